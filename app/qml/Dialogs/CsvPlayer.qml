@@ -182,6 +182,17 @@ Window {
         }
       }
 
+      //
+      // Indexing progress display
+      //
+      ProgressBar {
+        from: 0
+        to: 1
+        Layout.fillWidth: true
+        value: Cpp_CSV_Player.indexProgress
+        opacity: Cpp_CSV_Player.indexProgress < 1 ? 1 : 0
+      }
+
       //
       // Spacer
       //
@@ -232,6 +243,43 @@ Window {
           enabled: (Cpp_CSV_Player.framePosition < Cpp_CSV_Player.frameCount - 1) && !Cpp_CSV_Player.isPlaying
         }
       }
+
+      //
+      // Spacer
+      //
+      Item {
+        implicitHeight: 4
+      }
+
+      //
+      // Playback speed & achieved frame rate
+      //
+      RowLayout {
+        spacing: 8
+        Layout.fillWidth: true
+
+        Label {
+          text: qsTr("Speed:")
+          Layout.alignment: Qt.AlignVCenter
+        }
+
+        ComboBox {
+          Layout.fillWidth: true
+          currentIndex: Cpp_CSV_Player.speed
+          model: Cpp_CSV_Player.availableSpeeds
+          onCurrentIndexChanged: {
+            if (Cpp_CSV_Player.speed !== currentIndex)
+              Cpp_CSV_Player.speed = currentIndex
+          }
+        }
+
+        Label {
+          font: Cpp_Misc_CommonFonts.monoFont
+          Layout.alignment: Qt.AlignVCenter
+          visible: Cpp_CSV_Player.isPlaying && Cpp_CSV_Player.speed === Cpp_CSV_Player.availableSpeeds.length - 1
+          text: qsTr("%1 FPS").arg(Math.round(Cpp_CSV_Player.throughput))
+        }
+      }
     }
   }
 }
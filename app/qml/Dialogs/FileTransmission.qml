@@ -72,6 +72,8 @@ Window {
   Settings {
     category: "FileTransmission"
     property alias interval: _interval.value
+    property alias mode: _mode.currentIndex
+    property alias window: _window.value
   }
 
   //
@@ -167,18 +169,79 @@ Window {
             implicitHeight: 4
           }
 
+          //
+          // Mode selection
+          //
+          Label {
+            text: qsTr("Transmission Mode:")
+            opacity: enabled ? 1 : 0.5
+            enabled: !Cpp_IO_FileTransmission.active
+          } ComboBox {
+            id: _mode
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            enabled: !Cpp_IO_FileTransmission.active
+            model: Cpp_IO_FileTransmission.transmissionModes
+            currentIndex: Cpp_IO_FileTransmission.transmissionMode
+            onCurrentIndexChanged: {
+              if (currentIndex !== Cpp_IO_FileTransmission.transmissionMode)
+                Cpp_IO_FileTransmission.transmissionMode = currentIndex
+            }
+          }
+
+          //
+          // Spacer
+          //
+          Item {
+            implicitHeight: 4
+            visible: Cpp_IO_FileTransmission.transmissionMode >= 2
+          }
+
+          //
+          // XMODEM/YMODEM pipeline window
+          //
+          Label {
+            text: qsTr("Blocks Sent Before Acknowledgement:")
+            opacity: enabled ? 1 : 0.5
+            enabled: !Cpp_IO_FileTransmission.active
+            visible: Cpp_IO_FileTransmission.transmissionMode >= 2
+          } SpinBox {
+            id: _window
+            from: 1
+            to: 16
+            editable: true
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            enabled: !Cpp_IO_FileTransmission.active
+            visible: Cpp_IO_FileTransmission.transmissionMode >= 2
+            value: Cpp_IO_FileTransmission.protocolWindow
+            onValueChanged: {
+              if (value !== Cpp_IO_FileTransmission.protocolWindow)
+                Cpp_IO_FileTransmission.protocolWindow = value
+            }
+          }
+
+          //
+          // Spacer
+          //
+          Item {
+            implicitHeight: 4
+          }
+
           //
           // Interval selection
           //
           Label {
             text: qsTr("Transmission Interval:")
             opacity: enabled ? 1 : 0.5
-            enabled: !Cpp_IO_FileTransmission.active
+            enabled: !Cpp_IO_FileTransmission.active &&
+                     Cpp_IO_FileTransmission.transmissionMode === 0
           } RowLayout {
             spacing: 4
             Layout.fillWidth: true
             opacity: enabled ? 1 : 0.5
-            enabled: !Cpp_IO_FileTransmission.active
+            enabled: !Cpp_IO_FileTransmission.active &&
+                     Cpp_IO_FileTransmission.transmissionMode === 0
 
             SpinBox {
               id: _interval
@@ -224,7 +287,10 @@ Window {
               Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
 
               Label {
-                text: qsTr("Progress: %1").arg(Cpp_IO_FileTransmission.transmissionProgress) + "%"
+                text: Cpp_IO_FileTransmission.transmissionMode === 0 ?
+                        qsTr("Progress: %1").arg(Cpp_IO_FileTransmission.transmissionProgress) + "%" :
+                        qsTr("Progress: %1% (%2 KB/s)").arg(Cpp_IO_FileTransmission.transmissionProgress)
+                                                       .arg((Cpp_IO_FileTransmission.throughput / 1024).toFixed(1))
               }
 
               ProgressBar {
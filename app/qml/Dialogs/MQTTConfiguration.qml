@@ -125,6 +125,14 @@ Window {
     property alias ssl: _ssl.checked
     property alias certificate: _certificateMode.currentIndex
     property alias protocol: _protocols.currentIndex
+    property alias publishMode: _publishMode.currentIndex
+    property alias batchLatency: _batchLatency.text
+    property alias batchMessages: _batchMessages.text
+    property alias batchBytes: _batchBytes.text
+    property alias compression: _compression.checked
+    property alias changesOnly: _changesOnly.checked
+    property alias queueDepth: _queueDepth.text
+    property alias dropPolicy: _dropPolicy.currentIndex
   }
 
   //
@@ -386,7 +394,7 @@ Window {
             Layout.fillWidth: true
             opacity: enabled ? 1 : 0.5
             text: Cpp_MQTT_Client.topic
-            placeholderText: qsTr("MQTT Topic")
+            placeholderText: qsTr("MQTT Topic(s), e.g. fleet/+/data")
             enabled: !Cpp_MQTT_Client.isConnectedToHost
 
             onTextChanged: {
@@ -422,6 +430,259 @@ Window {
             implicitHeight: 8
           }
 
+          //
+          // Frame stream shown by the dashboard
+          //
+          Label {
+            Layout.columnSpan: 2
+            text: qsTr("Dashboard Topic") + ":"
+            visible: _mode.currentIndex === 1 &&
+                     Cpp_MQTT_Client.sources.length > 1
+          } ComboBox {
+            id: _source
+            Layout.columnSpan: 2
+            Layout.fillWidth: true
+            visible: _mode.currentIndex === 1 &&
+                     Cpp_MQTT_Client.sources.length > 1
+            currentIndex: Cpp_MQTT_Client.activeSource + 1
+            model: [qsTr("All Topics")].concat(Cpp_MQTT_Client.sources)
+
+            onCurrentIndexChanged: {
+              if (Cpp_MQTT_Client.activeSource !== currentIndex - 1)
+                Cpp_MQTT_Client.activeSource = currentIndex - 1
+            }
+          } Item {
+            implicitHeight: 8
+            Layout.columnSpan: 2
+            visible: _source.visible
+          }
+
+          //
+          // Publish mode & latency titles
+          //
+          Label {
+            text: qsTr("Publish Mode") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+          } Label {
+            text: qsTr("Max. Latency (ms)") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex !== 0
+          }
+
+          //
+          // Publish mode
+          //
+          ComboBox {
+            id: _publishMode
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+            model: Cpp_MQTT_Client.publishModes
+            currentIndex: Cpp_MQTT_Client.publishMode
+
+            onCurrentIndexChanged: {
+              if (Cpp_MQTT_Client.publishMode !== currentIndex)
+                Cpp_MQTT_Client.publishMode = currentIndex
+            }
+          }
+
+          //
+          // Max. latency
+          //
+          TextField {
+            id: _batchLatency
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            placeholderText: Cpp_MQTT_Client.batchMaxLatency
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex !== 0
+            Component.onCompleted: text = Cpp_MQTT_Client.batchMaxLatency
+
+            onTextChanged: {
+              if (text.length > 0 && Cpp_MQTT_Client.batchMaxLatency !== text)
+                Cpp_MQTT_Client.batchMaxLatency = text
+            }
+
+            validator: IntValidator {
+              bottom: 1
+              top: 10000
+            }
+          }
+
+          //
+          // Spacers
+          //
+          Item {
+            implicitHeight: 8
+          } Item {
+            implicitHeight: 8
+          }
+
+          //
+          // Batch size titles
+          //
+          Label {
+            text: qsTr("Frames per Message") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex === 1
+          } Label {
+            text: qsTr("Max. Message Size (KB)") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex === 1
+          }
+
+          //
+          // Max. frames per message
+          //
+          TextField {
+            id: _batchMessages
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            placeholderText: Cpp_MQTT_Client.batchMaxMessages
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex === 1
+            Component.onCompleted: text = Cpp_MQTT_Client.batchMaxMessages
+
+            onTextChanged: {
+              if (text.length > 0 && Cpp_MQTT_Client.batchMaxMessages !== text)
+                Cpp_MQTT_Client.batchMaxMessages = text
+            }
+
+            validator: IntValidator {
+              bottom: 1
+              top: 10000
+            }
+          }
+
+          //
+          // Max. message size
+          //
+          TextField {
+            id: _batchBytes
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            placeholderText: Cpp_MQTT_Client.batchMaxBytes / 1024
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex === 1
+            Component.onCompleted: text = Cpp_MQTT_Client.batchMaxBytes / 1024
+
+            onTextChanged: {
+              if (text.length > 0)
+                Cpp_MQTT_Client.batchMaxBytes = parseInt(text) * 1024
+            }
+
+            validator: IntValidator {
+              bottom: 1
+              top: 65536
+            }
+          }
+
+          //
+          // Payload compression
+          //
+          CheckBox {
+            id: _compression
+            Layout.columnSpan: 2
+            Layout.leftMargin: -6
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            text: qsTr("Compress Payloads")
+            checked: Cpp_MQTT_Client.compressionEnabled
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex !== 2
+
+            onCheckedChanged: {
+              if (Cpp_MQTT_Client.compressionEnabled !== checked)
+                Cpp_MQTT_Client.compressionEnabled = checked
+            }
+          }
+
+          //
+          // Only publish changed datasets
+          //
+          CheckBox {
+            id: _changesOnly
+            Layout.columnSpan: 2
+            Layout.leftMargin: -6
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            text: qsTr("Only Publish Changed Datasets")
+            checked: Cpp_MQTT_Client.changesOnly
+            enabled: _mode.currentIndex === 0 && _publishMode.currentIndex === 2
+
+            onCheckedChanged: {
+              if (Cpp_MQTT_Client.changesOnly !== checked)
+                Cpp_MQTT_Client.changesOnly = checked
+            }
+          }
+
+          //
+          // Spacers
+          //
+          Item {
+            implicitHeight: 8
+          } Item {
+            implicitHeight: 8
+          }
+
+          //
+          // Outbound queue titles
+          //
+          Label {
+            text: qsTr("Queue Depth") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+          } Label {
+            text: qsTr("When Queue Is Full") + ":"
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+          }
+
+          //
+          // Outbound queue depth
+          //
+          TextField {
+            id: _queueDepth
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+            placeholderText: Cpp_MQTT_Client.queueDepth
+            Component.onCompleted: text = Cpp_MQTT_Client.queueDepth
+
+            onTextChanged: {
+              if (text.length > 0 && Cpp_MQTT_Client.queueDepth !== text)
+                Cpp_MQTT_Client.queueDepth = text
+            }
+
+            validator: IntValidator {
+              bottom: 1
+              top: 100000
+            }
+          }
+
+          //
+          // Drop policy
+          //
+          ComboBox {
+            id: _dropPolicy
+            Layout.fillWidth: true
+            opacity: enabled ? 1 : 0.5
+            enabled: _mode.currentIndex === 0
+            model: Cpp_MQTT_Client.dropPolicies
+            currentIndex: Cpp_MQTT_Client.dropPolicy
+
+            onCurrentIndexChanged: {
+              if (Cpp_MQTT_Client.dropPolicy !== currentIndex)
+                Cpp_MQTT_Client.dropPolicy = currentIndex
+            }
+          }
+
+          //
+          // Spacers
+          //
+          Item {
+            implicitHeight: 8
+          } Item {
+            implicitHeight: 8
+          }
+
           //
           // Username & password titles
           //
@@ -640,8 +901,28 @@ Window {
           icon.color: Cpp_ThemeManager.colors["button_text"]
         }
 
+        //
+        // Outbound queue statistics, highlighted when MQTT is the bottleneck
+        //
+        Label {
+          Layout.fillWidth: true
+          elide: Label.ElideRight
+          horizontalAlignment: Label.AlignHCenter
+          visible: Cpp_MQTT_Client.isConnectedToHost && _mode.currentIndex === 0
+          color: Cpp_MQTT_Client.queuedMessages > 0 ||
+                 Cpp_MQTT_Client.droppedMessages > 0 ?
+                   Cpp_ThemeManager.colors["error"] :
+                   Cpp_ThemeManager.colors["text"]
+          text: qsTr("Queued: %1 · In Flight: %2 · Dropped: %3").arg(
+                  Cpp_MQTT_Client.queuedMessages).arg(
+                  Cpp_MQTT_Client.inFlightMessages).arg(
+                  Cpp_MQTT_Client.droppedMessages)
+        }
+
         Item {
           Layout.fillWidth: true
+          visible: !Cpp_MQTT_Client.isConnectedToHost ||
+                   _mode.currentIndex !== 0
         }
 
         Button {
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+//
+// Pipeline statistics overlay, displays the throughput, drops & latency of
+// each stage of the data pipeline, the memory used by each subsystem and the
+// link integrity counters
+//
+Rectangle {
+  id: root
+  radius: 4
+  opacity: 0.9
+  border.width: 1
+  implicitWidth: layout.implicitWidth + 16
+  implicitHeight: layout.implicitHeight + 16
+  color: Cpp_ThemeManager.colors["widget_base"]
+  border.color: Cpp_ThemeManager.colors["widget_border"]
+
+  //
+  // Formats the given rate with a unit suffix
+  //
+  function formatRate(value, unit) {
+    if (value >= 1e6)
+      return (value / 1e6).toFixed(2) + " M" + unit
+    if (value >= 1e3)
+      return (value / 1e3).toFixed(2) + " k" + unit
+    return (value.toFixed(0) + " " + unit).trim()
+  }
+
+  //
+  // Formats the given latency in microseconds
+  //
+  function formatLatency(us) {
+    if (us >= 1000)
+      return (us / 1000).toFixed(1) + " ms"
+    return us.toFixed(0) + " µs"
+  }
+
+  //
+  // Formats the given memory size in bytes
+  //
+  function formatMemory(bytes) {
+    if (bytes >= 1024 * 1024)
+      return (bytes / (1024 * 1024)).toFixed(1) + " MiB"
+    if (bytes >= 1024)
+      return (bytes / 1024).toFixed(1) + " KiB"
+    return bytes + " B"
+  }
+
+  ColumnLayout {
+    id: layout
+    spacing: 8
+    anchors.centerIn: parent
+
+    GridLayout {
+      id: grid
+      columns: 7
+      rowSpacing: 2
+      columnSpacing: 12
+
+      //
+      // Column titles
+      //
+      Repeater {
+        model: [qsTr("Stage"), qsTr("Items/s"), qsTr("Bytes/s"), qsTr("Drops"),
+          qsTr("p50"), qsTr("p99"), qsTr("Max")]
+        delegate: Label {
+          text: modelData
+          font: Cpp_Misc_CommonFonts.boldUiFont
+          color: Cpp_ThemeManager.colors["widget_text"]
+        }
+      }
+
+      //
+      // Statistics of each stage
+      //
+      Repeater {
+        model: Cpp_Misc_PipelineStats.stages
+        delegate: Repeater {
+          readonly property var stage: modelData
+          model: [stage.name,
+            root.formatRate(stage.items, ""),
+            root.formatRate(stage.bytes, "B"),
+            stage.drops,
+            root.formatLatency(stage.p50),
+            root.formatLatency(stage.p99),
+            root.formatLatency(stage.max)]
+          delegate: Label {
+            text: modelData
+            font: Cpp_Misc_CommonFonts.monoFont
+            color: index === 3 && stage.drops > 0 ?
+                     Cpp_ThemeManager.colors["alarm"] :
+                     Cpp_ThemeManager.colors["widget_text"]
+          }
+        }
+      }
+    }
+
+    //
+    // Memory usage of each subsystem
+    //
+    GridLayout {
+      columns: 3
+      rowSpacing: 2
+      columnSpacing: 12
+
+      Repeater {
+        model: [qsTr("Subsystem"), qsTr("Memory"), qsTr("Budget")]
+        delegate: Label {
+          text: modelData
+          font: Cpp_Misc_CommonFonts.boldUiFont
+          color: Cpp_ThemeManager.colors["widget_text"]
+        }
+      }
+
+      Repeater {
+        model: Cpp_Misc_PipelineStats.memory
+        delegate: Repeater {
+          readonly property var subsystem: modelData
+          model: [subsystem.name,
+            root.formatMemory(subsystem.bytes),
+            root.formatMemory(subsystem.budget)]
+          delegate: Label {
+            text: modelData
+            font: Cpp_Misc_CommonFonts.monoFont
+            color: index === 1 && subsystem.exceeded ?
+                     Cpp_ThemeManager.colors["alarm"] :
+                     Cpp_ThemeManager.colors["widget_text"]
+          }
+        }
+      }
+    }
+
+    //
+    // Link integrity counters
+    //
+    GridLayout {
+      columns: 2
+      rowSpacing: 2
+      columnSpacing: 12
+
+      Repeater {
+        model: [qsTr("Link Integrity"), qsTr("Count")]
+        delegate: Label {
+          text: modelData
+          font: Cpp_Misc_CommonFonts.boldUiFont
+          color: Cpp_ThemeManager.colors["widget_text"]
+        }
+      }
+
+      Repeater {
+        model: Cpp_Misc_PipelineStats.integrity
+        delegate: Repeater {
+          readonly property var counter: modelData
+          model: [counter.name, counter.count]
+          delegate: Label {
+            text: modelData
+            font: Cpp_Misc_CommonFonts.monoFont
+            color: index === 1 && counter.error ?
+                     Cpp_ThemeManager.colors["alarm"] :
+                     Cpp_ThemeManager.colors["widget_text"]
+          }
+        }
+      }
+    }
+  }
+}
@@ -50,7 +50,7 @@ Widgets.Pane {
     var minp = 0;
     var maxp = 100;
     var minv = Math.log(10);
-    var maxv = Math.log(10000);
+    var maxv = Math.log(100000);
     var scale = (maxv - minv) / (maxp - minp);
     var value = Math.exp(minv + scale * (position - minp));
     var roundedValue = Math.round(value / 10) * 10;
@@ -65,12 +65,34 @@ Widgets.Pane {
     var minp = 0
     var maxp = 100
     var minv = Math.log(10)
-    var maxv = Math.log(10000)
+    var maxv = Math.log(100000)
     var scale = (maxv - minv) / (maxp - minp)
     var result = (Math.log(value) - minv) / scale + minp;
     return result.toFixed(0)
   }
 
+  //
+  // Maps the slider position to a time window between 1 s and 24 h
+  //
+  function timeslider(position) {
+    var minv = Math.log(1)
+    var maxv = Math.log(86400)
+    var scale = (maxv - minv) / 100
+    return Math.round(Math.exp(minv + scale * position))
+  }
+
+  //
+  // Formats a time window in seconds, minutes or hours
+  //
+  function timeWindowText(seconds) {
+    if (seconds >= 3600)
+      return qsTr("%1 h").arg((seconds / 3600).toFixed(1))
+    if (seconds >= 60)
+      return qsTr("%1 min").arg((seconds / 60).toFixed(1))
+
+    return qsTr("%1 s").arg(seconds)
+  }
+
   //
   // Settings
   //
@@ -79,6 +101,12 @@ Widgets.Pane {
     property alias points: plotPoints.value
     property alias columns: columns.value
     property alias showLegends: legends.checked
+    property alias timeAxis: timeAxis.checked
+    property alias timeWindowPosition: timeWindow.value
+    property alias trigger: trigger.checked
+    property alias triggerEdge: triggerEdge.currentIndex
+    property alias triggerLevel: triggerLevel.text
+    property alias triggerPosition: triggerPosition.value
     property alias decimalPlaces: decimalPlaces.value
     property alias axisOptions: axisVisibility.currentIndex
   }
@@ -278,6 +306,215 @@ Widgets.Pane {
             visible: Cpp_UI_Dashboard.pointsWidgetVisible
           }
 
+          //
+          // Plot samples over their acquisition time
+          //
+          Label {
+            text: qsTr("Time Axis")
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+          } CheckBox {
+            id: timeAxis
+            Layout.leftMargin: -8
+            Layout.alignment: Qt.AlignLeft
+            checked: Cpp_UI_Dashboard.timeAxis
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+            onCheckedChanged: {
+              if (checked !== Cpp_UI_Dashboard.timeAxis)
+                Cpp_UI_Dashboard.timeAxis = checked
+            }
+          } Item {
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+          }
+
+          //
+          // Length of the plotted time window
+          //
+          Label {
+            text: qsTr("Time Window:")
+            visible: timeAxis.visible && timeAxis.checked
+          } Slider {
+            id: timeWindow
+            to: 100
+            from: 0
+            value: 20
+            stepSize: 1
+            Layout.fillWidth: true
+            visible: timeAxis.visible && timeAxis.checked
+            onValueChanged: Cpp_UI_Dashboard.timeWindow = timeslider(value)
+          } Label {
+            text: timeWindowText(timeslider(timeWindow.value))
+            visible: timeAxis.visible && timeAxis.checked
+          }
+
+          //
+          // Scrollback through the plotted history
+          //
+          Label {
+            text: qsTr("Scrollback:")
+            visible: timeAxis.visible && timeAxis.checked
+          } Slider {
+            id: timeOffset
+            to: 100
+            from: 0
+            value: 0
+            stepSize: 1
+            Layout.fillWidth: true
+            visible: timeAxis.visible && timeAxis.checked
+            onValueChanged: Cpp_UI_Dashboard.timeOffset = value > 0 ? timeslider(value) : 0
+          } Label {
+            visible: timeAxis.visible && timeAxis.checked
+            text: timeOffset.value > 0 ? timeWindowText(timeslider(timeOffset.value)) : qsTr("Live")
+          }
+
+          //
+          // Oscilloscope-style trigger
+          //
+          Label {
+            text: qsTr("Trigger")
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+          } CheckBox {
+            id: trigger
+            Layout.leftMargin: -8
+            Layout.alignment: Qt.AlignLeft
+            checked: Cpp_UI_Dashboard.triggerEnabled
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+            onCheckedChanged: {
+              if (checked !== Cpp_UI_Dashboard.triggerEnabled)
+                Cpp_UI_Dashboard.triggerEnabled = checked
+            }
+          } Item {
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1
+          }
+
+          //
+          // Dataset that triggers the captures
+          //
+          Label {
+            text: qsTr("Source:")
+            visible: trigger.visible && trigger.checked
+          } ComboBox {
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+            visible: trigger.visible && trigger.checked
+            currentIndex: Cpp_UI_Dashboard.triggerSource
+            model: Cpp_UI_Dashboard.widgetTitles(SerialStudio.DashboardPlot)
+            onCurrentIndexChanged: Cpp_UI_Dashboard.triggerSource = currentIndex
+          }
+
+          //
+          // Trigger edge
+          //
+          Label {
+            text: qsTr("Edge:")
+            visible: trigger.visible && trigger.checked
+          } ComboBox {
+            id: triggerEdge
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+            visible: trigger.visible && trigger.checked
+            model: [qsTr("Rising"), qsTr("Falling")]
+            onCurrentIndexChanged: {
+              Cpp_UI_Dashboard.triggerEdge = currentIndex === 0 ?
+                    SerialStudio.TriggerRisingEdge :
+                    SerialStudio.TriggerFallingEdge
+            }
+          }
+
+          //
+          // Trigger level
+          //
+          Label {
+            text: qsTr("Level:")
+            visible: trigger.visible && trigger.checked
+          } TextField {
+            id: triggerLevel
+            text: "0"
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+            visible: trigger.visible && trigger.checked
+            validator: DoubleValidator {}
+            onTextChanged: {
+              const level = Number(text)
+              if (!isNaN(level))
+                Cpp_UI_Dashboard.triggerLevel = level
+            }
+          }
+
+          //
+          // Position of the trigger sample within the captures
+          //
+          Label {
+            text: qsTr("Pre-trigger:")
+            visible: trigger.visible && trigger.checked
+          } Slider {
+            id: triggerPosition
+            to: 100
+            from: 0
+            value: 10
+            stepSize: 1
+            Layout.fillWidth: true
+            visible: trigger.visible && trigger.checked
+            onValueChanged: Cpp_UI_Dashboard.triggerPosition = Math.round(value)
+          } Label {
+            text: qsTr("%1 %").arg(Math.round(triggerPosition.value))
+            visible: trigger.visible && trigger.checked
+          }
+
+          //
+          // Recorded session overlaid on the plots
+          //
+          Label {
+            text: qsTr("Reference:")
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1 ||
+                     Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardMultiPlot) >= 1
+          } Button {
+            id: reference
+            Layout.fillWidth: true
+            onClicked: Cpp_CSV_Reference.openFile()
+            visible: Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardPlot) >= 1 ||
+                     Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardMultiPlot) >= 1
+            text: Cpp_CSV_Reference.isOpen ? Cpp_CSV_Reference.fileName : qsTr("Open…")
+          } Button {
+            text: qsTr("Close")
+            visible: reference.visible
+            enabled: Cpp_CSV_Reference.isOpen
+            onClicked: Cpp_CSV_Reference.closeFile()
+          }
+
+          //
+          // Alignment of the reference with the live data
+          //
+          Label {
+            text: qsTr("Align:")
+            visible: reference.visible && Cpp_CSV_Reference.isOpen
+          } ComboBox {
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+            visible: reference.visible && Cpp_CSV_Reference.isOpen
+            model: [qsTr("Start Time"), qsTr("Trigger")]
+            currentIndex: Cpp_CSV_Reference.triggerAlignment ? 1 : 0
+            onCurrentIndexChanged: Cpp_CSV_Reference.triggerAlignment = currentIndex === 1
+          }
+
+          //
+          // Largest deviation from the reference without an alarm
+          //
+          Label {
+            text: qsTr("Tolerance:")
+            visible: reference.visible && Cpp_CSV_Reference.isOpen
+          } TextField {
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+            text: Cpp_CSV_Reference.tolerance
+            validator: DoubleValidator { bottom: 0 }
+            visible: reference.visible && Cpp_CSV_Reference.isOpen
+            onTextChanged: {
+              const tolerance = Number(text)
+              if (!isNaN(tolerance))
+                Cpp_CSV_Reference.tolerance = tolerance
+            }
+          }
+
           //
           // Number of decimal places
           //
@@ -336,6 +573,21 @@ Widgets.Pane {
           } Item {
             visible: Cpp_UI_Dashboard.totalWidgetCount > 0 && Cpp_UI_Dashboard.widgetCount(SerialStudio.DashboardMultiPlot) >= 1
           }
+
+          //
+          // Pipeline statistics overlay
+          //
+          Label {
+            text: qsTr("Pipeline Statistics")
+          } CheckBox {
+            Layout.leftMargin: -8
+            Layout.alignment: Qt.AlignLeft
+            checked: Cpp_Misc_PipelineStats.overlayVisible
+            onCheckedChanged: {
+              if (checked !== Cpp_Misc_PipelineStats.overlayVisible)
+                Cpp_Misc_PipelineStats.overlayVisible = checked
+            }
+          } Item {}
         }
 
         //
@@ -412,7 +664,9 @@ Widgets.Pane {
               anchors.centerIn: parent
               width: Math.max(layout1.implicitWidth,
                               layout2.implicitWidth,
-                              layout3.implicitWidth)
+                              layout3.implicitWidth,
+                              layout4.implicitWidth,
+                              layout5.implicitWidth)
 
               Image {
                 sourceSize: Qt.size(18, 18)
@@ -443,7 +697,9 @@ Widgets.Pane {
               anchors.centerIn: parent
               width: Math.max(layout1.implicitWidth,
                               layout2.implicitWidth,
-                              layout3.implicitWidth)
+                              layout3.implicitWidth,
+                              layout4.implicitWidth,
+                              layout5.implicitWidth)
 
               Image {
                 sourceSize: Qt.size(18, 18)
@@ -464,6 +720,81 @@ Widgets.Pane {
             }
           }
 
+          Button {
+            Layout.fillWidth: true
+            onClicked: Cpp_UI_DashboardRecorder.saveSnapshot()
+
+            RowLayout {
+              id: layout4
+              spacing: 8
+              anchors.centerIn: parent
+              width: Math.max(layout1.implicitWidth,
+                              layout2.implicitWidth,
+                              layout3.implicitWidth,
+                              layout4.implicitWidth,
+                              layout5.implicitWidth)
+
+              Image {
+                sourceSize: Qt.size(18, 18)
+                Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
+                source: "qrc:/rcc/icons/buttons/save.svg"
+              }
+
+              Label {
+                text: qsTr("Save Dashboard Snapshot")
+                Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
+                horizontalAlignment: Text.AlignLeft
+                color: Cpp_ThemeManager.colors["button_text"]
+              }
+
+              Item {
+                Layout.fillWidth: true
+              }
+            }
+          }
+
+          Button {
+            Layout.fillWidth: true
+            onClicked: {
+              if (Cpp_UI_DashboardRecorder.recording)
+                Cpp_UI_DashboardRecorder.stop()
+              else
+                Cpp_UI_DashboardRecorder.recordVideo()
+            }
+
+            RowLayout {
+              id: layout5
+              spacing: 8
+              anchors.centerIn: parent
+              width: Math.max(layout1.implicitWidth,
+                              layout2.implicitWidth,
+                              layout3.implicitWidth,
+                              layout4.implicitWidth,
+                              layout5.implicitWidth)
+
+              Image {
+                sourceSize: Qt.size(18, 18)
+                Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
+                source: Cpp_UI_DashboardRecorder.recording ?
+                          "qrc:/rcc/icons/buttons/media-stop.svg" :
+                          "qrc:/rcc/icons/buttons/media-play.svg"
+              }
+
+              Label {
+                Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
+                horizontalAlignment: Text.AlignLeft
+                color: Cpp_ThemeManager.colors["button_text"]
+                text: Cpp_UI_DashboardRecorder.recording ?
+                        qsTr("Stop Recording (%1 Frames)").arg(Cpp_UI_DashboardRecorder.frameCount) :
+                        qsTr("Record Dashboard Video")
+              }
+
+              Item {
+                Layout.fillWidth: true
+              }
+            }
+          }
+
           Button {
             opacity: 0.5
             enabled: false
@@ -476,7 +807,9 @@ Widgets.Pane {
               anchors.centerIn: parent
               width: Math.max(layout1.implicitWidth,
                               layout2.implicitWidth,
-                              layout3.implicitWidth)
+                              layout3.implicitWidth,
+                              layout4.implicitWidth,
+                              layout5.implicitWidth)
 
               Image {
                 sourceSize: Qt.size(18, 18)
@@ -41,7 +41,9 @@ Widgets.Pane {
   onActionButtonClicked: windowLoader.active = true
 
   //
-  // Disable widget rendering when it is not visible on the user's screen
+  // Disable widget rendering & updates when it is not visible on the user's
+  // screen, the dashboard stops calling the update functions of disabled
+  // widgets until they are enabled again
   //
   property bool active: true
 
@@ -57,6 +59,7 @@ Widgets.Pane {
     id: widget
     clip: true
     visible: root.active
+    enabled: root.active
     anchors.fill: parent
     anchors.topMargin: -16
     anchors.leftMargin: -8
@@ -89,6 +92,21 @@ Widgets.Pane {
             loader.item.color = widget.widgetColor
         }
       }
+
+      //
+      // Re-assign the model when the widget is re-created with the same type
+      //
+      Connections {
+        target: widget
+
+        function onWidgetIndexChanged() {
+          if (loader.item && widget.widgetModel &&
+              loader.source.toString() === widget.widgetQmlPath) {
+            loader.item.color = widget.widgetColor
+            loader.item.model = widget.widgetModel
+          }
+        }
+      }
     }
   }
 
@@ -212,6 +230,18 @@ Widgets.Pane {
                 windowWidgetLoader.item.color = windowWidget.widgetColor
             }
           }
+
+          Connections {
+            target: windowWidget
+
+            function onWidgetIndexChanged() {
+              if (windowWidgetLoader.item && windowWidget.widgetModel &&
+                  windowWidgetLoader.source.toString() === windowWidget.widgetQmlPath) {
+                windowWidgetLoader.item.color = windowWidget.widgetColor
+                windowWidgetLoader.item.model = windowWidget.widgetModel
+              }
+            }
+          }
         }
       }
     }
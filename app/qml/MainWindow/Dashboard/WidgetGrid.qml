@@ -92,6 +92,7 @@ Widgets.Pane {
             icon.width: 24
             icon.height: 24
             toolbarButton: false
+            checked: Cpp_UI_Dashboard.activeActions[index] === true
             Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft | Qt.AlignLeft
             text: Cpp_UI_Dashboard.actionTitles[index]
             icon.source: Cpp_UI_Dashboard.actionIcons[index]
@@ -183,6 +184,12 @@ Widgets.Pane {
         height: childrenRect.height
         columns: root.appliedColumns
 
+        //
+        // Widgets are not instantiated until they are found to be inside the
+        // viewport, so check their positions whenever the grid is rebuilt
+        //
+        onChildrenChanged: Qt.callLater(flickable.updateVisibleWidgets)
+
         Timer {
           id: timer
           interval: 200
@@ -215,7 +222,7 @@ Widgets.Pane {
           id: model
           cellWidth: root.cellWidth
           cellHeight: root.cellHeight
-          model: Cpp_UI_Dashboard.totalWidgetCount
+          model: Cpp_UI_Dashboard.widgetModel
         }
       }
     }
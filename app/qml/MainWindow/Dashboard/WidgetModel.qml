@@ -30,17 +30,29 @@ Repeater {
 
   delegate: Loader {
     id: loader
+    opacity: 0
+    active: false
     asynchronous: true
     width: root.cellWidth
     height: root.cellHeight
     readonly property bool widgetInViewPort: opacity > 0
+    readonly property bool shown: visible && widgetInViewPort
 
     // Uncomment to verify that lazy widget rendering is working
     //Behavior on opacity {NumberAnimation{}}
 
+    //
+    // Only instantiate the widget once it is scrolled into view, afterwards
+    // keep it (and its state) alive, but suspended while it is not shown
+    //
+    onShownChanged: {
+      if (shown)
+        loader.active = true
+    }
+
     sourceComponent: WidgetDelegate {
       widgetIndex: index
-      active: loader.visible && loader.widgetInViewPort
+      active: loader.shown
     }
 
     Connections {
@@ -91,5 +91,43 @@ RowLayout {
     Layout.fillHeight: true
     Layout.minimumWidth: 240
     columns: viewOptions.widgetColumns
+
+    //
+    // Pipeline statistics overlay
+    //
+    DashboardItems.PipelineStats {
+      z: 10
+      anchors.top: parent.top
+      anchors.right: parent.right
+      anchors.topMargin: 40
+      anchors.rightMargin: 16
+      visible: Cpp_Misc_PipelineStats.overlayVisible
+    }
+
+    //
+    // Degraded indicator, shown while the dashboard skips frames to keep up
+    // with the incoming data
+    //
+    Rectangle {
+      z: 10
+      radius: 4
+      opacity: 0.9
+      anchors.top: parent.top
+      anchors.left: parent.left
+      anchors.topMargin: 40
+      anchors.leftMargin: 16
+      implicitWidth: degradedLabel.implicitWidth + 16
+      implicitHeight: degradedLabel.implicitHeight + 8
+      color: Cpp_ThemeManager.colors["alarm"]
+      visible: Cpp_Misc_OverloadController.degraded
+
+      Label {
+        id: degradedLabel
+        color: "#ffffff"
+        anchors.centerIn: parent
+        font: Cpp_Misc_CommonFonts.boldUiFont
+        text: qsTr("Degraded: %1% load").arg(Cpp_Misc_OverloadController.load)
+      }
+    }
   }
 }
@@ -70,9 +70,17 @@ Widgets.Pane {
 
     property alias tabIndex: tab.currentIndex
     property alias csvExport: csvLogging.checked
+    property alias csvSparseRows: csvSparseRows.checked
+    property alias arrowExport: arrowLogging.checked
     property alias driver: driverCombo.currentIndex
     property alias language: settings.language
     property alias tcpPlugins: settings.tcpPlugins
+    property alias pluginPolicy: settings.pluginPolicy
+    property alias bufferSize: settings.bufferSize
+    property alias overflowPolicy: settings.overflowPolicy
+    property alias csvCompression: settings.csvCompression
+    property alias csvRotationSize: settings.csvRotationSize
+    property alias csvRotationInterval: settings.csvRotationInterval
   }
 
   //
@@ -158,6 +166,184 @@ Widgets.Pane {
         }
       }
 
+      //
+      // Sparse CSV rows
+      //
+      Switch {
+        id: csvSparseRows
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        opacity: enabled ? 1 : 0.5
+        enabled: csvLogging.checked
+        text: qsTr("Only Write Changed Values")
+        checked: Cpp_CSV_Export.sparseRows
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_CSV_Export.sparseRows !== checked)
+            Cpp_CSV_Export.sparseRows = checked
+        }
+      }
+
+      //
+      // CSV writer status
+      //
+      Label {
+        Layout.fillWidth: true
+        wrapMode: Label.WordWrap
+        color: Cpp_ThemeManager.colors["error"]
+        font: Cpp_Misc_CommonFonts.customUiFont(0.8, false)
+        visible: Cpp_CSV_Export.exportEnabled &&
+                 (Cpp_CSV_Export.backPressure || Cpp_CSV_Export.droppedFrames > 0)
+        text: Cpp_CSV_Export.droppedFrames > 0 ?
+                qsTr("CSV writer is falling behind, %1 frames dropped").arg(Cpp_CSV_Export.droppedFrames) :
+                qsTr("CSV writer is falling behind")
+      }
+
+      //
+      // Arrow file generator
+      //
+      Switch {
+        id: arrowLogging
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        text: qsTr("Create Arrow File")
+        checked: Cpp_CSV_ArrowExport.exportEnabled
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_CSV_ArrowExport.exportEnabled !== checked)
+            Cpp_CSV_ArrowExport.exportEnabled = checked
+        }
+      }
+
+      //
+      // Time-series database export
+      //
+      Switch {
+        id: tsdbExport
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        text: qsTr("Send to Time-Series Database")
+        checked: Cpp_CSV_TsdbExport.exportEnabled
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_CSV_TsdbExport.exportEnabled !== checked)
+            Cpp_CSV_TsdbExport.exportEnabled = checked
+        }
+      }
+
+      //
+      // Time-series database server
+      //
+      GridLayout {
+        columns: 2
+        rowSpacing: 4
+        columnSpacing: 4
+        Layout.fillWidth: true
+        visible: tsdbExport.checked
+        Layout.maximumWidth: root.maxItemWidth
+
+        Label {
+          text: qsTr("API") + ":"
+        } ComboBox {
+          Layout.fillWidth: true
+          model: Cpp_CSV_TsdbExport.formats
+          currentIndex: Cpp_CSV_TsdbExport.format
+          onCurrentIndexChanged: {
+            if (currentIndex !== Cpp_CSV_TsdbExport.format)
+              Cpp_CSV_TsdbExport.format = currentIndex
+          }
+        }
+
+        Label {
+          text: qsTr("URL") + ":"
+        } TextField {
+          Layout.fillWidth: true
+          text: Cpp_CSV_TsdbExport.url
+          onEditingFinished: Cpp_CSV_TsdbExport.url = text
+          placeholderText: Cpp_CSV_TsdbExport.format === 0 ?
+                             "http://localhost:8086/api/v2/write?org=org&bucket=bucket&precision=ns" :
+                             "http://localhost:9090/api/v1/write"
+        }
+
+        Label {
+          text: qsTr("Token") + ":"
+        } TextField {
+          Layout.fillWidth: true
+          echoMode: TextInput.Password
+          text: Cpp_CSV_TsdbExport.token
+          placeholderText: qsTr("Optional")
+          onEditingFinished: Cpp_CSV_TsdbExport.token = text
+        }
+      }
+
+      //
+      // Time-series database status
+      //
+      Label {
+        Layout.fillWidth: true
+        wrapMode: Label.WordWrap
+        color: Cpp_ThemeManager.colors["error"]
+        font: Cpp_Misc_CommonFonts.customUiFont(0.8, false)
+        visible: tsdbExport.checked && Cpp_CSV_TsdbExport.lastError.length > 0
+        text: qsTr("%1 batches waiting to be sent: %2")
+                .arg(Cpp_CSV_TsdbExport.queuedBatches)
+                .arg(Cpp_CSV_TsdbExport.lastError)
+      }
+
+      //
+      // Binary session generator
+      //
+      Switch {
+        id: binaryLogging
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        text: qsTr("Create Binary Session File")
+        checked: Cpp_CSV_BinaryExport.exportEnabled
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_CSV_BinaryExport.exportEnabled !== checked)
+            Cpp_CSV_BinaryExport.exportEnabled = checked
+        }
+      }
+
+      //
+      // Raw capture generator
+      //
+      Switch {
+        id: rawCapture
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        text: qsTr("Create Raw Capture File")
+        checked: Cpp_IO_RawCapture.captureEnabled
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_IO_RawCapture.captureEnabled !== checked)
+            Cpp_IO_RawCapture.captureEnabled = checked
+        }
+      }
+
+      //
+      // Flight recorder
+      //
+      Switch {
+        id: flightRecorder
+        Layout.leftMargin: -6
+        Layout.alignment: Qt.AlignLeft
+        text: qsTr("Flight Recorder (Ctrl+Shift+R)")
+        checked: Cpp_CSV_FlightRecorder.enabled
+        palette.highlight: Cpp_ThemeManager.colors["csv_switch"]
+
+        onCheckedChanged:  {
+          if (Cpp_CSV_FlightRecorder.enabled !== checked)
+            Cpp_CSV_FlightRecorder.enabled = checked
+        }
+      }
+
       //
       // Spacer
       //
@@ -183,6 +369,17 @@ Widgets.Pane {
           if (checked && shouldChange)
             Cpp_JSON_FrameBuilder.operationMode = SerialStudio.DeviceSendsJSON
         }
+      } CheckBox {
+        Layout.leftMargin: 24
+        Layout.maximumHeight: 18
+        Layout.maximumWidth: root.maxItemWidth
+        text: qsTr("Fixed Layout (Update Values Only)")
+        checked: Cpp_JSON_FrameBuilder.fixedJsonLayout
+        visible: Cpp_JSON_FrameBuilder.operationMode === SerialStudio.DeviceSendsJSON
+        onCheckedChanged: {
+          if (Cpp_JSON_FrameBuilder.fixedJsonLayout !== checked)
+            Cpp_JSON_FrameBuilder.fixedJsonLayout = checked
+        }
       } RadioButton {
         Layout.maximumHeight: 18
         Layout.maximumWidth: root.maxItemWidth
@@ -241,6 +438,12 @@ Widgets.Pane {
           width: implicitWidth + 2 * 8
         }
 
+        TabButton {
+          text: qsTr("Sources")
+          height: tab.height + 3
+          width: implicitWidth + 2 * 8
+        }
+
         TabButton {
           text: qsTr("Settings")
           height: tab.height + 3
@@ -266,6 +469,12 @@ Widgets.Pane {
           Layout.fillHeight: true
         }
 
+        SetupPanes.Sources {
+          id: sources
+          Layout.fillWidth: true
+          Layout.fillHeight: true
+        }
+
         SetupPanes.Settings {
           id: settings
           Layout.fillWidth: true
@@ -134,6 +134,30 @@ Item {
       }
     }
 
+    //
+    // Characteristic subscriptions, each one is read with its own frame reader
+    //
+    Label {
+      opacity: 0.8
+      Layout.topMargin: 4
+      Layout.fillWidth: true
+      wrapMode: Label.WordWrap
+      text: qsTr("Read several characteristics at once:")
+      visible: Cpp_IO_Bluetooth_LE.operatingSystemSupported && characteristicNames.count > 2
+    }
+
+    Repeater {
+      model: Cpp_IO_Bluetooth_LE.operatingSystemSupported && characteristicNames.count > 2 ?
+               Cpp_IO_Bluetooth_LE.characteristicNames.slice(1) : []
+      delegate: CheckBox {
+        text: modelData
+        Layout.fillWidth: true
+        Layout.leftMargin: -8
+        checked: Cpp_IO_Bluetooth_LE.subscriptions.indexOf(index + 1) !== -1
+        onToggled: Cpp_IO_Bluetooth_LE.setSubscribed(index + 1, checked)
+      }
+    }
+
     //
     // Scanning indicator
     //
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight
+
+  //
+  // Access to properties
+  //
+  property alias plugin: _pluginCombo.currentIndex
+  property alias bitRate: _bitRateCombo.currentIndex
+  property alias flexibleDataRate: _canFd.checked
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    anchors.margins: 0
+    anchors.fill: parent
+
+    GridLayout {
+      columns: 2
+      rowSpacing: 4
+      columnSpacing: 4
+      Layout.fillWidth: true
+
+      //
+      // Plugin
+      //
+      Label {
+        text: qsTr("Plugin") + ":"
+      } ComboBox {
+        id: _pluginCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_CANBus.availablePlugins
+        currentIndex: Cpp_IO_CANBus.pluginIndex
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_CANBus.pluginIndex)
+            Cpp_IO_CANBus.pluginIndex = currentIndex
+        }
+      }
+
+      //
+      // Interface
+      //
+      Label {
+        text: qsTr("Interface") + ":"
+      } RowLayout {
+        spacing: 4
+        Layout.fillWidth: true
+
+        ComboBox {
+          id: _interfaceCombo
+          Layout.fillWidth: true
+          model: Cpp_IO_CANBus.availableInterfaces
+          currentIndex: Cpp_IO_CANBus.interfaceIndex
+          onCurrentIndexChanged: {
+            if (currentIndex !== Cpp_IO_CANBus.interfaceIndex)
+              Cpp_IO_CANBus.interfaceIndex = currentIndex
+          }
+        }
+
+        Button {
+          text: qsTr("Refresh")
+          onClicked: Cpp_IO_CANBus.refreshInterfaces()
+        }
+      }
+
+      //
+      // Bit rate
+      //
+      Label {
+        text: qsTr("Bit Rate") + ":"
+      } ComboBox {
+        id: _bitRateCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_CANBus.availableBitRates
+        currentIndex: Cpp_IO_CANBus.bitRateIndex
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_CANBus.bitRateIndex)
+            Cpp_IO_CANBus.bitRateIndex = currentIndex
+        }
+      }
+
+      //
+      // CAN FD
+      //
+      Label {
+        text: qsTr("CAN FD") + ":"
+      } CheckBox {
+        id: _canFd
+        Layout.alignment: Qt.AlignLeft
+        Layout.leftMargin: -8
+        checked: Cpp_IO_CANBus.flexibleDataRate
+        onCheckedChanged: {
+          if (checked !== Cpp_IO_CANBus.flexibleDataRate)
+            Cpp_IO_CANBus.flexibleDataRate = checked
+        }
+      }
+    }
+
+    //
+    // Vertical spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
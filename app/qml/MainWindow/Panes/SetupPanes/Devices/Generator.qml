@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight
+
+  //
+  // Access to properties
+  //
+  property alias waveform: _waveformCombo.currentIndex
+  property alias channels: _channelsSpin.value
+  property alias frameRate: _frameRateCombo.currentIndex
+  property alias checksum: _checksumCombo.currentIndex
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    anchors.margins: 0
+    anchors.fill: parent
+
+    GridLayout {
+      columns: 2
+      rowSpacing: 4
+      columnSpacing: 4
+      Layout.fillWidth: true
+
+      //
+      // Signal
+      //
+      Label {
+        text: qsTr("Signal") + ":"
+      } ComboBox {
+        id: _waveformCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_Generator.availableWaveforms
+        currentIndex: Cpp_IO_Generator.waveform
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Generator.waveform)
+            Cpp_IO_Generator.waveform = currentIndex
+        }
+      }
+
+      //
+      // Channels
+      //
+      Label {
+        text: qsTr("Channels") + ":"
+      } SpinBox {
+        id: _channelsSpin
+        from: 1
+        to: 256
+        editable: true
+        Layout.fillWidth: true
+        value: Cpp_IO_Generator.channels
+        onValueChanged: {
+          if (value !== Cpp_IO_Generator.channels)
+            Cpp_IO_Generator.channels = value
+        }
+      }
+
+      //
+      // Frame rate
+      //
+      Label {
+        text: qsTr("Frame Rate") + ":"
+      } ComboBox {
+        id: _frameRateCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_Generator.availableFrameRates
+        currentIndex: Cpp_IO_Generator.frameRate
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Generator.frameRate)
+            Cpp_IO_Generator.frameRate = currentIndex
+        }
+      }
+
+      //
+      // Checksum
+      //
+      Label {
+        text: qsTr("Checksum") + ":"
+      } ComboBox {
+        id: _checksumCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_Generator.availableChecksums
+        currentIndex: Cpp_IO_Generator.checksum
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Generator.checksum)
+            Cpp_IO_Generator.checksum = currentIndex
+        }
+      }
+    }
+
+    //
+    // Vertical spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
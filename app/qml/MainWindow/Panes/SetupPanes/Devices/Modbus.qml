@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight
+
+  //
+  // Access to properties
+  //
+  property alias host: _host.text
+  property alias port: _port.text
+  property alias parity: _parityCombo.currentIndex
+  property alias protocol: _protocolCombo.currentIndex
+  property alias baudRate: _baudRateCombo.currentIndex
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    anchors.margins: 0
+    anchors.fill: parent
+
+    GridLayout {
+      columns: 2
+      rowSpacing: 4
+      columnSpacing: 4
+      Layout.fillWidth: true
+
+      //
+      // Protocol
+      //
+      Label {
+        text: qsTr("Protocol") + ":"
+      } ComboBox {
+        id: _protocolCombo
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        model: Cpp_IO_Modbus.availableProtocols
+        currentIndex: Cpp_IO_Modbus.protocolIndex
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Modbus.protocolIndex)
+            Cpp_IO_Modbus.protocolIndex = currentIndex
+        }
+      }
+
+      //
+      // Serial port (Modbus RTU)
+      //
+      Label {
+        text: qsTr("COM Port") + ":"
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+      } RowLayout {
+        spacing: 4
+        Layout.fillWidth: true
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+
+        ComboBox {
+          id: _portCombo
+          Layout.fillWidth: true
+          opacity: enabled ? 1 : 0.5
+          enabled: !Cpp_IO_Manager.connected
+          model: Cpp_IO_Modbus.availableSerialPorts
+          currentIndex: Cpp_IO_Modbus.serialPortIndex
+          onCurrentIndexChanged: {
+            if (currentIndex !== Cpp_IO_Modbus.serialPortIndex)
+              Cpp_IO_Modbus.serialPortIndex = currentIndex
+          }
+        }
+
+        Button {
+          text: qsTr("Refresh")
+          opacity: enabled ? 1 : 0.5
+          enabled: !Cpp_IO_Manager.connected
+          onClicked: Cpp_IO_Modbus.refreshSerialPorts()
+        }
+      }
+
+      //
+      // Baud rate (Modbus RTU)
+      //
+      Label {
+        text: qsTr("Baud Rate") + ":"
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+      } ComboBox {
+        id: _baudRateCombo
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+        model: Cpp_IO_Modbus.availableBaudRates
+        currentIndex: Cpp_IO_Modbus.baudRateIndex
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Modbus.baudRateIndex)
+            Cpp_IO_Modbus.baudRateIndex = currentIndex
+        }
+      }
+
+      //
+      // Parity (Modbus RTU)
+      //
+      Label {
+        text: qsTr("Parity") + ":"
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+      } ComboBox {
+        id: _parityCombo
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        visible: Cpp_IO_Modbus.protocolIndex === 0
+        model: Cpp_IO_Modbus.availableParities
+        currentIndex: Cpp_IO_Modbus.parityIndex
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Modbus.parityIndex)
+            Cpp_IO_Modbus.parityIndex = currentIndex
+        }
+      }
+
+      //
+      // Host (Modbus TCP)
+      //
+      Label {
+        text: qsTr("Host") + ":"
+        visible: Cpp_IO_Modbus.protocolIndex === 1
+      } TextField {
+        id: _host
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        visible: Cpp_IO_Modbus.protocolIndex === 1
+        Component.onCompleted: text = Cpp_IO_Modbus.host
+        onTextChanged: {
+          if (Cpp_IO_Modbus.host !== text && text.length > 0)
+            Cpp_IO_Modbus.host = text
+        }
+      }
+
+      //
+      // Port (Modbus TCP)
+      //
+      Label {
+        text: qsTr("Port") + ":"
+        visible: Cpp_IO_Modbus.protocolIndex === 1
+      } TextField {
+        id: _port
+        Layout.fillWidth: true
+        placeholderText: "502"
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        visible: Cpp_IO_Modbus.protocolIndex === 1
+        Component.onCompleted: text = Cpp_IO_Modbus.port
+        onTextChanged: {
+          if (Cpp_IO_Modbus.port !== text && text.length > 0)
+            Cpp_IO_Modbus.port = text
+        }
+
+        validator: IntValidator {
+          bottom: 1
+          top: 65535
+        }
+      }
+    }
+
+    //
+    // Vertical spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
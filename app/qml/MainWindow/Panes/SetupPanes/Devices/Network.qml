@@ -95,6 +95,28 @@ Item {
         }
       }
 
+      //
+      // TCP server checkbox
+      //
+      Label {
+        opacity: enabled ? 1 : 0.5
+        enabled: !Cpp_IO_Manager.connected
+        text: qsTr("Accept Connections") + ":"
+        visible: Cpp_IO_Network.socketTypeIndex === 0
+      } CheckBox {
+        id: _tcpServer
+        opacity: enabled ? 1 : 0.5
+        Layout.leftMargin: -8
+        Layout.alignment: Qt.AlignLeft
+        checked: Cpp_IO_Network.tcpServer
+        enabled: !Cpp_IO_Manager.connected
+        visible: Cpp_IO_Network.socketTypeIndex === 0
+        onCheckedChanged: {
+          if (Cpp_IO_Network.tcpServer !== checked)
+            Cpp_IO_Network.tcpServer = checked
+        }
+      }
+
       //
       // Address
       //
@@ -102,11 +124,13 @@ Item {
         opacity: enabled ? 1 : 0.5
         enabled: !Cpp_IO_Manager.connected
         text: qsTr("Remote address") + ":"
+        visible: !(Cpp_IO_Network.socketTypeIndex === 0 && _tcpServer.checked)
       } TextField {
         id: _address
         Layout.fillWidth: true
         opacity: enabled ? 1 : 0.5
         enabled: !Cpp_IO_Manager.connected
+        visible: !(Cpp_IO_Network.socketTypeIndex === 0 && _tcpServer.checked)
         placeholderText: Cpp_IO_Network.defaultAddress
         Component.onCompleted: text = Cpp_IO_Network.remoteAddress
         onTextChanged: {
@@ -150,6 +174,16 @@ Item {
         visible: Cpp_IO_Network.socketTypeIndex === 0
       }
 
+      //
+      // Connected devices
+      //
+      Label {
+        text: qsTr("Devices") + ":"
+        visible: Cpp_IO_Network.socketTypeIndex === 0 && _tcpServer.checked
+      } Label {
+        text: Cpp_IO_Network.tcpClientCount
+        visible: Cpp_IO_Network.socketTypeIndex === 0 && _tcpServer.checked
+      }
 
       //
       // TCP port
@@ -234,6 +268,39 @@ Item {
             Cpp_IO_Network.udpMulticast = checked
         }
       }
+
+      //
+      // UDP sender demultiplexing checkbox
+      //
+      Label {
+        text: qsTr("Separate Senders") + ":"
+        opacity: _udpDemultiplex.enabled ? 1 : 0.5
+        visible: Cpp_IO_Network.socketTypeIndex === 1
+      } CheckBox {
+        id: _udpDemultiplex
+        opacity: enabled ? 1 : 0.5
+        Layout.alignment: Qt.AlignLeft
+        Layout.leftMargin: -8
+        checked: Cpp_IO_Network.udpDemultiplex
+        visible: Cpp_IO_Network.socketTypeIndex === 1
+        enabled: Cpp_IO_Network.socketTypeIndex === 1 && !Cpp_IO_Manager.connected
+
+        onCheckedChanged: {
+          if (Cpp_IO_Network.udpDemultiplex !== checked)
+            Cpp_IO_Network.udpDemultiplex = checked
+        }
+      }
+
+      //
+      // UDP senders
+      //
+      Label {
+        text: qsTr("Senders") + ":"
+        visible: Cpp_IO_Network.socketTypeIndex === 1 && _udpDemultiplex.checked
+      } Label {
+        text: Cpp_IO_Network.udpSenderCount
+        visible: Cpp_IO_Network.socketTypeIndex === 1 && _udpDemultiplex.checked
+      }
     }
 
     //
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight
+
+  //
+  // Access to properties
+  //
+  property alias speed: _speedCombo.currentIndex
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    anchors.margins: 0
+    anchors.fill: parent
+
+    GridLayout {
+      columns: 2
+      rowSpacing: 4
+      columnSpacing: 4
+      Layout.fillWidth: true
+
+      //
+      // Capture file
+      //
+      Label {
+        opacity: enabled ? 1 : 0.5
+        text: qsTr("Capture file") + ":"
+        enabled: !Cpp_IO_Manager.connected
+      } RowLayout {
+        spacing: 4
+        Layout.fillWidth: true
+
+        Label {
+          elide: Label.ElideMiddle
+          Layout.fillWidth: true
+          opacity: enabled ? 1 : 0.5
+          enabled: !Cpp_IO_Manager.connected
+          text: Cpp_IO_Replay.fileName
+        }
+
+        Button {
+          opacity: enabled ? 1 : 0.5
+          text: qsTr("Select File…")
+          enabled: !Cpp_IO_Manager.connected
+          onClicked: Cpp_IO_Replay.openFile()
+        }
+      }
+
+      //
+      // Playback speed
+      //
+      Label {
+        text: qsTr("Speed") + ":"
+      } ComboBox {
+        id: _speedCombo
+        Layout.fillWidth: true
+        model: Cpp_IO_Replay.availableSpeeds
+        currentIndex: Cpp_IO_Replay.speed
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Replay.speed)
+            Cpp_IO_Replay.speed = currentIndex
+        }
+      }
+    }
+
+    //
+    // Vertical spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
@@ -244,6 +244,39 @@ Item {
       }
     }
 
+    //
+    // Low latency mode
+    //
+    Label {
+      text: qsTr("Low Latency") + ":"
+    } CheckBox {
+      id: _lowLatency
+      Layout.maximumHeight: 18
+      Layout.leftMargin: -8
+      checked: Cpp_IO_Serial.lowLatency
+      Layout.alignment: Qt.AlignLeft | Qt.AlignVCenter | Qt.AlignLeft
+      onCheckedChanged: {
+        if (Cpp_IO_Serial.lowLatency !== checked)
+          Cpp_IO_Serial.lowLatency = checked
+      }
+    }
+
+    //
+    // OS receive buffer size (only configurable on Windows)
+    //
+    Label {
+      text: qsTr("RX Buffer (KB)") + ":"
+      visible: Qt.platform.os === "windows"
+    } SpinBox {
+      from: 0
+      to: 16384
+      editable: true
+      Layout.fillWidth: true
+      visible: Qt.platform.os === "windows"
+      value: Cpp_IO_Serial.rxBufferSize / 1024
+      onValueModified: Cpp_IO_Serial.rxBufferSize = value * 1024
+    }
+
     //
     // Vertical spacer
     //
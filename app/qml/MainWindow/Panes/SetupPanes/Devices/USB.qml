@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    anchors.margins: 0
+    anchors.fill: parent
+
+    GridLayout {
+      columns: 2
+      rowSpacing: 4
+      columnSpacing: 4
+      Layout.fillWidth: true
+      visible: Cpp_IO_USB.supported
+
+      //
+      // Device
+      //
+      Label {
+        text: qsTr("Device") + ":"
+      } RowLayout {
+        spacing: 4
+        Layout.fillWidth: true
+
+        ComboBox {
+          id: _deviceCombo
+          Layout.fillWidth: true
+          opacity: enabled ? 1 : 0.5
+          enabled: !Cpp_IO_Manager.connected
+          model: Cpp_IO_USB.availableDevices
+          currentIndex: Cpp_IO_USB.deviceIndex
+          onCurrentIndexChanged: {
+            if (currentIndex !== Cpp_IO_USB.deviceIndex)
+              Cpp_IO_USB.deviceIndex = currentIndex
+          }
+        }
+
+        Button {
+          text: qsTr("Refresh")
+          opacity: enabled ? 1 : 0.5
+          enabled: !Cpp_IO_Manager.connected
+          onClicked: Cpp_IO_USB.refreshDevices()
+        }
+      }
+    }
+
+    //
+    // libusb not available indicator
+    //
+    RowLayout {
+      spacing: 4
+      Layout.fillWidth: true
+      visible: !Cpp_IO_USB.supported
+
+      Image {
+        sourceSize: Qt.size(96, 96)
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        source: "qrc:/rcc/images/hammer.svg"
+      }
+
+      Label {
+        Layout.fillWidth: true
+        wrapMode: Label.WordWrap
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        text: qsTr("This version of Serial Studio was built without " +
+                   "libusb, raw USB devices are not available.")
+      }
+    }
+
+    //
+    // Vertical spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
@@ -49,6 +49,29 @@ Item {
     property alias networkUdpLocalPort: network.udpLocalPort
     property alias networkUdpRemotePort: network.udpRemotePort
     property alias networkUdpMulticastEnabled: network.udpMulticastEnabled
+
+    property alias replaySpeed: replay.speed
+
+    property alias generatorWaveform: generator.waveform
+    property alias generatorChannels: generator.channels
+    property alias generatorFrameRate: generator.frameRate
+    property alias generatorChecksum: generator.checksum
+
+    property alias canBusPlugin: canBus.plugin
+    property alias canBusBitRate: canBus.bitRate
+    property alias canBusFlexibleDataRate: canBus.flexibleDataRate
+
+    property alias modbusHost: modbus.host
+    property alias modbusPort: modbus.port
+    property alias modbusParity: modbus.parity
+    property alias modbusProtocol: modbus.protocol
+    property alias modbusBaudRate: modbus.baudRate
+
+    property alias audioChannels: audio.channels
+    property alias audioSampleRate: audio.sampleRate
+
+    property alias pipePath: pipe.path
+    property alias pipeSource: pipe.source
   }
 
   //
@@ -79,7 +102,7 @@ Item {
       Layout.fillWidth: true
       Layout.fillHeight: true
       currentIndex: Cpp_IO_Manager.busType
-      implicitHeight: Math.max(serial.implicitHeight, network.implicitHeight, bluetoothLE.implicitHeight)
+      implicitHeight: Math.max(serial.implicitHeight, network.implicitHeight, bluetoothLE.implicitHeight, replay.implicitHeight, generator.implicitHeight, canBus.implicitHeight, modbus.implicitHeight, usb.implicitHeight, audio.implicitHeight, pipe.implicitHeight)
 
       Devices.Serial {
         id: serial
@@ -98,6 +121,48 @@ Item {
         Layout.fillWidth: true
         Layout.fillHeight: true
       }
+
+      Devices.Replay {
+        id: replay
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.Generator {
+        id: generator
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.CANBus {
+        id: canBus
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.Modbus {
+        id: modbus
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.USB {
+        id: usb
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.Audio {
+        id: audio
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
+
+      Devices.Pipe {
+        id: pipe
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+      }
     }
   }
 }
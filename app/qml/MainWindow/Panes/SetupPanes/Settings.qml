@@ -32,7 +32,49 @@ Item {
   // Access to properties
   //
   property alias tcpPlugins: _tcpPlugins.checked
+  property alias pluginPolicy: _pluginPolicy.currentIndex
   property alias language: _langCombo.currentIndex
+  property alias bufferSize: _bufferSize.currentIndex
+  property alias overflowPolicy: _overflowPolicy.currentIndex
+  property alias csvCompression: _csvCompression.checked
+  property alias csvRotationSize: _csvRotationSize.currentIndex
+  property alias csvRotationInterval: _csvRotationInterval.currentIndex
+
+  //
+  // Priority & CPU affinity selector for a pipeline thread role
+  //
+  component ThreadSettings: RowLayout {
+    property int role: 0
+
+    spacing: 8 / 2
+    Layout.fillWidth: true
+
+    ComboBox {
+      Layout.fillWidth: true
+      model: Cpp_Misc_ThreadScheduler.priorities
+      currentIndex: Cpp_Misc_ThreadScheduler.priority(role)
+      onModelChanged: currentIndex = Cpp_Misc_ThreadScheduler.priority(role)
+      onCurrentIndexChanged: {
+        if (currentIndex !== Cpp_Misc_ThreadScheduler.priority(role))
+          Cpp_Misc_ThreadScheduler.setPriority(role, currentIndex)
+      }
+    }
+
+    TextField {
+      Layout.preferredWidth: 96
+      placeholderText: qsTr("All CPUs")
+      text: Cpp_Misc_ThreadScheduler.affinity(role)
+      visible: Cpp_Misc_ThreadScheduler.affinitySupported
+      color: Cpp_Misc_ThreadScheduler.validateAffinity(text) ?
+               palette.text : Cpp_ThemeManager.colors["error"]
+      onEditingFinished: {
+        if (Cpp_Misc_ThreadScheduler.validateAffinity(text))
+          Cpp_Misc_ThreadScheduler.setAffinity(role, text)
+        else
+          text = Cpp_Misc_ThreadScheduler.affinity(role)
+      }
+    }
+  }
 
   //
   // Background
@@ -96,6 +138,165 @@ Item {
         }
       }
 
+      //
+      // UI refresh rate selector
+      //
+      Label {
+        text: qsTr("UI Refresh Rate") + ":"
+      } ComboBox {
+        id: _refreshRateCombo
+        Layout.fillWidth: true
+        readonly property var rates: [10, 24, 30, 60]
+        model: rates.map(function(hz) { return qsTr("%1 Hz").arg(hz) })
+        currentIndex: rates.indexOf(Cpp_Misc_TimerEvents.uiRefreshRate)
+        onCurrentIndexChanged: {
+          const hz = rates[currentIndex]
+          if (currentIndex >= 0 && hz !== Cpp_Misc_TimerEvents.uiRefreshRate)
+            Cpp_Misc_TimerEvents.uiRefreshRate = hz
+        }
+      }
+
+      //
+      // Adaptive UI refresh rate
+      //
+      Label {
+        text: qsTr("Adaptive Refresh") + ":"
+      } Switch {
+        Layout.leftMargin: -8
+        Layout.alignment: Qt.AlignLeft
+        checked: Cpp_Misc_TimerEvents.adaptiveRefresh
+        palette.highlight: Cpp_ThemeManager.colors["switch_highlight"]
+        onCheckedChanged: {
+          if (checked !== Cpp_Misc_TimerEvents.adaptiveRefresh)
+            Cpp_Misc_TimerEvents.adaptiveRefresh = checked
+        }
+      }
+
+      //
+      // Low-power mode
+      //
+      Label {
+        text: qsTr("Low-Power Mode") + ":"
+      } Switch {
+        Layout.leftMargin: -8
+        Layout.alignment: Qt.AlignLeft
+        checked: Cpp_Misc_TimerEvents.lowPowerMode
+        palette.highlight: Cpp_ThemeManager.colors["switch_highlight"]
+        onCheckedChanged: {
+          if (checked !== Cpp_Misc_TimerEvents.lowPowerMode)
+            Cpp_Misc_TimerEvents.lowPowerMode = checked
+        }
+      }
+
+      //
+      // Graphics API selector
+      //
+      Label {
+        text: qsTr("Graphics API") + ":"
+      } ComboBox {
+        Layout.fillWidth: true
+        model: Cpp_Misc_GraphicsBackend.graphicsApis
+        currentIndex: Cpp_Misc_GraphicsBackend.graphicsApi
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_Misc_GraphicsBackend.graphicsApi)
+            Cpp_Misc_GraphicsBackend.graphicsApi = currentIndex
+        }
+      }
+
+      //
+      // Scene graph render loop selector
+      //
+      Label {
+        text: qsTr("Render Loop") + ":"
+      } ComboBox {
+        Layout.fillWidth: true
+        model: Cpp_Misc_GraphicsBackend.renderLoops
+        currentIndex: Cpp_Misc_GraphicsBackend.renderLoop
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_Misc_GraphicsBackend.renderLoop)
+            Cpp_Misc_GraphicsBackend.renderLoop = currentIndex
+        }
+      }
+
+      //
+      // Graphics backend in use & frame-time graph
+      //
+      Label {
+        text: qsTr("Frame Times") + ":"
+        Layout.alignment: Qt.AlignTop
+      } ColumnLayout {
+        spacing: 2
+        Layout.fillWidth: true
+
+        Label {
+          opacity: 0.6
+          Layout.fillWidth: true
+          elide: Label.ElideRight
+          font: Cpp_Misc_CommonFonts.monoFont
+          text: qsTr("%1 FPS, %2 ms render, %3 ms max").arg(
+                  Cpp_Misc_GraphicsBackend.frameRate.toFixed(1)).arg(
+                  Cpp_Misc_GraphicsBackend.averageRenderTime.toFixed(2)).arg(
+                  Cpp_Misc_GraphicsBackend.maxFrameInterval.toFixed(1))
+        }
+
+        //
+        // Frame intervals (bars) & render times (inner bars), the line marks
+        // the interval of a 60 Hz display
+        //
+        Rectangle {
+          id: _frameGraph
+          radius: 2
+          border.width: 1
+          clip: true
+          Layout.fillWidth: true
+          Layout.preferredHeight: 48
+          color: Cpp_ThemeManager.colors["widget_base"]
+          border.color: Cpp_ThemeManager.colors["widget_border"]
+
+          readonly property real scale: Math.max(1000 / 30, Cpp_Misc_GraphicsBackend.maxFrameInterval)
+          readonly property real barWidth: (width - 2) / 100
+
+          Repeater {
+            model: Cpp_Misc_GraphicsBackend.frameIntervals
+            delegate: Rectangle {
+              readonly property real render: Cpp_Misc_GraphicsBackend.renderTimes[index] || 0
+
+              y: _frameGraph.height - 1 - height
+              width: Math.max(1, _frameGraph.barWidth - 1)
+              x: _frameGraph.width - 1 - (Cpp_Misc_GraphicsBackend.frameIntervals.length - index) * _frameGraph.barWidth
+              color: Cpp_ThemeManager.colors["highlight"]
+              opacity: 0.5
+              height: Math.min(1, modelData / _frameGraph.scale) * (_frameGraph.height - 2)
+
+              Rectangle {
+                width: parent.width
+                anchors.bottom: parent.bottom
+                color: Cpp_ThemeManager.colors["widget_text"]
+                height: Math.min(1, parent.render / _frameGraph.scale) * (_frameGraph.height - 2)
+              }
+            }
+          }
+
+          Rectangle {
+            x: 1
+            height: 1
+            opacity: 0.5
+            width: parent.width - 2
+            color: Cpp_ThemeManager.colors["alarm"]
+            y: _frameGraph.height - 1 - (1000 / 60) / _frameGraph.scale * (_frameGraph.height - 2)
+          }
+        }
+
+        Label {
+          opacity: 0.6
+          Layout.fillWidth: true
+          wrapMode: Label.WordWrap
+          text: Cpp_Misc_GraphicsBackend.restartRequired ?
+                  qsTr("%1 (restart to apply the new options)").arg(Cpp_Misc_GraphicsBackend.activeBackend) :
+                  Cpp_Misc_GraphicsBackend.activeBackend
+        }
+      }
+
       //
       // Plugins enabled
       //
@@ -113,6 +314,192 @@ Item {
         }
       }
 
+      //
+      // Slow plugin policy
+      //
+      Label {
+        text: qsTr("Slow Plugins") + ":"
+      } ComboBox {
+        id: _pluginPolicy
+        Layout.fillWidth: true
+        model: Cpp_Plugins_Bridge.slowClientPolicies
+        currentIndex: Cpp_Plugins_Bridge.slowClientPolicy
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_Plugins_Bridge.slowClientPolicy)
+            Cpp_Plugins_Bridge.slowClientPolicy = currentIndex
+        }
+      }
+
+      //
+      // Remote node viewer
+      //
+      Label {
+        text: qsTr("Remote Node") + ":"
+      } RowLayout {
+        spacing: 8 / 2
+        Layout.fillWidth: true
+
+        TextField {
+          Layout.fillWidth: true
+          opacity: enabled ? 1 : 0.5
+          placeholderText: "127.0.0.1"
+          text: Cpp_Plugins_Viewer.host
+          enabled: !Cpp_Plugins_Viewer.isConnectedToHost
+          onEditingFinished: {
+            if (text.length > 0 && text !== Cpp_Plugins_Viewer.host)
+              Cpp_Plugins_Viewer.host = text
+          }
+        }
+
+        TextField {
+          Layout.preferredWidth: 64
+          opacity: enabled ? 1 : 0.5
+          placeholderText: Cpp_Plugins_Viewer.defaultPort
+          enabled: !Cpp_Plugins_Viewer.isConnectedToHost
+          Component.onCompleted: text = Cpp_Plugins_Viewer.port
+          onEditingFinished: {
+            if (text.length === 0)
+              Cpp_Plugins_Viewer.port = Cpp_Plugins_Viewer.defaultPort
+            else if (Cpp_Plugins_Viewer.port !== text)
+              Cpp_Plugins_Viewer.port = text
+          }
+
+          validator: IntValidator {
+            bottom: 1
+            top: 65535
+          }
+        }
+
+        Button {
+          onClicked: Cpp_Plugins_Viewer.toggleConnection()
+          text: Cpp_Plugins_Viewer.isConnectedToHost ? qsTr("Disconnect") :
+                                                       qsTr("Connect")
+        }
+      }
+
+      //
+      // Frame reader buffer size
+      //
+      Label {
+        text: qsTr("Input Buffer") + ":"
+      } ComboBox {
+        id: _bufferSize
+        Layout.fillWidth: true
+        model: Cpp_IO_Manager.bufferSizes
+        currentIndex: Cpp_IO_Manager.bufferSize
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Manager.bufferSize)
+            Cpp_IO_Manager.bufferSize = currentIndex
+        }
+      }
+
+      //
+      // Frame reader overflow policy
+      //
+      Label {
+        text: qsTr("Buffer Overflow") + ":"
+      } ComboBox {
+        id: _overflowPolicy
+        Layout.fillWidth: true
+        model: Cpp_IO_Manager.overflowPolicies
+        currentIndex: Cpp_IO_Manager.overflowPolicy
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_IO_Manager.overflowPolicy)
+            Cpp_IO_Manager.overflowPolicy = currentIndex
+        }
+      }
+
+      //
+      // CSV file compression
+      //
+      Label {
+        text: qsTr("Compress CSV Files") + ":"
+      } Switch {
+        id: _csvCompression
+        Layout.leftMargin: -8
+        Layout.alignment: Qt.AlignLeft
+        checked: Cpp_CSV_Export.compressFiles
+        palette.highlight: Cpp_ThemeManager.colors["switch_highlight"]
+        onCheckedChanged: {
+          if (checked !== Cpp_CSV_Export.compressFiles)
+            Cpp_CSV_Export.compressFiles = checked
+        }
+      }
+
+      //
+      // CSV file rotation
+      //
+      Label {
+        text: qsTr("CSV File Size") + ":"
+      } ComboBox {
+        id: _csvRotationSize
+        Layout.fillWidth: true
+        model: Cpp_CSV_Export.rotationSizes
+        currentIndex: Cpp_CSV_Export.rotationSize
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_CSV_Export.rotationSize)
+            Cpp_CSV_Export.rotationSize = currentIndex
+        }
+      }
+
+      Label {
+        text: qsTr("CSV File Duration") + ":"
+      } ComboBox {
+        id: _csvRotationInterval
+        Layout.fillWidth: true
+        model: Cpp_CSV_Export.rotationIntervals
+        currentIndex: Cpp_CSV_Export.rotationInterval
+        onCurrentIndexChanged: {
+          if (currentIndex !== Cpp_CSV_Export.rotationInterval)
+            Cpp_CSV_Export.rotationInterval = currentIndex
+        }
+      }
+
+      //
+      // Pipeline thread priorities & CPU affinities
+      //
+      Label {
+        text: qsTr("Reader Thread") + ":"
+      } ThreadSettings {
+        role: 0
+      }
+
+      Label {
+        text: qsTr("Parser Thread") + ":"
+      } ThreadSettings {
+        role: 1
+      }
+
+      Label {
+        text: qsTr("Export Thread") + ":"
+      } ThreadSettings {
+        role: 2
+      }
+
+      Label {
+        text: qsTr("Network Thread") + ":"
+      } ThreadSettings {
+        role: 3
+      }
+
+      //
+      // Lock the process memory in RAM
+      //
+      Label {
+        text: qsTr("Lock Memory") + ":"
+        visible: Cpp_Misc_ThreadScheduler.memoryLockSupported
+      } Switch {
+        Layout.leftMargin: -8
+        Layout.alignment: Qt.AlignLeft
+        checked: Cpp_Misc_ThreadScheduler.lockMemory
+        visible: Cpp_Misc_ThreadScheduler.memoryLockSupported
+        palette.highlight: Cpp_ThemeManager.colors["switch_highlight"]
+        onCheckedChanged: {
+          if (checked !== Cpp_Misc_ThreadScheduler.lockMemory)
+            Cpp_Misc_ThreadScheduler.lockMemory = checked
+        }
+      }
+
       //
       // Auto-updater
       //
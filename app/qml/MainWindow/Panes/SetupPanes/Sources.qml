@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import QtQuick.Layouts
+import QtQuick.Controls
+
+Item {
+  id: root
+  implicitHeight: layout.implicitHeight + 16
+
+  //
+  // Background
+  //
+  Rectangle {
+    radius: 2
+    border.width: 1
+    anchors.fill: parent
+    color: Cpp_ThemeManager.colors["groupbox_background"]
+    border.color: Cpp_ThemeManager.colors["groupbox_border"]
+  }
+
+  //
+  // Layout
+  //
+  ColumnLayout {
+    id: layout
+    spacing: 4
+    anchors.fill: parent
+    anchors.margins: 8
+
+    //
+    // New source controls
+    //
+    GridLayout {
+      columns: 2
+      Layout.fillWidth: true
+      rowSpacing: 8 / 2
+      columnSpacing: 8 / 2
+      enabled: !Cpp_IO_Manager.connected
+
+      //
+      // Source type
+      //
+      Label {
+        text: qsTr("Type") + ":"
+      } ComboBox {
+        id: _type
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        model: Cpp_IO_Manager.sourceTypes
+      }
+
+      //
+      // Serial port name
+      //
+      Label {
+        visible: _type.currentIndex === 0
+        text: qsTr("COM Port") + ":"
+      } TextField {
+        id: _portName
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        visible: _type.currentIndex === 0
+        placeholderText: qsTr("e.g. COM3 or /dev/ttyUSB1")
+      }
+
+      //
+      // Baud rate or UDP port
+      //
+      Label {
+        text: _type.currentIndex === 0 ? qsTr("Baud Rate") + ":" :
+                                         qsTr("Local Port") + ":"
+      } TextField {
+        id: _setting
+        Layout.fillWidth: true
+        opacity: enabled ? 1 : 0.5
+        placeholderText: _type.currentIndex === 0 ? "115200" : "5000"
+        validator: IntValidator {
+          bottom: 1
+          top: 10000000
+        }
+      }
+    }
+
+    //
+    // Add source button
+    //
+    Button {
+      Layout.alignment: Qt.AlignRight
+      text: qsTr("Add Source")
+      opacity: enabled ? 1 : 0.5
+      enabled: !Cpp_IO_Manager.connected &&
+               (_type.currentIndex !== 0 || _portName.text.length > 0)
+      onClicked: {
+        const value = _setting.text.length > 0 ? parseInt(_setting.text) :
+                                                 parseInt(_setting.placeholderText)
+        Cpp_IO_Manager.addSource(_type.currentIndex, _portName.text, value)
+      }
+    }
+
+    //
+    // Spacer
+    //
+    Item {
+      implicitHeight: 4
+    }
+
+    //
+    // List of additional sources
+    //
+    Repeater {
+      model: Cpp_IO_Manager.sources
+      delegate: RowLayout {
+        spacing: 4
+        Layout.fillWidth: true
+
+        Label {
+          Layout.fillWidth: true
+          elide: Label.ElideRight
+          text: (index + 1) + ". " + modelData
+        }
+
+        Button {
+          icon.width: 12
+          icon.height: 12
+          opacity: enabled ? 1 : 0.5
+          Layout.maximumWidth: height
+          icon.color: palette.buttonText
+          enabled: !Cpp_IO_Manager.connected
+          onClicked: Cpp_IO_Manager.removeSource(index)
+          icon.source: "qrc:/rcc/icons/buttons/close.svg"
+        }
+      }
+    }
+
+    //
+    // Spacer
+    //
+    Item {
+      Layout.fillHeight: true
+    }
+
+    //
+    // Help label
+    //
+    Label {
+      opacity: 0.6
+      Layout.fillWidth: true
+      wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+      text: qsTr("Additional sources are connected together with the main " +
+                 "device. In Quick Plot mode, their channels are merged into " +
+                 "the same dashboard & tagged with the name of each source.")
+    }
+  }
+}
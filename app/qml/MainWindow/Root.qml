@@ -94,6 +94,16 @@ Widgets.SmartWindow {
     onTriggered: toolbar.dashboardClicked()
   }
 
+  //
+  // Check for updates once the window is on screen, so that slow DNS lookups
+  // or TLS handshakes do not delay the startup of the application
+  //
+  Timer {
+    id: updateTimer
+    interval: 5000
+    onTriggered: Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
+  }
+
   //
   // Update document title automatically
   //
@@ -109,6 +119,15 @@ Widgets.SmartWindow {
     function onLanguageChanged() { root.updateDocumentTitle() }
   }
 
+  //
+  // Save the flight recorder window on demand
+  //
+  Shortcut {
+    sequence: "Ctrl+Shift+R"
+    enabled: Cpp_CSV_FlightRecorder.enabled
+    onActivated: Cpp_CSV_FlightRecorder.trigger()
+  }
+
   //
   // Show console tab on serial disconnect
   //
@@ -167,7 +186,7 @@ Widgets.SmartWindow {
     if (root.appLaunchCount == 2 && Cpp_UpdaterEnabled) {
       if (Cpp_Misc_Utilities.askAutomaticUpdates()) {
         root.automaticUpdates = true
-        Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
+        updateTimer.start()
       }
 
       else
@@ -176,7 +195,7 @@ Widgets.SmartWindow {
 
     // Check for updates (if we are allowed)
     if (root.automaticUpdates && Cpp_UpdaterEnabled)
-      Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
+      updateTimer.start()
 
     // Obtain document title from JSON project editor & display the window
     root.updateDocumentTitle()
@@ -49,22 +49,16 @@ Widgets.SmartWindow {
   onClosing: (close) => close.accepted = Cpp_JSON_ProjectModel.askSave()
 
   //
-  // Ensure that current JSON file is shown
+  // Build the editor models for the current project while the window is shown
   //
   onVisibleChanged: {
-    if (visible) {
+    if (visible)
       Cpp_NativeWindow.addWindow(root)
-      Cpp_JSON_ProjectModel.openJsonFile(Cpp_JSON_FrameBuilder.jsonMapFilepath)
-    }
-
     else
       Cpp_NativeWindow.removeWindow(root)
-  }
 
-  //
-  // Load project file on start
-  //
-  Component.onCompleted: Cpp_JSON_ProjectModel.openJsonFile(Cpp_JSON_FrameBuilder.jsonMapFilepath)
+    Cpp_JSON_ProjectModel.editorActive = visible
+  }
 
   //
   // Dummy string to increase width of buttons
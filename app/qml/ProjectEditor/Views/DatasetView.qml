@@ -130,6 +130,23 @@ Widgets.Pane {
           }
         }
 
+        //
+        // Add waterfall plot
+        //
+        Widgets.BigButton {
+          iconSize: 24
+          toolbarButton: false
+          text: qsTr("Waterfall")
+          Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
+          icon.source: "qrc:/rcc/icons/project-editor/actions/waterfall.svg"
+          checked: Cpp_JSON_ProjectModel.datasetOptions & SerialStudio.DatasetWaterfall
+          onClicked: {
+            const option = SerialStudio.DatasetWaterfall
+            const value = Cpp_JSON_ProjectModel.datasetOptions & option
+            Cpp_JSON_ProjectModel.changeDatasetOption(option, !value)
+          }
+        }
+
         //
         // Add bar
         //
@@ -103,7 +103,7 @@ Item {
           margins: parent.border.width
         }
 
-        visible: root.model.alarmValue !== 0 && root.model.value >= root.model.alarmValue
+        visible: root.model.alarm
       }
     }
 
@@ -131,7 +131,7 @@ Item {
       minValue: model.minValue
       maximumWidth: root.width * 0.3
       rangeVisible: root.height >= 120
-      alarm: root.model.alarmValue !== 0 && root.model.value >= root.model.alarmValue
+      alarm: root.model.alarm
 
       Layout.fillHeight: true
       Layout.minimumWidth: implicitWidth
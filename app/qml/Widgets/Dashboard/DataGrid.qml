@@ -40,6 +40,7 @@ Item {
   // Responsive design stuff
   //
   readonly property bool unitsVisible: root.height >= 120
+  readonly property bool statisticsVisible: root.width >= 560
 
   //
   // Create scrollable grid view with LED states
@@ -58,8 +59,8 @@ Item {
 
     GridLayout {
       id: grid
-      columns: 2
       rowSpacing: 4
+      columns: root.statisticsVisible ? 1 : 2
       columnSpacing: 4
       width: parent.width - 8
       anchors.centerIn: parent
@@ -129,6 +130,17 @@ Item {
               horizontalAlignment: Label.AlignLeft
               visible: text !== "" && root.unitsVisible
             }
+
+            Label {
+              elide: Qt.ElideRight
+              Layout.fillWidth: true
+              text: root.model.statistics[index]
+              Layout.alignment: Qt.AlignVCenter | Qt.AlignRight
+              font: Cpp_Misc_CommonFonts.monoFont
+              horizontalAlignment: Label.AlignRight
+              color: Cpp_ThemeManager.colors["widget_text"]
+              visible: text !== "" && root.statisticsVisible
+            }
           }
         }
       }
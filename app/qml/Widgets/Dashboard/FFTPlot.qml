@@ -21,7 +21,6 @@
  */
 
 import QtQuick
-import QtGraphs
 import SerialStudio
 
 import "../"
@@ -42,7 +41,7 @@ Item {
     repeat: true
     interval: 1000 / 24
     running: root.visible
-    onTriggered: root.model.draw(lineSeries)
+    onTriggered: root.model.draw(lineRenderer)
   }
 
   //
@@ -61,13 +60,19 @@ Item {
     xLabel: qsTr("Frequency (Hz)")
     xAxis.tickInterval: root.model.xTickInterval
     yAxis.tickInterval: root.model.yTickInterval
-    Component.onCompleted: graph.addSeries(lineSeries)
 
     //
     // Curve element
     //
-    LineSeries {
-      id: lineSeries
+    LineRenderer {
+      id: lineRenderer
+      color: root.color
+      parent: plot.plotArea
+      anchors.fill: parent
+      xMin: root.model.minX
+      xMax: root.model.maxX
+      yMin: root.model.minY
+      yMax: root.model.maxY
     }
   }
 }
@@ -59,6 +59,19 @@ Item {
       root.previousLongitude = root.longitude
       map.center = QtPositioning.coordinate(root.latitude, root.longitude)
     }
+
+    prefetchTimer.start()
+  }
+
+  //
+  // Asks the map to download the tiles around the current position, at most
+  // once per second, so that they are already cached when the map moves
+  //
+  Timer {
+    id: prefetchTimer
+    interval: 1000
+    repeat: false
+    onTriggered: map.prefetchData()
   }
 
   //
@@ -129,6 +142,55 @@ Item {
           onClicked: map.center = QtPositioning.coordinate(root.latitude, root.longitude)
         }
 
+        Button {
+          icon.width: 18
+          icon.height: 18
+          Layout.minimumWidth: 24
+          Layout.maximumWidth: 24
+          Layout.minimumHeight: 24
+          Layout.maximumHeight: 24
+          onClicked: root.model.clearTrack()
+          Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+          icon.color: Cpp_ThemeManager.colors["text"]
+          icon.source: "qrc:/rcc/icons/buttons/clear.svg"
+        }
+
+        Button {
+          icon.width: 18
+          icon.height: 18
+          Layout.minimumWidth: 24
+          Layout.maximumWidth: 24
+          Layout.minimumHeight: 24
+          Layout.maximumHeight: 24
+          Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+          icon.color: Cpp_ThemeManager.colors["text"]
+          icon.source: Cpp_Misc_TileCache.prefetching ?
+                         "qrc:/rcc/icons/buttons/close.svg" :
+                         "qrc:/rcc/icons/buttons/save.svg"
+          onClicked: {
+            if (Cpp_Misc_TileCache.prefetching) {
+              Cpp_Misc_TileCache.cancelPrefetch()
+              return
+            }
+
+            const region = map.visibleRegion.boundingGeoRectangle()
+            const zoom = Math.floor(map.zoomLevel)
+            Cpp_Misc_TileCache.prefetch(region.topLeft.latitude,
+                                        region.topLeft.longitude,
+                                        region.bottomRight.latitude,
+                                        region.bottomRight.longitude,
+                                        zoom, Math.min(zoom + 4, 18))
+          }
+        }
+
+        Label {
+          visible: Cpp_Misc_TileCache.prefetching
+          Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+          color: Cpp_ThemeManager.colors["text"]
+          text: qsTr("%1/%2").arg(Cpp_Misc_TileCache.prefetchCompleted)
+                             .arg(Cpp_Misc_TileCache.prefetchTotal)
+        }
+
         ComboBox {
           id: mapType
           Layout.fillWidth: true
@@ -176,6 +238,36 @@ Item {
             name: "osm.mapping.providersrepository.address"
             value: Cpp_JSON_ProjectModel.osmAddress
           }
+
+          PluginParameter {
+            name: "osm.mapping.cache.directory"
+            value: Cpp_JSON_ProjectModel.osmCachePath
+          }
+
+          PluginParameter {
+            name: "osm.mapping.cache.disk.cost_strategy"
+            value: "bytesize"
+          }
+
+          PluginParameter {
+            name: "osm.mapping.cache.disk.size"
+            value: 256 * 1024 * 1024
+          }
+
+          PluginParameter {
+            name: "osm.mapping.prefetching_style"
+            value: "TwoNeighbourLayers"
+          }
+        }
+
+        //
+        // Trajectory followed by the GPS
+        //
+        MapPolyline {
+          line.width: 3
+          opacity: 0.8
+          line.color: root.color
+          path: root.model.track
         }
 
         //
@@ -101,7 +101,7 @@ Item {
         visible: control.alarmEnabled
 
         Behavior on opacity {NumberAnimation{}}
-        opacity: root.model.value >= root.model.alarmValue ? 1 : 0.5
+        opacity: root.model.alarm ? 1 : 0.5
 
         ShapePath {
           capStyle: Qt.RoundCap
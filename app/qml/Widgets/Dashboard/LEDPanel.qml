@@ -21,8 +21,6 @@
  */
 
 import QtQuick
-import QtQuick.Effects
-import QtQuick.Layouts
 import QtQuick.Controls
 
 import SerialStudio
@@ -51,7 +49,10 @@ Item {
       id: scroll
     }
 
-    GridLayout {
+    //
+    // Cell backgrounds & LED titles
+    //
+    Grid {
       id: grid
       columns: 2
       rowSpacing: 4
@@ -63,94 +64,42 @@ Item {
       Repeater {
         model: root.model.count
         delegate: Rectangle {
+          height: 32
           border.width: 1
-          Layout.fillWidth: true
-          Layout.minimumHeight: 32
-          Layout.maximumHeight: 32
+          width: (grid.width - (grid.columns - 1) * grid.columnSpacing) / grid.columns
           color: Cpp_ThemeManager.colors["widget_base"]
           border.color: Cpp_ThemeManager.colors["widget_border"]
 
-          RowLayout {
-            id: layout
-            spacing: 0
-            anchors.margins: 4
+          Label {
+            elide: Qt.ElideRight
             anchors.left: parent.left
             anchors.right: parent.right
+            anchors.leftMargin: 34
+            anchors.rightMargin: 4
+            text: root.model.titles[index]
             anchors.verticalCenter: parent.verticalCenter
+            font: Cpp_Misc_CommonFonts.monoFont
+            horizontalAlignment: Label.AlignLeft
+            color: root.model.alarms[index] ? Cpp_ThemeManager.colors["alarm"] :
+                                              Cpp_ThemeManager.colors["widget_text"]
 
-            Item {
-              Layout.fillWidth: true
-            }
-
-            Rectangle {
-              id: led
-              readonly property color ledColor: root.model.alarms[index] ? Cpp_ThemeManager.colors["alarm"] :
-                                                                           root.model.colors[index]
-
-              border.width: 1
-              implicitWidth: 18
-              implicitHeight: 18
-              radius: implicitWidth / 2
-              Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
-              border.color: Cpp_ThemeManager.colors["widget_border"]
-              color: root.model.states[index] ? ledColor : Qt.darker(ledColor)
-
-              Behavior on color {ColorAnimation{}}
-            }
-
-            Item {
-              Layout.fillWidth: true
-              Layout.minimumWidth: 4
-            }
-
-            Label {
-              elide: Qt.ElideRight
-              text: root.model.titles[index]
-              Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft 
-              font: Cpp_Misc_CommonFonts.monoFont
-              horizontalAlignment: Label.AlignLeft
-              Layout.maximumWidth: layout.width - 4 - 24
-              color: root.model.alarms[index] ? Cpp_ThemeManager.colors["alarm"] :
-                                                Cpp_ThemeManager.colors["widget_text"]
-
-              Behavior on color {ColorAnimation{}}
-            }
-
-            Item {
-              Layout.fillWidth: true
-              Layout.minimumWidth: 4
-            }
-          }
-
-          MultiEffect {
-            source: led
-            width: led.width
-            height: led.height
-            x: layout.x + led.x
-            y: layout.y + led.y
-
-            blurEnabled: true
-            blur: root.model.states[index] ? 1 : 0
-            blurMax: root.model.states[index] ? 64 : 0
-            brightness: root.model.states[index] ? 0.4 : 0
-            saturation: root.model.states[index] ? 0.2 : 0
-          }
-
-          MultiEffect {
-            source: led
-            width: led.width
-            height: led.height
-            x: layout.x + led.x
-            y: layout.y + led.y
-
-            blurEnabled: true
-            blur: root.model.states[index] ? 0.3 : 0
-            blurMax: root.model.states[index] ? 64 : 0
-            brightness: root.model.states[index] ? 0.4 : 0
-            saturation: root.model.states[index] ? 0.2 : 0
+            Behavior on color {ColorAnimation{}}
           }
         }
       }
     }
+
+    //
+    // All the LEDs of the panel, drawn in a single batch over the cells
+    //
+    LEDRenderer {
+      x: grid.x
+      y: grid.y
+      model: root.model
+      width: grid.width
+      height: grid.height
+      columns: grid.columns
+      spacing: grid.rowSpacing
+    }
   }
 }
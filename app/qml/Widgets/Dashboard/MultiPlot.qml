@@ -21,7 +21,6 @@
  */
 
 import QtQuick
-import QtGraphs
 import SerialStudio
 import QtQuick.Layouts
 import QtQuick.Controls
@@ -45,12 +44,25 @@ Item {
     interval: 1000 / 24
     running: root.visible
     onTriggered: {
-      const count = plot.graph.seriesList.length
-      for (let i = 0; i < count; ++i)
-        root.model.draw(plot.graph.seriesList[i], i)
+      for (let i = 0; i < curves.count; ++i)
+        root.model.draw(curves.itemAt(i), i)
+
+      if (root.model.hasReference) {
+        for (let j = 0; j < references.count; ++j)
+          root.model.drawReference(references.itemAt(j), j)
+      }
     }
   }
 
+  //
+  // Decimate the curves to the width of the plot
+  //
+  Binding {
+    target: root.model
+    property: "pixelWidth"
+    value: Math.round(plot.width)
+  }
+
 
   RowLayout {
     spacing: 4
@@ -75,12 +87,39 @@ Item {
       yAxis.tickInterval: root.model.yTickInterval
 
       //
-      // Register curves
+      // Curve elements
       //
-      Instantiator {
-        model: root.model.count
-        delegate: LineSeries {
-          Component.onCompleted: plot.graph.addSeries(this)
+      Item {
+        parent: plot.plotArea
+        anchors.fill: parent
+
+        Repeater {
+          id: references
+          model: root.model.hasReference ? root.model.count : 0
+          delegate: LineRenderer {
+            required property int index
+            readonly property color curveColor: root.model.colors[index]
+            anchors.fill: parent
+            xMin: root.model.minX
+            xMax: root.model.maxX
+            yMin: root.model.minY
+            yMax: root.model.maxY
+            color: Qt.rgba(curveColor.r, curveColor.g, curveColor.b, 0.4)
+          }
+        }
+
+        Repeater {
+          id: curves
+          model: root.model.count
+          delegate: LineRenderer {
+            required property int index
+            anchors.fill: parent
+            xMin: root.model.minX
+            xMax: root.model.maxX
+            yMin: root.model.minY
+            yMax: root.model.maxY
+            color: root.model.colors[index]
+          }
         }
       }
     }
@@ -21,7 +21,6 @@
  */
 
 import QtQuick
-import QtGraphs
 import SerialStudio
 
 import "../"
@@ -42,7 +41,20 @@ Item {
     repeat: true
     interval: 1000 / 24
     running: root.visible
-    onTriggered: root.model.draw(lineSeries)
+    onTriggered: {
+      root.model.draw(lineRenderer)
+      if (root.model.hasReference)
+        root.model.drawReference(referenceRenderer)
+    }
+  }
+
+  //
+  // Decimate the curves to the width of the plot
+  //
+  Binding {
+    target: root.model
+    property: "pixelWidth"
+    value: Math.round(plot.width)
   }
 
   //
@@ -56,18 +68,39 @@ Item {
     xMax: root.model.maxX
     yMin: root.model.minY
     yMax: root.model.maxY
-    xLabel: qsTr("Samples")
+    xLabel: root.model.xLabel
     curveColors: [root.color]
     yLabel: root.model.yLabel
     xAxis.tickInterval: root.model.xTickInterval
     yAxis.tickInterval: root.model.yTickInterval
-    Component.onCompleted: graph.addSeries(lineSeries)
+
+    //
+    // Reference session overlay
+    //
+    LineRenderer {
+      id: referenceRenderer
+      parent: plot.plotArea
+      anchors.fill: parent
+      xMin: root.model.minX
+      xMax: root.model.maxX
+      yMin: root.model.minY
+      yMax: root.model.maxY
+      visible: root.model.hasReference
+      color: Qt.rgba(root.color.r, root.color.g, root.color.b, 0.4)
+    }
 
     //
     // Curve element
     //
-    LineSeries {
-      id: lineSeries
+    LineRenderer {
+      id: lineRenderer
+      color: root.color
+      parent: plot.plotArea
+      anchors.fill: parent
+      xMin: root.model.minX
+      xMax: root.model.maxX
+      yMin: root.model.minY
+      yMax: root.model.maxY
     }
   }
 }
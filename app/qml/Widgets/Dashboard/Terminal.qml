@@ -57,6 +57,9 @@ Item {
     property alias vt100Enabled: terminal.vt100emulation
     property alias lineEnding: lineEndingCombo.currentIndex
     property alias displayMode: displayModeCombo.currentIndex
+    property alias searchRegex: regexCheck.checked
+    property alias searchFilter: filterCheck.checked
+    property alias searchCaseSensitive: caseCheck.checked
   }
 
   //
@@ -114,6 +117,9 @@ Item {
   } Shortcut {
     onActivated: Cpp_IO_Console.print()
     sequences: [StandardKey.Print]
+  } Shortcut {
+    onActivated: searchField.forceActiveFocus()
+    sequences: [StandardKey.Find]
   }
 
   //
@@ -182,6 +188,109 @@ Item {
     anchors.fill: parent
     anchors.topMargin: -6
 
+    //
+    // Search controls
+    //
+    RowLayout {
+      Layout.fillWidth: true
+
+      TextField {
+        id: searchField
+        implicitHeight: 24
+        font: terminal.font
+        Layout.fillWidth: true
+        text: terminal.searchText
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        placeholderText: qsTr("Search") + "..."
+        onTextChanged: terminal.searchText = text
+        palette.base: Cpp_ThemeManager.colors["console_base"]
+        palette.text: Cpp_ThemeManager.colors["console_text"]
+        palette.highlight: Cpp_ThemeManager.colors["console_highlight"]
+        palette.highlightedText: Cpp_ThemeManager.colors["console_text"]
+        palette.placeholderText: Cpp_ThemeManager.colors["placeholder_text"]
+
+        background: Rectangle {
+          border.width: 1
+          color: Cpp_ThemeManager.colors["console_base"]
+          border.color: Cpp_ThemeManager.colors["console_border"]
+        }
+
+        //
+        // Go to the next match on <enter>, clear the search on <escape>
+        //
+        Keys.onReturnPressed: terminal.findNext()
+        Keys.onEscapePressed: searchField.clear()
+      }
+
+      Label {
+        opacity: 0.8
+        visible: searchField.text.length > 0
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        text: terminal.currentMatch > 0 ?
+                qsTr("%1 of %2").arg(terminal.currentMatch).arg(terminal.matchCount) :
+                qsTr("%1 matches").arg(terminal.matchCount)
+      }
+
+      Button {
+        icon.width: 18
+        icon.height: 18
+        implicitHeight: 24
+        Layout.maximumWidth: 24
+        opacity: enabled ? 1 : 0.5
+        enabled: terminal.matchCount > 0
+        onClicked: terminal.findPrevious()
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        icon.source: "qrc:/rcc/icons/buttons/media-prev.svg"
+        icon.color: Cpp_ThemeManager.colors["button_text"]
+      }
+
+      Button {
+        icon.width: 18
+        icon.height: 18
+        implicitHeight: 24
+        Layout.maximumWidth: 24
+        opacity: enabled ? 1 : 0.5
+        enabled: terminal.matchCount > 0
+        onClicked: terminal.findNext()
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        icon.source: "qrc:/rcc/icons/buttons/media-next.svg"
+        icon.color: Cpp_ThemeManager.colors["button_text"]
+      }
+
+      CheckBox {
+        id: regexCheck
+        text: qsTr("Regex")
+        checked: terminal.searchRegex
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        onCheckedChanged: {
+          if (terminal.searchRegex !== checked)
+            terminal.searchRegex = checked
+        }
+      }
+
+      CheckBox {
+        id: caseCheck
+        text: qsTr("Match Case")
+        checked: terminal.searchCaseSensitive
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        onCheckedChanged: {
+          if (terminal.searchCaseSensitive !== checked)
+            terminal.searchCaseSensitive = checked
+        }
+      }
+
+      CheckBox {
+        id: filterCheck
+        text: qsTr("Filter")
+        checked: terminal.filterEnabled
+        Layout.alignment: Qt.AlignVCenter | Qt.AlignLeft
+        onCheckedChanged: {
+          if (terminal.filterEnabled !== checked)
+            terminal.filterEnabled = checked
+        }
+      }
+    }
+
     //
     // Console display
     //
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick
+import SerialStudio
+
+import "../"
+
+Item {
+  id: root
+
+  //
+  // Widget data inputs
+  //
+  property color color: Cpp_ThemeManager.colors["highlight"]
+  property WaterfallModel model: WaterfallModel{}
+
+  //
+  // Add new spectrums to the history at 24 Hz
+  //
+  Timer {
+    repeat: true
+    interval: 1000 / 24
+    running: root.visible
+    onTriggered: root.model.draw(waterfall)
+  }
+
+  //
+  // Plot widget
+  //
+  Plot {
+    id: plot
+    anchors.margins: 8
+    anchors.fill: parent
+    xMin: root.model.minX
+    xMax: root.model.maxX
+    yMin: root.model.minY
+    yMax: root.model.maxY
+    curveColors: [root.color]
+    xLabel: qsTr("Frequency (Hz)")
+    yLabel: qsTr("History (Spectrums)")
+    xAxis.tickInterval: root.model.xTickInterval
+    yAxis.tickInterval: root.model.yTickInterval
+
+    //
+    // Spectrum history
+    //
+    WaterfallRenderer {
+      id: waterfall
+      parent: plot.plotArea
+      anchors.fill: parent
+      rows: root.model.rows
+      minValue: root.model.minValue
+      maxValue: root.model.maxValue
+    }
+  }
+}
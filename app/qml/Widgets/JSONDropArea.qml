@@ -34,7 +34,7 @@ DropArea {
     // Get file name & set color of rectangle accordingly
     if (drag.urls.length > 0) {
       var path = drag.urls[0].toString()
-      if (path.endsWith(".json") || path.endsWith(".csv")) {
+      if (path.endsWith(".json") || path.endsWith(".csv") || path.endsWith(".csv.gz")) {
         drag.accept(Qt.LinkAction)
         dropRectangle.color = Qt.darker(palette.highlight, 1.4)
       }
@@ -72,7 +72,7 @@ DropArea {
     }
 
     // Process CSV files
-    else if (cleanPath.endsWith(".csv"))
+    else if (cleanPath.endsWith(".csv") || cleanPath.endsWith(".csv.gz"))
       Cpp_CSV_Player.openFile(cleanPath)
   }
 
@@ -34,6 +34,7 @@ Item {
   // Plot properties
   //
   property alias graph: _graph
+  property alias plotArea: _plotArea
   property alias xAxis: _axisX
   property alias yAxis: _axisY
   property alias xMin: _axisX.min
@@ -133,6 +134,19 @@ Item {
     }
   }
 
+  //
+  // Plot area of the graph, curves are drawn here with the scene graph
+  //
+  Item {
+    id: _plotArea
+    z: 1
+    parent: _graph
+    x: _graph.plotArea.x
+    y: _graph.plotArea.y
+    width: _graph.plotArea.width
+    height: _graph.plotArea.height
+  }
+
   //
   // Plot area geometry calculation for tick intervals
   //
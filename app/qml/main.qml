@@ -92,12 +92,33 @@ Item {
   }
 
   //
-  // Project Editor
+  // Project Editor, created the first time that it is shown
   //
-  ProjectEditor.Root {
-    id: projectEditor
+  Loader {
+    id: projectEditorLoader
+    active: false
+    asynchronous: true
+    onLoaded: item.displayWindow()
+
+    function show() {
+      if (item)
+        item.displayWindow()
+      else
+        active = true
+    }
+
+    sourceComponent: Component {
+      ProjectEditor.Root {
+        id: projectEditor
+      }
+    }
   }
 
+  //
+  // Load the project file on start, the frame builder uses its parser code
+  //
+  Component.onCompleted: Cpp_JSON_ProjectModel.openJsonFile(Cpp_JSON_FrameBuilder.jsonMapFilepath)
+
   //
   // External console
   //
@@ -110,7 +131,7 @@ Item {
   // Dialog display functions
   //
   function showAboutDialog()       { aboutDialog.active = true }
-  function showProjectEditor()     { projectEditor.displayWindow() }
+  function showProjectEditor()     { projectEditorLoader.show() }
   function showExternalConsole()   { externalConsole.active = true }
   function showMqttConfiguration() { mqttConfiguration.active = true }
   function showAcknowledgements()  { acknowledgementsDialog.active = true }
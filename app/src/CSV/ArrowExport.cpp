@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ArrowExport.h"
+
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "CSV/Player.h"
+#include "MQTT/Client.h"
+#include "Misc/Utilities.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/ThreadScheduler.h"
+#include "JSON/FrameBuilder.h"
+
+/**
+ * Fraction of the frame bus that may be waiting to be written before the
+ * writer thread is asked to read it ahead of the 1 Hz timer
+ */
+static constexpr std::size_t kEarlyReadDivisor = 4;
+
+/**
+ * Registers a consumer of the frame bus & starts the Arrow writer thread.
+ */
+CSV::ArrowExport::ArrowExport()
+  : m_isOpen(false)
+  , m_writerBusy(false)
+  , m_exportEnabled(false)
+  , m_frameConsumer(-1)
+{
+  m_path = QStringLiteral("%1/%2/Arrow")
+               .arg(QStandardPaths::writableLocation(
+                        QStandardPaths::DocumentsLocation),
+                    qApp->applicationDisplayName());
+
+  // Read frames from the frame bus, losing the oldest ones if the disk is slow
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  m_frameConsumer = bus.addConsumer(JSON::FrameBus::Policy::DropOldest);
+  m_writer.setFrameBus(&bus, m_frameConsumer);
+
+  // Convert & write frames in their own thread
+  m_writer.setPath(m_path);
+  m_writer.moveToThread(&m_writerThread);
+  connect(&m_writer, &CSV::ArrowWriter::fileOpened, this,
+          &CSV::ArrowExport::onFileOpened, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ArrowWriter::fileClosed, this,
+          &CSV::ArrowExport::onFileClosed, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ArrowWriter::openFailed, this,
+          &CSV::ArrowExport::onOpenFailed, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ArrowWriter::framesWritten, this,
+          &CSV::ArrowExport::onFramesWritten, Qt::QueuedConnection);
+
+  // Write the remaining frames & stop the writer thread before quitting
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    closeFile();
+    m_writerThread.quit();
+    if (!m_writerThread.wait(5000))
+      m_writerThread.terminate();
+  });
+
+  // Start the writer thread
+  m_writerThread.setObjectName(QStringLiteral("Arrow Writer"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_writerThread, Misc::ThreadScheduler::Role::Exporter);
+  m_writerThread.start(QThread::LowPriority);
+}
+
+/**
+ * Close file & finnish write-operations before destroying the class
+ */
+CSV::ArrowExport::~ArrowExport()
+{
+  closeFile();
+  m_writerThread.quit();
+  m_writerThread.wait();
+}
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+CSV::ArrowExport &CSV::ArrowExport::instance()
+{
+  static ArrowExport singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if the Arrow file is open
+ */
+bool CSV::ArrowExport::isOpen() const
+{
+  return m_isOpen;
+}
+
+/**
+ * Returns @c true if Arrow export is enabled
+ */
+bool CSV::ArrowExport::exportEnabled() const
+{
+  return m_exportEnabled;
+}
+
+/**
+ * Open the current Arrow file in the Explorer/Finder window
+ */
+void CSV::ArrowExport::openCurrentFile()
+{
+  if (isOpen())
+    Misc::Utilities::revealFile(m_fileName);
+  else
+    Misc::Utilities::showMessageBox(tr("Arrow file not open"),
+                                    tr("Cannot find Arrow export file!"));
+}
+
+/**
+ * Configures the signal/slot connections with the rest of the modules of the
+ * application.
+ */
+void CSV::ArrowExport::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &ArrowExport::closeFile);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
+          this, &ArrowExport::registerFrame);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &ArrowExport::writeValues);
+}
+
+/**
+ * Enables or disables Arrow export
+ */
+void CSV::ArrowExport::setExportEnabled(const bool enabled)
+{
+  m_exportEnabled = enabled;
+  Q_EMIT enabledChanged();
+
+  if (!exportEnabled())
+    closeFile();
+}
+
+/**
+ * @brief Writes all remaining frames & closes the Arrow file.
+ *
+ * This function blocks until the writer thread has written every frame that
+ * is waiting in the frame bus and the file footer, so that the file can be
+ * opened by analysis tools as soon as the device is disconnected. The export
+ * then stops reading the bus until the next frame that should be exported
+ * arrives.
+ */
+void CSV::ArrowExport::closeFile()
+{
+  const auto type = m_writerThread.isRunning() ? Qt::BlockingQueuedConnection
+                                               : Qt::DirectConnection;
+  QMetaObject::invokeMethod(
+      &m_writer,
+      [=] {
+        m_writer.readFrameBus();
+        m_writer.closeFile();
+      },
+      type);
+
+  JSON::FrameBuilder::instance().frameBus().detach(m_frameConsumer);
+}
+
+/**
+ * Asks the writer thread to write the frames waiting in the frame bus, unless
+ * it is still busy with the previous ones.
+ */
+void CSV::ArrowExport::writeValues()
+{
+  const auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (m_writerBusy || bus.pending(m_frameConsumer) == 0)
+    return;
+
+  m_writerBusy = true;
+  QMetaObject::invokeMethod(&m_writer, &CSV::ArrowWriter::readFrameBus,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * Updates the UI when the writer thread closes the Arrow file
+ */
+void CSV::ArrowExport::onFileClosed()
+{
+  if (m_isOpen)
+  {
+    m_isOpen = false;
+    m_fileName.clear();
+    Q_EMIT openChanged();
+  }
+}
+
+/**
+ * Notifies the user that the Arrow file could not be created
+ */
+void CSV::ArrowExport::onOpenFailed()
+{
+  Misc::Utilities::showMessageBox(tr("Arrow File Error"),
+                                  tr("Cannot open Arrow file for writing!"));
+}
+
+/**
+ * Allows the writer thread to read the next frames
+ */
+void CSV::ArrowExport::onFramesWritten()
+{
+  m_writerBusy = false;
+}
+
+/**
+ * Updates the UI when the writer thread creates a new Arrow file
+ */
+void CSV::ArrowExport::onFileOpened(const QString &path)
+{
+  m_isOpen = true;
+  m_fileName = path;
+  Q_EMIT openChanged();
+}
+
+/**
+ * @brief Starts or stops reading the frame bus when a new frame is published.
+ *
+ * The export reads the bus only while the frames should be saved (i.e. when
+ * receiving data from a connected device or service, and not playing a CSV
+ * file); when that is no longer the case, the frames that are still waiting
+ * are written & the file is closed.
+ *
+ * If the unwritten frames fill a quarter of the bus, the writer thread is
+ * asked to read them without waiting for the 1 Hz timer.
+ */
+void CSV::ArrowExport::registerFrame(const JSON::Frame &frame)
+{
+  Q_UNUSED(frame);
+
+  // Check if the frames should be saved
+  const bool save = exportEnabled() && !CSV::Player::instance().isOpen()
+                    && (IO::Manager::instance().connected()
+                        || MQTT::Client::instance().isSubscribed());
+
+  // Stop reading the frame bus
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (!save)
+  {
+    if (bus.isAttached(m_frameConsumer))
+      closeFile();
+
+    return;
+  }
+
+  // Start reading the frame bus, beginning with this frame
+  if (!bus.isAttached(m_frameConsumer))
+    bus.attach(m_frameConsumer);
+
+  // Let the writer thread catch up before the bus is full
+  if (!m_writerBusy
+      && bus.pending(m_frameConsumer) >= bus.capacity() / kEarlyReadDivisor)
+  {
+    m_writerBusy = true;
+    QMetaObject::invokeMethod(&m_writer, &CSV::ArrowWriter::readFrameBus,
+                              Qt::QueuedConnection);
+  }
+}
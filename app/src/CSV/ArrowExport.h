@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QThread>
+#include <QObject>
+
+#include "JSON/Frame.h"
+#include "CSV/ArrowWriter.h"
+
+namespace CSV
+{
+/**
+ * @brief The ArrowExport class
+ *
+ * The Arrow export class records the received frames into Apache Arrow IPC
+ * files (@c .arrow, also known as Feather V2), with one typed column per
+ * project dataset. These files can be loaded or memory-mapped directly by
+ * pandas, polars & other analysis tools, without parsing any text. It works
+ * next to the @c CSV::Export class, both exports can be enabled
+ * independently.
+ *
+ * Like the CSV export, received frames are read from the @c JSON::FrameBus
+ * by the @c CSV::ArrowWriter worker thread each time the
+ * @c Misc::TimerEvents low-frequency timer expires, or earlier if a quarter
+ * of the bus is waiting to be written. The writer groups up to
+ * @c CSV::ArrowWriter::kRecordBatchRows frames in each record batch.
+ */
+class ArrowExport : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool isOpen
+             READ isOpen
+             NOTIFY openChanged)
+  Q_PROPERTY(bool exportEnabled
+             READ exportEnabled
+             WRITE setExportEnabled
+             NOTIFY enabledChanged)
+  // clang-format on
+
+signals:
+  void openChanged();
+  void enabledChanged();
+
+private:
+  explicit ArrowExport();
+  ArrowExport(ArrowExport &&) = delete;
+  ArrowExport(const ArrowExport &) = delete;
+  ArrowExport &operator=(ArrowExport &&) = delete;
+  ArrowExport &operator=(const ArrowExport &) = delete;
+
+  ~ArrowExport();
+
+public:
+  static ArrowExport &instance();
+
+  [[nodiscard]] bool isOpen() const;
+  [[nodiscard]] bool exportEnabled() const;
+
+public slots:
+  void closeFile();
+  void openCurrentFile();
+  void setupExternalConnections();
+  void setExportEnabled(const bool enabled);
+
+private slots:
+  void writeValues();
+  void onFileClosed();
+  void onOpenFailed();
+  void onFramesWritten();
+  void onFileOpened(const QString &path);
+  void registerFrame(const JSON::Frame &frame);
+
+private:
+  bool m_isOpen;
+  bool m_writerBusy;
+  bool m_exportEnabled;
+
+  QString m_path;
+  QString m_fileName;
+  int m_frameConsumer;
+
+  QThread m_writerThread;
+  CSV::ArrowWriter m_writer;
+};
+} // namespace CSV
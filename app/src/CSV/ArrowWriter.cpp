@@ -0,0 +1,838 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ArrowWriter.h"
+
+#include <limits>
+#include <numeric>
+
+#include <QDir>
+#include <QHash>
+#include <QtEndian>
+
+#include "Misc/Trace.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Magic number at the beginning & end of Arrow IPC files
+ */
+static constexpr char kArrowMagic[] = "ARROW1";
+
+/**
+ * Marker written before the metadata of each encapsulated IPC message
+ */
+static constexpr quint32 kContinuationMarker = 0xFFFFFFFF;
+
+/**
+ * Alignment of the metadata & body buffers of IPC messages
+ */
+static constexpr qsizetype kBufferAlignment = 8;
+
+/**
+ * Values of the Arrow flatbuffer enums & unions used by the writer
+ */
+static constexpr qint16 kMetadataVersionV5 = 4;
+static constexpr quint8 kMessageHeaderSchema = 1;
+static constexpr quint8 kMessageHeaderRecordBatch = 3;
+static constexpr quint8 kTypeFloatingPoint = 3;
+static constexpr quint8 kTypeUtf8 = 5;
+static constexpr quint8 kTypeTimestamp = 10;
+static constexpr qint16 kPrecisionDouble = 2;
+static constexpr qint16 kTimeUnitNanosecond = 3;
+static constexpr qint16 kEndiannessLittle = 0;
+
+/**
+ * Appends @a value to @a buffer in little-endian byte order.
+ */
+template<typename T>
+static void appendValue(QByteArray &buffer, const T value)
+{
+  char bytes[sizeof(T)];
+  qToLittleEndian(value, bytes);
+  buffer.append(bytes, sizeof(T));
+}
+
+/**
+ * Appends zeros to @a buffer until its size is a multiple of @a alignment.
+ */
+static void padBuffer(QByteArray &buffer, const qsizetype alignment)
+{
+  const auto remainder = buffer.size() % alignment;
+  if (remainder > 0)
+    buffer.append(alignment - remainder, '\0');
+}
+
+namespace CSV
+{
+/**
+ * @brief Minimal FlatBuffers builder used to encode the Arrow metadata.
+ *
+ * As in the reference implementation, the buffer is built back to front:
+ * children are serialized before the tables that refer to them, and objects
+ * are identified by their distance to the end of the buffer until
+ * @c finish() writes the offset of the root table.
+ *
+ * Only one table can be under construction at a time, so strings, vectors &
+ * child tables must be created before calling @c startTable().
+ */
+class FlatBufferBuilder
+{
+public:
+  FlatBufferBuilder();
+
+  quint32 createString(const QString &string);
+  quint32 createStructVector(const QByteArray &structs, const qsizetype count);
+  quint32 createOffsetVector(const QVector<quint32> &offsets);
+
+  void startTable();
+  quint32 endTable();
+  void addOffset(const int field, const quint32 offset);
+
+  template<typename T>
+  void addScalar(const int field, const T value)
+  {
+    align(sizeof(T));
+    push(value);
+    m_fields.append(qMakePair(field, size()));
+  }
+
+  [[nodiscard]] QByteArray finish(const quint32 root);
+
+private:
+  [[nodiscard]] quint32 size() const;
+  void align(const qsizetype alignment, const qsizetype extra = 0);
+
+  template<typename T>
+  void push(const T value)
+  {
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    m_buffer.prepend(bytes, sizeof(T));
+  }
+
+private:
+  quint32 m_tableStart;
+  qsizetype m_minAlign;
+  QByteArray m_buffer;
+  QVector<QPair<int, quint32>> m_fields;
+};
+} // namespace CSV
+
+//------------------------------------------------------------------------------
+// FlatBuffers builder
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+CSV::FlatBufferBuilder::FlatBufferBuilder()
+  : m_tableStart(0)
+  , m_minAlign(1)
+{
+}
+
+/**
+ * Serializes the given @a string as a null-terminated UTF-8 string prefixed
+ * with its byte count, and returns its offset.
+ */
+quint32 CSV::FlatBufferBuilder::createString(const QString &string)
+{
+  const auto utf8 = string.toUtf8();
+  align(sizeof(quint32), utf8.size() + 1);
+  m_buffer.prepend('\0');
+  m_buffer.prepend(utf8);
+  push(static_cast<quint32>(utf8.size()));
+  return size();
+}
+
+/**
+ * Serializes a vector of @a count structs, whose little-endian
+ * representation is given by @a structs, and returns its offset. All the
+ * structs used by the Arrow metadata are aligned to 8 bytes.
+ */
+quint32 CSV::FlatBufferBuilder::createStructVector(const QByteArray &structs,
+                                                   const qsizetype count)
+{
+  align(sizeof(quint32), structs.size());
+  align(sizeof(qint64), structs.size());
+  m_buffer.prepend(structs);
+  push(static_cast<quint32>(count));
+  return size();
+}
+
+/**
+ * Serializes a vector that refers to the given objects and returns its
+ * offset.
+ */
+quint32 CSV::FlatBufferBuilder::createOffsetVector(
+    const QVector<quint32> &offsets)
+{
+  align(sizeof(quint32), offsets.count() * sizeof(quint32));
+  for (auto i = offsets.count() - 1; i >= 0; --i)
+    push(size() - offsets[i] + static_cast<quint32>(sizeof(quint32)));
+
+  push(static_cast<quint32>(offsets.count()));
+  return size();
+}
+
+/**
+ * Starts the serialization of a table, its fields are added with
+ * @c addScalar() & @c addOffset().
+ */
+void CSV::FlatBufferBuilder::startTable()
+{
+  m_fields.clear();
+  m_tableStart = size();
+}
+
+/**
+ * @brief Finishes the current table & returns its offset.
+ *
+ * The table starts with the signed distance to its vtable, which is written
+ * right before the table and lists the position of each field within the
+ * table (zero for absent fields).
+ */
+quint32 CSV::FlatBufferBuilder::endTable()
+{
+  // Write a placeholder for the vtable offset
+  align(sizeof(qint32));
+  push(static_cast<qint32>(0));
+  const auto table = size();
+
+  // Obtain the position of each field relative to the table
+  int fieldCount = 0;
+  for (const auto &field : std::as_const(m_fields))
+    fieldCount = qMax(fieldCount, field.first + 1);
+
+  QVector<quint16> positions(fieldCount, 0);
+  for (const auto &field : std::as_const(m_fields))
+    positions[field.first] = static_cast<quint16>(table - field.second);
+
+  // Write the vtable
+  for (auto i = positions.count() - 1; i >= 0; --i)
+    push(positions[i]);
+
+  push(static_cast<quint16>(table - m_tableStart));
+  push(static_cast<quint16>((fieldCount + 2) * sizeof(quint16)));
+
+  // Let the table point to its vtable
+  const auto vtable = size();
+  qToLittleEndian(static_cast<qint32>(vtable - table),
+                  m_buffer.data() + size() - table);
+
+  m_fields.clear();
+  return table;
+}
+
+/**
+ * Adds a @a field that refers to the object at the given @a offset to the
+ * current table.
+ */
+void CSV::FlatBufferBuilder::addOffset(const int field, const quint32 offset)
+{
+  align(sizeof(quint32));
+  push(size() - offset + static_cast<quint32>(sizeof(quint32)));
+  m_fields.append(qMakePair(field, size()));
+}
+
+/**
+ * Writes the offset of the @a root table & returns the finished buffer.
+ */
+QByteArray CSV::FlatBufferBuilder::finish(const quint32 root)
+{
+  align(m_minAlign, sizeof(quint32));
+  push(size() - root + static_cast<quint32>(sizeof(quint32)));
+  return m_buffer;
+}
+
+/**
+ * Returns the number of bytes serialized so far
+ */
+quint32 CSV::FlatBufferBuilder::size() const
+{
+  return static_cast<quint32>(m_buffer.size());
+}
+
+/**
+ * Pads the buffer so that, after writing @a extra more bytes, its size is a
+ * multiple of @a alignment.
+ */
+void CSV::FlatBufferBuilder::align(const qsizetype alignment,
+                                   const qsizetype extra)
+{
+  m_minAlign = qMax(m_minAlign, alignment);
+  const auto padding = (alignment - (size() + extra) % alignment) % alignment;
+  if (padding > 0)
+    m_buffer.prepend(padding, '\0');
+}
+
+//------------------------------------------------------------------------------
+// Arrow writer
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+CSV::ArrowWriter::ArrowWriter(QObject *parent)
+  : QObject(parent)
+  , m_frameConsumer(-1)
+  , m_batchRows(0)
+  , m_frameBus(nullptr)
+  , m_file(this)
+{
+}
+
+/**
+ * Close file & finnish write-operations before destroying the class
+ */
+CSV::ArrowWriter::~ArrowWriter()
+{
+  closeFile();
+}
+
+/**
+ * Returns @c true if the Arrow file is open
+ */
+bool CSV::ArrowWriter::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * @brief Sets the frame bus read by @c readFrameBus().
+ *
+ * @param bus Ring to which the frame builder publishes frames.
+ * @param consumer Cursor of the Arrow export in @a bus.
+ */
+void CSV::ArrowWriter::setFrameBus(JSON::FrameBus *bus, const int consumer)
+{
+  m_frameBus = bus;
+  m_frameConsumer = consumer;
+}
+
+/**
+ * Writes the remaining rows, the end of stream marker & the footer, and
+ * closes the Arrow file
+ */
+void CSV::ArrowWriter::closeFile()
+{
+  if (isOpen())
+  {
+    if (m_batchRows > 0)
+      writeRecordBatch();
+
+    writeFooter();
+    m_file.close();
+
+    m_blocks.clear();
+    m_columns.clear();
+    m_timestamps.clear();
+    m_slotColumns.clear();
+    m_rowDatasets.clear();
+    m_rawSlotColumns.clear();
+
+    Q_EMIT fileClosed();
+  }
+}
+
+/**
+ * @brief Writes the frames that are waiting in the frame bus.
+ *
+ * Frames are copied one by one from the ring into a reusable frame, which
+ * shares the storage of its slot, so reading them does not allocate memory.
+ * Frames without a reception time are stamped with the current time. At most
+ * one ring worth of frames is read on each call, and the rows that did not
+ * fill a complete record batch are written before returning, so that the
+ * file always contains every frame that has been read.
+ */
+void CSV::ArrowWriter::readFrameBus()
+{
+  TRACE_ZONE("ArrowWriter::readFrameBus");
+
+  // No frame bus available
+  if (!m_frameBus || m_frameConsumer < 0)
+    return;
+
+  // Convert the pending frames to columns
+  qsizetype count = 0;
+  auto limit = m_frameBus->capacity();
+  while (limit-- > 0 && m_frameBus->tryRead(m_frameConsumer, m_busFrame))
+  {
+    if (!m_busFrame.isValid())
+      continue;
+
+    const auto timestamp = m_busFrame.timestamp() > 0
+                               ? m_busFrame.timestamp()
+                               : Misc::SessionClock::now();
+    if (!writeRow(m_busFrame, timestamp))
+      break;
+
+    ++count;
+  }
+
+  // Write the remaining rows to the hard disk
+  if (isOpen())
+  {
+    if (m_batchRows > 0)
+      writeRecordBatch();
+
+    m_file.flush();
+  }
+
+  // Notify the export module that the frames have been written
+  Q_EMIT framesWritten(count);
+}
+
+/**
+ * Changes the root directory in which Arrow files are created
+ */
+void CSV::ArrowWriter::setPath(const QString &path)
+{
+  m_path = path;
+}
+
+/**
+ * @brief Appends the values of the given @a frame to the column buffers.
+ *
+ * If the file is not open, it is created using the frame. Datasets that are
+ * missing from the frame, or numeric columns whose dataset holds a
+ * non-numeric value, are stored as null values. A record batch is written
+ * once @c kRecordBatchRows rows have been buffered.
+ *
+ * @return @c false if the Arrow file could not be created.
+ */
+bool CSV::ArrowWriter::writeRow(const JSON::Frame &frame,
+                                const qint64 timestamp)
+{
+  // File not open, create it & write the schema
+  if (!isOpen() && !createFile(frame, timestamp))
+    return false;
+
+  // Assign each dataset to its columns
+  int slot = 0;
+  m_rowDatasets.fill(nullptr);
+  for (const auto &group : frame.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      if (slot < m_slotColumns.count())
+      {
+        const auto column = m_slotColumns[slot];
+        if (column >= 0)
+          m_rowDatasets[column] = &dataset;
+
+        const auto rawColumn = m_rawSlotColumns[slot];
+        if (rawColumn >= 0)
+          m_rowDatasets[rawColumn] = &dataset;
+      }
+
+      ++slot;
+    }
+  }
+
+  // Write the reception time
+  appendValue<qint64>(m_timestamps, Misc::SessionClock::toUnixNsecs(timestamp));
+
+  // Write the value of each column & its validity bit
+  const auto bit = static_cast<int>(m_batchRows % 8);
+  for (qsizetype i = 0; i < m_columns.count(); ++i)
+  {
+    auto &column = m_columns[i];
+    const auto *dataset = m_rowDatasets[i];
+
+    bool valid = dataset != nullptr;
+    if (column.type == ColumnType::Float64)
+    {
+      valid = valid && dataset->isNumeric();
+      auto value = std::numeric_limits<double>::quiet_NaN();
+      if (valid)
+        value = column.raw ? dataset->rawValue() : dataset->numericValue();
+
+      appendValue<double>(column.values, value);
+    }
+
+    else
+    {
+      if (valid)
+        column.data.append(dataset->value().toUtf8());
+
+      appendValue<qint32>(column.values,
+                          static_cast<qint32>(column.data.size()));
+    }
+
+    if (bit == 0)
+      column.validity.append('\0');
+
+    if (valid)
+      column.validity.back() |= static_cast<char>(1 << bit);
+    else
+      ++column.nullCount;
+  }
+
+  // Write the record batch once it is complete
+  if (++m_batchRows >= kRecordBatchRows)
+    writeRecordBatch();
+
+  return true;
+}
+
+/**
+ * @brief Creates a new Arrow file & writes its schema.
+ *
+ * The file is created in a project-specific directory, and its columns are
+ * obtained from the datasets of the given @a frame with a non-duplicated
+ * index, sorted by their index. Numeric datasets are stored as @c float64
+ * columns & the rest as UTF-8 columns. Filtered datasets get an additional
+ * "(raw)" column after the dataset columns.
+ *
+ * The slot → column tables used by @c writeRow() are also built here, since
+ * the layout of the frame does not change while the file is open.
+ *
+ * @return @c true if the file was created, @c false otherwise.
+ */
+bool CSV::ArrowWriter::createFile(const JSON::Frame &frame,
+                                  const qint64 timestamp)
+{
+  // Get file name
+  const auto rxTime = Misc::SessionClock::toDateTime(timestamp);
+  const auto fileName
+      = rxTime.toString(QStringLiteral("yyyy_MMM_dd HH_mm_ss")) + ".arrow";
+
+  // Generate file path if required
+  QDir dir(QStringLiteral("%1/%2/").arg(m_path, frame.title()));
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  // Open file
+  m_file.setFileName(dir.filePath(fileName));
+  if (!m_file.open(QIODevice::WriteOnly))
+  {
+    Q_EMIT openFailed();
+    return false;
+  }
+
+  // Get the slot & column of each dataset with a non-duplicated index
+  QVector<int> slotIndexes;
+  QVector<int> datasetIndexes;
+  QVector<Column> columns;
+  QVector<Column> rawColumns;
+  m_rawSlotColumns.clear();
+  for (const auto &group : frame.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      const auto name = QStringLiteral("%1/%2").arg(group.title(),
+                                                    dataset.title());
+
+      slotIndexes.append(dataset.index());
+      if (dataset.filter().isEmpty())
+        m_rawSlotColumns.append(-1);
+
+      else
+      {
+        Column column;
+        column.raw = true;
+        column.type = ColumnType::Float64;
+        column.name = QStringLiteral("%1 (raw)").arg(name).simplified();
+        m_rawSlotColumns.append(rawColumns.count());
+        rawColumns.append(column);
+      }
+
+      if (!datasetIndexes.contains(dataset.index()))
+      {
+        Column column;
+        column.raw = false;
+        column.name = name.simplified();
+        column.type = dataset.isNumeric() ? ColumnType::Float64
+                                          : ColumnType::Utf8;
+        datasetIndexes.append(dataset.index());
+        columns.append(column);
+      }
+    }
+  }
+
+  // Sort the columns by dataset index
+  QVector<int> order(datasetIndexes.count());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return datasetIndexes[a] < datasetIndexes[b];
+  });
+
+  // Build the column list & the slot → column tables
+  QHash<int, int> lookup;
+  m_columns.clear();
+  for (int i = 0; i < order.count(); ++i)
+  {
+    lookup.insert(datasetIndexes[order[i]], i);
+    m_columns.append(columns[order[i]]);
+  }
+
+  m_slotColumns.clear();
+  for (const auto index : std::as_const(slotIndexes))
+    m_slotColumns.append(lookup.value(index, -1));
+
+  for (auto &column : m_rawSlotColumns)
+  {
+    if (column >= 0)
+      column += static_cast<int>(order.count());
+  }
+
+  m_columns.append(rawColumns);
+  m_rowDatasets.fill(nullptr, m_columns.count());
+
+  // Write the file magic & the schema
+  m_blocks.clear();
+  m_file.write(kArrowMagic, sizeof(kArrowMagic) - 1);
+  m_file.write(QByteArray(kBufferAlignment - sizeof(kArrowMagic) + 1, '\0'));
+
+  FlatBufferBuilder builder;
+  const auto schema = createSchema(builder);
+  builder.startTable();
+  builder.addScalar<qint64>(3, 0);
+  builder.addOffset(2, schema);
+  builder.addScalar<qint16>(0, kMetadataVersionV5);
+  builder.addScalar<quint8>(1, kMessageHeaderSchema);
+  writeMessage(builder.finish(builder.endTable()), QByteArray());
+
+  // Prepare the first record batch
+  resetBatch();
+
+  // Update UI
+  Q_EMIT fileOpened(m_file.fileName());
+  return true;
+}
+
+/**
+ * Clears the column buffers after a record batch has been written
+ */
+void CSV::ArrowWriter::resetBatch()
+{
+  m_batchRows = 0;
+  m_timestamps.clear();
+  for (auto &column : m_columns)
+  {
+    column.nullCount = 0;
+    column.data.clear();
+    column.values.clear();
+    column.validity.clear();
+    if (column.type == ColumnType::Utf8)
+      appendValue<qint32>(column.values, 0);
+  }
+}
+
+/**
+ * @brief Writes the end of stream marker & the file footer.
+ *
+ * The footer repeats the schema and lists the position of each record batch,
+ * so that readers can access any batch without scanning the file. It is
+ * followed by its size & the file magic.
+ */
+void CSV::ArrowWriter::writeFooter()
+{
+  // Write the end of stream marker
+  QByteArray eos;
+  appendValue<quint32>(eos, kContinuationMarker);
+  appendValue<qint32>(eos, 0);
+  m_file.write(eos);
+
+  // Serialize the record batch blocks
+  QByteArray blocks;
+  for (const auto &block : std::as_const(m_blocks))
+  {
+    appendValue<qint64>(blocks, block.offset);
+    appendValue<qint32>(blocks, block.metadataLength);
+    appendValue<qint32>(blocks, 0);
+    appendValue<qint64>(blocks, block.bodyLength);
+  }
+
+  // Build the footer
+  FlatBufferBuilder builder;
+  const auto schema = createSchema(builder);
+  const auto dictionaries = builder.createStructVector(QByteArray(), 0);
+  const auto batches = builder.createStructVector(blocks, m_blocks.count());
+  builder.startTable();
+  builder.addOffset(1, schema);
+  builder.addOffset(2, dictionaries);
+  builder.addOffset(3, batches);
+  builder.addScalar<qint16>(0, kMetadataVersionV5);
+  const auto footer = builder.finish(builder.endTable());
+
+  // Write the footer, its size & the file magic
+  QByteArray trailer;
+  appendValue<qint32>(trailer, static_cast<qint32>(footer.size()));
+  trailer.append(kArrowMagic, sizeof(kArrowMagic) - 1);
+  m_file.write(footer);
+  m_file.write(trailer);
+}
+
+/**
+ * @brief Writes the buffered rows as a record batch & clears the buffers.
+ *
+ * The message body contains the buffers of each column, in schema order &
+ * padded to 8 bytes: the validity bitmap (omitted when the column has no
+ * null values) followed by the values, or by the offsets & UTF-8 data of
+ * string columns. The reception time column has no null values.
+ */
+void CSV::ArrowWriter::writeRecordBatch()
+{
+  TRACE_ZONE("ArrowWriter::writeRecordBatch");
+
+  QByteArray body;
+  QByteArray nodes;
+  QByteArray buffers;
+  qsizetype bufferCount = 0;
+
+  // Registers the position of a buffer & appends it to the message body
+  auto addBuffer = [&](const QByteArray &buffer) {
+    appendValue<qint64>(buffers, body.size());
+    appendValue<qint64>(buffers, buffer.size());
+    body.append(buffer);
+    padBuffer(body, kBufferAlignment);
+    ++bufferCount;
+  };
+
+  // Add the reception time column
+  appendValue<qint64>(nodes, m_batchRows);
+  appendValue<qint64>(nodes, 0);
+  addBuffer(QByteArray());
+  addBuffer(m_timestamps);
+
+  // Add the dataset columns
+  for (const auto &column : std::as_const(m_columns))
+  {
+    appendValue<qint64>(nodes, m_batchRows);
+    appendValue<qint64>(nodes, column.nullCount);
+    addBuffer(column.nullCount > 0 ? column.validity : QByteArray());
+    addBuffer(column.values);
+    if (column.type == ColumnType::Utf8)
+      addBuffer(column.data);
+  }
+
+  // Build the record batch metadata
+  FlatBufferBuilder builder;
+  const auto nodeVector
+      = builder.createStructVector(nodes, m_columns.count() + 1);
+  const auto bufferVector = builder.createStructVector(buffers, bufferCount);
+  builder.startTable();
+  builder.addScalar<qint64>(0, m_batchRows);
+  builder.addOffset(1, nodeVector);
+  builder.addOffset(2, bufferVector);
+  const auto batch = builder.endTable();
+
+  builder.startTable();
+  builder.addScalar<qint64>(3, body.size());
+  builder.addOffset(2, batch);
+  builder.addScalar<qint16>(0, kMetadataVersionV5);
+  builder.addScalar<quint8>(1, kMessageHeaderRecordBatch);
+
+  // Write the message & register its position for the footer
+  m_blocks.append(writeMessage(builder.finish(builder.endTable()), body));
+  resetBatch();
+}
+
+/**
+ * @brief Writes an encapsulated IPC message & returns its position.
+ *
+ * The message starts with the continuation marker and the size of the
+ * @a metadata flatbuffer (padded so that the @a body starts at an 8-byte
+ * boundary), followed by the metadata & the body.
+ */
+CSV::ArrowWriter::Block
+CSV::ArrowWriter::writeMessage(const QByteArray &metadata,
+                               const QByteArray &body)
+{
+  QByteArray message;
+  appendValue<quint32>(message, kContinuationMarker);
+  appendValue<qint32>(message, 0);
+  message.append(metadata);
+  padBuffer(message, kBufferAlignment);
+  qToLittleEndian(static_cast<qint32>(message.size() - 8), message.data() + 4);
+
+  Block block;
+  block.offset = m_file.pos();
+  block.metadataLength = static_cast<qint32>(message.size());
+  block.bodyLength = body.size();
+
+  m_file.write(message);
+  m_file.write(body);
+  return block;
+}
+
+/**
+ * @brief Serializes the schema of the file with the given @a builder.
+ *
+ * The first field is the non-nullable reception time, stored as nanoseconds
+ * since the Unix epoch in UTC, followed by a nullable field for each column.
+ *
+ * @return Offset of the schema table.
+ */
+quint32 CSV::ArrowWriter::createSchema(FlatBufferBuilder &builder) const
+{
+  // Serializes a field with the given name, nullability & type
+  auto createField = [&](const QString &name, const bool nullable,
+                         const quint8 typeType, const quint32 type) {
+    const auto nameString = builder.createString(name);
+    const auto children = builder.createOffsetVector({});
+    builder.startTable();
+    builder.addOffset(0, nameString);
+    builder.addOffset(3, type);
+    builder.addOffset(5, children);
+    builder.addScalar<quint8>(1, nullable);
+    builder.addScalar<quint8>(2, typeType);
+    return builder.endTable();
+  };
+
+  // Add the reception time field
+  QVector<quint32> fields;
+  const auto timezone = builder.createString(QStringLiteral("UTC"));
+  builder.startTable();
+  builder.addOffset(1, timezone);
+  builder.addScalar<qint16>(0, kTimeUnitNanosecond);
+  const auto timestamp = builder.endTable();
+  fields.append(createField(QStringLiteral("RX Time"), false, kTypeTimestamp,
+                            timestamp));
+
+  // Add the dataset fields
+  for (const auto &column : std::as_const(m_columns))
+  {
+    builder.startTable();
+    if (column.type == ColumnType::Float64)
+    {
+      builder.addScalar<qint16>(0, kPrecisionDouble);
+      fields.append(createField(column.name, true, kTypeFloatingPoint,
+                                builder.endTable()));
+    }
+
+    else
+    {
+      fields.append(
+          createField(column.name, true, kTypeUtf8, builder.endTable()));
+    }
+  }
+
+  // Build the schema
+  const auto fieldVector = builder.createOffsetVector(fields);
+  builder.startTable();
+  builder.addOffset(1, fieldVector);
+  builder.addScalar<qint16>(0, kEndiannessLittle);
+  return builder.endTable();
+}
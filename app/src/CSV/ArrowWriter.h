@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QVector>
+#include <QObject>
+#include <QByteArray>
+
+#include "JSON/Frame.h"
+
+namespace CSV
+{
+class FlatBufferBuilder;
+
+/**
+ * @class CSV::ArrowWriter
+ * @brief Converts frames to columns & writes them to an Apache Arrow file.
+ *
+ * The Arrow writer owns the session file and is meant to live in a worker
+ * thread, next to the @c CSV::ExportWriter. Frames are read from the
+ * @c JSON::FrameBus by @c readFrameBus() when the @c CSV::ArrowExport class
+ * asks for it, and the writer notifies when they have been written through
+ * the @c framesWritten() signal.
+ *
+ * The file uses the Arrow IPC file format (also known as Feather V2): the
+ * @c "ARROW1" magic, the IPC stream (schema message, record batches & end of
+ * stream marker) and a footer that lists the position of every record batch.
+ * Since the stream is written incrementally, the file can be read as it
+ * grows by skipping the 8-byte magic, and once closed it can be opened or
+ * memory-mapped by pandas, polars & any other Arrow implementation.
+ *
+ * The schema is generated from the datasets of the first frame:
+ * - @c "RX Time": reception time, as a nanosecond UTC timestamp.
+ * - One column per dataset index, stored as nullable @c float64 values for
+ *   numeric datasets and as nullable UTF-8 strings for the rest.
+ * - One @c float64 column with the unfiltered values of each filtered dataset.
+ *
+ * Rows are accumulated in column buffers and written as a record batch each
+ * time @c kRecordBatchRows rows are available, or when the frame bus has been
+ * emptied.
+ */
+class ArrowWriter : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void fileClosed();
+  void openFailed();
+  void framesWritten(const qsizetype frames);
+  void fileOpened(const QString &path);
+
+public:
+  explicit ArrowWriter(QObject *parent = nullptr);
+  ~ArrowWriter();
+
+  /**
+   * Maximum number of rows stored in a single record batch
+   */
+  static constexpr qsizetype kRecordBatchRows = 8192;
+
+  [[nodiscard]] bool isOpen() const;
+
+  void setFrameBus(JSON::FrameBus *bus, const int consumer);
+
+public slots:
+  void closeFile();
+  void readFrameBus();
+  void setPath(const QString &path);
+
+private:
+  /**
+   * @brief Arrow type of the values stored in a column.
+   */
+  enum class ColumnType
+  {
+    Float64,
+    Utf8,
+  };
+
+  /**
+   * @brief Name, type & buffers of a column of the current record batch.
+   *
+   * The validity bitmap has one bit per row (least significant bit first),
+   * numeric values are stored in @c values, and string columns store the
+   * @c int32 offsets of their strings in @c values (starting with 0) & the
+   * UTF-8 data of the strings in @c data. Columns marked as @c raw store the
+   * unfiltered values of their dataset.
+   */
+  struct Column
+  {
+    bool raw;
+    QString name;
+    ColumnType type;
+    qint64 nullCount;
+    QByteArray validity;
+    QByteArray values;
+    QByteArray data;
+  };
+
+  /**
+   * @brief Position of a record batch, written to the file footer.
+   */
+  struct Block
+  {
+    qint64 offset;
+    qint32 metadataLength;
+    qint64 bodyLength;
+  };
+
+  [[nodiscard]] bool writeRow(const JSON::Frame &frame,
+                              const qint64 timestamp);
+  [[nodiscard]] bool createFile(const JSON::Frame &frame,
+                                const qint64 timestamp);
+
+  void resetBatch();
+  void writeFooter();
+  void writeRecordBatch();
+  Block writeMessage(const QByteArray &metadata, const QByteArray &body);
+  [[nodiscard]] quint32 createSchema(FlatBufferBuilder &builder) const;
+
+private:
+  int m_frameConsumer;
+  qsizetype m_batchRows;
+  JSON::FrameBus *m_frameBus;
+  JSON::Frame m_busFrame;
+
+  QFile m_file;
+  QString m_path;
+  QByteArray m_timestamps;
+  QVector<Block> m_blocks;
+  QVector<Column> m_columns;
+  QVector<int> m_slotColumns;
+  QVector<int> m_rawSlotColumns;
+  QVector<const JSON::Dataset *> m_rowDatasets;
+};
+} // namespace CSV
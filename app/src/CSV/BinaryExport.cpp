@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "BinaryExport.h"
+
+#include <cmath>
+#include <limits>
+
+#include <QDir>
+#include <QDateTime>
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "CSV/Player.h"
+#include "MQTT/Client.h"
+#include "Misc/Utilities.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/SessionClock.h"
+#include "JSON/FrameBuilder.h"
+
+/**
+ * Version of the session file format
+ */
+static constexpr quint32 kFormatVersion = 2;
+
+/**
+ * Maximum number of rows stored in a single compressed block
+ */
+static constexpr qsizetype kMaxBlockRows = 8192;
+
+/**
+ * Minimum time between two entries of the time index (in nanoseconds)
+ */
+static constexpr qint64 kTimeIndexInterval = 1000000000;
+
+/**
+ * Writes the given @a string as a byte count followed by its UTF-8 data.
+ */
+static void writeString(QDataStream &stream, const QString &string)
+{
+  const auto utf8 = string.toUtf8();
+  stream << static_cast<quint32>(utf8.size());
+  stream.writeRawData(utf8.constData(), static_cast<int>(utf8.size()));
+}
+
+/**
+ * Writes the given four or eight character @a magic without a terminator.
+ */
+static void writeMagic(QDataStream &stream, const char *magic)
+{
+  stream.writeRawData(magic, static_cast<int>(qstrlen(magic)));
+}
+
+/**
+ * Connect JSON Parser & Serial Manager signals to begin registering JSON
+ * dataframes into the session file.
+ */
+CSV::BinaryExport::BinaryExport()
+  : m_exportEnabled(false)
+  , m_rowCount(0)
+{
+  m_path = QStringLiteral("%1/%2/Sessions")
+               .arg(QStandardPaths::writableLocation(
+                        QStandardPaths::DocumentsLocation),
+                    qApp->applicationDisplayName());
+}
+
+/**
+ * Close file & finnish write-operations before destroying the class
+ */
+CSV::BinaryExport::~BinaryExport()
+{
+  closeFile();
+}
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+CSV::BinaryExport &CSV::BinaryExport::instance()
+{
+  static BinaryExport singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if the session file is open
+ */
+bool CSV::BinaryExport::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * Returns @c true if binary session export is enabled
+ */
+bool CSV::BinaryExport::exportEnabled() const
+{
+  return m_exportEnabled;
+}
+
+/**
+ * Open the current session file in the Explorer/Finder window
+ */
+void CSV::BinaryExport::openCurrentFile()
+{
+  if (isOpen())
+    Misc::Utilities::revealFile(m_file.fileName());
+  else
+    Misc::Utilities::showMessageBox(tr("Session file not open"),
+                                    tr("Cannot find session export file!"));
+}
+
+/**
+ * Configures the signal/slot connections with the rest of the modules of the
+ * application.
+ */
+void CSV::BinaryExport::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &BinaryExport::closeFile);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
+          this, &BinaryExport::registerFrame, Qt::QueuedConnection);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &BinaryExport::writeValues);
+}
+
+/**
+ * Enables or disables binary session export
+ */
+void CSV::BinaryExport::setExportEnabled(const bool enabled)
+{
+  m_exportEnabled = enabled;
+  Q_EMIT enabledChanged();
+
+  if (!exportEnabled())
+  {
+    m_frames.clear();
+    m_frames.squeeze();
+    closeFile();
+  }
+}
+
+/**
+ * Write all remaining frames, the footer index & close the session file
+ */
+void CSV::BinaryExport::closeFile()
+{
+  if (isOpen())
+  {
+    writeValues();
+
+    // Write the footer index
+    const auto indexOffset = m_file.pos();
+    writeMagic(m_stream, "SSIX");
+    m_stream << static_cast<quint32>(m_blocks.count());
+    for (const auto &block : std::as_const(m_blocks))
+    {
+      m_stream << block.offset << block.rows;
+      m_stream << block.firstTimestamp << block.lastTimestamp;
+    }
+
+    // Write the time index
+    writeMagic(m_stream, "SSTI");
+    m_stream << static_cast<quint32>(m_timeIndex.count());
+    for (const auto &entry : std::as_const(m_timeIndex))
+      m_stream << entry.timestamp << entry.row;
+
+    // Write the trailer, used by readers to locate the index
+    m_stream << static_cast<qint64>(indexOffset);
+    writeMagic(m_stream, "SSBINEND");
+
+    // Close the file
+    m_file.close();
+    m_stream.setDevice(nullptr);
+    m_rowCount = 0;
+    m_blocks.clear();
+    m_timeIndex.clear();
+    m_columnTypes.clear();
+    m_columnLookup.clear();
+    m_columnIndexes.clear();
+
+    Q_EMIT openChanged();
+  }
+}
+
+/**
+ * @brief Writes the buffered frames to the session file.
+ *
+ * If the file is not open, it is created using the first buffered frame,
+ * which defines the columns of the session. The frames are then written in
+ * compressed blocks of up to @c kMaxBlockRows rows, and the frame buffer is
+ * cleared.
+ */
+void CSV::BinaryExport::writeValues()
+{
+  if (m_frames.isEmpty())
+    return;
+
+  // File not open, create it & write the header
+  if (!isOpen() && exportEnabled())
+  {
+    if (!createFile(m_frames.first()))
+    {
+      m_frames.clear();
+      return;
+    }
+  }
+
+  // Write frames in blocks
+  if (isOpen())
+  {
+    for (qsizetype i = 0; i < m_frames.count(); i += kMaxBlockRows)
+    {
+      const auto count = qMin(kMaxBlockRows, m_frames.count() - i);
+      writeBlock(m_frames.constData() + i, count);
+    }
+
+    m_file.flush();
+  }
+
+  // Clear frames
+  m_frames.clear();
+}
+
+/**
+ * @brief Creates a new session file & writes its header.
+ *
+ * The columns of the session are obtained from the datasets of the given
+ * @a frame, sorted by their frame index (datasets that share an index are
+ * stored once). Datasets with a numeric value are stored as @c float64
+ * columns, and the rest as string columns.
+ *
+ * The unfiltered values of filtered datasets are stored in additional
+ * @c float64 columns after the dataset columns, identified by the negated
+ * frame index of the dataset.
+ *
+ * @return @c true if the file was created, @c false otherwise.
+ */
+bool CSV::BinaryExport::createFile(const TimestampFrame &frame)
+{
+  // Obtain frame data
+  const auto &data = frame.data;
+  const auto msecs = frame.timestamp / 1000000;
+  const auto rxTime = QDateTime::fromMSecsSinceEpoch(msecs);
+
+  // Get file name
+  const auto fileName
+      = rxTime.toString(QStringLiteral("yyyy_MMM_dd HH_mm_ss")) + ".ssb";
+
+  // Generate file path if required
+  QDir dir(QStringLiteral("%1/%2/").arg(m_path, data.title()));
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  // Open file
+  m_file.setFileName(dir.filePath(fileName));
+  if (!m_file.open(QIODevice::WriteOnly))
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Session File Error"),
+        tr("Cannot open session file for writing!"));
+    return false;
+  }
+
+  // Configure the data stream
+  m_stream.setDevice(&m_file);
+  m_stream.setByteOrder(QDataStream::LittleEndian);
+  m_stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+  // Obtain the columns from the datasets with non-duplicated indexes
+  QVector<QPair<int, QPair<ColumnType, QString>>> columns;
+  for (const auto &group : data.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      const auto index = dataset.index();
+      const auto exists = std::any_of(
+          columns.cbegin(), columns.cend(),
+          [index](const auto &column) { return column.first == index; });
+
+      if (!exists)
+      {
+        const auto type = dataset.isNumeric() ? Float64 : String;
+        const auto name
+            = QStringLiteral("%1/%2").arg(group.title(), dataset.title());
+        columns.append(qMakePair(index, qMakePair(type, name.simplified())));
+      }
+    }
+  }
+
+  // Sort the columns by dataset index
+  std::sort(columns.begin(), columns.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  // Add the unfiltered value columns of filtered datasets
+  for (const auto &group : data.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      const auto index = -dataset.index();
+      const auto exists = std::any_of(
+          columns.cbegin(), columns.cend(),
+          [index](const auto &column) { return column.first == index; });
+
+      if (index < 0 && !dataset.filter().isEmpty() && !exists)
+      {
+        const auto name
+            = QStringLiteral("%1/%2 (raw)").arg(group.title(), dataset.title());
+        columns.append(qMakePair(index, qMakePair(Float64, name.simplified())));
+      }
+    }
+  }
+
+  // Build the column lookup tables
+  m_rowCount = 0;
+  m_blocks.clear();
+  m_timeIndex.clear();
+  m_columnTypes.clear();
+  m_columnLookup.clear();
+  m_columnIndexes.clear();
+  for (const auto &column : std::as_const(columns))
+  {
+    m_columnLookup.insert(column.first, m_columnIndexes.count());
+    m_columnIndexes.append(column.first);
+    m_columnTypes.append(column.second.first);
+  }
+
+  // Write the header
+  writeMagic(m_stream, "SSBINARY");
+  m_stream << kFormatVersion;
+  writeString(m_stream, data.title());
+  m_stream << static_cast<quint32>(columns.count());
+  for (const auto &column : std::as_const(columns))
+  {
+    m_stream << static_cast<quint8>(column.second.first);
+    m_stream << static_cast<qint32>(column.first);
+    writeString(m_stream, column.second.second);
+  }
+
+  // Update UI
+  Q_EMIT openChanged();
+  return true;
+}
+
+/**
+ * @brief Writes @a count frames as a compressed columnar block.
+ *
+ * The payload is built column by column (timestamps first), compressed with
+ * zlib and appended to the file, and the position of the block is registered
+ * for the footer index.
+ */
+void CSV::BinaryExport::writeBlock(const TimestampFrame *frames,
+                                   const qsizetype count)
+{
+  if (count <= 0)
+    return;
+
+  // Gather the value of each column for each row
+  const auto columns = m_columnIndexes.count();
+  QVector<const QString *> cells(columns * count, nullptr);
+  QVector<double> numbers(columns * count,
+                          std::numeric_limits<double>::quiet_NaN());
+  for (qsizetype row = 0; row < count; ++row)
+  {
+    for (const auto &group : frames[row].data.groups())
+    {
+      for (const auto &dataset : group.datasets())
+      {
+        const auto column = m_columnLookup.value(dataset.index(), -1);
+        if (column < 0)
+          continue;
+
+        const auto cell = column * count + row;
+        cells[cell] = &dataset.value();
+        if (m_columnTypes[column] == Float64 && dataset.isNumeric())
+          numbers[cell] = dataset.numericValue();
+
+        // Store the unfiltered value of filtered datasets
+        if (dataset.filter().isEmpty() || dataset.index() <= 0)
+          continue;
+
+        const auto raw = m_columnLookup.value(-dataset.index(), -1);
+        if (raw >= 0 && dataset.isNumeric())
+          numbers[raw * count + row] = dataset.rawValue();
+      }
+    }
+  }
+
+  // Build the columnar payload
+  QByteArray payload;
+  QDataStream stream(&payload, QIODevice::WriteOnly);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+  for (qsizetype row = 0; row < count; ++row)
+    stream << frames[row].timestamp;
+
+  for (qsizetype column = 0; column < columns; ++column)
+  {
+    const auto offset = column * count;
+    if (m_columnTypes[column] == Float64)
+    {
+      for (qsizetype row = 0; row < count; ++row)
+        stream << numbers[offset + row];
+    }
+
+    else
+    {
+      for (qsizetype row = 0; row < count; ++row)
+      {
+        const auto *value = cells[offset + row];
+        writeString(stream, value ? *value : QString());
+      }
+    }
+  }
+
+  // Compress the payload, dropping the size prefix added by qCompress()
+  const auto compressed = qCompress(payload).mid(4);
+
+  // Register the first row of each second in the time index
+  for (qsizetype row = 0; row < count; ++row)
+  {
+    const auto timestamp = frames[row].timestamp;
+    if (m_timeIndex.isEmpty()
+        || timestamp - m_timeIndex.last().timestamp >= kTimeIndexInterval)
+    {
+      TimeIndexEntry entry;
+      entry.timestamp = timestamp;
+      entry.row = m_rowCount + static_cast<quint64>(row);
+      m_timeIndex.append(entry);
+    }
+  }
+
+  // Register the block in the footer index
+  BlockInfo block;
+  block.offset = m_file.pos();
+  block.rows = static_cast<quint32>(count);
+  block.firstTimestamp = frames[0].timestamp;
+  block.lastTimestamp = frames[count - 1].timestamp;
+  m_blocks.append(block);
+  m_rowCount += block.rows;
+
+  // Write the block header & the compressed payload
+  writeMagic(m_stream, "SSBK");
+  m_stream << block.rows << block.firstTimestamp << block.lastTimestamp;
+  m_stream << static_cast<quint32>(payload.size());
+  m_stream << static_cast<quint32>(compressed.size());
+  m_stream.writeRawData(compressed.constData(),
+                        static_cast<int>(compressed.size()));
+}
+
+/**
+ * Appends the latest frame from the device to the output buffer
+ */
+void CSV::BinaryExport::registerFrame(const JSON::Frame &frame)
+{
+  // Ignore if binary export is disabled
+  if (!exportEnabled())
+    return;
+
+  // Don't generate a session file when we are playing a CSV file
+  if (CSV::Player::instance().isOpen())
+    return;
+
+  // Don't save data when the device/service is not connected
+  if (!IO::Manager::instance().connected()
+      && !MQTT::Client::instance().isSubscribed())
+    return;
+
+  // Ignore if frame is invalid
+  if (!frame.isValid())
+    return;
+
+  // Register frame & its reception time (in nanoseconds since the epoch)
+  const auto rxTimestamp = frame.timestamp() > 0 ? frame.timestamp()
+                                                 : Misc::SessionClock::now();
+  TimestampFrame tframe;
+  tframe.data = frame;
+  tframe.timestamp = Misc::SessionClock::toUnixNsecs(rxTimestamp);
+  m_frames.append(tframe);
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include <QObject>
+#include <QDataStream>
+
+#include "JSON/Frame.h"
+
+namespace CSV
+{
+/**
+ * @brief The BinaryExport class
+ *
+ * The binary export class records the received frames into a columnar binary
+ * session file, which is much faster to write & load than a CSV file for long
+ * sessions with high frame rates. It works next to the @c CSV::Export class,
+ * both exports can be enabled independently.
+ *
+ * A session file (@c .ssb) is made of a header, a list of compressed blocks
+ * and a footer index. All integers & floating point numbers are stored in
+ * little-endian byte order, and strings are stored as a @c quint32 byte count
+ * followed by their UTF-8 representation.
+ *
+ * - Header: the @c "SSBINARY" magic, a @c quint32 format version, the project
+ *   title and a @c quint32 column count. Each column is described by its type
+ *   (@c quint8, 0 for @c float64 and 1 for strings), the @c qint32 dataset
+ *   index and the column name (group/dataset titles).
+ * - Block: the @c "SSBK" magic, the @c quint32 row count, the @c qint64
+ *   timestamps of the first & last row, and the @c quint32 sizes of the
+ *   uncompressed & compressed payload, followed by the payload as a zlib
+ *   stream. The payload stores the @c qint64 timestamps of all rows
+ *   (nanoseconds since the Unix epoch), followed by the values of each column:
+ *   @c float64 values (NaN for missing values) or strings.
+ * - Footer: the @c "SSIX" magic, the @c quint32 block count and the file
+ *   offset, row count & first/last timestamps of each block. It is followed
+ *   by a sparse time index: the @c "SSTI" magic, a @c quint32 entry count and
+ *   the @c qint64 timestamp & @c quint64 row number of the first row of each
+ *   second of the session. The file ends with the @c qint64 file offset of
+ *   the footer and the @c "SSBINEND" magic, so that readers can seek to any
+ *   block or point in time without scanning the whole file.
+ *
+ * Blocks are written each time the @c Misc::TimerEvents low-frequency timer
+ * expires (e.g. every 1 second).
+ */
+class BinaryExport : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool isOpen
+             READ isOpen
+             NOTIFY openChanged)
+  Q_PROPERTY(bool exportEnabled
+             READ exportEnabled
+             WRITE setExportEnabled
+             NOTIFY enabledChanged)
+  // clang-format on
+
+signals:
+  void openChanged();
+  void enabledChanged();
+
+private:
+  explicit BinaryExport();
+  BinaryExport(BinaryExport &&) = delete;
+  BinaryExport(const BinaryExport &) = delete;
+  BinaryExport &operator=(BinaryExport &&) = delete;
+  BinaryExport &operator=(const BinaryExport &) = delete;
+
+  ~BinaryExport();
+
+public:
+  static BinaryExport &instance();
+
+  [[nodiscard]] bool isOpen() const;
+  [[nodiscard]] bool exportEnabled() const;
+
+public slots:
+  void closeFile();
+  void openCurrentFile();
+  void setupExternalConnections();
+  void setExportEnabled(const bool enabled);
+
+private slots:
+  void writeValues();
+  void registerFrame(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Type of the values stored in a column.
+   */
+  enum ColumnType : quint8
+  {
+    Float64 = 0,
+    String = 1,
+  };
+
+  /**
+   * @brief Position & time range of a block, written to the footer index.
+   */
+  struct BlockInfo
+  {
+    qint64 offset;
+    quint32 rows;
+    qint64 firstTimestamp;
+    qint64 lastTimestamp;
+  };
+
+  /**
+   * @brief Time index entry, written to the footer index.
+   */
+  struct TimeIndexEntry
+  {
+    qint64 timestamp;
+    quint64 row;
+  };
+
+  /**
+   * @brief Frame received from the device & its reception time.
+   */
+  struct TimestampFrame
+  {
+    JSON::Frame data;
+    qint64 timestamp;
+  };
+
+  bool createFile(const TimestampFrame &frame);
+  void writeBlock(const TimestampFrame *frames, const qsizetype count);
+
+private:
+  QFile m_file;
+  QString m_path;
+  bool m_exportEnabled;
+  QDataStream m_stream;
+
+  QVector<int> m_columnIndexes;
+  QVector<ColumnType> m_columnTypes;
+  QHash<int, int> m_columnLookup;
+
+  quint64 m_rowCount;
+  QVector<BlockInfo> m_blocks;
+  QVector<TimeIndexEntry> m_timeIndex;
+  QVector<TimestampFrame> m_frames;
+};
+} // namespace CSV
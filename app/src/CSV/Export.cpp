@@ -22,11 +22,11 @@
 
 #include "Export.h"
 
+#include <array>
+
 #include <QDir>
-#include <QUrl>
-#include <QFileInfo>
+#include <QLocale>
 #include <QApplication>
-#include <QDesktopServices>
 #include <QStandardPaths>
 
 #include "IO/Manager.h"
@@ -34,19 +34,90 @@
 #include "MQTT/Client.h"
 #include "Misc/Utilities.h"
 #include "Misc/TimerEvents.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
 #include "JSON/FrameBuilder.h"
+#include "Misc/Trace.h"
+
+/**
+ * Fraction of the frame bus that may be waiting to be written before the
+ * writer thread is asked to read it ahead of the 1 Hz timer
+ */
+static constexpr std::size_t kEarlyReadDivisor = 4;
+
+/**
+ * File sizes after which a new part of the session is created, 0 disables
+ * rotation by size
+ */
+static constexpr std::array<qint64, 5> kRotationSizes
+    = {0, 64ll * 1024 * 1024, 256ll * 1024 * 1024, 1024ll * 1024 * 1024,
+       4096ll * 1024 * 1024};
+
+/**
+ * File durations (in minutes) after which a new part of the session is
+ * created, 0 disables rotation by time
+ */
+static constexpr std::array<qint64, 5> kRotationIntervals
+    = {0, 15, 60, 6 * 60, 24 * 60};
+
+/**
+ * Nanoseconds in a minute
+ */
+static constexpr qint64 kNsecsPerMinute = 60ll * 1000 * 1000 * 1000;
 
 /**
  * Connect JSON Parser & Serial Manager signals to begin registering JSON
- * dataframes into JSON list.
+ * dataframes into JSON list, and starts the CSV writer thread.
  */
 CSV::Export::Export()
-  : m_exportEnabled(true)
+  : m_isOpen(false)
+  , m_writerBusy(false)
+  , m_backPressure(false)
+  , m_exportEnabled(true)
+  , m_sparseRows(false)
+  , m_compressFiles(false)
+  , m_rotationSize(0)
+  , m_rotationInterval(0)
+  , m_frameConsumer(-1)
+  , m_droppedFrames(0)
+  , m_writeStart(0)
+  , m_frameMemory(0)
 {
   m_csvPath = QStringLiteral("%1/%2/CSV")
                   .arg(QStandardPaths::writableLocation(
                            QStandardPaths::DocumentsLocation),
                        qApp->applicationDisplayName());
+
+  // Read frames from the frame bus, losing the oldest ones if the disk is slow
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  m_frameConsumer = bus.addConsumer(JSON::FrameBus::Policy::DropOldest);
+  m_writer.setFrameBus(&bus, m_frameConsumer);
+
+  // Format & write CSV data in its own thread
+  m_writer.setCsvPath(m_csvPath);
+  m_writer.moveToThread(&m_writerThread);
+  connect(&m_writer, &CSV::ExportWriter::fileOpened, this,
+          &CSV::Export::onFileOpened, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ExportWriter::fileClosed, this,
+          &CSV::Export::onFileClosed, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ExportWriter::openFailed, this,
+          &CSV::Export::onOpenFailed, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::ExportWriter::framesWritten, this,
+          &CSV::Export::onFramesWritten, Qt::QueuedConnection);
+
+  // Write the remaining frames & stop the writer thread before quitting
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    closeFile();
+    m_writerThread.quit();
+    if (!m_writerThread.wait(5000))
+      m_writerThread.terminate();
+  });
+
+  // Start the writer thread
+  m_writerThread.setObjectName(QStringLiteral("CSV Writer"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_writerThread, Misc::ThreadScheduler::Role::Exporter);
+  m_writerThread.start(QThread::LowPriority);
 }
 
 /**
@@ -55,6 +126,8 @@ CSV::Export::Export()
 CSV::Export::~Export()
 {
   closeFile();
+  m_writerThread.quit();
+  m_writerThread.wait();
 }
 
 /**
@@ -71,7 +144,7 @@ CSV::Export &CSV::Export::instance()
  */
 bool CSV::Export::isOpen() const
 {
-  return m_csvFile.isOpen();
+  return m_isOpen;
 }
 
 /**
@@ -82,13 +155,89 @@ bool CSV::Export::exportEnabled() const
   return m_exportEnabled;
 }
 
+/**
+ * Returns @c true if the CSV rows only contain the values that changed since
+ * the previous row
+ */
+bool CSV::Export::sparseRows() const
+{
+  return m_sparseRows;
+}
+
+/**
+ * Returns @c true if new CSV files are compressed with gzip
+ */
+bool CSV::Export::compressFiles() const
+{
+  return m_compressFiles;
+}
+
+/**
+ * Returns the index of the file size after which a new part of the session
+ * is created, as an index of the list returned by @c rotationSizes()
+ */
+int CSV::Export::rotationSize() const
+{
+  return m_rotationSize;
+}
+
+/**
+ * Returns the index of the file duration after which a new part of the
+ * session is created, as an index of the list returned by
+ * @c rotationIntervals()
+ */
+int CSV::Export::rotationInterval() const
+{
+  return m_rotationInterval;
+}
+
+/**
+ * Returns the list of file sizes that can be used to rotate CSV files
+ */
+QStringList CSV::Export::rotationSizes() const
+{
+  QStringList list;
+  list.append(tr("No Limit"));
+  for (std::size_t i = 1; i < kRotationSizes.size(); ++i)
+    list.append(QLocale().formattedDataSize(kRotationSizes[i], 0));
+
+  return list;
+}
+
+/**
+ * Returns the list of file durations that can be used to rotate CSV files
+ */
+QStringList CSV::Export::rotationIntervals() const
+{
+  return {tr("No Limit"), tr("15 Minutes"), tr("1 Hour"), tr("6 Hours"),
+          tr("24 Hours")};
+}
+
+/**
+ * Returns @c true if the writer thread is falling behind, e.g. when more than
+ * half of the frame queue is waiting to be written.
+ */
+bool CSV::Export::backPressure() const
+{
+  return m_backPressure;
+}
+
+/**
+ * Returns the number of frames that have been dropped since the current CSV
+ * file was created because the frame queue was full.
+ */
+quint64 CSV::Export::droppedFrames() const
+{
+  return m_droppedFrames;
+}
+
 /**
  * Open the current CSV file in the Explorer/Finder window
  */
 void CSV::Export::openCurrentCsv()
 {
   if (isOpen())
-    Misc::Utilities::revealFile(m_csvFile.fileName());
+    Misc::Utilities::revealFile(m_fileName);
   else
     Misc::Utilities::showMessageBox(tr("CSV file not open"),
                                     tr("Cannot find CSV export file!"));
@@ -103,7 +252,7 @@ void CSV::Export::setupExternalConnections()
   connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
           &Export::closeFile);
   connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
-          this, &Export::registerFrame, Qt::QueuedConnection);
+          this, &Export::registerFrame);
   connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
           &Export::writeValues);
 }
@@ -116,229 +265,252 @@ void CSV::Export::setExportEnabled(const bool enabled)
   m_exportEnabled = enabled;
   Q_EMIT enabledChanged();
 
-  if (!exportEnabled() && isOpen())
-  {
-    m_frames.clear();
-    m_frames.squeeze();
+  if (!exportEnabled())
     closeFile();
-  }
 }
 
 /**
- * Write all remaining JSON frames & close the CSV file
+ * Enables or disables sparse CSV rows, the setting is handed over to the
+ * writer thread so that it applies to the next written row.
  */
-void CSV::Export::closeFile()
+void CSV::Export::setSparseRows(const bool enabled)
 {
-  if (isOpen())
-  {
-    while (!m_frames.isEmpty())
-      writeValues();
+  m_sparseRows = enabled;
+  QMetaObject::invokeMethod(
+      &m_writer, [=] { m_writer.setSparseRows(enabled); },
+      Qt::QueuedConnection);
 
-    m_csvFile.close();
-    m_textStream.setDevice(nullptr);
+  Q_EMIT sparseRowsChanged();
+}
 
-    Q_EMIT openChanged();
-  }
+/**
+ * Enables or disables gzip compression, the setting is handed over to the
+ * writer thread and applies to the next created file.
+ */
+void CSV::Export::setCompressFiles(const bool enabled)
+{
+  m_compressFiles = enabled;
+  QMetaObject::invokeMethod(
+      &m_writer, [=] { m_writer.setCompressed(enabled); },
+      Qt::QueuedConnection);
+
+  Q_EMIT compressFilesChanged();
 }
 
 /**
- * @brief Writes frame data to the current CSV file.
- *
- * This function writes the data from all stored frames (`m_frames`) to the
- * currently open CSV file. It ensures that values in each row are written
- * in the same order as the headers, based on dataset indexes.
+ * Selects the file size after which a new part of the session is created, as
+ * an index of the list returned by @c rotationSizes()
+ */
+void CSV::Export::setRotationSize(const int index)
+{
+  const auto max = static_cast<int>(kRotationSizes.size()) - 1;
+  m_rotationSize = qBound(0, index, max);
+  updateRotation();
+}
+
+/**
+ * Selects the file duration after which a new part of the session is
+ * created, as an index of the list returned by @c rotationIntervals()
+ */
+void CSV::Export::setRotationInterval(const int index)
+{
+  const auto max = static_cast<int>(kRotationIntervals.size()) - 1;
+  m_rotationInterval = qBound(0, index, max);
+  updateRotation();
+}
+
+/**
+ * @brief Writes all remaining frames & closes the CSV file.
  *
- * If the file is not open, it creates the CSV file using the first frame and
- * sets up the headers before writing data. Missing dataset values are replaced
- * with empty strings.
+ * This function blocks until the writer thread has written every frame that
+ * is waiting in the frame bus, so that no data is lost when the device is
+ * disconnected or the application quits. The export then stops reading the
+ * bus until the next frame that should be exported arrives.
+ */
+void CSV::Export::closeFile()
+{
+  // Write the frames & close the file from the writer thread, a single read
+  // empties the bus because no frames are published in the meantime
+  const auto type = m_writerThread.isRunning() ? Qt::BlockingQueuedConnection
+                                               : Qt::DirectConnection;
+  QMetaObject::invokeMethod(
+      &m_writer,
+      [=] {
+        m_writer.readFrameBus();
+        m_writer.closeFile();
+      },
+      type);
+
+  // Stop reading frames
+  JSON::FrameBuilder::instance().frameBus().detach(m_frameConsumer);
+}
+
+/**
+ * @brief Asks the writer thread to write the frames waiting in the frame bus.
  *
- * After writing, the stream is flushed to ensure the data is saved, and
- * the frame buffer (`m_frames`) is cleared.
+ * If the writer is still busy with the previous frames, the new ones remain
+ * in the bus until the next call, so that the main thread never waits for
+ * the disk.
  */
 void CSV::Export::writeValues()
 {
-  // Initialize a list of pairs between indexes & headers
-  static QVector<QPair<int, QString>> indexHeaderPairs;
+  TRACE_ZONE("Export::writeValues");
+
+  // Report the state of the frame queue to the user interface
+  updateWriterStatus();
+  const auto &bus = JSON::FrameBuilder::instance().frameBus();
+  const auto pending = bus.pending(m_frameConsumer);
+  TRACE_COUNTER("CSV export queue", pending);
+
+  // Report the memory retained by the unwritten frames of the bus
+  Misc::PipelineStats::instance().setMemoryUsage(
+      Misc::PipelineStats::CsvExportQueue, pending * m_frameMemory);
+
+  // Writer busy or nothing to do
+  if (m_writerBusy || pending == 0)
+    return;
+
+  // Let the writer thread read the frames
+  m_writerBusy = true;
+  m_writeStart = Misc::PipelineStats::timestamp();
+  QMetaObject::invokeMethod(&m_writer, &CSV::ExportWriter::readFrameBus,
+                            Qt::QueuedConnection);
+}
 
-  // Write each frame
-  for (auto i = m_frames.begin(); i != m_frames.end(); ++i)
+/**
+ * Updates the UI when the writer thread closes the CSV file
+ */
+void CSV::Export::onFileClosed()
+{
+  if (m_isOpen)
   {
-    // File not open, create it & add cell titles
-    if (!isOpen() && exportEnabled())
-    {
-      indexHeaderPairs.clear();
-      indexHeaderPairs.squeeze();
-      indexHeaderPairs = createCsvFile(*i);
-    }
-
-    // Continue if index/header pairs is not empty
-    if (indexHeaderPairs.isEmpty())
-      return;
-
-    // Obtain frame data
-    const auto &data = i->data;
-    const auto &rxTime = i->rxDateTime;
-
-    // Write RX date/time
-    const auto format = QStringLiteral("yyyy/MM/dd HH:mm:ss::zzz");
-    m_textStream << rxTime.toString(format) << QStringLiteral(",");
-
-    // Write frame data in the order of sorted fields
-    const auto &groups = data.groups();
-    QMap<int, QString> fieldValues;
-
-    // Iterate through groups and datasets to collect field values
-    for (auto g = groups.constBegin(); g != groups.constEnd(); ++g)
-    {
-      const auto &datasets = g->datasets();
-      for (auto d = datasets.constBegin(); d != datasets.constEnd(); ++d)
-        fieldValues[d->index()] = d->value().simplified();
-    }
-
-    // Write data according to the sorted field order
-    for (int i = 0; i < indexHeaderPairs.count(); ++i)
-    {
-      // Print value for current pair
-      const auto fieldIndex = indexHeaderPairs[i].first;
-      m_textStream << fieldValues.value(fieldIndex, QStringLiteral(""));
-
-      // Add comma or newline based on the position in the row
-      if (i < indexHeaderPairs.count() - 1)
-        m_textStream << QStringLiteral(",");
-      else
-        m_textStream << QStringLiteral("\n");
-    }
+    m_isOpen = false;
+    m_fileName.clear();
+    Q_EMIT openChanged();
   }
+}
 
-  // Flush the stream to writte it to the hard disk
-  m_textStream.flush();
-
-  // Clear frames
-  m_frames.clear();
-  m_frames.squeeze();
+/**
+ * Notifies the user that the CSV file could not be created
+ */
+void CSV::Export::onOpenFailed()
+{
+  Misc::Utilities::showMessageBox(tr("CSV File Error"),
+                                  tr("Cannot open CSV file for writing!"));
 }
 
 /**
- * @brief Creates and initializes a new CSV file for exporting frame data.
- *
- * This function generates a CSV file in a project-specific directory using the
- * frame's data and timestamps. The dataset headers are added to the CSV file,
- * sorted by their indexes, ensuring ordered column headers. If the file cannot
- * be created or opened, an error message is displayed, and the function returns
- * an empty vector.
- *
- * @param frame The frame containing data and timestamp information.
- * @return A vector of pairs, each containing a dataset index and its
- * corresponding header string, sorted by the dataset index.
+ * Allows the writer thread to read the next frames & registers the time it
+ * took to write the previous ones
  */
-QVector<QPair<int, QString>>
-CSV::Export::createCsvFile(const CSV::TimestampFrame &frame)
+void CSV::Export::onFramesWritten(const qsizetype frames)
 {
-  // Obtain frame data
-  const auto &data = frame.data;
-  const auto &rxTime = frame.rxDateTime;
+  m_writerBusy = false;
 
-  // Get file name
-  const auto fileName
-      = rxTime.toString(QStringLiteral("yyyy_MMM_dd HH_mm_ss")) + ".csv";
+  auto &stats = Misc::PipelineStats::instance();
+  stats.record(Misc::PipelineStats::CsvExport, frames, 0,
+               stats.timestamp() - m_writeStart);
+}
 
-  // Get path
-  const QString path = QStringLiteral("%1/%2/").arg(m_csvPath, data.title());
+/**
+ * Hands the selected rotation limits over to the writer thread
+ */
+void CSV::Export::updateRotation()
+{
+  const auto size = kRotationSizes[m_rotationSize];
+  const auto minutes = kRotationIntervals[m_rotationInterval];
+  const auto duration = minutes * kNsecsPerMinute;
+  QMetaObject::invokeMethod(
+      &m_writer, [=] { m_writer.setRotation(size, duration); },
+      Qt::QueuedConnection);
+
+  Q_EMIT rotationChanged();
+}
 
-  // Generate file path if required
-  QDir dir(path);
-  if (!dir.exists())
-    dir.mkpath(".");
+/**
+ * Updates the back-pressure state of the frame queue & notifies the UI when
+ * it changes, or when new frames have been dropped.
+ */
+void CSV::Export::updateWriterStatus()
+{
+  static quint64 reportedDrops = 0;
 
-  // Open file
-  m_csvFile.setFileName(dir.filePath(fileName));
-  if (!m_csvFile.open(QIODevice::WriteOnly | QIODevice::Text))
+  // Register the frames that the writer missed because it fell behind
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  const auto dropped = bus.takeDropped(m_frameConsumer);
+  if (dropped > 0)
   {
-    Misc::Utilities::showMessageBox(tr("CSV File Error"),
-                                    tr("Cannot open CSV file for writing!"));
-    closeFile();
-    return QVector<QPair<int, QString>>();
+    m_droppedFrames += dropped;
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::CsvExport, dropped);
   }
 
-  // Add cell titles & force UTF-8 codec
-  m_textStream.setDevice(&m_csvFile);
-  m_textStream.setGenerateByteOrderMark(true);
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-  m_textStream.setCodec("UTF-8");
-#else
-  m_textStream.setEncoding(QStringConverter::Utf8);
-#endif
-
-  // Get number of fields by counting datasets with non-duplicated indexes
-  QVector<QString> headers;
-  QVector<int> datasetIndexes;
-  const auto &groups = data.groups();
-  for (auto g = groups.constBegin(); g != groups.constEnd(); ++g)
+  // Update the UI
+  const auto pressure = bus.pending(m_frameConsumer) >= bus.capacity() / 2;
+  if (pressure != m_backPressure || reportedDrops != m_droppedFrames)
   {
-    const auto &datasets = g->datasets();
-    for (auto d = datasets.constBegin(); d != datasets.constEnd(); ++d)
-    {
-      if (!datasetIndexes.contains(d->index()))
-      {
-        auto header = QString("%1/%2").arg(g->title(), d->title()).simplified();
-        datasetIndexes.append(d->index());
-        headers.append(header);
-      }
-    }
+    m_backPressure = pressure;
+    reportedDrops = m_droppedFrames;
+    Q_EMIT writerStatusChanged();
   }
+}
 
-  // Combine fields and headers into pairs for sorting
-  QVector<QPair<int, QString>> fieldHeaderPairs;
-  for (int i = 0; i < datasetIndexes.count(); ++i)
-    fieldHeaderPairs.append(qMakePair(datasetIndexes[i], headers[i]));
-
-  // Sort the pairs based on the field values (first element of the pair)
-  std::sort(fieldHeaderPairs.begin(), fieldHeaderPairs.end(),
-            [](const QPair<int, QString> &a, const QPair<int, QString> &b) {
-              return a.first < b.first;
-            });
-
-  // Add CSV header directly from sorted pairs
-  m_textStream << QStringLiteral("RX Date/Time,");
-  for (int i = 0; i < fieldHeaderPairs.count(); ++i)
-  {
-    m_textStream << fieldHeaderPairs[i].second;
-    if (i < fieldHeaderPairs.count() - 1)
-      m_textStream << QStringLiteral(",");
-    else
-      m_textStream << QStringLiteral("\n");
-  }
+/**
+ * Updates the UI when the writer thread creates a new CSV file
+ */
+void CSV::Export::onFileOpened(const QString &path)
+{
+  m_isOpen = true;
+  m_fileName = path;
+  m_droppedFrames = 0;
+  updateWriterStatus();
 
-  // Update UI
   Q_EMIT openChanged();
-  return fieldHeaderPairs;
 }
 
 /**
- * Appends the latest frame from the device to the output buffer
+ * @brief Starts or stops reading the frame bus when a new frame is published.
+ *
+ * This function runs in the thread of the frame builder, right after the
+ * @a frame has been published to the frame bus. The export reads the bus
+ * only while the frames should be saved; when that is no longer the case,
+ * the frames that are still waiting are written & the file is closed.
+ *
+ * If the unwritten frames fill a quarter of the bus, the writer thread is
+ * asked to read them without waiting for the 1 Hz timer.
  */
 void CSV::Export::registerFrame(const JSON::Frame &frame)
 {
-  // Ignore if CSV export is disabled
-  if (!exportEnabled())
-    return;
-
-  // Don't generate a CSV file when we are playing a CSV file
-  if (CSV::Player::instance().isOpen())
-    return;
+  // Check if the frames should be saved, playing a CSV file or receiving data
+  // from a disconnected device/service does not generate a CSV file
+  const bool save = exportEnabled() && !CSV::Player::instance().isOpen()
+                    && (IO::Manager::instance().connected()
+                        || MQTT::Client::instance().isSubscribed());
+
+  // Stop reading the frame bus
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (!save)
+  {
+    if (bus.isAttached(m_frameConsumer))
+      closeFile();
 
-  // Don't save CSV data when the device/service is not connected
-  if (!IO::Manager::instance().connected()
-      && !MQTT::Client::instance().isSubscribed())
     return;
+  }
 
-  // Ignore if frame is invalid
-  if (!frame.isValid())
-    return;
+  // Start reading the frame bus, beginning with this frame
+  if (!bus.isAttached(m_frameConsumer))
+  {
+    bus.attach(m_frameConsumer);
+    m_frameMemory = frame.memoryUsage();
+  }
 
-  // Register raw frame to list
-  TimestampFrame tframe;
-  tframe.data = frame;
-  tframe.rxDateTime = QDateTime::currentDateTime();
-  m_frames.append(tframe);
+  // Let the writer thread catch up before the bus is full
+  if (!m_writerBusy
+      && bus.pending(m_frameConsumer) >= bus.capacity() / kEarlyReadDivisor)
+  {
+    m_writerBusy = true;
+    m_writeStart = Misc::PipelineStats::timestamp();
+    QMetaObject::invokeMethod(&m_writer, &CSV::ExportWriter::readFrameBus,
+                              Qt::QueuedConnection);
+  }
 }
@@ -22,15 +22,11 @@
 
 #pragma once
 
-#include <QFile>
-#include <QVector>
+#include <QThread>
 #include <QObject>
-#include <QVariant>
-#include <QDateTime>
-#include <QTextStream>
-#include <QJsonObject>
 
 #include "JSON/Frame.h"
+#include "CSV/ExportWriter.h"
 
 namespace CSV
 {
@@ -40,17 +36,20 @@ namespace CSV
  * The CSV export class receives data from the @c IO::Manager class and
  * exports the received frames into a CSV file selected by the user.
  *
- * CSV-data is generated periodically each time the @c Misc::TimerEvents
- * low-frequency timer expires (e.g. every 1 second). The idea behind this
- * is to allow exporting data, but avoid freezing the application when serial
- * data is received continuously.
+ * Received frames are read from the @c JSON::FrameBus by the
+ * @c CSV::ExportWriter worker thread each time the @c Misc::TimerEvents
+ * low-frequency timer expires (e.g. every 1 second), or earlier if a quarter
+ * of the bus is waiting to be written. Formatting and file I/O never run in
+ * the main thread, so a slow disk or network share does not freeze the
+ * application. If the writer falls a whole bus behind, the oldest frames are
+ * dropped (instead of blocking data acquisition) and the drop count is
+ * reported to the user interface.
+ *
+ * Optionally, the writer can produce sparse rows that only contain the values
+ * that changed since the previous row, compress the files with gzip and split
+ * long sessions into several files by size or duration (see
+ * @c CSV::ExportWriter).
  */
-typedef struct
-{
-  JSON::Frame data;
-  QDateTime rxDateTime;
-} TimestampFrame;
-
 class Export : public QObject
 {
   // clang-format off
@@ -62,11 +61,43 @@ class Export : public QObject
              READ exportEnabled
              WRITE setExportEnabled
              NOTIFY enabledChanged)
+  Q_PROPERTY(bool sparseRows
+             READ sparseRows
+             WRITE setSparseRows
+             NOTIFY sparseRowsChanged)
+  Q_PROPERTY(bool compressFiles
+             READ compressFiles
+             WRITE setCompressFiles
+             NOTIFY compressFilesChanged)
+  Q_PROPERTY(int rotationSize
+             READ rotationSize
+             WRITE setRotationSize
+             NOTIFY rotationChanged)
+  Q_PROPERTY(int rotationInterval
+             READ rotationInterval
+             WRITE setRotationInterval
+             NOTIFY rotationChanged)
+  Q_PROPERTY(QStringList rotationSizes
+             READ rotationSizes
+             CONSTANT)
+  Q_PROPERTY(QStringList rotationIntervals
+             READ rotationIntervals
+             CONSTANT)
+  Q_PROPERTY(bool backPressure
+             READ backPressure
+             NOTIFY writerStatusChanged)
+  Q_PROPERTY(quint64 droppedFrames
+             READ droppedFrames
+             NOTIFY writerStatusChanged)
   // clang-format on
 
 signals:
   void openChanged();
   void enabledChanged();
+  void rotationChanged();
+  void sparseRowsChanged();
+  void compressFilesChanged();
+  void writerStatusChanged();
 
 private:
   explicit Export();
@@ -82,25 +113,55 @@ public:
 
   [[nodiscard]] bool isOpen() const;
   [[nodiscard]] bool exportEnabled() const;
+  [[nodiscard]] bool sparseRows() const;
+  [[nodiscard]] bool compressFiles() const;
+  [[nodiscard]] int rotationSize() const;
+  [[nodiscard]] int rotationInterval() const;
+  [[nodiscard]] QStringList rotationSizes() const;
+  [[nodiscard]] QStringList rotationIntervals() const;
+  [[nodiscard]] bool backPressure() const;
+  [[nodiscard]] quint64 droppedFrames() const;
 
 public slots:
   void closeFile();
   void openCurrentCsv();
   void setupExternalConnections();
   void setExportEnabled(const bool enabled);
+  void setSparseRows(const bool enabled);
+  void setCompressFiles(const bool enabled);
+  void setRotationSize(const int index);
+  void setRotationInterval(const int index);
 
 private slots:
   void writeValues();
+  void onFileClosed();
+  void onOpenFailed();
+  void onFramesWritten(const qsizetype frames);
+  void updateWriterStatus();
+  void onFileOpened(const QString &path);
   void registerFrame(const JSON::Frame &frame);
 
 private:
-  QVector<QPair<int, QString>> createCsvFile(const CSV::TimestampFrame &frame);
+  void updateRotation();
 
 private:
-  QFile m_csvFile;
-  QString m_csvPath;
+  bool m_isOpen;
+  bool m_writerBusy;
+  bool m_backPressure;
   bool m_exportEnabled;
-  QTextStream m_textStream;
-  QVector<TimestampFrame> m_frames;
+  bool m_sparseRows;
+  bool m_compressFiles;
+  int m_rotationSize;
+  int m_rotationInterval;
+
+  QString m_csvPath;
+  QString m_fileName;
+  int m_frameConsumer;
+  quint64 m_droppedFrames;
+  qint64 m_writeStart;
+  qint64 m_frameMemory;
+
+  QThread m_writerThread;
+  CSV::ExportWriter m_writer;
 };
 } // namespace CSV
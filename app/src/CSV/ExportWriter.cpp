@@ -0,0 +1,664 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ExportWriter.h"
+
+#include <numeric>
+#include <charconv>
+
+#include <QDir>
+#include <QDate>
+#include <QHash>
+#include <QLocale>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include "CSV/Gzip.h"
+#include "Misc/Trace.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Size of the row buffer after which its contents are written to the file
+ */
+static constexpr qsizetype kFlushThreshold = 64 * 1024;
+
+/**
+ * Milliseconds in a day & Julian day number of the Unix epoch (1970/01/01)
+ */
+static constexpr qint64 kMsecsPerDay = 24 * 60 * 60 * 1000;
+static constexpr qint64 kUnixEpochJulianDay = 2440588;
+
+/**
+ * Appends @a value to @a buffer in decimal, padded with leading zeros up to
+ * @a width digits.
+ */
+static void appendNumber(QByteArray &buffer, const int value, const int width)
+{
+  char digits[16];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  const auto length = static_cast<int>(result.ptr - digits);
+  for (int i = length; i < width; ++i)
+    buffer.append('0');
+
+  buffer.append(digits, length);
+}
+
+/**
+ * Appends the UTF-8 representation of @a string to @a buffer, without
+ * allocating a temporary byte array for plain ASCII strings.
+ */
+static void appendString(QByteArray &buffer, const QString &string)
+{
+  const auto *data = string.constData();
+  const auto length = string.length();
+  for (qsizetype i = 0; i < length; ++i)
+  {
+    if (data[i].unicode() >= 0x80)
+    {
+      buffer.append(QStringView(data + i, length - i).toUtf8());
+      return;
+    }
+
+    buffer.append(static_cast<char>(data[i].unicode()));
+  }
+}
+
+/**
+ * Appends the local time of the given steady clock @a timestamp to @a buffer
+ * using the "yyyy/MM/dd HH:mm:ss::zzz" format.
+ *
+ * The timestamp is split into days & milliseconds with integer arithmetic, so
+ * no time zone conversion takes place for each row.
+ */
+static void appendDateTime(QByteArray &buffer, const qint64 timestamp)
+{
+  const auto local = Misc::SessionClock::toLocalMsecs(timestamp);
+  auto days = local / kMsecsPerDay;
+  auto msecs = local % kMsecsPerDay;
+  if (msecs < 0)
+  {
+    msecs += kMsecsPerDay;
+    --days;
+  }
+
+  const auto date = QDate::fromJulianDay(kUnixEpochJulianDay + days);
+  const auto ms = static_cast<int>(msecs);
+
+  appendNumber(buffer, date.year(), 4);
+  buffer.append('/');
+  appendNumber(buffer, date.month(), 2);
+  buffer.append('/');
+  appendNumber(buffer, date.day(), 2);
+  buffer.append(' ');
+  appendNumber(buffer, ms / 3600000, 2);
+  buffer.append(':');
+  appendNumber(buffer, ms / 60000 % 60, 2);
+  buffer.append(':');
+  appendNumber(buffer, ms / 1000 % 60, 2);
+  buffer.append("::", 2);
+  appendNumber(buffer, ms % 1000, 3);
+}
+
+/**
+ * Constructor function
+ */
+CSV::ExportWriter::ExportWriter(QObject *parent)
+  : QObject(parent)
+  , m_sparseRows(false)
+  , m_sparseRowCount(0)
+  , m_compressed(false)
+  , m_fileCompressed(false)
+  , m_maxFileSize(0)
+  , m_maxFileDuration(0)
+  , m_fileRows(0)
+  , m_fileFirstRow(0)
+  , m_fileLastRow(0)
+  , m_frameConsumer(-1)
+  , m_frameBus(nullptr)
+  , m_csvFile(this)
+{
+}
+
+/**
+ * Close file & finnish write-operations before destroying the class
+ */
+CSV::ExportWriter::~ExportWriter()
+{
+  closeFile();
+}
+
+/**
+ * Returns @c true if the CSV output file is open
+ */
+bool CSV::ExportWriter::isOpen() const
+{
+  return m_csvFile.isOpen();
+}
+
+/**
+ * Flushes pending data & closes the CSV file, ending the current session
+ */
+void CSV::ExportWriter::closeFile()
+{
+  if (isOpen())
+  {
+    finishPart();
+    m_buffer.squeeze();
+    m_rowDatasets.clear();
+    m_slotColumns.clear();
+    m_rawDatasets.clear();
+    m_rawSlotColumns.clear();
+    m_writtenGenerations.clear();
+    m_rawWrittenGenerations.clear();
+    m_manifestPath.clear();
+    m_manifestParts = QJsonArray();
+
+    Q_EMIT fileClosed();
+  }
+}
+
+/**
+ * Changes the root directory in which CSV files are created
+ */
+void CSV::ExportWriter::setCsvPath(const QString &path)
+{
+  m_csvPath = path;
+}
+
+/**
+ * @brief Sets the frame bus read by @c readFrameBus().
+ *
+ * @param bus Ring to which the frame builder publishes frames.
+ * @param consumer Cursor of the CSV export in @a bus.
+ */
+void CSV::ExportWriter::setFrameBus(JSON::FrameBus *bus, const int consumer)
+{
+  m_frameBus = bus;
+  m_frameConsumer = consumer;
+}
+
+/**
+ * Enables or disables writing sparse rows, the next row is always complete
+ */
+void CSV::ExportWriter::setSparseRows(const bool enabled)
+{
+  m_sparseRows = enabled;
+  m_sparseRowCount = 0;
+}
+
+/**
+ * Enables or disables gzip compression, the setting applies to the next
+ * created file
+ */
+void CSV::ExportWriter::setCompressed(const bool enabled)
+{
+  m_compressed = enabled;
+}
+
+/**
+ * @brief Changes the limits after which a new part of the session is created.
+ *
+ * @param maxSize Maximum size of a file in bytes, 0 disables the limit.
+ * @param maxDuration Maximum time between the first & last row of a file in
+ *                    nanoseconds, 0 disables the limit.
+ */
+void CSV::ExportWriter::setRotation(const qint64 maxSize,
+                                    const qint64 maxDuration)
+{
+  m_maxFileSize = qMax<qint64>(0, maxSize);
+  m_maxFileDuration = qMax<qint64>(0, maxDuration);
+}
+
+/**
+ * @brief Writes the given frames to the current CSV file.
+ *
+ * Each frame is formatted by @c writeRow(). After writing, the buffer is
+ * written to the file to ensure the data is saved, and the
+ * @c framesWritten() signal is emitted.
+ */
+void CSV::ExportWriter::writeFrames(const QVector<CSV::TimestampFrame> &frames)
+{
+  TRACE_ZONE("ExportWriter::writeFrames");
+
+  // Write each frame
+  qsizetype count = 0;
+  for (const auto &frame : frames)
+  {
+    if (!writeRow(frame))
+      break;
+
+    ++count;
+  }
+
+  // Write the remaining data to the hard disk
+  flushBuffer();
+
+  // Notify the export module that the batch has been written
+  Q_EMIT framesWritten(count);
+}
+
+/**
+ * @brief Writes the frames that are waiting in the frame bus.
+ *
+ * Frames are copied one by one from the ring into a reusable frame, which
+ * shares the storage of its slot, so reading them does not allocate memory.
+ * Frames without a reception time are stamped with the current time. At most
+ * one ring worth of frames is written on each call, so that the
+ * @c framesWritten() signal is emitted regularly under a constant stream of
+ * frames.
+ */
+void CSV::ExportWriter::readFrameBus()
+{
+  TRACE_ZONE("ExportWriter::readFrameBus");
+
+  // No frame bus available
+  if (!m_frameBus || m_frameConsumer < 0)
+    return;
+
+  // Write the pending frames
+  qsizetype count = 0;
+  auto &data = m_busFrame.data;
+  auto limit = m_frameBus->capacity();
+  while (limit-- > 0 && m_frameBus->tryRead(m_frameConsumer, data))
+  {
+    if (!data.isValid())
+      continue;
+
+    m_busFrame.rxTimestamp
+        = data.timestamp() > 0 ? data.timestamp() : Misc::SessionClock::now();
+    if (!writeRow(m_busFrame))
+      break;
+
+    ++count;
+  }
+
+  // Write the remaining data to the hard disk
+  flushBuffer();
+
+  // Notify the export module that the frames have been written
+  Q_EMIT framesWritten(count);
+}
+
+/**
+ * @brief Formats the given @a frame as a CSV row.
+ *
+ * This function ensures that values in each row are written in the same order
+ * as the headers, based on dataset indexes. The column of each dataset is
+ * obtained from the slot → column table built by @c createCsvFile(), where a
+ * slot is the position of the dataset within the frame (counting the datasets
+ * of each group in order).
+ *
+ * If the file is not open, it creates the CSV file using the frame and sets
+ * up the headers before writing data. Missing dataset values are replaced
+ * with empty strings.
+ *
+ * The unfiltered values of filtered datasets are written in extra columns at
+ * the end of each row.
+ *
+ * In sparse mode, values whose generation matches the last written one are
+ * left empty and frames without any changed value are not written at all.
+ *
+ * @return @c false if the CSV file could not be created.
+ */
+bool CSV::ExportWriter::writeRow(const CSV::TimestampFrame &frame)
+{
+  // File too large or too old, continue the session in a new part
+  if (isOpen() && shouldRotate(frame))
+    finishPart();
+
+  // File not open, create it & add cell titles
+  if (!isOpen() && !createCsvFile(frame))
+    return false;
+
+  // Assign each dataset to its column
+  int slot = 0;
+  m_rowDatasets.fill(nullptr);
+  m_rawDatasets.fill(nullptr);
+  for (const auto &group : frame.data.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      if (slot < m_slotColumns.count())
+      {
+        const auto column = m_slotColumns[slot];
+        if (column >= 0)
+          m_rowDatasets[column] = &dataset;
+
+        const auto rawColumn = m_rawSlotColumns[slot];
+        if (rawColumn >= 0)
+          m_rawDatasets[rawColumn] = &dataset;
+      }
+
+      ++slot;
+    }
+  }
+
+  // Skip sparse rows without changes, except for the periodic full rows
+  const bool fullRow = !m_sparseRows || m_sparseRowCount == 0;
+  if (!fullRow && !rowChanged())
+    return true;
+
+  // Write RX date/time
+  appendDateTime(m_buffer, frame.rxTimestamp);
+  m_buffer.append(',');
+
+  // Write the values in column order
+  const auto columns = m_rowDatasets.count() + m_rawDatasets.count();
+  for (qsizetype i = 0; i < m_rowDatasets.count(); ++i)
+  {
+    const auto *dataset = m_rowDatasets[i];
+    if (dataset)
+    {
+      const auto generation = dataset->valueGeneration();
+      if (fullRow || generation != m_writtenGenerations[i])
+        appendString(m_buffer, dataset->value());
+
+      m_writtenGenerations[i] = generation;
+    }
+
+    m_buffer.append(i < columns - 1 ? ',' : '\n');
+  }
+
+  // Write the unfiltered values of the filtered datasets
+  for (qsizetype i = 0; i < m_rawDatasets.count(); ++i)
+  {
+    const auto *dataset = m_rawDatasets[i];
+    if (dataset && dataset->isNumeric())
+    {
+      const auto generation = dataset->valueGeneration();
+      if (fullRow || generation != m_rawWrittenGenerations[i])
+        m_buffer.append(QByteArray::number(dataset->rawValue(), 'g',
+                                           QLocale::FloatingPointShortest));
+
+      m_rawWrittenGenerations[i] = generation;
+    }
+
+    m_buffer.append(i < m_rawDatasets.count() - 1 ? ',' : '\n');
+  }
+
+  // Count the rows written since the last full row
+  if (m_sparseRows)
+    m_sparseRowCount = (m_sparseRowCount + 1) % kSparseKeyframeInterval;
+
+  // Register the row for the manifest
+  ++m_fileRows;
+  m_fileLastRow = frame.rxTimestamp;
+
+  // Write the buffer to the file once it grows large enough
+  if (m_buffer.size() >= kFlushThreshold)
+    writeBuffer();
+
+  return true;
+}
+
+/**
+ * Writes the contents of the row buffer to the CSV file, as a gzip member if
+ * the file is compressed, and clears the buffer
+ */
+void CSV::ExportWriter::writeBuffer()
+{
+  if (m_buffer.isEmpty())
+    return;
+
+  if (m_fileCompressed)
+    m_csvFile.write(CSV::Gzip::compress(m_buffer));
+  else
+    m_csvFile.write(m_buffer);
+
+  m_buffer.clear();
+}
+
+/**
+ * Writes the contents of the row buffer to the CSV file
+ */
+void CSV::ExportWriter::flushBuffer()
+{
+  if (isOpen())
+  {
+    writeBuffer();
+    m_csvFile.flush();
+  }
+}
+
+/**
+ * @brief Writes the remaining rows & closes the current part of the session.
+ *
+ * If file rotation is enabled, the part is registered in the manifest of the
+ * session, which is rewritten so that it always lists every finished part.
+ */
+void CSV::ExportWriter::finishPart()
+{
+  // Write the remaining rows & close the file
+  writeBuffer();
+  const auto size = m_csvFile.pos();
+  m_csvFile.close();
+
+  // Register the part in the session manifest
+  if (!m_manifestPath.isEmpty())
+  {
+    QJsonObject part;
+    part.insert(QStringLiteral("file"),
+                QFileInfo(m_csvFile.fileName()).fileName());
+    part.insert(QStringLiteral("rows"), m_fileRows);
+    part.insert(QStringLiteral("bytes"), size);
+    part.insert(QStringLiteral("compression"),
+                m_fileCompressed ? QStringLiteral("gzip")
+                                 : QStringLiteral("none"));
+    part.insert(QStringLiteral("firstRow"),
+                Misc::SessionClock::toDateTime(m_fileFirstRow)
+                    .toString(Qt::ISODateWithMs));
+    part.insert(QStringLiteral("lastRow"),
+                Misc::SessionClock::toDateTime(m_fileLastRow)
+                    .toString(Qt::ISODateWithMs));
+    m_manifestParts.append(part);
+    writeManifest();
+  }
+}
+
+/**
+ * Writes the manifest of the current session, which lists its parts in the
+ * order in which they were written
+ */
+void CSV::ExportWriter::writeManifest()
+{
+  QJsonObject manifest;
+  manifest.insert(QStringLiteral("parts"), m_manifestParts);
+
+  QFile file(m_manifestPath);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    file.write(QJsonDocument(manifest).toJson());
+}
+
+/**
+ * Returns @c true if the given @a frame should be written to a new part of
+ * the session, because the current file exceeds the size or duration limits
+ */
+bool CSV::ExportWriter::shouldRotate(const CSV::TimestampFrame &frame) const
+{
+  if (m_fileRows == 0)
+    return false;
+
+  if (m_maxFileSize > 0 && m_csvFile.pos() >= m_maxFileSize)
+    return true;
+
+  if (m_maxFileDuration > 0
+      && frame.rxTimestamp - m_fileFirstRow >= m_maxFileDuration)
+    return true;
+
+  return false;
+}
+
+/**
+ * Returns @c true if any dataset of the current row changed since the last
+ * written row.
+ */
+bool CSV::ExportWriter::rowChanged() const
+{
+  for (qsizetype i = 0; i < m_rowDatasets.count(); ++i)
+  {
+    const auto *dataset = m_rowDatasets[i];
+    if (dataset && dataset->valueGeneration() != m_writtenGenerations[i])
+      return true;
+  }
+
+  for (qsizetype i = 0; i < m_rawDatasets.count(); ++i)
+  {
+    const auto *dataset = m_rawDatasets[i];
+    if (dataset && dataset->valueGeneration() != m_rawWrittenGenerations[i])
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Creates and initializes a new CSV file for exporting frame data.
+ *
+ * This function generates a CSV file in a project-specific directory using the
+ * frame's data and timestamps. The dataset headers are added to the CSV file,
+ * sorted by their indexes, ensuring ordered column headers.
+ *
+ * The slot → column table used by @c writeFrames() is also built here, since
+ * the layout of the frame does not change while the file is open. Filtered
+ * datasets get an additional "(raw)" column after the dataset columns.
+ *
+ * @param frame The frame containing data and timestamp information.
+ * @return @c true if the file was created, @c false otherwise.
+ */
+bool CSV::ExportWriter::createCsvFile(const CSV::TimestampFrame &frame)
+{
+  // Obtain frame data
+  const auto &data = frame.data;
+  const auto rxTime = Misc::SessionClock::toDateTime(frame.rxTimestamp);
+
+  // Get file name
+  const auto baseName = rxTime.toString(QStringLiteral("yyyy_MMM_dd HH_mm_ss"));
+  const auto fileName = baseName + (m_compressed ? ".csv.gz" : ".csv");
+
+  // Get path
+  const QString path = QStringLiteral("%1/%2/").arg(m_csvPath, data.title());
+
+  // Generate file path if required
+  QDir dir(path);
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  // Open file, compressed files are binary
+  auto mode = QIODevice::WriteOnly | QIODevice::Text;
+  if (m_compressed)
+    mode = QIODevice::WriteOnly;
+
+  m_csvFile.setFileName(dir.filePath(fileName));
+  if (!m_csvFile.open(mode))
+  {
+    Q_EMIT openFailed();
+    return false;
+  }
+
+  // Start a new session manifest with the first part of a rotated session
+  m_fileRows = 0;
+  m_fileCompressed = m_compressed;
+  m_fileFirstRow = frame.rxTimestamp;
+  m_fileLastRow = frame.rxTimestamp;
+  const bool rotation = m_maxFileSize > 0 || m_maxFileDuration > 0;
+  if (m_manifestPath.isEmpty() && rotation)
+  {
+    m_manifestParts = QJsonArray();
+    m_manifestPath = dir.filePath(baseName + ".manifest.json");
+  }
+
+  // Get the slot & header of each dataset with a non-duplicated index
+  QVector<int> slotIndexes;
+  QVector<int> datasetIndexes;
+  QVector<QString> headers;
+  QVector<QString> rawHeaders;
+  m_rawSlotColumns.clear();
+  const auto &groups = data.groups();
+  for (auto g = groups.constBegin(); g != groups.constEnd(); ++g)
+  {
+    const auto &datasets = g->datasets();
+    for (auto d = datasets.constBegin(); d != datasets.constEnd(); ++d)
+    {
+      slotIndexes.append(d->index());
+      if (d->filter().isEmpty())
+        m_rawSlotColumns.append(-1);
+
+      else
+      {
+        m_rawSlotColumns.append(rawHeaders.count());
+        rawHeaders.append(
+            QString("%1/%2 (raw)").arg(g->title(), d->title()).simplified());
+      }
+
+      if (!datasetIndexes.contains(d->index()))
+      {
+        auto header = QString("%1/%2").arg(g->title(), d->title()).simplified();
+        datasetIndexes.append(d->index());
+        headers.append(header);
+      }
+    }
+  }
+
+  // Sort the columns by dataset index
+  QVector<int> order(datasetIndexes.count());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return datasetIndexes[a] < datasetIndexes[b];
+  });
+
+  // Build the slot → column table, the last dataset of a column wins
+  QHash<int, int> columns;
+  for (int i = 0; i < order.count(); ++i)
+    columns.insert(datasetIndexes[order[i]], i);
+
+  m_slotColumns.clear();
+  for (const auto index : std::as_const(slotIndexes))
+    m_slotColumns.append(columns.value(index, -1));
+
+  m_sparseRowCount = 0;
+  m_rowDatasets.fill(nullptr, order.count());
+  m_rawDatasets.fill(nullptr, rawHeaders.count());
+  m_writtenGenerations.fill(0, order.count());
+  m_rawWrittenGenerations.fill(0, rawHeaders.count());
+
+  // Add UTF-8 byte order mark & cell titles
+  m_buffer.clear();
+  m_buffer.append("\xEF\xBB\xBF");
+  m_buffer.append("RX Date/Time,");
+  const auto columnCount = order.count() + rawHeaders.count();
+  for (int i = 0; i < order.count(); ++i)
+  {
+    appendString(m_buffer, headers[order[i]]);
+    m_buffer.append(i < columnCount - 1 ? ',' : '\n');
+  }
+
+  for (int i = 0; i < rawHeaders.count(); ++i)
+  {
+    appendString(m_buffer, rawHeaders[i]);
+    m_buffer.append(i < rawHeaders.count() - 1 ? ',' : '\n');
+  }
+
+  // Update UI
+  Q_EMIT fileOpened(m_csvFile.fileName());
+  return true;
+}
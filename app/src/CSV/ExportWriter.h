@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QVector>
+#include <QObject>
+#include <QJsonArray>
+#include <QByteArray>
+
+#include "JSON/Frame.h"
+
+namespace CSV
+{
+/**
+ * @brief Frame received from the device & its reception time.
+ *
+ * The reception time is a steady clock timestamp in nanoseconds (see
+ * @c Misc::SessionClock), which is converted to a date/time when the row is
+ * written.
+ */
+typedef struct
+{
+  JSON::Frame data;
+  qint64 rxTimestamp;
+} TimestampFrame;
+
+/**
+ * @class CSV::ExportWriter
+ * @brief Formats frames & writes them to the CSV file.
+ *
+ * The export writer owns the CSV file and is meant to live in a worker
+ * thread, so that formatting values and writing them to a slow disk or
+ * network share never blocks the user interface. Frames are read from the
+ * @c JSON::FrameBus by @c readFrameBus() when the @c CSV::Export class asks
+ * for it (or handed over in batches to @c writeFrames()), and the writer
+ * notifies when they have been written through the @c framesWritten()
+ * signal.
+ *
+ * The column of each dataset is resolved once, when the file is created, so
+ * rows are formatted by walking the datasets of each frame in order and
+ * appending their values to a reusable UTF-8 buffer.
+ *
+ * In sparse mode, each row only contains the values that changed since the
+ * previously written row and frames without changes are skipped. A complete
+ * row is written every @c kSparseKeyframeInterval rows, so that a player can
+ * recover the value of every column by looking back a bounded number of rows.
+ *
+ * Optionally, the writer compresses the file with gzip (see @c CSV::Gzip),
+ * one member each time the row buffer is written, and rotates the file when
+ * it exceeds a given size or duration. Each part of a rotated session starts
+ * with the header row (and a complete row in sparse mode), so it can be
+ * replayed on its own, and the parts are listed in a JSON manifest next to
+ * them, which is updated every time a part is finished.
+ */
+class ExportWriter : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void fileClosed();
+  void openFailed();
+  void framesWritten(const qsizetype frames);
+  void fileOpened(const QString &path);
+
+public:
+  explicit ExportWriter(QObject *parent = nullptr);
+  ~ExportWriter();
+
+  /**
+   * Number of rows between two complete rows of a sparse CSV file
+   */
+  static constexpr int kSparseKeyframeInterval = 1000;
+
+  [[nodiscard]] bool isOpen() const;
+
+  void setFrameBus(JSON::FrameBus *bus, const int consumer);
+
+public slots:
+  void closeFile();
+  void readFrameBus();
+  void setCsvPath(const QString &path);
+  void setSparseRows(const bool enabled);
+  void setCompressed(const bool enabled);
+  void setRotation(const qint64 maxSize, const qint64 maxDuration);
+  void writeFrames(const QVector<CSV::TimestampFrame> &frames);
+
+private:
+  void writeBuffer();
+  void flushBuffer();
+  void finishPart();
+  void writeManifest();
+  [[nodiscard]] bool rowChanged() const;
+  [[nodiscard]] bool shouldRotate(const CSV::TimestampFrame &frame) const;
+  [[nodiscard]] bool writeRow(const CSV::TimestampFrame &frame);
+  [[nodiscard]] bool createCsvFile(const CSV::TimestampFrame &frame);
+
+private:
+  bool m_sparseRows;
+  int m_sparseRowCount;
+
+  bool m_compressed;
+  bool m_fileCompressed;
+  qint64 m_maxFileSize;
+  qint64 m_maxFileDuration;
+  qint64 m_fileRows;
+  qint64 m_fileFirstRow;
+  qint64 m_fileLastRow;
+  QString m_manifestPath;
+  QJsonArray m_manifestParts;
+
+  int m_frameConsumer;
+  JSON::FrameBus *m_frameBus;
+  CSV::TimestampFrame m_busFrame;
+
+  QFile m_csvFile;
+  QString m_csvPath;
+  QByteArray m_buffer;
+  QVector<int> m_slotColumns;
+  QVector<int> m_rawSlotColumns;
+  QVector<quint64> m_writtenGenerations;
+  QVector<quint64> m_rawWrittenGenerations;
+  QVector<const JSON::Dataset *> m_rowDatasets;
+  QVector<const JSON::Dataset *> m_rawDatasets;
+};
+} // namespace CSV
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "FlightRecorder.h"
+
+#include <limits>
+
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "IO/RawCapture.h"
+#include "CSV/Player.h"
+#include "MQTT/Client.h"
+#include "Misc/WorkerPool.h"
+#include "Misc/SessionClock.h"
+#include "JSON/FrameBuilder.h"
+
+/**
+ * Capacity of the raw data ring (in bytes)
+ */
+static constexpr qsizetype kRawCapacity = 16 * 1024 * 1024;
+
+/**
+ * Capacity of the parsed frame ring
+ */
+static constexpr qsizetype kMaxFrames = 50000;
+
+/**
+ * Value used when no recording has been triggered yet
+ */
+static constexpr qint64 kNoTrigger = std::numeric_limits<qint64>::min();
+
+/**
+ * Constructor function
+ */
+CSV::FlightRecorder::FlightRecorder()
+  : m_enabled(false)
+  , m_windowLength(30)
+  , m_alarmActive(false)
+  , m_lastTrigger(kNoTrigger)
+  , m_bytesReceived(0)
+  , m_frameHead(0)
+  , m_frameCount(0)
+{
+  m_clock.start();
+  m_windowLength = m_settings.value("flight_recorder_window", 30).toInt();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+CSV::FlightRecorder &CSV::FlightRecorder::instance()
+{
+  static FlightRecorder singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if the flight recorder is enabled
+ */
+bool CSV::FlightRecorder::enabled() const
+{
+  return m_enabled;
+}
+
+/**
+ * Returns the length of the recorded window in seconds
+ */
+int CSV::FlightRecorder::windowLength() const
+{
+  return m_windowLength;
+}
+
+/**
+ * @brief Saves the data received during the recorded window to the disk.
+ *
+ * The frames & raw data chunks received during the last @c windowLength()
+ * seconds are copied from the in-memory rings, and written to the disk by a
+ * background job, so that triggering a recording never blocks the user
+ * interface. Triggers that fire before the window has been refilled after the
+ * previous recording are ignored.
+ */
+void CSV::FlightRecorder::trigger()
+{
+  // Recorder not active
+  if (!isRecording())
+    return;
+
+  // Ignore triggers until the window has been refilled
+  const auto now = m_clock.nsecsElapsed();
+  const auto window = static_cast<qint64>(m_windowLength) * 1000000000;
+  if (m_lastTrigger != kNoTrigger && now - m_lastTrigger < window)
+    return;
+
+  // Obtain the frames received during the window
+  const auto start = now - window;
+  QVector<TimestampFrame> frames;
+  for (qsizetype i = 0; i < m_frameCount; ++i)
+  {
+    const auto index = (m_frameHead + i) % kMaxFrames;
+    if (m_frameTimes[index] >= start)
+      frames.append(m_frames[index]);
+  }
+
+  // Build the raw capture with the chunks received during the window
+  auto capture = IO::RawCapture::fileHeader();
+  qint64 firstTimestamp = -1;
+  QByteArray chunk;
+  const auto base = m_bytesReceived - m_rawData->size();
+  for (const auto &c : std::as_const(m_chunks))
+  {
+    if (c.timestamp < start)
+      continue;
+
+    if (firstTimestamp < 0)
+      firstTimestamp = c.timestamp;
+
+    chunk.resize(c.size);
+    m_rawData->peek(c.start - base, c.size,
+                    reinterpret_cast<uint8_t *>(chunk.data()));
+
+    IO::RawCapture::appendChunk(capture, c.timestamp - firstTimestamp,
+                                chunk.constData(), chunk.size());
+  }
+
+  // Nothing to save
+  if (frames.isEmpty() && firstTimestamp < 0)
+    return;
+
+  // Register the trigger
+  m_lastTrigger = now;
+
+  // Obtain the output directory & file name
+  const auto path = QStringLiteral("%1/%2/Flight Recorder")
+                        .arg(QStandardPaths::writableLocation(
+                                 QStandardPaths::DocumentsLocation),
+                             qApp->applicationDisplayName());
+  const auto name = QDateTime::currentDateTime().toString(
+      QStringLiteral("yyyy_MMM_dd HH_mm_ss"));
+
+  // Write the recording in the background
+  auto *recorder = this;
+  Misc::WorkerPool::instance().start([=] {
+    // Write the frames to a CSV file
+    QString csvPath;
+    CSV::ExportWriter writer;
+    QObject::connect(&writer, &CSV::ExportWriter::fileOpened,
+                     [&](const QString &file) { csvPath = file; });
+    writer.setCsvPath(path);
+    writer.writeFrames(frames);
+    writer.closeFile();
+
+    // Write the raw capture next to the CSV file
+    QString rawPath;
+    if (!csvPath.isEmpty())
+      rawPath = csvPath.chopped(4) + QStringLiteral(".ssraw");
+    else
+    {
+      QDir dir(path);
+      if (!dir.exists())
+        dir.mkpath(".");
+
+      rawPath = dir.filePath(name + QStringLiteral(".ssraw"));
+    }
+
+    QFile file(rawPath);
+    if (file.open(QIODevice::WriteOnly))
+    {
+      file.write(capture);
+      file.close();
+    }
+
+    // Notify the user interface
+    const auto saved = csvPath.isEmpty() ? rawPath : csvPath;
+    QMetaObject::invokeMethod(
+        recorder, [=] { Q_EMIT recorder->recordingSaved(saved); },
+        Qt::QueuedConnection);
+  });
+}
+
+/**
+ * Discards the recorded data, e.g. when a new device is connected
+ */
+void CSV::FlightRecorder::clearHistory()
+{
+  m_frameHead = 0;
+  m_frameCount = 0;
+  m_chunks.clear();
+  m_alarmActive = false;
+  m_lastTrigger = kNoTrigger;
+
+  if (m_rawData)
+    m_rawData->clear();
+}
+
+/**
+ * Configures the signal/slot connections with the rest of the modules of the
+ * application.
+ */
+void CSV::FlightRecorder::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &FlightRecorder::clearHistory);
+  connect(&IO::Manager::instance(), &IO::Manager::dataReceived, this,
+          &FlightRecorder::registerData, Qt::QueuedConnection);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
+          this, &FlightRecorder::registerFrame, Qt::QueuedConnection);
+}
+
+/**
+ * Enables or disables the flight recorder, the in-memory rings are only
+ * allocated while the recorder is enabled.
+ */
+void CSV::FlightRecorder::setEnabled(const bool enabled)
+{
+  if (m_enabled == enabled)
+    return;
+
+  m_enabled = enabled;
+  clearHistory();
+
+  if (m_enabled)
+  {
+    m_frames.resize(kMaxFrames);
+    m_frameTimes.resize(kMaxFrames);
+    m_rawData = std::make_unique<IO::CircularBuffer<QByteArray, uint8_t>>(
+        kRawCapacity);
+  }
+
+  else
+  {
+    m_rawData.reset();
+    m_frames.clear();
+    m_frames.squeeze();
+    m_frameTimes.clear();
+    m_frameTimes.squeeze();
+  }
+
+  Q_EMIT enabledChanged();
+}
+
+/**
+ * Changes the length of the recorded window, in seconds
+ */
+void CSV::FlightRecorder::setWindowLength(const int seconds)
+{
+  m_windowLength = qBound(1, seconds, 600);
+  m_settings.setValue("flight_recorder_window", m_windowLength);
+  Q_EMIT windowLengthChanged();
+}
+
+/**
+ * Appends the given raw @a data to the raw data ring & discards the chunks
+ * that are older than the recorded window.
+ */
+void CSV::FlightRecorder::registerData(const QByteArray &data)
+{
+  // Recorder not active
+  if (!isRecording() || data.isEmpty())
+    return;
+
+  // Register the chunk, keeping only the latest bytes of huge chunks
+  const auto now = m_clock.nsecsElapsed();
+  const auto bytes = data.size() > kRawCapacity ? data.right(kRawCapacity)
+                                                : data;
+  m_rawData->append(bytes);
+
+  DataChunk chunk;
+  chunk.timestamp = now;
+  chunk.start = m_bytesReceived;
+  chunk.size = bytes.size();
+  m_chunks.append(chunk);
+  m_bytesReceived += chunk.size;
+
+  // Discard overwritten chunks & chunks outside of the window
+  const auto base = m_bytesReceived - m_rawData->size();
+  const auto window = static_cast<qint64>(m_windowLength) * 1000000000;
+  while (!m_chunks.isEmpty())
+  {
+    const auto &first = m_chunks.first();
+    if (first.start >= base && now - first.timestamp <= window)
+      break;
+
+    m_chunks.removeFirst();
+  }
+}
+
+/**
+ * Appends the given @a frame to the frame ring, and triggers a recording when
+ * the value of a dataset reaches its alarm level.
+ */
+void CSV::FlightRecorder::registerFrame(const JSON::Frame &frame)
+{
+  // Recorder not active
+  if (!isRecording() || !frame.isValid())
+    return;
+
+  // Obtain the position of the frame in the ring
+  qsizetype index;
+  if (m_frameCount < kMaxFrames)
+    index = (m_frameHead + m_frameCount++) % kMaxFrames;
+  else
+  {
+    index = m_frameHead;
+    m_frameHead = (m_frameHead + 1) % kMaxFrames;
+  }
+
+  // Register the frame
+  m_frames[index].data = frame;
+  m_frames[index].rxTimestamp = frame.timestamp() > 0
+                                    ? frame.timestamp()
+                                    : Misc::SessionClock::now();
+  m_frameTimes[index] = m_clock.nsecsElapsed();
+
+  // Trigger a recording when an alarm is raised
+  const auto alarm = alarmActive(frame);
+  if (alarm && !m_alarmActive)
+    trigger();
+
+  m_alarmActive = alarm;
+}
+
+/**
+ * Returns @c true if the recorder is enabled & data is being received from a
+ * device or service (played CSV files are not recorded).
+ */
+bool CSV::FlightRecorder::isRecording() const
+{
+  if (!m_enabled || !m_rawData)
+    return false;
+
+  if (CSV::Player::instance().isOpen())
+    return false;
+
+  return IO::Manager::instance().connected()
+         || MQTT::Client::instance().isSubscribed();
+}
+
+/**
+ * Returns @c true if the value of any dataset of the given @a frame is equal
+ * or greater than its (non-zero) alarm level.
+ */
+bool CSV::FlightRecorder::alarmActive(const JSON::Frame &frame) const
+{
+  for (const auto &group : frame.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      const auto alarm = dataset.alarm();
+      if (alarm != 0 && dataset.isNumeric() && dataset.numericValue() >= alarm)
+        return true;
+    }
+  }
+
+  return false;
+}
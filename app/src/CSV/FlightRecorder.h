@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QList>
+#include <QVector>
+#include <QObject>
+#include <QSettings>
+#include <QElapsedTimer>
+
+#include "JSON/Frame.h"
+#include "IO/CircularBuffer.h"
+#include "CSV/ExportWriter.h"
+
+namespace CSV
+{
+/**
+ * @brief The FlightRecorder class
+ *
+ * The flight recorder keeps the raw bytes & parsed frames received during the
+ * last few seconds in fixed-size in-memory rings, without writing anything to
+ * the disk. When a trigger fires, the recorded window is saved to a folder
+ * next to the CSV files, as a CSV file with the parsed frames and a raw
+ * capture file with the received data chunks, which can be replayed with the
+ * @c IO::Drivers::Replay driver.
+ *
+ * The recording can be triggered manually (e.g. with a keyboard shortcut)
+ * through the @c trigger() slot, and is triggered automatically when the value
+ * of any dataset reaches its alarm level. After a recording is saved, no other
+ * recording is made until the window has been refilled with new data.
+ *
+ * Raw capture files use the format described in the @c IO::RawCapture class.
+ */
+class FlightRecorder : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool enabled
+             READ enabled
+             WRITE setEnabled
+             NOTIFY enabledChanged)
+  Q_PROPERTY(int windowLength
+             READ windowLength
+             WRITE setWindowLength
+             NOTIFY windowLengthChanged)
+  // clang-format on
+
+signals:
+  void enabledChanged();
+  void windowLengthChanged();
+  void recordingSaved(const QString &path);
+
+private:
+  explicit FlightRecorder();
+  FlightRecorder(FlightRecorder &&) = delete;
+  FlightRecorder(const FlightRecorder &) = delete;
+  FlightRecorder &operator=(FlightRecorder &&) = delete;
+  FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+public:
+  static FlightRecorder &instance();
+
+  [[nodiscard]] bool enabled() const;
+  [[nodiscard]] int windowLength() const;
+
+public slots:
+  void trigger();
+  void clearHistory();
+  void setupExternalConnections();
+  void setEnabled(const bool enabled);
+  void setWindowLength(const int seconds);
+
+private slots:
+  void registerData(const QByteArray &data);
+  void registerFrame(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Reception time, position & size of a raw data chunk.
+   */
+  struct DataChunk
+  {
+    qint64 timestamp;
+    qint64 start;
+    qint64 size;
+  };
+
+  [[nodiscard]] bool isRecording() const;
+  [[nodiscard]] bool alarmActive(const JSON::Frame &frame) const;
+
+private:
+  bool m_enabled;
+  int m_windowLength;
+  bool m_alarmActive;
+  qint64 m_lastTrigger;
+  QSettings m_settings;
+  QElapsedTimer m_clock;
+
+  qint64 m_bytesReceived;
+  QList<DataChunk> m_chunks;
+  std::unique_ptr<IO::CircularBuffer<QByteArray, uint8_t>> m_rawData;
+
+  qsizetype m_frameHead;
+  qsizetype m_frameCount;
+  QVector<qint64> m_frameTimes;
+  QVector<TimestampFrame> m_frames;
+};
+} // namespace CSV
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Gzip.h"
+
+#include <cstring>
+
+#include <QtEndian>
+
+#include "IO/Checksum.h"
+
+/**
+ * Size of the fixed part of a gzip member header & of the member trailer
+ */
+static constexpr qsizetype kHeaderSize = 10;
+static constexpr qsizetype kTrailerSize = 8;
+
+/**
+ * Size of the extra field written in each member header (the subfield ID,
+ * its length, the size of the deflate data & the Adler-32 checksum)
+ */
+static constexpr quint16 kExtraSize = 12;
+
+/**
+ * Header flag set when the member contains an extra field
+ */
+static constexpr quint8 kFlagExtra = 0x04;
+
+/**
+ * Size of the length prefix & of the zlib header/trailer of the data
+ * generated by @c qCompress()
+ */
+static constexpr qsizetype kQtPrefixSize = 4;
+static constexpr qsizetype kZlibHeaderSize = 2;
+static constexpr qsizetype kZlibTrailerSize = 4;
+
+/**
+ * @brief Compresses @a data into a single gzip member.
+ *
+ * The deflate data is obtained from @c qCompress() by removing its length
+ * prefix and zlib header & trailer. The Adler-32 checksum of the zlib trailer
+ * is kept in the extra field of the member header, and the member ends with
+ * the CRC-32 & size of @a data, as required by the gzip format.
+ *
+ * @param data Uncompressed data, at most 2 GiB.
+ * @param level Compression level, from 1 (fastest) to 9 (smallest).
+ *
+ * @return The gzip member, or an empty array if @a data is empty.
+ */
+QByteArray CSV::Gzip::compress(const QByteArray &data, const int level)
+{
+  if (data.isEmpty())
+    return QByteArray();
+
+  // Compress the data & split the zlib stream
+  const auto zlib = qCompress(data, level);
+  const auto offset = kQtPrefixSize + kZlibHeaderSize;
+  const auto length = zlib.size() - offset - kZlibTrailerSize;
+  if (length <= 0)
+    return QByteArray();
+
+  const auto *adler = zlib.constData() + zlib.size() - kZlibTrailerSize;
+  const auto size = static_cast<int>(data.size());
+
+  // Write the member header
+  QByteArray member;
+  member.reserve(kHeaderSize + 2 + kExtraSize + length + kTrailerSize);
+  member.append("\x1F\x8B\x08", 3);
+  member.append(static_cast<char>(kFlagExtra));
+  member.append(4, '\0');
+  member.append('\0');
+  member.append('\xFF');
+
+  // Write the extra field with the deflate size & the Adler-32 checksum
+  char extra[2 + kExtraSize];
+  qToLittleEndian<quint16>(kExtraSize, extra);
+  extra[2] = 'S';
+  extra[3] = 'S';
+  qToLittleEndian<quint16>(kExtraSize - 4, extra + 4);
+  qToLittleEndian<quint32>(static_cast<quint32>(length), extra + 6);
+  std::memcpy(extra + 10, adler, kZlibTrailerSize);
+  member.append(extra, sizeof(extra));
+
+  // Write the deflate data, the CRC-32 & the uncompressed size
+  member.append(zlib.constData() + offset, length);
+
+  char trailer[kTrailerSize];
+  qToLittleEndian<quint32>(IO::crc32(data.constData(), size), trailer);
+  qToLittleEndian<quint32>(static_cast<quint32>(size), trailer + 4);
+  member.append(trailer, kTrailerSize);
+
+  return member;
+}
+
+/**
+ * @brief Decompresses the gzip members of @a input into @a output.
+ *
+ * Each member is converted back into the format expected by
+ * @c qUncompress() using the size & Adler-32 checksum stored in its extra
+ * field, and its contents are verified against the CRC-32 of the member
+ * trailer.
+ *
+ * @return @c false if @a input contains a member that was not written by
+ *         @c compress(), or if the data is corrupted.
+ */
+bool CSV::Gzip::decompress(QIODevice &input, QIODevice &output)
+{
+  while (!input.atEnd())
+  {
+    // Read & validate the member header
+    const auto header = input.read(kHeaderSize + 2 + kExtraSize);
+    if (header.size() != kHeaderSize + 2 + kExtraSize
+        || !header.startsWith("\x1F\x8B\x08")
+        || !(static_cast<quint8>(header[3]) & kFlagExtra))
+      return false;
+
+    const auto *extra = header.constData() + kHeaderSize;
+    if (qFromLittleEndian<quint16>(extra) != kExtraSize || extra[2] != 'S'
+        || extra[3] != 'S')
+      return false;
+
+    // Read the deflate data & the member trailer
+    const qsizetype length = qFromLittleEndian<quint32>(extra + 6);
+    const auto deflate = input.read(length);
+    const auto trailer = input.read(kTrailerSize);
+    if (deflate.size() != length || trailer.size() != kTrailerSize)
+      return false;
+
+    // Rebuild the zlib stream generated by qCompress()
+    QByteArray zlib;
+    const qsizetype size = qFromLittleEndian<quint32>(trailer.constData() + 4);
+    zlib.reserve(kQtPrefixSize + kZlibHeaderSize + length + kZlibTrailerSize);
+    zlib.resize(kQtPrefixSize);
+    qToBigEndian<quint32>(static_cast<quint32>(size), zlib.data());
+    zlib.append("\x78\x9C", kZlibHeaderSize);
+    zlib.append(deflate);
+    zlib.append(extra + 10, kZlibTrailerSize);
+
+    // Inflate the data & verify its checksum
+    const auto data = qUncompress(zlib);
+    const auto crc = qFromLittleEndian<quint32>(trailer.constData());
+    if (data.size() != size
+        || IO::crc32(data.constData(), static_cast<int>(data.size())) != crc)
+      return false;
+
+    if (output.write(data) != data.size())
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+
+namespace CSV
+{
+/**
+ * @brief Streaming gzip compression of exported files.
+ *
+ * Data is compressed in independent chunks, each of which is written as a
+ * complete gzip member. A file made of several members is a valid gzip file
+ * (RFC 1952), so it can be decompressed with @c gzip, @c zcat, pandas or any
+ * other tool, while the writer never has to keep compression state between
+ * chunks or rewrite earlier parts of the file.
+ *
+ * Each member carries an extra header field (@c "SS") with the size of its
+ * deflate data and the Adler-32 checksum of its contents, which allows
+ * @c decompress() to inflate the member through @c qUncompress() without
+ * depending on a separate zlib library.
+ */
+namespace Gzip
+{
+[[nodiscard]] QByteArray compress(const QByteArray &data, const int level = 6);
+[[nodiscard]] bool decompress(QIODevice &input, QIODevice &output);
+} // namespace Gzip
+} // namespace CSV
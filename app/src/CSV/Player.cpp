@@ -22,8 +22,14 @@
 
 #include "Player.h"
 
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <cstring>
+
 #include <QtMath>
-#include <QTimer>
+#include <QThread>
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QApplication>
@@ -31,7 +37,252 @@
 
 #include "IO/Manager.h"
 #include "UI/Dashboard.h"
+#include "CSV/Gzip.h"
+#include "CSV/ExportWriter.h"
+#include "JSON/FrameBuilder.h"
 #include "Misc/Utilities.h"
+#include "Misc/WorkerPool.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * Number of row offsets sent to the player by an indexing job at a time
+ */
+static constexpr qsizetype kIndexChunkSize = 64 * 1024;
+
+/**
+ * Minimum size of the chunks scanned by each indexing job, smaller files are
+ * split into fewer chunks
+ */
+static constexpr qint64 kMinIndexChunkBytes = 16 * 1024 * 1024;
+
+/**
+ * Number of chunks per CPU core, so that cores that finish early can pick up
+ * the remaining work
+ */
+static constexpr qint64 kIndexChunksPerThread = 2;
+
+/**
+ * Date/time format used to display the timestamp of each row
+ */
+static const QString kDateTimeFormat
+    = QStringLiteral("yyyy/MM/dd HH:mm:ss::zzz");
+
+/**
+ * Playback speed multipliers, zero replays frames as fast as possible
+ */
+static constexpr qreal kSpeeds[] = {1, 2, 10, 0};
+
+/**
+ * Maximum number of frames submitted per tick during unthrottled playback
+ */
+static constexpr qsizetype kMaxBatchSize = 1024;
+
+/**
+ * Value used for rows with an invalid timestamp
+ */
+static constexpr qint64 kInvalidTime = std::numeric_limits<qint64>::min();
+
+/**
+ * Julian day of the Unix epoch
+ */
+static constexpr qint64 kEpochJulianDay = 2440588;
+
+/**
+ * Milliseconds in a day
+ */
+static constexpr qint64 kMsecsPerDay = 86400000;
+
+/**
+ * @brief Background job that builds the row-offset index of a CSV file.
+ *
+ * The job is shared by the workers that scan each chunk of the file. Every
+ * worker maps the first @c size bytes of the file on its own, so that it can
+ * keep scanning while the player parses rows from its own mapping, and stops
+ * as soon as the @c cancelled flag is set (e.g. when the file is closed).
+ *
+ * The timestamp of each row is obtained from the @c timeColumn cell, rows with
+ * an invalid date/time are assigned the @c fallbackTime value.
+ */
+struct CSV::Player::IndexJob
+{
+  QString path;
+  qint64 size;
+  int timeColumn;
+  qint64 fallbackTime;
+  std::atomic_bool cancelled;
+};
+
+/**
+ * Returns the position of the line feed that terminates the line starting at
+ * @a offset, or @a size if the line is the last line of the file.
+ */
+static qint64 findLineEnd(const char *data, const qint64 size,
+                          const qint64 offset)
+{
+  const auto *end = static_cast<const char *>(
+      std::memchr(data + offset, '\n', static_cast<size_t>(size - offset)));
+  return end ? end - data : size;
+}
+
+/**
+ * Converts the given @a dateTime to milliseconds since the epoch, using its
+ * wall-clock time. Only the differences between rows are used for playback,
+ * so time zones & daylight saving changes are deliberately ignored.
+ */
+static qint64 toMsecs(const QDateTime &dateTime)
+{
+  if (!dateTime.isValid())
+    return kInvalidTime;
+
+  const auto day = dateTime.date().toJulianDay() - kEpochJulianDay;
+  return day * kMsecsPerDay + dateTime.time().msecsSinceStartOfDay();
+}
+
+/**
+ * Reads an unsigned decimal number of exactly @a digits digits at @a p, and
+ * moves @a p after the number. Returns @c false if the number is incomplete.
+ */
+static bool readNumber(const char *&p, const char *end, const int digits,
+                       int &value)
+{
+  value = 0;
+  for (int i = 0; i < digits; ++i, ++p)
+  {
+    if (p >= end || *p < '0' || *p > '9')
+      return false;
+
+    value = value * 10 + (*p - '0');
+  }
+
+  return true;
+}
+
+/**
+ * Reads the separator @a c at @a p, and moves @a p after it.
+ */
+static bool readChar(const char *&p, const char *end, const char c)
+{
+  if (p < end && *p == c)
+  {
+    ++p;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Parses the date/time stored in the given cell.
+ *
+ * The "yyyy/MM/dd HH:mm:ss::zzz" format used by @c CSV::Export and its
+ * variants without milliseconds or with a slash after the day (the same
+ * formats accepted by @c CSV::Player::getDateTime()) are parsed directly from
+ * the UTF-8 data, without creating any temporary string.
+ *
+ * @return The date/time in milliseconds, or @c kInvalidTime on failure.
+ */
+static qint64 parseTimestamp(const char *begin, const char *end)
+{
+  // Remove surrounding quotes & whitespace
+  while (begin < end && (*begin == ' ' || *begin == '"' || *begin == '\t'))
+    ++begin;
+  while (end > begin
+         && (end[-1] == ' ' || end[-1] == '"' || end[-1] == '\t'
+             || end[-1] == '\r'))
+    --end;
+
+  // Parse the date/time fields
+  int y, mo, d, h, mi, s, ms = 0;
+  const char *p = begin;
+  bool ok = readNumber(p, end, 4, y) && readChar(p, end, '/')
+            && readNumber(p, end, 2, mo) && readChar(p, end, '/')
+            && readNumber(p, end, 2, d);
+  if (ok)
+  {
+    (void)readChar(p, end, '/');
+    ok = readChar(p, end, ' ') && readNumber(p, end, 2, h)
+         && readChar(p, end, ':') && readNumber(p, end, 2, mi)
+         && readChar(p, end, ':') && readNumber(p, end, 2, s);
+  }
+
+  if (ok && p < end)
+    ok = readChar(p, end, ':') && readChar(p, end, ':')
+         && readNumber(p, end, 3, ms) && p == end;
+
+  // Invalid date/time
+  if (!ok)
+    return kInvalidTime;
+
+  // Validate the fields
+  const QDate date(y, mo, d);
+  const QTime time(h, mi, s, ms);
+  if (!date.isValid() || !time.isValid())
+    return kInvalidTime;
+
+  // Convert the fields to milliseconds
+  const auto day = date.toJulianDay() - kEpochJulianDay;
+  return day * kMsecsPerDay + time.msecsSinceStartOfDay();
+}
+
+/**
+ * Returns the offset of the first line at or after @a offset that contains at
+ * least one non-empty cell, or -1 if there are no more rows in the file.
+ */
+static qint64 findRow(const char *data, const qint64 size, qint64 offset)
+{
+  while (offset < size)
+  {
+    const auto end = findLineEnd(data, size, offset);
+    for (auto i = offset; i < end; ++i)
+    {
+      switch (data[i])
+      {
+        case ' ':
+        case ',':
+        case '"':
+        case '\t':
+        case '\r':
+        case '\v':
+        case '\f':
+          break;
+        default:
+          return offset;
+      }
+    }
+
+    offset = end + 1;
+  }
+
+  return -1;
+}
+
+/**
+ * Returns the timestamp stored in the @a column cell of the row that starts
+ * at @a offset, or @a fallback if the cell does not contain a valid date/time.
+ */
+static qint64 findTimestamp(const char *data, const qint64 size,
+                            const qint64 offset, const int column,
+                            const qint64 fallback)
+{
+  // Find the cell
+  const auto *p = data + offset;
+  const auto *end = data + findLineEnd(data, size, offset);
+  for (int i = 0; i < column && p < end; ++i)
+  {
+    const auto *comma = static_cast<const char *>(
+        std::memchr(p, ',', static_cast<size_t>(end - p)));
+    p = comma ? comma + 1 : end;
+  }
+
+  // Find the end of the cell
+  const auto *comma = static_cast<const char *>(
+      std::memchr(p, ',', static_cast<size_t>(end - p)));
+  const auto *cellEnd = comma ? comma : end;
+
+  // Parse the date/time
+  const auto time = parseTimestamp(p, cellEnd);
+  return time == kInvalidTime ? fallback : time;
+}
 
 /**
  * Constructor function
@@ -40,10 +291,30 @@ CSV::Player::Player()
   : m_framePos(0)
   , m_playing(false)
   , m_timestamp("")
+  , m_data(nullptr)
+  , m_dataSize(0)
+  , m_sortedTimestamps(true)
+  , m_nextChunk(0)
+  , m_indexSize(0)
+  , m_indexedBytes(0)
+  , m_cachedRow(-1)
+  , m_filledRow(-1)
+  , m_timeColumn(0)
+  , m_timeInterval(0)
+  , m_speed(0)
+  , m_nextFrameTime(0)
+  , m_throughput(0)
+  , m_throughputFrames(0)
 {
   qApp->installEventFilter(this);
   connect(this, &CSV::Player::playerStateChanged, this,
           &CSV::Player::updateData);
+
+  // Configure the playback scheduler
+  m_playbackTimer.setSingleShot(true);
+  m_playbackTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_playbackTimer, &QTimer::timeout, this,
+          &CSV::Player::onPlaybackTick);
 }
 
 /**
@@ -68,6 +339,16 @@ bool CSV::Player::isOpen() const
  */
 qreal CSV::Player::progress() const
 {
+  // Use the time elapsed since the first row when timestamps are sorted
+  if (m_sortedTimestamps && frameCount() > 1)
+  {
+    const auto start = rowTime(0);
+    const auto duration = rowTime(frameCount() - 1) - start;
+    if (duration > 0)
+      return qreal(rowTime(framePosition()) - start) / duration;
+  }
+
+  // Use the row number otherwise
   return ((qreal)framePosition()) / frameCount();
 }
 
@@ -81,13 +362,13 @@ bool CSV::Player::isPlaying() const
 }
 
 /**
- * Returns the total number of frames in the CSV file. This can be calculated
- * by getting the number of rows of the CSV and substracting 1 (because the
- * title cells do not count as a valid frame).
+ * Returns the total number of frames in the CSV file, excluding the title
+ * cells. While the file is being indexed, only the rows found so far are
+ * counted.
  */
 int CSV::Player::frameCount() const
 {
-  return m_csvData.count();
+  return m_rowOffsets.count();
 }
 
 /**
@@ -99,6 +380,53 @@ int CSV::Player::framePosition() const
   return m_framePos;
 }
 
+/**
+ * Returns the date/time of the current row in milliseconds, or the minimum
+ * value of @c qint64 if the row has no valid date/time.
+ */
+qint64 CSV::Player::currentTime() const
+{
+  return rowTime(framePosition());
+}
+
+/**
+ * Returns the index of the current playback speed in the list returned by
+ * @c availableSpeeds().
+ */
+int CSV::Player::speed() const
+{
+  return m_speed;
+}
+
+/**
+ * Returns the number of frames per second submitted during the last second
+ * of playback. In unthrottled mode, this is the frame rate that the whole
+ * data pipeline (frame builder, dashboard, exports...) is able to sustain.
+ */
+qreal CSV::Player::throughput() const
+{
+  return m_throughput;
+}
+
+/**
+ * Returns the fraction of the CSV file that has been indexed, from 0 to 1
+ */
+qreal CSV::Player::indexProgress() const
+{
+  if (!m_indexJob || m_indexSize <= 0)
+    return 1;
+
+  return qBound(0.0, static_cast<qreal>(m_indexedBytes) / m_indexSize, 1.0);
+}
+
+/**
+ * Returns the list of playback speeds that the user can select
+ */
+QStringList CSV::Player::availableSpeeds() const
+{
+  return {tr("1x"), tr("2x"), tr("10x"), tr("Unthrottled")};
+}
+
 /**
  * Returns the short filename of the current CSV file
  */
@@ -106,13 +434,34 @@ QString CSV::Player::filename() const
 {
   if (isOpen())
   {
-    auto fileInfo = QFileInfo(m_csvFile.fileName());
+    auto fileInfo = QFileInfo(m_filePath);
     return fileInfo.fileName();
   }
 
   return "";
 }
 
+/**
+ * @brief Parses the date/time stored in a CSV cell without creating any
+ *        temporary string.
+ *
+ * Accepts the same formats as the row index of the player, e.g. the
+ * "yyyy/MM/dd HH:mm:ss::zzz" format used by @c CSV::Export.
+ *
+ * @param begin The first character of the cell.
+ * @param end The character after the last character of the cell.
+ * @param ok Set to @c false if the cell does not contain a valid date/time.
+ * @return The wall-clock date/time in milliseconds since the epoch.
+ */
+qint64 CSV::Player::parseDateTime(const char *begin, const char *end, bool *ok)
+{
+  const auto time = parseTimestamp(begin, end);
+  if (ok)
+    *ok = time != kInvalidTime;
+
+  return time == kInvalidTime ? 0 : time;
+}
+
 /**
  * Returns the default path for CSV files
  */
@@ -160,9 +509,28 @@ void CSV::Player::play()
 void CSV::Player::pause()
 {
   m_playing = false;
+  m_playbackTimer.stop();
   Q_EMIT playerStateChanged();
 }
 
+/**
+ * Changes the playback speed, @a speed is an index of the list returned by
+ * @c availableSpeeds().
+ */
+void CSV::Player::setSpeed(const int speed)
+{
+  const auto count = static_cast<int>(std::size(kSpeeds));
+  m_speed = std::clamp(speed, 0, count - 1);
+  Q_EMIT speedChanged();
+
+  if (isPlaying())
+  {
+    m_nextFrameTime = 0;
+    m_playbackClock.start();
+    m_playbackTimer.start(0);
+  }
+}
+
 /**
  * Toggles play/pause state
  */
@@ -182,7 +550,7 @@ void CSV::Player::openFile()
   // Get file name
   auto file = QFileDialog::getOpenFileName(
       nullptr, tr("Select CSV file"), csvFilesPath(),
-      tr("CSV files") + QStringLiteral(" (*.csv)"));
+      tr("CSV files") + QStringLiteral(" (*.csv *.csv.gz)"));
 
   // Open CSV file
   if (!file.isEmpty())
@@ -195,16 +563,53 @@ void CSV::Player::openFile()
  */
 void CSV::Player::closeFile()
 {
-  m_framePos = 0;
+  // Stop the indexing jobs
+  if (m_indexJob)
+  {
+    m_indexJob->cancelled = true;
+    m_indexJob.reset();
+  }
+
+  m_nextChunk = 0;
+  m_indexSize = 0;
+  m_indexedBytes = 0;
+  m_indexChunks.clear();
+
+  // Unmap & close the file
+  if (m_data)
+    m_csvFile.unmap(m_data);
+
+  m_data = nullptr;
+  m_dataSize = 0;
   m_csvFile.close();
-  m_csvData.clear();
-  m_csvData.squeeze();
+  m_filePath.clear();
+  m_decompressedFile.reset();
+
+  // Reset the row index & cached data
+  m_framePos = 0;
+  m_cachedRow = -1;
+  m_filledRow = -1;
+  m_filledCells.clear();
+  m_timeColumn = 0;
+  m_timeInterval = 0;
+  m_startTime = QDateTime();
+  m_headers.clear();
+  m_rowOffsets.clear();
+  m_rowOffsets.squeeze();
+  m_timestamps.clear();
+  m_timestamps.squeeze();
+  m_sortedTimestamps = true;
+  m_cachedFields.clear();
+  m_playbackTimer.stop();
   m_playing = false;
   m_timestamp = "--.--";
+  reportMemoryUsage();
 
   Q_EMIT openChanged();
   Q_EMIT timestampChanged();
+  Q_EMIT frameCountChanged();
   Q_EMIT playerStateChanged();
+  Q_EMIT indexProgressChanged();
 }
 
 /**
@@ -225,14 +630,59 @@ void CSV::Player::nextFrame()
     UI::Dashboard::instance().resetData(false);
     int framesToLoad = UI::Dashboard::instance().points();
     int startFrame = std::max(1, m_framePos - framesToLoad);
-    for (int i = startFrame; i <= m_framePos; ++i)
-      IO::Manager::instance().processPayload(getFrame(i));
+    processFrames(startFrame, m_framePos);
 
     // Keep timestamp and data in sync
     updateData();
   }
 }
 
+/**
+ * @brief Sends every row after the current one with a date/time up to the
+ *        given @a time (in milliseconds), without the playback timer.
+ *
+ * Used to step through a file faster than real-time (e.g. when rendering a
+ * replayed session to a video), playback is paused if it was running.
+ *
+ * @return @c false if the end of the file was reached, or if the date/time of
+ *         the next row is invalid.
+ */
+bool CSV::Player::advanceTo(const qint64 time)
+{
+  // Nothing left to send
+  if (!isOpen() || framePosition() >= frameCount() - 1)
+    return false;
+
+  // Stop the playback timer
+  if (isPlaying())
+    pause();
+
+  // Find the last row that is due
+  const auto first = framePosition() + 1;
+  while (framePosition() < frameCount() - 1)
+  {
+    const auto next = rowTime(framePosition() + 1);
+    if (next == kInvalidTime)
+      return false;
+
+    if (next > time)
+      break;
+
+    ++m_framePos;
+  }
+
+  // Submit the rows in a single batch
+  if (framePosition() >= first)
+  {
+    bool error;
+    processFrames(first, framePosition());
+    m_timestamp = getTimestamp(framePosition(), error);
+    Q_EMIT timestampChanged();
+  }
+
+  return framePosition() < frameCount() - 1;
+}
+
 /**
  * @brief Reads & processes the previous CSV row, capped at the first row.
  *
@@ -251,8 +701,7 @@ void CSV::Player::previousFrame()
     UI::Dashboard::instance().resetData(false);
     int framesToLoad = UI::Dashboard::instance().points();
     int startFrame = std::max(1, m_framePos - framesToLoad);
-    for (int i = startFrame; i <= m_framePos; ++i)
-      IO::Manager::instance().processPayload(getFrame(i));
+    processFrames(startFrame, m_framePos);
 
     // Keep timestamp and data in sync
     updateData();
@@ -266,19 +715,18 @@ void CSV::Player::previousFrame()
  * processes the data for replaying. It checks if a device is connected and,
  * if so, asks the user to disconnect it.
  *
- * The function reads the CSV file into a string matrix (`m_csvData`), validates
- * the date/time format of the first column, and if necessary, prompts the user
- * to either select a valid date/time column or manually set an interval between
- * rows.
- *
- * Once the date/time column is validated, the function sorts the rows in
- * `m_csvData` based on the date/time in the first column. After sorting, it
- * signals the UI to update and starts playback of the first frame of the CSV
- * data.
+ * The file is memory-mapped, and only the header & the first data row are read
+ * before playback begins. The function validates the date/time format of the
+ * first column, and if necessary, prompts the user to either select a valid
+ * date/time column or manually set an interval between rows. The offsets of the
+ * remaining rows are obtained by a background job (see @c startIndexing()).
  *
  * If the file cannot be opened or an error occurs (e.g., invalid CSV data), the
  * function displays an appropriate error message and aborts further processing.
  *
+ * Files with the @c .gz extension are decompressed into a temporary file
+ * first, which is mapped instead of the original file.
+ *
  * @param filePath The file path of the CSV file to be opened.
  */
 void CSV::Player::openFile(const QString &filePath)
@@ -304,76 +752,110 @@ void CSV::Player::openFile(const QString &filePath)
       return;
   }
 
-  // Try to open the current file
-  m_csvFile.setFileName(filePath);
-  if (m_csvFile.open(QIODevice::ReadOnly))
+  // Decompress gzip files
+  auto path = filePath;
+  if (filePath.endsWith(QStringLiteral(".gz"), Qt::CaseInsensitive))
   {
-    // Read CSV file into string matrix
-    QTextStream in(&m_csvFile);
-    while (!in.atEnd())
+    QFile compressed(filePath);
+    m_decompressedFile = std::make_unique<QTemporaryFile>();
+    if (!compressed.open(QIODevice::ReadOnly) || !m_decompressedFile->open()
+        || !CSV::Gzip::decompress(compressed, *m_decompressedFile)
+        || !m_decompressedFile->flush())
     {
-      // Read a line and split it into a list of items
-      QStringList row = in.readLine().split(',');
-
-      // Remove surrounding quotes and trim whitespace from each item
-      for (auto &item : row)
-      {
-        item = item.simplified();
-        item.remove(QStringLiteral("\""));
-      }
+      Misc::Utilities::showMessageBox(
+          tr("Cannot read CSV file"),
+          tr("The compressed file is damaged or was not created by %1")
+              .arg(qAppName()));
+      closeFile();
+      return;
+    }
 
-      // Filter out rows that are empty or contain only empty items
-      bool isRowValid
-          = !row.isEmpty()
-            && std::any_of(row.cbegin(), row.cend(),
-                           [](const QString &item) { return !item.isEmpty(); });
+    path = m_decompressedFile->fileName();
+  }
 
-      // Only register valid rows
-      if (isRowValid)
-        m_csvData.append(row);
-    }
+  // Try to open & map the current file
+  m_filePath = filePath;
+  m_csvFile.setFileName(path);
+  if (!m_csvFile.open(QIODevice::ReadOnly))
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Cannot read CSV file"),
+        tr("Please check file permissions & location"));
+    closeFile();
+    return;
+  }
 
-    // Validate the cell at (1,1) for date/time format
-    if (!getDateTime(1).isValid())
+  // Map the file, an empty file cannot be mapped
+  m_dataSize = m_csvFile.size();
+  if (m_dataSize > 0)
+  {
+    m_data = m_csvFile.map(0, m_dataSize);
+    if (!m_data)
     {
-      // Ask user to select date/time column or set interval manually
-      if (!promptUserForDateTimeOrInterval())
-      {
-        closeFile();
-        return;
-      }
+      Misc::Utilities::showMessageBox(
+          tr("Cannot read CSV file"),
+          tr("Please check file permissions & location"));
+      closeFile();
+      return;
     }
+  }
 
-    // Remove the header row from the data
-    m_framePos = 0;
-    m_csvData.removeFirst();
+  // Skip the UTF-8 byte order mark
+  qint64 offset = 0;
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  if (m_dataSize >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+    offset = 3;
 
-    // Begin reading data
-    if (m_csvData.count() >= 2)
-    {
-      updateData();
-      Q_EMIT openChanged();
-    }
+  // Find the header & the first data row
+  const auto header = nextRow(offset);
+  qint64 first = -1;
+  if (header >= 0)
+    first = nextRow(findLineEnd(data, m_dataSize, header) + 1);
 
-    // Handle case where CSV file does not contain at least two frames
-    else
+  // Handle case where CSV file does not contain any frame
+  if (first < 0)
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Insufficient Data in CSV File"),
+        tr("The CSV file must contain at least two frames (data rows) to "
+           "proceed. Please check the file and try again."));
+    closeFile();
+    return;
+  }
+
+  // Register the header & the first data row
+  m_headers = parseRow(header);
+  m_rowOffsets.append(first);
+
+  // Validate the first cell for date/time format
+  if (!getDateTime(0).isValid())
+  {
+    // Ask user to select date/time column or set interval manually
+    if (!promptUserForDateTimeOrInterval())
     {
-      Misc::Utilities::showMessageBox(
-          tr("Insufficient Data in CSV File"),
-          tr("The CSV file must contain at least two frames (data rows) to "
-             "proceed. Please check the file and try again."));
       closeFile();
+      return;
     }
   }
 
-  // Open error
-  else
+  // Register the timestamp of the first data row
+  const auto fallback = toMsecs(m_startTime);
+  if (m_timeColumn >= 0)
   {
-    Misc::Utilities::showMessageBox(
-        tr("Cannot read CSV file"),
-        tr("Please check file permissions & location"));
-    closeFile();
+    const auto time
+        = findTimestamp(data, m_dataSize, first, m_timeColumn, fallback);
+    m_sortedTimestamps = time != kInvalidTime;
+    m_timestamps.append(time);
   }
+
+  // Index the remaining rows in the background
+  startIndexing(findLineEnd(data, m_dataSize, first) + 1);
+
+  // Begin reading data
+  m_framePos = 0;
+  updateData();
+  Q_EMIT openChanged();
+  Q_EMIT frameCountChanged();
 }
 
 /**
@@ -399,6 +881,11 @@ void CSV::Player::openFile(const QString &filePath)
  *   reloaded up to the new position, but capped to prevent going beyond the
  *   end of the CSV file.
  *
+ * When the timestamps of the CSV file are sorted, @a progress represents the
+ * time elapsed since the first row, and the target row is found with a binary
+ * search over the timestamps obtained when the file was indexed. Otherwise,
+ * @a progress is proportional to the row number.
+ *
  * @param progress A normalized value between 0.0 and 1.0 representing the
  *                 desired position in the CSV file.
  *
@@ -422,6 +909,13 @@ void CSV::Player::setProgress(const qreal progress)
 
   // Calculate new frame position based on progress
   int newFramePos = qMin(frameCount() - 1, qCeil(frameCount() * validProgress));
+  if (m_sortedTimestamps && frameCount() > 1)
+  {
+    const auto start = rowTime(0);
+    const auto duration = rowTime(frameCount() - 1) - start;
+    if (duration > 0)
+      newFramePos = rowAtTime(start + qRound64(duration * validProgress));
+  }
 
   // Only process if position changes
   if (newFramePos != m_framePos)
@@ -436,8 +930,7 @@ void CSV::Player::setProgress(const qreal progress)
     int endFrame = std::min(frameCount() - 1, m_framePos);
 
     // Populate dashboard with frames within capped range
-    for (int i = startFrame; i <= endFrame; ++i)
-      IO::Manager::instance().processPayload(getFrame(i));
+    processFrames(startFrame, endFrame);
 
     // Update with current data
     updateData();
@@ -448,9 +941,8 @@ void CSV::Player::setProgress(const qreal progress)
  * Generates a JSON data frame by combining the values of the current CSV
  * row & the structure of the JSON map file loaded in the @c JsonParser class.
  *
- * If playback is enabled, this function calculates the difference in
- * milliseconds between the current row and the next row & schedules a re-call
- * of this function using a timer.
+ * If playback is enabled, this function restarts the playback clock at the
+ * current row & schedules the next frame with @c onPlaybackTick().
  */
 void CSV::Player::updateData()
 {
@@ -460,54 +952,142 @@ void CSV::Player::updateData()
 
   // Update timestamp string
   bool error = true;
-  auto timestamp = getCellValue(framePosition(), 0, error);
+  const auto timestamp = getTimestamp(framePosition(), error);
   if (!error)
   {
     m_timestamp = timestamp;
-    IO::Manager::instance().processPayload(getFrame(framePosition()));
+    processFrames(framePosition(), framePosition());
     Q_EMIT timestampChanged();
   }
 
-  // If the user wants to 'play' the CSV, get time difference between this
-  // frame and the next frame & schedule an automated update
+  // Restart the playback clock at the current frame
   if (!error && isPlaying())
   {
-    // Get first frame
-    if (framePosition() < frameCount() - 1)
+    m_nextFrameTime = 0;
+    m_throughputFrames = 0;
+    m_playbackClock.start();
+    m_throughputClock.start();
+    m_playbackTimer.start(0);
+  }
+}
+
+/**
+ * @brief Sends every frame that is due to the I/O manager during playback.
+ *
+ * The due time of each frame is the sum of the (absolute) time differences
+ * between the rows that precede it, measured from the row at which playback
+ * started & divided by the playback speed. All frames that became due since
+ * the last tick are submitted at once, so that high-frequency CSV files are
+ * replayed at their real speed regardless of the resolution of the system
+ * timer. The timestamp shown in the user interface is only updated once per
+ * tick.
+ *
+ * In unthrottled mode, timestamps are ignored and up to @c kMaxBatchSize
+ * frames are submitted per tick, the next tick runs as soon as the event loop
+ * has processed the previous batch.
+ */
+void CSV::Player::onPlaybackTick()
+{
+  // Playback stopped
+  if (!isOpen() || !isPlaying())
+    return;
+
+  // Obtain the playback speed, zero means unthrottled
+  const auto speed = kSpeeds[m_speed];
+  const auto elapsed = m_playbackClock.nsecsElapsed() / 1e6;
+
+  // Collect every frame that is due
+  bool invalid = false;
+  const auto first = framePosition() + 1;
+  while (framePosition() < frameCount() - 1)
+  {
+    // Unthrottled playback, limit the size of each batch
+    if (speed <= 0)
     {
-      // Obtain time for current & next frame
-      auto currTime = getDateTime(framePosition());
-      auto nextTime = getDateTime(framePosition() + 1);
+      if (framePosition() - first + 1 >= kMaxBatchSize)
+        break;
+    }
 
-      // No error, calculate difference & schedule update
-      if (currTime.isValid() && nextTime.isValid())
+    // Real-time or accelerated playback, check if next frame is due
+    else
+    {
+      // Obtain time for current & next frame
+      const auto currTime = rowTime(framePosition());
+      const auto nextTime = rowTime(framePosition() + 1);
+      if (currTime == kInvalidTime || nextTime == kInvalidTime)
       {
-        // Obtain millis between the two frames
-        const auto msecsToNextF = abs(currTime.msecsTo(nextTime));
-
-        // Jump to next frame
-        QTimer::singleShot(msecsToNextF, Qt::PreciseTimer, this, [=] {
-          if (isOpen() && isPlaying() && framePosition() < frameCount())
-          {
-            ++m_framePos;
-            updateData();
-          }
-        });
+        invalid = true;
+        break;
       }
 
-      // Error - pause playback
-      else
-      {
-        pause();
-        qWarning() << "Error getting timestamp difference" << currTime
-                   << nextTime;
-      }
+      // Next frame is not due yet
+      const auto dueTime = m_nextFrameTime + qAbs(nextTime - currTime) / speed;
+      if (dueTime > elapsed)
+        break;
+
+      m_nextFrameTime = dueTime;
     }
 
-    // Pause at end of CSV
-    else
-      pause();
+    // Jump to next frame
+    ++m_framePos;
+  }
+
+  // Submit the frames in a single batch
+  const auto count = framePosition() - first + 1;
+  if (count > 0)
+  {
+    bool error;
+    processFrames(first, framePosition());
+    m_timestamp = getTimestamp(framePosition(), error);
+    Q_EMIT timestampChanged();
+  }
+
+  // Update the achieved frame rate
+  m_throughputFrames += count;
+  if (m_throughputClock.elapsed() >= 1000)
+  {
+    m_throughput = m_throughputFrames * 1000.0 / m_throughputClock.elapsed();
+    m_throughputFrames = 0;
+    m_throughputClock.start();
+    Q_EMIT throughputChanged();
+  }
+
+  // Error - pause playback
+  if (invalid)
+  {
+    pause();
+    qWarning() << "Error getting timestamp difference"
+               << getDateTime(framePosition())
+               << getDateTime(framePosition() + 1);
+    return;
+  }
+
+  // Pause at end of CSV
+  if (framePosition() >= frameCount() - 1)
+  {
+    pause();
+    return;
+  }
+
+  // Unthrottled playback, run again once the batch is processed
+  if (speed <= 0)
+  {
+    m_playbackTimer.start(0);
+    return;
+  }
+
+  // Schedule the next tick when the next frame is due
+  qreal wait = 0;
+  const auto currTime = rowTime(framePosition());
+  const auto nextTime = rowTime(framePosition() + 1);
+  if (currTime != kInvalidTime && nextTime != kInvalidTime)
+  {
+    const auto dueTime = m_nextFrameTime + qAbs(nextTime - currTime) / speed;
+    wait = dueTime - m_playbackClock.nsecsElapsed() / 1e6;
   }
+
+  const qreal maxWait = std::numeric_limits<int>::max();
+  m_playbackTimer.start(static_cast<int>(qBound<qreal>(0, wait, maxWait)));
 }
 
 /**
@@ -525,7 +1105,7 @@ void CSV::Player::updateData()
 bool CSV::Player::promptUserForDateTimeOrInterval()
 {
   // Check if there are headers available for the combobox
-  if (m_csvData.isEmpty() || m_csvData.first().isEmpty())
+  if (m_headers.isEmpty())
   {
     Misc::Utilities::showMessageBox(
         tr("Invalid CSV"),
@@ -534,7 +1114,7 @@ bool CSV::Player::promptUserForDateTimeOrInterval()
   }
 
   // Obtain header labels
-  const auto headerLabels = m_csvData.first().toList();
+  const auto headerLabels = m_headers;
 
   // Ask the user if they want to select a date/time column or enter an interval
   bool ok;
@@ -595,54 +1175,238 @@ bool CSV::Player::promptUserForDateTimeOrInterval()
 /**
  * @brief Generates date/time values for each row based on a fixed interval.
  *
- * This function generates date/time strings starting from the current time
- * and increments them by a user-specified interval in milliseconds. It then
- * prepends the generated date/time string to each row of the CSV data.
+ * The date/time of each row is calculated on demand by @c getDateTime(),
+ * starting from the current time and incrementing by a user-specified interval
+ * in milliseconds. All the columns of the CSV file are used as frame data.
  *
  * @param interval The interval in milliseconds between each row.
  */
 void CSV::Player::generateDateTimeForRows(int interval)
 {
-  const auto startTime = QDateTime::currentDateTime();
-  const auto format = QStringLiteral("yyyy/MM/dd HH:mm:ss::zzz");
+  m_timeColumn = -1;
+  m_timeInterval = interval;
+  m_startTime = QDateTime::currentDateTime();
+}
+
+/**
+ * @brief Uses the specified column of the CSV data as the date/time of each
+ *        row.
+ *
+ * The selected column is parsed by @c getDateTime() with the formats defined
+ * in the cell variant of that function, and is excluded from the frames
+ * generated by @c getFrame(). If a valid date/time is not found in a cell,
+ * the time at which the column was selected is used.
+ *
+ * @param columnIndex The index of the column that contains the date/time of
+ *                    each row.
+ */
+void CSV::Player::convertColumnToDateTime(int columnIndex)
+{
+  m_timeColumn = columnIndex;
+  m_startTime = QDateTime::currentDateTime();
+}
 
-  for (int i = 0; i < m_csvData.size(); ++i)
+/**
+ * @brief Builds the row-offset index of the CSV file in the background.
+ *
+ * The file is split into chunks of similar size from the given @a offset,
+ * which are scanned in parallel by the worker pool. A chunk owns the rows that
+ * start within it: each worker skips the partial line at the beginning of its
+ * chunk, and scans the line that crosses the end of the chunk.
+ *
+ * The workers send the offsets & timestamps of the rows that they find to
+ * @c onRowsIndexed() in batches, together with the number of bytes scanned
+ * since the previous batch, so that the frame count & the indexing progress
+ * grow while the user is already navigating through the file.
+ */
+void CSV::Player::startIndexing(const qint64 offset)
+{
+  // Create a new job
+  auto job = std::make_shared<IndexJob>();
+  job->size = m_dataSize;
+  job->cancelled = false;
+  job->timeColumn = m_timeColumn;
+  job->fallbackTime = toMsecs(m_startTime);
+  job->path = m_csvFile.fileName();
+  m_indexJob = job;
+
+  // Split the file into chunks
+  const auto length = qMax<qint64>(0, m_dataSize - offset);
+  const auto maxChunks = QThread::idealThreadCount() * kIndexChunksPerThread;
+  const auto count = qBound<qint64>(1, length / kMinIndexChunkBytes, maxChunks);
+
+  m_nextChunk = 0;
+  m_indexedBytes = 0;
+  m_indexSize = length;
+  m_indexChunks.clear();
+  m_indexChunks.resize(count);
+  Q_EMIT indexProgressChanged();
+
+  // Scan each chunk in the worker pool
+  auto *player = this;
+  for (qint64 i = 0; i < count; ++i)
   {
-    QString dateTimeString = startTime.addMSecs(i * interval).toString(format);
-    m_csvData[i].prepend(dateTimeString);
+    const auto chunk = static_cast<int>(i);
+    const auto begin = offset + length * i / count;
+    const auto end = offset + length * (i + 1) / count;
+    Misc::WorkerPool::instance().start([job, player, chunk, begin, end] {
+      // Sends the rows found so far to the player
+      qint64 position = begin;
+      QVector<qint64> offsets;
+      QVector<qint64> timestamps;
+      const auto publish = [&](const qint64 scanned, const bool finished) {
+        const auto bytes = qMin(scanned, end) - position;
+        QMetaObject::invokeMethod(
+            player,
+            [=] {
+              player->onRowsIndexed(job, chunk, offsets, timestamps, bytes,
+                                    finished);
+            },
+            Qt::QueuedConnection);
+        position += bytes;
+        offsets.clear();
+        timestamps.clear();
+      };
+
+      // Map the file
+      QFile file(job->path);
+      uchar *map = nullptr;
+      const auto size = job->size;
+      if (size > 0 && file.open(QIODevice::ReadOnly))
+        map = file.map(0, size);
+
+      // Register the offset of each row that starts in the chunk
+      if (map)
+      {
+        auto offset = begin;
+        const auto *data = reinterpret_cast<const char *>(map);
+        if (chunk > 0 && data[offset - 1] != '\n')
+          offset = findLineEnd(data, size, offset) + 1;
+
+        while (!job->cancelled)
+        {
+          offset = findRow(data, size, offset);
+          if (offset < 0 || offset >= end)
+            break;
+
+          offsets.append(offset);
+          if (job->timeColumn >= 0)
+            timestamps.append(findTimestamp(data, size, offset, job->timeColumn,
+                                            job->fallbackTime));
+
+          offset = findLineEnd(data, size, offset) + 1;
+
+          if (offsets.count() >= kIndexChunkSize)
+            publish(offset, false);
+        }
+
+        file.unmap(map);
+      }
+
+      // Notify the player that the chunk was indexed
+      publish(end, true);
+    });
   }
 }
 
 /**
- * @brief Converts the specified column in the CSV data to a date/time format
- *        and moves it to the start of each row.
+ * @brief Registers the rows found by an indexing worker.
  *
- * This function processes the specified column (excluding the header row) in
- * the CSV data and converts each value to a `QDateTime` object using the
- * formats defined in the `getDateTime` function. If a valid `QDateTime` is not
- * found, the current date/time is used. The converted date/time string is then
- * moved to the start of each row.
+ * Rows are added to the index in file order: the rows of the chunk that
+ * follows the last complete chunk are appended right away, while the rows of
+ * later chunks are kept until every preceding chunk has been indexed.
  *
- * The header row (row 0) is excluded from this operation to ensure it remains
- * intact. The selected column is removed from its original position and moved
- * to the start of the row as a formatted date/time string.
- *
- * @param columnIndex The index of the column to convert and move to the start
- * of each row.
+ * Results from a job that belongs to a previous file are discarded. Once the
+ * whole file has been indexed, the function verifies that the file contains
+ * at least two frames.
  */
-void CSV::Player::convertColumnToDateTime(int columnIndex)
+void CSV::Player::onRowsIndexed(const std::shared_ptr<IndexJob> &job,
+                                const int chunk,
+                                const QVector<qint64> &offsets,
+                                const QVector<qint64> &timestamps,
+                                const qint64 bytes, const bool finished)
 {
-  const auto format = QStringLiteral("yyyy/MM/dd HH:mm:ss::zzz");
-  for (int i = 1; i < m_csvData.size(); ++i)
+  // Ignore results from previous files
+  if (!isOpen() || job != m_indexJob)
+    return;
+
+  // Update the indexing progress
+  m_indexedBytes += bytes;
+  Q_EMIT indexProgressChanged();
+
+  // Keep the rows of chunks that cannot be appended yet
+  auto &pending = m_indexChunks[chunk];
+  pending.finished = finished;
+  if (chunk != m_nextChunk)
   {
-    // Parse the date/time from the specified column
-    auto dateTime = getDateTime(i);
-    if (!dateTime.isValid())
-      dateTime = QDateTime::currentDateTime();
+    pending.offsets.append(offsets);
+    pending.timestamps.append(timestamps);
+    return;
+  }
 
-    // Move the $TIME column to the start
-    m_csvData[i].remove(columnIndex);
-    m_csvData[i].prepend(dateTime.toString(format));
+  // Append the rows, followed by the rows of the chunks completed meanwhile
+  appendRows(offsets, timestamps);
+  while (m_nextChunk < m_indexChunks.count()
+         && m_indexChunks[m_nextChunk].finished)
+  {
+    if (++m_nextChunk < m_indexChunks.count())
+    {
+      auto &next = m_indexChunks[m_nextChunk];
+      appendRows(next.offsets, next.timestamps);
+      next.offsets = QVector<qint64>();
+      next.timestamps = QVector<qint64>();
+    }
+  }
+
+  // Indexing finished, validate the number of frames
+  if (m_nextChunk >= m_indexChunks.count())
+  {
+    m_indexJob.reset();
+    m_indexChunks.clear();
+    Q_EMIT indexProgressChanged();
+
+    if (frameCount() < 2)
+    {
+      Misc::Utilities::showMessageBox(
+          tr("Insufficient Data in CSV File"),
+          tr("The CSV file must contain at least two frames (data rows) to "
+             "proceed. Please check the file and try again."));
+      closeFile();
+    }
+  }
+}
+
+/**
+ * Appends the given rows to the index & checks if the timestamps are still
+ * sorted.
+ */
+void CSV::Player::appendRows(const QVector<qint64> &offsets,
+                             const QVector<qint64> &timestamps)
+{
+  // Check if the timestamps are still sorted
+  if (m_sortedTimestamps && !m_timestamps.isEmpty())
+  {
+    auto previous = m_timestamps.last();
+    for (const auto time : timestamps)
+    {
+      if (time == kInvalidTime || time < previous)
+      {
+        m_sortedTimestamps = false;
+        break;
+      }
+
+      previous = time;
+    }
+  }
+
+  // Register the new rows
+  if (!offsets.isEmpty())
+  {
+    m_rowOffsets.append(offsets);
+    m_timestamps.append(timestamps);
+    reportMemoryUsage();
+    Q_EMIT frameCountChanged();
+    Q_EMIT timestampChanged();
   }
 }
 
@@ -660,13 +1424,27 @@ void CSV::Player::convertColumnToDateTime(int columnIndex)
  */
 QDateTime CSV::Player::getDateTime(const int row)
 {
+  // Date/time generated from a fixed interval
+  if (m_timeColumn < 0)
+  {
+    if (row >= 0 && row < frameCount())
+      return m_startTime.addMSecs(static_cast<qint64>(row) * m_timeInterval);
+
+    return QDateTime();
+  }
+
+  // Parse the date/time column
   bool error;
-  auto value = getCellValue(row, 0, error);
+  const auto value = getCellValue(row, m_timeColumn, error);
+  if (error)
+    return QDateTime();
 
-  if (!error)
-    return getDateTime(value);
+  // Use the time at which the column was selected for invalid cells
+  const auto dateTime = getDateTime(value);
+  if (!dateTime.isValid() && m_startTime.isValid())
+    return m_startTime;
 
-  return QDateTime();
+  return dateTime;
 }
 
 /**
@@ -712,52 +1490,281 @@ QDateTime CSV::Player::getDateTime(const QString &cell)
 }
 
 /**
- * Generates a frame from the data at the given @a row. The first item of each
- * row is ignored because it contains the RX date/time, which is used to
- * regulate the interval at which the frames are parsed.
+ * Returns the frame fields of the given @a row. The date/time column of each
+ * row is ignored, because it is used to regulate the interval at which the
+ * frames are parsed.
  */
-QByteArray CSV::Player::getFrame(const int row)
+QStringList CSV::Player::getFields(const int row)
 {
-  QByteArray frame;
+  auto fields = getRow(row);
+  fillEmptyCells(row, fields);
+  if (m_timeColumn >= 0 && m_timeColumn < fields.count())
+    fields.removeAt(m_timeColumn);
+
+  return fields;
+}
 
-  if (m_csvData.count() > row)
+/**
+ * @brief Replaces the empty @a cells of the given @a row with the latest
+ *        value of the same column in earlier rows.
+ *
+ * When rows are read in order, the cells of the previously filled row are
+ * used. Otherwise (e.g. after seeking), earlier rows are parsed until every
+ * cell is filled, looking back no further than the interval at which sparse
+ * CSV files contain a complete row.
+ */
+void CSV::Player::fillEmptyCells(const int row, QStringList &cells)
+{
+  // Playing in order, take the values of the previous row
+  if (row == m_filledRow + 1 && m_filledCells.count() == cells.count())
   {
-    const auto &list = m_csvData[row];
-    for (int i = 1; i < list.count(); ++i)
+    for (qsizetype i = 0; i < cells.count(); ++i)
     {
-      frame.append(list[i].toUtf8());
-      if (i < list.count() - 1)
-        frame.append(',');
-      else
-        frame.append('\n');
+      if (cells[i].isEmpty())
+        cells[i] = m_filledCells[i];
     }
   }
 
+  // Seeking, look back until the previous complete row
+  else
+  {
+    auto missing = std::count_if(cells.cbegin(), cells.cend(),
+                                 [](const QString &c) { return c.isEmpty(); });
+    const auto limit
+        = qMax(0, row - CSV::ExportWriter::kSparseKeyframeInterval);
+    for (int r = row - 1; r >= limit && missing > 0; --r)
+    {
+      const auto previous = parseRow(m_rowOffsets[r]);
+      const auto count = qMin(cells.count(), previous.count());
+      for (qsizetype i = 0; i < count; ++i)
+      {
+        if (cells[i].isEmpty() && !previous[i].isEmpty())
+        {
+          cells[i] = previous[i];
+          --missing;
+        }
+      }
+    }
+  }
+
+  // Remember the filled row for the next call
+  m_filledRow = row;
+  m_filledCells = cells;
+}
+
+/**
+ * Generates a frame from the data at the given @a row, in the same format
+ * that a device would send it (comma-separated values).
+ */
+QByteArray CSV::Player::getFrame(const int row)
+{
+  QByteArray frame;
+
+  const auto fields = getFields(row);
+  for (int i = 0; i < fields.count(); ++i)
+  {
+    frame.append(fields[i].toUtf8());
+    if (i < fields.count() - 1)
+      frame.append(',');
+    else
+      frame.append('\n');
+  }
+
   return frame;
 }
 
+/**
+ * @brief Sends the rows from @a first to @a last (inclusive) to the rest of
+ *        the application.
+ *
+ * In project mode, the fields of each row are handed directly to the frame
+ * builder, avoiding joining them into a comma-separated frame that would be
+ * split again right away. The raw CSV lines are still published through the
+ * @c IO::Manager::dataReceived() signal, so that the console & the plugins
+ * server keep receiving the replayed data. In other operation modes, the rows
+ * are submitted as comma-separated frames through the I/O manager.
+ */
+void CSV::Player::processFrames(const int first, const int last)
+{
+  // Validate range
+  if (first < 0 || last < first || last >= frameCount())
+    return;
+
+  // Send comma-separated frames through the I/O manager
+  auto *builder = &JSON::FrameBuilder::instance();
+  if (builder->operationMode() != SerialStudio::ProjectFile)
+  {
+    QList<QByteArray> frames;
+    frames.reserve(last - first + 1);
+    for (int i = first; i <= last; ++i)
+      frames.append(getFrame(i));
+
+    IO::Manager::instance().processPayloads(frames);
+    return;
+  }
+
+  // Obtain the fields of each row
+  QList<QStringList> fields;
+  fields.reserve(last - first + 1);
+  for (int i = first; i <= last; ++i)
+    fields.append(getFields(i));
+
+  // Obtain the raw CSV lines, consecutive rows are contiguous in the file
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  const auto begin = m_rowOffsets[first];
+  const auto end = qMin(findLineEnd(data, m_dataSize, m_rowOffsets[last]) + 1,
+                        m_dataSize);
+  const auto raw = QByteArray(data + begin, end - begin);
+
+  // Publish the data
+  auto *manager = &IO::Manager::instance();
+  QMetaObject::invokeMethod(
+      manager, [=] { Q_EMIT manager->dataReceived(raw); },
+      Qt::QueuedConnection);
+  QMetaObject::invokeMethod(
+      builder, [=] { builder->readFields(fields); },
+      Qt::QueuedConnection);
+}
+
+/**
+ * Returns the date/time of the given @a row in milliseconds, as obtained when
+ * the file was indexed, or @c kInvalidTime if the row has no valid date/time.
+ */
+qint64 CSV::Player::rowTime(const int row) const
+{
+  if (row < 0 || row >= frameCount())
+    return kInvalidTime;
+
+  if (m_timeColumn < 0)
+    return static_cast<qint64>(row) * m_timeInterval;
+
+  if (row < m_timestamps.count())
+    return m_timestamps[row];
+
+  return kInvalidTime;
+}
+
+/**
+ * Returns the first row with a date/time equal or later than the given @a time
+ * (in milliseconds), using a binary search over the indexed timestamps. This
+ * function is only meaningful when the timestamps of the file are sorted.
+ */
+int CSV::Player::rowAtTime(const qint64 time) const
+{
+  // Date/time generated from a fixed interval
+  if (m_timeColumn < 0)
+  {
+    if (m_timeInterval <= 0)
+      return 0;
+
+    const auto row = (time + m_timeInterval - 1) / m_timeInterval;
+    return static_cast<int>(qBound<qint64>(0, row, frameCount() - 1));
+  }
+
+  // Search the timestamps of the indexed rows
+  const auto it = std::lower_bound(m_timestamps.cbegin(), m_timestamps.cend(),
+                                   time);
+  const auto row = static_cast<int>(it - m_timestamps.cbegin());
+  return qMin(row, frameCount() - 1);
+}
+
+/**
+ * Returns the date/time string displayed for the given @a row. If the row
+ * does not exist, the value of @a error shall be set to @c true.
+ */
+QString CSV::Player::getTimestamp(const int row, bool &error)
+{
+  if (m_timeColumn == 0)
+    return getCellValue(row, 0, error);
+
+  const auto dateTime = getDateTime(row);
+  error = !dateTime.isValid();
+  return dateTime.toString(kDateTimeFormat);
+}
+
+/**
+ * Returns the offset of the first row at or after the given @a offset of the
+ * mapped file, or -1 if there are no more rows.
+ */
+qint64 CSV::Player::nextRow(qint64 offset) const
+{
+  if (!m_data)
+    return -1;
+
+  return findRow(reinterpret_cast<const char *>(m_data), m_dataSize, offset);
+}
+
+/**
+ * Splits the row that starts at the given @a offset of the mapped file into
+ * cells, removing surrounding quotes & whitespace from each cell.
+ */
+QStringList CSV::Player::parseRow(const qint64 offset) const
+{
+  // Obtain the line, without the line terminator
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  auto end = findLineEnd(data, m_dataSize, offset);
+  if (end > offset && data[end - 1] == '\r')
+    --end;
+
+  // Split the line into a list of items
+  auto row = QString::fromUtf8(data + offset, end - offset).split(',');
+  for (auto &item : row)
+  {
+    item = item.simplified();
+    item.remove(QStringLiteral("\""));
+  }
+
+  return row;
+}
+
+/**
+ * Returns the cells of the given @a row, the last parsed row is cached so
+ * that reading several cells of the same row only parses it once.
+ */
+const QStringList &CSV::Player::getRow(const int row)
+{
+  static const QStringList empty;
+  if (row < 0 || row >= frameCount())
+    return empty;
+
+  if (row != m_cachedRow)
+  {
+    m_cachedFields = parseRow(m_rowOffsets[row]);
+    m_cachedRow = row;
+  }
+
+  return m_cachedFields;
+}
+
+/**
+ * @brief Reports the memory used by the row index of the CSV file.
+ *
+ * The contents of the file are memory-mapped, so they are backed by the file
+ * itself and are not counted as memory owned by the player.
+ */
+void CSV::Player::reportMemoryUsage()
+{
+  const auto rows = m_rowOffsets.capacity() + m_timestamps.capacity();
+  Misc::PipelineStats::instance().setMemoryUsage(
+      Misc::PipelineStats::CsvPlayer, rows * sizeof(qint64));
+}
+
 /**
  * Safely returns the value in the cell at the given @a row & @a column. If an
  * error occurs or the cell does not exist, the value of @a error shall be set
  * to @c true.
  */
-const QString &CSV::Player::getCellValue(const int row, const int column,
-                                         bool &error)
+QString CSV::Player::getCellValue(const int row, const int column, bool &error)
 {
-  static auto defaultValue = QStringLiteral("");
-
-  if (m_csvData.count() > row)
+  const auto &list = getRow(row);
+  if (column >= 0 && list.count() > column)
   {
-    const auto &list = m_csvData[row];
-    if (list.count() > column)
-    {
-      error = false;
-      return list[column];
-    }
+    error = false;
+    return list[column];
   }
 
   error = true;
-  return defaultValue;
+  return QString();
 }
 
 /**
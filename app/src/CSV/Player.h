@@ -22,10 +22,17 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QFile>
+#include <QTimer>
+#include <QTemporaryFile>
 #include <QObject>
 #include <QVector>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QKeyEvent>
+#include <QStringList>
 
 namespace CSV
 {
@@ -34,6 +41,30 @@ namespace CSV
  *
  * The CSV player class allows users to select a CSV file and "re-play" it
  * with Serial Studio.
+ *
+ * The CSV file is memory-mapped instead of being loaded into memory. When a
+ * file is opened, it is split into chunks at line boundaries, and background
+ * jobs scan the chunks in parallel to build an index with the offset of each
+ * row, while the cells of a row are only parsed when the row is displayed.
+ * The rows of each chunk are added to the index in file order, as soon as
+ * the preceding chunks are complete, so playback can start while the rest of
+ * the file is being indexed. This way, large CSV files open instantly, and
+ * seeking to any position simply jumps to the offset of the target row.
+ *
+ * The timestamp of each row is parsed once by the indexing job and stored in
+ * milliseconds, so that playback is driven by a single timer that emits every
+ * frame that is due at each tick, instead of parsing dates & scheduling a
+ * timer for each row. Frames can be replayed faster than real-time, or as
+ * fast as the application can process them, in which case the achieved frame
+ * rate is reported so that playback can be used to benchmark the pipeline.
+ *
+ * Empty cells take the value of the same column in earlier rows, so that
+ * sparse CSV files (which only list the values that changed) are replayed
+ * with the complete state of every dataset.
+ *
+ * Compressed CSV files (@c .csv.gz) generated by @c CSV::Export are
+ * decompressed into a temporary file, which is then mapped like any other
+ * CSV file.
  */
 class Player : public QObject
 {
@@ -47,7 +78,7 @@ class Player : public QObject
              NOTIFY timestampChanged)
   Q_PROPERTY(qreal frameCount
              READ frameCount
-             NOTIFY playerStateChanged)
+             NOTIFY frameCountChanged)
   Q_PROPERTY(qreal framePosition
              READ framePosition
              NOTIFY timestampChanged)
@@ -57,12 +88,29 @@ class Player : public QObject
   Q_PROPERTY(const QString& timestamp
              READ timestamp
              NOTIFY timestampChanged)
+  Q_PROPERTY(int speed
+             READ speed
+             WRITE setSpeed
+             NOTIFY speedChanged)
+  Q_PROPERTY(QStringList availableSpeeds
+             READ availableSpeeds
+             CONSTANT)
+  Q_PROPERTY(qreal throughput
+             READ throughput
+             NOTIFY throughputChanged)
+  Q_PROPERTY(qreal indexProgress
+             READ indexProgress
+             NOTIFY indexProgressChanged)
   // clang-format on
 
 signals:
   void openChanged();
+  void speedChanged();
   void timestampChanged();
+  void throughputChanged();
+  void frameCountChanged();
   void playerStateChanged();
+  void indexProgressChanged();
 
 private:
   explicit Player();
@@ -73,12 +121,20 @@ private:
 
 public:
   static Player &instance();
+  [[nodiscard]] static qint64 parseDateTime(const char *begin,
+                                            const char *end, bool *ok);
 
   [[nodiscard]] bool isOpen() const;
   [[nodiscard]] qreal progress() const;
   [[nodiscard]] bool isPlaying() const;
   [[nodiscard]] int frameCount() const;
   [[nodiscard]] int framePosition() const;
+  [[nodiscard]] qint64 currentTime() const;
+
+  [[nodiscard]] int speed() const;
+  [[nodiscard]] qreal throughput() const;
+  [[nodiscard]] qreal indexProgress() const;
+  [[nodiscard]] QStringList availableSpeeds() const;
 
   [[nodiscard]] QString filename() const;
   [[nodiscard]] QString csvFilesPath() const;
@@ -92,23 +148,60 @@ public slots:
   void closeFile();
   void nextFrame();
   void previousFrame();
+  bool advanceTo(const qint64 time);
   void openFile(const QString &filePath);
+  void setSpeed(const int speed);
   void setProgress(const qreal progress);
 
 private slots:
   void updateData();
+  void onPlaybackTick();
 
 private:
+  struct IndexJob;
+
+  /**
+   * @brief Rows found in a chunk of the file that cannot be added to the
+   *        index yet, because a preceding chunk is still being scanned.
+   */
+  struct IndexChunk
+  {
+    bool finished = false;
+    QVector<qint64> offsets;
+    QVector<qint64> timestamps;
+  };
+
   bool promptUserForDateTimeOrInterval();
   void generateDateTimeForRows(int interval);
   void convertColumnToDateTime(int columnIndex);
 
+  void startIndexing(const qint64 offset);
+  void onRowsIndexed(const std::shared_ptr<IndexJob> &job, const int chunk,
+                     const QVector<qint64> &offsets,
+                     const QVector<qint64> &timestamps, const qint64 bytes,
+                     const bool finished);
+  void appendRows(const QVector<qint64> &offsets,
+                  const QVector<qint64> &timestamps);
+
+  [[nodiscard]] qint64 rowTime(const int row) const;
+  [[nodiscard]] int rowAtTime(const qint64 time) const;
+  [[nodiscard]] QString getTimestamp(const int row, bool &error);
+
   QDateTime getDateTime(int row);
   QDateTime getDateTime(const QString &cell);
 
+  QStringList getFields(const int row);
+  void fillEmptyCells(const int row, QStringList &cells);
   QByteArray getFrame(const int row);
+  void processFrames(const int first, const int last);
+
+  [[nodiscard]] qint64 nextRow(qint64 offset) const;
+  [[nodiscard]] QStringList parseRow(const qint64 offset) const;
+  [[nodiscard]] const QStringList &getRow(const int row);
+
+  void reportMemoryUsage();
 
-  const QString &getCellValue(const int row, const int column, bool &error);
+  QString getCellValue(const int row, const int column, bool &error);
 
 protected:
   bool eventFilter(QObject *obj, QEvent *event) override;
@@ -118,7 +211,39 @@ private:
   int m_framePos;
   bool m_playing;
   QFile m_csvFile;
+  QString m_filePath;
   QString m_timestamp;
-  QList<QStringList> m_csvData;
+  std::unique_ptr<QTemporaryFile> m_decompressedFile;
+
+  uchar *m_data;
+  qint64 m_dataSize;
+  QStringList m_headers;
+  QVector<qint64> m_rowOffsets;
+  QVector<qint64> m_timestamps;
+  bool m_sortedTimestamps;
+  std::shared_ptr<IndexJob> m_indexJob;
+  QVector<IndexChunk> m_indexChunks;
+  int m_nextChunk;
+  qint64 m_indexSize;
+  qint64 m_indexedBytes;
+
+  int m_cachedRow;
+  QStringList m_cachedFields;
+
+  int m_filledRow;
+  QStringList m_filledCells;
+
+  int m_timeColumn;
+  int m_timeInterval;
+  QDateTime m_startTime;
+
+  int m_speed;
+  qreal m_nextFrameTime;
+  QTimer m_playbackTimer;
+  QElapsedTimer m_playbackClock;
+
+  qreal m_throughput;
+  qint64 m_throughputFrames;
+  QElapsedTimer m_throughputClock;
 };
 } // namespace CSV
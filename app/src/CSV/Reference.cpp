@@ -0,0 +1,1141 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "CSV/Reference.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <QtEndian>
+#include <QtNumeric>
+#include <QDataStream>
+#include <QFileDialog>
+#include <QFileInfo>
+
+#include "CSV/Gzip.h"
+#include "CSV/Player.h"
+#include "IO/Manager.h"
+#include "SIMD/SIMD.h"
+#include "UI/Dashboard.h"
+#include "JSON/FrameBuilder.h"
+#include "Misc/Utilities.h"
+#include "Misc/WorkerPool.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Number of row offsets sent to the reference by the indexing job at a time
+ */
+static constexpr qsizetype kIndexBatchSize = 64 * 1024;
+
+/**
+ * Newest version of the session file format that can be read
+ */
+static constexpr quint32 kMaxFormatVersion = 2;
+
+/**
+ * Size of the header of a compressed block of a session file
+ */
+static constexpr qint64 kBlockHeaderSize = 32;
+
+/**
+ * Reference trigger time that has not been searched for yet
+ */
+static constexpr qint64 kUnknownTime = std::numeric_limits<qint64>::min();
+
+/**
+ * Reference trigger time of a reference without any trigger event
+ */
+static constexpr qint64 kNoTrigger = std::numeric_limits<qint64>::max();
+
+/**
+ * Reads a string stored as a byte count followed by its UTF-8 data.
+ */
+static QString readString(QDataStream &stream)
+{
+  quint32 size = 0;
+  stream >> size;
+  if (stream.status() != QDataStream::Ok
+      || size > stream.device()->bytesAvailable())
+  {
+    stream.setStatus(QDataStream::ReadCorruptData);
+    return QString();
+  }
+
+  QByteArray utf8(static_cast<qsizetype>(size), Qt::Uninitialized);
+  stream.readRawData(utf8.data(), static_cast<int>(size));
+  return QString::fromUtf8(utf8);
+}
+
+/**
+ * Reads the given four or eight character @a magic, returns @c false if the
+ * stream contains something else.
+ */
+static bool readMagic(QDataStream &stream, const char *magic)
+{
+  char buffer[8];
+  const auto size = static_cast<int>(qstrlen(magic));
+  return stream.readRawData(buffer, size) == size
+         && std::memcmp(buffer, magic, static_cast<size_t>(size)) == 0;
+}
+
+/**
+ * Returns the position of the line feed that terminates the line starting at
+ * @a offset, or @a size if the line is the last line of the file.
+ */
+static qint64 findLineEnd(const char *data, const qint64 size,
+                          const qint64 offset)
+{
+  const auto *end = static_cast<const char *>(
+      std::memchr(data + offset, '\n', static_cast<size_t>(size - offset)));
+  return end ? end - data : size;
+}
+
+/**
+ * Returns the end of the first cell of the line between @a offset & @a end.
+ */
+static qint64 findCellEnd(const char *data, const qint64 offset,
+                          const qint64 end)
+{
+  const auto *comma = static_cast<const char *>(
+      std::memchr(data + offset, ',', static_cast<size_t>(end - offset)));
+  return comma ? comma - data : end;
+}
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, restores the alignment & tolerance settings.
+ */
+CSV::Reference::Reference()
+  : m_format(Format::Csv)
+  , m_data(nullptr)
+  , m_dataSize(0)
+  , m_cachedBlock(-1)
+  , m_cachedRow(-1)
+  , m_generation(0)
+  , m_aligned(false)
+  , m_triggerAlignment(false)
+  , m_liveOrigin(0)
+  , m_referenceOrigin(0)
+  , m_triggerIndex(-1)
+  , m_referenceTrigger(kUnknownTime)
+  , m_tolerance(0)
+  , m_changed(false)
+  , m_deviations(0)
+{
+  m_triggerAlignment = m_settings.value("reference_trigger", false).toBool();
+  m_tolerance = qMax(0.0, m_settings.value("reference_tolerance", 0).toReal());
+}
+
+/**
+ * Unmaps the reference file & stops the indexing job.
+ */
+CSV::Reference::~Reference()
+{
+  closeFile();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+CSV::Reference &CSV::Reference::instance()
+{
+  static Reference singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// Member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Returns @c true if a reference file is open.
+ */
+bool CSV::Reference::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * Returns @c true if the reference time is aligned with the live data, i.e.
+ * if the reference is being streamed.
+ */
+bool CSV::Reference::aligned() const
+{
+  return m_aligned;
+}
+
+/**
+ * Returns the name of the reference file, or an empty string if no reference
+ * file is open.
+ */
+QString CSV::Reference::fileName() const
+{
+  if (!isOpen())
+    return QString();
+
+  return QFileInfo(m_filePath).fileName();
+}
+
+/**
+ * Returns @c true if the reference is aligned with the plot trigger instead
+ * of the start of the session.
+ */
+bool CSV::Reference::triggerAlignment() const
+{
+  return m_triggerAlignment;
+}
+
+/**
+ * Returns the largest difference between a live value & its reference value
+ * that does not raise a deviation alarm, 0 disables the alarms.
+ */
+qreal CSV::Reference::tolerance() const
+{
+  return m_tolerance;
+}
+
+/**
+ * Returns the number of datasets that deviate from the reference.
+ */
+int CSV::Reference::deviations() const
+{
+  return m_deviations;
+}
+
+/**
+ * Returns @c true if the dataset with the given frame @a index deviates from
+ * the reference by more than the tolerance.
+ */
+bool CSV::Reference::deviating(const int index) const
+{
+  const auto channel = m_channelLookup.value(index, -1);
+  if (channel < 0)
+    return false;
+
+  return m_deviating[channel];
+}
+
+/**
+ * @brief Returns the reference value of a dataset at a live timestamp.
+ *
+ * @param index The frame index of the dataset.
+ * @param time The acquisition time of the live sample (session clock).
+ * @param ok Set to @c true if the reference covers the dataset at @a time.
+ * @return The reference value, or 0 if @a ok is @c false.
+ */
+qreal CSV::Reference::value(const int index, const qint64 time, bool *ok)
+{
+  *ok = false;
+  if (!m_aligned)
+    return 0;
+
+  const auto column = m_columnLookup.value(index, -1);
+  if (column < 0)
+    return 0;
+
+  const auto row = rowAtTime(m_referenceOrigin + time - m_liveOrigin);
+  if (row < 0 || !loadRow(row))
+    return 0;
+
+  const auto value = m_rowValues[column];
+  *ok = !qIsNaN(value);
+  return *ok ? value : 0;
+}
+
+//------------------------------------------------------------------------------
+// Public slots
+//------------------------------------------------------------------------------
+
+/**
+ * Waits for the next frame (or the next trigger event) to align the
+ * reference with the live data again, & clears the deviation alarms.
+ */
+void CSV::Reference::realign()
+{
+  m_trigger.reset();
+  m_deviating.fill(0);
+  if (m_deviations > 0)
+  {
+    m_deviations = 0;
+    m_changed = true;
+  }
+
+  if (m_aligned)
+  {
+    m_aligned = false;
+    Q_EMIT alignedChanged();
+  }
+}
+
+/**
+ * Lets the user select a reference file
+ */
+void CSV::Reference::openFile()
+{
+  auto file = QFileDialog::getOpenFileName(
+      nullptr, tr("Select reference file"),
+      CSV::Player::instance().csvFilesPath(),
+      tr("Recorded sessions")
+          + QStringLiteral(" (*.csv *.csv.gz *.ssb)"));
+
+  if (!file.isEmpty())
+    openFile(file);
+}
+
+/**
+ * Stops the indexing job, unmaps the reference file & clears the deviation
+ * alarms.
+ */
+void CSV::Reference::closeFile()
+{
+  // Stop the indexing job
+  if (m_indexJob)
+  {
+    m_indexJob->cancelled = true;
+    m_indexJob.reset();
+  }
+
+  // Unmap & close the file
+  const bool wasOpen = isOpen();
+  if (m_data)
+    m_file.unmap(m_data);
+
+  m_data = nullptr;
+  m_dataSize = 0;
+  m_file.close();
+  m_filePath.clear();
+  m_decompressedFile.reset();
+
+  // Reset the index & cached data
+  m_columns.clear();
+  m_numeric.clear();
+  m_rowOffsets.clear();
+  m_rowOffsets.squeeze();
+  m_rowTimes.clear();
+  m_rowTimes.squeeze();
+  m_blocks.clear();
+  m_cachedBlock = -1;
+  m_blockTimes.clear();
+  m_blockValues.clear();
+  m_cachedRow = -1;
+  m_rowValid.clear();
+  m_rowValues.clear();
+
+  // Forget the datasets & the alignment
+  realign();
+  m_generation = 0;
+  m_columnLookup.clear();
+  m_channelLookup.clear();
+  m_channelColumns.clear();
+  m_channelSources.clear();
+  m_referenceTrigger = kUnknownTime;
+
+  if (wasOpen)
+    Q_EMIT openChanged();
+}
+
+/**
+ * Receives the frames of the frame builder & realigns the reference when a
+ * device is connected, when a CSV file is opened or when the plot trigger
+ * changes.
+ */
+void CSV::Reference::setupExternalConnections()
+{
+  // clang-format off
+  connect(&CSV::Player::instance(), &CSV::Player::openChanged, this, &CSV::Reference::realign);
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this, &CSV::Reference::realign);
+  connect(&UI::Dashboard::instance(), &UI::Dashboard::triggerChanged, this, &CSV::Reference::configureTrigger);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged, this, &CSV::Reference::processFrame, Qt::QueuedConnection);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi, this, &CSV::Reference::notifyChanges);
+  // clang-format on
+
+  configureTrigger();
+}
+
+/**
+ * @brief Opens the given reference file.
+ *
+ * Files with the @c .ssb extension are read as session files, any other file
+ * is read as a CSV file. Files with the @c .gz extension are decompressed into
+ * a temporary file first, which is mapped instead of the original file.
+ */
+void CSV::Reference::openFile(const QString &filePath)
+{
+  // File name empty, abort
+  if (filePath.isEmpty())
+    return;
+
+  // Close previous file
+  closeFile();
+
+  // Decompress gzip files
+  auto path = filePath;
+  if (filePath.endsWith(QStringLiteral(".gz"), Qt::CaseInsensitive))
+  {
+    QFile compressed(filePath);
+    m_decompressedFile = std::make_unique<QTemporaryFile>();
+    if (!compressed.open(QIODevice::ReadOnly) || !m_decompressedFile->open()
+        || !CSV::Gzip::decompress(compressed, *m_decompressedFile)
+        || !m_decompressedFile->flush())
+    {
+      Misc::Utilities::showMessageBox(
+          tr("Cannot read reference file"),
+          tr("The compressed file is damaged or was not created by %1")
+              .arg(qAppName()));
+      closeFile();
+      return;
+    }
+
+    path = m_decompressedFile->fileName();
+  }
+
+  // Open & map the file
+  m_file.setFileName(path);
+  if (m_file.open(QIODevice::ReadOnly) && m_file.size() > 0)
+  {
+    m_dataSize = m_file.size();
+    m_data = m_file.map(0, m_dataSize);
+  }
+
+  if (!m_data)
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Cannot read reference file"),
+        tr("Please check file permissions & location"));
+    closeFile();
+    return;
+  }
+
+  // Read the columns & the index of the file
+  m_format = filePath.endsWith(QStringLiteral(".ssb"), Qt::CaseInsensitive)
+                 ? Format::Binary
+                 : Format::Csv;
+  const bool ok = m_format == Format::Binary ? openBinary() : openCsv();
+  if (!ok)
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Cannot read reference file"),
+        tr("The file is damaged or was not recorded by %1").arg(qAppName()));
+    closeFile();
+    return;
+  }
+
+  // Allocate the values of a row
+  m_rowValid.fill(false, m_columns.count());
+  m_rowValues.fill(qQNaN(), m_columns.count());
+
+  m_filePath = filePath;
+  Q_EMIT openChanged();
+}
+
+/**
+ * Changes the tolerance of the deviation alarms, 0 disables the alarms.
+ */
+void CSV::Reference::setTolerance(const qreal tolerance)
+{
+  const auto value = qMax(0.0, tolerance);
+  if (!qFuzzyCompare(m_tolerance, value))
+  {
+    m_tolerance = value;
+    m_tolerances.fill(m_tolerance > 0 ? m_tolerance : qInf());
+    m_settings.setValue("reference_tolerance", value);
+    Q_EMIT settingsChanged();
+  }
+}
+
+/**
+ * Aligns the reference with the plot trigger (@c true) or with the start of
+ * the session (@c false), the reference is realigned with the next frame.
+ */
+void CSV::Reference::setTriggerAlignment(const bool enabled)
+{
+  if (m_triggerAlignment != enabled)
+  {
+    m_triggerAlignment = enabled;
+    m_settings.setValue("reference_trigger", enabled);
+    realign();
+    Q_EMIT settingsChanged();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Deviation alarms
+//------------------------------------------------------------------------------
+
+/**
+ * Emits @c deviationsChanged() if any deviation alarm changed since the last
+ * UI refresh tick.
+ */
+void CSV::Reference::notifyChanges()
+{
+  if (m_changed)
+  {
+    m_changed = false;
+    Q_EMIT deviationsChanged();
+  }
+}
+
+/**
+ * @brief Compares the values of the given @a frame with the reference.
+ *
+ * The reference is aligned with the first suitable frame, afterwards the
+ * absolute differences between the live & reference values of all datasets
+ * are compared against the tolerance at once. Datasets that the reference
+ * does not cover at the time of the frame never deviate.
+ */
+void CSV::Reference::processFrame(const JSON::Frame &frame)
+{
+  // Validate frame & match the datasets when the structure changes
+  if (!isOpen() || !frame.isValid())
+    return;
+
+  if (frame.generation() != m_generation)
+  {
+    mapColumns(frame);
+    m_generation = frame.generation();
+  }
+
+  // Nothing to compare
+  const auto channels = m_channelSources.count();
+  if (channels == 0)
+    return;
+
+  // Align the reference with the live data
+  const auto time = frame.timestamp() > 0 ? frame.timestamp()
+                                          : Misc::SessionClock::now();
+  if (!m_aligned && !align(frame, time))
+    return;
+
+  // Obtain the reference row at the time of the frame
+  const auto row = rowAtTime(m_referenceOrigin + time - m_liveOrigin);
+  const bool covered = row >= 0 && loadRow(row);
+
+  // Calculate the differences, NaN values never reach the tolerance
+  const auto &groups = frame.groups();
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    const auto &source = m_channelSources[c];
+    const auto &dataset = groups[source.first].datasets()[source.second];
+    const auto live = dataset.isNumeric() ? dataset.numericValue() : qQNaN();
+    const auto reference
+        = covered ? m_rowValues[m_channelColumns[c]] : qQNaN();
+    m_errors[c] = qAbs(live - reference);
+  }
+
+  // Compare all the differences against the tolerance
+  SIMD::compareGreaterEqual(m_errors.constData(), m_tolerances.constData(),
+                            m_exceeded.data(), channels);
+
+  // Update the alarms that changed
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    if (m_exceeded[c] != m_deviating[c])
+    {
+      m_deviating[c] = m_exceeded[c];
+      m_deviations += m_deviating[c] ? 1 : -1;
+      m_changed = true;
+    }
+  }
+
+  // Leave the low-power idle state, so that alarms are shown immediately
+  if (m_changed)
+    Misc::TimerEvents::instance().wake();
+}
+
+//------------------------------------------------------------------------------
+// Reference file reading
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reads the header of a CSV file & starts indexing its rows.
+ *
+ * The first cell of each row must contain the reception date/time of the
+ * frame, like the files written by @c CSV::Export. The rows are indexed by a
+ * background job, the reference is aligned once the first rows are indexed.
+ *
+ * @return @c true if the file contains a valid header.
+ */
+bool CSV::Reference::openCsv()
+{
+  // Skip the UTF-8 byte order mark
+  qint64 offset = 0;
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  if (m_dataSize >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+    offset = 3;
+
+  // Obtain the header, without the line terminator
+  auto end = findLineEnd(data, m_dataSize, offset);
+  const auto next = end + 1;
+  if (end > offset && data[end - 1] == '\r')
+    --end;
+
+  // Register the dataset columns, the first column is the timestamp
+  auto headers = QString::fromUtf8(data + offset, end - offset).split(',');
+  if (headers.count() < 2 || next >= m_dataSize)
+    return false;
+
+  headers.removeFirst();
+  for (auto &header : headers)
+  {
+    header.remove(QStringLiteral("\""));
+    m_columns.append(header.simplified());
+    m_numeric.append(1);
+  }
+
+  // Create the indexing job
+  auto job = std::make_shared<IndexJob>();
+  job->path = m_file.fileName();
+  job->size = m_dataSize;
+  job->offset = next;
+  job->cancelled = false;
+  m_indexJob = job;
+
+  // Register the offset & time of each non-empty row in the worker pool
+  auto *reference = this;
+  Misc::WorkerPool::instance().start([job, reference] {
+    QVector<qint64> offsets;
+    QVector<qint64> times;
+    const auto publish = [&](const bool finished) {
+      QMetaObject::invokeMethod(
+          reference,
+          [=] { reference->onRowsIndexed(job, offsets, times, finished); },
+          Qt::QueuedConnection);
+      offsets.clear();
+      times.clear();
+    };
+
+    // Map the file
+    QFile file(job->path);
+    uchar *map = nullptr;
+    if (file.open(QIODevice::ReadOnly))
+      map = file.map(0, job->size);
+
+    // Rows with an invalid date/time take the time of the previous row
+    if (map)
+    {
+      qint64 time = 0;
+      auto offset = job->offset;
+      const auto *data = reinterpret_cast<const char *>(map);
+      while (!job->cancelled && offset < job->size)
+      {
+        const auto end = findLineEnd(data, job->size, offset);
+        if (end > offset + 1 || (end > offset && data[offset] != '\r'))
+        {
+          bool ok = false;
+          const auto cell = findCellEnd(data, offset, end);
+          const auto msecs
+              = CSV::Player::parseDateTime(data + offset, data + cell, &ok);
+          if (ok)
+            time = msecs * 1000000;
+
+          offsets.append(offset);
+          times.append(time);
+          if (offsets.count() >= kIndexBatchSize)
+            publish(false);
+        }
+
+        offset = end + 1;
+      }
+
+      file.unmap(map);
+    }
+
+    publish(true);
+  });
+
+  return true;
+}
+
+/**
+ * @brief Reads the header & the footer index of a session file written by
+ *        @c CSV::BinaryExport.
+ *
+ * @return @c true if the file is a complete session file with at least one
+ *         block.
+ */
+bool CSV::Reference::openBinary()
+{
+  // Validate the trailer
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  if (m_dataSize < 24 || std::memcmp(data + m_dataSize - 8, "SSBINEND", 8))
+    return false;
+
+  // Configure the data stream
+  const auto bytes = QByteArray::fromRawData(data, m_dataSize);
+  QDataStream stream(bytes);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+  // Read the header
+  quint32 version = 0;
+  quint32 columns = 0;
+  if (!readMagic(stream, "SSBINARY"))
+    return false;
+
+  stream >> version;
+  (void)readString(stream);
+  stream >> columns;
+  if (version == 0 || version > kMaxFormatVersion)
+    return false;
+
+  // Read the column names & types
+  for (quint32 i = 0; i < columns && stream.status() == QDataStream::Ok; ++i)
+  {
+    quint8 type = 0;
+    qint32 index = 0;
+    stream >> type >> index;
+    m_columns.append(readString(stream));
+    m_numeric.append(type == 0 ? 1 : 0);
+  }
+
+  // Locate the footer index
+  qint64 footer = 0;
+  stream.device()->seek(m_dataSize - 16);
+  stream >> footer;
+  if (footer <= 0 || footer >= m_dataSize - 16)
+    return false;
+
+  // Read the location & time range of each block
+  quint32 count = 0;
+  stream.device()->seek(footer);
+  if (!readMagic(stream, "SSIX"))
+    return false;
+
+  stream >> count;
+  qint64 rows = 0;
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+  {
+    Block block;
+    stream >> block.offset >> block.rows;
+    stream >> block.firstTime >> block.lastTime;
+    block.firstRow = rows;
+    rows += block.rows;
+    if (block.offset < 0 || block.offset + kBlockHeaderSize > footer)
+      return false;
+
+    m_blocks.append(block);
+  }
+
+  return stream.status() == QDataStream::Ok && !m_blocks.isEmpty()
+         && rows > 0;
+}
+
+/**
+ * Registers the rows found by the indexing job, results from a job that
+ * belongs to a previous file are discarded.
+ */
+void CSV::Reference::onRowsIndexed(const std::shared_ptr<IndexJob> &job,
+                                   const QVector<qint64> &offsets,
+                                   const QVector<qint64> &times,
+                                   const bool finished)
+{
+  if (job != m_indexJob)
+    return;
+
+  m_rowOffsets.append(offsets);
+  m_rowTimes.append(times);
+  if (!finished)
+    return;
+
+  m_indexJob.reset();
+  if (m_rowOffsets.isEmpty())
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Insufficient Data in Reference File"),
+        tr("The reference file does not contain any frame."));
+    closeFile();
+  }
+}
+
+/**
+ * Matches the numeric reference columns with the datasets of the given
+ * @a frame by their "group/dataset" titles, datasets that share a frame index
+ * are only compared once.
+ */
+void CSV::Reference::mapColumns(const JSON::Frame &frame)
+{
+  realign();
+  m_columnLookup.clear();
+  m_channelLookup.clear();
+  m_channelColumns.clear();
+  m_channelSources.clear();
+
+  // Find each column by its title
+  QHash<QString, int> columns;
+  for (int c = 0; c < m_columns.count(); ++c)
+  {
+    if (m_numeric[c])
+      columns.insert(m_columns[c], c);
+  }
+
+  // Register the datasets with a reference column
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &group = groups[g];
+    const auto &datasets = group.datasets();
+    for (int d = 0; d < datasets.count(); ++d)
+    {
+      const auto index = datasets[d].index();
+      if (m_columnLookup.contains(index))
+        continue;
+
+      const auto title
+          = QStringLiteral("%1/%2").arg(group.title(), datasets[d].title());
+      const auto column = columns.value(title.simplified(), -1);
+      if (column < 0)
+        continue;
+
+      m_columnLookup.insert(index, column);
+      m_channelLookup.insert(index, m_channelSources.count());
+      m_channelColumns.append(column);
+      m_channelSources.append(qMakePair(g, d));
+    }
+  }
+
+  // Allocate the state of each dataset
+  const auto channels = m_channelSources.count();
+  m_errors.fill(0, channels);
+  m_tolerances.fill(m_tolerance > 0 ? m_tolerance : qInf(), channels);
+  m_exceeded.fill(0, channels);
+  m_deviating.fill(0, channels);
+}
+
+/**
+ * Applies the edge & level of the dashboard plot trigger, the reference
+ * trigger event is searched again & the reference is realigned if it follows
+ * the trigger.
+ */
+void CSV::Reference::configureTrigger()
+{
+  const auto &dashboard = UI::Dashboard::instance();
+  m_trigger.configure(dashboard.triggerEdge(), dashboard.triggerLevel(), 0, 1);
+  m_referenceTrigger = kUnknownTime;
+  if (m_triggerAlignment)
+    realign();
+}
+
+/**
+ * @brief Aligns the reference with the live data.
+ *
+ * - Start alignment matches the given @a frame with the first reference row.
+ * - Trigger alignment feeds the trigger source of the dashboard to the
+ *   trigger, & matches the first live trigger event with the first trigger
+ *   event of the reference. The reference must be completely indexed & have
+ *   a column for the trigger source.
+ *
+ * @return @c true if the reference is now aligned.
+ */
+bool CSV::Reference::align(const JSON::Frame &frame, const qint64 time)
+{
+  if (rowCount() == 0)
+    return false;
+
+  // Match the frame with the start of the reference
+  if (!m_triggerAlignment)
+    m_referenceOrigin = rowTime(0);
+
+  // Match the live trigger event with the reference trigger event
+  else
+  {
+    // Obtain the dataset of the trigger source
+    const auto &dashboard = UI::Dashboard::instance();
+    const auto source = dashboard.triggerSource();
+    if (source >= dashboard.widgetCount(SerialStudio::DashboardPlot))
+      return false;
+
+    const auto index
+        = dashboard.getDatasetWidget(SerialStudio::DashboardPlot, source)
+              .index();
+    if (index != m_triggerIndex)
+    {
+      m_trigger.reset();
+      m_triggerIndex = index;
+      m_referenceTrigger = kUnknownTime;
+    }
+
+    // Find the trigger event of the reference
+    const auto channel = m_channelLookup.value(index, -1);
+    if (channel < 0 || m_indexJob)
+      return false;
+
+    if (m_referenceTrigger == kUnknownTime)
+      m_referenceTrigger = findTrigger(m_channelColumns[channel]);
+
+    if (m_referenceTrigger == kNoTrigger)
+      return false;
+
+    // Wait for the live trigger event
+    const auto &sources = m_channelSources[channel];
+    const auto &dataset
+        = frame.groups()[sources.first].datasets()[sources.second];
+    if (!m_trigger.process(dataset.numericValue()))
+      return false;
+
+    m_referenceOrigin = m_referenceTrigger;
+  }
+
+  m_aligned = true;
+  m_liveOrigin = time;
+  Q_EMIT alignedChanged();
+  return true;
+}
+
+/**
+ * Returns the number of rows of the reference file that have been indexed.
+ */
+qint64 CSV::Reference::rowCount() const
+{
+  if (m_format == Format::Csv)
+    return m_rowOffsets.count();
+
+  if (m_blocks.isEmpty())
+    return 0;
+
+  return m_blocks.last().firstRow + m_blocks.last().rows;
+}
+
+/**
+ * Returns the time of the given @a row in nanoseconds, or 0 if the row
+ * cannot be read.
+ */
+qint64 CSV::Reference::rowTime(const qint64 row)
+{
+  if (row < 0 || row >= rowCount())
+    return 0;
+
+  if (m_format == Format::Csv)
+    return m_rowTimes[row];
+
+  const auto block = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(), row,
+                                      [](const qint64 r, const Block &b) {
+                                        return r < b.firstRow;
+                                      })
+                     - m_blocks.cbegin() - 1;
+  if (!loadBlock(int(block)))
+    return 0;
+
+  return m_blockTimes[row - m_blocks[block].firstRow];
+}
+
+/**
+ * Returns the last row whose time is not after the given reference @a time,
+ * or -1 if @a time is before the first row or after the last row.
+ */
+qint64 CSV::Reference::rowAtTime(const qint64 time)
+{
+  // Search the row index of CSV files
+  if (m_format == Format::Csv)
+  {
+    if (m_rowTimes.isEmpty() || time < m_rowTimes.first()
+        || (!m_indexJob && time > m_rowTimes.last()))
+      return -1;
+
+    const auto it
+        = std::upper_bound(m_rowTimes.cbegin(), m_rowTimes.cend(), time);
+    return it - m_rowTimes.cbegin() - 1;
+  }
+
+  // Find the block that contains the time
+  if (m_blocks.isEmpty() || time < m_blocks.first().firstTime
+      || time > m_blocks.last().lastTime)
+    return -1;
+
+  const auto block = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(),
+                                      time,
+                                      [](const qint64 t, const Block &b) {
+                                        return t < b.firstTime;
+                                      })
+                     - m_blocks.cbegin() - 1;
+
+  // Search the timestamps of the block
+  if (!loadBlock(int(block)))
+    return -1;
+
+  const auto it
+      = std::upper_bound(m_blockTimes.cbegin(), m_blockTimes.cend(), time);
+  const auto first = m_blocks[block].firstRow;
+  return first + qMax<qint64>(0, it - m_blockTimes.cbegin() - 1);
+}
+
+/**
+ * Returns the time of the first row in which the given reference @a column
+ * triggers the plot trigger, or @c kNoTrigger if it never does.
+ */
+qint64 CSV::Reference::findTrigger(const int column)
+{
+  const auto &dashboard = UI::Dashboard::instance();
+
+  UI::PlotTrigger trigger;
+  trigger.configure(dashboard.triggerEdge(), dashboard.triggerLevel(), 0, 1);
+  for (qint64 row = 0; row < rowCount() && loadRow(row); ++row)
+  {
+    const auto value = m_rowValues[column];
+    if (!qIsNaN(value) && trigger.process(value))
+      return rowTime(row);
+  }
+
+  return kNoTrigger;
+}
+
+/**
+ * Reads the values of the given @a row into the row cache, cells that are
+ * empty or that do not contain numbers are read as NaN.
+ */
+bool CSV::Reference::loadRow(const qint64 row)
+{
+  if (row == m_cachedRow)
+    return true;
+
+  if (row < 0 || row >= rowCount())
+    return false;
+
+  // Copy the values of the row from its decompressed block
+  const auto columns = m_columns.count();
+  if (m_format == Format::Binary)
+  {
+    const auto block = std::upper_bound(m_blocks.cbegin(), m_blocks.cend(),
+                                        row,
+                                        [](const qint64 r, const Block &b) {
+                                          return r < b.firstRow;
+                                        })
+                       - m_blocks.cbegin() - 1;
+    if (!loadBlock(int(block)))
+      return false;
+
+    const auto rows = m_blocks[block].rows;
+    const auto offset = row - m_blocks[block].firstRow;
+    for (qsizetype c = 0; c < columns; ++c)
+      m_rowValues[c] = m_blockValues[c * rows + offset];
+
+    m_cachedRow = row;
+    return true;
+  }
+
+  // Obtain the line, without the line terminator
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  const auto offset = m_rowOffsets[row];
+  auto end = findLineEnd(data, m_dataSize, offset);
+  if (end > offset && data[end - 1] == '\r')
+    --end;
+
+  // Parse the cells after the timestamp
+  qsizetype count = 0;
+  const auto cell = findCellEnd(data, offset, end);
+  if (cell < end)
+    count = SIMD::parseNumbers(data + cell + 1, end - cell - 1, ',',
+                               m_rowValues.data(), m_rowValid.data(), nullptr,
+                               columns);
+
+  for (qsizetype c = 0; c < columns; ++c)
+  {
+    if (c >= count || !m_rowValid[c])
+      m_rowValues[c] = qQNaN();
+  }
+
+  m_cachedRow = row;
+  return true;
+}
+
+/**
+ * @brief Decompresses the given @a block of a session file into the block
+ *        cache.
+ *
+ * Only the timestamps & the numeric columns are kept, string columns are
+ * skipped & read as NaN.
+ */
+bool CSV::Reference::loadBlock(const int block)
+{
+  if (block == m_cachedBlock)
+    return true;
+
+  if (block < 0 || block >= m_blocks.count())
+    return false;
+
+  // Read the block header
+  const auto &info = m_blocks[block];
+  const auto *data = reinterpret_cast<const char *>(m_data);
+  const auto header = QByteArray::fromRawData(data + info.offset,
+                                              kBlockHeaderSize);
+  QDataStream stream(header);
+  stream.setByteOrder(QDataStream::LittleEndian);
+
+  quint32 rows = 0;
+  qint64 firstTime = 0;
+  qint64 lastTime = 0;
+  quint32 payloadSize = 0;
+  quint32 compressedSize = 0;
+  if (!readMagic(stream, "SSBK"))
+    return false;
+
+  stream >> rows >> firstTime >> lastTime >> payloadSize >> compressedSize;
+  if (rows != info.rows
+      || info.offset + kBlockHeaderSize + compressedSize > m_dataSize)
+    return false;
+
+  // Restore the size prefix of qCompress() & decompress the payload
+  QByteArray compressed(4, Qt::Uninitialized);
+  qToBigEndian<quint32>(payloadSize, compressed.data());
+  compressed.append(data + info.offset + kBlockHeaderSize,
+                    static_cast<qsizetype>(compressedSize));
+  const auto payload = qUncompress(compressed);
+  if (payload.size() != static_cast<qsizetype>(payloadSize))
+    return false;
+
+  // Read the timestamps & the numeric columns
+  QDataStream values(payload);
+  values.setByteOrder(QDataStream::LittleEndian);
+  values.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+  m_blockTimes.resize(rows);
+  for (quint32 r = 0; r < rows; ++r)
+    values >> m_blockTimes[r];
+
+  const auto columns = m_columns.count();
+  m_blockValues.fill(qQNaN(), columns * rows);
+  for (qsizetype c = 0; c < columns; ++c)
+  {
+    auto *column = m_blockValues.data() + c * rows;
+    for (quint32 r = 0; r < rows; ++r)
+    {
+      if (m_numeric[c])
+        values >> column[r];
+      else
+        (void)readString(values);
+    }
+  }
+
+  if (values.status() != QDataStream::Ok)
+  {
+    m_cachedBlock = -1;
+    return false;
+  }
+
+  m_cachedRow = -1;
+  m_cachedBlock = block;
+  return true;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include <QSettings>
+#include <QTemporaryFile>
+
+#include "JSON/Frame.h"
+#include "UI/PlotTrigger.h"
+
+namespace CSV
+{
+/**
+ * @brief The Reference class
+ *
+ * Overlays a recorded session (the "golden" run) on the live data, so that
+ * a live run can be compared against it while it is acquired. The reference
+ * can be a CSV file written by @c CSV::Export (optionally compressed) or a
+ * session file written by @c CSV::BinaryExport.
+ *
+ * The file is memory-mapped & never loaded into memory as a whole:
+ * - CSV files are indexed by a background job that stores the offset & the
+ *   timestamp of each row, rows are only parsed when they are needed.
+ * - Session files already contain a block index in their footer, only the
+ *   block that contains the current reference time is decompressed.
+ *
+ * The reference time advances with the acquisition time of the live frames.
+ * It is aligned either with the start of the session (the first live frame
+ * is matched with the first reference row) or with the plot trigger of the
+ * dashboard (the first live trigger event is matched with the first trigger
+ * event of the reference), after which the reference streams in step with
+ * the live frames.
+ *
+ * Reference columns are matched with the datasets of the live frames by their
+ * "group/dataset" titles. For each frame, the difference between the live &
+ * reference values is compared against the tolerance on the ingestion path,
+ * datasets whose difference reaches the tolerance raise a derived alarm that
+ * is reported by @c Misc::AlarmEngine next to the level alarms.
+ */
+class Reference : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool isOpen
+             READ isOpen
+             NOTIFY openChanged)
+  Q_PROPERTY(bool aligned
+             READ aligned
+             NOTIFY alignedChanged)
+  Q_PROPERTY(QString fileName
+             READ fileName
+             NOTIFY openChanged)
+  Q_PROPERTY(bool triggerAlignment
+             READ triggerAlignment
+             WRITE setTriggerAlignment
+             NOTIFY settingsChanged)
+  Q_PROPERTY(qreal tolerance
+             READ tolerance
+             WRITE setTolerance
+             NOTIFY settingsChanged)
+  Q_PROPERTY(int deviations
+             READ deviations
+             NOTIFY deviationsChanged)
+  // clang-format on
+
+signals:
+  void openChanged();
+  void alignedChanged();
+  void settingsChanged();
+  void deviationsChanged();
+
+private:
+  explicit Reference();
+  Reference(Reference &&) = delete;
+  Reference(const Reference &) = delete;
+  Reference &operator=(Reference &&) = delete;
+  Reference &operator=(const Reference &) = delete;
+
+  ~Reference();
+
+public:
+  static Reference &instance();
+
+  [[nodiscard]] bool isOpen() const;
+  [[nodiscard]] bool aligned() const;
+  [[nodiscard]] QString fileName() const;
+  [[nodiscard]] bool triggerAlignment() const;
+  [[nodiscard]] qreal tolerance() const;
+  [[nodiscard]] int deviations() const;
+
+  [[nodiscard]] bool deviating(const int index) const;
+  [[nodiscard]] qreal value(const int index, const qint64 time, bool *ok);
+
+public slots:
+  void realign();
+  void openFile();
+  void closeFile();
+  void setupExternalConnections();
+  void openFile(const QString &filePath);
+  void setTolerance(const qreal tolerance);
+  void setTriggerAlignment(const bool enabled);
+
+private slots:
+  void notifyChanges();
+  void processFrame(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Background job that indexes the rows of a CSV file.
+   */
+  struct IndexJob
+  {
+    QString path;
+    qint64 size;
+    qint64 offset;
+    std::atomic_bool cancelled;
+  };
+
+  /**
+   * @brief Location & time range of a compressed block of a session file.
+   */
+  struct Block
+  {
+    qint64 offset;
+    qint64 firstRow;
+    quint32 rows;
+    qint64 firstTime;
+    qint64 lastTime;
+  };
+
+  enum class Format
+  {
+    Csv,
+    Binary
+  };
+
+  bool openCsv();
+  bool openBinary();
+  void onRowsIndexed(const std::shared_ptr<IndexJob> &job,
+                     const QVector<qint64> &offsets,
+                     const QVector<qint64> &times, const bool finished);
+
+  void mapColumns(const JSON::Frame &frame);
+  void configureTrigger();
+  bool align(const JSON::Frame &frame, const qint64 time);
+
+  [[nodiscard]] qint64 rowCount() const;
+  [[nodiscard]] qint64 rowTime(const qint64 row);
+  [[nodiscard]] qint64 rowAtTime(const qint64 time);
+  [[nodiscard]] qint64 findTrigger(const int column);
+  [[nodiscard]] bool loadRow(const qint64 row);
+  [[nodiscard]] bool loadBlock(const int block);
+
+private:
+  Format m_format;
+  QFile m_file;
+  QString m_filePath;
+  std::unique_ptr<QTemporaryFile> m_decompressedFile;
+
+  uchar *m_data;
+  qint64 m_dataSize;
+  QStringList m_columns;
+  QVector<quint8> m_numeric;
+
+  QVector<qint64> m_rowOffsets;
+  QVector<qint64> m_rowTimes;
+  std::shared_ptr<IndexJob> m_indexJob;
+
+  QVector<Block> m_blocks;
+  int m_cachedBlock;
+  QVector<qint64> m_blockTimes;
+  QVector<double> m_blockValues;
+
+  qint64 m_cachedRow;
+  QVector<bool> m_rowValid;
+  QVector<double> m_rowValues;
+
+  quint64 m_generation;
+  QHash<int, int> m_columnLookup;
+  QHash<int, int> m_channelLookup;
+  QVector<int> m_channelColumns;
+  QVector<QPair<int, int>> m_channelSources;
+
+  bool m_aligned;
+  bool m_triggerAlignment;
+  qint64 m_liveOrigin;
+  qint64 m_referenceOrigin;
+  int m_triggerIndex;
+  qint64 m_referenceTrigger;
+  UI::PlotTrigger m_trigger;
+
+  qreal m_tolerance;
+  QSettings m_settings;
+
+  bool m_changed;
+  int m_deviations;
+  QVector<double> m_errors;
+  QVector<double> m_tolerances;
+  QVector<quint8> m_exceeded;
+  QVector<quint8> m_deviating;
+};
+} // namespace CSV
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "TsdbExport.h"
+
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "CSV/Player.h"
+#include "MQTT/Client.h"
+#include "Misc/Translator.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/ThreadScheduler.h"
+#include "JSON/FrameBuilder.h"
+
+/**
+ * Fraction of the frame bus that may be waiting to be sent before the
+ * writer thread is asked to read it ahead of the 1 Hz timer
+ */
+static constexpr std::size_t kEarlyReadDivisor = 4;
+
+/**
+ * Registers a consumer of the frame bus, restores the server settings &
+ * starts the TSDB writer thread.
+ */
+CSV::TsdbExport::TsdbExport()
+  : m_writerBusy(false)
+  , m_exportEnabled(false)
+  , m_queuedBatches(0)
+  , m_queuedBytes(0)
+  , m_frameConsumer(-1)
+{
+  // Restore the server settings
+  m_format = qBound(0, m_settings.value("tsdb_format", 0).toInt(), 1);
+  m_url = m_settings.value("tsdb_url").toString();
+  m_token = m_settings.value("tsdb_token").toString();
+  m_measurement
+      = m_settings.value("tsdb_measurement", "serial_studio").toString();
+
+  // Read frames from the frame bus, losing the oldest ones if sending is slow
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  m_frameConsumer = bus.addConsumer(JSON::FrameBus::Policy::DropOldest);
+  m_writer.setFrameBus(&bus, m_frameConsumer);
+
+  // Encode & send frames in their own thread
+  m_writer.setPath(QStringLiteral("%1/TSDB Queue")
+                       .arg(QStandardPaths::writableLocation(
+                           QStandardPaths::AppLocalDataLocation)));
+  m_writer.moveToThread(&m_writerThread);
+  connect(&m_writer, &CSV::TsdbWriter::framesWritten, this,
+          &CSV::TsdbExport::onFramesWritten, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::TsdbWriter::queueChanged, this,
+          &CSV::TsdbExport::onQueueChanged, Qt::QueuedConnection);
+  connect(&m_writer, &CSV::TsdbWriter::requestFailed, this,
+          &CSV::TsdbExport::onRequestFailed, Qt::QueuedConnection);
+
+  // Queue the remaining frames & stop the writer thread before quitting
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    flush();
+    m_writerThread.quit();
+    if (!m_writerThread.wait(5000))
+      m_writerThread.terminate();
+  });
+
+  // Start the writer thread
+  m_writerThread.setObjectName(QStringLiteral("TSDB Writer"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_writerThread, Misc::ThreadScheduler::Role::Exporter);
+  m_writerThread.start(QThread::LowPriority);
+  updateEndpoint();
+}
+
+/**
+ * Queue the remaining frames & stop the writer before destroying the class
+ */
+CSV::TsdbExport::~TsdbExport()
+{
+  flush();
+  m_writerThread.quit();
+  m_writerThread.wait();
+}
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+CSV::TsdbExport &CSV::TsdbExport::instance()
+{
+  static TsdbExport singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if frames are sent to the time-series database
+ */
+bool CSV::TsdbExport::exportEnabled() const
+{
+  return m_exportEnabled;
+}
+
+/**
+ * Returns the index of the selected server API in the @c formats() list
+ */
+int CSV::TsdbExport::format() const
+{
+  return m_format;
+}
+
+/**
+ * Returns the URL of the write endpoint
+ */
+QString CSV::TsdbExport::url() const
+{
+  return m_url;
+}
+
+/**
+ * Returns the access token sent to the server
+ */
+QString CSV::TsdbExport::token() const
+{
+  return m_token;
+}
+
+/**
+ * Returns the name of the InfluxDB measurement or Prometheus metric
+ */
+QString CSV::TsdbExport::measurement() const
+{
+  return m_measurement;
+}
+
+/**
+ * Returns the number of batches waiting to be sent
+ */
+int CSV::TsdbExport::queuedBatches() const
+{
+  return m_queuedBatches;
+}
+
+/**
+ * Returns the compressed size of the batches waiting to be sent
+ */
+qint64 CSV::TsdbExport::queuedBytes() const
+{
+  return m_queuedBytes;
+}
+
+/**
+ * Returns the last error reported by the server, or an empty string if the
+ * last batch was accepted
+ */
+QString CSV::TsdbExport::lastError() const
+{
+  return m_lastError;
+}
+
+/**
+ * Returns the list of supported server APIs
+ */
+QStringList CSV::TsdbExport::formats() const
+{
+  return {tr("InfluxDB (Line Protocol)"), tr("Prometheus (Remote Write)")};
+}
+
+/**
+ * @brief Encodes the frames waiting in the frame bus & queues the batch.
+ *
+ * This function blocks until the writer thread has queued every frame that
+ * is waiting in the frame bus, so that no values are lost when the device is
+ * disconnected. The export then stops reading the bus until the next frame
+ * that should be sent arrives.
+ */
+void CSV::TsdbExport::flush()
+{
+  const auto type = m_writerThread.isRunning() ? Qt::BlockingQueuedConnection
+                                               : Qt::DirectConnection;
+  QMetaObject::invokeMethod(&m_writer, &CSV::TsdbWriter::flush, type);
+  JSON::FrameBuilder::instance().frameBus().detach(m_frameConsumer);
+}
+
+/**
+ * Configures the signal/slot connections with the rest of the modules of the
+ * application.
+ */
+void CSV::TsdbExport::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &TsdbExport::flush);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
+          this, &TsdbExport::registerFrame);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &TsdbExport::writeValues);
+  connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
+          this, &TsdbExport::languageChanged);
+}
+
+/**
+ * Changes the server API, values waiting to be sent in the previous format
+ * are discarded
+ */
+void CSV::TsdbExport::setFormat(const int format)
+{
+  const auto value = qBound(0, format, 1);
+  if (m_format != value)
+  {
+    m_format = value;
+    m_settings.setValue("tsdb_format", m_format);
+    updateEndpoint();
+  }
+}
+
+/**
+ * Changes the URL of the write endpoint
+ */
+void CSV::TsdbExport::setUrl(const QString &url)
+{
+  const auto value = url.trimmed();
+  if (m_url != value)
+  {
+    m_url = value;
+    m_settings.setValue("tsdb_url", m_url);
+    updateEndpoint();
+  }
+}
+
+/**
+ * Changes the access token sent to the server
+ */
+void CSV::TsdbExport::setToken(const QString &token)
+{
+  const auto value = token.trimmed();
+  if (m_token != value)
+  {
+    m_token = value;
+    m_settings.setValue("tsdb_token", m_token);
+    updateEndpoint();
+  }
+}
+
+/**
+ * Enables or disables sending frames to the time-series database
+ */
+void CSV::TsdbExport::setExportEnabled(const bool enabled)
+{
+  m_exportEnabled = enabled;
+  Q_EMIT enabledChanged();
+
+  if (!exportEnabled())
+    flush();
+}
+
+/**
+ * Changes the name of the InfluxDB measurement or Prometheus metric
+ */
+void CSV::TsdbExport::setMeasurement(const QString &measurement)
+{
+  const auto value = measurement.trimmed();
+  if (m_measurement != value)
+  {
+    m_measurement = value;
+    m_settings.setValue("tsdb_measurement", m_measurement);
+    updateEndpoint();
+  }
+}
+
+/**
+ * Asks the writer thread to encode the frames waiting in the frame bus,
+ * unless it is still busy with the previous ones.
+ */
+void CSV::TsdbExport::writeValues()
+{
+  const auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (m_writerBusy || bus.pending(m_frameConsumer) == 0)
+    return;
+
+  m_writerBusy = true;
+  QMetaObject::invokeMethod(&m_writer, &CSV::TsdbWriter::readFrameBus,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * Sends the server settings to the writer thread
+ */
+void CSV::TsdbExport::updateEndpoint()
+{
+  const auto url = m_url;
+  const auto token = m_token;
+  const auto measurement = m_measurement;
+  const auto format = static_cast<CSV::TsdbWriter::Format>(m_format);
+  QMetaObject::invokeMethod(
+      &m_writer,
+      [=] { m_writer.setEndpoint(format, url, token, measurement); },
+      Qt::QueuedConnection);
+
+  Q_EMIT endpointChanged();
+}
+
+/**
+ * Allows the writer thread to read the next frames
+ */
+void CSV::TsdbExport::onFramesWritten()
+{
+  m_writerBusy = false;
+}
+
+/**
+ * Shows the error reported by the writer thread
+ */
+void CSV::TsdbExport::onRequestFailed(const QString &error)
+{
+  if (m_lastError != error)
+  {
+    m_lastError = error;
+    Q_EMIT lastErrorChanged();
+  }
+}
+
+/**
+ * @brief Starts or stops reading the frame bus when a new frame is published.
+ *
+ * The export reads the bus only while the frames should be sent (i.e. when
+ * receiving data from a connected device or service, and not playing a CSV
+ * file); when that is no longer the case, the frames that are still waiting
+ * are queued.
+ *
+ * If the unsent frames fill a quarter of the bus, the writer thread is asked
+ * to read them without waiting for the 1 Hz timer.
+ */
+void CSV::TsdbExport::registerFrame(const JSON::Frame &frame)
+{
+  Q_UNUSED(frame);
+
+  // Check if the frames should be sent
+  const bool save = exportEnabled() && !m_url.isEmpty()
+                    && !CSV::Player::instance().isOpen()
+                    && (IO::Manager::instance().connected()
+                        || MQTT::Client::instance().isSubscribed());
+
+  // Stop reading the frame bus
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (!save)
+  {
+    if (bus.isAttached(m_frameConsumer))
+      flush();
+
+    return;
+  }
+
+  // Start reading the frame bus, beginning with this frame
+  if (!bus.isAttached(m_frameConsumer))
+    bus.attach(m_frameConsumer);
+
+  // Let the writer thread catch up before the bus is full
+  if (!m_writerBusy
+      && bus.pending(m_frameConsumer) >= bus.capacity() / kEarlyReadDivisor)
+  {
+    m_writerBusy = true;
+    QMetaObject::invokeMethod(&m_writer, &CSV::TsdbWriter::readFrameBus,
+                              Qt::QueuedConnection);
+  }
+}
+
+/**
+ * Updates the queue status shown to the user, and clears the last error once
+ * the queue has been sent
+ */
+void CSV::TsdbExport::onQueueChanged(const int batches, const qint64 bytes)
+{
+  m_queuedBatches = batches;
+  m_queuedBytes = bytes;
+  Q_EMIT queueChanged();
+
+  if (batches == 0 && !m_lastError.isEmpty())
+  {
+    m_lastError.clear();
+    Q_EMIT lastErrorChanged();
+  }
+}
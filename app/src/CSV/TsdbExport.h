@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QThread>
+#include <QObject>
+#include <QSettings>
+
+#include "JSON/Frame.h"
+#include "CSV/TsdbWriter.h"
+
+namespace CSV
+{
+/**
+ * @brief The TsdbExport class
+ *
+ * The TSDB export class sends the received frames to a time-series database,
+ * either to an InfluxDB v2 write endpoint (line protocol) or to a Prometheus
+ * remote-write endpoint (e.g. Prometheus, Mimir or VictoriaMetrics). It works
+ * next to the file exports, all of them can be enabled independently.
+ *
+ * Like the Arrow export, received frames are read from the @c JSON::FrameBus
+ * by the @c CSV::TsdbWriter worker thread each time the @c Misc::TimerEvents
+ * low-frequency timer expires, or earlier if a quarter of the bus is waiting
+ * to be sent. The writer queues its batches on disk, so that the values
+ * received while the server cannot be reached are sent once it is back.
+ */
+class TsdbExport : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool exportEnabled
+             READ exportEnabled
+             WRITE setExportEnabled
+             NOTIFY enabledChanged)
+  Q_PROPERTY(int format
+             READ format
+             WRITE setFormat
+             NOTIFY endpointChanged)
+  Q_PROPERTY(QString url
+             READ url
+             WRITE setUrl
+             NOTIFY endpointChanged)
+  Q_PROPERTY(QString token
+             READ token
+             WRITE setToken
+             NOTIFY endpointChanged)
+  Q_PROPERTY(QString measurement
+             READ measurement
+             WRITE setMeasurement
+             NOTIFY endpointChanged)
+  Q_PROPERTY(int queuedBatches
+             READ queuedBatches
+             NOTIFY queueChanged)
+  Q_PROPERTY(qint64 queuedBytes
+             READ queuedBytes
+             NOTIFY queueChanged)
+  Q_PROPERTY(QString lastError
+             READ lastError
+             NOTIFY lastErrorChanged)
+  Q_PROPERTY(QStringList formats
+             READ formats
+             NOTIFY languageChanged)
+  // clang-format on
+
+signals:
+  void queueChanged();
+  void enabledChanged();
+  void endpointChanged();
+  void languageChanged();
+  void lastErrorChanged();
+
+private:
+  explicit TsdbExport();
+  TsdbExport(TsdbExport &&) = delete;
+  TsdbExport(const TsdbExport &) = delete;
+  TsdbExport &operator=(TsdbExport &&) = delete;
+  TsdbExport &operator=(const TsdbExport &) = delete;
+
+  ~TsdbExport();
+
+public:
+  static TsdbExport &instance();
+
+  [[nodiscard]] bool exportEnabled() const;
+
+  [[nodiscard]] int format() const;
+  [[nodiscard]] QString url() const;
+  [[nodiscard]] QString token() const;
+  [[nodiscard]] QString measurement() const;
+
+  [[nodiscard]] int queuedBatches() const;
+  [[nodiscard]] qint64 queuedBytes() const;
+  [[nodiscard]] QString lastError() const;
+  [[nodiscard]] QStringList formats() const;
+
+public slots:
+  void flush();
+  void setupExternalConnections();
+  void setFormat(const int format);
+  void setUrl(const QString &url);
+  void setToken(const QString &token);
+  void setExportEnabled(const bool enabled);
+  void setMeasurement(const QString &measurement);
+
+private slots:
+  void writeValues();
+  void updateEndpoint();
+  void onFramesWritten();
+  void onRequestFailed(const QString &error);
+  void registerFrame(const JSON::Frame &frame);
+  void onQueueChanged(const int batches, const qint64 bytes);
+
+private:
+  bool m_writerBusy;
+  bool m_exportEnabled;
+
+  int m_format;
+  QString m_url;
+  QString m_token;
+  QString m_measurement;
+
+  int m_queuedBatches;
+  qint64 m_queuedBytes;
+  QString m_lastError;
+  int m_frameConsumer;
+
+  QSettings m_settings;
+  QThread m_writerThread;
+  CSV::TsdbWriter m_writer;
+};
+} // namespace CSV
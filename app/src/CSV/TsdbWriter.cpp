@@ -0,0 +1,824 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "TsdbWriter.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <QFile>
+#include <QTimer>
+#include <QtEndian>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QNetworkAccessManager>
+
+#include "CSV/Gzip.h"
+#include "Misc/Trace.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Delay before the first retry of a failed request, doubled after each
+ * failure & limited to the maximum delay (in milliseconds)
+ */
+static constexpr int kMinRetryDelay = 1000;
+static constexpr int kMaxRetryDelay = 60000;
+
+/**
+ * Number of bits of the hash table used to find repeated sequences by the
+ * snappy compressor, and size of the blocks that it compresses independently
+ */
+static constexpr int kSnappyHashBits = 14;
+static constexpr qsizetype kSnappyBlockSize = 65536;
+
+/**
+ * Approximate size of an encoded Prometheus sample, used to close batches
+ */
+static constexpr qsizetype kSampleSize = 20;
+
+/**
+ * File name suffixes of the queued batches of each format
+ */
+static const QString kInfluxSuffix = QStringLiteral("lp.gz");
+static const QString kPrometheusSuffix = QStringLiteral("pb.sz");
+
+//------------------------------------------------------------------------------
+// Protobuf encoding helpers
+//------------------------------------------------------------------------------
+
+/**
+ * Appends @a value to @a out as a base 128 varint
+ */
+static void writeVarint(QByteArray &out, quint64 value)
+{
+  while (value >= 0x80)
+  {
+    out.append(char((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+
+  out.append(char(value));
+}
+
+/**
+ * Appends a length-delimited protobuf @a field with the given @a data to @a out
+ */
+static void writeBytes(QByteArray &out, const int field, const QByteArray &data)
+{
+  writeVarint(out, quint64(field) << 3 | 2);
+  writeVarint(out, quint64(data.size()));
+  out.append(data);
+}
+
+/**
+ * Appends a Prometheus @c Label message with the given @a name & @a value as
+ * field 1 of a @c TimeSeries message
+ */
+static void writeLabel(QByteArray &out, const QByteArray &name,
+                       const QString &value)
+{
+  QByteArray label;
+  writeBytes(label, 1, name);
+  writeBytes(label, 2, value.toUtf8());
+  writeBytes(out, 1, label);
+}
+
+//------------------------------------------------------------------------------
+// Snappy compression
+//------------------------------------------------------------------------------
+
+/**
+ * Appends a snappy literal element with @a size bytes of @a data to @a out
+ */
+static void writeLiteral(QByteArray &out, const char *data, qsizetype size)
+{
+  while (size > 0)
+  {
+    const auto count = qMin(size, kSnappyBlockSize);
+    const auto length = quint32(count - 1);
+    if (length < 60)
+      out.append(char(length << 2));
+
+    else if (length < 256)
+    {
+      out.append(char(60 << 2));
+      out.append(char(length));
+    }
+
+    else
+    {
+      out.append(char(61 << 2));
+      out.append(char(length & 0xFF));
+      out.append(char(length >> 8));
+    }
+
+    out.append(data, count);
+    data += count;
+    size -= count;
+  }
+}
+
+/**
+ * Appends snappy copy elements that repeat @a length bytes found @a offset
+ * bytes before the current position to @a out
+ */
+static void writeCopy(QByteArray &out, const quint32 offset, qsizetype length)
+{
+  while (length > 0)
+  {
+    const auto count = qMin<qsizetype>(length, 64);
+    out.append(char(((count - 1) << 2) | 2));
+    out.append(char(offset & 0xFF));
+    out.append(char(offset >> 8));
+    length -= count;
+  }
+}
+
+/**
+ * @brief Compresses @a data in the snappy block format.
+ *
+ * Repeated sequences of at least four bytes are found with a hash table of
+ * the last position of each sequence, and replaced by a copy of the previous
+ * one. The input is compressed in independent 64 KiB blocks, so that every
+ * copy can be encoded with a two-byte offset.
+ */
+static QByteArray snappyCompress(const QByteArray &data)
+{
+  QByteArray out;
+  out.reserve(data.size() + data.size() / 6 + 32);
+  writeVarint(out, quint64(data.size()));
+
+  QVector<int> table(1 << kSnappyHashBits);
+  const auto *src = data.constData();
+  const auto size = data.size();
+  for (qsizetype block = 0; block < size; block += kSnappyBlockSize)
+  {
+    table.fill(-1);
+    const auto end = qMin(size, block + kSnappyBlockSize);
+
+    qsizetype i = block;
+    qsizetype literal = block;
+    while (i + 4 <= end)
+    {
+      // Look for the previous occurrence of the next four bytes
+      quint32 word;
+      std::memcpy(&word, src + i, sizeof(word));
+      const auto hash = (word * 0x1E35A7BDu) >> (32 - kSnappyHashBits);
+      const auto candidate = table[hash];
+      table[hash] = int(i - block);
+
+      quint32 match = ~word;
+      if (candidate >= 0)
+        std::memcpy(&match, src + block + candidate, sizeof(match));
+
+      if (match != word)
+      {
+        ++i;
+        continue;
+      }
+
+      // Extend the match & replace it with a copy
+      const auto from = block + candidate;
+      qsizetype length = 4;
+      while (i + length < end && src[from + length] == src[i + length])
+        ++length;
+
+      writeLiteral(out, src + literal, i - literal);
+      writeCopy(out, quint32(i - from), length);
+      i += length;
+      literal = i;
+    }
+
+    writeLiteral(out, src + literal, end - literal);
+  }
+
+  return out;
+}
+
+//------------------------------------------------------------------------------
+// Line protocol encoding helpers
+//------------------------------------------------------------------------------
+
+/**
+ * Appends @a text to @a out, escaping the given @a special characters with a
+ * backslash & replacing line breaks, which line protocol does not allow
+ */
+static void appendEscaped(QByteArray &out, const QString &text,
+                          const char *special)
+{
+  const auto utf8 = text.toUtf8();
+  for (const auto c : utf8)
+  {
+    if (c == '\n' || c == '\r')
+    {
+      out.append(' ');
+      continue;
+    }
+
+    if (std::strchr(special, c))
+      out.append('\\');
+
+    out.append(c);
+  }
+}
+
+/**
+ * Returns @a name with the characters that are not valid in a Prometheus
+ * metric name replaced by underscores
+ */
+static QByteArray metricName(const QByteArray &name)
+{
+  QByteArray metric = name;
+  for (auto &c : metric)
+  {
+    const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                       || (c >= '0' && c <= '9') || c == '_' || c == ':';
+    if (!valid)
+      c = '_';
+  }
+
+  if (metric.isEmpty() || (metric.at(0) >= '0' && metric.at(0) <= '9'))
+    metric.prepend('_');
+
+  return metric;
+}
+
+//------------------------------------------------------------------------------
+// Writer implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Creates a writer without frame bus, queue folder or server
+ */
+CSV::TsdbWriter::TsdbWriter(QObject *parent)
+  : QObject(parent)
+  , m_frameConsumer(-1)
+  , m_frameBus(nullptr)
+  , m_format(Format::InfluxLineProtocol)
+  , m_measurement("serial_studio")
+  , m_seriesGeneration(0)
+  , m_batchSamples(0)
+  , m_queueBytes(0)
+  , m_nextBatch(0)
+  , m_retryDelay(kMinRetryDelay)
+  , m_retryPending(false)
+  , m_reply(nullptr)
+  , m_network(nullptr)
+{
+}
+
+/**
+ * Queues the values that have not been sent yet before destroying the writer
+ */
+CSV::TsdbWriter::~TsdbWriter()
+{
+  closeBatch();
+}
+
+/**
+ * @brief Sets the frame bus read by @c readFrameBus().
+ *
+ * @param bus Ring to which the frame builder publishes frames.
+ * @param consumer Cursor of the TSDB export in @a bus.
+ */
+void CSV::TsdbWriter::setFrameBus(JSON::FrameBus *bus, const int consumer)
+{
+  m_frameBus = bus;
+  m_frameConsumer = consumer;
+}
+
+/**
+ * Reads the frames waiting in the frame bus & queues the current batch, so
+ * that every received value is sent to the server
+ */
+void CSV::TsdbWriter::flush()
+{
+  readFrameBus();
+  closeBatch();
+}
+
+/**
+ * @brief Encodes the frames that are waiting in the frame bus.
+ *
+ * Frames are copied one by one from the ring into a reusable frame, which
+ * shares the storage of its slot, so reading them does not allocate memory.
+ * Frames without a reception time are stamped with the current time. At most
+ * one ring worth of frames is read on each call, and the current batch is
+ * queued once it is older than @c kBatchInterval.
+ */
+void CSV::TsdbWriter::readFrameBus()
+{
+  TRACE_ZONE("TsdbWriter::readFrameBus");
+
+  // No frame bus available
+  if (!m_frameBus || m_frameConsumer < 0)
+    return;
+
+  // Encode the pending frames
+  qsizetype count = 0;
+  auto limit = m_frameBus->capacity();
+  while (limit-- > 0 && m_frameBus->tryRead(m_frameConsumer, m_busFrame))
+  {
+    if (!m_busFrame.isValid())
+      continue;
+
+    const auto timestamp = m_busFrame.timestamp() > 0
+                               ? m_busFrame.timestamp()
+                               : Misc::SessionClock::now();
+    if (m_format == Format::InfluxLineProtocol)
+      appendLines(m_busFrame, timestamp);
+    else
+      appendSamples(m_busFrame, timestamp);
+
+    ++count;
+  }
+
+  // Queue the batch once it is old enough
+  if (m_batchAge.isValid() && m_batchAge.elapsed() >= kBatchInterval)
+    closeBatch();
+
+  // Notify the export module that the frames have been read
+  Q_EMIT framesWritten(count);
+}
+
+/**
+ * Changes the folder in which batches are queued & sends the batches that
+ * were left in it by a previous session
+ */
+void CSV::TsdbWriter::setPath(const QString &path)
+{
+  m_queueDir.setPath(path);
+  if (!m_queueDir.exists())
+    m_queueDir.mkpath(QStringLiteral("."));
+
+  loadQueue();
+  sendBatch();
+}
+
+/**
+ * @brief Changes the server to which the values are sent.
+ *
+ * The values encoded with the previous settings are queued first, unless
+ * the format changes, in which case they are discarded.
+ *
+ * @param format Encoding of the values, which must match the server API.
+ * @param url The full URL of the write endpoint (including the organization,
+ *            bucket & precision query of InfluxDB).
+ * @param token Access token, sent as @c "Token <token>" to InfluxDB and as
+ *              @c "Bearer <token>" to Prometheus.
+ * @param measurement Name of the InfluxDB measurement or Prometheus metric.
+ */
+void CSV::TsdbWriter::setEndpoint(const CSV::TsdbWriter::Format format,
+                                  const QString &url, const QString &token,
+                                  const QString &measurement)
+{
+  if (m_format == format)
+    closeBatch();
+
+  else
+  {
+    m_lines.clear();
+    m_batchSamples = 0;
+    m_batchAge.invalidate();
+  }
+
+  m_url = url;
+  m_token = token;
+  m_format = format;
+  m_measurement = measurement.toUtf8();
+  if (m_measurement.isEmpty())
+    m_measurement = "serial_studio";
+
+  m_series.clear();
+  m_seriesGeneration = 0;
+  m_retryDelay = kMinRetryDelay;
+  sendBatch();
+}
+
+/**
+ * @brief Sends the oldest queued batch to the server.
+ *
+ * Only one request is sent at a time, so that batches arrive in order and
+ * the network access manager reuses the same connection for every request.
+ * Batches that were encoded in another format are deleted.
+ */
+void CSV::TsdbWriter::sendBatch()
+{
+  // Wait for the current request, the retry delay or a server
+  if (m_reply || m_retryPending || m_url.isEmpty())
+    return;
+
+  // Obtain the oldest batch that can be sent in the current format
+  QByteArray body;
+  while (!m_queue.isEmpty() && body.isEmpty())
+  {
+    QFile file(m_queueDir.filePath(m_queue.first()));
+    if (m_queue.first().endsWith(batchSuffix())
+        && file.open(QFile::ReadOnly))
+      body = file.readAll();
+
+    if (body.isEmpty())
+    {
+      m_queueBytes -= file.size();
+      file.remove();
+      m_queue.removeFirst();
+    }
+  }
+
+  // Nothing to send
+  Q_EMIT queueChanged(m_queue.count(), m_queueBytes);
+  if (body.isEmpty())
+    return;
+
+  // Create the network access manager in the writer thread
+  if (!m_network)
+    m_network = new QNetworkAccessManager(this);
+
+  // Describe the body of the request
+  QNetworkRequest request(QUrl(m_url));
+  request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+  if (m_format == Format::InfluxLineProtocol)
+  {
+    request.setHeader(QNetworkRequest::ContentTypeHeader,
+                      QByteArrayLiteral("text/plain; charset=utf-8"));
+    request.setRawHeader("Content-Encoding", "gzip");
+    if (!m_token.isEmpty())
+      request.setRawHeader("Authorization", "Token " + m_token.toUtf8());
+  }
+
+  else
+  {
+    request.setHeader(QNetworkRequest::ContentTypeHeader,
+                      QByteArrayLiteral("application/x-protobuf"));
+    request.setRawHeader("Content-Encoding", "snappy");
+    request.setRawHeader("X-Prometheus-Remote-Write-Version", "0.1.0");
+    if (!m_token.isEmpty())
+      request.setRawHeader("Authorization", "Bearer " + m_token.toUtf8());
+  }
+
+  // Send the batch
+  m_reply = m_network->post(request, body);
+  connect(m_reply, &QNetworkReply::finished, this,
+          &CSV::TsdbWriter::onReplyFinished);
+}
+
+/**
+ * @brief Deletes the batch accepted by the server & sends the next one.
+ *
+ * Batches rejected because of their contents (HTTP 400, 413 & 422) are
+ * deleted as well, since sending them again would fail in the same way.
+ * Other failures (e.g. network errors, server errors, rate limits or invalid
+ * credentials) are retried after a delay that grows with each failure.
+ */
+void CSV::TsdbWriter::onReplyFinished()
+{
+  // Release the reply
+  auto *reply = m_reply;
+  m_reply = nullptr;
+  if (!reply)
+    return;
+
+  reply->deleteLater();
+
+  // Obtain the status of the request
+  const auto status
+      = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  const bool accepted = reply->error() == QNetworkReply::NoError
+                        && status >= 200 && status < 300;
+  const bool rejected = status == 400 || status == 413 || status == 422;
+
+  // Retry the batch later
+  if (!accepted && !rejected)
+  {
+    Q_EMIT requestFailed(reply->errorString());
+    scheduleRetry();
+    return;
+  }
+
+  // Report batches that the server will never accept
+  if (rejected)
+    Q_EMIT requestFailed(tr("The server rejected a batch (HTTP %1): %2")
+                             .arg(status)
+                             .arg(QString::fromUtf8(reply->readAll())));
+
+  // Delete the batch & send the next one
+  if (!m_queue.isEmpty())
+  {
+    QFile file(m_queueDir.filePath(m_queue.takeFirst()));
+    m_queueBytes -= file.size();
+    file.remove();
+  }
+
+  m_retryDelay = kMinRetryDelay;
+  sendBatch();
+}
+
+/**
+ * @brief Creates the time series of the datasets of @a frame.
+ *
+ * Every dataset gets a series labelled with the metric name, its title & the
+ * title of its group (and its units, if defined). Labels are written sorted
+ * by name, as required by the remote-write protocol.
+ */
+void CSV::TsdbWriter::buildSeries(const JSON::Frame &frame)
+{
+  m_series.clear();
+  m_seriesGeneration = frame.generation();
+
+  const auto name = metricName(m_measurement);
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &datasets = groups[g].datasets();
+    for (int d = 0; d < datasets.count(); ++d)
+    {
+      Series series{g, d, {}, {}, {}};
+      writeLabel(series.labels, "__name__", QString::fromUtf8(name));
+      writeLabel(series.labels, "dataset", datasets[d].title());
+      writeLabel(series.labels, "group", groups[g].title());
+      if (!datasets[d].units().isEmpty())
+        writeLabel(series.labels, "units", datasets[d].units());
+
+      m_series.append(std::move(series));
+    }
+  }
+}
+
+/**
+ * @brief Encodes the values of @a frame in InfluxDB line protocol.
+ *
+ * Each group is written as a line with the group title as a tag, the
+ * numeric values of its datasets as float fields & the rest as string
+ * fields. Values that are not finite are skipped, since line protocol cannot
+ * represent them.
+ */
+void CSV::TsdbWriter::appendLines(const JSON::Frame &frame,
+                                  const qint64 timestamp)
+{
+  if (!m_batchAge.isValid())
+    m_batchAge.start();
+
+  const auto time = QByteArray::number(
+      Misc::SessionClock::toUnixNsecs(timestamp));
+  for (const auto &group : frame.groups())
+  {
+    // Write the measurement & the group tag
+    const auto start = m_lines.size();
+    appendEscaped(m_lines, QString::fromUtf8(m_measurement), ", ");
+    if (!group.title().isEmpty())
+    {
+      m_lines.append(",group=");
+      appendEscaped(m_lines, group.title(), ",= ");
+    }
+
+    // Write the fields of the datasets
+    bool empty = true;
+    for (const auto &dataset : group.datasets())
+    {
+      const bool numeric = dataset.isNumeric();
+      if (numeric && !std::isfinite(dataset.numericValue()))
+        continue;
+
+      if (!numeric && dataset.value().isEmpty())
+        continue;
+
+      m_lines.append(empty ? ' ' : ',');
+      if (dataset.title().isEmpty())
+        m_lines.append("dataset_" + QByteArray::number(dataset.index()));
+      else
+        appendEscaped(m_lines, dataset.title(), ",= ");
+
+      m_lines.append('=');
+      if (numeric)
+        m_lines.append(QByteArray::number(dataset.numericValue(), 'g', 17));
+
+      else
+      {
+        m_lines.append('"');
+        appendEscaped(m_lines, dataset.value(), "\"\\");
+        m_lines.append('"');
+      }
+
+      empty = false;
+    }
+
+    // Groups without values are not written
+    if (empty)
+    {
+      m_lines.truncate(start);
+      continue;
+    }
+
+    m_lines.append(' ');
+    m_lines.append(time);
+    m_lines.append('\n');
+  }
+
+  if (m_lines.size() >= kBatchBytes)
+    closeBatch();
+}
+
+/**
+ * @brief Adds the numeric values of @a frame to the Prometheus time series.
+ *
+ * The series are created again when the structure of the frame changes,
+ * after the samples of the previous structure have been queued.
+ */
+void CSV::TsdbWriter::appendSamples(const JSON::Frame &frame,
+                                    const qint64 timestamp)
+{
+  if (m_seriesGeneration != frame.generation() || m_series.isEmpty())
+  {
+    closeBatch();
+    buildSeries(frame);
+  }
+
+  if (!m_batchAge.isValid())
+    m_batchAge.start();
+
+  const auto time = Misc::SessionClock::toUnixNsecs(timestamp) / 1000000;
+  const auto &groups = frame.groups();
+  for (auto &series : m_series)
+  {
+    const auto &dataset = groups[series.group].datasets()[series.dataset];
+    if (dataset.isNumeric() && std::isfinite(dataset.numericValue()))
+    {
+      series.values.append(dataset.numericValue());
+      series.times.append(time);
+      ++m_batchSamples;
+    }
+  }
+
+  if (m_batchSamples * kSampleSize >= kBatchBytes)
+    closeBatch();
+}
+
+/**
+ * Registers the batches left in the queue folder, oldest first
+ */
+void CSV::TsdbWriter::loadQueue()
+{
+  m_queue.clear();
+  m_queueBytes = 0;
+  m_nextBatch = 0;
+
+  const QStringList filters{QStringLiteral("*.") + kInfluxSuffix,
+                            QStringLiteral("*.") + kPrometheusSuffix};
+  const auto files = m_queueDir.entryInfoList(filters, QDir::Files, QDir::Name);
+  for (const auto &info : files)
+  {
+    m_queue.append(info.fileName());
+    m_queueBytes += info.size();
+    m_nextBatch = qMax(m_nextBatch, info.baseName().toULongLong() + 1);
+  }
+
+  trimQueue();
+}
+
+/**
+ * Deletes the oldest batches that are not being sent until the queue fits in
+ * @c kQueueBytes
+ */
+void CSV::TsdbWriter::trimQueue()
+{
+  const int first = m_reply ? 1 : 0;
+  while (m_queueBytes > kQueueBytes && m_queue.count() > first + 1)
+  {
+    QFile file(m_queueDir.filePath(m_queue.takeAt(first)));
+    m_queueBytes -= file.size();
+    file.remove();
+  }
+}
+
+/**
+ * @brief Compresses the current batch & adds it to the queue folder.
+ *
+ * The batch is written to disk before it is sent, so that it is not lost if
+ * the server cannot be reached or the application is closed.
+ */
+void CSV::TsdbWriter::closeBatch()
+{
+  // Compress the batch in the current format
+  QByteArray body;
+  if (m_format == Format::InfluxLineProtocol && !m_lines.isEmpty())
+  {
+    body = CSV::Gzip::compress(m_lines);
+    m_lines.clear();
+  }
+
+  else if (m_format == Format::PrometheusRemoteWrite && m_batchSamples > 0)
+  {
+    body = snappyCompress(writeRequest());
+    for (auto &series : m_series)
+    {
+      series.values.clear();
+      series.times.clear();
+    }
+  }
+
+  m_batchSamples = 0;
+  m_batchAge.invalidate();
+  if (body.isEmpty() || m_queueDir.path().isEmpty())
+    return;
+
+  // Write the batch to the queue folder
+  const auto name = QStringLiteral("%1.%2")
+                        .arg(m_nextBatch++, 16, 10, QLatin1Char('0'))
+                        .arg(batchSuffix());
+  QFile file(m_queueDir.filePath(name));
+  if (!file.open(QFile::WriteOnly) || file.write(body) != body.size())
+  {
+    file.remove();
+    Q_EMIT requestFailed(tr("Cannot write to the TSDB queue folder"));
+    return;
+  }
+
+  file.close();
+  m_queue.append(name);
+  m_queueBytes += body.size();
+  trimQueue();
+
+  // Send the batch if the server is idle
+  sendBatch();
+}
+
+/**
+ * Sends the current batch again once the retry delay expires
+ */
+void CSV::TsdbWriter::scheduleRetry()
+{
+  m_retryPending = true;
+  QTimer::singleShot(m_retryDelay, this, [=] {
+    m_retryPending = false;
+    sendBatch();
+  });
+
+  m_retryDelay = qMin(m_retryDelay * 2, kMaxRetryDelay);
+}
+
+/**
+ * @brief Encodes the samples of the current batch as a Prometheus
+ *        @c WriteRequest message.
+ *
+ * Each series is written as a @c TimeSeries message (field 1) with its labels
+ * and its samples, whose value is a @c double (field 1) and whose timestamp
+ * is the number of milliseconds since the Unix epoch (field 2).
+ */
+QByteArray CSV::TsdbWriter::writeRequest() const
+{
+  QByteArray request;
+  request.reserve(m_batchSamples * kSampleSize);
+  for (const auto &series : m_series)
+  {
+    if (series.values.isEmpty())
+      continue;
+
+    QByteArray timeSeries = series.labels;
+    for (qsizetype i = 0; i < series.values.count(); ++i)
+    {
+      char value[sizeof(double)];
+      qToLittleEndian(series.values[i], value);
+
+      QByteArray sample;
+      sample.append(char(0x09));
+      sample.append(value, sizeof(value));
+      sample.append(char(0x10));
+      writeVarint(sample, quint64(series.times[i]));
+      writeBytes(timeSeries, 2, sample);
+    }
+
+    writeBytes(request, 1, timeSeries);
+  }
+
+  return request;
+}
+
+/**
+ * Returns the file name suffix of the batches encoded in the current format
+ */
+QString CSV::TsdbWriter::batchSuffix() const
+{
+  if (m_format == Format::InfluxLineProtocol)
+    return kInfluxSuffix;
+
+  return kPrometheusSuffix;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QDir>
+#include <QVector>
+#include <QObject>
+#include <QByteArray>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "JSON/Frame.h"
+
+class QNetworkReply;
+class QNetworkAccessManager;
+
+namespace CSV
+{
+/**
+ * @class CSV::TsdbWriter
+ * @brief Encodes frames for a time-series database & sends them over HTTP.
+ *
+ * The TSDB writer is meant to live in a worker thread, next to the
+ * @c CSV::ArrowWriter. Frames are read from the @c JSON::FrameBus by
+ * @c readFrameBus() when the @c CSV::TsdbExport class asks for it, and the
+ * numeric values of their datasets are encoded directly in one of the
+ * following formats:
+ * - @c InfluxLineProtocol: one line per group & frame, with the group title
+ *   as a tag and one field per dataset, compressed with gzip.
+ * - @c PrometheusRemoteWrite: a protobuf @c WriteRequest with one time series
+ *   per dataset, labelled with its group & dataset titles and compressed with
+ *   snappy.
+ *
+ * Values are accumulated in a batch that is closed when it reaches
+ * @c kBatchBytes, or when it is older than @c kBatchInterval milliseconds.
+ * Closed batches are written to a queue folder before they are sent, so that
+ * they survive network failures & restarts of the application. Batches are
+ * sent one at a time through a single network access manager, which keeps
+ * the HTTP connection to the server alive. Failed requests are retried with
+ * an exponential back-off, and the oldest batches are deleted when the queue
+ * grows beyond @c kQueueBytes.
+ */
+class TsdbWriter : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void framesWritten(const qsizetype frames);
+  void queueChanged(const int batches, const qint64 bytes);
+  void requestFailed(const QString &error);
+
+public:
+  enum class Format
+  {
+    InfluxLineProtocol,
+    PrometheusRemoteWrite
+  };
+
+  explicit TsdbWriter(QObject *parent = nullptr);
+  ~TsdbWriter();
+
+  /**
+   * Uncompressed size at which a batch is closed & queued
+   */
+  static constexpr qsizetype kBatchBytes = 512 * 1024;
+
+  /**
+   * Age (in milliseconds) at which a batch is closed & queued
+   */
+  static constexpr qint64 kBatchInterval = 1000;
+
+  /**
+   * Maximum size of the batches waiting in the queue folder
+   */
+  static constexpr qint64 kQueueBytes = 64 * 1024 * 1024;
+
+  void setFrameBus(JSON::FrameBus *bus, const int consumer);
+
+public slots:
+  void flush();
+  void readFrameBus();
+  void setPath(const QString &path);
+  void setEndpoint(const CSV::TsdbWriter::Format format, const QString &url,
+                   const QString &token, const QString &measurement);
+
+private slots:
+  void sendBatch();
+  void onReplyFinished();
+
+private:
+  /**
+   * @brief Labels & samples of a dataset, sent with Prometheus remote-write.
+   */
+  struct Series
+  {
+    int group;
+    int dataset;
+    QByteArray labels;
+    QVector<double> values;
+    QVector<qint64> times;
+  };
+
+  void buildSeries(const JSON::Frame &frame);
+  void appendLines(const JSON::Frame &frame, const qint64 timestamp);
+  void appendSamples(const JSON::Frame &frame, const qint64 timestamp);
+
+  void loadQueue();
+  void trimQueue();
+  void closeBatch();
+  void scheduleRetry();
+  [[nodiscard]] QByteArray writeRequest() const;
+  [[nodiscard]] QString batchSuffix() const;
+
+private:
+  int m_frameConsumer;
+  JSON::FrameBus *m_frameBus;
+  JSON::Frame m_busFrame;
+
+  Format m_format;
+  QString m_url;
+  QString m_token;
+  QByteArray m_measurement;
+
+  QByteArray m_lines;
+  QVector<Series> m_series;
+  quint64 m_seriesGeneration;
+  qsizetype m_batchSamples;
+  QElapsedTimer m_batchAge;
+
+  QDir m_queueDir;
+  QStringList m_queue;
+  qint64 m_queueBytes;
+  quint64 m_nextBatch;
+
+  int m_retryDelay;
+  bool m_retryPending;
+  QNetworkReply *m_reply;
+  QNetworkAccessManager *m_network;
+};
+} // namespace CSV
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IO/Manager.h"
+#include "IO/ActionScheduler.h"
+
+/**
+ * Constructor function
+ */
+IO::ActionScheduler::ActionScheduler(QObject *parent)
+  : QObject(parent)
+{
+}
+
+/**
+ * Stops sending the payload of the periodic action with the given @a id.
+ */
+void IO::ActionScheduler::stop(const int id)
+{
+  auto *timer = m_timers.take(id);
+  if (timer)
+  {
+    timer->stop();
+    timer->deleteLater();
+  }
+}
+
+/**
+ * Stops sending the payloads of every periodic action.
+ */
+void IO::ActionScheduler::stopAll()
+{
+  for (auto *timer : std::as_const(m_timers))
+  {
+    timer->stop();
+    timer->deleteLater();
+  }
+
+  m_timers.clear();
+}
+
+/**
+ * @brief Starts sending @a data to the device every @a interval milliseconds.
+ *
+ * The data is written once right away, the timer of an action that is
+ * already running is restarted with the new payload & interval.
+ *
+ * @param id       Identifier of the action (its index in the dashboard).
+ * @param data     Pre-encoded payload of the action.
+ * @param interval Time between two writes, in milliseconds.
+ */
+void IO::ActionScheduler::start(const int id, const QByteArray &data,
+                                const int interval)
+{
+  // Replace the timer of the action
+  stop(id);
+  if (data.isEmpty() || interval <= 0)
+    return;
+
+  // Write the payload periodically, precise timers avoid the 5% coarse slack
+  auto *timer = new QTimer(this);
+  timer->setInterval(interval);
+  timer->setTimerType(Qt::PreciseTimer);
+  connect(timer, &QTimer::timeout, this,
+          [data] { (void)IO::Manager::instance().writeCommand(data); });
+
+  // Send the first payload right away
+  m_timers.insert(id, timer);
+  (void)IO::Manager::instance().writeCommand(data);
+  timer->start();
+}
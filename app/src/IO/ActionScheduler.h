@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QTimer>
+#include <QObject>
+#include <QByteArray>
+
+namespace IO
+{
+/**
+ * @class IO::ActionScheduler
+ * @brief Sends the payload of periodic dashboard actions to the device.
+ *
+ * The scheduler is meant to live in a dedicated worker thread, owned by the
+ * @c IO::Manager class. Each periodic action gets a precise timer, which
+ * writes the pre-encoded payload of the action through
+ * @c IO::Manager::writeCommand() (see @c JSON::Action::txBytes()), so
+ * polling commands keep a steady rate even while the UI thread is busy.
+ */
+class ActionScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ActionScheduler(QObject *parent = nullptr);
+
+public slots:
+  void stop(const int id);
+  void stopAll();
+  void start(const int id, const QByteArray &data, const int interval);
+
+private:
+  QHash<int, QTimer *> m_timers;
+};
+} // namespace IO
@@ -22,10 +22,181 @@
 
 #include "IO/Checksum.h"
 
+#include <array>
+#include <algorithm>
+#include <QtEndian>
+
+#if defined(CPU_ARM64) && defined(_MSC_VER)
+#  define NOMINMAX
+#  include <intrin.h>
+#  include <windows.h>
+#  define HAVE_ARM_CRC32
+#  define CRC32_TARGET
+#elif defined(CPU_ARM64) && (defined(__GNUC__) || defined(__clang__))
+#  include <arm_acle.h>
+#  define HAVE_ARM_CRC32
+#  if defined(__clang__)
+#    define CRC32_TARGET __attribute__((target("crc")))
+#  else
+#    define CRC32_TARGET __attribute__((target("+crc")))
+#  endif
+#  if defined(Q_OS_LINUX)
+#    include <sys/auxv.h>
+#    include <asm/hwcap.h>
+#  elif defined(Q_OS_DARWIN)
+#    include <sys/sysctl.h>
+#  endif
+#endif
+
+//------------------------------------------------------------------------------
+// Lookup table generation
+//------------------------------------------------------------------------------
+
+namespace
+{
+/**
+ * @brief Generates the lookup table for a non-reflected (MSB-first) CRC.
+ *
+ * @tparam T The unsigned integer type of the CRC register.
+ * @param poly The generator polynomial.
+ */
+template<typename T>
+constexpr std::array<T, 256> msbFirstTable(const T poly)
+{
+  std::array<T, 256> table{};
+  constexpr int shift = (sizeof(T) - 1) * 8;
+  constexpr T topBit = static_cast<T>(T(1) << (sizeof(T) * 8 - 1));
+
+  for (int i = 0; i < 256; ++i)
+  {
+    T crc = static_cast<T>(T(i) << shift);
+    for (int j = 0; j < 8; ++j)
+    {
+      if (crc & topBit)
+        crc = static_cast<T>((crc << 1) ^ poly);
+      else
+        crc = static_cast<T>(crc << 1);
+    }
+
+    table[i] = crc;
+  }
+
+  return table;
+}
+
+/**
+ * @brief Generates the slice-by-N lookup tables for a reflected (LSB-first)
+ *        CRC.
+ *
+ * The first table is the classic byte-wise table, each following table
+ * advances the CRC by one additional zero byte, which allows processing
+ * N bytes per iteration.
+ *
+ * @tparam T The unsigned integer type of the CRC register.
+ * @tparam N The number of tables to generate.
+ * @param poly The reflected generator polynomial.
+ */
+template<typename T, int N>
+constexpr std::array<std::array<T, 256>, N> lsbFirstTables(const T poly)
+{
+  std::array<std::array<T, 256>, N> tables{};
+  for (int i = 0; i < 256; ++i)
+  {
+    T crc = static_cast<T>(i);
+    for (int j = 0; j < 8; ++j)
+      crc = (crc & 1) ? static_cast<T>((crc >> 1) ^ poly)
+                      : static_cast<T>(crc >> 1);
+
+    tables[0][i] = crc;
+  }
+
+  for (int k = 1; k < N; ++k)
+  {
+    for (int i = 0; i < 256; ++i)
+    {
+      const T prev = tables[k - 1][i];
+      tables[k][i] = static_cast<T>((prev >> 8) ^ tables[0][prev & 0xFF]);
+    }
+  }
+
+  return tables;
+}
+
+// clang-format off
+constexpr auto CRC8_TABLE         = msbFirstTable<uint8_t>(0x31);
+constexpr auto CRC16_TABLE        = msbFirstTable<uint16_t>(0x1021);
+constexpr auto CRC16_MODBUS_TABLE = lsbFirstTables<uint16_t, 1>(0xA001);
+constexpr auto CRC32_TABLES       = lsbFirstTables<uint32_t, 8>(0xEDB88320);
+// clang-format on
+
+#if defined(HAVE_ARM_CRC32)
+/**
+ * @brief Returns @c true if the CPU implements the ARMv8 CRC32 instructions.
+ *
+ * The CRC extension is optional in ARMv8.0, so builds that do not target it
+ * explicitly query the operating system once and cache the result.
+ */
+bool hasArmCrc32()
+{
+  static const bool supported = [] {
+#  if defined(__ARM_FEATURE_CRC32)
+    return true;
+#  elif defined(_MSC_VER)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE)
+           != 0;
+#  elif defined(Q_OS_LINUX)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#  elif defined(Q_OS_DARWIN)
+    int value = 0;
+    size_t size = sizeof(value);
+    return sysctlbyname("hw.optional.armv8_crc32", &value, &size, nullptr, 0)
+               == 0
+           && value != 0;
+#  else
+    return false;
+#  endif
+  }();
+
+  return supported;
+}
+
+/**
+ * @brief Updates a CRC-32 register with the ARMv8 CRC32 instructions.
+ *
+ * Compiled for the CRC extension regardless of the build target, it must only
+ * be called when @c hasArmCrc32() returns @c true.
+ *
+ * @param crc The current (non-inverted) CRC register.
+ * @param bytes Pointer to the input data.
+ * @param length Length of the input data.
+ * @return The updated CRC register.
+ */
+CRC32_TARGET uint32_t armCrc32(uint32_t crc, const uint8_t *bytes,
+                               const int length)
+{
+  // Eight bytes per instruction
+  int i = 0;
+  for (; i + 8 <= length; i += 8)
+    crc = __crc32d(crc, qFromLittleEndian<uint64_t>(bytes + i));
+
+  // Remaining bytes
+  for (; i < length; ++i)
+    crc = __crc32b(crc, bytes[i]);
+
+  return crc;
+}
+#endif
+} // namespace
+
+//------------------------------------------------------------------------------
+// CRC implementations
+//------------------------------------------------------------------------------
+
 /**
  * @brief Computes an 8-bit CRC (Cyclic Redundancy Check) for the given data.
  *
- * This function calculates the CRC-8 checksum using the polynomial 0x31.
+ * This function calculates the CRC-8 checksum using the polynomial 0x31 and
+ * an initial value of 0xFF, using a 256-entry lookup table.
  *
  * @param data Pointer to the input data array.
  * @param length Length of the input data array.
@@ -34,17 +205,9 @@
 uint8_t IO::crc8(const char *data, const int length)
 {
   uint8_t crc = 0xff;
-  for (int i = 0; i < length; i++)
-  {
-    crc ^= data[i];
-    for (int j = 0; j < 8; j++)
-    {
-      if ((crc & 0x80) != 0)
-        crc = (uint8_t)((crc << 1) ^ 0x31);
-      else
-        crc <<= 1;
-    }
-  }
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  for (int i = 0; i < length; ++i)
+    crc = CRC8_TABLE[crc ^ bytes[i]];
 
   return crc;
 }
@@ -52,7 +215,8 @@ uint8_t IO::crc8(const char *data, const int length)
 /**
  * @brief Computes a 16-bit CRC (Cyclic Redundancy Check) for the given data.
  *
- * This function calculates the CRC-16 checksum using a bitwise algorithm.
+ * This function calculates the CRC-16/CCITT-FALSE checksum (polynomial 0x1021,
+ * initial value 0xFFFF) using a 256-entry lookup table.
  *
  * @param data Pointer to the input data array.
  * @param length Length of the input data array.
@@ -60,16 +224,11 @@ uint8_t IO::crc8(const char *data, const int length)
  */
 uint16_t IO::crc16(const char *data, const int length)
 {
-  uint8_t x;
   uint16_t crc = 0xFFFF;
-
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
   for (int i = 0; i < length; ++i)
-  {
-    x = crc >> 8 ^ data[i];
-    x ^= x >> 4;
-    crc = (crc << 8) ^ ((uint16_t)(x << 12)) ^ ((uint16_t)(x << 5))
-          ^ ((uint16_t)x);
-  }
+    crc = static_cast<uint16_t>((crc << 8)
+                                ^ CRC16_TABLE[((crc >> 8) ^ bytes[i]) & 0xFF]);
 
   return crc;
 }
@@ -77,7 +236,11 @@ uint16_t IO::crc16(const char *data, const int length)
 /**
  * @brief Computes a 32-bit CRC (Cyclic Redundancy Check) for the given data.
  *
- * This function calculates the CRC-32 checksum using the polynomial 0xEDB88320.
+ * This function calculates the standard CRC-32 checksum (reflected polynomial
+ * 0xEDB88320). On ARM64 CPUs that implement the CRC extension, which is
+ * detected at runtime, the dedicated CRC32 instructions are used. Otherwise,
+ * the data is processed eight bytes at a time using the slice-by-8
+ * algorithm.
  *
  * @param data Pointer to the input data array.
  * @param length Length of the input data array.
@@ -85,17 +248,218 @@ uint16_t IO::crc16(const char *data, const int length)
  */
 uint32_t IO::crc32(const char *data, const int length)
 {
-  uint32_t mask;
   uint32_t crc = 0xFFFFFFFF;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+
+#if defined(HAVE_ARM_CRC32)
+  // Hardware CRC-32, if the CPU supports it
+  if (hasArmCrc32())
+    return ~armCrc32(crc, bytes, length);
+#endif
+
+  // Slice-by-8, eight bytes per iteration
+  int i = 0;
+  const auto &t = CRC32_TABLES;
+  for (; i + 8 <= length; i += 8)
+  {
+    const uint32_t one = qFromLittleEndian<uint32_t>(bytes + i) ^ crc;
+    const uint32_t two = qFromLittleEndian<uint32_t>(bytes + i + 4);
+    crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF]
+          ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^ t[3][two & 0xFF]
+          ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF]
+          ^ t[0][two >> 24];
+  }
+
+  // Byte-wise processing for the remaining data
+  for (; i < length; ++i)
+    crc = (crc >> 8) ^ t[0][(crc ^ bytes[i]) & 0xFF];
+
+  return ~crc;
+}
+
+/**
+ * @brief Computes the CRC-16/MODBUS checksum for the given data.
+ *
+ * Uses the reflected polynomial 0xA001 with an initial value of 0xFFFF, as
+ * specified by the Modbus RTU protocol.
+ *
+ * @param data Pointer to the input data array.
+ * @param length Length of the input data array.
+ * @return The computed 16-bit CRC checksum.
+ */
+uint16_t IO::crc16Modbus(const char *data, const int length)
+{
+  uint16_t crc = 0xFFFF;
+  const auto &t = CRC16_MODBUS_TABLE[0];
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  for (int i = 0; i < length; ++i)
+    crc = static_cast<uint16_t>((crc >> 8) ^ t[(crc ^ bytes[i]) & 0xFF]);
+
+  return crc;
+}
+
+/**
+ * @brief Computes the CRC-16/XMODEM checksum for the given data.
+ *
+ * Uses the same polynomial (0x1021) and lookup table as @c crc16(), with an
+ * initial value of 0x0000, as specified by the XMODEM-CRC & YMODEM protocols.
+ *
+ * @param data Pointer to the input data array.
+ * @param length Length of the input data array.
+ * @return The computed 16-bit CRC checksum.
+ */
+uint16_t IO::crc16Xmodem(const char *data, const int length)
+{
+  uint16_t crc = 0x0000;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
   for (int i = 0; i < length; ++i)
+    crc = static_cast<uint16_t>((crc << 8)
+                                ^ CRC16_TABLE[((crc >> 8) ^ bytes[i]) & 0xFF]);
+
+  return crc;
+}
+
+//------------------------------------------------------------------------------
+// Fletcher checksums
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Computes the Fletcher-16 checksum for the given data.
+ *
+ * The modulo reduction is deferred and applied once every 5802 bytes, which
+ * is the largest block that cannot overflow the 32-bit accumulators.
+ *
+ * @param data Pointer to the input data array.
+ * @param length Length of the input data array.
+ * @return The computed checksum, with the second sum in the upper byte.
+ */
+uint16_t IO::fletcher16(const char *data, const int length)
+{
+  uint32_t sum1 = 0;
+  uint32_t sum2 = 0;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+
+  int i = 0;
+  while (i < length)
   {
-    crc = crc ^ data[i];
-    for (int j = 8; j >= 0; j--)
+    const int block = std::min(length - i, 5802);
+    for (int j = 0; j < block; ++j)
     {
-      mask = -(crc & 1);
-      crc = (crc >> 1) ^ (0xEDB88320 & mask);
+      sum1 += bytes[i + j];
+      sum2 += sum1;
     }
+
+    sum1 %= 255;
+    sum2 %= 255;
+    i += block;
   }
 
-  return ~crc;
+  return static_cast<uint16_t>((sum2 << 8) | sum1);
+}
+
+/**
+ * @brief Computes the Fletcher-32 checksum for the given data.
+ *
+ * The data is processed as little-endian 16-bit words; an odd trailing byte is
+ * zero-padded. The modulo reduction is deferred and applied once every 359
+ * words to avoid overflowing the 32-bit accumulators.
+ *
+ * @param data Pointer to the input data array.
+ * @param length Length of the input data array.
+ * @return The computed checksum, with the second sum in the upper half.
+ */
+uint32_t IO::fletcher32(const char *data, const int length)
+{
+  uint32_t sum1 = 0xFFFF;
+  uint32_t sum2 = 0xFFFF;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+
+  int words = length / 2;
+  while (words > 0)
+  {
+    const int block = std::min(words, 359);
+    words -= block;
+
+    for (int j = 0; j < block; ++j)
+    {
+      sum1 += qFromLittleEndian<uint16_t>(bytes);
+      sum2 += sum1;
+      bytes += 2;
+    }
+
+    sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+    sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+  }
+
+  if (length % 2 != 0)
+  {
+    sum1 += *bytes;
+    sum2 += sum1;
+  }
+
+  sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+  sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+  sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+  sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+
+  return (sum2 << 16) | sum1;
+}
+
+//------------------------------------------------------------------------------
+// Checksum selection
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the number of bytes of a checksum of the given @a type, or 0
+ *        if @a type does not declare a checksum.
+ */
+int IO::checksumLength(const SerialStudio::ChecksumAlgorithm type)
+{
+  switch (type)
+  {
+    case SerialStudio::Crc8:
+      return 1;
+    case SerialStudio::Crc16:
+    case SerialStudio::Crc16Modbus:
+    case SerialStudio::Crc16Xmodem:
+    case SerialStudio::Fletcher16:
+      return 2;
+    case SerialStudio::Crc32:
+    case SerialStudio::Fletcher32:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Computes the checksum of the given @a type for the given data.
+ *
+ * @param type The checksum algorithm.
+ * @param data Pointer to the input data array.
+ * @param length Length of the input data array.
+ * @return The computed checksum, or 0 if @a type does not declare a checksum.
+ */
+uint32_t IO::checksum(const SerialStudio::ChecksumAlgorithm type,
+                      const char *data, const int length)
+{
+  switch (type)
+  {
+    case SerialStudio::Crc8:
+      return crc8(data, length);
+    case SerialStudio::Crc16:
+      return crc16(data, length);
+    case SerialStudio::Crc32:
+      return crc32(data, length);
+    case SerialStudio::Crc16Modbus:
+      return crc16Modbus(data, length);
+    case SerialStudio::Crc16Xmodem:
+      return crc16Xmodem(data, length);
+    case SerialStudio::Fletcher16:
+      return fletcher16(data, length);
+    case SerialStudio::Fletcher32:
+      return fletcher32(data, length);
+    default:
+      return 0;
+  }
 }
@@ -24,9 +24,19 @@
 
 #include <cstdint>
 
+#include "SerialStudio.h"
+
 namespace IO
 {
 [[nodiscard]] uint8_t crc8(const char *data, const int length);
 [[nodiscard]] uint16_t crc16(const char *data, const int length);
 [[nodiscard]] uint32_t crc32(const char *data, const int length);
+[[nodiscard]] uint16_t crc16Modbus(const char *data, const int length);
+[[nodiscard]] uint16_t crc16Xmodem(const char *data, const int length);
+[[nodiscard]] uint16_t fletcher16(const char *data, const int length);
+[[nodiscard]] uint32_t fletcher32(const char *data, const int length);
+
+[[nodiscard]] int checksumLength(const SerialStudio::ChecksumAlgorithm type);
+[[nodiscard]] uint32_t checksum(const SerialStudio::ChecksumAlgorithm type,
+                                const char *data, const int length);
 } // namespace IO
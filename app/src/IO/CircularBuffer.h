@@ -24,12 +24,26 @@
 
 #include <QtCore>
 
-#include <mutex>
+#include <atomic>
 #include <vector>
 #include <cstring>
 
+#include "SIMD/SIMD.h"
+
 namespace IO
 {
+/**
+ * @brief Returns the number of bytes allocated by all circular buffers.
+ *
+ * Updated when a buffer is constructed or destroyed, and read by the memory
+ * report of @c Misc::PipelineStats.
+ */
+inline std::atomic<qint64> &circularBufferMemory()
+{
+  static std::atomic<qint64> bytes{0};
+  return bytes;
+}
+
 /**
  * @brief A generic circular buffer for managing data with fixed capacity.
  *
@@ -37,6 +51,20 @@ namespace IO
  * storage and retrieval of elements. It supports a customizable storage type
  * for internal representation, allowing for optimized memory usage.
  *
+ * The buffer is lock-free for one producer thread (calling @c append()) and
+ * one consumer thread (calling @c read(), @c peek() and friends). The read and
+ * write positions are monotonically increasing atomic counters that live on
+ * separate cache lines, so the producer and consumer never contend on the
+ * same memory or on a mutex.
+ *
+ * When the producer overwrites data that has not been consumed yet, it pushes
+ * the read position forward. The consumer detects this after copying and
+ * retries the operation, so it never returns a mix of old and new bytes.
+ *
+ * The buffer also keeps a high-water mark, the largest amount of unread data
+ * it has held since the last call to @c resetHighWaterMark(), which owners
+ * use to tell whether the configured capacity fits the incoming data rate.
+ *
  * @tparam T The type of elements exposed to the user (e.g., QByteArray,
  *           QString).
  * @tparam StorageType The type of elements used internally in the buffer
@@ -47,31 +75,44 @@ class CircularBuffer
 {
 public:
   explicit CircularBuffer(qsizetype capacity = 1024 * 1024 * 10);
+  ~CircularBuffer();
 
   [[nodiscard]] StorageType &operator[](qsizetype index);
 
   void clear();
+  void resetHighWaterMark();
+  void discard(qsizetype size);
   void append(const T &data);
+  void append(const StorageType *data, qsizetype size);
+  void setCapacity(qsizetype capacity);
 
   [[nodiscard]] qsizetype size() const;
+  [[nodiscard]] qsizetype capacity() const;
   [[nodiscard]] qsizetype freeSpace() const;
+  [[nodiscard]] qsizetype highWaterMark() const;
 
   [[nodiscard]] T read(qsizetype size);
   [[nodiscard]] T peek(qsizetype size) const;
+  void peek(qsizetype offset, qsizetype size, StorageType *dst) const;
 
-  [[nodiscard]] int findPatternKMP(const T &pattern);
+  [[nodiscard]] qsizetype findFirstOf(const SIMD::PatternSet &patterns,
+                                      qsizetype from = 0,
+                                      qsizetype *matchIndex = nullptr) const;
+  [[nodiscard]] qsizetype indexOf(StorageType value, qsizetype from = 0) const;
 
 private:
-  [[nodiscard]] std::vector<int> computeKMPTable(const T &p) const;
+  [[nodiscard]] bool matchesAt(qsizetype head, qsizetype size,
+                               qsizetype index, const QByteArray &p) const;
 
 private:
-  qsizetype m_size;
-  qsizetype m_head;
-  qsizetype m_tail;
+  static constexpr size_t kCacheLine = 64;
+
   qsizetype m_capacity;
   std::vector<StorageType> m_buffer;
+  std::atomic<qsizetype> m_highWaterMark;
 
-  mutable std::mutex m_mutex;
+  alignas(kCacheLine) std::atomic<qsizetype> m_head;
+  alignas(kCacheLine) std::atomic<qsizetype> m_tail;
 };
 } // namespace IO
 
@@ -85,12 +126,22 @@ private:
  */
 template<typename T, typename StorageType>
 IO::CircularBuffer<T, StorageType>::CircularBuffer(qsizetype capacity)
-  : m_size(0)
+  : m_capacity(capacity)
+  , m_highWaterMark(0)
   , m_head(0)
   , m_tail(0)
-  , m_capacity(capacity)
 {
   m_buffer.resize(capacity);
+  circularBufferMemory().fetch_add(capacity * sizeof(StorageType));
+}
+
+/**
+ * @brief Destroys the buffer & removes it from the memory accounting.
+ */
+template<typename T, typename StorageType>
+IO::CircularBuffer<T, StorageType>::~CircularBuffer()
+{
+  circularBufferMemory().fetch_sub(m_capacity * sizeof(StorageType));
 }
 
 /**
@@ -98,7 +149,8 @@ IO::CircularBuffer<T, StorageType>::CircularBuffer(qsizetype capacity)
  *
  * This subscript operator allows accessing elements stored in the circular
  * buffer at a specific logical index, taking the circular nature of the buffer
- * into account. It performs bounds checking and ensures thread-safe access.
+ * into account. It performs bounds checking against the currently published
+ * read and write positions.
  *
  * @param index The logical index of the element to access (0-based).
  *              Must be in the range [0, size()-1].
@@ -108,61 +160,156 @@ IO::CircularBuffer<T, StorageType>::CircularBuffer(qsizetype capacity)
 template<typename T, typename StorageType>
 StorageType &IO::CircularBuffer<T, StorageType>::operator[](qsizetype index)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto tail = m_tail.load(std::memory_order_acquire);
 
-  if (index < 0 || index >= m_size)
+  if (index < 0 || index >= tail - head)
     throw std::out_of_range("Index out of range");
 
-  qsizetype effectiveIndex = (m_head + index) % m_capacity;
-  return m_buffer[effectiveIndex];
+  return m_buffer[(head + index) % m_capacity];
 }
 
 /**
  * @brief Clears the circular buffer.
  *
- * Resets the buffer, removing all data and resetting internal variables.
+ * Discards all pending data by moving the read position up to the write
+ * position. Must be called from the consumer side.
  */
 template<typename T, typename StorageType>
 void IO::CircularBuffer<T, StorageType>::clear()
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  m_size = 0;
-  m_head = 0;
-  m_tail = 0;
+  m_head.store(m_tail.load(std::memory_order_acquire),
+               std::memory_order_release);
+}
+
+/**
+ * @brief Restarts the high-water mark from the amount of data buffered now.
+ */
+template<typename T, typename StorageType>
+void IO::CircularBuffer<T, StorageType>::resetHighWaterMark()
+{
+  m_highWaterMark.store(size(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Removes data from the front of the buffer without copying it.
+ *
+ * Moves the read position forward by the given number of bytes. This is
+ * equivalent to calling @c read() and throwing away the result, but avoids
+ * allocating and filling a temporary container. Must be called from the
+ * consumer side.
+ *
+ * @param size The number of bytes to discard.
+ * @throws std::underflow_error if there is not enough data in the buffer.
+ */
+template<typename T, typename StorageType>
+void IO::CircularBuffer<T, StorageType>::discard(qsizetype size)
+{
+  auto head = m_head.load(std::memory_order_acquire);
+  while (true)
+  {
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    if (size > tail - head)
+      throw std::underflow_error("Not enough data in buffer");
+
+    if (m_head.compare_exchange_weak(head, head + size,
+                                     std::memory_order_acq_rel))
+      break;
+  }
 }
 
 /**
  * @brief Appends data to the circular buffer.
  *
  * Adds the given data to the buffer. If the data exceeds the free space, old
- * data is overwritten.
+ * data is overwritten. If the data is larger than the whole buffer, only its
+ * last @c capacity() elements are kept. Must be called from the producer side.
  *
  * @param data The QByteArray containing data to append.
- * @throws std::overflow_error if the data size exceeds the buffer capacity.
  */
 template<typename T, typename StorageType>
 void IO::CircularBuffer<T, StorageType>::append(const T &data)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  append(reinterpret_cast<const StorageType *>(data.data()), data.size());
+}
 
-  qsizetype dataSize = data.size();
+/**
+ * @brief Appends @a size elements starting at @a data to the circular buffer.
+ *
+ * Same as @c append(const T &), but lets callers append a part of a chunk
+ * without copying it into a temporary object first.
+ *
+ * @param data Pointer to the first element to append.
+ * @param size Number of elements to append.
+ */
+template<typename T, typename StorageType>
+void IO::CircularBuffer<T, StorageType>::append(const StorageType *data,
+                                                qsizetype size)
+{
+  // Keep only the newest bytes of chunks larger than the buffer
+  qsizetype dataSize = size;
+  const auto *src = data;
   if (dataSize > m_capacity)
-    throw std::overflow_error("Data size exceeds buffer capacity");
-
-  if (freeSpace() < dataSize)
   {
-    qsizetype overwrite = dataSize - freeSpace();
-    m_head = (m_head + overwrite) % m_capacity;
-    m_size -= overwrite;
+    src += dataSize - m_capacity;
+    dataSize = m_capacity;
   }
 
-  for (qsizetype i = 0; i < dataSize; ++i)
+  // Push the read position forward if we need to overwrite unread data
+  const auto tail = m_tail.load(std::memory_order_relaxed);
+  auto head = m_head.load(std::memory_order_acquire);
+  while (tail + dataSize - head > m_capacity)
   {
-    m_buffer[m_tail] = data[i];
-    m_tail = (m_tail + 1) % m_capacity;
+    if (m_head.compare_exchange_weak(head, tail + dataSize - m_capacity,
+                                     std::memory_order_acq_rel))
+      break;
   }
 
-  m_size += dataSize;
+  // Make sure that the consumer sees the moved head before the new bytes
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // Copy the data into the buffer in (at most) two contiguous chunks
+  const auto start = tail % m_capacity;
+  const auto firstChunk = std::min(dataSize, m_capacity - start);
+  std::memcpy(&m_buffer[start], src, firstChunk);
+  if (dataSize > firstChunk)
+    std::memcpy(&m_buffer[0], src + firstChunk, dataSize - firstChunk);
+
+  // Publish the new data to the consumer
+  m_tail.store(tail + dataSize, std::memory_order_release);
+
+  // Update the high-water mark
+  const auto used = std::min(tail + dataSize - head, m_capacity);
+  if (used > m_highWaterMark.load(std::memory_order_relaxed))
+    m_highWaterMark.store(used, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Changes the capacity of the buffer.
+ *
+ * Reallocates the storage & discards all buffered data. Unlike the other
+ * functions, this one is not lock-free: it must only be called while neither
+ * the producer nor the consumer is using the buffer, e.g. from the thread that
+ * performs both roles.
+ *
+ * @param capacity The new maximum capacity of the buffer in elements.
+ */
+template<typename T, typename StorageType>
+void IO::CircularBuffer<T, StorageType>::setCapacity(qsizetype capacity)
+{
+  if (capacity <= 0 || capacity == m_capacity)
+    return;
+
+  circularBufferMemory().fetch_add((capacity - m_capacity)
+                                   * qsizetype(sizeof(StorageType)));
+
+  m_buffer.assign(capacity, StorageType());
+  m_buffer.shrink_to_fit();
+  m_capacity = capacity;
+
+  m_head.store(0, std::memory_order_relaxed);
+  m_tail.store(0, std::memory_order_relaxed);
+  m_highWaterMark.store(0, std::memory_order_relaxed);
 }
 
 /**
@@ -173,7 +320,18 @@ void IO::CircularBuffer<T, StorageType>::append(const T &data)
 template<typename T, typename StorageType>
 qsizetype IO::CircularBuffer<T, StorageType>::size() const
 {
-  return m_size;
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto tail = m_tail.load(std::memory_order_acquire);
+  return tail - head;
+}
+
+/**
+ * @brief Returns the maximum number of elements that the buffer can hold.
+ */
+template<typename T, typename StorageType>
+qsizetype IO::CircularBuffer<T, StorageType>::capacity() const
+{
+  return m_capacity;
 }
 
 /**
@@ -184,14 +342,24 @@ qsizetype IO::CircularBuffer<T, StorageType>::size() const
 template<typename T, typename StorageType>
 qsizetype IO::CircularBuffer<T, StorageType>::freeSpace() const
 {
-  return m_capacity - m_size;
+  return m_capacity - size();
+}
+
+/**
+ * @brief Returns the largest amount of data that the buffer has held since
+ *        it was created, resized or since @c resetHighWaterMark() was called.
+ */
+template<typename T, typename StorageType>
+qsizetype IO::CircularBuffer<T, StorageType>::highWaterMark() const
+{
+  return m_highWaterMark.load(std::memory_order_relaxed);
 }
 
 /**
  * @brief Reads data from the circular buffer.
  *
  * Reads the specified number of bytes from the buffer. The read data is removed
- * from the buffer.
+ * from the buffer. Must be called from the consumer side.
  *
  * @param size The number of bytes to read.
  * @return A QByteArray containing the read data.
@@ -200,22 +368,30 @@ qsizetype IO::CircularBuffer<T, StorageType>::freeSpace() const
 template<typename T, typename StorageType>
 T IO::CircularBuffer<T, StorageType>::read(qsizetype size)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  if (size > m_size)
-    throw std::underflow_error("Not enough data in buffer");
-
-  QByteArray result;
+  T result;
   result.resize(size);
 
-  for (qsizetype i = 0; i < size; ++i)
+  auto head = m_head.load(std::memory_order_acquire);
+  while (true)
   {
-    result[i] = m_buffer[m_head];
-    m_head = (m_head + 1) % m_capacity;
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    if (size > tail - head)
+      throw std::underflow_error("Not enough data in buffer");
+
+    const auto start = head % m_capacity;
+    const auto firstChunk = std::min(size, m_capacity - start);
+    std::memcpy(result.data(), &m_buffer[start], firstChunk);
+    if (size > firstChunk)
+      std::memcpy(result.data() + firstChunk, &m_buffer[0],
+                  size - firstChunk);
+
+    // Retry if the producer overwrote the data while we were copying it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_head.compare_exchange_strong(head, head + size,
+                                       std::memory_order_acq_rel))
+      break;
   }
 
-  m_size -= size;
-
   return result;
 }
 
@@ -234,103 +410,201 @@ T IO::CircularBuffer<T, StorageType>::read(qsizetype size)
 template<typename T, typename StorageType>
 T IO::CircularBuffer<T, StorageType>::peek(qsizetype size) const
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  size = std::min(size, m_size);
-
   T result;
-  result.resize(size);
+  while (true)
+  {
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    const auto count = std::min(size, tail - head);
+    const auto start = head % m_capacity;
 
-  qsizetype firstChunk = std::min(size, m_capacity - m_head);
-  std::memcpy(result.data(), &m_buffer[m_head], firstChunk);
+    result.resize(count);
+    qsizetype firstChunk = std::min(count, m_capacity - start);
+    std::memcpy(result.data(), &m_buffer[start], firstChunk);
 
-  if (size > firstChunk)
-  {
-    size_t secondChunk = size - firstChunk;
-    std::memcpy(result.data() + firstChunk, &m_buffer[0], secondChunk);
+    if (count > firstChunk)
+    {
+      size_t secondChunk = count - firstChunk;
+      std::memcpy(result.data() + firstChunk, &m_buffer[0], secondChunk);
+    }
+
+    // Retry if the producer overwrote the data while we were copying it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_head.load(std::memory_order_relaxed) == head)
+      break;
   }
 
   return result;
 }
 
 /**
- * @brief Searches for a pattern in the buffer using the KMP algorithm.
+ * @brief Copies a range of the buffer into caller-provided memory.
  *
- * Implements the Knuth-Morris-Pratt algorithm to efficiently find a pattern in
- * the buffer.
+ * Unlike @c peek(qsizetype), this overload does not allocate; it is meant to
+ * fill pre-allocated (e.g. pooled) storage with a frame that starts at an
+ * arbitrary logical offset.
  *
- * @param pattern The QByteArray representing the pattern to search for.
- * @return The index of the first occurrence of the pattern, or -1 if not found.
+ * @param offset The logical index of the first element to copy.
+ * @param size The number of elements to copy.
+ * @param dst The destination, which must hold at least @a size elements.
+ * @throws std::underflow_error if the range exceeds the buffered data.
  */
 template<typename T, typename StorageType>
-int IO::CircularBuffer<T, StorageType>::findPatternKMP(const T &pattern)
+void IO::CircularBuffer<T, StorageType>::peek(qsizetype offset, qsizetype size,
+                                              StorageType *dst) const
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  if (pattern.isEmpty() || m_size < pattern.size())
-    return -1;
+  while (true)
+  {
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    if (offset < 0 || offset + size > tail - head)
+      throw std::underflow_error("Not enough data in buffer");
+
+    const auto start = (head + offset) % m_capacity;
+    const auto firstChunk = std::min(size, m_capacity - start);
+    std::memcpy(dst, &m_buffer[start], firstChunk * sizeof(StorageType));
+    if (size > firstChunk)
+      std::memcpy(dst + firstChunk, &m_buffer[0],
+                  (size - firstChunk) * sizeof(StorageType));
+
+    // Retry if the producer overwrote the data while we were copying it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_head.load(std::memory_order_relaxed) == head)
+      break;
+  }
+}
 
-  std::vector<int> lps = computeKMPTable(pattern);
-  qsizetype bufferIdx = m_head;
+/**
+ * @brief Searches for the earliest occurrence of any pattern in the buffer.
+ *
+ * The buffer is scanned one contiguous segment at a time with
+ * @c SIMD::findFirstOf(), which only looks for the precomputed first bytes of
+ * the patterns. Each candidate position is then verified against the full
+ * patterns, taking wrap-around into account, so matches that straddle the end
+ * of the underlying storage are found as well.
+ *
+ * @param patterns The precomputed pattern set to search for.
+ * @param from The logical index at which to start searching, used by callers
+ *             that remember how far they have already scanned.
+ * @param matchIndex Optional output for the index (within @a patterns) of the
+ *                   pattern that matched.
+ *
+ * @return The logical index of the first match, or -1 if not found.
+ */
+template<typename T, typename StorageType>
+qsizetype IO::CircularBuffer<T, StorageType>::findFirstOf(
+    const SIMD::PatternSet &patterns, qsizetype from,
+    qsizetype *matchIndex) const
+{
+  static_assert(sizeof(StorageType) == 1, "Pattern search requires bytes");
 
-  int i = 0, j = 0;
-  while (i < m_size)
-  {
-    if (m_buffer[bufferIdx] == pattern[j])
-    {
-      i++;
-      j++;
-      bufferIdx = (bufferIdx + 1) % m_capacity;
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto tail = m_tail.load(std::memory_order_acquire);
+  const auto size = tail - head;
 
-      if (j == pattern.size())
-        return i - j;
-    }
+  if (patterns.isEmpty() || size < patterns.minLength())
+    return -1;
 
-    else if (j != 0)
-      j = lps[j - 1];
+  // Scan the (at most two) contiguous segments of the ring
+  qsizetype offset = std::max<qsizetype>(0, from);
+  while (offset < size)
+  {
+    const auto start = (head + offset) % m_capacity;
+    const auto chunk = std::min(size - offset, m_capacity - start);
+    const auto *data = reinterpret_cast<const char *>(&m_buffer[start]);
 
-    else
+    // Verify each candidate position against the full patterns
+    qsizetype pos = 0;
+    while (pos < chunk)
     {
-      i++;
-      bufferIdx = (bufferIdx + 1) % m_capacity;
+      const auto hit = SIMD::findFirstOf(data + pos, chunk - pos, patterns);
+      if (hit < 0)
+        break;
+
+      const auto index = offset + pos + hit;
+      for (qsizetype p = 0; p < patterns.count(); ++p)
+      {
+        if (matchesAt(head, size, index, patterns.at(p)))
+        {
+          if (matchIndex)
+            *matchIndex = p;
+
+          return index;
+        }
+      }
+
+      pos += hit + 1;
     }
+
+    offset += chunk;
   }
 
   return -1;
 }
 
 /**
- * @brief Computes the KMP table for a given p.
+ * @brief Searches for the earliest occurrence of a single byte in the buffer.
  *
- * Prepares the longest prefix suffix (LPS) table used by the KMP algorithm.
+ * Each contiguous segment of the ring is handed to @c memchr() directly, so
+ * single-byte delimiters skip the candidate verification of
+ * @c findFirstOf().
  *
- * @param p The QByteArray representing the p.
- * @return A vector of integers representing the LPS table.
+ * @param value The byte to search for.
+ * @param from The logical index at which to start searching.
+ *
+ * @return The logical index of the first match, or -1 if not found.
  */
 template<typename T, typename StorageType>
-std::vector<int>
-IO::CircularBuffer<T, StorageType>::computeKMPTable(const T &p) const
+qsizetype IO::CircularBuffer<T, StorageType>::indexOf(StorageType value,
+                                                      qsizetype from) const
 {
-  qsizetype m = p.size();
-  std::vector<int> lps(m, 0);
+  static_assert(sizeof(StorageType) == 1, "Byte search requires bytes");
 
-  qsizetype len = 0;
-  qsizetype i = 1;
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto tail = m_tail.load(std::memory_order_acquire);
+  const auto size = tail - head;
 
-  while (i < m)
+  // Scan the (at most two) contiguous segments of the ring
+  qsizetype offset = std::max<qsizetype>(0, from);
+  while (offset < size)
   {
-    if (p[i] == p[len])
-    {
-      len++;
-      lps[i++] = len;
-    }
+    const auto start = (head + offset) % m_capacity;
+    const auto chunk = std::min(size - offset, m_capacity - start);
+    const auto *data = &m_buffer[start];
+    const auto *hit = std::memchr(data, value, chunk);
+    if (hit)
+      return offset + (static_cast<const StorageType *>(hit) - data);
+
+    offset += chunk;
+  }
+
+  return -1;
+}
 
-    else if (len != 0)
-      len = lps[len - 1];
+/**
+ * @brief Checks if a pattern is stored at the given logical index.
+ *
+ * @param head The read position snapshot used by the caller.
+ * @param size The number of readable bytes in the snapshot.
+ * @param index The logical index (relative to @a head) to compare at.
+ * @param p The pattern to compare.
+ *
+ * @return @c true if the whole pattern is present at @a index.
+ */
+template<typename T, typename StorageType>
+bool IO::CircularBuffer<T, StorageType>::matchesAt(qsizetype head,
+                                                   qsizetype size,
+                                                   qsizetype index,
+                                                   const QByteArray &p) const
+{
+  if (index + p.size() > size)
+    return false;
 
-    else
-      lps[i++] = 0;
+  for (qsizetype i = 0; i < p.size(); ++i)
+  {
+    if (m_buffer[(head + index + i) % m_capacity] != p.at(i))
+      return false;
   }
 
-  return lps;
+  return true;
 }
@@ -20,60 +20,107 @@
  * THE SOFTWARE.
  */
 
+#include <array>
+#include <algorithm>
+
 #include <QFile>
+#include <QApplication>
 #include <QPrinter>
-#include <QDateTime>
 #include <QFileDialog>
 #include <QPrintDialog>
 #include <QTextDocument>
 
 #include "IO/Manager.h"
 #include "IO/Console.h"
+#include "SIMD/SIMD.h"
 #include "Misc/Utilities.h"
 #include "Misc/Translator.h"
+#include "Misc/TimerEvents.h"
 #include "Misc/CommonFonts.h"
+#include "Misc/SessionClock.h"
+#include "Misc/ThreadScheduler.h"
+
+// Maximum number of characters waiting to be displayed, older text is dropped
+// from the pending buffer (only the console display is affected)
+static constexpr qsizetype kMaxPendingText = 1024 * 1024;
+
+// Size of the in-memory ring that holds the most recent console text
+static constexpr qsizetype kTextBufferSize = 1024 * 1024;
+
+// Minimum number of bytes moved from the ring to the spill file at a time
+static constexpr qsizetype kMinSpillSize = 64 * 1024;
+
+// Size of the blocks written to the output file when saving the console data
+static constexpr qsizetype kSaveBlockSize = 64 * 1024;
+
+// Layout of a hexdump row: 16 bytes as "XX " groups split into two halves of
+// 8 bytes, followed by the printable ASCII representation of the row
+static constexpr qsizetype kHexBytesPerRow = 16;
+static constexpr qsizetype kHexColumnWidth = kHexBytesPerRow * 3 + 2;
+static constexpr qsizetype kHexRowWidth = kHexColumnWidth + 3 + 16 + 2;
 
 /**
- * Generates a hexdump of the given data
+ * Generates a hexdump of the given data.
+ *
+ * Every byte is formatted through a lookup table & written straight into a
+ * preallocated output string, rows are always 16 bytes wide (except the last
+ * one, which is padded so that the ASCII column stays aligned).
  */
-static QString HexDump(const char *data, const size_t size)
+static QString HexDump(const char *data, const qsizetype size)
 {
+  // Lookup table with the two hex digits of every byte value
+  static const auto table = [] {
+    std::array<char16_t, 512> digits{};
+    constexpr char hex[] = "0123456789ABCDEF";
+    for (int i = 0; i < 256; ++i)
+    {
+      digits[i * 2] = hex[i >> 4];
+      digits[i * 2 + 1] = hex[i & 0x0F];
+    }
+
+    return digits;
+  }();
+
+  // Preallocate the output string
   QString result;
-  char ascii[17];
-  ascii[16] = '\0';
+  const auto rows = (size + kHexBytesPerRow - 1) / kHexBytesPerRow;
+  result.resize(rows * kHexRowWidth);
+  auto *out = reinterpret_cast<char16_t *>(result.data());
 
-  for (size_t i = 0; i < size; ++i)
+  // Format each row
+  const auto *bytes = reinterpret_cast<const quint8 *>(data);
+  for (qsizetype row = 0; row < size; row += kHexBytesPerRow)
   {
-    char hexBuffer[4];
-    snprintf(hexBuffer, sizeof(hexBuffer), "%02X ",
-             static_cast<quint8>(data[i]));
-    result += hexBuffer;
+    const auto count = std::min(kHexBytesPerRow, size - row);
 
-    if (data[i] >= ' ' && data[i] <= '~')
-      ascii[i % 16] = data[i];
-    else
-      ascii[i % 16] = '.';
-
-    if ((i + 1) % 8 == 0 || i + 1 == size)
+    // Write the hex columns, padding missing bytes with spaces
+    auto *hex = out;
+    std::fill(hex, hex + kHexColumnWidth, u' ');
+    for (qsizetype i = 0; i < count; ++i)
     {
-      result += ' ';
-      if ((i + 1) % 16 == 0)
-        result += QString("|  %1 \n").arg(ascii);
-
-      else if (i + 1 == size)
-      {
-        ascii[(i + 1) % 16] = '\0';
-
-        if ((i + 1) % 16 <= 8)
-          result += ' ';
-        for (size_t j = (i + 1) % 16; j < 16; ++j)
-          result += "   ";
+      const auto *digits = &table[bytes[row + i] * 2];
+      auto *cell = hex + i * 3 + (i >= 8 ? 1 : 0);
+      cell[0] = digits[0];
+      cell[1] = digits[1];
+    }
 
-        result += QString("|  %1 \n").arg(ascii);
-      }
+    // Write the ASCII column
+    out += kHexColumnWidth;
+    *out++ = u'|';
+    *out++ = u' ';
+    *out++ = u' ';
+    for (qsizetype i = 0; i < count; ++i)
+    {
+      const auto c = bytes[row + i];
+      *out++ = (c >= ' ' && c <= '~') ? char16_t(c) : u'.';
     }
+
+    *out++ = u' ';
+    *out++ = u'\n';
   }
 
+  // Drop the space reserved for missing ASCII characters of the last row
+  result.truncate(out - reinterpret_cast<char16_t *>(result.data()));
   return result;
 }
 
@@ -89,11 +136,36 @@ IO::Console::Console()
   , m_showTimestamp(false)
   , m_isStartingLine(true)
   , m_lastCharWasCR(false)
-  , m_textBuffer(1024 * 1024)
-{
+  , m_spilledBytes(0)
+  , m_textBuffer(kTextBufferSize)
+{
+  // Write the text that does not fit in memory from its own thread
+  m_spillWriter.moveToThread(&m_spillThread);
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    m_spillThread.quit();
+    if (!m_spillThread.wait(1000))
+      m_spillThread.terminate();
+  });
+
+  // Start the spill writer thread
+  m_spillThread.setObjectName(QStringLiteral("Console Spill Writer"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_spillThread, Misc::ThreadScheduler::Role::Exporter);
+  m_spillThread.start(QThread::LowPriority);
+
+  // Initialize buffers
   clear();
 }
 
+/**
+ * Stops the spill writer thread before destroying the class
+ */
+IO::Console::~Console()
+{
+  m_spillThread.quit();
+  m_spillThread.wait();
+}
+
 /**
  * Returns the only instance of the class
  */
@@ -116,7 +188,8 @@ bool IO::Console::echo() const
  */
 bool IO::Console::saveAvailable() const
 {
-  return m_textBuffer.size() > 0;
+  return m_textBuffer.size() > 0 || m_spilledBytes > 0
+         || !m_pendingText.isEmpty();
 }
 
 /**
@@ -280,6 +353,9 @@ void IO::Console::save()
   if (!saveAvailable())
     return;
 
+  // Register the text that has not been displayed yet
+  flushPendingText();
+
   // Get file name
   auto path = QFileDialog::getSaveFileName(nullptr, tr("Export Console Data"),
                                            QDir::homePath(),
@@ -291,7 +367,31 @@ void IO::Console::save()
     QFile file(path);
     if (file.open(QFile::WriteOnly))
     {
-      file.write(m_textBuffer.peek(m_textBuffer.size()));
+      // Stream the oldest text from the spill file
+      if (m_spilledBytes > 0)
+      {
+        QMetaObject::invokeMethod(&m_spillWriter,
+                                  &IO::ConsoleSpillWriter::flush,
+                                  Qt::BlockingQueuedConnection);
+
+        QFile spillFile(m_spillWriter.fileName());
+        if (spillFile.open(QFile::ReadOnly))
+        {
+          while (!spillFile.atEnd())
+            file.write(spillFile.read(kSaveBlockSize));
+        }
+      }
+
+      // Write the text held in memory, one block at a time
+      QByteArray block(kSaveBlockSize, Qt::Uninitialized);
+      const auto size = m_textBuffer.size();
+      for (qsizetype offset = 0; offset < size; offset += kSaveBlockSize)
+      {
+        const auto length = qMin(kSaveBlockSize, size - offset);
+        m_textBuffer.peek(offset, length, block.data());
+        file.write(block.constData(), length);
+      }
+
       file.close();
       Misc::Utilities::revealFile(path);
     }
@@ -307,7 +407,17 @@ void IO::Console::save()
  */
 void IO::Console::clear()
 {
+  // Discard the spilled text
+  if (m_spilledBytes > 0)
+  {
+    m_spilledBytes = 0;
+    QMetaObject::invokeMethod(&m_spillWriter, &IO::ConsoleSpillWriter::clear,
+                              Qt::QueuedConnection);
+  }
+
   m_textBuffer.clear();
+  m_pendingText.clear();
+  m_utf8Carry.clear();
   m_isStartingLine = true;
   m_lastCharWasCR = false;
   Q_EMIT saveAvailableChanged();
@@ -358,6 +468,10 @@ void IO::Console::setupExternalConnections()
   connect(dm, &Manager::dataReceived, this, &IO::Console::onDataReceived,
           Qt::QueuedConnection);
 
+  // Display the accumulated text at the UI refresh rate
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi, this,
+          &IO::Console::flushPendingText);
+
   // Update lists when language changes
   connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
           this, &IO::Console::languageChanged);
@@ -415,6 +529,9 @@ void IO::Console::send(const QString &data)
  */
 void IO::Console::print()
 {
+  // Register the text that has not been displayed yet
+  flushPendingText();
+
   // Create text document
   QTextDocument document;
   document.setPlainText(
@@ -495,6 +612,11 @@ void IO::Console::setDisplayMode(const IO::Console::DisplayMode &mode)
 /**
  * Inserts the given @a string into the list of lines of the console, if @a
  * addTimestamp is set to @c true, an timestamp is added for each line.
+ *
+ * The string is scanned once: \r\n & \r line endings are converted to \n,
+ * timestamps are inserted at the start of each line & the result is appended
+ * to a pending buffer, which is displayed at the UI refresh rate by
+ * @c flushPendingText().
  */
 void IO::Console::append(const QString &string, const bool addTimestamp)
 {
@@ -505,72 +627,118 @@ void IO::Console::append(const QString &string, const bool addTimestamp)
   // Check if we should update the save available feature
   const bool previousSaveAvailable = saveAvailable();
 
-  // Omit leading \n if a trailing \r was already rendered from previous payload
-  auto data = string;
-  if (m_lastCharWasCR && data.startsWith('\n'))
-    data.removeFirst();
-
-  // Record trailing \r
-  m_lastCharWasCR = data.endsWith('\r');
-
-  // Only use \n as line separator for rendering
-  data = data.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-  data = data.replace(QStringLiteral("\r"), QStringLiteral("\n"));
-
   // Get timestamp
   QString timestamp;
   if (addTimestamp)
   {
-    QDateTime dateTime = QDateTime::currentDateTime();
-    timestamp = dateTime.toString(QStringLiteral("HH:mm:ss.zzz -> "));
+    const auto now = Misc::SessionClock::now();
+    timestamp = Misc::SessionClock::formatTime(now) + QStringLiteral(" -> ");
   }
 
-  // Initialize final string
-  QString processedString;
-  processedString.reserve(data.length() + timestamp.length());
-
-  // Create list with lines (keep separators)
-  QStringList tokens;
-  QString currentToken;
-  for (int i = 0; i < data.length(); ++i)
+  // Scan the string line by line, appending whole runs of characters
+  const auto *chars = string.constData();
+  const auto length = string.length();
+  m_pendingText.reserve(m_pendingText.length() + length + timestamp.length());
+  for (qsizetype i = 0; i < length;)
   {
-    if (data.at(i) == '\n')
+    // Omit the \n of a \r\n pair, even if the \r came in the previous chunk
+    if (m_lastCharWasCR && chars[i] == u'\n')
     {
-      tokens.append(currentToken);
-      tokens.append(QStringLiteral("\n"));
-      currentToken.clear();
+      m_lastCharWasCR = false;
+      ++i;
+      continue;
     }
 
-    else
-      currentToken += data.at(i);
-  }
+    // Find the end of the current line
+    m_lastCharWasCR = false;
+    auto end = i;
+    while (end < length && chars[end] != u'\n' && chars[end] != u'\r')
+      ++end;
 
-  // Add last item to list
-  if (!currentToken.isEmpty())
-    tokens.append(currentToken);
+    // Append the line contents
+    if (end > i)
+    {
+      if (m_isStartingLine)
+        m_pendingText.append(timestamp);
 
-  // Process lines
-  while (!tokens.isEmpty())
-  {
-    if (m_isStartingLine)
-      processedString.append(timestamp);
+      m_pendingText.append(QStringView(chars + i, end - i));
+      m_isStartingLine = false;
+    }
+
+    // Append the line break, only \n is used for rendering
+    if (end < length)
+    {
+      if (m_isStartingLine)
+        m_pendingText.append(timestamp);
 
-    auto token = tokens.first();
-    processedString.append(token);
-    m_isStartingLine = (token == QStringLiteral("\n"));
-    tokens.removeFirst();
+      m_pendingText.append(u'\n');
+      m_isStartingLine = true;
+      m_lastCharWasCR = chars[end] == u'\r';
+    }
+
+    i = end + 1;
   }
 
-  // Add data to saved text buffer
-  m_textBuffer.append(processedString.toUtf8());
+  // Keep the pending buffer bounded if the UI cannot keep up
+  if (m_pendingText.length() > kMaxPendingText)
+    m_pendingText.remove(0, m_pendingText.length() - kMaxPendingText);
 
   // Update save avaialable
   if (saveAvailable() != previousSaveAvailable)
     Q_EMIT saveAvailableChanged();
+}
 
-  // Update UI
+/**
+ * Registers the accumulated text in the saved text buffer & sends it to the
+ * terminal widget with a single signal.
+ */
+void IO::Console::flushPendingText()
+{
+  if (m_pendingText.isEmpty())
+    return;
+
+  // Make room for the new text, spilling the oldest text to disk
+  const auto data = m_pendingText.toUtf8();
+  const auto capacity = m_textBuffer.size() + m_textBuffer.freeSpace();
+  if (data.size() > capacity)
+  {
+    const auto excess = data.size() - capacity;
+    spill(m_textBuffer.size());
+    m_spilledBytes += excess;
+    QMetaObject::invokeMethod(
+        &m_spillWriter,
+        [this, head = data.left(excess)] { m_spillWriter.write(head); },
+        Qt::QueuedConnection);
+    m_textBuffer.append(data.right(capacity));
+  }
+
+  else
+  {
+    const auto overflow = data.size() - m_textBuffer.freeSpace();
+    if (overflow > 0)
+      spill(qMin(m_textBuffer.size(), qMax(overflow, kMinSpillSize)));
+
+    m_textBuffer.append(data);
+  }
+
+  // Display the text
+  Q_EMIT displayString(m_pendingText);
+  m_pendingText.clear();
+}
+
+/**
+ * Moves the oldest @a size bytes of the in-memory text buffer to the spill
+ * writer thread, which appends them to the temporary log file.
+ */
+void IO::Console::spill(const qsizetype size)
+{
+  if (size <= 0)
+    return;
+
+  m_spilledBytes += size;
+  const auto data = m_textBuffer.read(size);
   QMetaObject::invokeMethod(
-      this, [=] { Q_EMIT displayString(processedString); },
+      &m_spillWriter, [this, data] { m_spillWriter.write(data); },
       Qt::QueuedConnection);
 }
 
@@ -590,7 +758,7 @@ void IO::Console::onDataSent(const QByteArray &data)
  */
 void IO::Console::onDataReceived(const QByteArray &data)
 {
-  append(dataToString(data), showTimestamp());
+  append(dataToString(data, &m_utf8Carry), showTimestamp());
 }
 
 /**
@@ -654,13 +822,16 @@ QByteArray IO::Console::hexToBytes(const QString &data)
 /**
  * Converts the given @a data to a string according to the console display mode
  * set by the user.
+ *
+ * The optional @a carry buffer keeps the bytes of a UTF-8 sequence that was
+ * split at the end of the previous chunk of the same stream.
  */
-QString IO::Console::dataToString(const QByteArray &data)
+QString IO::Console::dataToString(const QByteArray &data, QByteArray *carry)
 {
   switch (displayMode())
   {
     case DisplayMode::DisplayPlainText:
-      return plainTextStr(data);
+      return plainTextStr(data, carry);
       break;
     case DisplayMode::DisplayHexadecimal:
       return hexadecimalStr(data);
@@ -672,16 +843,36 @@ QString IO::Console::dataToString(const QByteArray &data)
 }
 
 /**
- * Converts the given @a data into an UTF-8 string
+ * Converts the given @a data into an UTF-8 string, or into a Latin-1 string if
+ * the data is not valid UTF-8.
+ *
+ * If a @a carry buffer is given, its bytes are prepended to the data & a
+ * multi-byte sequence truncated at the end of the data is moved into it, so
+ * that characters split between two chunks are decoded correctly.
  */
-QString IO::Console::plainTextStr(const QByteArray &data)
+QString IO::Console::plainTextStr(const QByteArray &data, QByteArray *carry)
 {
-  QString str = QString::fromUtf8(data);
+  // Prepend the truncated sequence of the previous chunk
+  QByteArray bytes = data;
+  if (carry && !carry->isEmpty())
+  {
+    bytes.prepend(*carry);
+    carry->clear();
+  }
 
-  if (str.toUtf8() != data)
-    str = QString::fromLatin1(data);
+  // Validate the data in a single pass
+  qsizetype incomplete = 0;
+  if (!SIMD::validateUtf8(bytes.constData(), bytes.size(), &incomplete))
+    return QString::fromLatin1(bytes);
 
-  return str;
+  // Keep the truncated sequence for the next chunk
+  if (carry && incomplete > 0)
+  {
+    *carry = bytes.right(incomplete);
+    bytes.chop(incomplete);
+  }
+
+  return QString::fromUtf8(bytes);
 }
 
 /**
@@ -689,22 +880,5 @@ QString IO::Console::plainTextStr(const QByteArray &data)
  */
 QString IO::Console::hexadecimalStr(const QByteArray &data)
 {
-  // Remove line breaks from data
-  QByteArray copy = data;
-
-  // Convert data to string with dump every ~80 chars
-  QString str;
-  const int characters = 80;
-  for (int i = 0; i < copy.length(); ++i)
-  {
-    QByteArray line;
-    for (int j = 0; j < qMin(characters, copy.length() - i); ++j)
-      line.append(copy.at(i + j));
-
-    i += characters;
-    str.append(HexDump(line.data(), line.size()));
-  }
-
-  // Return string
-  return str;
+  return HexDump(data.constData(), data.size());
 }
@@ -22,8 +22,11 @@
 
 #pragma once
 
+#include <QThread>
 #include <QObject>
+
 #include "IO/CircularBuffer.h"
+#include "IO/ConsoleSpillWriter.h"
 
 namespace IO
 {
@@ -36,6 +39,11 @@ namespace IO
  * The class also controls various UI-related factors, such as the display
  * format of the data (e.g. ASCII or HEX), history of sent commands and
  * exporting of the RX data.
+ *
+ * Displayed text is kept in a bounded in-memory ring. When the ring is full,
+ * its oldest bytes are handed to the @c IO::ConsoleSpillWriter worker thread,
+ * which appends them to a temporary log file, so that exporting the console
+ * data saves the complete session.
  */
 class Console : public QObject
 {
@@ -97,6 +105,8 @@ private:
   Console &operator=(Console &&) = delete;
   Console &operator=(const Console &) = delete;
 
+  ~Console();
+
 public:
   enum class DisplayMode
   {
@@ -155,14 +165,16 @@ public slots:
   void append(const QString &str, const bool addTimestamp = false);
 
 private slots:
+  void flushPendingText();
   void onDataSent(const QByteArray &data);
   void addToHistory(const QString &command);
   void onDataReceived(const QByteArray &data);
 
 private:
+  void spill(const qsizetype size);
   QByteArray hexToBytes(const QString &data);
-  QString dataToString(const QByteArray &data);
-  QString plainTextStr(const QByteArray &data);
+  QString dataToString(const QByteArray &data, QByteArray *carry = nullptr);
+  QString plainTextStr(const QByteArray &data, QByteArray *carry = nullptr);
   QString hexadecimalStr(const QByteArray &data);
 
 private:
@@ -180,6 +192,12 @@ private:
   QStringList m_historyItems;
 
   QString m_printFont;
+  QString m_pendingText;
+  QByteArray m_utf8Carry;
+
+  qint64 m_spilledBytes;
+  QThread m_spillThread;
+  IO::ConsoleSpillWriter m_spillWriter;
   CircularBuffer<QByteArray, char> m_textBuffer;
 };
 } // namespace IO
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QDebug>
+
+#include "IO/ConsoleSpillWriter.h"
+
+/**
+ * Constructor function
+ */
+IO::ConsoleSpillWriter::ConsoleSpillWriter(QObject *parent)
+  : QObject(parent)
+{
+  m_file.setFileTemplate(
+      QDir::temp().filePath(QStringLiteral("SerialStudio-Console-XXXXXX.log")));
+}
+
+/**
+ * Returns the path of the temporary log file, or an empty string if no text
+ * has been spilled yet.
+ *
+ * @note Call @c flush() from the owner thread before using the file, so that
+ *       every queued write reaches the disk.
+ */
+QString IO::ConsoleSpillWriter::fileName() const
+{
+  return m_fileName;
+}
+
+/**
+ * Discards all the text stored in the temporary log file.
+ */
+void IO::ConsoleSpillWriter::clear()
+{
+  if (m_file.isOpen())
+  {
+    m_file.resize(0);
+    m_file.seek(0);
+  }
+}
+
+/**
+ * Writes the buffered data of the temporary log file to disk.
+ */
+void IO::ConsoleSpillWriter::flush()
+{
+  if (m_file.isOpen())
+    m_file.flush();
+}
+
+/**
+ * Appends the given @a data to the temporary log file, creating the file if
+ * required.
+ */
+void IO::ConsoleSpillWriter::write(const QByteArray &data)
+{
+  // Create the temporary file
+  if (!m_file.isOpen())
+  {
+    if (!m_file.open())
+    {
+      qWarning() << "Cannot create console log:" << m_file.errorString();
+      return;
+    }
+
+    m_fileName = m_file.fileName();
+  }
+
+  // Append the data at the end of the file
+  if (m_file.write(data) != data.size())
+    qWarning() << "Cannot write console log:" << m_file.errorString();
+}
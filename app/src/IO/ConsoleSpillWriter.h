@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QTemporaryFile>
+
+namespace IO
+{
+/**
+ * @class IO::ConsoleSpillWriter
+ * @brief Appends console text that no longer fits in memory to a temporary
+ *        log file.
+ *
+ * The spill writer is meant to live in a worker thread. The @c IO::Console
+ * class keeps the most recent text in a bounded in-memory ring, and queues the
+ * oldest bytes of the ring to @c write() when it needs room for new text, so
+ * that long sessions can be exported completely without growing the memory
+ * usage of the application.
+ *
+ * The temporary file is created on the first write and removed when the
+ * writer is destroyed.
+ */
+class ConsoleSpillWriter : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ConsoleSpillWriter(QObject *parent = nullptr);
+
+  [[nodiscard]] QString fileName() const;
+
+public slots:
+  void clear();
+  void flush();
+  void write(const QByteArray &data);
+
+private:
+  QString m_fileName;
+  QTemporaryFile m_file;
+};
+} // namespace IO
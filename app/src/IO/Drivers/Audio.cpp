@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QTimer>
+
+#include "IO/Manager.h"
+#include "IO/Drivers/Audio.h"
+
+#include "SIMD/SIMD.h"
+#include "JSON/FrameBuilder.h"
+#include "Misc/Utilities.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * Sample rates that can be selected by the user (in hertz)
+ */
+static constexpr int kSampleRates[] = {44100, 48000, 96000, 192000};
+
+/**
+ * Index of the default sample rate (48 kHz)
+ */
+static constexpr int kDefaultSampleRate = 1;
+
+/**
+ * Maximum number of input channels
+ */
+static constexpr int kMaxChannels = 8;
+
+/**
+ * Maximum number of sample rows handed to the frame builder at once, which
+ * keeps each block well within the capacity of the frame bus, so that the
+ * dashboard reads every sample before the next block is published
+ */
+static constexpr qsizetype kMaxFramesPerRead = 256;
+
+/**
+ * Duration of audio captured by the input buffer of the device (in seconds)
+ */
+static constexpr double kBufferDuration = 0.1;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::Audio::Audio()
+  : m_deviceIndex(-1)
+  , m_channelCount(1)
+  , m_sampleRateIndex(kDefaultSampleRate)
+  , m_readPending(false)
+  , m_source(nullptr)
+  , m_input(nullptr)
+{
+  connect(&m_mediaDevices, &QMediaDevices::audioInputsChanged, this,
+          &IO::Drivers::Audio::refreshDevices);
+
+  refreshDevices();
+}
+
+/**
+ * Stops capturing audio before destroying the driver
+ */
+IO::Drivers::Audio::~Audio()
+{
+  close();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::Audio &IO::Drivers::Audio::instance()
+{
+  static Audio singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Stops capturing audio & deletes the audio source
+ */
+void IO::Drivers::Audio::close()
+{
+  if (m_source)
+  {
+    m_source->disconnect(this);
+    m_source->stop();
+    m_source->deleteLater();
+    m_source = nullptr;
+  }
+
+  m_input = nullptr;
+  m_readPending = false;
+}
+
+/**
+ * Returns @c true if audio is being captured
+ */
+bool IO::Drivers::Audio::isOpen() const
+{
+  return m_source && m_input && m_source->state() != QAudio::StoppedState;
+}
+
+/**
+ * Returns @c true if audio is being captured
+ */
+bool IO::Drivers::Audio::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c false, audio inputs cannot receive data
+ */
+bool IO::Drivers::Audio::isWritable() const
+{
+  return false;
+}
+
+/**
+ * Returns @c true if an audio input is selected
+ */
+bool IO::Drivers::Audio::configurationOk() const
+{
+  return m_deviceIndex >= 0 && m_deviceIndex < m_devices.count();
+}
+
+/**
+ * Returns the number of sample bytes captured per second
+ */
+qint64 IO::Drivers::Audio::dataRate() const
+{
+  return qint64(kSampleRates[m_sampleRateIndex]) * m_channelCount
+         * qint64(sizeof(float));
+}
+
+/**
+ * Does nothing, audio inputs cannot receive data
+ */
+quint64 IO::Drivers::Audio::write(const QByteArray &data)
+{
+  (void)data;
+  return 0;
+}
+
+/**
+ * @brief Starts capturing audio from the selected input.
+ *
+ * @return @c true if the capture started.
+ */
+bool IO::Drivers::Audio::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+  close();
+
+  // Validate the configuration
+  if (!configurationOk())
+    return false;
+
+  // Use floating point samples if possible, signed 16-bit samples otherwise
+  const auto &device = m_devices.at(m_deviceIndex);
+  m_format = QAudioFormat();
+  m_format.setSampleRate(kSampleRates[m_sampleRateIndex]);
+  m_format.setChannelCount(m_channelCount);
+  m_format.setSampleFormat(QAudioFormat::Float);
+  if (!device.isFormatSupported(m_format))
+    m_format.setSampleFormat(QAudioFormat::Int16);
+
+  if (!device.isFormatSupported(m_format))
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Audio input error"),
+        tr("The selected device does not support %1 channel(s) at %2 Hz")
+            .arg(m_channelCount)
+            .arg(kSampleRates[m_sampleRateIndex]));
+    return false;
+  }
+
+  // Create the audio source
+  const auto bufferFrames = m_format.sampleRate() * kBufferDuration;
+  m_source = new QAudioSource(device, m_format, this);
+  m_source->setBufferSize(m_format.bytesForFrames(int(bufferFrames)));
+  connect(m_source, &QAudioSource::stateChanged, this,
+          &IO::Drivers::Audio::onStateChanged);
+
+  // Start capturing audio
+  m_input = m_source->start();
+  if (!m_input)
+  {
+    close();
+    Misc::Utilities::showMessageBox(tr("Audio input error"),
+                                    tr("Cannot open the selected device"));
+    return false;
+  }
+
+  connect(m_input, &QIODevice::readyRead, this,
+          &IO::Drivers::Audio::readSamples);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the index of the selected input, in the list returned by
+ * @c availableDevices().
+ */
+int IO::Drivers::Audio::deviceIndex() const
+{
+  return m_deviceIndex;
+}
+
+/**
+ * Returns the number of channels to capture
+ */
+int IO::Drivers::Audio::channelCount() const
+{
+  return m_channelCount;
+}
+
+/**
+ * Returns the index of the selected sample rate, in the list returned by
+ * @c availableSampleRates().
+ */
+int IO::Drivers::Audio::sampleRateIndex() const
+{
+  return m_sampleRateIndex;
+}
+
+/**
+ * Returns the names of the audio inputs of this system
+ */
+QStringList IO::Drivers::Audio::availableDevices() const
+{
+  QStringList list;
+  for (const auto &device : m_devices)
+    list.append(device.description());
+
+  return list;
+}
+
+/**
+ * Returns the list of sample rates that can be selected by the user
+ */
+QStringList IO::Drivers::Audio::availableSampleRates() const
+{
+  QStringList list;
+  for (const auto rate : kSampleRates)
+    list.append(tr("%1 kHz").arg(rate / 1000.0));
+
+  return list;
+}
+
+/**
+ * Obtains the audio inputs of this system & selects the default input if
+ * the selected one is no longer available
+ */
+void IO::Drivers::Audio::refreshDevices()
+{
+  const auto devices = QMediaDevices::audioInputs();
+  if (devices == m_devices)
+    return;
+
+  // Keep the selected device, or select the default one
+  QAudioDevice selected = QMediaDevices::defaultAudioInput();
+  if (configurationOk())
+    selected = m_devices.at(m_deviceIndex);
+
+  m_devices = devices;
+  m_deviceIndex = m_devices.indexOf(selected);
+  if (m_deviceIndex < 0 && !m_devices.isEmpty())
+    m_deviceIndex = 0;
+
+  Q_EMIT availableDevicesChanged();
+  Q_EMIT deviceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the selected audio input
+ */
+void IO::Drivers::Audio::setDeviceIndex(const int index)
+{
+  if (index == m_deviceIndex)
+    return;
+
+  m_deviceIndex = index;
+  Q_EMIT deviceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the number of channels to capture
+ */
+void IO::Drivers::Audio::setChannelCount(const int channels)
+{
+  const auto count = qBound(1, channels, kMaxChannels);
+  if (count == m_channelCount)
+    return;
+
+  m_channelCount = count;
+  Q_EMIT channelCountChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the sample rate of the capture
+ */
+void IO::Drivers::Audio::setSampleRateIndex(const int index)
+{
+  const auto count = static_cast<int>(std::size(kSampleRates));
+  if (index < 0 || index >= count || index == m_sampleRateIndex)
+    return;
+
+  m_sampleRateIndex = index;
+  Q_EMIT sampleRateIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+//------------------------------------------------------------------------------
+// Audio capture
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Converts the captured PCM samples & hands them to the frame builder.
+ *
+ * At most @c kMaxFramesPerRead rows are processed at a time. If more audio is
+ * pending, the rest is read from the event loop, after the consumers of the
+ * frame bus had a chance to read the rows that were just published.
+ */
+void IO::Drivers::Audio::readSamples()
+{
+  m_readPending = false;
+  const auto frameSize = m_format.bytesPerFrame();
+  if (!m_input || frameSize <= 0)
+    return;
+
+  // Obtain the number of complete sample rows
+  const auto available = m_input->bytesAvailable() / frameSize;
+  const auto frames = std::min<qsizetype>(available, kMaxFramesPerRead);
+  if (frames <= 0)
+    return;
+
+  // Read the PCM block
+  m_buffer.resize(frames * frameSize);
+  const auto bytes = m_input->read(m_buffer.data(), m_buffer.size());
+  const auto rows = bytes / frameSize;
+  if (rows <= 0)
+    return;
+
+  // Convert the samples to normalized values
+  const auto count = static_cast<size_t>(rows * m_format.channelCount());
+  m_samples.resize(count);
+  if (m_format.sampleFormat() == QAudioFormat::Float)
+  {
+    const auto *pcm = reinterpret_cast<const float *>(m_buffer.constData());
+    SIMD::pcmFloatToDouble(pcm, m_samples.data(), count, 1.0);
+  }
+
+  else
+  {
+    const auto *pcm = reinterpret_cast<const qint16 *>(m_buffer.constData());
+    SIMD::pcm16ToDouble(pcm, m_samples.data(), count, 1.0 / 32768.0);
+  }
+
+  // Back-date the rows from the time at which the last one was captured
+  auto &stats = Misc::PipelineStats::instance();
+  const auto period = qint64(1e9 / m_format.sampleRate());
+  const auto timestamp = stats.timestamp() - (rows - 1) * period;
+  stats.record(Misc::PipelineStats::DriverReceive, 1, bytes, 0);
+
+  // Publish the samples
+  JSON::FrameBuilder::instance().readSamples(
+      m_samples.constData(), rows, m_format.channelCount(), timestamp, period);
+
+  // Read the remaining audio from the event loop
+  if (available > frames && !m_readPending)
+  {
+    m_readPending = true;
+    QTimer::singleShot(0, this, &IO::Drivers::Audio::readSamples);
+  }
+}
+
+/**
+ * Disconnects from the device & displays a message if the capture failed
+ */
+void IO::Drivers::Audio::onStateChanged(QAudio::State state)
+{
+  if (state != QAudio::StoppedState || !m_source
+      || m_source->error() == QAudio::NoError)
+    return;
+
+  Manager::instance().disconnectDevice();
+  Misc::Utilities::showMessageBox(tr("Audio input error"),
+                                  tr("The audio capture stopped unexpectedly"));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+#include <QIODevice>
+#include <QByteArray>
+#include <QStringList>
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QAudioSource>
+#include <QMediaDevices>
+
+#include "IO/HAL_Driver.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The Audio class
+ *
+ * Serial Studio driver for audio inputs (sound cards, measurement
+ * microphones, line inputs of vibration sensors...), captured through
+ * @c QAudioSource at up to 192 kHz.
+ *
+ * Audio is not a byte stream: the captured PCM blocks are converted to
+ * numbers with SIMD routines and handed to @c JSON::FrameBuilder as sample
+ * blocks, skipping frame detection and the frame parsers. Each sample of
+ * each channel becomes a dataset value, channel @c n feeding the datasets
+ * with frame index @c n+1, so that FFT widgets whose sampling rate matches
+ * the capture rate work as a real-time spectrum analyzer.
+ *
+ * Samples are captured as 32-bit floats when the device supports it, and as
+ * signed 16-bit integers otherwise. Values are normalized to [-1, 1).
+ */
+class Audio : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int deviceIndex
+             READ deviceIndex
+             WRITE setDeviceIndex
+             NOTIFY deviceIndexChanged)
+  Q_PROPERTY(int sampleRateIndex
+             READ sampleRateIndex
+             WRITE setSampleRateIndex
+             NOTIFY sampleRateIndexChanged)
+  Q_PROPERTY(int channelCount
+             READ channelCount
+             WRITE setChannelCount
+             NOTIFY channelCountChanged)
+  Q_PROPERTY(QStringList availableDevices
+             READ availableDevices
+             NOTIFY availableDevicesChanged)
+  Q_PROPERTY(QStringList availableSampleRates
+             READ availableSampleRates
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void deviceIndexChanged();
+  void channelCountChanged();
+  void sampleRateIndexChanged();
+  void availableDevicesChanged();
+
+private:
+  explicit Audio();
+  Audio(Audio &&) = delete;
+  Audio(const Audio &) = delete;
+  Audio &operator=(Audio &&) = delete;
+  Audio &operator=(const Audio &) = delete;
+
+  ~Audio();
+
+public:
+  static Audio &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] qint64 dataRate() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] int deviceIndex() const;
+  [[nodiscard]] int channelCount() const;
+  [[nodiscard]] int sampleRateIndex() const;
+
+  [[nodiscard]] QStringList availableDevices() const;
+  [[nodiscard]] QStringList availableSampleRates() const;
+
+public slots:
+  void refreshDevices();
+  void setDeviceIndex(const int index);
+  void setChannelCount(const int channels);
+  void setSampleRateIndex(const int index);
+
+private slots:
+  void readSamples();
+  void onStateChanged(QAudio::State state);
+
+private:
+  int m_deviceIndex;
+  int m_channelCount;
+  int m_sampleRateIndex;
+  bool m_readPending;
+
+  QAudioFormat m_format;
+  QAudioSource *m_source;
+  QIODevice *m_input;
+  QMediaDevices m_mediaDevices;
+
+  QByteArray m_buffer;
+  QVector<double> m_samples;
+  QList<QAudioDevice> m_devices;
+};
+} // namespace Drivers
+} // namespace IO
@@ -20,21 +20,44 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+
+#include <QCoreApplication>
 #include <QOperatingSystemVersion>
+#include <QLowEnergyConnectionParameters>
 
+#include "IO/Manager.h"
 #include "Misc/Utilities.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
 #include "IO/Drivers/BluetoothLE.h"
 
 //------------------------------------------------------------------------------
 // Constructor & singleton access functions
 //------------------------------------------------------------------------------
 
+// Time window in which notifications are merged before reaching the reader
+static constexpr int kNotificationWindow = 10;
+
+// Number of full-size notifications that trigger an immediate flush
+static constexpr int kNotificationsPerFlush = 32;
+
+// Payload size of a notification with the default ATT MTU (23 bytes)
+static constexpr int kDefaultPayloadSize = 20;
+
+// Buffer capacity of the frame reader of each subscribed characteristic,
+// unless the user selects a fixed buffer size
+static constexpr qsizetype kLaneBufferCapacity = 64 * 1024;
+
 /**
  * Constructor function, configures the signals/slots of the BLE module
  */
 IO::Drivers::BluetoothLE::BluetoothLE()
   : m_deviceIndex(-1)
   , m_deviceConnected(false)
+  , m_selectedCharacteristic(-1)
+  , m_pendingSince(0)
+  , m_pendingBytes(0)
   , m_service(nullptr)
   , m_controller(nullptr)
   , m_discoveryAgent(nullptr)
@@ -42,11 +65,40 @@ IO::Drivers::BluetoothLE::BluetoothLE()
   connect(this, &IO::Drivers::BluetoothLE::deviceIndexChanged, this,
           &IO::Drivers::BluetoothLE::configurationChanged);
 
+  // Notifications arrive once per connection interval (several ms apart),
+  // merge them over a wider window than the default one
+  setCoalescingWindow(kNotificationWindow);
+  setCoalescingThreshold(kDefaultPayloadSize * kNotificationsPerFlush);
+
   connect(this, &IO::Drivers::BluetoothLE::error, this,
           [=](const QString &message) {
             Misc::Utilities::showMessageBox(tr("BLE I/O Module Error"),
                                             message);
           });
+
+  // Hand the queued notifications to the demuxer when the window expires
+  m_notificationTimer.setSingleShot(true);
+  m_notificationTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_notificationTimer, &QTimer::timeout, this,
+          &IO::Drivers::BluetoothLE::flushNotifications);
+
+  // Report the frames of each subscribed characteristic
+  m_demuxer.moveToThread(&m_readerThread);
+  connect(&m_demuxer, &IO::Drivers::NotificationDemuxer::framesReady, this,
+          &IO::Drivers::BluetoothLE::framesReceived, Qt::DirectConnection);
+
+  // Stop the reader thread before the application quits
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    close();
+    m_readerThread.quit();
+    if (!m_readerThread.wait(100))
+      m_readerThread.terminate();
+  });
+
+  // Name the reader thread, it is started when a device is opened
+  m_readerThread.setObjectName(QStringLiteral("BLE Reader"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_readerThread, Misc::ThreadScheduler::Role::Reader);
 }
 
 /**
@@ -78,6 +130,12 @@ void IO::Drivers::BluetoothLE::close()
   m_characteristics.clear();
   m_characteristicNames.clear();
   m_selectedCharacteristic = -1;
+  clearSubscriptions();
+
+  // Remove the lanes of the subscribed characteristics
+  if (m_readerThread.isRunning())
+    QMetaObject::invokeMethod(&m_demuxer, &NotificationDemuxer::reset,
+                              Qt::BlockingQueuedConnection);
 
   // Delete previous service
   if (m_service)
@@ -143,6 +201,19 @@ bool IO::Drivers::BluetoothLE::configurationOk() const
   return operatingSystemSupported() && deviceIndex() >= 0;
 }
 
+/**
+ * @brief Checks if consecutive writes can be merged.
+ *
+ * Each write is sent as a separate characteristic value, whose size is
+ * limited by the negotiated MTU, so writes are never merged.
+ *
+ * @return Always `false`.
+ */
+bool IO::Drivers::BluetoothLE::supportsCoalescedWrites() const
+{
+  return false;
+}
+
 /**
  * @brief Writes data to the Bluetooth LE device.
  *
@@ -203,6 +274,21 @@ bool IO::Drivers::BluetoothLE::open(const QIODevice::OpenMode mode)
   // Close previous device
   close();
 
+  // Start the thread that extracts the frames of each characteristic
+  startReader();
+
+  // Frame reader settings of each subscribed characteristic
+  const auto &manager = Manager::instance();
+  const auto start = manager.startSequence();
+  const auto finish = manager.finishSequence();
+  const auto capacity = manager.bufferSize() > 0 ? manager.bufferCapacity(0)
+                                                 : kLaneBufferCapacity;
+  const auto policy = static_cast<SerialStudio::BufferOverflowPolicy>(
+      manager.overflowPolicy());
+  QMetaObject::invokeMethod(
+      &m_demuxer, [=] { m_demuxer.configure(start, finish, capacity, policy); },
+      Qt::QueuedConnection);
+
   // Initialize a BLE controller for the current deveice
   auto device = m_devices.at(m_deviceIndex);
   m_controller = QLowEnergyController::createCentral(device, this);
@@ -214,10 +300,15 @@ bool IO::Drivers::BluetoothLE::open(const QIODevice::OpenMode mode)
   // React to connection event with BLE device
   connect(m_controller, &QLowEnergyController::connected, this, [this]() {
     m_deviceConnected = true;
+    requestLowLatencyConnection();
     m_controller->discoverServices();
     Q_EMIT deviceConnectedChanged();
   });
 
+  // Size the coalescing buffer according to the negotiated MTU
+  connect(m_controller, &QLowEnergyController::mtuChanged, this,
+          &IO::Drivers::BluetoothLE::onMtuChanged);
+
   // React to disconnection event with BLE device
   connect(m_controller, &QLowEnergyController::disconnected, this,
           &IO::Drivers::BluetoothLE::close);
@@ -271,6 +362,23 @@ int IO::Drivers::BluetoothLE::characteristicIndex() const
   return m_selectedCharacteristic + 1;
 }
 
+/**
+ * @return The indexes of the characteristics (as listed by
+ *         @c characteristicNames()) that are read with a frame reader of
+ *         their own.
+ */
+QVariantList IO::Drivers::BluetoothLE::subscriptions() const
+{
+  QList<int> indexes(m_subscriptions.cbegin(), m_subscriptions.cend());
+  std::sort(indexes.begin(), indexes.end());
+
+  QVariantList list;
+  for (const auto index : std::as_const(indexes))
+    list.append(index + 1);
+
+  return list;
+}
+
 /**
  * @return A list with the discovered BLE devices.
  */
@@ -402,6 +510,7 @@ void IO::Drivers::BluetoothLE::selectService(const int index)
   m_characteristics.clear();
   m_characteristicNames.clear();
   m_selectedCharacteristic = -1;
+  clearSubscriptions();
 
   // Ensure that index is valid
   if (index >= 1 && index <= m_serviceNames.count())
@@ -476,6 +585,84 @@ void IO::Drivers::BluetoothLE::setCharacteristicIndex(const int index)
   Q_EMIT characteristicIndexChanged();
 }
 
+/**
+ * @brief Subscribes to (or unsubscribes from) the notifications of the
+ *        characteristic at the given @a index of @c characteristicNames().
+ *
+ * While at least one characteristic is subscribed, only the notifications of
+ * the subscribed characteristics are read, and the frames of each one are
+ * extracted by a frame reader of its own, tagged with the position of the
+ * characteristic in the list as data source (starting at 1).
+ */
+void IO::Drivers::BluetoothLE::setSubscribed(const int index,
+                                             const bool subscribed)
+{
+  // Operating system not supported, abort process
+  if (!operatingSystemSupported())
+    return;
+
+  // Validate the service & the characteristic
+  const auto i = index - 1;
+  if (!m_service || i < 0 || i >= m_characteristics.count())
+    return;
+
+  // Nothing to do
+  if (m_subscriptions.contains(i) == subscribed)
+    return;
+
+  // Enable or disable the notifications of the characteristic
+  const auto &c = m_characteristics.at(i);
+  const auto &cccd = c.clientCharacteristicConfiguration();
+  if (subscribed)
+  {
+    m_subscriptions.insert(i);
+    if (cccd.isValid())
+      m_service->writeDescriptor(
+          cccd, QLowEnergyCharacteristic::CCCDEnableNotification);
+  }
+
+  else
+  {
+    m_subscriptions.remove(i);
+    if (cccd.isValid() && i != m_selectedCharacteristic)
+      m_service->writeDescriptor(cccd,
+                                 QLowEnergyCharacteristic::CCCDDisable);
+  }
+
+  // Update UI
+  Q_EMIT subscriptionsChanged();
+}
+
+/**
+ * @brief Hands the queued notifications to the demuxer in a single batch.
+ *
+ * Called when the coalescing window of the driver expires, or right away
+ * once the queued notifications reach the coalescing threshold.
+ */
+void IO::Drivers::BluetoothLE::flushNotifications()
+{
+  m_notificationTimer.stop();
+  if (m_pendingNotifications.isEmpty())
+    return;
+
+  // Take the queued notifications
+  QList<Notification> batch;
+  batch.swap(m_pendingNotifications);
+  const auto bytes = m_pendingBytes;
+  const auto since = m_pendingSince;
+  m_pendingBytes = 0;
+
+  // Register the received data
+  Misc::PipelineStats::instance().record(
+      Misc::PipelineStats::DriverReceive, static_cast<quint64>(batch.count()),
+      static_cast<quint64>(bytes), 0);
+
+  // Extract the frames of each characteristic in the reader thread
+  QMetaObject::invokeMethod(
+      &m_demuxer, [=] { m_demuxer.processNotifications(batch, since); },
+      Qt::QueuedConnection);
+}
+
 /**
  * Queries and registers the available characteristics for the currently
  * selected service.
@@ -490,6 +677,7 @@ void IO::Drivers::BluetoothLE::configureCharacteristics()
   m_characteristics.clear();
   m_characteristicNames.clear();
   m_selectedCharacteristic = -1;
+  clearSubscriptions();
 
   // Test & validate all service characteristics
   foreach (const QLowEnergyCharacteristic &c, m_service->characteristics())
@@ -629,14 +817,115 @@ void IO::Drivers::BluetoothLE::onServiceStateChanged(
     configureCharacteristics();
 }
 
+/**
+ * Adjusts the coalescing threshold to the payload size of a notification
+ * with the given @a mtu, so that a burst of full notifications is forwarded
+ * at once instead of waiting for the time window to expire.
+ */
+void IO::Drivers::BluetoothLE::onMtuChanged(const int mtu)
+{
+  const auto payload = qMax(kDefaultPayloadSize, mtu - 3);
+  setCoalescingThreshold(payload * kNotificationsPerFlush);
+}
+
+/**
+ * Asks the peripheral for the shortest connection interval allowed by the
+ * specification (7.5 ms) with no slave latency, which maximizes the number of
+ * notifications that can be delivered per second.
+ *
+ * Connection parameter updates are only supported on some platforms (e.g.
+ * Linux & Android), and the MTU is negotiated by the operating system when
+ * the connection is established, Qt reports the result through the
+ * @c QLowEnergyController::mtuChanged() signal.
+ */
+void IO::Drivers::BluetoothLE::requestLowLatencyConnection()
+{
+  if (!m_controller)
+    return;
+
+  QLowEnergyConnectionParameters params;
+  params.setIntervalRange(7.5, 15);
+  params.setLatency(0);
+  params.setSupervisionTimeout(4000);
+  m_controller->requestConnectionUpdate(params);
+
+  // The MTU may already have been negotiated
+  if (m_controller->mtu() > 0)
+    onMtuChanged(m_controller->mtu());
+}
+
 /**
  * Reads the transmitted data from the BLE service.
  */
 void IO::Drivers::BluetoothLE::onCharacteristicChanged(
     const QLowEnergyCharacteristic &info, const QByteArray &value)
 {
+  // Give each subscribed characteristic a lane of its own
+  if (!m_subscriptions.isEmpty())
+  {
+    const auto index = static_cast<int>(m_characteristics.indexOf(info));
+    if (m_subscriptions.contains(index))
+      queueNotification(index, value);
+
+    return;
+  }
+
+  // Read the selected characteristic as a single byte stream
   const bool anyCharacteristic = (m_selectedCharacteristic == -1);
-  const bool current = (info == m_characteristics.at(m_selectedCharacteristic));
+  const bool current
+      = !anyCharacteristic
+        && info == m_characteristics.at(m_selectedCharacteristic);
   if (anyCharacteristic || current)
     processData(value);
 }
+
+//------------------------------------------------------------------------------
+// Notification queue
+//------------------------------------------------------------------------------
+
+/**
+ * Starts the notification reader thread, if it is not running yet
+ */
+void IO::Drivers::BluetoothLE::startReader()
+{
+  if (!m_readerThread.isRunning())
+    m_readerThread.start(QThread::TimeCriticalPriority);
+}
+
+/**
+ * Unsubscribes from every characteristic & discards the queued notifications.
+ */
+void IO::Drivers::BluetoothLE::clearSubscriptions()
+{
+  m_notificationTimer.stop();
+  m_pendingNotifications.clear();
+  m_pendingBytes = 0;
+
+  if (!m_subscriptions.isEmpty())
+  {
+    m_subscriptions.clear();
+    Q_EMIT subscriptionsChanged();
+  }
+}
+
+/**
+ * @brief Queues the notification of the given @a characteristic until the
+ *        coalescing window expires or the coalescing threshold is reached.
+ */
+void IO::Drivers::BluetoothLE::queueNotification(const int characteristic,
+                                                 const QByteArray &value)
+{
+  if (value.isEmpty())
+    return;
+
+  if (m_pendingNotifications.isEmpty())
+    m_pendingSince = Misc::PipelineStats::timestamp();
+
+  m_pendingNotifications.append({characteristic, value});
+  m_pendingBytes += value.size();
+
+  if (m_pendingBytes >= coalescingThreshold())
+    flushNotifications();
+  else if (!m_notificationTimer.isActive())
+    m_notificationTimer.start(coalescingWindow());
+}
@@ -22,11 +22,16 @@
 
 #pragma once
 
+#include <QSet>
+#include <QTimer>
 #include <QObject>
+#include <QThread>
+#include <QVariantList>
 #include <QLowEnergyController>
 #include <QBluetoothDeviceDiscoveryAgent>
 
 #include "IO/HAL_Driver.h"
+#include "IO/Drivers/NotificationDemuxer.h"
 
 namespace IO
 {
@@ -35,6 +40,15 @@ namespace Drivers
 /**
  * @brief The BluetoothLE class
  * Serial Studio driver class to interact with Bluetooth Low Energy devices.
+ *
+ * By default, the driver reads the notifications of the selected
+ * characteristic (or of every characteristic if none is selected) as a single
+ * byte stream. Devices that spread their data across several characteristics
+ * can subscribe to them at once with @c setSubscribed(): the notifications of
+ * the subscribed characteristics are queued & handed in batches to a
+ * @c NotificationDemuxer, which extracts the frames of each characteristic
+ * with a frame reader of its own. Writes always go to the selected
+ * characteristic.
  */
 class BluetoothLE : public HAL_Driver
 {
@@ -66,6 +80,9 @@ class BluetoothLE : public HAL_Driver
              READ characteristicIndex
              WRITE setCharacteristicIndex
              NOTIFY characteristicIndexChanged)
+  Q_PROPERTY(QVariantList subscriptions
+             READ subscriptions
+             NOTIFY subscriptionsChanged)
   // clang-format on
 
 signals:
@@ -73,6 +90,7 @@ signals:
   void servicesChanged();
   void deviceIndexChanged();
   void characteristicsChanged();
+  void subscriptionsChanged();
   void deviceConnectedChanged();
   void characteristicIndexChanged();
   void error(const QString &message);
@@ -92,6 +110,7 @@ public:
   [[nodiscard]] bool isOpen() const override;
   [[nodiscard]] bool isReadable() const override;
   [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool supportsCoalescedWrites() const override;
   [[nodiscard]] bool configurationOk() const override;
   [[nodiscard]] quint64 write(const QByteArray &data) override;
   [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
@@ -102,6 +121,7 @@ public:
   [[nodiscard]] int deviceCount() const;
   [[nodiscard]] int deviceIndex() const;
   [[nodiscard]] int characteristicIndex() const;
+  [[nodiscard]] QVariantList subscriptions() const;
 
   [[nodiscard]] QStringList deviceNames() const;
   [[nodiscard]] QStringList serviceNames() const;
@@ -112,22 +132,40 @@ public slots:
   void selectDevice(const int index);
   void selectService(const int index);
   void setCharacteristicIndex(const int index);
+  void setSubscribed(const int index, const bool subscribed);
 
 private slots:
+  void flushNotifications();
   void configureCharacteristics();
   void onServiceDiscoveryFinished();
   void onDeviceDiscovered(const QBluetoothDeviceInfo &device);
   void onServiceError(QLowEnergyService::ServiceError serviceError);
   void onDiscoveryError(QBluetoothDeviceDiscoveryAgent::Error error);
   void onServiceStateChanged(QLowEnergyService::ServiceState serviceState);
+  void onMtuChanged(const int mtu);
+  void requestLowLatencyConnection();
   void onCharacteristicChanged(const QLowEnergyCharacteristic &info,
                                const QByteArray &value);
 
+private:
+  void startReader();
+  void clearSubscriptions();
+  void queueNotification(const int characteristic, const QByteArray &value);
+
 private:
   int m_deviceIndex;
   bool m_deviceConnected;
   int m_selectedCharacteristic;
 
+  qint64 m_pendingSince;
+  qsizetype m_pendingBytes;
+  QTimer m_notificationTimer;
+  QList<Notification> m_pendingNotifications;
+
+  QSet<int> m_subscriptions;
+  QThread m_readerThread;
+  NotificationDemuxer m_demuxer;
+
   QLowEnergyService *m_service;
   QLowEnergyController *m_controller;
   QBluetoothDeviceDiscoveryAgent *m_discoveryAgent;
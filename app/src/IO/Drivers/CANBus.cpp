@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QtEndian>
+#include <QCanBus>
+#include <QCanBusFrame>
+
+#include "IO/Manager.h"
+#include "IO/Drivers/CANBus.h"
+
+#include "JSON/FrameBuilder.h"
+#include "Misc/Utilities.h"
+
+/**
+ * Bit rates that can be selected by the user (in bits per second)
+ */
+static constexpr int kBitRates[] = {10000,  20000,  50000,  100000, 125000,
+                                    250000, 500000, 800000, 1000000};
+
+/**
+ * Index of the default bit rate (500 kbit/s)
+ */
+static constexpr int kDefaultBitRate = 6;
+
+/**
+ * Size of the message identifier written before the payload of each record
+ * & flag set in the identifier of extended frames
+ */
+static constexpr int kIdSize = 4;
+static constexpr quint32 kExtendedFlag = 0x80000000;
+
+/**
+ * Largest standard (11-bit) message identifier
+ */
+static constexpr quint32 kMaxStandardId = 0x7FF;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::CANBus::CANBus()
+  : m_pluginIndex(0)
+  , m_bitRateIndex(kDefaultBitRate)
+  , m_interfaceIndex(0)
+  , m_flexibleDataRate(false)
+  , m_device(nullptr)
+{
+  m_plugins = QCanBus::instance()->plugins();
+  refreshInterfaces();
+}
+
+/**
+ * Disconnects from the CAN interface before destroying the driver
+ */
+IO::Drivers::CANBus::~CANBus()
+{
+  close();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::CANBus &IO::Drivers::CANBus::instance()
+{
+  static CANBus singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Disconnects from the CAN interface & deletes the device object
+ */
+void IO::Drivers::CANBus::close()
+{
+  if (m_device)
+  {
+    m_device->disconnect(this);
+    m_device->disconnectDevice();
+    m_device->deleteLater();
+    m_device = nullptr;
+  }
+}
+
+/**
+ * Returns @c true if the CAN interface is connected
+ */
+bool IO::Drivers::CANBus::isOpen() const
+{
+  return m_device && m_device->state() == QCanBusDevice::ConnectedState;
+}
+
+/**
+ * Returns @c true if the CAN interface is connected
+ */
+bool IO::Drivers::CANBus::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c true if the CAN interface is connected
+ */
+bool IO::Drivers::CANBus::isWritable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c true if a plugin & an interface are selected
+ */
+bool IO::Drivers::CANBus::configurationOk() const
+{
+  return m_pluginIndex >= 0 && m_pluginIndex < m_plugins.count()
+         && m_interfaceIndex >= 0 && m_interfaceIndex < m_interfaces.count();
+}
+
+/**
+ * Returns the raw bit rate of the bus divided by eight, which is an upper
+ * bound of the record bytes produced per second.
+ */
+qint64 IO::Drivers::CANBus::dataRate() const
+{
+  return kBitRates[m_bitRateIndex] / 8;
+}
+
+/**
+ * Returns @c false, each write is sent as a CAN frame of its own
+ */
+bool IO::Drivers::CANBus::supportsCoalescedWrites() const
+{
+  return false;
+}
+
+/**
+ * @brief Sends a CAN frame.
+ *
+ * @param data Big-endian message identifier (4 bytes, bit 31 selects the
+ *             extended format) followed by the payload.
+ * @return The number of payload bytes queued for transmission.
+ */
+quint64 IO::Drivers::CANBus::write(const QByteArray &data)
+{
+  if (!isWritable() || data.size() < kIdSize)
+    return 0;
+
+  // Build the frame
+  const auto id = qFromBigEndian<quint32>(data.constData());
+  const auto frameId = id & ~kExtendedFlag;
+  const bool extended = (id & kExtendedFlag) || frameId > kMaxStandardId;
+  QCanBusFrame frame(frameId, data.mid(kIdSize));
+  frame.setExtendedFrameFormat(extended);
+  frame.setFlexibleDataRateFormat(m_flexibleDataRate
+                                  && frame.payload().size() > 8);
+
+  // Send the frame
+  if (!m_device->writeFrame(frame))
+    return 0;
+
+  Q_EMIT dataSent(data);
+  return frame.payload().size();
+}
+
+/**
+ * @brief Connects to the selected CAN interface.
+ *
+ * The bit rate, the CAN FD setting & the acceptance filters of the project
+ * are configured before connecting.
+ *
+ * @return @c true if the interface is connected (or connecting).
+ */
+bool IO::Drivers::CANBus::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+  close();
+
+  // Validate the configuration
+  if (!configurationOk())
+    return false;
+
+  // Create the device
+  QString error;
+  const auto &plugin = m_plugins.at(m_pluginIndex);
+  const auto &name = m_interfaces.at(m_interfaceIndex);
+  m_device = QCanBus::instance()->createDevice(plugin, name, &error);
+  if (!m_device)
+  {
+    Misc::Utilities::showMessageBox(tr("CAN bus error"), error);
+    return false;
+  }
+
+  // Configure the interface
+  m_device->setConfigurationParameter(QCanBusDevice::BitRateKey,
+                                      kBitRates[m_bitRateIndex]);
+  m_device->setConfigurationParameter(QCanBusDevice::CanFdKey,
+                                      m_flexibleDataRate);
+
+  // Let the kernel or the adapter discard messages that are not decoded
+  const auto filters = projectFilters();
+  if (!filters.isEmpty())
+    m_device->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                        QVariant::fromValue(filters));
+
+  // Read frames in batches
+  connect(m_device, &QCanBusDevice::framesReceived, this,
+          &IO::Drivers::CANBus::onFramesReceived);
+  connect(m_device, &QCanBusDevice::errorOccurred, this,
+          &IO::Drivers::CANBus::onErrorOccurred);
+
+  // Connect to the bus
+  if (!m_device->connectDevice())
+  {
+    error = m_device->errorString();
+    close();
+    Misc::Utilities::showMessageBox(tr("CAN bus error"), error);
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the index of the selected plugin, in the list returned by
+ * @c availablePlugins().
+ */
+int IO::Drivers::CANBus::pluginIndex() const
+{
+  return m_pluginIndex;
+}
+
+/**
+ * Returns the index of the selected bit rate, in the list returned by
+ * @c availableBitRates().
+ */
+int IO::Drivers::CANBus::bitRateIndex() const
+{
+  return m_bitRateIndex;
+}
+
+/**
+ * Returns the index of the selected interface, in the list returned by
+ * @c availableInterfaces().
+ */
+int IO::Drivers::CANBus::interfaceIndex() const
+{
+  return m_interfaceIndex;
+}
+
+/**
+ * Returns @c true if CAN FD frames (up to 64 bytes) are enabled
+ */
+bool IO::Drivers::CANBus::flexibleDataRate() const
+{
+  return m_flexibleDataRate;
+}
+
+/**
+ * Returns the Qt Serial Bus plugins that are available in this system
+ */
+QStringList IO::Drivers::CANBus::availablePlugins() const
+{
+  return m_plugins;
+}
+
+/**
+ * Returns the list of bit rates that can be selected by the user
+ */
+QStringList IO::Drivers::CANBus::availableBitRates() const
+{
+  QStringList list;
+  for (const auto rate : kBitRates)
+  {
+    if (rate >= 1000000)
+      list.append(tr("%1 Mbit/s").arg(rate / 1000000));
+    else
+      list.append(tr("%1 kbit/s").arg(rate / 1000));
+  }
+
+  return list;
+}
+
+/**
+ * Returns the interfaces found by the selected plugin
+ */
+QStringList IO::Drivers::CANBus::availableInterfaces() const
+{
+  return m_interfaces;
+}
+
+/**
+ * Scans the interfaces available through the selected plugin
+ */
+void IO::Drivers::CANBus::refreshInterfaces()
+{
+  QStringList interfaces;
+  if (m_pluginIndex >= 0 && m_pluginIndex < m_plugins.count())
+  {
+    const auto &plugin = m_plugins.at(m_pluginIndex);
+    for (const auto &info : QCanBus::instance()->availableDevices(plugin))
+      interfaces.append(info.name());
+  }
+
+  if (interfaces != m_interfaces)
+  {
+    m_interfaces = interfaces;
+    Q_EMIT availableInterfacesChanged();
+    Q_EMIT configurationChanged();
+  }
+}
+
+/**
+ * Changes the plugin used to access the CAN interface & scans its interfaces
+ */
+void IO::Drivers::CANBus::setPluginIndex(const int index)
+{
+  if (index == m_pluginIndex)
+    return;
+
+  m_pluginIndex = index;
+  m_interfaceIndex = 0;
+  refreshInterfaces();
+
+  Q_EMIT pluginIndexChanged();
+  Q_EMIT interfaceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the bit rate used when connecting to the bus
+ */
+void IO::Drivers::CANBus::setBitRateIndex(const int index)
+{
+  const auto count = static_cast<int>(std::size(kBitRates));
+  if (index < 0 || index >= count || index == m_bitRateIndex)
+    return;
+
+  m_bitRateIndex = index;
+  Q_EMIT bitRateIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the selected CAN interface
+ */
+void IO::Drivers::CANBus::setInterfaceIndex(const int index)
+{
+  if (index == m_interfaceIndex)
+    return;
+
+  m_interfaceIndex = index;
+  Q_EMIT interfaceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Enables or disables CAN FD frames when connecting to the bus
+ */
+void IO::Drivers::CANBus::setFlexibleDataRate(const bool enabled)
+{
+  if (enabled == m_flexibleDataRate)
+    return;
+
+  m_flexibleDataRate = enabled;
+  Q_EMIT flexibleDataRateChanged();
+  Q_EMIT configurationChanged();
+}
+
+//------------------------------------------------------------------------------
+// Frame reception
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Forwards the data frames received since the last call.
+ *
+ * All pending frames are encoded as length-prefixed records into a single
+ * buffer, which is handed over to the frame reader at once. Error, remote
+ * request & invalid frames are not forwarded.
+ */
+void IO::Drivers::CANBus::onFramesReceived()
+{
+  if (!m_device)
+    return;
+
+  // Encode every pending data frame
+  QByteArray batch;
+  const auto frames = m_device->readAllFrames();
+  batch.reserve(frames.count() * (1 + kIdSize + 8));
+  for (const auto &frame : frames)
+  {
+    if (!frame.isValid() || frame.frameType() != QCanBusFrame::DataFrame)
+      continue;
+
+    // Identifier, with the extended format in its most significant bit
+    auto id = frame.frameId();
+    if (frame.hasExtendedFrameFormat())
+      id |= kExtendedFlag;
+
+    // Write the record
+    const auto payload = frame.payload();
+    char header[1 + kIdSize];
+    header[0] = static_cast<char>(kIdSize + payload.size());
+    qToBigEndian<quint32>(id, header + 1);
+    batch.append(header, sizeof(header));
+    batch.append(payload);
+  }
+
+  // Hand the batch over to the frame reader
+  if (!batch.isEmpty())
+    processData(std::move(batch));
+}
+
+/**
+ * Disconnects from the bus & displays the error in a message box
+ */
+void IO::Drivers::CANBus::onErrorOccurred(QCanBusDevice::CanBusError error)
+{
+  // Errors reported while reading or writing frames are not fatal
+  if (error == QCanBusDevice::ReadError || error == QCanBusDevice::WriteError
+      || error == QCanBusDevice::NoError || !m_device)
+    return;
+
+  const auto message = m_device->errorString();
+  Manager::instance().disconnectDevice();
+  Misc::Utilities::showMessageBox(tr("CAN bus error"), message);
+}
+
+/**
+ * @brief Returns the acceptance filters of the loaded project.
+ *
+ * One filter that matches the exact identifier (and format) is created for
+ * each message decoded by the native parser. No filters are returned if the
+ * project does not use a CAN parser, in which case all frames are received.
+ */
+QList<QCanBusDevice::Filter> IO::Drivers::CANBus::projectFilters() const
+{
+  QList<QCanBusDevice::Filter> filters;
+  const auto &builder = JSON::FrameBuilder::instance();
+  if (builder.operationMode() != SerialStudio::ProjectFile)
+    return filters;
+
+  const auto &parser = builder.nativeParser();
+  if (parser.mode() != JSON::NativeParser::Mode::Can)
+    return filters;
+
+  for (const auto id : parser.canIds())
+  {
+    QCanBusDevice::Filter filter;
+    filter.frameId = id;
+    filter.frameIdMask = 0x1FFFFFFF;
+    filter.type = QCanBusFrame::DataFrame;
+    filter.format = id > kMaxStandardId
+                        ? QCanBusDevice::Filter::MatchExtendedFormat
+                        : QCanBusDevice::Filter::MatchBaseAndExtendedFormat;
+    filters.append(filter);
+  }
+
+  return filters;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QByteArray>
+#include <QStringList>
+#include <QCanBusDevice>
+
+#include "IO/HAL_Driver.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The CANBus class
+ *
+ * Serial Studio driver for CAN bus interfaces, using the plugins of the Qt
+ * Serial Bus module (e.g. SocketCAN, PEAK PCAN or Vector).
+ *
+ * Each received data frame is forwarded as a binary record: a one-byte
+ * length, the big-endian identifier of the message (bit 31 is set for
+ * extended identifiers) & the payload. Projects decode these records with
+ * the length-prefixed frame detection (one-byte length field, no header) and
+ * the @c "can" mode of the native parser, which maps the payload of each
+ * message identifier to its own columns without any text framing.
+ *
+ * When a project with a CAN parser is loaded, the identifiers of its
+ * messages are given to the interface as acceptance filters, so that the
+ * kernel or the adapter discards all other traffic before it reaches the
+ * application (on plugins that support raw filters). Frames are read in
+ * batches, each time the interface reports new frames.
+ *
+ * Data written to the device uses the same layout without the length byte,
+ * i.e. a four-byte identifier followed by the payload.
+ */
+class CANBus : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int pluginIndex
+             READ pluginIndex
+             WRITE setPluginIndex
+             NOTIFY pluginIndexChanged)
+  Q_PROPERTY(int interfaceIndex
+             READ interfaceIndex
+             WRITE setInterfaceIndex
+             NOTIFY interfaceIndexChanged)
+  Q_PROPERTY(int bitRateIndex
+             READ bitRateIndex
+             WRITE setBitRateIndex
+             NOTIFY bitRateIndexChanged)
+  Q_PROPERTY(bool flexibleDataRate
+             READ flexibleDataRate
+             WRITE setFlexibleDataRate
+             NOTIFY flexibleDataRateChanged)
+  Q_PROPERTY(QStringList availablePlugins
+             READ availablePlugins
+             CONSTANT)
+  Q_PROPERTY(QStringList availableInterfaces
+             READ availableInterfaces
+             NOTIFY availableInterfacesChanged)
+  Q_PROPERTY(QStringList availableBitRates
+             READ availableBitRates
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void pluginIndexChanged();
+  void bitRateIndexChanged();
+  void interfaceIndexChanged();
+  void flexibleDataRateChanged();
+  void availableInterfacesChanged();
+
+private:
+  explicit CANBus();
+  CANBus(CANBus &&) = delete;
+  CANBus(const CANBus &) = delete;
+  CANBus &operator=(CANBus &&) = delete;
+  CANBus &operator=(const CANBus &) = delete;
+
+  ~CANBus();
+
+public:
+  static CANBus &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] qint64 dataRate() const override;
+  [[nodiscard]] bool supportsCoalescedWrites() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] int pluginIndex() const;
+  [[nodiscard]] int bitRateIndex() const;
+  [[nodiscard]] int interfaceIndex() const;
+  [[nodiscard]] bool flexibleDataRate() const;
+
+  [[nodiscard]] QStringList availablePlugins() const;
+  [[nodiscard]] QStringList availableBitRates() const;
+  [[nodiscard]] QStringList availableInterfaces() const;
+
+public slots:
+  void refreshInterfaces();
+  void setPluginIndex(const int index);
+  void setBitRateIndex(const int index);
+  void setInterfaceIndex(const int index);
+  void setFlexibleDataRate(const bool enabled);
+
+private slots:
+  void onFramesReceived();
+  void onErrorOccurred(QCanBusDevice::CanBusError error);
+
+private:
+  [[nodiscard]] QList<QCanBusDevice::Filter> projectFilters() const;
+
+private:
+  int m_pluginIndex;
+  int m_bitRateIndex;
+  int m_interfaceIndex;
+  bool m_flexibleDataRate;
+
+  QCanBusDevice *m_device;
+  QStringList m_plugins;
+  QStringList m_interfaces;
+};
+} // namespace Drivers
+} // namespace IO
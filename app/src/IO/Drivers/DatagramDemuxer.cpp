@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IO/FrameReader.h"
+#include "IO/Drivers/DatagramDemuxer.h"
+
+#include "Misc/PipelineStats.h"
+
+/**
+ * Maximum number of senders with a lane of their own, datagrams of further
+ * senders are dropped
+ */
+static constexpr qsizetype kMaxSenders = 1024;
+
+/**
+ * Constructor function
+ */
+IO::Drivers::DatagramDemuxer::DatagramDemuxer()
+  : m_nextSource(1)
+  , m_bufferCapacity(0)
+  , m_overflowPolicy(SerialStudio::OverflowDropOldest)
+{
+}
+
+/**
+ * @brief Hands each of the given @a datagrams to the lane of its sender.
+ *
+ * Must be called from the thread of the demuxer.
+ *
+ * @param datagrams Datagrams received by the socket, in order.
+ * @param timestamp Time at which the datagrams were read from the socket.
+ */
+void IO::Drivers::DatagramDemuxer::processDatagrams(
+    const QList<IO::Drivers::Datagram> &datagrams, const qint64 timestamp)
+{
+  quint64 dropped = 0;
+  for (const auto &datagram : datagrams)
+  {
+    if (datagram.data.isEmpty())
+      continue;
+
+    auto *reader = lane({datagram.sender, datagram.port});
+    if (reader)
+      reader->processData(datagram.data, timestamp);
+    else
+      ++dropped;
+  }
+
+  if (dropped > 0)
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::DriverReceive, dropped);
+}
+
+/**
+ * Removes the lanes of every sender, must run in the thread of the demuxer.
+ */
+void IO::Drivers::DatagramDemuxer::reset()
+{
+  for (auto *reader : std::as_const(m_lanes))
+    reader->deleteLater();
+
+  m_lanes.clear();
+  m_nextSource = 1;
+  Q_EMIT senderCountChanged(0);
+}
+
+/**
+ * @brief Sets the frame detection & buffer settings of the lanes created from
+ *        now on.
+ */
+void IO::Drivers::DatagramDemuxer::configure(
+    const QString &start, const QString &finish, const qsizetype capacity,
+    const SerialStudio::BufferOverflowPolicy policy)
+{
+  m_startSequence = start;
+  m_finishSequence = finish;
+  m_bufferCapacity = capacity;
+  m_overflowPolicy = policy;
+}
+
+/**
+ * @brief Returns the frame reader of the sender identified by @a key,
+ *        creating its lane when the first datagram of the sender arrives.
+ *
+ * @return The frame reader of the lane, or @c nullptr if too many senders
+ *         have a lane already.
+ */
+IO::FrameReader *IO::Drivers::DatagramDemuxer::lane(const SenderKey &key)
+{
+  // Lane already exists
+  auto it = m_lanes.constFind(key);
+  if (it != m_lanes.constEnd())
+    return it.value();
+
+  // Too many senders
+  if (m_lanes.count() >= kMaxSenders)
+    return nullptr;
+
+  // Create the frame reader of the sender
+  auto *reader = new IO::FrameReader(this);
+  reader->setupExternalConnections();
+  reader->setStartSequence(m_startSequence);
+  reader->setFinishSequence(m_finishSequence);
+  reader->setBufferCapacity(m_bufferCapacity);
+  reader->setOverflowPolicy(m_overflowPolicy);
+
+  // Tag the frames of the sender with its source
+  const auto source = m_nextSource++;
+  connect(reader, &IO::FrameReader::framesReady, this,
+          [this, source](const IO::FrameBatch &frames) {
+            auto tagged = frames;
+            for (auto &frame : tagged)
+              frame.source = source;
+
+            Q_EMIT framesReady(tagged);
+          });
+
+  m_lanes.insert(key, reader);
+  Q_EMIT senderCountChanged(static_cast<int>(m_lanes.count()));
+  return reader;
+}
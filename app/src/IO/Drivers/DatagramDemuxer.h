@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QObject>
+#include <QHostAddress>
+
+#include "SerialStudio.h"
+#include "IO/FrameBatch.h"
+
+namespace IO
+{
+class FrameReader;
+
+namespace Drivers
+{
+/**
+ * @brief A datagram & the address of the device that sent it.
+ */
+struct Datagram
+{
+  QHostAddress sender;
+  quint16 port;
+  QByteArray data;
+};
+
+/**
+ * @brief The DatagramDemuxer class
+ *
+ * Separates the datagrams received by the UDP socket of the
+ * @c IO::Drivers::Network driver by sender (address & port), so that several
+ * devices can send to the same port or multicast group without their frames
+ * being interleaved.
+ *
+ * Each sender gets its own lane, i.e. a @c IO::FrameReader of its own, and is
+ * numbered as a data source (starting at 1, in order of arrival). The demuxer
+ * & its frame readers live in the UDP reader thread of the driver, and the
+ * frames of every lane are emitted through @c framesReady() tagged with their
+ * source.
+ */
+class DatagramDemuxer : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void senderCountChanged(const int count);
+  void framesReady(const IO::FrameBatch &frames);
+
+public:
+  explicit DatagramDemuxer();
+
+  void processDatagrams(const QList<IO::Drivers::Datagram> &datagrams,
+                        const qint64 timestamp);
+
+public slots:
+  void reset();
+  void configure(const QString &start, const QString &finish,
+                 const qsizetype capacity,
+                 const SerialStudio::BufferOverflowPolicy policy);
+
+private:
+  using SenderKey = QPair<QHostAddress, quint16>;
+  [[nodiscard]] IO::FrameReader *lane(const SenderKey &key);
+
+private:
+  int m_nextSource;
+  QString m_startSequence;
+  QString m_finishSequence;
+  qsizetype m_bufferCapacity;
+  SerialStudio::BufferOverflowPolicy m_overflowPolicy;
+
+  QHash<SenderKey, IO::FrameReader *> m_lanes;
+};
+} // namespace Drivers
+} // namespace IO
@@ -0,0 +1,618 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include <QtEndian>
+#include <QRandomGenerator>
+
+#include "IO/Manager.h"
+#include "IO/Checksum.h"
+#include "IO/Framing.h"
+#include "IO/Drivers/Generator.h"
+
+#include "JSON/FrameBuilder.h"
+#include "JSON/ProjectModel.h"
+
+/**
+ * Frame rates that can be selected by the user, zero means unthrottled
+ */
+static constexpr qint64 kFrameRates[] = {100, 1000, 10000, 100000, 1000000, 0};
+
+/**
+ * Number of frames in a rendered signal period
+ */
+static constexpr int kPatternFrames = 1000;
+
+/**
+ * Maximum number of channels per frame
+ */
+static constexpr int kMaxChannels = 256;
+
+/**
+ * Number of levels of the step signal
+ */
+static constexpr int kStepLevels = 5;
+
+/**
+ * Peak amplitude of the generated signals
+ */
+static constexpr double kAmplitude = 100;
+
+/**
+ * Maximum size of a chunk sent to the frame reader (in bytes)
+ */
+static constexpr qsizetype kMaxChunkSize = 256 * 1024;
+
+/**
+ * Maximum number of frames emitted per tick when each frame is sent as its
+ * own chunk (project mode without delimiters)
+ */
+static constexpr qsizetype kMaxSplitFrames = 1024;
+
+/**
+ * Minimum & maximum time between two generator ticks (in milliseconds)
+ */
+static constexpr qreal kMinWait = 1;
+static constexpr qreal kMaxWait = 100;
+
+/**
+ * Appends the checksum trailer of @a data expected by the frame reader, e.g.
+ * "crc16:" followed by the big-endian checksum bytes.
+ */
+static void appendChecksum(QByteArray &frame, const QByteArray &data,
+                           const int checksum)
+{
+  quint32 crc = 0;
+  qsizetype bytes = 0;
+  if (checksum == 1)
+  {
+    frame.append("crc8:");
+    crc = IO::crc8(data.constData(), data.length());
+    bytes = 1;
+  }
+
+  else if (checksum == 2)
+  {
+    frame.append("crc16:");
+    crc = IO::crc16(data.constData(), data.length());
+    bytes = 2;
+  }
+
+  else if (checksum == 3)
+  {
+    frame.append("crc32:");
+    crc = IO::crc32(data.constData(), data.length());
+    bytes = 4;
+  }
+
+  for (auto i = bytes - 1; i >= 0; --i)
+    frame.append(static_cast<char>((crc >> (8 * i)) & 0xFF));
+}
+
+/**
+ * Returns @a data with the checksum declared by the @a project stored in its
+ * first or last bytes, as expected by the frame reader.
+ */
+static QByteArray declareChecksum(const QByteArray &data,
+                                  const JSON::ProjectModel &project)
+{
+  const auto type = project.checksumAlgorithm();
+  const auto width = IO::checksumLength(type);
+  const auto start = project.checksumStart();
+  const auto covered = data.size() - start - project.checksumEnd();
+  if (width == 0 || covered < 0)
+    return data;
+
+  const auto crc = IO::checksum(type, data.constData() + start,
+                                static_cast<int>(covered));
+
+  QByteArray field;
+  for (int i = 0; i < width; ++i)
+  {
+    const int shift
+        = project.checksumBigEndian() ? 8 * (width - 1 - i) : 8 * i;
+    field.append(static_cast<char>((crc >> shift) & 0xFF));
+  }
+
+  if (project.checksumPosition() == SerialStudio::ChecksumHeader)
+    return field + data;
+
+  return data + field;
+}
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::Generator::Generator()
+  : m_open(false)
+  , m_waveform(static_cast<int>(Waveform::Sine))
+  , m_channels(8)
+  , m_checksum(0)
+  , m_frameRate(1)
+  , m_splitFrames(false)
+  , m_position(0)
+  , m_framesPerChunk(1)
+  , m_emittedFrames(0)
+{
+  // Chunks are already large, forward them to the frame reader right away
+  setCoalescingWindow(0);
+
+  m_generatorTimer.setSingleShot(true);
+  m_generatorTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_generatorTimer, &QTimer::timeout, this,
+          &IO::Drivers::Generator::onGeneratorTick);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::Generator &IO::Drivers::Generator::instance()
+{
+  static Generator singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Stops the generator & frees the rendered signal period
+ */
+void IO::Drivers::Generator::close()
+{
+  m_open = false;
+  m_generatorTimer.stop();
+
+  m_pattern.clear();
+  m_pattern.squeeze();
+  m_frameOffsets.clear();
+  m_frameOffsets.squeeze();
+}
+
+/**
+ * Returns @c true if the generator is running
+ */
+bool IO::Drivers::Generator::isOpen() const
+{
+  return m_open;
+}
+
+/**
+ * Returns @c true if the generator is running
+ */
+bool IO::Drivers::Generator::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c false, data sent to the generator is discarded
+ */
+bool IO::Drivers::Generator::isWritable() const
+{
+  return false;
+}
+
+/**
+ * Returns @c true, the generator needs no external resources
+ */
+bool IO::Drivers::Generator::configurationOk() const
+{
+  return true;
+}
+
+/**
+ * Discards the given @a data, since there is no device to write it to
+ */
+quint64 IO::Drivers::Generator::write(const QByteArray &data)
+{
+  (void)data;
+  return 0;
+}
+
+/**
+ * @brief Renders the signal period & starts generating frames.
+ *
+ * The framing of each frame is obtained from the current operation mode,
+ * frame detection method & start/finish sequences, so these settings should
+ * be changed while the generator is disconnected.
+ *
+ * @return @c true, opening the generator cannot fail.
+ */
+bool IO::Drivers::Generator::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+
+  close();
+  renderPattern();
+  restartClock();
+
+  m_open = true;
+  m_generatorTimer.start(0);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the index of the selected signal, in the list returned by
+ * @c availableWaveforms().
+ */
+int IO::Drivers::Generator::waveform() const
+{
+  return m_waveform;
+}
+
+/**
+ * Returns the number of values generated per frame
+ */
+int IO::Drivers::Generator::channels() const
+{
+  return m_channels;
+}
+
+/**
+ * Returns the index of the checksum appended to each frame, in the list
+ * returned by @c availableChecksums().
+ */
+int IO::Drivers::Generator::checksum() const
+{
+  return m_checksum;
+}
+
+/**
+ * Returns the index of the selected frame rate, in the list returned by
+ * @c availableFrameRates().
+ */
+int IO::Drivers::Generator::frameRate() const
+{
+  return m_frameRate;
+}
+
+/**
+ * Returns the list of signals that can be generated
+ */
+QStringList IO::Drivers::Generator::availableWaveforms() const
+{
+  return {tr("Sine"), tr("Noise"), tr("Step"), tr("Packed Binary")};
+}
+
+/**
+ * Returns the list of checksums that can be appended to each frame
+ */
+QStringList IO::Drivers::Generator::availableChecksums() const
+{
+  return {tr("None"), tr("CRC-8"), tr("CRC-16"), tr("CRC-32")};
+}
+
+/**
+ * Returns the list of frame rates that can be selected by the user
+ */
+QStringList IO::Drivers::Generator::availableFrameRates() const
+{
+  return {tr("100 Hz"),  tr("1 kHz"), tr("10 kHz"),
+          tr("100 kHz"), tr("1 MHz"), tr("Unthrottled")};
+}
+
+/**
+ * Changes the generated signal, the signal period is rendered again if the
+ * generator is running.
+ */
+void IO::Drivers::Generator::setWaveform(const int waveform)
+{
+  m_waveform = std::clamp(waveform, 0, static_cast<int>(Waveform::Binary));
+  Q_EMIT waveformChanged();
+
+  if (isOpen())
+    renderPattern();
+}
+
+/**
+ * Changes the number of values generated per frame, the signal period is
+ * rendered again if the generator is running.
+ */
+void IO::Drivers::Generator::setChannels(const int channels)
+{
+  m_channels = std::clamp(channels, 1, kMaxChannels);
+  Q_EMIT channelsChanged();
+
+  if (isOpen())
+    renderPattern();
+}
+
+/**
+ * Changes the checksum appended to each frame, the signal period is rendered
+ * again if the generator is running.
+ */
+void IO::Drivers::Generator::setChecksum(const int checksum)
+{
+  m_checksum = std::clamp(checksum, 0, 3);
+  Q_EMIT checksumChanged();
+
+  if (isOpen())
+    renderPattern();
+}
+
+/**
+ * Changes the frame rate, the generator clock is restarted so that changing
+ * the rate neither skips nor bursts frames.
+ */
+void IO::Drivers::Generator::setFrameRate(const int frameRate)
+{
+  const auto count = static_cast<int>(std::size(kFrameRates));
+  m_frameRate = std::clamp(frameRate, 0, count - 1);
+  Q_EMIT frameRateChanged();
+
+  if (isOpen())
+  {
+    restartClock();
+    m_generatorTimer.start(0);
+  }
+}
+
+/**
+ * @brief Emits every frame that is due.
+ *
+ * The number of frames to emit is derived from the elapsed time & the
+ * selected frame rate, and limited to the size of a single chunk. When the
+ * generator falls behind (or runs unthrottled), the next tick runs as soon as
+ * the event loop has processed the previous chunk.
+ */
+void IO::Drivers::Generator::onGeneratorTick()
+{
+  // Generator stopped
+  if (!isOpen())
+    return;
+
+  // Unthrottled generation, emit a full chunk & run again
+  const auto rate = kFrameRates[m_frameRate];
+  if (rate <= 0)
+  {
+    emitFrames(m_framesPerChunk);
+    m_generatorTimer.start(0);
+    return;
+  }
+
+  // Emit the frames that are due
+  const auto elapsed = m_generatorClock.nsecsElapsed();
+  const auto target = static_cast<qint64>(elapsed * (rate / 1e9));
+  const auto due = target - m_emittedFrames;
+  emitFrames(std::min<qint64>(due, m_framesPerChunk));
+
+  // Still behind, run again as soon as possible
+  if (due > m_framesPerChunk)
+  {
+    m_generatorTimer.start(0);
+    return;
+  }
+
+  // Wait until the next frame is due
+  const auto next = (m_emittedFrames + 1) * (1e9 / rate);
+  const auto wait = (next - m_generatorClock.nsecsElapsed()) / 1e6;
+  m_generatorTimer.start(static_cast<int>(qBound(kMinWait, wait, kMaxWait)));
+}
+
+/**
+ * @brief Renders a full signal period with the framing of the frame reader.
+ *
+ * Quick plot frames end with a line break, JSON frames are surrounded by the
+ * start & finish sequences, and project frames use the configured frame
+ * detection method. Checksums declared by the project are stored within the
+ * payload. Otherwise, the checksum trailer is only appended to frames that
+ * have a finish sequence or a length prefix, COBS & SLIP frames are sent
+ * without checksum.
+ */
+void IO::Drivers::Generator::renderPattern()
+{
+  // Obtain the framing expected by the frame reader
+  QByteArray start;
+  QByteArray finish;
+  const auto &manager = IO::Manager::instance();
+  const auto mode = JSON::FrameBuilder::instance().operationMode();
+  const auto &project = JSON::ProjectModel::instance();
+  const auto detection = project.frameDetection();
+  const bool encoded = mode == SerialStudio::ProjectFile
+                       && (detection == SerialStudio::LengthPrefixed
+                           || detection == SerialStudio::CobsEncoded
+                           || detection == SerialStudio::SlipEncoded);
+  const bool declared = mode == SerialStudio::ProjectFile
+                        && project.checksumAlgorithm()
+                               != SerialStudio::ChecksumAuto;
+  const auto trailer = declared ? 0 : m_checksum;
+  if (mode == SerialStudio::QuickPlot)
+    finish = QByteArrayLiteral("\n");
+
+  else if (mode == SerialStudio::DeviceSendsJSON
+           || detection == SerialStudio::StartAndEndDelimiter)
+  {
+    start = manager.startSequence().toUtf8();
+    finish = manager.finishSequence().toUtf8();
+  }
+
+  else if (detection == SerialStudio::EndDelimiterOnly)
+    finish = manager.finishSequence().toUtf8();
+
+  // Render each frame of the signal period
+  m_pattern.clear();
+  m_frameOffsets.clear();
+  m_frameOffsets.reserve(kPatternFrames + 1);
+  for (int i = 0; i < kPatternFrames; ++i)
+  {
+    const auto data = declared ? declareChecksum(payload(i), project)
+                               : payload(i);
+    m_frameOffsets.append(m_pattern.size());
+    if (encoded)
+    {
+      if (detection == SerialStudio::CobsEncoded)
+        m_pattern.append(IO::cobsEncode(data));
+
+      else if (detection == SerialStudio::SlipEncoded)
+        m_pattern.append(IO::slipEncode(data));
+
+      else
+      {
+        m_pattern.append(IO::lengthPrefix(project.frameHeader(), data,
+                                          project.lengthFieldSize(),
+                                          project.lengthBigEndian()));
+        appendChecksum(m_pattern, data, trailer);
+      }
+
+      continue;
+    }
+
+    m_pattern.append(start);
+    m_pattern.append(data);
+    m_pattern.append(finish);
+    if (!finish.isEmpty())
+      appendChecksum(m_pattern, data, trailer);
+  }
+
+  m_frameOffsets.append(m_pattern.size());
+
+  // Frames without delimiters must reach the frame reader one by one
+  m_position = 0;
+  m_splitFrames = finish.isEmpty() && !encoded;
+  if (m_splitFrames)
+    m_framesPerChunk = kMaxSplitFrames;
+  else
+  {
+    const auto size = std::max<qsizetype>(1, m_pattern.size() / kPatternFrames);
+    m_framesPerChunk = std::max<qsizetype>(1, kMaxChunkSize / size);
+  }
+}
+
+/**
+ * Restarts the timeline used to throttle the generator
+ */
+void IO::Drivers::Generator::restartClock()
+{
+  m_emittedFrames = 0;
+  m_generatorClock.start();
+}
+
+/**
+ * @brief Sends @a count consecutive frames of the signal period.
+ *
+ * Frames are copied into a single chunk, wrapping around the end of the
+ * period, unless frames have no delimiters, in which case every frame is
+ * sent on its own.
+ */
+void IO::Drivers::Generator::emitFrames(qsizetype count)
+{
+  // Nothing to do
+  if (count <= 0 || m_frameOffsets.count() < 2)
+    return;
+
+  // Send every frame on its own
+  m_emittedFrames += count;
+  const auto frames = m_frameOffsets.count() - 1;
+  if (m_splitFrames)
+  {
+    for (qsizetype i = 0; i < count; ++i)
+    {
+      const auto begin = m_frameOffsets[m_position];
+      const auto end = m_frameOffsets[m_position + 1];
+      processData(QByteArray(m_pattern.constData() + begin, end - begin));
+      m_position = (m_position + 1) % frames;
+    }
+
+    return;
+  }
+
+  // Copy consecutive frames into a single chunk
+  QByteArray chunk;
+  chunk.reserve(count * (m_pattern.size() / frames + 1));
+  while (count > 0)
+  {
+    const auto n = std::min(count, frames - m_position);
+    const auto begin = m_frameOffsets[m_position];
+    const auto end = m_frameOffsets[m_position + n];
+    chunk.append(m_pattern.constData() + begin, end - begin);
+    m_position = (m_position + n) % frames;
+    count -= n;
+  }
+
+  processData(std::move(chunk));
+}
+
+/**
+ * @brief Generates the values of the given @a frame of the signal period.
+ *
+ * Every channel is phase-shifted, so that channels can be told apart in the
+ * dashboard. Text signals are formatted as comma-separated values, the binary
+ * signal packs a sine wave as little-endian 32-bit floats.
+ */
+QByteArray IO::Drivers::Generator::payload(const int frame) const
+{
+  QByteArray data;
+  const auto waveform = static_cast<Waveform>(m_waveform);
+  const auto phase = static_cast<double>(frame) / kPatternFrames;
+  for (int channel = 0; channel < m_channels; ++channel)
+  {
+    // Calculate the value of the channel
+    double value = 0;
+    const auto shift = static_cast<double>(channel) / m_channels;
+    if (waveform == Waveform::Noise)
+    {
+      const auto random = QRandomGenerator::global()->generateDouble();
+      value = kAmplitude * (random * 2 - 1);
+    }
+
+    else if (waveform == Waveform::Step)
+    {
+      const auto step = static_cast<int>((phase + shift) * kStepLevels);
+      const auto level = step % kStepLevels;
+      value = kAmplitude * (2.0 * level / (kStepLevels - 1) - 1);
+    }
+
+    else
+      value = kAmplitude * std::sin(2 * M_PI * (phase + shift));
+
+    // Pack the value as a little-endian float
+    if (waveform == Waveform::Binary)
+    {
+      char bytes[sizeof(float)];
+      qToLittleEndian<float>(static_cast<float>(value), bytes);
+      data.append(bytes, sizeof(bytes));
+    }
+
+    // Append the value as text
+    else
+    {
+      if (channel > 0)
+        data.append(',');
+
+      data.append(QByteArray::number(value, 'f', 3));
+    }
+  }
+
+  return data;
+}
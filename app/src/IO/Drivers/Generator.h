@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QVector>
+#include <QByteArray>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "IO/HAL_Driver.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The Generator class
+ *
+ * Serial Studio "driver" class that produces synthetic frames, so that the
+ * frame reader, parsers, dashboard & exporters can be profiled without any
+ * hardware attached. Each frame contains one value per channel, either as
+ * comma-separated text (sine, noise or step signals) or as packed
+ * little-endian 32-bit floats (binary signal).
+ *
+ * Frames are framed the same way the frame reader expects them when the
+ * device is connected: quick plot mode uses line breaks, and project mode
+ * uses the configured start/finish sequences, followed by an optional
+ * CRC-8/16/32 trailer.
+ *
+ * To reach rates of hundreds of MB/s, a full signal period is rendered once
+ * when the driver is opened (or reconfigured), and playback only copies
+ * consecutive frames of that period into large chunks, which are sent to the
+ * frame reader without coalescing.
+ */
+class Generator : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int waveform
+             READ waveform
+             WRITE setWaveform
+             NOTIFY waveformChanged)
+  Q_PROPERTY(int channels
+             READ channels
+             WRITE setChannels
+             NOTIFY channelsChanged)
+  Q_PROPERTY(int frameRate
+             READ frameRate
+             WRITE setFrameRate
+             NOTIFY frameRateChanged)
+  Q_PROPERTY(int checksum
+             READ checksum
+             WRITE setChecksum
+             NOTIFY checksumChanged)
+  Q_PROPERTY(QStringList availableWaveforms
+             READ availableWaveforms
+             CONSTANT)
+  Q_PROPERTY(QStringList availableFrameRates
+             READ availableFrameRates
+             CONSTANT)
+  Q_PROPERTY(QStringList availableChecksums
+             READ availableChecksums
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void waveformChanged();
+  void channelsChanged();
+  void checksumChanged();
+  void frameRateChanged();
+
+private:
+  explicit Generator();
+  Generator(Generator &&) = delete;
+  Generator(const Generator &) = delete;
+  Generator &operator=(Generator &&) = delete;
+  Generator &operator=(const Generator &) = delete;
+
+public:
+  enum class Waveform
+  {
+    Sine,
+    Noise,
+    Step,
+    Binary
+  };
+  Q_ENUM(Waveform)
+
+  static Generator &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] int waveform() const;
+  [[nodiscard]] int channels() const;
+  [[nodiscard]] int checksum() const;
+  [[nodiscard]] int frameRate() const;
+
+  [[nodiscard]] QStringList availableWaveforms() const;
+  [[nodiscard]] QStringList availableChecksums() const;
+  [[nodiscard]] QStringList availableFrameRates() const;
+
+public slots:
+  void setWaveform(const int waveform);
+  void setChannels(const int channels);
+  void setChecksum(const int checksum);
+  void setFrameRate(const int frameRate);
+
+private slots:
+  void onGeneratorTick();
+
+private:
+  void renderPattern();
+  void restartClock();
+  void emitFrames(qsizetype count);
+  [[nodiscard]] QByteArray payload(const int frame) const;
+
+private:
+  bool m_open;
+  int m_waveform;
+  int m_channels;
+  int m_checksum;
+  int m_frameRate;
+
+  bool m_splitFrames;
+  qsizetype m_position;
+  qsizetype m_framesPerChunk;
+  QByteArray m_pattern;
+  QVector<qsizetype> m_frameOffsets;
+
+  qint64 m_emittedFrames;
+  QTimer m_generatorTimer;
+  QElapsedTimer m_generatorClock;
+};
+} // namespace Drivers
+} // namespace IO
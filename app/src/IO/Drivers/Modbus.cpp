@@ -0,0 +1,695 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QtEndian>
+#include <QSerialPort>
+#include <QSerialPortInfo>
+#include <QModbusTcpClient>
+#include <QModbusRtuSerialClient>
+
+#include "IO/Manager.h"
+#include "IO/Drivers/Modbus.h"
+
+#include "JSON/FrameBuilder.h"
+#include "Misc/Utilities.h"
+
+/**
+ * Baud rates that can be selected for Modbus RTU
+ */
+static constexpr int kBaudRates[] = {1200,  2400,  4800,   9600,  19200,
+                                     38400, 57600, 115200, 230400};
+
+/**
+ * Index of the default baud rate (19200 baud) & of the default parity (even),
+ * as required by the Modbus serial line specification
+ */
+static constexpr int kDefaultBaudRate = 4;
+static constexpr int kDefaultParity = 1;
+
+/**
+ * Parities that can be selected for Modbus RTU, in the order of the list
+ * returned by @c availableParities()
+ */
+static constexpr QSerialPort::Parity kParities[]
+    = {QSerialPort::NoParity, QSerialPort::EvenParity, QSerialPort::OddParity};
+
+/**
+ * Default port of Modbus TCP servers
+ */
+static constexpr quint16 kDefaultPort = 502;
+
+/**
+ * Size of the block identifier written before the values of each record
+ */
+static constexpr int kIdSize = 4;
+
+/**
+ * Time to wait for a reply (in milliseconds)
+ */
+static constexpr int kReplyTimeout = 1000;
+
+/**
+ * Returns the Qt register type that corresponds to the given Modbus table
+ */
+static QModbusDataUnit::RegisterType
+registerType(const JSON::NativeParser::ModbusTable table)
+{
+  switch (table)
+  {
+    case JSON::NativeParser::ModbusTable::Coils:
+      return QModbusDataUnit::Coils;
+    case JSON::NativeParser::ModbusTable::DiscreteInputs:
+      return QModbusDataUnit::DiscreteInputs;
+    case JSON::NativeParser::ModbusTable::InputRegisters:
+      return QModbusDataUnit::InputRegisters;
+    case JSON::NativeParser::ModbusTable::HoldingRegisters:
+      return QModbusDataUnit::HoldingRegisters;
+  }
+
+  return QModbusDataUnit::Invalid;
+}
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::Modbus::Modbus()
+  : m_parityIndex(kDefaultParity)
+  , m_protocolIndex(0)
+  , m_baudRateIndex(kDefaultBaudRate)
+  , m_serialPortIndex(0)
+  , m_host(QStringLiteral("127.0.0.1"))
+  , m_port(kDefaultPort)
+  , m_device(nullptr)
+{
+  refreshSerialPorts();
+}
+
+/**
+ * Disconnects from the Modbus server before destroying the driver
+ */
+IO::Drivers::Modbus::~Modbus()
+{
+  close();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::Modbus &IO::Drivers::Modbus::instance()
+{
+  static Modbus singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Stops polling, disconnects from the Modbus server & deletes the device
+ */
+void IO::Drivers::Modbus::close()
+{
+  stopPolling();
+  m_blocks.clear();
+
+  if (m_device)
+  {
+    m_device->disconnect(this);
+    m_device->disconnectDevice();
+    m_device->deleteLater();
+    m_device = nullptr;
+  }
+}
+
+/**
+ * Returns @c true if the client is connected or connecting to the server
+ */
+bool IO::Drivers::Modbus::isOpen() const
+{
+  return m_device && m_device->state() != QModbusDevice::UnconnectedState;
+}
+
+/**
+ * Returns @c true if the client is connected or connecting to the server
+ */
+bool IO::Drivers::Modbus::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c true if the client is connected or connecting to the server
+ */
+bool IO::Drivers::Modbus::isWritable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c true if a serial port (RTU) or a host (TCP) is selected
+ */
+bool IO::Drivers::Modbus::configurationOk() const
+{
+  if (m_protocolIndex == 0)
+    return m_serialPortIndex >= 0
+           && m_serialPortIndex < m_serialPorts.count();
+
+  return !m_host.isEmpty() && m_port > 0;
+}
+
+/**
+ * Returns the number of record bytes produced per second when every block
+ * is read at its poll interval.
+ */
+qint64 IO::Drivers::Modbus::dataRate() const
+{
+  qint64 rate = 0;
+  for (const auto &block : m_blocks)
+  {
+    const bool bits = block.table == JSON::NativeParser::ModbusTable::Coils
+                      || block.table
+                             == JSON::NativeParser::ModbusTable::DiscreteInputs;
+    const qint64 size = 1 + kIdSize + (bits ? block.count : block.count * 2);
+    rate += size * 1000 / block.interval;
+  }
+
+  return rate;
+}
+
+/**
+ * Returns @c false, each write is sent as a request of its own
+ */
+bool IO::Drivers::Modbus::supportsCoalescedWrites() const
+{
+  return false;
+}
+
+/**
+ * @brief Writes one or more holding registers.
+ *
+ * @param data Server address (1 byte), big-endian address of the first
+ *             register (2 bytes) & the big-endian register values.
+ * @return The number of value bytes sent to the server.
+ */
+quint64 IO::Drivers::Modbus::write(const QByteArray &data)
+{
+  if (!isWritable() || data.size() < 5 || (data.size() - 3) % 2 != 0)
+    return 0;
+
+  // Read the request
+  const auto server = static_cast<quint8>(data.at(0));
+  const auto address = qFromBigEndian<quint16>(data.constData() + 1);
+  QList<quint16> values;
+  for (qsizetype i = 3; i < data.size(); i += 2)
+    values.append(qFromBigEndian<quint16>(data.constData() + i));
+
+  // Send the request
+  QModbusDataUnit unit(QModbusDataUnit::HoldingRegisters, address, values);
+  auto *reply = m_device->sendWriteRequest(unit, server);
+  if (!reply)
+    return 0;
+
+  // Release the reply once the server answers
+  if (reply->isFinished())
+    reply->deleteLater();
+  else
+    connect(reply, &QModbusReply::finished, reply, &QObject::deleteLater);
+
+  Q_EMIT dataSent(data);
+  return values.count() * 2;
+}
+
+/**
+ * @brief Connects to the selected Modbus server.
+ *
+ * The register blocks to poll are obtained from the native parser of the
+ * loaded project, polling starts once the connection is established.
+ *
+ * @return @c true if the client is connecting to the server.
+ */
+bool IO::Drivers::Modbus::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+  close();
+
+  // Validate the configuration
+  if (!configurationOk())
+    return false;
+
+  // Obtain the register blocks of the project
+  const auto &builder = JSON::FrameBuilder::instance();
+  const auto &parser = builder.nativeParser();
+  if (builder.operationMode() != SerialStudio::ProjectFile
+      || parser.mode() != JSON::NativeParser::Mode::Modbus)
+  {
+    Misc::Utilities::showMessageBox(
+        tr("No Modbus registers to read"),
+        tr("Load a project that describes its Modbus registers with the "
+           "\"modbus\" mode of the native parser."));
+    return false;
+  }
+
+  m_blocks = parser.modbusBlocks();
+
+  // Create a Modbus RTU client
+  if (m_protocolIndex == 0)
+  {
+    const auto &name = m_serialPorts.at(m_serialPortIndex);
+    m_device = new QModbusRtuSerialClient(this);
+    m_device->setConnectionParameter(QModbusDevice::SerialPortNameParameter,
+                                     name);
+    m_device->setConnectionParameter(QModbusDevice::SerialBaudRateParameter,
+                                     kBaudRates[m_baudRateIndex]);
+    m_device->setConnectionParameter(QModbusDevice::SerialParityParameter,
+                                     kParities[m_parityIndex]);
+    m_device->setConnectionParameter(QModbusDevice::SerialDataBitsParameter,
+                                     QSerialPort::Data8);
+    m_device->setConnectionParameter(
+        QModbusDevice::SerialStopBitsParameter,
+        m_parityIndex == 0 ? QSerialPort::TwoStop : QSerialPort::OneStop);
+  }
+
+  // Create a Modbus TCP client
+  else
+  {
+    m_device = new QModbusTcpClient(this);
+    m_device->setConnectionParameter(QModbusDevice::NetworkAddressParameter,
+                                     m_host);
+    m_device->setConnectionParameter(QModbusDevice::NetworkPortParameter,
+                                     m_port);
+  }
+
+  // Configure the client
+  m_device->setTimeout(kReplyTimeout);
+  m_device->setNumberOfRetries(0);
+  connect(m_device, &QModbusDevice::stateChanged, this,
+          &IO::Drivers::Modbus::onStateChanged);
+  connect(m_device, &QModbusDevice::errorOccurred, this,
+          &IO::Drivers::Modbus::onErrorOccurred);
+
+  // Connect to the server (a failed connection may close the driver)
+  auto *device = m_device;
+  if (!device->connectDevice())
+  {
+    const auto error = device->errorString();
+    close();
+    Misc::Utilities::showMessageBox(tr("Modbus error"), error);
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the host name or IP address of the Modbus TCP server
+ */
+QString IO::Drivers::Modbus::host() const
+{
+  return m_host;
+}
+
+/**
+ * Returns the TCP port of the Modbus TCP server
+ */
+quint16 IO::Drivers::Modbus::port() const
+{
+  return m_port;
+}
+
+/**
+ * Returns the index of the selected parity, in the list returned by
+ * @c availableParities().
+ */
+int IO::Drivers::Modbus::parityIndex() const
+{
+  return m_parityIndex;
+}
+
+/**
+ * Returns the index of the selected protocol, in the list returned by
+ * @c availableProtocols().
+ */
+int IO::Drivers::Modbus::protocolIndex() const
+{
+  return m_protocolIndex;
+}
+
+/**
+ * Returns the index of the selected baud rate, in the list returned by
+ * @c availableBaudRates().
+ */
+int IO::Drivers::Modbus::baudRateIndex() const
+{
+  return m_baudRateIndex;
+}
+
+/**
+ * Returns the index of the selected serial port, in the list returned by
+ * @c availableSerialPorts().
+ */
+int IO::Drivers::Modbus::serialPortIndex() const
+{
+  return m_serialPortIndex;
+}
+
+/**
+ * Returns the list of parities that can be selected for Modbus RTU
+ */
+QStringList IO::Drivers::Modbus::availableParities() const
+{
+  return {tr("None"), tr("Even"), tr("Odd")};
+}
+
+/**
+ * Returns the list of baud rates that can be selected for Modbus RTU
+ */
+QStringList IO::Drivers::Modbus::availableBaudRates() const
+{
+  QStringList list;
+  for (const auto rate : kBaudRates)
+    list.append(QString::number(rate));
+
+  return list;
+}
+
+/**
+ * Returns the list of supported Modbus protocols
+ */
+QStringList IO::Drivers::Modbus::availableProtocols() const
+{
+  return {tr("Modbus RTU"), tr("Modbus TCP")};
+}
+
+/**
+ * Returns the serial ports that can be used for Modbus RTU
+ */
+QStringList IO::Drivers::Modbus::availableSerialPorts() const
+{
+  return m_serialPorts;
+}
+
+/**
+ * Scans the serial ports available in this system
+ */
+void IO::Drivers::Modbus::refreshSerialPorts()
+{
+  QStringList ports;
+  for (const auto &info : QSerialPortInfo::availablePorts())
+    ports.append(info.portName());
+
+  if (ports != m_serialPorts)
+  {
+    m_serialPorts = ports;
+    Q_EMIT availableSerialPortsChanged();
+    Q_EMIT configurationChanged();
+  }
+}
+
+/**
+ * Changes the TCP port of the Modbus TCP server
+ */
+void IO::Drivers::Modbus::setPort(const quint16 port)
+{
+  if (port == m_port)
+    return;
+
+  m_port = port;
+  Q_EMIT portChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the host name or IP address of the Modbus TCP server
+ */
+void IO::Drivers::Modbus::setHost(const QString &host)
+{
+  if (host == m_host)
+    return;
+
+  m_host = host;
+  Q_EMIT hostChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the parity used for Modbus RTU
+ */
+void IO::Drivers::Modbus::setParityIndex(const int index)
+{
+  const auto count = static_cast<int>(std::size(kParities));
+  if (index < 0 || index >= count || index == m_parityIndex)
+    return;
+
+  m_parityIndex = index;
+  Q_EMIT parityIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Selects Modbus RTU (0) or Modbus TCP (1)
+ */
+void IO::Drivers::Modbus::setProtocolIndex(const int index)
+{
+  if (index < 0 || index > 1 || index == m_protocolIndex)
+    return;
+
+  m_protocolIndex = index;
+  Q_EMIT protocolIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the baud rate used for Modbus RTU
+ */
+void IO::Drivers::Modbus::setBaudRateIndex(const int index)
+{
+  const auto count = static_cast<int>(std::size(kBaudRates));
+  if (index < 0 || index >= count || index == m_baudRateIndex)
+    return;
+
+  m_baudRateIndex = index;
+  Q_EMIT baudRateIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the serial port used for Modbus RTU
+ */
+void IO::Drivers::Modbus::setSerialPortIndex(const int index)
+{
+  if (index == m_serialPortIndex)
+    return;
+
+  m_serialPortIndex = index;
+  Q_EMIT serialPortIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+//------------------------------------------------------------------------------
+// Register polling
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Sends a read request for every block polled at the given interval.
+ *
+ * Blocks whose previous request is still pending are skipped, so that a slow
+ * server does not accumulate requests. Modbus TCP requests are sent at once
+ * without waiting for the replies of other blocks.
+ *
+ * @param interval Poll interval of the timer that expired, in milliseconds.
+ */
+void IO::Drivers::Modbus::poll(const int interval)
+{
+  if (!m_device || m_device->state() != QModbusDevice::ConnectedState)
+    return;
+
+  for (qsizetype i = 0; i < m_blocks.count(); ++i)
+  {
+    const auto &block = m_blocks.at(i);
+    if (block.interval != interval || m_pending.at(i))
+      continue;
+
+    // Build the request
+    QModbusDataUnit unit(registerType(block.table), block.address,
+                         static_cast<quint16>(block.count));
+
+    // Send the request
+    auto *reply = m_device->sendReadRequest(unit, block.server);
+    if (!reply)
+      continue;
+
+    // Wait for the reply
+    if (reply->isFinished())
+      onReplyFinished(reply, i);
+    else
+    {
+      m_pending[i] = true;
+      connect(reply, &QModbusReply::finished, this,
+              [this, reply, i] { onReplyFinished(reply, i); });
+    }
+  }
+}
+
+/**
+ * Starts polling once connected & disconnects if the connection is lost
+ */
+void IO::Drivers::Modbus::onStateChanged(QModbusDevice::State state)
+{
+  if (state == QModbusDevice::ConnectedState)
+    startPolling();
+
+  else if (state == QModbusDevice::UnconnectedState)
+  {
+    stopPolling();
+    Manager::instance().disconnectDevice();
+  }
+}
+
+/**
+ * Disconnects from the server & displays the error in a message box
+ */
+void IO::Drivers::Modbus::onErrorOccurred(QModbusDevice::Error error)
+{
+  // Errors of individual requests are not fatal
+  if (error == QModbusDevice::NoError || error == QModbusDevice::ReadError
+      || error == QModbusDevice::WriteError
+      || error == QModbusDevice::TimeoutError
+      || error == QModbusDevice::ProtocolError
+      || error == QModbusDevice::ReplyAbortedError || !m_device)
+    return;
+
+  const auto message = m_device->errorString();
+  Manager::instance().disconnectDevice();
+  Misc::Utilities::showMessageBox(tr("Modbus error"), message);
+}
+
+/**
+ * Creates one timer for each distinct poll interval of the register blocks
+ */
+void IO::Drivers::Modbus::startPolling()
+{
+  stopPolling();
+  m_pending.fill(false, m_blocks.count());
+
+  QList<int> intervals;
+  for (const auto &block : std::as_const(m_blocks))
+  {
+    if (intervals.contains(block.interval))
+      continue;
+
+    intervals.append(block.interval);
+    const auto interval = block.interval;
+    auto *timer = new QTimer(this);
+    timer->setInterval(interval);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this,
+            [this, interval] { poll(interval); });
+    m_timers.append(timer);
+    timer->start();
+
+    // Read the blocks right away
+    poll(interval);
+  }
+}
+
+/**
+ * Stops & deletes the poll timers
+ */
+void IO::Drivers::Modbus::stopPolling()
+{
+  for (auto *timer : std::as_const(m_timers))
+  {
+    timer->stop();
+    timer->deleteLater();
+  }
+
+  m_timers.clear();
+  m_pending.clear();
+}
+
+/**
+ * @brief Forwards the values read from a register block.
+ *
+ * The values are encoded as a length-prefixed record and handed over to the
+ * frame reader. Replies with errors (e.g. timeouts or exceptions reported by
+ * the server) are discarded, the block is read again at its next interval.
+ *
+ * @param reply The finished reply.
+ * @param index Index of the register block that was read.
+ */
+void IO::Drivers::Modbus::onReplyFinished(QModbusReply *reply,
+                                          const qsizetype index)
+{
+  reply->deleteLater();
+
+  // Ignore replies of previous connections
+  if (!m_device || reply->parent() != m_device || index >= m_pending.count())
+    return;
+
+  // Allow the block to be polled again
+  m_pending[index] = false;
+  if (reply->error() != QModbusDevice::NoError)
+    return;
+
+  // Obtain the values
+  const auto &block = m_blocks.at(index);
+  const auto values = reply->result().values();
+  const bool bits = block.table == JSON::NativeParser::ModbusTable::Coils
+                    || block.table
+                           == JSON::NativeParser::ModbusTable::DiscreteInputs;
+
+  // Write the record header
+  const auto width = bits ? 1 : 2;
+  const auto size = values.count() * width;
+  QByteArray record;
+  record.reserve(1 + kIdSize + size);
+  char header[1 + kIdSize];
+  header[0] = static_cast<char>(kIdSize + size);
+  qToBigEndian<quint32>(block.id, header + 1);
+  record.append(header, sizeof(header));
+
+  // Write the values
+  for (const auto value : values)
+  {
+    if (bits)
+      record.append(static_cast<char>(value ? 1 : 0));
+
+    else
+    {
+      char word[2];
+      qToBigEndian<quint16>(value, word);
+      record.append(word, sizeof(word));
+    }
+  }
+
+  // Hand the record over to the frame reader
+  processData(std::move(record));
+}
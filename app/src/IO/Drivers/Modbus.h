@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QTimer>
+#include <QByteArray>
+#include <QStringList>
+#include <QModbusClient>
+
+#include "IO/HAL_Driver.h"
+#include "JSON/NativeParser.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The Modbus class
+ *
+ * Serial Studio driver for Modbus servers, acting as a Modbus RTU (serial
+ * line) or Modbus TCP client through the Qt Serial Bus module.
+ *
+ * The driver polls the register blocks declared by the @c "modbus" mode of
+ * the native parser, in which adjacent registers are merged into the minimum
+ * number of read requests. Each distinct poll interval has its own timer,
+ * and a block is not polled again while its previous request is pending.
+ * Modbus TCP requests are sent without waiting for earlier replies, so that
+ * several transactions are in flight at the same time, while Modbus RTU
+ * requests are queued on the serial line.
+ *
+ * Each reply is forwarded as a binary record: a one-byte length, the
+ * big-endian identifier of the block & its values (registers as big-endian
+ * 16-bit words, coils & discrete inputs as one byte each). Projects decode
+ * these records with the length-prefixed frame detection (one-byte length
+ * field, no header), which maps the values of each block straight to their
+ * datasets without any text framing.
+ *
+ * Data written to the device sets holding registers: a server address byte,
+ * the big-endian address of the first register & the big-endian values.
+ */
+class Modbus : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int protocolIndex
+             READ protocolIndex
+             WRITE setProtocolIndex
+             NOTIFY protocolIndexChanged)
+  Q_PROPERTY(QString host
+             READ host
+             WRITE setHost
+             NOTIFY hostChanged)
+  Q_PROPERTY(quint16 port
+             READ port
+             WRITE setPort
+             NOTIFY portChanged)
+  Q_PROPERTY(int serialPortIndex
+             READ serialPortIndex
+             WRITE setSerialPortIndex
+             NOTIFY serialPortIndexChanged)
+  Q_PROPERTY(int baudRateIndex
+             READ baudRateIndex
+             WRITE setBaudRateIndex
+             NOTIFY baudRateIndexChanged)
+  Q_PROPERTY(int parityIndex
+             READ parityIndex
+             WRITE setParityIndex
+             NOTIFY parityIndexChanged)
+  Q_PROPERTY(QStringList availableProtocols
+             READ availableProtocols
+             CONSTANT)
+  Q_PROPERTY(QStringList availableSerialPorts
+             READ availableSerialPorts
+             NOTIFY availableSerialPortsChanged)
+  Q_PROPERTY(QStringList availableBaudRates
+             READ availableBaudRates
+             CONSTANT)
+  Q_PROPERTY(QStringList availableParities
+             READ availableParities
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void hostChanged();
+  void portChanged();
+  void parityIndexChanged();
+  void protocolIndexChanged();
+  void baudRateIndexChanged();
+  void serialPortIndexChanged();
+  void availableSerialPortsChanged();
+
+private:
+  explicit Modbus();
+  Modbus(Modbus &&) = delete;
+  Modbus(const Modbus &) = delete;
+  Modbus &operator=(Modbus &&) = delete;
+  Modbus &operator=(const Modbus &) = delete;
+
+  ~Modbus();
+
+public:
+  static Modbus &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] qint64 dataRate() const override;
+  [[nodiscard]] bool supportsCoalescedWrites() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] QString host() const;
+  [[nodiscard]] quint16 port() const;
+  [[nodiscard]] int parityIndex() const;
+  [[nodiscard]] int protocolIndex() const;
+  [[nodiscard]] int baudRateIndex() const;
+  [[nodiscard]] int serialPortIndex() const;
+
+  [[nodiscard]] QStringList availableParities() const;
+  [[nodiscard]] QStringList availableBaudRates() const;
+  [[nodiscard]] QStringList availableProtocols() const;
+  [[nodiscard]] QStringList availableSerialPorts() const;
+
+public slots:
+  void refreshSerialPorts();
+  void setPort(const quint16 port);
+  void setHost(const QString &host);
+  void setParityIndex(const int index);
+  void setProtocolIndex(const int index);
+  void setBaudRateIndex(const int index);
+  void setSerialPortIndex(const int index);
+
+private slots:
+  void poll(const int interval);
+  void onStateChanged(QModbusDevice::State state);
+  void onErrorOccurred(QModbusDevice::Error error);
+
+private:
+  void startPolling();
+  void stopPolling();
+  void onReplyFinished(QModbusReply *reply, const qsizetype index);
+
+private:
+  int m_parityIndex;
+  int m_protocolIndex;
+  int m_baudRateIndex;
+  int m_serialPortIndex;
+
+  QString m_host;
+  quint16 m_port;
+
+  QModbusClient *m_device;
+  QStringList m_serialPorts;
+
+  QList<bool> m_pending;
+  QList<QTimer *> m_timers;
+  QList<JSON::NativeParser::ModbusBlock> m_blocks;
+};
+} // namespace Drivers
+} // namespace IO
@@ -20,10 +20,29 @@
  * THE SOFTWARE.
  */
 
+#include <QCoreApplication>
+
+#ifdef Q_OS_LINUX
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <arpa/inet.h>
+#  include <netinet/in.h>
+#  include <sys/socket.h>
+#endif
+
 #include "IO/Manager.h"
 #include "IO/Drivers/Network.h"
 
 #include "Misc/Utilities.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * Buffer capacity of the frame reader of each device connected to the TCP
+ * server (or of each UDP sender), unless the user selects a fixed buffer size
+ */
+static constexpr qsizetype kConnectionBufferCapacity = 64 * 1024;
 
 //------------------------------------------------------------------------------
 // Constructor & singleton access functions
@@ -33,9 +52,15 @@
  * Constructor function
  */
 IO::Drivers::Network::Network()
-  : m_hostExists(false)
+  : m_tcpServer(false)
+  , m_hostExists(false)
   , m_udpMulticast(false)
   , m_lookupActive(false)
+  , m_udpDemultiplex(false)
+  , m_udpSenderCount(0)
+  , m_udpReceiveBufferSize(defaultUdpReceiveBufferSize())
+  , m_udpDescriptor(-1)
+  , m_udpNotifier(nullptr)
 {
   // Set initial configuration
   setRemoteAddress("");
@@ -51,6 +76,26 @@ IO::Drivers::Network::Network()
           &IO::Drivers::Network::configurationChanged);
   connect(this, &IO::Drivers::Network::portChanged, this,
           &IO::Drivers::Network::configurationChanged);
+  connect(this, &IO::Drivers::Network::tcpServerChanged, this,
+          &IO::Drivers::Network::configurationChanged);
+
+  // Report the frames of the devices connected to the TCP server
+  connect(&m_server, &IO::Drivers::NetworkServer::framesReady, this,
+          &IO::Drivers::Network::framesReceived, Qt::DirectConnection);
+  connect(&m_server, &IO::Drivers::NetworkServer::connectionCountChanged,
+          this, &IO::Drivers::Network::tcpClientCountChanged);
+
+  // Report the frames of each UDP sender, the demuxer lives in the UDP thread
+  m_demuxer.moveToThread(&m_udpThread);
+  connect(&m_demuxer, &IO::Drivers::DatagramDemuxer::framesReady, this,
+          &IO::Drivers::Network::framesReceived, Qt::DirectConnection);
+  connect(
+      &m_demuxer, &IO::Drivers::DatagramDemuxer::senderCountChanged, this,
+      [=](const int count) {
+        m_udpSenderCount = count;
+        Q_EMIT udpSenderCountChanged();
+      },
+      Qt::QueuedConnection);
 
   // Report socket errors
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
@@ -64,6 +109,20 @@ IO::Drivers::Network::Network()
   connect(&m_udpSocket, &QUdpSocket::errorOccurred, this,
           &IO::Drivers::Network::onErrorOccurred);
 #endif
+
+  // Stop the UDP reader thread before the application quits
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    close();
+    m_udpThread.quit();
+    if (!m_udpThread.wait(100))
+      m_udpThread.terminate();
+  });
+
+  // Start the thread that drains the UDP socket
+  m_udpThread.setObjectName(QStringLiteral("UDP Reader"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_udpThread, Misc::ThreadScheduler::Role::Reader);
+  m_udpThread.start(QThread::TimeCriticalPriority);
 }
 
 /**
@@ -85,6 +144,15 @@ IO::Drivers::Network &IO::Drivers::Network::instance()
  */
 void IO::Drivers::Network::close()
 {
+  // Stop reading datagrams from the reader thread
+  stopUdpReader();
+
+  // Close the connections of the TCP server & the lanes of the UDP senders
+  m_server.stop();
+  if (m_udpThread.isRunning())
+    QMetaObject::invokeMethod(&m_demuxer, &DatagramDemuxer::reset,
+                              Qt::BlockingQueuedConnection);
+
   // Abort network connections
   m_tcpSocket.abort();
   m_udpSocket.abort();
@@ -105,7 +173,9 @@ void IO::Drivers::Network::close()
  */
 bool IO::Drivers::Network::isOpen() const
 {
-  if (socketType() == QAbstractSocket::UdpSocket)
+  if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+    return m_server.isListening();
+  else if (socketType() == QAbstractSocket::UdpSocket)
     return m_udpSocket.isOpen();
   else if (socketType() == QAbstractSocket::TcpSocket)
     return m_tcpSocket.isOpen();
@@ -118,7 +188,9 @@ bool IO::Drivers::Network::isOpen() const
  */
 bool IO::Drivers::Network::isReadable() const
 {
-  if (socketType() == QAbstractSocket::UdpSocket)
+  if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+    return m_server.isListening();
+  else if (socketType() == QAbstractSocket::UdpSocket)
     return m_udpSocket.isReadable();
   else if (socketType() == QAbstractSocket::TcpSocket)
     return m_tcpSocket.isReadable();
@@ -131,7 +203,9 @@ bool IO::Drivers::Network::isReadable() const
  */
 bool IO::Drivers::Network::isWritable() const
 {
-  if (socketType() == QAbstractSocket::UdpSocket)
+  if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+    return m_server.isListening();
+  else if (socketType() == QAbstractSocket::UdpSocket)
     return m_udpSocket.isWritable();
   else if (socketType() == QAbstractSocket::TcpSocket)
     return m_tcpSocket.isWritable();
@@ -140,17 +214,35 @@ bool IO::Drivers::Network::isWritable() const
 }
 
 /**
- * Returns @c true if the port is greater than 0 and the host address is valid.
+ * Returns @c true if the port is greater than 0 and the host address is valid,
+ * the host address is not used in TCP server mode.
  */
 bool IO::Drivers::Network::configurationOk() const
 {
+  if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+    return tcpPort() > 0;
+
   return tcpPort() > 0 && m_hostExists;
 }
 
+/**
+ * @brief Checks if consecutive writes can be merged.
+ *
+ * TCP sockets are streams, but each UDP write is sent as a separate datagram,
+ * so merging writes would change the packets received by the device.
+ *
+ * @return `true` if the socket type is TCP.
+ */
+bool IO::Drivers::Network::supportsCoalescedWrites() const
+{
+  return socketType() == QAbstractSocket::TcpSocket;
+}
+
 /**
  * @brief Writes data to the network socket.
  *
- * Sends the provided data to the network socket if it is writable.
+ * Sends the provided data to the network socket if it is writable. In TCP
+ * server mode, the data is sent to every connected device.
  *
  * @param data The data to be written to the port.
  * @return The number of bytes written on success, or `-1` if the socket is not
@@ -162,6 +254,8 @@ quint64 IO::Drivers::Network::write(const QByteArray &data)
   {
     if (socketType() == QAbstractSocket::UdpSocket)
       return m_udpSocket.write(data);
+    else if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+      return m_server.write(data);
     else if (socketType() == QAbstractSocket::TcpSocket)
       return m_tcpSocket.write(data);
   }
@@ -173,8 +267,9 @@ quint64 IO::Drivers::Network::write(const QByteArray &data)
  * @brief Opens a network connection with the specified mode.
  *
  * Initializes and configures the network socket based on the selected socket
- * type (TCP or UDP). For TCP, it connects to the remote host, while for UDP,
- * it binds to the specified local port and joins a multicast group if required.
+ * type (TCP or UDP). For TCP, it connects to the remote host (or listens for
+ * device connections in TCP server mode), while for UDP, it binds to the
+ * specified local port and joins a multicast group if required.
  *
  * @param mode The mode in which to open the network connection.
  * @return `true` if the connection is successfully opened, `false` otherwise.
@@ -192,6 +287,26 @@ bool IO::Drivers::Network::open(const QIODevice::OpenMode mode)
   // Init socket pointer
   QIODevice *socket = nullptr;
 
+  // Frame reader settings of each device connection or UDP sender
+  const auto &manager = Manager::instance();
+  const auto capacity = manager.bufferSize() > 0 ? manager.bufferCapacity(0)
+                                                 : kConnectionBufferCapacity;
+  const auto policy = static_cast<SerialStudio::BufferOverflowPolicy>(
+      manager.overflowPolicy());
+
+  // TCP server, listen for device connections
+  if (socketType() == QAbstractSocket::TcpSocket && m_tcpServer)
+  {
+    if (m_server.start(tcpPort(), manager.startSequence(),
+                       manager.finishSequence(), capacity, policy))
+      return true;
+
+    Misc::Utilities::showMessageBox(tr("Unable to listen for connections"),
+                                    m_server.errorString());
+    close();
+    return false;
+  }
+
   // TCP connection, assign socket pointer & connect to host
   if (socketType() == QAbstractSocket::TcpSocket)
   {
@@ -206,10 +321,27 @@ bool IO::Drivers::Network::open(const QIODevice::OpenMode mode)
     m_udpSocket.bind(udpLocalPort(), QAbstractSocket::ShareAddress
                                          | QAbstractSocket::ReuseAddressHint);
 
-    // Join the multicast group (if required)
+    // Enlarge the kernel receive queue to absorb bursts
+    applyUdpReceiveBufferSize();
+
+    // Join the multicast groups (if required)
     if (udpMulticast())
-      m_udpSocket.joinMulticastGroup(
-          QHostAddress(QHostAddress(m_address).toIPv6Address()));
+    {
+      for (const auto &group : multicastGroups())
+        m_udpSocket.joinMulticastGroup(
+            QHostAddress(group.toIPv6Address()));
+    }
+
+    // Give each sender a frame reader of its own (if required)
+    if (udpDemultiplex())
+    {
+      const auto start = manager.startSequence();
+      const auto finish = manager.finishSequence();
+      QMetaObject::invokeMethod(
+          &m_demuxer,
+          [=] { m_demuxer.configure(start, finish, capacity, policy); },
+          Qt::QueuedConnection);
+    }
 
     // Set socket pointer
     socket = static_cast<QIODevice *>(&m_udpSocket);
@@ -220,8 +352,12 @@ bool IO::Drivers::Network::open(const QIODevice::OpenMode mode)
   {
     if (socket->open(mode))
     {
-      connect(socket, &QIODevice::readyRead, this,
-              &IO::Drivers::Network::onReadyRead);
+      // Use the batched UDP reader if available, otherwise use readyRead()
+      const bool udp = socketType() == QAbstractSocket::UdpSocket;
+      if (!udp || !(mode & QIODevice::ReadOnly) || !startUdpReader())
+        connect(socket, &QIODevice::readyRead, this,
+                &IO::Drivers::Network::onReadyRead);
+
       return true;
     }
   }
@@ -259,6 +395,57 @@ quint16 IO::Drivers::Network::udpRemotePort() const
   return m_udpRemotePort;
 }
 
+/**
+ * Returns @c true if the driver listens for device connections on the TCP
+ * port instead of connecting to a remote host.
+ */
+bool IO::Drivers::Network::tcpServer() const
+{
+  return m_tcpServer;
+}
+
+/**
+ * Returns the number of devices connected to the TCP server
+ */
+int IO::Drivers::Network::tcpClientCount() const
+{
+  return m_server.connectionCount();
+}
+
+/**
+ * Returns @c true if the datagrams of each UDP sender are framed separately
+ * & reported as a source of their own.
+ */
+bool IO::Drivers::Network::udpDemultiplex() const
+{
+  return m_udpDemultiplex;
+}
+
+/**
+ * Returns the number of UDP senders with a lane of their own
+ */
+int IO::Drivers::Network::udpSenderCount() const
+{
+  return m_udpSenderCount;
+}
+
+/**
+ * Returns the multicast groups to join, the remote address may list several
+ * groups separated by commas.
+ */
+QList<QHostAddress> IO::Drivers::Network::multicastGroups() const
+{
+  QList<QHostAddress> groups;
+  for (const auto &address : m_address.split(',', Qt::SkipEmptyParts))
+  {
+    const QHostAddress group(address.trimmed());
+    if (!group.isNull())
+      groups.append(group);
+  }
+
+  return groups;
+}
+
 /**
  * Returns @c true if the UDP socket is managing a multicasted
  * connection.
@@ -296,6 +483,15 @@ int IO::Drivers::Network::socketTypeIndex() const
   }
 }
 
+/**
+ * Returns the requested size (in bytes) of the kernel receive buffer used by
+ * the UDP socket.
+ */
+int IO::Drivers::Network::udpReceiveBufferSize() const
+{
+  return m_udpReceiveBufferSize;
+}
+
 /**
  * Returns the host address
  */
@@ -353,6 +549,16 @@ void IO::Drivers::Network::setTcpPort(const quint16 port)
   Q_EMIT portChanged();
 }
 
+/**
+ * Enables/disables the TCP server mode, in which the connections of many
+ * devices are accepted on the TCP port.
+ */
+void IO::Drivers::Network::setTcpServer(const bool enabled)
+{
+  m_tcpServer = enabled;
+  Q_EMIT tcpServerChanged();
+}
+
 /**
  * Changes the UDP socket's local @c port number
  */
@@ -372,12 +578,21 @@ void IO::Drivers::Network::setUdpRemotePort(const quint16 port)
 }
 
 /**
- * Sets the IPv4 or IPv6 address specified by the input string representation
+ * Sets the IPv4 or IPv6 address specified by the input string representation,
+ * several multicast groups can be separated by commas.
  */
 void IO::Drivers::Network::setRemoteAddress(const QString &address)
 {
+  // List of multicast groups, every entry must be an IP address
+  if (address.contains(','))
+  {
+    m_hostExists = true;
+    for (const auto &group : address.split(',', Qt::SkipEmptyParts))
+      m_hostExists &= !QHostAddress(group.trimmed()).isNull();
+  }
+
   // Check if host name exists
-  if (QHostAddress(address).isNull())
+  else if (QHostAddress(address).isNull())
   {
     m_hostExists = false;
     lookup(address);
@@ -403,6 +618,15 @@ void IO::Drivers::Network::lookup(const QString &host)
                         &IO::Drivers::Network::lookupFinished);
 }
 
+/**
+ * Enables/disables separate framing of the datagrams of each UDP sender.
+ */
+void IO::Drivers::Network::setUdpDemultiplex(const bool enabled)
+{
+  m_udpDemultiplex = enabled;
+  Q_EMIT udpDemultiplexChanged();
+}
+
 /**
  * Enables/Disables multicast connections with the UDP socket.
  */
@@ -431,6 +655,26 @@ void IO::Drivers::Network::setSocketTypeIndex(const int index)
   }
 }
 
+/**
+ * @brief Changes the size of the kernel receive buffer (@c SO_RCVBUF) of the
+ *        UDP socket.
+ *
+ * A larger buffer allows the socket to absorb bursts of datagrams while the
+ * reader thread is busy. The operating system may clamp the requested value
+ * (e.g. to @c net.core.rmem_max on Linux). A value of zero keeps the system
+ * default.
+ *
+ * @param bytes The requested buffer size in bytes.
+ */
+void IO::Drivers::Network::setUdpReceiveBufferSize(const int bytes)
+{
+  m_udpReceiveBufferSize = qMax(0, bytes);
+  if (m_udpSocket.state() == QAbstractSocket::BoundState)
+    applyUdpReceiveBufferSize();
+
+  Q_EMIT udpReceiveBufferSizeChanged();
+}
+
 /**
  * Changes the socket type. Valid input values are:
  *
@@ -449,15 +693,48 @@ void IO::Drivers::Network::setSocketType(const QAbstractSocket::SocketType type)
  */
 void IO::Drivers::Network::onReadyRead()
 {
+  // Hand each datagram to the lane of its sender
+  if (socketType() == QAbstractSocket::UdpSocket && udpDemultiplex())
+  {
+    qsizetype bytes = 0;
+    QList<Datagram> datagrams;
+    while (udpSocket()->hasPendingDatagrams())
+    {
+      const auto datagram = udpSocket()->receiveDatagram();
+      bytes += datagram.data().size();
+      datagrams.append({datagram.senderAddress(),
+                        static_cast<quint16>(datagram.senderPort()),
+                        datagram.data()});
+    }
+
+    if (datagrams.isEmpty())
+      return;
+
+    auto &stats = Misc::PipelineStats::instance();
+    const auto now = stats.timestamp();
+    stats.record(Misc::PipelineStats::DriverReceive, 1, bytes, 0);
+    QMetaObject::invokeMethod(
+        &m_demuxer, [=] { m_demuxer.processDatagrams(datagrams, now); },
+        Qt::QueuedConnection);
+  }
+
   // Check if we need to use UDP socket functions
-  if (socketType() == QAbstractSocket::UdpSocket)
+  else if (socketType() == QAbstractSocket::UdpSocket)
   {
     while (udpSocket()->hasPendingDatagrams())
     {
+      const auto size = udpSocket()->pendingDatagramSize();
+      if (size < 0)
+        break;
+
       QByteArray datagram;
-      datagram.resize(int(udpSocket()->pendingDatagramSize()));
-      udpSocket()->readDatagram(datagram.data(), datagram.size());
-      processData(datagram);
+      datagram.resize(size);
+      const auto bytes = udpSocket()->readDatagram(datagram.data(), size);
+      datagram.resize(qMax<qint64>(0, bytes));
+
+      // Each datagram is a frame of its own, never merge it with the next one
+      processData(std::move(datagram));
+      flushPendingData();
     }
   }
 
@@ -466,6 +743,177 @@ void IO::Drivers::Network::onReadyRead()
     processData(tcpSocket()->readAll());
 }
 
+/**
+ * @brief Drains all pending datagrams from the UDP socket.
+ *
+ * Runs in the UDP reader thread. On Linux, @c recvmmsg() is used to read up to
+ * 32 datagrams per system call. Each datagram is still forwarded through its
+ * own @c processData() call, so that the frame reader sees the same datagram
+ * boundaries as with @c onReadyRead() (e.g. one frame per datagram when no
+ * delimiters are used).
+ *
+ * When the senders are demultiplexed, the address of each datagram is kept
+ * and the batch is handed to the @c DatagramDemuxer instead.
+ */
+void IO::Drivers::Network::readDatagramBatch()
+{
+#ifdef Q_OS_LINUX
+  // Point each message to its own slot of the receive buffer
+  constexpr int batchSize = 32;
+  const auto slotSize = m_udpBuffer.size() / batchSize;
+  const bool demux = udpDemultiplex();
+  mmsghdr messages[batchSize] = {};
+  iovec vectors[batchSize];
+  sockaddr_storage names[batchSize];
+  for (int i = 0; i < batchSize; ++i)
+  {
+    vectors[i].iov_base = m_udpBuffer.data() + i * slotSize;
+    vectors[i].iov_len = slotSize;
+    messages[i].msg_hdr.msg_iov = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    if (demux)
+      messages[i].msg_hdr.msg_name = &names[i];
+  }
+
+  // Read datagrams until the socket queue is empty
+  qsizetype bytes = 0;
+  QList<Datagram> datagrams;
+  while (true)
+  {
+    // The kernel overwrites the address length of each message
+    if (demux)
+    {
+      for (int i = 0; i < batchSize; ++i)
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+
+    const int count = ::recvmmsg(m_udpDescriptor, messages, batchSize,
+                                 MSG_DONTWAIT, nullptr);
+    if (count < 0 && errno == EINTR)
+      continue;
+    else if (count <= 0)
+      break;
+
+    for (int i = 0; i < count; ++i)
+    {
+      const auto *data = static_cast<const char *>(vectors[i].iov_base);
+      const auto size = qMin<qsizetype>(messages[i].msg_len, slotSize);
+      if (!demux)
+      {
+        processData(QByteArray(data, size));
+        continue;
+      }
+
+      quint16 port = 0;
+      const auto *name = reinterpret_cast<sockaddr *>(&names[i]);
+      if (name->sa_family == AF_INET)
+        port = ntohs(reinterpret_cast<const sockaddr_in *>(name)->sin_port);
+      else if (name->sa_family == AF_INET6)
+        port = ntohs(reinterpret_cast<const sockaddr_in6 *>(name)->sin6_port);
+
+      bytes += size;
+      datagrams.append({QHostAddress(name), port, QByteArray(data, size)});
+    }
+
+    if (count < batchSize)
+      break;
+  }
+
+  // Hand the datagrams to the lanes of their senders
+  if (demux)
+  {
+    if (datagrams.isEmpty())
+      return;
+
+    auto &stats = Misc::PipelineStats::instance();
+    const auto now = stats.timestamp();
+    stats.record(Misc::PipelineStats::DriverReceive, 1, bytes, 0);
+    m_demuxer.processDatagrams(datagrams, now);
+  }
+#endif
+}
+
+/**
+ * @brief Starts reading datagrams from the UDP reader thread.
+ *
+ * The socket descriptor is duplicated and watched with a socket notifier that
+ * lives in the reader thread, so datagrams are drained without going through
+ * the main event loop. The @c QUdpSocket is still used for binding, multicast
+ * membership and writing.
+ *
+ * @return @c true if the reader was started, @c false if batched reads are not
+ *         available on this platform, in which case @c onReadyRead() must be
+ *         used instead.
+ */
+bool IO::Drivers::Network::startUdpReader()
+{
+#ifdef Q_OS_LINUX
+  // Reader thread not running, nothing to do
+  if (!m_udpThread.isRunning())
+    return false;
+
+  // Duplicate the socket descriptor
+  const auto descriptor = m_udpSocket.socketDescriptor();
+  if (descriptor < 0)
+    return false;
+
+  m_udpDescriptor = ::fcntl(int(descriptor), F_DUPFD_CLOEXEC, 0);
+  if (m_udpDescriptor < 0)
+    return false;
+
+  // Allocate room for a full batch of maximum-sized datagrams
+  if (m_udpBuffer.empty())
+    m_udpBuffer.resize(32 * 64 * 1024);
+
+  // Watch the descriptor from the reader thread
+  m_udpNotifier = new QSocketNotifier(m_udpDescriptor, QSocketNotifier::Read);
+  connect(m_udpNotifier, &QSocketNotifier::activated, this,
+          &IO::Drivers::Network::readDatagramBatch, Qt::DirectConnection);
+  m_udpNotifier->moveToThread(&m_udpThread);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Stops the UDP reader and releases the duplicated socket descriptor.
+ *
+ * The notifier is destroyed in the reader thread, and this function blocks
+ * until that happens, so no datagrams are read once it returns.
+ */
+void IO::Drivers::Network::stopUdpReader()
+{
+  if (m_udpNotifier)
+  {
+    auto notifier = m_udpNotifier;
+    m_udpNotifier = nullptr;
+    if (m_udpThread.isRunning())
+      QMetaObject::invokeMethod(
+          notifier, [=] { delete notifier; }, Qt::BlockingQueuedConnection);
+    else
+      delete notifier;
+  }
+
+#ifdef Q_OS_LINUX
+  if (m_udpDescriptor >= 0)
+  {
+    ::close(m_udpDescriptor);
+    m_udpDescriptor = -1;
+  }
+#endif
+}
+
+/**
+ * @brief Applies the configured @c SO_RCVBUF size to the UDP socket.
+ */
+void IO::Drivers::Network::applyUdpReceiveBufferSize()
+{
+  if (m_udpReceiveBufferSize > 0)
+    m_udpSocket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                                m_udpReceiveBufferSize);
+}
+
 /**
  * Sets the host IP address when the lookup finishes.
  * If the lookup fails, the error code/string shall be shown to the user in a
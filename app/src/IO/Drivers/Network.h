@@ -22,14 +22,20 @@
 
 #pragma once
 
+#include <vector>
+
+#include <QThread>
 #include <QHostInfo>
 #include <QTcpSocket>
 #include <QUdpSocket>
 #include <QByteArray>
 #include <QHostAddress>
 #include <QAbstractSocket>
+#include <QSocketNotifier>
 
 #include "IO/HAL_Driver.h"
+#include "IO/Drivers/NetworkServer.h"
+#include "IO/Drivers/DatagramDemuxer.h"
 
 namespace IO
 {
@@ -39,6 +45,18 @@ namespace Drivers
  * @brief The Network class
  *
  * Serial Studio "driver" class to interact with UDP/TCP network ports.
+ *
+ * In TCP server mode, the driver listens on the TCP port instead of
+ * connecting to a remote host, and accepts the connections of many devices
+ * (see @c IO::Drivers::NetworkServer). Frames of each connection are reported
+ * through @c framesReceived() tagged as a separate source, and data written
+ * by the user is sent to every connected device.
+ *
+ * UDP datagrams can also be separated by sender (see
+ * @c IO::Drivers::DatagramDemuxer), so that several devices can send to the
+ * same port or multicast group, each of them reported as a separate source.
+ * The remote address may then list several multicast groups separated by
+ * commas, all of them are joined by the same socket.
  */
 class Network : public HAL_Driver
 {
@@ -90,14 +108,37 @@ class Network : public HAL_Driver
              READ udpMulticast
              WRITE setUdpMulticast
              NOTIFY udpMulticastChanged)
+  Q_PROPERTY(int udpReceiveBufferSize
+             READ udpReceiveBufferSize
+             WRITE setUdpReceiveBufferSize
+             NOTIFY udpReceiveBufferSizeChanged)
+  Q_PROPERTY(bool tcpServer
+             READ tcpServer
+             WRITE setTcpServer
+             NOTIFY tcpServerChanged)
+  Q_PROPERTY(int tcpClientCount
+             READ tcpClientCount
+             NOTIFY tcpClientCountChanged)
+  Q_PROPERTY(bool udpDemultiplex
+             READ udpDemultiplex
+             WRITE setUdpDemultiplex
+             NOTIFY udpDemultiplexChanged)
+  Q_PROPERTY(int udpSenderCount
+             READ udpSenderCount
+             NOTIFY udpSenderCountChanged)
   // clang-format on
 
 signals:
   void portChanged();
   void addressChanged();
+  void tcpServerChanged();
+  void tcpClientCountChanged();
+  void udpDemultiplexChanged();
+  void udpSenderCountChanged();
   void socketTypeChanged();
   void udpMulticastChanged();
   void lookupActiveChanged();
+  void udpReceiveBufferSizeChanged();
 
 private:
   explicit Network();
@@ -114,6 +155,7 @@ public:
   [[nodiscard]] bool isOpen() const override;
   [[nodiscard]] bool isReadable() const override;
   [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool supportsCoalescedWrites() const override;
   [[nodiscard]] bool configurationOk() const override;
   [[nodiscard]] quint64 write(const QByteArray &data) override;
   [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
@@ -122,9 +164,14 @@ public:
   [[nodiscard]] quint16 udpLocalPort() const;
   [[nodiscard]] quint16 udpRemotePort() const;
 
+  [[nodiscard]] bool tcpServer() const;
+  [[nodiscard]] int tcpClientCount() const;
   [[nodiscard]] bool udpMulticast() const;
   [[nodiscard]] bool lookupActive() const;
+  [[nodiscard]] bool udpDemultiplex() const;
+  [[nodiscard]] int udpSenderCount() const;
   [[nodiscard]] int socketTypeIndex() const;
+  [[nodiscard]] int udpReceiveBufferSize() const;
   [[nodiscard]] QAbstractSocket::SocketType socketType() const;
 
   [[nodiscard]] QTcpSocket *tcpSocket() { return &m_tcpSocket; }
@@ -136,6 +183,7 @@ public:
   static quint16 defaultTcpPort() { return 23; }
   static quint16 defaultUdpLocalPort() { return 0; }
   static quint16 defaultUdpRemotePort() { return 53; }
+  static int defaultUdpReceiveBufferSize() { return 4 * 1024 * 1024; }
   static const QString &defaultAddress()
   {
     static QString addr = QStringLiteral("127.0.0.1");
@@ -147,30 +195,51 @@ public slots:
   void setUdpSocket();
   void lookup(const QString &host);
   void setTcpPort(const quint16 port);
+  void setTcpServer(const bool enabled);
   void setUdpLocalPort(const quint16 port);
   void setUdpMulticast(const bool enabled);
+  void setUdpDemultiplex(const bool enabled);
   void setSocketTypeIndex(const int index);
   void setUdpRemotePort(const quint16 port);
   void setRemoteAddress(const QString &address);
+  void setUdpReceiveBufferSize(const int bytes);
   void setSocketType(const QAbstractSocket::SocketType type);
 
 private slots:
   void onReadyRead();
+  void readDatagramBatch();
   void lookupFinished(const QHostInfo &info);
   void onErrorOccurred(const QAbstractSocket::SocketError socketError);
 
+private:
+  bool startUdpReader();
+  void stopUdpReader();
+  void applyUdpReceiveBufferSize();
+  [[nodiscard]] QList<QHostAddress> multicastGroups() const;
+
 private:
   QString m_address;
   quint16 m_tcpPort;
+  bool m_tcpServer;
   bool m_hostExists;
   bool m_udpMulticast;
   bool m_lookupActive;
+  bool m_udpDemultiplex;
+  int m_udpSenderCount;
   quint16 m_udpLocalPort;
   quint16 m_udpRemotePort;
+  int m_udpReceiveBufferSize;
   QAbstractSocket::SocketType m_socketType;
 
   QTcpSocket m_tcpSocket;
   QUdpSocket m_udpSocket;
+  NetworkServer m_server;
+
+  int m_udpDescriptor;
+  QThread m_udpThread;
+  std::vector<char> m_udpBuffer;
+  QSocketNotifier *m_udpNotifier;
+  DatagramDemuxer m_demuxer;
 };
 } // namespace Drivers
 } // namespace IO
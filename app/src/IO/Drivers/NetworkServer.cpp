@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "IO/Drivers/NetworkServer.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * Maximum number of I/O threads that serve the device connections
+ */
+static constexpr int kMaxReaderThreads = 4;
+
+/**
+ * Maximum number of devices connected at the same time, further connections
+ * are refused
+ */
+static constexpr int kMaxConnections = 1024;
+
+/**
+ * Number of connection requests queued by the operating system while the
+ * server accepts the previous ones
+ */
+static constexpr int kListenBacklog = 256;
+
+/**
+ * Constructor function
+ */
+IO::Drivers::NetworkServer::NetworkServer(QObject *parent)
+  : QTcpServer(parent)
+  , m_nextSource(1)
+  , m_connectionCount(0)
+{
+  setListenBacklogSize(kListenBacklog);
+}
+
+/**
+ * Closes every connection & stops the I/O threads
+ */
+IO::Drivers::NetworkServer::~NetworkServer()
+{
+  stop();
+  for (const auto &reader : m_readers)
+  {
+    reader->thread.quit();
+    if (!reader->thread.wait(100))
+      reader->thread.terminate();
+  }
+}
+
+/**
+ * Returns the number of devices that are connected to the server
+ */
+int IO::Drivers::NetworkServer::connectionCount() const
+{
+  return m_connectionCount;
+}
+
+/**
+ * Stops listening & closes the connections of every device, waiting for the
+ * I/O threads to do so.
+ */
+void IO::Drivers::NetworkServer::stop()
+{
+  close();
+  for (const auto &reader : m_readers)
+  {
+    if (reader->thread.isRunning())
+      QMetaObject::invokeMethod(&reader->worker,
+                                &NetworkServerWorker::closeConnections,
+                                Qt::BlockingQueuedConnection);
+
+    reader->connections = 0;
+  }
+
+  if (m_connectionCount != 0)
+  {
+    m_connectionCount = 0;
+    Q_EMIT connectionCountChanged();
+  }
+}
+
+/**
+ * Sends the given @a data to every connected device.
+ *
+ * @return The number of bytes handed to the I/O threads, or -1 if no device
+ *         is connected.
+ */
+qint64 IO::Drivers::NetworkServer::write(const QByteArray &data)
+{
+  if (m_connectionCount <= 0)
+    return -1;
+
+  for (const auto &reader : m_readers)
+  {
+    if (reader->connections > 0)
+    {
+      auto *worker = &reader->worker;
+      QMetaObject::invokeMethod(
+          worker, [=] { worker->write(data); }, Qt::QueuedConnection);
+    }
+  }
+
+  return data.size();
+}
+
+/**
+ * @brief Starts listening for device connections on the given @a port.
+ *
+ * @param port     Local TCP port.
+ * @param start    Start sequence used for frame detection.
+ * @param finish   Finish sequence used for frame detection.
+ * @param capacity Buffer capacity of the frame reader of each connection.
+ * @param policy   Overflow policy of the frame reader of each connection.
+ *
+ * @return @c true if the server is listening.
+ */
+bool IO::Drivers::NetworkServer::start(
+    const quint16 port, const QString &start, const QString &finish,
+    const qsizetype capacity, const SerialStudio::BufferOverflowPolicy policy)
+{
+  stop();
+  startReaders();
+
+  m_nextSource = 1;
+  for (const auto &reader : m_readers)
+  {
+    auto *worker = &reader->worker;
+    QMetaObject::invokeMethod(
+        worker, [=] { worker->configure(start, finish, capacity, policy); },
+        Qt::QueuedConnection);
+  }
+
+  return listen(QHostAddress::Any, port);
+}
+
+/**
+ * Hands the accepted connection to the I/O thread with the fewest
+ * connections.
+ */
+void IO::Drivers::NetworkServer::incomingConnection(qintptr descriptor)
+{
+  // Refuse the connection if too many devices are connected
+  if (m_readers.empty() || m_connectionCount >= kMaxConnections)
+  {
+    QTcpSocket socket;
+    if (socket.setSocketDescriptor(descriptor))
+      socket.abort();
+
+    qWarning() << "Refusing device connection, too many devices connected";
+    return;
+  }
+
+  // Select the least busy I/O thread
+  auto reader = std::min_element(
+      m_readers.begin(), m_readers.end(), [](const auto &a, const auto &b) {
+        return a->connections < b->connections;
+      });
+
+  // Hand the connection over to it
+  const auto source = m_nextSource++;
+  auto *worker = &(*reader)->worker;
+  QMetaObject::invokeMethod(
+      worker, [=] { worker->addConnection(descriptor, source); },
+      Qt::QueuedConnection);
+
+  ++(*reader)->connections;
+  ++m_connectionCount;
+  Q_EMIT connectionCountChanged();
+}
+
+/**
+ * Starts the I/O threads, if they are not running yet.
+ */
+void IO::Drivers::NetworkServer::startReaders()
+{
+  if (!m_readers.empty())
+    return;
+
+  const auto count = qBound(1, QThread::idealThreadCount() / 2,
+                            kMaxReaderThreads);
+  for (int i = 0; i < count; ++i)
+  {
+    auto reader = std::make_unique<Reader>();
+    auto *ptr = reader.get();
+
+    // Forward the frames from the I/O thread, without a detour through the
+    // thread of the server
+    connect(&ptr->worker, &NetworkServerWorker::framesReady, this,
+            &NetworkServer::framesReady, Qt::DirectConnection);
+
+    // Keep track of the connections served by the thread
+    connect(&ptr->worker, &NetworkServerWorker::connectionClosed, this,
+            [=] {
+              if (ptr->connections > 0)
+                --ptr->connections;
+
+              if (m_connectionCount > 0)
+              {
+                --m_connectionCount;
+                Q_EMIT connectionCountChanged();
+              }
+            },
+            Qt::QueuedConnection);
+
+    // Start the thread
+    ptr->worker.moveToThread(&ptr->thread);
+    ptr->thread.setObjectName(QStringLiteral("TCP Server %1").arg(i + 1));
+    Misc::ThreadScheduler::instance().registerThread(
+        &ptr->thread, Misc::ThreadScheduler::Role::Reader);
+    ptr->thread.start(QThread::HighPriority);
+
+    m_readers.push_back(std::move(reader));
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QThread>
+#include <QTcpServer>
+
+#include "IO/Drivers/NetworkServerWorker.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The NetworkServer class
+ *
+ * TCP server used by the @c IO::Drivers::Network driver to accept the
+ * connections of many devices at once (e.g. a fleet of test devices that
+ * report to a collector).
+ *
+ * Accepted connections are handed, as socket descriptors, to a small pool of
+ * I/O threads, each of them running a @c IO::Drivers::NetworkServerWorker.
+ * The sockets are served by the event dispatcher of their thread (which
+ * polls all of them at once), so the number of threads does not grow with
+ * the number of devices. New connections go to the thread that serves the
+ * fewest connections.
+ *
+ * Each connection is numbered as a data source (starting at 1, in order of
+ * arrival) & its frames are emitted through @c framesReady() directly from
+ * its I/O thread.
+ */
+class NetworkServer : public QTcpServer
+{
+  Q_OBJECT
+
+signals:
+  void connectionCountChanged();
+  void framesReady(const IO::FrameBatch &frames);
+
+public:
+  explicit NetworkServer(QObject *parent = nullptr);
+  ~NetworkServer();
+
+  [[nodiscard]] int connectionCount() const;
+
+  void stop();
+  [[nodiscard]] qint64 write(const QByteArray &data);
+  [[nodiscard]] bool start(const quint16 port, const QString &start,
+                           const QString &finish, const qsizetype capacity,
+                           const SerialStudio::BufferOverflowPolicy policy);
+
+protected:
+  void incomingConnection(qintptr descriptor) override;
+
+private:
+  /**
+   * @brief I/O thread of the server & the connections that it serves.
+   */
+  struct Reader
+  {
+    int connections = 0;
+    QThread thread;
+    NetworkServerWorker worker;
+  };
+
+  void startReaders();
+
+private:
+  int m_nextSource;
+  int m_connectionCount;
+  std::vector<std::unique_ptr<Reader>> m_readers;
+};
+} // namespace Drivers
+} // namespace IO
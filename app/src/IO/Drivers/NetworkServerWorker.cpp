@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IO/FrameReader.h"
+#include "IO/Drivers/NetworkServerWorker.h"
+
+#include "Misc/PipelineStats.h"
+
+/**
+ * Constructor function
+ */
+IO::Drivers::NetworkServerWorker::NetworkServerWorker()
+  : m_bufferCapacity(0)
+  , m_overflowPolicy(SerialStudio::OverflowDropOldest)
+{
+}
+
+/**
+ * Closes every connection served by the worker, must run in its thread. The
+ * server resets its connection counters by itself, so @c connectionClosed()
+ * is not emitted.
+ */
+void IO::Drivers::NetworkServerWorker::closeConnections()
+{
+  const auto sockets = m_connections.keys();
+  for (auto *socket : sockets)
+  {
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+    m_connections.take(socket)->deleteLater();
+  }
+}
+
+/**
+ * Sends the given @a data to every connected device.
+ */
+void IO::Drivers::NetworkServerWorker::write(const QByteArray &data)
+{
+  for (auto it = m_connections.cbegin(); it != m_connections.cend(); ++it)
+    it.key()->write(data);
+}
+
+/**
+ * @brief Starts serving the accepted connection with the given socket
+ *        @a descriptor.
+ *
+ * The connection gets its own frame reader, configured with the settings
+ * given to @c configure(), and its frames are tagged with @a source.
+ */
+void IO::Drivers::NetworkServerWorker::addConnection(const qintptr descriptor,
+                                                     const int source)
+{
+  // Take over the socket of the connection
+  auto *socket = new QTcpSocket(this);
+  if (!socket->setSocketDescriptor(descriptor))
+  {
+    qWarning() << "Cannot accept device connection:" << socket->errorString();
+    socket->deleteLater();
+    Q_EMIT connectionClosed();
+    return;
+  }
+
+  // Create the frame reader of the connection
+  auto *reader = new IO::FrameReader(this);
+  reader->setupExternalConnections();
+  reader->setStartSequence(m_startSequence);
+  reader->setFinishSequence(m_finishSequence);
+  reader->setBufferCapacity(m_bufferCapacity);
+  reader->setOverflowPolicy(m_overflowPolicy);
+
+  // Tag the frames of the connection with its source
+  connect(reader, &IO::FrameReader::framesReady, this,
+          [this, source](const IO::FrameBatch &frames) {
+            auto tagged = frames;
+            for (auto &frame : tagged)
+              frame.source = source;
+
+            Q_EMIT framesReady(tagged);
+          });
+
+  // Read incoming data & remove the connection when it is closed
+  socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+  connect(socket, &QTcpSocket::readyRead, this,
+          &IO::Drivers::NetworkServerWorker::onReadyRead);
+  connect(socket, &QTcpSocket::disconnected, this,
+          &IO::Drivers::NetworkServerWorker::onDisconnected);
+
+  m_connections.insert(socket, reader);
+}
+
+/**
+ * @brief Sets the frame detection & buffer settings of the connections
+ *        accepted from now on.
+ */
+void IO::Drivers::NetworkServerWorker::configure(
+    const QString &start, const QString &finish, const qsizetype capacity,
+    const SerialStudio::BufferOverflowPolicy policy)
+{
+  m_startSequence = start;
+  m_finishSequence = finish;
+  m_bufferCapacity = capacity;
+  m_overflowPolicy = policy;
+}
+
+/**
+ * Hands the data received from a device to the frame reader of its
+ * connection.
+ */
+void IO::Drivers::NetworkServerWorker::onReadyRead()
+{
+  auto *socket = static_cast<QTcpSocket *>(sender());
+  auto *reader = m_connections.value(socket);
+  if (!reader)
+    return;
+
+  const auto data = socket->readAll();
+  if (data.isEmpty())
+    return;
+
+  auto &stats = Misc::PipelineStats::instance();
+  const auto now = stats.timestamp();
+  stats.record(Misc::PipelineStats::DriverReceive, 1, data.size(), 0);
+  reader->processData(data, now);
+}
+
+/**
+ * Removes a connection closed by its device.
+ */
+void IO::Drivers::NetworkServerWorker::onDisconnected()
+{
+  auto *socket = static_cast<QTcpSocket *>(sender());
+  auto *reader = m_connections.take(socket);
+  if (!reader)
+    return;
+
+  reader->deleteLater();
+  socket->deleteLater();
+  Q_EMIT connectionClosed();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QTcpSocket>
+
+#include "SerialStudio.h"
+#include "IO/FrameBatch.h"
+
+namespace IO
+{
+class FrameReader;
+
+namespace Drivers
+{
+/**
+ * @brief The NetworkServerWorker class
+ *
+ * Serves a share of the device connections accepted by the
+ * @c IO::Drivers::NetworkServer, from one of the I/O threads of the server.
+ * Every connection has its own socket & @c IO::FrameReader, so that the
+ * frames of a device are never mixed with the bytes of another one, and the
+ * extracted frames are tagged with the source number of their connection.
+ */
+class NetworkServerWorker : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void connectionClosed();
+  void framesReady(const IO::FrameBatch &frames);
+
+public:
+  explicit NetworkServerWorker();
+
+public slots:
+  void closeConnections();
+  void write(const QByteArray &data);
+  void addConnection(const qintptr descriptor, const int source);
+  void configure(const QString &start, const QString &finish,
+                 const qsizetype capacity,
+                 const SerialStudio::BufferOverflowPolicy policy);
+
+private slots:
+  void onReadyRead();
+  void onDisconnected();
+
+private:
+  QString m_startSequence;
+  QString m_finishSequence;
+  qsizetype m_bufferCapacity;
+  SerialStudio::BufferOverflowPolicy m_overflowPolicy;
+
+  QHash<QTcpSocket *, IO::FrameReader *> m_connections;
+};
+} // namespace Drivers
+} // namespace IO
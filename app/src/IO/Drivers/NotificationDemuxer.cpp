@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IO/FrameReader.h"
+#include "IO/Drivers/NotificationDemuxer.h"
+
+/**
+ * Constructor function
+ */
+IO::Drivers::NotificationDemuxer::NotificationDemuxer()
+  : m_bufferCapacity(0)
+  , m_overflowPolicy(SerialStudio::OverflowDropOldest)
+{
+}
+
+/**
+ * @brief Hands each of the given @a notifications to the lane of its
+ *        characteristic.
+ *
+ * Must be called from the thread of the demuxer.
+ *
+ * @param notifications Notifications received by the driver, in order.
+ * @param timestamp Time at which the oldest notification was received.
+ */
+void IO::Drivers::NotificationDemuxer::processNotifications(
+    const QList<IO::Drivers::Notification> &notifications,
+    const qint64 timestamp)
+{
+  for (const auto &notification : notifications)
+  {
+    if (!notification.data.isEmpty())
+      lane(notification.characteristic)
+          ->processData(notification.data, timestamp);
+  }
+}
+
+/**
+ * Removes the lanes of every characteristic, must run in the thread of the
+ * demuxer.
+ */
+void IO::Drivers::NotificationDemuxer::reset()
+{
+  for (auto *reader : std::as_const(m_lanes))
+    reader->deleteLater();
+
+  m_lanes.clear();
+}
+
+/**
+ * @brief Sets the frame detection & buffer settings of the lanes created from
+ *        now on.
+ */
+void IO::Drivers::NotificationDemuxer::configure(
+    const QString &start, const QString &finish, const qsizetype capacity,
+    const SerialStudio::BufferOverflowPolicy policy)
+{
+  m_startSequence = start;
+  m_finishSequence = finish;
+  m_bufferCapacity = capacity;
+  m_overflowPolicy = policy;
+}
+
+/**
+ * @brief Returns the frame reader of the given @a characteristic, creating
+ *        its lane when the first notification of the characteristic arrives.
+ */
+IO::FrameReader *
+IO::Drivers::NotificationDemuxer::lane(const int characteristic)
+{
+  // Lane already exists
+  auto it = m_lanes.constFind(characteristic);
+  if (it != m_lanes.constEnd())
+    return it.value();
+
+  // Create the frame reader of the characteristic
+  auto *reader = new IO::FrameReader(this);
+  reader->setupExternalConnections();
+  reader->setStartSequence(m_startSequence);
+  reader->setFinishSequence(m_finishSequence);
+  reader->setBufferCapacity(m_bufferCapacity);
+  reader->setOverflowPolicy(m_overflowPolicy);
+
+  // Tag the frames of the characteristic with its source
+  const auto source = characteristic + 1;
+  connect(reader, &IO::FrameReader::framesReady, this,
+          [this, source](const IO::FrameBatch &frames) {
+            auto tagged = frames;
+            for (auto &frame : tagged)
+              frame.source = source;
+
+            Q_EMIT framesReady(tagged);
+          });
+
+  m_lanes.insert(characteristic, reader);
+  return reader;
+}
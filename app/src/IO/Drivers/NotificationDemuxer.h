@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+
+#include "SerialStudio.h"
+#include "IO/FrameBatch.h"
+
+namespace IO
+{
+class FrameReader;
+
+namespace Drivers
+{
+/**
+ * @brief A BLE notification & the characteristic that sent it.
+ */
+struct Notification
+{
+  int characteristic;
+  QByteArray data;
+};
+
+/**
+ * @brief The NotificationDemuxer class
+ *
+ * Separates the notifications received by the @c IO::Drivers::BluetoothLE
+ * driver by characteristic, so that a device can spread its data across
+ * several characteristics (e.g. IMU, environmental & battery data) without
+ * their frames being interleaved.
+ *
+ * Each subscribed characteristic gets its own lane, i.e. a @c IO::FrameReader
+ * of its own, and is numbered as a data source after its position in the
+ * characteristic list of the service (starting at 1). The BLE driver hands
+ * the notifications to the demuxer in batches, the demuxer & its frame
+ * readers live in the BLE reader thread, and the frames of every lane are
+ * emitted through @c framesReady() tagged with their source.
+ */
+class NotificationDemuxer : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void framesReady(const IO::FrameBatch &frames);
+
+public:
+  explicit NotificationDemuxer();
+
+  void processNotifications(
+      const QList<IO::Drivers::Notification> &notifications,
+      const qint64 timestamp);
+
+public slots:
+  void reset();
+  void configure(const QString &start, const QString &finish,
+                 const qsizetype capacity,
+                 const SerialStudio::BufferOverflowPolicy policy);
+
+private:
+  [[nodiscard]] IO::FrameReader *lane(const int characteristic);
+
+private:
+  QString m_startSequence;
+  QString m_finishSequence;
+  qsizetype m_bufferCapacity;
+  SerialStudio::BufferOverflowPolicy m_overflowPolicy;
+
+  QHash<int, IO::FrameReader *> m_lanes;
+};
+} // namespace Drivers
+} // namespace IO
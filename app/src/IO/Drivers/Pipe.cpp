@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include <QFile>
+
+#ifdef Q_OS_WIN
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
+#include "IO/Manager.h"
+#include "IO/Drivers/Pipe.h"
+
+#include "Misc/Utilities.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * Maximum number of bytes read at once
+ */
+static constexpr qsizetype kReadSize = 256 * 1024;
+
+/**
+ * Time that the reader thread waits for data before checking whether the
+ * driver was closed (in milliseconds)
+ */
+static constexpr int kPollTimeout = 100;
+
+/**
+ * Time to wait for the connection to a local socket (in milliseconds)
+ */
+static constexpr int kConnectTimeout = 1000;
+
+/**
+ * Value of the handle member when no handle is open
+ */
+static constexpr qintptr kInvalidHandle = -1;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::Pipe::Pipe()
+  : m_source(Source::StandardInput)
+  , m_thread(nullptr)
+  , m_running(false)
+  , m_handle(kInvalidHandle)
+  , m_socket(nullptr)
+{
+}
+
+/**
+ * Stops reading before destroying the driver
+ */
+IO::Drivers::Pipe::~Pipe()
+{
+  close();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::Pipe &IO::Drivers::Pipe::instance()
+{
+  static Pipe singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Stops the reader thread & closes the pipe or socket
+ */
+void IO::Drivers::Pipe::close()
+{
+  // Stop the reader thread
+  m_running = false;
+  if (m_thread)
+  {
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+
+  // Close the local socket
+  if (m_socket)
+  {
+    m_socket->abort();
+    delete m_socket;
+    m_socket = nullptr;
+  }
+
+  // Close the named pipe, the standard input is left open
+  if (m_handle != kInvalidHandle && m_source == Source::NamedPipe)
+  {
+#ifdef Q_OS_WIN
+    CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+#else
+    ::close(static_cast<int>(m_handle));
+#endif
+  }
+
+  m_handle = kInvalidHandle;
+}
+
+/**
+ * Returns @c true while the reader thread is running
+ */
+bool IO::Drivers::Pipe::isOpen() const
+{
+  return m_thread && !m_thread->isFinished();
+}
+
+/**
+ * Returns @c true while the reader thread is running
+ */
+bool IO::Drivers::Pipe::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c false, the driver only reads data
+ */
+bool IO::Drivers::Pipe::isWritable() const
+{
+  return false;
+}
+
+/**
+ * Returns @c true if the standard input or a path is selected
+ */
+bool IO::Drivers::Pipe::configurationOk() const
+{
+  return m_source == Source::StandardInput || !m_path.isEmpty();
+}
+
+/**
+ * Does nothing, the driver only reads data
+ */
+quint64 IO::Drivers::Pipe::write(const QByteArray &data)
+{
+  (void)data;
+  return 0;
+}
+
+/**
+ * @brief Opens the selected pipe or socket & starts the reader thread.
+ *
+ * @return @c true if the data source is open.
+ */
+bool IO::Drivers::Pipe::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+  close();
+
+  // Validate the configuration
+  if (!configurationOk())
+    return false;
+
+  // Connect to the local socket
+  if (m_source == Source::LocalSocket)
+  {
+    m_socket = new QLocalSocket;
+    m_socket->connectToServer(m_path, QIODevice::ReadOnly);
+    if (!m_socket->waitForConnected(kConnectTimeout))
+    {
+      const auto error = m_socket->errorString();
+      close();
+      Misc::Utilities::showMessageBox(tr("Cannot connect to %1").arg(m_path),
+                                      error);
+      return false;
+    }
+  }
+
+  // Obtain the standard input
+  else if (m_source == Source::StandardInput)
+  {
+#ifdef Q_OS_WIN
+    m_handle = reinterpret_cast<qintptr>(GetStdHandle(STD_INPUT_HANDLE));
+#else
+    m_handle = STDIN_FILENO;
+#endif
+  }
+
+  // Open the named pipe
+  else
+  {
+#ifdef Q_OS_WIN
+    const auto name = reinterpret_cast<LPCWSTR>(m_path.utf16());
+    m_handle = reinterpret_cast<qintptr>(CreateFileW(
+        name, GENERIC_READ, 0, nullptr, OPEN_EXISTING, 0, nullptr));
+#else
+    const auto name = QFile::encodeName(m_path);
+    m_handle = ::open(name.constData(), O_RDONLY | O_NONBLOCK);
+#endif
+  }
+
+  // Validate the handle
+  if (m_source != Source::LocalSocket && m_handle == kInvalidHandle)
+  {
+    Misc::Utilities::showMessageBox(tr("Cannot open %1").arg(m_path),
+                                    tr("Check that the named pipe exists and "
+                                       "that you have permission to read it"));
+    return false;
+  }
+
+  // Start the reader thread
+  m_running = true;
+  m_thread = QThread::create([this] {
+    if (m_socket)
+      readSocket();
+    else
+      readHandle();
+  });
+
+  auto *thread = m_thread;
+  connect(thread, &QThread::finished, this,
+          [this, thread] { onReaderFinished(thread); });
+
+  if (m_socket)
+    m_socket->moveToThread(m_thread);
+
+  m_thread->setObjectName(QStringLiteral("Pipe Reader"));
+  Misc::ThreadScheduler::instance().registerThread(
+      m_thread, Misc::ThreadScheduler::Role::Reader);
+  m_thread->start();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the path of the named pipe or local socket
+ */
+QString IO::Drivers::Pipe::path() const
+{
+  return m_path;
+}
+
+/**
+ * Returns the index of the selected data source, in the list returned by
+ * @c availableSources().
+ */
+int IO::Drivers::Pipe::sourceIndex() const
+{
+  return static_cast<int>(m_source);
+}
+
+/**
+ * Returns the list of data sources that can be selected by the user
+ */
+QStringList IO::Drivers::Pipe::availableSources() const
+{
+  return {tr("Standard Input"), tr("Named Pipe (FIFO)"), tr("Local Socket")};
+}
+
+/**
+ * Changes the path of the named pipe or local socket
+ */
+void IO::Drivers::Pipe::setPath(const QString &path)
+{
+  if (path == m_path)
+    return;
+
+  m_path = path;
+  Q_EMIT pathChanged();
+  Q_EMIT configurationChanged();
+}
+
+/**
+ * Selects the standard input (0), a named pipe (1) or a local socket (2)
+ */
+void IO::Drivers::Pipe::setSourceIndex(const int index)
+{
+  if (index < 0 || index > 2 || index == sourceIndex())
+    return;
+
+  m_source = static_cast<Source>(index);
+  Q_EMIT sourceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+//------------------------------------------------------------------------------
+// Reader thread
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reads the local socket until it is closed by the server or the
+ *        driver is closed.
+ *
+ * Runs in the reader thread, which owns the socket.
+ */
+void IO::Drivers::Pipe::readSocket()
+{
+  while (m_running && m_socket->state() == QLocalSocket::ConnectedState)
+  {
+    if (m_socket->waitForReadyRead(kPollTimeout))
+      processData(m_socket->readAll());
+  }
+
+  // Forward the data received before the server closed the socket
+  if (m_socket->bytesAvailable() > 0)
+    processData(m_socket->readAll());
+}
+
+/**
+ * @brief Reads the standard input or named pipe until the writer closes it
+ *        or the driver is closed.
+ *
+ * Runs in the reader thread. Each block is read into a buffer of its own,
+ * which is moved to the frame reader.
+ */
+void IO::Drivers::Pipe::readHandle()
+{
+#ifdef Q_OS_WIN
+  const auto handle = reinterpret_cast<HANDLE>(m_handle);
+  while (m_running)
+  {
+    // Wait for data on pipes, regular files are read directly
+    DWORD available = kReadSize;
+    if (PeekNamedPipe(handle, nullptr, 0, nullptr, &available, nullptr))
+    {
+      if (available == 0)
+      {
+        QThread::msleep(1);
+        continue;
+      }
+    }
+
+    else if (GetLastError() == ERROR_BROKEN_PIPE)
+      break;
+
+    // Read the pending data
+    DWORD bytes = 0;
+    const auto size = std::min<DWORD>(available, kReadSize);
+    QByteArray buffer(size, Qt::Uninitialized);
+    if (!ReadFile(handle, buffer.data(), size, &bytes, nullptr) || bytes == 0)
+      break;
+
+    buffer.resize(bytes);
+    processData(std::move(buffer));
+  }
+#else
+  const auto fd = static_cast<int>(m_handle);
+  while (m_running)
+  {
+    // Wait for data, so that the thread notices when the driver is closed
+    pollfd descriptor{fd, POLLIN, 0};
+    const auto ready = ::poll(&descriptor, 1, kPollTimeout);
+    if (ready < 0 && errno != EINTR)
+      break;
+
+    if (ready <= 0)
+      continue;
+
+    // Read the pending data, the end of the stream closes the device
+    QByteArray buffer(kReadSize, Qt::Uninitialized);
+    const auto bytes = ::read(fd, buffer.data(), kReadSize);
+    if (bytes == 0 || (bytes < 0 && errno != EINTR && errno != EAGAIN))
+      break;
+
+    if (bytes < 0)
+      continue;
+
+    // Release the unused memory of small reads
+    buffer.resize(bytes);
+    if (bytes < kReadSize / 2)
+      buffer.squeeze();
+
+    processData(std::move(buffer));
+  }
+#endif
+}
+
+/**
+ * Disconnects the device once the writer closed the pipe or socket
+ */
+void IO::Drivers::Pipe::onReaderFinished(QThread *thread)
+{
+  if (thread == m_thread && m_running)
+    Manager::instance().disconnectDevice();
+}
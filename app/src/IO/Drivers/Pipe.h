@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QThread>
+#include <QByteArray>
+#include <QStringList>
+#include <QLocalSocket>
+
+#include "IO/HAL_Driver.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The Pipe class
+ *
+ * Serial Studio driver for data produced by other processes of the same
+ * machine: the standard input of Serial Studio, a named pipe (FIFO) or a
+ * local socket (a Unix domain socket, or a named pipe server on Windows).
+ *
+ * Combined with headless mode, this allows Serial Studio to be used in a
+ * shell pipeline (e.g. @c{devtool | serial-studio --headless --stdin ...})
+ * without going through a loopback network socket.
+ *
+ * Data is read on a dedicated thread in large blocks, which are moved to the
+ * frame reader without being copied. The device disconnects when the writer
+ * closes its end of the pipe or socket.
+ */
+class Pipe : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int sourceIndex
+             READ sourceIndex
+             WRITE setSourceIndex
+             NOTIFY sourceIndexChanged)
+  Q_PROPERTY(QString path
+             READ path
+             WRITE setPath
+             NOTIFY pathChanged)
+  Q_PROPERTY(QStringList availableSources
+             READ availableSources
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void pathChanged();
+  void sourceIndexChanged();
+
+private:
+  explicit Pipe();
+  Pipe(Pipe &&) = delete;
+  Pipe(const Pipe &) = delete;
+  Pipe &operator=(Pipe &&) = delete;
+  Pipe &operator=(const Pipe &) = delete;
+
+  ~Pipe();
+
+public:
+  enum class Source
+  {
+    StandardInput,
+    NamedPipe,
+    LocalSocket
+  };
+  Q_ENUM(Source)
+
+  static Pipe &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] QString path() const;
+  [[nodiscard]] int sourceIndex() const;
+  [[nodiscard]] QStringList availableSources() const;
+
+public slots:
+  void setPath(const QString &path);
+  void setSourceIndex(const int index);
+
+private:
+  void readSocket();
+  void readHandle();
+  void onReaderFinished(QThread *thread);
+
+private:
+  Source m_source;
+  QString m_path;
+
+  QThread *m_thread;
+  std::atomic<bool> m_running;
+
+  qintptr m_handle;
+  QLocalSocket *m_socket;
+};
+} // namespace Drivers
+} // namespace IO
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include <QFileInfo>
+#include <QFileDialog>
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "IO/Drivers/Replay.h"
+
+#include "Misc/Utilities.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * Playback speed factors, zero means unthrottled
+ */
+static constexpr qreal kSpeeds[] = {1, 2, 10, 0};
+
+/**
+ * Maximum number of chunks replayed per tick during unthrottled playback
+ */
+static constexpr qsizetype kMaxBatchSize = 1024;
+
+/**
+ * Maximum time between two playback ticks (in milliseconds)
+ */
+static constexpr qint64 kMaxWait = 100;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::Replay::Replay()
+  : m_speed(0)
+  , m_data(nullptr)
+  , m_position(0)
+  , m_timeOffset(0)
+{
+  m_playbackTimer.setSingleShot(true);
+  m_playbackTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_playbackTimer, &QTimer::timeout, this,
+          &IO::Drivers::Replay::onPlaybackTick);
+
+  connect(this, &IO::Drivers::Replay::fileChanged, this,
+          &IO::Drivers::Replay::configurationChanged);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::Replay &IO::Drivers::Replay::instance()
+{
+  static Replay singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * Stops the playback & unmaps the raw capture file
+ */
+void IO::Drivers::Replay::close()
+{
+  m_playbackTimer.stop();
+
+  if (m_data)
+  {
+    m_file.unmap(m_data);
+    m_data = nullptr;
+  }
+
+  m_file.close();
+  m_chunks.clear();
+  m_chunks.squeeze();
+  m_position = 0;
+}
+
+/**
+ * Returns @c true if a raw capture file is being replayed
+ */
+bool IO::Drivers::Replay::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * Returns @c true if a raw capture file is being replayed
+ */
+bool IO::Drivers::Replay::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c false, data cannot be sent to a raw capture file
+ */
+bool IO::Drivers::Replay::isWritable() const
+{
+  return false;
+}
+
+/**
+ * Returns @c true if the selected raw capture file exists
+ */
+bool IO::Drivers::Replay::configurationOk() const
+{
+  return !m_filePath.isEmpty() && QFileInfo::exists(m_filePath);
+}
+
+/**
+ * Discards the given @a data, since there is no device to write it to
+ */
+quint64 IO::Drivers::Replay::write(const QByteArray &data)
+{
+  (void)data;
+  return 0;
+}
+
+/**
+ * @brief Opens the selected raw capture file & starts replaying it.
+ *
+ * The file is memory-mapped and its chunk table is read before the playback
+ * starts, the file is only read by the playback timer afterwards.
+ *
+ * @return @c true if the file is a valid raw capture, @c false otherwise.
+ */
+bool IO::Drivers::Replay::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+
+  // Close the previous file
+  close();
+
+  // Map the file & read the chunk table
+  m_file.setFileName(m_filePath);
+  if (m_file.open(QIODevice::ReadOnly))
+  {
+    m_data = m_file.map(0, m_file.size());
+    if (RawCapture::readChunks(m_data, m_file.size(), m_chunks))
+    {
+      m_timeOffset = 0;
+      m_playbackClock.start();
+      m_playbackTimer.start(0);
+      return true;
+    }
+  }
+
+  // Error opening or reading the file
+  close();
+  Misc::Utilities::showMessageBox(
+      tr("Cannot replay raw capture file"),
+      tr("The selected file could not be opened or is not a valid raw "
+         "capture file."));
+  return false;
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the index of the current playback speed, in the list returned by
+ * @c availableSpeeds().
+ */
+int IO::Drivers::Replay::speed() const
+{
+  return m_speed;
+}
+
+/**
+ * Returns the name of the selected raw capture file
+ */
+QString IO::Drivers::Replay::fileName() const
+{
+  if (m_filePath.isEmpty())
+    return tr("No file selected");
+
+  return QFileInfo(m_filePath).fileName();
+}
+
+/**
+ * Returns the list of playback speeds that can be selected by the user
+ */
+QStringList IO::Drivers::Replay::availableSpeeds() const
+{
+  return {tr("1x"), tr("2x"), tr("10x"), tr("Unthrottled")};
+}
+
+/**
+ * Lets the user select a raw capture file to replay
+ */
+void IO::Drivers::Replay::openFile()
+{
+  const auto dir = QStringLiteral("%1/%2/Raw Captures")
+                       .arg(QStandardPaths::writableLocation(
+                                QStandardPaths::DocumentsLocation),
+                            qApp->applicationDisplayName());
+
+  const auto file = QFileDialog::getOpenFileName(
+      nullptr, tr("Select raw capture file"), dir,
+      tr("Raw capture files") + QStringLiteral(" (*.ssraw)"));
+
+  if (!file.isEmpty())
+    setFilePath(file);
+}
+
+/**
+ * @brief Changes the playback speed.
+ *
+ * The replay time is rebased on the next chunk to replay, so that changing
+ * the speed during playback neither skips nor bursts chunks.
+ *
+ * @param speed Index of the new speed, in the list returned by
+ *              @c availableSpeeds().
+ */
+void IO::Drivers::Replay::setSpeed(const int speed)
+{
+  const auto count = static_cast<int>(std::size(kSpeeds));
+  m_speed = std::clamp(speed, 0, count - 1);
+  Q_EMIT speedChanged();
+
+  if (isOpen() && m_position < m_chunks.count())
+  {
+    m_timeOffset = m_chunks[m_position].timestamp;
+    m_playbackClock.start();
+    m_playbackTimer.start(0);
+  }
+}
+
+/**
+ * Selects the raw capture file to replay when the device is connected
+ */
+void IO::Drivers::Replay::setFilePath(const QString &path)
+{
+  m_filePath = path;
+  Q_EMIT fileChanged();
+}
+
+/**
+ * @brief Replays every chunk that is due.
+ *
+ * All chunks whose timestamp has been reached since the last tick are emitted
+ * at once, so that captures with thousands of chunks per second are replayed
+ * at their real speed regardless of the resolution of the system timer.
+ *
+ * In unthrottled mode, timestamps are ignored and up to @c kMaxBatchSize
+ * chunks are emitted per tick, the next tick runs as soon as the event loop
+ * has processed the previous batch.
+ */
+void IO::Drivers::Replay::onPlaybackTick()
+{
+  // Playback stopped
+  if (!isOpen())
+    return;
+
+  // Emit every chunk that is due
+  qsizetype count = 0;
+  const auto speed = kSpeeds[m_speed];
+  const auto time = replayTime();
+  const auto now = Misc::PipelineStats::timestamp();
+  while (m_position < m_chunks.count())
+  {
+    const auto &chunk = m_chunks[m_position];
+    if (speed <= 0 && count >= kMaxBatchSize)
+      break;
+    else if (speed > 0 && chunk.timestamp > time)
+      break;
+
+    const auto *data = reinterpret_cast<const char *>(m_data + chunk.offset);
+    Q_EMIT dataReceived(QByteArray(data, chunk.size), now);
+
+    ++count;
+    ++m_position;
+  }
+
+  // End of capture, close the connection
+  if (m_position >= m_chunks.count())
+  {
+    QTimer::singleShot(0, &IO::Manager::instance(),
+                       &IO::Manager::disconnectDevice);
+    return;
+  }
+
+  // Unthrottled playback, run again as soon as possible
+  if (speed <= 0)
+  {
+    m_playbackTimer.start(0);
+    return;
+  }
+
+  // Wait until the next chunk is due
+  const auto wait = (m_chunks[m_position].timestamp - time) / speed / 1e6;
+  m_playbackTimer.start(static_cast<int>(qBound<qreal>(0, wait, kMaxWait)));
+}
+
+/**
+ * Returns the current position of the playback in the timeline of the raw
+ * capture file, in nanoseconds.
+ */
+qint64 IO::Drivers::Replay::replayTime() const
+{
+  const auto speed = kSpeeds[m_speed];
+  if (speed <= 0)
+    return m_timeOffset;
+
+  return m_timeOffset
+         + static_cast<qint64>(m_playbackClock.nsecsElapsed() * speed);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include <QElapsedTimer>
+
+#include "IO/HAL_Driver.h"
+#include "IO/RawCapture.h"
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The Replay class
+ *
+ * Serial Studio "driver" class that replays raw capture files recorded by the
+ * @c IO::RawCapture class. Every chunk of the capture is reported through the
+ * @c dataReceived() signal exactly as it was received from the original
+ * device, either at its original timing, accelerated, or as fast as the
+ * frame reader is able to process it. This allows reproducing frame reader &
+ * parser issues with the byte chunking of a real-world session.
+ *
+ * The capture file is memory-mapped while the driver is open, and the
+ * connection is closed automatically once the last chunk has been replayed.
+ */
+class Replay : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(QString fileName
+             READ fileName
+             NOTIFY fileChanged)
+  Q_PROPERTY(int speed
+             READ speed
+             WRITE setSpeed
+             NOTIFY speedChanged)
+  Q_PROPERTY(QStringList availableSpeeds
+             READ availableSpeeds
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void fileChanged();
+  void speedChanged();
+
+private:
+  explicit Replay();
+  Replay(Replay &&) = delete;
+  Replay(const Replay &) = delete;
+  Replay &operator=(Replay &&) = delete;
+  Replay &operator=(const Replay &) = delete;
+
+public:
+  static Replay &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] int speed() const;
+  [[nodiscard]] QString fileName() const;
+  [[nodiscard]] QStringList availableSpeeds() const;
+
+public slots:
+  void openFile();
+  void setSpeed(const int speed);
+  void setFilePath(const QString &path);
+
+private slots:
+  void onPlaybackTick();
+
+private:
+  [[nodiscard]] qint64 replayTime() const;
+
+private:
+  int m_speed;
+  QFile m_file;
+  QString m_filePath;
+
+  uchar *m_data;
+  qsizetype m_position;
+  QVector<RawCapture::Chunk> m_chunks;
+
+  qint64 m_timeOffset;
+  QTimer m_playbackTimer;
+  QElapsedTimer m_playbackClock;
+};
+} // namespace Drivers
+} // namespace IO
@@ -20,12 +20,38 @@
  * THE SOFTWARE.
  */
 
+#include <QFile>
+#include <QCoreApplication>
+
+#ifdef Q_OS_WIN
+#  include <windows.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#  include <sys/ioctl.h>
+#  include <linux/serial.h>
+#endif
+
 #include "IO/Manager.h"
 #include "IO/Drivers/Serial.h"
 
 #include "Misc/Utilities.h"
 #include "Misc/Translator.h"
 #include "Misc/TimerEvents.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * Latency timer (in milliseconds) of FTDI adapters in low latency mode, and
+ * the default value of the FTDI driver
+ */
+static constexpr int kFtdiLowLatencyTimer = 1;
+static constexpr int kFtdiDefaultLatencyTimer = 16;
+
+/**
+ * Largest OS receive buffer that can be requested for a serial port
+ */
+static constexpr int kMaxRxBufferSize = 16 * 1024 * 1024;
 
 //------------------------------------------------------------------------------
 // Constructor/destructor & singleton access functions
@@ -37,7 +63,10 @@
 IO::Drivers::Serial::Serial()
   : m_port(nullptr)
   , m_dtrEnabled(true)
+  , m_lowLatency(false)
   , m_autoReconnect(false)
+  , m_rxBufferSize(0)
+  , m_lastReadTime(0)
   , m_usingCustomSerialPort(false)
   , m_lastSerialDeviceIndex(0)
   , m_portIndex(0)
@@ -63,6 +92,20 @@ IO::Drivers::Serial::Serial()
   // Update error list when language is changed
   connect(this, &IO::Drivers::Serial::languageChanged, this,
           &IO::Drivers::Serial::populateErrors);
+
+  // Stop the reader thread when quitting the application
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    disconnectDevice();
+    m_readerThread.quit();
+    if (!m_readerThread.wait(100))
+      m_readerThread.terminate();
+  });
+
+  // Start the thread that drains the serial port
+  m_readerThread.setObjectName(QStringLiteral("Serial Reader"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_readerThread, Misc::ThreadScheduler::Role::Reader);
+  m_readerThread.start(QThread::TimeCriticalPriority);
 }
 
 /**
@@ -97,7 +140,11 @@ void IO::Drivers::Serial::close()
 {
   if (isOpen())
   {
-    port()->close();
+    // Fail the unwritten data, so the next port starts without tickets
+    runInPortThread([=] {
+      port()->close();
+      failPendingWrites();
+    });
     port()->deleteLater();
     m_port = nullptr;
   }
@@ -145,21 +192,88 @@ bool IO::Drivers::Serial::configurationOk() const
   return portIndex() > 0;
 }
 
+/**
+ * Returns the maximum number of bytes per second that the serial port can
+ * receive, assuming ten symbols per byte (start bit, 8 data bits & stop bit).
+ */
+qint64 IO::Drivers::Serial::dataRate() const
+{
+  return baudRate() / 10;
+}
+
+/**
+ * Returns @c true, writes issued from other threads are queued in the reader
+ * thread, where the serial port lives.
+ */
+bool IO::Drivers::Serial::supportsThreadSafeWrites() const
+{
+  return true;
+}
+
 /**
  * @brief Writes data to the serial port.
  *
- * Sends the provided data to the serial port if it is writable.
+ * Sends the provided data to the serial port if it is writable. The data is
+ * handed to the reader thread without waiting for it, so that large writes
+ * never block the caller (usually the UI thread). Use @c beginWrite() to be
+ * notified when the bytes are actually written.
  *
  * @param data The data to be written to the port.
- * @return The number of bytes written on success, or `-1` if the port is not
+ * @return The number of bytes queued on success, or `-1` if the port is not
  *         writable.
  */
 quint64 IO::Drivers::Serial::write(const QByteArray &data)
 {
-  if (isWritable())
-    return port()->write(data);
+  if (!isWritable())
+    return -1;
+
+  // Write directly if the port lives in the current thread
+  auto *serialPort = port();
+  const auto *thread = serialPort->thread();
+  if (QThread::currentThread() == thread || !thread->isRunning())
+    return writeToPort(serialPort, 0, data);
 
-  return -1;
+  // Queue the write in the reader thread
+  QMetaObject::invokeMethod(
+      serialPort, [=] { (void)writeToPort(serialPort, 0, data); },
+      Qt::QueuedConnection);
+
+  return data.size();
+}
+
+/**
+ * @brief Queues a write in the reader thread & reports its completion.
+ *
+ * The @c writeFinished() signal is emitted from the reader thread once
+ * @c QSerialPort::bytesWritten() accounts for every byte of @a data, or with
+ * -1 if the port rejects the data, reports a write error or is closed before
+ * the data is written.
+ *
+ * @param ticket Number chosen by the caller to identify the write.
+ * @param data The data to be written to the port.
+ */
+void IO::Drivers::Serial::beginWrite(const quint64 ticket,
+                                     const QByteArray &data)
+{
+  if (!isWritable())
+  {
+    Q_EMIT writeFinished(ticket, -1);
+    return;
+  }
+
+  // Write directly if the port lives in the current thread
+  auto *serialPort = port();
+  const auto *thread = serialPort->thread();
+  if (QThread::currentThread() == thread || !thread->isRunning())
+  {
+    (void)writeToPort(serialPort, ticket, data);
+    return;
+  }
+
+  // Queue the write in the reader thread
+  QMetaObject::invokeMethod(
+      serialPort, [=] { (void)writeToPort(serialPort, ticket, data); },
+      Qt::QueuedConnection);
 }
 
 /**
@@ -209,18 +323,37 @@ bool IO::Drivers::Serial::open(const QIODevice::OpenMode mode)
     port()->setStopBits(stopBits());
     port()->setFlowControl(flowControl());
 
-    // Connect signals/slots
+    // Connect signals/slots, read data directly in the reader thread
     connect(port(), &QSerialPort::errorOccurred, this,
-            &IO::Drivers::Serial::handleError);
+            &IO::Drivers::Serial::handleError, Qt::QueuedConnection);
+    connect(port(), &QIODevice::readyRead, this,
+            &IO::Drivers::Serial::onReadyRead, Qt::DirectConnection);
+    connect(port(), &QIODevice::bytesWritten, this,
+            &IO::Drivers::Serial::onBytesWritten, Qt::DirectConnection);
+    connect(
+        port(), &QSerialPort::errorOccurred, this,
+        [this](QSerialPort::SerialPortError error) {
+          if (error == QSerialPort::WriteError)
+            failPendingWrites();
+        },
+        Qt::DirectConnection);
+
+    // Move the port to the reader thread & open it from there
+    bool opened = false;
+    m_lastReadTime = 0;
+    port()->moveToThread(&m_readerThread);
+    runInPortThread([&] {
+      opened = port()->open(mode);
+      if (opened)
+      {
+        port()->setDataTerminalReady(dtrEnabled());
+        applyLatencySettings();
+      }
+    });
 
-    // Open device
-    if (port()->open(mode))
-    {
-      connect(port(), &QIODevice::readyRead, this,
-              &IO::Drivers::Serial::onReadyRead);
-      port()->setDataTerminalReady(dtrEnabled());
+    // Device opened successfully
+    if (opened)
       return true;
-    }
 
     // Display error
     else
@@ -239,6 +372,90 @@ bool IO::Drivers::Serial::open(const QIODevice::OpenMode mode)
 // Driver specifics
 //------------------------------------------------------------------------------
 
+/**
+ * @brief Writes @a data to the serial port & tracks it until it is written.
+ *
+ * Writes identified by a non-zero @a ticket are reported with
+ * @c writeFinished(), right away if the port rejects the data.
+ *
+ * @note This function must be called from the reader thread.
+ *
+ * @param serialPort The port that the write was issued to.
+ * @param ticket Number chosen by the caller, 0 if it does not need to know
+ *               when the data is written.
+ * @param data The data to be written to the port.
+ * @return The number of bytes accepted by the port, or -1 on failure.
+ */
+qint64 IO::Drivers::Serial::writeToPort(QSerialPort *serialPort,
+                                        const quint64 ticket,
+                                        const QByteArray &data)
+{
+  // Port was closed after the write was queued
+  if (!serialPort->isOpen())
+  {
+    if (ticket != 0)
+      Q_EMIT writeFinished(ticket, -1);
+
+    return -1;
+  }
+
+  // Write the data & report rejected writes immediately
+  const auto bytes = serialPort->write(data);
+  if (bytes <= 0)
+  {
+    if (ticket != 0)
+      Q_EMIT writeFinished(ticket, bytes < 0 ? -1 : 0);
+
+    return bytes;
+  }
+
+  // Wait for the bytes to be written
+  m_pendingWrites.enqueue({ticket, bytes, bytes});
+  return bytes;
+}
+
+/**
+ * @brief Reports every write that has not been fully written as failed.
+ *
+ * Called when the port reports a write error or is closed.
+ *
+ * @note This function must be called from the reader thread.
+ */
+void IO::Drivers::Serial::failPendingWrites()
+{
+  while (!m_pendingWrites.isEmpty())
+  {
+    const auto write = m_pendingWrites.dequeue();
+    if (write.ticket != 0)
+      Q_EMIT writeFinished(write.ticket, -1);
+  }
+}
+
+/**
+ * @brief Runs the given function in the thread that owns the serial port.
+ *
+ * The serial port object lives in a dedicated reader thread, so that incoming
+ * data is drained even while the GUI thread is busy. @c QSerialPort is not
+ * thread-safe, so every configuration change, write or close operation is
+ * marshalled to the reader thread and executed there. The calling thread
+ * blocks until the function returns, which allows capturing locals by
+ * reference.
+ *
+ * @param function The function to execute, does nothing if no port exists.
+ */
+template<typename Function>
+void IO::Drivers::Serial::runInPortThread(Function function) const
+{
+  if (!port())
+    return;
+
+  const auto *thread = port()->thread();
+  if (QThread::currentThread() == thread || !thread->isRunning())
+    function();
+  else
+    QMetaObject::invokeMethod(port(), function, Qt::BlockingQueuedConnection);
+}
+
 /**
  * Returns the pointer to the current serial port handler
  */
@@ -265,6 +482,24 @@ bool IO::Drivers::Serial::dtrEnabled() const
   return m_dtrEnabled;
 }
 
+/**
+ * Returns @c true if the OS is asked to deliver received bytes without
+ * batching them
+ */
+bool IO::Drivers::Serial::lowLatency() const
+{
+  return m_lowLatency;
+}
+
+/**
+ * Returns the size of the OS receive buffer requested for the serial port, or
+ * zero to use the default size of the driver
+ */
+int IO::Drivers::Serial::rxBufferSize() const
+{
+  return m_rxBufferSize;
+}
+
 /**
  * Returns the index of the current serial device selected by the program.
  */
@@ -446,8 +681,11 @@ void IO::Drivers::Serial::disconnectDevice()
     // Disconnect signals/slots
     disconnect(port());
 
-    // Close & delete serial port handler
-    port()->close();
+    // Close & delete serial port handler, the unwritten data is lost
+    runInPortThread([=] {
+      port()->close();
+      failPendingWrites();
+    });
     port()->deleteLater();
   }
 
@@ -466,9 +704,17 @@ void IO::Drivers::Serial::disconnectDevice()
  */
 void IO::Drivers::Serial::setupExternalConnections()
 {
-  // Build serial devices list and refresh it every second
-  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
-          &IO::Drivers::Serial::refreshSerialDevices);
+  // Build serial devices list
+  refreshSerialDevices();
+
+  // Refresh the list when the system reports a device change, or poll the
+  // available ports every second if hotplug events are not available
+  if (m_deviceMonitor.isSupported())
+    connect(&m_deviceMonitor, &DeviceMonitor::devicesChanged, this,
+            &IO::Drivers::Serial::refreshSerialDevices);
+  else
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+            this, &IO::Drivers::Serial::refreshSerialDevices);
 
   // Update lists when language changes
   connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
@@ -487,8 +733,7 @@ void IO::Drivers::Serial::setBaudRate(const qint32 rate)
   m_baudRate = rate;
 
   // Update serial port config
-  if (port())
-    port()->setBaudRate(baudRate());
+  runInPortThread([=] { port()->setBaudRate(baudRate()); });
 
   // Update user interface
   Q_EMIT baudRateChanged();
@@ -511,11 +756,44 @@ void IO::Drivers::Serial::setDtrEnabled(const bool enabled)
   m_dtrEnabled = enabled;
 
   if (port() && port()->isOpen())
-    port()->setDataTerminalReady(enabled);
+    runInPortThread([=] { port()->setDataTerminalReady(enabled); });
 
   Q_EMIT dtrEnabledChanged();
 }
 
+/**
+ * Enables or disables the low latency mode of the serial port, which is
+ * applied right away if the port is open
+ */
+void IO::Drivers::Serial::setLowLatency(const bool enabled)
+{
+  if (m_lowLatency != enabled)
+  {
+    m_lowLatency = enabled;
+    if (isOpen())
+      runInPortThread([=] { applyLatencySettings(); });
+
+    Q_EMIT lowLatencyChanged();
+  }
+}
+
+/**
+ * Changes the size of the OS receive buffer requested for the serial port,
+ * zero restores the default size of the driver
+ */
+void IO::Drivers::Serial::setRxBufferSize(const int bytes)
+{
+  const auto size = qBound(0, bytes, kMaxRxBufferSize);
+  if (m_rxBufferSize != size)
+  {
+    m_rxBufferSize = size;
+    if (isOpen())
+      runInPortThread([=] { applyLatencySettings(); });
+
+    Q_EMIT rxBufferSizeChanged();
+  }
+}
+
 /**
  * Changes the port index value, this value is later used by the @c
  * openSerialPort() function.
@@ -593,8 +871,7 @@ void IO::Drivers::Serial::setParity(const quint8 parityIndex)
   }
 
   // Update serial port config.
-  if (port())
-    port()->setParity(parity());
+  runInPortThread([=] { port()->setParity(parity()); });
 
   // Notify user interface
   Q_EMIT parityChanged();
@@ -648,8 +925,7 @@ void IO::Drivers::Serial::setDataBits(const quint8 dataBitsIndex)
   }
 
   // Update serial port configuration
-  if (port())
-    port()->setDataBits(dataBits());
+  runInPortThread([=] { port()->setDataBits(dataBits()); });
 
   // Update user interface
   Q_EMIT dataBitsChanged();
@@ -684,8 +960,7 @@ void IO::Drivers::Serial::setStopBits(const quint8 stopBitsIndex)
   }
 
   // Update serial port configuration
-  if (port())
-    port()->setStopBits(stopBits());
+  runInPortThread([=] { port()->setStopBits(stopBits()); });
 
   // Update user interface
   Q_EMIT stopBitsChanged();
@@ -729,8 +1004,7 @@ void IO::Drivers::Serial::setFlowControl(const quint8 flowControlIndex)
   }
 
   // Update serial port configuration
-  if (port())
-    port()->setFlowControl(flowControl());
+  runInPortThread([=] { port()->setFlowControl(flowControl()); });
 
   // Update user interface
   Q_EMIT flowControlChanged();
@@ -841,11 +1115,54 @@ void IO::Drivers::Serial::handleError(QSerialPort::SerialPortError error)
 
 /**
  * Reads all the data from the serial port.
+ *
+ * @note This function is called from the reader thread, the data is forwarded
+ *       to the frame reader without going through the GUI event loop.
  */
 void IO::Drivers::Serial::onReadyRead()
 {
-  if (isOpen())
-    processData(port()->readAll());
+  if (!isOpen())
+    return;
+
+  // Read the data & the current time
+  auto data = port()->readAll();
+  const auto now = Misc::PipelineStats::timestamp();
+
+  // The bytes of a chunk arrive one after another at the baud rate, so its
+  // oldest byte waited at least as long as the chunk took on the wire, but
+  // no longer than the time since the previous chunk was read
+  auto waited = qint64(data.size()) * 10 * 1000000000 / qMax(baudRate(), 1);
+  if (m_lastReadTime > 0)
+    waited = qMin(waited, now - m_lastReadTime);
+
+  m_lastReadTime = now;
+  processData(std::move(data), now - waited);
+}
+
+/**
+ * Accounts the @a bytes that the serial port wrote to the OS to the pending
+ * writes, in the order in which they were queued, and reports every write
+ * whose bytes have all been written.
+ *
+ * @note This function is called from the reader thread.
+ */
+void IO::Drivers::Serial::onBytesWritten(const qint64 bytes)
+{
+  qint64 available = bytes;
+  while (available > 0 && !m_pendingWrites.isEmpty())
+  {
+    auto &write = m_pendingWrites.head();
+    const auto written = qMin(available, write.remaining);
+    write.remaining -= written;
+    available -= written;
+
+    if (write.remaining == 0)
+    {
+      const auto finished = m_pendingWrites.dequeue();
+      if (finished.ticket != 0)
+        Q_EMIT writeFinished(finished.ticket, finished.size);
+    }
+  }
 }
 
 /**
@@ -949,6 +1266,60 @@ void IO::Drivers::Serial::populateErrors()
   // clang-format on
 }
 
+/**
+ * @brief Applies the low latency & receive buffer options to the open port.
+ *
+ * On Linux, the @c ASYNC_LOW_LATENCY flag is set through @c TIOCSSERIAL,
+ * which the @c ftdi_sio kernel driver turns into a 1 ms latency timer. The
+ * @c latency_timer attribute of USB serial adapters is written as well, in
+ * case the driver ignores the flag (writing it usually requires permission
+ * from a udev rule). On Windows, the receive buffer size is requested with
+ * @c SetupComm(); the other platforms do not allow changing it.
+ *
+ * @note This function must be called from the reader thread.
+ */
+void IO::Drivers::Serial::applyLatencySettings()
+{
+  if (!isOpen())
+    return;
+
+#if defined(Q_OS_LINUX)
+  // Change the low latency flag of the tty
+  const int fd = port()->handle();
+  struct serial_struct serial;
+  if (ioctl(fd, TIOCGSERIAL, &serial) == 0)
+  {
+    if (m_lowLatency)
+      serial.flags |= ASYNC_LOW_LATENCY;
+    else
+      serial.flags &= ~ASYNC_LOW_LATENCY;
+
+    if (ioctl(fd, TIOCSSERIAL, &serial) != 0)
+      qWarning() << "Cannot change the latency mode of" << port()->portName();
+  }
+
+  // Change the latency timer of FTDI adapters
+  QFile timer(QStringLiteral("/sys/bus/usb-serial/devices/%1/latency_timer")
+                  .arg(port()->portName()));
+  if (timer.exists() && timer.open(QFile::WriteOnly))
+  {
+    const auto value = m_lowLatency ? kFtdiLowLatencyTimer
+                                    : kFtdiDefaultLatencyTimer;
+    timer.write(QByteArray::number(value));
+  }
+
+#elif defined(Q_OS_WIN)
+  // Request the buffer sizes, the driver may round or ignore them
+  if (m_rxBufferSize > 0)
+  {
+    const auto size = DWORD(m_rxBufferSize);
+    auto handle = static_cast<HANDLE>(port()->handle());
+    if (!SetupComm(handle, size, size))
+      qWarning() << "Cannot change the buffer size of" << port()->portName();
+  }
+#endif
+}
+
 /**
  * Returns a list with all the valid serial port objects
  */
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <QObject>
+#include <QThread>
 #include <QString>
 #include <QSettings>
 #include <QByteArray>
@@ -31,6 +32,7 @@
 #include <QQuickTextDocument>
 
 #include "IO/HAL_Driver.h"
+#include "Platform/DeviceMonitor.h"
 
 namespace IO
 {
@@ -39,6 +41,22 @@ namespace Drivers
 /**
  * @brief The Serial class
  * Serial Studio "driver" class to interact with serial port devices.
+ *
+ * The underlying @c QSerialPort lives in a dedicated, time-critical reader
+ * thread, so that the OS buffers are drained even when the GUI thread is busy
+ * rendering the dashboard.
+ *
+ * The low latency option asks the OS to deliver received bytes as soon as
+ * possible rather than in batches (e.g. every 16 ms with the default latency
+ * timer of FTDI adapters). The time that each chunk waited before it was
+ * read is estimated from its size & the baud rate, and reported to the
+ * pipeline statistics.
+ *
+ * Writes are queued in the reader thread without blocking the caller. Each
+ * write is tracked until @c QSerialPort::bytesWritten() reports that all of
+ * its bytes reached the OS, and only then is it reported as finished, so that
+ * the transmission queue of @c IO::Manager reflects the data that is still
+ * waiting in the write buffer of the port.
  */
 class Serial : public HAL_Driver
 {
@@ -52,6 +70,14 @@ class Serial : public HAL_Driver
              READ dtrEnabled
              WRITE setDtrEnabled
              NOTIFY dtrEnabledChanged)
+  Q_PROPERTY(bool lowLatency
+             READ lowLatency
+             WRITE setLowLatency
+             NOTIFY lowLatencyChanged)
+  Q_PROPERTY(int rxBufferSize
+             READ rxBufferSize
+             WRITE setRxBufferSize
+             NOTIFY rxBufferSizeChanged)
   Q_PROPERTY(quint8 portIndex
              READ portIndex
              WRITE setPortIndex
@@ -105,10 +131,12 @@ signals:
   void stopBitsChanged();
   void portIndexChanged();
   void dtrEnabledChanged();
+  void lowLatencyChanged();
   void flowControlChanged();
   void baudRateListChanged();
   void autoReconnectChanged();
   void baudRateIndexChanged();
+  void rxBufferSizeChanged();
   void availablePortsChanged();
   void connectionError(const QString &name);
 
@@ -130,13 +158,18 @@ public:
   [[nodiscard]] bool isReadable() const override;
   [[nodiscard]] bool isWritable() const override;
   [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] qint64 dataRate() const override;
+  [[nodiscard]] bool supportsThreadSafeWrites() const override;
   [[nodiscard]] quint64 write(const QByteArray &data) override;
   [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+  void beginWrite(const quint64 ticket, const QByteArray &data) override;
 
   [[nodiscard]] QSerialPort *port() const;
   [[nodiscard]] bool autoReconnect() const;
 
   [[nodiscard]] bool dtrEnabled() const;
+  [[nodiscard]] bool lowLatency() const;
+  [[nodiscard]] int rxBufferSize() const;
   [[nodiscard]] quint8 portIndex() const;
   [[nodiscard]] quint8 parityIndex() const;
   [[nodiscard]] quint8 displayMode() const;
@@ -163,6 +196,8 @@ public slots:
   void setupExternalConnections();
   void setBaudRate(const qint32 rate);
   void setDtrEnabled(const bool enabled);
+  void setLowLatency(const bool enabled);
+  void setRxBufferSize(const int bytes);
   void setParity(const quint8 parityIndex);
   void setPortIndex(const quint8 portIndex);
   void registerDevice(const QString &device);
@@ -178,16 +213,37 @@ private slots:
   void writeSettings();
   void populateErrors();
   void refreshSerialDevices();
+  void onBytesWritten(const qint64 bytes);
   void handleError(QSerialPort::SerialPortError error);
 
 private:
+  void failPendingWrites();
+  void applyLatencySettings();
+  qint64 writeToPort(QSerialPort *serialPort, const quint64 ticket,
+                     const QByteArray &data);
   QVector<QSerialPortInfo> validPorts() const;
 
+  template<typename Function>
+  void runInPortThread(Function function) const;
+
 private:
   QSerialPort *m_port;
+  QThread m_readerThread;
+
+  struct PendingWrite
+  {
+    quint64 ticket;
+    qint64 size;
+    qint64 remaining;
+  };
+
+  QQueue<PendingWrite> m_pendingWrites;
 
   bool m_dtrEnabled;
+  bool m_lowLatency;
   bool m_autoReconnect;
+  int m_rxBufferSize;
+  qint64 m_lastReadTime;
   int m_lastSerialDeviceIndex;
   bool m_usingCustomSerialPort;
 
@@ -210,6 +266,8 @@ private:
 
   QStringList m_baudRateList;
   QMap<QSerialPort::SerialPortError, QString> m_errorDescriptions;
+
+  DeviceMonitor m_deviceMonitor;
 };
 } // namespace Drivers
 } // namespace IO
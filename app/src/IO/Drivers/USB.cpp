@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#ifdef ENABLE_LIBUSB
+#  include <libusb.h>
+#endif
+
+#include "IO/Manager.h"
+#include "IO/Drivers/USB.h"
+
+#include "Misc/Utilities.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * Number of bulk transfers kept in flight & size of the buffer of each one,
+ * which is a multiple of the packet size of every USB speed
+ */
+static constexpr int kTransferCount = 16;
+static constexpr int kTransferSize = 64 * 1024;
+
+/**
+ * Time to wait for a write to the bulk OUT endpoint (in milliseconds)
+ */
+static constexpr unsigned int kWriteTimeout = 1000;
+
+#ifdef ENABLE_LIBUSB
+/**
+ * @brief Bulk transfer of the transfer ring & the buffer that it fills.
+ */
+struct IO::Drivers::USB::Transfer
+{
+  USB *driver;
+  QByteArray buffer;
+  libusb_transfer *handle;
+
+  static void LIBUSB_CALL onCompleted(libusb_transfer *transfer);
+};
+
+/**
+ * @brief Forwards the data of a finished transfer & submits it again.
+ *
+ * Called by libusb from the event thread. The filled buffer is moved to the
+ * frame reader and the transfer is given a new buffer before it is submitted
+ * again, as long as the driver is running. Transfers that are cancelled or
+ * fail are released, and the device is disconnected if it was unplugged.
+ */
+void LIBUSB_CALL
+IO::Drivers::USB::Transfer::onCompleted(libusb_transfer *transfer)
+{
+  auto *self = static_cast<Transfer *>(transfer->user_data);
+  auto *driver = self->driver;
+
+  // Hand the received data over to the frame reader
+  const auto status = transfer->status;
+  if (status == LIBUSB_TRANSFER_COMPLETED && transfer->actual_length > 0)
+  {
+    self->buffer.resize(transfer->actual_length);
+    driver->processData(std::move(self->buffer));
+    self->buffer = QByteArray(kTransferSize, Qt::Uninitialized);
+    transfer->buffer = reinterpret_cast<unsigned char *>(self->buffer.data());
+  }
+
+  // Submit the transfer again
+  const bool resubmit = status == LIBUSB_TRANSFER_COMPLETED
+                        || status == LIBUSB_TRANSFER_TIMED_OUT;
+  if (resubmit && driver->m_running && libusb_submit_transfer(transfer) == 0)
+    return;
+
+  // Release the transfer & disconnect if the device is gone
+  --driver->m_activeTransfers;
+  if (driver->m_running && status != LIBUSB_TRANSFER_CANCELLED)
+    driver->onDeviceLost();
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::Drivers::USB::USB()
+  : m_deviceIndex(0)
+  , m_interface(-1)
+  , m_inEndpoint(0)
+  , m_outEndpoint(0)
+  , m_dataRate(0)
+  , m_context(nullptr)
+  , m_handle(nullptr)
+  , m_eventThread(nullptr)
+  , m_running(false)
+  , m_activeTransfers(0)
+{
+#ifdef ENABLE_LIBUSB
+  if (libusb_init(&m_context) != 0)
+    m_context = nullptr;
+#endif
+
+  refreshDevices();
+}
+
+/**
+ * Disconnects from the device & releases libusb before destroying the driver
+ */
+IO::Drivers::USB::~USB()
+{
+  close();
+
+#ifdef ENABLE_LIBUSB
+  if (m_context)
+    libusb_exit(m_context);
+#endif
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Drivers::USB &IO::Drivers::USB::instance()
+{
+  static USB singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// HAL driver implementation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Stops the transfer ring & releases the device.
+ *
+ * Every transfer is cancelled, and the event thread keeps processing events
+ * until all of them have been released, before it is stopped.
+ */
+void IO::Drivers::USB::close()
+{
+#ifdef ENABLE_LIBUSB
+  // Stop resubmitting transfers & cancel the ones in flight
+  m_running = false;
+  for (auto *transfer : std::as_const(m_transfers))
+    libusb_cancel_transfer(transfer->handle);
+
+  // Wait until the event thread has released every transfer
+  if (m_eventThread)
+  {
+    m_eventThread->wait();
+    delete m_eventThread;
+    m_eventThread = nullptr;
+  }
+
+  // Free the transfers & their buffers
+  for (auto *transfer : std::as_const(m_transfers))
+  {
+    libusb_free_transfer(transfer->handle);
+    delete transfer;
+  }
+
+  m_transfers.clear();
+  m_activeTransfers = 0;
+
+  // Release the device
+  if (m_handle)
+  {
+    if (m_interface >= 0)
+      libusb_release_interface(m_handle, m_interface);
+
+    libusb_close(m_handle);
+    m_handle = nullptr;
+  }
+#endif
+
+  m_interface = -1;
+  m_inEndpoint = 0;
+  m_outEndpoint = 0;
+  m_dataRate = 0;
+}
+
+/**
+ * Returns @c true if the device is open
+ */
+bool IO::Drivers::USB::isOpen() const
+{
+  return m_handle != nullptr;
+}
+
+/**
+ * Returns @c true if the device is open
+ */
+bool IO::Drivers::USB::isReadable() const
+{
+  return isOpen();
+}
+
+/**
+ * Returns @c true if the device is open & has a bulk OUT endpoint
+ */
+bool IO::Drivers::USB::isWritable() const
+{
+  return isOpen() && m_outEndpoint != 0;
+}
+
+/**
+ * Returns @c true if a device is selected
+ */
+bool IO::Drivers::USB::configurationOk() const
+{
+  return m_deviceIndex >= 0 && m_deviceIndex < m_devices.count();
+}
+
+/**
+ * Returns the signalling rate of the bus that the device is connected to,
+ * divided by eight, which is an upper bound of its throughput.
+ */
+qint64 IO::Drivers::USB::dataRate() const
+{
+  return m_dataRate;
+}
+
+/**
+ * @brief Sends data to the bulk OUT endpoint of the device.
+ *
+ * @param data The data to send.
+ * @return The number of bytes written.
+ */
+quint64 IO::Drivers::USB::write(const QByteArray &data)
+{
+#ifdef ENABLE_LIBUSB
+  if (!isWritable() || data.isEmpty())
+    return 0;
+
+  int written = 0;
+  const auto *constBytes = reinterpret_cast<const uchar *>(data.constData());
+  auto *bytes = const_cast<uchar *>(constBytes);
+  const auto result = libusb_bulk_transfer(m_handle, m_outEndpoint, bytes,
+                                           static_cast<int>(data.size()),
+                                           &written, kWriteTimeout);
+  if (result != 0 && written <= 0)
+    return 0;
+
+  Q_EMIT dataSent(data.left(written));
+  return written;
+#else
+  (void)data;
+  return 0;
+#endif
+}
+
+/**
+ * @brief Opens the selected device & starts the transfer ring.
+ *
+ * The first interface with a bulk IN endpoint is claimed (detaching its
+ * kernel driver if needed), and its bulk OUT endpoint, if any, is used for
+ * writing.
+ *
+ * @return @c true if the device is open & its transfers are submitted.
+ */
+bool IO::Drivers::USB::open(const QIODevice::OpenMode mode)
+{
+  (void)mode;
+  close();
+
+#ifdef ENABLE_LIBUSB
+  // Validate the configuration
+  if (!configurationOk() || !m_context)
+    return false;
+
+  // Find the selected device
+  libusb_device **list = nullptr;
+  libusb_device *device = nullptr;
+  const auto &info = m_devices.at(m_deviceIndex);
+  const auto count = libusb_get_device_list(m_context, &list);
+  for (ssize_t i = 0; i < count; ++i)
+  {
+    if (libusb_get_bus_number(list[i]) == info.busNumber
+        && libusb_get_device_address(list[i]) == info.address)
+    {
+      device = list[i];
+      break;
+    }
+  }
+
+  // Open the device
+  int result = LIBUSB_ERROR_NO_DEVICE;
+  if (device)
+    result = libusb_open(device, &m_handle);
+
+  // Find the first interface with a bulk IN endpoint
+  if (result == 0)
+  {
+    libusb_config_descriptor *config = nullptr;
+    result = libusb_get_active_config_descriptor(device, &config);
+    for (int i = 0; result == 0 && i < config->bNumInterfaces; ++i)
+    {
+      if (config->interface[i].num_altsetting < 1)
+        continue;
+
+      quint8 in = 0;
+      quint8 out = 0;
+      const auto &setting = config->interface[i].altsetting[0];
+      for (int j = 0; j < setting.bNumEndpoints; ++j)
+      {
+        const auto &endpoint = setting.endpoint[j];
+        const auto type = endpoint.bmAttributes & LIBUSB_TRANSFER_TYPE_MASK;
+        if (type != LIBUSB_TRANSFER_TYPE_BULK)
+          continue;
+
+        if (endpoint.bEndpointAddress & LIBUSB_ENDPOINT_IN)
+        {
+          if (in == 0)
+            in = endpoint.bEndpointAddress;
+        }
+
+        else if (out == 0)
+          out = endpoint.bEndpointAddress;
+      }
+
+      if (in != 0)
+      {
+        m_interface = setting.bInterfaceNumber;
+        m_inEndpoint = in;
+        m_outEndpoint = out;
+        break;
+      }
+    }
+
+    if (config)
+      libusb_free_config_descriptor(config);
+
+    if (result == 0 && m_interface < 0)
+      result = LIBUSB_ERROR_NOT_SUPPORTED;
+  }
+
+  // Obtain the throughput of the bus
+  if (result == 0)
+  {
+    switch (libusb_get_device_speed(device))
+    {
+      case LIBUSB_SPEED_LOW:
+        m_dataRate = 1500000 / 8;
+        break;
+      case LIBUSB_SPEED_FULL:
+        m_dataRate = 12000000 / 8;
+        break;
+      case LIBUSB_SPEED_HIGH:
+        m_dataRate = 480000000 / 8;
+        break;
+      default:
+        m_dataRate = Q_INT64_C(5000000000) / 8;
+        break;
+    }
+  }
+
+  libusb_free_device_list(list, 1);
+
+  // Claim the interface
+  if (result == 0)
+  {
+    libusb_set_auto_detach_kernel_driver(m_handle, 1);
+    result = libusb_claim_interface(m_handle, m_interface);
+    if (result != 0)
+      m_interface = -1;
+  }
+
+  // Submit the transfer ring
+  m_running = true;
+  for (int i = 0; result == 0 && i < kTransferCount; ++i)
+  {
+    auto *transfer = new Transfer;
+    transfer->driver = this;
+    transfer->buffer = QByteArray(kTransferSize, Qt::Uninitialized);
+    transfer->handle = libusb_alloc_transfer(0);
+    m_transfers.append(transfer);
+
+    auto *buffer = reinterpret_cast<unsigned char *>(transfer->buffer.data());
+    libusb_fill_bulk_transfer(transfer->handle, m_handle, m_inEndpoint, buffer,
+                              kTransferSize, &Transfer::onCompleted, transfer,
+                              0);
+
+    result = libusb_submit_transfer(transfer->handle);
+    if (result == 0)
+      ++m_activeTransfers;
+  }
+
+  // Complete the transfers from a dedicated thread
+  if (m_activeTransfers > 0)
+  {
+    m_eventThread = QThread::create([this] { handleEvents(); });
+    m_eventThread->setObjectName(QStringLiteral("USB Events"));
+    Misc::ThreadScheduler::instance().registerThread(
+        m_eventThread, Misc::ThreadScheduler::Role::Reader);
+    m_eventThread->start(QThread::TimeCriticalPriority);
+  }
+
+  // Report errors
+  if (result != 0)
+  {
+    const auto error = QString::fromUtf8(libusb_strerror(result));
+    close();
+    Misc::Utilities::showMessageBox(tr("USB error"), error);
+    return false;
+  }
+
+  return true;
+#else
+  Misc::Utilities::showMessageBox(
+      tr("USB support is not available"),
+      tr("This version of Serial Studio was built without libusb."));
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Driver specifics
+//------------------------------------------------------------------------------
+
+/**
+ * Returns @c true if Serial Studio was built with libusb
+ */
+bool IO::Drivers::USB::supported() const
+{
+#ifdef ENABLE_LIBUSB
+  return m_context != nullptr;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Returns the index of the selected device, in the list returned by
+ * @c availableDevices().
+ */
+int IO::Drivers::USB::deviceIndex() const
+{
+  return m_deviceIndex;
+}
+
+/**
+ * Returns the USB devices connected to this system
+ */
+QStringList IO::Drivers::USB::availableDevices() const
+{
+  QStringList list;
+  for (const auto &device : m_devices)
+  {
+    const auto vid = QStringLiteral("%1").arg(device.vendorId, 4, 16,
+                                              QLatin1Char('0'));
+    const auto pid = QStringLiteral("%1").arg(device.productId, 4, 16,
+                                              QLatin1Char('0'));
+    list.append(tr("%1:%2 (Bus %3, Device %4)")
+                    .arg(vid, pid, QString::number(device.busNumber),
+                         QString::number(device.address)));
+  }
+
+  return list;
+}
+
+/**
+ * Scans the USB devices connected to this system
+ */
+void IO::Drivers::USB::refreshDevices()
+{
+  QList<Device> devices;
+
+#ifdef ENABLE_LIBUSB
+  if (m_context)
+  {
+    libusb_device **list = nullptr;
+    const auto count = libusb_get_device_list(m_context, &list);
+    for (ssize_t i = 0; i < count; ++i)
+    {
+      libusb_device_descriptor descriptor;
+      if (libusb_get_device_descriptor(list[i], &descriptor) != 0)
+        continue;
+
+      // Skip hubs, they never stream data
+      if (descriptor.bDeviceClass == LIBUSB_CLASS_HUB)
+        continue;
+
+      Device device;
+      device.vendorId = descriptor.idVendor;
+      device.productId = descriptor.idProduct;
+      device.busNumber = libusb_get_bus_number(list[i]);
+      device.address = libusb_get_device_address(list[i]);
+      devices.append(device);
+    }
+
+    if (count >= 0)
+      libusb_free_device_list(list, 1);
+  }
+#endif
+
+  // Update the device list
+  const bool changed = devices.count() != m_devices.count()
+                       || !std::equal(devices.cbegin(), devices.cend(),
+                                      m_devices.cbegin(),
+                                      [](const Device &a, const Device &b) {
+                                        return a.busNumber == b.busNumber
+                                               && a.address == b.address;
+                                      });
+  if (changed)
+  {
+    m_devices = devices;
+    Q_EMIT availableDevicesChanged();
+    Q_EMIT configurationChanged();
+  }
+}
+
+/**
+ * Changes the selected device
+ */
+void IO::Drivers::USB::setDeviceIndex(const int index)
+{
+  if (index == m_deviceIndex)
+    return;
+
+  m_deviceIndex = index;
+  Q_EMIT deviceIndexChanged();
+  Q_EMIT configurationChanged();
+}
+
+//------------------------------------------------------------------------------
+// Transfer ring
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Runs the libusb event loop of the transfer ring.
+ *
+ * Runs in the event thread until the driver is closed and every transfer
+ * has been released, so that transfer callbacks never run after @c close()
+ * returns.
+ */
+void IO::Drivers::USB::handleEvents()
+{
+#ifdef ENABLE_LIBUSB
+  while (m_running || m_activeTransfers > 0)
+  {
+    timeval timeout{0, 100000};
+    libusb_handle_events_timeout_completed(m_context, &timeout, nullptr);
+  }
+#endif
+}
+
+/**
+ * Disconnects from the device if it was unplugged or its endpoint failed
+ */
+void IO::Drivers::USB::onDeviceLost()
+{
+  QMetaObject::invokeMethod(
+      this,
+      [=] {
+        if (isOpen())
+        {
+          Manager::instance().disconnectDevice();
+          Misc::Utilities::showMessageBox(
+              tr("USB error"), tr("The device was disconnected"));
+        }
+      },
+      Qt::QueuedConnection);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QList>
+#include <QThread>
+#include <QByteArray>
+#include <QStringList>
+
+#include "IO/HAL_Driver.h"
+
+struct libusb_context;
+struct libusb_device_handle;
+
+namespace IO
+{
+namespace Drivers
+{
+/**
+ * @brief The USB class
+ *
+ * Serial Studio driver for USB devices that stream data through bulk
+ * endpoints (e.g. custom data acquisition boards), using libusb instead of a
+ * CDC-ACM serial port.
+ *
+ * When connecting, the driver claims the first interface of the device that
+ * has a bulk IN endpoint, and keeps a ring of asynchronous bulk transfers
+ * submitted on that endpoint so that the host controller always has buffers
+ * to fill. Transfers complete on a dedicated event thread, each filled buffer
+ * is moved to the frame reader as-is and replaced by a new buffer before the
+ * transfer is submitted again, so received data is never copied by the
+ * driver.
+ *
+ * Data written to the device is sent to the bulk OUT endpoint of the same
+ * interface, if there is one.
+ *
+ * The driver is only functional if Serial Studio is built with the
+ * @c ENABLE_LIBUSB option.
+ */
+class USB : public HAL_Driver
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int deviceIndex
+             READ deviceIndex
+             WRITE setDeviceIndex
+             NOTIFY deviceIndexChanged)
+  Q_PROPERTY(QStringList availableDevices
+             READ availableDevices
+             NOTIFY availableDevicesChanged)
+  Q_PROPERTY(bool supported
+             READ supported
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void deviceIndexChanged();
+  void availableDevicesChanged();
+
+private:
+  explicit USB();
+  USB(USB &&) = delete;
+  USB(const USB &) = delete;
+  USB &operator=(USB &&) = delete;
+  USB &operator=(const USB &) = delete;
+
+  ~USB();
+
+public:
+  static USB &instance();
+
+  void close() override;
+
+  [[nodiscard]] bool isOpen() const override;
+  [[nodiscard]] bool isReadable() const override;
+  [[nodiscard]] bool isWritable() const override;
+  [[nodiscard]] bool configurationOk() const override;
+  [[nodiscard]] qint64 dataRate() const override;
+  [[nodiscard]] quint64 write(const QByteArray &data) override;
+  [[nodiscard]] bool open(const QIODevice::OpenMode mode) override;
+
+  [[nodiscard]] bool supported() const;
+  [[nodiscard]] int deviceIndex() const;
+  [[nodiscard]] QStringList availableDevices() const;
+
+public slots:
+  void refreshDevices();
+  void setDeviceIndex(const int index);
+
+private:
+  struct Transfer;
+  void handleEvents();
+  void onDeviceLost();
+
+private:
+  struct Device
+  {
+    quint16 vendorId;
+    quint16 productId;
+    quint8 busNumber;
+    quint8 address;
+  };
+
+  int m_deviceIndex;
+  int m_interface;
+  quint8 m_inEndpoint;
+  quint8 m_outEndpoint;
+  qint64 m_dataRate;
+
+  libusb_context *m_context;
+  libusb_device_handle *m_handle;
+
+  QThread *m_eventThread;
+  std::atomic<bool> m_running;
+  std::atomic<int> m_activeTransfers;
+
+  QList<Device> m_devices;
+  QList<Transfer *> m_transfers;
+};
+} // namespace Drivers
+} // namespace IO
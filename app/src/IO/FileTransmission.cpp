@@ -28,10 +28,28 @@
 #include "Misc/Translator.h"
 #include "IO/FileTransmission.h"
 
+// Size of each block written in binary block mode
+static constexpr qint64 kBlockSize = 4 * 1024;
+
+// Maximum number of blocks queued or handed to the driver that were not written
+// to the device yet (e.g. still in the write buffer of the serial port)
+static constexpr int kBlocksInFlight = 8;
+
+// Time to wait before retrying when the transmission queue is full
+static constexpr int kRetryInterval = 10;
+
 /**
  * Constructor function
  */
 IO::FileTransmission::FileTransmission()
+  : m_mode(TransmissionMode::LineByLine)
+  , m_map(nullptr)
+  , m_blockTransfer(false)
+  , m_blockOffset(0)
+  , m_bytesWritten(0)
+  , m_protocolWindow(1)
+  , m_throughput(0)
+  , m_throughputBytes(0)
 {
   // Set stream object pointer to null
   m_stream = nullptr;
@@ -40,6 +58,12 @@ IO::FileTransmission::FileTransmission()
   m_timer.setInterval(100);
   m_timer.setTimerType(Qt::PreciseTimer);
   connect(&m_timer, &QTimer::timeout, this, &FileTransmission::sendLine);
+
+  // Track the progress of XMODEM/YMODEM transfers
+  connect(&m_modem, &IO::ModemSender::finished, this,
+          &FileTransmission::onModemFinished);
+  connect(&m_modem, &IO::ModemSender::progressChanged, this,
+          &FileTransmission::onModemProgress);
 }
 
 /**
@@ -65,7 +89,43 @@ IO::FileTransmission &IO::FileTransmission::instance()
  */
 bool IO::FileTransmission::active() const
 {
-  return m_timer.isActive();
+  return m_timer.isActive() || m_blockTransfer || m_modem.active();
+}
+
+/**
+ * Returns the average number of bytes per second written to the device since
+ * the transmission was started or resumed.
+ */
+double IO::FileTransmission::throughput() const
+{
+  return m_throughput;
+}
+
+/**
+ * Returns the number of XMODEM/YMODEM blocks that are sent before waiting for
+ * their acknowledgements.
+ */
+int IO::FileTransmission::protocolWindow() const
+{
+  return m_protocolWindow;
+}
+
+/**
+ * Returns the index of the current transmission mode, see
+ * @c transmissionModes().
+ */
+int IO::FileTransmission::transmissionMode() const
+{
+  return static_cast<int>(m_mode);
+}
+
+/**
+ * Returns a list with the available transmission modes.
+ */
+QStringList IO::FileTransmission::transmissionModes() const
+{
+  return QStringList{tr("Line by Line"), tr("Binary Blocks"),
+                     QStringLiteral("XMODEM-1K"), QStringLiteral("YMODEM")};
 }
 
 /**
@@ -99,6 +159,9 @@ int IO::FileTransmission::transmissionProgress() const
 
   // Return progress as percentage
   qreal txb = m_stream->pos();
+  if (m_mode != TransmissionMode::LineByLine)
+    txb = m_bytesWritten;
+
   qreal len = m_file.size();
   return qMin(1.0, (txb / len)) * 100;
 }
@@ -152,10 +215,17 @@ void IO::FileTransmission::closeFile()
   // Stop transmitting the file to the serial device
   stopTransmission();
 
-  // Close current file
+  // Release the memory map & close current file
+  unmapFile();
   if (m_file.isOpen())
     m_file.close();
 
+  // Reset binary transfer state
+  m_pendingWrites.clear();
+  m_blockOffset = 0;
+  m_bytesWritten = 0;
+  m_throughput = 0;
+
   // Reset text stream handler
   if (m_stream)
   {
@@ -173,6 +243,12 @@ void IO::FileTransmission::closeFile()
  */
 void IO::FileTransmission::stopTransmission()
 {
+  // Protocol transfers cannot be paused, notify the receiver
+  if (m_modem.active())
+    m_modem.cancel();
+
+  // Blocks that are already queued are still written & accounted for
+  m_blockTransfer = false;
   m_timer.stop();
   emit activeChanged();
 }
@@ -188,16 +264,71 @@ void IO::FileTransmission::beginTransmission()
   // Only allow transmission if serial device is open
   if (IO::Manager::instance().connected())
   {
-    // If file has already been sent, reset text stream position
-    if (transmissionProgress() == 100)
+    // If file has already been sent, reset text stream position, protocol
+    // transfers always start from the beginning of the file
+    const bool protocol = m_mode == TransmissionMode::XModem1K
+                          || m_mode == TransmissionMode::YModem;
+    if (transmissionProgress() == 100 || protocol)
     {
       m_stream->seek(0);
+      m_blockOffset = 0;
+      m_bytesWritten = 0;
+      m_pendingWrites.clear();
       emit transmissionProgressChanged();
     }
 
+    // Reset throughput measurement
+    m_throughput = 0;
+    m_throughputBytes = 0;
+    m_throughputTimer.start();
+
+    // Map the file for binary & protocol transfers
+    if (m_mode != TransmissionMode::LineByLine)
+    {
+      if (!m_map && m_file.size() > 0)
+        m_map = m_file.map(0, m_file.size());
+
+      if (!m_map)
+      {
+        qWarning() << "File map error" << m_file.errorString();
+        return;
+      }
+    }
+
+    // Start sending blocks
+    if (m_mode == TransmissionMode::BinaryBlocks)
+    {
+      m_blockTransfer = true;
+      emit activeChanged();
+      sendBlocks();
+    }
+
+    // Listen to the receiver & start the protocol transfer
+    else if (protocol)
+    {
+      auto *driver = IO::Manager::instance().driver();
+      if (driver)
+      {
+        disconnect(m_driverConnection);
+        m_driverConnection
+            = connect(driver, &IO::HAL_Driver::dataReceived, &m_modem,
+                      &IO::ModemSender::processData, Qt::QueuedConnection);
+      }
+
+      const auto type = m_mode == TransmissionMode::YModem
+                            ? IO::ModemSender::Protocol::YModem
+                            : IO::ModemSender::Protocol::XModem1K;
+      m_modem.start(type, m_map, m_file.size(), QFileInfo(m_file).fileName(),
+                    m_protocolWindow);
+      emit activeChanged();
+    }
+
     // Start timer
-    m_timer.start();
-    emit activeChanged();
+    else
+    {
+      m_timer.start();
+      emit activeChanged();
+    }
   }
 
   // Stop transmission if serial device is closed
@@ -214,6 +345,10 @@ void IO::FileTransmission::setupExternalConnections()
   connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
           &FileTransmission::stopTransmission);
 
+  // Send new blocks as the driver writes the previous ones
+  connect(&IO::Manager::instance(), &IO::Manager::writeCompleted, this,
+          &FileTransmission::onWriteCompleted);
+
   // Refresh UI when serial device connection status changes
   connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
           &FileTransmission::fileChanged);
@@ -235,6 +370,42 @@ void IO::FileTransmission::setLineTransmissionInterval(const int msec)
   m_timer.setInterval(qMax(0, msec));
 }
 
+/**
+ * Changes the number of XMODEM/YMODEM blocks that are sent before waiting for
+ * their acknowledgements, a @a window of 1 is the standard stop-and-wait
+ * behavior.
+ */
+void IO::FileTransmission::setProtocolWindow(const int window)
+{
+  const auto value = qBound(1, window, 16);
+  if (m_protocolWindow != value)
+  {
+    m_protocolWindow = value;
+    emit protocolWindowChanged();
+  }
+}
+
+/**
+ * Changes the transmission @a mode, see @c transmissionModes(). The mode
+ * cannot be changed while a transmission is active.
+ */
+void IO::FileTransmission::setTransmissionMode(const int mode)
+{
+  const auto value = static_cast<TransmissionMode>(
+      qBound(0, mode, transmissionModes().count() - 1));
+  if (active() || value == m_mode)
+    return;
+
+  m_mode = value;
+  m_blockOffset = 0;
+  m_bytesWritten = 0;
+  if (m_stream)
+    m_stream->seek(0);
+
+  emit transmissionModeChanged();
+  emit transmissionProgressChanged();
+}
+
 /**
  * Transmits a new line from the selected file to the serial port device.
  *
@@ -251,6 +422,10 @@ void IO::FileTransmission::sendLine()
   if (!IO::Manager::instance().connected())
     return;
 
+  // Device is busy, wait for the transmission queue to drain
+  if (IO::Manager::instance().txQueueBytes() >= 64 * 1024)
+    return;
+
   // Send next line to device
   if (m_stream && !m_stream->atEnd())
   {
@@ -277,3 +452,135 @@ void IO::FileTransmission::sendLine()
   else
     stopTransmission();
 }
+
+/**
+ * Queues blocks of the memory-mapped file to the @c IO::Manager transmission
+ * queue until the maximum number of blocks in flight is reached.
+ *
+ * A block stays in flight until the driver reports that its bytes were
+ * written (see @c IO::HAL_Driver::writeFinished()), so the transmission is
+ * paced by the link & not by how fast the driver accepts data.
+ *
+ * If the transmission queue rejects a block (e.g. because other modules are
+ * writing large amounts of data) and no block is in flight, the function
+ * tries again after a short delay.
+ */
+void IO::FileTransmission::sendBlocks()
+{
+  // Transmission disabled, abort
+  if (!m_blockTransfer || !m_map)
+    return;
+
+  // Queue new blocks
+  const auto size = m_file.size();
+  auto &manager = IO::Manager::instance();
+  while (m_pendingWrites.count() < kBlocksInFlight && m_blockOffset < size)
+  {
+    const auto length = qMin(kBlockSize, size - m_blockOffset);
+    const auto *data = reinterpret_cast<const char *>(m_map + m_blockOffset);
+    const auto id = manager.queueWrite(QByteArray(data, length));
+    if (id == 0)
+      break;
+
+    m_pendingWrites.insert(id, m_blockOffset);
+    m_blockOffset += length;
+  }
+
+  // Reached end of file, stop transmission
+  if (m_pendingWrites.isEmpty() && m_bytesWritten >= size)
+  {
+    stopTransmission();
+    emit transmissionProgressChanged();
+  }
+
+  // Queue is full, try again later
+  else if (m_pendingWrites.isEmpty())
+    QTimer::singleShot(kRetryInterval, this, &FileTransmission::sendBlocks);
+}
+
+/**
+ * Stops listening to the receiver once an XMODEM/YMODEM transfer finishes.
+ */
+void IO::FileTransmission::onModemFinished(const bool success)
+{
+  disconnect(m_driverConnection);
+  if (success)
+    m_bytesWritten = m_file.size();
+
+  emit activeChanged();
+  emit transmissionProgressChanged();
+}
+
+/**
+ * Updates the progress & throughput with the number of @a bytes acknowledged
+ * by the XMODEM/YMODEM receiver.
+ */
+void IO::FileTransmission::onModemProgress(const qint64 bytes)
+{
+  m_bytesWritten = bytes;
+  m_throughputBytes = bytes;
+  const auto elapsed = m_throughputTimer.nsecsElapsed() / 1e9;
+  if (elapsed > 0)
+    m_throughput = m_throughputBytes / elapsed;
+
+  emit transmissionProgressChanged();
+}
+
+/**
+ * Registers the completion of a block written by the driver, updates the
+ * progress & throughput, and queues the next blocks.
+ *
+ * Only the bytes that the driver has actually written are counted, so the
+ * progress & throughput reflect the data that left the application.
+ */
+void IO::FileTransmission::onWriteCompleted(const quint64 id,
+                                            const qint64 bytes)
+{
+  // Not a block of the current transmission
+  const auto it = m_pendingWrites.constFind(id);
+  if (it == m_pendingWrites.constEnd())
+    return;
+
+  // Obtain the position & length of the block
+  const auto offset = it.value();
+  const auto length = qMin(kBlockSize, m_file.size() - offset);
+  m_pendingWrites.erase(it);
+
+  // Write error, stop the transmission & resume from the failed block
+  if (bytes < length)
+  {
+    const auto resume = offset + qMax<qint64>(0, bytes);
+    m_blockOffset = qMin(m_blockOffset, resume);
+    m_bytesWritten = qMin(m_bytesWritten + qMax<qint64>(0, bytes), resume);
+    if (m_blockTransfer)
+      qWarning() << "File transmission error, stopping transfer";
+
+    stopTransmission();
+    emit transmissionProgressChanged();
+    return;
+  }
+
+  // Update the progress & throughput
+  m_bytesWritten += bytes;
+  m_throughputBytes += bytes;
+  const auto elapsed = m_throughputTimer.nsecsElapsed() / 1e9;
+  if (elapsed > 0)
+    m_throughput = m_throughputBytes / elapsed;
+
+  emit transmissionProgressChanged();
+
+  // Continue with the next blocks
+  sendBlocks();
+}
+
+/**
+ * Releases the memory map of the current file.
+ */
+void IO::FileTransmission::unmapFile()
+{
+  if (m_map)
+  {
+    m_file.unmap(m_map);
+    m_map = nullptr;
+  }
+}
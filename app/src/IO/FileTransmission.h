@@ -22,13 +22,35 @@
 
 #pragma once
 
+#include <QHash>
 #include <QFile>
 #include <QTimer>
 #include <QObject>
 #include <QTextStream>
+#include <QElapsedTimer>
+
+#include "IO/ModemSender.h"
 
 namespace IO
 {
+/**
+ * @brief The FileTransmission class
+ *
+ * Sends the contents of a file selected by the user to the connected device.
+ *
+ * In line mode, the file is read as text and one line is written each time
+ * the transmission interval expires. In binary block mode, the file is
+ * memory-mapped and written in fixed-size blocks through the asynchronous
+ * transmission queue of the @c IO::Manager. A bounded number of blocks is kept
+ * in flight, and a new block is queued each time the driver reports that a
+ * previous one was written to the device (for serial ports, once
+ * @c QSerialPort::bytesWritten() accounts for it), so the file goes out as
+ * fast as the link allows without piling up in the driver.
+ *
+ * The XMODEM-1K & YMODEM modes send the memory-mapped file with the
+ * @c IO::ModemSender, which reads the acknowledgements of the receiver from
+ * the data reported by the current driver.
+ */
 class FileTransmission : public QObject
 {
   // clang-format off
@@ -49,11 +71,27 @@ class FileTransmission : public QObject
              READ lineTransmissionInterval
              WRITE setLineTransmissionInterval
              NOTIFY lineTransmissionIntervalChanged)
+  Q_PROPERTY(int transmissionMode
+             READ transmissionMode
+             WRITE setTransmissionMode
+             NOTIFY transmissionModeChanged)
+  Q_PROPERTY(QStringList transmissionModes
+             READ transmissionModes
+             CONSTANT)
+  Q_PROPERTY(double throughput
+             READ throughput
+             NOTIFY transmissionProgressChanged)
+  Q_PROPERTY(int protocolWindow
+             READ protocolWindow
+             WRITE setProtocolWindow
+             NOTIFY protocolWindowChanged)
   // clang-format on
 
 signals:
   void fileChanged();
   void activeChanged();
+  void protocolWindowChanged();
+  void transmissionModeChanged();
   void transmissionProgressChanged();
   void lineTransmissionIntervalChanged();
 
@@ -68,7 +106,20 @@ private:
 public:
   static FileTransmission &instance();
 
+  enum class TransmissionMode
+  {
+    LineByLine,
+    BinaryBlocks,
+    XModem1K,
+    YModem
+  };
+  Q_ENUM(TransmissionMode)
+
   [[nodiscard]] bool active() const;
+  [[nodiscard]] double throughput() const;
+  [[nodiscard]] int protocolWindow() const;
+  [[nodiscard]] int transmissionMode() const;
+  [[nodiscard]] QStringList transmissionModes() const;
   [[nodiscard]] bool fileOpen() const;
   [[nodiscard]] QString fileName() const;
   [[nodiscard]] int transmissionProgress() const;
@@ -80,14 +131,39 @@ public slots:
   void stopTransmission();
   void beginTransmission();
   void setupExternalConnections();
+  void setProtocolWindow(const int window);
+  void setTransmissionMode(const int mode);
   void setLineTransmissionInterval(const int msec);
 
 private slots:
   void sendLine();
+  void sendBlocks();
+  void onModemFinished(const bool success);
+  void onModemProgress(const qint64 bytes);
+  void onWriteCompleted(const quint64 id, const qint64 bytes);
+
+private:
+  void unmapFile();
 
 private:
   QFile m_file;
   QTimer m_timer;
   QTextStream *m_stream;
+
+  TransmissionMode m_mode;
+
+  uchar *m_map;
+  bool m_blockTransfer;
+  qint64 m_blockOffset;
+  qint64 m_bytesWritten;
+  QHash<quint64, qint64> m_pendingWrites;
+
+  int m_protocolWindow;
+  IO::ModemSender m_modem;
+  QMetaObject::Connection m_driverConnection;
+
+  double m_throughput;
+  qint64 m_throughputBytes;
+  QElapsedTimer m_throughputTimer;
 };
 } // namespace IO
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QByteArray>
+
+namespace IO
+{
+/**
+ * @brief A frame extracted from the incoming data stream.
+ *
+ * The frame data is usually a slot of the @c IO::FramePool, which is shared
+ * with every consumer instead of being copied.
+ */
+struct RawFrame
+{
+  QByteArray data;  /**< The frame, without delimiters & checksum. */
+  qint64 timestamp; /**< Arrival time of its last byte, or 0 if unknown. */
+  int source = 0;   /**< Data source of the frame, 0 is the main device. */
+};
+
+/**
+ * @brief Frames extracted during one wakeup of a frame reader, in order.
+ *
+ * Frames are delivered in batches, so that a single queued event crosses the
+ * thread boundary (and the event loop of the receiver) for all the frames
+ * found in a chunk of data, instead of one event per frame.
+ */
+using FrameBatch = QList<RawFrame>;
+} // namespace IO
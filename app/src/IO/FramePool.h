@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QByteArray>
+
+namespace IO
+{
+/**
+ * @class IO::FramePool
+ * @brief Recycles the memory used by detected frames.
+ *
+ * Every frame found by the @c FrameReader used to be materialized in a freshly
+ * allocated @c QByteArray. The frame pool keeps a fixed set of pre-allocated
+ * slots instead. Since @c QByteArray is implicitly shared, emitting a slot
+ * through a signal only bumps its reference count; all consumers (dashboard,
+ * CSV export, MQTT, plugins...) share the same memory block.
+ *
+ * Once every consumer has released its copy, the reference count drops back
+ * to one and the slot can be filled again without touching the heap. Slots
+ * that are still in use are skipped, and consumers that modify a frame simply
+ * detach from the shared block, so recycling is always safe.
+ */
+class FramePool
+{
+public:
+  /**
+   * @brief Constructs a frame pool.
+   *
+   * @param slots The number of frame slots to pre-allocate.
+   * @param capacity The initial capacity (in bytes) of each slot.
+   */
+  explicit FramePool(const int slots = 128, const qsizetype capacity = 1024)
+    : m_next(0)
+  {
+    m_slots.resize(slots);
+    for (auto &slot : m_slots)
+      slot.reserve(capacity);
+  }
+
+  /**
+   * @brief Obtains a slot that is not referenced by any consumer.
+   *
+   * The returned byte array is resized to @a size and can be written directly
+   * through @c data() without causing a detach. If every slot is still in use,
+   * the least recently used slot is replaced with a new allocation.
+   *
+   * @param size The size of the frame that will be stored in the slot.
+   * @return A reference to the slot, valid until the next call.
+   */
+  [[nodiscard]] QByteArray &acquire(const qsizetype size)
+  {
+    const auto count = m_slots.count();
+    for (qsizetype i = 0; i < count; ++i)
+    {
+      auto &slot = m_slots[(m_next + i) % count];
+      if (slot.isDetached())
+      {
+        m_next = (m_next + i + 1) % count;
+        slot.resize(size);
+        return slot;
+      }
+    }
+
+    auto &slot = m_slots[m_next];
+    m_next = (m_next + 1) % count;
+    slot = QByteArray(size, Qt::Uninitialized);
+    return slot;
+  }
+
+private:
+  qsizetype m_next;
+  QVector<QByteArray> m_slots;
+};
+} // namespace IO
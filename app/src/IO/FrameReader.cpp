@@ -24,8 +24,18 @@
 
 #include "IO/Manager.h"
 #include "IO/Checksum.h"
+#include "IO/Framing.h"
 #include "JSON/FrameBuilder.h"
 #include "JSON/ProjectModel.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+#include "Misc/Trace.h"
+
+/**
+ * @brief Number of bytes copied from the buffer at a time by the COBS & SLIP
+ *        decoders.
+ */
+static constexpr qsizetype kDecodeBlockSize = 4096;
 
 /**
  * @brief Constructs a FrameReader object.
@@ -39,13 +49,67 @@
 IO::FrameReader::FrameReader(QObject *parent)
   : QObject(parent)
   , m_enableCrc(false)
+  , m_readScheduled(false)
+  , m_extractor(nullptr)
+  , m_lengthFieldSize(2)
+  , m_lengthBigEndian(false)
+  , m_declaredChecksum(false)
+  , m_checksumBigEndian(true)
+  , m_checksumStart(0)
+  , m_checksumEnd(0)
+  , m_checksumLength(0)
+  , m_checksum(SerialStudio::ChecksumAuto)
+  , m_checksumPosition(SerialStudio::ChecksumTrailer)
+  , m_cobsBlock(0)
+  , m_cobsZero(false)
+  , m_slipEscape(false)
+  , m_decodeError(false)
+  , m_startScanOffset(0)
+  , m_finishScanOffset(0)
+  , m_pendingSince(0)
+  , m_sequence(0)
+  , m_publishedBytes(0)
+  , m_publishedFrames(0)
+  , m_receivedBytes(0)
+  , m_consumedBytes(0)
   , m_operationMode(SerialStudio::QuickPlot)
   , m_frameDetectionMode(SerialStudio::EndDelimiterOnly)
+  , m_overflowPolicy(SerialStudio::OverflowDropOldest)
   , m_dataBuffer(1024 * 1024)
 {
   m_quickPlotEndSequences.append(QByteArray("\n"));
   m_quickPlotEndSequences.append(QByteArray("\r"));
   m_quickPlotEndSequences.append(QByteArray("\r\n"));
+  m_quickPlotPattern.set(m_quickPlotEndSequences);
+  selectExtractor();
+}
+
+/**
+ * @brief Returns the sequence number of the latest published frame.
+ *
+ * Sequence numbers start at 1 and keep increasing when the reader is reset,
+ * so that every frame extracted by this reader has a unique number.
+ */
+quint64 IO::FrameReader::sequence() const
+{
+  return m_sequence;
+}
+
+/**
+ * @brief Returns the maximum number of bytes that can wait to be parsed.
+ */
+qsizetype IO::FrameReader::bufferCapacity() const
+{
+  return m_dataBuffer.capacity();
+}
+
+/**
+ * @brief Returns what the reader does with data that does not fit in its
+ *        buffer.
+ */
+SerialStudio::BufferOverflowPolicy IO::FrameReader::overflowPolicy() const
+{
+  return m_overflowPolicy;
 }
 
 /**
@@ -98,6 +162,18 @@ const QByteArray &IO::FrameReader::finishSequence() const
   return m_finishSequence;
 }
 
+/**
+ * @brief Retrieves the header that precedes the length field of
+ *        length-prefixed frames.
+ *
+ * @return A reference to the QByteArray containing the header, which is empty
+ *         if the length field starts every frame.
+ */
+const QByteArray &IO::FrameReader::frameHeader() const
+{
+  return m_frameHeader;
+}
+
 /**
  * @brief Resets the FrameReader's state.
  *
@@ -107,8 +183,26 @@ const QByteArray &IO::FrameReader::finishSequence() const
  */
 void IO::FrameReader::reset()
 {
+  // Unread data is lost, count it as an incomplete frame
+  if (m_dataBuffer.size() > 0 || !m_decodedFrame.isEmpty())
+    Misc::PipelineStats::instance().recordIntegrity(
+        Misc::PipelineStats::IncompleteFrames);
+
   m_enableCrc = false;
+  m_startScanOffset = 0;
+  m_finishScanOffset = 0;
   m_dataBuffer.clear();
+  m_dataBuffer.resetHighWaterMark();
+
+  m_cobsBlock = 0;
+  m_cobsZero = false;
+  m_slipEscape = false;
+  m_decodeError = false;
+  m_decodedFrame.clear();
+
+  m_receivedBytes = 0;
+  m_consumedBytes = 0;
+  m_chunkTimes.clear();
 }
 
 /**
@@ -121,7 +215,7 @@ void IO::FrameReader::reset()
 void IO::FrameReader::setupExternalConnections()
 {
   setOperationMode(JSON::FrameBuilder::instance().operationMode());
-  setFrameDetectionMode(JSON::ProjectModel::instance().frameDetection());
+  loadProjectFraming();
 
   connect(&JSON::FrameBuilder::instance(),
           &JSON::FrameBuilder::operationModeChanged, this, [=] {
@@ -129,10 +223,23 @@ void IO::FrameReader::setupExternalConnections()
           });
 
   connect(&JSON::ProjectModel::instance(),
-          &JSON::ProjectModel::frameDetectionChanged, this, [=] {
-            setFrameDetectionMode(
-                JSON::ProjectModel::instance().frameDetection());
-          });
+          &JSON::ProjectModel::frameDetectionChanged, this,
+          &IO::FrameReader::loadProjectFraming);
+}
+
+/**
+ * @brief Applies the frame detection, length prefix & checksum settings of
+ *        the current project.
+ */
+void IO::FrameReader::loadProjectFraming()
+{
+  const auto &project = JSON::ProjectModel::instance();
+  setFrameDetectionMode(project.frameDetection());
+  setLengthPrefix(project.frameHeader(), project.lengthFieldSize(),
+                  project.lengthBigEndian());
+  setChecksum(project.checksumAlgorithm(), project.checksumPosition(),
+              project.checksumBigEndian(), project.checksumStart(),
+              project.checksumEnd());
 }
 
 /**
@@ -141,29 +248,118 @@ void IO::FrameReader::setupExternalConnections()
  *
  * Appends the incoming data to an internal buffer and attempts to extract
  * frames based on the operation mode and frame detection mode. Removes
- * processed data from the buffer and truncates it if it exceeds the maximum
- * buffer size.
+ * processed data from the buffer. Data that does not fit in the buffer is
+ * handled according to the overflow policy, and is still forwarded to the
+ * console.
+ *
+ * In no-delimiter mode, each chunk is a frame of its own. If the buffer is
+ * empty, the chunk is published as-is (sharing the memory filled by the
+ * driver) instead of being copied in & out of the buffer.
  *
  * @param data The incoming data to process.
+ * @param timestamp The time at which the I/O driver received the data, or 0
+ *                  to use the current time.
  */
-void IO::FrameReader::processData(const QByteArray &data)
+void IO::FrameReader::processData(const QByteArray &data,
+                                  const qint64 timestamp)
 {
   // Stop if not connected
   if (!IO::Manager::instance().connected())
     return;
 
-  // Add data to circular buffer
-  m_dataBuffer.append(data);
+  // In no-delimiter mode, chunks are whole frames that can skip the buffer
+  const bool directFrames = m_operationMode == SerialStudio::ProjectFile
+                            && m_frameDetectionMode
+                                   == SerialStudio::NoDelimiters;
+  const bool bypassBuffer = directFrames && m_dataBuffer.size() == 0;
 
-  // Read frames in no-delimiter mode directly
-  if (m_operationMode == SerialStudio::ProjectFile
-      && m_frameDetectionMode == SerialStudio::NoDelimiters)
-    Q_EMIT frameReady(m_dataBuffer.read(data.size()));
+  // Apply backpressure by parsing the pending frames before accepting data
+  auto &stats = Misc::PipelineStats::instance();
+  const auto policy = m_overflowPolicy;
+  const auto freeSpace = m_dataBuffer.freeSpace();
+  if (data.size() > freeSpace
+      && (policy == SerialStudio::OverflowBackpressure
+          || (policy == SerialStudio::OverflowDropNewest && freeSpace == 0)))
+    extractFrames();
 
-  // Schedule a frame extraction as soon as possible without blocking the thread
-  else
+  // A full buffer without complete frames would reject all new data forever
+  if (policy == SerialStudio::OverflowDropNewest
+      && m_dataBuffer.freeSpace() == 0)
+  {
+    stats.recordIntegrity(Misc::PipelineStats::IncompleteFrames);
+    consume(m_dataBuffer.size());
+  }
+
+  // Register buffer overruns according to the overflow policy
+  qsizetype accepted = data.size();
+  const auto overrun = data.size() - m_dataBuffer.freeSpace();
+  if (overrun > 0)
+  {
+    stats.recordDrops(Misc::PipelineStats::FrameReader);
+    if (policy == SerialStudio::OverflowDropNewest)
+    {
+      accepted -= overrun;
+      stats.recordIntegrity(Misc::PipelineStats::RejectedBytes, overrun);
+    }
+
+    else
+    {
+      m_startScanOffset = 0;
+      m_finishScanOffset = 0;
+      m_decodeError = true;
+      stats.recordIntegrity(Misc::PipelineStats::OverwrittenBytes, overrun);
+    }
+  }
+
+  // Add the accepted data to the circular buffer
+  if (accepted > 0)
+  {
+    if (m_pendingSince == 0)
+      m_pendingSince = stats.timestamp();
+
+    // Register the arrival time of the chunk, overwritten bytes are consumed
+    if (overrun > 0 && policy != SerialStudio::OverflowDropNewest)
+      m_consumedBytes += overrun;
+
+    m_receivedBytes += accepted;
+    m_chunkTimes.enqueue({m_receivedBytes,
+                          timestamp > 0 ? timestamp : stats.timestamp()});
+    discardChunkTimes();
+
+    if (!bypassBuffer)
+      m_dataBuffer.append(data.constData(), accepted);
+  }
+
+  // Read frames in no-delimiter mode directly, sharing the received chunk
+  // when no older bytes are waiting in the buffer
+  if (directFrames)
+  {
+    if (accepted > 0)
+    {
+      const auto time = frameTimestamp(accepted);
+      if (!bypassBuffer)
+        publishFrame(m_dataBuffer.read(accepted), time);
+      else if (accepted < data.size())
+        publishFrame(data.first(accepted), time);
+      else
+        publishFrame(data, time);
+
+      m_consumedBytes += accepted;
+      discardChunkTimes();
+      flushFrames();
+    }
+
+    recordStatistics();
+  }
+
+  // Schedule a frame extraction as soon as possible without blocking the
+  // thread, chunks received before it runs are parsed in the same wakeup
+  else if (!m_readScheduled)
+  {
+    m_readScheduled = true;
     QMetaObject::invokeMethod(this, &FrameReader::readFrames,
                               Qt::QueuedConnection);
+  }
 
   // Notify UI of received data
   Q_EMIT dataReceived(data);
@@ -183,6 +379,8 @@ void IO::FrameReader::setStartSequence(const QString &start)
   if (m_startSequence != data)
   {
     m_startSequence = data;
+    m_startPattern.set({m_startSequence});
+    selectExtractor();
     reset();
   }
 }
@@ -201,10 +399,39 @@ void IO::FrameReader::setFinishSequence(const QString &finish)
   if (m_finishSequence != data)
   {
     m_finishSequence = data;
+    m_finishPattern.set({m_finishSequence});
+    selectExtractor();
     reset();
   }
 }
 
+/**
+ * @brief Changes the capacity of the data buffer.
+ *
+ * Resets the reader, since resizing the buffer discards its contents.
+ *
+ * @param capacity The maximum number of bytes that can wait to be parsed.
+ */
+void IO::FrameReader::setBufferCapacity(const qsizetype capacity)
+{
+  if (capacity > 0 && m_dataBuffer.capacity() != capacity)
+  {
+    reset();
+    m_dataBuffer.setCapacity(capacity);
+  }
+}
+
+/**
+ * @brief Sets what the reader does with data that does not fit in its buffer.
+ *
+ * @param policy The new overflow policy.
+ */
+void IO::FrameReader::setOverflowPolicy(
+    const SerialStudio::BufferOverflowPolicy policy)
+{
+  m_overflowPolicy = policy;
+}
+
 /**
  * @brief Sets the operation mode of the FrameReader.
  *
@@ -218,6 +445,7 @@ void IO::FrameReader::setOperationMode(const SerialStudio::OperationMode mode)
   if (m_operationMode != mode)
   {
     m_operationMode = mode;
+    selectExtractor();
     reset();
   }
 }
@@ -238,15 +466,73 @@ void IO::FrameReader::setFrameDetectionMode(
   if (m_frameDetectionMode != mode)
   {
     m_frameDetectionMode = mode;
+    selectExtractor();
     reset();
   }
 }
 
+/**
+ * @brief Configures the layout of length-prefixed frames.
+ *
+ * Resets the FrameReader state if the layout changes.
+ *
+ * @param header The bytes that precede the length field (may be empty).
+ * @param size The width of the length field in bytes (1, 2 or 4).
+ * @param bigEndian Set to @c true if the most significant byte of the length
+ *                  is received first.
+ */
+void IO::FrameReader::setLengthPrefix(const QByteArray &header, const int size,
+                                      const bool bigEndian)
+{
+  const auto width = std::clamp(size, 1, 4);
+  if (m_frameHeader != header || m_lengthFieldSize != width
+      || m_lengthBigEndian != bigEndian)
+  {
+    m_frameHeader = header;
+    m_lengthFieldSize = width;
+    m_lengthBigEndian = bigEndian;
+    m_headerPattern.set({m_frameHeader});
+    reset();
+  }
+}
+
+/**
+ * @brief Declares the checksum that protects project frames.
+ *
+ * With @c SerialStudio::ChecksumAuto, in-band checksum tags are detected
+ * after the frame delimiter. Otherwise, the checksum is read from the first or
+ * the last bytes of each frame & removed from the frame once validated.
+ *
+ * @param algorithm The checksum algorithm.
+ * @param position Whether the checksum is stored in the first or last bytes.
+ * @param bigEndian Set to @c true if the most significant byte of the
+ *                  checksum is received first.
+ * @param start The number of leading frame bytes that are not covered.
+ * @param end The number of trailing frame bytes that are not covered.
+ */
+void IO::FrameReader::setChecksum(
+    const SerialStudio::ChecksumAlgorithm algorithm,
+    const SerialStudio::ChecksumPosition position, const bool bigEndian,
+    const int start, const int end)
+{
+  m_checksum = algorithm;
+  m_checksumPosition = position;
+  m_checksumBigEndian = bigEndian;
+  m_checksumStart = qMax(0, start);
+  m_checksumEnd = qMax(0, end);
+  m_checksumLength = IO::checksumLength(algorithm);
+  m_enableCrc = false;
+  selectExtractor();
+}
+
 /**
  * @brief IO::FrameReader::readFrames
  */
 void IO::FrameReader::readFrames()
 {
+  TRACE_ZONE("FrameReader::readFrames");
+  m_readScheduled = false;
+
   // Stop parsing data when a device is disconnected
   if (!IO::Manager::instance().connected() && m_dataBuffer.size() > 0)
   {
@@ -254,110 +540,212 @@ void IO::FrameReader::readFrames()
     return;
   }
 
+  // Report the fill of the buffer to the overload controller
+  Misc::OverloadController::instance().reportQueue(
+      Misc::OverloadController::FrameReaderBuffer, m_dataBuffer.size(),
+      m_dataBuffer.capacity());
+
+  // Extract all complete frames from the buffer
+  extractFrames();
+  recordStatistics();
+  TRACE_COUNTER("FrameReader buffer", m_dataBuffer.size());
+}
+
+/**
+ * @brief Extracts the complete frames that are stored in the data buffer.
+ *
+ * Selects the frame detection method according to the current operation mode
+ * and frame detection mode, and emits all the frames found in a single
+ * @c framesReady() batch.
+ */
+void IO::FrameReader::extractFrames()
+{
+  // Run the extractor selected for the current configuration
+  if (m_extractor)
+    (this->*m_extractor)();
+
+  // Publish the extracted frames
+  flushFrames();
+}
+
+/**
+ * @brief Selects the frame extraction method for the current configuration.
+ *
+ * The extraction methods are specialized at compile time for the detection
+ * mode & for single-byte delimiters, which are searched with @c memchr()
+ * instead of the generic pattern search. Selecting the specialization when
+ * the configuration changes keeps the mode checks out of the extraction
+ * loops.
+ */
+void IO::FrameReader::selectExtractor()
+{
+  // Declared checksums only apply to project frames
+  m_declaredChecksum = m_operationMode == SerialStudio::ProjectFile
+                       && m_checksum != SerialStudio::ChecksumAuto;
+
+  // Obtain the specialization for start & finish delimiters
+  const bool singleStart = m_startSequence.size() == 1;
+  const bool singleFinish = m_finishSequence.size() == 1;
+  Extractor startEnd = &FrameReader::readStartEndDelimetedFrames<false, false>;
+  if (singleStart && singleFinish)
+    startEnd = &FrameReader::readStartEndDelimetedFrames<true, true>;
+  else if (singleStart)
+    startEnd = &FrameReader::readStartEndDelimetedFrames<true, false>;
+  else if (singleFinish)
+    startEnd = &FrameReader::readStartEndDelimetedFrames<false, true>;
+
+  // Quick plot data is delimited by line breaks
+  m_extractor = nullptr;
+  if (m_operationMode == SerialStudio::QuickPlot)
+    m_extractor = &FrameReader::readEndDelimetedFrames<true, false>;
+
   // JSON mode, read until default frame start & end sequences are found
-  if (m_operationMode == SerialStudio::DeviceSendsJSON)
-    readStartEndDelimetedFrames();
+  else if (m_operationMode == SerialStudio::DeviceSendsJSON)
+    m_extractor = startEnd;
 
   // Project mode, obtain which frame detection method to use
   else if (m_operationMode == SerialStudio::ProjectFile)
   {
-    // Read using only an end delimiter
-    if (m_frameDetectionMode == SerialStudio::EndDelimiterOnly)
-      readEndDelimetedFrames();
+    switch (m_frameDetectionMode)
+    {
+      case SerialStudio::EndDelimiterOnly:
+        if (singleFinish)
+          m_extractor = &FrameReader::readEndDelimetedFrames<false, true>;
+        else
+          m_extractor = &FrameReader::readEndDelimetedFrames<false, false>;
+        break;
+      case SerialStudio::StartAndEndDelimiter:
+        m_extractor = startEnd;
+        break;
+      case SerialStudio::NoDelimiters:
+        m_extractor = &FrameReader::readUndelimitedFrames;
+        break;
+      case SerialStudio::LengthPrefixed:
+        m_extractor = &FrameReader::readLengthPrefixedFrames;
+        break;
+      case SerialStudio::CobsEncoded:
+        m_extractor = &FrameReader::readCobsFrames;
+        break;
+      case SerialStudio::SlipEncoded:
+        m_extractor = &FrameReader::readSlipFrames;
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Finds the first delimiter of @a pattern from the logical index
+ *        @a from.
+ *
+ * @tparam SingleByte Set to @c true if @a pattern consists of a single byte,
+ *                    which is searched with @c memchr().
+ * @param match Optional output for the index of the pattern that matched.
+ * @return The logical index of the delimiter, or -1 if not found.
+ */
+template<bool SingleByte>
+qsizetype IO::FrameReader::findDelimiter(const SIMD::PatternSet &pattern,
+                                         const qsizetype from,
+                                         qsizetype *match) const
+{
+  if constexpr (SingleByte)
+  {
+    if (match)
+      *match = 0;
 
-    // Read using both a start & end delimiter
-    else if (m_frameDetectionMode == SerialStudio::StartAndEndDelimiter)
-      readStartEndDelimetedFrames();
+    return m_dataBuffer.indexOf(pattern.at(0).at(0), from);
   }
 
-  // Handle quick plot data
-  else if (m_operationMode == SerialStudio::QuickPlot)
-    readEndDelimetedFrames();
+  else
+    return m_dataBuffer.findFirstOf(pattern, from, match);
+}
+
+/**
+ * @brief Publishes all the buffered data as a single frame.
+ */
+void IO::FrameReader::readUndelimitedFrames()
+{
+  if (m_dataBuffer.size() > 0)
+  {
+    const auto size = m_dataBuffer.size();
+    const auto time = frameTimestamp(size);
+    publishFrame(m_dataBuffer.read(size), time);
+    m_consumedBytes += size;
+    discardChunkTimes();
+  }
 }
 
 /**
  * @brief Reads frames delimited by an end sequence from the buffer.
  *
  * Extracts frames from the circular buffer that are terminated by a specified
- * end delimiter. Emits `frameReady` for each valid frame. Handles oversized
- * frames gracefully and stops processing if data is incomplete.
+ * end delimiter. Publishes each valid frame. Handles oversized frames
+ * gracefully and stops processing if data is incomplete.
+ *
+ * @tparam QuickPlot Set to @c true to split lines of quick plot data.
+ * @tparam SingleByte Set to @c true if the finish sequence is a single byte.
  */
+template<bool QuickPlot, bool SingleByte>
 void IO::FrameReader::readEndDelimetedFrames()
 {
-  // Cap the number of frames that we can read in a single call
-  int framesRead = 0;
-  constexpr int maxFrames = 100;
+  // Select the delimiters to search for
+  const auto &pattern = QuickPlot ? m_quickPlotPattern : m_finishPattern;
 
-  // Consume the buffer until
-  while (framesRead < maxFrames)
+  // Consume the buffer until no complete frames are left
+  while (true)
   {
-    // Initialize variables
-    int endIndex = -1;
-    QByteArray delimiter;
+    // Find the earliest finish sequence, skipping already scanned bytes
+    qsizetype match = -1;
+    const auto size = m_dataBuffer.size();
+    const auto endIndex
+        = findDelimiter<SingleByte>(pattern, m_finishScanOffset, &match);
 
-    // Find the earliest finish sequence in the buffer (QuickPlot mode)
-    if (m_operationMode == SerialStudio::QuickPlot)
-    {
-      for (const QByteArray &d : m_quickPlotEndSequences)
-      {
-        int index = m_dataBuffer.findPatternKMP(d);
-        if (index != -1 && (endIndex == -1 || index < endIndex))
-        {
-          endIndex = index;
-          delimiter = d;
-        }
-      }
-    }
-
-    // Find the earliest finish sequence in the buffer (project mode)
-    else if (m_frameDetectionMode == SerialStudio::EndDelimiterOnly)
+    // No complete frame found, remember how far we got
+    if (endIndex == -1)
     {
-      delimiter = m_finishSequence;
-      endIndex = m_dataBuffer.findPatternKMP(delimiter);
+      m_finishScanOffset = resumeOffset(pattern, size);
+      break;
     }
 
-    // No complete frame found
-    if (endIndex == -1)
-      break;
+    // Obtain the delimiter that was found
+    const auto &delimiter = pattern.at(match);
 
     // Extract the frame up to the delimiter
     qsizetype frameLength = endIndex;
-    QByteArray frame = m_dataBuffer.peek(frameLength);
+    auto &frame = m_framePool.acquire(frameLength);
+    m_dataBuffer.peek(0, frameLength, frame.data());
 
     // Parse frame if not empty
     if (!frame.isEmpty())
     {
       // Checksum verification & emit frame if valid
       qsizetype chop = 0;
-      auto result = integrityChecks(frame, delimiter, &chop);
+      auto result = integrityChecks(frame, endIndex, delimiter.size(), &chop);
       if (result == ValidationStatus::FrameOk)
       {
-        Q_EMIT frameReady(frame);
-        qsizetype bytesToRemove = endIndex + chop;
-        (void)m_dataBuffer.read(bytesToRemove);
+        publishFrame(frame, frameTimestamp(endIndex));
+        consume(endIndex + chop);
       }
 
       // Incomplete data; wait for more data
       else if (result == ValidationStatus::ChecksumIncomplete)
+      {
+        m_finishScanOffset = endIndex;
         break;
+      }
 
-      // Invalid frame; skip past finish sequence
+      // Invalid frame; skip past finish sequence & checksum
       else
       {
-        qsizetype bytesToRemove = endIndex + delimiter.size();
-        (void)m_dataBuffer.read(bytesToRemove);
+        consume(endIndex + chop);
+        auto &stats = Misc::PipelineStats::instance();
+        stats.recordDrops(Misc::PipelineStats::FrameReader);
+        stats.recordIntegrity(Misc::PipelineStats::ChecksumErrors);
       }
     }
 
     // Empty frame; move past the finish sequence
     else
-    {
-      qsizetype bytesToRemove = endIndex + delimiter.size();
-      (void)m_dataBuffer.read(bytesToRemove);
-    }
-
-    // Increment number of frames read
-    ++framesRead;
+      consume(endIndex + delimiter.size());
   }
 }
 
@@ -367,23 +755,37 @@ void IO::FrameReader::readEndDelimetedFrames()
  *
  * Extracts frames from the circular buffer that are enclosed by a specified
  * start and end sequence. Validates frames using integrity checks (e.g., CRC)
- * if applicable, and emits `frameReady` for each valid frame.
+ * if applicable, and publishes each valid frame.
+ *
+ * @tparam SingleStart Set to @c true if the start sequence is a single byte.
+ * @tparam SingleFinish Set to @c true if the finish sequence is a single byte.
  */
+template<bool SingleStart, bool SingleFinish>
 void IO::FrameReader::readStartEndDelimetedFrames()
 {
   // Consume the buffer until no frames are found
   while (true)
   {
-    // Find the first end sequence
-    int finishIndex = m_dataBuffer.findPatternKMP(m_finishSequence);
+    // Find the first end sequence, skipping already scanned bytes
+    const auto size = m_dataBuffer.size();
+    qsizetype finishIndex
+        = findDelimiter<SingleFinish>(m_finishPattern, m_finishScanOffset);
     if (finishIndex == -1)
+    {
+      m_finishScanOffset = resumeOffset(m_finishPattern, size);
       break;
+    }
 
     // Find the first start sequence and ensure its before the end sequence
-    int startIndex = m_dataBuffer.findPatternKMP(m_startSequence);
+    qsizetype startIndex
+        = findDelimiter<SingleStart>(m_startPattern, m_startScanOffset);
     if (startIndex == -1 || startIndex >= finishIndex)
     {
-      (void)m_dataBuffer.read(finishIndex + m_finishSequence.size());
+      if (finishIndex > 0)
+        Misc::PipelineStats::instance().recordIntegrity(
+            Misc::PipelineStats::IncompleteFrames);
+
+      consume(finishIndex + m_finishSequence.size());
       continue;
     }
 
@@ -392,142 +794,624 @@ void IO::FrameReader::readStartEndDelimetedFrames()
     qsizetype frameLength = finishIndex - frameStart;
 
     // Extract the frame between start and finish sequences
-    QByteArray frame = m_dataBuffer.peek(frameStart + frameLength)
-                           .mid(frameStart, frameLength);
+    auto &frame = m_framePool.acquire(frameLength);
+    m_dataBuffer.peek(frameStart, frameLength, frame.data());
 
     // Parse the frame if not empty
     if (!frame.isEmpty())
     {
       // Checksum verification & emit frame if valid
       qsizetype chop = 0;
-      auto result = integrityChecks(frame, m_finishSequence, &chop);
+      auto result = integrityChecks(frame, finishIndex,
+                                    m_finishSequence.size(), &chop);
       if (result == ValidationStatus::FrameOk)
       {
-        Q_EMIT frameReady(frame);
-        qsizetype bytesToRemove = finishIndex + chop;
-        (void)m_dataBuffer.read(bytesToRemove);
+        publishFrame(frame, frameTimestamp(finishIndex));
+        consume(finishIndex + chop);
       }
 
       // Incomplete data; wait for more data
       else if (result == ValidationStatus::ChecksumIncomplete)
+      {
+        m_startScanOffset = startIndex;
+        m_finishScanOffset = finishIndex;
         break;
+      }
 
-      // Invalid frame; discard up to the end sequence
+      // Invalid frame; discard up to the end sequence & checksum
       else
       {
-        qsizetype bytesToRemove = finishIndex + m_finishSequence.size();
-        (void)m_dataBuffer.read(bytesToRemove);
+        consume(finishIndex + chop);
+        auto &stats = Misc::PipelineStats::instance();
+        stats.recordDrops(Misc::PipelineStats::FrameReader);
+        stats.recordIntegrity(Misc::PipelineStats::ChecksumErrors);
       }
     }
 
     // Empty frame; discard up to the end sequence
     else
-    {
-      qsizetype bytesToRemove = finishIndex + m_finishSequence.size();
-      (void)m_dataBuffer.read(bytesToRemove);
-    }
+      consume(finishIndex + m_finishSequence.size());
   }
 }
 
 /**
- * @brief Performs integrity checks on a frame.
+ * @brief Reads length-prefixed frames from the buffer.
  *
- * Verifies the validity of a frame using CRC checks (CRC-8, CRC-16, or CRC-32)
- * if the appropriate headers are detected in the circular buffer. Updates the
- * number of bytes to be removed from the buffer and returns the validation
- * status.
- *
- * @param frame The frame data to validate.
- * @param bytes A pointer to the number of bytes to remove from the buffer.
- * @return The validation status as a `ValidationStatus` enum:
- *         - `FrameOk`: Frame is valid.
- *         - `ChecksumError`: CRC mismatch.
- *         - `ChecksumIncomplete`: Not enough data for validation.
+ * Every frame starts with the configured header (if any), followed by the
+ * length of the payload & the payload itself. Bytes that precede the header
+ * are discarded, and a length that cannot fit in the buffer is treated as a
+ * corrupted header, in which case the reader resynchronizes at the next
+ * header. Checksum trailers right after the payload are verified as with
+ * delimited frames.
  */
-IO::ValidationStatus
-IO::FrameReader::integrityChecks(const QByteArray &frame,
-                                 const QByteArray &delimeter, qsizetype *bytes)
+void IO::FrameReader::readLengthPrefixedFrames()
 {
-  // Get finish sequence as byte array
-  auto crc8Header = delimeter + "crc8:";
-  auto crc16Header = delimeter + "crc16:";
-  auto crc32Header = delimeter + "crc32:";
+  const auto headerSize = m_frameHeader.size();
+  const auto prefixSize = headerSize + m_lengthFieldSize;
+  auto &stats = Misc::PipelineStats::instance();
 
-  // Temporary buffer to peek at the required length of data
-  QByteArray cursor = m_dataBuffer.peek(m_dataBuffer.size());
+  while (true)
+  {
+    // Find the header & discard the bytes that precede it
+    if (headerSize > 0)
+    {
+      const auto size = m_dataBuffer.size();
+      const auto headerIndex
+          = m_dataBuffer.findFirstOf(m_headerPattern, m_startScanOffset);
+      if (headerIndex == -1)
+      {
+        const auto offset = resumeOffset(m_headerPattern, size);
+        if (offset > 0)
+        {
+          stats.recordIntegrity(Misc::PipelineStats::IncompleteFrames);
+          consume(offset);
+        }
+
+        break;
+      }
 
-  // Check CRC-8
-  if (cursor.contains(crc8Header))
+      if (headerIndex > 0)
+      {
+        stats.recordIntegrity(Misc::PipelineStats::IncompleteFrames);
+        consume(headerIndex);
+      }
+    }
+
+    // Wait for the length field
+    if (m_dataBuffer.size() < prefixSize)
+    {
+      m_startScanOffset = 0;
+      break;
+    }
+
+    // Decode the length of the payload
+    char field[4];
+    quint32 length = 0;
+    m_dataBuffer.peek(headerSize, m_lengthFieldSize, field);
+    for (int i = 0; i < m_lengthFieldSize; ++i)
+    {
+      const int j = m_lengthBigEndian ? i : m_lengthFieldSize - 1 - i;
+      length = (length << 8) | static_cast<quint8>(field[j]);
+    }
+
+    // A frame larger than the buffer can never be completed, resynchronize
+    if (length > static_cast<quint32>(m_dataBuffer.capacity() - prefixSize))
+    {
+      stats.recordIntegrity(Misc::PipelineStats::IncompleteFrames);
+      consume(headerSize > 0 ? 1 : prefixSize);
+      continue;
+    }
+
+    // Empty frame; move past the length field
+    if (length == 0)
+    {
+      consume(prefixSize);
+      continue;
+    }
+
+    // Wait for the rest of the payload
+    const auto endIndex = prefixSize + static_cast<qsizetype>(length);
+    if (m_dataBuffer.size() < endIndex)
+      break;
+
+    // Extract the payload
+    auto &frame = m_framePool.acquire(length);
+    m_dataBuffer.peek(prefixSize, length, frame.data());
+
+    // Checksum verification & emit frame if valid
+    qsizetype chop = 0;
+    auto result = integrityChecks(frame, endIndex, 0, &chop);
+    if (result == ValidationStatus::FrameOk)
+    {
+      publishFrame(frame, frameTimestamp(endIndex));
+      consume(endIndex + chop);
+    }
+
+    // Incomplete data; wait for more data
+    else if (result == ValidationStatus::ChecksumIncomplete)
+      break;
+
+    // Invalid frame; discard the payload & checksum
+    else
+    {
+      consume(endIndex + chop);
+      stats.recordDrops(Misc::PipelineStats::FrameReader);
+      stats.recordIntegrity(Misc::PipelineStats::ChecksumErrors);
+    }
+  }
+}
+
+/**
+ * @brief Decodes the COBS frames in the buffer.
+ *
+ * Each code byte gives the distance to the next (implicit) zero byte, and a
+ * zero byte terminates the frame. The decoder state is kept between calls, so
+ * every byte is visited once & consumed from the buffer right away. A zero
+ * byte that appears before the end of a block marks the frame as corrupted.
+ */
+void IO::FrameReader::readCobsFrames()
+{
+  char block[kDecodeBlockSize];
+  const auto size = m_dataBuffer.size();
+  for (qsizetype offset = 0; offset < size; offset += kDecodeBlockSize)
   {
-    m_enableCrc = true;
-    qsizetype offset = cursor.indexOf(crc8Header) + crc8Header.length() - 1;
+    const auto count = std::min(kDecodeBlockSize, size - offset);
+    m_dataBuffer.peek(offset, count, block);
 
-    // Check if we have enough data in the buffer
-    if (cursor.size() >= offset + 1)
+    qsizetype i = 0;
+    while (i < count)
     {
-      *bytes += crc8Header.length() + 1;
-      quint8 crc = static_cast<quint8>(cursor.at(offset + 1));
+      // Copy the data bytes of the current block up to the next zero byte
+      if (m_cobsBlock > 0)
+      {
+        const auto run = std::min<qsizetype>(m_cobsBlock, count - i);
+        const auto *zero = static_cast<const char *>(
+            std::memchr(block + i, kCobsDelimiter, run));
+        const auto length = zero ? zero - (block + i) : run;
+        appendDecoded(block + i, length);
+        m_cobsBlock -= static_cast<int>(length);
+        i += length;
+        if (!zero)
+          continue;
 
-      if (crc8(frame.data(), frame.length()) == crc)
-        return ValidationStatus::FrameOk;
-      else
-        return ValidationStatus::ChecksumError;
+        m_decodeError = true;
+      }
+
+      // End of frame
+      const char byte = block[i];
+      if (byte == kCobsDelimiter)
+        finishDecodedFrame(offset + i + 1);
+
+      // Code byte, the previous block ends with an implicit zero
+      else if (!m_decodeError)
+      {
+        if (m_cobsZero)
+          appendDecoded(&kCobsDelimiter, 1);
+
+        const auto code = static_cast<quint8>(byte);
+        m_cobsBlock = code - 1;
+        m_cobsZero = code != 0xFF;
+      }
+
+      ++i;
     }
   }
 
-  // Check CRC-16
-  else if (cursor.contains(crc16Header))
+  consume(size);
+}
+
+/**
+ * @brief Decodes the SLIP frames in the buffer.
+ *
+ * Frames are terminated by END bytes, and END & ESC bytes in the payload are
+ * escaped. The decoder state is kept between calls, so every byte is visited
+ * once & consumed from the buffer right away. An invalid escape sequence
+ * marks the frame as corrupted.
+ */
+void IO::FrameReader::readSlipFrames()
+{
+  char block[kDecodeBlockSize];
+  const auto size = m_dataBuffer.size();
+  for (qsizetype offset = 0; offset < size; offset += kDecodeBlockSize)
   {
-    m_enableCrc = true;
-    qsizetype offset = cursor.indexOf(crc16Header) + crc16Header.length() - 1;
+    const auto count = std::min(kDecodeBlockSize, size - offset);
+    m_dataBuffer.peek(offset, count, block);
 
-    // Check if we have enough data in the buffer
-    if (cursor.size() >= offset + 2)
+    qsizetype i = 0;
+    while (i < count)
     {
-      *bytes += crc16Header.length() + 2;
+      // Copy the bytes that need no decoding at once
+      if (!m_slipEscape)
+      {
+        qsizetype j = i;
+        while (j < count && block[j] != kSlipEnd && block[j] != kSlipEsc)
+          ++j;
+
+        appendDecoded(block + i, j - i);
+        i = j;
+        if (i == count)
+          break;
+      }
+
+      // End of frame
+      const char byte = block[i];
+      if (byte == kSlipEnd)
+        finishDecodedFrame(offset + i + 1);
 
-      quint8 a = static_cast<quint8>(cursor.at(offset + 1));
-      quint8 b = static_cast<quint8>(cursor.at(offset + 2));
-      quint16 crc = (a << 8) | b;
+      // Escaped byte
+      else if (m_slipEscape)
+      {
+        m_slipEscape = false;
+        if (byte == kSlipEscEnd)
+          appendDecoded(&kSlipEnd, 1);
+        else if (byte == kSlipEscEsc)
+          appendDecoded(&kSlipEsc, 1);
+        else
+          m_decodeError = true;
+      }
 
-      if (crc16(frame.data(), frame.length()) == crc)
-        return ValidationStatus::FrameOk;
+      // Beginning of an escape sequence
       else
-        return ValidationStatus::ChecksumError;
+        m_slipEscape = true;
+
+      ++i;
     }
   }
 
-  // Check CRC-32
-  else if (cursor.contains(crc32Header))
+  consume(size);
+}
+
+/**
+ * @brief Publishes the frame decoded by the COBS or SLIP decoder & resets the
+ *        state of the decoder.
+ *
+ * Corrupted frames are counted as incomplete frames, empty frames (e.g. the
+ * END byte that SLIP senders place before each frame) are ignored.
+ *
+ * @param endIndex The logical buffer index right after the frame delimiter.
+ */
+void IO::FrameReader::finishDecodedFrame(const qsizetype endIndex)
+{
+  auto &stats = Misc::PipelineStats::instance();
+  if (m_decodeError || m_slipEscape || m_cobsBlock > 0)
+    stats.recordIntegrity(Misc::PipelineStats::IncompleteFrames);
+
+  else if (!m_decodedFrame.isEmpty())
   {
-    m_enableCrc = true;
-    qsizetype offset = cursor.indexOf(crc32Header) + crc32Header.length() - 1;
+    if (!m_declaredChecksum || verifyChecksum(m_decodedFrame))
+      publishFrame(m_decodedFrame, frameTimestamp(endIndex));
 
-    // Check if we have enough data in the buffer
-    if (cursor.size() >= offset + 4)
+    else
     {
-      *bytes += crc32Header.length() + 4;
+      stats.recordDrops(Misc::PipelineStats::FrameReader);
+      stats.recordIntegrity(Misc::PipelineStats::ChecksumErrors);
+    }
+  }
 
-      quint8 a = static_cast<quint8>(cursor.at(offset + 1));
-      quint8 b = static_cast<quint8>(cursor.at(offset + 2));
-      quint8 c = static_cast<quint8>(cursor.at(offset + 3));
-      quint8 d = static_cast<quint8>(cursor.at(offset + 4));
-      quint32 crc = (a << 24) | (b << 16) | (c << 8) | d;
+  m_cobsBlock = 0;
+  m_cobsZero = false;
+  m_slipEscape = false;
+  m_decodeError = false;
+  m_decodedFrame.clear();
+}
 
-      if (crc32(frame.data(), frame.length()) == crc)
-        return ValidationStatus::FrameOk;
-      else
-        return ValidationStatus::ChecksumError;
+/**
+ * @brief Appends decoded bytes to the current COBS or SLIP frame.
+ *
+ * Frames that grow beyond the capacity of the buffer are discarded until the
+ * next frame delimiter is received.
+ */
+void IO::FrameReader::appendDecoded(const char *data, const qsizetype size)
+{
+  if (m_decodeError || size <= 0)
+    return;
+
+  if (m_decodedFrame.size() + size > m_dataBuffer.capacity())
+  {
+    m_decodeError = true;
+    m_decodedFrame.clear();
+    return;
+  }
+
+  m_decodedFrame.append(data, size);
+}
+
+/**
+ * @brief Adds the given @a frame to the current batch & counts it for the
+ *        pipeline statistics.
+ *
+ * The frame is assigned the next sequence number of the reader, the batch is
+ * emitted by @c flushFrames().
+ *
+ * @param frame The extracted frame.
+ * @param timestamp The arrival time of the last byte of the frame.
+ */
+void IO::FrameReader::publishFrame(const QByteArray &frame,
+                                   const qint64 timestamp)
+{
+  ++m_sequence;
+  ++m_publishedFrames;
+  m_publishedBytes += frame.size();
+  m_batch.append({frame, timestamp});
+}
+
+/**
+ * @brief Emits the frames published since the last call as a single batch.
+ *
+ * The batch holds references to the frame pool slots, so each slot is only
+ * recycled after the receivers have released the batch.
+ */
+void IO::FrameReader::flushFrames()
+{
+  if (!m_batch.isEmpty())
+  {
+    Q_EMIT framesReady(m_batch);
+    m_batch.clear();
+  }
+}
+
+/**
+ * @brief Returns the arrival time of the chunk that contains the byte right
+ *        before the given logical buffer index.
+ *
+ * @param endIndex The logical index at which the frame ends (exclusive).
+ */
+qint64 IO::FrameReader::frameTimestamp(const qsizetype endIndex) const
+{
+  const auto position = m_consumedBytes + static_cast<quint64>(endIndex);
+  for (const auto &chunk : m_chunkTimes)
+  {
+    if (chunk.end >= position)
+      return chunk.timestamp;
+  }
+
+  return m_chunkTimes.isEmpty() ? 0 : m_chunkTimes.last().timestamp;
+}
+
+/**
+ * @brief Forgets the arrival time of the chunks that were fully consumed.
+ */
+void IO::FrameReader::discardChunkTimes()
+{
+  while (!m_chunkTimes.isEmpty() && m_chunkTimes.head().end <= m_consumedBytes)
+    m_chunkTimes.dequeue();
+}
+
+/**
+ * @brief Registers the frames published since the last call in the pipeline
+ *        statistics.
+ *
+ * The latency of the frames is the time elapsed since the oldest chunk of data
+ * that was still waiting to be processed was received.
+ */
+void IO::FrameReader::recordStatistics()
+{
+  if (m_publishedFrames > 0)
+  {
+    auto &stats = Misc::PipelineStats::instance();
+    stats.record(Misc::PipelineStats::FrameReader, m_publishedFrames,
+                 m_publishedBytes, stats.timestamp() - m_pendingSince);
+    stats.setIntegrity(Misc::PipelineStats::FrameSequence, m_sequence);
+    m_publishedBytes = 0;
+    m_publishedFrames = 0;
+  }
+
+  Misc::PipelineStats::instance().raiseIntegrity(
+      Misc::PipelineStats::BufferHighWater, m_dataBuffer.highWaterMark());
+
+  m_pendingSince = 0;
+}
+
+/**
+ * @brief Removes the given number of bytes from the front of the buffer.
+ *
+ * Since the logical indices of the remaining data shift after consuming
+ * bytes, the saved scan offsets for the start and finish sequences are reset.
+ *
+ * @param bytes The number of bytes to remove.
+ */
+void IO::FrameReader::consume(const qsizetype bytes)
+{
+  m_dataBuffer.discard(bytes);
+  m_startScanOffset = 0;
+  m_finishScanOffset = 0;
+
+  m_consumedBytes += bytes;
+  discardChunkTimes();
+}
+
+/**
+ * @brief Calculates where the next search for a pattern should resume.
+ *
+ * After a failed search, every byte in the buffer has been checked except for
+ * the last few, which may hold the beginning of a delimiter that has not been
+ * fully received yet. The next search starts right before those bytes, so
+ * that large frames arriving in small chunks are not rescanned from the head
+ * over and over again.
+ *
+ * The producer thread may append data while the search runs, so callers pass
+ * the buffer size they read before searching. Bytes appended after that have
+ * not necessarily been scanned and must not be skipped.
+ *
+ * @param pattern The pattern set that was searched for.
+ * @param size The buffer size read before the search started.
+ * @return The logical index from which the next search should start.
+ */
+qsizetype IO::FrameReader::resumeOffset(const SIMD::PatternSet &pattern,
+                                        const qsizetype size) const
+{
+  const auto offset = size - pattern.maxLength() + 1;
+  return std::max<qsizetype>(0, offset);
+}
+
+/**
+ * @brief Performs integrity checks on a frame.
+ *
+ * If the project declares its checksum, the frame is validated at the fixed
+ * offsets given by the declaration (see @c verifyChecksum()).
+ *
+ * Otherwise, verifies the validity of a frame using CRC checks (CRC-8, CRC-16,
+ * or CRC-32) if a checksum trailer (e.g. "crc16:" followed by the raw checksum
+ * bytes) is found right after the frame delimiter. Only the handful of bytes
+ * that can make up the trailer are copied from the circular buffer, so the
+ * cost of this check does not depend on the amount of buffered data.
+ *
+ * Updates the number of bytes to be removed from the buffer and returns the
+ * validation status.
+ *
+ * @param frame The frame data to validate.
+ * @param delimiterIndex The logical buffer index of the frame delimiter.
+ * @param delimiterLength The length of the frame delimiter.
+ * @param bytes A pointer to the number of bytes to remove from the buffer.
+ * @return The validation status as a `ValidationStatus` enum:
+ *         - `FrameOk`: Frame is valid.
+ *         - `ChecksumError`: CRC mismatch, or no CRC in a CRC-enabled stream.
+ *         - `ChecksumIncomplete`: Not enough data for validation.
+ */
+IO::ValidationStatus
+IO::FrameReader::integrityChecks(QByteArray &frame,
+                                 const qsizetype delimiterIndex,
+                                 const qsizetype delimiterLength,
+                                 qsizetype *bytes)
+{
+  // Validate declared checksums at fixed offsets of the frame
+  if (m_declaredChecksum)
+  {
+    *bytes += delimiterLength;
+    if (verifyChecksum(frame))
+      return ValidationStatus::FrameOk;
+
+    return ValidationStatus::ChecksumError;
+  }
+
+  // Supported checksum trailers
+  struct CrcTrailer
+  {
+    const char *tag;
+    qsizetype tagLength;
+    qsizetype crcLength;
+  };
+  static constexpr CrcTrailer trailers[] = {
+      {"crc8:", 5, 1},
+      {"crc16:", 6, 2},
+      {"crc32:", 6, 4},
+  };
+  static constexpr qsizetype maxTrailerLength = 10;
+
+  // Copy the bytes that follow the delimiter (if any)
+  char trailer[maxTrailerLength];
+  const auto offset = delimiterIndex + delimiterLength;
+  const auto available = std::clamp<qsizetype>(m_dataBuffer.size() - offset, 0,
+                                               maxTrailerLength);
+  if (available > 0)
+    m_dataBuffer.peek(offset, available, trailer);
+
+  // Look for a checksum trailer
+  bool partialTrailer = false;
+  for (const auto &t : trailers)
+  {
+    // Skip trailers that do not match the received bytes
+    const auto compare = std::min(available, t.tagLength);
+    if (std::memcmp(trailer, t.tag, compare) != 0)
+      continue;
+
+    // The beginning of the trailer may still be in transit
+    if (available < t.tagLength)
+    {
+      partialTrailer = true;
+      continue;
     }
+
+    // Check if we have enough data in the buffer
+    m_enableCrc = true;
+    if (available < t.tagLength + t.crcLength)
+      return ValidationStatus::ChecksumIncomplete;
+
+    // Read the big-endian checksum value
+    quint32 crc = 0;
+    for (qsizetype i = 0; i < t.crcLength; ++i)
+      crc = (crc << 8) | static_cast<quint8>(trailer[t.tagLength + i]);
+
+    // Calculate the checksum of the frame
+    quint32 value = 0;
+    if (t.crcLength == 1)
+      value = crc8(frame.data(), frame.length());
+    else if (t.crcLength == 2)
+      value = crc16(frame.data(), frame.length());
+    else
+      value = crc32(frame.data(), frame.length());
+
+    // Validate the frame
+    *bytes += delimiterLength + t.tagLength + t.crcLength;
+    if (value == crc)
+      return ValidationStatus::FrameOk;
+    else
+      return ValidationStatus::ChecksumError;
   }
 
   // Buffer does not contain CRC code
-  else if (!m_enableCrc)
+  if (!m_enableCrc)
   {
-    *bytes += delimeter.length();
+    *bytes += delimiterLength;
     return ValidationStatus::FrameOk;
   }
 
   // Checksum data incomplete
-  return ValidationStatus::ChecksumIncomplete;
+  if (partialTrailer || available == 0)
+    return ValidationStatus::ChecksumIncomplete;
+
+  // CRC-enabled stream, but this frame has no checksum
+  *bytes += delimiterLength;
+  return ValidationStatus::ChecksumError;
+}
+
+/**
+ * @brief Validates the checksum declared by the project for @a frame.
+ *
+ * The checksum is read from the first or the last bytes of the frame with the
+ * declared byte order, and compared with the checksum of the covered bytes,
+ * i.e. the rest of the frame without the declared leading & trailing bytes.
+ * On success, the checksum bytes are removed from the frame.
+ *
+ * @param frame The frame to validate.
+ * @return @c true if the frame is valid or no checksum is declared.
+ */
+bool IO::FrameReader::verifyChecksum(QByteArray &frame) const
+{
+  // No checksum declared
+  const auto width = m_checksumLength;
+  if (width == 0)
+    return true;
+
+  // The frame must hold the checksum & the bytes excluded from it
+  const auto size = frame.size();
+  const auto covered = size - width - m_checksumStart - m_checksumEnd;
+  if (covered < 0)
+    return false;
+
+  // Locate the checksum & the covered bytes
+  const bool header = m_checksumPosition == SerialStudio::ChecksumHeader;
+  const auto *data = frame.constData();
+  const auto *field = header ? data : data + size - width;
+  const auto *payload = (header ? data + width : data) + m_checksumStart;
+
+  // Read the received checksum
+  quint32 expected = 0;
+  for (int i = 0; i < width; ++i)
+  {
+    const int j = m_checksumBigEndian ? i : width - 1 - i;
+    expected = (expected << 8) | static_cast<quint8>(field[j]);
+  }
+
+  // Compare it with the checksum of the covered bytes
+  if (IO::checksum(m_checksum, payload, static_cast<int>(covered)) != expected)
+    return false;
+
+  // Strip the checksum from the frame
+  if (header)
+    frame.remove(0, width);
+  else
+    frame.chop(width);
+
+  return true;
 }
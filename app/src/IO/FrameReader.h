@@ -22,14 +22,24 @@
 
 #pragma once
 
+#include <QQueue>
 #include <QTimer>
 #include <QThread>
 #include <QObject>
 #include <QByteArray>
 
 #include "SerialStudio.h"
+#include "SIMD/SIMD.h"
+#include "IO/FrameBatch.h"
+#include "IO/FramePool.h"
 #include "IO/CircularBuffer.h"
 
+namespace Misc
+{
+class Benchmark;
+class Corpus;
+}
+
 namespace IO
 {
 enum class ValidationStatus
@@ -47,53 +57,172 @@ enum class ValidationStatus
  * and end sequences or delimiters. Supports multiple modes for flexible data
  * handling, such as quick plotting, JSON extraction, and project-specific
  * parsing.
+ *
+ * The arrival time of each received chunk is kept until its bytes have been
+ * consumed, so that every frame is published with the time at which the
+ * chunk containing its last byte was received by the I/O driver.
+ *
+ * Extraction is scheduled at most once at a time: every wakeup drains all the
+ * complete frames in the buffer & publishes them in a single
+ * @c framesReady() batch, so that high frame rates do not flood the event
+ * loops of the reader & of the receivers with one event per frame.
+ *
+ * Every published frame is assigned a monotonically increasing sequence
+ * number. Bytes overwritten in the circular buffer before they could be read,
+ * frames rejected by their checksum & incomplete frames (e.g. a finish
+ * sequence without a start sequence, or unread data discarded when the reader
+ * is reset) are reported to the link integrity counters of
+ * @c Misc::PipelineStats.
+ *
+ * The capacity of the data buffer is set by the owner of the reader according
+ * to the data rate of the source, and the overflow policy decides what happens
+ * when a chunk does not fit: the oldest bytes are overwritten, the new bytes
+ * are rejected, or the pending frames are parsed first (backpressure) so that
+ * only the bytes of incomplete frames can be lost.
+ *
+ * Binary protocols can be framed without delimiters that may collide with the
+ * payload: length-prefixed frames (an optional header followed by the length
+ * of the payload), COBS frames & SLIP frames. COBS & SLIP frames are decoded
+ * byte by byte as they are received, so a corrupted frame is dropped at the
+ * next frame boundary without searching the buffer again.
+ *
+ * Project frames can declare their checksum (algorithm, position, byte order
+ * & covered range), in which case it is validated at fixed offsets of the
+ * frame. Otherwise, in-band checksum tags after the delimiter are detected.
  */
 class FrameReader : public QObject
 {
   Q_OBJECT
 
 signals:
-  void frameReady(const QByteArray &frame);
+  void framesReady(const IO::FrameBatch &frames);
   void dataReceived(const QByteArray &data);
 
 public:
   explicit FrameReader(QObject *parent = nullptr);
 
+  [[nodiscard]] quint64 sequence() const;
+  [[nodiscard]] qsizetype bufferCapacity() const;
+  [[nodiscard]] SerialStudio::BufferOverflowPolicy overflowPolicy() const;
   [[nodiscard]] SerialStudio::OperationMode operationMode() const;
   [[nodiscard]] SerialStudio::FrameDetection frameDetectionMode() const;
 
   [[nodiscard]] const QByteArray &startSequence() const;
   [[nodiscard]] const QByteArray &finishSequence() const;
+  [[nodiscard]] const QByteArray &frameHeader() const;
 
 public slots:
   void reset();
   void setupExternalConnections();
-  void processData(const QByteArray &data);
+  void processData(const QByteArray &data, const qint64 timestamp = 0);
   void setStartSequence(const QString &start);
   void setFinishSequence(const QString &finish);
+  void setBufferCapacity(const qsizetype capacity);
+  void setOverflowPolicy(const SerialStudio::BufferOverflowPolicy policy);
   void setOperationMode(const SerialStudio::OperationMode mode);
   void setFrameDetectionMode(const SerialStudio::FrameDetection mode);
+  void setLengthPrefix(const QByteArray &header, const int size,
+                       const bool bigEndian);
+  void setChecksum(const SerialStudio::ChecksumAlgorithm algorithm,
+                   const SerialStudio::ChecksumPosition position,
+                   const bool bigEndian, const int start, const int end);
 
 private slots:
   void readFrames();
+  void loadProjectFraming();
 
 private:
+  void extractFrames();
+  void selectExtractor();
+  void readUndelimitedFrames();
+  template<bool QuickPlot, bool SingleByte>
   void readEndDelimetedFrames();
+  template<bool SingleStart, bool SingleFinish>
   void readStartEndDelimetedFrames();
-  ValidationStatus integrityChecks(const QByteArray &frame,
-                                   const QByteArray &delimeter,
+  void readLengthPrefixedFrames();
+  void readCobsFrames();
+  void readSlipFrames();
+  void finishDecodedFrame(const qsizetype endIndex);
+  void appendDecoded(const char *data, const qsizetype size);
+  void flushFrames();
+  void recordStatistics();
+  void consume(const qsizetype bytes);
+  void discardChunkTimes();
+  qint64 frameTimestamp(const qsizetype endIndex) const;
+  void publishFrame(const QByteArray &frame, const qint64 timestamp);
+  qsizetype resumeOffset(const SIMD::PatternSet &pattern,
+                         const qsizetype size) const;
+  template<bool SingleByte>
+  qsizetype findDelimiter(const SIMD::PatternSet &pattern, const qsizetype from,
+                          qsizetype *match = nullptr) const;
+  bool verifyChecksum(QByteArray &frame) const;
+  ValidationStatus integrityChecks(QByteArray &frame,
+                                   const qsizetype delimiterIndex,
+                                   const qsizetype delimiterLength,
                                    qsizetype *bytes);
 
 private:
   bool m_enableCrc;
+  bool m_readScheduled;
+
+  using Extractor = void (FrameReader::*)();
+  Extractor m_extractor;
+
+  int m_lengthFieldSize;
+  bool m_lengthBigEndian;
+
+  bool m_declaredChecksum;
+  bool m_checksumBigEndian;
+  int m_checksumStart;
+  int m_checksumEnd;
+  int m_checksumLength;
+  SerialStudio::ChecksumAlgorithm m_checksum;
+  SerialStudio::ChecksumPosition m_checksumPosition;
+
+  int m_cobsBlock;
+  bool m_cobsZero;
+  bool m_slipEscape;
+  bool m_decodeError;
+  QByteArray m_decodedFrame;
+
+  qsizetype m_startScanOffset;
+  qsizetype m_finishScanOffset;
+
+  qint64 m_pendingSince;
+  quint64 m_sequence;
+  quint64 m_publishedBytes;
+  quint64 m_publishedFrames;
+
+  struct ChunkTime
+  {
+    quint64 end;
+    qint64 timestamp;
+  };
+
+  quint64 m_receivedBytes;
+  quint64 m_consumedBytes;
+  QQueue<ChunkTime> m_chunkTimes;
+
+  FrameBatch m_batch;
 
   SerialStudio::OperationMode m_operationMode;
   SerialStudio::FrameDetection m_frameDetectionMode;
+  SerialStudio::BufferOverflowPolicy m_overflowPolicy;
 
+  FramePool m_framePool;
   CircularBuffer<QByteArray, char> m_dataBuffer;
 
+  QByteArray m_frameHeader;
   QByteArray m_startSequence;
   QByteArray m_finishSequence;
   QList<QByteArray> m_quickPlotEndSequences;
+
+  SIMD::PatternSet m_startPattern;
+  SIMD::PatternSet m_headerPattern;
+  SIMD::PatternSet m_finishPattern;
+  SIMD::PatternSet m_quickPlotPattern;
+
+  friend class Misc::Benchmark;
+  friend class Misc::Corpus;
 };
 } // namespace IO
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IO/Framing.h"
+
+/**
+ * @brief Encodes @a data with Consistent Overhead Byte Stuffing.
+ *
+ * Every zero byte is replaced by the distance to the next zero byte, so that
+ * the encoded frame contains no zero bytes. The returned frame includes the
+ * trailing zero delimiter.
+ *
+ * @param data The payload to encode.
+ * @return The encoded frame.
+ */
+QByteArray IO::cobsEncode(const QByteArray &data)
+{
+  QByteArray frame;
+  frame.reserve(data.size() + data.size() / 254 + 2);
+
+  // Reserve the code byte of the first block
+  qsizetype codeIndex = 0;
+  quint8 code = 1;
+  frame.append('\0');
+
+  for (const char byte : data)
+  {
+    // A zero byte closes the current block
+    if (byte == kCobsDelimiter)
+    {
+      frame[codeIndex] = static_cast<char>(code);
+      codeIndex = frame.size();
+      frame.append('\0');
+      code = 1;
+      continue;
+    }
+
+    // Copy the byte, full blocks are closed without an implicit zero
+    frame.append(byte);
+    if (++code == 0xFF)
+    {
+      frame[codeIndex] = static_cast<char>(code);
+      codeIndex = frame.size();
+      frame.append('\0');
+      code = 1;
+    }
+  }
+
+  // Close the last block & terminate the frame
+  frame[codeIndex] = static_cast<char>(code);
+  frame.append(kCobsDelimiter);
+  return frame;
+}
+
+/**
+ * @brief Encodes @a data with the Serial Line Internet Protocol framing.
+ *
+ * END & ESC bytes in the payload are escaped, and the frame is surrounded by
+ * END bytes, so that the receiver can discard any noise before the frame.
+ *
+ * @param data The payload to encode.
+ * @return The encoded frame.
+ */
+QByteArray IO::slipEncode(const QByteArray &data)
+{
+  QByteArray frame;
+  frame.reserve(data.size() + 2);
+  frame.append(kSlipEnd);
+
+  for (const char byte : data)
+  {
+    if (byte == kSlipEnd)
+    {
+      frame.append(kSlipEsc);
+      frame.append(kSlipEscEnd);
+    }
+
+    else if (byte == kSlipEsc)
+    {
+      frame.append(kSlipEsc);
+      frame.append(kSlipEscEsc);
+    }
+
+    else
+      frame.append(byte);
+  }
+
+  frame.append(kSlipEnd);
+  return frame;
+}
+
+/**
+ * @brief Prepends the @a header and the length of @a data to @a data.
+ *
+ * @param header The bytes that mark the beginning of a frame (may be empty).
+ * @param data The payload of the frame.
+ * @param size The width of the length field in bytes (1, 2 or 4).
+ * @param bigEndian Writes the most significant byte of the length first.
+ * @return The length-prefixed frame.
+ */
+QByteArray IO::lengthPrefix(const QByteArray &header, const QByteArray &data,
+                            const int size, const bool bigEndian)
+{
+  QByteArray frame;
+  frame.reserve(header.size() + size + data.size());
+  frame.append(header);
+
+  const auto length = static_cast<quint32>(data.size());
+  for (int i = 0; i < size; ++i)
+  {
+    const int shift = bigEndian ? 8 * (size - 1 - i) : 8 * i;
+    frame.append(static_cast<char>((length >> shift) & 0xFF));
+  }
+
+  frame.append(data);
+  return frame;
+}
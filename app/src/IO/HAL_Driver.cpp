@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QThread>
+
+#include "IO/HAL_Driver.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * @brief Constructs the driver base class.
+ *
+ * By default, received data is coalesced for up to 2 ms or until 8 KB have
+ * been accumulated, whichever comes first.
+ *
+ * @param parent The parent QObject (optional).
+ */
+IO::HAL_Driver::HAL_Driver(QObject *parent)
+  : QObject(parent)
+  , m_coalescingWindow(2)
+  , m_coalescingThreshold(8 * 1024)
+  , m_pendingSince(0)
+{
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_flushTimer, &QTimer::timeout, this,
+          &IO::HAL_Driver::flushPendingData);
+}
+
+/**
+ * @brief Returns the maximum number of bytes per second that the device can
+ *        deliver, or 0 if it is unknown.
+ *
+ * Used by @c IO::Manager to size the frame reader buffer. Drivers that know
+ * their link speed (e.g. the baud rate of a serial port) override this.
+ */
+qint64 IO::HAL_Driver::dataRate() const
+{
+  return 0;
+}
+
+/**
+ * @brief Returns @c true if consecutive writes can be merged into a single
+ *        write call.
+ *
+ * Stream-oriented devices (serial ports, TCP sockets) accept merged writes.
+ * Drivers for message-oriented devices, where each write is delivered as a
+ * separate packet, must override this function & return @c false.
+ */
+bool IO::HAL_Driver::supportsCoalescedWrites() const
+{
+  return true;
+}
+
+/**
+ * @brief Returns @c true if @c write() may be called from any thread.
+ *
+ * Drivers whose device lives in a thread of its own, and that marshal every
+ * write to that thread, can override this function & return @c true, which
+ * lets the plugin command lane (see @c IO::Manager::writeCommand()) hand data
+ * to the driver without going through the main thread.
+ */
+bool IO::HAL_Driver::supportsThreadSafeWrites() const
+{
+  return false;
+}
+
+/**
+ * @brief Writes @a data to the device & reports the result through the
+ *        @c writeFinished() signal, tagged with the caller's @a ticket.
+ *
+ * The default implementation writes synchronously with @c write(), so the
+ * signal is emitted before this function returns. Drivers that only queue
+ * the data must override it & emit the signal once the bytes are written,
+ * or with -1 if the write fails.
+ *
+ * @param ticket Number chosen by the caller to identify the write.
+ * @param data The data to write.
+ */
+void IO::HAL_Driver::beginWrite(const quint64 ticket, const QByteArray &data)
+{
+  const auto bytes = static_cast<qint64>(write(data));
+  Q_EMIT writeFinished(ticket, bytes);
+}
+
+/**
+ * @brief Returns the maximum time (in milliseconds) that received data is
+ *        held back before being forwarded.
+ *
+ * A value of zero disables coalescing.
+ */
+int IO::HAL_Driver::coalescingWindow() const
+{
+  return m_coalescingWindow;
+}
+
+/**
+ * @brief Returns the number of pending bytes that triggers an immediate
+ *        flush, regardless of the time window.
+ */
+qsizetype IO::HAL_Driver::coalescingThreshold() const
+{
+  return m_coalescingThreshold;
+}
+
+/**
+ * @brief Forwards all accumulated data through a single @c dataReceived()
+ *        signal.
+ */
+void IO::HAL_Driver::flushPendingData()
+{
+  m_flushTimer.stop();
+  if (m_pendingData.isEmpty())
+    return;
+
+  QByteArray data;
+  data.swap(m_pendingData);
+
+  // Register the time that the oldest bytes spent waiting
+  auto &stats = Misc::PipelineStats::instance();
+  stats.record(Misc::PipelineStats::DriverReceive, 1, data.size(),
+               stats.timestamp() - m_pendingSince);
+
+  Q_EMIT dataReceived(data, m_pendingSince);
+}
+
+/**
+ * @brief Changes the coalescing time window.
+ *
+ * Pending data is flushed, so that changing the window never delays bytes
+ * that were already received.
+ *
+ * @param msec The new window in milliseconds, zero disables coalescing.
+ */
+void IO::HAL_Driver::setCoalescingWindow(const int msec)
+{
+  flushPendingData();
+  m_coalescingWindow = qMax(0, msec);
+}
+
+/**
+ * @brief Changes the byte threshold that triggers an immediate flush.
+ *
+ * @param bytes The new threshold in bytes.
+ */
+void IO::HAL_Driver::setCoalescingThreshold(const qsizetype bytes)
+{
+  m_coalescingThreshold = qMax<qsizetype>(1, bytes);
+  if (m_pendingData.size() >= m_coalescingThreshold)
+    flushPendingData();
+}
+
+/**
+ * @brief Registers data received from the device.
+ *
+ * If coalescing is disabled, the data is forwarded right away. Otherwise, it
+ * is appended to the pending buffer, which is flushed when the byte threshold
+ * is reached or when the coalescing window expires.
+ *
+ * Drivers that read from a dedicated thread already receive data in large
+ * chunks, so their data is always forwarded right away, directly from the
+ * reader thread.
+ *
+ * The driver gives up its buffer, which becomes the pending buffer when no
+ * data is pending, so that its memory reaches the frame reader as-is.
+ *
+ * @param data The received data.
+ * @param receivedAt Time at which the oldest bytes were received, or a
+ *                   negative value to use the current time.
+ */
+void IO::HAL_Driver::processData(QByteArray &&data, const qint64 receivedAt)
+{
+  // Nothing to do
+  if (data.isEmpty())
+    return;
+
+  // Coalescing disabled or reader thread, forward data directly
+  if (m_coalescingWindow <= 0 || QThread::currentThread() != thread())
+  {
+    auto &stats = Misc::PipelineStats::instance();
+    const auto now = stats.timestamp();
+    const auto since = receivedAt >= 0 ? qMin(receivedAt, now) : now;
+    stats.record(Misc::PipelineStats::DriverReceive, 1, data.size(),
+                 now - since);
+    Q_EMIT dataReceived(data, since);
+    return;
+  }
+
+  // Accumulate data
+  if (m_pendingData.isEmpty())
+  {
+    m_pendingData = std::move(data);
+    m_pendingSince = receivedAt >= 0 ? receivedAt
+                                     : Misc::PipelineStats::timestamp();
+  }
+
+  else
+    m_pendingData.append(data);
+
+  // Flush immediately if we reached the threshold, otherwise wait
+  if (m_pendingData.size() >= m_coalescingThreshold)
+    flushPendingData();
+  else if (!m_flushTimer.isActive())
+    m_flushTimer.start(m_coalescingWindow);
+}
+
+/**
+ * @brief Registers data received from the device.
+ *
+ * Overload for drivers that keep their buffer, the data is implicitly shared
+ * rather than copied.
+ *
+ * @param data The received data.
+ * @param receivedAt Time at which the oldest bytes were received.
+ */
+void IO::HAL_Driver::processData(const QByteArray &data,
+                                   const qint64 receivedAt)
+{
+  processData(QByteArray(data), receivedAt);
+}
@@ -22,9 +22,12 @@
 
 #pragma once
 
+#include <QTimer>
 #include <QObject>
 #include <QIODevice>
 
+#include "IO/FrameBatch.h"
+
 namespace IO
 {
 /**
@@ -37,6 +40,34 @@ namespace IO
  *
  * Signals are available for configuration changes, data transmission, and data
  * reception.
+ *
+ * Received data can optionally be coalesced: small chunks reported by the
+ * driver are accumulated and forwarded in a single @c dataReceived() signal
+ * once a byte threshold is reached or a time window expires. This keeps high
+ * baud-rate devices from flooding the frame reader thread with thousands of
+ * tiny events per second.
+ *
+ * Drivers that read into a buffer of their own (e.g. @c QIODevice::readAll())
+ * can move it into @c processData(), which then hands the same memory over to
+ * the frame reader without copying it.
+ *
+ * Every chunk is reported with the monotonic time at which its oldest bytes
+ * were received (see @c Misc::PipelineStats::timestamp()), which is carried
+ * through the frame reader & frame builder to measure end-to-end latency.
+ * Drivers that can estimate how long the bytes waited before they were read
+ * (e.g. in the buffer of a USB serial adapter) pass that time to
+ * @c processData(), otherwise the time of the call is used.
+ *
+ * Writes issued through @c beginWrite() are reported with @c writeFinished()
+ * once the bytes have really been written to the device, which lets callers
+ * apply backpressure & measure the transmission latency. Drivers that buffer
+ * writes (e.g. in the thread of a serial port) override @c beginWrite() to
+ * report the completion when the device accepts the data.
+ *
+ * Drivers that serve several devices at once (e.g. the TCP server mode of the
+ * network driver) extract the frames of each device with a frame reader of
+ * their own, and report them through @c framesReceived() instead, tagged with
+ * the number of the device that sent them.
  */
 class HAL_Driver : public QObject
 {
@@ -45,9 +76,13 @@ class HAL_Driver : public QObject
 signals:
   void configurationChanged();
   void dataSent(const QByteArray &data);
-  void dataReceived(const QByteArray &data);
+  void dataReceived(const QByteArray &data, const qint64 timestamp);
+  void framesReceived(const IO::FrameBatch &frames);
+  void writeFinished(const quint64 ticket, const qint64 bytes);
 
 public:
+  explicit HAL_Driver(QObject *parent = nullptr);
+
   /**
    * @brief Close the device connection.
    */
@@ -60,12 +95,30 @@ public:
   [[nodiscard]] virtual quint64 write(const QByteArray &data) = 0;
   [[nodiscard]] virtual bool open(const QIODevice::OpenMode mode) = 0;
 
+  [[nodiscard]] virtual qint64 dataRate() const;
+  [[nodiscard]] virtual bool supportsCoalescedWrites() const;
+  [[nodiscard]] virtual bool supportsThreadSafeWrites() const;
+
+  virtual void beginWrite(const quint64 ticket, const QByteArray &data);
+
+  [[nodiscard]] int coalescingWindow() const;
+  [[nodiscard]] qsizetype coalescingThreshold() const;
+
+public slots:
+  void flushPendingData();
+  void setCoalescingWindow(const int msec);
+  void setCoalescingThreshold(const qsizetype bytes);
+
 protected:
-  void processData(const QByteArray &data)
-  {
-    QByteArray dataCopy(data);
-    QMetaObject::invokeMethod(
-        this, [=] { Q_EMIT dataReceived(dataCopy); }, Qt::QueuedConnection);
-  }
+  void processData(QByteArray &&data, const qint64 receivedAt = -1);
+  void processData(const QByteArray &data, const qint64 receivedAt = -1);
+
+private:
+  int m_coalescingWindow;
+  qsizetype m_coalescingThreshold;
+  qint64 m_pendingSince;
+
+  QTimer m_flushTimer;
+  QByteArray m_pendingData;
 };
 } // namespace IO
@@ -24,12 +24,60 @@
 #include "IO/Manager.h"
 #include "IO/Drivers/Serial.h"
 #include "IO/Drivers/Network.h"
+#include "IO/Drivers/Replay.h"
+#include "IO/Drivers/CANBus.h"
+#include "IO/Drivers/Modbus.h"
+#include "IO/Drivers/USB.h"
+#include "IO/Drivers/Audio.h"
+#include "IO/Drivers/Pipe.h"
+#include "IO/Drivers/Generator.h"
 #include "IO/Drivers/BluetoothLE.h"
 
+#include "Misc/Utilities.h"
 #include "Misc/Translator.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/ThreadScheduler.h"
+#include "JSON/FrameBuilder.h"
 
+#include <array>
+#include <algorithm>
+
+#include <QLocale>
 #include <QApplication>
 
+//------------------------------------------------------------------------------
+// Transmission queue limits
+//------------------------------------------------------------------------------
+
+// Maximum number of bytes waiting to be written to the device
+static constexpr qint64 kMaxTxQueueBytes = 8 * 1024 * 1024;
+
+// Maximum number of bytes handed to the driver per event loop iteration, and
+// maximum number of bytes that the driver may hold without having written them
+static constexpr qint64 kTxBudget = 64 * 1024;
+
+// Maximum size of a write obtained by merging consecutive requests
+static constexpr qint64 kMaxCoalescedWrite = 4 * 1024;
+
+//------------------------------------------------------------------------------
+// Frame reader buffer limits
+//------------------------------------------------------------------------------
+
+// Number of seconds of incoming data that an automatic buffer can hold
+static constexpr qint64 kBufferSeconds = 4;
+
+// Limits of the automatic buffer capacity
+static constexpr qsizetype kMinBufferCapacity = 64 * 1024;
+static constexpr qsizetype kMaxBufferCapacity = 64 * 1024 * 1024;
+
+// Buffer capacity used when the data rate of the device is unknown
+static constexpr qsizetype kDefaultBufferCapacity = 1024 * 1024;
+
+// Buffer sizes that can be selected by the user, 0 selects the automatic size
+static constexpr std::array<qsizetype, 6> kBufferSizes
+    = {0, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024,
+       64 * 1024 * 1024};
+
 /**
  * @brief Converts C-style escape sequences in a string to their actual values.
  *
@@ -67,12 +115,27 @@ static QString ADD_ESCAPE_SEQUENCES(const QString &str)
  */
 IO::Manager::Manager()
   : m_writeEnabled(true)
+  , m_bufferSize(0)
+  , m_overflowPolicy(SerialStudio::OverflowDropOldest)
   , m_driver(nullptr)
   , m_startSequence(QStringLiteral("/*"))
   , m_finishSequence(QStringLiteral("*/"))
+  , m_payloadDrainPending(false)
+  , m_payloadQueue(16384)
+  , m_txScheduled(false)
+  , m_txLatency(0)
+  , m_txQueueBytes(0)
+  , m_txRequestId(0)
+  , m_txInFlightBytes(0)
+  , m_writeTicket(0)
+  , m_commandDriver(nullptr)
 {
-  // Move the frame parser worker to its dedicated thread
+  // Start the clock used to measure the transmission latency
+  m_txClock.start();
+
+  // Move the frame parser & periodic action workers to their threads
   m_frameReader.moveToThread(&m_workerThread);
+  m_actionScheduler.moveToThread(&m_actionThread);
 
   // Automatically enable/disable the connect button when bus type changes
   connect(this, &IO::Manager::busTypeChanged, this,
@@ -81,14 +144,26 @@ IO::Manager::Manager()
   // Avoid crashing the app when quitting
   connect(qApp, &QApplication::aboutToQuit, this, [=] {
     disconnect(&m_frameReader);
+    m_sources.clear();
     m_workerThread.quit();
+    m_actionThread.quit();
     if (!m_workerThread.wait(100))
       m_workerThread.terminate();
+    if (!m_actionThread.wait(100))
+      m_actionThread.terminate();
   });
 
   // Start the worker thread
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_workerThread, Misc::ThreadScheduler::Role::Reader);
   m_workerThread.start(QThread::HighestPriority);
 
+  // Start the periodic action thread
+  m_actionThread.setObjectName(QStringLiteral("Action Scheduler"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_actionThread, Misc::ThreadScheduler::Role::Reader);
+  m_actionThread.start(QThread::TimeCriticalPriority);
+
   // Set default data interface to serial port
   setBusType(SerialStudio::BusType::Serial);
 }
@@ -220,7 +295,8 @@ const QString &IO::Manager::finishSequence() const
  * @brief Retrieves a list of available bus types.
  *
  * Provides a list of all supported communication mediums, including Serial,
- * Network, and Bluetooth LE.
+ * Network, Bluetooth LE, the replay of raw capture files, the synthetic
+ * signal generator and CAN bus interfaces.
  *
  * @return A list of available bus types as strings.
  */
@@ -230,36 +306,285 @@ QStringList IO::Manager::availableBuses() const
   list.append(tr("Serial Port"));
   list.append(tr("Network Socket"));
   list.append(tr("Bluetooth LE"));
+  list.append(tr("Raw Capture Replay"));
+  list.append(tr("Signal Generator"));
+  list.append(tr("CAN Bus"));
+  list.append(tr("Modbus"));
+  list.append(tr("Raw USB"));
+  list.append(tr("Audio Input"));
+  list.append(tr("Pipe / Local Socket"));
   return list;
 }
 
+/**
+ * @brief Retrieves the names of the additional data sources.
+ *
+ * Additional sources are acquired together with the main device, each one
+ * with its own reader thread & frame pipeline.
+ *
+ * @return A list with the user-readable name of each source.
+ */
+QStringList IO::Manager::sources() const
+{
+  QStringList list;
+  for (const auto &source : m_sources)
+    list.append(source->name());
+
+  return list;
+}
+
+/**
+ * @brief Retrieves the types of devices that can be used as additional
+ *        data sources.
+ *
+ * @return A list of source types as strings, in the order of the
+ *         @c IO::Source::Type enum.
+ */
+QStringList IO::Manager::sourceTypes() const
+{
+  return QStringList{tr("Serial Port"), tr("UDP Socket")};
+}
+
+/**
+ * @brief Retrieves the layout of the merged quick plot frame.
+ *
+ * When additional sources are connected in quick plot mode, the latest frame
+ * of each source is appended to the merged frame. The layout indicates which
+ * source contributed each range of channels, so that the frame builder can
+ * tag the datasets with the name of their source.
+ *
+ * @return The sources found in the last merged frame, in order.
+ */
+const QVector<IO::Manager::SourceLayout> &IO::Manager::mergedLayout() const
+{
+  return m_mergedLayout;
+}
+
+/**
+ * @brief Returns the average time (in milliseconds) between queueing a write
+ *        & the driver reporting that its bytes were written.
+ */
+double IO::Manager::txLatency() const
+{
+  return m_txLatency;
+}
+
+/**
+ * @brief Returns the number of bytes waiting in the transmission queue, or
+ *        handed to the driver but not written to the device yet.
+ */
+qint64 IO::Manager::txQueueBytes() const
+{
+  return m_txQueueBytes;
+}
+
+/**
+ * @brief Returns the frame reader buffer size selected by the user, as an
+ *        index of the list returned by @c bufferSizes().
+ */
+int IO::Manager::bufferSize() const
+{
+  return m_bufferSize;
+}
+
+/**
+ * @brief Returns what the frame readers do with data that does not fit in
+ *        their buffers, as an index of the list returned by
+ *        @c overflowPolicies().
+ */
+int IO::Manager::overflowPolicy() const
+{
+  return m_overflowPolicy;
+}
+
+/**
+ * @brief Returns the list of frame reader buffer sizes that can be selected.
+ */
+QStringList IO::Manager::bufferSizes() const
+{
+  QStringList list;
+  list.append(tr("Automatic"));
+  for (std::size_t i = 1; i < kBufferSizes.size(); ++i)
+    list.append(QLocale().formattedDataSize(kBufferSizes[i], 0));
+
+  return list;
+}
+
+/**
+ * @brief Returns the list of actions that can be taken when incoming data
+ *        does not fit in the frame reader buffer.
+ */
+QStringList IO::Manager::overflowPolicies() const
+{
+  return {tr("Drop Oldest Data"), tr("Drop Newest Data"),
+          tr("Parse Before Accepting Data")};
+}
+
+/**
+ * @brief Returns the buffer capacity of a frame reader that receives data
+ *        from a device with the given @a dataRate.
+ *
+ * Unless the user selects a fixed size, the buffer holds a few seconds of
+ * data at the maximum rate of the device, so that short stalls of the reader
+ * thread do not lose data, without reserving many megabytes for slow links.
+ *
+ * @param dataRate Maximum number of bytes per second, or 0 if unknown.
+ */
+qsizetype IO::Manager::bufferCapacity(const qint64 dataRate) const
+{
+  if (m_bufferSize > 0)
+    return kBufferSizes[m_bufferSize];
+
+  if (dataRate <= 0)
+    return kDefaultBufferCapacity;
+
+  return std::clamp<qsizetype>(dataRate * kBufferSeconds, kMinBufferCapacity,
+                               kMaxBufferCapacity);
+}
+
 /**
  * @brief Writes data to the connected device.
  *
- * Sends the specified data to the connected device through the active driver.
- * Emits the `dataSent` signal upon successful transmission.
+ * Queues the specified data for transmission, see @c queueWrite(). The
+ * `dataSent` signal is emitted once the driver has written the data.
  *
  * @param data The data to be written.
- * @return The number of bytes written, or -1 if an error occurs or no device is
- *         connected.
+ * @return The number of bytes queued, or -1 if the transmission queue is full
+ *         or no device is connected.
  */
 qint64 IO::Manager::writeData(const QByteArray &data)
 {
-  if (connected())
-  {
-    const auto bytes = driver()->write(data);
+  if (queueWrite(data) > 0)
+    return data.size();
 
-    if (bytes > 0)
-    {
-      auto writtenData = data;
-      writtenData.chop(data.length() - bytes);
-      Q_EMIT dataSent(writtenData);
-    }
+  return -1;
+}
+
+/**
+ * @brief Queues data for asynchronous transmission to the connected device.
+ *
+ * The data is handed to the driver from the event loop, so that callers
+ * (console, file transmission, dashboard actions) never block the UI while
+ * the driver is busy. The queue is bounded, writes are rejected when it is
+ * full so that producers can apply backpressure.
+ *
+ * @param data The data to be written.
+ * @return The ID of the write request, which is reported by the
+ *         @c writeCompleted() signal, or 0 if the data was rejected.
+ */
+quint64 IO::Manager::queueWrite(const QByteArray &data)
+{
+  // Device not connected or nothing to write
+  if (!connected() || data.isEmpty())
+    return 0;
+
+  // Queue is full
+  if (m_txQueueBytes + data.size() > kMaxTxQueueBytes)
+    return 0;
+
+  // Register the write request
+  TxRequest request;
+  request.id = ++m_txRequestId;
+  request.data = data;
+  request.timestamp = m_txClock.nsecsElapsed();
+  m_txQueue.enqueue(request);
+  m_txQueueBytes += data.size();
+
+  // Schedule the transmission
+  scheduleTxQueue();
+  return request.id;
+}
+
+/**
+ * @brief Writes a latency-sensitive command to the connected device.
+ *
+ * Unlike @c queueWrite(), this function may be called from any thread and
+ * bypasses the transmission queue. If the driver supports thread-safe writes,
+ * the data is handed to it directly from the calling thread, otherwise the
+ * write is posted to the manager thread, ahead of the queued requests that
+ * were not handed to the driver yet.
+ *
+ * The result of the write is reported with @c commandCompleted() once the
+ * driver has written the data (or failed to), from the manager thread.
+ *
+ * @param data The data to be written.
+ * @return The ticket that identifies the command in @c commandCompleted(), or
+ *         0 if no device is connected or there is nothing to write.
+ */
+quint64 IO::Manager::writeCommand(const QByteArray &data)
+{
+  // Device not connected or nothing to write
+  QMutexLocker locker(&m_commandLock);
+  if (!m_commandDriver || data.isEmpty())
+    return 0;
 
-    return bytes;
+  // Write directly from the calling thread
+  auto *target = m_commandDriver;
+  const auto ticket = ++m_writeTicket;
+  if (target->supportsThreadSafeWrites())
+  {
+    Q_EMIT dataSent(data);
+    target->beginWrite(ticket, data);
+    return ticket;
   }
 
-  return -1;
+  // Post the write to the manager thread
+  QMetaObject::invokeMethod(
+      this,
+      [this, target, ticket, data] {
+        if (driver() != target || !connected())
+        {
+          Q_EMIT commandCompleted(ticket, -1);
+          return;
+        }
+
+        Q_EMIT dataSent(data);
+        target->beginWrite(ticket, data);
+      },
+      Qt::QueuedConnection);
+
+  return ticket;
+}
+
+/**
+ * @brief Stops every periodic write started with @c startPeriodicWrite().
+ */
+void IO::Manager::stopPeriodicWrites()
+{
+  QMetaObject::invokeMethod(&m_actionScheduler, &ActionScheduler::stopAll,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * @brief Stops the periodic write identified by @a id.
+ */
+void IO::Manager::stopPeriodicWrite(const int id)
+{
+  QMetaObject::invokeMethod(
+      &m_actionScheduler, [this, id] { m_actionScheduler.stop(id); },
+      Qt::QueuedConnection);
+}
+
+/**
+ * @brief Writes @a data to the device every @a interval milliseconds.
+ *
+ * The writes are timed by the action scheduler thread & sent with
+ * @c writeCommand(), so they do not depend on the UI thread. Starting a
+ * periodic write with an @a id that is already in use replaces it.
+ *
+ * @param id       Identifier of the periodic write.
+ * @param data     The data to be written.
+ * @param interval Time between two writes, in milliseconds.
+ */
+void IO::Manager::startPeriodicWrite(const int id, const QByteArray &data,
+                                     const int interval)
+{
+  QMetaObject::invokeMethod(
+      &m_actionScheduler,
+      [this, id, data, interval] {
+        m_actionScheduler.start(id, data, interval);
+      },
+      Qt::QueuedConnection);
 }
 
 /**
@@ -298,13 +623,26 @@ void IO::Manager::connectDevice()
     {
       connect(driver(), &IO::HAL_Driver::dataReceived, &m_frameReader,
               &FrameReader::processData, Qt::QueuedConnection);
-      connect(&m_frameReader, &IO::FrameReader::frameReady, this,
-              &IO::Manager::frameReceived, Qt::QueuedConnection);
+      connect(&m_frameReader, &IO::FrameReader::framesReady, this,
+              &IO::Manager::onFramesReady, Qt::QueuedConnection);
       connect(&m_frameReader, &IO::FrameReader::dataReceived, this,
               &IO::Manager::dataReceived, Qt::QueuedConnection);
+      connect(driver(), &IO::HAL_Driver::framesReceived, this,
+              &IO::Manager::onDriverFrames, Qt::QueuedConnection);
+      connect(driver(), &IO::HAL_Driver::writeFinished, this,
+              &IO::Manager::onWriteFinished, Qt::UniqueConnection);
+
+      // Enable the command lane
+      {
+        QMutexLocker locker(&m_commandLock);
+        m_commandDriver = driver();
+      }
 
+      configureFrameReaders();
       QMetaObject::invokeMethod(&m_frameReader, &FrameReader::reset,
                                 Qt::QueuedConnection);
+
+      openSources();
     }
 
     // Error opening the device
@@ -332,16 +670,33 @@ void IO::Manager::disconnectDevice()
     {
       disconnect(driver(), &IO::HAL_Driver::dataReceived, &m_frameReader,
                  &FrameReader::processData);
-      disconnect(&m_frameReader, &IO::FrameReader::frameReady, this,
-                 &IO::Manager::frameReceived);
+      disconnect(&m_frameReader, &IO::FrameReader::framesReady, this,
+                 &IO::Manager::onFramesReady);
       disconnect(&m_frameReader, &IO::FrameReader::dataReceived, this,
                  &IO::Manager::dataReceived);
+      disconnect(driver(), &IO::HAL_Driver::framesReceived, this,
+                 &IO::Manager::onDriverFrames);
       QMetaObject::invokeMethod(&m_frameReader, &FrameReader::reset,
                                 Qt::QueuedConnection);
     }
 
-    // Close driver device
+    // Disable the command lane, waiting for commands being written
+    {
+      QMutexLocker locker(&m_commandLock);
+      m_commandDriver = nullptr;
+    }
+
+    // Stop the periodic writes
+    stopPeriodicWrites();
+
+    // Close driver device & the additional sources
     driver()->close();
+    closeSources();
+    clearTxQueue();
+
+    // Stop listening for write results once the pending ones were reported
+    disconnect(driver(), &IO::HAL_Driver::writeFinished, this,
+               &IO::Manager::onWriteFinished);
 
     // Update UI
     Q_EMIT driverChanged();
@@ -365,6 +720,19 @@ void IO::Manager::setupExternalConnections()
   QMetaObject::invokeMethod(&m_frameReader,
                             &FrameReader::setupExternalConnections,
                             Qt::QueuedConnection);
+
+  // Update the transmission statistics periodically
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &IO::Manager::txStatisticsChanged);
+
+  // Restore the additional sources, now that the frame builder exists
+  const auto list = m_settings.value("io_sources").toList();
+  for (const auto &item : list)
+  {
+    const auto map = item.toMap();
+    addSource(map.value("type").toInt(), map.value("address").toString(),
+              map.value("setting").toInt());
+  }
 }
 
 /**
@@ -393,15 +761,528 @@ void IO::Manager::processPayload(const QByteArray &payload)
 {
   if (!payload.isEmpty())
   {
-    QByteArray copy = payload;
+    FrameBatch batch;
+    batch.append({payload, 0});
     QMetaObject::invokeMethod(
         this,
         [=] {
-          Q_EMIT dataReceived(copy);
-          Q_EMIT frameReceived(copy);
+          Q_EMIT dataReceived(batch.first().data);
+          Q_EMIT framesReceived(batch);
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Processes a batch of received payloads.
+ *
+ * Works like @c processPayload(), but posts a single event & emits a single
+ * frame batch for all the payloads, which avoids flooding the event queue
+ * when a large number of frames is submitted at once (e.g. during fast CSV
+ * playback).
+ *
+ * @param payloads The data payloads to process, in order.
+ */
+void IO::Manager::processPayloads(const QList<QByteArray> &payloads)
+{
+  if (!payloads.isEmpty())
+  {
+    FrameBatch batch;
+    batch.reserve(payloads.count());
+    for (const auto &payload : payloads)
+    {
+      if (!payload.isEmpty())
+        batch.append({payload, 0});
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [=] {
+          for (const auto &frame : batch)
+            Q_EMIT dataReceived(frame.data);
+
+          Q_EMIT framesReceived(batch);
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Queues a complete frame received from a remote source.
+ *
+ * Fast path for sources that deliver whole frames at high rates (e.g. the
+ * MQTT subscriber). The payload is stored in a lock-free ring & the manager
+ * is woken up only once per batch, instead of posting one event per frame.
+ *
+ * This function must always be called from the same producer thread.
+ *
+ * @param payload The frame to process.
+ * @return @c false if the ring is full, in that case the payload is processed
+ *         with @c processPayload().
+ */
+bool IO::Manager::enqueuePayload(const QByteArray &payload)
+{
+  // Ignore empty payloads
+  if (payload.isEmpty())
+    return true;
+
+  // Ring is full, fall back to an individual event
+  if (!m_payloadQueue.tryPush(payload))
+  {
+    processPayload(payload);
+    return false;
+  }
+
+  // Wake up the manager if no drain is scheduled yet
+  if (!m_payloadDrainPending.exchange(true, std::memory_order_acq_rel))
+    QMetaObject::invokeMethod(this, &IO::Manager::drainPayloads,
+                              Qt::QueuedConnection);
+
+  return true;
+}
+
+/**
+ * @brief Processes all the frames queued with @c enqueuePayload().
+ *
+ * The pending flag is cleared before the ring is read, so that frames pushed
+ * while draining schedule a new drain instead of being left in the ring.
+ */
+void IO::Manager::drainPayloads()
+{
+  m_payloadDrainPending.store(false, std::memory_order_release);
+
+  FrameBatch batch;
+  QByteArray payload;
+  while (m_payloadQueue.tryPop(payload))
+  {
+    Q_EMIT dataReceived(payload);
+    batch.append({payload, 0});
+  }
+
+  if (!batch.isEmpty())
+    Q_EMIT framesReceived(batch);
+}
+
+/**
+ * @brief Hands the queued write requests to the driver.
+ *
+ * At most @c kTxBudget bytes are written per call, the function schedules
+ * itself again until the queue is empty, which keeps large transmissions
+ * from starving the event loop. Consecutive requests are merged into a
+ * single write when the driver allows it.
+ *
+ * Requests are only completed when the driver reports that their bytes were
+ * written (see @c onWriteFinished()). While @c kTxBudget bytes are waiting in
+ * the driver, no further data is handed to it, and the queue is resumed once
+ * the driver catches up.
+ */
+void IO::Manager::processTxQueue()
+{
+  m_txScheduled = false;
+
+  // Device was disconnected
+  if (!connected())
+  {
+    clearTxQueue();
+    return;
+  }
+
+  qint64 budget = kTxBudget;
+  const bool coalesce = driver()->supportsCoalescedWrites();
+  while (!m_txQueue.isEmpty() && budget > 0 && m_txInFlightBytes < kTxBudget)
+  {
+    // Merge consecutive requests into a single write
+    QList<TxRequest> requests;
+    requests.append(m_txQueue.dequeue());
+    QByteArray buffer = requests.first().data;
+    while (coalesce && !m_txQueue.isEmpty()
+           && buffer.size() + m_txQueue.head().data.size() <= kMaxCoalescedWrite)
+    {
+      requests.append(m_txQueue.dequeue());
+      buffer.append(requests.last().data);
+    }
+
+    // Register the write before starting it, drivers may report it at once
+    const auto ticket = ++m_writeTicket;
+    m_txInFlight.insert(ticket, {buffer, requests});
+    m_txInFlightBytes += buffer.size();
+    budget -= buffer.size();
+
+    // Hand the data to the driver
+    driver()->beginWrite(ticket, buffer);
+  }
+
+  // Continue with the remaining requests in the next iteration, unless we
+  // need to wait for the driver to write the data that it already has
+  if (!m_txQueue.isEmpty() && m_txInFlightBytes < kTxBudget)
+    scheduleTxQueue();
+}
+
+/**
+ * @brief Completes the write identified by @a ticket once the driver reports
+ *        that @a bytes were written (or -1 if the write failed).
+ *
+ * Writes that were not started by the transmission queue belong to the
+ * priority command lane, and are reported with @c commandCompleted().
+ */
+void IO::Manager::onWriteFinished(const quint64 ticket, const qint64 bytes)
+{
+  // Not a queued write, report the result of the command
+  auto it = m_txInFlight.find(ticket);
+  if (it == m_txInFlight.end())
+  {
+    Q_EMIT commandCompleted(ticket, bytes);
+    return;
+  }
+
+  // Remove the write from the in-flight data
+  const auto write = it.value();
+  m_txInFlight.erase(it);
+  m_txInFlightBytes -= write.data.size();
+  m_txQueueBytes -= write.data.size();
+
+  // Notify the UI about the transmitted data
+  if (bytes > 0)
+    Q_EMIT dataSent(write.data.left(bytes));
+
+  // Report the completion of each request & update the latency average
+  const auto now = m_txClock.nsecsElapsed();
+  qint64 remaining = qMax<qint64>(bytes, 0);
+  for (const auto &request : write.requests)
+  {
+    const auto written = qMin<qint64>(remaining, request.data.size());
+    remaining -= written;
+
+    const auto latency = (now - request.timestamp) / 1e6;
+    m_txLatency = m_txLatency * 0.9 + latency * 0.1;
+    Q_EMIT writeCompleted(request.id, bytes < 0 ? -1 : written);
+  }
+
+  // Hand more data to the driver
+  if (!m_txQueue.isEmpty() && m_txInFlightBytes < kTxBudget)
+    scheduleTxQueue();
+}
+
+/**
+ * @brief Discards the pending & in-flight write requests, which are reported
+ *        as failed.
+ */
+void IO::Manager::clearTxQueue()
+{
+  while (!m_txQueue.isEmpty())
+    Q_EMIT writeCompleted(m_txQueue.dequeue().id, -1);
+
+  const auto inFlight = m_txInFlight;
+  m_txInFlight.clear();
+  m_txInFlightBytes = 0;
+  for (const auto &write : inFlight)
+  {
+    for (const auto &request : write.requests)
+      Q_EMIT writeCompleted(request.id, -1);
+  }
+
+  m_txQueueBytes = 0;
+  Q_EMIT txStatisticsChanged();
+}
+
+/**
+ * @brief Runs @c processTxQueue() in the next event loop iteration, unless
+ *        it is already scheduled.
+ */
+void IO::Manager::scheduleTxQueue()
+{
+  if (m_txScheduled)
+    return;
+
+  m_txScheduled = true;
+  QMetaObject::invokeMethod(this, &IO::Manager::processTxQueue,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * @brief Adds an additional data source.
+ *
+ * The source runs in its own thread & is opened together with the main
+ * device. The list of sources is saved, so that it is restored when the
+ * application is started again.
+ *
+ * @param type    Source type, see @c IO::Source::Type.
+ * @param address Port name of serial sources, ignored for UDP sources.
+ * @param setting Baud rate of serial sources, local port of UDP sources.
+ */
+void IO::Manager::addSource(const int type, const QString &address,
+                            const int setting)
+{
+  // Validate the source parameters
+  const auto sourceType = static_cast<Source::Type>(qBound(0, type, 1));
+  if (setting <= 0 || (sourceType == Source::SerialPort && address.isEmpty()))
+    return;
+
+  // Create the source & connect its signals
+  auto source = std::make_unique<Source>(sourceType, address, setting);
+  connect(source.get(), &IO::Source::framesReady, this,
+          &IO::Manager::onSourceFrames, Qt::QueuedConnection);
+  connect(source.get(), &IO::Source::errorOccurred, this,
+          &IO::Manager::onSourceError, Qt::QueuedConnection);
+
+  // Open the source right away if the main device is connected
+  auto *ptr = source.get();
+  m_sources.push_back(std::move(source));
+  if (connected())
+  {
+    const auto start = m_startSequence;
+    const auto finish = m_finishSequence;
+    const auto policy = m_overflowPolicy;
+    const auto capacity = bufferCapacity(ptr->dataRate());
+    QMetaObject::invokeMethod(
+        ptr,
+        [=] {
+          ptr->configureBuffer(capacity, policy);
+          ptr->open(start, finish);
+        },
+        Qt::QueuedConnection);
+  }
+
+  // Update the merged frame & the user interface
+  m_latestFrames.clear();
+  saveSources();
+  Q_EMIT sourcesChanged();
+}
+
+/**
+ * @brief Removes the additional data source at the given @a index.
+ *
+ * The source is closed & its thread is stopped before returning.
+ */
+void IO::Manager::removeSource(const int index)
+{
+  if (index < 0 || index >= static_cast<int>(m_sources.size()))
+    return;
+
+  m_sources.erase(m_sources.begin() + index);
+  m_latestFrames.clear();
+  m_mergedLayout.clear();
+
+  saveSources();
+  Q_EMIT sourcesChanged();
+}
+
+/**
+ * @brief Handles a batch of frames extracted from the main device.
+ *
+ * Without additional sources, the batch is forwarded untouched. Otherwise its
+ * frames are tagged as source 0 & merged with the frames of the other sources.
+ */
+void IO::Manager::onFramesReady(const IO::FrameBatch &frames)
+{
+  if (m_sources.empty())
+    Q_EMIT framesReceived(frames);
+  else
+    mergeFrames(0, frames);
+}
+
+/**
+ * @brief Handles a batch of frames extracted by the driver itself, from the
+ *        devices that it serves (e.g. the TCP server mode of the network
+ *        driver).
+ *
+ * The device number of each frame is placed after the additional data
+ * sources, so that every device keeps its own source in the frame stream.
+ * Frames are not merged in quick plot mode, since the number of devices is
+ * not known in advance.
+ */
+void IO::Manager::onDriverFrames(const IO::FrameBatch &frames)
+{
+  auto tagged = frames;
+  const auto offset = static_cast<int>(m_sources.size());
+  for (auto &frame : tagged)
+  {
+    frame.source += offset;
+    Q_EMIT dataReceived(frame.data);
+    Q_EMIT sourceFrameReceived(frame.source, frame.data);
+  }
+
+  Q_EMIT framesReceived(tagged);
+}
+
+/**
+ * @brief Reports an error of an additional data source to the user.
+ */
+void IO::Manager::onSourceError(const QString &error)
+{
+  Misc::Utilities::showMessageBox(tr("Data source error"), error);
+}
+
+/**
+ * @brief Handles a batch of frames extracted by one of the additional data
+ *        sources.
+ */
+void IO::Manager::onSourceFrames(const IO::FrameBatch &frames)
+{
+  const auto source = sender();
+  for (std::size_t i = 0; i < m_sources.size(); ++i)
+  {
+    if (m_sources[i].get() == source)
+    {
+      mergeFrames(static_cast<int>(i) + 1, frames);
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Saves the list of additional data sources.
+ */
+void IO::Manager::saveSources()
+{
+  QVariantList list;
+  for (const auto &source : m_sources)
+  {
+    QVariantMap map;
+    map.insert("type", source->type());
+    map.insert("address", source->address());
+    map.insert("setting", source->setting());
+    list.append(map);
+  }
+
+  m_settings.setValue("io_sources", list);
+}
+
+/**
+ * @brief Opens all the additional data sources in their threads.
+ */
+void IO::Manager::openSources()
+{
+  const auto start = m_startSequence;
+  const auto finish = m_finishSequence;
+  for (const auto &source : m_sources)
+  {
+    auto *ptr = source.get();
+    QMetaObject::invokeMethod(
+        ptr, [=] { ptr->open(start, finish); }, Qt::QueuedConnection);
+  }
+
+  m_latestFrames.clear();
+  m_mergedLayout.clear();
+}
+
+/**
+ * @brief Applies the buffer capacity & overflow policy to the frame readers
+ *        of the main device & of the additional sources.
+ *
+ * The settings are handed to the thread of each reader, resizing a buffer
+ * discards the data that it holds.
+ */
+void IO::Manager::configureFrameReaders()
+{
+  const auto policy = m_overflowPolicy;
+  if (driver() && m_workerThread.isRunning())
+  {
+    const auto capacity = bufferCapacity(driver()->dataRate());
+    QMetaObject::invokeMethod(
+        &m_frameReader,
+        [=] {
+          m_frameReader.setBufferCapacity(capacity);
+          m_frameReader.setOverflowPolicy(policy);
         },
         Qt::QueuedConnection);
   }
+
+  for (const auto &source : m_sources)
+  {
+    auto *ptr = source.get();
+    const auto capacity = bufferCapacity(ptr->dataRate());
+    QMetaObject::invokeMethod(
+        ptr, [=] { ptr->configureBuffer(capacity, policy); },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Closes all the additional data sources.
+ */
+void IO::Manager::closeSources()
+{
+  for (const auto &source : m_sources)
+    QMetaObject::invokeMethod(source.get(), &IO::Source::close,
+                              Qt::QueuedConnection);
+
+  m_latestFrames.clear();
+  m_mergedLayout.clear();
+}
+
+/**
+ * @brief Tags the given @a frames with their source & feeds the dashboard.
+ *
+ * Every frame is published through @c sourceFrameReceived(). In quick plot
+ * mode, the latest frame of each source is appended into a single merged
+ * frame, so that the channels of all devices are shown in one dashboard.
+ * In the other modes, the frames of all sources are interleaved & parsed by
+ * the project, JSON or frame parser code.
+ *
+ * The resulting frames are emitted as a single batch.
+ *
+ * @param index Source index, 0 is the main device.
+ * @param frames Frames extracted by the source, each merged frame inherits
+ *               the arrival time of the frame that triggered it.
+ */
+void IO::Manager::mergeFrames(const int index, const FrameBatch &frames)
+{
+  // Let other modules know where the frames come from
+  for (const auto &frame : frames)
+    Q_EMIT sourceFrameReceived(index, frame.data);
+
+  // Frames are not merged outside of quick plot mode, but keep their source
+  const auto mode = JSON::FrameBuilder::instance().operationMode();
+  if (mode != SerialStudio::QuickPlot)
+  {
+    if (index == 0)
+      Q_EMIT framesReceived(frames);
+
+    else
+    {
+      auto tagged = frames;
+      for (auto &frame : tagged)
+        frame.source = index;
+
+      Q_EMIT framesReceived(tagged);
+    }
+
+    return;
+  }
+
+  // Register the latest frame of the source
+  const auto count = static_cast<int>(m_sources.size()) + 1;
+  if (m_latestFrames.count() != count)
+    m_latestFrames.resize(count);
+
+  FrameBatch batch;
+  batch.reserve(frames.count());
+  for (const auto &frame : frames)
+  {
+    m_latestFrames[index] = frame.data;
+
+    // Build the merged frame & the layout of its channels
+    QByteArray merged;
+    m_mergedLayout.clear();
+    for (int i = 0; i < count; ++i)
+    {
+      const auto &latest = m_latestFrames.at(i);
+      if (latest.isEmpty())
+        continue;
+
+      if (!merged.isEmpty())
+        merged.append(',');
+
+      merged.append(latest);
+      const auto name = i == 0 ? tr("Device") : m_sources[i - 1]->name();
+      m_mergedLayout.append({name, static_cast<int>(latest.count(',')) + 1});
+    }
+
+    batch.append({merged, frame.timestamp});
+  }
+
+  Q_EMIT framesReceived(batch);
 }
 
 /**
@@ -452,6 +1333,39 @@ void IO::Manager::setFinishSequence(const QString &sequence)
   Q_EMIT finishSequenceChanged();
 }
 
+/**
+ * @brief Selects the frame reader buffer size, as an index of the list
+ *        returned by @c bufferSizes().
+ *
+ * The new size is applied right away, discarding the data that is waiting to
+ * be parsed.
+ */
+void IO::Manager::setBufferSize(const int index)
+{
+  const auto max = static_cast<int>(kBufferSizes.size()) - 1;
+  m_bufferSize = qBound(0, index, max);
+  if (connected())
+    configureFrameReaders();
+
+  Q_EMIT maxBufferSizeChanged();
+}
+
+/**
+ * @brief Changes what the frame readers do with data that does not fit in
+ *        their buffers, as an index of the list returned by
+ *        @c overflowPolicies().
+ */
+void IO::Manager::setOverflowPolicy(const int policy)
+{
+  m_overflowPolicy = static_cast<SerialStudio::BufferOverflowPolicy>(
+      qBound<int>(SerialStudio::OverflowDropOldest, policy,
+                  SerialStudio::OverflowBackpressure));
+  if (connected())
+    configureFrameReaders();
+
+  Q_EMIT overflowPolicyChanged();
+}
+
 /**
  * @brief Sets the bus type and updates the associated driver.
  *
@@ -464,6 +1378,13 @@ void IO::Manager::setFinishSequence(const QString &sequence)
  * - `SerialStudio::BusType::Serial`: Serial communication.
  * - `SerialStudio::BusType::Network`: Network-based communication.
  * - `SerialStudio::BusType::BluetoothLE`: Bluetooth Low Energy communication.
+ * - `SerialStudio::BusType::Replay`: Replay of a raw capture file.
+ * - `SerialStudio::BusType::Generator`: Synthetic signal generator.
+ * - `SerialStudio::BusType::CanBus`: CAN bus interface.
+ * - `SerialStudio::BusType::Modbus`: Modbus RTU/TCP server.
+ * - `SerialStudio::BusType::RawUsb`: Bulk endpoints of a USB device.
+ * - `SerialStudio::BusType::AudioInput`: Audio capture device.
+ * - `SerialStudio::BusType::Pipe`: Standard input, named pipe or local socket.
  *
  * @param driver The new bus type as a `SerialStudio::BusType` enum.
  */
@@ -497,6 +1418,34 @@ void IO::Manager::setBusType(const SerialStudio::BusType &driver)
     }
   }
 
+  // Replay a raw capture file
+  else if (busType() == SerialStudio::BusType::Replay)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::Replay::instance())));
+
+  // Generate synthetic frames
+  else if (busType() == SerialStudio::BusType::Generator)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::Generator::instance())));
+
+  // Read frames from a CAN bus interface
+  else if (busType() == SerialStudio::BusType::CanBus)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::CANBus::instance())));
+
+  // Poll the registers of a Modbus server
+  else if (busType() == SerialStudio::BusType::Modbus)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::Modbus::instance())));
+
+  // Stream data from the bulk endpoints of a USB device
+  else if (busType() == SerialStudio::BusType::RawUsb)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::USB::instance())));
+
+  // Capture samples from an audio input
+  else if (busType() == SerialStudio::BusType::AudioInput)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::Audio::instance())));
+
+  // Read the output of another process
+  else if (busType() == SerialStudio::BusType::Pipe)
+    setDriver(static_cast<HAL_Driver *>(&(Drivers::Pipe::instance())));
+
   // Invalid driver
   else
     setDriver(nullptr);
@@ -22,12 +22,25 @@
 
 #pragma once
 
+#include <atomic>
+
+#include <memory>
+#include <vector>
+
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
 #include <QThread>
 #include <QObject>
+#include <QSettings>
+#include <QElapsedTimer>
 
 #include "SerialStudio.h"
+#include "IO/Source.h"
 #include "IO/HAL_Driver.h"
 #include "IO/FrameReader.h"
+#include "IO/ActionScheduler.h"
+#include "Misc/SpscQueue.h"
 
 namespace IO
 {
@@ -40,6 +53,24 @@ namespace IO
  *
  * Integrates with `FrameReader` for parsing data streams and ensures
  * thread-safe operation using a dedicated worker thread.
+ *
+ * The buffer of each frame reader is sized from the data rate of its device
+ * (e.g. the baud rate of a serial port), unless the user selects a fixed
+ * buffer size, and the user-selected overflow policy is applied to all of
+ * them.
+ *
+ * Queued writes are handed to the driver with @c HAL_Driver::beginWrite() and
+ * stay accounted in @c txQueueBytes() until the driver reports that they were
+ * written. Only a fixed budget of bytes is in flight at once, so drivers that
+ * buffer writes (e.g. the serial port) never hold more than that amount of
+ * unwritten data.
+ *
+ * Besides the queued write path, @c writeCommand() offers a priority lane for
+ * latency-sensitive producers running in other threads (e.g. closed-loop
+ * plugins): commands skip the transmission queue, and are handed straight to
+ * the thread of the driver when it supports thread-safe writes. Periodic
+ * writes (e.g. polling actions) are timed by an @c IO::ActionScheduler that
+ * runs in a thread of its own, and use the same priority lane.
  */
 class Manager : public QObject
 {
@@ -72,6 +103,32 @@ class Manager : public QObject
   Q_PROPERTY(QStringList availableBuses
              READ availableBuses
              NOTIFY busListChanged)
+  Q_PROPERTY(QStringList sources
+             READ sources
+             NOTIFY sourcesChanged)
+  Q_PROPERTY(QStringList sourceTypes
+             READ sourceTypes
+             NOTIFY busListChanged)
+  Q_PROPERTY(qint64 txQueueBytes
+             READ txQueueBytes
+             NOTIFY txStatisticsChanged)
+  Q_PROPERTY(double txLatency
+             READ txLatency
+             NOTIFY txStatisticsChanged)
+  Q_PROPERTY(int bufferSize
+             READ bufferSize
+             WRITE setBufferSize
+             NOTIFY maxBufferSizeChanged)
+  Q_PROPERTY(QStringList bufferSizes
+             READ bufferSizes
+             NOTIFY busListChanged)
+  Q_PROPERTY(int overflowPolicy
+             READ overflowPolicy
+             WRITE setOverflowPolicy
+             NOTIFY overflowPolicyChanged)
+  Q_PROPERTY(QStringList overflowPolicies
+             READ overflowPolicies
+             NOTIFY busListChanged)
   // clang-format on
 
 signals:
@@ -84,9 +141,15 @@ signals:
   void maxBufferSizeChanged();
   void startSequenceChanged();
   void finishSequenceChanged();
+  void overflowPolicyChanged();
   void dataSent(const QByteArray &data);
   void dataReceived(const QByteArray &data);
-  void frameReceived(const QByteArray &frame);
+  void framesReceived(const IO::FrameBatch &frames);
+  void sourcesChanged();
+  void txStatisticsChanged();
+  void writeCompleted(const quint64 id, const qint64 bytes);
+  void commandCompleted(const quint64 ticket, const qint64 bytes);
+  void sourceFrameReceived(const int source, const QByteArray &frame);
 
 private:
   explicit Manager();
@@ -111,6 +174,39 @@ public:
 
   [[nodiscard]] QStringList availableBuses() const;
   Q_INVOKABLE qint64 writeData(const QByteArray &data);
+  quint64 queueWrite(const QByteArray &data);
+  quint64 writeCommand(const QByteArray &data);
+
+  void stopPeriodicWrites();
+  void stopPeriodicWrite(const int id);
+  void startPeriodicWrite(const int id, const QByteArray &data,
+                          const int interval);
+
+  [[nodiscard]] double txLatency() const;
+  [[nodiscard]] qint64 txQueueBytes() const;
+
+  [[nodiscard]] int bufferSize() const;
+  [[nodiscard]] int overflowPolicy() const;
+  [[nodiscard]] QStringList bufferSizes() const;
+  [[nodiscard]] QStringList overflowPolicies() const;
+  [[nodiscard]] qsizetype bufferCapacity(const qint64 dataRate) const;
+
+  [[nodiscard]] QStringList sources() const;
+  [[nodiscard]] QStringList sourceTypes() const;
+
+  /**
+   * @brief Number of channels contributed by each source to the merged
+   *        quick plot frame, in the order of the merged fields.
+   */
+  struct SourceLayout
+  {
+    QString name;
+    int channels;
+  };
+
+  [[nodiscard]] const QVector<SourceLayout> &mergedLayout() const;
+
+  bool enqueuePayload(const QByteArray &payload);
 
 public slots:
   void connectDevice();
@@ -119,16 +215,39 @@ public slots:
   void setupExternalConnections();
   void setWriteEnabled(const bool enabled);
   void processPayload(const QByteArray &payload);
+  void processPayloads(const QList<QByteArray> &payloads);
   void setStartSequence(const QString &sequence);
   void setFinishSequence(const QString &sequence);
+  void setBufferSize(const int index);
+  void setOverflowPolicy(const int policy);
   void setBusType(const SerialStudio::BusType &driver);
+  void removeSource(const int index);
+  void addSource(const int type, const QString &address, const int setting);
 
 private slots:
+  void drainPayloads();
+  void processTxQueue();
   void setDriver(HAL_Driver *driver);
+  void onWriteFinished(const quint64 ticket, const qint64 bytes);
+  void onFramesReady(const IO::FrameBatch &frames);
+  void onDriverFrames(const IO::FrameBatch &frames);
+  void onSourceError(const QString &error);
+  void onSourceFrames(const IO::FrameBatch &frames);
+
+private:
+  void clearTxQueue();
+  void scheduleTxQueue();
+  void saveSources();
+  void openSources();
+  void configureFrameReaders();
+  void closeSources();
+  void mergeFrames(const int index, const FrameBatch &frames);
 
 private:
   bool m_writeEnabled;
+  int m_bufferSize;
   SerialStudio::BusType m_busType;
+  SerialStudio::BufferOverflowPolicy m_overflowPolicy;
 
   HAL_Driver *m_driver;
   QThread m_workerThread;
@@ -136,5 +255,42 @@ private:
 
   QString m_startSequence;
   QString m_finishSequence;
+
+  std::atomic_bool m_payloadDrainPending;
+  Misc::SpscQueue<QByteArray> m_payloadQueue;
+
+  struct TxRequest
+  {
+    quint64 id;
+    QByteArray data;
+    qint64 timestamp;
+  };
+
+  struct TxWrite
+  {
+    QByteArray data;
+    QList<TxRequest> requests;
+  };
+
+  bool m_txScheduled;
+  double m_txLatency;
+  qint64 m_txQueueBytes;
+  quint64 m_txRequestId;
+  qint64 m_txInFlightBytes;
+  QElapsedTimer m_txClock;
+  QQueue<TxRequest> m_txQueue;
+  QHash<quint64, TxWrite> m_txInFlight;
+  std::atomic<quint64> m_writeTicket;
+
+  QMutex m_commandLock;
+  HAL_Driver *m_commandDriver;
+
+  QThread m_actionThread;
+  ActionScheduler m_actionScheduler;
+
+  QSettings m_settings;
+  QVector<QByteArray> m_latestFrames;
+  QVector<SourceLayout> m_mergedLayout;
+  std::vector<std::unique_ptr<Source>> m_sources;
 };
 } // namespace IO
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include <QDebug>
+
+#include "IO/Manager.h"
+#include "IO/Checksum.h"
+#include "IO/ModemSender.h"
+
+// Protocol control characters
+static constexpr char kSOH = 0x01;
+static constexpr char kSTX = 0x02;
+static constexpr char kEOT = 0x04;
+static constexpr char kACK = 0x06;
+static constexpr char kNAK = 0x15;
+static constexpr char kCAN = 0x18;
+static constexpr char kCRC = 'C';
+static constexpr char kPadding = 0x1A;
+
+// Block sizes
+static constexpr qint64 kBlockSize = 1024;
+static constexpr qint64 kShortBlockSize = 128;
+
+// Time to wait for a response from the receiver & maximum number of retries
+static constexpr int kTimeout = 10000;
+static constexpr int kMaxRetries = 10;
+
+// Maximum number of blocks sent before waiting for acknowledgements
+static constexpr int kMaxWindow = 16;
+
+/**
+ * Constructor function
+ */
+IO::ModemSender::ModemSender(QObject *parent)
+  : QObject(parent)
+  , m_state(State::Idle)
+  , m_protocol(Protocol::XModem1K)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_window(1)
+  , m_retries(0)
+  , m_cancelCount(0)
+  , m_nextBlock(0)
+  , m_firstUnacked(0)
+{
+  m_timeout.setSingleShot(true);
+  m_timeout.setInterval(kTimeout);
+  connect(&m_timeout, &QTimer::timeout, this, &IO::ModemSender::onTimeout);
+}
+
+/**
+ * Returns @c true while a transfer is in progress.
+ */
+bool IO::ModemSender::active() const
+{
+  return m_state != State::Idle;
+}
+
+/**
+ * Aborts the current transfer, notifying the receiver with @c CAN characters.
+ */
+void IO::ModemSender::cancel()
+{
+  if (!active())
+    return;
+
+  IO::Manager::instance().writeData(QByteArray(5, kCAN));
+  finish(false, tr("Transfer cancelled"));
+}
+
+/**
+ * Processes the responses of the receiver, each byte is handled according to
+ * the current state of the transfer.
+ */
+void IO::ModemSender::processData(const QByteArray &data)
+{
+  for (const char byte : data)
+  {
+    if (!active())
+      return;
+
+    // Two consecutive CAN characters abort the transfer
+    if (byte == kCAN)
+    {
+      if (++m_cancelCount >= 2)
+      {
+        finish(false, tr("Transfer cancelled by the receiver"));
+        return;
+      }
+
+      continue;
+    }
+
+    // Only react to protocol characters
+    m_cancelCount = 0;
+    if (byte != kACK && byte != kNAK && byte != kCRC)
+      continue;
+
+    // The receiver is alive
+    m_retries = 0;
+    m_timeout.start();
+
+    switch (m_state)
+    {
+      case State::WaitingForStart:
+        if (byte == kCRC)
+        {
+          if (m_protocol == Protocol::YModem)
+            sendHeader(false);
+
+          else
+          {
+            m_state = State::SendingData;
+            sendBlocks();
+          }
+        }
+        break;
+
+      case State::WaitingForHeaderAck:
+        if (byte == kACK)
+          m_state = State::WaitingForDataStart;
+        else if (byte == kNAK)
+          sendHeader(false);
+        break;
+
+      case State::WaitingForDataStart:
+        if (byte == kCRC)
+        {
+          m_state = State::SendingData;
+          sendBlocks();
+        }
+        break;
+
+      case State::SendingData:
+        if (byte == kACK && m_firstUnacked < m_nextBlock)
+        {
+          ++m_firstUnacked;
+          Q_EMIT progressChanged(qMin(m_size, m_firstUnacked * kBlockSize));
+          sendBlocks();
+        }
+
+        else if (byte == kNAK)
+        {
+          m_nextBlock = m_firstUnacked;
+          sendBlocks();
+        }
+        break;
+
+      case State::WaitingForEotAck:
+        if (byte == kACK)
+        {
+          if (m_protocol == Protocol::YModem)
+            m_state = State::WaitingForEndStart;
+          else
+            finish(true);
+        }
+
+        else if (byte == kNAK)
+          sendEot();
+        break;
+
+      case State::WaitingForEndStart:
+        if (byte == kCRC)
+          sendHeader(true);
+        break;
+
+      case State::WaitingForEndAck:
+        if (byte == kACK)
+          finish(true);
+        else if (byte == kNAK)
+          sendHeader(true);
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+/**
+ * Starts sending @a size bytes of @a data with the given @a protocol.
+ *
+ * The data must remain valid until the @c finished() signal is emitted. The
+ * @a fileName is only used by the YMODEM header block, and @a window sets
+ * the number of blocks that may be sent before waiting for acknowledgements.
+ */
+void IO::ModemSender::start(const Protocol protocol, const uchar *data,
+                            const qint64 size, const QString &fileName,
+                            const int window)
+{
+  // Abort ongoing transfers
+  if (active())
+    cancel();
+
+  // Initialize the transfer state
+  m_data = data;
+  m_size = qMax<qint64>(0, size);
+  m_protocol = protocol;
+  m_fileName = fileName;
+  m_window = qBound(1, window, kMaxWindow);
+  m_retries = 0;
+  m_cancelCount = 0;
+  m_nextBlock = 0;
+  m_firstUnacked = 0;
+
+  // Wait for the receiver to request the first block
+  m_state = State::WaitingForStart;
+  m_timeout.start();
+  Q_EMIT progressChanged(0);
+}
+
+/**
+ * Resends the pending packets when the receiver does not respond in time,
+ * and aborts the transfer after too many retries.
+ */
+void IO::ModemSender::onTimeout()
+{
+  if (!active())
+    return;
+
+  // Give up
+  if (++m_retries > kMaxRetries)
+  {
+    IO::Manager::instance().writeData(QByteArray(5, kCAN));
+    finish(false, tr("Receiver timed out"));
+    return;
+  }
+
+  // Resend the pending packets
+  switch (m_state)
+  {
+    case State::WaitingForHeaderAck:
+      sendHeader(false);
+      break;
+    case State::SendingData:
+      m_nextBlock = m_firstUnacked;
+      sendBlocks();
+      break;
+    case State::WaitingForEotAck:
+      sendEot();
+      break;
+    case State::WaitingForEndAck:
+      sendHeader(true);
+      break;
+    default:
+      break;
+  }
+
+  m_timeout.start();
+}
+
+/**
+ * Sends the end of transmission character.
+ */
+void IO::ModemSender::sendEot()
+{
+  m_state = State::WaitingForEotAck;
+  IO::Manager::instance().writeData(QByteArray(1, kEOT));
+}
+
+/**
+ * Sends data blocks until the window is full, or the end of transmission
+ * once every block has been acknowledged.
+ */
+void IO::ModemSender::sendBlocks()
+{
+  const auto count = blockCount();
+  if (m_firstUnacked >= count)
+  {
+    sendEot();
+    return;
+  }
+
+  while (m_nextBlock < count && m_nextBlock - m_firstUnacked < m_window)
+    sendBlock(m_nextBlock++);
+}
+
+/**
+ * Sends the YMODEM header block, which contains the file name & size, or an
+ * empty header block when @a last is @c true to terminate the batch.
+ */
+void IO::ModemSender::sendHeader(const bool last)
+{
+  QByteArray header;
+  if (!last)
+  {
+    header = m_fileName.toUtf8();
+    header.append('\0');
+    header.append(QByteArray::number(m_size));
+    header.append('\0');
+  }
+
+  // Use a 1K block if the file name is too long for a short block
+  const auto blockSize = header.size() > kShortBlockSize ? kBlockSize
+                                                         : kShortBlockSize;
+  header = header.left(blockSize);
+  header.append(QByteArray(blockSize - header.size(), '\0'));
+
+  m_state = last ? State::WaitingForEndAck : State::WaitingForHeaderAck;
+  writePacket(blockSize == kBlockSize ? kSTX : kSOH, 0, header.constData(),
+              header.size(), blockSize);
+}
+
+/**
+ * Sends the data block with the given zero-based @a index, the block number
+ * sent to the receiver starts at 1 and wraps around at 255.
+ */
+void IO::ModemSender::sendBlock(const qint64 index)
+{
+  const auto offset = index * kBlockSize;
+  const auto length = qMin(kBlockSize, m_size - offset);
+  const auto blockSize = length <= kShortBlockSize ? kShortBlockSize
+                                                   : kBlockSize;
+  const auto *payload = reinterpret_cast<const char *>(m_data + offset);
+  writePacket(blockSize == kBlockSize ? kSTX : kSOH,
+              static_cast<quint8>((index + 1) & 0xFF), payload, length,
+              blockSize);
+}
+
+/**
+ * Stops the transfer & notifies the result.
+ */
+void IO::ModemSender::finish(const bool success, const QString &error)
+{
+  if (!error.isEmpty())
+    qWarning() << "File transfer error:" << error;
+
+  m_timeout.stop();
+  m_state = State::Idle;
+  m_data = nullptr;
+  Q_EMIT finished(success);
+}
+
+/**
+ * Builds a packet with the given @a type, block @a number & @a payload (padded
+ * up to @a blockSize bytes), appends its CRC & writes it to the device.
+ */
+void IO::ModemSender::writePacket(const char type, const quint8 number,
+                                  const char *payload, const qint64 length,
+                                  const qint64 blockSize)
+{
+  // Build the packet in a reusable buffer
+  m_packet.resize(3 + blockSize + 2);
+  auto *packet = m_packet.data();
+  packet[0] = type;
+  packet[1] = static_cast<char>(number);
+  packet[2] = static_cast<char>(0xFF - number);
+  std::memcpy(packet + 3, payload, length);
+  std::memset(packet + 3 + length, kPadding, blockSize - length);
+
+  // Append the CRC in big-endian byte order
+  const auto crc = IO::crc16Xmodem(packet + 3, static_cast<int>(blockSize));
+  packet[3 + blockSize] = static_cast<char>(crc >> 8);
+  packet[4 + blockSize] = static_cast<char>(crc & 0xFF);
+
+  // Queue the packet, abort if the device does not accept it
+  if (IO::Manager::instance().writeData(m_packet) < 0)
+    finish(false, tr("Cannot write to the device"));
+}
+
+/**
+ * Returns the number of data blocks required to send the buffer.
+ */
+qint64 IO::ModemSender::blockCount() const
+{
+  return (m_size + kBlockSize - 1) / kBlockSize;
+}
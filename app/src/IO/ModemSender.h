@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+
+namespace IO
+{
+/**
+ * @class IO::ModemSender
+ * @brief Sends a memory buffer with the XMODEM-1K or YMODEM protocols.
+ *
+ * The sender waits for the receiver to request a CRC transfer (@c 'C'), and
+ * writes 1024-byte blocks (128-byte blocks for a short final block) through
+ * the @c IO::Manager transmission queue. Every block carries a CRC-16/XMODEM
+ * computed with the @c IO::Checksum engine. In YMODEM mode, the data blocks
+ * are preceded by a header block with the file name & size, and the batch is
+ * terminated with an empty header block.
+ *
+ * Blocks are pipelined: up to @c window blocks are sent before waiting for
+ * their acknowledgements, which are matched in order. A @c NAK or a timeout
+ * resends every unacknowledged block (go-back-N). A window of one block is
+ * the classic stop-and-wait behavior that every receiver supports, larger
+ * windows require receivers that buffer incoming blocks.
+ */
+class ModemSender : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void finished(const bool success);
+  void progressChanged(const qint64 bytes);
+
+public:
+  explicit ModemSender(QObject *parent = nullptr);
+
+  enum class Protocol
+  {
+    XModem1K,
+    YModem
+  };
+
+  [[nodiscard]] bool active() const;
+
+public slots:
+  void cancel();
+  void processData(const QByteArray &data);
+  void start(const Protocol protocol, const uchar *data, const qint64 size,
+             const QString &fileName, const int window);
+
+private slots:
+  void onTimeout();
+
+private:
+  enum class State
+  {
+    Idle,
+    WaitingForStart,
+    WaitingForHeaderAck,
+    WaitingForDataStart,
+    SendingData,
+    WaitingForEotAck,
+    WaitingForEndStart,
+    WaitingForEndAck
+  };
+
+  void sendEot();
+  void sendBlocks();
+  void sendHeader(const bool last);
+  void sendBlock(const qint64 index);
+  void finish(const bool success, const QString &error = QString());
+  void writePacket(const char type, const quint8 number, const char *payload,
+                   const qint64 length, const qint64 blockSize);
+
+  [[nodiscard]] qint64 blockCount() const;
+
+private:
+  State m_state;
+  Protocol m_protocol;
+
+  const uchar *m_data;
+  qint64 m_size;
+  QString m_fileName;
+
+  int m_window;
+  int m_retries;
+  int m_cancelCount;
+  qint64 m_nextBlock;
+  qint64 m_firstUnacked;
+
+  QTimer m_timeout;
+  QByteArray m_packet;
+};
+} // namespace IO
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "RawCapture.h"
+
+#include <cstring>
+
+#include <QDir>
+#include <QDateTime>
+#include <QtEndian>
+#include <QApplication>
+#include <QStandardPaths>
+
+#include "IO/Manager.h"
+#include "Misc/Utilities.h"
+#include "Misc/TimerEvents.h"
+
+/**
+ * Version of the raw capture file format
+ */
+static constexpr quint32 kFormatVersion = 1;
+
+/**
+ * Size of the file header (magic & format version)
+ */
+static constexpr qsizetype kHeaderSize = 8 + sizeof(quint32);
+
+/**
+ * Size of the header of each chunk record (timestamp & size)
+ */
+static constexpr qsizetype kRecordSize = sizeof(qint64) + sizeof(quint32);
+
+/**
+ * Maximum amount of data buffered between two writes
+ */
+static constexpr qsizetype kMaxBufferSize = 64 * 1024 * 1024;
+
+/**
+ * Constructor function
+ */
+IO::RawCapture::RawCapture()
+  : m_captureEnabled(false)
+  , m_firstTimestamp(-1)
+{
+  m_path = QStringLiteral("%1/%2/Raw Captures")
+               .arg(QStandardPaths::writableLocation(
+                        QStandardPaths::DocumentsLocation),
+                    qApp->applicationDisplayName());
+}
+
+/**
+ * Close file & finnish write-operations before destroying the class
+ */
+IO::RawCapture::~RawCapture()
+{
+  closeFile();
+}
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+IO::RawCapture &IO::RawCapture::instance()
+{
+  static RawCapture singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if the raw capture file is open
+ */
+bool IO::RawCapture::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * Returns @c true if raw data capture is enabled
+ */
+bool IO::RawCapture::captureEnabled() const
+{
+  return m_captureEnabled;
+}
+
+/**
+ * Returns the header of a raw capture file (magic & format version).
+ */
+QByteArray IO::RawCapture::fileHeader()
+{
+  QByteArray header("SSRAWCAP", 8);
+  header.resize(kHeaderSize);
+  qToLittleEndian(kFormatVersion, header.data() + 8);
+  return header;
+}
+
+/**
+ * Appends a chunk record with the given @a timestamp (in nanoseconds, relative
+ * to the first chunk of the capture) and @a size bytes of @a data to the given
+ * @a buffer.
+ */
+void IO::RawCapture::appendChunk(QByteArray &buffer, const qint64 timestamp,
+                                 const char *data, const qsizetype size)
+{
+  const auto pos = buffer.size();
+  buffer.resize(pos + kRecordSize);
+  qToLittleEndian(timestamp, buffer.data() + pos);
+  qToLittleEndian(static_cast<quint32>(size),
+                  buffer.data() + pos + sizeof(qint64));
+  buffer.append(data, size);
+}
+
+/**
+ * @brief Reads the chunk table of a raw capture file.
+ *
+ * Validates the header of the raw capture stored in the given @a data buffer,
+ * and appends the timestamp, offset & size of each chunk to @a chunks. A
+ * truncated last record (e.g. if the application was terminated while
+ * capturing) is ignored.
+ *
+ * @return @c true if @a data contains a valid raw capture, @c false otherwise.
+ */
+bool IO::RawCapture::readChunks(const uchar *data, const qint64 size,
+                                QVector<Chunk> &chunks)
+{
+  // Validate header
+  if (!data || size < kHeaderSize || memcmp(data, "SSRAWCAP", 8) != 0)
+    return false;
+
+  if (qFromLittleEndian<quint32>(data + 8) > kFormatVersion)
+    return false;
+
+  // Read chunk records
+  qint64 pos = kHeaderSize;
+  while (pos + kRecordSize <= size)
+  {
+    Chunk chunk;
+    chunk.timestamp = qFromLittleEndian<qint64>(data + pos);
+    chunk.size = qFromLittleEndian<quint32>(data + pos + sizeof(qint64));
+    chunk.offset = pos + kRecordSize;
+    if (chunk.offset + chunk.size > size)
+      break;
+
+    chunks.append(chunk);
+    pos = chunk.offset + chunk.size;
+  }
+
+  return true;
+}
+
+/**
+ * Write all buffered data & close the raw capture file
+ */
+void IO::RawCapture::closeFile()
+{
+  // Stop receiving data from the driver
+  if (m_driver)
+    disconnect(m_driver, &HAL_Driver::dataReceived, this,
+               &RawCapture::registerData);
+
+  m_driver = nullptr;
+
+  // Write remaining data & close the file
+  if (isOpen())
+  {
+    writeData();
+    m_file.close();
+    Q_EMIT openChanged();
+  }
+
+  // Discard chunks registered while the driver was being disconnected
+  QMutexLocker locker(&m_mutex);
+  m_buffer.clear();
+}
+
+/**
+ * Open the current raw capture file in the Explorer/Finder window
+ */
+void IO::RawCapture::openCurrentFile()
+{
+  if (isOpen())
+    Misc::Utilities::revealFile(m_file.fileName());
+  else
+    Misc::Utilities::showMessageBox(tr("Raw capture file not open"),
+                                    tr("Cannot find raw capture file!"));
+}
+
+/**
+ * Configures the signal/slot connections with the rest of the modules of the
+ * application.
+ */
+void IO::RawCapture::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &RawCapture::onConnectedChanged);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &RawCapture::writeData);
+}
+
+/**
+ * Enables or disables raw data capture
+ */
+void IO::RawCapture::setCaptureEnabled(const bool enabled)
+{
+  m_captureEnabled = enabled;
+  Q_EMIT enabledChanged();
+
+  if (captureEnabled())
+    onConnectedChanged();
+  else
+    closeFile();
+}
+
+/**
+ * Writes the buffered chunks to the raw capture file
+ */
+void IO::RawCapture::writeData()
+{
+  // Take the buffered chunks
+  QByteArray data;
+  {
+    QMutexLocker locker(&m_mutex);
+    data.swap(m_buffer);
+  }
+
+  // Write them to the file
+  if (isOpen() && !data.isEmpty())
+  {
+    m_file.write(data);
+    m_file.flush();
+  }
+}
+
+/**
+ * @brief Starts or stops capturing data when the device is (dis)connected.
+ *
+ * The capture is attached directly to the @c HAL_Driver::dataReceived() signal,
+ * so that every chunk is timestamped as soon as the driver reports it. Data
+ * replayed from a raw capture file is not captured again.
+ */
+void IO::RawCapture::onConnectedChanged()
+{
+  // Close the previous capture
+  closeFile();
+
+  // Capture disabled, or replaying a capture file
+  auto &manager = IO::Manager::instance();
+  if (!captureEnabled() || !manager.connected())
+    return;
+
+  if (manager.busType() == SerialStudio::BusType::Replay)
+    return;
+
+  // Create the capture file
+  if (!createFile())
+    return;
+
+  // Receive data from the driver, in the thread that emits it
+  m_driver = manager.driver();
+  connect(m_driver, &HAL_Driver::dataReceived, this,
+          &RawCapture::registerData, Qt::DirectConnection);
+}
+
+/**
+ * @brief Timestamps the given @a data chunk & appends it to the write buffer.
+ *
+ * This function may be called from the reader thread of the driver, so it
+ * only touches the write buffer. If the file is not written fast enough (e.g.
+ * the user interface is blocked), chunks that exceed the maximum buffer size
+ * are dropped instead of growing the buffer without bounds.
+ */
+void IO::RawCapture::registerData(const QByteArray &data)
+{
+  const auto timestamp = m_clock.nsecsElapsed();
+
+  QMutexLocker locker(&m_mutex);
+  if (m_buffer.size() >= kMaxBufferSize)
+    return;
+
+  if (m_firstTimestamp < 0)
+    m_firstTimestamp = timestamp;
+
+  appendChunk(m_buffer, timestamp - m_firstTimestamp, data.constData(),
+              data.size());
+}
+
+/**
+ * @brief Creates a new raw capture file & writes its header.
+ *
+ * The monotonic clock used to timestamp the chunks is restarted, and the
+ * first chunk that is received defines the origin of the timestamps.
+ *
+ * @return @c true if the file was created, @c false otherwise.
+ */
+bool IO::RawCapture::createFile()
+{
+  // Get file name
+  const auto fileName = QDateTime::currentDateTime().toString(
+                            QStringLiteral("yyyy_MMM_dd HH_mm_ss"))
+                        + ".ssraw";
+
+  // Generate file path if required
+  QDir dir(m_path);
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  // Open file
+  m_file.setFileName(dir.filePath(fileName));
+  if (!m_file.open(QIODevice::WriteOnly))
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Raw Capture Error"),
+        tr("Cannot open raw capture file for writing!"));
+    return false;
+  }
+
+  // Write the header & restart the clock
+  m_file.write(fileHeader());
+  m_firstTimestamp = -1;
+  m_clock.start();
+  Q_EMIT openChanged();
+  return true;
+}
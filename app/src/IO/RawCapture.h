@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+#include <QObject>
+#include <QPointer>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+#include "IO/HAL_Driver.h"
+
+namespace IO
+{
+/**
+ * @brief The RawCapture class
+ *
+ * The raw capture class records the byte chunks reported by the active
+ * @c HAL_Driver, exactly as they are handed to the @c FrameReader, together
+ * with their monotonic reception time. Raw capture files can be replayed with
+ * the @c IO::Drivers::Replay driver, which reproduces the chunking & timing of
+ * the original session.
+ *
+ * A raw capture file (@c .ssraw) starts with the @c "SSRAWCAP" magic and a
+ * @c quint32 format version, followed by one record per data chunk: a
+ * @c qint64 monotonic timestamp in nanoseconds (relative to the first chunk),
+ * the @c quint32 size of the chunk and its bytes. All integers are stored in
+ * little-endian byte order.
+ *
+ * Chunks are timestamped & buffered in memory directly from the thread that
+ * emits them (drivers may report data from a dedicated reader thread), and
+ * written each time the @c Misc::TimerEvents low-frequency timer expires (e.g.
+ * every 1 second).
+ */
+class RawCapture : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool isOpen
+             READ isOpen
+             NOTIFY openChanged)
+  Q_PROPERTY(bool captureEnabled
+             READ captureEnabled
+             WRITE setCaptureEnabled
+             NOTIFY enabledChanged)
+  // clang-format on
+
+signals:
+  void openChanged();
+  void enabledChanged();
+
+private:
+  explicit RawCapture();
+  RawCapture(RawCapture &&) = delete;
+  RawCapture(const RawCapture &) = delete;
+  RawCapture &operator=(RawCapture &&) = delete;
+  RawCapture &operator=(const RawCapture &) = delete;
+
+  ~RawCapture();
+
+public:
+  static RawCapture &instance();
+
+  /**
+   * @brief Timestamp, file offset & size of a chunk of a raw capture file.
+   */
+  struct Chunk
+  {
+    qint64 timestamp;
+    qint64 offset;
+    qint64 size;
+  };
+
+  [[nodiscard]] bool isOpen() const;
+  [[nodiscard]] bool captureEnabled() const;
+
+  [[nodiscard]] static QByteArray fileHeader();
+  static void appendChunk(QByteArray &buffer, const qint64 timestamp,
+                          const char *data, const qsizetype size);
+  [[nodiscard]] static bool readChunks(const uchar *data, const qint64 size,
+                                       QVector<Chunk> &chunks);
+
+public slots:
+  void closeFile();
+  void openCurrentFile();
+  void setupExternalConnections();
+  void setCaptureEnabled(const bool enabled);
+
+private slots:
+  void writeData();
+  void onConnectedChanged();
+  void registerData(const QByteArray &data);
+
+private:
+  bool createFile();
+
+private:
+  bool m_captureEnabled;
+
+  QFile m_file;
+  QString m_path;
+  QElapsedTimer m_clock;
+
+  QMutex m_mutex;
+  QByteArray m_buffer;
+  qint64 m_firstTimestamp;
+
+  QPointer<HAL_Driver> m_driver;
+};
+} // namespace IO
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QUdpSocket>
+#include <QSerialPort>
+#include <QNetworkDatagram>
+
+#include "IO/Source.h"
+#include "Misc/ThreadScheduler.h"
+
+/**
+ * @brief Constructs a source & starts its thread.
+ *
+ * @param type    Type of device used by the source.
+ * @param address Port name of serial sources, ignored for UDP sources.
+ * @param setting Baud rate of serial sources, local port of UDP sources.
+ */
+IO::Source::Source(const Type type, const QString &address, const int setting)
+  : m_type(type)
+  , m_setting(setting)
+  , m_address(address)
+  , m_frameReader(this)
+{
+  // Forward the extracted frames to the I/O manager
+  connect(&m_frameReader, &IO::FrameReader::framesReady, this,
+          &IO::Source::framesReady);
+
+  // Move the source (and its frame reader) to its own thread
+  m_thread.setObjectName(QStringLiteral("Source: %1").arg(name()));
+  moveToThread(&m_thread);
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_thread, Misc::ThreadScheduler::Role::Reader);
+  m_thread.start(QThread::HighPriority);
+
+  // Synchronize the frame detection settings with the rest of the app
+  QMetaObject::invokeMethod(&m_frameReader,
+                            &FrameReader::setupExternalConnections,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * @brief Closes the device & stops the source thread.
+ */
+IO::Source::~Source()
+{
+  if (m_thread.isRunning())
+  {
+    QMetaObject::invokeMethod(this, &IO::Source::close,
+                              Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    if (!m_thread.wait(100))
+      m_thread.terminate();
+  }
+}
+
+/**
+ * @brief Returns the type of device used by the source.
+ */
+IO::Source::Type IO::Source::type() const
+{
+  return m_type;
+}
+
+/**
+ * @brief Returns the baud rate (serial) or the local port (UDP) of the source.
+ */
+int IO::Source::setting() const
+{
+  return m_setting;
+}
+
+/**
+ * @brief Returns a short, user-readable name of the source, which is used to
+ *        tag the datasets that it contributes to the dashboard.
+ */
+QString IO::Source::name() const
+{
+  if (m_type == SerialPort)
+    return QStringLiteral("%1 @ %2").arg(m_address).arg(m_setting);
+
+  return QStringLiteral("UDP :%1").arg(m_setting);
+}
+
+/**
+ * @brief Returns the maximum number of bytes per second that the source can
+ *        receive, or 0 if it is unknown (UDP sockets).
+ */
+qint64 IO::Source::dataRate() const
+{
+  if (m_type == SerialPort)
+    return m_setting / 10;
+
+  return 0;
+}
+
+/**
+ * @brief Returns the port name of serial sources.
+ */
+const QString &IO::Source::address() const
+{
+  return m_address;
+}
+
+/**
+ * @brief Closes the device of the source, must run in the source thread.
+ */
+void IO::Source::close()
+{
+  if (m_device)
+  {
+    m_device->close();
+    delete m_device;
+  }
+
+  m_frameReader.reset();
+}
+
+/**
+ * @brief Opens the device of the source, must run in the source thread.
+ *
+ * @param start  Start sequence used for frame detection.
+ * @param finish Finish sequence used for frame detection.
+ */
+void IO::Source::open(const QString &start, const QString &finish)
+{
+  // Close the previous device & configure the frame reader
+  close();
+  m_frameReader.setStartSequence(start);
+  m_frameReader.setFinishSequence(finish);
+
+  // Open a serial port
+  bool opened = false;
+  if (m_type == SerialPort)
+  {
+    auto port = new QSerialPort(m_address, this);
+    port->setBaudRate(m_setting);
+    connect(port, &QSerialPort::readyRead, this, &IO::Source::readData);
+    opened = port->open(QIODevice::ReadOnly);
+    m_device = port;
+  }
+
+  // Bind a UDP socket
+  else
+  {
+    auto socket = new QUdpSocket(this);
+    connect(socket, &QUdpSocket::readyRead, this, &IO::Source::readDatagrams);
+    opened = socket->bind(QHostAddress::Any, m_setting,
+                          QAbstractSocket::ShareAddress
+                              | QAbstractSocket::ReuseAddressHint);
+    m_device = socket;
+  }
+
+  // Report errors to the user
+  if (!opened)
+  {
+    Q_EMIT errorOccurred(tr("Cannot open %1: %2")
+                             .arg(name(), m_device->errorString()));
+    close();
+  }
+}
+
+/**
+ * @brief Sets the buffer capacity & overflow policy of the frame reader.
+ *
+ * Must be called from the thread of the source, i.e. before @c open() in the
+ * same queued call.
+ */
+void IO::Source::configureBuffer(
+    const qsizetype capacity, const SerialStudio::BufferOverflowPolicy policy)
+{
+  m_frameReader.setBufferCapacity(capacity);
+  m_frameReader.setOverflowPolicy(policy);
+}
+
+/**
+ * @brief Reads all the bytes available in the serial port.
+ */
+void IO::Source::readData()
+{
+  if (m_device)
+  {
+    const auto data = m_device->readAll();
+    if (!data.isEmpty())
+      m_frameReader.processData(data);
+  }
+}
+
+/**
+ * @brief Reads all the pending datagrams of the UDP socket.
+ */
+void IO::Source::readDatagrams()
+{
+  auto socket = qobject_cast<QUdpSocket *>(m_device);
+  if (!socket)
+    return;
+
+  while (socket->hasPendingDatagrams())
+  {
+    const auto datagram = socket->receiveDatagram();
+    if (!datagram.data().isEmpty())
+      m_frameReader.processData(datagram.data());
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QThread>
+#include <QObject>
+#include <QPointer>
+#include <QIODevice>
+
+#include "IO/FrameReader.h"
+
+namespace IO
+{
+/**
+ * @class IO::Source
+ * @brief Additional data source acquired next to the main device.
+ *
+ * Each source owns a serial port or UDP socket, its own @c FrameReader & a
+ * dedicated thread in which both of them live. Sources are connected and
+ * disconnected together with the main device, and the frames that they
+ * extract are handed to the I/O manager, which tags them with the source
+ * index & merges them into the dashboard stream.
+ *
+ * Sources are read-only, data written by the user is always sent to the main
+ * device.
+ */
+class Source : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void framesReady(const IO::FrameBatch &frames);
+  void errorOccurred(const QString &error);
+
+public:
+  /**
+   * @brief Supported source types
+   */
+  enum Type
+  {
+    SerialPort = 0,
+    UdpSocket = 1
+  };
+
+  Source(const Type type, const QString &address, const int setting);
+  ~Source();
+
+  [[nodiscard]] Type type() const;
+  [[nodiscard]] int setting() const;
+  [[nodiscard]] QString name() const;
+  [[nodiscard]] qint64 dataRate() const;
+  [[nodiscard]] const QString &address() const;
+
+public slots:
+  void close();
+  void open(const QString &start, const QString &finish);
+  void configureBuffer(const qsizetype capacity,
+                       const SerialStudio::BufferOverflowPolicy policy);
+
+private slots:
+  void readData();
+  void readDatagrams();
+
+private:
+  Type m_type;
+  int m_setting;
+  QString m_address;
+
+  QThread m_thread;
+  FrameReader m_frameReader;
+  QPointer<QIODevice> m_device;
+};
+} // namespace IO
@@ -25,13 +25,15 @@
 /**
  * @brief Constructs an Action object with a specified action ID.
  *
- * This constructor initializes the action with the provided ID, and sets
- * the icon, title, txData, and eolSequence to empty strings.
+ * This constructor initializes the action with the provided ID, sets the
+ * title, txData, and eolSequence to empty strings, and disables the periodic
+ * transmission of the action.
  *
  * @param actionId The unique ID for this action, set by the project editor.
  */
 JSON::Action::Action(const int actionId)
   : m_actionId(actionId)
+  , m_repeatInterval(0)
   , m_icon("Play Property")
   , m_title("")
   , m_txData("")
@@ -89,6 +91,27 @@ const QString &JSON::Action::eolSequence() const
   return m_eolSequence;
 }
 
+/**
+ * @brief Gets the time between two transmissions of the action.
+ *
+ * @return The repeat interval in milliseconds, or 0 if the action is sent
+ *         once every time that it is triggered.
+ */
+int JSON::Action::repeatInterval() const
+{
+  return m_repeatInterval;
+}
+
+/**
+ * @brief Gets the bytes sent to the device when the action is triggered.
+ *
+ * @return The UTF-8 encoded txData, followed by the eol sequence.
+ */
+const QByteArray &JSON::Action::txBytes() const
+{
+  return m_txBytes;
+}
+
 /**
  * @brief Serializes the action to a QJsonObject.
  *
@@ -104,6 +127,7 @@ QJsonObject JSON::Action::serialize() const
   object.insert(QStringLiteral("txData"), m_txData);
   object.insert(QStringLiteral("eol"), m_eolSequence);
   object.insert(QStringLiteral("title"), m_title.simplified());
+  object.insert(QStringLiteral("repeatInterval"), m_repeatInterval);
   return object;
 }
 
@@ -114,7 +138,8 @@ QJsonObject JSON::Action::serialize() const
  * QJsonObject.
  *
  * It expects the object to contain fields for "icon", "title", "txData", and
- * "eol".
+ * "eol", and optionally "repeatInterval". The bytes sent to the device are
+ * encoded afterwards.
  *
  * @param object The QJsonObject containing the action's data.
  * @return true if the object was successfully read, false if the object is
@@ -128,9 +153,20 @@ bool JSON::Action::read(const QJsonObject &object)
     m_txData = object.value(QStringLiteral("txData")).toString();
     m_eolSequence = object.value(QStringLiteral("eol")).toString();
     m_title = object.value(QStringLiteral("title")).toString().simplified();
+    m_repeatInterval
+        = qMax(0, object.value(QStringLiteral("repeatInterval")).toInt(0));
 
+    encodePayload();
     return true;
   }
 
   return false;
 }
+
+/**
+ * @brief Encodes the bytes sent to the device when the action is triggered.
+ */
+void JSON::Action::encodePayload()
+{
+  m_txBytes = (m_txData + m_eolSequence).toUtf8();
+}
@@ -43,6 +43,12 @@ namespace JSON
  * (txData), and an end-of-line (eol) sequence. It also provides functionality
  * to serialize and deserialize the action to and from a QJsonObject, making it
  * suitable for JSON-based communication or storage.
+ *
+ * The bytes sent to the device (the UTF-8 encoded txData followed by the eol
+ * sequence) are encoded once, when the action is loaded, instead of every
+ * time that the action is triggered. Actions with a repeat interval send
+ * their data periodically while they are active, which is useful to poll
+ * devices.
  */
 class Action
 {
@@ -55,15 +61,23 @@ public:
   [[nodiscard]] const QString &txData() const;
   [[nodiscard]] const QString &eolSequence() const;
 
+  [[nodiscard]] int repeatInterval() const;
+  [[nodiscard]] const QByteArray &txBytes() const;
+
   [[nodiscard]] QJsonObject serialize() const;
   [[nodiscard]] bool read(const QJsonObject &object);
 
+private:
+  void encodePayload();
+
 private:
   int m_actionId;
+  int m_repeatInterval;
   QString m_icon;
   QString m_title;
   QString m_txData;
   QString m_eolSequence;
+  QByteArray m_txBytes;
 
   friend class JSON::ProjectModel;
 };
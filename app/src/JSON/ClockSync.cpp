@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "JSON/ClockSync.h"
+
+/**
+ * Length (in nanoseconds of device time) of each window in which the lowest
+ * transport delay is measured to estimate the clock drift.
+ */
+static constexpr qint64 kDriftWindow = 10'000'000'000;
+
+/**
+ * Largest clock drift that is compensated, in parts per million.
+ */
+static constexpr double kMaxDrift = 1000e-6;
+
+/**
+ * Fraction of the remaining delay that the offset follows on every frame when
+ * the delay grows, so that the offset slowly adapts to a slower device clock
+ * without following the jitter of the transport.
+ */
+static constexpr double kOffsetLeak = 1e-3;
+
+/**
+ * Creates a clock mapping for a 32-bit counter.
+ */
+JSON::ClockSync::ClockSync()
+  : m_bits(32)
+{
+  reset();
+}
+
+/**
+ * Forgets the estimated offset & drift, e.g. when a new device is connected.
+ */
+void JSON::ClockSync::reset()
+{
+  m_valid = false;
+  m_lastCounter = 0;
+  m_device = 0;
+  m_anchorDevice = 0;
+  m_anchorHost = 0;
+  m_rate = 1.0;
+  m_offset = 0.0;
+  m_windowStart = 0;
+  m_windowDevice = 0;
+  m_windowMin = std::numeric_limits<double>::max();
+  m_hasPrevious = false;
+  m_previousDevice = 0;
+  m_previousMin = 0.0;
+}
+
+/**
+ * Sets the width of the device counter, 64 (or 0) disables the wraparound
+ * handling.
+ */
+void JSON::ClockSync::setCounterBits(const int bits)
+{
+  const auto width = bits <= 0 ? 64 : std::min(bits, 64);
+  if (m_bits != width)
+  {
+    m_bits = width;
+    reset();
+  }
+}
+
+/**
+ * Returns the host time (in nanoseconds, on the clock of @a arrival) at which
+ * the device sampled the frame that carries the given microsecond @a counter.
+ *
+ * @param counter The microsecond counter sent by the device.
+ * @param arrival The time at which the frame was received by the host.
+ */
+qint64 JSON::ClockSync::map(const quint64 counter, const qint64 arrival)
+{
+  // Mask of the counter bits
+  const quint64 mask = m_bits >= 64 ? ~0ULL : (1ULL << m_bits) - 1;
+  const auto value = counter & mask;
+  if (!m_valid)
+  {
+    restart(value, arrival);
+    return arrival;
+  }
+
+  // Unwrap the counter, a large step back is a device reset
+  const auto delta = (value - m_lastCounter) & mask;
+  if (delta > mask / 2)
+  {
+    restart(value, arrival);
+    return arrival;
+  }
+
+  m_lastCounter = value;
+  m_device += static_cast<qint64>(delta) * 1000;
+
+  // Follow the lower envelope of the transport delay
+  const auto base = m_anchorHost + (m_device - m_anchorDevice) * m_rate;
+  const auto delay = arrival - base - m_offset;
+  if (delay < 0)
+    m_offset += delay;
+  else
+    m_offset += delay * kOffsetLeak;
+
+  // Measure the lowest delay of the window, independently of the rate
+  const auto raw = static_cast<double>(arrival - m_device);
+  if (raw < m_windowMin)
+  {
+    m_windowMin = raw;
+    m_windowDevice = m_device;
+  }
+
+  // Estimate the drift from the slope of the lowest delays
+  if (m_device - m_windowStart >= kDriftWindow)
+  {
+    if (m_hasPrevious && m_windowDevice > m_previousDevice)
+    {
+      const auto slope = (m_windowMin - m_previousMin)
+                         / static_cast<double>(m_windowDevice
+                                               - m_previousDevice);
+      const auto rate = std::clamp(1.0 + slope, 1.0 - kMaxDrift,
+                                   1.0 + kMaxDrift);
+
+      // Re-anchor the mapping so that the new rate causes no jump
+      m_anchorHost = static_cast<qint64>(std::llround(base));
+      m_anchorDevice = m_device;
+      m_rate += (rate - m_rate) * 0.5;
+    }
+
+    m_hasPrevious = true;
+    m_previousMin = m_windowMin;
+    m_previousDevice = m_windowDevice;
+    m_windowStart = m_device;
+    m_windowMin = std::numeric_limits<double>::max();
+  }
+
+  // Never report a sampling time after the arrival of the frame
+  const auto mapped = m_anchorHost + (m_device - m_anchorDevice) * m_rate
+                      + m_offset;
+  return std::min(arrival, static_cast<qint64>(std::llround(mapped)));
+}
+
+/**
+ * Anchors the mapping at the given @a counter value & @a arrival time.
+ */
+void JSON::ClockSync::restart(const quint64 counter, const qint64 arrival)
+{
+  reset();
+  m_valid = true;
+  m_lastCounter = counter;
+  m_anchorHost = arrival;
+}
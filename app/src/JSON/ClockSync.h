@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+namespace JSON
+{
+/**
+ * @class JSON::ClockSync
+ * @brief Maps the timestamps sent by a device to the host clock.
+ *
+ * High-rate devices deliver their frames in bursts (e.g. USB packets), so the
+ * arrival time of a frame says little about when it was sampled. Devices that
+ * send a microsecond counter can use it instead: the counter is unwrapped
+ * (counters narrower than 64 bits overflow periodically) and mapped to the
+ * host clock with an offset & a rate estimated from the frames.
+ *
+ * Transport delays only ever make frames arrive later, so the offset follows
+ * the lower envelope of the difference between the arrival time & the device
+ * time. The rate, which compensates the drift between both crystals, is the
+ * slope of that envelope, measured once per estimation window.
+ *
+ * A counter that goes back by more than half of its range is assumed to be a
+ * device reset, and restarts the estimation.
+ */
+class ClockSync
+{
+public:
+  ClockSync();
+
+  void reset();
+  void setCounterBits(const int bits);
+  [[nodiscard]] qint64 map(const quint64 counter, const qint64 arrival);
+
+private:
+  void restart(const quint64 counter, const qint64 arrival);
+
+private:
+  int m_bits;
+  bool m_valid;
+  quint64 m_lastCounter;
+
+  qint64 m_device;
+  qint64 m_anchorDevice;
+  qint64 m_anchorHost;
+  double m_rate;
+  double m_offset;
+
+  qint64 m_windowStart;
+  qint64 m_windowDevice;
+  double m_windowMin;
+  bool m_hasPrevious;
+  qint64 m_previousDevice;
+  double m_previousMin;
+};
+} // namespace JSON
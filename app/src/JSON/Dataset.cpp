@@ -20,26 +20,45 @@
  * THE SOFTWARE.
  */
 
+#include <atomic>
+
+#include <QLocale>
+
 #include "JSON/Dataset.h"
+#include "SIMD/SIMD.h"
 
 JSON::Dataset::Dataset(const int groupId, const int datasetId)
   : m_fft(false)
   , m_led(false)
   , m_log(false)
   , m_graph(false)
+  , m_waterfall(false)
+  , m_priority(false)
+  , m_isNumeric(false)
   , m_title("")
   , m_value("")
   , m_units("")
   , m_widget("")
+  , m_fftWindow("Hann")
+  , m_expression("")
+  , m_filter("")
   , m_index(0)
   , m_max(0)
   , m_min(0)
   , m_alarm(0)
   , m_ledHigh(1)
+  , m_rawValue(0)
+  , m_numericValue(0)
+  , m_filterCutoff(10)
+  , m_sampleRate(0)
   , m_fftSamples(256)
   , m_fftSamplingRate(100)
+  , m_fftHopSize(1)
+  , m_filterRate(100)
+  , m_filterOrder(4)
   , m_groupId(groupId)
   , m_datasetId(datasetId)
+  , m_valueGeneration(nextValueGeneration())
 {
 }
 
@@ -51,6 +70,15 @@ bool JSON::Dataset::fft() const
   return m_fft;
 }
 
+/**
+ * @return @c true if the UI should generate a waterfall (spectrogram) plot of
+ *         this dataset
+ */
+bool JSON::Dataset::waterfall() const
+{
+  return m_waterfall;
+}
+
 /**
  * @return @c true if the UI should generate a LED of this dataset
  */
@@ -67,6 +95,15 @@ bool JSON::Dataset::log() const
   return m_log;
 }
 
+/**
+ * @return @c true if the dataset keeps being published to the MQTT broker
+ *         while the application sheds load (see @c Misc::OverloadController)
+ */
+bool JSON::Dataset::priority() const
+{
+  return m_priority;
+}
+
 /**
  * @return the field index represented by the current dataset
  */
@@ -83,6 +120,14 @@ bool JSON::Dataset::graph() const
   return m_graph;
 }
 
+/**
+ * @return @c true if the current value of the dataset is a valid number
+ */
+bool JSON::Dataset::isNumeric() const
+{
+  return m_isNumeric;
+}
+
 /**
  * Returns the minimum value of the dataset
  */
@@ -115,6 +160,28 @@ double JSON::Dataset::ledHigh() const
   return m_ledHigh;
 }
 
+/**
+ * @brief Returns the numeric value of the dataset before its filter is
+ *        applied, which equals @c numericValue() for unfiltered datasets.
+ */
+double JSON::Dataset::rawValue() const
+{
+  return m_rawValue;
+}
+
+/**
+ * @brief Returns the current value of the dataset as a number.
+ *
+ * The value is parsed once when it is assigned, so that the dashboard widgets
+ * do not need to convert the same string on every update.
+ *
+ * @return The numeric value, or @c 0 if the value is not a valid number.
+ */
+double JSON::Dataset::numericValue() const
+{
+  return m_numericValue;
+}
+
 /**
  * @return The title/description of this dataset
  */
@@ -163,6 +230,88 @@ int JSON::Dataset::fftSamplingRate() const
   return m_fftSamplingRate;
 }
 
+/**
+ * Returns the number of new samples that must be received before the FFT
+ * transform is re-calculated
+ */
+int JSON::Dataset::fftHopSize() const
+{
+  return qMax(1, m_fftHopSize);
+}
+
+/**
+ * Returns the sampling rate (in Hz) assumed by the low-pass & high-pass
+ * filters of the dataset.
+ */
+int JSON::Dataset::filterRate() const
+{
+  return m_filterRate;
+}
+
+/**
+ * Returns the order of the IIR filters, or the window length of the moving
+ * average & median filters of the dataset.
+ */
+int JSON::Dataset::filterOrder() const
+{
+  return m_filterOrder;
+}
+
+/**
+ * Returns the cutoff frequency (in Hz) of the low-pass & high-pass filters of
+ * the dataset.
+ */
+double JSON::Dataset::filterCutoff() const
+{
+  return m_filterCutoff;
+}
+
+/**
+ * Returns the rate (in Hz) at which the samples of an array dataset were
+ * acquired, or 0 if the dataset receives a single value per frame.
+ */
+double JSON::Dataset::sampleRate() const
+{
+  return m_sampleRate;
+}
+
+/**
+ * @return @c true if the field of the dataset carries a block of samples
+ *         (separated by spaces or semicolons) instead of a single value.
+ */
+bool JSON::Dataset::isArray() const
+{
+  return m_sampleRate > 0 && m_expression.isEmpty();
+}
+
+/**
+ * Returns the name of the window function applied before the FFT transform,
+ * for example "Hann", "Hamming" or "Rectangular"
+ */
+const QString &JSON::Dataset::fftWindow() const
+{
+  return m_fftWindow;
+}
+
+/**
+ * Returns the expression that computes the value of the dataset from the
+ * frame fields, or an empty string if the value is read from a field.
+ */
+const QString &JSON::Dataset::expression() const
+{
+  return m_expression;
+}
+
+/**
+ * Returns the type of digital filter applied to the dataset ("lowpass",
+ * "highpass", "movingAverage" or "median"), or an empty string if the value is
+ * not filtered.
+ */
+const QString &JSON::Dataset::filter() const
+{
+  return m_filter;
+}
+
 /**
  * @return The index of the group to which the dataset belongs to, used by
  *         the project model to easily identify which group/dataset to update
@@ -182,6 +331,18 @@ int JSON::Dataset::datasetId() const
   return m_datasetId;
 }
 
+/**
+ * @brief Returns the value generation of the dataset.
+ *
+ * A new generation is assigned whenever the value of the dataset changes, so
+ * that the dashboard only needs to update the widgets of the datasets whose
+ * generation differs from the one that was last displayed.
+ */
+quint64 JSON::Dataset::valueGeneration() const
+{
+  return m_valueGeneration;
+}
+
 /**
  * Returns the JSON data that represents this widget
  */
@@ -190,6 +351,103 @@ const QJsonObject &JSON::Dataset::jsonData() const
   return m_jsonData;
 }
 
+/**
+ * @brief Changes the current value of the dataset.
+ *
+ * Whitespace is simplified and the numeric representation of the value is
+ * updated, invalid numbers are stored as @c 0.
+ *
+ * @param value The new value/reading of the dataset.
+ * @return @c true if the value changed, @c false if it was the same.
+ */
+bool JSON::Dataset::setValue(const QString &value)
+{
+  bool ok;
+  const auto *text = reinterpret_cast<const char16_t *>(value.constData());
+  const auto number = SIMD::parseNumber(text, value.size(), &ok);
+  return setValue(value, number, ok);
+}
+
+/**
+ * @brief Changes the current value of the dataset, given together with its
+ *        numeric representation.
+ *
+ * Used by the frame builder, which converts all the fields of a frame to
+ * numbers in a single pass, so that they are not parsed again here.
+ *
+ * @param value The new value/reading of the dataset.
+ * @param numericValue The numeric representation of @a value.
+ * @param isNumeric @c true if @a value is a valid number.
+ * @return @c true if the value changed, @c false if it was the same.
+ */
+bool JSON::Dataset::setValue(const QString &value, const double numericValue,
+                             const bool isNumeric)
+{
+  auto simplified = value.simplified();
+  if (simplified == m_value)
+    return false;
+
+  m_value = std::move(simplified);
+  m_isNumeric = isNumeric;
+  m_numericValue = isNumeric ? numericValue : 0;
+  m_rawValue = m_numericValue;
+  m_valueGeneration = nextValueGeneration();
+  return true;
+}
+
+/**
+ * @brief Changes the current value of the dataset to a computed number.
+ *
+ * Used for datasets whose value is obtained from an expression, avoids
+ * parsing the textual representation of the value.
+ *
+ * @param value The new numeric value of the dataset.
+ * @return @c true if the value changed, @c false if it was the same.
+ */
+bool JSON::Dataset::setNumericValue(const double value)
+{
+  if (m_isNumeric && value == m_numericValue)
+    return false;
+
+  m_isNumeric = true;
+  m_rawValue = value;
+  m_numericValue = value;
+  m_value = QString::number(value, 'g', QLocale::FloatingPointShortest);
+  m_valueGeneration = nextValueGeneration();
+  return true;
+}
+
+/**
+ * @brief Replaces the current value of the dataset with the output of its
+ *        filter, keeping the unfiltered value in @c rawValue().
+ *
+ * @param value The filtered value of the dataset.
+ * @return @c true if the value changed, @c false if it was the same.
+ */
+bool JSON::Dataset::setFilteredValue(const double value)
+{
+  if (m_isNumeric && value == m_numericValue)
+    return false;
+
+  m_isNumeric = true;
+  m_numericValue = value;
+  m_value = QString::number(value, 'g', QLocale::FloatingPointShortest);
+  m_valueGeneration = nextValueGeneration();
+  return true;
+}
+
+/**
+ * @brief Returns a new, unique value generation number.
+ *
+ * Datasets & groups share the same counter, so that a group can take the
+ * generation of the most recently changed dataset.
+ */
+quint64 JSON::Dataset::nextValueGeneration()
+{
+  static std::atomic<quint64> generation(0);
+  return ++generation;
+}
+
 /**
  * @brief Encodes the dataset information into a QJsonObject.
  *
@@ -212,10 +470,20 @@ QJsonObject JSON::Dataset::serialize() const
   object.insert(QStringLiteral("graph"), m_graph);
   object.insert(QStringLiteral("ledHigh"), m_ledHigh);
   object.insert(QStringLiteral("fftSamples"), m_fftSamples);
+  object.insert(QStringLiteral("fftWindow"), m_fftWindow);
+  object.insert(QStringLiteral("waterfall"), m_waterfall);
+  object.insert(QStringLiteral("priority"), m_priority);
+  object.insert(QStringLiteral("fftHopSize"), m_fftHopSize);
   object.insert(QStringLiteral("value"), m_value.simplified());
   object.insert(QStringLiteral("title"), m_title.simplified());
   object.insert(QStringLiteral("units"), m_units.simplified());
   object.insert(QStringLiteral("widget"), m_widget.simplified());
+  object.insert(QStringLiteral("expression"), m_expression.simplified());
+  object.insert(QStringLiteral("filter"), m_filter);
+  object.insert(QStringLiteral("filterRate"), m_filterRate);
+  object.insert(QStringLiteral("filterOrder"), m_filterOrder);
+  object.insert(QStringLiteral("filterCutoff"), m_filterCutoff);
+  object.insert(QStringLiteral("sampleRate"), m_sampleRate);
   object.insert(QStringLiteral("fftSamplingRate"), m_fftSamplingRate);
   return object;
 }
@@ -240,13 +508,27 @@ bool JSON::Dataset::read(const QJsonObject &object)
     m_ledHigh = object.value(QStringLiteral("ledHigh")).toDouble();
     m_fftSamples = object.value(QStringLiteral("fftSamples")).toInt();
     m_title = object.value(QStringLiteral("title")).toString().simplified();
-    m_value = object.value(QStringLiteral("value")).toString().simplified();
+    setValue(object.value(QStringLiteral("value")).toString());
     m_units = object.value(QStringLiteral("units")).toString().simplified();
     m_widget = object.value(QStringLiteral("widget")).toString().simplified();
     m_fftSamplingRate = object.value(QStringLiteral("fftSamplingRate")).toInt();
+    m_fftHopSize = object.value(QStringLiteral("fftHopSize")).toInt(1);
+    m_fftWindow = object.value(QStringLiteral("fftWindow")).toString("Hann");
+    m_waterfall = object.value(QStringLiteral("waterfall")).toBool();
+    m_priority = object.value(QStringLiteral("priority")).toBool();
+    m_expression = object.value(QStringLiteral("expression"))
+                       .toString()
+                       .simplified();
+    m_filter = object.value(QStringLiteral("filter")).toString();
+    m_filterRate = object.value(QStringLiteral("filterRate")).toInt(100);
+    m_filterOrder = object.value(QStringLiteral("filterOrder")).toInt(4);
+    m_filterCutoff = object.value(QStringLiteral("filterCutoff")).toDouble(10);
+    m_sampleRate = object.value(QStringLiteral("sampleRate")).toDouble();
+    m_sampleRate = qMax(0.0, m_sampleRate);
     if (m_value.isEmpty())
-      m_value = QStringLiteral("--.--");
+      setValue(QStringLiteral("--.--"));
 
+    m_valueGeneration = nextValueGeneration();
     return true;
   }
 
@@ -63,11 +63,16 @@ namespace JSON
  * - Min: minimum value of the dataset, used for gauges & bars.
  * - Alarm: if the value exceeds the alarm level, bar widgets
  *          shall be rendered with a dark-red background.
+ * - Expression: if set, the value is computed from the fields of the frame
+ *               by a @c JSON::Expression instead of being read directly.
+ * - Filter: digital filter applied to the value (see @c JSON::FilterBank),
+ *           the unfiltered value remains available through @c rawValue().
  *
  * @note All of the dataset fields are optional, except the "value"
  *       field and the "title" field.
  */
 class Group;
+class FramePool;
 class FrameBuilder;
 class Dataset
 {
@@ -77,39 +82,67 @@ public:
   [[nodiscard]] bool fft() const;
   [[nodiscard]] bool led() const;
   [[nodiscard]] bool log() const;
+  [[nodiscard]] bool waterfall() const;
+  [[nodiscard]] bool priority() const;
   [[nodiscard]] int index() const;
   [[nodiscard]] bool graph() const;
+  [[nodiscard]] bool isNumeric() const;
   [[nodiscard]] double min() const;
   [[nodiscard]] double max() const;
   [[nodiscard]] double alarm() const;
   [[nodiscard]] double ledHigh() const;
+  [[nodiscard]] double rawValue() const;
+  [[nodiscard]] double numericValue() const;
   [[nodiscard]] int fftSamples() const;
   [[nodiscard]] int fftSamplingRate() const;
+  [[nodiscard]] int fftHopSize() const;
+  [[nodiscard]] int filterRate() const;
+  [[nodiscard]] int filterOrder() const;
+  [[nodiscard]] double filterCutoff() const;
+  [[nodiscard]] double sampleRate() const;
+  [[nodiscard]] bool isArray() const;
 
   [[nodiscard]] int groupId() const;
   [[nodiscard]] int datasetId() const;
+  [[nodiscard]] quint64 valueGeneration() const;
 
   [[nodiscard]] const QString &title() const;
   [[nodiscard]] const QString &value() const;
   [[nodiscard]] const QString &units() const;
   [[nodiscard]] const QString &widget() const;
+  [[nodiscard]] const QString &fftWindow() const;
+  [[nodiscard]] const QString &expression() const;
+  [[nodiscard]] const QString &filter() const;
   [[nodiscard]] const QJsonObject &jsonData() const;
 
   [[nodiscard]] QJsonObject serialize() const;
   [[nodiscard]] bool read(const QJsonObject &object);
 
+  bool setValue(const QString &value);
+  bool setValue(const QString &value, const double numericValue,
+                const bool isNumeric);
+  bool setNumericValue(const double value);
+  bool setFilteredValue(const double value);
   void setTitle(const QString &title) { m_title = title; }
 
+  [[nodiscard]] static quint64 nextValueGeneration();
+
 private:
   bool m_fft;
   bool m_led;
   bool m_log;
   bool m_graph;
+  bool m_waterfall;
+  bool m_priority;
+  bool m_isNumeric;
 
   QString m_title;
   QString m_value;
   QString m_units;
   QString m_widget;
+  QString m_fftWindow;
+  QString m_expression;
+  QString m_filter;
   QJsonObject m_jsonData;
 
   int m_index;
@@ -117,13 +150,22 @@ private:
   double m_min;
   double m_alarm;
   double m_ledHigh;
+  double m_rawValue;
+  double m_numericValue;
+  double m_filterCutoff;
+  double m_sampleRate;
   int m_fftSamples;
   int m_fftSamplingRate;
+  int m_fftHopSize;
+  int m_filterRate;
+  int m_filterOrder;
 
   int m_groupId;
   int m_datasetId;
+  quint64 m_valueGeneration;
 
   friend class JSON::ProjectModel;
+  friend class JSON::FramePool;
   friend class JSON::FrameBuilder;
 };
 } // namespace JSON
@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <array>
+#include <cmath>
+
+#include <QObject>
+#include <QtNumeric>
+
+#include "JSON/Expression.h"
+
+/**
+ * Maximum number of values on the evaluation stack of an expression.
+ */
+static constexpr int kMaxStack = 64;
+
+/**
+ * Maximum nesting level of parentheses and function calls.
+ */
+static constexpr int kMaxNesting = 32;
+
+/**
+ * Function that can be called from an expression, a negative maximum
+ * argument count indicates that the function is variadic.
+ */
+struct ExpressionFunction
+{
+  const char *name;
+  int opcode;
+  int minArgs;
+  int maxArgs;
+};
+
+/**
+ * Constructor function, creates an empty (invalid) expression.
+ */
+JSON::Expression::Expression()
+  : m_pos(0)
+  , m_depth(0)
+  , m_nesting(0)
+{
+}
+
+/**
+ * Returns @c true if the expression has been compiled successfully.
+ */
+bool JSON::Expression::isValid() const
+{
+  return !m_code.isEmpty();
+}
+
+/**
+ * Returns the source code of the expression.
+ */
+const QString &JSON::Expression::source() const
+{
+  return m_source;
+}
+
+/**
+ * Returns a description of the last compilation error.
+ */
+const QString &JSON::Expression::errorString() const
+{
+  return m_error;
+}
+
+/**
+ * @brief Compiles the expression given by @a source.
+ *
+ * @param source Expression text, for example <tt>($1 - 32) / 1.8</tt>.
+ *
+ * @return @c true on success, otherwise the error is available through
+ *         @c errorString() and the expression evaluates to NaN.
+ */
+bool JSON::Expression::compile(const QString &source)
+{
+  // Reset the compiler state
+  m_pos = 0;
+  m_depth = 0;
+  m_nesting = 0;
+  m_code.clear();
+  m_error.clear();
+  m_source = source;
+
+  // Compile the expression and make sure that all of it was consumed
+  bool ok = parseSum() && m_error.isEmpty();
+  if (ok)
+  {
+    skipWhitespace();
+    if (m_pos < m_source.length())
+      ok = fail(QObject::tr("Unexpected character \"%1\" at position %2")
+                    .arg(m_source.at(m_pos))
+                    .arg(m_pos + 1));
+  }
+
+  // Discard partially compiled code
+  if (!ok)
+    m_code.clear();
+
+  return ok;
+}
+
+/**
+ * @brief Evaluates the compiled expression.
+ *
+ * @param fields   Numeric values of the frame fields, @c $1 is @c fields[0].
+ * @param count    Number of values in @a fields.
+ * @param previous Previous value of the dataset, used for @c prev.
+ *
+ * @return Value of the expression, or NaN if it is not valid.
+ */
+double JSON::Expression::evaluate(const double *fields, const qsizetype count,
+                                  const double previous) const
+{
+  if (m_code.isEmpty())
+    return qQNaN();
+
+  int top = 0;
+  std::array<double, kMaxStack> stack;
+  for (const auto &i : m_code)
+  {
+    switch (i.op)
+    {
+      case Op::Constant:
+        stack[top++] = i.value;
+        break;
+      case Op::Field:
+        stack[top++] = i.arg < count ? fields[i.arg] : qQNaN();
+        break;
+      case Op::Previous:
+        stack[top++] = previous;
+        break;
+      case Op::Add:
+        --top;
+        stack[top - 1] += stack[top];
+        break;
+      case Op::Subtract:
+        --top;
+        stack[top - 1] -= stack[top];
+        break;
+      case Op::Multiply:
+        --top;
+        stack[top - 1] *= stack[top];
+        break;
+      case Op::Divide:
+        --top;
+        stack[top - 1] /= stack[top];
+        break;
+      case Op::Modulo:
+        --top;
+        stack[top - 1] = std::fmod(stack[top - 1], stack[top]);
+        break;
+      case Op::Power:
+        --top;
+        stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+        break;
+      case Op::Atan2:
+        --top;
+        stack[top - 1] = std::atan2(stack[top - 1], stack[top]);
+        break;
+      case Op::Negate:
+        stack[top - 1] = -stack[top - 1];
+        break;
+      case Op::Abs:
+        stack[top - 1] = std::abs(stack[top - 1]);
+        break;
+      case Op::Sqrt:
+        stack[top - 1] = std::sqrt(stack[top - 1]);
+        break;
+      case Op::Exp:
+        stack[top - 1] = std::exp(stack[top - 1]);
+        break;
+      case Op::Log:
+        stack[top - 1] = std::log(stack[top - 1]);
+        break;
+      case Op::Log10:
+        stack[top - 1] = std::log10(stack[top - 1]);
+        break;
+      case Op::Sin:
+        stack[top - 1] = std::sin(stack[top - 1]);
+        break;
+      case Op::Cos:
+        stack[top - 1] = std::cos(stack[top - 1]);
+        break;
+      case Op::Tan:
+        stack[top - 1] = std::tan(stack[top - 1]);
+        break;
+      case Op::Asin:
+        stack[top - 1] = std::asin(stack[top - 1]);
+        break;
+      case Op::Acos:
+        stack[top - 1] = std::acos(stack[top - 1]);
+        break;
+      case Op::Atan:
+        stack[top - 1] = std::atan(stack[top - 1]);
+        break;
+      case Op::Floor:
+        stack[top - 1] = std::floor(stack[top - 1]);
+        break;
+      case Op::Ceil:
+        stack[top - 1] = std::ceil(stack[top - 1]);
+        break;
+      case Op::Round:
+        stack[top - 1] = std::round(stack[top - 1]);
+        break;
+      case Op::Min:
+        for (int n = 1; n < i.arg; ++n, --top)
+          stack[top - 2] = std::fmin(stack[top - 2], stack[top - 1]);
+        break;
+      case Op::Max:
+        for (int n = 1; n < i.arg; ++n, --top)
+          stack[top - 2] = std::fmax(stack[top - 2], stack[top - 1]);
+        break;
+      case Op::Hypot:
+        if (i.arg == 1)
+          stack[top - 1] = std::abs(stack[top - 1]);
+
+        for (int n = 1; n < i.arg; ++n, --top)
+          stack[top - 2] = std::hypot(stack[top - 2], stack[top - 1]);
+        break;
+    }
+  }
+
+  return stack[0];
+}
+
+/**
+ * Compiles a sum or difference of products.
+ */
+bool JSON::Expression::parseSum()
+{
+  if (!parseProduct())
+    return false;
+
+  while (true)
+  {
+    skipWhitespace();
+    if (consume('+'))
+    {
+      if (!parseProduct())
+        return false;
+
+      append(Op::Add);
+    }
+
+    else if (consume('-'))
+    {
+      if (!parseProduct())
+        return false;
+
+      append(Op::Subtract);
+    }
+
+    else
+      return true;
+  }
+}
+
+/**
+ * Compiles a product, quotient or remainder of unary expressions.
+ */
+bool JSON::Expression::parseProduct()
+{
+  if (!parseUnary())
+    return false;
+
+  while (true)
+  {
+    skipWhitespace();
+    Op op;
+    if (consume('*'))
+      op = Op::Multiply;
+    else if (consume('/'))
+      op = Op::Divide;
+    else if (consume('%'))
+      op = Op::Modulo;
+    else
+      return true;
+
+    if (!parseUnary())
+      return false;
+
+    append(op);
+  }
+}
+
+/**
+ * Compiles an expression preceded by an optional sign.
+ */
+bool JSON::Expression::parseUnary()
+{
+  skipWhitespace();
+  if (consume('-'))
+  {
+    if (!parseUnary())
+      return false;
+
+    append(Op::Negate);
+    return true;
+  }
+
+  if (consume('+'))
+    return parseUnary();
+
+  return parsePower();
+}
+
+/**
+ * Compiles a power, which is right-associative and binds tighter than the
+ * sign of its base, so that <tt>-2^2</tt> equals -4.
+ */
+bool JSON::Expression::parsePower()
+{
+  if (!parsePrimary())
+    return false;
+
+  skipWhitespace();
+  if (consume('^'))
+  {
+    if (!parseUnary())
+      return false;
+
+    append(Op::Power);
+  }
+
+  return true;
+}
+
+/**
+ * Compiles a number, a field, an identifier or a parenthesized expression.
+ */
+bool JSON::Expression::parsePrimary()
+{
+  skipWhitespace();
+  if (m_pos >= m_source.length())
+    return fail(QObject::tr("Unexpected end of expression"));
+
+  // Parenthesized expression
+  const auto c = m_source.at(m_pos);
+  if (c == '(')
+  {
+    if (++m_nesting > kMaxNesting)
+      return fail(QObject::tr("Expression is nested too deeply"));
+
+    ++m_pos;
+    if (!parseSum())
+      return false;
+
+    skipWhitespace();
+    if (!consume(')'))
+      return fail(QObject::tr("Expected \")\" at position %1").arg(m_pos + 1));
+
+    --m_nesting;
+    return true;
+  }
+
+  // Frame field
+  if (c == '$')
+    return parseField();
+
+  // Numeric constant
+  if (c.isDigit() || c == '.')
+    return parseNumber();
+
+  // Constant, variable or function call
+  if (c.isLetter() || c == '_')
+    return parseIdentifier();
+
+  return fail(QObject::tr("Unexpected character \"%1\" at position %2")
+                  .arg(c)
+                  .arg(m_pos + 1));
+}
+
+/**
+ * Compiles a numeric constant, with an optional decimal exponent.
+ */
+bool JSON::Expression::parseNumber()
+{
+  // Find the end of the mantissa
+  const auto start = m_pos;
+  const auto length = m_source.length();
+  while (m_pos < length
+         && (m_source.at(m_pos).isDigit() || m_source.at(m_pos) == '.'))
+    ++m_pos;
+
+  // Find the end of the exponent
+  const auto isExponent = [](const QChar c) { return c == 'e' || c == 'E'; };
+  if (m_pos < length && isExponent(m_source.at(m_pos)))
+  {
+    auto end = m_pos + 1;
+    if (end < length && (m_source.at(end) == '+' || m_source.at(end) == '-'))
+      ++end;
+
+    if (end < length && m_source.at(end).isDigit())
+    {
+      m_pos = end;
+      while (m_pos < length && m_source.at(m_pos).isDigit())
+        ++m_pos;
+    }
+  }
+
+  // Convert the number
+  bool ok;
+  const auto text = QStringView(m_source).mid(start, m_pos - start);
+  const auto value = text.toDouble(&ok);
+  if (!ok)
+    return fail(QObject::tr("Invalid number \"%1\"").arg(text));
+
+  append(Op::Constant, 0, value);
+  return true;
+}
+
+/**
+ * Compiles a reference to a frame field, such as @c $3.
+ */
+bool JSON::Expression::parseField()
+{
+  // Skip the dollar sign and read the field number
+  const auto start = ++m_pos;
+  while (m_pos < m_source.length() && m_source.at(m_pos).isDigit())
+    ++m_pos;
+
+  // Validate the field number
+  bool ok;
+  const auto text = QStringView(m_source).mid(start, m_pos - start);
+  const auto field = text.toInt(&ok);
+  if (!ok || field < 1)
+    return fail(QObject::tr("Invalid field reference at position %1")
+                    .arg(start));
+
+  append(Op::Field, field - 1);
+  return true;
+}
+
+/**
+ * Compiles a named constant, the @c prev variable or a function call.
+ */
+bool JSON::Expression::parseIdentifier()
+{
+  // clang-format off
+  static const std::array<ExpressionFunction, 19> functions = {{
+    {"abs",   static_cast<int>(Op::Abs),   1,  1},
+    {"sqrt",  static_cast<int>(Op::Sqrt),  1,  1},
+    {"exp",   static_cast<int>(Op::Exp),   1,  1},
+    {"log",   static_cast<int>(Op::Log),   1,  1},
+    {"log10", static_cast<int>(Op::Log10), 1,  1},
+    {"sin",   static_cast<int>(Op::Sin),   1,  1},
+    {"cos",   static_cast<int>(Op::Cos),   1,  1},
+    {"tan",   static_cast<int>(Op::Tan),   1,  1},
+    {"asin",  static_cast<int>(Op::Asin),  1,  1},
+    {"acos",  static_cast<int>(Op::Acos),  1,  1},
+    {"atan",  static_cast<int>(Op::Atan),  1,  1},
+    {"floor", static_cast<int>(Op::Floor), 1,  1},
+    {"ceil",  static_cast<int>(Op::Ceil),  1,  1},
+    {"round", static_cast<int>(Op::Round), 1,  1},
+    {"atan2", static_cast<int>(Op::Atan2), 2,  2},
+    {"pow",   static_cast<int>(Op::Power), 2,  2},
+    {"min",   static_cast<int>(Op::Min),   1, -1},
+    {"max",   static_cast<int>(Op::Max),   1, -1},
+    {"hypot", static_cast<int>(Op::Hypot), 1, -1},
+  }};
+  // clang-format on
+
+  // Read the identifier
+  const auto start = m_pos;
+  const auto isNameChar = [](const QChar c) {
+    return c.isLetterOrNumber() || c == '_';
+  };
+
+  while (m_pos < m_source.length() && isNameChar(m_source.at(m_pos)))
+    ++m_pos;
+
+  // Constants and variables
+  const auto name = m_source.mid(start, m_pos - start);
+  skipWhitespace();
+  if (m_pos >= m_source.length() || m_source.at(m_pos) != '(')
+  {
+    if (name == QStringLiteral("prev"))
+      append(Op::Previous);
+    else if (name == QStringLiteral("pi"))
+      append(Op::Constant, 0, M_PI);
+    else
+      return fail(QObject::tr("Unknown identifier \"%1\"").arg(name));
+
+    return true;
+  }
+
+  // Find the function
+  const ExpressionFunction *function = nullptr;
+  for (const auto &f : functions)
+  {
+    if (name == QLatin1String(f.name))
+    {
+      function = &f;
+      break;
+    }
+  }
+
+  if (!function)
+    return fail(QObject::tr("Unknown function \"%1\"").arg(name));
+
+  if (++m_nesting > kMaxNesting)
+    return fail(QObject::tr("Expression is nested too deeply"));
+
+  // Compile the arguments
+  ++m_pos;
+  int argc = 0;
+  skipWhitespace();
+  if (!consume(')'))
+  {
+    do
+    {
+      if (!parseSum())
+        return false;
+
+      ++argc;
+      skipWhitespace();
+    } while (consume(','));
+
+    if (!consume(')'))
+      return fail(QObject::tr("Expected \")\" at position %1").arg(m_pos + 1));
+  }
+
+  // Validate the number of arguments
+  if (argc < function->minArgs
+      || (function->maxArgs >= 0 && argc > function->maxArgs))
+    return fail(QObject::tr("Wrong number of arguments for \"%1\"")
+                    .arg(name));
+
+  append(static_cast<Op>(function->opcode), argc);
+  --m_nesting;
+  return true;
+}
+
+/**
+ * Advances the compiler past any whitespace in the source.
+ */
+void JSON::Expression::skipWhitespace()
+{
+  while (m_pos < m_source.length() && m_source.at(m_pos).isSpace())
+    ++m_pos;
+}
+
+/**
+ * Advances the compiler past the character @a c if it is the next character
+ * of the source, and returns @c true in that case.
+ */
+bool JSON::Expression::consume(const QChar c)
+{
+  if (m_pos < m_source.length() && m_source.at(m_pos) == c)
+  {
+    ++m_pos;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Records the compilation @a error and returns @c false.
+ */
+bool JSON::Expression::fail(const QString &error)
+{
+  if (m_error.isEmpty())
+    m_error = error;
+
+  return false;
+}
+
+/**
+ * @brief Appends an instruction to the compiled code.
+ *
+ * Tracks the depth of the evaluation stack, which must never exceed
+ * @c kMaxStack values, so that the evaluation does not need to allocate or
+ * check its bounds.
+ */
+void JSON::Expression::append(const Op op, const int arg, const double value)
+{
+  // Update the stack depth
+  switch (op)
+  {
+    case Op::Constant:
+    case Op::Field:
+    case Op::Previous:
+      ++m_depth;
+      break;
+    case Op::Add:
+    case Op::Subtract:
+    case Op::Multiply:
+    case Op::Divide:
+    case Op::Modulo:
+    case Op::Power:
+    case Op::Atan2:
+      --m_depth;
+      break;
+    case Op::Min:
+    case Op::Max:
+    case Op::Hypot:
+      m_depth -= arg - 1;
+      break;
+    default:
+      break;
+  }
+
+  // Reject expressions that would overflow the stack
+  if (m_depth > kMaxStack)
+  {
+    (void)fail(QObject::tr("Expression is too complex"));
+    return;
+  }
+
+  m_code.append({op, arg, value});
+}
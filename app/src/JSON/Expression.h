@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+namespace JSON
+{
+/**
+ * @class JSON::Expression
+ * @brief Arithmetic expression that computes the value of a dataset.
+ *
+ * Computed datasets obtain their value from the fields of the parsed frame
+ * instead of reading a field directly, for example to convert units, to
+ * combine several channels or to filter a noisy signal. The expression is
+ * compiled once into a compact stack-based byte code, which is evaluated for
+ * every frame over the numeric values of the frame fields without allocating
+ * memory.
+ *
+ * The expression language supports:
+ * - Numbers, @c pi and the fields of the frame, written as @c $1, @c $2, etc.
+ * - @c prev, the previous value of the dataset, which allows exponential
+ *   moving averages, such as <tt>0.9 * prev + 0.1 * $1</tt>.
+ * - The @c +, @c -, @c *, @c /, @c % and @c ^ (power) operators.
+ * - The @c abs(), @c sqrt(), @c exp(), @c log(), @c log10(), @c sin(),
+ *   @c cos(), @c tan(), @c asin(), @c acos(), @c atan(), @c floor(),
+ *   @c ceil(), @c round(), @c atan2(), @c pow(), @c min(), @c max() and
+ *   @c hypot() functions. The last three take any number of arguments.
+ *
+ * Fields that are missing or not numeric evaluate to NaN.
+ */
+class Expression
+{
+public:
+  Expression();
+
+  [[nodiscard]] bool isValid() const;
+  [[nodiscard]] const QString &source() const;
+  [[nodiscard]] const QString &errorString() const;
+
+  [[nodiscard]] bool compile(const QString &source);
+  [[nodiscard]] double evaluate(const double *fields, const qsizetype count,
+                                const double previous) const;
+
+private:
+  enum class Op : quint8
+  {
+    Constant,
+    Field,
+    Previous,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    Power,
+    Negate,
+    Abs,
+    Sqrt,
+    Exp,
+    Log,
+    Log10,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Floor,
+    Ceil,
+    Round,
+    Atan2,
+    Min,
+    Max,
+    Hypot
+  };
+
+  struct Instruction
+  {
+    Op op;
+    int arg;
+    double value;
+  };
+
+  [[nodiscard]] bool parseSum();
+  [[nodiscard]] bool parseProduct();
+  [[nodiscard]] bool parseUnary();
+  [[nodiscard]] bool parsePower();
+  [[nodiscard]] bool parsePrimary();
+  [[nodiscard]] bool parseNumber();
+  [[nodiscard]] bool parseField();
+  [[nodiscard]] bool parseIdentifier();
+
+  void skipWhitespace();
+  [[nodiscard]] bool consume(const QChar c);
+  [[nodiscard]] bool fail(const QString &error);
+  void append(const Op op, const int arg = 0, const double value = 0);
+
+private:
+  QString m_source;
+  QString m_error;
+  QVector<Instruction> m_code;
+
+  qsizetype m_pos;
+  int m_depth;
+  int m_nesting;
+};
+} // namespace JSON
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include <QObject>
+
+#include "SIMD/SIMD.h"
+#include "JSON/FilterBank.h"
+
+/**
+ * Highest order of the Butterworth filters, in biquad sections times two.
+ */
+static constexpr int kMaxIirOrder = 8;
+
+/**
+ * Longest window of the moving average filters.
+ */
+static constexpr int kMaxAverageWindow = 1024;
+
+/**
+ * Longest window of the median filters, medians are searched by sorting a
+ * copy of the window, so it must remain short.
+ */
+static constexpr int kMaxMedianWindow = 63;
+
+/**
+ * Removes every filter.
+ */
+void JSON::FilterBank::clear()
+{
+  m_banks.clear();
+}
+
+/**
+ * Returns @c true if no dataset is filtered.
+ */
+bool JSON::FilterBank::isEmpty() const
+{
+  return m_banks.isEmpty();
+}
+
+/**
+ * @brief Builds the filters of the datasets of the given @a frame.
+ *
+ * Datasets with the same filter type & parameters are assigned to the same
+ * bank, the coefficients of each bank are computed once.
+ *
+ * @return The titles & errors of the datasets with an invalid filter, which
+ *         are left unfiltered.
+ */
+QStringList JSON::FilterBank::build(const JSON::Frame &frame)
+{
+  clear();
+
+  QStringList errors;
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &datasets = groups[g].datasets();
+    for (int d = 0; d < datasets.count(); ++d)
+    {
+      // Skip unfiltered datasets
+      const auto &dataset = datasets[d];
+      const auto &filter = dataset.filter();
+      if (filter.isEmpty())
+        continue;
+
+      // Obtain & validate the filter parameters
+      Type type;
+      int rate = 0;
+      double cutoff = 0;
+      int order = dataset.filterOrder();
+      QString error;
+      if (filter == QStringLiteral("lowpass")
+          || filter == QStringLiteral("highpass"))
+      {
+        type = filter == QStringLiteral("lowpass") ? Type::LowPass
+                                                   : Type::HighPass;
+        rate = dataset.filterRate();
+        cutoff = dataset.filterCutoff();
+        order = qBound(2, order + (order % 2), kMaxIirOrder);
+        if (rate <= 0 || cutoff <= 0 || cutoff >= rate / 2.0)
+          error = QObject::tr("the cutoff frequency must be between 0 Hz and "
+                              "half of the sampling rate");
+      }
+
+      else if (filter == QStringLiteral("movingAverage"))
+      {
+        type = Type::MovingAverage;
+        order = qBound(2, order, kMaxAverageWindow);
+      }
+
+      else if (filter == QStringLiteral("median"))
+      {
+        type = Type::Median;
+        order = qBound(3, order | 1, kMaxMedianWindow);
+      }
+
+      else
+        error = QObject::tr("unknown filter \"%1\"").arg(filter);
+
+      if (!error.isEmpty())
+      {
+        errors.append(QStringLiteral("%1 / %2: %3")
+                          .arg(groups[g].title(), dataset.title(), error));
+        continue;
+      }
+
+      // Find the bank of the filter, or create it
+      auto bank = std::find_if(m_banks.begin(), m_banks.end(),
+                               [&](const Bank &b) {
+                                 return b.type == type && b.order == order
+                                        && b.rate == rate
+                                        && b.cutoff == cutoff;
+                               });
+      if (bank == m_banks.end())
+      {
+        Bank b;
+        b.type = type;
+        b.order = order;
+        b.rate = rate;
+        b.cutoff = cutoff;
+        m_banks.append(b);
+        bank = m_banks.end() - 1;
+      }
+
+      bank->lanes.append({g, d});
+    }
+  }
+
+  // Allocate the filter state & compute the coefficients
+  for (auto &bank : m_banks)
+    initialize(bank);
+
+  return errors;
+}
+
+/**
+ * @brief Runs the values of the filtered datasets of @a groups through their
+ *        filters & replaces them with the filter outputs.
+ *
+ * The unfiltered values are gathered from @c JSON::Dataset::rawValue(), text
+ * datasets keep the last numeric sample of their filter.
+ */
+void JSON::FilterBank::process(QVector<JSON::Group> &groups)
+{
+  for (auto &bank : m_banks)
+  {
+    // Gather the samples of the bank
+    const auto lanes = bank.lanes.count();
+    for (qsizetype l = 0; l < lanes; ++l)
+    {
+      const auto &lane = bank.lanes[l];
+      const auto &dataset = groups[lane.group].m_datasets[lane.dataset];
+      if (dataset.isNumeric())
+        bank.samples[l] = dataset.rawValue();
+    }
+
+    // Run the filter
+    switch (bank.type)
+    {
+      case Type::LowPass:
+      case Type::HighPass:
+        processIir(bank);
+        break;
+      case Type::MovingAverage:
+        processMovingAverage(bank);
+        break;
+      case Type::Median:
+        processMedian(bank);
+        break;
+    }
+
+    // Replace the values of numeric datasets with the filter outputs
+    for (qsizetype l = 0; l < lanes; ++l)
+    {
+      const auto &lane = bank.lanes[l];
+      auto &group = groups[lane.group];
+      auto &dataset = group.m_datasets[lane.dataset];
+      if (dataset.isNumeric() && dataset.setFilteredValue(bank.window[l]))
+        group.m_valueGeneration = dataset.valueGeneration();
+    }
+  }
+}
+
+/**
+ * @brief Sets the state of the IIR sections of the @a bank so that they start
+ *        in steady state for the first samples.
+ *
+ * Without this, every low-pass filter would ramp up from zero and every
+ * high-pass filter would start with a step response.
+ */
+void JSON::FilterBank::prime(Bank &bank)
+{
+  const auto lanes = bank.lanes.count();
+  const double gain = bank.type == Type::LowPass ? 1 : 0;
+
+  auto input = bank.samples;
+  for (qsizetype s = 0; s < bank.sections.count(); ++s)
+  {
+    const auto &c = bank.sections[s];
+    for (qsizetype l = 0; l < lanes; ++l)
+    {
+      const auto x = input[l];
+      const auto y = gain * x;
+      const auto i = s * lanes + l;
+      bank.z2[i] = (c.b2 - c.a2 * gain) * x;
+      bank.z1[i] = (c.b1 - c.a1 * gain) * x + bank.z2[i];
+      input[l] = y;
+    }
+  }
+}
+
+/**
+ * @brief Allocates the state of the given @a bank & computes the coefficients
+ *        of its IIR sections.
+ *
+ * A Butterworth filter of order N is split into N / 2 biquad sections, whose
+ * quality factors are given by the angles of the poles of the filter. The
+ * coefficients of each section are obtained with the bilinear transform.
+ */
+void JSON::FilterBank::initialize(Bank &bank)
+{
+  const auto lanes = bank.lanes.count();
+  bank.samples.fill(0, lanes);
+  bank.window.fill(0, lanes);
+  bank.filled = 0;
+  bank.position = 0;
+
+  switch (bank.type)
+  {
+    case Type::LowPass:
+    case Type::HighPass:
+    {
+      const auto count = bank.order / 2;
+      const auto w0 = 2 * M_PI * bank.cutoff / bank.rate;
+      const auto cosw = std::cos(w0);
+      const auto sinw = std::sin(w0);
+      const bool lowPass = bank.type == Type::LowPass;
+
+      bank.sections.clear();
+      for (int k = 0; k < count; ++k)
+      {
+        const auto q
+            = 1.0 / (2 * std::cos(M_PI * (2 * k + 1) / (2.0 * bank.order)));
+        const auto alpha = sinw / (2 * q);
+        const auto a0 = 1 + alpha;
+
+        Section s;
+        s.b1 = (lowPass ? 1 - cosw : -(1 + cosw)) / a0;
+        s.b0 = (lowPass ? (1 - cosw) / 2 : (1 + cosw) / 2) / a0;
+        s.b2 = s.b0;
+        s.a1 = -2 * cosw / a0;
+        s.a2 = (1 - alpha) / a0;
+        bank.sections.append(s);
+      }
+
+      bank.z1.fill(0, count * lanes);
+      bank.z2.fill(0, count * lanes);
+      break;
+    }
+
+    case Type::MovingAverage:
+      bank.sum.fill(0, lanes);
+      bank.history.fill(0, bank.order * lanes);
+      break;
+
+    case Type::Median:
+      bank.history.fill(0, bank.order * lanes);
+      break;
+  }
+}
+
+/**
+ * Runs the samples of the @a bank through its cascade of biquad sections,
+ * processing all the lanes of each section at once.
+ */
+void JSON::FilterBank::processIir(Bank &bank)
+{
+  if (bank.filled == 0)
+  {
+    prime(bank);
+    bank.filled = 1;
+  }
+
+  const auto lanes = bank.lanes.count();
+  std::copy(bank.samples.cbegin(), bank.samples.cend(), bank.window.begin());
+  for (qsizetype s = 0; s < bank.sections.count(); ++s)
+  {
+    const auto &c = bank.sections[s];
+    SIMD::biquad(bank.window.data(), bank.z1.data() + s * lanes,
+                 bank.z2.data() + s * lanes, lanes, c.b0, c.b1, c.b2, c.a1,
+                 c.a2);
+  }
+}
+
+/**
+ * Adds the samples of the @a bank to the running sums of its windows & obtains
+ * the average of each lane.
+ */
+void JSON::FilterBank::processMovingAverage(Bank &bank)
+{
+  const auto lanes = bank.lanes.count();
+  const bool full = bank.filled == bank.order;
+  const auto count = full ? bank.filled : bank.filled + 1;
+  auto *history = bank.history.data() + bank.position * lanes;
+  for (qsizetype l = 0; l < lanes; ++l)
+  {
+    const auto x = bank.samples[l];
+    bank.sum[l] += x - (full ? history[l] : 0);
+    history[l] = x;
+    bank.window[l] = bank.sum[l] / count;
+  }
+
+  bank.filled = count;
+  bank.position = (bank.position + 1) % bank.order;
+}
+
+/**
+ * Adds the samples of the @a bank to their windows & obtains the median of
+ * each lane.
+ */
+void JSON::FilterBank::processMedian(Bank &bank)
+{
+  const auto lanes = bank.lanes.count();
+  const bool full = bank.filled == bank.order;
+  const auto count = full ? bank.filled : bank.filled + 1;
+  auto *history = bank.history.data() + bank.position * lanes;
+  for (qsizetype l = 0; l < lanes; ++l)
+    history[l] = bank.samples[l];
+
+  // Find the median of the window of each lane
+  double values[kMaxMedianWindow];
+  for (qsizetype l = 0; l < lanes; ++l)
+  {
+    for (qsizetype i = 0; i < count; ++i)
+      values[i] = bank.history[i * lanes + l];
+
+    const auto middle = values + count / 2;
+    std::nth_element(values, middle, values + count);
+    bank.window[l] = *middle;
+  }
+
+  bank.filled = count;
+  bank.position = (bank.position + 1) % bank.order;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QStringList>
+
+#include "JSON/Frame.h"
+
+namespace JSON
+{
+/**
+ * @class JSON::FilterBank
+ * @brief Digital filters applied to the values of the datasets after parsing.
+ *
+ * Each dataset can select one of the following filters in the project file:
+ * - @c "lowpass" / @c "highpass": Butterworth IIR filters of the given order,
+ *   implemented as a cascade of biquad sections, for the given cutoff
+ *   frequency & sampling rate.
+ * - @c "movingAverage": FIR filter that averages the last samples.
+ * - @c "median": returns the median of the last samples, which removes
+ *   isolated spikes.
+ *
+ * The coefficients are computed when the filters are built. Datasets that use
+ * exactly the same filter are grouped in a bank, whose samples are processed
+ * together as SIMD lanes. Every frame is one sample of each filter, filters
+ * start from the first value that they receive to avoid a start-up
+ * transient.
+ */
+class FilterBank
+{
+public:
+  void clear();
+  [[nodiscard]] bool isEmpty() const;
+  [[nodiscard]] QStringList build(const JSON::Frame &frame);
+  void process(QVector<JSON::Group> &groups);
+
+private:
+  enum class Type
+  {
+    LowPass,
+    HighPass,
+    MovingAverage,
+    Median
+  };
+
+  /**
+   * @brief Location of a filtered dataset in the frame.
+   */
+  struct Lane
+  {
+    int group;
+    int dataset;
+  };
+
+  /**
+   * @brief Normalized coefficients of a biquad section.
+   */
+  struct Section
+  {
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+  };
+
+  /**
+   * @brief Datasets that share the same filter & their filter state.
+   */
+  struct Bank
+  {
+    Type type;
+    int order;
+    int rate;
+    double cutoff;
+
+    QVector<Lane> lanes;
+    QVector<Section> sections;
+
+    QVector<double> samples;
+    QVector<double> z1;
+    QVector<double> z2;
+    QVector<double> sum;
+    QVector<double> history;
+    QVector<double> window;
+
+    qsizetype filled = 0;
+    qsizetype position = 0;
+  };
+
+  void prime(Bank &bank);
+  void initialize(Bank &bank);
+  void processIir(Bank &bank);
+  void processMedian(Bank &bank);
+  void processMovingAverage(Bank &bank);
+
+private:
+  QVector<Bank> m_banks;
+};
+} // namespace JSON
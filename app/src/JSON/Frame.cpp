@@ -20,8 +20,29 @@
  * THE SOFTWARE.
  */
 
+#include <atomic>
+
 #include "JSON/Frame.h"
 
+/**
+ * @brief Returns a new, unique structure generation number.
+ */
+static quint64 nextGeneration()
+{
+  static std::atomic<quint64> generation(0);
+  return ++generation;
+}
+
+/**
+ * Constructor function, every new frame has its own structure generation.
+ */
+JSON::Frame::Frame()
+  : m_timestamp(0)
+  , m_generation(nextGeneration())
+  , m_publishedValueGeneration(0)
+{
+}
+
 /**
  * Destructor function, free memory used by the @c Group objects before
  * destroying an instance of this class.
@@ -40,6 +61,11 @@ JSON::Frame::~Frame()
  */
 void JSON::Frame::clear()
 {
+  m_timestamp = 0;
+  m_generation = nextGeneration();
+  m_publishedValueGeneration = 0;
+  m_changedDatasets.clear();
+
   m_title = "";
   m_frameEnd = "";
   m_frameStart = "";
@@ -140,6 +166,59 @@ int JSON::Frame::groupCount() const
   return m_groups.count();
 }
 
+/**
+ * Returns the number of datasets whose values changed since the previously
+ * published frame.
+ */
+int JSON::Frame::changedCount() const
+{
+  return static_cast<int>(m_changedDatasets.count(true));
+}
+
+/**
+ * @brief Returns the structure generation of the frame.
+ *
+ * A new generation is assigned whenever the frame is constructed, cleared or
+ * read from a JSON object. Copies of a frame, and frames whose dataset values
+ * are updated by the frame builder, keep the same generation. Two frames with
+ * the same generation are guaranteed to have the same groups, datasets and
+ * actions, so consumers can skip any structural comparison.
+ */
+quint64 JSON::Frame::generation() const
+{
+  return m_generation;
+}
+
+/**
+ * @brief Returns an estimate of the memory used by a copy of the frame.
+ *
+ * Copies share the project strings (titles, units, etc.) with the original
+ * frame, so only the group & dataset structures and the dataset values are
+ * taken into account.
+ */
+qsizetype JSON::Frame::memoryUsage() const
+{
+  qsizetype bytes = sizeof(Frame);
+  for (const auto &group : m_groups)
+  {
+    bytes += sizeof(Group);
+    for (const auto &dataset : group.datasets())
+      bytes += sizeof(Dataset) + dataset.value().capacity() * sizeof(QChar);
+  }
+
+  return bytes;
+}
+
+/**
+ * Returns the time at which the data of this frame was received by the I/O
+ * driver (see @c Misc::PipelineStats::timestamp()), or 0 if unknown (e.g.
+ * frames replayed from a CSV file).
+ */
+qint64 JSON::Frame::timestamp() const
+{
+  return m_timestamp;
+}
+
 /**
  * Returns the title of the frame.
  */
@@ -181,3 +260,64 @@ const QVector<JSON::Action> &JSON::Frame::actions() const
 {
   return m_actions;
 }
+
+/**
+ * @brief Returns the datasets whose values changed since the previously
+ *        published frame.
+ *
+ * Each bit corresponds to a dataset slot, i.e. the position of the dataset
+ * within the frame (counting the datasets of each group in order). Every bit
+ * is set for the first frame published after the structure of the frame
+ * changes.
+ *
+ * The bitmap describes the change with respect to the previous frame that was
+ * published by the frame builder. Consumers that may drop frames should
+ * compare the value generation of each dataset instead.
+ */
+const QBitArray &JSON::Frame::changedDatasets() const
+{
+  return m_changedDatasets;
+}
+
+/**
+ * @brief Updates the changed dataset bitmap before the frame is published.
+ *
+ * Value generations are taken from a single monotonic counter, so a dataset
+ * changed since the last call if its generation is newer than the newest
+ * generation seen back then. Groups take the generation of their most recently
+ * changed dataset, which allows skipping unchanged groups entirely.
+ */
+void JSON::Frame::markChangedDatasets()
+{
+  // Count the dataset slots of the frame
+  qsizetype slots = 0;
+  for (const auto &group : std::as_const(m_groups))
+    slots += group.datasetCount();
+
+  // Compare the value generation of each dataset with the last published one
+  qsizetype slot = 0;
+  auto newest = m_publishedValueGeneration;
+  m_changedDatasets.resize(slots);
+  m_changedDatasets.fill(false);
+  for (const auto &group : std::as_const(m_groups))
+  {
+    const auto &datasets = group.datasets();
+    if (group.valueGeneration() <= m_publishedValueGeneration)
+    {
+      slot += datasets.count();
+      continue;
+    }
+
+    newest = qMax(newest, group.valueGeneration());
+    for (const auto &dataset : datasets)
+    {
+      if (dataset.valueGeneration() > m_publishedValueGeneration)
+        m_changedDatasets.setBit(slot);
+
+      newest = qMax(newest, dataset.valueGeneration());
+      ++slot;
+    }
+  }
+
+  m_publishedValueGeneration = newest;
+}
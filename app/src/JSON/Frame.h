@@ -24,12 +24,14 @@
 
 #include <QVector>
 #include <QObject>
+#include <QBitArray>
 #include <QVariant>
 #include <QJsonArray>
 #include <QJsonObject>
 
 #include "JSON/Group.h"
 #include "JSON/Action.h"
+#include "Misc/RingBus.h"
 
 namespace JSON
 {
@@ -53,11 +55,17 @@ namespace JSON
  *    frame.
  * 9) UI dashboard updates the widgets with the C++ model provided by this
  * class.
+ *
+ * Each frame published by the @c JSON::FrameBuilder also carries a bitmap of
+ * the datasets whose values changed since the previously published frame, so
+ * that downstream consumers can skip unchanged values without comparing them.
  */
+class FramePool;
 class FrameBuilder;
 class Frame
 {
 public:
+  Frame();
   ~Frame();
 
   void clear();
@@ -67,6 +75,10 @@ public:
   [[nodiscard]] bool read(const QJsonObject &object);
 
   [[nodiscard]] int groupCount() const;
+  [[nodiscard]] int changedCount() const;
+  [[nodiscard]] qint64 timestamp() const;
+  [[nodiscard]] quint64 generation() const;
+  [[nodiscard]] qsizetype memoryUsage() const;
 
   [[nodiscard]] const QString &title() const;
   [[nodiscard]] const QString &frameEnd() const;
@@ -74,6 +86,10 @@ public:
 
   [[nodiscard]] const QVector<Group> &groups() const;
   [[nodiscard]] const QVector<Action> &actions() const;
+  [[nodiscard]] const QBitArray &changedDatasets() const;
+
+private:
+  void markChangedDatasets();
 
 private:
   QString m_title;
@@ -83,6 +99,20 @@ private:
   QVector<Group> m_groups;
   QVector<Action> m_actions;
 
+  qint64 m_timestamp;
+  quint64 m_generation;
+  quint64 m_publishedValueGeneration;
+
+  QBitArray m_changedDatasets;
+
+  friend class Plugins::Viewer;
+  friend class JSON::FramePool;
   friend class JSON::FrameBuilder;
 };
+
+/**
+ * @brief Broadcast ring through which the frame builder publishes its frames
+ *        to the consumers that read them at their own pace.
+ */
+using FrameBus = Misc::RingBus<JSON::Frame>;
 } // namespace JSON
@@ -20,31 +20,103 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+
+#include <QDir>
 #include <QFileInfo>
+#include <QMessageBox>
+#include <QCoreApplication>
 #include <QFileDialog>
+#include <QtNumeric>
 
+#include "AppInfo.h"
 #include "IO/Manager.h"
 #include "Misc/Utilities.h"
 
 #include "CSV/Player.h"
+#include "JSON/ProjectCache.h"
 #include "JSON/ProjectModel.h"
+#include "JSON/ValueReader.h"
 #include "JSON/FrameBuilder.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+#include "Misc/ThreadScheduler.h"
+#include "Misc/Trace.h"
+#include "SIMD/SIMD.h"
+
+/**
+ * Default time that the JS frame parser may spend on a batch of frames before
+ * it is interrupted, in milliseconds.
+ */
+static constexpr int kDefaultParserTimeBudget = 500;
+
+/**
+ * Maximum number of parser threads used for stateless frame parsers.
+ */
+static constexpr int kMaxParserWorkers = 8;
+
+/**
+ * Number of frames held by the frame bus, consumers that fall further behind
+ * lose frames.
+ */
+static constexpr int kFrameBusCapacity = 1024;
+
+/**
+ * Time that frames may wait before they are parsed, in nanoseconds, a backlog
+ * this long is reported as a full queue to the overload controller.
+ */
+static constexpr qint64 kMaxParserLag = 500 * 1000 * 1000;
 
 /**
  * Initializes the JSON Parser class and connects appropiate SIGNALS/SLOTS
  */
 JSON::FrameBuilder::FrameBuilder()
-  : m_opMode(SerialStudio::ProjectFile)
+  : m_frameBus(kFrameBusCapacity)
+  , m_datasetMapGeneration(0)
+  , m_opMode(SerialStudio::ProjectFile)
   , m_frameParser(nullptr)
+  , m_fixedJsonLayout(false)
+  , m_jsonLayoutReady(false)
+  , m_sequenceColumn(-1)
+  , m_sequenceValid(false)
+  , m_lastSequence(0)
+  , m_timestampBits(32)
+  , m_timestampColumn(-1)
+  , m_parserTimeBudget(kDefaultParserTimeBudget)
+  , m_activeParserWorkers(1)
+  , m_pendingSince(0)
+  , m_dispatchSequence(0)
+  , m_publishSequence(0)
 {
-  // Read JSON map location
+  // Read JSON map location, never load parser plugins without the user
   auto path = m_settings.value("json_map_location", "").toString();
   if (!path.isEmpty())
-    loadJsonMap(path);
+    readJsonMap(path, false);
 
   // Obtain operation mode from settings
   auto m = m_settings.value("operation_mode", SerialStudio::QuickPlot).toInt();
   setOperationMode(static_cast<SerialStudio::OperationMode>(m));
+
+  // Obtain JSON layout mode from settings
+  m_fixedJsonLayout = m_settings.value("fixed_json_layout", false).toBool();
+
+  // Obtain the time budget of the JS frame parser from settings
+  m_parserTimeBudget = m_settings.value("parser_time_budget",
+                                        kDefaultParserTimeBudget)
+                           .toInt();
+
+  // Run the JS frame parser in its own thread
+  addParserWorker();
+
+  // Stop the parser threads before the application quits
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    for (const auto &worker : m_parserWorkers)
+    {
+      worker->thread.quit();
+      if (!worker->thread.wait(1000))
+        worker->thread.terminate();
+    }
+  });
 }
 
 /**
@@ -92,6 +164,33 @@ JSON::FrameParser *JSON::FrameBuilder::frameParser() const
   return m_frameParser;
 }
 
+/**
+ * Returns the time that the JS frame parser may spend on a batch of frames
+ * before it is interrupted and the frames are dropped, in milliseconds. A
+ * value of 0 disables the time budget.
+ */
+int JSON::FrameBuilder::parserTimeBudget() const
+{
+  return m_parserTimeBudget;
+}
+
+/**
+ * Returns the ring through which frames are published to the consumers that
+ * read them at their own pace.
+ */
+JSON::FrameBus &JSON::FrameBuilder::frameBus()
+{
+  return m_frameBus;
+}
+
+/**
+ * Returns the native frame parser compiled from the loaded project file.
+ */
+const JSON::NativeParser &JSON::FrameBuilder::nativeParser() const
+{
+  return m_nativeParser;
+}
+
 /**
  * Returns the operation mode
  */
@@ -100,6 +199,16 @@ SerialStudio::OperationMode JSON::FrameBuilder::operationMode() const
   return m_opMode;
 }
 
+/**
+ * Returns @c true if the layout of the first JSON frame received from the
+ * device is kept, and only the dataset values are updated with the following
+ * frames.
+ */
+bool JSON::FrameBuilder::fixedJsonLayout() const
+{
+  return m_fixedJsonLayout;
+}
+
 /**
  * Creates a file dialog & lets the user select the JSON file map
  */
@@ -120,20 +229,48 @@ void JSON::FrameBuilder::loadJsonMap()
  */
 void JSON::FrameBuilder::setupExternalConnections()
 {
-  connect(&IO::Manager::instance(), &IO::Manager::frameReceived, this,
-          &JSON::FrameBuilder::readData, Qt::QueuedConnection);
+  connect(&IO::Manager::instance(), &IO::Manager::framesReceived, this,
+          &JSON::FrameBuilder::readFrames, Qt::QueuedConnection);
+
+  // Restart the device frame counter check for each connection
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          [=] {
+            m_clocks.clear();
+            m_sequenceValid = false;
+            m_imuFusion.reset();
+          });
+
+  // Load the frame parser code into the parser engine
+  connect(&JSON::ProjectModel::instance(),
+          &JSON::ProjectModel::frameParserCodeChanged, this,
+          &JSON::FrameBuilder::loadParserScript);
+  loadParserScript();
 }
 
 /**
  * Opens, validates & loads into memory the JSON file in the given @a path.
  */
 void JSON::FrameBuilder::loadJsonMap(const QString &path)
+{
+  readJsonMap(path, true);
+}
+
+/**
+ * Loads the JSON file in the given @a path, see @c loadJsonMap().
+ *
+ * The frame parser plugin of the project is only loaded if the user trusts
+ * its library, @a userAction is @c false when the project is reopened at
+ * startup, in which case the user is not asked to trust new libraries.
+ */
+void JSON::FrameBuilder::readJsonMap(const QString &path,
+                                     const bool userAction)
 {
   // Validate path
   if (path.isEmpty())
     return;
 
   // Close previous file (if open)
+  m_jsonLayoutReady = false;
   if (m_jsonMap.isOpen())
   {
     m_frame.clear();
@@ -145,17 +282,16 @@ void JSON::FrameBuilder::loadJsonMap(const QString &path)
   m_jsonMap.setFileName(path);
   if (m_jsonMap.open(QFile::ReadOnly))
   {
-    // Read data & validate JSON from file
-    QJsonParseError error;
-    auto data = m_jsonMap.readAll();
-    auto document = QJsonDocument::fromJson(data, &error);
-    if (error.error != QJsonParseError::NoError)
+    // Read data & validate JSON from file, reuse the parsed project if cached
+    QString error;
+    QJsonObject json;
+    if (!JSON::ProjectCache::instance().parse(m_jsonMap.readAll(), &json,
+                                              &error))
     {
       m_frame.clear();
       m_jsonMap.close();
       setJsonPathSetting("");
-      Misc::Utilities::showMessageBox(tr("JSON parse error"),
-                                      error.errorString());
+      Misc::Utilities::showMessageBox(tr("JSON parse error"), error);
     }
 
     // JSON contains no errors, load compacted JSON document & save settings
@@ -166,11 +302,91 @@ void JSON::FrameBuilder::loadJsonMap(const QString &path)
 
       // Load frame from data
       m_frame.clear();
-      const bool ok = m_frame.read(document.object());
+      const bool ok = m_frame.read(json);
+
+      // Obtain the column of the device frame counter (if any)
+      m_sequenceValid = false;
+      const auto sequenceField = json.value(QStringLiteral("sequenceField"));
+      m_sequenceColumn = sequenceField.toInt() - 1;
+
+      // Obtain the column & width of the device timestamp counter (if any)
+      m_clocks.clear();
+      const auto timestampField = json.value(QStringLiteral("timestampField"));
+      const auto timestampBits = json.value(QStringLiteral("timestampBits"));
+      m_timestampColumn = timestampField.toInt() - 1;
+      m_timestampBits = timestampBits.toInt(32);
+
+      // Apply the load shedding policy of the project
+      const auto threshold = json.value(QStringLiteral("overloadThreshold"));
+      const auto decimation = json.value(QStringLiteral("overloadDecimation"));
+      Misc::OverloadController::instance().setPolicy(threshold.toInt(50),
+                                                     decimation.toInt(4));
+
+      // Compile the native frame parser, fall back to JS on failure
+      const auto parser = json.value(QStringLiteral("nativeParser"));
+      if (!m_nativeParser.read(parser.toObject()))
+        Misc::Utilities::showMessageBox(
+            tr("Invalid native frame parser"),
+            tr("%1. The JavaScript frame parser will be used instead.")
+                .arg(m_nativeParser.errorString()));
+
+      // Load the frame parser plugin, fall back to the other parsers
+      const auto plugin = json.value(QStringLiteral("parserPlugin"));
+      const auto folder = QFileInfo(path).absolutePath();
+      bool valid = m_pluginParser.read(plugin.toObject(), folder);
+      const auto library = m_pluginParser.libraryPath();
+      if (valid && !library.isEmpty())
+      {
+        if (trustParserPlugin(library, userAction))
+          valid = m_pluginParser.load();
+        else
+          Misc::Utilities::showMessageBox(
+              tr("Frame parser plugin not loaded"),
+              tr("%1 is not a trusted library. The project frame parser "
+                 "will be used instead.")
+                  .arg(QDir::toNativeSeparators(library)));
+      }
+
+      if (!valid)
+        Misc::Utilities::showMessageBox(
+            tr("Invalid frame parser plugin"),
+            tr("%1. The project frame parser will be used instead.")
+                .arg(m_pluginParser.errorString()));
+
+      const bool enabled = m_pluginParser.isEnabled();
+      m_pluginValues.resize(enabled ? m_pluginParser.capacity() : 0);
 
       // Update I/O manager settings
       if (ok && m_frame.isValid())
       {
+        // Map parsed fields to datasets, report invalid frame indexes
+        QStringList errors;
+        QStringList filters;
+        const auto invalid = buildDatasetMap(&errors, &filters);
+        if (!invalid.isEmpty())
+          Misc::Utilities::showMessageBox(
+              tr("Invalid dataset frame index"),
+              tr("The frame index of the following datasets is outside of "
+                 "the parsed frame and their values will not be updated:\n\n"
+                 "%1")
+                  .arg(invalid.join(QStringLiteral("\n"))));
+
+        // Report expressions that could not be compiled
+        if (!errors.isEmpty())
+          Misc::Utilities::showMessageBox(
+              tr("Invalid dataset expression"),
+              tr("The expression of the following datasets could not be "
+                 "compiled and their values will not be updated:\n\n%1")
+                  .arg(errors.join(QStringLiteral("\n"))));
+
+        // Report filters with invalid parameters
+        if (!filters.isEmpty())
+          Misc::Utilities::showMessageBox(
+              tr("Invalid dataset filter"),
+              tr("The filter of the following datasets is not valid and "
+                 "their values will not be filtered:\n\n%1")
+                  .arg(filters.join(QStringLiteral("\n"))));
+
         if (operationMode() == SerialStudio::ProjectFile)
         {
           IO::Manager::instance().setFinishSequence(m_frame.frameEnd());
@@ -187,9 +403,6 @@ void JSON::FrameBuilder::loadJsonMap(const QString &path)
         Misc::Utilities::showMessageBox(tr("Invalid JSON project format"));
       }
     }
-
-    // Get rid of warnings
-    Q_UNUSED(document);
   }
 
   // Open error
@@ -232,6 +445,8 @@ void JSON::FrameBuilder::setOperationMode(
     const SerialStudio::OperationMode mode)
 {
   m_opMode = mode;
+  m_jsonLayoutReady = false;
+  m_quickPlotFrame.clear();
 
   switch (mode)
   {
@@ -256,6 +471,81 @@ void JSON::FrameBuilder::setOperationMode(
   Q_EMIT operationModeChanged();
 }
 
+/**
+ * Enables or disables the fixed JSON layout mode.
+ *
+ * When enabled, the first JSON frame received from the device defines the
+ * groups & datasets of the dashboard. The following frames are scanned with
+ * @c JSON::ValueReader, which only updates the dataset values without building
+ * a @c QJsonDocument or a new frame. If a frame does not match the current
+ * layout, it is read completely and becomes the new layout.
+ *
+ * @note Changes to anything but the dataset values (e.g. titles or units) are
+ *       ignored while the layout of the frame stays the same.
+ */
+void JSON::FrameBuilder::setFixedJsonLayout(const bool enabled)
+{
+  if (m_fixedJsonLayout != enabled)
+  {
+    m_fixedJsonLayout = enabled;
+    m_jsonLayoutReady = false;
+    m_settings.setValue("fixed_json_layout", enabled);
+    Q_EMIT fixedJsonLayoutChanged();
+  }
+}
+
+/**
+ * Changes the time that the JS frame parser may spend on a batch of frames,
+ * in milliseconds. A value of 0 disables the time budget.
+ */
+void JSON::FrameBuilder::setParserTimeBudget(const int budget)
+{
+  const auto value = qMax(0, budget);
+  if (m_parserTimeBudget != value)
+  {
+    m_parserTimeBudget = value;
+    m_settings.setValue("parser_time_budget", value);
+    Q_EMIT parserTimeBudgetChanged();
+  }
+}
+
+/**
+ * @brief Checks if the user trusts the frame parser plugin at @a library.
+ *
+ * Trusted libraries are kept in the application settings. Unknown libraries
+ * are only trusted if the user accepts them in a message box, which is not
+ * shown unless the project was opened by a @a userAction.
+ */
+bool JSON::FrameBuilder::trustParserPlugin(const QString &library,
+                                           const bool userAction)
+{
+  // Load libraries that the user has already accepted
+  const auto key = QStringLiteral("trusted_parser_plugins");
+  auto trusted = m_settings.value(key).toStringList();
+  if (trusted.contains(library))
+    return true;
+
+  // Never run library code that the user has not seen
+  if (!userAction)
+    return false;
+
+  // Ask the user before loading the library
+  const int result = Misc::Utilities::showMessageBox(
+      tr("Load the frame parser plugin?"),
+      tr("The project decodes frames with the native library %1, which runs "
+         "with the same rights as %2. Only load libraries from sources that "
+         "you trust.")
+          .arg(QDir::toNativeSeparators(library), APP_NAME),
+      APP_NAME, QMessageBox::Yes | QMessageBox::No);
+  if (result != QMessageBox::Yes)
+    return false;
+
+  // Remember the decision for this library
+  trusted.append(library);
+  m_settings.setValue(key, trusted);
+  return true;
+}
+
 /**
  * Saves the location of the last valid JSON map file that was opened (if any)
  */
@@ -264,6 +554,651 @@ void JSON::FrameBuilder::setJsonPathSetting(const QString &path)
   m_settings.setValue(QStringLiteral("json_map_location"), path);
 }
 
+/**
+ * @brief Loads the frame parser code of the current project into the parser
+ *        engine.
+ */
+void JSON::FrameBuilder::loadParserScript()
+{
+  // Stateless parsers use one parser thread per spare CPU core
+  const auto &project = JSON::ProjectModel::instance();
+  m_activeParserWorkers = 1;
+  if (project.statelessParser())
+    m_activeParserWorkers
+        = qBound(1, QThread::idealThreadCount() - 1, kMaxParserWorkers);
+
+  // Create the missing parser threads
+  while (int(m_parserWorkers.size()) < m_activeParserWorkers)
+    addParserWorker();
+
+  // Load the script into the engine of each active parser thread
+  const auto code = project.frameParserCode();
+  for (int i = 0; i < m_activeParserWorkers; ++i)
+  {
+    auto *engine = &m_parserWorkers[i]->engine;
+    QMetaObject::invokeMethod(
+        engine, [=] { (void)engine->loadScript(code); }, Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Sends all the frames received since the last batch to an idle parser
+ *        thread.
+ *
+ * Each parser thread processes one batch at a time. Frames that arrive while
+ * every active parser thread is busy are accumulated, and are sent with a
+ * single @c parseBatch() call once one of them has finished, so that a slow
+ * parser script never blocks the user interface.
+ *
+ * Stateful parsers only use one thread, so that frames are parsed in order.
+ * Batches handed to the threads of a stateless parser are numbered, and their
+ * results are published in the same order by @c onFramesParsed().
+ */
+void JSON::FrameBuilder::parsePendingFrames()
+{
+  // Report the number of frames waiting for the parser
+  TRACE_COUNTER("FrameBuilder pending frames", m_pendingFrames.count());
+
+  // Nothing to do or every parser thread is busy
+  auto *worker = idleParserWorker();
+  if (!worker || m_pendingFrames.isEmpty())
+    return;
+
+  // Obtain pending frames
+  QList<QByteArray> frames;
+  QList<int> sources;
+  QList<qint64> timestamps;
+  frames.swap(m_pendingFrames);
+  sources.swap(m_pendingSources);
+  timestamps.swap(m_pendingTimestamps);
+
+  // Validate state
+  if (operationMode() != SerialStudio::ProjectFile)
+    return;
+
+  // Register the frames handed to the parser for the pipeline statistics
+  worker->batch.bytes = 0;
+  worker->batch.since = m_pendingSince;
+  worker->batch.sources = std::move(sources);
+  worker->batch.timestamps = std::move(timestamps);
+  for (const auto &frame : std::as_const(frames))
+    worker->batch.bytes += frame.size();
+
+  // Send frames to the parser thread
+  worker->busy = true;
+  worker->sequence = m_dispatchSequence++;
+  auto *engine = &worker->engine;
+  const auto decoder = JSON::ProjectModel::instance().decoderMethod();
+  QMetaObject::invokeMethod(
+      engine, [=] { engine->parseFrames(frames, decoder); },
+      Qt::QueuedConnection);
+
+  // Start the watchdog of the parser
+  if (m_parserTimeBudget > 0)
+    worker->watchdog.start(m_parserTimeBudget);
+}
+
+/**
+ * @brief Publishes the fields obtained by the parser engine for each frame,
+ *        and sends the frames that arrived in the meantime to the parser.
+ *
+ * Batches that finish before the batches dispatched earlier are kept until
+ * the earlier ones are published, so that frames reach the dashboard and the
+ * exporters in the order in which they were received.
+ */
+void JSON::FrameBuilder::onFramesParsed(ParserWorker *worker,
+                                        const QList<QStringList> &results)
+{
+  // Mark the worker as idle & keep its results
+  worker->busy = false;
+  worker->watchdog.stop();
+  worker->batch.results = results;
+  m_parsedBatches.insert(worker->sequence, std::move(worker->batch));
+  worker->batch = ParsedBatch();
+
+  // Publish the batches that are next in order
+  auto &stats = Misc::PipelineStats::instance();
+  while (!m_parsedBatches.isEmpty()
+         && m_parsedBatches.firstKey() == m_publishSequence)
+  {
+    const auto batch = m_parsedBatches.take(m_publishSequence++);
+    stats.record(Misc::PipelineStats::FrameParser, batch.results.count(),
+                 batch.bytes, stats.timestamp() - batch.since);
+
+    if (operationMode() == SerialStudio::ProjectFile)
+    {
+      for (qsizetype i = 0; i < batch.results.count(); ++i)
+        updateFrame(batch.results.at(i), batch.timestamps.value(i),
+                    batch.sources.value(i));
+    }
+  }
+
+  parsePendingFrames();
+}
+
+/**
+ * @brief Creates a parser thread with its own parser engine & watchdog.
+ */
+void JSON::FrameBuilder::addParserWorker()
+{
+  auto worker = std::make_unique<ParserWorker>();
+  auto *w = worker.get();
+
+  // Run the parser engine in the thread of the worker
+  w->engine.moveToThread(&w->thread);
+  connect(&w->engine, &JSON::ParserEngine::framesParsed, this,
+          [=](const QList<QStringList> &results) {
+            onFramesParsed(w, results);
+          },
+          Qt::QueuedConnection);
+
+  // Interrupt the JS frame parser when it exceeds its time budget
+  w->watchdog.setSingleShot(true);
+  w->watchdog.setTimerType(Qt::PreciseTimer);
+  connect(&w->watchdog, &QTimer::timeout, this,
+          [=] { w->engine.interrupt(); });
+
+  // Start the parser thread
+  const auto number = m_parserWorkers.size() + 1;
+  w->thread.setObjectName(QStringLiteral("Frame Parser %1").arg(number));
+  Misc::ThreadScheduler::instance().registerThread(
+      &w->thread, Misc::ThreadScheduler::Role::Parser);
+  w->thread.start();
+  m_parserWorkers.push_back(std::move(worker));
+}
+
+/**
+ * @brief Returns the first active parser thread that is not parsing frames,
+ *        or @c nullptr if all of them are busy.
+ */
+JSON::FrameBuilder::ParserWorker *JSON::FrameBuilder::idleParserWorker() const
+{
+  for (int i = 0; i < m_activeParserWorkers; ++i)
+  {
+    if (!m_parserWorkers[i]->busy)
+      return m_parserWorkers[i].get();
+  }
+
+  return nullptr;
+}
+
+/**
+ * @brief Assigns already separated frame fields to the project frame.
+ *
+ * This is used by the CSV player to replay rows without joining their cells
+ * into a comma-separated frame, which would be split again by @c readData().
+ * Each item of @a frames is processed as an individual frame, in order.
+ */
+void JSON::FrameBuilder::readFields(const QList<QStringList> &frames)
+{
+  if (operationMode() != SerialStudio::ProjectFile)
+    return;
+
+  for (const auto &fields : frames)
+  {
+    if (!fields.isEmpty())
+      updateFrame(fields);
+  }
+}
+
+/**
+ * @brief Assigns the given @a fields to the datasets of the project frame and
+ *        notifies the rest of the application.
+ *
+ * @param fields The parsed fields of the frame.
+ * @param timestamp The time at which the frame was received, or 0 if unknown.
+ * @param source The data source of the frame, 0 is the main device.
+ */
+void JSON::FrameBuilder::updateFrame(const QStringList &fields,
+                                     const qint64 timestamp, const int source)
+{
+  // Rebuild the dataset map if the frame structure changed
+  if (m_datasetMapGeneration != m_frame.generation())
+    (void)buildDatasetMap();
+
+  // Detect frames lost by the device link with the device frame counter
+  const auto count = fields.count();
+  if (m_sequenceColumn >= 0 && m_sequenceColumn < count
+      && !fields.at(m_sequenceColumn).isNull())
+    checkSequence(fields.at(m_sequenceColumn));
+
+  // Use the sampling time given by the device timestamp (if any)
+  auto time = timestamp;
+  if (m_timestampColumn >= 0 && m_timestampColumn < count && timestamp > 0
+      && !fields.at(m_timestampColumn).isNull())
+    time = deviceTime(fields.at(m_timestampColumn), timestamp, source);
+
+  // Convert the fields to numbers once for the datasets & expressions
+  m_fieldValid.resize(count);
+  m_fieldValues.resize(count);
+  for (qsizetype i = 0; i < count; ++i)
+  {
+    const auto &field = fields.at(i);
+    const auto *text = reinterpret_cast<const char16_t *>(field.constData());
+    bool ok;
+    m_fieldValues[i] = SIMD::parseNumber(text, field.size(), &ok);
+    m_fieldValid[i] = ok;
+  }
+
+  // Replace data in frame, slots are sorted by field column & null fields
+  // (e.g. the values of other CAN messages) keep the current value
+  auto &groups = m_frame.m_groups;
+  for (const auto &slot : std::as_const(m_datasetSlots))
+  {
+    if (slot.column >= count)
+      break;
+
+    if (fields.at(slot.column).isNull())
+      continue;
+
+    // Groups take the value generation of their latest changed dataset
+    auto &group = groups[slot.group];
+    auto &dataset = group.m_datasets[slot.dataset];
+    const auto column = slot.column;
+    if (dataset.setValue(fields.at(column), m_fieldValues[column],
+                         m_fieldValid[column]))
+      group.m_valueGeneration = dataset.valueGeneration();
+  }
+
+  // Invalid numbers are given to the expressions as NaN
+  if (!m_expressionSlots.isEmpty())
+  {
+    for (qsizetype i = 0; i < count; ++i)
+    {
+      if (!m_fieldValid[i])
+        m_fieldValues[i] = qQNaN();
+    }
+  }
+
+  // Publish a frame for each sample of the array datasets
+  if (!m_arraySlots.isEmpty())
+  {
+    const auto rows = readArrays(fields);
+    if (rows > 0)
+    {
+      publishArrays(time, rows);
+      return;
+    }
+  }
+
+  // Evaluate expressions
+  if (!m_expressionSlots.isEmpty())
+    evaluateExpressions(m_fieldValues.constData(), count);
+
+  // Filter the values & update user interface
+  finishFrame(time);
+}
+
+/**
+ * @brief Assigns numeric @a values to the datasets of the project frame and
+ *        notifies the rest of the application.
+ *
+ * Used by the sample-based drivers & the parser plugins, whose values need no
+ * text conversion. Value @c n is assigned to the datasets with frame index
+ * @c n+1, array datasets & device counters are not read from numeric frames.
+ *
+ * @param values The values of the frame.
+ * @param count The number of values in @a values.
+ * @param timestamp The sampling time of the frame.
+ */
+void JSON::FrameBuilder::updateFrame(const double *values,
+                                     const qsizetype count,
+                                     const qint64 timestamp)
+{
+  // Rebuild the dataset map if the frame structure changed
+  if (m_datasetMapGeneration != m_frame.generation())
+    (void)buildDatasetMap();
+
+  // Replace data in frame, slots are sorted by field column
+  auto &groups = m_frame.m_groups;
+  for (const auto &slot : std::as_const(m_datasetSlots))
+  {
+    if (slot.column >= count)
+      break;
+
+    auto &group = groups[slot.group];
+    auto &dataset = group.m_datasets[slot.dataset];
+    if (dataset.setNumericValue(values[slot.column]))
+      group.m_valueGeneration = dataset.valueGeneration();
+  }
+
+  // Evaluate expressions
+  if (!m_expressionSlots.isEmpty())
+    evaluateExpressions(values, count);
+
+  // Filter the values & update user interface
+  finishFrame(timestamp);
+}
+
+/**
+ * @brief Splits the fields of the array datasets into their samples.
+ *
+ * Samples are separated by semicolons, spaces or tabs, and values that are
+ * not numeric are skipped.
+ *
+ * @param fields The parsed fields of the frame.
+ * @return The largest number of samples found in an array field.
+ */
+qsizetype JSON::FrameBuilder::readArrays(const QStringList &fields)
+{
+  qsizetype rows = 0;
+  for (auto &slot : m_arraySlots)
+  {
+    slot.samples.clear();
+    if (slot.column >= fields.count() || fields.at(slot.column).isNull())
+      continue;
+
+    const auto &field = fields.at(slot.column);
+    const auto *text = reinterpret_cast<const char16_t *>(field.constData());
+    const auto size = field.size();
+
+    qsizetype begin = 0;
+    for (qsizetype i = 0; i <= size; ++i)
+    {
+      if (i < size && text[i] != u';' && text[i] != u' ' && text[i] != u'\t')
+        continue;
+
+      if (i > begin)
+      {
+        bool ok;
+        const auto value = SIMD::parseNumber(text + begin, i - begin, &ok);
+        if (ok)
+          slot.samples.append(value);
+      }
+
+      begin = i + 1;
+    }
+
+    rows = qMax(rows, slot.samples.count());
+  }
+
+  return rows;
+}
+
+/**
+ * @brief Publishes a frame for each sample of the array datasets.
+ *
+ * The scalar datasets keep the value of the frame, while array datasets with
+ * fewer samples repeat their last one. The newest sample is given the frame
+ * time and older samples are placed before it with the sample rate of the
+ * first array dataset that received samples.
+ *
+ * @param timestamp The sampling time of the frame.
+ * @param rows The number of samples to publish.
+ */
+void JSON::FrameBuilder::publishArrays(const qint64 timestamp,
+                                       const qsizetype rows)
+{
+  // Obtain the sample period
+  qint64 period = 0;
+  for (const auto &slot : std::as_const(m_arraySlots))
+  {
+    if (!slot.samples.isEmpty())
+    {
+      period = slot.period;
+      break;
+    }
+  }
+
+  // Publish each sample as an individual frame
+  auto &groups = m_frame.m_groups;
+  const auto count = m_fieldValues.count();
+  for (qsizetype row = 0; row < rows; ++row)
+  {
+    for (const auto &slot : std::as_const(m_arraySlots))
+    {
+      const auto n = slot.samples.count();
+      if (n == 0)
+        continue;
+
+      auto &group = groups[slot.group];
+      auto &dataset = group.m_datasets[slot.dataset];
+      const auto value = slot.samples[qMin(row, n - 1)];
+      if (dataset.setNumericValue(value))
+        group.m_valueGeneration = dataset.valueGeneration();
+
+      if (slot.column < count)
+        m_fieldValues[slot.column] = value;
+    }
+
+    if (!m_expressionSlots.isEmpty())
+      evaluateExpressions(m_fieldValues.constData(), count);
+
+    finishFrame(timestamp - (rows - 1 - row) * period);
+  }
+}
+
+/**
+ * @brief Publishes blocks of numeric samples without any text conversion.
+ *
+ * Used by drivers that acquire sampled signals (e.g. the audio input), whose
+ * blocks must not go through frame detection or the frame parsers. Each row
+ * of @a samples holds one value per channel, and becomes a frame of its own
+ * so that the plots & FFT widgets receive every sample. In project mode,
+ * channel @c n is assigned to the datasets with frame index @c n+1, in quick
+ * plot mode, a channel is created for each column.
+ *
+ * @param samples Interleaved samples, @a frames rows of @a channels values.
+ * @param frames The number of rows in @a samples.
+ * @param channels The number of values in each row.
+ * @param timestamp The sampling time of the first row.
+ * @param period The time between two rows, in nanoseconds.
+ */
+void JSON::FrameBuilder::readSamples(const double *samples,
+                                     const qsizetype frames,
+                                     const int channels,
+                                     const qint64 timestamp,
+                                     const qint64 period)
+{
+  // Nothing to do
+  if (!samples || frames <= 0 || channels <= 0)
+    return;
+
+  // Obtain the time at which processing started
+  auto &stats = Misc::PipelineStats::instance();
+  const auto start = stats.timestamp();
+
+  // Assign the channels to the datasets of the project
+  if (operationMode() == SerialStudio::ProjectFile)
+  {
+    for (qsizetype row = 0; row < frames; ++row)
+    {
+      const auto time = timestamp + row * period;
+      updateFrame(samples + row * channels, channels, time);
+    }
+  }
+
+  // Assign the channels to the quick plot frame
+  else if (operationMode() == SerialStudio::QuickPlot)
+  {
+    if (m_quickPlotFrame.groupCount() == 0
+        || m_quickPlotFrame.m_groups.first().datasetCount() != channels)
+      buildQuickPlotFrame(channels);
+
+    auto &groups = m_quickPlotFrame.m_groups;
+    for (qsizetype row = 0; row < frames; ++row)
+    {
+      const auto *values = samples + row * channels;
+      for (int channel = 0; channel < channels; ++channel)
+      {
+        auto &dataset = groups[0].m_datasets[channel];
+        if (!dataset.setNumericValue(values[channel]))
+          continue;
+
+        groups[0].m_valueGeneration = dataset.m_valueGeneration;
+        if (groups.count() > 1)
+        {
+          auto &plot = groups[1].m_datasets[channel];
+          plot.setNumericValue(values[channel]);
+          groups[1].m_valueGeneration = plot.m_valueGeneration;
+        }
+      }
+
+      m_quickPlotFrame.m_timestamp = timestamp + row * period;
+      m_quickPlotFrame.markChangedDatasets();
+      publishFrame(m_quickPlotFrame);
+    }
+  }
+
+  // JSON frames cannot be built from samples
+  else
+    return;
+
+  // Register the frames for the pipeline statistics
+  const auto bytes = frames * channels * qsizetype(sizeof(double));
+  stats.record(Misc::PipelineStats::FrameParser, frames, bytes,
+               stats.timestamp() - start);
+}
+
+/**
+ * @brief Evaluates the datasets obtained from expressions.
+ *
+ * NaN results leave the value of the dataset unchanged.
+ *
+ * @param values The numeric value of each field of the frame.
+ * @param count The number of fields.
+ */
+void JSON::FrameBuilder::evaluateExpressions(const double *values,
+                                             const qsizetype count)
+{
+  auto &groups = m_frame.m_groups;
+  for (const auto &slot : std::as_const(m_expressionSlots))
+  {
+    auto &group = groups[slot.group];
+    auto &dataset = group.m_datasets[slot.dataset];
+    const auto value
+        = slot.expression.evaluate(values, count, dataset.numericValue());
+
+    if (!qIsNaN(value) && dataset.setNumericValue(value))
+      group.m_valueGeneration = dataset.valueGeneration();
+  }
+}
+
+/**
+ * @brief Runs the filters & orientation estimator over the values assigned
+ *        to the project frame, and publishes it.
+ *
+ * @param timestamp The sampling time of the frame.
+ */
+void JSON::FrameBuilder::finishFrame(const qint64 timestamp)
+{
+  // Run the values of filtered datasets through their filters
+  auto &groups = m_frame.m_groups;
+  if (!m_filters.isEmpty())
+    m_filters.process(groups);
+
+  // Estimate the orientation of the gyroscopes
+  m_imuFusion.process(groups, m_frame.generation(), timestamp);
+
+  // Update user interface
+  m_frame.m_timestamp = timestamp;
+  m_frame.markChangedDatasets();
+  publishFrame(m_frame);
+}
+
+/**
+ * @brief Maps the device timestamp in the given @a field to the host clock.
+ *
+ * Every data source has its own clock estimator, since each device has its
+ * own crystal. Fields that are not a counter keep the arrival time.
+ *
+ * @param field The field that contains the microsecond counter of the device.
+ * @param timestamp The time at which the frame was received.
+ * @param source The data source of the frame.
+ * @return The estimated sampling time of the frame on the host clock.
+ */
+qint64 JSON::FrameBuilder::deviceTime(const QString &field,
+                                      const qint64 timestamp, const int source)
+{
+  bool ok;
+  const auto counter = field.trimmed().toULongLong(&ok);
+  if (!ok)
+    return timestamp;
+
+  auto &clock = m_clocks[source];
+  clock.setCounterBits(m_timestampBits);
+  return clock.map(counter, timestamp);
+}
+
+/**
+ * @brief Compares the frame counter in the given @a field with the counter of
+ *        the previous frame.
+ *
+ * Counters that skip values are reported as missing device frames. Counters
+ * that go back are assumed to have wrapped around or to have been reset by
+ * the device, and are not reported.
+ */
+void JSON::FrameBuilder::checkSequence(const QString &field)
+{
+  bool ok;
+  const auto sequence = field.trimmed().toULongLong(&ok);
+  if (!ok)
+    return;
+
+  if (m_sequenceValid && sequence > m_lastSequence + 1)
+    Misc::PipelineStats::instance().recordIntegrity(
+        Misc::PipelineStats::SequenceGaps, sequence - m_lastSequence - 1);
+
+  m_sequenceValid = true;
+  m_lastSequence = sequence;
+}
+
+/**
+ * @brief Assigns the dataset values of the given JSON @a data to the current
+ *        frame, without rebuilding its groups & datasets.
+ *
+ * @return @c false if @a data is not valid JSON or if its layout does not
+ *         match the layout of the current frame.
+ */
+bool JSON::FrameBuilder::updateJsonValues(const QByteArray &data)
+{
+  int count = 0;
+  auto &groups = m_frame.m_groups;
+  const bool ok = JSON::ValueReader::read(
+      data, [&](const int group, const int dataset, const QString &value) {
+        if (group >= groups.count())
+          return false;
+
+        auto &datasets = groups[group].m_datasets;
+        if (dataset >= datasets.count())
+          return false;
+
+        ++count;
+        auto &target = datasets[dataset];
+        const auto &text = value.isEmpty() ? QStringLiteral("--.--") : value;
+        if (target.setValue(text))
+          groups[group].m_valueGeneration = target.valueGeneration();
+
+        return true;
+      });
+
+  // Every dataset of the current frame must have received a value
+  int total = 0;
+  for (const auto &group : std::as_const(groups))
+    total += group.datasetCount();
+
+  return ok && count == total;
+}
+
+/**
+ * Parses every frame of the given batch, in order, within a single event of
+ * the main thread.
+ */
+void JSON::FrameBuilder::readFrames(const IO::FrameBatch &frames)
+{
+  // Report how long the oldest frame of the batch waited to be parsed
+  if (!frames.isEmpty() && frames.first().timestamp > 0)
+  {
+    const auto now = Misc::PipelineStats::timestamp();
+    const auto lag = now - frames.first().timestamp;
+    Misc::OverloadController::instance().reportQueue(
+        Misc::OverloadController::ParserLag, lag, kMaxParserLag);
+  }
+
+  for (const auto &frame : frames)
+    readData(frame.data, frame.timestamp, frame.source);
+}
+
 /**
  * Tries to parse the given data as a JSON document according to the selected
  * operation mode.
@@ -276,118 +1211,360 @@ void JSON::FrameBuilder::setJsonPathSetting(const QString &path)
  *
  * If JSON parsing is successfull, then the class shall notify the rest of the
  * application in order to process packet data.
+ *
+ * The @a timestamp at which the I/O driver received the frame is attached to
+ * the published @c JSON::Frame, so that end-to-end latency can be measured.
+ * The @a source of the frame selects the clock estimator of device
+ * timestamps.
  */
-void JSON::FrameBuilder::readData(const QByteArray &data)
+void JSON::FrameBuilder::readData(const QByteArray &data,
+                                  const qint64 timestamp, const int source)
 {
+  TRACE_ZONE("FrameBuilder::readData");
+
   // Data empty, abort
   if (data.isEmpty())
     return;
 
+  // Obtain the time at which processing started
+  auto &stats = Misc::PipelineStats::instance();
+  const auto start = stats.timestamp();
+
   // Serial device sends JSON (auto mode)
   if (operationMode() == SerialStudio::DeviceSendsJSON)
   {
-    auto jsonData = QJsonDocument::fromJson(data).object();
-    if (m_frame.read(jsonData))
-      Q_EMIT frameChanged(m_frame);
-  }
-
-  // Data is separated and parsed by Serial Studio project
-  else if (operationMode() == SerialStudio::ProjectFile && m_frameParser)
-  {
-    // Obtain state of the app
-    const bool csvPlaying = CSV::Player::instance().isOpen();
+    // Fixed layout, only update the dataset values of the current frame
+    if (m_fixedJsonLayout && m_jsonLayoutReady && updateJsonValues(data))
+    {
+      m_imuFusion.process(m_frame.m_groups, m_frame.generation(), timestamp);
+      m_frame.m_timestamp = timestamp;
+      m_frame.markChangedDatasets();
+      publishFrame(m_frame);
+    }
 
-    // Real-time data, parse data & perform conversion
-    QStringList fields;
-    if (!csvPlaying)
+    // Build a new frame from the JSON document
+    else
     {
-      // Convert binary frame data to a string
-      QString frameData;
-      switch (JSON::ProjectModel::instance().decoderMethod())
+      auto jsonData = QJsonDocument::fromJson(data).object();
+      m_jsonLayoutReady = m_frame.read(jsonData);
+      if (m_jsonLayoutReady)
       {
-        case SerialStudio::PlainText:
-          frameData = QString::fromUtf8(data);
-          break;
-        case SerialStudio::Hexadecimal:
-          frameData = QString::fromUtf8(data.toHex());
-          break;
-        case SerialStudio::Base64:
-          frameData = QString::fromUtf8(data.toBase64());
-          break;
-        default:
-          frameData = QString::fromUtf8(data);
-          break;
+        m_imuFusion.process(m_frame.m_groups, m_frame.generation(),
+                            timestamp);
+        m_frame.m_timestamp = timestamp;
+        m_frame.markChangedDatasets();
+        publishFrame(m_frame);
       }
 
-      // Get fields from frame parser function
-      fields = m_frameParser->parse(frameData);
+      else
+        stats.recordDrops(Misc::PipelineStats::FrameParser);
     }
+  }
 
+  // Data is separated and parsed by Serial Studio project
+  else if (operationMode() == SerialStudio::ProjectFile)
+  {
     // CSV data, no need to perform conversions or use frame parser
-    else
-      fields = QString::fromUtf8(data.simplified()).split(',');
+    if (CSV::Player::instance().isOpen())
+      updateFrame(QString::fromUtf8(data.simplified()).split(','), timestamp);
 
-    // Replace data in frame
-    for (auto g = m_frame.m_groups.begin(); g != m_frame.m_groups.end(); ++g)
+    // Parser plugin, values are assigned without text conversion
+    else if (m_pluginParser.isEnabled())
     {
-      for (auto d = g->m_datasets.begin(); d != g->m_datasets.end(); ++d)
+      const auto count = m_pluginParser.parse(data, m_pluginValues.data());
+      if (count > 0)
+        updateFrame(m_pluginValues.constData(), count, timestamp);
+      else
+        stats.recordDrops(Misc::PipelineStats::FrameParser);
+    }
+
+    // Native parser, binary data is decoded without text conversion
+    else if (m_nativeParser.isEnabled())
+    {
+      const auto decoder = JSON::ProjectModel::instance().decoderMethod();
+      if (m_nativeParser.isBinary() || decoder == SerialStudio::Binary)
+      {
+        const auto fields = m_nativeParser.parse(data);
+        if (!fields.isEmpty())
+          updateFrame(fields, timestamp, source);
+      }
+
+      else
       {
-        const auto index = d->index();
-        if (index <= fields.count())
-          d->m_value = fields.at(index - 1);
+        const auto frame = JSON::ParserEngine::decodeFrame(data, decoder);
+        updateFrame(m_nativeParser.parse(frame), timestamp, source);
       }
     }
 
-    // Update user interface
-    Q_EMIT frameChanged(m_frame);
+    // JS frame parser, queue frames & parse them on the parser thread
+    else
+    {
+      m_pendingFrames.append(data);
+      m_pendingSources.append(source);
+      m_pendingTimestamps.append(timestamp);
+      if (m_pendingFrames.count() == 1)
+        m_pendingSince = start;
+
+      if (m_pendingFrames.count() == 1 && idleParserWorker())
+        QMetaObject::invokeMethod(this, &JSON::FrameBuilder::parsePendingFrames,
+                                  Qt::QueuedConnection);
+
+      return;
+    }
   }
 
   // Data is separated by comma separated values
   else if (operationMode() == SerialStudio::QuickPlot)
   {
-    // Obtain fields from data frame
-    auto fields = data.split(',');
+    // Rebuild the frame structure only if the number of channels changed
+    const auto channels = int(data.count(',')) + 1;
+    if (m_quickPlotFrame.groupCount() == 0
+        || m_quickPlotFrame.m_groups.first().datasetCount() != channels)
+      buildQuickPlotFrame(channels);
 
-    // Create datasets from the data
-    int channel = 1;
-    QVector<JSON::Dataset> datasets;
-    for (const auto &field : fields)
+    // Split & convert all the fields in a single pass
+    m_fieldEnds.resize(channels);
+    m_fieldValid.resize(channels);
+    m_fieldValues.resize(channels);
+    const auto *ptr = data.constData();
+    SIMD::parseNumbers(ptr, data.size(), ',', m_fieldValues.data(),
+                       m_fieldValid.data(), m_fieldEnds.data(), channels);
+
+    // Update the values of each channel
+    auto &groups = m_quickPlotFrame.m_groups;
+    qsizetype start = 0;
+    for (int channel = 0; channel < channels; ++channel)
     {
-      JSON::Dataset dataset;
-      dataset.m_index = channel;
-      dataset.m_title = tr("Channel %1").arg(channel);
-      dataset.m_value = QString::fromUtf8(field);
-      dataset.m_graph = false;
-      datasets.append(dataset);
+      // Only changed channels are copied to the multiplot group
+      const auto end = m_fieldEnds[channel];
+      auto &dataset = groups[0].m_datasets[channel];
+      if (dataset.setValue(QString::fromUtf8(ptr + start, end - start),
+                           m_fieldValues[channel], m_fieldValid[channel]))
+      {
+        groups[0].m_valueGeneration = dataset.m_valueGeneration;
+        if (groups.count() > 1)
+        {
+          auto &plot = groups[1].m_datasets[channel];
+          plot.m_value = dataset.m_value;
+          plot.m_isNumeric = dataset.m_isNumeric;
+          plot.m_numericValue = dataset.m_numericValue;
+          plot.m_valueGeneration = dataset.m_valueGeneration;
+          groups[1].m_valueGeneration = dataset.m_valueGeneration;
+        }
+      }
 
-      ++channel;
+      start = end + 1;
     }
 
-    // Create a project frame from the groups
-    JSON::Frame frame;
-    frame.m_title = tr("Quick Plot");
+    m_quickPlotFrame.m_timestamp = timestamp;
+    m_quickPlotFrame.markChangedDatasets();
+    publishFrame(m_quickPlotFrame);
+  }
 
-    // Create a datagrid group from the dataset array
-    JSON::Group datagrid;
-    datagrid.m_datasets = datasets;
-    datagrid.m_title = tr("Data Grid");
-    datagrid.m_widget = QStringLiteral("datagrid");
-    for (int i = 0; i < datagrid.m_datasets.count(); ++i)
-      datagrid.m_datasets[i].m_graph = true;
+  // Register the frame for the pipeline statistics
+  stats.record(Misc::PipelineStats::FrameParser, 1, data.size(),
+               stats.timestamp() - start);
+}
 
-    // Append datagrid to frame
-    frame.m_groups.append(datagrid);
+/**
+ * @brief Builds the flat map of parsed frame fields to the datasets of the
+ *        project frame.
+ *
+ * Each slot maps a zero-based field column to a group & dataset position. The
+ * slots are sorted by column, so that assigning a parsed frame is a single
+ * linear pass that stops at the first column missing from the frame.
+ *
+ * Datasets with a frame index below 1, or above the number of fields decoded
+ * by a binary native parser, are left out of the map.
+ *
+ * Datasets with an expression are not read from a field, their expression is
+ * compiled instead and their frame index only identifies them.
+ *
+ * The filters of the datasets are built again as well, which resets their
+ * state.
+ *
+ * @param errors Receives the titles & compilation errors of the datasets with
+ *               an invalid expression.
+ * @param filters Receives the titles & errors of the datasets with an invalid
+ *                filter.
+ *
+ * @return The titles of the datasets with an invalid frame index.
+ */
+QStringList JSON::FrameBuilder::buildDatasetMap(QStringList *errors,
+                                                QStringList *filters)
+{
+  QStringList invalid;
+  m_arraySlots.clear();
+  m_datasetSlots.clear();
+  m_expressionSlots.clear();
+  m_datasetMapGeneration = m_frame.generation();
+
+  // Number of fields in each frame, 0 if unknown
+  qsizetype fieldCount = 0;
+  if (m_pluginParser.isEnabled())
+    fieldCount = m_pluginParser.capacity();
+  else if (m_nativeParser.isBinary())
+    fieldCount = m_nativeParser.fieldCount();
 
-    // Create a multiplot group when multiple datasets are found
-    if (datasets.count() > 1)
+  // Register the slot of each dataset
+  const auto &groups = m_frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &datasets = groups.at(g).datasets();
+    for (int d = 0; d < datasets.count(); ++d)
     {
-      JSON::Group plots;
-      plots.m_datasets = datasets;
-      plots.m_title = tr("Multiple Plots");
-      plots.m_widget = QStringLiteral("multiplot");
-      frame.m_groups.append(plots);
+      // Compile the expression of computed datasets
+      const auto &source = datasets.at(d).expression();
+      if (!source.isEmpty())
+      {
+        ExpressionSlot slot{g, d, {}};
+        if (slot.expression.compile(source))
+          m_expressionSlots.append(std::move(slot));
+
+        else if (errors)
+          errors->append(QStringLiteral("%1 / %2: %3")
+                             .arg(groups.at(g).title(), datasets.at(d).title(),
+                                  slot.expression.errorString()));
+
+        continue;
+      }
+
+      // Validate the frame index of the dataset
+      const auto index = datasets.at(d).index();
+      if (index < 1 || (fieldCount > 0 && index > fieldCount))
+      {
+        invalid.append(QStringLiteral("%1 / %2 (%3)")
+                           .arg(groups.at(g).title(), datasets.at(d).title())
+                           .arg(index));
+        continue;
+      }
+
+      // Array datasets are assigned sample by sample
+      if (datasets.at(d).isArray())
+      {
+        const auto period = qRound64(1e9 / datasets.at(d).sampleRate());
+        m_arraySlots.append({index - 1, g, d, period, {}});
+        continue;
+      }
+
+      m_datasetSlots.append({index - 1, g, d});
     }
+  }
+
+  // Sort slots by column, keep the frame order for shared columns
+  std::stable_sort(m_datasetSlots.begin(), m_datasetSlots.end(),
+                   [](const DatasetSlot &a, const DatasetSlot &b) {
+                     return a.column < b.column;
+                   });
 
-    Q_EMIT frameChanged(frame);
+  // Build the filters of the datasets
+  const auto filterErrors = m_filters.build(m_frame);
+  if (filters)
+    filters->append(filterErrors);
+
+  return invalid;
+}
+
+/**
+ * @brief Builds the structure of the frame used in quick plot mode.
+ *
+ * The frame contains a data grid with one dataset per channel, and a
+ * multiplot group when more than one channel is found. The structure is
+ * cached and only the dataset values are updated for each received line, so
+ * that the titles & groups are not re-created for every frame.
+ *
+ * When the I/O manager merges the frames of several sources, each dataset
+ * title is tagged with the name of the source that provides the channel.
+ *
+ * @param channels The number of comma-separated channels in each frame.
+ */
+void JSON::FrameBuilder::buildQuickPlotFrame(const int channels)
+{
+  // Obtain the source of each channel, if frames are merged
+  QStringList tags;
+  const auto &layout = IO::Manager::instance().mergedLayout();
+  for (const auto &source : layout)
+  {
+    for (int i = 1; i <= source.channels; ++i)
+      tags.append(tr("%1 · Channel %2").arg(source.name).arg(i));
   }
+
+  if (tags.count() != channels)
+    tags.clear();
+
+  // Create datasets for each channel
+  QVector<JSON::Dataset> datasets;
+  datasets.reserve(channels);
+  for (int channel = 1; channel <= channels; ++channel)
+  {
+    JSON::Dataset dataset;
+    dataset.m_index = channel;
+    dataset.m_graph = false;
+    if (tags.isEmpty())
+      dataset.m_title = tr("Channel %1").arg(channel);
+    else
+      dataset.m_title = tags.at(channel - 1);
+
+    datasets.append(dataset);
+  }
+
+  // Create a project frame from the groups
+  m_quickPlotFrame.clear();
+  m_quickPlotFrame.m_title = tr("Quick Plot");
+
+  // Create a datagrid group from the dataset array
+  JSON::Group datagrid;
+  datagrid.m_datasets = datasets;
+  datagrid.m_title = tr("Data Grid");
+  datagrid.m_widget = QStringLiteral("datagrid");
+  for (int i = 0; i < datagrid.m_datasets.count(); ++i)
+    datagrid.m_datasets[i].m_graph = true;
+
+  // Append datagrid to frame
+  m_quickPlotFrame.m_groups.append(datagrid);
+
+  // Create a multiplot group when multiple datasets are found
+  if (datasets.count() > 1)
+  {
+    JSON::Group plots;
+    plots.m_datasets = datasets;
+    plots.m_title = tr("Multiple Plots");
+    plots.m_widget = QStringLiteral("multiplot");
+    m_quickPlotFrame.m_groups.append(plots);
+  }
+}
+
+/**
+ * @brief Publishes a @a frame whose values were assigned by another source.
+ *
+ * Used by @c Plugins::Viewer to show the frames of a remote Serial Studio
+ * node, which were already parsed, filtered & computed by the node. The
+ * frame is published as if it had been built locally, so that the dashboard
+ * & the exporters do not need to know where it came from.
+ *
+ * @param frame     Frame with the new values, owned by the caller.
+ * @param timestamp The sampling time of the frame.
+ */
+void JSON::FrameBuilder::readFrame(JSON::Frame &frame, const qint64 timestamp)
+{
+  if (!frame.isValid())
+    return;
+
+  frame.m_timestamp = timestamp;
+  frame.markChangedDatasets();
+  publishFrame(frame);
+}
+
+/**
+ * @brief Publishes the given working @a frame.
+ *
+ * The frame is first written to its slot of the frame bus, and then emitted
+ * through the @c frameChanged() signal as a copy of the frame pool. Receivers
+ * of the signal can thus rely on the bus already holding the frame.
+ */
+void JSON::FrameBuilder::publishFrame(const JSON::Frame &frame)
+{
+  m_frameBus.publish(
+      [&](JSON::Frame &slot) { JSON::FramePool::assign(slot, frame); });
+  Q_EMIT frameChanged(m_framePool.publish(frame));
 }
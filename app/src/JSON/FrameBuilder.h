@@ -22,8 +22,14 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include <QMap>
 #include <QFile>
 #include <QObject>
+#include <QTimer>
+#include <QThread>
 #include <QSettings>
 #include <QJsonArray>
 #include <QJsonValue>
@@ -31,9 +37,24 @@
 #include <QJsonDocument>
 
 #include "SerialStudio.h"
+#include "IO/FrameBatch.h"
 
 #include "JSON/Frame.h"
+#include "JSON/ClockSync.h"
+#include "JSON/FramePool.h"
+#include "JSON/Expression.h"
+#include "JSON/ImuFusion.h"
+#include "JSON/FilterBank.h"
 #include "JSON/FrameParser.h"
+#include "JSON/NativeParser.h"
+#include "JSON/ParserEngine.h"
+#include "JSON/PluginParser.h"
+
+namespace Misc
+{
+class Benchmark;
+class Corpus;
+}
 
 namespace JSON
 {
@@ -47,6 +68,26 @@ namespace JSON
  *
  * This frame is later shared with the rest of the modules, and is updated
  * automatically with new incoming raw data.
+ *
+ * Projects can declare a field that contains a frame counter sent by the
+ * device (@c "sequenceField", using the same 1-based numbering as the frame
+ * index of the datasets). Jumps in that counter are reported as missing
+ * device frames to @c Misc::PipelineStats.
+ *
+ * Projects can also declare a field that contains a microsecond counter sent
+ * by the device (@c "timestampField", with a @c "timestampBits" wide counter).
+ * The time of each frame is then the device time mapped to the host clock by
+ * a @c JSON::ClockSync estimator of the source of the frame, which is used by
+ * the plots & exporters instead of the bursty arrival time.
+ *
+ * The working frames of the builder are never shared, each frame is published
+ * through a @c JSON::FramePool copy instead, so that updating the values of
+ * the next frame does not allocate memory.
+ *
+ * Every frame is also published to the @c frameBus() ring before the
+ * @c frameChanged() signal is emitted. Consumers with their own pace (the
+ * dashboard, the CSV export & the plugin server) read the frames from
+ * the ring with their own cursor, instead of queuing copies of them.
  */
 class FrameBuilder : public QObject
 {
@@ -62,11 +103,21 @@ class FrameBuilder : public QObject
              READ operationMode
              WRITE setOperationMode
              NOTIFY operationModeChanged)
+  Q_PROPERTY(bool fixedJsonLayout
+             READ fixedJsonLayout
+             WRITE setFixedJsonLayout
+             NOTIFY fixedJsonLayoutChanged)
+  Q_PROPERTY(int parserTimeBudget
+             READ parserTimeBudget
+             WRITE setParserTimeBudget
+             NOTIFY parserTimeBudgetChanged)
   // clang-format on
 
 signals:
   void jsonFileMapChanged();
   void operationModeChanged();
+  void fixedJsonLayoutChanged();
+  void parserTimeBudgetChanged();
   void frameChanged(const JSON::Frame &frame);
 
 private:
@@ -79,14 +130,26 @@ private:
 public:
   static FrameBuilder &instance();
 
+  [[nodiscard]] bool fixedJsonLayout() const;
+  [[nodiscard]] int parserTimeBudget() const;
   [[nodiscard]] QString jsonMapFilepath() const;
   [[nodiscard]] QString jsonMapFilename() const;
+  [[nodiscard]] JSON::FrameBus &frameBus();
   [[nodiscard]] JSON::FrameParser *frameParser() const;
+  [[nodiscard]] const JSON::NativeParser &nativeParser() const;
   [[nodiscard]] SerialStudio::OperationMode operationMode() const;
 
+  void readSamples(const double *samples, const qsizetype frames,
+                   const int channels, const qint64 timestamp,
+                   const qint64 period);
+  void readFrame(JSON::Frame &frame, const qint64 timestamp);
+
 public slots:
   void loadJsonMap();
   void setupExternalConnections();
+  void readFields(const QList<QStringList> &frames);
+  void setFixedJsonLayout(const bool enabled);
+  void setParserTimeBudget(const int budget);
   void loadJsonMap(const QString &path);
   void setFrameParser(JSON::FrameParser *editor);
   void setOperationMode(const SerialStudio::OperationMode mode);
@@ -95,13 +158,137 @@ public slots:
   void setJsonPathSetting(const QString &path);
 
 private slots:
-  void readData(const QByteArray &data);
+  void loadParserScript();
+  void parsePendingFrames();
+  void readFrames(const IO::FrameBatch &frames);
+  void readData(const QByteArray &data, const qint64 timestamp = 0,
+                const int source = 0);
+
+private:
+  struct DatasetSlot
+  {
+    int column;
+    int group;
+    int dataset;
+  };
+
+  /**
+   * @brief Dataset that receives a block of samples in its frame field.
+   */
+  struct ArraySlot
+  {
+    int column;
+    int group;
+    int dataset;
+    qint64 period;
+    QVector<double> samples;
+  };
+
+  /**
+   * @brief Dataset whose value is computed from the fields of the frame.
+   */
+  struct ExpressionSlot
+  {
+    int group;
+    int dataset;
+    JSON::Expression expression;
+  };
+
+  /**
+   * @brief Frames handed to a parser thread & the fields obtained from them.
+   */
+  struct ParsedBatch
+  {
+    qint64 since = 0;
+    quint64 bytes = 0;
+    QList<int> sources;
+    QList<qint64> timestamps;
+    QList<QStringList> results;
+  };
+
+  /**
+   * @brief Parser thread with its own JS engine & time budget watchdog.
+   */
+  struct ParserWorker
+  {
+    bool busy = false;
+    quint64 sequence = 0;
+    ParsedBatch batch;
+    QTimer watchdog;
+    QThread thread;
+    JSON::ParserEngine engine;
+  };
+
+  void readJsonMap(const QString &path, const bool userAction);
+  [[nodiscard]] bool trustParserPlugin(const QString &library,
+                                       const bool userAction);
+
+  void addParserWorker();
+  [[nodiscard]] ParserWorker *idleParserWorker() const;
+  void onFramesParsed(ParserWorker *worker, const QList<QStringList> &results);
+
+  [[nodiscard]] QStringList buildDatasetMap(QStringList *errors = nullptr,
+                                            QStringList *filters = nullptr);
+  void buildQuickPlotFrame(const int channels);
+  void publishFrame(const JSON::Frame &frame);
+  void updateFrame(const QStringList &fields, const qint64 timestamp = 0,
+                   const int source = 0);
+  void updateFrame(const double *values, const qsizetype count,
+                   const qint64 timestamp);
+  void checkSequence(const QString &field);
+  void finishFrame(const qint64 timestamp);
+  [[nodiscard]] qsizetype readArrays(const QStringList &fields);
+  void publishArrays(const qint64 timestamp, const qsizetype rows);
+  void evaluateExpressions(const double *values, const qsizetype count);
+  [[nodiscard]] qint64 deviceTime(const QString &field, const qint64 timestamp,
+                                  const int source);
+  [[nodiscard]] bool updateJsonValues(const QByteArray &data);
 
 private:
   QFile m_jsonMap;
   JSON::Frame m_frame;
+  JSON::Frame m_quickPlotFrame;
+  JSON::FramePool m_framePool;
+  JSON::FrameBus m_frameBus;
+  JSON::FilterBank m_filters;
+  JSON::ImuFusion m_imuFusion;
+  QVector<bool> m_fieldValid;
+  QVector<double> m_fieldValues;
+  QVector<qsizetype> m_fieldEnds;
+  QVector<ArraySlot> m_arraySlots;
+  QVector<DatasetSlot> m_datasetSlots;
+  QVector<ExpressionSlot> m_expressionSlots;
+  quint64 m_datasetMapGeneration;
   QSettings m_settings;
   SerialStudio::OperationMode m_opMode;
   JSON::FrameParser *m_frameParser;
+  JSON::NativeParser m_nativeParser;
+  JSON::PluginParser m_pluginParser;
+  QVector<double> m_pluginValues;
+  QList<QByteArray> m_pendingFrames;
+  QList<int> m_pendingSources;
+  QList<qint64> m_pendingTimestamps;
+
+  bool m_fixedJsonLayout;
+  bool m_jsonLayoutReady;
+
+  int m_sequenceColumn;
+  bool m_sequenceValid;
+  quint64 m_lastSequence;
+
+  int m_timestampBits;
+  int m_timestampColumn;
+  QMap<int, JSON::ClockSync> m_clocks;
+
+  int m_parserTimeBudget;
+  int m_activeParserWorkers;
+  qint64 m_pendingSince;
+  quint64 m_dispatchSequence;
+  quint64 m_publishSequence;
+  QMap<quint64, ParsedBatch> m_parsedBatches;
+  std::vector<std::unique_ptr<ParserWorker>> m_parserWorkers;
+
+  friend class Misc::Benchmark;
+  friend class Misc::Corpus;
 };
 } // namespace JSON
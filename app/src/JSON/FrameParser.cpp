@@ -20,11 +20,13 @@
  * THE SOFTWARE.
  */
 
+#include <QSet>
 #include <QFile>
 #include <QJSEngine>
 #include <QFileDialog>
 #include <QLineNumberArea>
 #include <QDesktopServices>
+#include <QCryptographicHash>
 #include <QRegularExpression>
 #include <QJavascriptHighlighter>
 
@@ -159,31 +161,6 @@ bool JSON::FrameParser::isModified() const
   return false;
 }
 
-/**
- * @brief Executes the current frame parser function over the input data.
- *
- * @param frame current/latest frame data.
- *
- * @return An array of strings with the values returned by the JS frame parser.
- */
-QStringList JSON::FrameParser::parse(const QString &frame)
-{
-  // Construct function arguments
-  QJSValueList args;
-  args << frame;
-
-  // Evaluate frame parsing function
-  auto out = m_parseFunction.call(args).toVariant().toStringList();
-
-  // Convert output to QStringList
-  QStringList list;
-  for (auto i = 0; i < out.count(); ++i)
-    list.append(out.at(i));
-
-  // Return fields list
-  return list;
-}
-
 /**
  * @brief Returns @c true whenever if there are any actions that can be undone.
  */
@@ -237,14 +214,18 @@ bool JSON::FrameParser::save(const bool silent)
 }
 
 /**
- * @brief Generates a callable JS function given the script code.
+ * @brief Validates the given frame parser script code.
  *
  * This function validates that the given @a script data does not contain any
  * syntax errors and that it can be executed by the JavaScript Engine.
  *
- * If the conditions required to execute the frame parser code are met, this
- * function proceeds to generate a callable JS function that can be used
- * by the rest of the application modules.
+ * The engine of the code editor is only used for validation, frames are
+ * parsed by the @c JSON::ParserEngine of the frame builder, which runs in its
+ * own thread and loads the script once it is stored in the project model.
+ *
+ * Scripts are validated once per version: the hashes of the scripts that
+ * passed validation are remembered, and loading one of them again returns
+ * immediately instead of evaluating the script and its lookup tables again.
  *
  * @param script JavaScript code
  *
@@ -252,9 +233,19 @@ bool JSON::FrameParser::save(const bool silent)
  */
 bool JSON::FrameParser::loadScript(const QString &script)
 {
+  // Skip scripts that have already been validated
+  static QSet<QByteArray> validated;
+  const auto hash = QCryptographicHash::hash(script.toUtf8(),
+                                             QCryptographicHash::Sha1);
+  if (validated.contains(hash))
+    return true;
+
   // Ensure that engine is configured correctly
   m_engine.installExtensions(QJSEngine::AllExtensions);
 
+  // Forget the function declared by the previously validated script
+  m_engine.globalObject().setProperty("parse", QJSValue::UndefinedValue);
+
   // Check if there are no general JS errors
   QStringList errors;
   m_engine.evaluate(script, "", 1, &errors);
@@ -310,8 +301,8 @@ bool JSON::FrameParser::loadScript(const QString &script)
     return false;
   }
 
-  // We have reached this point without any errors, set function caller
-  m_parseFunction = fun;
+  // We have reached this point without any errors
+  validated.insert(hash);
   return true;
 }
 
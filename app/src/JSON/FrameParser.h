@@ -51,7 +51,6 @@ public:
 
   [[nodiscard]] QString text() const;
   [[nodiscard]] bool isModified() const;
-  [[nodiscard]] QStringList parse(const QString &frame);
 
   [[nodiscard]] bool undoAvailable() const;
   [[nodiscard]] bool redoAvailable() const;
@@ -100,6 +99,5 @@ private:
   QJSEngine m_engine;
   QSyntaxStyle m_style;
   QCodeEditor m_widget;
-  QJSValue m_parseFunction;
 };
 } // namespace JSON
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "JSON/FramePool.h"
+
+/**
+ * Smallest & largest number of frames that the pool can hold
+ */
+static constexpr int kMinPooledFrames = 4;
+static constexpr int kMaxPooledFrames = 1024;
+
+/**
+ * Memory budget (in bytes) used to bound the number of pooled frames
+ */
+static constexpr qsizetype kMaxPoolMemory = 16 * 1024 * 1024;
+
+/**
+ * Constructor function, the pool starts empty
+ */
+JSON::FramePool::FramePool()
+  : m_next(0)
+  , m_capacity(kMinPooledFrames)
+  , m_generation(0)
+  , m_allocations(0)
+{
+}
+
+/**
+ * Releases the pooled frames, frames still held by consumers remain valid
+ */
+void JSON::FramePool::clear()
+{
+  m_next = 0;
+  m_generation = 0;
+  m_frames.clear();
+  m_frames.shrink_to_fit();
+}
+
+/**
+ * Returns the number of frames held by the pool
+ */
+int JSON::FramePool::size() const
+{
+  return static_cast<int>(m_frames.size());
+}
+
+/**
+ * Returns the number of pooled frames allocated since the pool was created
+ */
+quint64 JSON::FramePool::allocations() const
+{
+  return m_allocations;
+}
+
+/**
+ * @brief Returns a pooled copy of the given @a frame, to be published.
+ *
+ * The first pooled frame that is no longer held by any consumer receives the
+ * values of @a frame. A new pooled frame is allocated if every pooled frame is
+ * still in use, or if the structure of @a frame changed.
+ */
+const JSON::Frame &JSON::FramePool::publish(const JSON::Frame &frame)
+{
+  // Drop the pooled frames of the previous structure
+  if (frame.generation() != m_generation)
+  {
+    clear();
+    m_generation = frame.generation();
+
+    const auto bytes = qMax<qsizetype>(1, frame.memoryUsage());
+    m_capacity = static_cast<int>(qBound<qsizetype>(
+        kMinPooledFrames, kMaxPoolMemory / bytes, kMaxPooledFrames));
+  }
+
+  // Reuse the oldest pooled frame released by every consumer
+  const auto count = size();
+  for (int i = 0; i < count; ++i)
+  {
+    const auto index = (m_next + i) % count;
+    auto &pooled = m_frames[index];
+    if (!isShared(pooled))
+    {
+      copyValues(pooled, frame);
+      m_next = (index + 1) % count;
+      return pooled;
+    }
+  }
+
+  // Grow the pool while it is below its capacity
+  if (count < m_capacity)
+  {
+    m_frames.emplace_back();
+    allocate(m_frames.back(), frame);
+    m_next = 0;
+    return m_frames.back();
+  }
+
+  // Replace the oldest pooled frame, consumers keep their copy of it
+  auto &oldest = m_frames[m_next];
+  allocate(oldest, frame);
+  m_next = (m_next + 1) % count;
+  return oldest;
+}
+
+/**
+ * @brief Copies @a source to @a target, reusing the storage of @a target.
+ *
+ * If both frames have the same structure only the changed values are copied,
+ * otherwise @a target becomes a copy of @a source that does not share its
+ * groups & datasets with it. Used to update frames that are overwritten in
+ * place, such as the slots of the frame bus.
+ */
+void JSON::FramePool::assign(JSON::Frame &target, const JSON::Frame &source)
+{
+  if (target.generation() == source.generation())
+    copyValues(target, source);
+
+  else
+  {
+    target = source;
+    detach(target);
+  }
+}
+
+/**
+ * Ensures that the groups, the datasets & the changed dataset bitmap of the
+ * given @a frame are not shared with any other frame.
+ */
+void JSON::FramePool::detach(JSON::Frame &frame)
+{
+  frame.m_groups.detach();
+  for (auto &group : frame.m_groups)
+    group.m_datasets.detach();
+
+  frame.m_changedDatasets.detach();
+}
+
+/**
+ * Makes @a target an unshared copy of @a source & counts the allocation
+ */
+void JSON::FramePool::allocate(JSON::Frame &target, const JSON::Frame &source)
+{
+  target = source;
+  detach(target);
+  ++m_allocations;
+}
+
+/**
+ * Returns @c true if a consumer still holds a copy of the given pooled
+ * @a frame, or of one of its groups.
+ */
+bool JSON::FramePool::isShared(const JSON::Frame &frame)
+{
+  const auto &changed = frame.m_changedDatasets;
+  if (!changed.isEmpty() && !changed.isDetached())
+    return true;
+
+  if (!frame.m_groups.isEmpty() && !frame.m_groups.isDetached())
+    return true;
+
+  for (const auto &group : frame.m_groups)
+  {
+    if (!group.m_datasets.isEmpty() && !group.m_datasets.isDetached())
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Copies the values of @a source to the pooled frame @a target.
+ *
+ * Both frames must have the same structure. Only the groups & datasets whose
+ * value generation differs are copied, and the changed dataset bitmap is
+ * copied bit by bit so that it is not shared with @a source. Storage of
+ * @a target that is still shared with a consumer is detached on write.
+ */
+void JSON::FramePool::copyValues(JSON::Frame &target, const JSON::Frame &source)
+{
+  Q_ASSERT(target.generation() == source.generation());
+
+  // Copy the frame time & the changed dataset bitmap
+  target.m_timestamp = source.m_timestamp;
+  target.m_publishedValueGeneration = source.m_publishedValueGeneration;
+  const auto &changed = source.m_changedDatasets;
+  target.m_changedDatasets.resize(changed.size());
+  for (qsizetype i = 0; i < changed.size(); ++i)
+    target.m_changedDatasets.setBit(i, changed.testBit(i));
+
+  // Copy the values of the groups & datasets that changed
+  for (qsizetype g = 0; g < source.m_groups.count(); ++g)
+  {
+    const auto &from = source.m_groups[g];
+    auto &to = target.m_groups[g];
+    if (to.m_valueGeneration == from.m_valueGeneration)
+      continue;
+
+    to.m_yaw = from.m_yaw;
+    to.m_roll = from.m_roll;
+    to.m_pitch = from.m_pitch;
+    to.m_valueGeneration = from.m_valueGeneration;
+    for (qsizetype d = 0; d < from.m_datasets.count(); ++d)
+    {
+      const auto &value = from.m_datasets[d];
+      auto &dataset = to.m_datasets[d];
+      if (dataset.m_valueGeneration == value.m_valueGeneration)
+        continue;
+
+      dataset.m_value = value.m_value;
+      dataset.m_rawValue = value.m_rawValue;
+      dataset.m_isNumeric = value.m_isNumeric;
+      dataset.m_numericValue = value.m_numericValue;
+      dataset.m_valueGeneration = value.m_valueGeneration;
+    }
+  }
+}
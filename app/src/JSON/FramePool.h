@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "JSON/Frame.h"
+
+namespace JSON
+{
+/**
+ * @class JSON::FramePool
+ * @brief Recycles the frames published by the frame builder.
+ *
+ * Published frames are queued by value by every consumer (the dashboard, the
+ * exporters, the plugin server, etc.). If the frame builder published its own
+ * working frame, the next parsed frame would detach it from those copies,
+ * allocating new group & dataset vectors for every frame.
+ *
+ * Instead, the working frame is never shared. Each frame is published through
+ * a pooled frame with the same structure, owned by the pool, whose values are
+ * overwritten in place once every consumer released its copy. Project strings
+ * (titles, units, etc.) are implicitly shared by all the pooled frames, so
+ * only the dataset values are copied, and only for the datasets that changed.
+ *
+ * Pooled frames are allocated when the structure of the frame changes, or
+ * when consumers hold more frames than the pool has. Once the pool has grown
+ * to the number of frames held by the consumers, publishing a frame does not
+ * allocate memory. The pool is bounded, beyond that limit its oldest frame is
+ * replaced by a new copy.
+ */
+class FramePool
+{
+public:
+  FramePool();
+
+  void clear();
+  [[nodiscard]] int size() const;
+  [[nodiscard]] quint64 allocations() const;
+  [[nodiscard]] const JSON::Frame &publish(const JSON::Frame &frame);
+
+  static void assign(JSON::Frame &target, const JSON::Frame &source);
+
+private:
+  static void detach(JSON::Frame &frame);
+  void allocate(JSON::Frame &target, const JSON::Frame &source);
+  [[nodiscard]] static bool isShared(const JSON::Frame &frame);
+  static void copyValues(JSON::Frame &target, const JSON::Frame &source);
+
+private:
+  int m_next;
+  int m_capacity;
+  quint64 m_generation;
+  quint64 m_allocations;
+  std::vector<JSON::Frame> m_frames;
+};
+} // namespace JSON
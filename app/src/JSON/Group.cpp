@@ -30,6 +30,11 @@ JSON::Group::Group(const int groupId)
   : m_groupId(groupId)
   , m_title("")
   , m_widget("")
+  , m_refreshClass("")
+  , m_valueGeneration(JSON::Dataset::nextValueGeneration())
+  , m_yaw(0)
+  , m_roll(0)
+  , m_pitch(0)
 {
 }
 
@@ -63,6 +68,9 @@ QJsonObject JSON::Group::serialize() const
   object.insert(QStringLiteral("title"), m_title.simplified());
   object.insert(QStringLiteral("widget"), m_widget.simplified());
   object.insert(QStringLiteral("datasets"), datasetArray);
+  if (!m_refreshClass.isEmpty())
+    object.insert(QStringLiteral("refresh"), m_refreshClass);
+
   return object;
 }
 
@@ -80,12 +88,14 @@ bool JSON::Group::read(const QJsonObject &object)
     const auto array = object.value(QStringLiteral("datasets")).toArray();
     const auto title = object.value(QStringLiteral("title")).toString().simplified();
     const auto widget = object.value(QStringLiteral("widget")).toString().simplified();
+    const auto refresh = object.value(QStringLiteral("refresh")).toString().simplified();
     // clang-format on
 
     if (!title.isEmpty() && !array.isEmpty())
     {
       m_title = title;
       m_widget = widget;
+      m_refreshClass = refresh;
       m_datasets.clear();
       m_datasets.squeeze();
 
@@ -100,6 +110,7 @@ bool JSON::Group::read(const QJsonObject &object)
         }
       }
 
+      m_valueGeneration = JSON::Dataset::nextValueGeneration();
       return datasetCount() > 0;
     }
   }
@@ -123,6 +134,16 @@ const QString &JSON::Group::widget() const
   return m_widget;
 }
 
+/**
+ * @return The ID of the refresh class of the widgets generated by this group
+ *         ("realtime", "normal" or "low"), or an empty string to use the
+ *         default class of each widget type
+ */
+const QString &JSON::Group::refreshClass() const
+{
+  return m_refreshClass;
+}
+
 /**
  * @return The group groupId in the project array, only used for interacting
  *         with the project model (which is used to build the Project Editor
@@ -141,6 +162,39 @@ int JSON::Group::datasetCount() const
   return m_datasets.count();
 }
 
+/**
+ * @return The value generation of the group, which changes whenever the value
+ *         of any of its datasets is updated by the frame builder
+ */
+quint64 JSON::Group::valueGeneration() const
+{
+  return m_valueGeneration;
+}
+
+/**
+ * @return The fused yaw angle of a gyroscope group, from -180 to 180 degrees
+ */
+double JSON::Group::yaw() const
+{
+  return m_yaw;
+}
+
+/**
+ * @return The fused roll angle of a gyroscope group, from -180 to 180 degrees
+ */
+double JSON::Group::roll() const
+{
+  return m_roll;
+}
+
+/**
+ * @return The fused pitch angle of a gyroscope group, from -180 to 180 degrees
+ */
+double JSON::Group::pitch() const
+{
+  return m_pitch;
+}
+
 /**
  * @return A list with all the dataset objects contained in this group
  */
@@ -29,6 +29,11 @@ namespace UI
 class Dashboard;
 }
 
+namespace Plugins
+{
+class Viewer;
+}
+
 namespace JSON
 {
 class ProjectModel;
@@ -54,8 +59,16 @@ namespace JSON
  * A group contains the following properties:
  * - Title
  * - Widget
+ * - Refresh class of the dashboard widgets generated by the group (optional)
  * - A vector of datasets
+ *
+ * Gyroscope groups also carry the orientation (yaw, pitch & roll, in degrees)
+ * obtained by @c JSON::ImuFusion from their angular rates, so that widgets do
+ * not need to integrate the rates themselves.
  */
+class FilterBank;
+class ImuFusion;
+class FramePool;
 class FrameBuilder;
 class Group
 {
@@ -68,8 +81,13 @@ public:
 
   [[nodiscard]] int groupId() const;
   [[nodiscard]] int datasetCount() const;
+  [[nodiscard]] quint64 valueGeneration() const;
+  [[nodiscard]] double yaw() const;
+  [[nodiscard]] double roll() const;
+  [[nodiscard]] double pitch() const;
   [[nodiscard]] const QString &title() const;
   [[nodiscard]] const QString &widget() const;
+  [[nodiscard]] const QString &refreshClass() const;
   [[nodiscard]] const QVector<JSON::Dataset> &datasets() const;
   [[nodiscard]] const JSON::Dataset &getDataset(const int index) const;
 
@@ -77,10 +95,20 @@ private:
   int m_groupId;
   QString m_title;
   QString m_widget;
+  QString m_refreshClass;
   QVector<JSON::Dataset> m_datasets;
+  quint64 m_valueGeneration;
+
+  double m_yaw;
+  double m_roll;
+  double m_pitch;
 
   friend class UI::Dashboard;
+  friend class Plugins::Viewer;
   friend class JSON::ProjectModel;
+  friend class JSON::FilterBank;
+  friend class JSON::ImuFusion;
+  friend class JSON::FramePool;
   friend class JSON::FrameBuilder;
 };
 } // namespace JSON
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cmath>
+
+#include <QtMath>
+
+#include "SerialStudio.h"
+#include "JSON/ImuFusion.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Standard gravity, the accelerometer datasets are in m/s².
+ */
+static constexpr double kGravity = 9.80665;
+
+/**
+ * Range of accelerations (in g) in which the accelerometer is trusted to
+ * measure the direction of gravity.
+ */
+static constexpr double kMinGravity = 0.7;
+static constexpr double kMaxGravity = 1.3;
+
+/**
+ * Time constant (in seconds) of the complementary filter, the gyroscope is
+ * trusted for shorter periods & the accelerometer for longer periods.
+ */
+static constexpr double kTimeConstant = 1.0;
+
+/**
+ * Longest interval (in seconds) between two frames that is integrated, longer
+ * gaps (e.g. a paused device) restart the integration.
+ */
+static constexpr double kMaxDeltaT = 1.0;
+
+/**
+ * Wraps the given @a angle (in degrees) to the range from -180 to 180.
+ */
+static double wrapAngle(const double angle)
+{
+  auto wrapped = std::fmod(angle + 180.0, 360.0);
+  if (wrapped < 0)
+    wrapped += 360.0;
+
+  return wrapped - 180.0;
+}
+
+/**
+ * Creates a fusion stage without gyroscopes.
+ */
+JSON::ImuFusion::ImuFusion()
+  : m_generation(0)
+{
+}
+
+/**
+ * Restarts the orientation of every gyroscope from zero, e.g. when a new
+ * device is connected.
+ */
+void JSON::ImuFusion::reset()
+{
+  m_states.fill(State());
+}
+
+/**
+ * @brief Updates the orientation of the gyroscope groups of a frame.
+ *
+ * The location of the gyroscope & accelerometer datasets is obtained again
+ * when the structure @a generation of the frame changes. The estimated
+ * orientation is kept as long as the number of gyroscope groups does not
+ * change, so that frames that are rebuilt from JSON documents do not reset
+ * it.
+ *
+ * @param groups The groups of the frame, with the values of the new sample.
+ * @param generation The structure generation of the frame.
+ * @param timestamp The arrival time of the frame, or 0 to use the current
+ *                  time.
+ */
+void JSON::ImuFusion::process(QVector<JSON::Group> &groups,
+                              const quint64 generation, const qint64 timestamp)
+{
+  // Locate the datasets of the gyroscopes if the frame structure changed
+  if (m_generation != generation)
+  {
+    m_generation = generation;
+    build(groups);
+  }
+
+  // Nothing to do without gyroscopes
+  if (m_imus.isEmpty())
+    return;
+
+  // Obtain the time of the sample
+  const auto now = timestamp > 0 ? timestamp : Misc::SessionClock::now();
+
+  // Update the orientation of each gyroscope
+  for (int i = 0; i < m_imus.count(); ++i)
+  {
+    const auto &imu = m_imus.at(i);
+    auto &state = m_states[i];
+    auto &gyro = groups[imu.gyro];
+
+    // Obtain the time elapsed since the previous sample
+    double dt = 0;
+    if (state.timestamp > 0 && now > state.timestamp)
+      dt = (now - state.timestamp) / 1e9;
+
+    if (dt > kMaxDeltaT)
+      dt = 0;
+
+    state.timestamp = now;
+
+    // Integrate the angular rates
+    const auto rate = [&gyro](const int slot) {
+      return slot >= 0 ? gyro.m_datasets.at(slot).numericValue() : 0.0;
+    };
+
+    state.yaw += rate(imu.yaw) * dt;
+    state.roll += rate(imu.roll) * dt;
+    state.pitch += rate(imu.pitch) * dt;
+
+    // Correct the pitch & roll drift with the direction of gravity
+    if (imu.accel >= 0)
+    {
+      const auto &acc = groups.at(imu.accel);
+      const auto value = [&acc](const int slot) {
+        return slot >= 0 ? acc.m_datasets.at(slot).numericValue() : 0.0;
+      };
+
+      const auto ax = value(imu.x);
+      const auto ay = value(imu.y);
+      const auto az = value(imu.z);
+      const auto g = std::sqrt(ax * ax + ay * ay + az * az) / kGravity;
+      if (g > kMinGravity && g < kMaxGravity)
+      {
+        // Pitch rotates around the X axis & roll around the Y axis
+        const auto tilt = std::hypot(ay, az);
+        const auto pitch = qRadiansToDegrees(std::atan2(ay, az));
+        const auto roll = qRadiansToDegrees(std::atan2(-ax, tilt));
+        const auto weight = dt / (kTimeConstant + dt);
+        state.pitch += weight * wrapAngle(pitch - state.pitch);
+        state.roll += weight * wrapAngle(roll - state.roll);
+      }
+    }
+
+    // Normalize the angles
+    state.yaw = wrapAngle(state.yaw);
+    state.roll = wrapAngle(state.roll);
+    state.pitch = wrapAngle(state.pitch);
+
+    // Publish them in the gyroscope group, the dashboard only copies groups
+    // with a new value generation
+    if (gyro.m_yaw != state.yaw || gyro.m_roll != state.roll
+        || gyro.m_pitch != state.pitch)
+    {
+      gyro.m_yaw = state.yaw;
+      gyro.m_roll = state.roll;
+      gyro.m_pitch = state.pitch;
+      gyro.m_valueGeneration = JSON::Dataset::nextValueGeneration();
+    }
+  }
+}
+
+/**
+ * @brief Finds the gyroscope groups of a frame & pairs them with the
+ *        accelerometer groups.
+ *
+ * The rotation axes are identified by the widget of each dataset, as done by
+ * the gyroscope widget: "z"/"yaw", "y"/"roll" & "x"/"pitch".
+ */
+void JSON::ImuFusion::build(const QVector<JSON::Group> &groups)
+{
+  // Find the gyroscope & accelerometer groups
+  QVector<int> gyros;
+  QVector<int> accels;
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto widget = SerialStudio::getDashboardWidget(groups.at(g));
+    if (widget == SerialStudio::DashboardGyroscope)
+      gyros.append(g);
+    else if (widget == SerialStudio::DashboardAccelerometer)
+      accels.append(g);
+  }
+
+  // Locate the datasets of each gyroscope & of its accelerometer
+  m_imus.clear();
+  for (int i = 0; i < gyros.count(); ++i)
+  {
+    Imu imu{gyros.at(i), -1, -1, -1, -1, -1, -1, -1};
+    const auto &gyro = groups.at(imu.gyro);
+    for (int d = 0; d < gyro.datasetCount(); ++d)
+    {
+      const auto &widget = gyro.getDataset(d).widget();
+      if (widget == QStringLiteral("z") || widget == QStringLiteral("yaw"))
+      {
+        if (imu.yaw < 0)
+          imu.yaw = d;
+      }
+
+      else if (widget == QStringLiteral("y")
+               || widget == QStringLiteral("roll"))
+      {
+        if (imu.roll < 0)
+          imu.roll = d;
+      }
+
+      else if (widget == QStringLiteral("x")
+               || widget == QStringLiteral("pitch"))
+      {
+        if (imu.pitch < 0)
+          imu.pitch = d;
+      }
+    }
+
+    if (i < accels.count())
+    {
+      imu.accel = accels.at(i);
+      const auto &acc = groups.at(imu.accel);
+      for (int d = 0; d < acc.datasetCount(); ++d)
+      {
+        const auto &widget = acc.getDataset(d).widget();
+        if (imu.x < 0 && widget == QStringLiteral("x"))
+          imu.x = d;
+        else if (imu.y < 0 && widget == QStringLiteral("y"))
+          imu.y = d;
+        else if (imu.z < 0 && widget == QStringLiteral("z"))
+          imu.z = d;
+      }
+
+      // Gravity cannot be located without the three axes
+      if (imu.x < 0 || imu.y < 0 || imu.z < 0)
+        imu.accel = -1;
+    }
+
+    m_imus.append(imu);
+  }
+
+  // Keep the orientation unless the number of gyroscopes changed
+  if (m_states.count() != m_imus.count())
+  {
+    m_states.clear();
+    m_states.resize(m_imus.count());
+  }
+}
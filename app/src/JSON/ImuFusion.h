@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+
+#include "JSON/Group.h"
+
+namespace JSON
+{
+/**
+ * @class JSON::ImuFusion
+ * @brief Estimates the orientation of the gyroscope groups on every frame.
+ *
+ * The angular rates (in degrees per second) of each gyroscope group are
+ * integrated with the arrival time of every frame, so that the orientation
+ * does not depend on how often the dashboard is refreshed, nor on whether the
+ * gyroscope widget is visible.
+ *
+ * When the frame also has an accelerometer group, the i-th gyroscope is paired
+ * with the i-th accelerometer and a complementary filter corrects the drift of
+ * the pitch & roll angles with the direction of gravity. The correction is
+ * skipped while the measured acceleration is far from 1 g, since the
+ * accelerometer then mostly measures linear acceleration. Yaw is never
+ * corrected, as gravity carries no heading information.
+ *
+ * The result is stored in the gyroscope group (see @c JSON::Group::yaw()).
+ */
+class ImuFusion
+{
+public:
+  ImuFusion();
+
+  void reset();
+  void process(QVector<JSON::Group> &groups, const quint64 generation,
+               const qint64 timestamp);
+
+private:
+  void build(const QVector<JSON::Group> &groups);
+
+private:
+  /**
+   * @brief Location of the datasets of a gyroscope & of its accelerometer.
+   */
+  struct Imu
+  {
+    int gyro;
+    int yaw;
+    int roll;
+    int pitch;
+
+    int accel;
+    int x;
+    int y;
+    int z;
+  };
+
+  /**
+   * @brief Orientation estimated for a gyroscope, in degrees.
+   */
+  struct State
+  {
+    double yaw = 0;
+    double roll = 0;
+    double pitch = 0;
+    qint64 timestamp = 0;
+  };
+
+  quint64 m_generation;
+  QVector<Imu> m_imus;
+  QVector<State> m_states;
+};
+} // namespace JSON
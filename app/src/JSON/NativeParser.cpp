@@ -0,0 +1,874 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include <QObject>
+#include <QtEndian>
+#include <QJsonArray>
+
+#include "JSON/NativeParser.h"
+
+//------------------------------------------------------------------------------
+// Field decoding helpers
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reads a single value of type @a T from @a data and converts it to
+ *        text.
+ *
+ * Floating point values are printed with enough digits to be converted back
+ * without losing precision.
+ */
+template<typename T>
+static QString decodeField(const char *data, const bool bigEndian)
+{
+  const T value
+      = bigEndian ? qFromBigEndian<T>(data) : qFromLittleEndian<T>(data);
+
+  if constexpr (std::is_floating_point_v<T>)
+    return QString::number(value, 'g', std::numeric_limits<T>::max_digits10);
+  else
+    return QString::number(value);
+}
+
+/**
+ * @brief Returns the size in bytes of the given field @a type, or @c 0 for
+ *        padding fields, which define their own size.
+ */
+static qsizetype fieldSize(const JSON::NativeParser::FieldType type)
+{
+  switch (type)
+  {
+    case JSON::NativeParser::FieldType::Int8:
+    case JSON::NativeParser::FieldType::UInt8:
+      return 1;
+    case JSON::NativeParser::FieldType::Int16:
+    case JSON::NativeParser::FieldType::UInt16:
+      return 2;
+    case JSON::NativeParser::FieldType::Int32:
+    case JSON::NativeParser::FieldType::UInt32:
+    case JSON::NativeParser::FieldType::Float32:
+      return 4;
+    case JSON::NativeParser::FieldType::Int64:
+    case JSON::NativeParser::FieldType::UInt64:
+    case JSON::NativeParser::FieldType::Float64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Decodes the binary @a fields found in the @a size bytes at @a data,
+ *        appending their values to @a output.
+ *
+ * Fields are decoded in order until the data runs out, padding bytes do not
+ * produce any value.
+ */
+static void decodeFields(const QList<JSON::NativeParser::BinaryField> &fields,
+                         const char *data, const qsizetype size,
+                         QStringList &output)
+{
+  using FieldType = JSON::NativeParser::FieldType;
+
+  qsizetype offset = 0;
+  for (const auto &field : fields)
+  {
+    // Stop if the frame is too short
+    if (offset + field.size > size)
+      break;
+
+    // Reverse the order of the 16-bit words of the value (if required)
+    const auto *ptr = data + offset;
+    char swapped[8];
+    if (field.swapWords && field.size <= 8)
+    {
+      for (qsizetype i = 0; i < field.size; i += 2)
+      {
+        swapped[i] = ptr[field.size - 2 - i];
+        swapped[i + 1] = ptr[field.size - 1 - i];
+      }
+
+      ptr = swapped;
+    }
+
+    // Convert field data to text
+    const auto be = field.bigEndian;
+    switch (field.type)
+    {
+      case FieldType::Int8:
+        output.append(decodeField<qint8>(ptr, be));
+        break;
+      case FieldType::UInt8:
+        output.append(decodeField<quint8>(ptr, be));
+        break;
+      case FieldType::Int16:
+        output.append(decodeField<qint16>(ptr, be));
+        break;
+      case FieldType::UInt16:
+        output.append(decodeField<quint16>(ptr, be));
+        break;
+      case FieldType::Int32:
+        output.append(decodeField<qint32>(ptr, be));
+        break;
+      case FieldType::UInt32:
+        output.append(decodeField<quint32>(ptr, be));
+        break;
+      case FieldType::Int64:
+        output.append(decodeField<qint64>(ptr, be));
+        break;
+      case FieldType::UInt64:
+        output.append(decodeField<quint64>(ptr, be));
+        break;
+      case FieldType::Float32:
+        output.append(decodeField<float>(ptr, be));
+        break;
+      case FieldType::Float64:
+        output.append(decodeField<double>(ptr, be));
+        break;
+      default:
+        break;
+    }
+
+    offset += field.size;
+  }
+
+}
+
+/**
+ * @brief Finds the field @a type with the given @a name.
+ *
+ * @return @c false if @a name is not a known field type.
+ */
+static bool findFieldType(const QString &name,
+                          JSON::NativeParser::FieldType &type)
+{
+  using FieldType = JSON::NativeParser::FieldType;
+
+  // Map of the supported field types
+  static const QList<QPair<QString, FieldType>> types
+      = {{QStringLiteral("padding"), FieldType::Padding},
+         {QStringLiteral("int8"), FieldType::Int8},
+         {QStringLiteral("uint8"), FieldType::UInt8},
+         {QStringLiteral("int16"), FieldType::Int16},
+         {QStringLiteral("uint16"), FieldType::UInt16},
+         {QStringLiteral("int32"), FieldType::Int32},
+         {QStringLiteral("uint32"), FieldType::UInt32},
+         {QStringLiteral("int64"), FieldType::Int64},
+         {QStringLiteral("uint64"), FieldType::UInt64},
+         {QStringLiteral("float32"), FieldType::Float32},
+         {QStringLiteral("float64"), FieldType::Float64}};
+
+  for (const auto &entry : types)
+  {
+    if (entry.first == name)
+    {
+      type = entry.second;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Size of the identifier that precedes the payload of message frames & mask
+ * of the 29 bits of CAN identifiers (the upper bits carry frame flags)
+ */
+static constexpr qsizetype kMessageIdSize = 4;
+static constexpr quint32 kCanIdMask = 0x1FFFFFFF;
+
+/**
+ * Maximum number of registers & of coils/discrete inputs read by a single
+ * Modbus request (the coil limit keeps payloads within a one-byte length)
+ */
+static constexpr int kMaxModbusRegisters = 125;
+static constexpr int kMaxModbusBits = 250;
+
+/**
+ * Default poll interval of Modbus registers (in milliseconds)
+ */
+static constexpr int kDefaultModbusInterval = 100;
+
+//------------------------------------------------------------------------------
+// Constructor & member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs a disabled parser, frames shall be parsed by the
+ *        JavaScript engine until a native parser description is read.
+ */
+JSON::NativeParser::NativeParser()
+  : m_mode(Mode::Disabled)
+  , m_frameSize(0)
+{
+}
+
+/**
+ * @brief Returns the parsing mode compiled from the project file.
+ */
+JSON::NativeParser::Mode JSON::NativeParser::mode() const
+{
+  return m_mode;
+}
+
+/**
+ * @brief Returns @c true if frames must be given to the parser as raw bytes,
+ *        before any text conversion takes place.
+ */
+bool JSON::NativeParser::isBinary() const
+{
+  return m_mode == Mode::Binary || m_mode == Mode::Can
+         || m_mode == Mode::Modbus;
+}
+
+/**
+ * @brief Returns @c true if a native parser description was compiled, and the
+ *        JavaScript frame parser should not be used.
+ */
+bool JSON::NativeParser::isEnabled() const
+{
+  return m_mode != Mode::Disabled;
+}
+
+/**
+ * @brief Returns the number of bytes required to decode all the fields of a
+ *        binary structure.
+ */
+qsizetype JSON::NativeParser::frameSize() const
+{
+  return m_frameSize;
+}
+
+/**
+ * @brief Returns the number of fields decoded from a binary structure, or 0 if
+ *        the number of fields depends on the contents of each frame.
+ */
+qsizetype JSON::NativeParser::fieldCount() const
+{
+  // Messages fill their own columns, up to the last column of any message
+  if (!m_messages.isEmpty())
+  {
+    qsizetype columns = 0;
+    for (const auto &message : m_messages)
+      columns = qMax(columns, message.columnCount);
+
+    return columns;
+  }
+
+  // Count the fields of the binary structure
+  qsizetype count = 0;
+  for (const auto &field : m_fields)
+  {
+    if (field.type != FieldType::Padding)
+      ++count;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Returns the identifiers of the CAN messages decoded by the parser,
+ *        so that the CAN driver can filter out all other messages.
+ */
+QList<quint32> JSON::NativeParser::canIds() const
+{
+  QList<quint32> ids;
+  ids.reserve(m_messages.count());
+  for (const auto &message : m_messages)
+    ids.append(message.id);
+
+  return ids;
+}
+
+/**
+ * @brief Returns the register blocks that the Modbus driver must poll, each
+ *        block is read with a single request.
+ */
+const QList<JSON::NativeParser::ModbusBlock> &
+JSON::NativeParser::modbusBlocks() const
+{
+  return m_modbusBlocks;
+}
+
+/**
+ * @brief Returns a description of the last error found while reading the
+ *        parser description.
+ */
+const QString &JSON::NativeParser::errorString() const
+{
+  return m_errorString;
+}
+
+//------------------------------------------------------------------------------
+// Frame parsing
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Splits the given text @a frame into fields using the separator or
+ *        the regular expression of the parser.
+ *
+ * @param frame The frame text, after conversion with the project decoder.
+ * @return The list of fields found in the frame.
+ */
+QStringList JSON::NativeParser::parse(const QString &frame) const
+{
+  // Split on separator, avoid substring matching for single characters
+  if (m_mode == Mode::Separator)
+  {
+    if (m_separator.length() == 1)
+      return frame.split(m_separator.at(0));
+
+    return frame.split(m_separator);
+  }
+
+  // Collect the captured groups (or whole matches) of the regex
+  QStringList fields;
+  if (m_mode == Mode::Regex)
+  {
+    const int groups = m_regex.captureCount();
+    auto it = m_regex.globalMatch(frame);
+    while (it.hasNext())
+    {
+      const auto match = it.next();
+      if (groups == 0)
+        fields.append(match.captured(0));
+      else
+      {
+        for (int i = 1; i <= groups; ++i)
+          fields.append(match.captured(i));
+      }
+    }
+  }
+
+  // Binary structures are decoded from raw bytes
+  else if (m_mode == Mode::Binary)
+    return parse(frame.toUtf8());
+
+  return fields;
+}
+
+/**
+ * @brief Decodes the raw bytes of a binary @a frame into fields.
+ *
+ * Fields are decoded in order until the frame runs out of data, so a short
+ * frame yields fewer fields instead of an error. Padding bytes do not produce
+ * any field.
+ *
+ * @param frame The raw frame data.
+ * @return The decoded field values.
+ */
+QStringList JSON::NativeParser::parse(const QByteArray &frame) const
+{
+  // Text parsing modes
+  if (m_mode == Mode::Can || m_mode == Mode::Modbus)
+    return parseMessage(frame);
+  else if (m_mode != Mode::Binary)
+    return parse(QString::fromUtf8(frame));
+
+  // Decode each field of the structure
+  QStringList fields;
+  fields.reserve(m_fields.count());
+  decodeFields(m_fields, frame.constData(), frame.size(), fields);
+  return fields;
+}
+
+/**
+ * @brief Decodes a @a frame with the layout of its message.
+ *
+ * Message frames are made of the big-endian identifier of the message (4
+ * bytes) followed by its payload, as produced by @c IO::Drivers::CANBus &
+ * @c IO::Drivers::Modbus. The values are placed in the columns of the
+ * message, the columns of other messages are null strings, so that the frame
+ * builder keeps their current values.
+ *
+ * @param frame The raw message frame.
+ * @return The decoded values, or an empty list for unknown messages.
+ */
+QStringList JSON::NativeParser::parseMessage(const QByteArray &frame) const
+{
+  // Obtain the message layout
+  if (frame.size() < kMessageIdSize)
+    return {};
+
+  const auto raw = qFromBigEndian<quint32>(frame.constData());
+  const auto index = m_messageIndex.value(raw & kCanIdMask, -1);
+  if (index < 0)
+    return {};
+
+  // Decode the payload
+  QStringList values;
+  const auto &message = m_messages.at(index);
+  values.reserve(message.columns.count());
+  decodeFields(message.fields, frame.constData() + kMessageIdSize,
+               frame.size() - kMessageIdSize, values);
+
+  // Place each value in its column
+  QStringList fields;
+  fields.resize(message.columnCount);
+  for (qsizetype i = 0; i < values.count(); ++i)
+    fields[message.columns.at(i)] = values.at(i);
+
+  return fields;
+}
+
+//------------------------------------------------------------------------------
+// Parser description
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Disables the native parser, so that the JavaScript frame parser is
+ *        used instead.
+ */
+void JSON::NativeParser::clear()
+{
+  m_mode = Mode::Disabled;
+  m_frameSize = 0;
+  m_fields.clear();
+  m_messages.clear();
+  m_modbusBlocks.clear();
+  m_messageIndex.clear();
+  m_separator.clear();
+  m_errorString.clear();
+  m_regex = QRegularExpression();
+}
+
+/**
+ * @brief Compiles the native parser description given in @a object.
+ *
+ * An empty object disables the native parser. If the description is invalid,
+ * the parser is disabled and @c errorString() explains the problem.
+ *
+ * @param object The @c "nativeParser" object of the project file.
+ * @return @c true if the description is empty or valid, @c false otherwise.
+ */
+bool JSON::NativeParser::read(const QJsonObject &object)
+{
+  // Reset parser state
+  clear();
+  if (object.isEmpty())
+    return true;
+
+  // Compile the description according to the selected mode
+  bool ok = false;
+  const auto mode = object.value(QStringLiteral("mode")).toString();
+  if (mode == QStringLiteral("separator"))
+  {
+    m_separator = object.value(QStringLiteral("separator")).toString();
+    ok = !m_separator.isEmpty();
+    if (ok)
+      m_mode = Mode::Separator;
+    else
+      m_errorString = QObject::tr("The separator sequence is empty");
+  }
+
+  else if (mode == QStringLiteral("regex"))
+  {
+    m_regex.setPattern(object.value(QStringLiteral("pattern")).toString());
+    m_regex.optimize();
+    ok = !m_regex.pattern().isEmpty() && m_regex.isValid();
+    if (ok)
+      m_mode = Mode::Regex;
+    else
+      m_errorString = QObject::tr("Invalid regular expression: %1")
+                          .arg(m_regex.errorString());
+  }
+
+  else if (mode == QStringLiteral("binary"))
+  {
+    ok = readBinaryFields(object, m_fields, m_frameSize);
+    if (ok)
+      m_mode = Mode::Binary;
+  }
+
+  else if (mode == QStringLiteral("can"))
+  {
+    ok = readCanMessages(object);
+    if (ok)
+      m_mode = Mode::Can;
+  }
+
+  else if (mode == QStringLiteral("modbus"))
+  {
+    ok = readModbusRegisters(object);
+    if (ok)
+      m_mode = Mode::Modbus;
+  }
+
+  else
+    m_errorString = QObject::tr("Unknown parser mode \"%1\"").arg(mode);
+
+  // Disable the parser on failure
+  if (!ok)
+  {
+    const auto error = m_errorString;
+    clear();
+    m_errorString = error;
+  }
+
+  return ok;
+}
+
+/**
+ * @brief Reads the field list of a binary structure description.
+ *
+ * @param object The @c "nativeParser" object of the project file, or a CAN
+ *               message description.
+ * @param fields Receives the fields of the structure.
+ * @param size Receives the size of the structure in bytes.
+ * @param defaultBigEndian Byte order used when @a object does not define one.
+ * @return @c true if all the fields are valid.
+ */
+bool JSON::NativeParser::readBinaryFields(const QJsonObject &object,
+                                          QList<BinaryField> &fields,
+                                          qsizetype &size,
+                                          const bool defaultBigEndian)
+{
+  // Obtain default endianness of the structure
+  const auto endianness = QStringLiteral("endianness");
+  const auto big = QStringLiteral("big");
+  bool bigEndian = defaultBigEndian;
+  if (object.contains(endianness))
+    bigEndian = object.value(endianness).toString() == big;
+
+  // Read each field
+  const auto array = object.value(QStringLiteral("fields")).toArray();
+  for (int i = 0; i < array.count(); ++i)
+  {
+    const auto field = array.at(i).toObject();
+    const auto name = field.value(QStringLiteral("type")).toString();
+
+    // Find the field type
+    BinaryField binaryField{FieldType::Padding, 0, bigEndian, false};
+    if (!findFieldType(name, binaryField.type))
+    {
+      m_errorString = QObject::tr("Unknown type \"%1\" for field %2")
+                          .arg(name, QString::number(i + 1));
+      return false;
+    }
+
+    // Obtain field size
+    binaryField.size = fieldSize(binaryField.type);
+    if (binaryField.type == FieldType::Padding)
+      binaryField.size = field.value(QStringLiteral("size")).toInt();
+
+    if (binaryField.size <= 0)
+    {
+      m_errorString = QObject::tr("Invalid size for field %1").arg(i + 1);
+      return false;
+    }
+
+    // Override endianness for this field
+    if (field.contains(endianness))
+      binaryField.bigEndian = field.value(endianness).toString() == big;
+
+    // Register the field
+    size += binaryField.size;
+    fields.append(binaryField);
+  }
+
+  // Validate that we have something to decode
+  if (fields.isEmpty())
+  {
+    m_errorString = QObject::tr("The binary structure has no fields");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Reads the message list of a CAN bus description.
+ *
+ * Each message has an @c "id", the 1-based @c "column" of its first value
+ * and the @c "fields" of its payload, which are described as binary fields
+ * (the payload endianness defaults to the one of the whole description).
+ *
+ * @param object The @c "nativeParser" object of the project file.
+ * @return @c true if all the messages are valid.
+ */
+bool JSON::NativeParser::readCanMessages(const QJsonObject &object)
+{
+  // Obtain default endianness of the payloads
+  const auto endianness = object.value(QStringLiteral("endianness"));
+  const bool bigEndian = endianness.toString() == QStringLiteral("big");
+
+  // Read each message
+  const auto array = object.value(QStringLiteral("messages")).toArray();
+  for (int i = 0; i < array.count(); ++i)
+  {
+    const auto json = array.at(i).toObject();
+
+    // Validate the identifier
+    Message message;
+    const auto id = json.value(QStringLiteral("id")).toInteger(-1);
+    if (id < 0 || id > kCanIdMask)
+    {
+      m_errorString = QObject::tr("Invalid identifier for CAN message %1")
+                          .arg(i + 1);
+      return false;
+    }
+
+    message.id = static_cast<quint32>(id);
+    if (m_messageIndex.contains(message.id))
+    {
+      m_errorString = QObject::tr("Duplicated CAN message identifier %1")
+                          .arg(message.id);
+      return false;
+    }
+
+    // Validate the column of the first value
+    const auto column = json.value(QStringLiteral("column")).toInt() - 1;
+    if (column < 0)
+    {
+      m_errorString = QObject::tr("Invalid column for CAN message %1")
+                          .arg(i + 1);
+      return false;
+    }
+
+    // Read the payload layout
+    qsizetype size = 0;
+    if (!readBinaryFields(json, message.fields, size, bigEndian))
+    {
+      m_errorString = QObject::tr("CAN message %1: %2")
+                          .arg(QString::number(i + 1), m_errorString);
+      return false;
+    }
+
+    // Values fill consecutive columns
+    for (const auto &field : std::as_const(message.fields))
+    {
+      if (field.type != FieldType::Padding)
+        message.columns.append(column + message.columns.count());
+    }
+
+    // Register the message
+    message.columnCount = column + message.columns.count();
+    m_messageIndex.insert(message.id, m_messages.count());
+    m_messages.append(message);
+  }
+
+  // Validate that we have something to decode
+  if (m_messages.isEmpty())
+  {
+    m_errorString = QObject::tr("The CAN bus description has no messages");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Reads the register list of a Modbus description & merges it into
+ *        the blocks polled by the Modbus driver.
+ *
+ * Registers are sorted by server, table, poll interval & address. Registers
+ * that follow each other are merged into the same block, up to the maximum
+ * size of a Modbus request, so that each poll uses the minimum number of
+ * requests. Each block is decoded as a message whose identifier is the index
+ * of the block, where every coil or discrete input is a @c uint8 value and
+ * every input or holding register value is stored in big-endian words.
+ *
+ * @param object The @c "nativeParser" object of the project file.
+ * @return @c true if all the registers are valid.
+ */
+bool JSON::NativeParser::readModbusRegisters(const QJsonObject &object)
+{
+  // Register that is read by the driver
+  struct Register
+  {
+    int server;
+    int address;
+    int interval;
+    ModbusTable table;
+    qsizetype column;
+    BinaryField field;
+  };
+
+  // Map of the supported tables
+  static const QList<QPair<QString, ModbusTable>> tables
+      = {{QStringLiteral("coil"), ModbusTable::Coils},
+         {QStringLiteral("discrete"), ModbusTable::DiscreteInputs},
+         {QStringLiteral("input"), ModbusTable::InputRegisters},
+         {QStringLiteral("holding"), ModbusTable::HoldingRegisters}};
+
+  // Obtain the defaults of the description
+  const auto serverKey = QStringLiteral("server");
+  const auto intervalKey = QStringLiteral("interval");
+  const auto wordOrderKey = QStringLiteral("wordOrder");
+  const auto little = QStringLiteral("little");
+  const auto server = object.value(serverKey).toInt(1);
+  const auto interval = object.value(intervalKey).toInt(kDefaultModbusInterval);
+  const auto wordOrder = object.value(wordOrderKey).toString();
+
+  // Read each register
+  QList<Register> registers;
+  const auto array = object.value(QStringLiteral("registers")).toArray();
+  for (int i = 0; i < array.count(); ++i)
+  {
+    const auto json = array.at(i).toObject();
+    Register reg;
+    reg.server = json.value(serverKey).toInt(server);
+    reg.address = json.value(QStringLiteral("address")).toInt(-1);
+    reg.interval = json.value(intervalKey).toInt(interval);
+    reg.column = json.value(QStringLiteral("column")).toInt() - 1;
+    reg.field = BinaryField{FieldType::UInt8, 1, true, false};
+
+    // Find the table
+    const auto tableName = json.value(QStringLiteral("table")).toString();
+    bool found = false;
+    for (const auto &table : tables)
+    {
+      if (table.first == tableName)
+      {
+        reg.table = table.second;
+        found = true;
+        break;
+      }
+    }
+
+    if (!found)
+    {
+      m_errorString = QObject::tr("Unknown table \"%1\" for register %2")
+                          .arg(tableName, QString::number(i + 1));
+      return false;
+    }
+
+    // Validate the location of the register
+    if (reg.address < 0 || reg.address > 0xFFFF || reg.column < 0
+        || reg.server < 0 || reg.server > 247 || reg.interval <= 0)
+    {
+      m_errorString = QObject::tr("Invalid address, column, server or "
+                                  "interval for register %1")
+                          .arg(i + 1);
+      return false;
+    }
+
+    // Obtain the value type of 16-bit registers
+    const bool bits = reg.table == ModbusTable::Coils
+                      || reg.table == ModbusTable::DiscreteInputs;
+    if (!bits)
+    {
+      const auto name = json.value(QStringLiteral("type")).toString();
+      reg.field.type = FieldType::UInt16;
+      if (!name.isEmpty() && !findFieldType(name, reg.field.type))
+      {
+        m_errorString = QObject::tr("Unknown type \"%1\" for register %2")
+                            .arg(name, QString::number(i + 1));
+        return false;
+      }
+
+      reg.field.size = fieldSize(reg.field.type);
+      if (reg.field.size < 2)
+      {
+        m_errorString = QObject::tr("Invalid type for register %1").arg(i + 1);
+        return false;
+      }
+
+      reg.field.swapWords
+          = json.value(wordOrderKey).toString(wordOrder) == little;
+    }
+
+    registers.append(reg);
+  }
+
+  // Validate that we have something to poll
+  if (registers.isEmpty())
+  {
+    m_errorString = QObject::tr("The Modbus description has no registers");
+    return false;
+  }
+
+  // Sort the registers so that adjacent registers follow each other
+  std::stable_sort(registers.begin(), registers.end(),
+                   [](const Register &a, const Register &b) {
+                     if (a.server != b.server)
+                       return a.server < b.server;
+                     if (a.table != b.table)
+                       return a.table < b.table;
+                     if (a.interval != b.interval)
+                       return a.interval < b.interval;
+
+                     return a.address < b.address;
+                   });
+
+  // Merge the registers into blocks
+  for (const auto &reg : std::as_const(registers))
+  {
+    const bool bits = reg.table == ModbusTable::Coils
+                      || reg.table == ModbusTable::DiscreteInputs;
+    const int count = bits ? 1 : static_cast<int>(reg.field.size / 2);
+    const int limit = bits ? kMaxModbusBits : kMaxModbusRegisters;
+
+    // Continue the current block if the register follows it
+    bool append = false;
+    if (!m_modbusBlocks.isEmpty())
+    {
+      const auto &block = m_modbusBlocks.last();
+      const auto end = block.address + block.count;
+      if (block.server == reg.server && block.table == reg.table
+          && block.interval == reg.interval)
+      {
+        if (reg.address < end)
+        {
+          m_errorString = QObject::tr("Register %1 overlaps another register")
+                              .arg(reg.address);
+          return false;
+        }
+
+        append = reg.address == end && block.count + count <= limit;
+      }
+    }
+
+    // Start a new block
+    if (!append)
+    {
+      ModbusBlock block;
+      block.id = static_cast<quint32>(m_modbusBlocks.count());
+      block.server = reg.server;
+      block.address = reg.address;
+      block.count = 0;
+      block.interval = reg.interval;
+      block.table = reg.table;
+      m_modbusBlocks.append(block);
+
+      Message message;
+      message.id = block.id;
+      message.columnCount = 0;
+      m_messageIndex.insert(message.id, m_messages.count());
+      m_messages.append(message);
+    }
+
+    // Register the value in the block & its message
+    auto &message = m_messages.last();
+    m_modbusBlocks.last().count += count;
+    message.fields.append(reg.field);
+    message.columns.append(reg.column);
+    message.columnCount = qMax(message.columnCount, reg.column + 1);
+  }
+
+  return true;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+#include <QJsonObject>
+#include <QRegularExpression>
+
+namespace JSON
+{
+/**
+ * @class JSON::NativeParser
+ * @brief Declarative frame parser that splits frames without the JS engine.
+ *
+ * Most projects only split frames on a separator or decode a fixed binary
+ * layout. Such projects can describe their frame format with a
+ * @c "nativeParser" object in the project file. The description is compiled
+ * once when the project is loaded, and frames are then decoded with plain C++
+ * code. Projects without a native parser description keep using the JavaScript
+ * @c parse() function.
+ *
+ * Supported modes:
+ * - @c "separator": splits the frame text on the given @c "separator" string.
+ * - @c "regex": applies the @c "pattern" regular expression to the frame
+ *   text. Every capture group of every match is a field, or the whole match if
+ *   the pattern has no capture groups.
+ * - @c "binary": decodes the raw frame bytes as a packed structure. @c "fields"
+ *   lists the @c "type" of each field (@c int8, @c uint8, @c int16, @c uint16,
+ *   @c int32, @c uint32, @c int64, @c uint64, @c float32, @c float64, or
+ *   @c padding with a @c "size" in bytes). Each field may override the
+ *   structure's @c "endianness" (@c "little" or @c "big").
+ * - @c "can": decodes frames of the CAN bus driver by message identifier.
+ *   Each entry of @c "messages" has an @c "id", the 1-based @c "column" of
+ *   its first value and the binary @c "fields" of its payload. Values of the
+ *   other messages keep their current value.
+ * - @c "modbus": describes the @c "registers" polled by the Modbus driver.
+ *   Each register has a @c "table" (@c coil, @c discrete, @c input or
+ *   @c holding), an @c "address", a 1-based @c "column" and, for input &
+ *   holding registers, the @c "type" of its value (values wider than 16 bits
+ *   span consecutive registers in the given @c "wordOrder"). The @c "server"
+ *   address & poll @c "interval" (in milliseconds) may be given for each
+ *   register or for the whole description. Adjacent registers polled at the
+ *   same rate are merged into blocks that are read with a single request.
+ *
+ * Example:
+ * @code
+ * "nativeParser": {
+ *   "mode": "binary",
+ *   "endianness": "little",
+ *   "fields": [
+ *     { "type": "uint16" },
+ *     { "type": "padding", "size": 2 },
+ *     { "type": "float32", "endianness": "big" }
+ *   ]
+ * }
+ * @endcode
+ */
+class NativeParser
+{
+public:
+  enum class Mode
+  {
+    Disabled,
+    Separator,
+    Regex,
+    Binary,
+    Can,
+    Modbus
+  };
+
+  enum class ModbusTable
+  {
+    Coils,
+    DiscreteInputs,
+    InputRegisters,
+    HoldingRegisters
+  };
+
+  enum class FieldType
+  {
+    Padding,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64
+  };
+
+  struct BinaryField
+  {
+    FieldType type;
+    qsizetype size;
+    bool bigEndian;
+    bool swapWords;
+  };
+
+  struct Message
+  {
+    quint32 id;
+    qsizetype columnCount;
+    QList<qsizetype> columns;
+    QList<BinaryField> fields;
+  };
+
+  struct ModbusBlock
+  {
+    quint32 id;
+    int server;
+    int address;
+    int count;
+    int interval;
+    ModbusTable table;
+  };
+
+  NativeParser();
+
+  [[nodiscard]] Mode mode() const;
+  [[nodiscard]] bool isBinary() const;
+  [[nodiscard]] bool isEnabled() const;
+  [[nodiscard]] qsizetype frameSize() const;
+  [[nodiscard]] qsizetype fieldCount() const;
+  [[nodiscard]] QList<quint32> canIds() const;
+  [[nodiscard]] const QList<ModbusBlock> &modbusBlocks() const;
+  [[nodiscard]] const QString &errorString() const;
+
+  [[nodiscard]] QStringList parse(const QString &frame) const;
+  [[nodiscard]] QStringList parse(const QByteArray &frame) const;
+
+  void clear();
+  [[nodiscard]] bool read(const QJsonObject &object);
+
+private:
+  [[nodiscard]] QStringList parseMessage(const QByteArray &frame) const;
+
+  [[nodiscard]] bool readCanMessages(const QJsonObject &object);
+  [[nodiscard]] bool readModbusRegisters(const QJsonObject &object);
+  [[nodiscard]] bool readBinaryFields(const QJsonObject &object,
+                                      QList<BinaryField> &fields,
+                                      qsizetype &size,
+                                      const bool defaultBigEndian = false);
+
+private:
+  Mode m_mode;
+  QString m_separator;
+  QString m_errorString;
+  qsizetype m_frameSize;
+  QRegularExpression m_regex;
+  QList<BinaryField> m_fields;
+  QList<Message> m_messages;
+  QList<ModbusBlock> m_modbusBlocks;
+  QHash<quint32, qsizetype> m_messageIndex;
+};
+} // namespace JSON
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QLocale>
+
+#include "JSON/ParserEngine.h"
+
+#include "Misc/Trace.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * Number of fields that a @c parseInto() function can write into the output
+ * array given by the engine.
+ */
+static constexpr int kMaxFields = 1024;
+
+/**
+ * @brief Constructs the parser engine.
+ *
+ * The @c QJSEngine is created on the first call to @c loadScript(), so that it
+ * belongs to the thread in which the parser engine runs.
+ *
+ * @param parent The parent QObject (optional).
+ */
+JSON::ParserEngine::ParserEngine(QObject *parent)
+  : QObject(parent)
+  , m_engine(nullptr)
+  , m_running(false)
+{
+}
+
+/**
+ * @brief Converts the given binary frame @a data to a string, using the given
+ *        decoder @a method.
+ */
+QString
+JSON::ParserEngine::decodeFrame(const QByteArray &data,
+                                const SerialStudio::DecoderMethod method)
+{
+  switch (method)
+  {
+    case SerialStudio::PlainText:
+      return QString::fromUtf8(data);
+    case SerialStudio::Hexadecimal:
+      return QString::fromUtf8(data.toHex());
+    case SerialStudio::Base64:
+      return QString::fromUtf8(data.toBase64());
+    default:
+      return QString::fromUtf8(data);
+  }
+}
+
+/**
+ * @brief Executes the current frame parser function over the input data.
+ *
+ * @param frame current/latest frame data.
+ *
+ * @return An array of strings with the values returned by the JS frame parser.
+ */
+QStringList JSON::ParserEngine::parse(const QString &frame)
+{
+  if (m_fillFunction.isCallable())
+    return callFillFunction(QJSValue(frame));
+
+  if (!m_parseFunction.isCallable())
+    return QStringList();
+
+  return m_parseFunction.call(QJSValueList{frame}).toVariant().toStringList();
+}
+
+/**
+ * @brief Executes the current frame parser function over raw binary data.
+ *
+ * The frame is given to the JS function as an @c ArrayBuffer, without any
+ * hexadecimal or Base64 conversion. Scripts can access the individual bytes
+ * with <tt>new Uint8Array(frame)</tt> or a @c DataView.
+ *
+ * @param frame current/latest frame data.
+ *
+ * @return An array of strings with the values returned by the JS frame parser.
+ */
+QStringList JSON::ParserEngine::parse(const QByteArray &frame)
+{
+  if (m_fillFunction.isCallable())
+    return callFillFunction(m_engine->toScriptValue(frame));
+
+  if (!m_parseFunction.isCallable())
+    return QStringList();
+
+  QJSValueList args;
+  args << m_engine->toScriptValue(frame);
+  return m_parseFunction.call(args).toVariant().toStringList();
+}
+
+/**
+ * @brief Executes the frame parser over several frames at once.
+ *
+ * The frames are given to the script's @c parseBatch() function as an array,
+ * and the script returns an array with the fields of each frame. Scripts that
+ * only declare @c parse() are called through a JS helper that maps each frame
+ * through @c parse(), so that the engine is entered only once per batch.
+ * Scripts that declare @c parseInto() without @c parseBatch() fill the output
+ * array once per frame instead.
+ *
+ * @param frames frames received since the last call.
+ *
+ * @return The values returned by the JS frame parser for each frame.
+ */
+QList<QStringList> JSON::ParserEngine::parseBatch(const QStringList &frames)
+{
+  if (!m_batchFunction.isCallable())
+  {
+    QList<QStringList> results;
+    if (m_fillFunction.isCallable())
+    {
+      results.reserve(frames.count());
+      for (const auto &frame : frames)
+        results.append(callFillFunction(QJSValue(frame)));
+    }
+
+    return results;
+  }
+
+  auto array = m_engine->newArray(frames.count());
+  for (int i = 0; i < frames.count(); ++i)
+    array.setProperty(i, frames.at(i));
+
+  return callBatchFunction(array);
+}
+
+/**
+ * @brief Executes the frame parser over several binary frames at once.
+ *
+ * Each frame is given to the JS function as an @c ArrayBuffer.
+ *
+ * @param frames frames received since the last call.
+ *
+ * @return The values returned by the JS frame parser for each frame.
+ */
+QList<QStringList>
+JSON::ParserEngine::parseBatch(const QList<QByteArray> &frames)
+{
+  if (!m_batchFunction.isCallable())
+  {
+    QList<QStringList> results;
+    if (m_fillFunction.isCallable())
+    {
+      results.reserve(frames.count());
+      for (const auto &frame : frames)
+        results.append(callFillFunction(m_engine->toScriptValue(frame)));
+    }
+
+    return results;
+  }
+
+  auto array = m_engine->newArray(frames.count());
+  for (int i = 0; i < frames.count(); ++i)
+    array.setProperty(i, m_engine->toScriptValue(frames.at(i)));
+
+  return callBatchFunction(array);
+}
+
+/**
+ * @brief Loads the given frame parser @a script into the engine.
+ *
+ * The script is expected to have been validated by the frame parser editor,
+ * so errors are not reported to the user here. If the script does not declare
+ * a callable @c parse() function, frames are parsed into empty field lists.
+ *
+ * Loading the script that is already compiled is a no-op, since the project
+ * model reports its parser code every time that the project is re-opened.
+ *
+ * Scripts may also declare <tt>parseInto(frame, fields)</tt>, which writes
+ * the values of the frame into the persistent @c Float64Array given as
+ * @c fields and returns the number of values written. It is preferred over
+ * @c parse(), since no array is created for every frame and the values are
+ * read back without @c QVariant conversions.
+ *
+ * @param script JavaScript code
+ *
+ * @return @c true if the script declares a callable @c parse() function.
+ */
+bool JSON::ParserEngine::loadScript(const QString &script)
+{
+  // Create the engine in the thread that will use it
+  if (!m_engine)
+  {
+    m_engine = new QJSEngine(this);
+    m_engine->installExtensions(QJSEngine::AllExtensions);
+  }
+
+  // The script is already compiled, keep its functions
+  if (script == m_script && m_parseFunction.isCallable())
+    return true;
+
+  // Forget functions declared by previously loaded scripts
+  m_script = script;
+  m_engine->globalObject().setProperty("parse", QJSValue::UndefinedValue);
+  m_engine->globalObject().setProperty("parseBatch", QJSValue::UndefinedValue);
+  m_engine->globalObject().setProperty("parseInto", QJSValue::UndefinedValue);
+
+  // Evaluate the script & obtain the parse function
+  m_engine->evaluate(script);
+  m_parseFunction = m_engine->globalObject().property("parse");
+  if (!m_parseFunction.isCallable())
+  {
+    m_fields = QJSValue();
+    m_fillFunction = QJSValue();
+    m_parseFunction = QJSValue();
+    m_batchFunction = QJSValue();
+    return false;
+  }
+
+  // Preallocate the output array of the script's parseInto() function
+  m_fillFunction = m_engine->globalObject().property("parseInto");
+  if (m_fillFunction.isCallable())
+    m_fields = m_engine->evaluate(
+        QStringLiteral("new Float64Array(%1)").arg(kMaxFields));
+  else
+  {
+    m_fields = QJSValue();
+    m_fillFunction = QJSValue();
+  }
+
+  // Use the script's parseBatch() function, parseInto() for each frame, or
+  // map frames through parse()
+  m_batchFunction = m_engine->globalObject().property("parseBatch");
+  if (!m_batchFunction.isCallable() && !m_fillFunction.isCallable())
+    m_batchFunction = m_engine->evaluate(QStringLiteral(
+        "(function(frames) { return frames.map(function(frame) { "
+        "return parse(frame); }); })"));
+
+  return true;
+}
+
+/**
+ * @brief Parses the given @a frames and publishes the resulting fields.
+ *
+ * A single frame is given to @c parse(), while several frames are given to
+ * the batch function with one call. The @c framesParsed() signal is emitted
+ * once with the fields of every frame, in the same order.
+ *
+ * The execution time of the script is reported to the pipeline statistics.
+ * If the script is stopped with @c interrupt(), the frames are dropped and an
+ * empty result list is published.
+ *
+ * @param frames The raw frames to parse.
+ * @param method The decoder method used to convert frames to text.
+ */
+void JSON::ParserEngine::parseFrames(const QList<QByteArray> &frames,
+                                     const SerialStudio::DecoderMethod method)
+{
+  TRACE_ZONE("ParserEngine::parseFrames");
+
+  // Let the watchdog interrupt the script from now on
+  if (m_engine)
+  {
+    QMutexLocker locker(&m_interruptLock);
+    m_engine->setInterrupted(false);
+    m_running = true;
+  }
+
+  // Single frame, no need to build a batch
+  QList<QStringList> results;
+  auto &stats = Misc::PipelineStats::instance();
+  const auto start = stats.timestamp();
+  const bool binary = method == SerialStudio::Binary;
+  if (frames.count() == 1)
+  {
+    if (binary)
+      results.append(parse(frames.first()));
+    else
+      results.append(parse(decodeFrame(frames.first(), method)));
+  }
+
+  // Parse all frames at once
+  else if (binary)
+    results = parseBatch(frames);
+  else
+  {
+    QStringList text;
+    text.reserve(frames.count());
+    for (const auto &frame : frames)
+      text.append(decodeFrame(frame, method));
+
+    results = parseBatch(text);
+  }
+
+  // Stop the watchdog & check if the script was interrupted
+  bool interrupted = false;
+  if (m_engine)
+  {
+    QMutexLocker locker(&m_interruptLock);
+    interrupted = m_engine->isInterrupted();
+    m_engine->setInterrupted(false);
+    m_running = false;
+  }
+
+  // Report the execution time of the script
+  quint64 bytes = 0;
+  for (const auto &frame : frames)
+    bytes += frame.size();
+
+  stats.record(Misc::PipelineStats::ParserScript, frames.count(), bytes,
+               stats.timestamp() - start);
+
+  // Drop the frames of an interrupted script
+  if (interrupted)
+  {
+    results.clear();
+    stats.recordDrops(Misc::PipelineStats::FrameParser, frames.count());
+    qWarning() << "Frame parser exceeded its time budget," << frames.count()
+               << "frame(s) dropped";
+  }
+
+  // Publish parsed fields
+  Q_EMIT framesParsed(results);
+}
+
+/**
+ * @brief Stops the script that is being executed by @c parseFrames().
+ *
+ * This function is thread-safe, it is called by the watchdog of the frame
+ * builder when the script exceeds its time budget. Nothing happens if the
+ * engine is not parsing frames.
+ */
+void JSON::ParserEngine::interrupt()
+{
+  QMutexLocker locker(&m_interruptLock);
+  if (m_running)
+    m_engine->setInterrupted(true);
+}
+
+/**
+ * @brief Calls the script's @c parseInto() function with the given @a frame
+ *        and converts the values written into the output array into fields.
+ *
+ * The function returns the number of values that it wrote, values beyond the
+ * capacity of the output array are ignored.
+ */
+QStringList JSON::ParserEngine::callFillFunction(const QJSValue &frame)
+{
+  // Let the script fill the persistent output array
+  const auto ret = m_fillFunction.call(QJSValueList{frame, m_fields});
+  const auto count = qBound(0, ret.toInt(), kMaxFields);
+
+  // Read the values back without creating an intermediate list
+  QStringList fields;
+  fields.reserve(count);
+  for (int i = 0; i < count; ++i)
+    fields.append(QString::number(m_fields.property(i).toNumber(), 'g',
+                                  QLocale::FloatingPointShortest));
+
+  return fields;
+}
+
+/**
+ * @brief Calls the batch parsing function with the given JS array of @a frames
+ *        and converts the result into a list of field lists.
+ */
+QList<QStringList>
+JSON::ParserEngine::callBatchFunction(const QJSValue &frames)
+{
+  // Evaluate batch parsing function
+  const auto out = m_batchFunction.call(QJSValueList{frames}).toVariant();
+
+  // Convert output to a list of field lists
+  QList<QStringList> results;
+  const auto list = out.toList();
+  results.reserve(list.count());
+  for (const auto &fields : list)
+    results.append(fields.toStringList());
+
+  return results;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QJSValue>
+#include <QJSEngine>
+#include <QByteArray>
+#include <QStringList>
+
+#include "SerialStudio.h"
+
+namespace JSON
+{
+/**
+ * @class JSON::ParserEngine
+ * @brief Headless JavaScript engine that executes the project frame parser.
+ *
+ * The parser engine owns its own @c QJSEngine, independent from the one used
+ * by the frame parser code editor to validate scripts. It is meant to live in
+ * a worker thread, so that long or slow parser scripts never block the user
+ * interface: frames are queued to @c parseFrames(), and the resulting fields
+ * are published through the @c framesParsed() signal.
+ *
+ * Besides @c parse(), scripts can declare @c parseInto(), which fills a
+ * persistent, preallocated output array instead of returning a new array for
+ * every frame.
+ *
+ * A watchdog may stop a runaway script with @c interrupt(), the frames that
+ * it was parsing are then dropped.
+ */
+class ParserEngine : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void framesParsed(const QList<QStringList> &results);
+
+public:
+  explicit ParserEngine(QObject *parent = nullptr);
+
+  [[nodiscard]] static QString
+  decodeFrame(const QByteArray &data, const SerialStudio::DecoderMethod method);
+
+  [[nodiscard]] QStringList parse(const QString &frame);
+  [[nodiscard]] QStringList parse(const QByteArray &frame);
+  [[nodiscard]] QList<QStringList> parseBatch(const QStringList &frames);
+  [[nodiscard]] QList<QStringList> parseBatch(const QList<QByteArray> &frames);
+
+  void interrupt();
+
+public slots:
+  bool loadScript(const QString &script);
+  void parseFrames(const QList<QByteArray> &frames,
+                   const SerialStudio::DecoderMethod method);
+
+private:
+  [[nodiscard]] QStringList callFillFunction(const QJSValue &frame);
+  [[nodiscard]] QList<QStringList> callBatchFunction(const QJSValue &frames);
+
+private:
+  QString m_script;
+  QJSEngine *m_engine;
+  bool m_running;
+  QMutex m_interruptLock;
+  QJSValue m_fields;
+  QJSValue m_fillFunction;
+  QJSValue m_parseFunction;
+  QJSValue m_batchFunction;
+};
+} // namespace JSON
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QObject>
+#include <QFileInfo>
+
+#include "JSON/PluginParser.h"
+
+/**
+ * @brief Largest number of values that a plugin may write for each frame.
+ */
+static constexpr qsizetype kMaxCapacity = 65536;
+
+/**
+ * @brief Number of values used when the project file does not define the
+ *        capacity of the plugin.
+ */
+static constexpr qsizetype kDefaultCapacity = 256;
+
+/**
+ * @brief Creates a parser without a plugin.
+ */
+JSON::PluginParser::PluginParser()
+  : m_capacity(0)
+  , m_parse(nullptr)
+{
+}
+
+/**
+ * @brief Unloads the plugin library (if any).
+ */
+JSON::PluginParser::~PluginParser()
+{
+  clear();
+}
+
+/**
+ * @brief Returns @c true if a plugin is loaded & its parse function resolved.
+ */
+bool JSON::PluginParser::isEnabled() const
+{
+  return m_parse != nullptr;
+}
+
+/**
+ * @brief Returns the largest number of values decoded from a frame.
+ */
+qsizetype JSON::PluginParser::capacity() const
+{
+  return m_capacity;
+}
+
+/**
+ * @brief Returns the reason why the last plugin could not be loaded.
+ */
+const QString &JSON::PluginParser::errorString() const
+{
+  return m_errorString;
+}
+
+/**
+ * @brief Returns the canonical path of the library selected by the last
+ *        project file, or an empty string if the project uses no plugin.
+ */
+const QString &JSON::PluginParser::libraryPath() const
+{
+  return m_libraryPath;
+}
+
+/**
+ * @brief Decodes a frame with the plugin.
+ *
+ * @param frame The raw bytes of the frame.
+ * @param values Receives up to @c capacity() decoded values.
+ * @return The number of values written to @a values, @c 0 if the plugin
+ *         dropped the frame or no plugin is loaded.
+ */
+qsizetype JSON::PluginParser::parse(const QByteArray &frame,
+                                    double *values) const
+{
+  if (!m_parse || !values)
+    return 0;
+
+  const auto *data = reinterpret_cast<const uint8_t *>(frame.constData());
+  const auto count = m_parse(data, size_t(frame.size()), values,
+                             size_t(m_capacity));
+
+  return qsizetype(qMin(count, size_t(m_capacity)));
+}
+
+/**
+ * @brief Unloads the plugin library & disables the parser.
+ */
+void JSON::PluginParser::clear()
+{
+  m_capacity = 0;
+  m_parse = nullptr;
+  m_errorString.clear();
+  m_libraryPath.clear();
+  if (m_library.isLoaded())
+    m_library.unload();
+}
+
+/**
+ * @brief Reads the @c "parserPlugin" object of a project file, without
+ *        loading the library.
+ *
+ * @param object The @c "parserPlugin" object, an empty object disables the
+ *               parser.
+ * @param path The folder used to resolve relative library paths.
+ * @return @c true if the object is empty or valid, @c false if the plugin
+ *         is invalid (see @c errorString()).
+ */
+bool JSON::PluginParser::read(const QJsonObject &object, const QString &path)
+{
+  // Reset parser state
+  clear();
+  if (object.isEmpty())
+    return true;
+
+  // Obtain the library path & the number of values of each frame
+  const auto name = object.value(QStringLiteral("library")).toString();
+  const auto capacity = object.value(QStringLiteral("capacity"))
+                            .toInteger(kDefaultCapacity);
+  if (name.isEmpty())
+  {
+    m_errorString = QObject::tr("The parser plugin library is not defined");
+    return false;
+  }
+
+  if (capacity < 1 || capacity > kMaxCapacity)
+  {
+    m_errorString = QObject::tr("The parser plugin capacity must be between "
+                                "1 and %1")
+                        .arg(kMaxCapacity);
+    return false;
+  }
+
+  // Resolve the library file, so that the trusted path names one file
+  const QFileInfo info(QDir(path).absoluteFilePath(name));
+  if (!info.isFile())
+  {
+    m_errorString = QObject::tr("Cannot find the parser plugin library %1")
+                        .arg(QDir::toNativeSeparators(info.filePath()));
+    return false;
+  }
+
+  m_capacity = capacity;
+  m_libraryPath = info.canonicalFilePath();
+  return true;
+}
+
+/**
+ * @brief Loads the library selected by @c read() & resolves its functions.
+ *
+ * @return @c true if the plugin was loaded, @c false if no library was
+ *         selected or it is invalid (see @c errorString()).
+ */
+bool JSON::PluginParser::load()
+{
+  // Keep the library selected by the project file across resets
+  const auto path = m_libraryPath;
+  const auto capacity = m_capacity;
+  if (path.isEmpty())
+    return false;
+
+  // Load the library
+  m_library.setFileName(path);
+  if (!m_library.load())
+  {
+    m_errorString = m_library.errorString();
+    return false;
+  }
+
+  // Reject plugins built against another version of the interface
+  auto version = reinterpret_cast<VersionFunction>(
+      m_library.resolve("parser_abi_version"));
+  if (version && version() != kAbiVersion)
+  {
+    const auto error = QObject::tr("Unsupported parser plugin version %1")
+                           .arg(version());
+    clear();
+    m_errorString = error;
+    m_libraryPath = path;
+    return false;
+  }
+
+  // Resolve the parse function
+  auto parse = reinterpret_cast<ParseFunction>(m_library.resolve("parse"));
+  if (!parse)
+  {
+    const auto error = QObject::tr("The parser plugin does not export a "
+                                   "\"parse\" function");
+    clear();
+    m_errorString = error;
+    m_libraryPath = path;
+    return false;
+  }
+
+  m_capacity = capacity;
+  m_parse = parse;
+  return true;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <QString>
+#include <QLibrary>
+#include <QByteArray>
+#include <QJsonObject>
+
+namespace JSON
+{
+/**
+ * @class JSON::PluginParser
+ * @brief Frame parser loaded from a shared library with a small C ABI.
+ *
+ * Protocols that are too complex for the @c JSON::NativeParser description,
+ * but too slow to decode with the JavaScript @c parse() function, can be
+ * decoded by a compiled plugin. The plugin is selected with a
+ * @c "parserPlugin" object in the project file, whose @c "library" is the
+ * path of the shared library (relative paths are resolved from the folder of
+ * the project file) and whose @c "capacity" is the largest number of values
+ * that a frame may contain.
+ *
+ * The library must export the following C function, which writes up to
+ * @c cap values decoded from the raw frame bytes to @c out and returns how
+ * many values were written, or @c 0 to drop the frame:
+ * @code
+ * extern "C" size_t parse(const uint8_t *data, size_t size,
+ *                         double *out, size_t cap);
+ * @endcode
+ *
+ * The library may also export @c "int parser_abi_version(void)", plugins
+ * that report another version than @c kAbiVersion are rejected. The
+ * function is called from the frame builder thread only, and value @c n of
+ * each frame is assigned to the datasets with frame index @c n+1 without any
+ * conversion to text.
+ *
+ * Loading a library runs its code with the rights of the application, so
+ * @c read() only validates the object & resolves @c libraryPath(), the
+ * library itself is loaded by @c load() once the caller has checked that
+ * the user trusts that path.
+ */
+class PluginParser
+{
+public:
+  static constexpr int kAbiVersion = 1;
+
+  using ParseFunction = size_t (*)(const uint8_t *, size_t, double *, size_t);
+  using VersionFunction = int (*)();
+
+  PluginParser();
+  ~PluginParser();
+
+  PluginParser(PluginParser &&) = delete;
+  PluginParser(const PluginParser &) = delete;
+  PluginParser &operator=(PluginParser &&) = delete;
+  PluginParser &operator=(const PluginParser &) = delete;
+
+  [[nodiscard]] bool isEnabled() const;
+  [[nodiscard]] qsizetype capacity() const;
+  [[nodiscard]] const QString &errorString() const;
+  [[nodiscard]] const QString &libraryPath() const;
+
+  [[nodiscard]] qsizetype parse(const QByteArray &frame, double *values) const;
+
+  void clear();
+  [[nodiscard]] bool load();
+  [[nodiscard]] bool read(const QJsonObject &object, const QString &path);
+
+private:
+  QLibrary m_library;
+  QString m_errorString;
+  QString m_libraryPath;
+  qsizetype m_capacity;
+  ParseFunction m_parse;
+};
+} // namespace JSON
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QCborMap>
+#include <QCborValue>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+
+#include "JSON/ProjectCache.h"
+
+/**
+ * Version of the cache file layout, cache files with another version are
+ * ignored and overwritten.
+ */
+static constexpr qint64 kCacheVersion = 1;
+
+/**
+ * Maximum number of cached projects kept in the cache directory.
+ */
+static constexpr int kMaxCacheFiles = 32;
+
+/**
+ * Constructor function, creates the project cache directory.
+ */
+JSON::ProjectCache::ProjectCache()
+  : m_path(QStringLiteral("%1/Projects/").arg(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation)))
+{
+  QDir dir(m_path);
+  if (!dir.exists())
+    dir.mkpath(".");
+}
+
+/**
+ * Returns the only instance of the class.
+ */
+JSON::ProjectCache &JSON::ProjectCache::instance()
+{
+  static ProjectCache singleton;
+  return singleton;
+}
+
+/**
+ * @brief Parses the project file contents given by @a data into @a json.
+ *
+ * The document is taken from memory when it is the last one parsed, then
+ * from its binary cache file, and is only parsed from the JSON text when
+ * neither of them exists.
+ *
+ * @param data  Contents of the project file.
+ * @param json  Receives the root object of the project.
+ * @param error Receives the parse error, if any.
+ *
+ * @return @c true if @a data contains a valid JSON object.
+ */
+bool JSON::ProjectCache::parse(const QByteArray &data, QJsonObject *json,
+                               QString *error)
+{
+  Q_ASSERT(json);
+
+  // Same document as the last one parsed
+  const auto hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+  if (hash == m_hash)
+  {
+    *json = m_json;
+    return true;
+  }
+
+  // Parse the JSON text if the document has not been cached
+  if (!readCache(hash, json))
+  {
+    QJsonParseError result;
+    const auto document = QJsonDocument::fromJson(data, &result);
+    if (result.error != QJsonParseError::NoError || !document.isObject())
+    {
+      if (error)
+        *error = result.error != QJsonParseError::NoError
+                     ? result.errorString()
+                     : QStringLiteral("The document is not a JSON object");
+
+      return false;
+    }
+
+    *json = document.object();
+    writeCache(hash, *json);
+  }
+
+  // Remember the document for the next caller
+  m_hash = hash;
+  m_json = *json;
+  return true;
+}
+
+/**
+ * Forgets the last parsed document, cache files are kept.
+ */
+void JSON::ProjectCache::clear()
+{
+  m_hash.clear();
+  m_json = QJsonObject();
+}
+
+/**
+ * Returns the path of the cache file for the document with the given @a hash.
+ */
+QString JSON::ProjectCache::cacheFile(const QByteArray &hash) const
+{
+  return m_path + QString::fromLatin1(hash.toHex()) + QStringLiteral(".cbor");
+}
+
+/**
+ * @brief Reads the cached document with the given @a hash into @a json.
+ *
+ * @return @c true if a cache file with the current layout version exists.
+ */
+bool JSON::ProjectCache::readCache(const QByteArray &hash,
+                                   QJsonObject *json) const
+{
+  QFile file(cacheFile(hash));
+  if (!file.open(QFile::ReadOnly))
+    return false;
+
+  // Validate the cache file layout
+  QCborParserError error;
+  const auto cache = QCborValue::fromCbor(file.readAll(), &error).toMap();
+  if (error.error != QCborError::NoError
+      || cache.value(QStringLiteral("version")).toInteger() != kCacheVersion)
+    return false;
+
+  // Obtain the project document
+  const auto project = cache.value(QStringLiteral("project"));
+  if (!project.isMap())
+    return false;
+
+  *json = project.toMap().toJsonObject();
+  return true;
+}
+
+/**
+ * @brief Stores the given @a json document in the cache file for @a hash.
+ *
+ * The oldest cache files are removed, so that the cache directory does not
+ * grow beyond @c kMaxCacheFiles projects.
+ */
+void JSON::ProjectCache::writeCache(const QByteArray &hash,
+                                    const QJsonObject &json) const
+{
+  // Write the cache file atomically
+  QCborMap cache;
+  cache.insert(QStringLiteral("version"), kCacheVersion);
+  cache.insert(QStringLiteral("project"), QCborMap::fromJsonObject(json));
+  QSaveFile file(cacheFile(hash));
+  if (!file.open(QFile::WriteOnly))
+    return;
+
+  file.write(cache.toCborValue().toCbor());
+  if (!file.commit())
+    return;
+
+  // Remove the oldest cache files
+  QDir dir(m_path);
+  const auto files = dir.entryInfoList({QStringLiteral("*.cbor")}, QDir::Files,
+                                       QDir::Time);
+  for (int i = kMaxCacheFiles; i < files.count(); ++i)
+    QFile::remove(files.at(i).absoluteFilePath());
+}
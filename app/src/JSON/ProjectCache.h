@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+
+namespace JSON
+{
+/**
+ * @class JSON::ProjectCache
+ * @brief Parsed project documents, keyed by the hash of their contents.
+ *
+ * Opening a project parses the same file from @c JSON::ProjectModel and from
+ * @c JSON::FrameBuilder, and large projects take a long time to parse. This
+ * class remembers the last parsed document, and stores every document that
+ * parses into a valid JSON object as binary CBOR in the cache directory, so
+ * that warm loads of an unchanged project skip the JSON text parser.
+ *
+ * The cache is only used from the main thread.
+ */
+class ProjectCache
+{
+private:
+  explicit ProjectCache();
+  ProjectCache(ProjectCache &&) = delete;
+  ProjectCache(const ProjectCache &) = delete;
+  ProjectCache &operator=(ProjectCache &&) = delete;
+  ProjectCache &operator=(const ProjectCache &) = delete;
+
+public:
+  static ProjectCache &instance();
+
+  [[nodiscard]] bool parse(const QByteArray &data, QJsonObject *json,
+                           QString *error = nullptr);
+
+  void clear();
+
+private:
+  [[nodiscard]] QString cacheFile(const QByteArray &hash) const;
+  [[nodiscard]] bool readCache(const QByteArray &hash, QJsonObject *json) const;
+  void writeCache(const QByteArray &hash, const QJsonObject &json) const;
+
+private:
+  QString m_path;
+  QByteArray m_hash;
+  QJsonObject m_json;
+};
+} // namespace JSON
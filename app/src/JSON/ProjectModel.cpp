@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonArray>
@@ -33,9 +35,50 @@
 #include "Misc/Translator.h"
 
 #include "JSON/FrameParser.h"
+#include "JSON/ProjectCache.h"
 #include "JSON/ProjectModel.h"
 #include "JSON/FrameBuilder.h"
 
+/**
+ * @brief Widths of the length field of length-prefixed frames, in the order
+ *        in which they are listed in the project editor.
+ */
+static constexpr int kLengthFieldSizes[] = {1, 2, 4};
+
+/**
+ * @brief Default queue fill (in percent) at which load is shed.
+ */
+static constexpr int kDefaultOverloadThreshold = 50;
+
+/**
+ * @brief Default dashboard decimation factor while overloaded.
+ */
+static constexpr int kDefaultOverloadDecimation = 4;
+
+/**
+ * @brief Largest dashboard decimation factor accepted by the project editor.
+ */
+static constexpr int kMaxOverloadDecimation = 100;
+
+/**
+ * @brief Returns the tree view icon of a group with the given @a widget.
+ */
+static QString groupIcon(const QString &widget)
+{
+  if (widget == "map")
+    return "qrc:/rcc/icons/project-editor/treeview/gps.svg";
+  else if (widget == "accelerometer")
+    return "qrc:/rcc/icons/project-editor/treeview/accelerometer.svg";
+  else if (widget == "gyro")
+    return "qrc:/rcc/icons/project-editor/treeview/gyroscope.svg";
+  else if (widget == "multiplot")
+    return "qrc:/rcc/icons/project-editor/treeview/multiplot.svg";
+  else if (widget == "datagrid")
+    return "qrc:/rcc/icons/project-editor/treeview/datagrid.svg";
+
+  return "qrc:/rcc/icons/project-editor/treeview/group.svg";
+}
+
 //------------------------------------------------------------------------------
 // Private enums to keep track of which item the user selected/modified
 //------------------------------------------------------------------------------
@@ -63,7 +106,21 @@ typedef enum
   kProjectView_FrameDecoder,        /**< Represents the frame decoder item. */
   kProjectView_FrameDetection,      /**< Represents the frame detection item. */
   kProjectView_ThunderforestApiKey, /**< Represents the Thunderforest API key. */
-  kProjectView_MapTilerApiKey       /**< Represents the MapTiler API key. */
+  kProjectView_MapTilerApiKey,      /**< Represents the MapTiler API key. */
+  kProjectView_StatelessParser,     /**< Represents the stateless parser. */
+  kProjectView_SequenceField,       /**< Represents the frame counter field. */
+  kProjectView_FrameHeader,         /**< Represents the length frame header. */
+  kProjectView_LengthFieldSize,     /**< Represents the length field width. */
+  kProjectView_LengthBigEndian,     /**< Represents the length byte order. */
+  kProjectView_ChecksumAlgorithm,   /**< Represents the checksum algorithm. */
+  kProjectView_ChecksumPosition,    /**< Represents the checksum position. */
+  kProjectView_ChecksumBigEndian,   /**< Represents the checksum byte order. */
+  kProjectView_ChecksumStart,       /**< Represents the checksum range start. */
+  kProjectView_ChecksumEnd,         /**< Represents the checksum range end. */
+  kProjectView_TimestampField,      /**< Represents the device time field. */
+  kProjectView_TimestampBits,       /**< Represents the device time width. */
+  kProjectView_OverloadThreshold,   /**< Represents the load shedding limit. */
+  kProjectView_OverloadDecimation   /**< Represents the UI decimation factor. */
 } ProjectItem;
 // clang-format on
 
@@ -86,6 +143,16 @@ typedef enum
   kDatasetView_Alarm,         /**< Represents the dataset alarm value item. */
   kDatasetView_FFT_Samples,    /**< Represents the FFT window size item. */
   kDatasetView_FFT_SamplingRate, /**< Represents the FFT sampling rate item. */
+  kDatasetView_FFT_HopSize,      /**< Represents the FFT hop size item. */
+  kDatasetView_FFT_Window,       /**< Represents the FFT window function. */
+  kDatasetView_Waterfall,        /**< Represents the waterfall plot checkbox. */
+  kDatasetView_Expression,       /**< Represents the computed value item. */
+  kDatasetView_Filter,           /**< Represents the filter type item. */
+  kDatasetView_FilterCutoff,     /**< Represents the filter cutoff item. */
+  kDatasetView_FilterRate,       /**< Represents the filter sampling rate. */
+  kDatasetView_FilterOrder,      /**< Represents the filter order item. */
+  kDatasetView_SampleRate,       /**< Represents the array sample rate item. */
+  kDatasetView_Priority,         /**< Represents the priority checkbox item. */
 } DatasetItem;
 // clang-format on
 
@@ -95,10 +162,11 @@ typedef enum
 // clang-format off
 typedef enum
 {
-  kActionView_Title, /**< Represents the action title item. */
-  kActionView_Icon,  /**< Represents the icon item. */
-  kActionView_EOL,   /**< Represents the EOL (end of line) item. */
-  kActionView_Data   /**< Represents the TX data item. */
+  kActionView_Title,   /**< Represents the action title item. */
+  kActionView_Icon,    /**< Represents the icon item. */
+  kActionView_EOL,     /**< Represents the EOL (end of line) item. */
+  kActionView_Data,    /**< Represents the TX data item. */
+  kActionView_Interval /**< Represents the repeat interval item. */
 } ActionItem;
 // clang-format on
 
@@ -108,8 +176,9 @@ typedef enum
 // clang-format off
 typedef enum
 {
-  kGroupView_Title,  /**< Represents the group title item. */
-  kGroupView_Widget  /**< Represents the group widget item. */
+  kGroupView_Title,   /**< Represents the group title item. */
+  kGroupView_Widget,  /**< Represents the group widget item. */
+  kGroupView_Refresh  /**< Represents the group refresh class item. */
 } GroupItem;
 // clang-format on
 
@@ -128,8 +197,8 @@ static quint16 TILE_SERVER_PORT = 2701;
  * @brief Constructor for the JSON::ProjectModel class.
  *
  * Initializes the ProjectModel class by setting default values for member
- * variables, generating the necessary combo box models, and connecting signals
- * to handle J SON file changes.
+ * variables and connecting signals to handle JSON file changes. The combo box
+ * and editor models are generated when the project editor is opened.
  *
  * This constructor also loads the current JSON map file into the model or
  * creates a new project if no file is present.
@@ -143,17 +212,30 @@ JSON::ProjectModel::ProjectModel()
   , m_frameDecoder(SerialStudio::PlainText)
   , m_frameDetection(SerialStudio::EndDelimiterOnly)
   , m_modified(false)
+  , m_editorActive(false)
+  , m_statelessParser(false)
+  , m_sequenceField(0)
+  , m_timestampField(0)
+  , m_timestampBits(32)
+  , m_overloadThreshold(kDefaultOverloadThreshold)
+  , m_overloadDecimation(kDefaultOverloadDecimation)
   , m_filePath("")
+  , m_frameHeader("")
+  , m_lengthFieldSize(2)
+  , m_lengthBigEndian(false)
+  , m_checksumAlgorithm(SerialStudio::ChecksumAuto)
+  , m_checksumPosition(SerialStudio::ChecksumTrailer)
+  , m_checksumBigEndian(true)
+  , m_checksumStart(0)
+  , m_checksumEnd(0)
   , m_treeModel(nullptr)
   , m_selectionModel(nullptr)
   , m_groupModel(nullptr)
+  , m_actionModel(nullptr)
   , m_projectModel(nullptr)
   , m_datasetModel(nullptr)
   , m_server("", "", TILE_SERVER_PORT, SERVER_PORT, nullptr)
 {
-  // Generate data sources for project model
-  generateComboBoxModels();
-
   // Clear selection model when JSON file is changed
   connect(this, &JSON::ProjectModel::jsonFileChanged, this, [=] {
     if (m_selectionModel)
@@ -216,6 +298,19 @@ bool JSON::ProjectModel::modified() const
   return m_modified || parserModified;
 }
 
+/**
+ * @brief Checks if the project editor is open.
+ *
+ * The editor models are only built while the project editor is open, so that
+ * loading a project to display its dashboard does not allocate them.
+ *
+ * @return True if the project editor is open, false otherwise.
+ */
+bool JSON::ProjectModel::editorActive() const
+{
+  return m_editorActive;
+}
+
 /**
  * @brief Retrieves the current view of the project.
  *
@@ -234,7 +329,7 @@ JSON::ProjectModel::CurrentView JSON::ProjectModel::currentView() const
  *
  * This function returns the decoder method currently set for parsing data
  * frames. The decoder method determines how incoming data is interpreted
- * (e.g., as normal UTF-8, hexadecimal, or Base64).
+ * (e.g., as normal UTF-8, hexadecimal, Base64 or raw bytes).
  *
  * @return The current decoder method as a value from the `DecoderMethod` enum.
  */
@@ -256,6 +351,148 @@ SerialStudio::FrameDetection JSON::ProjectModel::frameDetection() const
   return m_frameDetection;
 }
 
+/**
+ * @brief Returns the bytes that precede the length field of length-prefixed
+ *        frames.
+ *
+ * The header is written in the project file as hexadecimal bytes (e.g.
+ * "AA 55"), an empty header means that the length field starts every frame.
+ */
+QByteArray JSON::ProjectModel::frameHeader() const
+{
+  return QByteArray::fromHex(m_frameHeader.toLatin1());
+}
+
+/**
+ * @brief Returns the width in bytes of the length field of length-prefixed
+ *        frames.
+ */
+int JSON::ProjectModel::lengthFieldSize() const
+{
+  return m_lengthFieldSize;
+}
+
+/**
+ * @brief Returns @c true if the most significant byte of the length field of
+ *        length-prefixed frames is sent first.
+ */
+bool JSON::ProjectModel::lengthBigEndian() const
+{
+  return m_lengthBigEndian;
+}
+
+/**
+ * @brief Returns the checksum that protects the frames of the project.
+ *
+ * @c SerialStudio::ChecksumAuto keeps detecting in-band checksum tags after
+ * the frame delimiter, every other value declares the checksum explicitly.
+ */
+SerialStudio::ChecksumAlgorithm JSON::ProjectModel::checksumAlgorithm() const
+{
+  return m_checksumAlgorithm;
+}
+
+/**
+ * @brief Returns whether the declared checksum is stored in the first or in
+ *        the last bytes of each frame.
+ */
+SerialStudio::ChecksumPosition JSON::ProjectModel::checksumPosition() const
+{
+  return m_checksumPosition;
+}
+
+/**
+ * @brief Returns @c true if the most significant byte of the declared
+ *        checksum is sent first.
+ */
+bool JSON::ProjectModel::checksumBigEndian() const
+{
+  return m_checksumBigEndian;
+}
+
+/**
+ * @brief Returns the number of leading bytes of the frame (after a checksum
+ *        header) that are not covered by the declared checksum.
+ */
+int JSON::ProjectModel::checksumStart() const
+{
+  return m_checksumStart;
+}
+
+/**
+ * @brief Returns the number of trailing bytes of the frame (before a checksum
+ *        trailer) that are not covered by the declared checksum.
+ */
+int JSON::ProjectModel::checksumEnd() const
+{
+  return m_checksumEnd;
+}
+
+/**
+ * @brief Checks if the frame parser keeps no state between frames.
+ *
+ * The frames of a stateless parser can be parsed in any order, which allows
+ * the frame builder to spread them across several parser threads.
+ *
+ * @return True if the frame parser is stateless, false otherwise.
+ */
+bool JSON::ProjectModel::statelessParser() const
+{
+  return m_statelessParser;
+}
+
+/**
+ * @brief Returns the frame index of the field that contains the frame counter
+ *        sent by the device, or 0 if the device does not send one.
+ *
+ * The frame builder uses this counter to detect frames lost by the link.
+ */
+int JSON::ProjectModel::sequenceField() const
+{
+  return m_sequenceField;
+}
+
+/**
+ * @brief Returns the frame index of the field that contains the microsecond
+ *        counter sent by the device, or 0 if the device does not send one.
+ *
+ * The frame builder maps this counter to the host clock to obtain the
+ * sampling time of each frame.
+ */
+int JSON::ProjectModel::timestampField() const
+{
+  return m_timestampField;
+}
+
+/**
+ * @brief Returns the width in bits of the device timestamp counter, which
+ *        wraps around after reaching its maximum value.
+ */
+int JSON::ProjectModel::timestampBits() const
+{
+  return m_timestampBits;
+}
+
+/**
+ * @brief Returns the fill of the pipeline queues (in percent) at which the
+ *        application starts shedding load, or 0 to never shed load.
+ *
+ * See @c Misc::OverloadController for the actions taken under overload.
+ */
+int JSON::ProjectModel::overloadThreshold() const
+{
+  return m_overloadThreshold;
+}
+
+/**
+ * @brief Returns the fraction of the frames (one out of N) that the dashboard
+ *        processes while the application is overloaded.
+ */
+int JSON::ProjectModel::overloadDecimation() const
+{
+  return m_overloadDecimation;
+}
+
 //------------------------------------------------------------------------------
 // Document information functions
 //------------------------------------------------------------------------------
@@ -311,6 +548,25 @@ QString JSON::ProjectModel::osmAddress() const
   return QStringLiteral("http://localhost:%1").arg(m_server.serverPort());
 }
 
+/**
+ * @brief Returns the directory in which downloaded map tiles are stored.
+ *
+ * The directory persists across sessions, so that previously visited areas
+ * are rendered without downloading their tiles again. It is created if it
+ * does not exist.
+ */
+QString JSON::ProjectModel::osmCachePath() const
+{
+  static QString path = QString("%1/Map Tiles/").arg(
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QDir dir(path);
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  return path;
+}
+
 /**
  * @brief Retrieves the currently selected item's text.
  *
@@ -552,6 +808,9 @@ quint8 JSON::ProjectModel::datasetOptions() const
   if (m_selectedDataset.fft())
     option |= SerialStudio::DatasetFFT;
 
+  if (m_selectedDataset.waterfall())
+    option |= SerialStudio::DatasetWaterfall;
+
   if (m_selectedDataset.led())
     option |= SerialStudio::DatasetLED;
 
@@ -760,9 +1019,27 @@ bool JSON::ProjectModel::saveJsonFile(const bool askPath)
   json.insert("frameEnd", m_frameEndSequence);
   json.insert("frameParser", m_frameParserCode);
   json.insert("frameDetection", m_frameDetection);
+  json.insert("frameHeader", m_frameHeader);
+  json.insert("lengthFieldSize", m_lengthFieldSize);
+  json.insert("lengthBigEndian", m_lengthBigEndian);
+  json.insert("checksum", m_checksumAlgorithm);
+  json.insert("checksumPosition", m_checksumPosition);
+  json.insert("checksumBigEndian", m_checksumBigEndian);
+  json.insert("checksumStart", m_checksumStart);
+  json.insert("checksumEnd", m_checksumEnd);
+  json.insert("statelessParser", m_statelessParser);
+  json.insert("sequenceField", m_sequenceField);
+  json.insert("timestampField", m_timestampField);
+  json.insert("timestampBits", m_timestampBits);
+  json.insert("overloadThreshold", m_overloadThreshold);
+  json.insert("overloadDecimation", m_overloadDecimation);
   json.insert("frameStart", m_frameStartSequence);
   json.insert("mapTilerApiKey", m_mapTilerApiKey);
   json.insert("thunderforestApiKey", m_thunderforestApiKey);
+  if (!m_nativeParser.isEmpty())
+    json.insert("nativeParser", m_nativeParser);
+  if (!m_parserPlugin.isEmpty())
+    json.insert("parserPlugin", m_parserPlugin);
 
   // Create group array
   QJsonArray groupArray;
@@ -808,6 +1085,9 @@ void JSON::ProjectModel::setupExternalConnections()
   // Generate combo-boxes again when app is translated
   connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
           this, [=] {
+            if (!m_editorActive)
+              return;
+
             generateComboBoxModels();
             buildTreeModel();
 
@@ -861,7 +1141,23 @@ void JSON::ProjectModel::newJsonFile()
   m_frameEndSequence = "\\n";
   m_mapTilerApiKey = "";
   m_thunderforestApiKey = "";
+  m_nativeParser = QJsonObject();
+  m_parserPlugin = QJsonObject();
   m_frameStartSequence = "$";
+  m_statelessParser = false;
+  m_sequenceField = 0;
+  m_timestampField = 0;
+  m_timestampBits = 32;
+  m_overloadThreshold = kDefaultOverloadThreshold;
+  m_overloadDecimation = kDefaultOverloadDecimation;
+  m_frameHeader = "";
+  m_lengthFieldSize = 2;
+  m_lengthBigEndian = false;
+  m_checksumAlgorithm = SerialStudio::ChecksumAuto;
+  m_checksumPosition = SerialStudio::ChecksumTrailer;
+  m_checksumBigEndian = true;
+  m_checksumStart = 0;
+  m_checksumEnd = 0;
   m_title = tr("Untitled Project");
   m_frameParserCode = JSON::FrameParser::defaultCode();
 
@@ -935,17 +1231,19 @@ void JSON::ProjectModel::openJsonFile(const QString &path)
   if (path.isEmpty())
     return;
 
-  // Open file
+  // Open file, reuse the document parsed by the frame builder if possible
   QFile file(path);
-  QJsonDocument document;
+  QJsonObject json;
   if (file.open(QFile::ReadOnly))
   {
-    document = QJsonDocument::fromJson(file.readAll());
+    if (!JSON::ProjectCache::instance().parse(file.readAll(), &json))
+      json = QJsonObject();
+
     file.close();
   }
 
   // Validate JSON document
-  if (document.isEmpty())
+  if (json.isEmpty())
     return;
 
   // Reset C++ model
@@ -955,17 +1253,41 @@ void JSON::ProjectModel::openJsonFile(const QString &path)
   m_filePath = path;
 
   // Read data from JSON document
-  auto json = document.object();
   m_title = json.value("title").toString();
   m_frameEndSequence = json.value("frameEnd").toString();
   m_frameParserCode = json.value("frameParser").toString();
   m_frameStartSequence = json.value("frameStart").toString();
   m_mapTilerApiKey = json.value("mapTilerApiKey").toString();
   m_thunderforestApiKey = json.value("thunderforestApiKey").toString();
+  m_nativeParser = json.value("nativeParser").toObject();
+  m_parserPlugin = json.value("parserPlugin").toObject();
+  m_statelessParser = json.value("statelessParser").toBool();
+  m_sequenceField = qMax(0, json.value("sequenceField").toInt());
+  m_timestampField = qMax(0, json.value("timestampField").toInt());
+  m_timestampBits = qBound(8, json.value("timestampBits").toInt(32), 64);
+  m_overloadThreshold = qBound(
+      0, json.value("overloadThreshold").toInt(kDefaultOverloadThreshold), 100);
+  m_overloadDecimation = qBound(
+      1, json.value("overloadDecimation").toInt(kDefaultOverloadDecimation),
+      kMaxOverloadDecimation);
   m_frameDecoder
       = static_cast<SerialStudio::DecoderMethod>(json.value("decoder").toInt());
   m_frameDetection = static_cast<SerialStudio::FrameDetection>(
       json.value("frameDetection").toInt());
+  m_frameHeader = json.value("frameHeader").toString();
+  m_lengthFieldSize = json.value("lengthFieldSize").toInt(2);
+  m_lengthBigEndian = json.value("lengthBigEndian").toBool();
+  if (!std::count(std::begin(kLengthFieldSizes), std::end(kLengthFieldSizes),
+                  m_lengthFieldSize))
+    m_lengthFieldSize = 2;
+
+  m_checksumAlgorithm = static_cast<SerialStudio::ChecksumAlgorithm>(
+      qBound(0, json.value("checksum").toInt(), 8));
+  m_checksumPosition = static_cast<SerialStudio::ChecksumPosition>(
+      qBound(0, json.value("checksumPosition").toInt(), 1));
+  m_checksumBigEndian = json.value("checksumBigEndian").toBool(true);
+  m_checksumStart = qMax(0, json.value("checksumStart").toInt());
+  m_checksumEnd = qMax(0, json.value("checksumEnd").toInt());
 
   // Preserve compatibility with previous projects
   if (!json.contains("frameDetection"))
@@ -1058,9 +1380,9 @@ void JSON::ProjectModel::openJsonFile(const QString &path)
  *
  * This function prompts the user for confirmation before deleting the
  * currently selected group. If the user confirms, the group is removed from
- * the project, and group and dataset IDs areregenerated. The tree model is
- * rebuilt, the modified flag is set, and the project item is selected in the
- * UI.
+ * the project, and group and dataset IDs areregenerated. The group item is
+ * removed from the tree model, the modified flag is set, and the project item
+ * is selected in the UI.
  */
 void JSON::ProjectModel::deleteCurrentGroup()
 {
@@ -1075,7 +1397,9 @@ void JSON::ProjectModel::deleteCurrentGroup()
     return;
 
   // Delete the group
-  m_groups.removeAt(m_selectedGroup.groupId());
+  const auto groupId = m_selectedGroup.groupId();
+  auto *item = groupItem(groupId);
+  m_groups.removeAt(groupId);
 
   // Regenerate group IDs
   int id = 0;
@@ -1086,8 +1410,12 @@ void JSON::ProjectModel::deleteCurrentGroup()
       d->m_groupId = id;
   }
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Remove the group item & update the items of the following groups
+  removeTreeItem(item);
+  for (int g = groupId; g < m_groups.count(); ++g)
+    updateGroupItem(g);
+
+  // Set modification flag
   setModified(true);
 
   // Select project item
@@ -1100,8 +1428,9 @@ void JSON::ProjectModel::deleteCurrentGroup()
  *
  * This function prompts the user for confirmation before deleting the
  * currently selected action. If the user confirms, the action is removed from
- * the project, and action IDs areregenerated. The tree model is rebuilt, the
- * modified flag is set, and the project item is selected in the UI.
+ * the project, and action IDs areregenerated. The action item is removed from
+ * the tree model, the modified flag is set, and the project item is selected
+ * in the UI.
  */
 void JSON::ProjectModel::deleteCurrentAction()
 {
@@ -1116,15 +1445,21 @@ void JSON::ProjectModel::deleteCurrentAction()
     return;
 
   // Delete the action
-  m_actions.removeAt(m_selectedAction.actionId());
+  const auto actionId = m_selectedAction.actionId();
+  auto *item = actionItem(actionId);
+  m_actions.removeAt(actionId);
 
   // Regenerate action IDs
   int id = 0;
   for (auto a = m_actions.begin(); a != m_actions.end(); ++a, ++id)
     a->m_actionId = id;
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Remove the action item & update the items of the following actions
+  removeTreeItem(item);
+  for (int a = actionId; a < m_actions.count(); ++a)
+    updateActionItem(a);
+
+  // Set modification flag
   setModified(true);
 
   // Select project item
@@ -1138,8 +1473,8 @@ void JSON::ProjectModel::deleteCurrentAction()
  * This function prompts the user for confirmation before deleting the
  * currently selected dataset. If the user confirms, the dataset is removed
  * from the associated group, and dataset IDs within the group are reassigned.
- * The tree model is rebuilt, the modified flag is set, and the parent group
- * is selected in the UI.
+ * The dataset item is removed from the tree model, the modified flag is set,
+ * and the parent group is selected in the UI.
  */
 void JSON::ProjectModel::deleteCurrentDataset()
 {
@@ -1159,6 +1494,7 @@ void JSON::ProjectModel::deleteCurrentDataset()
   const auto datasetId = m_selectedDataset.datasetId();
 
   // Remove dataset
+  auto *item = datasetItem(groupId, datasetId);
   m_groups[groupId].m_datasets.removeAt(datasetId);
 
   // Reassign dataset IDs
@@ -1168,20 +1504,13 @@ void JSON::ProjectModel::deleteCurrentDataset()
   for (auto dataset = begin; dataset != end; ++dataset, ++id)
     dataset->m_datasetId = id;
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Remove the dataset item, update the group & set modification flag
+  removeTreeItem(item);
+  updateGroupItem(groupId);
   setModified(true);
 
   // Select parent group
-  for (auto i = m_groupItems.constBegin(); i != m_groupItems.constEnd(); ++i)
-  {
-    if (i.value().groupId() == groupId)
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(groupItem(groupId));
 }
 
 /**
@@ -1196,6 +1525,7 @@ void JSON::ProjectModel::duplicateCurrentGroup()
   // Initialize a new group
   auto group = JSON::Group(m_groups.count());
   group.m_widget = m_selectedGroup.widget();
+  group.m_refreshClass = m_selectedGroup.refreshClass();
   group.m_title = tr("%1 (Copy)").arg(m_selectedGroup.title());
   for (auto i = 0; i < m_selectedGroup.m_datasets.count(); ++i)
   {
@@ -1208,20 +1538,12 @@ void JSON::ProjectModel::duplicateCurrentGroup()
   // Register the group
   m_groups.append(group);
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Add the group item & set modification flag
+  insertGroupItem(group.groupId());
   setModified(true);
 
   // Select the group
-  for (auto i = m_groupItems.constBegin(); i != m_groupItems.constEnd(); ++i)
-  {
-    if (i.value().groupId() == group.groupId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(groupItem(group.groupId()));
 }
 
 /**
@@ -1239,24 +1561,18 @@ void JSON::ProjectModel::duplicateCurrentAction()
   action.m_eolSequence = m_selectedAction.eolSequence();
   action.m_txData = m_selectedAction.txData();
   action.m_icon = m_selectedAction.icon();
+  action.m_repeatInterval = m_selectedAction.repeatInterval();
+  action.encodePayload();
 
   // Register the group
   m_actions.append(action);
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Add the action item & set modification flag
+  insertActionItem(action.actionId());
   setModified(true);
 
   // Select the action
-  for (auto i = m_actionItems.constBegin(); i != m_actionItems.constEnd(); ++i)
-  {
-    if (i.value().actionId() == action.actionId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(actionItem(action.actionId()));
 }
 
 /**
@@ -1278,21 +1594,12 @@ void JSON::ProjectModel::duplicateCurrentDataset()
   // Register the dataset to the group
   m_groups[dataset.groupId()].m_datasets.append(dataset);
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Add the dataset item & set modification flag
+  updateGroupItem(dataset.groupId());
   setModified(true);
 
   // Select dataset
-  for (auto i = m_datasetItems.begin(); i != m_datasetItems.end(); ++i)
-  {
-    if (i.value().groupId() == dataset.groupId()
-        && i.value().datasetId() == dataset.datasetId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(datasetItem(dataset.groupId(), dataset.datasetId()));
 }
 
 /**
@@ -1300,8 +1607,8 @@ void JSON::ProjectModel::duplicateCurrentDataset()
  *
  * This function creates a new dataset based on the provided option, assigns
  * it a unique title, ID, and frame index, and adds it to the selected group.
- * The tree model is rebuilt, the modification flag is set, and the group is
- * reselected to rebuild the dataset model.
+ * The dataset item is added to the tree model, the modification flag is set,
+ * and the new dataset is selected.
  *
  * @param option The dataset option that defines the type of dataset to add
  *               (e.g., Plot, FFT, Bar, Gauge, Compass).
@@ -1327,6 +1634,10 @@ void JSON::ProjectModel::addDataset(const SerialStudio::DatasetOption option)
       title = tr("New FFT Plot");
       dataset.m_fft = true;
       break;
+    case SerialStudio::DatasetWaterfall:
+      title = tr("New Waterfall Plot");
+      dataset.m_waterfall = true;
+      break;
     case SerialStudio::DatasetBar:
       title = tr("New Bar Widget");
       dataset.m_widget = QStringLiteral("bar");
@@ -1386,21 +1697,12 @@ void JSON::ProjectModel::addDataset(const SerialStudio::DatasetOption option)
   // Add dataset to group
   m_groups[groupId].m_datasets.append(dataset);
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Add the dataset item & set modification flag
+  updateGroupItem(groupId);
   setModified(true);
 
   // Select newly added dataset item
-  for (auto i = m_datasetItems.begin(); i != m_datasetItems.end(); ++i)
-  {
-    if (i.value().datasetId() == dataset.datasetId()
-        && i.value().groupId() == dataset.groupId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(datasetItem(groupId, dataset.datasetId()));
 }
 
 /**
@@ -1408,8 +1710,8 @@ void JSON::ProjectModel::addDataset(const SerialStudio::DatasetOption option)
  *
  * This function modifies the currently selected dataset's options (e.g.,
  * enabling/disabling plots, FFT, or widgets) based on the provided option and
- * checked state. The dataset is updated, the tree model is rebuilt, and the
- * dataset is reselected to rebuild the dataset model.
+ * checked state. The dataset & its tree item are updated, and the dataset
+ * model is rebuilt.
  *
  * @param option The dataset option to modify (e.g., Plot, Bar, Gauge, etc).
  * @param checked A boolean indicating whether the option should be enabled
@@ -1427,6 +1729,9 @@ void JSON::ProjectModel::changeDatasetOption(
     case SerialStudio::DatasetFFT:
       m_selectedDataset.m_fft = checked;
       break;
+    case SerialStudio::DatasetWaterfall:
+      m_selectedDataset.m_waterfall = checked;
+      break;
     case SerialStudio::DatasetBar:
       m_selectedDataset.m_widget = checked ? QStringLiteral("bar") : "";
       break;
@@ -1448,20 +1753,12 @@ void JSON::ProjectModel::changeDatasetOption(
   const auto datasetId = m_selectedDataset.datasetId();
   m_groups[groupId].m_datasets.replace(datasetId, m_selectedDataset);
 
-  // Build tree model & set modification flag
-  buildTreeModel();
+  // Update the dataset item & set modification flag
+  updateDatasetItem(groupId, datasetId);
   setModified(true);
 
-  // Select dataset item again to rebuild dataset model
-  for (auto i = m_datasetItems.begin(); i != m_datasetItems.end(); ++i)
-  {
-    if (i.value().datasetId() == datasetId && i.value().groupId() == groupId)
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  // Rebuild dataset model
+  buildDatasetModel(m_selectedDataset);
 }
 
 /**
@@ -1513,19 +1810,11 @@ void JSON::ProjectModel::addAction()
   m_actions.append(action);
 
   // Update the user interface
-  buildTreeModel();
+  insertActionItem(action.actionId());
   setModified(true);
 
   // Select action
-  for (auto i = m_actionItems.constBegin(); i != m_actionItems.constEnd(); ++i)
-  {
-    if (i.value().actionId() == action.actionId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(actionItem(action.actionId()));
 }
 
 /**
@@ -1582,19 +1871,11 @@ void JSON::ProjectModel::addGroup(const QString &title,
   setGroupWidget(m_groups.count() - 1, widget);
 
   // Update the user interface
-  buildTreeModel();
+  insertGroupItem(group.groupId());
   setModified(true);
 
   // Select group
-  for (auto i = m_groupItems.constBegin(); i != m_groupItems.constEnd(); ++i)
-  {
-    if (i.value().groupId() == group.groupId())
-    {
-      m_selectionModel->setCurrentIndex(i.key()->index(),
-                                        QItemSelectionModel::ClearAndSelect);
-      break;
-    }
-  }
+  selectTreeItem(groupItem(group.groupId()));
 }
 
 /**
@@ -1861,6 +2142,10 @@ void JSON::ProjectModel::displayFrameParserView()
  */
 void JSON::ProjectModel::buildTreeModel()
 {
+  // The editor models are built when the project editor is opened
+  if (!m_editorActive)
+    return;
+
   // Clear model/pointer maps
   m_rootItems.clear();
   m_groupItems.clear();
@@ -1919,77 +2204,19 @@ void JSON::ProjectModel::buildTreeModel()
   m_rootItems.insert(frameParsingCode, kFrameParser);
 
   // Iterare through the actions and add them to the model
-  for (int aIndex = 0; aIndex < m_actions.size(); ++aIndex)
-  {
-    // Create action item
-    const auto action = m_actions[aIndex];
-    auto *actionItem = new QStandardItem(action.title());
-
-    // Configure action item
-    const auto icon = "qrc:/rcc/icons/project-editor/treeview/action.svg";
-    actionItem->setData(-1, TreeViewFrameIndex);
-    actionItem->setData(icon, TreeViewIcon);
-    actionItem->setData(action.title(), TreeViewText);
-
-    // Register action item
-    root->appendRow(actionItem);
-    m_actionItems.insert(actionItem, action);
-  }
+  for (const auto &action : std::as_const(m_actions))
+    root->appendRow(createActionItem(action));
 
   // Iterate through the groups and add them to the model
-  for (int gIndex = 0; gIndex < m_groups.size(); ++gIndex)
-  {
-    // Create group item
-    const auto group = m_groups[gIndex];
-    auto *groupItem = new QStandardItem(group.title());
-
-    // Decide which icon to use for the group
-    QString icon;
-    if (group.widget() == "map")
-      icon = "qrc:/rcc/icons/project-editor/treeview/gps.svg";
-    else if (group.widget() == "accelerometer")
-      icon = "qrc:/rcc/icons/project-editor/treeview/accelerometer.svg";
-    else if (group.widget() == "gyro")
-      icon = "qrc:/rcc/icons/project-editor/treeview/gyroscope.svg";
-    else if (group.widget() == "multiplot")
-      icon = "qrc:/rcc/icons/project-editor/treeview/multiplot.svg";
-    else if (group.widget() == "datagrid")
-      icon = "qrc:/rcc/icons/project-editor/treeview/datagrid.svg";
-    else
-      icon = "qrc:/rcc/icons/project-editor/treeview/group.svg";
-
-    // Set metadata for the group item
-    groupItem->setData(icon, TreeViewIcon);
-    groupItem->setData(-1, TreeViewFrameIndex);
-    groupItem->setData(group.title(), TreeViewText);
-
-    // Iterate through the datasets within this group and add them as children
-    for (int dIndex = 0; dIndex < group.datasets().size(); ++dIndex)
-    {
-      // Create dataset item
-      const auto dataset = group.datasets()[dIndex];
-      auto *datasetItem = new QStandardItem(dataset.title());
-      const auto icon = "qrc:/rcc/icons/project-editor/treeview/dataset.svg";
-      datasetItem->setData(icon, TreeViewIcon);
-      datasetItem->setData(dataset.title(), TreeViewText);
-      datasetItem->setData(dataset.index(), TreeViewFrameIndex);
-
-      // Add dataset item as child for group item
-      groupItem->appendRow(datasetItem);
-
-      // Create relationship with dataset item & actual dataset
-      m_datasetItems.insert(datasetItem, dataset);
-    }
-
-    // Restore expanded states for the group
-    restoreExpandedStateMap(groupItem, expandedStates,
+  for (const auto &group : std::as_const(m_groups))
+  {
+    // Create group item & restore its expanded state
+    auto *item = createGroupItem(group);
+    restoreExpandedStateMap(item, expandedStates,
                             root->text() + "/" + group.title());
 
     // Add the group item to the root
-    root->appendRow(groupItem);
-
-    // Create relationship with group item & actual group
-    m_groupItems.insert(groupItem, group);
+    root->appendRow(item);
   }
 
   // Construct selection model
@@ -2001,6 +2228,270 @@ void JSON::ProjectModel::buildTreeModel()
   Q_EMIT treeModelChanged();
 }
 
+//------------------------------------------------------------------------------
+// Incremental tree model updates
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Creates & registers the tree item of the given @a group, including
+ *        the items of its datasets.
+ *
+ * @param group The group represented by the item.
+ * @return The new item, owned by the caller until it is added to the model.
+ */
+QStandardItem *JSON::ProjectModel::createGroupItem(const JSON::Group &group)
+{
+  // Create group item
+  auto *item = new QStandardItem(group.title());
+  item->setData(true, TreeViewExpanded);
+  item->setData(-1, TreeViewFrameIndex);
+  item->setData(group.title(), TreeViewText);
+  item->setData(groupIcon(group.widget()), TreeViewIcon);
+
+  // Add the datasets of the group as children
+  for (const auto &dataset : group.datasets())
+    item->appendRow(createDatasetItem(dataset));
+
+  // Create relationship with group item & actual group
+  m_groupItems.insert(item, group);
+  return item;
+}
+
+/**
+ * @brief Creates & registers the tree item of the given @a action.
+ *
+ * @param action The action represented by the item.
+ * @return The new item, owned by the caller until it is added to the model.
+ */
+QStandardItem *JSON::ProjectModel::createActionItem(const JSON::Action &action)
+{
+  const auto icon = "qrc:/rcc/icons/project-editor/treeview/action.svg";
+  auto *item = new QStandardItem(action.title());
+  item->setData(-1, TreeViewFrameIndex);
+  item->setData(icon, TreeViewIcon);
+  item->setData(action.title(), TreeViewText);
+  m_actionItems.insert(item, action);
+  return item;
+}
+
+/**
+ * @brief Creates & registers the tree item of the given @a dataset.
+ *
+ * @param dataset The dataset represented by the item.
+ * @return The new item, owned by the caller until it is added to the model.
+ */
+QStandardItem *
+JSON::ProjectModel::createDatasetItem(const JSON::Dataset &dataset)
+{
+  const auto icon = "qrc:/rcc/icons/project-editor/treeview/dataset.svg";
+  auto *item = new QStandardItem(dataset.title());
+  item->setData(icon, TreeViewIcon);
+  item->setData(dataset.title(), TreeViewText);
+  item->setData(dataset.index(), TreeViewFrameIndex);
+  m_datasetItems.insert(item, dataset);
+  return item;
+}
+
+/**
+ * @brief Returns the tree item of the group with the given ID.
+ *
+ * The project root item lists the frame parser function, the actions and the
+ * groups in this order, so the item is found by its row.
+ *
+ * @param groupId The ID of the group.
+ * @return The group item, or @c nullptr if it does not exist.
+ */
+QStandardItem *JSON::ProjectModel::groupItem(const int groupId) const
+{
+  auto *root = m_treeModel ? m_treeModel->item(0) : nullptr;
+  if (!root || groupId < 0)
+    return nullptr;
+
+  return root->child(1 + m_actionItems.count() + groupId);
+}
+
+/**
+ * @brief Returns the tree item of the action with the given ID.
+ *
+ * @param actionId The ID of the action.
+ * @return The action item, or @c nullptr if it does not exist.
+ */
+QStandardItem *JSON::ProjectModel::actionItem(const int actionId) const
+{
+  auto *root = m_treeModel ? m_treeModel->item(0) : nullptr;
+  if (!root || actionId < 0 || actionId >= m_actionItems.count())
+    return nullptr;
+
+  return root->child(1 + actionId);
+}
+
+/**
+ * @brief Returns the tree item of a dataset.
+ *
+ * @param groupId The ID of the parent group.
+ * @param datasetId The ID of the dataset within its group.
+ * @return The dataset item, or @c nullptr if it does not exist.
+ */
+QStandardItem *JSON::ProjectModel::datasetItem(const int groupId,
+                                               const int datasetId) const
+{
+  auto *group = groupItem(groupId);
+  return group && datasetId >= 0 ? group->child(datasetId) : nullptr;
+}
+
+/**
+ * @brief Appends the item of the group with the given ID to the tree model.
+ *
+ * @param groupId The ID of the group, which must be the last group.
+ */
+void JSON::ProjectModel::insertGroupItem(const int groupId)
+{
+  auto *root = m_treeModel ? m_treeModel->item(0) : nullptr;
+  if (!root)
+    return;
+
+  const auto row = 1 + m_actionItems.count() + groupId;
+  root->insertRow(row, createGroupItem(m_groups.at(groupId)));
+}
+
+/**
+ * @brief Appends the item of the action with the given ID to the tree model.
+ *
+ * @param actionId The ID of the action, which must be the last action.
+ */
+void JSON::ProjectModel::insertActionItem(const int actionId)
+{
+  auto *root = m_treeModel ? m_treeModel->item(0) : nullptr;
+  if (!root)
+    return;
+
+  root->insertRow(1 + actionId, createActionItem(m_actions.at(actionId)));
+}
+
+/**
+ * @brief Removes a group, action or dataset item from the tree model.
+ *
+ * The current selection is cleared first, so that the selection model does
+ * not move to a neighbouring item while the IDs of the remaining items are
+ * being updated.
+ *
+ * @param item The item to remove.
+ */
+void JSON::ProjectModel::removeTreeItem(QStandardItem *item)
+{
+  if (!item || !m_treeModel)
+    return;
+
+  // Unregister the item & its children
+  for (int i = 0; i < item->rowCount(); ++i)
+    m_datasetItems.remove(item->child(i));
+
+  m_groupItems.remove(item);
+  m_actionItems.remove(item);
+  m_datasetItems.remove(item);
+
+  // Clear the selection & delete the item
+  if (m_selectionModel)
+    m_selectionModel->clearCurrentIndex();
+
+  auto *parent = item->parent();
+  if (!parent)
+    parent = m_treeModel->invisibleRootItem();
+
+  parent->removeRow(item->row());
+}
+
+/**
+ * @brief Updates the tree item of a group & the items of its datasets.
+ *
+ * Dataset items are updated in place, the items of removed datasets are
+ * deleted and items are created for new datasets, so that the cost of the
+ * update does not depend on the size of the rest of the project.
+ *
+ * @param groupId The ID of the group.
+ */
+void JSON::ProjectModel::updateGroupItem(const int groupId)
+{
+  auto *item = groupItem(groupId);
+  if (!item)
+    return;
+
+  // Update the group item
+  const auto &group = m_groups.at(groupId);
+  item->setText(group.title());
+  item->setData(group.title(), TreeViewText);
+  item->setData(groupIcon(group.widget()), TreeViewIcon);
+  m_groupItems[item] = group;
+
+  // Remove the items of deleted datasets
+  const auto &datasets = group.datasets();
+  while (item->rowCount() > datasets.count())
+  {
+    const auto row = item->rowCount() - 1;
+    m_datasetItems.remove(item->child(row));
+    item->removeRow(row);
+  }
+
+  // Update the existing dataset items & add the new ones
+  for (int d = 0; d < datasets.count(); ++d)
+  {
+    if (d < item->rowCount())
+      updateDatasetItem(groupId, d);
+    else
+      item->appendRow(createDatasetItem(datasets.at(d)));
+  }
+}
+
+/**
+ * @brief Updates the tree item of the action with the given ID.
+ *
+ * @param actionId The ID of the action.
+ */
+void JSON::ProjectModel::updateActionItem(const int actionId)
+{
+  auto *item = actionItem(actionId);
+  if (!item)
+    return;
+
+  const auto &action = m_actions.at(actionId);
+  item->setText(action.title());
+  item->setData(action.title(), TreeViewText);
+  m_actionItems[item] = action;
+}
+
+/**
+ * @brief Updates the tree item of a dataset & the group registered for its
+ *        parent item.
+ *
+ * @param groupId The ID of the parent group.
+ * @param datasetId The ID of the dataset within its group.
+ */
+void JSON::ProjectModel::updateDatasetItem(const int groupId,
+                                           const int datasetId)
+{
+  auto *item = datasetItem(groupId, datasetId);
+  if (!item)
+    return;
+
+  const auto &group = m_groups.at(groupId);
+  const auto &dataset = group.datasets().at(datasetId);
+  item->setText(dataset.title());
+  item->setData(dataset.title(), TreeViewText);
+  item->setData(dataset.index(), TreeViewFrameIndex);
+  m_datasetItems[item] = dataset;
+  m_groupItems[item->parent()] = group;
+}
+
+/**
+ * @brief Makes the given tree @a item the current item of the project editor.
+ */
+void JSON::ProjectModel::selectTreeItem(QStandardItem *item)
+{
+  if (item && m_selectionModel)
+    m_selectionModel->setCurrentIndex(item->index(),
+                                      QItemSelectionModel::ClearAndSelect);
+}
+
 /**
  * @brief Builds the project model that contains project configuration
  * settings.
@@ -2016,6 +2507,10 @@ void JSON::ProjectModel::buildTreeModel()
  */
 void JSON::ProjectModel::buildProjectModel()
 {
+  // The editor models are built when the project editor is opened
+  if (!m_editorActive)
+    return;
+
   // Clear the existing model
   if (m_projectModel)
   {
@@ -2092,6 +2587,186 @@ void JSON::ProjectModel::buildProjectModel()
     m_projectModel->appendRow(frameEnd);
   }
 
+  // Add length-prefix options
+  if (m_frameDetection == SerialStudio::LengthPrefixed)
+  {
+    auto header = new QStandardItem();
+    header->setEditable(true);
+    header->setData(TextField, WidgetType);
+    header->setData(m_frameHeader, EditableValue);
+    header->setData(tr("Frame Header (Hex)"), ParameterName);
+    header->setData(kProjectView_FrameHeader, ParameterType);
+    header->setData(QStringLiteral("AA 55"), PlaceholderValue);
+    header->setData(tr("Bytes preceding the length field (optional)"),
+                    ParameterDescription);
+    m_projectModel->appendRow(header);
+
+    const auto sizes = std::begin(kLengthFieldSizes);
+    const auto index = std::find(sizes, std::end(kLengthFieldSizes),
+                                 m_lengthFieldSize)
+                       - sizes;
+
+    auto lengthSize = new QStandardItem();
+    lengthSize->setEditable(true);
+    lengthSize->setData(ComboBox, WidgetType);
+    lengthSize->setData(m_lengthFieldSizes, ComboBoxData);
+    lengthSize->setData(static_cast<int>(index), EditableValue);
+    lengthSize->setData(tr("Length Field Size"), ParameterName);
+    lengthSize->setData(kProjectView_LengthFieldSize, ParameterType);
+    lengthSize->setData(tr("Width of the payload length field"),
+                        ParameterDescription);
+    m_projectModel->appendRow(lengthSize);
+
+    auto bigEndian = new QStandardItem();
+    bigEndian->setEditable(true);
+    bigEndian->setData(CheckBox, WidgetType);
+    bigEndian->setData(m_lengthBigEndian, EditableValue);
+    bigEndian->setData(tr("Big-Endian Length"), ParameterName);
+    bigEndian->setData(kProjectView_LengthBigEndian, ParameterType);
+    bigEndian->setData(0, PlaceholderValue);
+    bigEndian->setData(tr("Send the most significant length byte first"),
+                       ParameterDescription);
+    m_projectModel->appendRow(bigEndian);
+  }
+
+  // Add checksum algorithm
+  auto checksum = new QStandardItem();
+  checksum->setEditable(true);
+  checksum->setData(ComboBox, WidgetType);
+  checksum->setData(m_checksumAlgorithms, ComboBoxData);
+  checksum->setData(m_checksumAlgorithm, EditableValue);
+  checksum->setData(tr("Checksum"), ParameterName);
+  checksum->setData(kProjectView_ChecksumAlgorithm, ParameterType);
+  checksum->setData(tr("Algorithm used to validate each frame"),
+                    ParameterDescription);
+  m_projectModel->appendRow(checksum);
+
+  // Add declared checksum options
+  if (m_checksumAlgorithm > SerialStudio::NoChecksum)
+  {
+    auto position = new QStandardItem();
+    position->setEditable(true);
+    position->setData(ComboBox, WidgetType);
+    position->setData(m_checksumPositions, ComboBoxData);
+    position->setData(m_checksumPosition, EditableValue);
+    position->setData(tr("Checksum Position"), ParameterName);
+    position->setData(kProjectView_ChecksumPosition, ParameterType);
+    position->setData(tr("Location of the checksum within the frame"),
+                      ParameterDescription);
+    m_projectModel->appendRow(position);
+
+    auto bigEndian = new QStandardItem();
+    bigEndian->setEditable(true);
+    bigEndian->setData(CheckBox, WidgetType);
+    bigEndian->setData(m_checksumBigEndian, EditableValue);
+    bigEndian->setData(tr("Big-Endian Checksum"), ParameterName);
+    bigEndian->setData(kProjectView_ChecksumBigEndian, ParameterType);
+    bigEndian->setData(0, PlaceholderValue);
+    bigEndian->setData(tr("Send the most significant checksum byte first"),
+                       ParameterDescription);
+    m_projectModel->appendRow(bigEndian);
+
+    auto start = new QStandardItem();
+    start->setEditable(true);
+    start->setData(IntField, WidgetType);
+    start->setData(m_checksumStart, EditableValue);
+    start->setData(tr("Checksum Skip Start"), ParameterName);
+    start->setData(kProjectView_ChecksumStart, ParameterType);
+    start->setData(0, PlaceholderValue);
+    start->setData(tr("Leading frame bytes excluded from the checksum"),
+                   ParameterDescription);
+    m_projectModel->appendRow(start);
+
+    auto end = new QStandardItem();
+    end->setEditable(true);
+    end->setData(IntField, WidgetType);
+    end->setData(m_checksumEnd, EditableValue);
+    end->setData(tr("Checksum Skip End"), ParameterName);
+    end->setData(kProjectView_ChecksumEnd, ParameterType);
+    end->setData(0, PlaceholderValue);
+    end->setData(tr("Trailing frame bytes excluded from the checksum"),
+                 ParameterDescription);
+    m_projectModel->appendRow(end);
+  }
+
+  // Add stateless parser checkbox
+  auto stateless = new QStandardItem();
+  stateless->setEditable(true);
+  stateless->setData(CheckBox, WidgetType);
+  stateless->setData(m_statelessParser, EditableValue);
+  stateless->setData(tr("Stateless Frame Parser"), ParameterName);
+  stateless->setData(kProjectView_StatelessParser, ParameterType);
+  stateless->setData(0, PlaceholderValue);
+  stateless->setData(tr("Parse frames in parallel, in any order"),
+                     ParameterDescription);
+  m_projectModel->appendRow(stateless);
+
+  // Add device frame counter field
+  auto sequence = new QStandardItem();
+  sequence->setEditable(true);
+  sequence->setData(IntField, WidgetType);
+  sequence->setData(m_sequenceField, EditableValue);
+  sequence->setData(tr("Frame Counter Index"), ParameterName);
+  sequence->setData(kProjectView_SequenceField, ParameterType);
+  sequence->setData(0, PlaceholderValue);
+  sequence->setData(tr("Frame counter sent by the device (0 = none)"),
+                    ParameterDescription);
+  m_projectModel->appendRow(sequence);
+
+  // Add device timestamp field
+  auto timestamp = new QStandardItem();
+  timestamp->setEditable(true);
+  timestamp->setData(IntField, WidgetType);
+  timestamp->setData(m_timestampField, EditableValue);
+  timestamp->setData(tr("Device Timestamp Index"), ParameterName);
+  timestamp->setData(kProjectView_TimestampField, ParameterType);
+  timestamp->setData(0, PlaceholderValue);
+  timestamp->setData(tr("Microsecond counter sent by the device (0 = none)"),
+                     ParameterDescription);
+  m_projectModel->appendRow(timestamp);
+
+  // Add device timestamp width
+  if (m_timestampField > 0)
+  {
+    auto bits = new QStandardItem();
+    bits->setEditable(true);
+    bits->setData(IntField, WidgetType);
+    bits->setData(m_timestampBits, EditableValue);
+    bits->setData(tr("Device Timestamp Bits"), ParameterName);
+    bits->setData(kProjectView_TimestampBits, ParameterType);
+    bits->setData(32, PlaceholderValue);
+    bits->setData(tr("Width of the counter before it wraps around"),
+                  ParameterDescription);
+    m_projectModel->appendRow(bits);
+  }
+
+  // Add load shedding threshold
+  auto overload = new QStandardItem();
+  overload->setEditable(true);
+  overload->setData(IntField, WidgetType);
+  overload->setData(m_overloadThreshold, EditableValue);
+  overload->setData(tr("Overload Threshold (%)"), ParameterName);
+  overload->setData(kProjectView_OverloadThreshold, ParameterType);
+  overload->setData(kDefaultOverloadThreshold, PlaceholderValue);
+  overload->setData(tr("Queue fill at which load is shed (0 = never)"),
+                    ParameterDescription);
+  m_projectModel->appendRow(overload);
+
+  // Add dashboard decimation under overload
+  if (m_overloadThreshold > 0)
+  {
+    auto decimation = new QStandardItem();
+    decimation->setEditable(true);
+    decimation->setData(IntField, WidgetType);
+    decimation->setData(m_overloadDecimation, EditableValue);
+    decimation->setData(tr("Overload UI Decimation"), ParameterName);
+    decimation->setData(kProjectView_OverloadDecimation, ParameterType);
+    decimation->setData(kDefaultOverloadDecimation, PlaceholderValue);
+    decimation->setData(tr("Plot one out of N frames when overloaded"),
+                        ParameterDescription);
+    m_projectModel->appendRow(decimation);
+  }
+
   // Add Thunderforest API Key
   auto thunderforest = new QStandardItem();
   thunderforest->setEditable(true);
@@ -2189,6 +2864,19 @@ void JSON::ProjectModel::buildGroupModel(const JSON::Group &group)
   widget->setData(tr("Group display widget (optional)"), ParameterDescription);
   m_groupModel->appendRow(widget);
 
+  // Add refresh class, the combobox index matches the enum value
+  const auto refresh = SerialStudio::refreshClassFromId(group.refreshClass());
+  auto refreshClass = new QStandardItem();
+  refreshClass->setEditable(true);
+  refreshClass->setData(ComboBox, WidgetType);
+  refreshClass->setData(m_refreshClasses, ComboBoxData);
+  refreshClass->setData(static_cast<int>(refresh), EditableValue);
+  refreshClass->setData(tr("Refresh Rate"), ParameterName);
+  refreshClass->setData(kGroupView_Refresh, ParameterType);
+  refreshClass->setData(tr("How often the group's widgets are redrawn"),
+                        ParameterDescription);
+  m_groupModel->appendRow(refreshClass);
+
   // Handle edits
   connect(m_groupModel, &CustomModel::itemChanged, this,
           &JSON::ProjectModel::onGroupItemChanged);
@@ -2272,6 +2960,18 @@ void JSON::ProjectModel::buildActionModel(const JSON::Action &action)
   eol->setData(tr("End-of-line (EOL) sequence to use"), ParameterDescription);
   m_actionModel->appendRow(eol);
 
+  // Add repeat interval
+  auto interval = new QStandardItem();
+  interval->setEditable(true);
+  interval->setData(IntField, WidgetType);
+  interval->setData(action.repeatInterval(), EditableValue);
+  interval->setData(tr("Repeat Interval (ms)"), ParameterName);
+  interval->setData(kActionView_Interval, ParameterType);
+  interval->setData(0, PlaceholderValue);
+  interval->setData(tr("Send the data periodically while active (0 = once)"),
+                    ParameterDescription);
+  m_actionModel->appendRow(interval);
+
   // Handle edits
   connect(m_actionModel, &CustomModel::itemChanged, this,
           &JSON::ProjectModel::onActionItemChanged);
@@ -2313,7 +3013,7 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
 
   // Get which optional parameters should be displayed
   const bool showWidget = currentDatasetIsEditable();
-  const bool showFFTOptions = dataset.fft();
+  const bool showFFTOptions = dataset.fft() || dataset.waterfall();
   const bool showLedOptions = dataset.led();
   const bool showMinMax = dataset.graph() || dataset.widget() == "gauge"
                           || dataset.widget() == "bar"
@@ -2345,6 +3045,19 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
   index->setData(tr("Position in the frame"), ParameterDescription);
   m_datasetModel->appendRow(index);
 
+  // Add array sample rate
+  auto sampleRate = new QStandardItem();
+  sampleRate->setEditable(true);
+  sampleRate->setData(FloatField, WidgetType);
+  sampleRate->setData(0, PlaceholderValue);
+  sampleRate->setData(dataset.sampleRate(), EditableValue);
+  sampleRate->setData(tr("Array Sample Rate"), ParameterName);
+  sampleRate->setData(kDatasetView_SampleRate, ParameterType);
+  sampleRate->setData(tr("Rate (Hz) of the samples in each field, 0 for a "
+                         "single value per frame"),
+                      ParameterDescription);
+  m_datasetModel->appendRow(sampleRate);
+
   // Add units
   auto units = new QStandardItem();
   units->setEditable(true);
@@ -2356,6 +3069,94 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
   units->setData(tr("Unit of measurement (optional)"), ParameterDescription);
   m_datasetModel->appendRow(units);
 
+  // Add expression
+  auto expression = new QStandardItem();
+  expression->setEditable(true);
+  expression->setData(TextField, WidgetType);
+  expression->setData(dataset.expression(), EditableValue);
+  expression->setData(tr("Expression"), ParameterName);
+  expression->setData(kDatasetView_Expression, ParameterType);
+  expression->setData(QStringLiteral("($1 - 32) / 1.8"), PlaceholderValue);
+  expression->setData(tr("Compute the value from the frame fields (optional)"),
+                      ParameterDescription);
+  m_datasetModel->appendRow(expression);
+
+  // Get filter type index
+  int filterIndex = 0;
+  bool filterFound = false;
+  for (auto it = m_filterTypes.begin(); it != m_filterTypes.end();
+       ++it, ++filterIndex)
+  {
+    if (it.key() == dataset.filter())
+    {
+      filterFound = true;
+      break;
+    }
+  }
+
+  // If not found, reset the index to 0
+  if (!filterFound)
+    filterIndex = 0;
+
+  // Add filter type
+  auto filter = new QStandardItem();
+  filter->setEditable(true);
+  filter->setData(ComboBox, WidgetType);
+  filter->setData(m_filterTypes.values(), ComboBoxData);
+  filter->setData(filterIndex, EditableValue);
+  filter->setData(tr("Filter"), ParameterName);
+  filter->setData(kDatasetView_Filter, ParameterType);
+  filter->setData(tr("Digital filter applied to the received values"),
+                  ParameterDescription);
+  m_datasetModel->appendRow(filter);
+
+  // Filter-specific options
+  const bool iirFilter = dataset.filter() == QStringLiteral("lowpass")
+                         || dataset.filter() == QStringLiteral("highpass");
+  if (iirFilter)
+  {
+    // Add filter cutoff frequency
+    auto filterCutoff = new QStandardItem();
+    filterCutoff->setEditable(true);
+    filterCutoff->setData(FloatField, WidgetType);
+    filterCutoff->setData(10, PlaceholderValue);
+    filterCutoff->setData(dataset.filterCutoff(), EditableValue);
+    filterCutoff->setData(tr("Filter Cutoff"), ParameterName);
+    filterCutoff->setData(kDatasetView_FilterCutoff, ParameterType);
+    filterCutoff->setData(tr("Cutoff frequency (Hz) of the filter"),
+                          ParameterDescription);
+    m_datasetModel->appendRow(filterCutoff);
+
+    // Add filter sampling rate
+    auto filterRate = new QStandardItem();
+    filterRate->setEditable(true);
+    filterRate->setData(IntField, WidgetType);
+    filterRate->setData(100, PlaceholderValue);
+    filterRate->setData(dataset.filterRate(), EditableValue);
+    filterRate->setData(tr("Filter Sampling Rate"), ParameterName);
+    filterRate->setData(kDatasetView_FilterRate, ParameterType);
+    filterRate->setData(tr("Rate (Hz) at which the frames are received"),
+                        ParameterDescription);
+    m_datasetModel->appendRow(filterRate);
+  }
+
+  // Add filter order or window length
+  if (!dataset.filter().isEmpty())
+  {
+    auto filterOrder = new QStandardItem();
+    filterOrder->setEditable(true);
+    filterOrder->setData(IntField, WidgetType);
+    filterOrder->setData(4, PlaceholderValue);
+    filterOrder->setData(dataset.filterOrder(), EditableValue);
+    filterOrder->setData(iirFilter ? tr("Filter Order") : tr("Filter Window"),
+                         ParameterName);
+    filterOrder->setData(kDatasetView_FilterOrder, ParameterType);
+    filterOrder->setData(iirFilter ? tr("Order of the filter (2 to 8)")
+                                   : tr("Number of samples in the window"),
+                         ParameterDescription);
+    m_datasetModel->appendRow(filterOrder);
+  }
+
   // Add widget combobox item
   if (showWidget)
   {
@@ -2471,6 +3272,18 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
   fft->setData(tr("Plot frequency-domain data"), ParameterDescription);
   m_datasetModel->appendRow(fft);
 
+  // Add waterfall checkbox
+  auto waterfall = new QStandardItem();
+  waterfall->setEditable(true);
+  waterfall->setData(CheckBox, WidgetType);
+  waterfall->setData(dataset.waterfall(), EditableValue);
+  waterfall->setData(tr("Waterfall Plot"), ParameterName);
+  waterfall->setData(kDatasetView_Waterfall, ParameterType);
+  waterfall->setData(0, PlaceholderValue);
+  waterfall->setData(tr("Plot the spectrum history (spectrogram)"),
+                     ParameterDescription);
+  m_datasetModel->appendRow(waterfall);
+
   // FFT-specific options
   if (showFFTOptions)
   {
@@ -2502,6 +3315,47 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
     fftSamplingRate->setData(tr("Sampling rate (Hz) for FFT calculation"),
                              ParameterDescription);
     m_datasetModel->appendRow(fftSamplingRate);
+
+    // Add FFT hop size
+    auto fftHopSize = new QStandardItem();
+    fftHopSize->setEditable(true);
+    fftHopSize->setData(IntField, WidgetType);
+    fftHopSize->setData(1, PlaceholderValue);
+    fftHopSize->setData(dataset.fftHopSize(), EditableValue);
+    fftHopSize->setData(tr("FFT Hop Size"), ParameterName);
+    fftHopSize->setData(kDatasetView_FFT_HopSize, ParameterType);
+    fftHopSize->setData(tr("New samples required to update the FFT"),
+                        ParameterDescription);
+    m_datasetModel->appendRow(fftHopSize);
+
+    // Get FFT window function index
+    int functionIndex = 0;
+    bool functionFound = false;
+    for (auto it = m_fftWindows.begin(); it != m_fftWindows.end();
+         ++it, ++functionIndex)
+    {
+      if (it.key() == dataset.fftWindow())
+      {
+        functionFound = true;
+        break;
+      }
+    }
+
+    // If not found, reset the index to 0
+    if (!functionFound)
+      functionIndex = 0;
+
+    // Add FFT window function
+    auto fftFunction = new QStandardItem();
+    fftFunction->setEditable(true);
+    fftFunction->setData(ComboBox, WidgetType);
+    fftFunction->setData(m_fftWindows.values(), ComboBoxData);
+    fftFunction->setData(functionIndex, EditableValue);
+    fftFunction->setData(tr("FFT Window Function"), ParameterName);
+    fftFunction->setData(kDatasetView_FFT_Window, ParameterType);
+    fftFunction->setData(tr("Window applied to the samples before the FFT"),
+                         ParameterDescription);
+    m_datasetModel->appendRow(fftFunction);
   }
 
   // Add LED panel checkbox
@@ -2529,6 +3383,18 @@ void JSON::ProjectModel::buildDatasetModel(const JSON::Dataset &dataset)
     m_datasetModel->appendRow(ledHigh);
   }
 
+  // Add priority checkbox
+  auto priority = new QStandardItem();
+  priority->setEditable(true);
+  priority->setData(CheckBox, WidgetType);
+  priority->setData(dataset.priority(), EditableValue);
+  priority->setData(tr("Priority Dataset"), ParameterName);
+  priority->setData(kDatasetView_Priority, ParameterType);
+  priority->setData(0, PlaceholderValue);
+  priority->setData(tr("Keep publishing to MQTT when overloaded"),
+                    ParameterDescription);
+  m_datasetModel->appendRow(priority);
+
   // Handle edits
   connect(m_datasetModel, &CustomModel::itemChanged, this,
           &JSON::ProjectModel::onDatasetItemChanged);
@@ -2593,17 +3459,66 @@ void JSON::ProjectModel::generateComboBoxModels()
   m_fftSamples.append("8192");
   m_fftSamples.append("16384");
 
+  // Initialize FFT window functions
+  m_fftWindows.clear();
+  m_fftWindows.insert(QStringLiteral("Hann"), tr("Hann"));
+  m_fftWindows.insert(QStringLiteral("Hamming"), tr("Hamming"));
+  m_fftWindows.insert(QStringLiteral("Rectangular"), tr("Rectangular (None)"));
+
+  // Initialize dataset filter types
+  m_filterTypes.clear();
+  m_filterTypes.insert(QString(), tr("None"));
+  m_filterTypes.insert(QStringLiteral("lowpass"), tr("Low-pass (Butterworth)"));
+  m_filterTypes.insert(QStringLiteral("highpass"),
+                       tr("High-pass (Butterworth)"));
+  m_filterTypes.insert(QStringLiteral("movingAverage"), tr("Moving Average"));
+  m_filterTypes.insert(QStringLiteral("median"), tr("Median"));
+
   // Initialize decoder options
   m_decoderOptions.clear();
   m_decoderOptions.append(tr("Plain Text (UTF8)"));
   m_decoderOptions.append(tr("Hexadecimal"));
   m_decoderOptions.append(tr("Base64"));
+  m_decoderOptions.append(tr("Binary (Raw Bytes)"));
 
   // Initialize frame detection methods
   m_frameDetectionMethods.clear();
   m_frameDetectionMethods.append(tr("End Delimiter Only"));
   m_frameDetectionMethods.append(tr("Start + End Delimiter"));
   m_frameDetectionMethods.append(tr("No Delimiters"));
+  m_frameDetectionMethods.append(tr("Length-Prefixed"));
+  m_frameDetectionMethods.append(tr("COBS Encoded"));
+  m_frameDetectionMethods.append(tr("SLIP Encoded"));
+
+  // Initialize length field sizes
+  m_lengthFieldSizes.clear();
+  m_lengthFieldSizes.append(tr("1 Byte"));
+  m_lengthFieldSizes.append(tr("2 Bytes"));
+  m_lengthFieldSizes.append(tr("4 Bytes"));
+
+  // Initialize checksum algorithms
+  m_checksumAlgorithms.clear();
+  m_checksumAlgorithms.append(tr("Automatic (In-Band Tag)"));
+  m_checksumAlgorithms.append(tr("None"));
+  m_checksumAlgorithms.append(QStringLiteral("CRC-8"));
+  m_checksumAlgorithms.append(QStringLiteral("CRC-16/CCITT"));
+  m_checksumAlgorithms.append(QStringLiteral("CRC-32"));
+  m_checksumAlgorithms.append(QStringLiteral("CRC-16/MODBUS"));
+  m_checksumAlgorithms.append(QStringLiteral("CRC-16/XMODEM"));
+  m_checksumAlgorithms.append(QStringLiteral("Fletcher-16"));
+  m_checksumAlgorithms.append(QStringLiteral("Fletcher-32"));
+
+  // Initialize checksum positions
+  m_checksumPositions.clear();
+  m_checksumPositions.append(tr("Frame Trailer"));
+  m_checksumPositions.append(tr("Frame Header"));
+
+  // Initialize widget refresh classes
+  m_refreshClasses.clear();
+  m_refreshClasses.append(tr("Default"));
+  m_refreshClasses.append(tr("Realtime (Every Update)"));
+  m_refreshClasses.append(tr("Normal"));
+  m_refreshClasses.append(tr("Low (2 Hz)"));
 
   // Initialize group-level widgets
   m_groupWidgets.clear();
@@ -2654,6 +3569,38 @@ void JSON::ProjectModel::setModified(const bool modified)
   Q_EMIT modifiedChanged();
 }
 
+/**
+ * @brief Builds or releases the editor models.
+ *
+ * The combo box, tree and project models are built when the project editor
+ * is opened, and the tree and parameter models are released when it is
+ * closed, so that large projects use no editor memory while only their
+ * dashboard is shown.
+ *
+ * @param active Whether the project editor is open.
+ */
+void JSON::ProjectModel::setEditorActive(const bool active)
+{
+  if (m_editorActive == active)
+    return;
+
+  m_editorActive = active;
+  if (m_editorActive)
+  {
+    generateComboBoxModels();
+    buildTreeModel();
+
+    // Select the project root item, which shows the project view
+    m_selectionModel->setCurrentIndex(m_treeModel->index(0, 0),
+                                      QItemSelectionModel::ClearAndSelect);
+  }
+
+  else
+    releaseEditorModels();
+
+  Q_EMIT editorActiveChanged();
+}
+
 /**
  * @brief Sets the current view of the project.
  *
@@ -2708,7 +3655,7 @@ void JSON::ProjectModel::setCurrentView(const CurrentView currentView)
  *
  * This function processes changes to group items such as the group title or
  * widget type. It validates the modified item, updates the group title or
- * widget accordingly, and rebuilds the tree model to reflect the changes.
+ * widget accordingly, and updates the group item of the tree model.
  *
  * If the group was modified, it sets the modified flag. Finally, it reselects
  * the group in the user interface.
@@ -2744,6 +3691,16 @@ void JSON::ProjectModel::onGroupItemChanged(QStandardItem *item)
     m_groups.replace(groupId, m_selectedGroup);
   }
 
+  // Change group refresh class
+  else if (id == kGroupView_Refresh)
+  {
+    const auto refresh = static_cast<SerialStudio::RefreshClass>(value.toInt());
+    const auto refreshStr = SerialStudio::refreshClassId(refresh);
+    modified = m_selectedGroup.m_refreshClass != refreshStr;
+    m_selectedGroup.m_refreshClass = refreshStr;
+    m_groups.replace(groupId, m_selectedGroup);
+  }
+
   // Change group widget
   else if (id == kGroupView_Widget)
   {
@@ -2771,23 +3728,13 @@ void JSON::ProjectModel::onGroupItemChanged(QStandardItem *item)
     // User canceled the operation, reload model GUI to restore previous value
     else
     {
-      buildTreeModel();
-      for (auto g = m_groupItems.begin(); g != m_groupItems.end(); ++g)
-      {
-        if (g.value().groupId() == m_selectedGroup.groupId())
-        {
-          m_selectionModel->setCurrentIndex(
-              g.key()->index(), QItemSelectionModel::ClearAndSelect);
-          break;
-        }
-      }
-
+      buildGroupModel(m_selectedGroup);
       return;
     }
   }
 
-  // Re-build tree model
-  buildTreeModel();
+  // Update the group item
+  updateGroupItem(groupId);
   if (modified)
     setModified(true);
 
@@ -2799,8 +3746,7 @@ void JSON::ProjectModel::onGroupItemChanged(QStandardItem *item)
  * @brief Handles changes made to a action item in the action model.
  *
  * This function processes changes to action items such as the title, data or
- * icon, it updates the action data and rebuilds the tree model to reflect the
- * changes.
+ * icon, it updates the action data and the action item of the tree model.
  *
  * If the action was modified, it sets the modified flag. Finally, it
  * reselects the action in the user interface.
@@ -2836,6 +3782,9 @@ void JSON::ProjectModel::onActionItemChanged(QStandardItem *item)
     case kActionView_EOL:
       m_selectedAction.m_eolSequence = eolSequences.at(value.toInt());
       break;
+    case kActionView_Interval:
+      m_selectedAction.m_repeatInterval = qMax(0, value.toInt());
+      break;
     case kActionView_Icon:
       m_selectedAction.m_icon = value.toString();
       Q_EMIT actionModelChanged();
@@ -2845,9 +3794,10 @@ void JSON::ProjectModel::onActionItemChanged(QStandardItem *item)
   }
 
   // Replace action data
+  m_selectedAction.encodePayload();
   const auto actionId = m_selectedAction.actionId();
   m_actions.replace(actionId, m_selectedAction);
-  buildTreeModel();
+  updateActionItem(actionId);
 
   // Mark document as modified
   setModified(true);
@@ -2906,6 +3856,61 @@ void JSON::ProjectModel::onProjectItemChanged(QStandardItem *item)
       m_mapTilerApiKey = value.toString();
       Q_EMIT gpsApiKeysChanged();
       break;
+    case kProjectView_StatelessParser:
+      m_statelessParser = value.toBool();
+      break;
+    case kProjectView_SequenceField:
+      m_sequenceField = qMax(0, value.toInt());
+      break;
+    case kProjectView_TimestampField:
+      m_timestampField = qMax(0, value.toInt());
+      buildProjectModel();
+      break;
+    case kProjectView_TimestampBits:
+      m_timestampBits = qBound(8, value.toInt(), 64);
+      break;
+    case kProjectView_OverloadThreshold:
+      m_overloadThreshold = qBound(0, value.toInt(), 100);
+      buildProjectModel();
+      break;
+    case kProjectView_OverloadDecimation:
+      m_overloadDecimation = qBound(1, value.toInt(), kMaxOverloadDecimation);
+      break;
+    case kProjectView_FrameHeader:
+      m_frameHeader = value.toString();
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_LengthFieldSize:
+      m_lengthFieldSize = kLengthFieldSizes[std::clamp(value.toInt(), 0, 2)];
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_LengthBigEndian:
+      m_lengthBigEndian = value.toBool();
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_ChecksumAlgorithm:
+      m_checksumAlgorithm
+          = static_cast<SerialStudio::ChecksumAlgorithm>(value.toInt());
+      Q_EMIT frameDetectionChanged();
+      buildProjectModel();
+      break;
+    case kProjectView_ChecksumPosition:
+      m_checksumPosition
+          = static_cast<SerialStudio::ChecksumPosition>(value.toInt());
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_ChecksumBigEndian:
+      m_checksumBigEndian = value.toBool();
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_ChecksumStart:
+      m_checksumStart = qMax(0, value.toInt());
+      Q_EMIT frameDetectionChanged();
+      break;
+    case kProjectView_ChecksumEnd:
+      m_checksumEnd = qMax(0, value.toInt());
+      Q_EMIT frameDetectionChanged();
+      break;
     default:
       break;
   }
@@ -2920,8 +3925,8 @@ void JSON::ProjectModel::onProjectItemChanged(QStandardItem *item)
  * This function processes changes to dataset items such as the title, index,
  * units, widget type, FFT settings, LED settings, plotting mode, and
  * min/max/alarm values. It updates the relevant parameters of the selected
- * dataset, replaces the dataset in its parent group, and rebuilds the tree
- * model. After updating the dataset, it marks the document as modified.
+ * dataset, replaces the dataset in its parent group, and updates its tree
+ * item. After updating the dataset, it marks the document as modified.
  *
  * @param item A pointer to the modified `QStandardItem` representing the
  *             changed dataset property.
@@ -2934,6 +3939,8 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
 
   // Construct lists with key values for QMap-based comboboxes
   static QStringList widgets;
+  static QStringList fftWindows;
+  static QStringList filterTypes;
   static QList<QPair<bool, bool>> plotOptions;
 
   // Construct widget list
@@ -2941,6 +3948,16 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
     for (auto i = m_datasetWidgets.begin(); i != m_datasetWidgets.end(); ++i)
       widgets.append(i.key());
 
+  // Construct FFT window function list
+  if (fftWindows.isEmpty())
+    for (auto i = m_fftWindows.begin(); i != m_fftWindows.end(); ++i)
+      fftWindows.append(i.key());
+
+  // Construct filter type list
+  if (filterTypes.isEmpty())
+    for (auto i = m_filterTypes.begin(); i != m_filterTypes.end(); ++i)
+      filterTypes.append(i.key());
+
   // Construct plot options list
   if (plotOptions.isEmpty())
     for (auto i = m_plotOptions.begin(); i != m_plotOptions.end(); ++i)
@@ -2962,6 +3979,25 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
     case kDatasetView_Units:
       m_selectedDataset.m_units = value.toString();
       break;
+    case kDatasetView_Expression:
+      m_selectedDataset.m_expression = value.toString().simplified();
+      break;
+    case kDatasetView_Filter:
+      m_selectedDataset.m_filter = filterTypes.at(value.toInt());
+      buildDatasetModel(m_selectedDataset);
+      break;
+    case kDatasetView_FilterCutoff:
+      m_selectedDataset.m_filterCutoff = value.toDouble();
+      break;
+    case kDatasetView_FilterRate:
+      m_selectedDataset.m_filterRate = value.toInt();
+      break;
+    case kDatasetView_SampleRate:
+      m_selectedDataset.m_sampleRate = qMax(0.0, value.toDouble());
+      break;
+    case kDatasetView_FilterOrder:
+      m_selectedDataset.m_filterOrder = qMax(1, value.toInt());
+      break;
     case kDatasetView_Widget:
       m_selectedDataset.m_widget = widgets.at(value.toInt());
       buildDatasetModel(m_selectedDataset);
@@ -2970,6 +4006,10 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
       m_selectedDataset.m_fft = value.toBool();
       buildDatasetModel(m_selectedDataset);
       break;
+    case kDatasetView_Waterfall:
+      m_selectedDataset.m_waterfall = value.toBool();
+      buildDatasetModel(m_selectedDataset);
+      break;
     case kDatasetView_LED:
       m_selectedDataset.m_led = value.toBool();
       buildDatasetModel(m_selectedDataset);
@@ -2977,6 +4017,9 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
     case kDatasetView_LED_High:
       m_selectedDataset.m_ledHigh = value.toFloat();
       break;
+    case kDatasetView_Priority:
+      m_selectedDataset.m_priority = value.toBool();
+      break;
     case kDatasetView_Plot:
       m_selectedDataset.m_graph = plotOptions.at(value.toInt()).first;
       m_selectedDataset.m_log = plotOptions.at(value.toInt()).second;
@@ -2997,6 +4040,12 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
     case kDatasetView_FFT_SamplingRate:
       m_selectedDataset.m_fftSamplingRate = value.toInt();
       break;
+    case kDatasetView_FFT_HopSize:
+      m_selectedDataset.m_fftHopSize = qMax(1, value.toInt());
+      break;
+    case kDatasetView_FFT_Window:
+      m_selectedDataset.m_fftWindow = fftWindows.at(value.toInt());
+      break;
     default:
       break;
   }
@@ -3007,7 +4056,7 @@ void JSON::ProjectModel::onDatasetItemChanged(QStandardItem *item)
   auto group = m_groups.at(groupId);
   group.m_datasets.replace(datasetId, m_selectedDataset);
   m_groups.replace(groupId, group);
-  buildTreeModel();
+  updateDatasetItem(groupId, datasetId);
 
   // Mark document as modified
   setModified(true);
@@ -3113,6 +4162,54 @@ int JSON::ProjectModel::nextDatasetIndex()
   return maxIndex;
 }
 
+//------------------------------------------------------------------------------
+// Release the editor models when the project editor is closed
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Deletes the tree, selection and parameter models of the editor.
+ *
+ * The project structure is kept in the group and action vectors, so the
+ * models are rebuilt from it when the project editor is opened again.
+ */
+void JSON::ProjectModel::releaseEditorModels()
+{
+  // Clear model/pointer maps
+  m_rootItems.clear();
+  m_groupItems.clear();
+  m_actionItems.clear();
+  m_datasetItems.clear();
+
+  // Delete the selection model
+  if (m_selectionModel)
+  {
+    disconnect(m_selectionModel);
+    m_selectionModel->deleteLater();
+    m_selectionModel = nullptr;
+  }
+
+  // Delete the tree & parameter models
+  const QList<CustomModel **> models = {&m_treeModel, &m_groupModel,
+                                        &m_actionModel, &m_projectModel,
+                                        &m_datasetModel};
+  for (auto *model : models)
+  {
+    if (*model)
+    {
+      disconnect(*model);
+      (*model)->deleteLater();
+      *model = nullptr;
+    }
+  }
+
+  // Update user interface
+  Q_EMIT treeModelChanged();
+  Q_EMIT groupModelChanged();
+  Q_EMIT actionModelChanged();
+  Q_EMIT projectModelChanged();
+  Q_EMIT datasetModelChanged();
+}
+
 //------------------------------------------------------------------------------
 // Save & restore expanded items of project structure upon modification
 //------------------------------------------------------------------------------
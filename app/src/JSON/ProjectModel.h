@@ -73,6 +73,10 @@ class ProjectModel : public QObject
   Q_PROPERTY(bool modified
              READ modified
              NOTIFY modifiedChanged)
+  Q_PROPERTY(bool editorActive
+             READ editorActive
+             WRITE setEditorActive
+             NOTIFY editorActiveChanged)
   Q_PROPERTY(QString title
              READ title
              NOTIFY titleChanged)
@@ -133,12 +137,16 @@ class ProjectModel : public QObject
   Q_PROPERTY(QString osmAddress
              READ osmAddress
              CONSTANT)
+  Q_PROPERTY(QString osmCachePath
+             READ osmCachePath
+             CONSTANT)
   // clang-format on
 
 signals:
   void titleChanged();
   void jsonFileChanged();
   void modifiedChanged();
+  void editorActiveChanged();
   void treeModelChanged();
   void groupModelChanged();
   void gpsApiKeysChanged();
@@ -213,14 +221,30 @@ public:
   Q_ENUM(CustomRoles)
 
   [[nodiscard]] bool modified() const;
+  [[nodiscard]] bool editorActive() const;
   [[nodiscard]] CurrentView currentView() const;
   [[nodiscard]] SerialStudio::DecoderMethod decoderMethod() const;
   [[nodiscard]] SerialStudio::FrameDetection frameDetection() const;
+  [[nodiscard]] QByteArray frameHeader() const;
+  [[nodiscard]] int lengthFieldSize() const;
+  [[nodiscard]] bool lengthBigEndian() const;
+  [[nodiscard]] SerialStudio::ChecksumAlgorithm checksumAlgorithm() const;
+  [[nodiscard]] SerialStudio::ChecksumPosition checksumPosition() const;
+  [[nodiscard]] bool checksumBigEndian() const;
+  [[nodiscard]] int checksumStart() const;
+  [[nodiscard]] int checksumEnd() const;
+  [[nodiscard]] bool statelessParser() const;
+  [[nodiscard]] int sequenceField() const;
+  [[nodiscard]] int timestampField() const;
+  [[nodiscard]] int timestampBits() const;
+  [[nodiscard]] int overloadThreshold() const;
+  [[nodiscard]] int overloadDecimation() const;
 
   [[nodiscard]] QString jsonFileName() const;
   [[nodiscard]] QString jsonProjectsPath() const;
 
   [[nodiscard]] QString osmAddress() const;
+  [[nodiscard]] QString osmCachePath() const;
   [[nodiscard]] QString selectedText() const;
   [[nodiscard]] QString selectedIcon() const;
 
@@ -274,6 +298,7 @@ public slots:
   bool setGroupWidget(const int group, const SerialStudio::GroupWidget widget);
 
   void setModified(const bool modified);
+  void setEditorActive(const bool active);
   void setFrameParserCode(const QString &code);
 
   void displayFrameParserView();
@@ -298,6 +323,22 @@ private slots:
 
 private:
   int nextDatasetIndex();
+  void releaseEditorModels();
+
+  QStandardItem *createGroupItem(const JSON::Group &group);
+  QStandardItem *createActionItem(const JSON::Action &action);
+  QStandardItem *createDatasetItem(const JSON::Dataset &dataset);
+  [[nodiscard]] QStandardItem *groupItem(const int groupId) const;
+  [[nodiscard]] QStandardItem *actionItem(const int actionId) const;
+  [[nodiscard]] QStandardItem *datasetItem(const int groupId,
+                                           const int datasetId) const;
+  void insertGroupItem(const int groupId);
+  void insertActionItem(const int actionId);
+  void removeTreeItem(QStandardItem *item);
+  void updateGroupItem(const int groupId);
+  void updateActionItem(const int actionId);
+  void updateDatasetItem(const int groupId, const int datasetId);
+  void selectTreeItem(QStandardItem *item);
   void saveExpandedStateMap(QStandardItem *item, QHash<QString, bool> &map,
                             const QString &title);
   void restoreExpandedStateMap(QStandardItem *item, QHash<QString, bool> &map,
@@ -312,13 +353,33 @@ private:
   QString m_mapTilerApiKey;
   QString m_thunderforestApiKey;
 
+  QJsonObject m_nativeParser;
+  QJsonObject m_parserPlugin;
+
   CurrentView m_currentView;
   SerialStudio::DecoderMethod m_frameDecoder;
   SerialStudio::FrameDetection m_frameDetection;
 
   bool m_modified;
+  bool m_editorActive;
+  bool m_statelessParser;
+  int m_sequenceField;
+  int m_timestampField;
+  int m_timestampBits;
+  int m_overloadThreshold;
+  int m_overloadDecimation;
   QString m_filePath;
 
+  QString m_frameHeader;
+  int m_lengthFieldSize;
+  bool m_lengthBigEndian;
+
+  SerialStudio::ChecksumAlgorithm m_checksumAlgorithm;
+  SerialStudio::ChecksumPosition m_checksumPosition;
+  bool m_checksumBigEndian;
+  int m_checksumStart;
+  int m_checksumEnd;
+
   QMap<QStandardItem *, int> m_rootItems;
   QMap<QStandardItem *, JSON::Group> m_groupItems;
   QMap<QStandardItem *, JSON::Action> m_actionItems;
@@ -336,8 +397,14 @@ private:
   CustomModel *m_datasetModel;
 
   QStringList m_fftSamples;
+  QMap<QString, QString> m_fftWindows;
+  QMap<QString, QString> m_filterTypes;
   QStringList m_decoderOptions;
   QStringList m_frameDetectionMethods;
+  QStringList m_lengthFieldSizes;
+  QStringList m_checksumAlgorithms;
+  QStringList m_checksumPositions;
+  QStringList m_refreshClasses;
   QMap<QString, QString> m_eolSequences;
   QMap<QString, QString> m_groupWidgets;
   QMap<QString, QString> m_datasetWidgets;
@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "JSON/ValueReader.h"
+
+/**
+ * Maximum nesting depth of skipped JSON values, avoids stack overflows with
+ * malformed or malicious frames.
+ */
+static constexpr int kMaxDepth = 64;
+
+/**
+ * Constructor function, prepares the reader to scan the given @a json text.
+ */
+JSON::ValueReader::ValueReader(const QByteArray &json,
+                               const Callback &callback)
+  : m_depth(0)
+  , m_pos(json.constData())
+  , m_end(json.constData() + json.size())
+  , m_callback(callback)
+{
+}
+
+/**
+ * Scans the given @a json frame and calls @a callback with the group index,
+ * dataset index and value of every dataset in the frame.
+ *
+ * @return @c false if the frame is not valid JSON, or if the callback function
+ *         returned @c false to abort the operation.
+ */
+bool JSON::ValueReader::read(const QByteArray &json, const Callback &callback)
+{
+  ValueReader reader(json, callback);
+  return reader.readFrame();
+}
+
+/**
+ * Reads the root object of the frame, only the @c "groups" array is
+ * processed, all other members are skipped.
+ */
+bool JSON::ValueReader::readFrame()
+{
+  if (!consume('{'))
+    return false;
+
+  if (!consume('}'))
+  {
+    do
+    {
+      QByteArrayView key;
+      if (!readKey(&key))
+        return false;
+
+      if (key == "groups")
+      {
+        if (!readGroups())
+          return false;
+      }
+
+      else if (!skipValue())
+        return false;
+    } while (consume(','));
+
+    if (!consume('}'))
+      return false;
+  }
+
+  // Only whitespace may follow the root object
+  skipWhitespace();
+  return m_pos == m_end;
+}
+
+/**
+ * Reads the groups array of the frame.
+ */
+bool JSON::ValueReader::readGroups()
+{
+  if (!consume('['))
+    return false;
+
+  if (consume(']'))
+    return true;
+
+  int group = 0;
+  do
+  {
+    if (peek('{'))
+    {
+      bool valid = false;
+      if (!readGroup(group, &valid))
+        return false;
+
+      if (valid)
+        ++group;
+    }
+
+    else if (!skipValue())
+      return false;
+  } while (consume(','));
+
+  return consume(']');
+}
+
+/**
+ * Reads a group object and reports the values of its datasets. The values are
+ * buffered until the end of the object, since the group is only valid if it
+ * has a title, which may appear after the datasets array.
+ */
+bool JSON::ValueReader::readGroup(const int group, bool *valid)
+{
+  *valid = false;
+  m_values.clear();
+
+  if (!consume('{'))
+    return false;
+
+  if (consume('}'))
+    return true;
+
+  bool hasTitle = false;
+  do
+  {
+    QByteArrayView key;
+    if (!readKey(&key))
+      return false;
+
+    if (key == "datasets" && peek('['))
+    {
+      if (!readDatasets())
+        return false;
+    }
+
+    else if (key == "title" && peek('"'))
+    {
+      QString title;
+      if (!readString(&title))
+        return false;
+
+      hasTitle = !title.trimmed().isEmpty();
+    }
+
+    else if (!skipValue())
+      return false;
+  } while (consume(','));
+
+  if (!consume('}'))
+    return false;
+
+  // Report dataset values of valid groups
+  if (hasTitle && !m_values.isEmpty())
+  {
+    *valid = true;
+    for (int i = 0; i < m_values.count(); ++i)
+    {
+      if (!m_callback(group, i, m_values.at(i)))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Reads the datasets array of a group.
+ */
+bool JSON::ValueReader::readDatasets()
+{
+  m_values.clear();
+
+  if (!consume('['))
+    return false;
+
+  if (consume(']'))
+    return true;
+
+  do
+  {
+    if (peek('{'))
+    {
+      if (!readDataset())
+        return false;
+    }
+
+    else if (!skipValue())
+      return false;
+  } while (consume(','));
+
+  return consume(']');
+}
+
+/**
+ * Reads a dataset object and buffers its value, empty objects are ignored.
+ */
+bool JSON::ValueReader::readDataset()
+{
+  if (!consume('{'))
+    return false;
+
+  if (consume('}'))
+    return true;
+
+  QString value;
+  do
+  {
+    QByteArrayView key;
+    if (!readKey(&key))
+      return false;
+
+    if (key == "value" && peek('"'))
+    {
+      if (!readString(&value))
+        return false;
+    }
+
+    else if (!skipValue())
+      return false;
+  } while (consume(','));
+
+  if (!consume('}'))
+    return false;
+
+  m_values.append(value);
+  return true;
+}
+
+/**
+ * Skips the next JSON value, including nested objects and arrays.
+ */
+bool JSON::ValueReader::skipValue()
+{
+  skipWhitespace();
+  if (m_pos >= m_end)
+    return false;
+
+  // Strings
+  if (*m_pos == '"')
+  {
+    const char *begin;
+    const char *end;
+    bool escaped;
+    return rawString(&begin, &end, &escaped);
+  }
+
+  // Objects & arrays
+  if (*m_pos == '{' || *m_pos == '[')
+  {
+    if (++m_depth > kMaxDepth)
+      return false;
+
+    const bool object = *m_pos == '{';
+    const char close = object ? '}' : ']';
+
+    ++m_pos;
+    if (!consume(close))
+    {
+      do
+      {
+        QByteArrayView key;
+        if (object && !readKey(&key))
+          return false;
+
+        if (!skipValue())
+          return false;
+      } while (consume(','));
+
+      if (!consume(close))
+        return false;
+    }
+
+    --m_depth;
+    return true;
+  }
+
+  // Numbers, booleans & null
+  const char *begin = m_pos;
+  while (m_pos < m_end)
+  {
+    const char c = *m_pos;
+    if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n'
+        || c == '\r')
+      break;
+
+    ++m_pos;
+  }
+
+  return m_pos != begin;
+}
+
+/**
+ * Reads an object member name and the colon that follows it. Member names are
+ * compared as raw text, escape sequences are not decoded.
+ */
+bool JSON::ValueReader::readKey(QByteArrayView *key)
+{
+  const char *begin;
+  const char *end;
+  bool escaped;
+  if (!rawString(&begin, &end, &escaped))
+    return false;
+
+  *key = QByteArrayView(begin, end - begin);
+  return consume(':');
+}
+
+/**
+ * Reads a JSON string and decodes its escape sequences.
+ */
+bool JSON::ValueReader::readString(QString *string)
+{
+  const char *begin;
+  const char *end;
+  bool escaped;
+  if (!rawString(&begin, &end, &escaped))
+    return false;
+
+  // Fast path, string has no escape sequences
+  if (!escaped)
+  {
+    *string = QString::fromUtf8(begin, end - begin);
+    return true;
+  }
+
+  // Decode escape sequences, plain text runs are converted as UTF-8
+  string->clear();
+  const char *run = begin;
+  for (const char *p = begin; p < end; ++p)
+  {
+    if (*p != '\\')
+      continue;
+
+    string->append(QString::fromUtf8(run, p - run));
+
+    ++p;
+    switch (*p)
+    {
+      case 'b':
+        string->append(QLatin1Char('\b'));
+        break;
+      case 'f':
+        string->append(QLatin1Char('\f'));
+        break;
+      case 'n':
+        string->append(QLatin1Char('\n'));
+        break;
+      case 'r':
+        string->append(QLatin1Char('\r'));
+        break;
+      case 't':
+        string->append(QLatin1Char('\t'));
+        break;
+      case 'u':
+      {
+        if (end - p < 5)
+          return false;
+
+        char16_t code = 0;
+        for (int i = 1; i <= 4; ++i)
+        {
+          const char c = p[i];
+          code <<= 4;
+          if (c >= '0' && c <= '9')
+            code |= c - '0';
+          else if (c >= 'a' && c <= 'f')
+            code |= c - 'a' + 10;
+          else if (c >= 'A' && c <= 'F')
+            code |= c - 'A' + 10;
+          else
+            return false;
+        }
+
+        string->append(QChar(code));
+        p += 4;
+        break;
+      }
+      default:
+        string->append(QChar::fromLatin1(*p));
+        break;
+    }
+
+    run = p + 1;
+  }
+
+  string->append(QString::fromUtf8(run, end - run));
+  return true;
+}
+
+/**
+ * Scans the JSON string at the current position without decoding it.
+ *
+ * @param begin   set to the first character of the string contents
+ * @param end     set to the closing quote of the string
+ * @param escaped set to @c true if the string contains escape sequences
+ */
+bool JSON::ValueReader::rawString(const char **begin, const char **end,
+                                  bool *escaped)
+{
+  *escaped = false;
+  if (!consume('"'))
+    return false;
+
+  *begin = m_pos;
+  while (m_pos < m_end)
+  {
+    if (*m_pos == '\\')
+    {
+      if (m_end - m_pos < 2)
+        return false;
+
+      *escaped = true;
+      m_pos += 2;
+      continue;
+    }
+
+    if (*m_pos == '"')
+    {
+      *end = m_pos;
+      ++m_pos;
+      return true;
+    }
+
+    ++m_pos;
+  }
+
+  return false;
+}
+
+/**
+ * Advances the current position past any JSON whitespace.
+ */
+void JSON::ValueReader::skipWhitespace()
+{
+  while (m_pos < m_end)
+  {
+    const char c = *m_pos;
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+      break;
+
+    ++m_pos;
+  }
+}
+
+/**
+ * @return @c true if the next non-whitespace character is @a c.
+ */
+bool JSON::ValueReader::peek(const char c)
+{
+  skipWhitespace();
+  return m_pos < m_end && *m_pos == c;
+}
+
+/**
+ * Consumes the next non-whitespace character if it is @a c.
+ */
+bool JSON::ValueReader::consume(const char c)
+{
+  if (!peek(c))
+    return false;
+
+  ++m_pos;
+  return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <QString>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QStringList>
+
+namespace JSON
+{
+/**
+ * @class JSON::ValueReader
+ * @brief Streaming reader that extracts dataset values from a JSON frame.
+ *
+ * When the device sends JSON frames with a fixed layout, building a
+ * @c QJsonDocument and a complete @c JSON::Frame for every frame is wasteful,
+ * since only the @c "value" fields change between frames. This class scans the
+ * raw frame text once and reports the value of every dataset, identified by
+ * its group & dataset position, without creating an intermediate JSON tree.
+ *
+ * Empty objects, non-object array items and groups without a title or without
+ * datasets are skipped in the same way as @c JSON::Frame::read() and
+ * @c JSON::Group::read() skip them, so that the reported positions match the
+ * layout of a frame built from the same data.
+ * Non-string values are reported as empty strings, like
+ * @c JSON::Dataset::read() does.
+ */
+class ValueReader
+{
+public:
+  typedef std::function<bool(const int group, const int dataset,
+                             const QString &value)>
+      Callback;
+
+  [[nodiscard]] static bool read(const QByteArray &json,
+                                 const Callback &callback);
+
+private:
+  ValueReader(const QByteArray &json, const Callback &callback);
+
+  [[nodiscard]] bool readFrame();
+  [[nodiscard]] bool readGroups();
+  [[nodiscard]] bool readGroup(const int group, bool *valid);
+  [[nodiscard]] bool readDatasets();
+  [[nodiscard]] bool readDataset();
+
+  [[nodiscard]] bool skipValue();
+  [[nodiscard]] bool readKey(QByteArrayView *key);
+  [[nodiscard]] bool readString(QString *string);
+  [[nodiscard]] bool rawString(const char **begin, const char **end,
+                               bool *escaped);
+
+  void skipWhitespace();
+  [[nodiscard]] bool peek(const char c);
+  [[nodiscard]] bool consume(const char c);
+
+private:
+  int m_depth;
+  const char *m_pos;
+  const char *m_end;
+  const Callback &m_callback;
+
+  QStringList m_values;
+};
+} // namespace JSON
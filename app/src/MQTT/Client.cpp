@@ -20,12 +20,42 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+
 #include <QFile>
+#include <QtEndian>
+#include <QRegularExpression>
 #include <QFileDialog>
 
 #include "IO/Manager.h"
 #include "MQTT/Client.h"
 #include "Misc/Utilities.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+#include "Misc/Trace.h"
+#include "JSON/FrameBuilder.h"
+
+//----------------------------------------------------------------------------
+// Batch envelope format
+//----------------------------------------------------------------------------
+
+// Batched messages start with the magic, a version byte & a flags byte. The
+// body is a sequence of [quint32 LE length][frame] records, which is passed
+// through qCompress() when the compression flag is set. Payloads without the
+// magic are treated as plain frames, so that older publishers keep working.
+static constexpr char kEnvelopeMagic[] = "SSMQ";
+static constexpr int kEnvelopeHeaderSize = 6;
+static constexpr quint8 kEnvelopeVersion = 1;
+static constexpr quint8 kEnvelopeCompressed = 0x01;
+
+// Maximum number of QoS 1/2 messages waiting for an acknowledgement, further
+// messages wait in the outbound queue until the broker catches up.
+static constexpr int kMaxInFlight = 64;
+
+// Client options reported until the QMQTT client is created on first use
+static constexpr quint16 kDefaultKeepAlive = 60;
+static constexpr char kDefaultClientId[] = "SerialStudio";
 
 //----------------------------------------------------------------------------
 // Suppress deprecated warnings
@@ -54,16 +84,38 @@ MQTT::Client::Client()
   , m_sentMessages(0)
   , m_clientMode(MQTTClientMode::ClientPublisher)
   , m_client(nullptr)
+  , m_publishMode(PublishFrames)
+  , m_batchMaxBytes(64 * 1024)
+  , m_batchMaxLatency(100)
+  , m_batchMaxMessages(100)
+  , m_compressionEnabled(false)
+  , m_changesOnly(false)
+  , m_publishAllDatasets(true)
+  , m_batchCount(0)
+  , m_queueDepth(1000)
+  , m_droppedMessages(0)
+  , m_dropPolicy(DropOldest)
+  , m_activeSource(-1)
 {
-  // Configure new client
-  regenerateClient();
+  // Publish pending batches when the latency limit is reached
+  m_batchTimer.setSingleShot(true);
+  m_batchTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_batchTimer, &QTimer::timeout, this, &MQTT::Client::flushBatch);
 
   // Send data periodically & reset statistics when disconnected/connected to a
-  connect(&IO::Manager::instance(), &IO::Manager::frameReceived, this,
-          &MQTT::Client::sendFrame);
+  connect(&IO::Manager::instance(), &IO::Manager::framesReceived, this,
+          &MQTT::Client::sendFrames);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
+          this, &MQTT::Client::sendDatasets);
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          &MQTT::Client::flushBatch);
   connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
           &MQTT::Client::resetStatistics);
 
+  // Update the outbound queue statistics periodically
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &MQTT::Client::outboundStatisticsChanged);
+
   // Disconenct from current IO connection when MQTT client is subscribed
   connect(this, &MQTT::Client::connectedChanged, this, [=] {
     if (isSubscribed())
@@ -91,6 +143,125 @@ MQTT::Client &MQTT::Client::instance()
   return singleton;
 }
 
+/**
+ * Returns the way in which received frames are mapped to MQTT messages, see
+ * the @c MQTTPublishMode enum for more information.
+ */
+int MQTT::Client::publishMode() const
+{
+  return m_publishMode;
+}
+
+/**
+ * Returns the maximum payload size of a batched message, in bytes
+ */
+int MQTT::Client::batchMaxBytes() const
+{
+  return m_batchMaxBytes;
+}
+
+/**
+ * Returns the maximum time (in milliseconds) that a frame or a dataset value
+ * waits before it is published.
+ */
+int MQTT::Client::batchMaxLatency() const
+{
+  return m_batchMaxLatency;
+}
+
+/**
+ * Returns the maximum number of frames packed in a batched message
+ */
+int MQTT::Client::batchMaxMessages() const
+{
+  return m_batchMaxMessages;
+}
+
+/**
+ * Returns @c true if the batched payloads are compressed with zlib
+ */
+bool MQTT::Client::compressionEnabled() const
+{
+  return m_compressionEnabled;
+}
+
+/**
+ * Returns @c true if only the datasets whose values changed are published in
+ * the per-dataset publish mode
+ */
+bool MQTT::Client::changesOnly() const
+{
+  return m_changesOnly;
+}
+
+/**
+ * Returns the maximum number of messages that can wait in the outbound queue
+ */
+int MQTT::Client::queueDepth() const
+{
+  return m_queueDepth;
+}
+
+/**
+ * Returns the policy used to discard messages when the outbound queue is full
+ */
+int MQTT::Client::dropPolicy() const
+{
+  return m_dropPolicy;
+}
+
+/**
+ * Returns the number of messages waiting in the outbound queue
+ */
+int MQTT::Client::queuedMessages() const
+{
+  return m_outboundQueue.count();
+}
+
+/**
+ * Returns the number of QoS 1/2 messages that have not been acknowledged by
+ * the broker yet.
+ */
+int MQTT::Client::inFlightMessages() const
+{
+  return m_inFlight.count();
+}
+
+/**
+ * Returns the number of messages discarded because the outbound queue was full
+ */
+quint64 MQTT::Client::droppedMessages() const
+{
+  return m_droppedMessages;
+}
+
+/**
+ * Returns the index of the received topic that feeds the dashboard, or -1 if
+ * the frames of all topics are processed.
+ */
+int MQTT::Client::activeSource() const
+{
+  return m_activeSource;
+}
+
+/**
+ * Returns the topics received by the subscriber, in order of appearance. Each
+ * topic is handled as a separate frame stream.
+ */
+QStringList MQTT::Client::sources() const
+{
+  return m_sources;
+}
+
+/**
+ * Returns the topic filters entered by the user, multiple filters may be
+ * separated with commas or spaces.
+ */
+QStringList MQTT::Client::topicFilters() const
+{
+  return m_topicList;
+}
+
 /**
  * Returns the quality-of-service option, available values:
  * - 0: at most once
@@ -99,8 +270,7 @@ MQTT::Client &MQTT::Client::instance()
  */
 quint8 MQTT::Client::qos() const
 {
-  Q_ASSERT(m_client);
-  return m_client->willQos();
+  return m_client ? m_client->willQos() : 0;
 }
 
 /**
@@ -108,8 +278,7 @@ quint8 MQTT::Client::qos() const
  */
 bool MQTT::Client::retain() const
 {
-  Q_ASSERT(m_client);
-  return m_client->willRetain();
+  return m_client ? m_client->willRetain() : false;
 }
 
 /**
@@ -117,8 +286,7 @@ bool MQTT::Client::retain() const
  */
 quint16 MQTT::Client::port() const
 {
-  Q_ASSERT(m_client);
-  return m_client->port();
+  return m_client ? m_client->port() : defaultPort();
 }
 
 /**
@@ -144,7 +312,8 @@ int MQTT::Client::sslProtocol() const
  */
 int MQTT::Client::mqttVersion() const
 {
-  Q_ASSERT(m_client);
+  if (!m_client)
+    return 1;
 
   switch (m_client->version())
   {
@@ -183,8 +352,7 @@ int MQTT::Client::clientMode() const
  */
 QString MQTT::Client::username() const
 {
-  Q_ASSERT(m_client);
-  return m_client->username();
+  return m_client ? m_client->username() : QString();
 }
 
 /**
@@ -192,8 +360,7 @@ QString MQTT::Client::username() const
  */
 QString MQTT::Client::password() const
 {
-  Q_ASSERT(m_client);
-  return QString::fromUtf8(m_client->password());
+  return m_client ? QString::fromUtf8(m_client->password()) : QString();
 }
 
 /**
@@ -201,7 +368,9 @@ QString MQTT::Client::password() const
  */
 QString MQTT::Client::clientId() const
 {
-  Q_ASSERT(m_client);
+  if (!m_client)
+    return QString::fromLatin1(kDefaultClientId);
+
   return m_client->clientId();
 }
 
@@ -210,8 +379,7 @@ QString MQTT::Client::clientId() const
  */
 QString MQTT::Client::host() const
 {
-  Q_ASSERT(m_client);
-  return m_client->hostName();
+  return m_client ? m_client->hostName() : defaultHost();
 }
 
 /**
@@ -219,8 +387,7 @@ QString MQTT::Client::host() const
  */
 quint16 MQTT::Client::keepAlive() const
 {
-  Q_ASSERT(m_client);
-  return m_client->keepAlive();
+  return m_client ? m_client->keepAlive() : kDefaultKeepAlive;
 }
 
 /**
@@ -247,8 +414,7 @@ bool MQTT::Client::isSubscribed() const
  */
 bool MQTT::Client::isConnectedToHost() const
 {
-  Q_ASSERT(m_client);
-  return m_client->isConnectedToHost();
+  return m_client && m_client->isConnectedToHost();
 }
 
 /**
@@ -276,6 +442,23 @@ QStringList MQTT::Client::mqttVersions() const
   return QStringList{"MQTT 3.1.0", "MQTT 3.1.1"};
 }
 
+/**
+ * Returns a list with the available publisher modes.
+ */
+QStringList MQTT::Client::publishModes() const
+{
+  return QStringList{tr("Frame Per Message"), tr("Batched Frames"),
+                     tr("Dataset Topics")};
+}
+
+/**
+ * Returns a list with the available outbound queue drop policies.
+ */
+QStringList MQTT::Client::dropPolicies() const
+{
+  return QStringList{tr("Drop Oldest Messages"), tr("Drop Newest Messages")};
+}
+
 /**
  * Returns a list with the supported SSL/TLS protocols
  */
@@ -320,8 +503,7 @@ void MQTT::Client::loadCaFile()
  */
 void MQTT::Client::connectToHost()
 {
-  Q_ASSERT(m_client);
-  m_client->connectToHost();
+  client()->connectToHost();
 }
 
 /**
@@ -341,8 +523,8 @@ void MQTT::Client::toggleConnection()
  */
 void MQTT::Client::disconnectFromHost()
 {
-  Q_ASSERT(m_client);
-  m_client->disconnectFromHost();
+  if (m_client)
+    m_client->disconnectFromHost();
 }
 
 /**
@@ -350,8 +532,7 @@ void MQTT::Client::disconnectFromHost()
  */
 void MQTT::Client::setQos(const quint8 qos)
 {
-  Q_ASSERT(m_client);
-  m_client->setWillQos(qos);
+  client()->setWillQos(qos);
   Q_EMIT qosChanged();
 }
 
@@ -370,8 +551,7 @@ void MQTT::Client::lookup(const QString &host)
  */
 void MQTT::Client::setPort(const quint16 port)
 {
-  Q_ASSERT(m_client);
-  m_client->setPort(port);
+  client()->setPort(port);
   Q_EMIT portChanged();
 }
 
@@ -380,8 +560,7 @@ void MQTT::Client::setPort(const quint16 port)
  */
 void MQTT::Client::setHost(const QString &host)
 {
-  Q_ASSERT(m_client);
-  m_client->setHostName(host);
+  client()->setHostName(host);
   Q_EMIT hostChanged();
 }
 
@@ -392,8 +571,7 @@ void MQTT::Client::setHost(const QString &host)
  */
 void MQTT::Client::setRetain(const bool retain)
 {
-  Q_ASSERT(m_client);
-  m_client->setWillRetain(retain);
+  client()->setWillRetain(retain);
   Q_EMIT retainChanged();
 }
 
@@ -413,7 +591,16 @@ void MQTT::Client::setClientMode(const int mode)
  */
 void MQTT::Client::setTopic(const QString &topic)
 {
+  static const QRegularExpression separator(QStringLiteral("[,\\s]+"));
+
   m_topic = topic;
+  m_topicList = topic.split(separator, Qt::SkipEmptyParts);
+
+  m_topicFilters.clear();
+  for (const auto &filter : std::as_const(m_topicList))
+    m_topicFilters.append(TopicFilter(filter));
+
+  clearSources();
   Q_EMIT topicChanged();
 }
 
@@ -451,7 +638,8 @@ void MQTT::Client::loadCaFile(const QString &path)
 
   // Load certificate into SSL configuration
   m_sslConfiguration.setCaCertificates(QSslCertificate::fromData(data));
-  regenerateClient();
+  if (m_client)
+    regenerateClient();
 }
 
 /**
@@ -515,7 +703,9 @@ void MQTT::Client::setSslProtocol(const int index)
   }
 #endif
 
-  regenerateClient();
+  if (m_client)
+    regenerateClient();
+
   Q_EMIT sslProtocolChanged();
 }
 
@@ -525,7 +715,9 @@ void MQTT::Client::setSslProtocol(const int index)
 void MQTT::Client::setSslEnabled(const bool enabled)
 {
   m_sslEnabled = enabled;
-  regenerateClient();
+  if (m_client)
+    regenerateClient();
+
   Q_EMIT sslEnabledChanged();
 }
 
@@ -534,8 +726,7 @@ void MQTT::Client::setSslEnabled(const bool enabled)
  */
 void MQTT::Client::setUsername(const QString &username)
 {
-  Q_ASSERT(m_client);
-  m_client->setUsername(username);
+  client()->setUsername(username);
   Q_EMIT usernameChanged();
 }
 
@@ -544,8 +735,7 @@ void MQTT::Client::setUsername(const QString &username)
  */
 void MQTT::Client::setPassword(const QString &password)
 {
-  Q_ASSERT(m_client);
-  m_client->setPassword(password.toUtf8());
+  client()->setPassword(password.toUtf8());
   Q_EMIT passwordChanged();
 }
 
@@ -554,8 +744,7 @@ void MQTT::Client::setPassword(const QString &password)
  */
 void MQTT::Client::setClientId(const QString &clientId)
 {
-  Q_ASSERT(m_client);
-  m_client->setClientId(clientId);
+  client()->setClientId(clientId);
   Q_EMIT clientIdChanged();
 }
 
@@ -566,8 +755,7 @@ void MQTT::Client::setClientId(const QString &clientId)
  */
 void MQTT::Client::setKeepAlive(const quint16 keepAlive)
 {
-  Q_ASSERT(m_client);
-  m_client->setKeepAlive(keepAlive);
+  client()->setKeepAlive(keepAlive);
   Q_EMIT keepAliveChanged();
 }
 
@@ -576,15 +764,13 @@ void MQTT::Client::setKeepAlive(const quint16 keepAlive)
  */
 void MQTT::Client::setMqttVersion(const int versionIndex)
 {
-  Q_ASSERT(m_client);
-
   switch (versionIndex)
   {
     case 0:
-      m_client->setVersion(QMQTT::V3_1_0);
+      client()->setVersion(QMQTT::V3_1_0);
       break;
     case 1:
-      m_client->setVersion(QMQTT::V3_1_1);
+      client()->setVersion(QMQTT::V3_1_1);
       break;
     default:
       break;
@@ -593,12 +779,168 @@ void MQTT::Client::setMqttVersion(const int versionIndex)
   Q_EMIT mqttVersionChanged();
 }
 
+/**
+ * Changes the publisher mode, pending messages are published first so that
+ * no data is lost when switching between modes.
+ */
+void MQTT::Client::setPublishMode(const int mode)
+{
+  flushBatch();
+  m_publishMode = static_cast<MQTTPublishMode>(qBound(0, mode, 2));
+  Q_EMIT publishModeChanged();
+}
+
+/**
+ * Changes the maximum payload size of a batched message
+ */
+void MQTT::Client::setBatchMaxBytes(const int bytes)
+{
+  m_batchMaxBytes = qBound(1024, bytes, 64 * 1024 * 1024);
+  Q_EMIT batchSettingsChanged();
+}
+
+/**
+ * Changes the maximum time that a frame waits before it is published
+ */
+void MQTT::Client::setBatchMaxLatency(const int msecs)
+{
+  m_batchMaxLatency = qBound(1, msecs, 10000);
+  Q_EMIT batchSettingsChanged();
+}
+
+/**
+ * Changes the maximum number of frames packed in a batched message
+ */
+void MQTT::Client::setBatchMaxMessages(const int messages)
+{
+  m_batchMaxMessages = qBound(1, messages, 10000);
+  Q_EMIT batchSettingsChanged();
+}
+
+/**
+ * Enables or disables the zlib compression of the batched payloads
+ */
+void MQTT::Client::setCompressionEnabled(const bool enabled)
+{
+  flushBatch();
+  m_compressionEnabled = enabled;
+  Q_EMIT compressionEnabledChanged();
+}
+
+/**
+ * Enables or disables publishing only the datasets whose values changed since
+ * the previous frame, the next frame always publishes every dataset.
+ */
+void MQTT::Client::setChangesOnly(const bool enabled)
+{
+  m_changesOnly = enabled;
+  m_publishAllDatasets = true;
+  Q_EMIT changesOnlyChanged();
+}
+
+/**
+ * Changes the maximum number of messages that can wait in the outbound queue,
+ * the oldest messages are discarded if the queue is larger than @a depth.
+ */
+void MQTT::Client::setQueueDepth(const int depth)
+{
+  m_queueDepth = qBound(1, depth, 100000);
+  while (m_outboundQueue.count() > m_queueDepth)
+  {
+    m_outboundQueue.dequeue();
+    ++m_droppedMessages;
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::MqttPublish);
+  }
+
+  Q_EMIT queueDepthChanged();
+  Q_EMIT outboundStatisticsChanged();
+}
+
+/**
+ * Changes the policy used to discard messages when the outbound queue is full
+ */
+void MQTT::Client::setDropPolicy(const int policy)
+{
+  m_dropPolicy = static_cast<MQTTDropPolicy>(qBound(0, policy, 1));
+  Q_EMIT dropPolicyChanged();
+}
+
+/**
+ * Selects the received topic that feeds the dashboard, -1 processes the
+ * frames of all topics.
+ */
+void MQTT::Client::setActiveSource(const int source)
+{
+  m_activeSource = qBound(-1, source, m_sources.count() - 1);
+  Q_EMIT activeSourceChanged();
+}
+
+/**
+ * Sends queued messages to the broker until the in-flight window is full
+ */
+void MQTT::Client::drainQueue()
+{
+  while (!m_outboundQueue.isEmpty() && m_inFlight.count() < kMaxInFlight)
+  {
+    const auto message = m_outboundQueue.dequeue();
+    sendMessage(message.topic, message.payload);
+  }
+}
+
+/**
+ * Publishes the pending batch & the latest value of every dataset that
+ * changed since the last call to this function.
+ */
+void MQTT::Client::flushBatch()
+{
+  m_batchTimer.stop();
+
+  // Publish the latest value of each dataset
+  for (auto it = m_datasetValues.cbegin(); it != m_datasetValues.cend(); ++it)
+    publish(it.key(), it.value());
+
+  m_datasetValues.clear();
+
+  // Nothing else to publish
+  if (m_batch.isEmpty())
+    return;
+
+  // Compress the body, unless that does not reduce its size
+  quint8 flags = 0;
+  QByteArray body = m_batch;
+  if (m_compressionEnabled)
+  {
+    auto compressed = qCompress(m_batch);
+    if (compressed.size() < m_batch.size())
+    {
+      body = compressed;
+      flags |= kEnvelopeCompressed;
+    }
+  }
+
+  // Build the envelope & publish it
+  QByteArray payload;
+  payload.reserve(kEnvelopeHeaderSize + body.size());
+  payload.append(kEnvelopeMagic, 4);
+  payload.append(static_cast<char>(kEnvelopeVersion));
+  payload.append(static_cast<char>(flags));
+  payload.append(body);
+  publish(publishTopic(), payload);
+
+  // Reset the batch
+  m_batch.clear();
+  m_batchCount = 0;
+}
+
 /**
  * Clears the JSON frames & sets the sent messages to 0
  */
 void MQTT::Client::resetStatistics()
 {
   m_sentMessages = 0;
+  m_droppedMessages = 0;
+  Q_EMIT outboundStatisticsChanged();
 }
 
 /**
@@ -607,12 +949,45 @@ void MQTT::Client::resetStatistics()
  */
 void MQTT::Client::onConnectedChanged()
 {
-  Q_ASSERT(m_client);
+  if (!m_client)
+    return;
 
-  if (isConnectedToHost())
-    m_client->subscribe(topic());
-  else
-    m_client->unsubscribe(topic());
+  const auto filters = topicFilters();
+  for (const auto &filter : filters)
+  {
+    if (isConnectedToHost())
+      m_client->subscribe(filter);
+    else
+      m_client->unsubscribe(filter);
+  }
+
+  // Subscribers that connect later need the value of every dataset
+  m_publishAllDatasets = true;
+
+  // Pending messages cannot be delivered anymore
+  if (!isConnectedToHost())
+  {
+    m_droppedMessages += m_outboundQueue.count();
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::MqttPublish, m_outboundQueue.count());
+    m_outboundQueue.clear();
+    m_inFlight.clear();
+    Q_EMIT outboundStatisticsChanged();
+  }
+}
+
+/**
+ * @brief Sends every frame of the given batch to the MQTT broker
+ *
+ * @param frames The frames received by the I/O manager, in order.
+ */
+void MQTT::Client::sendFrames(const IO::FrameBatch &frames)
+{
+  if (!publisherActive())
+    return;
+
+  for (const auto &frame : frames)
+    sendFrame(frame.data);
 }
 
 /**
@@ -622,27 +997,114 @@ void MQTT::Client::onConnectedChanged()
  */
 void MQTT::Client::sendFrame(const QByteArray &frame)
 {
-  Q_ASSERT(m_client);
+  // Ignore if the publisher is not active or if the frame is empty
+  if (!publisherActive() || frame.isEmpty())
+    return;
+
+  // Dataset values are published from the parsed frames
+  if (m_publishMode == PublishDatasets)
+    return;
+
+  // Raw frames are shed while the pipeline is overloaded
+  if (Misc::OverloadController::instance().shedding())
+  {
+    ++m_droppedMessages;
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::MqttPublish);
+    return;
+  }
 
-  // Ignore if device is not connected
-  if (!IO::Manager::instance().connected())
+  // Send one plain message per frame
+  if (m_publishMode == PublishFrames && !m_compressionEnabled)
+  {
+    publish(publishTopic(), frame);
     return;
+  }
+
+  // Publish the current batch if the frame does not fit in it
+  const auto recordSize = static_cast<int>(sizeof(quint32)) + frame.size();
+  if (!m_batch.isEmpty() && m_batch.size() + recordSize > m_batchMaxBytes)
+    flushBatch();
+
+  // Append the frame to the batch
+  const auto size = qToLittleEndian<quint32>(frame.size());
+  m_batch.append(reinterpret_cast<const char *>(&size), sizeof(size));
+  m_batch.append(frame);
+  ++m_batchCount;
+
+  // Publish the batch when it is full, otherwise wait for the latency limit
+  const bool full = m_batchCount >= m_batchMaxMessages
+                    || m_batch.size() >= m_batchMaxBytes;
+  if (m_publishMode == PublishFrames || full)
+    flushBatch();
+  else if (!m_batchTimer.isActive())
+    m_batchTimer.start(m_batchMaxLatency);
+}
 
-  // Ignore if client is not connected
-  else if (!isConnectedToHost())
+/**
+ * @brief Registers the values of the datasets of the given @a frame
+ *
+ * Each dataset is published in its own topic (topic/group/dataset). Numeric
+ * values are sent as 8-byte little-endian doubles, other values are sent as
+ * UTF-8 text. Only the latest value of each dataset is published when the
+ * latency limit is reached, so that high frame rates do not flood the broker.
+ *
+ * If @c changesOnly() is enabled, datasets that did not change since the
+ * previous frame are skipped, except for the first frame published after
+ * connecting to the broker.
+ *
+ * While @c Misc::OverloadController reports an overloaded pipeline, only the
+ * datasets marked as priority datasets in the project are published.
+ */
+void MQTT::Client::sendDatasets(const JSON::Frame &frame)
+{
+  // Ignore if the publisher is not active or not in dataset mode
+  if (m_publishMode != PublishDatasets || !publisherActive())
     return;
 
-  // Ignore if mode is not set to publisher
-  else if (clientMode() != ClientPublisher)
+  // Only look at the datasets that changed, if requested
+  qsizetype slot = 0;
+  const auto &changed = frame.changedDatasets();
+  const bool skipUnchanged = m_changesOnly && !m_publishAllDatasets;
+  if (skipUnchanged && frame.changedCount() == 0)
     return;
 
-  // Create & send MQTT message
-  if (!frame.isEmpty())
+  // Register the latest value of each dataset
+  m_publishAllDatasets = false;
+  const auto base = publishTopic();
+  const bool shedding = Misc::OverloadController::instance().shedding();
+  for (const auto &group : frame.groups())
   {
-    QMQTT::Message message(m_sentMessages, topic(), frame);
-    m_client->publish(message);
-    ++m_sentMessages;
+    const auto groupLevel = topicLevel(group.title());
+    for (const auto &dataset : group.datasets())
+    {
+      const auto index = slot++;
+      if (skipUnchanged && index < changed.size() && !changed.testBit(index))
+        continue;
+
+      if (shedding && !dataset.priority())
+        continue;
+
+      QByteArray payload;
+      if (dataset.isNumeric())
+      {
+        const auto value = qToLittleEndian(dataset.numericValue());
+        payload = QByteArray(reinterpret_cast<const char *>(&value),
+                             sizeof(value));
+      }
+
+      else
+        payload = dataset.value().toUtf8();
+
+      const auto datasetLevel = topicLevel(dataset.title());
+      m_datasetValues.insert(base + '/' + groupLevel + '/' + datasetLevel,
+                             payload);
+    }
   }
+
+  // Wait for the latency limit before publishing
+  if (!m_datasetValues.isEmpty() && !m_batchTimer.isActive())
+    m_batchTimer.start(m_batchMaxLatency);
 }
 
 /**
@@ -812,18 +1274,225 @@ void MQTT::Client::onMessageReceived(const QMQTT::Message &message)
   if (clientMode() != ClientSubscriber)
     return;
 
-  // Get message data
-  auto mtopic = message.topic();
-  auto mpayld = message.payload();
+  // Ignore if topic does not match any of the subscribed topic filters
+  const auto mtopic = message.topic();
+  const auto match = std::any_of(
+      m_topicFilters.cbegin(), m_topicFilters.cend(),
+      [&](const TopicFilter &filter) { return filter.matches(mtopic); });
+  if (!match)
+    return;
+
+  // Obtain the frame stream of the topic
+  const auto source = registerSource(mtopic);
+  const bool active = m_activeSource < 0 || m_activeSource == source;
+
+  // Unpack batched messages
+  const auto &payload = message.payload();
+  QList<QByteArray> frames;
+  if (!decodePayload(payload, frames))
+    frames.append(payload);
+
+  // Route the frames, only the active stream is processed by the IO manager
+  auto &manager = IO::Manager::instance();
+  for (const auto &frame : std::as_const(frames))
+  {
+    Q_EMIT sourceFrameReceived(source, frame);
+    if (active)
+      manager.enqueuePayload(frame);
+  }
+}
+
+/**
+ * Forgets the received topics & processes the frames of all topics again
+ */
+void MQTT::Client::clearSources()
+{
+  m_sources.clear();
+  m_sourceIds.clear();
+  m_activeSource = -1;
+
+  Q_EMIT sourcesChanged();
+  Q_EMIT activeSourceChanged();
+}
+
+/**
+ * Returns the topic used by the publisher, which is the first topic entered
+ * by the user.
+ */
+QString MQTT::Client::publishTopic() const
+{
+  if (m_topicList.isEmpty())
+    return QString();
+
+  return m_topicList.first();
+}
+
+/**
+ * Returns the index of the frame stream of the given @a topic, new topics are
+ * registered as they are received.
+ */
+int MQTT::Client::registerSource(const QString &topic)
+{
+  const auto it = m_sourceIds.constFind(topic);
+  if (it != m_sourceIds.cend())
+    return it.value();
+
+  const auto source = m_sources.count();
+  m_sources.append(topic);
+  m_sourceIds.insert(topic, source);
+  Q_EMIT sourcesChanged();
+  return source;
+}
+
+/**
+ * Returns @c true if received frames shall be published to the broker
+ */
+bool MQTT::Client::publisherActive() const
+{
+  return m_client && IO::Manager::instance().connected()
+         && isConnectedToHost() && clientMode() == ClientPublisher;
+}
+
+/**
+ * Removes acknowledged QoS 1/2 messages from the in-flight window & sends the
+ * messages that were waiting in the outbound queue.
+ */
+void MQTT::Client::onPublished(const QMQTT::Message &message, quint16 msgid)
+{
+  Q_UNUSED(message);
+
+  // Register the time it took the broker to acknowledge the message
+  const auto sent = m_inFlight.constFind(msgid);
+  if (sent != m_inFlight.cend())
+  {
+    auto &stats = Misc::PipelineStats::instance();
+    stats.record(Misc::PipelineStats::MqttPublish, 0, 0,
+                 stats.timestamp() - sent.value());
 
-  // Ignore if topic is not equal to current topic
-  if (topic() != mtopic)
+    m_inFlight.erase(sent);
+    drainQueue();
+  }
+}
+
+/**
+ * @brief Publishes the given @a payload in the given @a topic
+ *
+ * QoS 0 messages are sent right away. QoS 1/2 messages are sent while the
+ * in-flight window has room, otherwise they wait in the bounded outbound
+ * queue & the configured drop policy is applied when the queue is full.
+ */
+void MQTT::Client::publish(const QString &topic, const QByteArray &payload)
+{
+  if (!m_client || !isConnectedToHost())
+    return;
+
+  // Send the message right away if there is no backpressure
+  if (qos() == 0
+      || (m_outboundQueue.isEmpty() && m_inFlight.count() < kMaxInFlight))
+  {
+    sendMessage(topic, payload);
     return;
+  }
+
+  // Queue is full, apply the drop policy
+  if (m_outboundQueue.count() >= m_queueDepth)
+  {
+    ++m_droppedMessages;
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::MqttPublish);
+    if (m_dropPolicy == DropNewest)
+      return;
+
+    m_outboundQueue.dequeue();
+  }
+
+  // Wait for the broker to acknowledge the in-flight messages
+  m_outboundQueue.enqueue({topic, payload});
+  TRACE_COUNTER("MQTT outbound queue", m_outboundQueue.count());
+  Misc::OverloadController::instance().reportQueue(
+      Misc::OverloadController::MqttQueue, m_outboundQueue.count(),
+      m_queueDepth);
+}
+
+/**
+ * Hands the given message to the MQTT client, QoS 1/2 messages are tracked
+ * until the broker acknowledges them.
+ */
+void MQTT::Client::sendMessage(const QString &topic, const QByteArray &payload)
+{
+  // Let the MQTT client assign the packet ID of QoS 1/2 messages
+  const auto qosLevel = qos();
+  const quint16 id = qosLevel > 0 ? 0 : m_sentMessages;
+  QMQTT::Message message(id, topic, payload, qosLevel, retain());
+
+  // Publish the message & register it in the in-flight window
+  auto &stats = Misc::PipelineStats::instance();
+  const auto msgid = m_client->publish(message);
+  if (qosLevel > 0)
+    m_inFlight.insert(msgid, stats.timestamp());
+
+  ++m_sentMessages;
+  stats.record(Misc::PipelineStats::MqttPublish, 1, payload.size());
+}
+
+/**
+ * Converts the given group/dataset @a name into a valid MQTT topic level by
+ * replacing the separator & wildcard characters.
+ */
+QString MQTT::Client::topicLevel(const QString &name)
+{
+  auto level = name.simplified();
+  level.replace('/', '_');
+  level.replace('+', '_');
+  level.replace('#', '_');
+
+  if (level.isEmpty())
+    return QStringLiteral("_");
+
+  return level;
+}
 
-  // Let IO manager process incoming data
-  QMetaObject::invokeMethod(
-      this, [=] { IO::Manager::instance().processPayload(mpayld); },
-      Qt::QueuedConnection);
+/**
+ * Unpacks the frames of a batched message into @a frames, returns @c false if
+ * the @a payload is not a valid batch envelope.
+ */
+bool MQTT::Client::decodePayload(const QByteArray &payload,
+                                 QList<QByteArray> &frames)
+{
+  // Validate the envelope header
+  if (payload.size() < kEnvelopeHeaderSize)
+    return false;
+
+  if (!payload.startsWith(kEnvelopeMagic))
+    return false;
+
+  if (static_cast<quint8>(payload.at(4)) != kEnvelopeVersion)
+    return false;
+
+  // Obtain the body
+  QByteArray body = payload.mid(kEnvelopeHeaderSize);
+  if (static_cast<quint8>(payload.at(5)) & kEnvelopeCompressed)
+  {
+    body = qUncompress(body);
+    if (body.isEmpty())
+      return false;
+  }
+
+  // Read the records
+  qsizetype offset = 0;
+  const auto header = static_cast<qsizetype>(sizeof(quint32));
+  while (body.size() - offset >= header)
+  {
+    const auto size = qFromLittleEndian<quint32>(body.constData() + offset);
+    offset += header;
+    if (body.size() - offset < static_cast<qsizetype>(size))
+      break;
+
+    frames.append(body.mid(offset, size));
+    offset += size;
+  }
+
+  return true;
 }
 
 /**
@@ -837,11 +1506,11 @@ void MQTT::Client::regenerateClient()
   QString user = "";
   bool retain = false;
   QString password = "";
-  quint16 keepAlive = 60;
+  quint16 keepAlive = kDefaultKeepAlive;
   quint16 port = defaultPort();
   QString host = defaultHost();
   QMQTT::MQTTVersion version = QMQTT::V3_1_1;
-  QString clientId = QStringLiteral("SerialStudio");
+  QString clientId = QString::fromLatin1(kDefaultClientId);
 
   // There is an existing client, copy its configuration and delete it from
   // memory
@@ -860,6 +1529,7 @@ void MQTT::Client::regenerateClient()
 
     disconnect(m_client, &QMQTT::Client::error, nullptr, 0);
     disconnect(m_client, &QMQTT::Client::received, nullptr, 0);
+    disconnect(m_client, &QMQTT::Client::published, nullptr, 0);
     disconnect(m_client, &QMQTT::Client::connected, nullptr, 0);
     disconnect(m_client, &QMQTT::Client::sslErrors, nullptr, 0);
     disconnect(m_client, &QMQTT::Client::disconnected, nullptr, 0);
@@ -892,6 +1562,8 @@ void MQTT::Client::regenerateClient()
           &MQTT::Client::onSslErrors);
   connect(m_client, &QMQTT::Client::received, this,
           &MQTT::Client::onMessageReceived);
+  connect(m_client, &QMQTT::Client::published, this,
+          &MQTT::Client::onPublished);
   connect(m_client, &QMQTT::Client::connected, this,
           &MQTT::Client::connectedChanged);
   connect(m_client, &QMQTT::Client::connected, this,
@@ -901,3 +1573,15 @@ void MQTT::Client::regenerateClient()
   connect(m_client, &QMQTT::Client::disconnected, this,
           &MQTT::Client::onConnectedChanged);
 }
+
+/**
+ * Returns the QMQTT client, creating it on first use so that applications
+ * which never talk to a broker do not pay for the socket setup at startup.
+ */
+QMQTT::Client *MQTT::Client::client()
+{
+  if (!m_client)
+    regenerateClient();
+
+  return m_client;
+}
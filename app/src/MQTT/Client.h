@@ -22,6 +22,11 @@
 
 #pragma once
 
+#include <QMap>
+#include <QSet>
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
 #include <QObject>
 #include <QPointer>
 #include <QHostInfo>
@@ -31,6 +36,14 @@
 
 #include <qmqtt.h>
 
+#include "IO/FrameBatch.h"
+#include "MQTT/TopicFilter.h"
+
+namespace JSON
+{
+class Frame;
+}
+
 namespace MQTT
 {
 /**
@@ -44,6 +57,35 @@ enum MQTTClientMode
   ClientSubscriber = 1
 };
 
+/**
+ * @brief The MQTTPublishMode enum
+ *
+ * Specifies how the publisher maps received frames to MQTT messages:
+ * - One message per frame, with the raw frame text as payload.
+ * - Batches of frames packed into a single message.
+ * - One topic per dataset, with the latest value of each dataset.
+ *
+ * In the per-dataset mode, the publisher can optionally skip the datasets
+ * whose values did not change since the previous frame.
+ */
+enum MQTTPublishMode
+{
+  PublishFrames = 0,
+  PublishBatches = 1,
+  PublishDatasets = 2
+};
+
+/**
+ * @brief The MQTTDropPolicy enum
+ *
+ * Specifies which messages are discarded when the outbound queue is full.
+ */
+enum MQTTDropPolicy
+{
+  DropOldest = 0,
+  DropNewest = 1
+};
+
 /**
  * @brief The Client class
  *
@@ -145,6 +187,60 @@ class Client : public QObject
   Q_PROPERTY(bool isSubscribed
              READ isSubscribed
              NOTIFY connectedChanged)
+  Q_PROPERTY(int publishMode
+             READ publishMode
+             WRITE setPublishMode
+             NOTIFY publishModeChanged)
+  Q_PROPERTY(int batchMaxMessages
+             READ batchMaxMessages
+             WRITE setBatchMaxMessages
+             NOTIFY batchSettingsChanged)
+  Q_PROPERTY(int batchMaxBytes
+             READ batchMaxBytes
+             WRITE setBatchMaxBytes
+             NOTIFY batchSettingsChanged)
+  Q_PROPERTY(int batchMaxLatency
+             READ batchMaxLatency
+             WRITE setBatchMaxLatency
+             NOTIFY batchSettingsChanged)
+  Q_PROPERTY(bool compressionEnabled
+             READ compressionEnabled
+             WRITE setCompressionEnabled
+             NOTIFY compressionEnabledChanged)
+  Q_PROPERTY(bool changesOnly
+             READ changesOnly
+             WRITE setChangesOnly
+             NOTIFY changesOnlyChanged)
+  Q_PROPERTY(QStringList publishModes
+             READ publishModes
+             CONSTANT)
+  Q_PROPERTY(int queueDepth
+             READ queueDepth
+             WRITE setQueueDepth
+             NOTIFY queueDepthChanged)
+  Q_PROPERTY(int dropPolicy
+             READ dropPolicy
+             WRITE setDropPolicy
+             NOTIFY dropPolicyChanged)
+  Q_PROPERTY(QStringList dropPolicies
+             READ dropPolicies
+             CONSTANT)
+  Q_PROPERTY(int queuedMessages
+             READ queuedMessages
+             NOTIFY outboundStatisticsChanged)
+  Q_PROPERTY(int inFlightMessages
+             READ inFlightMessages
+             NOTIFY outboundStatisticsChanged)
+  Q_PROPERTY(quint64 droppedMessages
+             READ droppedMessages
+             NOTIFY outboundStatisticsChanged)
+  Q_PROPERTY(QStringList sources
+             READ sources
+             NOTIFY sourcesChanged)
+  Q_PROPERTY(int activeSource
+             READ activeSource
+             WRITE setActiveSource
+             NOTIFY activeSourceChanged)
   // clang-format on
 
 signals:
@@ -164,6 +260,16 @@ signals:
   void sslProtocolChanged();
   void mqttVersionChanged();
   void lookupActiveChanged();
+  void publishModeChanged();
+  void batchSettingsChanged();
+  void compressionEnabledChanged();
+  void changesOnlyChanged();
+  void queueDepthChanged();
+  void dropPolicyChanged();
+  void outboundStatisticsChanged();
+  void sourcesChanged();
+  void activeSourceChanged();
+  void sourceFrameReceived(const int source, const QByteArray &frame);
 
 private:
   explicit Client();
@@ -194,9 +300,28 @@ public:
   [[nodiscard]] bool isSubscribed() const;
   [[nodiscard]] bool isConnectedToHost() const;
 
+  [[nodiscard]] int publishMode() const;
+  [[nodiscard]] int batchMaxBytes() const;
+  [[nodiscard]] int batchMaxLatency() const;
+  [[nodiscard]] int batchMaxMessages() const;
+  [[nodiscard]] bool compressionEnabled() const;
+  [[nodiscard]] bool changesOnly() const;
+
+  [[nodiscard]] int queueDepth() const;
+  [[nodiscard]] int dropPolicy() const;
+  [[nodiscard]] int queuedMessages() const;
+  [[nodiscard]] int inFlightMessages() const;
+  [[nodiscard]] quint64 droppedMessages() const;
+
+  [[nodiscard]] int activeSource() const;
+  [[nodiscard]] QStringList sources() const;
+  [[nodiscard]] QStringList topicFilters() const;
+
   [[nodiscard]] QStringList qosLevels() const;
   [[nodiscard]] QStringList clientModes() const;
   [[nodiscard]] QStringList mqttVersions() const;
+  [[nodiscard]] QStringList publishModes() const;
+  [[nodiscard]] QStringList dropPolicies() const;
   [[nodiscard]] QStringList sslProtocols() const;
 
   [[nodiscard]] QString caFilePath() const;
@@ -223,18 +348,43 @@ public slots:
   void setClientId(const QString &clientId);
   void setKeepAlive(const quint16 keepAlive);
   void setMqttVersion(const int versionIndex);
+  void setPublishMode(const int mode);
+  void setBatchMaxBytes(const int bytes);
+  void setBatchMaxLatency(const int msecs);
+  void setBatchMaxMessages(const int messages);
+  void setCompressionEnabled(const bool enabled);
+  void setChangesOnly(const bool enabled);
+  void setQueueDepth(const int depth);
+  void setDropPolicy(const int policy);
+  void setActiveSource(const int source);
 
 private slots:
+  void flushBatch();
+  void drainQueue();
   void resetStatistics();
   void onConnectedChanged();
   void sendFrame(const QByteArray &frame);
+  void sendFrames(const IO::FrameBatch &frames);
+  void sendDatasets(const JSON::Frame &frame);
   void lookupFinished(const QHostInfo &info);
   void onError(const QMQTT::ClientError error);
   void onSslErrors(const QList<QSslError> &errors);
   void onMessageReceived(const QMQTT::Message &message);
+  void onPublished(const QMQTT::Message &message, quint16 msgid);
 
 private:
   void regenerateClient();
+  QMQTT::Client *client();
+  void clearSources();
+  [[nodiscard]] QString publishTopic() const;
+  [[nodiscard]] bool publisherActive() const;
+  [[nodiscard]] int registerSource(const QString &topic);
+  void publish(const QString &topic, const QByteArray &payload);
+  void sendMessage(const QString &topic, const QByteArray &payload);
+
+  [[nodiscard]] static QString topicLevel(const QString &name);
+  [[nodiscard]] static bool decodePayload(const QByteArray &payload,
+                                          QList<QByteArray> &frames);
 
 private:
   QString m_topic;
@@ -246,5 +396,36 @@ private:
   MQTTClientMode m_clientMode;
   QPointer<QMQTT::Client> m_client;
   QSslConfiguration m_sslConfiguration;
+  QStringList m_topicList;
+  QVector<TopicFilter> m_topicFilters;
+
+  MQTTPublishMode m_publishMode;
+  int m_batchMaxBytes;
+  int m_batchMaxLatency;
+  int m_batchMaxMessages;
+  bool m_compressionEnabled;
+  bool m_changesOnly;
+  bool m_publishAllDatasets;
+
+  int m_batchCount;
+  QByteArray m_batch;
+  QTimer m_batchTimer;
+  QMap<QString, QByteArray> m_datasetValues;
+
+  struct OutboundMessage
+  {
+    QString topic;
+    QByteArray payload;
+  };
+
+  int m_queueDepth;
+  quint64 m_droppedMessages;
+  MQTTDropPolicy m_dropPolicy;
+  QHash<quint16, qint64> m_inFlight;
+  QQueue<OutboundMessage> m_outboundQueue;
+
+  int m_activeSource;
+  QStringList m_sources;
+  QHash<QString, int> m_sourceIds;
 };
 } // namespace MQTT
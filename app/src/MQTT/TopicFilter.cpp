@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MQTT/TopicFilter.h"
+
+/**
+ * Constructor function, compiles the given topic @a filter.
+ */
+MQTT::TopicFilter::TopicFilter(const QString &filter)
+  : m_valid(false)
+  , m_wildcards(false)
+{
+  setFilter(filter);
+}
+
+/**
+ * Returns @c true if the filter is not empty & uses the wildcards correctly
+ */
+bool MQTT::TopicFilter::isValid() const
+{
+  return m_valid;
+}
+
+/**
+ * Returns @c true if the filter contains @c + or @c # wildcards
+ */
+bool MQTT::TopicFilter::hasWildcards() const
+{
+  return m_wildcards;
+}
+
+/**
+ * Returns the topic filter string
+ */
+const QString &MQTT::TopicFilter::filter() const
+{
+  return m_filter;
+}
+
+/**
+ * @brief Checks if the given @a topic matches the filter.
+ *
+ * Follows the MQTT 3.1.1 rules: @c + matches exactly one level, @c # matches
+ * the parent level & any number of child levels, and topics starting with
+ * @c $ are not matched by filters that start with a wildcard.
+ */
+bool MQTT::TopicFilter::matches(QStringView topic) const
+{
+  // Filter is invalid
+  if (!m_valid)
+    return false;
+
+  // Filters without wildcards only match the exact same topic
+  if (!m_wildcards)
+    return topic == m_filter;
+
+  // System topics are not matched by leading wildcards
+  const auto &first = m_levels.first();
+  if (topic.startsWith(u'$') && (first == QStringLiteral("+")
+                                 || first == QStringLiteral("#")))
+    return false;
+
+  // Compare the topic level by level, without splitting it into strings
+  qsizetype start = 0;
+  for (int i = 0; i < m_levels.count(); ++i)
+  {
+    const auto &level = m_levels.at(i);
+
+    // Multi-level wildcard matches the rest of the topic (& its parent)
+    if (level == QStringLiteral("#"))
+      return true;
+
+    // Topic has less levels than the filter
+    if (start > topic.size())
+      return false;
+
+    // Obtain the current topic level
+    auto end = topic.indexOf(u'/', start);
+    if (end < 0)
+      end = topic.size();
+
+    // Compare the level, unless the filter uses a single-level wildcard
+    const auto current = topic.mid(start, end - start);
+    if (level != QStringLiteral("+") && current != level)
+      return false;
+
+    start = end + 1;
+  }
+
+  // All filter levels matched, the topic must not have more levels
+  return start > topic.size();
+}
+
+/**
+ * Changes & compiles the topic filter, invalid filters never match a topic.
+ */
+void MQTT::TopicFilter::setFilter(const QString &filter)
+{
+  m_filter = filter;
+  m_levels = filter.split('/');
+  m_wildcards = filter.contains('+') || filter.contains('#');
+
+  // Validate the wildcards, they must occupy a whole level & '#' must be last
+  m_valid = !filter.isEmpty();
+  for (int i = 0; i < m_levels.count() && m_valid; ++i)
+  {
+    const auto &level = m_levels.at(i);
+    if (level.contains('#'))
+      m_valid = level.size() == 1 && i == m_levels.count() - 1;
+    else if (level.contains('+'))
+      m_valid = level.size() == 1;
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+namespace MQTT
+{
+/**
+ * @class MQTT::TopicFilter
+ * @brief Precompiled MQTT topic filter.
+ *
+ * Splits a topic filter into its levels once, so that incoming topics can be
+ * matched against it without allocating memory for every received message.
+ * Supports the single-level (@c +) & multi-level (@c #) wildcards, filters
+ * without wildcards are matched with a plain string comparison.
+ */
+class TopicFilter
+{
+public:
+  TopicFilter(const QString &filter = QString());
+
+  [[nodiscard]] bool isValid() const;
+  [[nodiscard]] bool hasWildcards() const;
+  [[nodiscard]] const QString &filter() const;
+  [[nodiscard]] bool matches(QStringView topic) const;
+
+  void setFilter(const QString &filter);
+
+private:
+  bool m_valid;
+  bool m_wildcards;
+  QString m_filter;
+  QStringList m_levels;
+};
+} // namespace MQTT
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/AlarmEngine.h"
+
+#include <QtNumeric>
+
+#include "CSV/Player.h"
+#include "CSV/Reference.h"
+#include "IO/Manager.h"
+#include "SIMD/SIMD.h"
+#include "JSON/FrameBuilder.h"
+#include "Misc/TimerEvents.h"
+
+/**
+ * Largest number of consecutive frames required to change an alarm state.
+ */
+static constexpr int kMaxDebounce = 1000;
+
+/**
+ * Largest hysteresis, as a percentage of the alarm level.
+ */
+static constexpr qreal kMaxHysteresis = 100;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, restores the debounce & hysteresis settings.
+ */
+Misc::AlarmEngine::AlarmEngine()
+  : m_debounce(1)
+  , m_hysteresis(0)
+  , m_changed(false)
+  , m_activeAlarms(0)
+  , m_generation(0)
+{
+  m_debounce = qBound(1, m_settings.value("alarm_debounce", 1).toInt(),
+                      kMaxDebounce);
+  m_hysteresis = qBound(0.0, m_settings.value("alarm_hysteresis", 0).toReal(),
+                        kMaxHysteresis);
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::AlarmEngine &Misc::AlarmEngine::instance()
+{
+  static AlarmEngine singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// Member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the number of consecutive frames in which the condition of an alarm
+ * state change must hold before the state changes.
+ */
+int Misc::AlarmEngine::debounce() const
+{
+  return m_debounce;
+}
+
+/**
+ * Returns the distance below the alarm level, as a percentage of the alarm
+ * level, that a value must fall to clear the alarm.
+ */
+qreal Misc::AlarmEngine::hysteresis() const
+{
+  return m_hysteresis;
+}
+
+/**
+ * Returns the number of active alarms, including the reference deviation
+ * alarms.
+ */
+int Misc::AlarmEngine::activeAlarms() const
+{
+  return m_activeAlarms + CSV::Reference::instance().deviations();
+}
+
+/**
+ * Returns @c true if the alarm of the dataset with the given frame @a index
+ * is active, or if the dataset deviates from the reference session.
+ */
+bool Misc::AlarmEngine::active(const int index) const
+{
+  if (CSV::Reference::instance().deviating(index))
+    return true;
+
+  const auto channel = m_channels.value(index, -1);
+  if (channel < 0)
+    return false;
+
+  return m_active[channel];
+}
+
+//------------------------------------------------------------------------------
+// Public slots
+//------------------------------------------------------------------------------
+
+/**
+ * Clears every alarm & forgets the datasets, they are registered again with
+ * the next frame.
+ */
+void Misc::AlarmEngine::reset()
+{
+  m_generation = 0;
+  m_sources.clear();
+  m_channels.clear();
+  m_values.clear();
+  m_raise.clear();
+  m_clear.clear();
+  m_aboveRaise.clear();
+  m_aboveClear.clear();
+  m_active.clear();
+  m_pending.clear();
+
+  if (m_activeAlarms > 0)
+  {
+    m_changed = true;
+    m_activeAlarms = 0;
+  }
+}
+
+/**
+ * Receives the frames of the frame builder, resets the alarms when a device
+ * is connected or a CSV file is opened & notifies the widgets on each UI
+ * refresh tick.
+ */
+void Misc::AlarmEngine::setupExternalConnections()
+{
+  // clang-format off
+  connect(&CSV::Player::instance(), &CSV::Player::openChanged, this, [=] { reset(); });
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this, [=] { reset(); });
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::jsonFileMapChanged, this, [=] { reset(); });
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged, this, &Misc::AlarmEngine::processFrame, Qt::QueuedConnection);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi, this, &Misc::AlarmEngine::notifyChanges);
+  connect(&CSV::Reference::instance(), &CSV::Reference::deviationsChanged, this, &Misc::AlarmEngine::alarmsChanged);
+  // clang-format on
+}
+
+/**
+ * Changes the number of consecutive frames required to raise or clear an
+ * alarm.
+ */
+void Misc::AlarmEngine::setDebounce(const int frames)
+{
+  const auto debounce = qBound(1, frames, kMaxDebounce);
+  if (m_debounce != debounce)
+  {
+    m_debounce = debounce;
+    m_settings.setValue("alarm_debounce", debounce);
+    Q_EMIT settingsChanged();
+  }
+}
+
+/**
+ * Changes the hysteresis of the alarms, as a percentage of the alarm level,
+ * the new clear levels are applied with the next frame.
+ */
+void Misc::AlarmEngine::setHysteresis(const qreal percent)
+{
+  const auto hysteresis = qBound(0.0, percent, kMaxHysteresis);
+  if (!qFuzzyCompare(m_hysteresis, hysteresis))
+  {
+    m_hysteresis = hysteresis;
+    m_generation = 0;
+    m_settings.setValue("alarm_hysteresis", hysteresis);
+    Q_EMIT settingsChanged();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Alarm evaluation
+//------------------------------------------------------------------------------
+
+/**
+ * Emits @c alarmsChanged() if any alarm changed since the last UI refresh
+ * tick.
+ */
+void Misc::AlarmEngine::notifyChanges()
+{
+  if (m_changed)
+  {
+    m_changed = false;
+    Q_EMIT alarmsChanged();
+  }
+}
+
+/**
+ * @brief Evaluates the alarms of every dataset with the values of the given
+ *        @a frame.
+ *
+ * The values are compared against the raise & clear levels of all datasets
+ * at once, the state of each alarm is then only updated when the condition
+ * for a state change holds.
+ */
+void Misc::AlarmEngine::processFrame(const JSON::Frame &frame)
+{
+  // Validate frame & register the datasets when the structure changes
+  if (!frame.isValid())
+    return;
+
+  if (frame.generation() != m_generation)
+  {
+    if (!sameLayout(frame))
+      initialize(frame);
+
+    loadThresholds(frame);
+    m_generation = frame.generation();
+  }
+
+  // Nothing to do if the frame has no datasets
+  const auto channels = m_sources.count();
+  if (channels == 0)
+    return;
+
+  // Gather the numeric values, text datasets never trigger alarms
+  const auto &groups = frame.groups();
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    const auto &source = m_sources[c];
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    m_values[c] = dataset.isNumeric() ? dataset.numericValue() : qQNaN();
+  }
+
+  // Compare all the values against their raise & clear levels
+  SIMD::compareGreaterEqual(m_values.constData(), m_raise.constData(),
+                            m_aboveRaise.data(), channels);
+  SIMD::compareGreaterEqual(m_values.constData(), m_clear.constData(),
+                            m_aboveClear.data(), channels);
+
+  // Update the states whose change condition held for long enough
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    const bool condition = m_active[c] ? !m_aboveClear[c] : m_aboveRaise[c];
+    if (!condition)
+    {
+      m_pending[c] = 0;
+      continue;
+    }
+
+    if (++m_pending[c] >= m_debounce)
+    {
+      m_pending[c] = 0;
+      m_active[c] = !m_active[c];
+      m_activeAlarms += m_active[c] ? 1 : -1;
+      m_changed = true;
+    }
+  }
+
+  // Leave the low-power idle state, so that alarms are shown immediately
+  if (m_changed)
+    Misc::TimerEvents::instance().wake();
+}
+
+/**
+ * Returns @c true if the datasets of the given @a frame are at the same
+ * locations & have the same frame indexes as the current sources.
+ */
+bool Misc::AlarmEngine::sameLayout(const JSON::Frame &frame) const
+{
+  if (m_sources.isEmpty())
+    return false;
+
+  const auto &groups = frame.groups();
+  for (const auto &source : m_sources)
+  {
+    if (source.group >= groups.count())
+      return false;
+
+    const auto &datasets = groups[source.group].datasets();
+    if (source.dataset >= datasets.count()
+        || datasets[source.dataset].index() != source.index)
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Registers the datasets of the given @a frame & clears their alarms,
+ * datasets that share a frame index are only evaluated once.
+ */
+void Misc::AlarmEngine::initialize(const JSON::Frame &frame)
+{
+  reset();
+
+  // Register each dataset once
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &datasets = groups[g].datasets();
+    for (int d = 0; d < datasets.count(); ++d)
+    {
+      const auto index = datasets[d].index();
+      if (m_channels.contains(index))
+        continue;
+
+      m_channels.insert(index, m_sources.count());
+      m_sources.append({g, d, index});
+    }
+  }
+
+  // Allocate the state of each dataset
+  const auto channels = m_sources.count();
+  m_values.fill(0, channels);
+  m_raise.fill(0, channels);
+  m_clear.fill(0, channels);
+  m_aboveRaise.fill(0, channels);
+  m_aboveClear.fill(0, channels);
+  m_active.fill(0, channels);
+  m_pending.fill(0, channels);
+}
+
+/**
+ * Obtains the raise & clear levels of each dataset from the given @a frame,
+ * datasets without an alarm level get infinite levels, which are never
+ * reached.
+ */
+void Misc::AlarmEngine::loadThresholds(const JSON::Frame &frame)
+{
+  const auto &groups = frame.groups();
+  for (qsizetype c = 0; c < m_sources.count(); ++c)
+  {
+    const auto &source = m_sources[c];
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    const auto level = dataset.alarm();
+    if (level == 0)
+    {
+      m_raise[c] = qInf();
+      m_clear[c] = qInf();
+    }
+
+    else
+    {
+      m_raise[c] = level;
+      m_clear[c] = level - qAbs(level) * m_hysteresis / 100;
+    }
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include <QSettings>
+
+#include "JSON/Frame.h"
+
+namespace Misc
+{
+/**
+ * @brief The AlarmEngine class
+ *
+ * Evaluates the alarm level of every dataset for each frame emitted by the
+ * @c JSON::FrameBuilder, so that alarms are detected at the rate at which
+ * frames are received, regardless of which widgets are visible, of the UI
+ * refresh rate or of whether the application runs headless.
+ *
+ * The numeric values of the frame are gathered into a contiguous array and
+ * compared against the raise & clear levels of all the datasets with SIMD
+ * instructions. An alarm is raised when the value reaches the alarm level of
+ * the dataset, and cleared when the value falls below the alarm level minus
+ * the hysteresis (a percentage of the alarm level). A state change is only
+ * accepted once its condition holds for @c debounce() consecutive frames.
+ * Datasets with an alarm level of 0 have no alarm.
+ *
+ * Datasets that deviate from the reference session (see @c CSV::Reference)
+ * are reported as active alarms too, in addition to their level alarms.
+ *
+ * Datasets are identified by their frame index. Widgets query the state of
+ * their datasets with @c active(), the @c alarmsChanged() signal is emitted
+ * at most once per UI refresh tick.
+ */
+class AlarmEngine : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int debounce
+             READ debounce
+             WRITE setDebounce
+             NOTIFY settingsChanged)
+  Q_PROPERTY(qreal hysteresis
+             READ hysteresis
+             WRITE setHysteresis
+             NOTIFY settingsChanged)
+  Q_PROPERTY(int activeAlarms
+             READ activeAlarms
+             NOTIFY alarmsChanged)
+  // clang-format on
+
+signals:
+  void alarmsChanged();
+  void settingsChanged();
+
+private:
+  explicit AlarmEngine();
+  AlarmEngine(AlarmEngine &&) = delete;
+  AlarmEngine(const AlarmEngine &) = delete;
+  AlarmEngine &operator=(AlarmEngine &&) = delete;
+  AlarmEngine &operator=(const AlarmEngine &) = delete;
+
+public:
+  static AlarmEngine &instance();
+
+  [[nodiscard]] int debounce() const;
+  [[nodiscard]] qreal hysteresis() const;
+  [[nodiscard]] int activeAlarms() const;
+  [[nodiscard]] bool active(const int index) const;
+
+public slots:
+  void reset();
+  void setupExternalConnections();
+  void setDebounce(const int frames);
+  void setHysteresis(const qreal percent);
+
+private slots:
+  void notifyChanges();
+  void processFrame(const JSON::Frame &frame);
+
+private:
+  [[nodiscard]] bool sameLayout(const JSON::Frame &frame) const;
+  void initialize(const JSON::Frame &frame);
+  void loadThresholds(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Location of a dataset in the source frame.
+   */
+  struct Source
+  {
+    int group;
+    int dataset;
+    int index;
+  };
+
+  int m_debounce;
+  qreal m_hysteresis;
+  QSettings m_settings;
+
+  bool m_changed;
+  int m_activeAlarms;
+  quint64 m_generation;
+
+  QVector<Source> m_sources;
+  QHash<int, qsizetype> m_channels;
+
+  QVector<double> m_values;
+  QVector<double> m_raise;
+  QVector<double> m_clear;
+  QVector<quint8> m_aboveRaise;
+  QVector<quint8> m_aboveClear;
+  QVector<quint8> m_active;
+  QVector<qint32> m_pending;
+};
+} // namespace Misc
@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/Benchmark.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include <QFile>
+#include <QThread>
+#include <QSysInfo>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QSignalBlocker>
+#include <QTemporaryDir>
+
+#include "AppInfo.h"
+#include "IO/Checksum.h"
+#include "IO/FrameReader.h"
+#include "UI/Dashboard.h"
+#include "CSV/ExportWriter.h"
+#include "JSON/FrameParser.h"
+#include "JSON/FrameBuilder.h"
+#include "JSON/NativeParser.h"
+#include "JSON/ParserEngine.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/SessionClock.h"
+
+//------------------------------------------------------------------------------
+// Benchmark parameters
+//------------------------------------------------------------------------------
+
+static constexpr int kChannels = 8;
+static constexpr int kBatchSize = 100;
+static constexpr qint64 kMinIterations = 10;
+static constexpr qint64 kMinDurationNs = 250 * 1000 * 1000;
+static constexpr qsizetype kChunkSize = 64 * 1024;
+static constexpr qsizetype kBufferSize = 1024 * 1024;
+
+//------------------------------------------------------------------------------
+// Constructor function
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs an empty benchmark report.
+ */
+Misc::Benchmark::Benchmark() {}
+
+//------------------------------------------------------------------------------
+// Benchmark execution
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Runs every benchmark case & writes the JSON report.
+ *
+ * The report is written to @a outputPath, or to the standard output if no
+ * path is given. A human-readable summary of each case is printed through
+ * the Qt message handler while the benchmarks run.
+ *
+ * @param outputPath Location of the JSON report (optional).
+ * @return @c EXIT_SUCCESS, or @c EXIT_FAILURE if the report can't be written.
+ */
+int Misc::Benchmark::run(const QString &outputPath)
+{
+  // Run every pipeline stage, following the order in which data flows
+  m_results.clear();
+  benchmarkCircularBuffer();
+  benchmarkFrameReader();
+  benchmarkChecksum();
+  benchmarkFrameParser();
+  benchmarkFrameBuilder();
+  benchmarkDashboard();
+  benchmarkCsvExport();
+  benchmarkEndToEnd();
+
+  // Generate the report
+  const auto json = QJsonDocument(report()).toJson(QJsonDocument::Indented);
+
+  // Write the report to the standard output
+  if (outputPath.isEmpty())
+  {
+    QFile output;
+    if (output.open(stdout, QIODevice::WriteOnly))
+    {
+      output.write(json);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  // Write the report to the given file
+  else
+  {
+    QFile output(outputPath);
+    if (output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      output.write(json);
+      qInfo() << "Benchmark report written to" << outputPath;
+      return EXIT_SUCCESS;
+    }
+  }
+
+  qCritical() << "Cannot write benchmark report" << outputPath;
+  return EXIT_FAILURE;
+}
+
+/**
+ * @brief Measures the execution time of @a function.
+ *
+ * The function is called once to warm up caches & lazily-initialized
+ * structures, and then repeatedly until it ran for at least
+ * @c kMinIterations iterations and @c kMinDurationNs nanoseconds.
+ *
+ * @param name Name of the benchmark case.
+ * @param bytesPerIteration Bytes processed by each call (0 if not relevant).
+ * @param itemsPerIteration Frames or rows processed by each call.
+ * @param function Function that runs one iteration of the benchmark.
+ */
+template<typename Function>
+void Misc::Benchmark::measure(const QString &name,
+                              const qint64 bytesPerIteration,
+                              const qint64 itemsPerIteration,
+                              Function &&function)
+{
+  // Warm up
+  function();
+
+  // Run the benchmark
+  QElapsedTimer timer;
+  qint64 iterations = 0;
+  timer.start();
+  do
+  {
+    function();
+    ++iterations;
+  } while (iterations < kMinIterations
+           || timer.nsecsElapsed() < kMinDurationNs);
+
+  // Register the result
+  const auto elapsed = timer.nsecsElapsed();
+  m_results.append(
+      {name, iterations, elapsed, bytesPerIteration, itemsPerIteration});
+
+  // Print a summary of the result
+  const double seconds = elapsed / 1e9;
+  const double items = iterations * itemsPerIteration / seconds;
+  const double megabytes = iterations * bytesPerIteration / seconds / 1e6;
+  qInfo().noquote() << QStringLiteral("%1: %2 items/s, %3 MB/s")
+                           .arg(name, -48)
+                           .arg(items, 0, 'f', 0)
+                           .arg(megabytes, 0, 'f', 2);
+}
+
+//------------------------------------------------------------------------------
+// Benchmark cases
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Measures copying data in & out of the frame reader's circular buffer,
+ *        and scanning the buffered data for frame delimiters.
+ */
+void Misc::Benchmark::benchmarkCircularBuffer()
+{
+  const auto chunk = repeat(csvFrame(0) + '\n', kChunkSize);
+  const auto frames = chunk.count('\n');
+  IO::CircularBuffer<QByteArray, char> buffer(kBufferSize);
+
+  measure(QStringLiteral("CircularBuffer/appendRead"), chunk.size(), 1, [&] {
+    buffer.append(chunk);
+    (void)buffer.read(chunk.size());
+  });
+
+  SIMD::PatternSet pattern;
+  pattern.set({QByteArray("\n")});
+  measure(QStringLiteral("CircularBuffer/findFirstOf"), chunk.size(), frames,
+          [&] {
+            buffer.append(chunk);
+            qsizetype index = 0;
+            while ((index = buffer.findFirstOf(pattern, index)) >= 0)
+              ++index;
+
+            buffer.discard(buffer.size());
+          });
+}
+
+/**
+ * @brief Measures frame extraction for every operation mode & frame detection
+ *        method, with and without checksum trailers.
+ *
+ * Data is given directly to the frame extraction code, so that the frame
+ * reader processes it without a connected device.
+ */
+void Misc::Benchmark::benchmarkFrameReader()
+{
+  // Appends a big-endian checksum trailer to the given frame
+  const auto withCrc = [](const QByteArray &frame, const QByteArray &trailer) {
+    QByteArray data = trailer;
+    if (trailer == "crc16:")
+    {
+      const auto crc = IO::crc16(frame.data(), frame.length());
+      data.append(char(crc >> 8));
+      data.append(char(crc & 0xFF));
+    }
+
+    else
+    {
+      const auto crc = IO::crc32(frame.data(), frame.length());
+      for (int shift = 24; shift >= 0; shift -= 8)
+        data.append(char((crc >> shift) & 0xFF));
+    }
+
+    return data;
+  };
+
+  // Feeds a stream of identical frames to a frame reader
+  const auto run = [this](const QString &name,
+                          const SerialStudio::OperationMode mode,
+                          const SerialStudio::FrameDetection detection,
+                          const QString &start, const QString &finish,
+                          const QByteArray &frame) {
+    IO::FrameReader reader;
+    reader.setOperationMode(mode);
+    reader.setFrameDetectionMode(detection);
+    reader.setStartSequence(start);
+    reader.setFinishSequence(finish);
+
+    qint64 frames = 0;
+    QObject::connect(&reader, &IO::FrameReader::framesReady, &reader,
+                     [&frames](const IO::FrameBatch &batch) {
+                       frames += batch.count();
+                     });
+
+    const auto chunk = repeat(frame, kChunkSize);
+    const auto count = detection == SerialStudio::NoDelimiters
+                           ? 1
+                           : chunk.size() / frame.size();
+    measure(name, chunk.size(), count, [&] {
+      reader.m_dataBuffer.append(chunk);
+      reader.extractFrames();
+    });
+
+    if (frames == 0)
+      qWarning() << name << "did not detect any frame";
+  };
+
+  // Frame reader inputs
+  const auto csv = csvFrame(0);
+  const auto json = jsonFrame(0);
+
+  // clang-format off
+  run(QStringLiteral("FrameReader/QuickPlot"),
+      SerialStudio::QuickPlot, SerialStudio::EndDelimiterOnly,
+      QString(), QString(), csv + "\r\n");
+  run(QStringLiteral("FrameReader/DeviceSendsJSON"),
+      SerialStudio::DeviceSendsJSON, SerialStudio::StartAndEndDelimiter,
+      QStringLiteral("/*"), QStringLiteral("*/"), "/*" + json + "*/");
+  run(QStringLiteral("FrameReader/EndDelimiterOnly"),
+      SerialStudio::ProjectFile, SerialStudio::EndDelimiterOnly,
+      QString(), QStringLiteral("\n"), csv + "\n");
+  run(QStringLiteral("FrameReader/EndDelimiterOnly+CRC16"),
+      SerialStudio::ProjectFile, SerialStudio::EndDelimiterOnly,
+      QString(), QStringLiteral("\n"), csv + "\n" + withCrc(csv, "crc16:"));
+  run(QStringLiteral("FrameReader/EndDelimiterOnly+CRC32"),
+      SerialStudio::ProjectFile, SerialStudio::EndDelimiterOnly,
+      QString(), QStringLiteral("\n"), csv + "\n" + withCrc(csv, "crc32:"));
+  run(QStringLiteral("FrameReader/StartAndEndDelimiter"),
+      SerialStudio::ProjectFile, SerialStudio::StartAndEndDelimiter,
+      QStringLiteral("$"), QStringLiteral(";"), "$" + csv + ";");
+  run(QStringLiteral("FrameReader/StartAndEndDelimiter+CRC16"),
+      SerialStudio::ProjectFile, SerialStudio::StartAndEndDelimiter,
+      QStringLiteral("$"), QStringLiteral(";"),
+      "$" + csv + ";" + withCrc(csv, "crc16:"));
+  run(QStringLiteral("FrameReader/NoDelimiters"),
+      SerialStudio::ProjectFile, SerialStudio::NoDelimiters,
+      QString(), QString(), csv);
+  // clang-format on
+}
+
+/**
+ * @brief Measures the throughput of every checksum algorithm that frames can
+ *        be validated with.
+ *
+ * On ARM64, the CRC-32 case reports the hardware path when the CPU implements
+ * the CRC extension, and the slice-by-8 tables otherwise.
+ */
+void Misc::Benchmark::benchmarkChecksum()
+{
+  const auto chunk = repeat(csvFrame(0) + '\n', kChunkSize);
+  const auto *data = chunk.constData();
+  const auto length = static_cast<int>(chunk.size());
+
+  // Accumulate the results so that the calls are not optimized away
+  quint64 sink = 0;
+
+  // clang-format off
+  measure(QStringLiteral("Checksum/CRC8"), length, 1,
+          [&] { sink += IO::crc8(data, length); });
+  measure(QStringLiteral("Checksum/CRC16"), length, 1,
+          [&] { sink += IO::crc16(data, length); });
+  measure(QStringLiteral("Checksum/CRC16-MODBUS"), length, 1,
+          [&] { sink += IO::crc16Modbus(data, length); });
+  measure(QStringLiteral("Checksum/CRC16-XMODEM"), length, 1,
+          [&] { sink += IO::crc16Xmodem(data, length); });
+  measure(QStringLiteral("Checksum/CRC32"), length, 1,
+          [&] { sink += IO::crc32(data, length); });
+  measure(QStringLiteral("Checksum/Fletcher16"), length, 1,
+          [&] { sink += IO::fletcher16(data, length); });
+  measure(QStringLiteral("Checksum/Fletcher32"), length, 1,
+          [&] { sink += IO::fletcher32(data, length); });
+  // clang-format on
+
+  if (sink == 0)
+    qWarning() << "Checksum benchmark produced no output";
+}
+
+/**
+ * @brief Measures the JavaScript frame parser (with the default parser code)
+ *        and the native frame parser modes.
+ */
+void Misc::Benchmark::benchmarkFrameParser()
+{
+  // Generate the frames to parse
+  QStringList texts;
+  QList<QByteArray> frames;
+  for (int i = 0; i < kBatchSize; ++i)
+  {
+    frames.append(csvFrame(i));
+    texts.append(QString::fromUtf8(frames.last()));
+  }
+
+  // JavaScript parser, one frame per call & batched
+  JSON::ParserEngine engine;
+  if (engine.loadScript(JSON::FrameParser::defaultCode()))
+  {
+    measure(QStringLiteral("FrameParser/parse"), frames.first().size(), 1,
+            [&] { (void)engine.parse(texts.first()); });
+    measure(QStringLiteral("FrameParser/parseBatch"),
+            frames.first().size() * kBatchSize, kBatchSize,
+            [&] { (void)engine.parseBatch(texts); });
+  }
+
+  else
+    qWarning() << "Cannot load the default frame parser code";
+
+  // Native parser, separator mode
+  JSON::NativeParser separator;
+  QJsonObject separatorMode;
+  separatorMode.insert(QStringLiteral("mode"), QStringLiteral("separator"));
+  separatorMode.insert(QStringLiteral("separator"), QStringLiteral(","));
+  if (separator.read(separatorMode))
+  {
+    measure(QStringLiteral("NativeParser/separator"), frames.first().size(), 1,
+            [&] { (void)separator.parse(frames.first()); });
+  }
+
+  // Native parser, binary mode
+  QJsonArray fields;
+  QByteArray binaryFrame;
+  for (int i = 0; i < kChannels; ++i)
+  {
+    const float value = std::sin(i * 0.5f) * 100;
+    binaryFrame.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    fields.append(QJsonObject{{QStringLiteral("type"), "float32"}});
+  }
+
+  JSON::NativeParser binary;
+  QJsonObject binaryMode;
+  binaryMode.insert(QStringLiteral("mode"), QStringLiteral("binary"));
+  binaryMode.insert(QStringLiteral("endianness"), QStringLiteral("little"));
+  binaryMode.insert(QStringLiteral("fields"), fields);
+  if (binary.read(binaryMode))
+  {
+    measure(QStringLiteral("NativeParser/binary"), binaryFrame.size(), 1,
+            [&] { (void)binary.parse(binaryFrame); });
+  }
+}
+
+/**
+ * @brief Measures frame generation for every operation mode.
+ *
+ * The signals of the frame builder are blocked, and its operation mode & JSON
+ * layout settings are restored afterwards. The project file mode is measured
+ * with already-parsed fields, since the frame parser is measured separately
+ * by @c benchmarkFrameParser(), and uses the project that is currently loaded.
+ */
+void Misc::Benchmark::benchmarkFrameBuilder()
+{
+  // Save the frame builder settings
+  auto &builder = JSON::FrameBuilder::instance();
+  const auto mode = builder.operationMode();
+  const auto fixedLayout = builder.fixedJsonLayout();
+  const QSignalBlocker blocker(&builder);
+
+  // Generate frames
+  const auto csv = csvFrame(0);
+  const auto json = jsonFrame(0);
+
+  // Quick plot mode
+  builder.setOperationMode(SerialStudio::QuickPlot);
+  measure(QStringLiteral("FrameBuilder/QuickPlot"), csv.size(), 1,
+          [&] { builder.readData(csv); });
+
+  // JSON mode, building a new frame for each JSON document
+  builder.setOperationMode(SerialStudio::DeviceSendsJSON);
+  builder.setFixedJsonLayout(false);
+  measure(QStringLiteral("FrameBuilder/DeviceSendsJSON"), json.size(), 1,
+          [&] { builder.readData(json); });
+
+  // JSON mode, only updating the values of the current frame
+  builder.setFixedJsonLayout(true);
+  measure(QStringLiteral("FrameBuilder/DeviceSendsJSON+FixedLayout"),
+          json.size(), 1, [&] { builder.readData(json); });
+
+  // Project mode, assigning parsed fields to the project datasets
+  QList<QStringList> fields;
+  for (int i = 0; i < kBatchSize; ++i)
+    fields.append(QString::fromUtf8(csvFrame(i)).split(','));
+
+  builder.setOperationMode(SerialStudio::ProjectFile);
+  measure(QStringLiteral("FrameBuilder/ProjectFile"), 0, kBatchSize,
+          [&] { builder.readFields(fields); });
+
+  // Restore the frame builder settings
+  builder.setFixedJsonLayout(fixedLayout);
+  builder.setOperationMode(mode);
+}
+
+/**
+ * @brief Measures frame ingestion & widget updates of the dashboard.
+ */
+void Misc::Benchmark::benchmarkDashboard()
+{
+  // Generate frames with the same structure and different values
+  QVector<JSON::Frame> frames;
+  for (int i = 0; i < kBatchSize; ++i)
+    frames.append(projectFrame(i));
+
+  // Measure frame ingestion & widget updates
+  auto &dashboard = UI::Dashboard::instance();
+  measure(QStringLiteral("Dashboard/processFrame"), 0, kBatchSize, [&] {
+    for (const auto &frame : std::as_const(frames))
+      dashboard.processFrame(frame);
+  });
+  measure(QStringLiteral("Dashboard/updateWidgets"), 0, 1, [&] {
+    dashboard.m_updateRequired = true;
+    dashboard.updateWidgets();
+  });
+
+  // Discard the benchmark data
+  dashboard.resetData(false);
+}
+
+/**
+ * @brief Measures formatting & writing frames to a CSV file.
+ *
+ * The file is written to a temporary directory that is removed afterwards.
+ */
+void Misc::Benchmark::benchmarkCsvExport()
+{
+  // Create a temporary directory for the CSV file
+  QTemporaryDir dir;
+  if (!dir.isValid())
+  {
+    qWarning() << "Cannot create a temporary directory for the CSV benchmark";
+    return;
+  }
+
+  // Generate frames
+  QVector<CSV::TimestampFrame> frames;
+  const auto now = Misc::SessionClock::now();
+  for (int i = 0; i < kBatchSize; ++i)
+    frames.append({projectFrame(i), now + i * 1000000});
+
+  // Measure CSV export
+  CSV::ExportWriter writer;
+  writer.setCsvPath(dir.path());
+  measure(QStringLiteral("CSV/writeFrames"), 0, kBatchSize,
+          [&] { writer.writeFrames(frames); });
+  writer.closeFile();
+}
+
+/**
+ * @brief Measures the latency between the arrival of a batch of frames and
+ *        the presentation of the dashboard that displays them.
+ *
+ * Each iteration builds a batch of quick plot frames that arrived at the same
+ * time, feeds them to the dashboard, updates the widgets & simulates a buffer
+ * swap. The latency recorded by the end-to-end stage of the pipeline
+ * statistics is added to the report.
+ */
+void Misc::Benchmark::benchmarkEndToEnd()
+{
+  // Save the frame builder settings
+  auto &builder = JSON::FrameBuilder::instance();
+  const auto mode = builder.operationMode();
+  const QSignalBlocker blocker(&builder);
+
+  // Start from clean statistics
+  auto &stats = Misc::PipelineStats::instance();
+  stats.reset();
+
+  // Measure the complete path from the frame builder to the screen
+  const auto csv = csvFrame(0);
+  auto &dashboard = UI::Dashboard::instance();
+  builder.setOperationMode(SerialStudio::QuickPlot);
+  measure(QStringLiteral("Pipeline/EndToEnd"), csv.size() * kBatchSize,
+          kBatchSize, [&] {
+            const auto arrival = stats.timestamp();
+            for (int i = 0; i < kBatchSize; ++i)
+            {
+              builder.readData(csv, arrival);
+              dashboard.processFrame(
+                  builder.m_framePool.publish(builder.m_quickPlotFrame));
+            }
+
+            dashboard.updateWidgets();
+            dashboard.onFrameSwapped();
+          });
+
+  // Obtain the latency statistics of the end-to-end stage
+  QMetaObject::invokeMethod(&stats, "updateSnapshot", Qt::DirectConnection);
+  const auto json = stats.toJson();
+  m_latency = json.value(QStringLiteral("endToEnd")).toObject();
+
+  // Restore the frame builder settings & discard the benchmark data
+  builder.setOperationMode(mode);
+  dashboard.resetData(false);
+  stats.reset();
+}
+
+//------------------------------------------------------------------------------
+// Report generation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Generates the JSON report with the system information & the result
+ *        of each benchmark case.
+ */
+QJsonObject Misc::Benchmark::report() const
+{
+  QJsonArray benchmarks;
+  for (const auto &result : m_results)
+  {
+    const double seconds = result.elapsedNs / 1e9;
+
+    QJsonObject object;
+    object.insert(QStringLiteral("name"), result.name);
+    object.insert(QStringLiteral("iterations"), result.iterations);
+    object.insert(QStringLiteral("elapsedNs"), result.elapsedNs);
+    object.insert(QStringLiteral("nsPerIteration"),
+                  double(result.elapsedNs) / result.iterations);
+    object.insert(QStringLiteral("itemsPerSecond"),
+                  result.iterations * result.itemsPerIteration / seconds);
+    if (result.bytesPerIteration > 0)
+      object.insert(QStringLiteral("bytesPerSecond"),
+                    result.iterations * result.bytesPerIteration / seconds);
+
+    benchmarks.append(object);
+  }
+
+  QJsonObject system;
+  system.insert(QStringLiteral("os"), QSysInfo::prettyProductName());
+  system.insert(QStringLiteral("kernel"), QSysInfo::kernelVersion());
+  system.insert(QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture());
+  system.insert(QStringLiteral("threads"), QThread::idealThreadCount());
+
+  QJsonObject object;
+  object.insert(QStringLiteral("application"), APP_NAME);
+  object.insert(QStringLiteral("version"), APP_VERSION);
+  object.insert(QStringLiteral("date"),
+                QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+  object.insert(QStringLiteral("system"), system);
+  object.insert(QStringLiteral("benchmarks"), benchmarks);
+  object.insert(QStringLiteral("endToEndLatency"), m_latency);
+  return object;
+}
+
+//------------------------------------------------------------------------------
+// Synthetic data generation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Generates a comma-separated frame (without delimiters) with the
+ *        values of each channel for the given @a sample.
+ */
+QByteArray Misc::Benchmark::csvFrame(const int sample)
+{
+  QByteArray frame;
+  for (int i = 0; i < kChannels; ++i)
+  {
+    if (i > 0)
+      frame.append(',');
+
+    const auto value = std::sin(sample * 0.01 + i) * 100;
+    frame.append(QByteArray::number(value, 'f', 3));
+  }
+
+  return frame;
+}
+
+/**
+ * @brief Generates a JSON frame (without delimiters) with one group that
+ *        contains a plotted dataset for each channel.
+ */
+QByteArray Misc::Benchmark::jsonFrame(const int sample)
+{
+  const auto values = csvFrame(sample).split(',');
+
+  QJsonArray datasets;
+  for (int i = 0; i < kChannels; ++i)
+  {
+    QJsonObject dataset;
+    dataset.insert(QStringLiteral("index"), i + 1);
+    dataset.insert(QStringLiteral("graph"), true);
+    dataset.insert(QStringLiteral("units"), QStringLiteral("V"));
+    dataset.insert(QStringLiteral("title"),
+                   QStringLiteral("Channel %1").arg(i + 1));
+    dataset.insert(QStringLiteral("value"), QString::fromUtf8(values.at(i)));
+    datasets.append(dataset);
+  }
+
+  QJsonObject group;
+  group.insert(QStringLiteral("title"), QStringLiteral("Sensors"));
+  group.insert(QStringLiteral("widget"), QString());
+  group.insert(QStringLiteral("datasets"), datasets);
+
+  QJsonObject frame;
+  frame.insert(QStringLiteral("title"), QStringLiteral("Benchmark"));
+  frame.insert(QStringLiteral("groups"), QJsonArray{group});
+  return QJsonDocument(frame).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Generates a frame object from the JSON frame of the given @a sample.
+ */
+JSON::Frame Misc::Benchmark::projectFrame(const int sample)
+{
+  JSON::Frame frame;
+  (void)frame.read(QJsonDocument::fromJson(jsonFrame(sample)).object());
+  return frame;
+}
+
+/**
+ * @brief Repeats @a frame as many times as it fits in @a size bytes.
+ *
+ * Only whole frames are stored, so that every chunk of the generated data
+ * stream starts at a frame boundary.
+ */
+QByteArray Misc::Benchmark::repeat(const QByteArray &frame,
+                                   const qsizetype size)
+{
+  return frame.repeated(std::max<qsizetype>(1, size / frame.size()));
+}
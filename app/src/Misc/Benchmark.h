@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QJsonObject>
+
+#include "JSON/Frame.h"
+
+namespace Misc
+{
+/**
+ * @brief The Benchmark class
+ *
+ * Measures the throughput of each stage of the data pipeline (circular
+ * buffer, frame reader, checksums, frame parsers, frame builder, dashboard &
+ * CSV export) by feeding synthetic data to the same classes that process live device data.
+ *
+ * The benchmark is started with the @c --benchmark command line option, which
+ * runs every case without loading the user interface and writes the results
+ * as a JSON document, so that throughput regressions between releases can be
+ * detected by comparing the reports of two builds.
+ */
+class Benchmark
+{
+public:
+  Benchmark();
+
+  int run(const QString &outputPath = QString());
+
+private:
+  struct Result
+  {
+    QString name;
+    qint64 iterations;
+    qint64 elapsedNs;
+    qint64 bytesPerIteration;
+    qint64 itemsPerIteration;
+  };
+
+  template<typename Function>
+  void measure(const QString &name, const qint64 bytesPerIteration,
+               const qint64 itemsPerIteration, Function &&function);
+
+  void benchmarkCircularBuffer();
+  void benchmarkFrameReader();
+  void benchmarkChecksum();
+  void benchmarkFrameParser();
+  void benchmarkFrameBuilder();
+  void benchmarkDashboard();
+  void benchmarkCsvExport();
+  void benchmarkEndToEnd();
+
+  [[nodiscard]] QJsonObject report() const;
+  [[nodiscard]] static QByteArray csvFrame(const int sample);
+  [[nodiscard]] static QByteArray jsonFrame(const int sample);
+  [[nodiscard]] static JSON::Frame projectFrame(const int sample);
+  [[nodiscard]] static QByteArray repeat(const QByteArray &frame,
+                                         const qsizetype size);
+
+private:
+  QVector<Result> m_results;
+  QJsonObject m_latency;
+};
+} // namespace Misc
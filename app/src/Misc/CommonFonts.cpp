@@ -20,10 +20,34 @@
  * THE SOFTWARE.
  */
 
+#include <QImage>
+#include <QPainter>
+#include <QRawFont>
+#include <QQuickWindow>
 #include <QApplication>
 #include <QFontDatabase>
 
 #include "Misc/CommonFonts.h"
+#include "Misc/WorkerPool.h"
+
+/**
+ * Characters rasterized by @c Misc::CommonFonts::warmUp(): printable ASCII
+ * (which covers digits & most units), common unit symbols & the terminal
+ * cursor.
+ */
+static const QString &warmUpCharacters()
+{
+  static const QString characters = [] {
+    QString text;
+    for (char16_t c = 0x20; c < 0x7f; ++c)
+      text.append(QChar(c));
+
+    text.append(QStringLiteral("°µΩ±²³·…█"));
+    return text;
+  }();
+
+  return characters;
+}
 
 /**
  * @brief Constructs the CommonFonts object, registering common fonts and
@@ -119,3 +143,87 @@ QFont Misc::CommonFonts::customMonoFont(const qreal fraction)
   font.setPointSizeF(m_monoFont.pointSizeF() * qMax(0.1, fraction));
   return font;
 }
+
+/**
+ * @brief Loads the common fonts & rasterizes their most used glyphs.
+ *
+ * The font files are matched, opened & their glyphs rasterized by a worker
+ * thread, which keeps the expensive part of font loading (populating the font
+ * database, matching the families & reading the font files) away from the GUI
+ * and render threads.
+ */
+void Misc::CommonFonts::warmUp()
+{
+  const auto fonts = warmUpFonts();
+  Misc::WorkerPool::instance().start([fonts] {
+    for (const auto &font : fonts)
+    {
+      const auto raw = QRawFont::fromFont(font);
+      if (!raw.isValid())
+        continue;
+
+      const auto glyphs = raw.glyphIndexesForString(warmUpCharacters());
+      for (const auto glyph : glyphs)
+        (void)raw.alphaMapForGlyph(glyph);
+    }
+  });
+}
+
+/**
+ * @brief Fills the glyph cache of the render thread of the given @a window
+ *        right before its first frame is rendered.
+ *
+ * Painted items (such as the terminal) draw in the render thread, whose glyph
+ * cache would otherwise be filled while the first data frames are displayed.
+ */
+void Misc::CommonFonts::warmUpWindow(QQuickWindow *window)
+{
+  if (!window)
+    return;
+
+  const auto fonts = warmUpFonts();
+  connect(
+      window, &QQuickWindow::beforeRendering, window,
+      [fonts, window] {
+        rasterizeGlyphs(fonts, window->effectiveDevicePixelRatio());
+      },
+      static_cast<Qt::ConnectionType>(Qt::DirectConnection
+                                      | Qt::SingleShotConnection));
+}
+
+/**
+ * @brief Returns the fonts drawn right after new data arrives: the UI fonts
+ *        of the dashboard, the monospace font of the terminal (with the
+ *        antialiasing strategy that it uses) & the font of the console export.
+ */
+QList<QFont> Misc::CommonFonts::warmUpFonts() const
+{
+  auto terminalFont = m_monoFont;
+  terminalFont.setStyleStrategy(QFont::PreferAntialias);
+
+  auto consoleFont = m_monoFont;
+  consoleFont.setPointSizeF(m_monoFont.pointSizeF() * 0.8);
+
+  return {m_uiFont, m_boldUiFont, m_monoFont, terminalFont, consoleFont};
+}
+
+/**
+ * @brief Draws the warm-up characters with each of the given @a fonts into an
+ *        offscreen image with the given device pixel ratio (@a dpr), which
+ *        fills the glyph cache of the calling thread.
+ */
+void Misc::CommonFonts::rasterizeGlyphs(const QList<QFont> &fonts,
+                                        const qreal dpr)
+{
+  QImage image(QSize(1024, 32) * dpr, QImage::Format_ARGB32_Premultiplied);
+  image.setDevicePixelRatio(dpr);
+  image.fill(Qt::transparent);
+
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::TextAntialiasing);
+  for (const auto &font : fonts)
+  {
+    painter.setFont(font);
+    painter.drawText(QPointF(0, 24), warmUpCharacters());
+  }
+}
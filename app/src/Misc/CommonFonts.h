@@ -25,11 +25,20 @@
 #include <QFont>
 #include <QObject>
 
+class QQuickWindow;
+
 namespace Misc
 {
 /**
  * @class Misc::CommonFonts
  * @brief A class providing common fonts for the user interface.
+ *
+ * The fonts can be warmed up during startup with @c warmUp(): the font files
+ * are loaded & the glyphs drawn by the dashboard and the terminal (digits,
+ * units & printable ASCII) are rasterized in a worker thread. Since glyph
+ * caches belong to the thread that draws, @c warmUpWindow() draws the glyphs
+ * once more in the render thread of a window before its first frame, so
+ * that the first data frames do not stall while glyphs are rasterized.
  */
 class CommonFonts : public QObject
 {
@@ -67,6 +76,14 @@ public:
   Q_INVOKABLE QFont customUiFont(qreal fraction = 1, bool bold = false);
   Q_INVOKABLE QFont customMonoFont(qreal fraction = 1);
 
+public slots:
+  void warmUp();
+  void warmUpWindow(QQuickWindow *window);
+
+private:
+  [[nodiscard]] QList<QFont> warmUpFonts() const;
+  static void rasterizeGlyphs(const QList<QFont> &fonts, const qreal dpr);
+
 private:
   QFont m_uiFont;
   QFont m_monoFont;
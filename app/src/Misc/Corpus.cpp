@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/Corpus.h"
+
+#include <algorithm>
+
+#include <QDir>
+#include <QMap>
+#include <QFile>
+#include <QFileInfo>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+
+#include "IO/RawCapture.h"
+#include "IO/FrameReader.h"
+#include "JSON/FrameBuilder.h"
+#include "JSON/ParserEngine.h"
+
+//------------------------------------------------------------------------------
+// Replay parameters
+//------------------------------------------------------------------------------
+
+static constexpr qint64 kMinIterations = 10;
+static constexpr qint64 kMinDurationNs = 250 * 1000 * 1000;
+static constexpr qsizetype kDefaultChunkSize = 64;
+
+//------------------------------------------------------------------------------
+// Constructor function
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs the corpus replay harness.
+ */
+Misc::Corpus::Corpus() {}
+
+//------------------------------------------------------------------------------
+// Corpus execution
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Replays every corpus found in the given directory.
+ *
+ * The directory is searched recursively for @c corpus.json manifests, which
+ * are replayed in alphabetical order. The settings of the frame builder are
+ * restored afterwards.
+ *
+ * @param path Directory that contains the corpora.
+ * @param update Regenerate the expected output instead of checking it.
+ *
+ * @return @c EXIT_SUCCESS if every corpus passed, @c EXIT_FAILURE otherwise.
+ */
+int Misc::Corpus::run(const QString &path, const bool update)
+{
+  // Find the corpus manifests
+  QStringList manifests;
+  QDirIterator it(path.isEmpty() ? QDir::currentPath() : path,
+                  {QStringLiteral("corpus.json")}, QDir::Files,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext())
+    manifests.append(it.next());
+
+  std::sort(manifests.begin(), manifests.end());
+  if (manifests.isEmpty())
+  {
+    qCritical() << "No corpus manifest found in" << path;
+    return EXIT_FAILURE;
+  }
+
+  // Save the frame builder settings
+  auto &builder = JSON::FrameBuilder::instance();
+  const auto mode = builder.operationMode();
+  const auto fixedLayout = builder.fixedJsonLayout();
+  builder.setFixedJsonLayout(false);
+
+  // Replay each corpus
+  int passed = 0;
+  for (const auto &manifest : std::as_const(manifests))
+  {
+    Case corpus;
+    if (load(manifest, corpus) && check(corpus, update))
+      ++passed;
+  }
+
+  // Restore the frame builder settings
+  builder.m_frame.clear();
+  (void)builder.m_nativeParser.read(QJsonObject());
+  builder.setFixedJsonLayout(fixedLayout);
+  builder.setOperationMode(mode);
+
+  // Print a summary
+  qInfo().noquote() << QStringLiteral("%1 of %2 corpora %3")
+                           .arg(passed)
+                           .arg(manifests.count())
+                           .arg(update ? QStringLiteral("updated")
+                                       : QStringLiteral("passed"));
+
+  return passed == manifests.count() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Reads the manifest, project & input data of a corpus.
+ *
+ * Paths in the manifest are relative to the directory of the manifest.
+ *
+ * @param manifestPath Location of the @c corpus.json file.
+ * @param corpus Corpus description to fill.
+ *
+ * @return @c true on success, @c false if any of the files is invalid.
+ */
+bool Misc::Corpus::load(const QString &manifestPath, Case &corpus) const
+{
+  // Read the manifest
+  QFile file(manifestPath);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    qCritical() << "Cannot open corpus manifest" << manifestPath;
+    return false;
+  }
+
+  QJsonParseError error;
+  const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+  if (error.error != QJsonParseError::NoError || !document.isObject())
+  {
+    qCritical() << "Invalid corpus manifest" << manifestPath
+                << error.errorString();
+    return false;
+  }
+
+  // Obtain the corpus name & the operation mode
+  const auto json = document.object();
+  const QDir dir = QFileInfo(manifestPath).absoluteDir();
+  corpus.name = json.value(QStringLiteral("name")).toString(dir.dirName());
+  const auto mode = json.value(QStringLiteral("operationMode")).toString();
+  if (mode == QStringLiteral("project"))
+    corpus.mode = SerialStudio::ProjectFile;
+  else if (mode == QStringLiteral("json"))
+    corpus.mode = SerialStudio::DeviceSendsJSON;
+  else if (mode == QStringLiteral("quickPlot"))
+    corpus.mode = SerialStudio::QuickPlot;
+  else
+  {
+    qCritical() << corpus.name << "has an invalid operation mode" << mode;
+    return false;
+  }
+
+  // Set the frame detection settings used by the device sends JSON mode
+  corpus.frameStart = QStringLiteral("/*");
+  corpus.frameEnd = QStringLiteral("*/");
+  corpus.decoder = SerialStudio::PlainText;
+  corpus.detection = SerialStudio::StartAndEndDelimiter;
+
+  // Read the project file & its frame detection settings
+  if (corpus.mode == SerialStudio::ProjectFile)
+  {
+    const auto projectPath = json.value(QStringLiteral("project")).toString();
+    QFile project(dir.absoluteFilePath(projectPath));
+    if (!project.open(QIODevice::ReadOnly))
+    {
+      qCritical() << corpus.name << "cannot open project" << projectPath;
+      return false;
+    }
+
+    corpus.project = QJsonDocument::fromJson(project.readAll()).object();
+    if (corpus.project.isEmpty())
+    {
+      qCritical() << corpus.name << "has an invalid project" << projectPath;
+      return false;
+    }
+
+    // Projects without a detection mode use start & end delimiters
+    const auto &p = corpus.project;
+    corpus.frameEnd = escapeSequences(p.value("frameEnd").toString());
+    corpus.frameStart = escapeSequences(p.value("frameStart").toString());
+    corpus.decoder = static_cast<SerialStudio::DecoderMethod>(
+        p.value(QStringLiteral("decoder")).toInt());
+    if (p.contains(QStringLiteral("frameDetection")))
+      corpus.detection = static_cast<SerialStudio::FrameDetection>(
+          p.value(QStringLiteral("frameDetection")).toInt());
+  }
+
+  // Read the input data
+  const auto inputPath = json.value(QStringLiteral("input")).toString();
+  QFile input(dir.absoluteFilePath(inputPath));
+  if (!input.open(QIODevice::ReadOnly))
+  {
+    qCritical() << corpus.name << "cannot open input" << inputPath;
+    return false;
+  }
+
+  const auto data = input.readAll();
+
+  // Raw captures are replayed with their original chunk boundaries
+  if (inputPath.endsWith(QStringLiteral(".ssraw")))
+  {
+    QVector<IO::RawCapture::Chunk> chunks;
+    const auto *ptr = reinterpret_cast<const uchar *>(data.constData());
+    if (!IO::RawCapture::readChunks(ptr, data.size(), chunks))
+    {
+      qCritical() << corpus.name << "has an invalid raw capture" << inputPath;
+      return false;
+    }
+
+    for (const auto &chunk : std::as_const(chunks))
+      corpus.chunks.append(data.mid(chunk.offset, chunk.size));
+  }
+
+  // Other files are split in chunks of a fixed size
+  else
+  {
+    auto size = json.value(QStringLiteral("chunkSize")).toInteger();
+    if (size <= 0)
+      size = kDefaultChunkSize;
+
+    for (qsizetype i = 0; i < data.size(); i += size)
+      corpus.chunks.append(data.mid(i, size));
+  }
+
+  // Obtain the location of the expected output
+  corpus.expectedPath = dir.absoluteFilePath(
+      json.value(QStringLiteral("expected"))
+          .toString(QStringLiteral("expected.csv")));
+
+  return true;
+}
+
+/**
+ * @brief Replays a corpus, compares the generated frames with the expected
+ *        output & measures the replay throughput.
+ *
+ * The first mismatch is reported through the Qt message handler. In update
+ * mode, the generated frames are written to the expected output file and the
+ * throughput is not measured.
+ *
+ * @param corpus Corpus to replay.
+ * @param update Regenerate the expected output instead of checking it.
+ *
+ * @return @c true if the corpus passed (or was updated), @c false otherwise.
+ */
+bool Misc::Corpus::check(const Case &corpus, const bool update) const
+{
+  // Configure the frame builder with the corpus project
+  auto &builder = JSON::FrameBuilder::instance();
+  builder.setOperationMode(corpus.mode);
+  builder.m_frame.clear();
+  if (corpus.mode == SerialStudio::ProjectFile
+      && !builder.m_frame.read(corpus.project))
+  {
+    qCritical() << corpus.name << "has an invalid project frame";
+    return false;
+  }
+
+  // Invalid native parsers fall back to the JavaScript frame parser
+  const auto parser = corpus.project.value(QStringLiteral("nativeParser"));
+  if (!builder.m_nativeParser.read(parser.toObject()))
+    qWarning() << corpus.name << builder.m_nativeParser.errorString();
+
+  // Map the parsed fields to the datasets of the project
+  if (corpus.mode == SerialStudio::ProjectFile)
+    (void)builder.buildDatasetMap();
+
+  // Load the JavaScript frame parser of the project
+  JSON::ParserEngine engine;
+  const auto code = corpus.project.value(QStringLiteral("frameParser"));
+  if (corpus.mode == SerialStudio::ProjectFile
+      && !builder.m_nativeParser.isEnabled()
+      && !engine.loadScript(code.toString()))
+  {
+    qCritical() << corpus.name << "has an invalid frame parser";
+    return false;
+  }
+
+  // Parsed frames are handed to the frame builder in the calling thread
+  QObject::connect(&engine, &JSON::ParserEngine::framesParsed, &engine,
+                   [&builder](const QList<QStringList> &results) {
+                     builder.readFields(results);
+                   });
+
+  // Replay the corpus & capture the generated frames
+  QStringList output;
+  const auto frames = replay(corpus, engine, &output);
+
+  // Write the expected output
+  if (update)
+  {
+    QFile file(corpus.expectedPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      qCritical() << corpus.name << "cannot write" << corpus.expectedPath;
+      return false;
+    }
+
+    for (const auto &line : std::as_const(output))
+      file.write(line.toUtf8() + '\n');
+
+    qInfo().noquote() << QStringLiteral("%1: %2 frames written to %3")
+                             .arg(corpus.name, -24)
+                             .arg(frames)
+                             .arg(corpus.expectedPath);
+    return true;
+  }
+
+  // Read the expected output
+  QFile file(corpus.expectedPath);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    qCritical() << corpus.name << "cannot open" << corpus.expectedPath;
+    return false;
+  }
+
+  auto expected = QString::fromUtf8(file.readAll()).split('\n');
+  if (!expected.isEmpty() && expected.last().isEmpty())
+    expected.removeLast();
+
+  // Report the first frame that differs from the expected output
+  const auto count = std::max(expected.count(), output.count());
+  for (qsizetype i = 0; i < count; ++i)
+  {
+    const auto want = expected.value(i, QStringLiteral("<no frame>"));
+    const auto got = output.value(i, QStringLiteral("<no frame>"));
+    if (want != got)
+    {
+      qCritical().noquote() << QStringLiteral("%1: FAIL at frame %2")
+                                   .arg(corpus.name)
+                                   .arg(i + 1);
+      qCritical().noquote() << "  expected:" << want;
+      qCritical().noquote() << "  actual:  " << got;
+      return false;
+    }
+  }
+
+  // Replay the corpus at maximum speed
+  QElapsedTimer timer;
+  qint64 iterations = 0;
+  timer.start();
+  do
+  {
+    (void)replay(corpus, engine);
+    ++iterations;
+  } while (iterations < kMinIterations
+           || timer.nsecsElapsed() < kMinDurationNs);
+
+  // Print a summary of the result
+  const double seconds = timer.nsecsElapsed() / 1e9;
+  qInfo().noquote() << QStringLiteral("%1: PASS, %2 frames, %3 frames/s")
+                           .arg(corpus.name, -24)
+                           .arg(frames)
+                           .arg(iterations * frames / seconds, 0, 'f', 0);
+  return true;
+}
+
+/**
+ * @brief Feeds the input of a corpus to a new frame reader, and the detected
+ *        frames to the frame builder.
+ *
+ * The frames detected in each chunk are parsed in a single batch, in the same
+ * way as the frame builder queues the frames that arrive while the parser is
+ * busy.
+ *
+ * @param corpus Corpus to replay.
+ * @param engine JavaScript parser loaded with the project's frame parser.
+ * @param output Optional list where the generated frames are written.
+ *
+ * @return Number of frames generated by the frame builder.
+ */
+qint64 Misc::Corpus::replay(const Case &corpus, JSON::ParserEngine &engine,
+                            QStringList *output) const
+{
+  // Configure the frame reader
+  IO::FrameReader reader;
+  reader.setOperationMode(corpus.mode);
+  reader.setFrameDetectionMode(corpus.detection);
+  reader.setStartSequence(corpus.frameStart);
+  reader.setFinishSequence(corpus.frameEnd);
+
+  // Count & capture the frames generated by the frame builder
+  qint64 frames = 0;
+  auto &builder = JSON::FrameBuilder::instance();
+  const auto capture = QObject::connect(
+      &builder, &JSON::FrameBuilder::frameChanged,
+      [&frames, output](const JSON::Frame &frame) {
+        ++frames;
+        if (output)
+          output->append(formatFrame(frame));
+      });
+
+  // Hand the detected frames to the frame builder or the frame parser
+  qint64 detected = 0;
+  QList<QByteArray> pending;
+  const auto &native = builder.m_nativeParser;
+  const bool project = corpus.mode == SerialStudio::ProjectFile;
+  const auto handleFrame = [&](const QByteArray &frame) {
+    ++detected;
+    if (!project)
+      builder.readData(frame);
+    else if (!native.isEnabled())
+      pending.append(frame);
+    else if (native.isBinary() || corpus.decoder == SerialStudio::Binary)
+      builder.readFields({native.parse(frame)});
+    else
+      builder.readFields({native.parse(
+          JSON::ParserEngine::decodeFrame(frame, corpus.decoder))});
+  };
+
+  QObject::connect(&reader, &IO::FrameReader::framesReady, &reader,
+                   [&](const IO::FrameBatch &frames) {
+                     for (const auto &frame : frames)
+                       handleFrame(frame.data);
+                   });
+
+  // Feed the input, reading frames until the buffer has no complete frame
+  for (const auto &chunk : std::as_const(corpus.chunks))
+  {
+    reader.m_dataBuffer.append(chunk);
+
+    qint64 previous = 0;
+    do
+    {
+      previous = detected;
+      reader.extractFrames();
+    } while (detected != previous);
+
+    if (!pending.isEmpty())
+    {
+      engine.parseFrames(pending, corpus.decoder);
+      pending.clear();
+    }
+  }
+
+  QObject::disconnect(capture);
+  return frames;
+}
+
+//------------------------------------------------------------------------------
+// Utility functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Formats the dataset values of a frame as a CSV line.
+ *
+ * Values are sorted by dataset index, and datasets that share an index (e.g.
+ * the multiplot group of the quick plot mode) are written once. Values that
+ * contain commas or quotes are quoted.
+ */
+QString Misc::Corpus::formatFrame(const JSON::Frame &frame)
+{
+  // Obtain the value of each dataset index
+  QMap<int, QString> values;
+  for (const auto &group : frame.groups())
+  {
+    for (const auto &dataset : group.datasets())
+    {
+      if (!values.contains(dataset.index()))
+        values.insert(dataset.index(), dataset.value());
+    }
+  }
+
+  // Generate the CSV line
+  QStringList fields;
+  for (auto value : std::as_const(values))
+  {
+    if (value.contains(',') || value.contains('"') || value.contains('\n'))
+      value = '"' + value.replace('"', QStringLiteral("\"\"")) + '"';
+
+    fields.append(value);
+  }
+
+  return fields.join(',');
+}
+
+/**
+ * @brief Replaces the escape sequences of a frame delimiter (e.g. "\\n") with
+ *        the characters that they represent, as done by the I/O manager.
+ */
+QString Misc::Corpus::escapeSequences(const QString &sequence)
+{
+  auto str = sequence;
+  str.replace(QStringLiteral("\\a"), QStringLiteral("\a"));
+  str.replace(QStringLiteral("\\b"), QStringLiteral("\b"));
+  str.replace(QStringLiteral("\\f"), QStringLiteral("\f"));
+  str.replace(QStringLiteral("\\n"), QStringLiteral("\n"));
+  str.replace(QStringLiteral("\\r"), QStringLiteral("\r"));
+  str.replace(QStringLiteral("\\t"), QStringLiteral("\t"));
+  str.replace(QStringLiteral("\\v"), QStringLiteral("\v"));
+  return str;
+}
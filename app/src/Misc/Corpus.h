@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QStringList>
+
+#include "SerialStudio.h"
+#include "JSON/Frame.h"
+
+namespace JSON
+{
+class ParserEngine;
+}
+
+namespace Misc
+{
+/**
+ * @brief The Corpus class
+ *
+ * Replays regression corpora through the frame reader & frame builder, checks
+ * that the generated frames match the expected output, and measures how many
+ * frames per second are processed when the data is fed at maximum speed.
+ *
+ * Each corpus is a directory with a @c corpus.json manifest:
+ *
+ * @code
+ * {
+ *   "name": "MPU6050",
+ *   "operationMode": "project",
+ *   "project": "../MPU6050.json",
+ *   "input": "input.txt",
+ *   "chunkSize": 64,
+ *   "expected": "expected.csv"
+ * }
+ * @endcode
+ *
+ * - @c operationMode is @c project, @c json or @c quickPlot.
+ * - @c project is only required by the project mode.
+ * - @c input contains the raw bytes sent by the device, or a raw capture
+ *   (@c *.ssraw) recorded by Serial Studio, which is replayed with its
+ *   original chunk boundaries.
+ * - @c chunkSize is the number of bytes handed to the frame reader at once,
+ *   so that frames split across several reads are also tested.
+ * - @c expected has one line per frame with the values of the frame
+ *   datasets, sorted by dataset index (datasets that share an index are
+ *   written once).
+ *
+ * The replay is started with the @c --corpus command line option, which
+ * searches the given directory recursively for manifests. The
+ * @c --corpus-update option regenerates the expected output of every corpus
+ * instead of checking it.
+ */
+class Corpus
+{
+public:
+  Corpus();
+
+  int run(const QString &path, const bool update = false);
+
+private:
+  struct Case
+  {
+    QString name;
+    QString frameEnd;
+    QString frameStart;
+    QString expectedPath;
+    QJsonObject project;
+    QList<QByteArray> chunks;
+    SerialStudio::OperationMode mode;
+    SerialStudio::DecoderMethod decoder;
+    SerialStudio::FrameDetection detection;
+  };
+
+  [[nodiscard]] bool load(const QString &manifestPath, Case &corpus) const;
+  [[nodiscard]] bool check(const Case &corpus, const bool update) const;
+  [[nodiscard]] qint64 replay(const Case &corpus, JSON::ParserEngine &engine,
+                              QStringList *output = nullptr) const;
+
+  [[nodiscard]] static QString formatFrame(const JSON::Frame &frame);
+  [[nodiscard]] static QString escapeSequences(const QString &sequence);
+};
+} // namespace Misc
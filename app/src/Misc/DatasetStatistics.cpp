@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/DatasetStatistics.h"
+
+#include <cmath>
+
+#include <QJsonObject>
+
+#include "CSV/Player.h"
+#include "IO/Manager.h"
+#include "SIMD/SIMD.h"
+#include "JSON/FrameBuilder.h"
+#include "Misc/PipelineStats.h"
+
+/**
+ * Default, smallest & largest number of frames in the sliding window.
+ */
+static constexpr int kDefaultWindowSize = 1000;
+static constexpr int kMinWindowSize = 2;
+static constexpr int kMaxWindowSize = 100000;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, restores the size of the sliding window.
+ */
+Misc::DatasetStatistics::DatasetStatistics()
+  : m_windowSize(kDefaultWindowSize)
+  , m_generation(0)
+  , m_position(0)
+  , m_filled(0)
+{
+  m_windowSize = qBound(
+      kMinWindowSize,
+      m_settings.value("dataset_statistics_window", kDefaultWindowSize).toInt(),
+      kMaxWindowSize);
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::DatasetStatistics &Misc::DatasetStatistics::instance()
+{
+  static DatasetStatistics singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// Member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the number of frames in the sliding window of the statistics.
+ */
+int Misc::DatasetStatistics::windowSize() const
+{
+  return m_windowSize;
+}
+
+/**
+ * @brief Returns the statistics of the dataset with the given frame @a index.
+ *
+ * The standard deviation is the sample standard deviation of the window, the
+ * rate is the number of value updates per second. An empty summary is
+ * returned for unknown datasets.
+ */
+Misc::DatasetStatistics::Summary
+Misc::DatasetStatistics::summary(const int index) const
+{
+  Summary summary;
+  const auto channel = m_channels.value(index, -1);
+  if (channel < 0 || m_filled < 1)
+    return summary;
+
+  // Obtain the moments of the window
+  const auto n = static_cast<double>(m_filled);
+  const auto m2 = qMax(0.0, m_m2[channel]);
+  summary.count = m_filled;
+  summary.mean = m_mean[channel];
+  summary.min = m_min[channel];
+  summary.max = m_max[channel];
+  summary.rms = std::sqrt(m2 / n + summary.mean * summary.mean);
+  if (m_filled > 1)
+    summary.stddev = std::sqrt(m2 / (n - 1));
+
+  // Obtain the update rate from the time covered by the window
+  const auto size = m_timeline.count();
+  const auto oldest = m_filled < size ? 0 : m_position;
+  const auto newest = (m_position + size - 1) % size;
+  const auto span = m_timeline[newest] - m_timeline[oldest];
+  if (span > 0)
+    summary.rate = m_changes[channel] * 1e9 / span;
+
+  return summary;
+}
+
+/**
+ * @brief Returns the statistics of every dataset for the plugins.
+ *
+ * Each item contains the frame @c index & @c title of the dataset, the number
+ * of samples in the window (@c count) and the @c mean, @c rms, @c stddev,
+ * @c min, @c max and @c rate values.
+ */
+QJsonArray Misc::DatasetStatistics::toJson() const
+{
+  QJsonArray array;
+  for (const auto &source : m_sources)
+  {
+    const auto s = summary(source.index);
+
+    QJsonObject object;
+    object.insert(QStringLiteral("index"), source.index);
+    object.insert(QStringLiteral("title"), source.title);
+    object.insert(QStringLiteral("count"), s.count);
+    object.insert(QStringLiteral("mean"), s.mean);
+    object.insert(QStringLiteral("rms"), s.rms);
+    object.insert(QStringLiteral("stddev"), s.stddev);
+    object.insert(QStringLiteral("min"), s.min);
+    object.insert(QStringLiteral("max"), s.max);
+    object.insert(QStringLiteral("rate"), s.rate);
+    array.append(object);
+  }
+
+  return array;
+}
+
+//------------------------------------------------------------------------------
+// Public slots
+//------------------------------------------------------------------------------
+
+/**
+ * Discards the statistics of every dataset, the window is rebuilt with the
+ * next frame.
+ */
+void Misc::DatasetStatistics::reset()
+{
+  m_generation = 0;
+  m_position = 0;
+  m_filled = 0;
+
+  m_sources.clear();
+  m_channels.clear();
+  m_input.clear();
+  m_evicted.clear();
+  m_mean.clear();
+  m_m2.clear();
+  m_min.clear();
+  m_max.clear();
+  m_changes.clear();
+  m_generations.clear();
+  m_window.clear();
+  m_changed.clear();
+  m_timeline.clear();
+
+  m_window.squeeze();
+  m_changed.squeeze();
+}
+
+/**
+ * Receives the frames of the frame builder & resets the statistics when a
+ * device is connected or a CSV file is opened.
+ */
+void Misc::DatasetStatistics::setupExternalConnections()
+{
+  // clang-format off
+  connect(&CSV::Player::instance(), &CSV::Player::openChanged, this, [=] { reset(); });
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this, [=] { reset(); });
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::jsonFileMapChanged, this, [=] { reset(); });
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged, this, &Misc::DatasetStatistics::processFrame, Qt::QueuedConnection);
+  // clang-format on
+}
+
+/**
+ * Changes the number of frames in the sliding window, the statistics are
+ * restarted with the new window.
+ */
+void Misc::DatasetStatistics::setWindowSize(const int samples)
+{
+  const auto size = qBound(kMinWindowSize, samples, kMaxWindowSize);
+  if (m_windowSize != size)
+  {
+    m_windowSize = size;
+    m_settings.setValue("dataset_statistics_window", size);
+    reset();
+
+    Q_EMIT windowSizeChanged();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Statistics update
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Adds the dataset values of the given @a frame to the statistics.
+ *
+ * The values are gathered into a contiguous array, swapped with the oldest
+ * samples of the window & added to the running moments of all the datasets
+ * at once. Text datasets keep their last numeric value.
+ */
+void Misc::DatasetStatistics::processFrame(const JSON::Frame &frame)
+{
+  // Validate frame & rebuild the window when the layout changes
+  if (!frame.isValid())
+    return;
+
+  if (frame.generation() != m_generation)
+  {
+    if (!sameLayout(frame))
+      initialize(frame);
+
+    m_generation = frame.generation();
+  }
+
+  // Nothing to do if the frame has no datasets
+  const auto channels = m_sources.count();
+  if (channels == 0)
+    return;
+
+  // Swap the new values with the oldest samples of the window
+  const auto size = static_cast<qsizetype>(m_windowSize);
+  const bool full = m_filled == size;
+  const auto &groups = frame.groups();
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    const auto &source = m_sources[c];
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    if (dataset.isNumeric())
+      m_input[c] = dataset.numericValue();
+
+    const auto slot = c * size + m_position;
+    m_evicted[c] = m_window[slot];
+    m_window[slot] = m_input[c];
+
+    const quint8 changed = dataset.valueGeneration() != m_generations[c];
+    m_generations[c] = dataset.valueGeneration();
+    m_changes[c] += changed - (full ? m_changed[slot] : 0);
+    m_changed[slot] = changed;
+  }
+
+  // Update the running means & variances of every dataset
+  const auto count = full ? size : m_filled + 1;
+  if (full)
+    SIMD::welfordReplace(m_mean.data(), m_m2.data(), m_input.constData(),
+                         m_evicted.constData(), channels, count);
+  else
+    SIMD::welfordAdd(m_mean.data(), m_m2.data(), m_input.constData(),
+                     channels, count);
+
+  // Update the extremes, search the window when an extreme leaves it
+  for (qsizetype c = 0; c < channels; ++c)
+  {
+    const auto x = m_input[c];
+    if (count == 1)
+    {
+      m_min[c] = x;
+      m_max[c] = x;
+    }
+
+    else if (full && (m_evicted[c] <= m_min[c] || m_evicted[c] >= m_max[c]))
+    {
+      const auto *samples = m_window.constData() + c * size;
+      m_min[c] = SIMD::findMin(samples, size);
+      m_max[c] = SIMD::findMax(samples, size);
+    }
+
+    else
+    {
+      m_min[c] = qMin(m_min[c], x);
+      m_max[c] = qMax(m_max[c], x);
+    }
+  }
+
+  // Register the reception time of the frame
+  auto timestamp = frame.timestamp();
+  if (timestamp <= 0)
+    timestamp = Misc::PipelineStats::timestamp();
+
+  m_timeline[m_position] = timestamp;
+  m_position = (m_position + 1) % size;
+  m_filled = count;
+}
+
+/**
+ * Returns @c true if the datasets of the given @a frame are at the same
+ * locations & have the same frame indexes as the current sources.
+ */
+bool Misc::DatasetStatistics::sameLayout(const JSON::Frame &frame) const
+{
+  if (m_sources.isEmpty())
+    return false;
+
+  const auto &groups = frame.groups();
+  for (const auto &source : m_sources)
+  {
+    if (source.group >= groups.count())
+      return false;
+
+    const auto &datasets = groups[source.group].datasets();
+    if (source.dataset >= datasets.count()
+        || datasets[source.dataset].index() != source.index)
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Registers the datasets of the given @a frame & allocates the windows of
+ * the statistics, datasets that share a frame index are only counted once.
+ */
+void Misc::DatasetStatistics::initialize(const JSON::Frame &frame)
+{
+  reset();
+
+  // Register each dataset once
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &datasets = groups[g].datasets();
+    for (int d = 0; d < datasets.count(); ++d)
+    {
+      const auto index = datasets[d].index();
+      if (m_channels.contains(index))
+        continue;
+
+      m_channels.insert(index, m_sources.count());
+      m_sources.append({g, d, index, datasets[d].title()});
+    }
+  }
+
+  // Allocate the state of each dataset
+  const auto channels = m_sources.count();
+  m_input.fill(0, channels);
+  m_evicted.fill(0, channels);
+  m_mean.fill(0, channels);
+  m_m2.fill(0, channels);
+  m_min.fill(0, channels);
+  m_max.fill(0, channels);
+  m_changes.fill(0, channels);
+  m_generations.fill(0, channels);
+
+  // Allocate the sliding windows
+  m_window.fill(0, channels * m_windowSize);
+  m_changed.fill(0, channels * m_windowSize);
+  m_timeline.fill(0, m_windowSize);
+}
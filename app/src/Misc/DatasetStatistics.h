@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include <QSettings>
+#include <QJsonArray>
+
+#include "JSON/Frame.h"
+
+namespace Misc
+{
+/**
+ * @brief The DatasetStatistics class
+ *
+ * Keeps live statistics of every dataset of the received frames over a
+ * sliding window of the last @c windowSize() frames: the mean, the RMS value,
+ * the standard deviation, the minimum & maximum values and the rate at which
+ * the value of the dataset is updated.
+ *
+ * The statistics are updated for every frame emitted by the
+ * @c JSON::FrameBuilder. The state of all the datasets is kept in structures
+ * of arrays, so that the running means & variances (Welford's algorithm) of
+ * every dataset are updated together with SIMD instructions, at a constant
+ * cost per sample. The window of each dataset is a ring buffer, the minimum &
+ * maximum values are only searched again when the sample that leaves the
+ * window was one of them.
+ *
+ * Datasets are identified by their frame index, the statistics are displayed
+ * by the data grid widgets and sent to the plugins with the pipeline
+ * statistics.
+ */
+class DatasetStatistics : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int windowSize
+             READ windowSize
+             WRITE setWindowSize
+             NOTIFY windowSizeChanged)
+  // clang-format on
+
+signals:
+  void windowSizeChanged();
+
+private:
+  explicit DatasetStatistics();
+  DatasetStatistics(DatasetStatistics &&) = delete;
+  DatasetStatistics(const DatasetStatistics &) = delete;
+  DatasetStatistics &operator=(DatasetStatistics &&) = delete;
+  DatasetStatistics &operator=(const DatasetStatistics &) = delete;
+
+public:
+  /**
+   * @brief Statistics of a dataset over the current window.
+   */
+  struct Summary
+  {
+    qsizetype count = 0;
+    double mean = 0;
+    double rms = 0;
+    double stddev = 0;
+    double min = 0;
+    double max = 0;
+    double rate = 0;
+  };
+
+  static DatasetStatistics &instance();
+
+  [[nodiscard]] int windowSize() const;
+  [[nodiscard]] Summary summary(const int index) const;
+  [[nodiscard]] QJsonArray toJson() const;
+
+public slots:
+  void reset();
+  void setupExternalConnections();
+  void setWindowSize(const int samples);
+
+private slots:
+  void processFrame(const JSON::Frame &frame);
+
+private:
+  [[nodiscard]] bool sameLayout(const JSON::Frame &frame) const;
+  void initialize(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Location of a dataset in the source frame.
+   */
+  struct Source
+  {
+    int group;
+    int dataset;
+    int index;
+    QString title;
+  };
+
+  int m_windowSize;
+  QSettings m_settings;
+
+  quint64 m_generation;
+  qsizetype m_position;
+  qsizetype m_filled;
+
+  QVector<Source> m_sources;
+  QHash<int, qsizetype> m_channels;
+
+  QVector<double> m_input;
+  QVector<double> m_evicted;
+  QVector<double> m_mean;
+  QVector<double> m_m2;
+  QVector<double> m_min;
+  QVector<double> m_max;
+  QVector<qint32> m_changes;
+  QVector<quint64> m_generations;
+
+  QVector<double> m_window;
+  QVector<quint8> m_changed;
+  QVector<qint64> m_timeline;
+};
+} // namespace Misc
@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <iterator>
+
+#include <QDebug>
+#include <QThread>
+#include <QQuickWindow>
+#include <QApplication>
+#include <QSGRendererInterface>
+
+#include "Misc/SessionClock.h"
+#include "Misc/Translator.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/GraphicsBackend.h"
+
+/**
+ * Settings & command line names of each graphics API and render loop, in the
+ * order of the @c GraphicsApi and @c RenderLoop enums
+ */
+static constexpr const char *kApiKeys[] = {"auto",  "opengl", "vulkan",
+                                           "metal", "d3d11",  "d3d12"};
+static constexpr const char *kLoopKeys[] = {"auto", "basic", "threaded"};
+
+/**
+ * Number of frame-time samples kept for the graph, published at 10 Hz
+ */
+static constexpr int kHistorySize = 100;
+
+/**
+ * Graphics API & render loop used by the running application, set by
+ * @c GraphicsBackend::configure() before the user interface is created
+ */
+static auto s_startupApi = Misc::GraphicsBackend::GraphicsApi::Automatic;
+static auto s_startupLoop = Misc::GraphicsBackend::RenderLoop::Automatic;
+
+/**
+ * Returns the graphics APIs that Qt Quick can use on this platform
+ */
+static QList<Misc::GraphicsBackend::GraphicsApi> availableApis()
+{
+  using Api = Misc::GraphicsBackend::GraphicsApi;
+
+  QList<Api> apis = {Api::Automatic, Api::OpenGL};
+#if QT_CONFIG(vulkan)
+  apis.append(Api::Vulkan);
+#endif
+#if defined(Q_OS_MACOS) || defined(Q_OS_IOS)
+  apis.append(Api::Metal);
+#endif
+#ifdef Q_OS_WIN
+  apis.append(Api::Direct3D11);
+  apis.append(Api::Direct3D12);
+#endif
+
+  return apis;
+}
+
+/**
+ * Returns the graphics API with the given settings @a key, or the automatic
+ * selection if the key is unknown or the API is not available
+ */
+static Misc::GraphicsBackend::GraphicsApi apiFromKey(const QString &key)
+{
+  using Api = Misc::GraphicsBackend::GraphicsApi;
+
+  for (const auto api : availableApis())
+  {
+    if (key == QLatin1String(kApiKeys[static_cast<int>(api)]))
+      return api;
+  }
+
+  return Api::Automatic;
+}
+
+/**
+ * Returns the render loop with the given settings @a key, or the automatic
+ * selection if the key is unknown
+ */
+static Misc::GraphicsBackend::RenderLoop loopFromKey(const QString &key)
+{
+  using Loop = Misc::GraphicsBackend::RenderLoop;
+
+  for (int i = 0; i < static_cast<int>(std::size(kLoopKeys)); ++i)
+  {
+    if (key == QLatin1String(kLoopKeys[i]))
+      return static_cast<Loop>(i);
+  }
+
+  return Loop::Automatic;
+}
+
+/**
+ * Returns the scene graph identifier of the given graphics @a api
+ */
+static QSGRendererInterface::GraphicsApi
+sceneGraphApi(const Misc::GraphicsBackend::GraphicsApi api)
+{
+  using Api = Misc::GraphicsBackend::GraphicsApi;
+
+  switch (api)
+  {
+    case Api::OpenGL:
+      return QSGRendererInterface::OpenGL;
+    case Api::Vulkan:
+      return QSGRendererInterface::Vulkan;
+    case Api::Metal:
+      return QSGRendererInterface::Metal;
+    case Api::Direct3D11:
+      return QSGRendererInterface::Direct3D11;
+    case Api::Direct3D12:
+      return QSGRendererInterface::Direct3D12;
+    default:
+      return QSGRendererInterface::Unknown;
+  }
+}
+
+/**
+ * Constructor function, reads the graphics settings
+ */
+Misc::GraphicsBackend::GraphicsBackend()
+  : m_apis(availableApis())
+  , m_threaded(false)
+  , m_frameStart(0)
+  , m_lastSwap(0)
+  , m_intervalSum(0)
+  , m_intervalCount(0)
+  , m_renderSum(0)
+  , m_renderCount(0)
+{
+  m_graphicsApi = apiFromKey(m_settings.value("graphics_api").toString());
+  m_renderLoop = loopFromKey(m_settings.value("render_loop").toString());
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::GraphicsBackend &Misc::GraphicsBackend::instance()
+{
+  static GraphicsBackend singleton;
+  return singleton;
+}
+
+/**
+ * Selects the graphics API & the render loop of Qt Quick, must be called
+ * before the application object is created.
+ *
+ * The values saved in the application settings are used, unless they are
+ * overridden with the @c --graphics-api or @c --render-loop options, which
+ * accept the names in @c kApiKeys and @c kLoopKeys. The environment variables
+ * of Qt have priority over both.
+ *
+ * If the low-power mode of @c Misc::TimerEvents is enabled and no render loop
+ * was selected, the basic render loop is used, which does not keep a render
+ * thread per window & only renders when the scene changes.
+ *
+ * @param argc Argument count from @c main().
+ * @param argv Argument data from @c main().
+ */
+void Misc::GraphicsBackend::configure(int argc, char **argv)
+{
+  // Read the saved options
+  QSettings settings;
+  auto api = apiFromKey(settings.value("graphics_api").toString());
+  auto loop = loopFromKey(settings.value("render_loop").toString());
+
+  // Read the command line options
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    const auto value = QString::fromLocal8Bit(argv[i + 1]);
+    if (qstrcmp(argv[i], "--graphics-api") == 0)
+    {
+      api = apiFromKey(value);
+      if (api == GraphicsApi::Automatic && value != QLatin1String(kApiKeys[0]))
+        qWarning() << "Graphics API not available:" << value;
+    }
+
+    else if (qstrcmp(argv[i], "--render-loop") == 0)
+    {
+      loop = loopFromKey(value);
+      if (loop == RenderLoop::Automatic && value != QLatin1String(kLoopKeys[0]))
+        qWarning() << "Unknown render loop:" << value;
+    }
+  }
+
+  // Apply the graphics API
+  s_startupApi = api;
+  if (api != GraphicsApi::Automatic
+      && qEnvironmentVariableIsEmpty("QSG_RHI_BACKEND"))
+    QQuickWindow::setGraphicsApi(sceneGraphApi(api));
+
+  // Use the basic render loop in low-power mode
+  s_startupLoop = loop;
+  if (loop == RenderLoop::Automatic
+      && settings.value("low_power_mode", false).toBool())
+    loop = RenderLoop::Basic;
+
+  // Apply the render loop
+  if (loop != RenderLoop::Automatic
+      && qEnvironmentVariableIsEmpty("QSG_RENDER_LOOP"))
+    qputenv("QSG_RENDER_LOOP", kLoopKeys[static_cast<int>(loop)]);
+}
+
+/**
+ * Returns the index of the selected graphics API in @c graphicsApis()
+ */
+int Misc::GraphicsBackend::graphicsApi() const
+{
+  return qMax(0, m_apis.indexOf(m_graphicsApi));
+}
+
+/**
+ * Returns the index of the selected render loop in @c renderLoops()
+ */
+int Misc::GraphicsBackend::renderLoop() const
+{
+  return static_cast<int>(m_renderLoop);
+}
+
+/**
+ * Returns the names of the graphics APIs available on this platform
+ */
+QStringList Misc::GraphicsBackend::graphicsApis() const
+{
+  QStringList list;
+  for (const auto api : m_apis)
+  {
+    switch (api)
+    {
+      case GraphicsApi::Automatic:
+        list.append(tr("Automatic"));
+        break;
+      case GraphicsApi::OpenGL:
+        list.append(QStringLiteral("OpenGL"));
+        break;
+      case GraphicsApi::Vulkan:
+        list.append(QStringLiteral("Vulkan"));
+        break;
+      case GraphicsApi::Metal:
+        list.append(QStringLiteral("Metal"));
+        break;
+      case GraphicsApi::Direct3D11:
+        list.append(QStringLiteral("Direct3D 11"));
+        break;
+      case GraphicsApi::Direct3D12:
+        list.append(QStringLiteral("Direct3D 12"));
+        break;
+    }
+  }
+
+  return list;
+}
+
+/**
+ * Returns the names of the scene graph render loops
+ */
+QStringList Misc::GraphicsBackend::renderLoops() const
+{
+  return {tr("Automatic"), tr("Basic"), tr("Threaded")};
+}
+
+/**
+ * Returns the graphics API & the render loop used by the main window, e.g.
+ * "Vulkan, threaded render loop"
+ */
+QString Misc::GraphicsBackend::activeBackend() const
+{
+  return m_activeBackend;
+}
+
+/**
+ * Returns @c true if the selected graphics API or render loop differ from the
+ * ones used by the running application
+ */
+bool Misc::GraphicsBackend::restartRequired() const
+{
+  return m_graphicsApi != s_startupApi || m_renderLoop != s_startupLoop;
+}
+
+/**
+ * Returns the average frame interval (in milliseconds) of each 100 ms sample
+ */
+QVariantList Misc::GraphicsBackend::frameIntervals() const
+{
+  QVariantList list;
+  list.reserve(m_frameIntervals.count());
+  for (const auto value : m_frameIntervals)
+    list.append(value);
+
+  return list;
+}
+
+/**
+ * Returns the average render time (in milliseconds) of each 100 ms sample
+ */
+QVariantList Misc::GraphicsBackend::renderTimes() const
+{
+  QVariantList list;
+  list.reserve(m_renderTimes.count());
+  for (const auto value : m_renderTimes)
+    list.append(value);
+
+  return list;
+}
+
+/**
+ * Returns the average number of frames presented per second during the
+ * samples of the frame-time graph
+ */
+double Misc::GraphicsBackend::frameRate() const
+{
+  if (m_frameIntervals.isEmpty())
+    return 0;
+
+  double sum = 0;
+  for (const auto value : m_frameIntervals)
+    sum += value;
+
+  return sum > 0 ? 1000.0 * m_frameIntervals.count() / sum : 0;
+}
+
+/**
+ * Returns the average render time (in milliseconds) during the samples of the
+ * frame-time graph
+ */
+double Misc::GraphicsBackend::averageRenderTime() const
+{
+  if (m_renderTimes.isEmpty())
+    return 0;
+
+  double sum = 0;
+  for (const auto value : m_renderTimes)
+    sum += value;
+
+  return sum / m_renderTimes.count();
+}
+
+/**
+ * Returns the largest frame interval (in milliseconds) of the samples of the
+ * frame-time graph
+ */
+double Misc::GraphicsBackend::maxFrameInterval() const
+{
+  double max = 0;
+  for (const auto value : m_frameIntervals)
+    max = qMax(max, value);
+
+  return max;
+}
+
+/**
+ * Updates the translated names & samples the frame times periodically
+ */
+void Misc::GraphicsBackend::setupExternalConnections()
+{
+  connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
+          this, &Misc::GraphicsBackend::languageChanged);
+  connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
+          this, &Misc::GraphicsBackend::updateActiveBackend);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout10Hz,
+          this, &Misc::GraphicsBackend::updateFrameTimes);
+}
+
+/**
+ * Measures the frame times of the given @a window, the signals of the scene
+ * graph are handled on the render thread when the threaded loop is used.
+ */
+void Misc::GraphicsBackend::trackWindow(QQuickWindow *window)
+{
+  if (m_window)
+    disconnect(m_window, nullptr, this, nullptr);
+
+  m_window = window;
+  m_lastSwap = 0;
+  m_frameStart = 0;
+  if (!m_window)
+    return;
+
+  connect(m_window, &QQuickWindow::beforeSynchronizing, this,
+          &Misc::GraphicsBackend::onFrameStarted, Qt::DirectConnection);
+  connect(m_window, &QQuickWindow::afterRendering, this,
+          &Misc::GraphicsBackend::onFrameRendered, Qt::DirectConnection);
+  connect(m_window, &QQuickWindow::frameSwapped, this,
+          &Misc::GraphicsBackend::onFrameSwapped, Qt::DirectConnection);
+}
+
+/**
+ * Changes the graphics API used after the next restart, the value is saved in
+ * the application settings.
+ */
+void Misc::GraphicsBackend::setGraphicsApi(const int index)
+{
+  const auto api = m_apis.value(index, GraphicsApi::Automatic);
+  if (m_graphicsApi != api)
+  {
+    m_graphicsApi = api;
+    m_settings.setValue("graphics_api", kApiKeys[static_cast<int>(api)]);
+    Q_EMIT graphicsApiChanged();
+    Q_EMIT restartRequiredChanged();
+  }
+}
+
+/**
+ * Changes the render loop used after the next restart, the value is saved in
+ * the application settings.
+ */
+void Misc::GraphicsBackend::setRenderLoop(const int index)
+{
+  const auto count = static_cast<int>(std::size(kLoopKeys));
+  const auto loop = static_cast<RenderLoop>(qBound(0, index, count - 1));
+  if (m_renderLoop != loop)
+  {
+    m_renderLoop = loop;
+    m_settings.setValue("render_loop", kLoopKeys[static_cast<int>(loop)]);
+    Q_EMIT renderLoopChanged();
+    Q_EMIT restartRequiredChanged();
+  }
+}
+
+/**
+ * Moves the frame times measured since the last call to the frame-time graph
+ */
+void Misc::GraphicsBackend::updateFrameTimes()
+{
+  // Take the counters of the last interval
+  const auto intervals = m_intervalCount.exchange(0);
+  const auto intervalSum = m_intervalSum.exchange(0);
+  const auto renders = m_renderCount.exchange(0);
+  const auto renderSum = m_renderSum.exchange(0);
+
+  // The render loop is known once the first frame has been presented
+  updateActiveBackend();
+
+  // Nothing was presented, the samples are only about presented frames
+  if (intervals <= 0)
+    return;
+
+  // Append the averages of the interval to the graph
+  m_frameIntervals.append(intervalSum / 1e6 / intervals);
+  m_renderTimes.append(renders > 0 ? renderSum / 1e6 / renders : 0);
+  while (m_frameIntervals.count() > kHistorySize)
+    m_frameIntervals.removeFirst();
+  while (m_renderTimes.count() > kHistorySize)
+    m_renderTimes.removeFirst();
+
+  Q_EMIT frameTimesChanged();
+}
+
+/**
+ * Updates the description of the graphics API & render loop of the main
+ * window
+ */
+void Misc::GraphicsBackend::updateActiveBackend()
+{
+  if (!m_window || !m_window->rendererInterface())
+    return;
+
+  // Obtain the name of the graphics API
+  QString api;
+  switch (m_window->rendererInterface()->graphicsApi())
+  {
+    case QSGRendererInterface::OpenGL:
+      api = QStringLiteral("OpenGL");
+      break;
+    case QSGRendererInterface::Vulkan:
+      api = QStringLiteral("Vulkan");
+      break;
+    case QSGRendererInterface::Metal:
+      api = QStringLiteral("Metal");
+      break;
+    case QSGRendererInterface::Direct3D11:
+      api = QStringLiteral("Direct3D 11");
+      break;
+    case QSGRendererInterface::Direct3D12:
+      api = QStringLiteral("Direct3D 12");
+      break;
+    case QSGRendererInterface::Software:
+      api = tr("Software");
+      break;
+    default:
+      api = tr("Unknown");
+      break;
+  }
+
+  // Add the render loop
+  const auto loop = m_threaded ? tr("threaded render loop")
+                               : tr("basic render loop");
+  const auto backend = QStringLiteral("%1, %2").arg(api, loop);
+  if (m_activeBackend != backend)
+  {
+    m_activeBackend = backend;
+    Q_EMIT activeBackendChanged();
+  }
+}
+
+/**
+ * Registers the time at which the scene graph starts synchronizing a frame
+ */
+void Misc::GraphicsBackend::onFrameStarted()
+{
+  m_frameStart.store(Misc::SessionClock::now(), std::memory_order_relaxed);
+}
+
+/**
+ * Accumulates the time spent synchronizing & rendering the current frame
+ */
+void Misc::GraphicsBackend::onFrameRendered()
+{
+  const auto start = m_frameStart.exchange(0, std::memory_order_relaxed);
+  if (start <= 0)
+    return;
+
+  const auto elapsed = Misc::SessionClock::now() - start;
+  m_renderSum.fetch_add(elapsed, std::memory_order_relaxed);
+  m_renderCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Accumulates the time between the current & the previous presented frames,
+ * and detects whether the window is rendered by a dedicated thread
+ */
+void Misc::GraphicsBackend::onFrameSwapped()
+{
+  const auto now = Misc::SessionClock::now();
+  const auto last = m_lastSwap.exchange(now, std::memory_order_relaxed);
+  m_threaded.store(QThread::currentThread() != qApp->thread(),
+                   std::memory_order_relaxed);
+
+  if (last <= 0)
+    return;
+
+  m_intervalSum.fetch_add(now - last, std::memory_order_relaxed);
+  m_intervalCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSettings>
+#include <QStringList>
+#include <QVariantList>
+
+class QQuickWindow;
+
+namespace Misc
+{
+/**
+ * @brief The GraphicsBackend class
+ *
+ * Selects the graphics API used by Qt Quick (OpenGL, Vulkan, Metal or
+ * Direct3D 11/12) and the scene graph render loop (basic or threaded), and
+ * measures the frame times of the main window so that users can compare each
+ * combination on their hardware.
+ *
+ * Both options must be applied before the application object is created,
+ * which is done by @c configure() in @c main(). They are read from the
+ * application settings, and can be overridden for a single session with the
+ * @c --graphics-api and @c --render-loop command line options (or with the
+ * @c QSG_RHI_BACKEND and @c QSG_RENDER_LOOP environment variables). Changes
+ * made from the user interface take effect after restarting the application.
+ *
+ * Frame times are sampled on the thread that renders the main window. The
+ * frame interval is the time between two presented frames, the render time
+ * is the time the scene graph spent synchronizing & recording a frame,
+ * without waiting for the display. Averages are published ten times per
+ * second, and the last ten seconds are kept for the frame-time graph.
+ */
+class GraphicsBackend : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int graphicsApi
+             READ graphicsApi
+             WRITE setGraphicsApi
+             NOTIFY graphicsApiChanged)
+  Q_PROPERTY(int renderLoop
+             READ renderLoop
+             WRITE setRenderLoop
+             NOTIFY renderLoopChanged)
+  Q_PROPERTY(QStringList graphicsApis
+             READ graphicsApis
+             NOTIFY languageChanged)
+  Q_PROPERTY(QStringList renderLoops
+             READ renderLoops
+             NOTIFY languageChanged)
+  Q_PROPERTY(QString activeBackend
+             READ activeBackend
+             NOTIFY activeBackendChanged)
+  Q_PROPERTY(bool restartRequired
+             READ restartRequired
+             NOTIFY restartRequiredChanged)
+  Q_PROPERTY(QVariantList frameIntervals
+             READ frameIntervals
+             NOTIFY frameTimesChanged)
+  Q_PROPERTY(QVariantList renderTimes
+             READ renderTimes
+             NOTIFY frameTimesChanged)
+  Q_PROPERTY(double frameRate
+             READ frameRate
+             NOTIFY frameTimesChanged)
+  Q_PROPERTY(double averageRenderTime
+             READ averageRenderTime
+             NOTIFY frameTimesChanged)
+  Q_PROPERTY(double maxFrameInterval
+             READ maxFrameInterval
+             NOTIFY frameTimesChanged)
+  // clang-format on
+
+signals:
+  void languageChanged();
+  void frameTimesChanged();
+  void renderLoopChanged();
+  void graphicsApiChanged();
+  void activeBackendChanged();
+  void restartRequiredChanged();
+
+private:
+  explicit GraphicsBackend();
+  GraphicsBackend(GraphicsBackend &&) = delete;
+  GraphicsBackend(const GraphicsBackend &) = delete;
+  GraphicsBackend &operator=(GraphicsBackend &&) = delete;
+  GraphicsBackend &operator=(const GraphicsBackend &) = delete;
+
+public:
+  enum class GraphicsApi
+  {
+    Automatic,
+    OpenGL,
+    Vulkan,
+    Metal,
+    Direct3D11,
+    Direct3D12
+  };
+  Q_ENUM(GraphicsApi)
+
+  enum class RenderLoop
+  {
+    Automatic,
+    Basic,
+    Threaded
+  };
+  Q_ENUM(RenderLoop)
+
+  static GraphicsBackend &instance();
+  static void configure(int argc, char **argv);
+
+  [[nodiscard]] int graphicsApi() const;
+  [[nodiscard]] int renderLoop() const;
+  [[nodiscard]] QStringList graphicsApis() const;
+  [[nodiscard]] QStringList renderLoops() const;
+  [[nodiscard]] QString activeBackend() const;
+  [[nodiscard]] bool restartRequired() const;
+
+  [[nodiscard]] QVariantList frameIntervals() const;
+  [[nodiscard]] QVariantList renderTimes() const;
+  [[nodiscard]] double frameRate() const;
+  [[nodiscard]] double averageRenderTime() const;
+  [[nodiscard]] double maxFrameInterval() const;
+
+public slots:
+  void setupExternalConnections();
+  void trackWindow(QQuickWindow *window);
+  void setGraphicsApi(const int index);
+  void setRenderLoop(const int index);
+
+private slots:
+  void updateFrameTimes();
+
+private:
+  void updateActiveBackend();
+  void onFrameStarted();
+  void onFrameRendered();
+  void onFrameSwapped();
+
+private:
+  QSettings m_settings;
+  QList<GraphicsApi> m_apis;
+  GraphicsApi m_graphicsApi;
+  RenderLoop m_renderLoop;
+
+  QString m_activeBackend;
+  QPointer<QQuickWindow> m_window;
+
+  QList<double> m_frameIntervals;
+  QList<double> m_renderTimes;
+
+  std::atomic<bool> m_threaded;
+  std::atomic<qint64> m_frameStart;
+  std::atomic<qint64> m_lastSwap;
+  std::atomic<qint64> m_intervalSum;
+  std::atomic<qint64> m_intervalCount;
+  std::atomic<qint64> m_renderSum;
+  std::atomic<qint64> m_renderCount;
+};
+} // namespace Misc
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/Headless.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+
+#include <QCommandLineParser>
+
+#include "IO/Manager.h"
+#include "CSV/Export.h"
+#include "MQTT/Client.h"
+#include "IO/RawCapture.h"
+#include "Plugins/Server.h"
+#include "CSV/ArrowExport.h"
+#include "CSV/BinaryExport.h"
+#include "CSV/TsdbExport.h"
+#include "IO/Drivers/Pipe.h"
+#include "IO/Drivers/Serial.h"
+#include "IO/Drivers/Replay.h"
+#include "IO/Drivers/Generator.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/Utilities.h"
+#include "IO/Drivers/Network.h"
+#include "JSON/FrameBuilder.h"
+#include "JSON/ProjectModel.h"
+#include "CSV/FlightRecorder.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/AlarmEngine.h"
+#include "Misc/DatasetStatistics.h"
+
+//------------------------------------------------------------------------------
+// Signal handling
+//------------------------------------------------------------------------------
+
+static constexpr int kSignalPollIntervalMs = 100;
+
+static std::atomic_bool s_quitRequested{false};
+
+/**
+ * Flags the headless runner to quit. Only async-signal-safe operations are
+ * allowed here, the event loop is stopped from @c checkQuitRequest().
+ */
+static void onQuitSignal(int signal)
+{
+  (void)signal;
+  s_quitRequested = true;
+}
+
+//------------------------------------------------------------------------------
+// Constructor function
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+Misc::Headless::Headless()
+  : m_reconnect(true)
+  , m_wasConnected(false)
+{
+}
+
+//------------------------------------------------------------------------------
+// Headless runner
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Configures the pipeline from the command line & runs the event loop.
+ *
+ * The device is connected as soon as the event loop starts. If the connection
+ * fails or is lost, a new attempt is made every second, unless the
+ * @c --exit-on-disconnect option is given, in which case the application
+ * quits once the device disconnects (e.g. at the end of a replay).
+ *
+ * @param arguments Command line arguments of the application.
+ * @return Exit code of the event loop, or @c EXIT_FAILURE if the command line
+ *         is invalid.
+ */
+int Misc::Headless::run(const QStringList &arguments)
+{
+  // clang-format off
+  QCommandLineParser parser;
+  parser.setApplicationDescription(tr("Runs the data acquisition & export "
+                                      "pipeline without user interface."));
+  const auto help = parser.addHelpOption();
+  const QCommandLineOption headless("headless", tr("Run without user interface."));
+  const QCommandLineOption project("project", tr("Load the given project file."), tr("file"));
+  const QCommandLineOption json("json", tr("Parse frames as JSON sent by the device."));
+  const QCommandLineOption quickPlot("quick-plot", tr("Plot comma-separated values."));
+  const QCommandLineOption serial("serial", tr("Connect to the given serial port."), tr("port"));
+  const QCommandLineOption baud("baud", tr("Baud rate of the serial port."), tr("rate"));
+  const QCommandLineOption tcp("tcp", tr("Connect to the given TCP server."), tr("host:port"));
+  const QCommandLineOption udp("udp", tr("Listen on the given UDP port."), tr("port"));
+  const QCommandLineOption replay("replay", tr("Replay the given raw capture file."), tr("file"));
+  const QCommandLineOption generator("generator", tr("Generate synthetic frames."));
+  const QCommandLineOption stdinput("stdin", tr("Read data from the standard input."));
+  const QCommandLineOption fifo("fifo", tr("Read data from the given named pipe."), tr("path"));
+  const QCommandLineOption localSocket("local-socket", tr("Connect to the given local socket."), tr("path"));
+  const QCommandLineOption csv("csv", tr("Export received frames to CSV files."));
+  const QCommandLineOption csvGzip("csv-gzip", tr("Compress exported CSV files with gzip."));
+  const QCommandLineOption arrow("arrow", tr("Export received frames to Apache Arrow files."));
+  const QCommandLineOption tsdb("tsdb", tr("Send received frames to the given time-series database endpoint."), tr("url"));
+  const QCommandLineOption tsdbFormat("tsdb-format", tr("API of the time-series database (influx or prometheus)."), tr("format"));
+  const QCommandLineOption tsdbToken("tsdb-token", tr("Access token of the time-series database."), tr("token"));
+  const QCommandLineOption mqtt("mqtt", tr("Publish frames to the given MQTT broker."), tr("host:port"));
+  const QCommandLineOption topic("mqtt-topic", tr("Topic used to publish MQTT messages."), tr("topic"));
+  const QCommandLineOption plugins("plugins", tr("Enable the plugin server."));
+  const QCommandLineOption exitOnDisconnect("exit-on-disconnect", tr("Quit when the device disconnects."));
+  parser.addOptions({headless, project, json, quickPlot, serial, baud, tcp,
+                     udp, replay, generator, stdinput, fifo, localSocket, csv,
+                     csvGzip, arrow, tsdb, tsdbFormat, tsdbToken, mqtt, topic,
+                     plugins, exitOnDisconnect});
+  // clang-format on
+
+  // Parse the command line
+  if (!parser.parse(arguments))
+  {
+    qCritical().noquote() << parser.errorText();
+    return EXIT_FAILURE;
+  }
+
+  // Print usage information
+  if (parser.isSet(help))
+  {
+    std::fputs(qPrintable(parser.helpText()), stdout);
+    return EXIT_SUCCESS;
+  }
+
+  // Exactly one driver must be selected
+  int drivers = 0;
+  QString driver;
+  for (const auto &option :
+       {serial, tcp, udp, replay, generator, stdinput, fifo, localSocket})
+  {
+    if (parser.isSet(option))
+    {
+      ++drivers;
+      driver = option.names().first();
+    }
+  }
+
+  if (drivers != 1)
+  {
+    qCritical() << "Exactly one of --serial, --tcp, --udp, --replay,"
+                << "--generator, --stdin, --fifo or --local-socket must be"
+                << "given";
+    return EXIT_FAILURE;
+  }
+
+  // At most one operation mode may be selected
+  const int modes = parser.isSet(project) + parser.isSet(json)
+                    + parser.isSet(quickPlot);
+  if (modes > 1)
+  {
+    qCritical() << "Only one of --project, --json or --quick-plot may be given";
+    return EXIT_FAILURE;
+  }
+
+  // Nobody is around to answer message boxes, log them instead
+  Misc::Utilities::setInteractive(false);
+
+  // Start common event timers
+  auto &timerEvents = Misc::TimerEvents::instance();
+  timerEvents.startTimers();
+
+  // Setup module interconnections, skipping UI-only modules (e.g. console)
+  IO::Drivers::Serial::instance().setupExternalConnections();
+  CSV::Export::instance().setupExternalConnections();
+  IO::Manager::instance().setupExternalConnections();
+  IO::RawCapture::instance().setupExternalConnections();
+  CSV::ArrowExport::instance().setupExternalConnections();
+  CSV::BinaryExport::instance().setupExternalConnections();
+  CSV::TsdbExport::instance().setupExternalConnections();
+  CSV::FlightRecorder::instance().setupExternalConnections();
+  JSON::ProjectModel::instance().setupExternalConnections();
+  JSON::FrameBuilder::instance().setupExternalConnections();
+  Misc::PipelineStats::instance().setupExternalConnections();
+  Misc::AlarmEngine::instance().setupExternalConnections();
+  Misc::DatasetStatistics::instance().setupExternalConnections();
+
+  // Select operation mode & load the project file
+  auto &builder = JSON::FrameBuilder::instance();
+  if (parser.isSet(project))
+  {
+    builder.setOperationMode(SerialStudio::ProjectFile);
+    builder.loadJsonMap(parser.value(project));
+    if (builder.jsonMapFilepath().isEmpty())
+    {
+      qCritical() << "Cannot load project file" << parser.value(project);
+      return EXIT_FAILURE;
+    }
+  }
+
+  else if (parser.isSet(json))
+    builder.setOperationMode(SerialStudio::DeviceSendsJSON);
+
+  else if (parser.isSet(quickPlot))
+    builder.setOperationMode(SerialStudio::QuickPlot);
+
+  // Configure the I/O driver
+  if (!configureDriver(driver, parser.value(driver)))
+    return EXIT_FAILURE;
+
+  if (parser.isSet(baud))
+  {
+    bool ok = false;
+    const auto rate = parser.value(baud).toInt(&ok);
+    if (!ok || rate <= 10)
+    {
+      qCritical() << "Invalid baud rate" << parser.value(baud);
+      return EXIT_FAILURE;
+    }
+
+    IO::Drivers::Serial::instance().setBaudRate(rate);
+  }
+
+  // Configure CSV/Arrow export & plugin server
+  CSV::Export::instance().setExportEnabled(parser.isSet(csv));
+  CSV::Export::instance().setCompressFiles(parser.isSet(csvGzip));
+  CSV::ArrowExport::instance().setExportEnabled(parser.isSet(arrow));
+  Plugins::Server::instance().setEnabled(parser.isSet(plugins));
+
+  // Configure the time-series database export
+  if (parser.isSet(tsdb))
+  {
+    const auto api = parser.value(tsdbFormat).toLower();
+    if (!api.isEmpty() && api != "influx" && api != "prometheus")
+    {
+      qCritical() << "Invalid time-series database format" << api;
+      return EXIT_FAILURE;
+    }
+
+    auto &tsdbExport = CSV::TsdbExport::instance();
+    tsdbExport.setFormat(api == "prometheus" ? 1 : 0);
+    tsdbExport.setUrl(parser.value(tsdb));
+    if (parser.isSet(tsdbToken))
+      tsdbExport.setToken(parser.value(tsdbToken));
+
+    tsdbExport.setExportEnabled(true);
+  }
+
+  // Configure MQTT publisher
+  if (parser.isSet(mqtt))
+  {
+    const auto address = parser.value(mqtt);
+    const auto separator = address.lastIndexOf(':');
+    const auto host = separator > 0 ? address.left(separator) : address;
+
+    auto &client = MQTT::Client::instance();
+    client.setHost(host);
+    client.setClientMode(MQTT::ClientPublisher);
+    if (separator > 0)
+    {
+      bool ok = false;
+      const auto port = address.mid(separator + 1).toUShort(&ok);
+      if (!ok || port == 0)
+      {
+        qCritical() << "Invalid MQTT broker address" << address;
+        return EXIT_FAILURE;
+      }
+
+      client.setPort(port);
+    }
+
+    if (parser.isSet(topic))
+      client.setTopic(parser.value(topic));
+
+    client.connectToHost();
+  }
+
+  // Connect the device when the event loop starts & retry every second
+  m_reconnect = !parser.isSet(exitOnDisconnect);
+  auto &manager = IO::Manager::instance();
+  connect(&manager, &IO::Manager::connectedChanged, this,
+          &Misc::Headless::onConnectedChanged);
+  connect(&timerEvents, &Misc::TimerEvents::timeout1Hz, this,
+          &Misc::Headless::connectDevice);
+  QTimer::singleShot(0, this, &Misc::Headless::connectDevice);
+
+  // Quit cleanly on SIGINT & SIGTERM, so that CSV files are flushed
+  std::signal(SIGINT, onQuitSignal);
+  std::signal(SIGTERM, onQuitSignal);
+  connect(&m_signalTimer, &QTimer::timeout, this,
+          &Misc::Headless::checkQuitRequest);
+  m_signalTimer.start(kSignalPollIntervalMs);
+
+  // Run the event loop
+  qInfo() << "Running in headless mode, press Ctrl+C to quit";
+  const auto status = qApp->exec();
+
+  // Disconnect the device before the modules are destroyed
+  manager.disconnectDevice();
+  return status;
+}
+
+//------------------------------------------------------------------------------
+// Private slots
+//------------------------------------------------------------------------------
+
+/**
+ * Tries to connect to the selected device, unless it is already connected or
+ * it was disconnected and the @c --exit-on-disconnect option is active.
+ */
+void Misc::Headless::connectDevice()
+{
+  auto &manager = IO::Manager::instance();
+  if (manager.connected() || (m_wasConnected && !m_reconnect))
+    return;
+
+  if (manager.configurationOk())
+    manager.connectDevice();
+}
+
+/**
+ * Stops the event loop once a quit signal has been received.
+ */
+void Misc::Headless::checkQuitRequest()
+{
+  if (s_quitRequested)
+  {
+    m_signalTimer.stop();
+    qInfo() << "Quit requested, stopping data acquisition";
+    qApp->quit();
+  }
+}
+
+/**
+ * Logs connection changes & quits when the device disconnects if requested.
+ */
+void Misc::Headless::onConnectedChanged()
+{
+  if (IO::Manager::instance().connected())
+  {
+    m_wasConnected = true;
+    qInfo() << "Device connected";
+  }
+
+  else if (m_wasConnected)
+  {
+    qWarning() << "Device disconnected";
+    if (!m_reconnect)
+      qApp->quit();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Driver configuration
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Selects & configures the I/O driver given on the command line.
+ *
+ * @param driver Name of the driver option (serial, tcp, udp, replay,
+ *               generator, stdin, fifo or local-socket).
+ * @param value Value of the driver option (port, address, file or path).
+ * @return @c true if the driver could be configured.
+ */
+bool Misc::Headless::configureDriver(const QString &driver,
+                                     const QString &value)
+{
+  auto &manager = IO::Manager::instance();
+
+  // Serial port, given by name (e.g. ttyUSB0) or by device path
+  if (driver == QStringLiteral("serial"))
+  {
+    auto &port = IO::Drivers::Serial::instance();
+    manager.setBusType(SerialStudio::BusType::Serial);
+    QMetaObject::invokeMethod(&port, "refreshSerialDevices",
+                              Qt::DirectConnection);
+
+    auto index = port.portList().indexOf(value);
+    if (index < 1)
+    {
+      port.registerDevice(value);
+      index = port.portList().indexOf(value.simplified());
+    }
+
+    if (index < 1)
+    {
+      qCritical() << "Serial port not found" << value;
+      return false;
+    }
+
+    port.setPortIndex(static_cast<quint8>(index));
+    return true;
+  }
+
+  // TCP client, given as host:port
+  if (driver == QStringLiteral("tcp"))
+  {
+    bool ok = false;
+    const auto separator = value.lastIndexOf(':');
+    const auto port = value.mid(separator + 1).toUShort(&ok);
+    if (separator < 1 || !ok || port == 0)
+    {
+      qCritical() << "Invalid TCP address" << value;
+      return false;
+    }
+
+    auto &network = IO::Drivers::Network::instance();
+    manager.setBusType(SerialStudio::BusType::Network);
+    network.setTcpSocket();
+    network.setRemoteAddress(value.left(separator));
+    network.setTcpPort(port);
+    return true;
+  }
+
+  // UDP socket, listening on the given local port
+  if (driver == QStringLiteral("udp"))
+  {
+    bool ok = false;
+    const auto port = value.toUShort(&ok);
+    if (!ok || port == 0)
+    {
+      qCritical() << "Invalid UDP port" << value;
+      return false;
+    }
+
+    auto &network = IO::Drivers::Network::instance();
+    manager.setBusType(SerialStudio::BusType::Network);
+    network.setUdpSocket();
+    network.setUdpLocalPort(port);
+    return true;
+  }
+
+  // Output of another process, through a pipe or a local socket
+  if (driver == QStringLiteral("stdin") || driver == QStringLiteral("fifo")
+      || driver == QStringLiteral("local-socket"))
+  {
+    using Source = IO::Drivers::Pipe::Source;
+    auto source = Source::LocalSocket;
+    if (driver == QStringLiteral("stdin"))
+      source = Source::StandardInput;
+    else if (driver == QStringLiteral("fifo"))
+      source = Source::NamedPipe;
+
+    auto &pipe = IO::Drivers::Pipe::instance();
+    manager.setBusType(SerialStudio::BusType::Pipe);
+    pipe.setSourceIndex(static_cast<int>(source));
+    pipe.setPath(value);
+    return true;
+  }
+
+  // Synthetic signal generator, configured from the GUI settings
+  if (driver == QStringLiteral("generator"))
+  {
+    manager.setBusType(SerialStudio::BusType::Generator);
+    return true;
+  }
+
+  // Raw capture replay
+  manager.setBusType(SerialStudio::BusType::Replay);
+  IO::Drivers::Replay::instance().setFilePath(value);
+  return true;
+}
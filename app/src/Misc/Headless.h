@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+#include <QStringList>
+
+namespace Misc
+{
+/**
+ * @brief The Headless class
+ *
+ * Runs the data acquisition & export pipeline without creating the QML
+ * engine, the dashboard or any widget, so that Serial Studio can be used as a
+ * lightweight data-logging service.
+ *
+ * Headless mode is started with the @c --headless command line option. The
+ * remaining options select the project file or operation mode, the I/O driver
+ * to connect to and the data sinks (CSV export, MQTT publisher and/or plugin
+ * server). Any setting that is not given on the command line is taken from
+ * the persistent settings of the GUI.
+ *
+ * Message boxes are redirected to the log, and the application quits cleanly
+ * (flushing pending CSV data) when it receives @c SIGINT or @c SIGTERM.
+ */
+class Headless : public QObject
+{
+  Q_OBJECT
+
+public:
+  Headless();
+
+  int run(const QStringList &arguments);
+
+private slots:
+  void connectDevice();
+  void checkQuitRequest();
+  void onConnectedChanged();
+
+private:
+  [[nodiscard]] bool configureDriver(const QString &driver,
+                                     const QString &value);
+
+private:
+  bool m_reconnect;
+  bool m_wasConnected;
+  QTimer m_signalTimer;
+};
+} // namespace Misc
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/Logger.h"
+
+#include <chrono>
+#include <cstdlib>
+
+#include "IO/Manager.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Number of messages that fit in the queue before new messages are dropped
+ */
+static constexpr std::size_t kQueueCapacity = 4096;
+
+/**
+ * Maximum number of messages that a single site may log per second
+ */
+static constexpr int kSiteMessageLimit = 20;
+
+/**
+ * Length of a rate limit window, in nanoseconds
+ */
+static constexpr qint64 kSiteWindow = 1000 * 1000 * 1000;
+
+/**
+ * Time between two runs of the background writer
+ */
+static constexpr auto kWriterInterval = std::chrono::milliseconds(50);
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, opens the log file (if any) & starts the writer.
+ */
+Misc::Logger::Logger()
+  : m_file(nullptr)
+  , m_running(true)
+  , m_dropped(0)
+  , m_queue(kQueueCapacity)
+{
+  const char *path = std::getenv("SERIAL_STUDIO_LOG");
+  if (path && *path)
+    m_file = std::fopen(path, "a");
+
+  m_thread = std::thread(&Logger::run, this);
+}
+
+/**
+ * Destructor function, stops the writer & writes the pending messages.
+ */
+Misc::Logger::~Logger()
+{
+  m_running = false;
+  if (m_thread.joinable())
+    m_thread.join();
+
+  drain(false);
+  if (m_file)
+    std::fclose(m_file);
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::Logger &Misc::Logger::instance()
+{
+  static Logger singleton;
+  return singleton;
+}
+
+/**
+ * @brief Handles the messages of the Qt logging framework, install it with
+ *        @c qInstallMessageHandler().
+ *
+ * @param type The type of the message.
+ * @param context The message log context (file, line, function).
+ * @param message The actual message that was emitted by the Qt system.
+ */
+void Misc::Logger::messageHandler(QtMsgType type,
+                                  const QMessageLogContext &context,
+                                  const QString &message)
+{
+  if (!message.isEmpty())
+    instance().post(type, context, message);
+}
+
+//------------------------------------------------------------------------------
+// Message writing
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Writes the queued messages right away, from the calling thread.
+ *
+ * Called when the application is about to quit, so that no message is lost.
+ */
+void Misc::Logger::flush()
+{
+  drain(true);
+}
+
+/**
+ * @brief Main loop of the background writer.
+ */
+void Misc::Logger::run()
+{
+  while (m_running)
+  {
+    std::this_thread::sleep_for(kWriterInterval);
+    drain(true);
+  }
+}
+
+/**
+ * @brief Formats the queued messages & writes them as a single batch.
+ *
+ * @param toConsole Set to @c true to show the messages in the console of the
+ *                  application.
+ */
+void Misc::Logger::drain(const bool toConsole)
+{
+  // Only one thread may consume the queue at a time
+  std::lock_guard<std::mutex> lock(m_drainMutex);
+
+  // Format the queued messages
+  Message message;
+  QByteArray batch;
+  while (m_queue.tryPop(message))
+    format(message, batch);
+
+  // Report the messages that did not fit in the queue
+  const auto dropped = m_dropped.exchange(0);
+  if (dropped > 0)
+  {
+    batch.append("[WARN] ");
+    batch.append(QByteArray::number(dropped));
+    batch.append(" log messages dropped\n");
+  }
+
+  if (batch.isEmpty())
+    return;
+
+  // Write the batch to the standard output & the log file
+  std::fwrite(batch.constData(), 1, batch.size(), stdout);
+  std::fflush(stdout);
+  if (m_file)
+  {
+    std::fwrite(batch.constData(), 1, batch.size(), m_file);
+    std::fflush(m_file);
+  }
+
+  // Use IO::Manager signal to avoid messing up tokens in console
+  if (toConsole)
+  {
+    QMetaObject::invokeMethod(
+        &IO::Manager::instance(),
+        [batch] { Q_EMIT IO::Manager::instance().dataReceived(batch); },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Appends the given @a message, with its level prefix, function name
+ *        and suppression count, to @a output.
+ */
+void Misc::Logger::format(const Message &message, QByteArray &output)
+{
+  switch (message.type)
+  {
+    case QtInfoMsg:
+      output.append("[INFO] ");
+      break;
+    case QtDebugMsg:
+      output.append("[DEBG] ");
+      break;
+    case QtWarningMsg:
+      output.append("[WARN] ");
+      break;
+    case QtCriticalMsg:
+      output.append("[CRIT] ");
+      break;
+    case QtFatalMsg:
+      output.append("[FATL] ");
+      break;
+    default:
+      return;
+  }
+
+  if (!message.function.isEmpty())
+  {
+    output.append(message.function);
+    output.append(" - ");
+  }
+
+  output.append(message.text.toUtf8());
+  if (message.suppressed > 0)
+  {
+    output.append(" (");
+    output.append(QByteArray::number(message.suppressed));
+    output.append(" similar messages suppressed)");
+  }
+
+  output.append('\n');
+}
+
+//------------------------------------------------------------------------------
+// Message queuing & rate limiting
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Queues a message for the background writer, unless its site already
+ *        logged too many messages during the current second.
+ */
+void Misc::Logger::post(QtMsgType type, const QMessageLogContext &context,
+                        const QString &message)
+{
+  // Write fatal messages right away, the application aborts after this call
+  if (type == QtFatalMsg)
+  {
+    drain(false);
+
+    QByteArray output;
+    format({type, context.function, message, 0}, output);
+    std::fwrite(output.constData(), 1, output.size(), stderr);
+    std::fflush(stderr);
+    if (m_file)
+    {
+      std::fwrite(output.constData(), 1, output.size(), m_file);
+      std::fflush(m_file);
+    }
+
+    return;
+  }
+
+  // Apply the rate limit of the message site
+  const auto suppressed = admit(context, message);
+  if (suppressed < 0)
+    return;
+
+  // Queue the message, or count it as dropped if the queue is full
+  if (!m_queue.tryPush({type, context.function, message, suppressed}))
+    m_dropped.fetch_add(1 + suppressed, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks the rate limit of the site of a message.
+ *
+ * The site is identified by its source location, or by the message text
+ * without its digits if the location is not available (release builds), so
+ * that a warning containing a frame number or value still counts as the same
+ * site. Sites are mapped to a fixed table of counters, the counters are
+ * updated with atomic operations only, and two sites that share an entry
+ * simply restart each other's rate limit window.
+ *
+ * @return -1 if the message must be discarded, otherwise the number of
+ *         messages of the site that were discarded since the last message
+ *         that went through.
+ */
+int Misc::Logger::admit(const QMessageLogContext &context,
+                        const QString &message)
+{
+  // Obtain the key of the message site
+  quint64 key = 0;
+  if (context.file)
+    key = qHashMulti(0, static_cast<const void *>(context.file), context.line);
+  else if (context.function)
+    key = qHash(QByteArrayView(context.function));
+  // FNV-1a hash of the message text, skipping digits
+  else
+  {
+    key = 14695981039346656037ULL;
+    for (const auto c : message)
+    {
+      if (!c.isDigit())
+        key = (key ^ c.unicode()) * 1099511628211ULL;
+    }
+  }
+
+  key = qMax<quint64>(key, 1);
+
+  // Restart the counters if the entry belonged to another site
+  const auto now = Misc::SessionClock::now();
+  auto &site = m_sites[key % m_sites.size()];
+  if (site.key.exchange(key, std::memory_order_relaxed) != key)
+  {
+    site.window.store(now, std::memory_order_relaxed);
+    site.count.store(0, std::memory_order_relaxed);
+    site.suppressed.store(0, std::memory_order_relaxed);
+  }
+
+  // Start a new window once a second has passed
+  auto window = site.window.load(std::memory_order_relaxed);
+  if (now - window >= kSiteWindow
+      && site.window.compare_exchange_strong(window, now,
+                                             std::memory_order_relaxed))
+    site.count.store(0, std::memory_order_relaxed);
+
+  // Discard the message if the site reached its limit
+  if (site.count.fetch_add(1, std::memory_order_relaxed) >= kSiteMessageLimit)
+  {
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+  }
+
+  return site.suppressed.exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+
+#include <QString>
+#include <QtGlobal>
+#include <QByteArray>
+
+#include "Misc/MpscQueue.h"
+
+namespace Misc
+{
+/**
+ * @class Misc::Logger
+ * @brief Asynchronous, rate-limited sink for the messages of the Qt logging
+ *        framework.
+ *
+ * The @c messageHandler() function is installed with
+ * @c qInstallMessageHandler(). It does not format or write anything: it
+ * checks the rate limit of the message site and pushes the message to a
+ * lock-free queue, so that a parser or checksum that warns on every frame
+ * never stalls the thread that emits the warnings.
+ *
+ * A background writer drains the queue a few times per second, formats the
+ * messages and writes each batch with a single write (and flush) to the
+ * standard output, to the optional log file given by the
+ * @c SERIAL_STUDIO_LOG environment variable, and to the console of the
+ * application.
+ *
+ * Every message site (source location, or the message text without digits
+ * when the location is not available) may log @c kSiteMessageLimit messages
+ * per second. Further messages are counted and reported with the next
+ * message from that site that goes through. Messages that do not fit in the
+ * queue are dropped and reported as well. Fatal messages are written
+ * synchronously, since the application aborts right after.
+ */
+class Logger
+{
+private:
+  explicit Logger();
+  Logger(Logger &&) = delete;
+  Logger(const Logger &) = delete;
+  Logger &operator=(Logger &&) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  ~Logger();
+
+public:
+  static Logger &instance();
+  static void messageHandler(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message);
+
+  void flush();
+
+private:
+  /**
+   * @brief Message waiting for the background writer.
+   */
+  struct Message
+  {
+    QtMsgType type = QtDebugMsg;
+    QByteArray function;
+    QString text;
+    int suppressed = 0;
+  };
+
+  /**
+   * @brief Rate limit counters of a message site.
+   */
+  struct Site
+  {
+    std::atomic<quint64> key{0};
+    std::atomic<qint64> window{0};
+    std::atomic<int> count{0};
+    std::atomic<int> suppressed{0};
+  };
+
+  void run();
+  void drain(const bool toConsole);
+  int admit(const QMessageLogContext &context, const QString &message);
+  void post(QtMsgType type, const QMessageLogContext &context,
+            const QString &message);
+
+  static void format(const Message &message, QByteArray &output);
+
+private:
+  std::FILE *m_file;
+  std::thread m_thread;
+  std::mutex m_drainMutex;
+  std::atomic<bool> m_running;
+  std::atomic<qint64> m_dropped;
+
+  MpscQueue<Message> m_queue;
+  std::array<Site, 256> m_sites;
+};
+} // namespace Misc
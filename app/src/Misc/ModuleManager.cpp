@@ -20,7 +20,6 @@
  * THE SOFTWARE.
  */
 
-#include <iostream>
 #include <QQuickWindow>
 #include <QSimpleUpdater.h>
 
@@ -28,7 +27,12 @@
 #include "SerialStudio.h"
 
 #include "CSV/Export.h"
+#include "CSV/ArrowExport.h"
+#include "CSV/BinaryExport.h"
+#include "CSV/FlightRecorder.h"
 #include "CSV/Player.h"
+#include "CSV/Reference.h"
+#include "CSV/TsdbExport.h"
 
 #include "JSON/Group.h"
 #include "JSON/Dataset.h"
@@ -38,24 +42,42 @@
 
 #include "IO/Manager.h"
 #include "IO/Console.h"
+#include "IO/RawCapture.h"
 #include "IO/FileTransmission.h"
 
 #include "IO/Drivers/Serial.h"
 #include "IO/Drivers/Network.h"
+#include "IO/Drivers/Replay.h"
+#include "IO/Drivers/CANBus.h"
+#include "IO/Drivers/Modbus.h"
+#include "IO/Drivers/USB.h"
+#include "IO/Drivers/Audio.h"
+#include "IO/Drivers/Pipe.h"
+#include "IO/Drivers/Generator.h"
 #include "IO/Drivers/BluetoothLE.h"
 
+#include "Misc/Logger.h"
 #include "Misc/Utilities.h"
 #include "Misc/Translator.h"
 #include "Misc/CommonFonts.h"
 #include "Misc/TimerEvents.h"
 #include "Misc/ThemeManager.h"
 #include "Misc/ModuleManager.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+#include "Misc/GraphicsBackend.h"
+#include "Misc/ThreadScheduler.h"
+#include "Misc/AlarmEngine.h"
+#include "Misc/DatasetStatistics.h"
+#include "Misc/TileCache.h"
 
 #include "MQTT/Client.h"
 #include "Plugins/Server.h"
+#include "Plugins/Viewer.h"
 
 #include "UI/Dashboard.h"
 #include "UI/DashboardWidget.h"
+#include "UI/DashboardRecorder.h"
 
 #include "UI/Widgets/Bar.h"
 #include "UI/Widgets/GPS.h"
@@ -66,74 +88,13 @@
 #include "UI/Widgets/DataGrid.h"
 #include "UI/Widgets/LEDPanel.h"
 #include "UI/Widgets/Terminal.h"
+#include "UI/Widgets/Waterfall.h"
 #include "UI/Widgets/Gyroscope.h"
 #include "UI/Widgets/MultiPlot.h"
+#include "UI/Widgets/LineRenderer.h"
+#include "UI/Widgets/LEDRenderer.h"
 #include "UI/Widgets/Accelerometer.h"
-
-/**
- * @brief Custom message handler for Qt debug, warning, critical, and fatal
- *        messages.
- *
- * This static function handles messages of various types (debug, warning,
- * critical, fatal) emitted by the Qt framework.
- *
- * It formats the message with a corresponding prefix based on the message type
- * (e.g., "[Debug]", "[Warning]").
- *
- * @param type The type of the message.
- * @param context The message log context (file, line, function).
- * @param msg The actual message that was emitted by the Qt system.
- *
- * @note The function appends the formatted message to the console handler.
- */
-static void MessageHandler(QtMsgType type, const QMessageLogContext &context,
-                           const QString &msg)
-{
-  // Skip empty messages
-  (void)context;
-  if (msg.isEmpty())
-    return;
-
-  // Add function to string
-  QString message;
-  if (context.function)
-    message = QStringLiteral("%1 - %2").arg(context.function, msg);
-  else
-    message = msg;
-
-  // Show message & warning level
-  QString output;
-  switch (type)
-  {
-    case QtInfoMsg:
-      output = QStringLiteral("[INFO] %1").arg(message);
-      break;
-    case QtDebugMsg:
-      output = QStringLiteral("[DEBG] %1").arg(message);
-      break;
-    case QtWarningMsg:
-      output = QStringLiteral("[WARN] %1").arg(message);
-      break;
-    case QtCriticalMsg:
-      output = QStringLiteral("[CRIT] %1").arg(message);
-      break;
-    case QtFatalMsg:
-      output = QStringLiteral("[FATL] %1").arg(message);
-      break;
-    default:
-      break;
-  }
-
-  if (!output.isEmpty())
-  {
-    // Add a newline at the end
-    std::cout << output.toStdString() << std::endl;
-    output.append("\n");
-
-    // Use IO::Manager signal to avoid messing up tokens in console
-    Q_EMIT IO::Manager::instance().dataReceived(output.toUtf8());
-  }
-}
+#include "UI/Widgets/WaterfallRenderer.h"
 
 /**
  * Configures the application font and configures application signals/slots to
@@ -141,6 +102,9 @@ static void MessageHandler(QtMsgType type, const QMessageLogContext &context,
  */
 Misc::ModuleManager::ModuleManager()
 {
+  // Measure the startup time from here
+  m_startupTimer.start();
+
   // Init translator
   (void)Misc::Translator::instance();
 
@@ -157,6 +121,15 @@ const QQmlApplicationEngine &Misc::ModuleManager::engine() const
   return m_engine;
 }
 
+/**
+ * Returns a modifiable reference to the QML application engine, used to
+ * instantiate QML components outside of the main window
+ */
+QQmlApplicationEngine &Misc::ModuleManager::engine()
+{
+  return m_engine;
+}
+
 /**
  * Enables or disables the auto-updater system (QSimpleUpdater).
  *
@@ -182,9 +155,16 @@ void Misc::ModuleManager::onQuit()
   Misc::TimerEvents::instance().stopTimers();
 
   CSV::Export::instance().closeFile();
+  CSV::ArrowExport::instance().closeFile();
+  CSV::BinaryExport::instance().closeFile();
+  CSV::TsdbExport::instance().flush();
+  IO::RawCapture::instance().closeFile();
   CSV::Player::instance().closeFile();
+  CSV::Reference::instance().closeFile();
   IO::Manager::instance().disconnectDevice();
-  Plugins::Server::instance().removeConnection();
+  Plugins::Server::instance().removeConnections();
+  Plugins::Viewer::instance().disconnectFromHost();
+  Misc::Logger::instance().flush();
 }
 
 /**
@@ -203,6 +183,38 @@ void Misc::ModuleManager::configureUpdater()
   QSimpleUpdater::getInstance()->setMandatoryUpdate(APP_UPDATER_URL, false);
 }
 
+/**
+ * Records the time elapsed since the module manager was created as the end of
+ * the given startup @a phase.
+ */
+void Misc::ModuleManager::markStartupPhase(const char *phase)
+{
+  m_startupPhases.append(qMakePair(phase, m_startupTimer.elapsed()));
+}
+
+/**
+ * Logs the duration of each startup phase, in milliseconds.
+ */
+void Misc::ModuleManager::reportStartupTimes()
+{
+  QString report;
+  qint64 previous = 0;
+  for (const auto &phase : std::as_const(m_startupPhases))
+  {
+    if (!report.isEmpty())
+      report.append(QStringLiteral(", "));
+
+    report.append(QString::fromLatin1(phase.first));
+    report.append(QStringLiteral(": "));
+    report.append(QString::number(phase.second - previous));
+    report.append(QStringLiteral(" ms"));
+    previous = phase.second;
+  }
+
+  qInfo().noquote() << "Startup times:" << report << "- total:" << previous
+                    << "ms";
+}
+
 /**
  * Register custom QML types, for the moment, we have:
  */
@@ -217,11 +229,16 @@ void Misc::ModuleManager::registerQmlTypes()
   qmlRegisterType<Widgets::FFTPlot>("SerialStudio", 1, 0, "FFTPlotModel");
   qmlRegisterType<Widgets::DataGrid>("SerialStudio", 1, 0, "DataGridModel");
   qmlRegisterType<Widgets::LEDPanel>("SerialStudio", 1, 0, "LEDPanelModel");
+  qmlRegisterType<Widgets::LineRenderer>("SerialStudio", 1, 0, "LineRenderer");
+  qmlRegisterType<Widgets::LEDRenderer>("SerialStudio", 1, 0, "LEDRenderer");
   qmlRegisterType<Widgets::Terminal>("SerialStudio", 1, 0, "TerminalWidget");
   qmlRegisterType<Widgets::MultiPlot>("SerialStudio", 1, 0, "MultiPlotModel");
   qmlRegisterType<Widgets::Gyroscope>("SerialStudio", 1, 0, "GyroscopeModel");
+  qmlRegisterType<Widgets::Waterfall>("SerialStudio", 1, 0, "WaterfallModel");
   qmlRegisterType<Widgets::Accelerometer>("SerialStudio", 1, 0,
                                           "AccelerometerModel");
+  qmlRegisterType<Widgets::WaterfallRenderer>("SerialStudio", 1, 0,
+                                              "WaterfallRenderer");
 
   // Register JSON custom items
   qmlRegisterType<JSON::FrameParser>("SerialStudio", 1, 0, "FrameParser");
@@ -237,18 +254,37 @@ void Misc::ModuleManager::registerQmlTypes()
 /**
  * Initializes all the application modules, registers them with the QML engine
  * and loads the "main.qml" file as the root QML file.
+ *
+ * If @a loadUserInterface is @c false, the main window is not loaded & log
+ * messages are not redirected, so that command line tools (such as the widget
+ * benchmark) can instantiate QML components that use the C++ modules.
  */
-void Misc::ModuleManager::initializeQmlInterface()
+void Misc::ModuleManager::initializeQmlInterface(const bool loadUserInterface)
 {
   // Initialize modules
   auto csvExport = &CSV::Export::instance();
   auto csvPlayer = &CSV::Player::instance();
+  auto csvReference = &CSV::Reference::instance();
+  auto csvArrowExport = &CSV::ArrowExport::instance();
+  auto csvBinaryExport = &CSV::BinaryExport::instance();
+  auto csvTsdbExport = &CSV::TsdbExport::instance();
+  auto csvFlightRecorder = &CSV::FlightRecorder::instance();
   auto ioManager = &IO::Manager::instance();
   auto ioConsole = &IO::Console::instance();
+  auto ioRawCapture = &IO::RawCapture::instance();
   auto mqttClient = &MQTT::Client::instance();
   auto uiDashboard = &UI::Dashboard::instance();
+  auto uiDashboardRecorder = &UI::DashboardRecorder::instance();
   auto ioSerial = &IO::Drivers::Serial::instance();
+  auto ioReplay = &IO::Drivers::Replay::instance();
+  auto ioGenerator = &IO::Drivers::Generator::instance();
+  auto ioCanBus = &IO::Drivers::CANBus::instance();
+  auto ioModbus = &IO::Drivers::Modbus::instance();
+  auto ioUsb = &IO::Drivers::USB::instance();
+  auto ioAudio = &IO::Drivers::Audio::instance();
+  auto ioPipe = &IO::Drivers::Pipe::instance();
   auto pluginsBridge = &Plugins::Server::instance();
+  auto pluginsViewer = &Plugins::Viewer::instance();
   auto miscUtilities = &Misc::Utilities::instance();
   auto ioNetwork = &IO::Drivers::Network::instance();
   auto frameBuilder = &JSON::FrameBuilder::instance();
@@ -257,11 +293,22 @@ void Misc::ModuleManager::initializeQmlInterface()
   auto miscTimerEvents = &Misc::TimerEvents::instance();
   auto miscCommonFonts = &Misc::CommonFonts::instance();
   auto miscThemeManager = &Misc::ThemeManager::instance();
+  auto miscPipelineStats = &Misc::PipelineStats::instance();
+  auto miscOverloadController = &Misc::OverloadController::instance();
+  auto miscGraphicsBackend = &Misc::GraphicsBackend::instance();
+  auto miscThreadScheduler = &Misc::ThreadScheduler::instance();
+  auto miscAlarmEngine = &Misc::AlarmEngine::instance();
+  auto miscDatasetStatistics = &Misc::DatasetStatistics::instance();
+  auto miscTileCache = &Misc::TileCache::instance();
   auto ioBluetoothLE = &IO::Drivers::BluetoothLE::instance();
   auto ioFileTransmission = &IO::FileTransmission::instance();
 
   // Initialize third-party modules
   auto updater = QSimpleUpdater::getInstance();
+  markStartupPhase("modules");
+
+  // Load the fonts & rasterize their common glyphs in the background
+  miscCommonFonts->warmUp();
 
   // Start common event timers
   miscTimerEvents->startTimers();
@@ -280,13 +327,24 @@ void Misc::ModuleManager::initializeQmlInterface()
   c->setContextProperty("Cpp_IO_Serial", ioSerial);
   c->setContextProperty("Cpp_CSV_Export", csvExport);
   c->setContextProperty("Cpp_CSV_Player", csvPlayer);
+  c->setContextProperty("Cpp_CSV_Reference", csvReference);
   c->setContextProperty("Cpp_IO_Console", ioConsole);
   c->setContextProperty("Cpp_IO_Manager", ioManager);
   c->setContextProperty("Cpp_IO_Network", ioNetwork);
+  c->setContextProperty("Cpp_IO_Replay", ioReplay);
+  c->setContextProperty("Cpp_IO_Generator", ioGenerator);
+  c->setContextProperty("Cpp_IO_CANBus", ioCanBus);
+  c->setContextProperty("Cpp_IO_Modbus", ioModbus);
+  c->setContextProperty("Cpp_IO_USB", ioUsb);
+  c->setContextProperty("Cpp_IO_Audio", ioAudio);
+  c->setContextProperty("Cpp_IO_Pipe", ioPipe);
+  c->setContextProperty("Cpp_IO_RawCapture", ioRawCapture);
   c->setContextProperty("Cpp_MQTT_Client", mqttClient);
   c->setContextProperty("Cpp_UI_Dashboard", uiDashboard);
+  c->setContextProperty("Cpp_UI_DashboardRecorder", uiDashboardRecorder);
   c->setContextProperty("Cpp_NativeWindow", &m_nativeWindow);
   c->setContextProperty("Cpp_Plugins_Bridge", pluginsBridge);
+  c->setContextProperty("Cpp_Plugins_Viewer", pluginsViewer);
   c->setContextProperty("Cpp_Misc_Utilities", miscUtilities);
   c->setContextProperty("Cpp_IO_Bluetooth_LE", ioBluetoothLE);
   c->setContextProperty("Cpp_ThemeManager", miscThemeManager);
@@ -295,6 +353,17 @@ void Misc::ModuleManager::initializeQmlInterface()
   c->setContextProperty("Cpp_JSON_FrameBuilder", frameBuilder);
   c->setContextProperty("Cpp_Misc_TimerEvents", miscTimerEvents);
   c->setContextProperty("Cpp_Misc_CommonFonts", miscCommonFonts);
+  c->setContextProperty("Cpp_Misc_PipelineStats", miscPipelineStats);
+  c->setContextProperty("Cpp_Misc_OverloadController", miscOverloadController);
+  c->setContextProperty("Cpp_Misc_GraphicsBackend", miscGraphicsBackend);
+  c->setContextProperty("Cpp_Misc_ThreadScheduler", miscThreadScheduler);
+  c->setContextProperty("Cpp_Misc_AlarmEngine", miscAlarmEngine);
+  c->setContextProperty("Cpp_Misc_DatasetStatistics", miscDatasetStatistics);
+  c->setContextProperty("Cpp_Misc_TileCache", miscTileCache);
+  c->setContextProperty("Cpp_CSV_ArrowExport", csvArrowExport);
+  c->setContextProperty("Cpp_CSV_BinaryExport", csvBinaryExport);
+  c->setContextProperty("Cpp_CSV_TsdbExport", csvTsdbExport);
+  c->setContextProperty("Cpp_CSV_FlightRecorder", csvFlightRecorder);
   c->setContextProperty("Cpp_IO_FileTransmission", ioFileTransmission);
 
   // Register app info with QML
@@ -309,17 +378,72 @@ void Misc::ModuleManager::initializeQmlInterface()
   c->setContextProperty("Cpp_AppOrganizationDomain",
                         qApp->organizationDomain());
 
+  // Let the dashboard recorder instantiate the dashboard offscreen
+  uiDashboardRecorder->setEngine(&m_engine);
+
   // Load main.qml
-  m_engine.load(QUrl(QStringLiteral("qrc:/qml/main.qml")));
+  if (loadUserInterface)
+  {
+    m_engine.load(QUrl(QStringLiteral("qrc:/qml/main.qml")));
+    markStartupPhase("qml");
+  }
 
   // Setup singleton module interconnections
   ioSerial->setupExternalConnections();
   csvExport->setupExternalConnections();
   ioConsole->setupExternalConnections();
   ioManager->setupExternalConnections();
+  ioRawCapture->setupExternalConnections();
+  csvArrowExport->setupExternalConnections();
+  csvBinaryExport->setupExternalConnections();
+  csvReference->setupExternalConnections();
+  csvTsdbExport->setupExternalConnections();
+  csvFlightRecorder->setupExternalConnections();
   projectModel->setupExternalConnections();
   frameBuilder->setupExternalConnections();
+  pluginsViewer->setupExternalConnections();
+  miscPipelineStats->setupExternalConnections();
+  miscOverloadController->setupExternalConnections();
+  miscGraphicsBackend->setupExternalConnections();
+  miscThreadScheduler->setupExternalConnections();
+  miscAlarmEngine->setupExternalConnections();
+  miscDatasetStatistics->setupExternalConnections();
+
+  // No user interface, nothing else to do
+  if (!loadUserInterface)
+    return;
+
+  // Measure end-to-end latency when a new image is presented on screen, and
+  // adapt the UI refresh rate to the visibility of the windows
+  bool firstWindow = true;
+  for (auto *object : m_engine.rootObjects())
+  {
+    auto *window = qobject_cast<QQuickWindow *>(object);
+    if (window)
+    {
+      miscCommonFonts->warmUpWindow(window);
+      miscTimerEvents->trackWindow(window);
+      connect(window, &QQuickWindow::frameSwapped, uiDashboard,
+              &UI::Dashboard::onFrameSwapped, Qt::DirectConnection);
+
+      // Report the startup times once the first image is on screen, and
+      // measure the frame times of the main window
+      if (firstWindow)
+      {
+        firstWindow = false;
+        miscGraphicsBackend->trackWindow(window);
+        connect(
+            window, &QQuickWindow::frameSwapped, this,
+            [=] {
+              markStartupPhase("first frame");
+              reportStartupTimes();
+            },
+            static_cast<Qt::ConnectionType>(Qt::QueuedConnection
+                                            | Qt::SingleShotConnection));
+      }
+    }
+  }
 
   // Install custom message handler to redirect qDebug output to console
-  qInstallMessageHandler(MessageHandler);
+  qInstallMessageHandler(Misc::Logger::messageHandler);
 }
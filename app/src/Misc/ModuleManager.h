@@ -23,6 +23,7 @@
 #pragma once
 
 #include <QObject>
+#include <QElapsedTimer>
 #include <QQmlApplicationEngine>
 
 #include "Platform/NativeWindow.h"
@@ -34,6 +35,10 @@ namespace Misc
  *
  * The @c ModuleManager class is in charge of initializing all the C++ modules
  * that are part of Serial Studio in the correct order.
+ *
+ * The time spent in each startup phase (module initialization, loading of the
+ * QML user interface & presentation of the first frame) is measured and
+ * logged once the main window is on screen.
  */
 class ModuleManager : public QObject
 {
@@ -44,16 +49,23 @@ public:
   ModuleManager();
 
   [[nodiscard]] bool autoUpdaterEnabled() const;
+  [[nodiscard]] QQmlApplicationEngine &engine();
   [[nodiscard]] const QQmlApplicationEngine &engine() const;
 
 public slots:
   void onQuit();
   void configureUpdater();
   void registerQmlTypes();
-  void initializeQmlInterface();
+  void initializeQmlInterface(const bool loadUserInterface = true);
+
+private:
+  void markStartupPhase(const char *phase);
+  void reportStartupTimes();
 
 private:
   NativeWindow m_nativeWindow;
   QQmlApplicationEngine m_engine;
+  QElapsedTimer m_startupTimer;
+  QList<QPair<const char *, qint64>> m_startupPhases;
 };
 } // namespace Misc
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include <QtGlobal>
+
+namespace Misc
+{
+/**
+ * @class Misc::MpscQueue
+ * @brief Fixed-capacity, lock-free queue for many producers & one consumer.
+ *
+ * Works like @c Misc::SpscQueue, but any number of threads may call
+ * @c tryPush() at the same time. Each slot has a sequence number that tells
+ * producers whether the slot is free, so that a producer only has to claim a
+ * position with a compare-and-swap on the tail, and the consumer never
+ * waits for producers that are not done writing their slot (bounded queue
+ * design by Dmitry Vyukov).
+ *
+ * Only one thread (the consumer) may call @c tryPop() at a time.
+ *
+ * @tparam T Type of the queued objects, must be default-constructible.
+ */
+template<typename T>
+class MpscQueue
+{
+public:
+  /**
+   * @brief Constructs the queue.
+   *
+   * @param capacity Minimum number of objects that the queue can hold, it is
+   *                 rounded up to the next power of two.
+   */
+  explicit MpscQueue(const std::size_t capacity = 1024)
+    : m_head(0)
+    , m_tail(0)
+  {
+    std::size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+
+    m_mask = size - 1;
+    m_slots = std::make_unique<Slot[]>(size);
+    for (std::size_t i = 0; i < size; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the number of objects that the queue can hold.
+   */
+  [[nodiscard]] std::size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * @brief Appends a copy of @a item to the queue (any thread).
+   *
+   * @return @c false if the queue is full & the item was not added.
+   */
+  bool tryPush(const T &item)
+  {
+    Slot *slot = nullptr;
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      slot = &m_slots[tail & m_mask];
+      const auto sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence)
+                        - static_cast<std::ptrdiff_t>(tail);
+
+      // The slot is free, try to claim its position
+      if (diff == 0)
+      {
+        if (m_tail.compare_exchange_weak(tail, tail + 1,
+                                         std::memory_order_relaxed))
+          break;
+      }
+
+      // The slot still holds an object from the previous lap
+      else if (diff < 0)
+        return false;
+
+      // Another producer claimed the position first
+      else
+        tail = m_tail.load(std::memory_order_relaxed);
+    }
+
+    slot->item = item;
+    slot->sequence.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Takes the oldest object of the queue (consumer thread only).
+   *
+   * @param item Receives the object.
+   * @return @c false if the queue is empty, or if the producer of the oldest
+   *         object has not finished writing it yet.
+   */
+  bool tryPop(T &item)
+  {
+    auto &slot = m_slots[m_head & m_mask];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != m_head + 1)
+      return false;
+
+    item = std::move(slot.item);
+    slot.item = T();
+    slot.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    ++m_head;
+    return true;
+  }
+
+private:
+  /**
+   * @brief Queued object & the sequence number that tells its state.
+   */
+  struct Slot
+  {
+    std::atomic<std::size_t> sequence;
+    T item;
+  };
+
+  std::size_t m_mask;
+  std::unique_ptr<Slot[]> m_slots;
+
+  alignas(64) std::size_t m_head;
+  alignas(64) std::atomic<std::size_t> m_tail;
+};
+} // namespace Misc
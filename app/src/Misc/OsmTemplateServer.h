@@ -23,6 +23,8 @@
 #include <QRegularExpression>
 #include <QDebug>
 
+#include "Misc/TileCache.h"
+
 class OsmTemplateServer : public QTcpServer
 {
   Q_OBJECT
@@ -81,6 +83,7 @@ private slots:
       {
         bool hires = tokens[1].contains("hires");
         QString hiresURL = hires ? "@2x" : "";
+        QString provider = tokens[1].mid(1);
         QString xml, url;
         if ((tokens[1] == "/street") || (tokens[1] == "/street-hires"))
         {
@@ -92,6 +95,7 @@ private slots:
           else
           {
             url = "https://tile.openstreetmap.org/%z/%x/%y.png";
+            url = Misc::TileCache::instance().localTemplate(provider, url);
           }
           xml = QString("\
                         {\
@@ -118,6 +122,7 @@ private slots:
                           "%y%1.jpg?key=%2")
                       .arg(hiresURL)
                       .arg(m_maptilerAPIKey);
+            url = Misc::TileCache::instance().localTemplate(provider, url);
           }
           xml = QString("\
                     {\
@@ -154,6 +159,7 @@ private slots:
             url = QString("http://1.basemaps.cartocdn.com/%2/%z/%x/%y.png%1")
                       .arg(hiresURL)
                       .arg(mapUrl[idx]);
+            url = Misc::TileCache::instance().localTemplate(provider, url);
           }
           xml = QString("\
                     {\
@@ -197,6 +203,7 @@ private slots:
                         .arg(mapUrl[idx])
                         .arg(m_thunderforestAPIKey)
                         .arg(hiresURL);
+              url = Misc::TileCache::instance().localTemplate(provider, url);
             }
             xml = QString("\
                         {\
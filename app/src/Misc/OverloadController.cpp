@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/OverloadController.h"
+
+#include <algorithm>
+
+#include <QDebug>
+
+#include "IO/Manager.h"
+#include "Misc/TimerEvents.h"
+
+/**
+ * @brief Default queue fill (in percent) at which load is shed.
+ */
+static constexpr int kDefaultThreshold = 50;
+
+/**
+ * @brief Default fraction of the frames processed by the dashboard while the
+ *        application is degraded.
+ */
+static constexpr int kDefaultDecimation = 4;
+
+/**
+ * @brief Number of consecutive samples (at 10 Hz) below the recovery limit
+ *        after which the controller steps down one level.
+ */
+static constexpr int kRecoverySamples = 10;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, uses the default policy until a project is loaded.
+ */
+Misc::OverloadController::OverloadController()
+  : m_load(0)
+  , m_belowSamples(0)
+  , m_level(Normal)
+  , m_threshold(kDefaultThreshold)
+  , m_decimation(kDefaultDecimation)
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::OverloadController &Misc::OverloadController::instance()
+{
+  static OverloadController singleton;
+  return singleton;
+}
+
+//------------------------------------------------------------------------------
+// Member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the fill (in percent) of the fullest pipeline queue during the last
+ * sampling interval.
+ */
+int Misc::OverloadController::load() const
+{
+  return m_load / 10;
+}
+
+/**
+ * Returns the current @c Level of the controller. This function is
+ * thread-safe.
+ */
+int Misc::OverloadController::level() const
+{
+  return m_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns @c true if the dashboard only processes a fraction of the frames.
+ */
+bool Misc::OverloadController::degraded() const
+{
+  return level() == Degraded;
+}
+
+/**
+ * @brief Returns @c true if the plugin & MQTT consumers must shed frames.
+ *
+ * This function is thread-safe & lock-free, consumers call it for each frame.
+ */
+bool Misc::OverloadController::shedding() const
+{
+  return level() != Normal;
+}
+
+/**
+ * @brief Returns the dashboard decimation factor (one out of N frames).
+ *
+ * The factor is 1 unless the application is degraded. This function is
+ * thread-safe & lock-free.
+ */
+int Misc::OverloadController::uiDecimation() const
+{
+  if (!degraded())
+    return 1;
+
+  return m_decimation.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Queue registration
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Registers the @a depth of a pipeline @a queue that holds up to
+ *        @a capacity items.
+ *
+ * Only the highest fill reported during a sampling interval is kept. This
+ * function is thread-safe & lock-free.
+ */
+void Misc::OverloadController::reportQueue(const Queue queue,
+                                           const qint64 depth,
+                                           const qint64 capacity)
+{
+  if (capacity <= 0 || depth <= 0)
+    return;
+
+  // Express the fill in permille, so that integer atomics can be used
+  const auto fill
+      = static_cast<int>(std::min<qint64>(1000, depth * 1000 / capacity));
+
+  // Keep the highest fill of the interval
+  auto &slot = m_fill[queue];
+  auto max = slot.load(std::memory_order_relaxed);
+  while (fill > max
+         && !slot.compare_exchange_weak(max, fill, std::memory_order_relaxed))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+// Public slots
+//------------------------------------------------------------------------------
+
+/**
+ * Clears the queue samples & leaves the overloaded state.
+ */
+void Misc::OverloadController::reset()
+{
+  for (auto &fill : m_fill)
+    fill.store(0, std::memory_order_relaxed);
+
+  m_belowSamples = 0;
+  if (m_load != 0)
+  {
+    m_load = 0;
+    Q_EMIT loadChanged();
+  }
+
+  if (m_level.exchange(Normal, std::memory_order_relaxed) != Normal)
+    Q_EMIT levelChanged();
+}
+
+/**
+ * Samples the pipeline queues periodically & starts from a clean state every
+ * time a device is connected.
+ */
+void Misc::OverloadController::setupExternalConnections()
+{
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout10Hz,
+          this, &Misc::OverloadController::sample);
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          [=] {
+            if (IO::Manager::instance().connected())
+              reset();
+          });
+}
+
+/**
+ * @brief Changes the load shedding policy.
+ *
+ * @param threshold Queue fill (in percent) at which load is shed, or 0 to
+ *                  never shed load.
+ * @param decimation Fraction of the frames (one out of N) processed by the
+ *                   dashboard while the application is degraded.
+ */
+void Misc::OverloadController::setPolicy(const int threshold,
+                                         const int decimation)
+{
+  m_threshold.store(qBound(0, threshold, 100), std::memory_order_relaxed);
+  m_decimation.store(qMax(1, decimation), std::memory_order_relaxed);
+  reset();
+}
+
+//------------------------------------------------------------------------------
+// Level evaluation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Updates the level of the controller from the fullest queue of the
+ *        last sampling interval.
+ */
+void Misc::OverloadController::sample()
+{
+  // Obtain the fill of the fullest queue & start a new interval
+  int load = 0;
+  for (auto &fill : m_fill)
+    load = std::max(load, fill.exchange(0, std::memory_order_relaxed));
+
+  const bool changed = load / 10 != m_load / 10;
+  m_load = load;
+  if (changed)
+    Q_EMIT loadChanged();
+
+  // Never shed load if the policy disables it
+  const auto threshold = m_threshold.load(std::memory_order_relaxed) * 10;
+  const auto current = m_level.load(std::memory_order_relaxed);
+  int next = current;
+  if (threshold <= 0)
+    next = Normal;
+
+  // Escalate as soon as the load crosses a limit
+  else
+  {
+    const auto degradeLimit = (threshold + 1000) / 2;
+    int target = Normal;
+    if (load >= degradeLimit)
+      target = Degraded;
+    else if (load >= threshold)
+      target = Shedding;
+
+    if (target > current)
+    {
+      next = target;
+      m_belowSamples = 0;
+    }
+
+    // Step down one level once the load stays below the recovery limit
+    else if (current != Normal)
+    {
+      const auto limit = current == Degraded ? threshold : threshold / 2;
+      if (load < limit)
+        ++m_belowSamples;
+      else
+        m_belowSamples = 0;
+
+      if (m_belowSamples >= kRecoverySamples)
+      {
+        next = current - 1;
+        m_belowSamples = 0;
+      }
+    }
+  }
+
+  // Update the level
+  if (next != current)
+  {
+    m_level.store(next, std::memory_order_relaxed);
+    if (next > current)
+      qWarning() << "Pipeline overloaded at" << load / 10
+                 << "% queue fill, shedding load (level" << next << ")";
+    else
+      qWarning() << "Pipeline load reduced to" << load / 10
+                 << "% queue fill (level" << next << ")";
+
+    Q_EMIT levelChanged();
+  }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <QObject>
+
+namespace Misc
+{
+/**
+ * @brief The OverloadController class
+ *
+ * Watches the fill of the queues of the data pipeline and sheds load in a
+ * fixed order when the application cannot keep up with the incoming data.
+ *
+ * The frame reader buffer, the frame parser, the dashboard frame queue, the
+ * plugin server queue & the MQTT publisher queue report their depth with
+ * @c reportQueue(), which may be called from any thread. Ten times per second,
+ * the controller takes the fullest queue as the load of the pipeline and
+ * compares it against the policy of the project:
+ *
+ * - @c Normal: every consumer receives every frame.
+ * - @c Shedding: the load reached the overload threshold. Frames are no longer
+ *   sent to the plugins, and the MQTT client only publishes priority datasets.
+ * - @c Degraded: the load kept growing halfway between the threshold and a
+ *   full queue. The dashboard also processes one out of N frames, and a
+ *   "degraded" indicator is shown over the dashboard.
+ *
+ * The CSV export, the flight recorder & the alarm engine are never shed, so
+ * every frame still reaches the recordings & alarms.
+ *
+ * The controller escalates as soon as a sample crosses a limit and steps down
+ * one level after the load stays below the limit for a second, which keeps it
+ * from oscillating around the threshold.
+ */
+class OverloadController : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int level
+             READ level
+             NOTIFY levelChanged)
+  Q_PROPERTY(bool degraded
+             READ degraded
+             NOTIFY levelChanged)
+  Q_PROPERTY(int load
+             READ load
+             NOTIFY loadChanged)
+  // clang-format on
+
+signals:
+  void loadChanged();
+  void levelChanged();
+
+private:
+  explicit OverloadController();
+  OverloadController(OverloadController &&) = delete;
+  OverloadController(const OverloadController &) = delete;
+  OverloadController &operator=(OverloadController &&) = delete;
+  OverloadController &operator=(const OverloadController &) = delete;
+
+public:
+  enum Level
+  {
+    Normal,
+    Shedding,
+    Degraded
+  };
+  Q_ENUM(Level)
+
+  enum Queue
+  {
+    FrameReaderBuffer,
+    ParserLag,
+    DashboardQueue,
+    PluginQueue,
+    MqttQueue,
+    QueueCount
+  };
+  Q_ENUM(Queue)
+
+  static OverloadController &instance();
+
+  [[nodiscard]] int load() const;
+  [[nodiscard]] int level() const;
+  [[nodiscard]] bool degraded() const;
+  [[nodiscard]] bool shedding() const;
+  [[nodiscard]] int uiDecimation() const;
+
+  void reportQueue(const Queue queue, const qint64 depth,
+                   const qint64 capacity);
+
+public slots:
+  void reset();
+  void setupExternalConnections();
+  void setPolicy(const int threshold, const int decimation);
+
+private slots:
+  void sample();
+
+private:
+  int m_load;
+  int m_belowSamples;
+
+  std::atomic<int> m_level;
+  std::atomic<int> m_threshold;
+  std::atomic<int> m_decimation;
+  std::array<std::atomic<int>, QueueCount> m_fill{};
+};
+} // namespace Misc
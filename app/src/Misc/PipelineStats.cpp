@@ -0,0 +1,696 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/PipelineStats.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QVariantMap>
+#include <QtAlgorithms>
+
+#include "IO/Manager.h"
+#include "IO/CircularBuffer.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/SessionClock.h"
+
+// Bytes in a mebibyte, used to express memory budgets
+static constexpr qint64 kMiB = 1024 * 1024;
+
+//------------------------------------------------------------------------------
+// Constructor & singleton access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function, restores the visibility of the dashboard overlay.
+ */
+Misc::PipelineStats::PipelineStats()
+  : m_overlayVisible(false)
+{
+  m_overlayVisible = m_settings.value("pipeline_stats_overlay", false).toBool();
+  m_interval.start();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::PipelineStats &Misc::PipelineStats::instance()
+{
+  static PipelineStats singleton;
+  return singleton;
+}
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ *
+ * Stages use the difference between two timestamps as the latency that is
+ * given to @c record().
+ */
+qint64 Misc::PipelineStats::timestamp()
+{
+  return Misc::SessionClock::now();
+}
+
+//------------------------------------------------------------------------------
+// Member access functions
+//------------------------------------------------------------------------------
+
+/**
+ * Returns @c true if the statistics overlay is displayed over the dashboard.
+ */
+bool Misc::PipelineStats::overlayVisible() const
+{
+  return m_overlayVisible;
+}
+
+/**
+ * @brief Returns the statistics of the last interval for the user interface.
+ *
+ * Each item is a map with the translated @c name of the stage, the number of
+ * @c items & @c bytes per second, the total number of @c drops and the
+ * @c p50, @c p99 and @c max latencies in microseconds.
+ */
+QVariantList Misc::PipelineStats::stages() const
+{
+  QVariantList list;
+  for (int i = 0; i < StageCount; ++i)
+  {
+    const auto &s = m_snapshots[i];
+
+    QVariantMap map;
+    map.insert(QStringLiteral("name"), stageName(static_cast<Stage>(i)));
+    map.insert(QStringLiteral("items"), s.itemsPerSecond);
+    map.insert(QStringLiteral("bytes"), s.bytesPerSecond);
+    map.insert(QStringLiteral("drops"), s.drops);
+    map.insert(QStringLiteral("p50"), s.p50LatencyUs);
+    map.insert(QStringLiteral("p99"), s.p99LatencyUs);
+    map.insert(QStringLiteral("max"), s.maxLatencyUs);
+    list.append(map);
+  }
+
+  return list;
+}
+
+/**
+ * @brief Returns the memory usage of each subsystem for the user interface.
+ *
+ * Each item is a map with the translated @c name of the subsystem, its memory
+ * usage & budget in @c bytes and @c budget, and an @c exceeded flag that is
+ * set when the subsystem uses more memory than its budget.
+ */
+QVariantList Misc::PipelineStats::memory() const
+{
+  QVariantList list;
+  for (int i = 0; i < MemoryOwnerCount; ++i)
+  {
+    const auto owner = static_cast<MemoryOwner>(i);
+    const auto bytes = m_memorySnapshot[i];
+    const auto budget = memoryBudget(owner);
+
+    QVariantMap map;
+    map.insert(QStringLiteral("name"), memoryName(owner));
+    map.insert(QStringLiteral("bytes"), bytes);
+    map.insert(QStringLiteral("budget"), budget);
+    map.insert(QStringLiteral("exceeded"), bytes > budget);
+    list.append(map);
+  }
+
+  return list;
+}
+
+/**
+ * @brief Returns the link integrity counters for the user interface.
+ *
+ * Each item is a map with the translated @c name of the counter, its total
+ * @c count since the device was connected and an @c error flag that is set
+ * when the counter reports lost data.
+ */
+QVariantList Misc::PipelineStats::integrity() const
+{
+  QVariantList list;
+  for (int i = 0; i < IntegrityCounterCount; ++i)
+  {
+    const auto counter = static_cast<IntegrityCounter>(i);
+    const auto count = m_integritySnapshot[i];
+
+    QVariantMap map;
+    map.insert(QStringLiteral("name"), integrityName(counter));
+    map.insert(QStringLiteral("count"), count);
+    map.insert(QStringLiteral("error"), count > 0 && counter != FrameSequence
+                                            && counter != BufferHighWater);
+    list.append(map);
+  }
+
+  return list;
+}
+
+/**
+ * @brief Returns the statistics of the last interval as a JSON object.
+ *
+ * The object has one key for each stage, which is an object with the
+ * @c itemsPerSecond, @c bytesPerSecond, total @c items, @c bytes & @c drops,
+ * and the @c p50LatencyUs, @c p99LatencyUs & @c maxLatencyUs values.
+ *
+ * The @c memory key contains one object for each subsystem, with its memory
+ * usage & budget in @c bytes and @c budgetBytes.
+ *
+ * The @c integrity key contains the value of each link integrity counter.
+ */
+QJsonObject Misc::PipelineStats::toJson() const
+{
+  QJsonObject object;
+  for (int i = 0; i < StageCount; ++i)
+  {
+    const auto &s = m_snapshots[i];
+
+    QJsonObject stage;
+    stage.insert(QStringLiteral("items"), static_cast<qint64>(s.items));
+    stage.insert(QStringLiteral("bytes"), static_cast<qint64>(s.bytes));
+    stage.insert(QStringLiteral("drops"), static_cast<qint64>(s.drops));
+    stage.insert(QStringLiteral("itemsPerSecond"), s.itemsPerSecond);
+    stage.insert(QStringLiteral("bytesPerSecond"), s.bytesPerSecond);
+    stage.insert(QStringLiteral("p50LatencyUs"), s.p50LatencyUs);
+    stage.insert(QStringLiteral("p99LatencyUs"), s.p99LatencyUs);
+    stage.insert(QStringLiteral("maxLatencyUs"), s.maxLatencyUs);
+    object.insert(stageKey(static_cast<Stage>(i)), stage);
+  }
+
+  QJsonObject memory;
+  for (int i = 0; i < MemoryOwnerCount; ++i)
+  {
+    const auto owner = static_cast<MemoryOwner>(i);
+
+    QJsonObject subsystem;
+    subsystem.insert(QStringLiteral("bytes"), m_memorySnapshot[i]);
+    subsystem.insert(QStringLiteral("budgetBytes"), memoryBudget(owner));
+    memory.insert(memoryKey(owner), subsystem);
+  }
+
+  QJsonObject integrity;
+  for (int i = 0; i < IntegrityCounterCount; ++i)
+  {
+    const auto counter = static_cast<IntegrityCounter>(i);
+    integrity.insert(integrityKey(counter),
+                     static_cast<qint64>(m_integritySnapshot[i]));
+  }
+
+  object.insert(QStringLiteral("memory"), memory);
+  object.insert(QStringLiteral("integrity"), integrity);
+  return object;
+}
+
+//------------------------------------------------------------------------------
+// Statistics registration
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Registers @a items that were discarded by the given @a stage.
+ *
+ * This function is thread-safe & lock-free.
+ */
+void Misc::PipelineStats::recordDrops(const Stage stage, const quint64 items)
+{
+  auto &c = m_counters[stage];
+  c.drops.fetch_add(items, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Registers the activity of the given @a stage.
+ *
+ * This function is thread-safe & lock-free.
+ *
+ * @param stage The stage that processed the data.
+ * @param items Number of items (chunks, frames or messages) processed.
+ * @param bytes Number of bytes processed.
+ * @param latencyNs Time it took to process the items, or a negative value if
+ *                  the stage does not measure its latency.
+ */
+void Misc::PipelineStats::record(const Stage stage, const quint64 items,
+                                 const quint64 bytes, const qint64 latencyNs)
+{
+  auto &c = m_counters[stage];
+  c.items.fetch_add(items, std::memory_order_relaxed);
+  c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  if (latencyNs < 0)
+    return;
+
+  // Bucket 0 holds latencies below 1 µs, bucket N holds [2^(N-1), 2^N) µs
+  const auto us = static_cast<quint64>(latencyNs / 1000);
+  int bucket = 0;
+  if (us > 0)
+  {
+    const auto bits = 64 - static_cast<int>(qCountLeadingZeroBits(us));
+    bucket = std::min(kHistogramBuckets - 1, bits);
+  }
+
+  c.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  // Update the maximum latency of the current interval
+  auto max = c.maxLatency.load(std::memory_order_relaxed);
+  while (latencyNs > max
+         && !c.maxLatency.compare_exchange_weak(max, latencyNs,
+                                                std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * @brief Adds @a bytes (which may be negative) to the memory usage of the
+ *        given @a owner.
+ *
+ * Used by subsystems that have several instances, such as terminal widgets,
+ * each instance adds the change of its own memory usage. This function is
+ * thread-safe & lock-free.
+ */
+void Misc::PipelineStats::addMemoryUsage(const MemoryOwner owner,
+                                         const qint64 bytes)
+{
+  m_memory[owner].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the memory usage of the given @a owner to @a bytes.
+ *
+ * This function is thread-safe & lock-free.
+ */
+void Misc::PipelineStats::setMemoryUsage(const MemoryOwner owner,
+                                         const qint64 bytes)
+{
+  m_memory[owner].store(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the given integrity @a counter to @a value.
+ *
+ * Used for values that are not accumulated, such as the sequence number of
+ * the latest frame. This function is thread-safe & lock-free.
+ */
+void Misc::PipelineStats::setIntegrity(const IntegrityCounter counter,
+                                       const quint64 value)
+{
+  m_integrity[counter].store(value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Raises the given integrity @a counter to @a value if it is lower.
+ *
+ * Used for peak values reported by several owners, such as the high-water
+ * mark of the frame reader buffers. This function is thread-safe & lock-free.
+ */
+void Misc::PipelineStats::raiseIntegrity(const IntegrityCounter counter,
+                                         const quint64 value)
+{
+  auto current = m_integrity[counter].load(std::memory_order_relaxed);
+  while (current < value
+         && !m_integrity[counter].compare_exchange_weak(
+             current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * @brief Adds @a count events to the given integrity @a counter.
+ *
+ * This function is thread-safe & lock-free.
+ */
+void Misc::PipelineStats::recordIntegrity(const IntegrityCounter counter,
+                                          const quint64 count)
+{
+  m_integrity[counter].fetch_add(count, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Public slots
+//------------------------------------------------------------------------------
+
+/**
+ * Clears the statistics of every stage.
+ */
+void Misc::PipelineStats::reset()
+{
+  for (auto &c : m_counters)
+  {
+    c.items.store(0, std::memory_order_relaxed);
+    c.bytes.store(0, std::memory_order_relaxed);
+    c.drops.store(0, std::memory_order_relaxed);
+    c.maxLatency.store(0, std::memory_order_relaxed);
+    for (auto &bucket : c.histogram)
+      bucket.store(0, std::memory_order_relaxed);
+  }
+
+  for (auto &counter : m_integrity)
+    counter.store(0, std::memory_order_relaxed);
+
+  m_snapshots.fill(Snapshot());
+  m_integritySnapshot.fill(0);
+  m_interval.restart();
+  Q_EMIT statisticsChanged();
+}
+
+/**
+ * @brief Updates the snapshot once per second & clears the statistics when a
+ *        device is connected, so that each session starts from zero.
+ */
+void Misc::PipelineStats::setupExternalConnections()
+{
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &Misc::PipelineStats::updateSnapshot);
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          [=] {
+            if (IO::Manager::instance().connected())
+              reset();
+          });
+}
+
+/**
+ * Shows or hides the statistics overlay of the dashboard.
+ */
+void Misc::PipelineStats::setOverlayVisible(const bool visible)
+{
+  if (m_overlayVisible != visible)
+  {
+    m_overlayVisible = visible;
+    m_settings.setValue("pipeline_stats_overlay", visible);
+    Q_EMIT overlayVisibleChanged();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Snapshot generation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Computes the rates & latency percentiles of the last interval.
+ *
+ * Percentiles are obtained from the histogram entries added during the
+ * interval, and are reported as the upper bound of the matching bucket.
+ */
+void Misc::PipelineStats::updateSnapshot()
+{
+  // Obtain the duration of the interval
+  const auto seconds = std::max(1e-3, m_interval.restart() / 1000.0);
+
+  // Returns the growth of a cumulative counter
+  const auto delta = [](const quint64 current, const quint64 previous) {
+    return current >= previous ? current - previous : current;
+  };
+
+  // Update each stage
+  for (int i = 0; i < StageCount; ++i)
+  {
+    auto &c = m_counters[i];
+    auto &s = m_snapshots[i];
+
+    // Update rates
+    const auto items = c.items.load(std::memory_order_relaxed);
+    const auto bytes = c.bytes.load(std::memory_order_relaxed);
+    s.itemsPerSecond = delta(items, s.items) / seconds;
+    s.bytesPerSecond = delta(bytes, s.bytes) / seconds;
+    s.drops = c.drops.load(std::memory_order_relaxed);
+    s.items = items;
+    s.bytes = bytes;
+
+    // Obtain the latency histogram of the interval
+    quint64 samples = 0;
+    std::array<quint64, kHistogramBuckets> histogram;
+    for (int b = 0; b < kHistogramBuckets; ++b)
+    {
+      const auto value = c.histogram[b].load(std::memory_order_relaxed);
+      histogram[b] = delta(value, s.histogram[b]);
+      s.histogram[b] = value;
+      samples += histogram[b];
+    }
+
+    // Keep the previous latencies if the stage was idle
+    const auto max = c.maxLatency.exchange(0, std::memory_order_relaxed);
+    if (samples == 0)
+      continue;
+
+    // Obtain the percentiles
+    quint64 count = 0;
+    s.p50LatencyUs = 0;
+    s.p99LatencyUs = 0;
+    for (int b = 0; b < kHistogramBuckets; ++b)
+    {
+      count += histogram[b];
+      const double upperBound = static_cast<double>(quint64(1) << b);
+      if (s.p50LatencyUs == 0 && count * 2 >= samples)
+        s.p50LatencyUs = upperBound;
+      if (s.p99LatencyUs == 0 && count * 100 >= samples * 99)
+      {
+        s.p99LatencyUs = upperBound;
+        break;
+      }
+    }
+
+    s.maxLatencyUs = max / 1000.0;
+  }
+
+  // Update the memory usage, circular buffers keep their own global counter
+  setMemoryUsage(CircularBuffers, IO::circularBufferMemory().load());
+  for (int i = 0; i < MemoryOwnerCount; ++i)
+  {
+    const auto owner = static_cast<MemoryOwner>(i);
+    const auto bytes = m_memory[i].load(std::memory_order_relaxed);
+    const auto budget = memoryBudget(owner);
+    m_memorySnapshot[i] = bytes;
+
+    // Warn once each time the subsystem grows past its budget
+    if (bytes > budget && !m_memoryWarned[i])
+    {
+      qWarning() << memoryName(owner) << "uses" << bytes / kMiB
+                 << "MiB of memory, exceeding its budget of"
+                 << budget / kMiB << "MiB";
+    }
+
+    m_memoryWarned[i] = bytes > budget;
+  }
+
+  // Update the link integrity counters
+  for (int i = 0; i < IntegrityCounterCount; ++i)
+    m_integritySnapshot[i] = m_integrity[i].load(std::memory_order_relaxed);
+
+  Q_EMIT statisticsChanged();
+}
+
+//------------------------------------------------------------------------------
+// Stage names
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the key used to identify the given @a stage in the JSON statistics.
+ */
+QString Misc::PipelineStats::stageKey(const Stage stage)
+{
+  switch (stage)
+  {
+    case DriverReceive:
+      return QStringLiteral("driver");
+    case FrameReader:
+      return QStringLiteral("frameReader");
+    case FrameParser:
+      return QStringLiteral("frameParser");
+    case ParserScript:
+      return QStringLiteral("parserScript");
+    case Dashboard:
+      return QStringLiteral("dashboard");
+    case CsvExport:
+      return QStringLiteral("csvExport");
+    case MqttPublish:
+      return QStringLiteral("mqtt");
+    case PluginSend:
+      return QStringLiteral("plugins");
+    case PluginCommand:
+      return QStringLiteral("pluginCommands");
+    case EndToEnd:
+      return QStringLiteral("endToEnd");
+    default:
+      return QString();
+  }
+}
+
+/**
+ * Returns the user-visible name of the given @a stage.
+ */
+QString Misc::PipelineStats::stageName(const Stage stage)
+{
+  switch (stage)
+  {
+    case DriverReceive:
+      return tr("Driver");
+    case FrameReader:
+      return tr("Frame Reader");
+    case FrameParser:
+      return tr("Frame Parser");
+    case ParserScript:
+      return tr("Parser Script");
+    case Dashboard:
+      return tr("Dashboard");
+    case CsvExport:
+      return tr("CSV Export");
+    case MqttPublish:
+      return tr("MQTT");
+    case PluginSend:
+      return tr("Plugins");
+    case PluginCommand:
+      return tr("Plugin Commands");
+    case EndToEnd:
+      return tr("End-to-End");
+    default:
+      return QString();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Memory subsystems
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the key used to identify the given memory @a owner in the JSON
+ * statistics.
+ */
+QString Misc::PipelineStats::memoryKey(const MemoryOwner owner)
+{
+  switch (owner)
+  {
+    case CircularBuffers:
+      return QStringLiteral("circularBuffers");
+    case DashboardCurves:
+      return QStringLiteral("dashboardCurves");
+    case TerminalScrollback:
+      return QStringLiteral("terminalScrollback");
+    case CsvPlayer:
+      return QStringLiteral("csvPlayer");
+    case CsvExportQueue:
+      return QStringLiteral("csvExportQueue");
+    case PluginQueue:
+      return QStringLiteral("pluginQueue");
+    default:
+      return QString();
+  }
+}
+
+/**
+ * Returns the user-visible name of the given memory @a owner.
+ */
+QString Misc::PipelineStats::memoryName(const MemoryOwner owner)
+{
+  switch (owner)
+  {
+    case CircularBuffers:
+      return tr("Circular Buffers");
+    case DashboardCurves:
+      return tr("Plot Histories");
+    case TerminalScrollback:
+      return tr("Terminal Scrollback");
+    case CsvPlayer:
+      return tr("CSV Player");
+    case CsvExportQueue:
+      return tr("CSV Export Queue");
+    case PluginQueue:
+      return tr("Plugin Queues");
+    default:
+      return QString();
+  }
+}
+
+/**
+ * Returns the memory budget of the given @a owner in bytes, a warning is
+ * logged when the subsystem grows past this limit.
+ */
+qint64 Misc::PipelineStats::memoryBudget(const MemoryOwner owner)
+{
+  switch (owner)
+  {
+    case CircularBuffers:
+      return 128 * kMiB;
+    case DashboardCurves:
+      return 256 * kMiB;
+    case TerminalScrollback:
+      return 128 * kMiB;
+    case CsvPlayer:
+      return 256 * kMiB;
+    case CsvExportQueue:
+      return 256 * kMiB;
+    case PluginQueue:
+      return 128 * kMiB;
+    default:
+      return 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Link integrity counters
+//------------------------------------------------------------------------------
+
+/**
+ * Returns the key used to identify the given integrity @a counter in the JSON
+ * statistics.
+ */
+QString Misc::PipelineStats::integrityKey(const IntegrityCounter counter)
+{
+  switch (counter)
+  {
+    case FrameSequence:
+      return QStringLiteral("frameSequence");
+    case OverwrittenBytes:
+      return QStringLiteral("overwrittenBytes");
+    case RejectedBytes:
+      return QStringLiteral("rejectedBytes");
+    case BufferHighWater:
+      return QStringLiteral("bufferHighWater");
+    case ChecksumErrors:
+      return QStringLiteral("checksumErrors");
+    case IncompleteFrames:
+      return QStringLiteral("incompleteFrames");
+    case SequenceGaps:
+      return QStringLiteral("sequenceGaps");
+    default:
+      return QString();
+  }
+}
+
+/**
+ * Returns the user-visible name of the given integrity @a counter.
+ */
+QString Misc::PipelineStats::integrityName(const IntegrityCounter counter)
+{
+  switch (counter)
+  {
+    case FrameSequence:
+      return tr("Frame Sequence");
+    case OverwrittenBytes:
+      return tr("Overwritten Bytes");
+    case RejectedBytes:
+      return tr("Rejected Bytes");
+    case BufferHighWater:
+      return tr("Buffer High-Water Mark");
+    case ChecksumErrors:
+      return tr("Checksum Errors");
+    case IncompleteFrames:
+      return tr("Incomplete Frames");
+    case SequenceGaps:
+      return tr("Missing Device Frames");
+    default:
+      return QString();
+  }
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <QObject>
+#include <QSettings>
+#include <QJsonObject>
+#include <QVariantList>
+#include <QElapsedTimer>
+
+namespace Misc
+{
+/**
+ * @brief The PipelineStats class
+ *
+ * Keeps throughput, drop & latency statistics for each stage of the data
+ * pipeline: driver reception, frame extraction, frame parsing, the execution
+ * of the JS parser script, the dashboard, CSV export, MQTT publishing, the
+ * plugin server & the plugin command lane. The end-to-end stage measures the
+ * time between the arrival of the bytes of a frame at the driver and the
+ * presentation of the frame on screen.
+ *
+ * Stages report their activity with @c record() and @c recordDrops(), which
+ * only update relaxed atomic counters and may be called from any thread.
+ * Latencies are accumulated in logarithmic histograms (one bucket per power of
+ * two microseconds). Once per second, the counters are turned into a snapshot
+ * with the rates, the 50th/99th percentile and the maximum latency of the
+ * last interval, which is displayed by the optional dashboard overlay and sent
+ * to the plugins.
+ *
+ * The latency of a stage is the time it took to handle its items, including
+ * the time they waited in the input queue of the stage, if the stage has one.
+ *
+ * The class also keeps an estimate of the memory used by the largest owners
+ * of the application (buffers, plot histories, scrollback & queues), which
+ * report their usage with @c setMemoryUsage() or @c addMemoryUsage(). A
+ * warning is logged when a subsystem grows past its memory budget.
+ *
+ * Link integrity counters (see @c IntegrityCounter) keep track of the data
+ * lost before frames reach the parser: bytes overwritten or rejected by the
+ * frame reader buffer, checksum errors, incomplete frames & gaps in the frame
+ * counter sent by the device, next to the sequence number of the latest
+ * extracted frame & the high-water mark of the frame reader buffer.
+ */
+class PipelineStats : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool overlayVisible
+             READ overlayVisible
+             WRITE setOverlayVisible
+             NOTIFY overlayVisibleChanged)
+  Q_PROPERTY(QVariantList stages
+             READ stages
+             NOTIFY statisticsChanged)
+  Q_PROPERTY(QVariantList memory
+             READ memory
+             NOTIFY statisticsChanged)
+  Q_PROPERTY(QVariantList integrity
+             READ integrity
+             NOTIFY statisticsChanged)
+  // clang-format on
+
+signals:
+  void statisticsChanged();
+  void overlayVisibleChanged();
+
+private:
+  explicit PipelineStats();
+  PipelineStats(PipelineStats &&) = delete;
+  PipelineStats(const PipelineStats &) = delete;
+  PipelineStats &operator=(PipelineStats &&) = delete;
+  PipelineStats &operator=(const PipelineStats &) = delete;
+
+public:
+  enum Stage
+  {
+    DriverReceive,
+    FrameReader,
+    FrameParser,
+    ParserScript,
+    Dashboard,
+    CsvExport,
+    MqttPublish,
+    PluginSend,
+    PluginCommand,
+    EndToEnd,
+    StageCount
+  };
+  Q_ENUM(Stage)
+
+  enum MemoryOwner
+  {
+    CircularBuffers,
+    DashboardCurves,
+    TerminalScrollback,
+    CsvPlayer,
+    CsvExportQueue,
+    PluginQueue,
+    MemoryOwnerCount
+  };
+  Q_ENUM(MemoryOwner)
+
+  enum IntegrityCounter
+  {
+    FrameSequence,
+    OverwrittenBytes,
+    RejectedBytes,
+    BufferHighWater,
+    ChecksumErrors,
+    IncompleteFrames,
+    SequenceGaps,
+    IntegrityCounterCount
+  };
+  Q_ENUM(IntegrityCounter)
+
+  static PipelineStats &instance();
+  [[nodiscard]] static qint64 timestamp();
+
+  [[nodiscard]] bool overlayVisible() const;
+  [[nodiscard]] QVariantList stages() const;
+  [[nodiscard]] QVariantList memory() const;
+  [[nodiscard]] QVariantList integrity() const;
+  [[nodiscard]] QJsonObject toJson() const;
+
+  void recordDrops(const Stage stage, const quint64 items = 1);
+  void record(const Stage stage, const quint64 items, const quint64 bytes,
+              const qint64 latencyNs = -1);
+
+  void addMemoryUsage(const MemoryOwner owner, const qint64 bytes);
+  void setMemoryUsage(const MemoryOwner owner, const qint64 bytes);
+
+  void setIntegrity(const IntegrityCounter counter, const quint64 value);
+  void raiseIntegrity(const IntegrityCounter counter, const quint64 value);
+  void recordIntegrity(const IntegrityCounter counter,
+                       const quint64 count = 1);
+
+public slots:
+  void reset();
+  void setupExternalConnections();
+  void setOverlayVisible(const bool visible);
+
+private slots:
+  void updateSnapshot();
+
+private:
+  static constexpr int kHistogramBuckets = 32;
+
+  /**
+   * @brief Cumulative counters of a stage, updated from any thread.
+   */
+  struct Counters
+  {
+    std::atomic<quint64> items{0};
+    std::atomic<quint64> bytes{0};
+    std::atomic<quint64> drops{0};
+    std::atomic<qint64> maxLatency{0};
+    std::array<std::atomic<quint64>, kHistogramBuckets> histogram{};
+  };
+
+  /**
+   * @brief Statistics of a stage during the last interval.
+   */
+  struct Snapshot
+  {
+    quint64 items = 0;
+    quint64 bytes = 0;
+    quint64 drops = 0;
+    std::array<quint64, kHistogramBuckets> histogram{};
+
+    double itemsPerSecond = 0;
+    double bytesPerSecond = 0;
+    double p50LatencyUs = 0;
+    double p99LatencyUs = 0;
+    double maxLatencyUs = 0;
+  };
+
+  [[nodiscard]] static QString stageKey(const Stage stage);
+  [[nodiscard]] static QString stageName(const Stage stage);
+  [[nodiscard]] static QString memoryKey(const MemoryOwner owner);
+  [[nodiscard]] static QString memoryName(const MemoryOwner owner);
+  [[nodiscard]] static qint64 memoryBudget(const MemoryOwner owner);
+  [[nodiscard]] static QString integrityKey(const IntegrityCounter counter);
+  [[nodiscard]] static QString integrityName(const IntegrityCounter counter);
+
+private:
+  bool m_overlayVisible;
+  QSettings m_settings;
+  QElapsedTimer m_interval;
+
+  std::array<Counters, StageCount> m_counters;
+  std::array<Snapshot, StageCount> m_snapshots;
+
+  std::array<std::atomic<qint64>, MemoryOwnerCount> m_memory{};
+  std::array<qint64, MemoryOwnerCount> m_memorySnapshot{};
+  std::array<bool, MemoryOwnerCount> m_memoryWarned{};
+
+  std::array<std::atomic<quint64>, IntegrityCounterCount> m_integrity{};
+  std::array<quint64, IntegrityCounterCount> m_integritySnapshot{};
+};
+} // namespace Misc
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+#include <QtGlobal>
+
+namespace Misc
+{
+/**
+ * @class Misc::RingBus
+ * @brief Fixed-capacity broadcast ring for one producer & many consumers.
+ *
+ * Every published object is stored once, in a slot of the ring, and each
+ * consumer has its own read cursor, so that consumers in different threads
+ * read the same objects at their own pace without copying them to a queue of
+ * their own. Slots are preallocated and overwritten in place by the producer
+ * (disruptor design), which lets implicitly shared objects reuse the memory
+ * of their slot.
+ *
+ * The producer never waits for a slow consumer. When a consumer falls a whole
+ * ring behind, its cursor is moved forward according to its @c Policy and the
+ * skipped objects are added to its drop count. The only exception is a
+ * consumer that is copying the very slot being overwritten, which the
+ * producer waits for (a copy of a single object).
+ *
+ * Consumers are registered, attached & detached from the producer thread.
+ * @c tryRead() may be called from any thread, but only from one thread at a
+ * time for each consumer.
+ *
+ * @tparam T Type of the published objects, must be default-constructible.
+ */
+template<typename T>
+class RingBus
+{
+public:
+  /**
+   * @brief Action taken when a consumer falls a whole ring behind.
+   */
+  enum class Policy
+  {
+    DropOldest,
+    SkipToLatest
+  };
+
+  /**
+   * Maximum number of consumers of a ring
+   */
+  static constexpr int kMaxConsumers = 8;
+
+  /**
+   * @brief Constructs the ring.
+   *
+   * @param capacity Minimum number of objects that the ring can hold, it is
+   *                 rounded up to the next power of two.
+   */
+  explicit RingBus(const std::size_t capacity = 1024)
+    : m_published(0)
+    , m_consumerCount(0)
+  {
+    std::size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+
+    m_mask = size - 1;
+    m_items.resize(size);
+    for (auto &cursor : m_cursors)
+      cursor.next.store(kDetached, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the number of objects that the ring can hold.
+   */
+  [[nodiscard]] std::size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * @brief Registers a new consumer, which starts detached (producer thread).
+   *
+   * @return The consumer identifier, or -1 if the ring has no free cursors.
+   */
+  [[nodiscard]] int addConsumer(const Policy policy)
+  {
+    if (m_consumerCount >= kMaxConsumers)
+      return -1;
+
+    m_cursors[m_consumerCount].policy = policy;
+    return m_consumerCount++;
+  }
+
+  /**
+   * @brief Attaches the given @a consumer (producer thread).
+   *
+   * The consumer receives the latest published object & the objects
+   * published afterwards.
+   */
+  void attach(const int consumer)
+  {
+    Q_ASSERT(consumer >= 0 && consumer < m_consumerCount);
+    auto &cursor = m_cursors[consumer];
+    if (cursor.next.load(std::memory_order_acquire) != kDetached)
+      return;
+
+    const auto published = m_published.load(std::memory_order_relaxed);
+    cursor.next.store(qMax<quint64>(published, 1), std::memory_order_release);
+  }
+
+  /**
+   * @brief Detaches the given @a consumer (producer thread).
+   *
+   * Waits for the consumer to finish copying an object, if it is doing so.
+   */
+  void detach(const int consumer)
+  {
+    Q_ASSERT(consumer >= 0 && consumer < m_consumerCount);
+    auto &cursor = m_cursors[consumer];
+    auto next = cursor.next.load(std::memory_order_acquire);
+    while (next != kDetached)
+    {
+      if (next & kReading)
+      {
+        std::this_thread::yield();
+        next = cursor.next.load(std::memory_order_acquire);
+      }
+
+      else if (cursor.next.compare_exchange_weak(next, kDetached,
+                                                 std::memory_order_acq_rel))
+        break;
+    }
+
+    cursor.dropped.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns @c true if the given @a consumer is attached.
+   */
+  [[nodiscard]] bool isAttached(const int consumer) const
+  {
+    return m_cursors[consumer].next.load(std::memory_order_acquire)
+           != kDetached;
+  }
+
+  /**
+   * @brief Returns the number of objects that the given @a consumer has not
+   *        read yet.
+   */
+  [[nodiscard]] std::size_t pending(const int consumer) const
+  {
+    const auto next = m_cursors[consumer].next.load(std::memory_order_acquire);
+    const auto published = m_published.load(std::memory_order_acquire);
+    if (next == kDetached || (next & ~kReading) > published)
+      return 0;
+
+    return static_cast<std::size_t>(published - (next & ~kReading) + 1);
+  }
+
+  /**
+   * @brief Returns & resets the number of objects that the given @a consumer
+   *        missed because it fell behind.
+   */
+  quint64 takeDropped(const int consumer)
+  {
+    return m_cursors[consumer].dropped.exchange(0, std::memory_order_acq_rel);
+  }
+
+  /**
+   * @brief Publishes a new object (producer thread only).
+   *
+   * The slot of the object is handed to @a write, which updates it in place.
+   * Consumers that would lose an unread object are moved forward first.
+   */
+  template<typename Writer>
+  void publish(Writer &&write)
+  {
+    const auto sequence = m_published.load(std::memory_order_relaxed) + 1;
+    for (int i = 0; i < m_consumerCount; ++i)
+      makeRoom(m_cursors[i], sequence);
+
+    write(m_items[sequence & m_mask]);
+    m_published.store(sequence, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies the oldest object that the given @a consumer has not read
+   *        yet (one thread per consumer).
+   *
+   * @param item Receives the object.
+   * @return @c false if the consumer is detached or has read every object.
+   */
+  bool tryRead(const int consumer, T &item)
+  {
+    auto &cursor = m_cursors[consumer];
+    auto next = cursor.next.load(std::memory_order_acquire);
+    while (true)
+    {
+      if (next == kDetached)
+        return false;
+
+      if (next > m_published.load(std::memory_order_acquire))
+        return false;
+
+      if (cursor.next.compare_exchange_weak(next, next | kReading,
+                                            std::memory_order_acq_rel))
+        break;
+    }
+
+    item = m_items[next & m_mask];
+    cursor.next.store(next + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  /**
+   * Cursor flags, set in the upper bits of the sequence numbers
+   */
+  static constexpr quint64 kReading = quint64(1) << 63;
+  static constexpr quint64 kDetached = quint64(1) << 62;
+
+  /**
+   * @brief Read cursor of a consumer.
+   *
+   * Holds the sequence number of the next object to read. The @c kReading
+   * flag is set while the consumer copies that object.
+   */
+  struct alignas(64) Cursor
+  {
+    Policy policy = Policy::DropOldest;
+    std::atomic<quint64> next{0};
+    std::atomic<quint64> dropped{0};
+  };
+
+  /**
+   * @brief Moves the given @a cursor forward if publishing @a sequence would
+   *        overwrite an object that it has not read yet.
+   */
+  void makeRoom(Cursor &cursor, const quint64 sequence)
+  {
+    const auto capacity = m_mask + 1;
+    auto next = cursor.next.load(std::memory_order_acquire);
+    while (next != kDetached && sequence - (next & ~kReading) >= capacity)
+    {
+      // Wait for the consumer to finish copying the oldest object
+      if (next & kReading)
+      {
+        std::this_thread::yield();
+        next = cursor.next.load(std::memory_order_acquire);
+        continue;
+      }
+
+      // Skip the objects that would be lost
+      const auto target = cursor.policy == Policy::SkipToLatest
+                              ? sequence
+                              : sequence - capacity + 1;
+      if (cursor.next.compare_exchange_weak(next, target,
+                                            std::memory_order_acq_rel))
+      {
+        cursor.dropped.fetch_add(target - next, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+
+private:
+  std::size_t m_mask;
+  std::vector<T> m_items;
+
+  alignas(64) std::atomic<quint64> m_published;
+  int m_consumerCount;
+  std::array<Cursor, kMaxConsumers> m_cursors;
+};
+} // namespace Misc
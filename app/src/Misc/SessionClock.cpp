@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/SessionClock.h"
+
+#include <chrono>
+
+//------------------------------------------------------------------------------
+// Timestamp acquisition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the current time of the steady clock in nanoseconds.
+ */
+qint64 Misc::SessionClock::now()
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+//------------------------------------------------------------------------------
+// Timestamp conversion
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Converts the given steady clock @a timestamp to nanoseconds since the
+ *        Unix epoch (UTC).
+ */
+qint64 Misc::SessionClock::toUnixNsecs(const qint64 timestamp)
+{
+  const auto &e = epoch();
+  return e.unixNs + (timestamp - e.steadyNs);
+}
+
+/**
+ * @brief Converts the given steady clock @a timestamp to milliseconds since
+ *        the Unix epoch in local time.
+ *
+ * The result can be split into days & milliseconds of the day with plain
+ * integer arithmetic, which is how the CSV export formats its timestamps.
+ */
+qint64 Misc::SessionClock::toLocalMsecs(const qint64 timestamp)
+{
+  const auto unixNs = toUnixNsecs(timestamp);
+  const auto msecs = unixNs / 1000000 - (unixNs % 1000000 < 0 ? 1 : 0);
+  return msecs + epoch().utcOffsetMs;
+}
+
+/**
+ * @brief Formats the local time of the given @a timestamp as "HH:mm:ss.zzz".
+ */
+QString Misc::SessionClock::formatTime(const qint64 timestamp)
+{
+  constexpr qint64 kMsecsPerDay = 24 * 60 * 60 * 1000;
+  auto msecs = toLocalMsecs(timestamp) % kMsecsPerDay;
+  if (msecs < 0)
+    msecs += kMsecsPerDay;
+
+  const auto ms = static_cast<int>(msecs % 1000);
+  const auto s = static_cast<int>(msecs / 1000 % 60);
+  const auto m = static_cast<int>(msecs / 60000 % 60);
+  const auto h = static_cast<int>(msecs / 3600000);
+
+  QString str(12, u'0');
+  str[0] = QChar(u'0' + h / 10);
+  str[1] = QChar(u'0' + h % 10);
+  str[2] = u':';
+  str[3] = QChar(u'0' + m / 10);
+  str[4] = QChar(u'0' + m % 10);
+  str[5] = u':';
+  str[6] = QChar(u'0' + s / 10);
+  str[7] = QChar(u'0' + s % 10);
+  str[8] = u'.';
+  str[9] = QChar(u'0' + ms / 100);
+  str[10] = QChar(u'0' + ms / 10 % 10);
+  str[11] = QChar(u'0' + ms % 10);
+  return str;
+}
+
+/**
+ * @brief Converts the given steady clock @a timestamp to a local date/time.
+ *
+ * This conversion goes through the time zone database, so it should only be
+ * used for infrequent operations, such as generating file names.
+ */
+QDateTime Misc::SessionClock::toDateTime(const qint64 timestamp)
+{
+  return QDateTime::fromMSecsSinceEpoch(toUnixNsecs(timestamp) / 1000000);
+}
+
+//------------------------------------------------------------------------------
+// Session epoch
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the session epoch, capturing it on the first call.
+ */
+const Misc::SessionClock::Epoch &Misc::SessionClock::epoch()
+{
+  static const Epoch epoch = [] {
+    using namespace std::chrono;
+    const auto wall = system_clock::now().time_since_epoch();
+
+    Epoch e;
+    e.steadyNs = now();
+    e.unixNs = duration_cast<nanoseconds>(wall).count();
+    e.utcOffsetMs
+        = static_cast<qint64>(QDateTime::currentDateTime().offsetFromUtc())
+          * 1000;
+    return e;
+  }();
+
+  return epoch;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QDateTime>
+
+namespace Misc
+{
+/**
+ * @brief Monotonic acquisition timestamps for the data path.
+ *
+ * Chunks & frames are stamped with the nanoseconds of a steady clock, which is
+ * cheap to read and never jumps backwards. The first call to any function of
+ * this class captures the session epoch (the steady clock & wall clock time
+ * at the same instant), which is used to convert timestamps to a date/time
+ * when they are written to a file or displayed.
+ *
+ * The UTC offset is obtained only once, so converted timestamps do not follow
+ * daylight saving time changes that happen during the session.
+ */
+class SessionClock
+{
+public:
+  [[nodiscard]] static qint64 now();
+  [[nodiscard]] static qint64 toUnixNsecs(const qint64 timestamp);
+  [[nodiscard]] static qint64 toLocalMsecs(const qint64 timestamp);
+  [[nodiscard]] static QString formatTime(const qint64 timestamp);
+  [[nodiscard]] static QDateTime toDateTime(const qint64 timestamp);
+
+private:
+  /**
+   * @brief Steady & wall clock time at the start of the session.
+   */
+  struct Epoch
+  {
+    qint64 steadyNs;
+    qint64 unixNs;
+    qint64 utcOffsetMs;
+  };
+
+  [[nodiscard]] static const Epoch &epoch();
+};
+} // namespace Misc
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+#include <QtGlobal>
+
+namespace Misc
+{
+/**
+ * @class Misc::SpscQueue
+ * @brief Fixed-capacity, lock-free queue for one producer & one consumer.
+ *
+ * The queue is used to hand objects over between two threads without locking
+ * or posting one event per object. One thread (the producer) may only call
+ * @c tryPush(), and one thread (the consumer) may only call @c tryPop(). Both
+ * calls are wait-free & never allocate memory, the slots are allocated once
+ * when the queue is constructed.
+ *
+ * Popped slots are reset to a default-constructed value, so that implicitly
+ * shared objects (e.g. frames or byte arrays) are released as soon as the
+ * consumer takes them.
+ *
+ * @tparam T Type of the queued objects, must be default-constructible.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+  /**
+   * @brief Constructs the queue.
+   *
+   * @param capacity Minimum number of objects that the queue can hold, it is
+   *                 rounded up to the next power of two.
+   */
+  explicit SpscQueue(const std::size_t capacity = 1024)
+    : m_head(0)
+    , m_tail(0)
+  {
+    std::size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+
+    m_mask = size - 1;
+    m_items.resize(size);
+  }
+
+  /**
+   * @brief Returns the number of objects that the queue can hold.
+   */
+  [[nodiscard]] std::size_t capacity() const { return m_items.size(); }
+
+  /**
+   * @brief Returns @c true if the queue contains no objects.
+   *
+   * The result is only a snapshot when called while the other thread is
+   * pushing or popping objects.
+   */
+  [[nodiscard]] bool isEmpty() const
+  {
+    return m_head.load(std::memory_order_acquire)
+           == m_tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Appends a copy of @a item to the queue (producer thread only).
+   *
+   * @return @c false if the queue is full & the item was not added.
+   */
+  bool tryPush(const T &item)
+  {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto head = m_head.load(std::memory_order_acquire);
+    if (tail - head >= m_items.size())
+      return false;
+
+    m_items[tail & m_mask] = item;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Takes the oldest object of the queue (consumer thread only).
+   *
+   * @param item Receives the object.
+   * @return @c false if the queue is empty.
+   */
+  bool tryPop(T &item)
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    if (head == tail)
+      return false;
+
+    auto &slot = m_items[head & m_mask];
+    item = std::move(slot);
+    slot = T();
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::size_t m_mask;
+  std::vector<T> m_items;
+
+  alignas(64) std::atomic<std::size_t> m_head;
+  alignas(64) std::atomic<std::size_t> m_tail;
+};
+} // namespace Misc
@@ -24,6 +24,7 @@
 
 #include <QDir>
 #include <QPalette>
+#include <QJsonArray>
 #include <QStyleHints>
 #include <QApplication>
 #include <QJsonDocument>
@@ -146,12 +147,65 @@ const QStringList &Misc::ThemeManager::availableThemes() const
  */
 QColor Misc::ThemeManager::getColor(const QString &name) const
 {
-  if (colors().contains(name))
-    return QColor(colors()[name].toString());
+  const auto it = m_palette.colors.constFind(name);
+  if (it != m_palette.colors.constEnd())
+    return *it;
 
   return QColor("#f0f");
 }
 
+/**
+ * @brief Returns the pre-parsed colors of the current theme.
+ * @return Reference to the palette, which is rebuilt when the theme changes.
+ */
+const Misc::ThemePalette &Misc::ThemeManager::palette() const
+{
+  return m_palette;
+}
+
+/**
+ * @brief Returns the names of the dataset colors of the current theme.
+ * @return QStringList with the "widget_colors" array of the theme.
+ */
+const QStringList &Misc::ThemeManager::widgetColors() const
+{
+  return m_palette.widgetColorNames;
+}
+
+/**
+ * @brief Returns the color of the dataset with the given frame @a index.
+ *
+ * Datasets are numbered from 1, and dataset indexes past the end of the
+ * theme's color array wrap around.
+ *
+ * @param index The frame index of the dataset.
+ * @return QColor
+ */
+QColor Misc::ThemeManager::datasetColor(const int index) const
+{
+  const auto &colors = m_palette.widgetColors;
+  if (colors.isEmpty())
+    return QColor("#f0f");
+
+  return colors.at(qMax(0, index - 1) % colors.count());
+}
+
+/**
+ * @brief Returns the name of the color of the dataset with the given frame
+ *        @a index, see @c datasetColor().
+ *
+ * @param index The frame index of the dataset.
+ * @return QString with the color name, ready to be used from QML.
+ */
+QString Misc::ThemeManager::datasetColorName(const int index) const
+{
+  const auto &names = m_palette.widgetColorNames;
+  if (names.isEmpty())
+    return QStringLiteral("#f0f");
+
+  return names.at(qMax(0, index - 1) % names.count());
+}
+
 /**
  * @brief Sets the current theme to the theme at the specified index.
  *
@@ -175,6 +229,7 @@ void Misc::ThemeManager::setTheme(const int index)
   // Obtain the data for the theme name
   m_themeData = m_themes.value(m_themeName);
   m_colors = m_themeData.value("colors").toObject();
+  updatePalette();
 
   // Tell OS if we prefer dark mode or light mode
   auto bg = getColor("base");
@@ -212,3 +267,30 @@ void Misc::ThemeManager::setTheme(const int index)
   // Update UI
   Q_EMIT themeChanged();
 }
+
+/**
+ * @brief Parses the colors of the current theme into @c m_palette.
+ *
+ * Widgets & QML bindings read the parsed colors instead of looking them up &
+ * converting them from the JSON data of the theme every time.
+ */
+void Misc::ThemeManager::updatePalette()
+{
+  m_palette = ThemePalette();
+  m_palette.colors.reserve(m_colors.count());
+  for (auto it = m_colors.constBegin(); it != m_colors.constEnd(); ++it)
+  {
+    if (it.value().isString())
+      m_palette.colors.insert(it.key(), QColor(it.value().toString()));
+  }
+
+  const auto widgetColors = m_colors.value("widget_colors").toArray();
+  m_palette.widgetColors.reserve(widgetColors.count());
+  m_palette.widgetColorNames.reserve(widgetColors.count());
+  for (const auto &value : widgetColors)
+  {
+    const auto name = value.toString();
+    m_palette.widgetColors.append(QColor(name));
+    m_palette.widgetColorNames.append(name);
+  }
+}
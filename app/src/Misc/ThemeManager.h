@@ -23,6 +23,8 @@
 #ifndef _UTILITIES_THEME_MANAGER_H
 #define _UTILITIES_THEME_MANAGER_H
 
+#include <QHash>
+#include <QList>
 #include <QColor>
 #include <QObject>
 #include <QSettings>
@@ -83,6 +85,8 @@ inline QString QSS(const QString &style, const Colors &...colors)
  * - Retrieve available themes using @c availableThemes().
  * - Change the theme using @c setTheme().
  * - Get the current theme's color scheme with @c colors().
+ * - Get the pre-parsed colors of the current theme with @c palette(),
+ *   @c getColor() or @c datasetColor().
  *
  * The class emits a @c themeChanged signal when the application theme is
  * changed, either manually or automatically in response to system palette
@@ -92,6 +96,20 @@ inline QString QSS(const QString &style, const Colors &...colors)
  */
 namespace Misc
 {
+/**
+ * @brief Colors of the current theme, parsed once when the theme changes.
+ *
+ * The dataset colors are kept both as @c QColor values and as the names
+ * that are handed to QML, so that widgets don't need to convert them for
+ * every dataset.
+ */
+struct ThemePalette
+{
+  QHash<QString, QColor> colors;
+  QList<QColor> widgetColors;
+  QStringList widgetColorNames;
+};
+
 class ThemeManager : public QObject
 {
   // clang-format off
@@ -109,6 +127,9 @@ class ThemeManager : public QObject
   Q_PROPERTY(QStringList availableThemes
              READ availableThemes
              CONSTANT)
+  Q_PROPERTY(QStringList widgetColors
+             READ widgetColors
+             NOTIFY themeChanged)
   // clang-format on
 
 signals:
@@ -131,9 +152,17 @@ public:
   [[nodiscard]] const QStringList &availableThemes() const;
   [[nodiscard]] QColor getColor(const QString &name) const;
 
+  [[nodiscard]] const ThemePalette &palette() const;
+  [[nodiscard]] const QStringList &widgetColors() const;
+  [[nodiscard]] QColor datasetColor(const int index) const;
+  [[nodiscard]] QString datasetColorName(const int index) const;
+
 public slots:
   void setTheme(int index);
 
+private:
+  void updatePalette();
+
 private:
   int m_theme;
   QString m_themeName;
@@ -141,6 +170,7 @@ private:
   QSettings m_settings;
   QJsonObject m_colors;
   QJsonObject m_themeData;
+  ThemePalette m_palette;
 
   QStringList m_availableThemes;
   QMap<QString, QJsonObject> m_themes;
@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDebug>
+#include <QAbstractEventDispatcher>
+
+#include "Misc/Translator.h"
+#include "Misc/ThreadScheduler.h"
+
+#if defined(Q_OS_WIN)
+#  include <windows.h>
+#  include <avrt.h>
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#  include <cerrno>
+#  include <cstring>
+#  include <sched.h>
+#  include <unistd.h>
+#  include <pthread.h>
+#  include <sys/mman.h>
+#  include <sys/resource.h>
+#endif
+
+/**
+ * Settings key fragment of each thread role, in the order of the @c Role enum
+ */
+static constexpr const char *kRoleKeys[] = {"reader", "parser", "exporter",
+                                            "network"};
+static constexpr int kRoleCount = 4;
+
+/**
+ * @c SCHED_FIFO priority used for realtime threads, bounded to the range
+ * supported by the system. It is kept below the kernel's own IRQ threads.
+ */
+static constexpr int kFifoPriority = 40;
+
+/**
+ * Highest CPU index accepted in an affinity list
+ */
+static constexpr int kMaxCpuIndex = 1023;
+
+#ifdef Q_OS_WIN
+/**
+ * MMCSS task handle of the calling thread, if it joined the "Pro Audio" class
+ */
+static thread_local HANDLE t_mmcssTask = nullptr;
+#endif
+
+/**
+ * Moves the calling thread to the realtime scheduling class, returns @c false
+ * if the process lacks the privileges to do so.
+ */
+static bool enterRealtime()
+{
+#if defined(Q_OS_WIN)
+  if (!t_mmcssTask)
+  {
+    DWORD taskIndex = 0;
+    t_mmcssTask = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+    if (!t_mmcssTask)
+      return false;
+  }
+
+  return AvSetMmThreadPriority(t_mmcssTask, AVRT_PRIORITY_HIGH);
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+  sched_param param = {};
+  param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO),
+                                kFifoPriority,
+                                sched_get_priority_max(SCHED_FIFO));
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Moves the calling thread back to the regular scheduling class if it was
+ * previously moved to the realtime class.
+ */
+static void leaveRealtime()
+{
+#if defined(Q_OS_WIN)
+  if (t_mmcssTask)
+  {
+    AvRevertMmThreadCharacteristics(t_mmcssTask);
+    t_mmcssTask = nullptr;
+  }
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+  int policy = 0;
+  sched_param param = {};
+  if (pthread_getschedparam(pthread_self(), &policy, &param) != 0)
+    return;
+
+  if (policy == SCHED_FIFO)
+  {
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+  }
+#endif
+}
+
+/**
+ * Restricts the calling thread to the given CPUs, or allows it to run on any
+ * of the CPUs of the process if @a cpus is empty.
+ */
+static bool setCurrentThreadAffinity(const QList<int> &cpus)
+{
+#if defined(Q_OS_WIN)
+  DWORD_PTR mask = 0;
+  if (cpus.isEmpty())
+  {
+    DWORD_PTR systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask))
+      return false;
+  }
+
+  else
+  {
+    for (const auto cpu : cpus)
+    {
+      if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+        mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+  }
+
+  return mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(Q_OS_LINUX)
+  // The main thread is never pinned, so its mask is the one of the process
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (cpus.isEmpty())
+  {
+    if (sched_getaffinity(getpid(), sizeof(set), &set) != 0)
+      return false;
+  }
+
+  else
+  {
+    for (const auto cpu : cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &set);
+    }
+  }
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  Q_UNUSED(cpus);
+  return false;
+#endif
+}
+
+/**
+ * Returns the Qt priority equivalent to the given non-realtime @a priority,
+ * @a initial is the priority with which the thread was started.
+ */
+static QThread::Priority
+qtPriority(const Misc::ThreadScheduler::Priority priority,
+           const QThread::Priority initial)
+{
+  switch (priority)
+  {
+    case Misc::ThreadScheduler::Priority::Normal:
+      return QThread::NormalPriority;
+    case Misc::ThreadScheduler::Priority::High:
+      return QThread::HighPriority;
+    case Misc::ThreadScheduler::Priority::Highest:
+      return QThread::HighestPriority;
+    default:
+      break;
+  }
+
+  if (initial == QThread::InheritPriority)
+    return QThread::NormalPriority;
+
+  return initial;
+}
+
+/**
+ * Constructor function, reads the scheduling settings of each thread role
+ * and locks the process memory if the user asked to do so.
+ */
+Misc::ThreadScheduler::ThreadScheduler()
+  : m_lockMemory(false)
+  , m_memoryLocked(false)
+{
+  for (int i = 0; i < kRoleCount; ++i)
+  {
+    const auto key = QString::fromLatin1(kRoleKeys[i]);
+    const auto priorityKey = QStringLiteral("thread_%1_priority").arg(key);
+    const auto affinityKey = QStringLiteral("thread_%1_affinity").arg(key);
+    const auto p = m_settings.value(priorityKey, 0).toInt();
+    const auto cpus = m_settings.value(affinityKey).toString();
+
+    if (p >= 0 && p <= static_cast<int>(Priority::Realtime))
+      m_roles[i].priority = static_cast<Priority>(p);
+
+    if (validateAffinity(cpus))
+      m_roles[i].affinity = cpus.trimmed();
+  }
+
+  m_lockMemory = m_settings.value("lock_memory", false).toBool();
+  applyMemoryLock();
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+Misc::ThreadScheduler &Misc::ThreadScheduler::instance()
+{
+  static ThreadScheduler singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true if the user asked to lock the process memory in RAM
+ */
+bool Misc::ThreadScheduler::lockMemory() const
+{
+  return m_lockMemory;
+}
+
+/**
+ * Returns @c true if the process memory is currently locked in RAM
+ */
+bool Misc::ThreadScheduler::memoryLocked() const
+{
+  return m_memoryLocked;
+}
+
+/**
+ * Returns @c true if thread CPU affinity can be set on this platform
+ */
+bool Misc::ThreadScheduler::affinitySupported() const
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_LINUX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Returns @c true if the process memory can be locked on this platform
+ */
+bool Misc::ThreadScheduler::memoryLockSupported() const
+{
+#ifdef Q_OS_LINUX
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Returns the list of thread priorities, in the order of the @c Priority enum
+ */
+QStringList Misc::ThreadScheduler::priorities() const
+{
+  return {tr("Default"), tr("Normal"), tr("High"), tr("Highest"),
+          tr("Realtime")};
+}
+
+/**
+ * Returns the index of the priority configured for the given thread @a role
+ */
+int Misc::ThreadScheduler::priority(const int role) const
+{
+  if (role < 0 || role >= kRoleCount)
+    return 0;
+
+  QMutexLocker locker(&m_mutex);
+  return static_cast<int>(m_roles[role].priority);
+}
+
+/**
+ * Returns the list of CPUs (e.g. "2,4-5") to which the threads of the given
+ * @a role are restricted, an empty string means any CPU.
+ */
+QString Misc::ThreadScheduler::affinity(const int role) const
+{
+  if (role < 0 || role >= kRoleCount)
+    return QString();
+
+  QMutexLocker locker(&m_mutex);
+  return m_roles[role].affinity;
+}
+
+/**
+ * Returns @c true if @a cpus is an empty string or a valid list of CPU
+ * indexes and ranges, such as "0,2-3".
+ */
+bool Misc::ThreadScheduler::validateAffinity(const QString &cpus) const
+{
+  bool ok = false;
+  parseCpuList(cpus, &ok);
+  return ok;
+}
+
+/**
+ * Registers a pipeline @a thread with the given @a role. The settings of the
+ * role are applied from within the thread as soon as it starts (or right
+ * away if it is already running), and whenever they are changed.
+ */
+void Misc::ThreadScheduler::registerThread(QThread *thread, const Role role)
+{
+  Q_ASSERT(thread);
+
+  // Register the thread & drop the threads that no longer exist
+  {
+    QMutexLocker locker(&m_mutex);
+    m_threads.removeIf([](const Registration &r) { return r.thread.isNull(); });
+
+    Registration registration;
+    registration.thread = thread;
+    registration.role = role;
+    m_threads.append(registration);
+  }
+
+  // Apply the settings from within the thread when it starts
+  connect(
+      thread, &QThread::started, this,
+      [=] { applyToCurrentThread(thread, role); }, Qt::DirectConnection);
+
+  // Apply the settings right away if the thread is already running
+  auto *dispatcher = thread->eventDispatcher();
+  if (thread->isRunning() && dispatcher)
+  {
+    QMetaObject::invokeMethod(
+        dispatcher, [=] { applyToCurrentThread(thread, role); },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * Updates the display names of the priorities when the language changes
+ */
+void Misc::ThreadScheduler::setupExternalConnections()
+{
+  connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
+          this, &Misc::ThreadScheduler::languageChanged);
+}
+
+/**
+ * Enables or disables locking the process memory in RAM, the value is saved
+ * in the application settings.
+ */
+void Misc::ThreadScheduler::setLockMemory(const bool enabled)
+{
+  if (m_lockMemory != enabled)
+  {
+    m_lockMemory = enabled;
+    m_settings.setValue("lock_memory", enabled);
+    applyMemoryLock();
+
+    Q_EMIT lockMemoryChanged();
+  }
+}
+
+/**
+ * Changes the priority of the threads of the given @a role, the value is saved
+ * in the application settings.
+ */
+void Misc::ThreadScheduler::setPriority(const int role, const int priority)
+{
+  if (role < 0 || role >= kRoleCount)
+    return;
+
+  if (priority < 0 || priority > static_cast<int>(Priority::Realtime))
+    return;
+
+  // Update the settings of the role
+  {
+    QMutexLocker locker(&m_mutex);
+    const auto value = static_cast<Priority>(priority);
+    if (m_roles[role].priority == value)
+      return;
+
+    m_roles[role].priority = value;
+  }
+
+  // Save the settings & apply them to the running threads
+  const auto key = QString::fromLatin1(kRoleKeys[role]);
+  m_settings.setValue(QStringLiteral("thread_%1_priority").arg(key), priority);
+  reapply(static_cast<Role>(role));
+
+  Q_EMIT settingsChanged();
+}
+
+/**
+ * Restricts the threads of the given @a role to the CPUs listed in @a cpus
+ * (e.g. "2,4-5"), an empty string allows them to run on any CPU. The value is
+ * saved in the application settings.
+ */
+void Misc::ThreadScheduler::setAffinity(const int role, const QString &cpus)
+{
+  if (role < 0 || role >= kRoleCount || !validateAffinity(cpus))
+    return;
+
+  // Update the settings of the role
+  const auto value = cpus.trimmed();
+  {
+    QMutexLocker locker(&m_mutex);
+    if (m_roles[role].affinity == value)
+      return;
+
+    m_roles[role].affinity = value;
+  }
+
+  // Save the settings & apply them to the running threads
+  const auto key = QString::fromLatin1(kRoleKeys[role]);
+  m_settings.setValue(QStringLiteral("thread_%1_affinity").arg(key), value);
+  reapply(static_cast<Role>(role));
+
+  Q_EMIT settingsChanged();
+}
+
+/**
+ * Locks or unlocks the current & future memory pages of the process in RAM.
+ *
+ * Locking is refused unless the memory lock limit of the process is unlimited
+ * (or the process is privileged), because with @c MCL_FUTURE any allocation
+ * beyond the limit would fail.
+ */
+void Misc::ThreadScheduler::applyMemoryLock()
+{
+#ifdef Q_OS_LINUX
+  const bool wasLocked = m_memoryLocked;
+  if (m_lockMemory && !m_memoryLocked)
+  {
+    rlimit limit = {};
+    getrlimit(RLIMIT_MEMLOCK, &limit);
+    if (limit.rlim_cur != RLIM_INFINITY && geteuid() != 0)
+      qWarning() << "Cannot lock memory: the memlock limit is not unlimited";
+
+    else if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+      qWarning() << "Cannot lock memory:" << std::strerror(errno);
+
+    else
+      m_memoryLocked = true;
+  }
+
+  else if (!m_lockMemory && m_memoryLocked)
+  {
+    munlockall();
+    m_memoryLocked = false;
+  }
+
+  if (wasLocked != m_memoryLocked)
+    Q_EMIT lockMemoryChanged();
+#endif
+}
+
+/**
+ * Re-applies the settings of the given @a role to its running threads, the
+ * settings are applied from the event loop of each thread.
+ */
+void Misc::ThreadScheduler::reapply(const Role role)
+{
+  QList<QThread *> threads;
+  {
+    QMutexLocker locker(&m_mutex);
+    for (const auto &registration : std::as_const(m_threads))
+    {
+      if (registration.role == role && registration.thread)
+        threads.append(registration.thread.data());
+    }
+  }
+
+  for (auto *thread : std::as_const(threads))
+  {
+    auto *dispatcher = thread->eventDispatcher();
+    if (!thread->isRunning() || !dispatcher)
+      continue;
+
+    QMetaObject::invokeMethod(
+        dispatcher, [=] { applyToCurrentThread(thread, role); },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * Applies the priority & CPU affinity of the given @a role to the calling
+ * thread, which must be @a thread.
+ *
+ * The CPU affinity of a thread is only reset when it was previously pinned by
+ * this class, so that the affinity inherited from the process (e.g. through
+ * @c taskset) is preserved.
+ */
+void Misc::ThreadScheduler::applyToCurrentThread(QThread *thread,
+                                                 const Role role)
+{
+  Q_ASSERT(QThread::currentThread() == thread);
+
+  // Obtain the settings of the role & the state of the thread
+  bool pinned = false;
+  RoleSettings settings;
+  QThread::Priority initial = QThread::InheritPriority;
+  {
+    QMutexLocker locker(&m_mutex);
+    settings = m_roles[static_cast<int>(role)];
+    for (auto &registration : m_threads)
+    {
+      if (registration.thread != thread)
+        continue;
+
+      if (!registration.started)
+      {
+        registration.started = true;
+        registration.initialPriority = thread->priority();
+      }
+
+      initial = registration.initialPriority;
+      pinned = registration.pinned;
+      registration.pinned = !settings.affinity.isEmpty();
+      break;
+    }
+  }
+
+  // Apply the priority, use the highest Qt priority if realtime fails
+  leaveRealtime();
+  if (settings.priority == Priority::Realtime)
+  {
+    if (!enterRealtime())
+    {
+      qWarning() << "Cannot use realtime scheduling for"
+                 << thread->objectName();
+      thread->setPriority(QThread::TimeCriticalPriority);
+    }
+  }
+
+  else if (settings.priority != Priority::Default
+           || thread->priority() != initial)
+    thread->setPriority(qtPriority(settings.priority, initial));
+
+  // Apply the CPU affinity
+  if (pinned || !settings.affinity.isEmpty())
+  {
+    if (!setCurrentThreadAffinity(parseCpuList(settings.affinity)))
+      qWarning() << "Cannot set the CPU affinity of" << thread->objectName();
+  }
+}
+
+/**
+ * Parses a list of CPU indexes and ranges, such as "0,2-3". The @a ok flag is
+ * set to @c false if the list is malformed.
+ */
+QList<int> Misc::ThreadScheduler::parseCpuList(const QString &cpus, bool *ok)
+{
+  QList<int> list;
+  if (ok)
+    *ok = true;
+
+  const auto parts = cpus.split(',', Qt::SkipEmptyParts);
+  for (const auto &part : parts)
+  {
+    // Obtain the first & last CPU of the range
+    bool valid = false;
+    const auto range = part.trimmed().split('-');
+    const int first = range.first().trimmed().toInt(&valid);
+    int last = first;
+    if (valid && range.count() == 2)
+      last = range.last().trimmed().toInt(&valid);
+
+    // Reject malformed ranges
+    if (!valid || range.count() > 2 || first < 0 || last < first
+        || last > kMaxCpuIndex)
+    {
+      if (ok)
+        *ok = false;
+
+      return {};
+    }
+
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      if (!list.contains(cpu))
+        list.append(cpu);
+    }
+  }
+
+  return list;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QPointer>
+#include <QSettings>
+
+namespace Misc
+{
+/**
+ * @brief The ThreadScheduler class
+ *
+ * The @c ThreadScheduler class applies the user-configured scheduling class,
+ * priority and CPU affinity to the threads of the data pipeline, so that
+ * dedicated acquisition machines can keep scheduling jitter away from the
+ * hot path.
+ *
+ * Threads are registered with a @c Role before they are started, the settings
+ * of their role are then applied from within the thread itself as soon as it
+ * starts, and re-applied through the event loop of the thread whenever the
+ * user changes them.
+ *
+ * The @c Realtime priority uses the @c SCHED_FIFO policy on Linux & macOS and
+ * the "Pro Audio" MMCSS task class on Windows. If the process lacks the
+ * privileges to do so, the thread falls back to
+ * @c QThread::TimeCriticalPriority.
+ *
+ * The class can also lock the memory of the process (including every buffer
+ * allocated afterwards) in RAM with @c mlockall(), which avoids page faults
+ * while acquiring data. Memory locking is only available on Linux, and CPU
+ * affinity is not available on macOS.
+ */
+class ThreadScheduler : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool lockMemory
+             READ lockMemory
+             WRITE setLockMemory
+             NOTIFY lockMemoryChanged)
+  Q_PROPERTY(bool memoryLocked
+             READ memoryLocked
+             NOTIFY lockMemoryChanged)
+  Q_PROPERTY(bool affinitySupported
+             READ affinitySupported
+             CONSTANT)
+  Q_PROPERTY(bool memoryLockSupported
+             READ memoryLockSupported
+             CONSTANT)
+  Q_PROPERTY(QStringList priorities
+             READ priorities
+             NOTIFY languageChanged)
+  // clang-format on
+
+signals:
+  void languageChanged();
+  void settingsChanged();
+  void lockMemoryChanged();
+
+private:
+  explicit ThreadScheduler();
+  ThreadScheduler(ThreadScheduler &&) = delete;
+  ThreadScheduler(const ThreadScheduler &) = delete;
+  ThreadScheduler &operator=(ThreadScheduler &&) = delete;
+  ThreadScheduler &operator=(const ThreadScheduler &) = delete;
+
+public:
+  enum class Role
+  {
+    Reader,
+    Parser,
+    Exporter,
+    Network
+  };
+  Q_ENUM(Role)
+
+  enum class Priority
+  {
+    Default,
+    Normal,
+    High,
+    Highest,
+    Realtime
+  };
+  Q_ENUM(Priority)
+
+  static ThreadScheduler &instance();
+
+  [[nodiscard]] bool lockMemory() const;
+  [[nodiscard]] bool memoryLocked() const;
+  [[nodiscard]] bool affinitySupported() const;
+  [[nodiscard]] bool memoryLockSupported() const;
+  [[nodiscard]] QStringList priorities() const;
+
+  Q_INVOKABLE int priority(const int role) const;
+  Q_INVOKABLE QString affinity(const int role) const;
+  Q_INVOKABLE bool validateAffinity(const QString &cpus) const;
+
+  void registerThread(QThread *thread, const Role role);
+
+public slots:
+  void setupExternalConnections();
+  void setLockMemory(const bool enabled);
+  void setPriority(const int role, const int priority);
+  void setAffinity(const int role, const QString &cpus);
+
+private:
+  void applyMemoryLock();
+  void reapply(const Role role);
+  void applyToCurrentThread(QThread *thread, const Role role);
+  [[nodiscard]] static QList<int> parseCpuList(const QString &cpus,
+                                               bool *ok = nullptr);
+
+private:
+  struct RoleSettings
+  {
+    Priority priority = Priority::Default;
+    QString affinity;
+  };
+
+  struct Registration
+  {
+    QPointer<QThread> thread;
+    Role role = Role::Reader;
+    QThread::Priority initialPriority = QThread::InheritPriority;
+    bool started = false;
+    bool pinned = false;
+  };
+
+  bool m_lockMemory;
+  bool m_memoryLocked;
+  QSettings m_settings;
+
+  mutable QMutex m_mutex;
+  RoleSettings m_roles[4];
+  QList<Registration> m_threads;
+};
+} // namespace Misc
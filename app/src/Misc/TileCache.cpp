@@ -0,0 +1,656 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QtMath>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QTcpSocket>
+#include <QDirIterator>
+#include <QNetworkReply>
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QRegularExpression>
+
+#include <climits>
+#include <algorithm>
+
+#include "Misc/TileCache.h"
+#include "Misc/Utilities.h"
+#include "Misc/WorkerPool.h"
+
+/**
+ * Download limits: tiles downloaded at the same time, how many of them can
+ * be prefetched tiles (so that the map stays responsive while a region is
+ * downloaded), transfer timeout (in milliseconds) & tiles per prefetch.
+ */
+static constexpr int kMaxRequests = 6;
+static constexpr int kMaxPrefetchRequests = 2;
+static constexpr int kTransferTimeout = 15000;
+static constexpr int kMaxPrefetchTiles = 20000;
+
+/**
+ * Default, lowest and highest disk cache sizes (in megabytes)
+ */
+static constexpr int kDefaultCacheSize = 512;
+static constexpr int kMinCacheSize = 16;
+static constexpr int kMaxCacheSize = 16384;
+
+/**
+ * Highest zoom level that can be prefetched & latitude limit of the Web
+ * Mercator projection used by the tile servers
+ */
+static constexpr int kMaxZoom = 20;
+static constexpr qreal kMaxLatitude = 85.05112878;
+
+/**
+ * Returns the column of the tile that contains the given @a longitude
+ */
+static int tileX(const qreal longitude, const int zoom)
+{
+  const int tiles = 1 << zoom;
+  const auto x = qFloor((qBound(-180.0, longitude, 180.0) + 180) / 360 * tiles);
+  return qBound(0, x, tiles - 1);
+}
+
+/**
+ * Returns the row of the tile that contains the given @a latitude
+ */
+static int tileY(const qreal latitude, const int zoom)
+{
+  const int tiles = 1 << zoom;
+  const auto lat = qDegreesToRadians(qBound(-kMaxLatitude, latitude,
+                                            kMaxLatitude));
+  const auto mercator = std::log(std::tan(lat) + 1 / std::cos(lat));
+  const auto y = qFloor((1 - mercator / M_PI) / 2 * tiles);
+  return qBound(0, y, tiles - 1);
+}
+
+/**
+ * Constructor function, starts the local tile server & loads the index of
+ * the disk cache in the background
+ */
+Misc::TileCache::TileCache()
+  : m_size(0)
+  , m_generation(0)
+  , m_requests(0)
+  , m_prefetchRequests(0)
+  , m_prefetchTotal(0)
+  , m_prefetchCompleted(0)
+{
+  // Read the cache size & create the cache directory
+  const auto size = m_settings.value("tile_cache_size", kDefaultCacheSize);
+  m_maxCacheSize = qBound(kMinCacheSize, size.toInt(), kMaxCacheSize);
+  m_path = QStringLiteral("%1/Tile Cache/").arg(
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+  QDir().mkpath(m_path);
+
+  // Give up on stalled downloads, connections are kept open between tiles
+  m_network.setTransferTimeout(kTransferTimeout);
+
+  // Serve the tiles to the map from the loopback interface only
+  connect(&m_server, &QTcpServer::newConnection, this,
+          &Misc::TileCache::onNewConnection);
+  if (!m_server.listen(QHostAddress::LocalHost, 0))
+    qWarning() << "Tile cache server error:" << m_server.errorString();
+
+  loadIndex();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::TileCache &Misc::TileCache::instance()
+{
+  static TileCache singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true while the tiles of a region are being downloaded
+ */
+bool Misc::TileCache::prefetching() const
+{
+  return !m_prefetchQueue.isEmpty() || m_prefetchRequests > 0;
+}
+
+/**
+ * Returns the number of tiles that are being prefetched
+ */
+int Misc::TileCache::prefetchTotal() const
+{
+  return m_prefetchTotal;
+}
+
+/**
+ * Returns the number of prefetched tiles that were downloaded (or that
+ * could not be downloaded)
+ */
+int Misc::TileCache::prefetchCompleted() const
+{
+  return m_prefetchCompleted;
+}
+
+/**
+ * Returns the size (in bytes) of the tiles stored in the disk cache
+ */
+qint64 Misc::TileCache::cacheSize() const
+{
+  return m_size;
+}
+
+/**
+ * Returns the maximum size (in megabytes) of the disk cache
+ */
+int Misc::TileCache::maxCacheSize() const
+{
+  return m_maxCacheSize;
+}
+
+/**
+ * Registers the @a upstream URL template of a tile @a provider and returns
+ * the URL template of the local tile server, which serves the tiles of the
+ * provider from the disk cache.
+ *
+ * The upstream template is returned if the local server is not running.
+ */
+QString Misc::TileCache::localTemplate(const QString &provider,
+                                       const QString &upstream)
+{
+  static const QRegularExpression name(QStringLiteral("^[A-Za-z0-9_-]+$"));
+  if (!m_server.isListening() || !name.match(provider).hasMatch())
+    return upstream;
+
+  m_providers.insert(provider, upstream);
+  return QStringLiteral("http://127.0.0.1:%1/%2/%z/%x/%y")
+      .arg(m_server.serverPort())
+      .arg(provider);
+}
+
+/**
+ * Returns the number of tiles that cover the given region for every zoom
+ * level between @a minZoom and @a maxZoom.
+ */
+int Misc::TileCache::tileCount(const qreal north, const qreal west,
+                               const qreal south, const qreal east,
+                               const int minZoom, const int maxZoom) const
+{
+  qint64 count = 0;
+  const auto first = qBound(0, qMin(minZoom, maxZoom), kMaxZoom);
+  const auto last = qBound(0, qMax(minZoom, maxZoom), kMaxZoom);
+  for (int z = first; z <= last; ++z)
+  {
+    const auto x0 = tileX(qMin(west, east), z);
+    const auto x1 = tileX(qMax(west, east), z);
+    const auto y0 = tileY(qMax(north, south), z);
+    const auto y1 = tileY(qMin(north, south), z);
+    count += qint64(x1 - x0 + 1) * (y1 - y0 + 1);
+  }
+
+  return static_cast<int>(qMin<qint64>(count, INT_MAX));
+}
+
+/**
+ * Removes every tile from the disk cache
+ */
+void Misc::TileCache::clear()
+{
+  cancelPrefetch();
+
+  ++m_generation;
+  QDir(m_path).removeRecursively();
+  QDir().mkpath(m_path);
+
+  m_size = 0;
+  m_entries.clear();
+  Q_EMIT cacheSizeChanged();
+}
+
+/**
+ * Stops downloading the tiles of the current prefetch region, the tiles that
+ * are being downloaded are still stored in the cache
+ */
+void Misc::TileCache::cancelPrefetch()
+{
+  for (const auto &key : std::as_const(m_prefetchQueue))
+    m_pending.remove(key);
+
+  m_prefetchQueue.clear();
+  m_prefetchTotal = 0;
+  m_prefetchCompleted = 0;
+  Q_EMIT prefetchChanged();
+}
+
+/**
+ * Changes the maximum size (in megabytes) of the disk cache, the value is
+ * saved in the application settings.
+ */
+void Misc::TileCache::setMaxCacheSize(const int megabytes)
+{
+  const auto size = qBound(kMinCacheSize, megabytes, kMaxCacheSize);
+  if (m_maxCacheSize != size)
+  {
+    m_maxCacheSize = size;
+    m_settings.setValue("tile_cache_size", size);
+    evict();
+
+    Q_EMIT maxCacheSizeChanged();
+    Q_EMIT cacheSizeChanged();
+  }
+}
+
+/**
+ * Downloads the tiles of the map that is currently displayed for the given
+ * region & zoom levels, skipping the tiles that are already cached.
+ *
+ * Regions with more than @c kMaxPrefetchTiles tiles are rejected, so that
+ * tile servers are not flooded with requests.
+ */
+void Misc::TileCache::prefetch(const qreal north, const qreal west,
+                               const qreal south, const qreal east,
+                               const int minZoom, const int maxZoom)
+{
+  // Nothing to do if no map has been displayed yet
+  const auto provider = m_activeProvider;
+  if (provider.isEmpty())
+    return;
+
+  // Reject huge regions
+  const auto count = tileCount(north, west, south, east, minZoom, maxZoom);
+  if (count > kMaxPrefetchTiles)
+  {
+    Misc::Utilities::showMessageBox(
+        tr("The selected region has too many map tiles"),
+        tr("The region contains %1 tiles, at most %2 tiles can be downloaded "
+           "at once. Zoom in or download fewer zoom levels.")
+            .arg(count)
+            .arg(kMaxPrefetchTiles),
+        tr("Map Tiles"));
+    return;
+  }
+
+  // Queue the tiles that are not cached or downloaded yet
+  const auto first = qBound(0, qMin(minZoom, maxZoom), kMaxZoom);
+  const auto last = qBound(0, qMax(minZoom, maxZoom), kMaxZoom);
+  for (int z = first; z <= last; ++z)
+  {
+    const auto x0 = tileX(qMin(west, east), z);
+    const auto x1 = tileX(qMax(west, east), z);
+    const auto y0 = tileY(qMax(north, south), z);
+    const auto y1 = tileY(qMin(north, south), z);
+    for (int x = x0; x <= x1; ++x)
+    {
+      for (int y = y0; y <= y1; ++y)
+      {
+        const auto key = QStringLiteral("%1/%2/%3/%4")
+                             .arg(provider)
+                             .arg(z)
+                             .arg(x)
+                             .arg(y);
+        if (m_entries.contains(key) || m_pending.contains(key))
+          continue;
+
+        m_pending.insert(key);
+        m_prefetchQueue.append(key);
+        ++m_prefetchTotal;
+      }
+    }
+  }
+
+  // Start downloading
+  Q_EMIT prefetchChanged();
+  startRequests();
+}
+
+/**
+ * Registers the connections of the map to the local tile server
+ */
+void Misc::TileCache::onNewConnection()
+{
+  while (m_server.hasPendingConnections())
+  {
+    auto *socket = m_server.nextPendingConnection();
+    connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    connect(socket, &QTcpSocket::readyRead, this,
+            [this, socket] { readRequest(socket); });
+  }
+}
+
+/**
+ * Stores a downloaded tile in the disk cache & sends it to every connection
+ * that requested it, then starts the next downloads
+ */
+void Misc::TileCache::onRequestFinished()
+{
+  // Obtain the reply & its tile
+  auto *reply = qobject_cast<QNetworkReply *>(sender());
+  if (!reply)
+    return;
+
+  reply->deleteLater();
+  const auto key = reply->property("key").toString();
+  const auto prefetch = reply->property("prefetch").toBool();
+  m_pending.remove(key);
+  --m_requests;
+  if (prefetch)
+    --m_prefetchRequests;
+
+  // Store the tile
+  QByteArray data;
+  const auto status
+      = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  if (reply->error() == QNetworkReply::NoError && status == 200)
+  {
+    data = reply->readAll();
+    if (!data.isEmpty())
+      insert(key, data);
+  }
+
+  // Answer the map, an empty reply is sent if the tile is not available
+  const auto sockets = m_waiting.take(key);
+  for (const auto &socket : sockets)
+  {
+    if (socket)
+      respond(socket, data);
+  }
+
+  // Update the prefetch progress
+  if (prefetch && m_prefetchCompleted < m_prefetchTotal)
+  {
+    ++m_prefetchCompleted;
+    if (!prefetching())
+    {
+      m_prefetchTotal = 0;
+      m_prefetchCompleted = 0;
+    }
+
+    Q_EMIT prefetchChanged();
+  }
+
+  startRequests();
+}
+
+/**
+ * Removes the least recently used tiles until the disk cache is 10% below
+ * its maximum size, if the maximum size was exceeded
+ */
+void Misc::TileCache::evict()
+{
+  const auto limit = qint64(m_maxCacheSize) * 1024 * 1024;
+  if (m_size <= limit)
+    return;
+
+  QList<QPair<qint64, QString>> order;
+  order.reserve(m_entries.count());
+  for (auto i = m_entries.cbegin(); i != m_entries.cend(); ++i)
+    order.append(qMakePair(i->lastAccess, i.key()));
+
+  std::sort(order.begin(), order.end());
+
+  const auto target = limit * 9 / 10;
+  for (const auto &item : std::as_const(order))
+  {
+    if (m_size <= target)
+      break;
+
+    QFile::remove(filePath(item.second));
+    m_size -= m_entries.take(item.second).size;
+  }
+}
+
+/**
+ * Scans the disk cache in a worker thread to obtain the size & last access
+ * time of every stored tile, the modification time of each tile file is
+ * updated whenever it is served, so the access order persists across
+ * sessions.
+ */
+void Misc::TileCache::loadIndex()
+{
+  const auto path = m_path;
+  const auto generation = m_generation;
+  Misc::WorkerPool::instance().start([this, path, generation] {
+    // Find the tiles stored in the cache
+    QHash<QString, Entry> entries;
+    const QDir root(path);
+    QDirIterator it(path, {QStringLiteral("*.tile")}, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+      const auto info = it.nextFileInfo();
+      auto key = root.relativeFilePath(info.filePath());
+      key.chop(5);
+      const auto time = info.lastModified().toMSecsSinceEpoch();
+      entries.insert(key, {info.size(), time});
+    }
+
+    // Merge them with the tiles registered in the meantime
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, entries = std::move(entries)] {
+          if (generation != m_generation)
+            return;
+
+          for (auto i = entries.cbegin(); i != entries.cend(); ++i)
+          {
+            if (m_entries.contains(i.key()))
+              continue;
+
+            m_entries.insert(i.key(), i.value());
+            m_size += i->size;
+          }
+
+          evict();
+          Q_EMIT cacheSizeChanged();
+        },
+        Qt::QueuedConnection);
+  });
+}
+
+/**
+ * Starts downloading the queued tiles, tiles requested by the map are
+ * downloaded before prefetched tiles
+ */
+void Misc::TileCache::startRequests()
+{
+  const auto userAgent = QStringLiteral("%1/%2").arg(
+      qApp->applicationName(), qApp->applicationVersion());
+
+  while (m_requests < kMaxRequests)
+  {
+    // Select the next tile
+    QString key;
+    bool prefetch = false;
+    if (!m_queue.isEmpty())
+      key = m_queue.takeFirst();
+
+    else if (!m_prefetchQueue.isEmpty()
+             && m_prefetchRequests < kMaxPrefetchRequests)
+    {
+      prefetch = true;
+      key = m_prefetchQueue.takeFirst();
+    }
+
+    else
+      break;
+
+    // Download it, reusing the connections to the tile server
+    QNetworkRequest request(QUrl(upstreamUrl(key)));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setHeader(QNetworkRequest::UserAgentHeader, userAgent);
+    auto *reply = m_network.get(request);
+    reply->setProperty("key", key);
+    reply->setProperty("prefetch", prefetch);
+    connect(reply, &QNetworkReply::finished, this,
+            &Misc::TileCache::onRequestFinished);
+
+    ++m_requests;
+    if (prefetch)
+      ++m_prefetchRequests;
+  }
+}
+
+/**
+ * Reads a tile request of the map (@c GET /provider/z/x/y) and answers it
+ * from the disk cache, or queues the download of the tile
+ */
+void Misc::TileCache::readRequest(QTcpSocket *socket)
+{
+  // Only the request line is needed
+  if (!socket->canReadLine())
+    return;
+
+  disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+  const auto line = QString::fromLatin1(socket->readLine()).trimmed();
+  const auto tokens = line.split(QLatin1Char(' '));
+
+  // Validate the request
+  static const QRegularExpression path(
+      QStringLiteral("^/([A-Za-z0-9_-]+)/\\d+/\\d+/\\d+$"));
+  const auto match = tokens.count() >= 2 && tokens[0] == QLatin1String("GET")
+                         ? path.match(tokens[1])
+                         : QRegularExpressionMatch();
+  if (!match.hasMatch() || !m_providers.contains(match.captured(1)))
+  {
+    respond(socket, QByteArray());
+    return;
+  }
+
+  // Prefetch the tiles of the map that is being displayed
+  const auto key = tokens[1].mid(1);
+  m_activeProvider = match.captured(1);
+
+  // Serve cached tiles, marking them as recently used
+  QFile file(filePath(key));
+  if (file.open(QFile::ReadWrite))
+  {
+    const auto data = file.readAll();
+    const auto now = QDateTime::currentDateTime();
+    file.setFileTime(now, QFileDevice::FileModificationTime);
+    file.close();
+
+    auto entry = m_entries.find(key);
+    if (entry == m_entries.end())
+    {
+      m_size += data.size();
+      entry = m_entries.insert(key, {data.size(), 0});
+    }
+
+    entry->lastAccess = now.toMSecsSinceEpoch();
+    respond(socket, data);
+    return;
+  }
+
+  // Download the tile before any prefetched tile
+  m_waiting[key].append(socket);
+  if (m_prefetchQueue.removeOne(key))
+    m_queue.append(key);
+
+  else if (!m_pending.contains(key))
+  {
+    m_pending.insert(key);
+    m_queue.append(key);
+  }
+
+  startRequests();
+}
+
+/**
+ * Stores a downloaded tile in the disk cache, removing the least recently
+ * used tiles if the cache gets too big
+ */
+void Misc::TileCache::insert(const QString &key, const QByteArray &data)
+{
+  // Write the tile atomically, so that interrupted writes are not served
+  const auto path = filePath(key);
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file(path);
+  if (!file.open(QFile::WriteOnly))
+    return;
+
+  file.write(data);
+  if (!file.commit())
+    return;
+
+  // Register the tile
+  const auto previous = m_entries.find(key);
+  if (previous != m_entries.end())
+    m_size -= previous->size;
+
+  m_size += data.size();
+  m_entries.insert(key, {data.size(), QDateTime::currentMSecsSinceEpoch()});
+
+  evict();
+  Q_EMIT cacheSizeChanged();
+}
+
+/**
+ * Sends a tile to the map & closes the connection, an empty @a data array
+ * is answered with a "404 Not Found" response
+ */
+void Misc::TileCache::respond(QTcpSocket *socket, const QByteArray &data)
+{
+  if (socket->state() != QAbstractSocket::ConnectedState)
+    return;
+
+  if (data.isEmpty())
+    socket->write("HTTP/1.1 404 Not Found\r\n"
+                  "Content-Length: 0\r\n"
+                  "Connection: close\r\n\r\n");
+
+  else
+  {
+    const auto type = data.startsWith("\x89PNG") ? "image/png" : "image/jpeg";
+    socket->write("HTTP/1.1 200 OK\r\nContent-Type: ");
+    socket->write(type);
+    socket->write("\r\nContent-Length: ");
+    socket->write(QByteArray::number(data.size()));
+    socket->write("\r\nConnection: close\r\n\r\n");
+    socket->write(data);
+  }
+
+  socket->disconnectFromHost();
+}
+
+/**
+ * Returns the path of the cache file of the tile with the given @a key
+ */
+QString Misc::TileCache::filePath(const QString &key) const
+{
+  return m_path + key + QStringLiteral(".tile");
+}
+
+/**
+ * Returns the URL of the tile with the given @a key on its tile server
+ */
+QString Misc::TileCache::upstreamUrl(const QString &key) const
+{
+  const auto parts = key.split(QLatin1Char('/'));
+  if (parts.count() != 4)
+    return QString();
+
+  auto url = m_providers.value(parts[0]);
+  url.replace(QStringLiteral("%z"), parts[1]);
+  url.replace(QStringLiteral("%x"), parts[2]);
+  url.replace(QStringLiteral("%y"), parts[3]);
+  return url;
+}
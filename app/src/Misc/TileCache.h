@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QSet>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSettings>
+#include <QTcpServer>
+#include <QNetworkAccessManager>
+
+class QTcpSocket;
+class QNetworkReply;
+
+namespace Misc
+{
+/**
+ * @brief The TileCache class
+ *
+ * The @c TileCache class is a local HTTP proxy for the map tiles displayed by
+ * the GPS widget. The URL templates published by @c OsmTemplateServer point
+ * to this proxy, which serves the tiles from a persistent disk cache and only
+ * downloads the tiles that are not cached yet.
+ *
+ * Downloads share a single @c QNetworkAccessManager, so that connections to
+ * each tile server are pooled (and multiplexed over HTTP/2 when the server
+ * supports it), and at most @c kMaxRequests tiles are downloaded at a time.
+ *
+ * The disk cache is bounded by a configurable size, the least recently used
+ * tiles are removed when it is exceeded. Tiles of a region can be downloaded
+ * in advance with @c prefetch(), so that the map can be used offline (e.g. in
+ * the field with poor connectivity). Tiles requested by the map always have
+ * priority over prefetched tiles.
+ */
+class TileCache : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool prefetching
+             READ prefetching
+             NOTIFY prefetchChanged)
+  Q_PROPERTY(int prefetchTotal
+             READ prefetchTotal
+             NOTIFY prefetchChanged)
+  Q_PROPERTY(int prefetchCompleted
+             READ prefetchCompleted
+             NOTIFY prefetchChanged)
+  Q_PROPERTY(qint64 cacheSize
+             READ cacheSize
+             NOTIFY cacheSizeChanged)
+  Q_PROPERTY(int maxCacheSize
+             READ maxCacheSize
+             WRITE setMaxCacheSize
+             NOTIFY maxCacheSizeChanged)
+  // clang-format on
+
+signals:
+  void prefetchChanged();
+  void cacheSizeChanged();
+  void maxCacheSizeChanged();
+
+private:
+  TileCache();
+  TileCache(TileCache &&) = delete;
+  TileCache(const TileCache &) = delete;
+  TileCache &operator=(TileCache &&) = delete;
+  TileCache &operator=(const TileCache &) = delete;
+
+public:
+  static TileCache &instance();
+
+  [[nodiscard]] bool prefetching() const;
+  [[nodiscard]] int prefetchTotal() const;
+  [[nodiscard]] int prefetchCompleted() const;
+  [[nodiscard]] qint64 cacheSize() const;
+  [[nodiscard]] int maxCacheSize() const;
+
+  [[nodiscard]] QString localTemplate(const QString &provider,
+                                      const QString &upstream);
+
+  Q_INVOKABLE int tileCount(const qreal north, const qreal west,
+                            const qreal south, const qreal east,
+                            const int minZoom, const int maxZoom) const;
+
+public slots:
+  void clear();
+  void cancelPrefetch();
+  void setMaxCacheSize(const int megabytes);
+  void prefetch(const qreal north, const qreal west, const qreal south,
+                const qreal east, const int minZoom, const int maxZoom);
+
+private slots:
+  void onNewConnection();
+  void onRequestFinished();
+
+private:
+  struct Entry
+  {
+    qint64 size;
+    qint64 lastAccess;
+  };
+
+  void evict();
+  void loadIndex();
+  void startRequests();
+  void readRequest(QTcpSocket *socket);
+  void insert(const QString &key, const QByteArray &data);
+  void respond(QTcpSocket *socket, const QByteArray &data);
+
+  [[nodiscard]] QString filePath(const QString &key) const;
+  [[nodiscard]] QString upstreamUrl(const QString &key) const;
+
+private:
+  QString m_path;
+  QString m_activeProvider;
+  QHash<QString, QString> m_providers;
+
+  qint64 m_size;
+  int m_generation;
+  int m_maxCacheSize;
+  QHash<QString, Entry> m_entries;
+
+  int m_requests;
+  int m_prefetchRequests;
+  QSet<QString> m_pending;
+  QStringList m_queue;
+  QStringList m_prefetchQueue;
+  QHash<QString, QList<QPointer<QTcpSocket>>> m_waiting;
+
+  int m_prefetchTotal;
+  int m_prefetchCompleted;
+
+  QSettings m_settings;
+  QTcpServer m_server;
+  QNetworkAccessManager m_network;
+};
+} // namespace Misc
@@ -20,9 +20,62 @@
  * THE SOFTWARE.
  */
 
+#include <QScreen>
+#include <QWindow>
 #include <QTimerEvent>
+
+#include <algorithm>
+
 #include "Misc/TimerEvents.h"
 
+/**
+ * Lowest and highest UI refresh rates that can be selected (in Hz)
+ */
+static constexpr int kMinUiRefreshRate = 1;
+static constexpr int kMaxUiRefreshRate = 240;
+
+/**
+ * Adaptive refresh parameters: UI refresh rate while every window is hidden,
+ * lowest rate selected when the UI overruns its time budget, fraction of the
+ * GUI thread time spent in UI updates above which the rate is reduced & below
+ * which it can be raised, and seconds of headroom before raising the rate.
+ */
+static constexpr int kHiddenUiRefreshRate = 1;
+static constexpr int kMinAdaptiveUiRefreshRate = 5;
+static constexpr int kFallbackDisplayRefreshRate = 60;
+static constexpr double kHighUiLoad = 0.5;
+static constexpr double kLowUiLoad = 0.2;
+static constexpr int kHeadroomSeconds = 3;
+
+/**
+ * Low-power mode parameters: UI refresh rate while nothing changes on the
+ * screen, and seconds without changes before that rate is applied.
+ */
+static constexpr int kIdleUiRefreshRate = 2;
+static constexpr int kIdleSeconds = 3;
+
+/**
+ * Constructor function, reads the UI refresh rate from the settings
+ */
+Misc::TimerEvents::TimerEvents()
+  : m_idle(false)
+  , m_windowVisible(true)
+  , m_uiTicks(0)
+  , m_overruns(0)
+  , m_headroomSeconds(0)
+  , m_busyNs(0)
+  , m_lastUiTick(0)
+  , m_lastActivity(0)
+  , m_lastEvaluation(0)
+{
+  const auto hz = m_settings.value("ui_refresh_rate", 24).toInt();
+  m_uiRefreshRate = qBound(kMinUiRefreshRate, hz, kMaxUiRefreshRate);
+  m_adaptiveRefresh = m_settings.value("ui_adaptive_refresh", true).toBool();
+  m_lowPowerMode = m_settings.value("low_power_mode", false).toBool();
+  m_effectiveRate = m_uiRefreshRate;
+  m_clock.start();
+}
+
 /**
  * Returns a pointer to the only instance of the class
  */
@@ -32,11 +85,66 @@ Misc::TimerEvents &Misc::TimerEvents::instance()
   return singleton;
 }
 
+/**
+ * Returns the frequency (in Hz) at which the @c timeoutUi() signal is emitted
+ */
+int Misc::TimerEvents::uiRefreshRate() const
+{
+  return m_uiRefreshRate;
+}
+
+/**
+ * Returns @c true if the low-power mode is enabled, in which case the UI
+ * refresh rate is reduced while nothing changes on the screen
+ */
+bool Misc::TimerEvents::lowPowerMode() const
+{
+  return m_lowPowerMode;
+}
+
+/**
+ * Returns @c true if the UI refresh rate is adapted to the visibility of the
+ * windows & to the time spent updating the UI
+ */
+bool Misc::TimerEvents::adaptiveRefresh() const
+{
+  return m_adaptiveRefresh;
+}
+
+/**
+ * Returns the frequency (in Hz) at which the @c timeoutUi() signal is
+ * currently emitted, which differs from @c uiRefreshRate() when the adaptive
+ * refresh governor changed it
+ */
+int Misc::TimerEvents::effectiveUiRefreshRate() const
+{
+  return m_effectiveRate;
+}
+
+/**
+ * Registers a change of the displayed data, called by the modules that
+ * update the user interface on the UI refresh ticks.
+ *
+ * In low-power mode, the configured UI refresh rate is restored immediately
+ * if it had been reduced because nothing changed on the screen.
+ */
+void Misc::TimerEvents::wake()
+{
+  m_lastActivity = m_clock.nsecsElapsed();
+  if (m_idle)
+  {
+    m_idle = false;
+    m_headroomSeconds = 0;
+    applyUiRefreshRate(baseUiRefreshRate());
+  }
+}
+
 /**
  * Stops all the timers of this module
  */
 void Misc::TimerEvents::stopTimers()
 {
+  m_timerUi.stop();
   m_timer1Hz.stop();
   m_timer10Hz.stop();
   m_timer20Hz.stop();
@@ -48,8 +156,29 @@ void Misc::TimerEvents::stopTimers()
  */
 void Misc::TimerEvents::timerEvent(QTimerEvent *event)
 {
-  if (event->timerId() == m_timer1Hz.timerId())
+  if (event->timerId() == m_timerUi.timerId())
+  {
+    // Measure the time spent by the UI update slots
+    const auto start = m_clock.nsecsElapsed();
+    Q_EMIT timeoutUi();
+    const auto end = m_clock.nsecsElapsed();
+
+    // Register ticks that took too long, or that were delivered too late
+    const auto period = 1000000000 / m_effectiveRate;
+    const auto late = m_lastUiTick > 0 && start - m_lastUiTick > 2 * period;
+    if (end - start > period || late)
+      ++m_overruns;
+
+    ++m_uiTicks;
+    m_lastUiTick = start;
+    m_busyNs += end - start;
+  }
+
+  else if (event->timerId() == m_timer1Hz.timerId())
+  {
     Q_EMIT timeout1Hz();
+    governUiRefreshRate();
+  }
 
   else if (event->timerId() == m_timer10Hz.timerId())
     Q_EMIT timeout10Hz();
@@ -70,4 +199,261 @@ void Misc::TimerEvents::startTimers()
   m_timer20Hz.start(1000 / 20, Qt::PreciseTimer, this);
   m_timer24Hz.start(1000 / 24, Qt::PreciseTimer, this);
   m_timer10Hz.start(1000 / 10, Qt::PreciseTimer, this);
+  m_timerUi.start(1000 / m_effectiveRate, Qt::PreciseTimer, this);
+}
+
+/**
+ * Adapts the UI refresh rate to the visibility of the given @a window, which
+ * is usually a top-level window of the QML interface. The UI refresh rate is
+ * only reduced when every tracked window is minimized, hidden or occluded.
+ */
+void Misc::TimerEvents::trackWindow(QWindow *window)
+{
+  if (!window || m_windows.contains(window))
+    return;
+
+  m_windows.append(window);
+  window->installEventFilter(this);
+  connect(window, &QWindow::visibilityChanged, this,
+          &Misc::TimerEvents::updateWindowVisibility);
+  connect(window, &QObject::destroyed, this,
+          &Misc::TimerEvents::updateWindowVisibility, Qt::QueuedConnection);
+
+  updateWindowVisibility();
+}
+
+/**
+ * Changes the frequency (in Hz) at which the @c timeoutUi() signal is emitted,
+ * the value is saved in the application settings.
+ */
+void Misc::TimerEvents::setUiRefreshRate(const int hz)
+{
+  const auto rate = qBound(kMinUiRefreshRate, hz, kMaxUiRefreshRate);
+  if (m_uiRefreshRate != rate)
+  {
+    m_uiRefreshRate = rate;
+    m_settings.setValue("ui_refresh_rate", rate);
+    m_headroomSeconds = 0;
+    applyUiRefreshRate(baseUiRefreshRate());
+
+    Q_EMIT uiRefreshRateChanged();
+  }
+}
+
+/**
+ * Enables or disables the low-power mode, the value is saved in the
+ * application settings. The render loop selected for the low-power mode is
+ * only applied after restarting the application.
+ */
+void Misc::TimerEvents::setLowPowerMode(const bool enabled)
+{
+  if (m_lowPowerMode != enabled)
+  {
+    m_idle = false;
+    m_lowPowerMode = enabled;
+    m_settings.setValue("low_power_mode", enabled);
+    m_headroomSeconds = 0;
+    m_lastActivity = m_clock.nsecsElapsed();
+    applyUiRefreshRate(baseUiRefreshRate());
+
+    Q_EMIT lowPowerModeChanged();
+  }
+}
+
+/**
+ * Enables or disables the adaptive refresh governor, the value is saved in
+ * the application settings. Disabling it restores the configured UI refresh
+ * rate.
+ */
+void Misc::TimerEvents::setAdaptiveRefresh(const bool enabled)
+{
+  if (m_adaptiveRefresh != enabled)
+  {
+    m_adaptiveRefresh = enabled;
+    m_settings.setValue("ui_adaptive_refresh", enabled);
+    m_headroomSeconds = 0;
+    applyUiRefreshRate(baseUiRefreshRate());
+
+    Q_EMIT adaptiveRefreshChanged();
+  }
+}
+
+/**
+ * Updates the window visibility when a tracked window is exposed or occluded
+ * (e.g. covered by another window, or on an inactive virtual desktop), and
+ * leaves the low-power idle state when the user interacts with the window
+ */
+bool Misc::TimerEvents::eventFilter(QObject *watched, QEvent *event)
+{
+  switch (event->type())
+  {
+    case QEvent::Expose:
+      updateWindowVisibility();
+      break;
+    case QEvent::KeyPress:
+    case QEvent::Wheel:
+    case QEvent::TouchBegin:
+    case QEvent::MouseButtonPress:
+      if (m_idle)
+        wake();
+      break;
+    default:
+      break;
+  }
+
+  return QObject::eventFilter(watched, event);
+}
+
+/**
+ * Adapts the UI refresh rate once per second, according to the fraction of
+ * the GUI thread time that was spent in UI updates & to the number of ticks
+ * that overran their period. The rate is reduced by a third as soon as the UI
+ * can't keep up, and raised by a quarter after a few seconds of headroom, up
+ * to the refresh rate of the display (or to the configured rate in low-power
+ * mode).
+ *
+ * In low-power mode, the idle UI refresh rate is applied when @c wake() was
+ * not called during the last seconds.
+ */
+void Misc::TimerEvents::governUiRefreshRate()
+{
+  // Obtain the UI load during the last second & start a new measurement
+  const auto now = m_clock.nsecsElapsed();
+  const auto elapsed = now - m_lastEvaluation;
+  const auto load = elapsed > 0 ? double(m_busyNs) / elapsed : 0.0;
+  const bool overrun = m_overruns * 10 > m_uiTicks;
+  m_busyNs = 0;
+  m_uiTicks = 0;
+  m_overruns = 0;
+  m_lastEvaluation = now;
+
+  // Reduce the refresh rate while nothing changes in low-power mode
+  if (m_lowPowerMode && !m_idle && m_windowVisible
+      && now - m_lastActivity > qint64(kIdleSeconds) * 1000000000)
+  {
+    m_idle = true;
+    applyUiRefreshRate(baseUiRefreshRate());
+  }
+
+  // Nothing to do if the governor is disabled, or the windows are hidden
+  if (!m_adaptiveRefresh || !m_windowVisible || m_idle)
+    return;
+
+  // Back off quickly when the UI updates can't keep up
+  if (overrun || load > kHighUiLoad)
+  {
+    m_headroomSeconds = 0;
+    const auto hz = m_effectiveRate * 2 / 3;
+    const auto floor = std::min(kMinAdaptiveUiRefreshRate, m_effectiveRate);
+    applyUiRefreshRate(std::max(floor, hz));
+    return;
+  }
+
+  // Raise the rate slowly when there is headroom
+  if (load >= kLowUiLoad)
+    m_headroomSeconds = 0;
+
+  else if (++m_headroomSeconds >= kHeadroomSeconds)
+  {
+    m_headroomSeconds = 0;
+    auto ceiling = displayRefreshRate();
+    if (m_lowPowerMode)
+      ceiling = std::min(ceiling, m_uiRefreshRate);
+
+    if (m_effectiveRate < ceiling)
+    {
+      const auto step = std::max(1, m_effectiveRate / 4);
+      applyUiRefreshRate(std::min(ceiling, m_effectiveRate + step));
+    }
+  }
+}
+
+/**
+ * Checks if any of the tracked windows is visible & exposed, and applies the
+ * UI refresh rate that corresponds to the new state
+ */
+void Misc::TimerEvents::updateWindowVisibility()
+{
+  // Assume that the UI is visible if no window is tracked
+  bool visible = true;
+  bool tracked = false;
+  for (const auto &window : std::as_const(m_windows))
+  {
+    if (!window)
+      continue;
+
+    if (!tracked)
+      visible = false;
+
+    tracked = true;
+    const auto visibility = window->visibility();
+    if (visibility != QWindow::Hidden && visibility != QWindow::Minimized
+        && window->isExposed())
+    {
+      visible = true;
+      break;
+    }
+  }
+
+  // Restart from the configured refresh rate when the state changes
+  if (m_windowVisible != visible)
+  {
+    m_windowVisible = visible;
+    m_headroomSeconds = 0;
+    applyUiRefreshRate(baseUiRefreshRate());
+  }
+}
+
+/**
+ * Changes the frequency (in Hz) at which the @c timeoutUi() signal is emitted,
+ * without modifying the configured UI refresh rate
+ */
+void Misc::TimerEvents::applyUiRefreshRate(const int hz)
+{
+  const auto rate = qBound(kMinUiRefreshRate, hz, kMaxUiRefreshRate);
+  if (m_effectiveRate != rate)
+  {
+    m_effectiveRate = rate;
+    m_lastUiTick = 0;
+    if (m_timerUi.isActive())
+      m_timerUi.start(1000 / rate, Qt::PreciseTimer, this);
+
+    Q_EMIT effectiveUiRefreshRateChanged();
+  }
+}
+
+/**
+ * Returns the UI refresh rate to use before the governor adapts it, which is
+ * the configured rate, @c kHiddenUiRefreshRate if adaptive refresh or the
+ * low-power mode are enabled and every window is hidden, or the idle rate if
+ * nothing changed on the screen in low-power mode
+ */
+int Misc::TimerEvents::baseUiRefreshRate() const
+{
+  if ((m_adaptiveRefresh || m_lowPowerMode) && !m_windowVisible)
+    return kHiddenUiRefreshRate;
+
+  if (m_lowPowerMode && m_idle)
+    return std::min(kIdleUiRefreshRate, m_uiRefreshRate);
+
+  return m_uiRefreshRate;
+}
+
+/**
+ * Returns the highest refresh rate (in Hz) of the screens that display the
+ * tracked windows, or 60 Hz if it can't be obtained
+ */
+int Misc::TimerEvents::displayRefreshRate() const
+{
+  qreal hz = 0;
+  for (const auto &window : std::as_const(m_windows))
+  {
+    if (window && window->screen())
+      hz = std::max(hz, window->screen()->refreshRate());
+  }
+
+  if (hz < 1)
+    return kFallbackDisplayRefreshRate;
+
+  return qBound(kMinUiRefreshRate, qRound(hz), kMaxUiRefreshRate);
 }
@@ -22,8 +22,14 @@
 
 #pragma once
 
+#include <QList>
 #include <QObject>
+#include <QPointer>
+#include <QSettings>
 #include <QBasicTimer>
+#include <QElapsedTimer>
+
+class QWindow;
 
 namespace Misc
 {
@@ -32,19 +38,59 @@ namespace Misc
  *
  * The @c TimerEvents class implements periodic timers that are used to update
  * the user interface elements at a specific frequency.
+ *
+ * The @c timeoutUi() signal is emitted at the configurable UI refresh rate,
+ * which is stored in the application settings so that it can be tuned for
+ * each deployment (e.g. 60 Hz on workstations and 10 Hz on embedded panels).
+ *
+ * When adaptive refresh is enabled, the UI refresh rate is governed at
+ * runtime: it drops to 1 Hz while every tracked window is minimized or
+ * occluded, it is reduced when the slots connected to @c timeoutUi() overrun
+ * their time budget, and it is raised towards the refresh rate of the display
+ * when there is headroom. The other timers, and thus data acquisition, are
+ * not affected.
+ *
+ * The low-power mode is meant for embedded panels that display steady values
+ * for long periods. In this mode, the UI refresh rate is never raised above
+ * the configured rate, and it drops to 2 Hz when nothing changed on the
+ * screen for a few seconds. Modules that change what is displayed (e.g. new
+ * dataset values or alarms) call @c wake(), which restores the configured
+ * rate immediately. Animations such as the terminal cursor are disabled.
  */
 class TimerEvents : public QObject
 {
+  // clang-format off
   Q_OBJECT
+  Q_PROPERTY(int uiRefreshRate
+             READ uiRefreshRate
+             WRITE setUiRefreshRate
+             NOTIFY uiRefreshRateChanged)
+  Q_PROPERTY(bool adaptiveRefresh
+             READ adaptiveRefresh
+             WRITE setAdaptiveRefresh
+             NOTIFY adaptiveRefreshChanged)
+  Q_PROPERTY(int effectiveUiRefreshRate
+             READ effectiveUiRefreshRate
+             NOTIFY effectiveUiRefreshRateChanged)
+  Q_PROPERTY(bool lowPowerMode
+             READ lowPowerMode
+             WRITE setLowPowerMode
+             NOTIFY lowPowerModeChanged)
+  // clang-format on
 
 signals:
+  void timeoutUi();
   void timeout1Hz();
   void timeout10Hz();
   void timeout20Hz();
   void timeout24Hz();
+  void uiRefreshRateChanged();
+  void lowPowerModeChanged();
+  void adaptiveRefreshChanged();
+  void effectiveUiRefreshRateChanged();
 
 private:
-  TimerEvents() {};
+  TimerEvents();
   TimerEvents(TimerEvents &&) = delete;
   TimerEvents(const TimerEvents &) = delete;
   TimerEvents &operator=(TimerEvents &&) = delete;
@@ -53,14 +99,52 @@ private:
 public:
   static TimerEvents &instance();
 
+  [[nodiscard]] int uiRefreshRate() const;
+  [[nodiscard]] bool lowPowerMode() const;
+  [[nodiscard]] bool adaptiveRefresh() const;
+  [[nodiscard]] int effectiveUiRefreshRate() const;
+
 protected:
   void timerEvent(QTimerEvent *event) override;
+  bool eventFilter(QObject *watched, QEvent *event) override;
 
 public slots:
+  void wake();
   void stopTimers();
   void startTimers();
+  void trackWindow(QWindow *window);
+  void setUiRefreshRate(const int hz);
+  void setLowPowerMode(const bool enabled);
+  void setAdaptiveRefresh(const bool enabled);
 
 private:
+  void governUiRefreshRate();
+  void updateWindowVisibility();
+  void applyUiRefreshRate(const int hz);
+  [[nodiscard]] int baseUiRefreshRate() const;
+  [[nodiscard]] int displayRefreshRate() const;
+
+private:
+  int m_uiRefreshRate;
+  int m_effectiveRate;
+  QSettings m_settings;
+
+  bool m_idle;
+  bool m_lowPowerMode;
+  bool m_windowVisible;
+  bool m_adaptiveRefresh;
+  QList<QPointer<QWindow>> m_windows;
+
+  int m_uiTicks;
+  int m_overruns;
+  int m_headroomSeconds;
+  qint64 m_busyNs;
+  qint64 m_lastUiTick;
+  qint64 m_lastActivity;
+  qint64 m_lastEvaluation;
+  QElapsedTimer m_clock;
+
+  QBasicTimer m_timerUi;
   QBasicTimer m_timer1Hz;
   QBasicTimer m_timer10Hz;
   QBasicTimer m_timer20Hz;
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/Trace.h"
+
+#ifdef ENABLE_PERFETTO_TRACE
+
+#  include <mutex>
+#  include <chrono>
+#  include <cstdio>
+#  include <string>
+#  include <vector>
+#  include <cstdlib>
+#  include <unordered_map>
+
+#  include <QThread>
+
+/**
+ * Maximum number of recorded events (roughly 32 bytes each)
+ */
+static constexpr std::size_t kMaxEvents = 8 * 1024 * 1024;
+
+//------------------------------------------------------------------------------
+// Event recorder
+//------------------------------------------------------------------------------
+
+namespace
+{
+/**
+ * @brief A single trace event, either a complete zone or a counter sample.
+ */
+struct Event
+{
+  const char *name;
+  qint64 timestamp;
+  qint64 value;
+  quintptr thread;
+  bool counter;
+};
+
+/**
+ * @brief Collects the trace events of every thread & writes them to a Chrome
+ *        JSON trace file when the application exits.
+ *
+ * Events are appended to a preallocated vector under a mutex, which is
+ * uncontended most of the time since each pipeline stage runs in a different
+ * thread at a different moment. Once @c kMaxEvents is reached, new events are
+ * discarded so that long sessions do not exhaust memory.
+ */
+class Recorder
+{
+public:
+  Recorder() { m_events.reserve(1024 * 1024); }
+
+  ~Recorder() { save(); }
+
+  void add(const Event &event)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_events.size() < kMaxEvents)
+      m_events.push_back(event);
+  }
+
+  void registerThread(const quintptr thread, const std::string &name)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads[thread] = name;
+  }
+
+private:
+  void save()
+  {
+    // Obtain output file
+    const char *path = std::getenv("SERIAL_STUDIO_TRACE");
+    if (!path || !*path)
+      path = "serial-studio-trace.json";
+
+    FILE *file = std::fopen(path, "w");
+    if (!file)
+      return;
+
+    // Write thread names
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const auto &thread : m_threads)
+    {
+      std::fprintf(file,
+                   "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"tid\":%llu,\"args\":{\"name\":\"%s\"}}",
+                   first ? "" : ",\n",
+                   static_cast<unsigned long long>(thread.first),
+                   thread.second.c_str());
+      first = false;
+    }
+
+    // Write zones & counters, timestamps are given in microseconds
+    for (const auto &event : m_events)
+    {
+      if (event.counter)
+        std::fprintf(file,
+                     "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,"
+                     "\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                     first ? "" : ",\n", event.name, event.timestamp / 1e3,
+                     static_cast<long long>(event.value));
+      else
+        std::fprintf(file,
+                     "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                     "\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",\n", event.name,
+                     static_cast<unsigned long long>(event.thread),
+                     event.timestamp / 1e3, event.value / 1e3);
+
+      first = false;
+    }
+
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<Event> m_events;
+  std::unordered_map<quintptr, std::string> m_threads;
+};
+
+/**
+ * Returns the event recorder shared by every thread
+ */
+Recorder &recorder()
+{
+  static Recorder instance;
+  return instance;
+}
+
+/**
+ * Returns the current time of the steady clock, in nanoseconds
+ */
+qint64 timestamp()
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+/**
+ * Returns an identifier of the calling thread, registering the name of the
+ * thread the first time it records an event.
+ */
+quintptr currentThread()
+{
+  thread_local const quintptr id = [] {
+    const auto thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    auto name = QThread::currentThread()->objectName().toStdString();
+    if (name.empty())
+      name = "Thread " + std::to_string(thread);
+
+    recorder().registerThread(thread, name);
+    return thread;
+  }();
+
+  return id;
+}
+} // namespace
+
+//------------------------------------------------------------------------------
+// Trace zones & counters
+//------------------------------------------------------------------------------
+
+/**
+ * Starts measuring the zone with the given @a name, which must be a string
+ * literal (only the pointer is stored).
+ */
+Misc::Trace::Zone::Zone(const char *name)
+  : m_name(name)
+  , m_start(timestamp())
+{
+}
+
+/**
+ * Records the zone, from construction until now
+ */
+Misc::Trace::Zone::~Zone()
+{
+  const auto end = timestamp();
+  recorder().add({m_name, m_start, end - m_start, currentThread(), false});
+}
+
+/**
+ * Records a sample of the counter with the given @a name, which must be a
+ * string literal (only the pointer is stored).
+ */
+void Misc::Trace::counter(const char *name, const qint64 value)
+{
+  recorder().add({name, timestamp(), value, currentThread(), true});
+}
+
+#endif
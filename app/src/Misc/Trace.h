@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+/**
+ * @file Trace.h
+ * @brief Compile-time trace zones & counters for deep profiling sessions.
+ *
+ * Hot functions of the data path declare a trace zone with @c TRACE_ZONE()
+ * and report queue depths with @c TRACE_COUNTER(). Depending on the build
+ * options, the macros expand to:
+ *
+ * - @c ENABLE_TRACY: Tracy zones & plots, streamed to the Tracy profiler.
+ * - @c ENABLE_PERFETTO_TRACE: events recorded by @c Misc::Trace, written as a
+ *   Chrome JSON trace (which the Perfetto UI opens) when the application
+ *   exits. The output file is given by the @c SERIAL_STUDIO_TRACE environment
+ *   variable, and defaults to @c serial-studio-trace.json.
+ * - Otherwise: nothing. Arguments are not evaluated, so disabled trace points
+ *   have no cost at all.
+ */
+
+#if defined(ENABLE_TRACY)
+#  include <tracy/Tracy.hpp>
+#  define TRACE_ZONE(name) ZoneScopedN(name)
+#  define TRACE_COUNTER(name, value)                                           \
+    TracyPlot(name, static_cast<int64_t>(value))
+
+#elif defined(ENABLE_PERFETTO_TRACE)
+#  include <QtGlobal>
+
+namespace Misc
+{
+namespace Trace
+{
+/**
+ * @brief Records the duration of the enclosing scope as a trace event.
+ */
+class Zone
+{
+public:
+  explicit Zone(const char *name);
+  ~Zone();
+
+  Zone(Zone &&) = delete;
+  Zone(const Zone &) = delete;
+  Zone &operator=(Zone &&) = delete;
+  Zone &operator=(const Zone &) = delete;
+
+private:
+  const char *m_name;
+  qint64 m_start;
+};
+
+void counter(const char *name, const qint64 value);
+} // namespace Trace
+} // namespace Misc
+
+#  define TRACE_CONCAT_IMPL(a, b) a##b
+#  define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#  define TRACE_ZONE(name)                                                     \
+    const Misc::Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#  define TRACE_COUNTER(name, value)                                           \
+    Misc::Trace::counter(name, static_cast<qint64>(value))
+
+#else
+#  define TRACE_ZONE(name)
+#  define TRACE_COUNTER(name, value)
+#endif
@@ -33,6 +33,12 @@
 #include "AppInfo.h"
 #include "Misc/Utilities.h"
 
+//------------------------------------------------------------------------------
+// Message box behavior
+//------------------------------------------------------------------------------
+
+static bool s_interactive = true;
+
 /**
  * Returns a pointer to the only instance of the class
  */
@@ -77,6 +83,25 @@ bool Misc::Utilities::askAutomaticUpdates()
   return result == QMessageBox::Yes;
 }
 
+/**
+ * Returns @c true if message boxes are shown to the user, or @c false if
+ * they are only written to the log (e.g. when running in headless mode).
+ */
+bool Misc::Utilities::interactive()
+{
+  return s_interactive;
+}
+
+/**
+ * Enables or disables message boxes. When disabled, @c showMessageBox()
+ * writes the message to the log and returns @c QMessageBox::NoButton
+ * immediately, so that callers proceed as if the dialog was dismissed.
+ */
+void Misc::Utilities::setInteractive(const bool interactive)
+{
+  s_interactive = interactive;
+}
+
 /**
  * Shows a macOS-like message box with the given properties
  */
@@ -85,6 +110,17 @@ int Misc::Utilities::showMessageBox(const QString &text,
                                     const QString &windowTitle,
                                     const QMessageBox::StandardButtons &bt)
 {
+  // Log the message instead of blocking on a dialog nobody will see
+  if (!s_interactive)
+  {
+    if (informativeText.isEmpty())
+      qWarning().noquote() << text;
+    else
+      qWarning().noquote() << text << "-" << informativeText;
+
+    return QMessageBox::NoButton;
+  }
+
   // Get app icon
   QPixmap icon;
   if (qApp->devicePixelRatio() >= 2)
@@ -41,7 +41,9 @@ class Utilities : public QObject
 
 public:
   static Utilities &instance();
+  static bool interactive();
   static void rebootApplication();
+  static void setInteractive(const bool interactive);
   Q_INVOKABLE bool askAutomaticUpdates();
 
   // clang-format off
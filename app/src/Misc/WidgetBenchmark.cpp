@@ -0,0 +1,762 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Misc/WidgetBenchmark.h"
+
+#include <cmath>
+
+#include <QFile>
+#include <QTimer>
+#include <QThread>
+#include <QSysInfo>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QJsonDocument>
+#include <QQmlComponent>
+#include <QQuickRenderTarget>
+#include <QQuickRenderControl>
+#include <QQuickGraphicsConfiguration>
+
+#include <rhi/qrhi.h>
+
+#include "AppInfo.h"
+#include "IO/Console.h"
+#include "UI/Dashboard.h"
+#include "Misc/ThemeManager.h"
+
+#if defined(Q_OS_WIN)
+#  include <windows.h>
+#  include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#  include <mach/mach.h>
+#  include <sys/resource.h>
+#elif defined(Q_OS_UNIX)
+#  include <unistd.h>
+#  include <sys/resource.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Benchmark parameters
+//------------------------------------------------------------------------------
+
+static constexpr int kDefaultCopies = 8;
+static constexpr int kMaxCopies = 64;
+static constexpr int kFrameRate = 60;
+static constexpr int kSampleRate = 1000;
+static constexpr int kSampleCount = 256;
+static constexpr int kWarmupMs = 1000;
+static constexpr int kDurationMs = 3000;
+static constexpr QSize kTileSize(480, 320);
+
+/**
+ * QML component of the dashboard widgets, which wraps the widget of the given
+ * index in the same pane as the dashboard
+ */
+static constexpr auto kWidgetQml
+    = "qrc:/qml/MainWindow/Dashboard/WidgetDelegate.qml";
+
+/**
+ * QML component of the terminal, which is not part of the dashboard model
+ */
+static constexpr auto kTerminalQml = "qrc:/qml/Widgets/Dashboard/Terminal.qml";
+
+/**
+ * Offscreen window of the benchmark that is currently running (if any)
+ */
+static const QWindow *s_offscreenWindow = nullptr;
+
+//------------------------------------------------------------------------------
+// Constructor & destructor functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs a widget benchmark that instantiates the widgets with the
+ *        given QML @a engine, which must expose the C++ modules of the user
+ *        interface.
+ */
+Misc::WidgetBenchmark::WidgetBenchmark(QQmlEngine *engine)
+  : m_engine(engine)
+{
+}
+
+/**
+ * @brief Destroys the widgets & the offscreen renderer.
+ */
+Misc::WidgetBenchmark::~WidgetBenchmark()
+{
+  release();
+}
+
+//------------------------------------------------------------------------------
+// Benchmark execution
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Renders each widget type & writes the JSON report.
+ *
+ * The report is written to @a outputPath, or to the standard output if no
+ * path is given. A human-readable summary of each widget type is printed
+ * through the Qt message handler while the benchmarks run.
+ *
+ * @param copies Number of widgets of each type that are rendered at the same
+ *               time (a default is used if not positive).
+ * @param outputPath Location of the JSON report (optional).
+ * @return @c EXIT_SUCCESS, or @c EXIT_FAILURE if the report can't be written.
+ */
+int Misc::WidgetBenchmark::run(const int copies, const QString &outputPath)
+{
+  // Validate the number of copies
+  const auto count = copies > 0 ? qMin(copies, kMaxCopies) : kDefaultCopies;
+
+  // Render every widget type
+  m_results.clear();
+  benchmarkWidget(QStringLiteral("Plot"), SerialStudio::DashboardPlot, count);
+  benchmarkWidget(QStringLiteral("MultiPlot"), SerialStudio::DashboardMultiPlot,
+                  count);
+  benchmarkWidget(QStringLiteral("FFTPlot"), SerialStudio::DashboardFFT, count);
+  benchmarkWidget(QStringLiteral("Waterfall"), SerialStudio::DashboardWaterfall,
+                  count);
+  benchmarkWidget(QStringLiteral("Gauge"), SerialStudio::DashboardGauge, count);
+  benchmarkWidget(QStringLiteral("Bar"), SerialStudio::DashboardBar, count);
+  benchmarkWidget(QStringLiteral("Compass"), SerialStudio::DashboardCompass,
+                  count);
+  benchmarkWidget(QStringLiteral("GPS"), SerialStudio::DashboardGPS, count);
+  benchmarkWidget(QStringLiteral("DataGrid"), SerialStudio::DashboardDataGrid,
+                  count);
+  benchmarkWidget(QStringLiteral("LEDPanel"), SerialStudio::DashboardLED,
+                  count);
+  benchmarkTerminal(count);
+  benchmarkWidget(QStringLiteral("Accelerometer"),
+                  SerialStudio::DashboardAccelerometer, count);
+  benchmarkWidget(QStringLiteral("Gyroscope"), SerialStudio::DashboardGyroscope,
+                  count);
+
+  // Generate the report
+  const auto json = QJsonDocument(report()).toJson(QJsonDocument::Indented);
+
+  // Write the report to the standard output
+  if (outputPath.isEmpty())
+  {
+    QFile output;
+    if (output.open(stdout, QIODevice::WriteOnly))
+    {
+      output.write(json);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  // Write the report to the given file
+  else
+  {
+    QFile output(outputPath);
+    if (output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      output.write(json);
+      qInfo() << "Widget benchmark report written to" << outputPath;
+      return EXIT_SUCCESS;
+    }
+  }
+
+  qCritical() << "Cannot write widget benchmark report" << outputPath;
+  return EXIT_FAILURE;
+}
+
+/**
+ * Returns @c true if the given @a window is the offscreen window in which the
+ * benchmark renders the widgets, which must stay enabled even though the
+ * window is never shown
+ */
+bool Misc::WidgetBenchmark::isOffscreenWindow(const QWindow *window)
+{
+  return window && window == s_offscreenWindow;
+}
+
+/**
+ * @brief Renders copies of a widget & records what they cost.
+ *
+ * One item is created from @a qmlPath for each set of initial @a properties,
+ * and the items are tiled in the offscreen window. The window is then rendered
+ * at @c kFrameRate for @c kWarmupMs milliseconds (so that asynchronous loaders
+ * finish and caches are filled), and for @c kDurationMs milliseconds while the
+ * CPU & GPU times are recorded. @a feed is called before each frame with the
+ * number of the frame, and must hand the synthetic data to the widgets.
+ *
+ * The memory of the widgets is the growth of the resident memory of the
+ * process between the creation of the offscreen window & the end of the run.
+ */
+template<typename Function>
+void Misc::WidgetBenchmark::measure(const QString &name, const QString &qmlPath,
+                                    const QVector<QVariantMap> &properties,
+                                    Function &&feed)
+{
+  // Nothing to render
+  if (properties.isEmpty())
+  {
+    qWarning() << "Widget benchmark:" << name << "has no widgets";
+    return;
+  }
+
+  // Create an offscreen window with a tile for each widget
+  const auto memory = residentMemory();
+  const auto count = static_cast<int>(properties.count());
+  const auto columns = static_cast<int>(std::ceil(std::sqrt(count)));
+  const auto rows = (count + columns - 1) / columns;
+  if (!initialize(QSize(columns * kTileSize.width(),
+                        rows * kTileSize.height())))
+    return;
+
+  // Instantiate the widgets
+  QQmlComponent component(m_engine, QUrl(qmlPath));
+  for (int i = 0; i < count; ++i)
+  {
+    auto *object = component.createWithInitialProperties(properties.at(i));
+    auto *item = qobject_cast<QQuickItem *>(object);
+    if (!item)
+    {
+      qWarning() << "Widget benchmark:" << component.errorString();
+      delete object;
+      release();
+      return;
+    }
+
+    item->setParentItem(m_window->contentItem());
+    item->setPosition(QPointF((i % columns) * kTileSize.width(),
+                              (i / columns) * kTileSize.height()));
+    item->setSize(kTileSize);
+    m_items.append(item);
+  }
+
+  // Let the widgets load & reach a steady state
+  int frame = 0;
+  runFrames(kWarmupMs, [&] {
+    feed(frame++);
+    (void)renderFrame();
+  });
+
+  // Render the widgets & measure the time spent in each frame
+  Result result{name, count, 0, 0, 0, 0, 0};
+  runFrames(kDurationMs, [&] {
+    const auto start = cpuTime();
+    feed(frame++);
+    const auto gpuTime = renderFrame();
+    result.cpuTimeNs += cpuTime() - start;
+    ++result.frames;
+
+    if (gpuTime > 0)
+    {
+      result.gpuTimeNs += gpuTime * 1e9;
+      ++result.gpuFrames;
+    }
+  });
+
+  // Register the result & destroy the widgets
+  result.memoryBytes = qMax<qint64>(0, residentMemory() - memory);
+  m_results.append(result);
+  release();
+
+  // Print a summary of the result
+  const double frames = qMax<qint64>(1, result.frames);
+  const double gpuFrames = qMax<qint64>(1, result.gpuFrames);
+  qInfo().noquote() << QStringLiteral(
+                           "%1: %2 us CPU, %3 us GPU, %4 KiB per widget")
+                           .arg(name, -16)
+                           .arg(result.cpuTimeNs / frames / count / 1e3, 0,
+                                'f', 1)
+                           .arg(result.gpuTimeNs / gpuFrames / count / 1e3, 0,
+                                'f', 1)
+                           .arg(result.memoryBytes / count / 1024);
+}
+
+/**
+ * @brief Calls @a frame at @c kFrameRate for @a duration milliseconds.
+ *
+ * The frames are driven by a precise timer in a local event loop, so that the
+ * asynchronous loaders of the widgets & deferred deletions are processed just
+ * like in the user interface.
+ */
+template<typename Function>
+void Misc::WidgetBenchmark::runFrames(const int duration, Function &&frame)
+{
+  QEventLoop loop;
+  QTimer timer;
+  timer.setTimerType(Qt::PreciseTimer);
+  QObject::connect(&timer, &QTimer::timeout, &loop, [&] { frame(); });
+  QTimer::singleShot(duration, &loop, &QEventLoop::quit);
+  timer.start(1000 / kFrameRate);
+  loop.exec();
+}
+
+//------------------------------------------------------------------------------
+// Benchmark cases
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Renders @a copies dashboard widgets of the given type.
+ *
+ * A frame with one group per copy is loaded into the dashboard, and one
+ * widget delegate is created for each dashboard widget of the benchmarked
+ * type. Before each rendered frame, the dashboard receives the frames that
+ * arrived at @c kSampleRate since the previous one & updates its widgets.
+ */
+void Misc::WidgetBenchmark::benchmarkWidget(
+    const QString &name, const SerialStudio::DashboardWidget widget,
+    const int copies)
+{
+  // Generate frames with the same structure and different values
+  QVector<JSON::Frame> frames;
+  frames.reserve(kSampleCount);
+  for (int i = 0; i < kSampleCount; ++i)
+    frames.append(projectFrame(widget, copies, i));
+
+  // Load the widgets into the dashboard
+  auto &dashboard = UI::Dashboard::instance();
+  dashboard.resetData(false);
+  dashboard.processFrame(frames.first());
+  dashboard.updateWidgets();
+
+  // Create a delegate for each widget of the benchmarked type
+  QVector<QVariantMap> properties;
+  for (int i = 0; i < dashboard.totalWidgetCount(); ++i)
+  {
+    if (dashboard.widgetType(i) == widget)
+      properties.append({{QStringLiteral("widgetIndex"), i}});
+  }
+
+  // Feed the data of each rendered frame to the dashboard
+  int sample = 0;
+  constexpr int samplesPerFrame = kSampleRate / kFrameRate;
+  measure(name, QString::fromLatin1(kWidgetQml), properties, [&](int) {
+    for (int i = 0; i < samplesPerFrame; ++i)
+      dashboard.processFrame(frames.at(sample++ % kSampleCount));
+
+    dashboard.m_updateRequired = true;
+    dashboard.updateWidgets();
+  });
+
+  // Discard the benchmark data
+  dashboard.resetData(false);
+}
+
+/**
+ * @brief Renders @a copies terminals, which display the text appended to the
+ *        console with one line per synthetic sample.
+ */
+void Misc::WidgetBenchmark::benchmarkTerminal(const int copies)
+{
+  QVector<QVariantMap> properties(copies);
+  constexpr int samplesPerFrame = kSampleRate / kFrameRate;
+  auto &console = IO::Console::instance();
+  measure(QStringLiteral("Terminal"), QString::fromLatin1(kTerminalQml),
+          properties, [&](const int frame) {
+            QString text;
+            for (int i = 0; i < samplesPerFrame; ++i)
+            {
+              const auto sample = frame * samplesPerFrame + i;
+              text += QStringLiteral("%1,%2,%3\n")
+                          .arg(sample)
+                          .arg(std::sin(sample * 0.05), 0, 'f', 4)
+                          .arg(std::cos(sample * 0.05), 0, 'f', 4);
+            }
+
+            console.append(text);
+          });
+
+  console.clear();
+}
+
+//------------------------------------------------------------------------------
+// Offscreen rendering
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Creates the offscreen window & the texture of the given @a size in
+ *        which the widgets are rendered.
+ *
+ * GPU timestamps are requested from the graphics API, so that the duration of
+ * each frame on the GPU can be read back once the frame completes.
+ *
+ * @return @c false if the offscreen renderer could not be created.
+ */
+bool Misc::WidgetBenchmark::initialize(const QSize &size)
+{
+  // Destroy the renderer of the previous widget type
+  release();
+
+  // The widgets need the context properties of the user interface
+  if (!m_engine)
+  {
+    qWarning() << "Widget benchmark: QML engine not available";
+    return false;
+  }
+
+  // Create the offscreen window
+  const auto &theme = Misc::ThemeManager::instance();
+  m_renderControl = std::make_unique<QQuickRenderControl>();
+  m_window = std::make_unique<QQuickWindow>(m_renderControl.get());
+  m_window->setColor(theme.getColor("dashboard_background"));
+  m_window->setGeometry(QRect(QPoint(0, 0), size));
+  m_window->contentItem()->setSize(size);
+  s_offscreenWindow = m_window.get();
+
+  // Enable GPU timestamps
+  auto config = m_window->graphicsConfiguration();
+  config.setTimestamps(true);
+  m_window->setGraphicsConfiguration(config);
+
+  // Initialize the graphics API
+  if (!m_renderControl->initialize())
+  {
+    qWarning() << "Widget benchmark: cannot initialize the renderer";
+    release();
+    return false;
+  }
+
+  // Create the texture in which the widgets are rendered
+  auto *rhi = m_renderControl->rhi();
+  m_texture.reset(rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+                                  QRhiTexture::RenderTarget));
+  m_depthStencil.reset(
+      rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size, 1));
+  if (!m_texture->create() || !m_depthStencil->create())
+  {
+    qWarning() << "Widget benchmark: cannot create the render texture";
+    release();
+    return false;
+  }
+
+  // Create the render target
+  QRhiTextureRenderTargetDescription description(
+      (QRhiColorAttachment(m_texture.get())));
+  description.setDepthStencilBuffer(m_depthStencil.get());
+  m_renderTarget.reset(rhi->newTextureRenderTarget(description));
+  m_renderPass.reset(m_renderTarget->newCompatibleRenderPassDescriptor());
+  m_renderTarget->setRenderPassDescriptor(m_renderPass.get());
+  if (!m_renderTarget->create())
+  {
+    qWarning() << "Widget benchmark: cannot create the render target";
+    release();
+    return false;
+  }
+
+  // Render the window into the texture
+  m_window->setRenderTarget(
+      QQuickRenderTarget::fromRhiRenderTarget(m_renderTarget.get()));
+  return true;
+}
+
+/**
+ * @brief Destroys the widgets, the offscreen window & the graphics resources
+ *        used to render them, the graphics resources must be destroyed before
+ *        the render control.
+ */
+void Misc::WidgetBenchmark::release()
+{
+  qDeleteAll(m_items);
+  m_items.clear();
+
+  m_renderTarget.reset();
+  m_renderPass.reset();
+  m_depthStencil.reset();
+  m_texture.reset();
+  m_renderControl.reset();
+  m_window.reset();
+  s_offscreenWindow = nullptr;
+}
+
+/**
+ * @brief Renders one frame of the offscreen window.
+ *
+ * @return Duration of the last frame completed by the GPU (in seconds), or 0
+ *         if the graphics API does not report timestamps.
+ */
+double Misc::WidgetBenchmark::renderFrame()
+{
+  if (!m_window || !m_renderControl)
+    return 0;
+
+  m_renderControl->polishItems();
+  m_renderControl->beginFrame();
+  m_renderControl->sync();
+  m_renderControl->render();
+
+  double gpuTime = 0;
+  auto *commandBuffer = m_renderControl->commandBuffer();
+  if (commandBuffer)
+    gpuTime = commandBuffer->lastCompletedGpuTime();
+
+  m_renderControl->endFrame();
+  return gpuTime;
+}
+
+//------------------------------------------------------------------------------
+// Report generation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Builds the JSON report with the results of every widget type and a
+ *        description of the system that ran the benchmark.
+ *
+ * The GPU time is omitted when the graphics API does not report timestamps.
+ */
+QJsonObject Misc::WidgetBenchmark::report() const
+{
+  QJsonArray widgets;
+  for (const auto &result : m_results)
+  {
+    const double frames = qMax<qint64>(1, result.frames);
+
+    QJsonObject object;
+    object.insert(QStringLiteral("name"), result.name);
+    object.insert(QStringLiteral("copies"), result.copies);
+    object.insert(QStringLiteral("frames"), result.frames);
+    object.insert(QStringLiteral("cpuNsPerFrame"), result.cpuTimeNs / frames);
+    object.insert(QStringLiteral("cpuNsPerWidget"),
+                  result.cpuTimeNs / frames / result.copies);
+    if (result.gpuFrames > 0)
+    {
+      const double gpuTime = result.gpuTimeNs / result.gpuFrames;
+      object.insert(QStringLiteral("gpuNsPerFrame"), gpuTime);
+      object.insert(QStringLiteral("gpuNsPerWidget"), gpuTime / result.copies);
+    }
+
+    object.insert(QStringLiteral("memoryBytes"), result.memoryBytes);
+    object.insert(QStringLiteral("memoryBytesPerWidget"),
+                  result.memoryBytes / result.copies);
+    widgets.append(object);
+  }
+
+  QJsonObject settings;
+  settings.insert(QStringLiteral("frameRate"), kFrameRate);
+  settings.insert(QStringLiteral("sampleRate"), kSampleRate);
+  settings.insert(QStringLiteral("durationMs"), kDurationMs);
+  settings.insert(QStringLiteral("tileWidth"), kTileSize.width());
+  settings.insert(QStringLiteral("tileHeight"), kTileSize.height());
+
+  QJsonObject system;
+  system.insert(QStringLiteral("os"), QSysInfo::prettyProductName());
+  system.insert(QStringLiteral("kernel"), QSysInfo::kernelVersion());
+  system.insert(QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture());
+  system.insert(QStringLiteral("threads"), QThread::idealThreadCount());
+
+  QJsonObject object;
+  object.insert(QStringLiteral("application"), APP_NAME);
+  object.insert(QStringLiteral("version"), APP_VERSION);
+  object.insert(QStringLiteral("date"),
+                QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+  object.insert(QStringLiteral("system"), system);
+  object.insert(QStringLiteral("settings"), settings);
+  object.insert(QStringLiteral("widgets"), widgets);
+  return object;
+}
+
+//------------------------------------------------------------------------------
+// Synthetic data generation
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Generates a frame with @a copies groups that are displayed by the
+ *        given @a widget type, with the values of the given @a sample.
+ *
+ * Dataset widgets get one dataset per group, while group widgets get the
+ * datasets that they display (e.g. the axes of an accelerometer).
+ */
+JSON::Frame
+Misc::WidgetBenchmark::projectFrame(const SerialStudio::DashboardWidget widget,
+                                    const int copies, const int sample)
+{
+  // Select the group widget & the dataset widgets of the benchmarked type
+  QString groupWidget;
+  QStringList datasetWidgets;
+  switch (widget)
+  {
+    case SerialStudio::DashboardMultiPlot:
+      groupWidget = QStringLiteral("multiplot");
+      datasetWidgets = {QString(), QString(), QString(), QString()};
+      break;
+    case SerialStudio::DashboardAccelerometer:
+      groupWidget = QStringLiteral("accelerometer");
+      datasetWidgets = {"x", "y", "z"};
+      break;
+    case SerialStudio::DashboardGyroscope:
+      groupWidget = QStringLiteral("gyro");
+      datasetWidgets = {"x", "y", "z"};
+      break;
+    case SerialStudio::DashboardGPS:
+      groupWidget = QStringLiteral("map");
+      datasetWidgets = {"lat", "lon", "alt"};
+      break;
+    case SerialStudio::DashboardDataGrid:
+      groupWidget = QStringLiteral("datagrid");
+      for (int i = 0; i < 8; ++i)
+        datasetWidgets.append(QString());
+      break;
+    case SerialStudio::DashboardLED:
+      for (int i = 0; i < 8; ++i)
+        datasetWidgets.append(QString());
+      break;
+    case SerialStudio::DashboardGauge:
+      datasetWidgets = {"gauge"};
+      break;
+    case SerialStudio::DashboardBar:
+      datasetWidgets = {"bar"};
+      break;
+    case SerialStudio::DashboardCompass:
+      datasetWidgets = {"compass"};
+      break;
+    default:
+      datasetWidgets = {QString()};
+      break;
+  }
+
+  // Generate the groups
+  int index = 1;
+  QJsonArray groups;
+  for (int g = 0; g < copies; ++g)
+  {
+    QJsonArray datasets;
+    for (int d = 0; d < datasetWidgets.count(); ++d)
+    {
+      const auto phase = sample * 0.05 + g + d * 0.5;
+      auto value = std::sin(phase) * 100;
+      if (widget == SerialStudio::DashboardCompass)
+        value = 180 + std::sin(phase) * 180;
+      else if (widget == SerialStudio::DashboardGPS)
+        value = d == 0 ? 19.43 + std::sin(phase) * 0.01
+                : d == 1 ? -99.13 + std::cos(phase) * 0.01
+                         : 2240 + std::sin(phase) * 10;
+
+      QJsonObject dataset;
+      dataset.insert(QStringLiteral("index"), index++);
+      dataset.insert(QStringLiteral("title"),
+                     QStringLiteral("Dataset %1").arg(d + 1));
+      dataset.insert(QStringLiteral("value"), QString::number(value, 'f', 4));
+      dataset.insert(QStringLiteral("widget"), datasetWidgets.at(d));
+      dataset.insert(QStringLiteral("min"), -100);
+      dataset.insert(QStringLiteral("max"), 100);
+      dataset.insert(QStringLiteral("graph"),
+                     widget == SerialStudio::DashboardPlot);
+      dataset.insert(QStringLiteral("led"),
+                     widget == SerialStudio::DashboardLED);
+      dataset.insert(QStringLiteral("ledHigh"), 0);
+      dataset.insert(QStringLiteral("fft"),
+                     widget == SerialStudio::DashboardFFT);
+      dataset.insert(QStringLiteral("waterfall"),
+                     widget == SerialStudio::DashboardWaterfall);
+      dataset.insert(QStringLiteral("fftSamples"), 1024);
+      dataset.insert(QStringLiteral("fftSamplingRate"), kSampleRate);
+      datasets.append(dataset);
+    }
+
+    QJsonObject group;
+    group.insert(QStringLiteral("title"),
+                 QStringLiteral("Group %1").arg(g + 1));
+    group.insert(QStringLiteral("widget"), groupWidget);
+    group.insert(QStringLiteral("datasets"), datasets);
+    groups.append(group);
+  }
+
+  QJsonObject object;
+  object.insert(QStringLiteral("title"), QStringLiteral("Widget Benchmark"));
+  object.insert(QStringLiteral("groups"), groups);
+
+  JSON::Frame frame;
+  (void)frame.read(object);
+  return frame;
+}
+
+//------------------------------------------------------------------------------
+// Process statistics
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the CPU time used by all threads of the process so far (in
+ *        nanoseconds), or 0 if it is not available on this platform.
+ */
+qint64 Misc::WidgetBenchmark::cpuTime()
+{
+#if defined(Q_OS_WIN)
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    return 0;
+
+  const auto ticks = [](const FILETIME &time) {
+    return (static_cast<qint64>(time.dwHighDateTime) << 32)
+           | time.dwLowDateTime;
+  };
+
+  return (ticks(kernel) + ticks(user)) * 100;
+#elif defined(Q_OS_UNIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  const auto time = [](const timeval &value) {
+    return static_cast<qint64>(value.tv_sec) * 1000000000
+           + static_cast<qint64>(value.tv_usec) * 1000;
+  };
+
+  return time(usage.ru_utime) + time(usage.ru_stime);
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Returns the resident memory of the process (in bytes), or 0 if it is
+ *        not available on this platform.
+ */
+qint64 Misc::WidgetBenchmark::residentMemory()
+{
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                               sizeof(counters)))
+    return 0;
+
+  return static_cast<qint64>(counters.WorkingSetSize);
+#elif defined(Q_OS_MACOS)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count)
+      != KERN_SUCCESS)
+    return 0;
+
+  return static_cast<qint64>(info.resident_size);
+#elif defined(Q_OS_UNIX)
+  QFile file(QStringLiteral("/proc/self/statm"));
+  if (!file.open(QIODevice::ReadOnly))
+    return 0;
+
+  const auto fields = file.readAll().split(' ');
+  if (fields.count() < 2)
+    return 0;
+
+  return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
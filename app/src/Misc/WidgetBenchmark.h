@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QSize>
+#include <QVector>
+#include <QString>
+#include <QVariantMap>
+#include <QJsonObject>
+
+#include "SerialStudio.h"
+#include "JSON/Frame.h"
+
+class QWindow;
+class QQmlEngine;
+class QQuickItem;
+class QQuickWindow;
+class QQuickRenderControl;
+
+class QRhiTexture;
+class QRhiRenderBuffer;
+class QRhiTextureRenderTarget;
+class QRhiRenderPassDescriptor;
+
+namespace Misc
+{
+/**
+ * @brief The WidgetBenchmark class
+ *
+ * Measures the rendering cost of each dashboard widget type. For every type,
+ * the requested number of copies is instantiated from the same QML files as
+ * the dashboard, in an offscreen window driven by a @c QQuickRenderControl.
+ * The widgets are then fed with synthetic frames at a fixed data rate, and
+ * rendered at a fixed frame rate, while the CPU time, the GPU frame time and
+ * the memory used by the widgets are recorded.
+ *
+ * The benchmark is started with the @c --widget-benchmark command line
+ * option, and writes its results as a JSON document, so that the cost of the
+ * scene-graph renderers can be compared between releases & used to size
+ * dashboards for a given computer.
+ */
+class WidgetBenchmark
+{
+public:
+  explicit WidgetBenchmark(QQmlEngine *engine);
+  ~WidgetBenchmark();
+
+  int run(const int copies, const QString &outputPath = QString());
+
+  [[nodiscard]] static bool isOffscreenWindow(const QWindow *window);
+
+private:
+  struct Result
+  {
+    QString name;
+    int copies;
+    qint64 frames;
+    qint64 cpuTimeNs;
+    qint64 gpuFrames;
+    double gpuTimeNs;
+    qint64 memoryBytes;
+  };
+
+  template<typename Function>
+  void measure(const QString &name, const QString &qmlPath,
+               const QVector<QVariantMap> &properties, Function &&feed);
+  template<typename Function>
+  void runFrames(const int duration, Function &&frame);
+
+  void benchmarkWidget(const QString &name,
+                       const SerialStudio::DashboardWidget widget,
+                       const int copies);
+  void benchmarkTerminal(const int copies);
+
+  bool initialize(const QSize &size);
+  void release();
+  [[nodiscard]] double renderFrame();
+
+  [[nodiscard]] QJsonObject report() const;
+  [[nodiscard]] static JSON::Frame
+  projectFrame(const SerialStudio::DashboardWidget widget, const int copies,
+               const int sample);
+  [[nodiscard]] static qint64 cpuTime();
+  [[nodiscard]] static qint64 residentMemory();
+
+private:
+  QQmlEngine *m_engine;
+  std::unique_ptr<QQuickRenderControl> m_renderControl;
+  std::unique_ptr<QQuickWindow> m_window;
+  QVector<QQuickItem *> m_items;
+
+  std::unique_ptr<QRhiTexture> m_texture;
+  std::unique_ptr<QRhiRenderBuffer> m_depthStencil;
+  std::unique_ptr<QRhiTextureRenderTarget> m_renderTarget;
+  std::unique_ptr<QRhiRenderPassDescriptor> m_renderPass;
+
+  QVector<Result> m_results;
+};
+} // namespace Misc
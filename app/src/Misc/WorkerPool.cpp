@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QThread>
+#include "Misc/WorkerPool.h"
+
+/**
+ * Constructor function, configures the number of worker threads
+ */
+Misc::WorkerPool::WorkerPool()
+{
+  m_pool.setThreadPriority(QThread::LowPriority);
+  m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+Misc::WorkerPool &Misc::WorkerPool::instance()
+{
+  static WorkerPool singleton;
+  return singleton;
+}
+
+/**
+ * Queues the given @a job to be executed by one of the worker threads.
+ *
+ * @note The job must not access objects that may be destroyed before it runs,
+ *       widgets should give it shared ownership of the data it works on.
+ */
+void Misc::WorkerPool::start(std::function<void()> job)
+{
+  m_pool.start(std::move(job));
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <functional>
+#include <QThreadPool>
+
+namespace Misc
+{
+/**
+ * @brief The WorkerPool class
+ *
+ * The @c WorkerPool class is a shared thread pool used by the dashboard
+ * widgets to run expensive analytics (such as FFT transforms) away from the
+ * GUI thread. Widgets submit jobs with @c start() and pick up the results
+ * during the next UI refresh, so that the GUI & render threads only have to
+ * draw the data.
+ *
+ * One hardware thread is left for the GUI thread, and the workers run with
+ * a low priority so that they never compete with frame reading & parsing.
+ */
+class WorkerPool
+{
+private:
+  WorkerPool();
+  WorkerPool(WorkerPool &&) = delete;
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(WorkerPool &&) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+public:
+  static WorkerPool &instance();
+
+  void start(std::function<void()> job);
+
+private:
+  QThreadPool m_pool;
+};
+} // namespace Misc
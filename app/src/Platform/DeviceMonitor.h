@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _PLATFORM_DEVICE_MONITOR_H
+#define _PLATFORM_DEVICE_MONITOR_H
+
+#include <QTimer>
+#include <QObject>
+
+/**
+ * @class DeviceMonitor
+ * @brief Notifies when serial devices are attached to or removed from the
+ *        computer.
+ *
+ * Enumerating the serial ports can be expensive (specially with many virtual
+ * COM ports), so instead of polling the port list, the monitor listens to the
+ * hotplug notifications of the operating system:
+ * - Linux: kernel uevents of the @c tty subsystem, read from a netlink socket.
+ * - Windows: @c WM_DEVICECHANGE port arrival & removal broadcasts.
+ * - macOS: IOKit matching & termination notifications of serial services.
+ *
+ * Notifications usually come in bursts (e.g. a USB adapter with several
+ * ports), so @c devicesChanged() is emitted once the burst is over.
+ *
+ * On other platforms, or if the notifications cannot be set up,
+ * @c isSupported() returns @c false and the owner must poll the devices.
+ */
+class DeviceMonitor : public QObject
+{
+  Q_OBJECT
+
+signals:
+  void devicesChanged();
+
+public:
+  explicit DeviceMonitor(QObject *parent = nullptr);
+  ~DeviceMonitor();
+
+  [[nodiscard]] bool isSupported() const;
+
+private:
+  /**
+   * @brief Schedules the @c devicesChanged() signal after a notification.
+   */
+  void notifyChange() { m_debounceTimer.start(); }
+
+private:
+  static constexpr int kDebounceInterval = 500;
+
+  struct Backend;
+  Backend *m_backend;
+  QTimer m_debounceTimer;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Platform/DeviceMonitor.h"
+
+#ifdef Q_OS_LINUX
+#  include <QSocketNotifier>
+
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <linux/netlink.h>
+#endif
+
+/**
+ * @brief Netlink socket that receives the kernel uevents.
+ */
+struct DeviceMonitor::Backend
+{
+  int descriptor = -1;
+  QSocketNotifier *notifier = nullptr;
+};
+
+/**
+ * @brief Constructor for DeviceMonitor class.
+ * @param parent The parent QObject.
+ *
+ * On Linux, subscribes to the uevents broadcast by the kernel. Serial devices
+ * are created by the kernel itself (devtmpfs), so the raw kernel events are
+ * enough and no dependency on libudev is needed. Other UNIX systems are not
+ * supported.
+ */
+DeviceMonitor::DeviceMonitor(QObject *parent)
+  : QObject(parent)
+  , m_backend(new Backend)
+{
+  m_debounceTimer.setSingleShot(true);
+  m_debounceTimer.setInterval(kDebounceInterval);
+  connect(&m_debounceTimer, &QTimer::timeout, this,
+          &DeviceMonitor::devicesChanged);
+
+#ifdef Q_OS_LINUX
+  // Open a netlink socket for the kernel uevents
+  const int fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                          NETLINK_KOBJECT_UEVENT);
+  if (fd < 0)
+    return;
+
+  // Subscribe to the kernel event group
+  sockaddr_nl address = {};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = 1;
+  if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+  {
+    ::close(fd);
+    return;
+  }
+
+  // Read the events from the event loop, only tty events are relevant
+  m_backend->descriptor = fd;
+  m_backend->notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+  connect(m_backend->notifier, &QSocketNotifier::activated, this, [=] {
+    char buffer[8192];
+    bool changed = false;
+    while (true)
+    {
+      const auto bytes = ::recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+      if (bytes <= 0)
+        break;
+
+      // Events are "ACTION@DEVPATH" followed by NUL-separated KEY=VALUE pairs
+      const QByteArray event = QByteArray::fromRawData(buffer, bytes);
+      if (event.contains(QByteArrayLiteral("SUBSYSTEM=tty")))
+        changed = true;
+    }
+
+    if (changed)
+      notifyChange();
+  });
+#endif
+}
+
+/**
+ * @brief Closes the netlink socket.
+ */
+DeviceMonitor::~DeviceMonitor()
+{
+#ifdef Q_OS_LINUX
+  delete m_backend->notifier;
+  if (m_backend->descriptor >= 0)
+    ::close(m_backend->descriptor);
+#endif
+
+  delete m_backend;
+}
+
+/**
+ * @brief Returns @c true if device changes are notified by the system.
+ */
+bool DeviceMonitor::isSupported() const
+{
+  return m_backend->descriptor >= 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Platform/DeviceMonitor.h"
+
+#include <QCoreApplication>
+#include <QAbstractNativeEventFilter>
+
+#include <windows.h>
+#include <dbt.h>
+
+/**
+ * @brief Native event filter that watches the device change broadcasts.
+ *
+ * Windows broadcasts @c WM_DEVICECHANGE to every top-level window when a COM
+ * port is attached or removed, no registration is needed for port devices.
+ */
+struct DeviceMonitor::Backend : public QAbstractNativeEventFilter
+{
+  explicit Backend(DeviceMonitor *owner)
+    : monitor(owner)
+  {
+  }
+
+  bool nativeEventFilter(const QByteArray &eventType, void *message,
+                         qintptr *result) override
+  {
+    (void)result;
+    if (eventType != "windows_generic_MSG")
+      return false;
+
+    const auto *msg = static_cast<MSG *>(message);
+    if (msg->message != WM_DEVICECHANGE)
+      return false;
+
+    if (msg->wParam == DBT_DEVICEARRIVAL
+        || msg->wParam == DBT_DEVICEREMOVECOMPLETE)
+    {
+      const auto *header = reinterpret_cast<DEV_BROADCAST_HDR *>(msg->lParam);
+      if (header && header->dbch_devicetype == DBT_DEVTYP_PORT)
+        monitor->notifyChange();
+    }
+
+    return false;
+  }
+
+  DeviceMonitor *monitor;
+  bool installed = false;
+};
+
+/**
+ * @brief Constructor for DeviceMonitor class.
+ * @param parent The parent QObject.
+ *
+ * Installs a native event filter in the application to receive the device
+ * change broadcasts sent to the windows of the application.
+ */
+DeviceMonitor::DeviceMonitor(QObject *parent)
+  : QObject(parent)
+  , m_backend(new Backend(this))
+{
+  m_debounceTimer.setSingleShot(true);
+  m_debounceTimer.setInterval(kDebounceInterval);
+  connect(&m_debounceTimer, &QTimer::timeout, this,
+          &DeviceMonitor::devicesChanged);
+
+  if (QCoreApplication::instance())
+  {
+    QCoreApplication::instance()->installNativeEventFilter(m_backend);
+    m_backend->installed = true;
+  }
+}
+
+/**
+ * @brief Removes the native event filter.
+ */
+DeviceMonitor::~DeviceMonitor()
+{
+  if (m_backend->installed && QCoreApplication::instance())
+    QCoreApplication::instance()->removeNativeEventFilter(m_backend);
+
+  delete m_backend;
+}
+
+/**
+ * @brief Returns @c true if device changes are notified by the system.
+ */
+bool DeviceMonitor::isSupported() const
+{
+  return m_backend->installed;
+}
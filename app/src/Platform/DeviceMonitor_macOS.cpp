@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Platform/DeviceMonitor.h"
+
+#include <CoreFoundation/CoreFoundation.h>
+#include <IOKit/IOKitLib.h>
+#include <IOKit/serial/IOSerialKeys.h>
+
+/**
+ * @brief IOKit notification port & the iterators of the serial services that
+ *        are published or terminated.
+ */
+struct DeviceMonitor::Backend
+{
+  /**
+   * @brief Drains the given @a iterator, which re-arms the notification, and
+   *        reports the change to the monitor given as @a context.
+   */
+  static void onServices(void *context, io_iterator_t iterator)
+  {
+    io_object_t service;
+    while ((service = IOIteratorNext(iterator)))
+      IOObjectRelease(service);
+
+    if (context)
+      static_cast<DeviceMonitor *>(context)->notifyChange();
+  }
+
+  /**
+   * @brief Registers a notification of the given @a type for serial services.
+   */
+  bool watch(DeviceMonitor *monitor, const io_name_t type,
+             io_iterator_t *iterator)
+  {
+    // The matching dictionary is consumed by the call
+    auto matching = IOServiceMatching(kIOSerialBSDServiceValue);
+    if (!matching)
+      return false;
+
+    if (IOServiceAddMatchingNotification(port, type, matching, &onServices,
+                                         monitor, iterator)
+        != KERN_SUCCESS)
+      return false;
+
+    // Arm the notification without reporting the existing services
+    onServices(nullptr, *iterator);
+    return true;
+  }
+
+  IONotificationPortRef port = nullptr;
+  io_iterator_t published = 0;
+  io_iterator_t terminated = 0;
+  bool supported = false;
+};
+
+/**
+ * @brief Constructor for DeviceMonitor class.
+ * @param parent The parent QObject.
+ *
+ * Registers IOKit notifications for serial services, delivered through the
+ * main run loop, which is the run loop of the Qt event dispatcher.
+ */
+DeviceMonitor::DeviceMonitor(QObject *parent)
+  : QObject(parent)
+  , m_backend(new Backend)
+{
+  m_debounceTimer.setSingleShot(true);
+  m_debounceTimer.setInterval(kDebounceInterval);
+  connect(&m_debounceTimer, &QTimer::timeout, this,
+          &DeviceMonitor::devicesChanged);
+
+  m_backend->port = IONotificationPortCreate(MACH_PORT_NULL);
+  if (!m_backend->port)
+    return;
+
+  CFRunLoopAddSource(CFRunLoopGetMain(),
+                     IONotificationPortGetRunLoopSource(m_backend->port),
+                     kCFRunLoopDefaultMode);
+
+  m_backend->supported
+      = m_backend->watch(this, kIOPublishNotification, &m_backend->published)
+        && m_backend->watch(this, kIOTerminatedNotification,
+                            &m_backend->terminated);
+}
+
+/**
+ * @brief Releases the IOKit notifications.
+ */
+DeviceMonitor::~DeviceMonitor()
+{
+  if (m_backend->published)
+    IOObjectRelease(m_backend->published);
+
+  if (m_backend->terminated)
+    IOObjectRelease(m_backend->terminated);
+
+  if (m_backend->port)
+    IONotificationPortDestroy(m_backend->port);
+
+  delete m_backend;
+}
+
+/**
+ * @brief Returns @c true if device changes are notified by the system.
+ */
+bool DeviceMonitor::isSupported() const
+{
+  return m_backend->supported;
+}
@@ -20,53 +20,71 @@
  * THE SOFTWARE.
  */
 
-#include <QJsonArray>
-#include <QJsonObject>
-#include <QJsonDocument>
+#include <QApplication>
 
 #include "IO/Manager.h"
 #include "Plugins/Server.h"
 #include "JSON/FrameBuilder.h"
 
-#include "Misc/Utilities.h"
 #include "Misc/TimerEvents.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
+#include "Misc/DatasetStatistics.h"
 
 /**
- * Constructor function
+ * Constructor function, moves the plugin server worker to its network thread
+ * & starts listening for plugin connections.
  */
 Plugins::Server::Server()
   : m_enabled(false)
+  , m_frameConsumer(-1)
+  , m_slowClientPolicy(ServerWorker::DropOldest)
 {
+  // Read frames from the frame bus, slow plugins must not stall other sinks
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  m_frameConsumer = bus.addConsumer(JSON::FrameBus::Policy::DropOldest);
+  m_worker.setFrameBus(&bus, m_frameConsumer);
+
+  // Move the worker to its dedicated thread
+  m_worker.moveToThread(&m_workerThread);
 
   // Send processed data at 1 Hz
   connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged,
-          this, &Plugins::Server::registerFrame, Qt::QueuedConnection);
-  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
-          &Plugins::Server::sendProcessedData);
+          this, &Plugins::Server::notifyFrame);
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+          &m_worker, &Plugins::ServerWorker::sendProcessedData,
+          Qt::QueuedConnection);
+
+  // Send the pipeline & dataset statistics whenever they are updated
+  connect(&Misc::PipelineStats::instance(),
+          &Misc::PipelineStats::statisticsChanged, this, [=] {
+            if (!m_enabled)
+              return;
+
+            auto stats = Misc::PipelineStats::instance().toJson();
+            stats.insert(QStringLiteral("datasets"),
+                         Misc::DatasetStatistics::instance().toJson());
+            QMetaObject::invokeMethod(
+                &m_worker, [=] { m_worker.sendStatistics(stats); },
+                Qt::QueuedConnection);
+          });
 
   // Send I/O "raw" data directly
   connect(&IO::Manager::instance(), &IO::Manager::dataReceived, this,
           &Plugins::Server::sendRawData, Qt::QueuedConnection);
 
-  // Configure TCP server
-  connect(&m_server, &QTcpServer::newConnection, this,
-          &Plugins::Server::acceptConnection);
-
-  // Begin listening on TCP port
-  if (!m_server.listen(QHostAddress::Any, PLUGINS_TCP_PORT))
-  {
-    Misc::Utilities::showMessageBox(tr("Unable to start plugin TCP server"),
-                                    m_server.errorString());
-    m_server.close();
-  }
-}
-
-/**
- * Destructor function
- */
-Plugins::Server::~Server()
-{
-  m_server.close();
+  // Close all connections & stop the worker thread when quitting
+  connect(qApp, &QApplication::aboutToQuit, this, [=] {
+    removeConnections();
+    m_workerThread.quit();
+    if (!m_workerThread.wait(100))
+      m_workerThread.terminate();
+  });
+
+  // Name the worker thread, it is started when plugins are enabled
+  m_workerThread.setObjectName(QStringLiteral("Plugin Server"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_workerThread, Misc::ThreadScheduler::Role::Network);
 }
 
 /**
@@ -87,230 +105,98 @@ bool Plugins::Server::enabled() const
 }
 
 /**
- * Disconnects the socket used for communicating with plugins.
+ * Returns the action taken when the send queue of a plugin is full, as an
+ * index of the list returned by @c slowClientPolicies().
  */
-void Plugins::Server::removeConnection()
+int Plugins::Server::slowClientPolicy() const
 {
-  // Get caller socket
-  auto socket = static_cast<QTcpSocket *>(QObject::sender());
-
-  // Remove socket from registered sockets
-  if (socket)
-  {
-    for (int i = 0; i < m_sockets.count(); ++i)
-    {
-      if (m_sockets.at(i) == socket)
-      {
-        m_sockets.removeAt(i);
-        i = 0;
-      }
-    }
-
-    // Delete socket handler
-    socket->deleteLater();
-  }
+  return m_slowClientPolicy;
 }
 
 /**
- * Enables/disables the plugin subsystem
+ * Returns the list of actions that can be taken with slow plugins
  */
-void Plugins::Server::setEnabled(const bool enabled)
+QStringList Plugins::Server::slowClientPolicies() const
 {
-  // Change value
-  m_enabled = enabled;
-  Q_EMIT enabledChanged();
-
-  // If not enabled, remove all connections
-  if (!enabled)
-  {
-    for (int i = 0; i < m_sockets.count(); ++i)
-    {
-      auto socket = m_sockets.at(i);
-
-      if (socket)
-      {
-        socket->abort();
-        socket->deleteLater();
-      }
-    }
-
-    m_sockets.clear();
-  }
-
-  // Clear frames array to avoid memory leaks
-  m_frames.clear();
-  m_frames.squeeze();
+  return {tr("Drop Oldest Data"), tr("Disconnect Plugin")};
 }
 
 /**
- * Process incoming data and writes it directly to the connected I/O device
+ * Closes all plugin connections & the TCP server, waiting for the worker
+ * thread to finish doing so.
  */
-void Plugins::Server::onDataReceived()
+void Plugins::Server::removeConnections()
 {
-  // Get caller socket
-  auto socket = static_cast<QTcpSocket *>(QObject::sender());
-
-  // Write incoming data to manager
-  if (enabled() && socket)
-    IO::Manager::instance().writeData(socket->readAll());
+  if (m_workerThread.isRunning())
+    QMetaObject::invokeMethod(&m_worker, &ServerWorker::stopServer,
+                              Qt::BlockingQueuedConnection);
 }
 
 /**
- * Configures incoming connection requests
+ * Enables/disables the plugin subsystem
  */
-void Plugins::Server::acceptConnection()
+void Plugins::Server::setEnabled(const bool enabled)
 {
-  // Get & validate socket
-  auto socket = m_server.nextPendingConnection();
-  if (!socket && enabled())
-  {
-    Misc::Utilities::showMessageBox(tr("Plugin server"),
-                                    tr("Invalid pending connection"));
-    return;
-  }
-
-  // Close connection if system is not enabled
-  if (!enabled())
-  {
-    if (socket)
-    {
-      socket->close();
-      socket->deleteLater();
-    }
-
-    return;
-  }
+  if (enabled)
+    startWorker();
 
-  // Connect socket signals/slots
-  connect(socket, &QTcpSocket::readyRead, this,
-          &Plugins::Server::onDataReceived);
-  connect(socket, &QTcpSocket::disconnected, this,
-          &Plugins::Server::removeConnection);
+  // Only read frames from the frame bus while plugins are enabled
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  if (enabled)
+    bus.attach(m_frameConsumer);
+  else
+    bus.detach(m_frameConsumer);
 
-  // React to socket errors
-#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
-  connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), this,
-          SLOT(onErrorOccurred(QAbstractSocket::SocketError)));
-#else
-  connect(socket, &QTcpSocket::errorOccurred, this,
-          &Plugins::Server::onErrorOccurred);
-#endif
+  m_enabled = enabled;
+  QMetaObject::invokeMethod(
+      &m_worker, [=] { m_worker.setEnabled(enabled); }, Qt::QueuedConnection);
 
-  // Add socket to sockets list
-  m_sockets.append(socket);
+  Q_EMIT enabledChanged();
 }
 
 /**
- * Sends an array of frames with the following information:
- * - Frame ID number
- * - RX timestamp
- * - Frame JSON data
+ * Changes the action taken when the send queue of a plugin is full
  */
-void Plugins::Server::sendProcessedData()
+void Plugins::Server::setSlowClientPolicy(const int policy)
 {
-  // Stop if system is not enabled
-  if (!enabled())
-    return;
-
-  // Stop if frame list is empty
-  if (m_frames.count() <= 0)
-    return;
-
-  // Stop if no sockets are available
-  if (m_sockets.count() < 1)
-    return;
-
-  // Create JSON array with frame data
-  QJsonArray array;
-  for (int i = 0; i < m_frames.count(); ++i)
-  {
-    QJsonObject object;
-    auto frame = m_frames.at(i);
-    object.insert(QStringLiteral("data"), frame.serialize());
-    array.append(object);
-  }
-
-  // Create JSON document with frame arrays
-  if (array.count() > 0)
-  {
-    // Construct QByteArray with data
-    QJsonObject object;
-    object.insert(QStringLiteral("frames"), array);
-    const QJsonDocument document(object);
-    auto json = document.toJson(QJsonDocument::Compact) + "\n";
-
-    // Send data to each plugin
-    Q_FOREACH (auto socket, m_sockets)
-    {
-      if (!socket)
-        continue;
-
-      if (socket->isWritable())
-        socket->write(json);
-    }
-  }
-
-  // Clear frame list
-  m_frames.clear();
-  m_frames.squeeze();
+  m_slowClientPolicy = qBound<int>(ServerWorker::DropOldest, policy,
+                                   ServerWorker::Disconnect);
+  const auto value = m_slowClientPolicy;
+  QMetaObject::invokeMethod(
+      &m_worker, [=] { m_worker.setSlowClientPolicy(value); },
+      Qt::QueuedConnection);
+
+  Q_EMIT slowClientPolicyChanged();
 }
 
 /**
- * Encodes the given @a data in Base64 and sends it through the TCP socket
- * connected to the localhost.
+ * Hands the given raw @a data over to the worker thread
  */
 void Plugins::Server::sendRawData(const QByteArray &data)
 {
-  // Stop if system is not enabled
-  if (!enabled())
-    return;
-
-  // Stop if no sockets are available
-  if (m_sockets.count() < 1)
-    return;
-
-  // Create JSON structure with incoming data encoded in Base-64
-  QJsonObject object;
-  object.insert(QStringLiteral("data"), QString::fromUtf8(data.toBase64()));
-
-  // Get JSON string in compact format & send it over the TCP socket
-  QJsonDocument document(object);
-  const auto json = document.toJson(QJsonDocument::Compact) + "\n";
-
-  // Send data to each plugin
-  Q_FOREACH (auto socket, m_sockets)
-  {
-    if (!socket)
-      continue;
-
-    if (socket->isWritable())
-      socket->write(json);
-  }
+  if (m_enabled)
+    m_worker.enqueueRawData(data);
 }
 
 /**
- * Obtains the latest JSON dataframe & appends it to the JSON list, which is
- * later read and sent by the @c sendProcessedData() function.
+ * Wakes the worker thread up when a new frame is published to the frame bus,
+ * the worker sends the received frames to the plugins once per second.
  */
-void Plugins::Server::registerFrame(const JSON::Frame &frame)
+void Plugins::Server::notifyFrame()
 {
-  if (enabled())
-    m_frames.append(frame);
+  if (m_enabled)
+    m_worker.wakeUp();
 }
 
 /**
- * This function is called whenever a socket error occurs, it disconnects the
- * socket from the host and displays the error in a message box.
+ * Starts the worker thread & the TCP server, if they are not running yet
  */
-void Plugins::Server::onErrorOccurred(
-    const QAbstractSocket::SocketError socketError)
+void Plugins::Server::startWorker()
 {
-  // Get caller socket
-  auto socket = static_cast<QTcpSocket *>(QObject::sender());
+  if (m_workerThread.isRunning())
+    return;
 
-  // Print error
-  if (socket)
-    qDebug() << socket->errorString();
-  else
-    qDebug() << socketError;
+  m_workerThread.start();
+  QMetaObject::invokeMethod(&m_worker, &ServerWorker::startServer,
+                            Qt::QueuedConnection);
 }
@@ -22,19 +22,12 @@
 
 #pragma once
 
+#include <QThread>
 #include <QObject>
-#include <QTcpSocket>
-#include <QTcpServer>
 #include <QByteArray>
-#include <QHostAddress>
 
 #include "JSON/Frame.h"
-
-/**
- * Default TCP port to use for incoming connections, I choose 7777 because 7 is
- * one of my favourite numbers :)
- */
-#define PLUGINS_TCP_PORT 7777
+#include "Plugins/ServerWorker.h"
 
 namespace Plugins
 {
@@ -52,14 +45,37 @@ namespace Plugins
  * A benefit of implementing plugins in this manner is that you can write your
  * Serial Studio companion application in any language and framework that you
  * desire, you do not have to force yourself to use Qt or C/C++.
+ *
+ * The TCP server, the plugin sockets and the encoding of the data are handled
+ * by a @c Plugins::ServerWorker running in a dedicated network thread, which
+ * also describes the JSON & binary protocols. This class only exposes the
+ * settings of the plugin system to the user interface, attaches the worker to
+ * the frame bus while plugins are enabled, and hands raw data over to it.
+ *
+ * The network thread & the TCP server are only started the first time that
+ * the plugin system is enabled, so that the application does not open a
+ * listening socket (or spend startup time on it) when plugins are not used.
  */
 class Server : public QObject
 {
+  // clang-format off
   Q_OBJECT
-  Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+  Q_PROPERTY(bool enabled
+             READ enabled
+             WRITE setEnabled
+             NOTIFY enabledChanged)
+  Q_PROPERTY(int slowClientPolicy
+             READ slowClientPolicy
+             WRITE setSlowClientPolicy
+             NOTIFY slowClientPolicyChanged)
+  Q_PROPERTY(QStringList slowClientPolicies
+             READ slowClientPolicies
+             CONSTANT)
+  // clang-format on
 
 signals:
   void enabledChanged();
+  void slowClientPolicyChanged();
 
 private:
   explicit Server();
@@ -68,28 +84,31 @@ private:
   Server &operator=(Server &&) = delete;
   Server &operator=(const Server &) = delete;
 
-  ~Server();
-
 public:
   static Server &instance();
+
   [[nodiscard]] bool enabled() const;
+  [[nodiscard]] int slowClientPolicy() const;
+  [[nodiscard]] QStringList slowClientPolicies() const;
 
 public slots:
-  void removeConnection();
+  void removeConnections();
   void setEnabled(const bool enabled);
+  void setSlowClientPolicy(const int policy);
 
 private slots:
-  void onDataReceived();
-  void acceptConnection();
-  void sendProcessedData();
+  void notifyFrame();
   void sendRawData(const QByteArray &data);
-  void registerFrame(const JSON::Frame &frame);
-  void onErrorOccurred(const QAbstractSocket::SocketError socketError);
+
+private:
+  void startWorker();
 
 private:
   bool m_enabled;
-  QTcpServer m_server;
-  QVector<JSON::Frame> m_frames;
-  QVector<QTcpSocket *> m_sockets;
+  int m_frameConsumer;
+  int m_slowClientPolicy;
+
+  QThread m_workerThread;
+  ServerWorker m_worker;
 };
 } // namespace Plugins
@@ -0,0 +1,1438 @@
+/*
+ * Copyright (c) 2020-2023 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <numeric>
+#include <algorithm>
+
+#include <QtEndian>
+#include <QCborMap>
+#include <QByteArrayView>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QApplication>
+#include <QCborStreamWriter>
+
+#include "IO/Manager.h"
+#include "Plugins/ServerWorker.h"
+
+#include "Misc/Utilities.h"
+#include "Misc/SessionClock.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+
+/**
+ * Number of raw data chunks that can be handed over to the worker thread at a
+ * time
+ */
+static constexpr std::size_t kRawDataQueueCapacity = 4096;
+
+/**
+ * Maximum number of bytes waiting in the output buffer of a socket, further
+ * messages are kept in the send queue of the plugin.
+ */
+static constexpr qint64 kSocketWatermark = 1024 * 1024;
+
+/**
+ * Maximum number of bytes waiting in the send queue of a plugin
+ */
+static constexpr qsizetype kMaxQueuedBytes = 8 * 1024 * 1024;
+
+/**
+ * Maximum payload size of a priority device command
+ */
+static constexpr qint64 kMaxCommandSize = 64 * 1024;
+
+/**
+ * Maximum size of an incomplete control message header kept until the rest of
+ * the message arrives
+ */
+static constexpr qsizetype kMaxControlHeader = 64 * 1024;
+
+/**
+ * Prefixes the given CBOR-encoded @a payload with its @c quint32 byte count,
+ * as expected by plugins that use the binary protocol.
+ */
+static QByteArray binaryMessage(const QByteArray &payload)
+{
+  QByteArray message;
+  message.resize(sizeof(quint32));
+  qToLittleEndian(static_cast<quint32>(payload.size()), message.data());
+  message.append(payload);
+  return message;
+}
+
+/**
+ * Returns @c true if @a data is shorter than @a message & could still become
+ * @a message once more data is received.
+ */
+static bool isIncomplete(QByteArrayView data, const QByteArray &message)
+{
+  return data.size() < message.size() && message.startsWith(data);
+}
+
+/**
+ * Writes the value of the given @a dataset, as a number if the dataset is
+ * numeric or as a string otherwise.
+ */
+static void writeValue(QCborStreamWriter &writer, const JSON::Dataset &dataset)
+{
+  if (dataset.isNumeric())
+    writer.append(dataset.numericValue());
+  else
+    writer.append(QStringView(dataset.value()));
+}
+
+/**
+ * @brief Returns the slots of the given @a frame that belong to a
+ *        subscription.
+ *
+ * A slot is selected if its group id is listed in @a groups, or if its
+ * dataset index is listed in @a datasets. An empty mask is returned when both
+ * lists are empty, which selects every slot.
+ */
+static QVector<bool> slotMask(const JSON::Frame &frame, const QSet<int> &groups,
+                              const QSet<int> &datasets)
+{
+  QVector<bool> mask;
+  if (groups.isEmpty() && datasets.isEmpty())
+    return mask;
+
+  for (const auto &group : frame.groups())
+  {
+    const bool all = groups.contains(group.groupId());
+    for (const auto &dataset : group.datasets())
+      mask.append(all || datasets.contains(dataset.index()));
+  }
+
+  return mask;
+}
+
+/**
+ * @brief Encodes @a count frames, whose positions in @a frames are given by
+ *        @a indexes, as a binary @c "frames" message.
+ *
+ * All frames must share the schema identified by @a schemaId. The first frame
+ * lists every value whose generation is newer than @a since (every value by
+ * default), and the following frames only list the values that differ from
+ * the preceding frame. Only the slots selected by @a mask are written (see
+ * @c slotMask()).
+ */
+static QByteArray encodeRun(const QVector<JSON::Frame> &frames,
+                            const qsizetype *indexes, const qsizetype count,
+                            const QVector<bool> &mask, const quint64 schemaId,
+                            const quint64 since = 0)
+{
+  QByteArray payload;
+  QCborStreamWriter writer(&payload);
+  writer.startMap(3);
+  writer.append(QLatin1StringView("type"));
+  writer.append(QLatin1StringView("frames"));
+  writer.append(QLatin1StringView("schema"));
+  writer.append(static_cast<qint64>(schemaId));
+  writer.append(QLatin1StringView("frames"));
+  writer.startArray(static_cast<quint64>(count));
+  for (qsizetype k = 0; k < count; ++k)
+  {
+    qint64 slot = 0;
+    writer.startArray();
+    const auto &groups = frames[indexes[k]].groups();
+    for (qsizetype g = 0; g < groups.count(); ++g)
+    {
+      const auto &datasets = groups[g].datasets();
+      for (qsizetype d = 0; d < datasets.count(); ++d, ++slot)
+      {
+        // Skip slots that are not part of the subscription
+        if (!mask.isEmpty() && (slot >= mask.count() || !mask[slot]))
+          continue;
+
+        // Skip values that did not change since the previous frame, value
+        // generations are compared so that frames dropped from the queue
+        // cannot hide changes
+        const auto &dataset = datasets[d];
+        if (k > 0)
+        {
+          const auto &prev = frames[indexes[k - 1]].groups()[g].datasets()[d];
+          if (prev.valueGeneration() == dataset.valueGeneration())
+            continue;
+        }
+
+        else if (dataset.valueGeneration() <= since)
+          continue;
+
+        writer.append(slot);
+        writeValue(writer, dataset);
+      }
+    }
+
+    writer.endArray();
+  }
+
+  writer.endArray();
+  writer.endMap();
+  return binaryMessage(payload);
+}
+
+/**
+ * Returns the newest value generation of the datasets of the given @a frame,
+ * groups take the generation of their most recently changed dataset.
+ */
+static quint64 newestGeneration(const JSON::Frame &frame)
+{
+  quint64 newest = 0;
+  for (const auto &group : frame.groups())
+    newest = qMax(newest, group.valueGeneration());
+
+  return newest;
+}
+
+/**
+ * Constructor function, the TCP server is a child of the worker so that it is
+ * moved to the worker thread together with it.
+ */
+Plugins::ServerWorker::ServerWorker()
+  : m_enabled(false)
+  , m_slowClientPolicy(DropOldest)
+  , m_wakeUpPending(false)
+  , m_frameConsumer(-1)
+  , m_frameBus(nullptr)
+  , m_rawDataQueue(kRawDataQueueCapacity)
+  , m_server(this)
+  , m_framesSince(0)
+  , m_schemaId(0)
+  , m_schemaGeneration(0)
+{
+  connect(&m_server, &QTcpServer::newConnection, this,
+          &Plugins::ServerWorker::acceptConnection);
+
+  // Acknowledge priority commands once the device has written them
+  connect(&IO::Manager::instance(), &IO::Manager::commandCompleted, this,
+          &Plugins::ServerWorker::onCommandCompleted);
+}
+
+/**
+ * @brief Sets the frame bus from which frames are read, & the cursor of the
+ *        worker in it.
+ *
+ * Must be called before the worker thread is started. Attaching & detaching
+ * the cursor is done by the owner of the worker, from the producer thread.
+ */
+void Plugins::ServerWorker::setFrameBus(JSON::FrameBus *bus,
+                                        const int consumer)
+{
+  m_frameBus = bus;
+  m_frameConsumer = consumer;
+}
+
+/**
+ * @brief Queues the given raw @a data to be sent to the plugins.
+ *
+ * This function is called from the producer thread (the main thread), it never
+ * touches the sockets. If the queue is full, the data is dropped.
+ */
+void Plugins::ServerWorker::enqueueRawData(const QByteArray &data)
+{
+  if (m_rawDataQueue.tryPush(data))
+    wakeUp();
+}
+
+/**
+ * Begins listening for plugin connections on the TCP port
+ */
+void Plugins::ServerWorker::startServer()
+{
+  if (!m_server.listen(QHostAddress::Any, PLUGINS_TCP_PORT))
+  {
+    const auto error = m_server.errorString();
+    QMetaObject::invokeMethod(
+        qApp,
+        [=] {
+          Misc::Utilities::showMessageBox(
+              tr("Unable to start plugin TCP server"), error);
+        },
+        Qt::QueuedConnection);
+
+    m_server.close();
+  }
+}
+
+/**
+ * Closes all plugin connections & stops listening for new ones
+ */
+void Plugins::ServerWorker::stopServer()
+{
+  setEnabled(false);
+  m_server.close();
+}
+
+/**
+ * Disconnects the socket used for communicating with plugins.
+ */
+void Plugins::ServerWorker::removeConnection()
+{
+  // Get caller socket
+  auto socket = static_cast<QTcpSocket *>(QObject::sender());
+
+  // Remove socket from registered sockets
+  if (socket)
+  {
+    m_clients.remove(socket);
+
+    // Forget the commands that are waiting to be acknowledged
+    for (auto it = m_pendingAcks.begin(); it != m_pendingAcks.end();)
+    {
+      if (it.value().socket == socket)
+        it = m_pendingAcks.erase(it);
+      else
+        ++it;
+    }
+
+    for (int i = 0; i < m_sockets.count(); ++i)
+    {
+      if (m_sockets.at(i) == socket)
+      {
+        m_sockets.removeAt(i);
+        i = 0;
+      }
+    }
+
+    // Delete socket handler
+    socket->deleteLater();
+  }
+}
+
+/**
+ * Enables/disables the plugin subsystem
+ */
+void Plugins::ServerWorker::setEnabled(const bool enabled)
+{
+  // Change value
+  m_enabled = enabled;
+
+  // Create or release the shared memory transport
+  if (enabled)
+    m_sharedMemory.open();
+  else
+    m_sharedMemory.close();
+
+  // If not enabled, remove all connections
+  if (!enabled)
+  {
+    for (int i = 0; i < m_sockets.count(); ++i)
+    {
+      auto socket = m_sockets.at(i);
+
+      if (socket)
+      {
+        socket->abort();
+        socket->deleteLater();
+      }
+    }
+
+    m_sockets.clear();
+    m_clients.clear();
+  }
+
+  // Clear frames array to avoid memory leaks
+  m_frames.clear();
+  m_frames.squeeze();
+}
+
+/**
+ * Changes the action taken when the send queue of a plugin is full
+ */
+void Plugins::ServerWorker::setSlowClientPolicy(const int policy)
+{
+  m_slowClientPolicy = qBound<int>(DropOldest, policy, Disconnect);
+}
+
+/**
+ * Schedules a call to @c drainQueues() in the worker thread, unless a call is
+ * already pending, so that the producer never posts one event per object.
+ */
+void Plugins::ServerWorker::wakeUp()
+{
+  if (!m_wakeUpPending.exchange(true, std::memory_order_acq_rel))
+    QMetaObject::invokeMethod(this, &ServerWorker::drainQueues,
+                              Qt::QueuedConnection);
+}
+
+/**
+ * @brief Takes the new frames of the frame bus & the raw data handed over by
+ *        the producer thread.
+ *
+ * Frames are buffered until the next call to @c sendProcessedData(), while raw
+ * data is sent right away. Frames that the worker missed because it fell too
+ * far behind are reported as dropped.
+ *
+ * The plugins are the first consumers to shed load, while
+ * @c Misc::OverloadController reports an overloaded pipeline, frames & raw
+ * data are discarded and reported as dropped.
+ */
+void Plugins::ServerWorker::drainQueues()
+{
+  m_wakeUpPending.store(false, std::memory_order_release);
+
+  // Report the backlog of the plugin server to the overload controller
+  auto &overload = Misc::OverloadController::instance();
+  if (m_frameBus)
+    overload.reportQueue(
+        Misc::OverloadController::PluginQueue,
+        static_cast<qint64>(m_frameBus->pending(m_frameConsumer)),
+        static_cast<qint64>(m_frameBus->capacity()));
+
+  quint64 shed = 0;
+  JSON::Frame frame;
+  const bool shedding = overload.shedding();
+  while (m_frameBus && m_frameBus->tryRead(m_frameConsumer, frame))
+  {
+    if (shedding)
+      ++shed;
+
+    else if (m_enabled
+             && (!m_sockets.isEmpty() || m_sharedMemory.hasConsumers()))
+    {
+      if (m_frames.isEmpty())
+        m_framesSince = Misc::PipelineStats::timestamp();
+
+      m_frames.append(frame);
+    }
+  }
+
+  if (m_frameBus)
+  {
+    const auto dropped = m_frameBus->takeDropped(m_frameConsumer);
+    if (dropped > 0)
+      Misc::PipelineStats::instance().recordDrops(
+          Misc::PipelineStats::PluginSend, dropped);
+  }
+
+  QByteArray data;
+  while (m_rawDataQueue.tryPop(data))
+  {
+    if (shedding)
+      ++shed;
+    else
+      sendRawData(data);
+  }
+
+  if (shed > 0)
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::PluginSend, shed);
+
+  sendLiveFrames();
+}
+
+/**
+ * @brief Sends the newest buffered frame to the plugins with a delta
+ *        subscription.
+ *
+ * Frames are sent as soon as they are published, skipping the frames received
+ * before the subscription interval elapsed, so that remote viewers receive a
+ * stream decimated to their refresh rate instead of the one second batches.
+ * Each frame only lists the values that changed since the previous frame sent
+ * to the plugin.
+ */
+void Plugins::ServerWorker::sendLiveFrames()
+{
+  // Stop if system is not enabled or there are no frames to send
+  if (!m_enabled || m_frames.isEmpty())
+    return;
+
+  // Send the newest frame to each live plugin
+  QByteArray schema;
+  const auto index = m_frames.count() - 1;
+  const auto now = Misc::SessionClock::now();
+  Q_FOREACH (auto socket, m_sockets)
+  {
+    if (!socket || !socket->isWritable())
+      continue;
+
+    // Skip plugins without a delta subscription
+    auto &client = m_clients[socket];
+    if (!client.binary || !client.subscription.delta)
+      continue;
+
+    // Skip plugins that received a frame within the subscription interval
+    const auto interval = client.subscription.interval;
+    if (client.lastFrameTime > 0 && now - client.lastFrameTime < interval)
+      continue;
+
+    // Send the schema of the frame if the plugin does not have it
+    if (schema.isEmpty())
+    {
+      updateSchema(m_frames[index]);
+      schema = m_schemaMessage;
+    }
+
+    if (client.schemaId != m_schemaId)
+    {
+      send(socket, schema, false);
+      client.schemaId = m_schemaId;
+      client.deltaGeneration = 0;
+    }
+
+    // Send the values that changed since the previous frame
+    const auto &subscription = client.subscription;
+    const auto mask = slotMask(m_frames[index], subscription.groups,
+                               subscription.datasets);
+    const auto data = encodeRun(m_frames, &index, 1, mask, m_schemaId,
+                                client.deltaGeneration);
+
+    client.lastFrameTime = now;
+    client.deltaGeneration = newestGeneration(m_frames[index]);
+    send(socket, data);
+  }
+}
+
+/**
+ * @brief Reports the memory used by the buffered frames & the send queues of
+ *        the plugins.
+ */
+void Plugins::ServerWorker::reportMemoryUsage()
+{
+  qint64 bytes = m_frames.capacity() * sizeof(JSON::Frame);
+  if (!m_frames.isEmpty())
+    bytes += m_frames.count() * m_frames.first().memoryUsage();
+
+  for (auto i = m_clients.cbegin(); i != m_clients.cend(); ++i)
+    bytes += i.value().queuedBytes;
+
+  Misc::PipelineStats::instance().setMemoryUsage(
+      Misc::PipelineStats::PluginQueue, bytes);
+}
+
+/**
+ * Hands the queued messages to the socket that reported written data
+ */
+void Plugins::ServerWorker::onBytesWritten()
+{
+  auto socket = static_cast<QTcpSocket *>(QObject::sender());
+  if (socket)
+    flushQueue(socket);
+}
+
+/**
+ * Process incoming data and writes it directly to the connected I/O device
+ */
+void Plugins::ServerWorker::onDataReceived()
+{
+  // Get caller socket
+  auto socket = static_cast<QTcpSocket *>(QObject::sender());
+
+  // Stop if system is not enabled
+  if (!m_enabled || !socket)
+    return;
+
+  // Obtain the incoming data & the incomplete message received before
+  auto data = socket->readAll();
+  auto &client = m_clients[socket];
+  const auto receivedAt = Misc::PipelineStats::timestamp();
+  if (!client.pendingInput.isEmpty())
+  {
+    data.prepend(client.pendingInput);
+    client.pendingInput.clear();
+  }
+
+  // Switch to the binary protocol if the first message is the handshake
+  static const QByteArray handshake(PLUGINS_BINARY_HANDSHAKE);
+  if (!client.handshakeDone)
+  {
+    // Wait for the rest of a handshake that was split across reads
+    if (isIncomplete(data, handshake))
+    {
+      client.pendingInput = data;
+      return;
+    }
+
+    client.handshakeDone = true;
+    if (data.startsWith(handshake))
+    {
+      client.binary = true;
+      data.remove(0, handshake.size());
+      socket->write(handshake);
+    }
+  }
+
+  // Handle the subscription messages & priority commands that start a line,
+  // everything else is written to the device
+  QByteArray raw;
+  qsizetype pos = 0;
+  static const QByteArray command(PLUGINS_DEVICE_COMMAND);
+  static const QByteArray subscription(PLUGINS_SUBSCRIBE_COMMAND);
+  while (pos < data.size())
+  {
+    const auto rest = QByteArrayView(data).sliced(pos);
+    if (client.lineStart)
+    {
+      // Wait for the rest of a control message prefix
+      if (isIncomplete(rest, command) || isIncomplete(rest, subscription))
+      {
+        client.pendingInput = rest.toByteArray();
+        break;
+      }
+
+      const bool isCommand = rest.startsWith(command);
+      const bool isSubscription = rest.startsWith(subscription);
+      if (isCommand || isSubscription)
+      {
+        // Wait for the rest of the message header
+        const auto end = rest.indexOf('\n');
+        if (end < 0)
+        {
+          if (rest.size() <= kMaxControlHeader)
+            client.pendingInput = rest.toByteArray();
+          else
+            client.lineStart = false;
+
+          break;
+        }
+
+        // Update the subscription of the plugin
+        if (isSubscription)
+        {
+          const auto size = subscription.size();
+          subscribe(client, rest.sliced(size, end - size).toByteArray());
+          pos += end + 1;
+          continue;
+        }
+
+        // Parse the command id & payload size
+        bool idOk = false;
+        bool sizeOk = false;
+        const auto header = rest.sliced(command.size(), end - command.size())
+                                .toByteArray();
+        const auto fields = header.trimmed().split(' ');
+        const auto id = fields.value(0).toLongLong(&idOk);
+        const auto size = fields.value(1).toLongLong(&sizeOk);
+        if (fields.count() != 2 || !idOk || !sizeOk || size < 0
+            || size > kMaxCommandSize)
+        {
+          qWarning() << "Invalid plugin command header:" << header;
+          pos += end + 1;
+          continue;
+        }
+
+        // Wait for the rest of the payload
+        const auto length = end + 1 + size;
+        if (rest.size() < length)
+        {
+          client.pendingInput = rest.toByteArray();
+          break;
+        }
+
+        // Write the command to the device
+        writeCommand(socket, id, rest.sliced(end + 1, size).toByteArray(),
+                     receivedAt);
+        pos += length;
+        continue;
+      }
+    }
+
+    // Forward the data up to the end of the line to the device
+    const auto end = rest.indexOf('\n');
+    client.lineStart = end >= 0;
+    if (end < 0)
+    {
+      raw.append(rest);
+      break;
+    }
+
+    raw.append(rest.first(end + 1));
+    pos += end + 1;
+  }
+
+  // Write incoming data to manager, from the main thread
+  if (!raw.isEmpty())
+  {
+    QMetaObject::invokeMethod(
+        &IO::Manager::instance(),
+        [=] { (void)IO::Manager::instance().writeData(raw); },
+        Qt::QueuedConnection);
+  }
+}
+
+/**
+ * Configures incoming connection requests
+ */
+void Plugins::ServerWorker::acceptConnection()
+{
+  // Get & validate socket
+  auto socket = m_server.nextPendingConnection();
+  if (!socket && m_enabled)
+  {
+    qWarning() << "Plugin server: invalid pending connection";
+    return;
+  }
+
+  // Close connection if system is not enabled
+  if (!m_enabled)
+  {
+    if (socket)
+    {
+      socket->close();
+      socket->deleteLater();
+    }
+
+    return;
+  }
+
+  // Send small messages (e.g. command acknowledgements) without delay
+  socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+  // Connect socket signals/slots
+  connect(socket, &QTcpSocket::readyRead, this,
+          &Plugins::ServerWorker::onDataReceived);
+  connect(socket, &QTcpSocket::bytesWritten, this,
+          &Plugins::ServerWorker::onBytesWritten);
+  connect(socket, &QTcpSocket::disconnected, this,
+          &Plugins::ServerWorker::removeConnection);
+
+  // React to socket errors
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+  connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), this,
+          SLOT(onErrorOccurred(QAbstractSocket::SocketError)));
+#else
+  connect(socket, &QTcpSocket::errorOccurred, this,
+          &Plugins::ServerWorker::onErrorOccurred);
+#endif
+
+  // Add socket to sockets list
+  m_sockets.append(socket);
+  m_clients.insert(socket, ClientState());
+}
+
+/**
+ * Sends the frames received since the last call to each plugin, as a JSON
+ * array of frames or as binary messages, depending on the protocol selected
+ * by each plugin. The frames & datasets sent to each plugin are selected by
+ * its subscription, and each encoding is generated once for all the plugins
+ * that use the same protocol & selection.
+ */
+void Plugins::ServerWorker::sendProcessedData()
+{
+  // Report the memory used by the frame buffer & the send queues
+  reportMemoryUsage();
+
+  // Stop if system is not enabled
+  if (!m_enabled)
+    return;
+
+  // Stop if frame list is empty
+  if (m_frames.count() <= 0)
+    return;
+
+  // Stop if no plugins are available
+  const bool localClients = m_sharedMemory.hasConsumers();
+  if (m_sockets.count() < 1 && !localClients)
+    return;
+
+  // Split the frames in runs that share the same schema
+  bool binaryClients = localClients;
+  for (auto i = m_clients.cbegin(); i != m_clients.cend(); ++i)
+    binaryClients |= i.value().binary;
+
+  QByteArray firstSchema;
+  quint64 firstSchemaId = 0;
+  if (binaryClients)
+  {
+    updateSchemaRuns();
+    firstSchema = m_schemaRuns.first().schemaMessage;
+    firstSchemaId = m_schemaRuns.first().schemaId;
+  }
+
+  // Encode the selected frames once for each protocol & subscription
+  qsizetype bytes = 0;
+  QHash<QByteArray, QByteArray> encodings;
+  const auto encode = [&](const bool binary, const Subscription &subscription,
+                          const QVector<qsizetype> &selection) {
+    QByteArray key(binary ? "B" : "J");
+    key.append(subscription.key);
+    key.append('/');
+    if (selection.count() == m_frames.count())
+      key.append('*');
+    else
+      key.append(reinterpret_cast<const char *>(selection.constData()),
+                 selection.count() * sizeof(qsizetype));
+
+    auto it = encodings.constFind(key);
+    if (it == encodings.constEnd())
+    {
+      const auto data = binary ? encodeBinaryFrames(selection, subscription)
+                               : encodeJsonFrames(selection, subscription);
+      bytes += data.size();
+      it = encodings.insert(key, data);
+    }
+
+    return it.value();
+  };
+
+  // Send data to each plugin
+  Q_FOREACH (auto socket, m_sockets)
+  {
+    if (!socket || !socket->isWritable())
+      continue;
+
+    // Skip live plugins & those that do not receive any buffered frame
+    auto &client = m_clients[socket];
+    if (client.binary && client.subscription.delta)
+      continue;
+
+    const auto selection = selectFrames(client);
+    if (selection.isEmpty())
+      continue;
+
+    // Send the schema of the first frame if the plugin does not have it
+    const auto data = encode(client.binary, client.subscription, selection);
+    if (client.binary)
+    {
+      if (client.schemaId != firstSchemaId)
+        send(socket, firstSchema, false);
+
+      client.schemaId = m_schemaId;
+    }
+
+    if (!data.isEmpty())
+      send(socket, data);
+  }
+
+  // Send every frame to local plugins
+  if (localClients)
+  {
+    QVector<qsizetype> selection(m_frames.count());
+    std::iota(selection.begin(), selection.end(), 0);
+    const auto data = encode(true, Subscription(), selection);
+    m_sharedMemory.sendFrames(firstSchema, firstSchemaId, data, m_schemaId);
+  }
+
+  // Register the time that the oldest frame waited before being sent
+  auto &stats = Misc::PipelineStats::instance();
+  stats.record(Misc::PipelineStats::PluginSend, m_frames.count(), bytes,
+               stats.timestamp() - m_framesSince);
+
+  // Clear frame list
+  m_frames.clear();
+  m_frames.squeeze();
+}
+
+/**
+ * Sends the given raw @a data to each plugin, encoded in Base64 inside a JSON
+ * object, or as a binary @c "raw" message for plugins that use the binary
+ * protocol.
+ */
+void Plugins::ServerWorker::sendRawData(const QByteArray &data)
+{
+  // Stop if system is not enabled
+  if (!m_enabled)
+    return;
+
+  // Stop if no plugins are available
+  const bool localClients = m_sharedMemory.hasConsumers();
+  if (m_sockets.count() < 1 && !localClients)
+    return;
+
+  // Binary protocol, send data as a CBOR byte string
+  QByteArray binary;
+  const auto encodeBinary = [&] {
+    if (binary.isEmpty())
+    {
+      QCborMap map;
+      map.insert(QLatin1StringView("type"), QLatin1StringView("raw"));
+      map.insert(QLatin1StringView("data"), data);
+      binary = binaryMessage(map.toCborValue().toCbor());
+    }
+
+    return binary;
+  };
+
+  // Send data to local plugins
+  if (localClients)
+    m_sharedMemory.sendRawData(encodeBinary());
+
+  // Send data to each plugin, encoding it only once for each protocol
+  QByteArray json;
+  Q_FOREACH (auto socket, m_sockets)
+  {
+    if (!socket || !socket->isWritable())
+      continue;
+
+    // Skip plugins that opted out of raw data
+    const auto &client = m_clients[socket];
+    if (!client.subscription.raw)
+      continue;
+
+    // Binary protocol
+    if (client.binary)
+      send(socket, encodeBinary());
+
+    // JSON protocol, send data encoded in Base-64
+    else
+    {
+      if (json.isEmpty())
+      {
+        QJsonObject object;
+        object.insert(QStringLiteral("data"),
+                      QString::fromUtf8(data.toBase64()));
+
+        QJsonDocument document(object);
+        json = document.toJson(QJsonDocument::Compact) + "\n";
+      }
+
+      send(socket, json);
+    }
+  }
+}
+
+/**
+ * Sends the pipeline statistics to each plugin, as a JSON object with a
+ * @c "stats" key, or as a binary @c "stats" message for plugins that use the
+ * binary protocol.
+ */
+void Plugins::ServerWorker::sendStatistics(const QJsonObject &statistics)
+{
+  // Stop if system is not enabled or no plugins are available
+  if (!m_enabled || m_sockets.count() < 1)
+    return;
+
+  // Send the statistics to each plugin, encoding them once for each protocol
+  QByteArray json;
+  QByteArray binary;
+  Q_FOREACH (auto socket, m_sockets)
+  {
+    if (!socket || !socket->isWritable())
+      continue;
+
+    // Binary protocol
+    if (m_clients.value(socket).binary)
+    {
+      if (binary.isEmpty())
+      {
+        QCborMap map;
+        map.insert(QLatin1StringView("type"), QLatin1StringView("stats"));
+        map.insert(QLatin1StringView("stats"),
+                   QCborValue::fromJsonValue(statistics));
+        binary = binaryMessage(map.toCborValue().toCbor());
+      }
+
+      send(socket, binary);
+    }
+
+    // JSON protocol
+    else
+    {
+      if (json.isEmpty())
+      {
+        QJsonObject object;
+        object.insert(QStringLiteral("stats"), statistics);
+
+        QJsonDocument document(object);
+        json = document.toJson(QJsonDocument::Compact) + "\n";
+      }
+
+      send(socket, json);
+    }
+  }
+}
+
+/**
+ * Writes queued messages to the given @a socket until its output buffer
+ * reaches the watermark or the queue is empty.
+ */
+void Plugins::ServerWorker::flushQueue(QTcpSocket *socket)
+{
+  auto client = m_clients.find(socket);
+  if (client == m_clients.end())
+    return;
+
+  while (!client->queue.isEmpty() && socket->bytesToWrite() < kSocketWatermark)
+  {
+    const auto message = client->queue.dequeue();
+    client->droppable.dequeue();
+    client->queuedBytes -= message.size();
+    socket->write(message);
+  }
+}
+
+/**
+ * @brief Queues the given @a message for the given @a socket.
+ *
+ * The message is shared with the other plugins, so queueing it never copies
+ * its data. If the queue of the plugin is full, the oldest @a droppable
+ * messages are discarded, or the plugin is disconnected, depending on the
+ * selected policy.
+ */
+void Plugins::ServerWorker::send(QTcpSocket *socket, const QByteArray &message,
+                           const bool droppable)
+{
+  // Obtain plugin state
+  auto client = m_clients.find(socket);
+  if (client == m_clients.end() || client->disconnecting)
+    return;
+
+  // Queue the message
+  client->queue.enqueue(message);
+  client->droppable.enqueue(droppable);
+  client->queuedBytes += message.size();
+
+  // Queue is full, disconnect the plugin after this event loop iteration
+  if (client->queuedBytes > kMaxQueuedBytes && m_slowClientPolicy == Disconnect)
+  {
+    qWarning() << "Disconnecting slow plugin" << socket->peerAddress();
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::PluginSend, client->queue.count());
+    client->queue.clear();
+    client->droppable.clear();
+    client->queuedBytes = 0;
+    client->disconnecting = true;
+    QMetaObject::invokeMethod(socket, &QTcpSocket::abort,
+                              Qt::QueuedConnection);
+    return;
+  }
+
+  // Queue is full, drop the oldest messages
+  for (qsizetype i = 0;
+       client->queuedBytes > kMaxQueuedBytes && i < client->queue.count();)
+  {
+    if (client->droppable.at(i))
+    {
+      client->queuedBytes -= client->queue.at(i).size();
+      client->queue.removeAt(i);
+      client->droppable.removeAt(i);
+      client->deltaGeneration = 0;
+      Misc::PipelineStats::instance().recordDrops(
+          Misc::PipelineStats::PluginSend);
+    }
+
+    else
+      ++i;
+  }
+
+  // Write as much as possible
+  flushQueue(socket);
+}
+
+/**
+ * @brief Updates the subscription of a plugin.
+ *
+ * The @a message is the JSON object that follows the
+ * @c PLUGINS_SUBSCRIBE_COMMAND prefix (see the class documentation). An
+ * invalid message leaves the current subscription untouched.
+ */
+void Plugins::ServerWorker::subscribe(ClientState &client,
+                                      const QByteArray &message)
+{
+  // Parse the subscription object
+  QJsonParseError error;
+  const auto document = QJsonDocument::fromJson(message, &error);
+  if (error.error != QJsonParseError::NoError || !document.isObject())
+  {
+    qWarning() << "Invalid plugin subscription:" << error.errorString();
+    return;
+  }
+
+  // Read the frame rate & raw data settings
+  Subscription subscription;
+  const auto object = document.object();
+  const auto rate = object.value(QStringLiteral("rate")).toDouble(0);
+  subscription.raw = object.value(QStringLiteral("raw")).toBool(true);
+  subscription.delta = object.value(QStringLiteral("delta")).toBool(false);
+  if (rate > 0)
+    subscription.interval = static_cast<qint64>(1e9 / rate);
+
+  // Read the group & dataset filters
+  for (const auto &id : object.value(QStringLiteral("groups")).toArray())
+    subscription.groups.insert(id.toInt());
+  for (const auto &id : object.value(QStringLiteral("datasets")).toArray())
+    subscription.datasets.insert(id.toInt());
+
+  // Build the filter key from the sorted ids
+  if (!subscription.groups.isEmpty() || !subscription.datasets.isEmpty())
+  {
+    auto groups = subscription.groups.values();
+    auto datasets = subscription.datasets.values();
+    std::sort(groups.begin(), groups.end());
+    std::sort(datasets.begin(), datasets.end());
+
+    subscription.key = "g";
+    for (const auto id : std::as_const(groups))
+      subscription.key.append(QByteArray::number(id) + ',');
+
+    subscription.key.append('d');
+    for (const auto id : std::as_const(datasets))
+      subscription.key.append(QByteArray::number(id) + ',');
+  }
+
+  // Apply the new subscription
+  client.lastFrameTime = 0;
+  client.deltaGeneration = 0;
+  client.subscription = subscription;
+}
+
+/**
+ * @brief Writes a priority command received from a plugin to the device.
+ *
+ * The command is acknowledged by @c onCommandCompleted() once the driver
+ * reports that it was written, or right away if no device can receive it.
+ *
+ * @param socket     Plugin that sent the command.
+ * @param id         Command id chosen by the plugin.
+ * @param payload    Data written to the device.
+ * @param receivedAt Time at which the command was read from the socket.
+ */
+void Plugins::ServerWorker::writeCommand(QTcpSocket *socket, const qint64 id,
+                                         const QByteArray &payload,
+                                         const qint64 receivedAt)
+{
+  // Hand the command to the device, bypassing the transmission queue
+  const auto ticket = IO::Manager::instance().writeCommand(payload);
+  if (ticket != 0)
+  {
+    m_pendingAcks.insert(ticket, {socket, id, receivedAt});
+    return;
+  }
+
+  // No device, report the failure at once
+  auto &stats = Misc::PipelineStats::instance();
+  stats.recordDrops(Misc::PipelineStats::PluginCommand);
+  sendAck(socket, id, -1, stats.timestamp() - receivedAt);
+}
+
+/**
+ * @brief Acknowledges the priority command identified by @a ticket, now that
+ *        the driver has written @a bytes of it (or -1 if the write failed).
+ *
+ * The latency of the acknowledgement spans from the reception of the command
+ * to the completion of the write, which is what closed-loop plugins need to
+ * measure the round-trip time of their control loop.
+ */
+void Plugins::ServerWorker::onCommandCompleted(const quint64 ticket,
+                                               const qint64 bytes)
+{
+  // Not a command sent by a connected plugin
+  const auto it = m_pendingAcks.constFind(ticket);
+  if (it == m_pendingAcks.constEnd())
+    return;
+
+  const auto ack = it.value();
+  m_pendingAcks.erase(it);
+  if (!m_clients.contains(ack.socket))
+    return;
+
+  // Register the command
+  auto &stats = Misc::PipelineStats::instance();
+  const auto latency = stats.timestamp() - ack.receivedAt;
+  if (bytes < 0)
+    stats.recordDrops(Misc::PipelineStats::PluginCommand);
+  else
+    stats.record(Misc::PipelineStats::PluginCommand, 1, bytes, latency);
+
+  // Send the acknowledgement
+  sendAck(ack.socket, ack.id, bytes, latency);
+}
+
+/**
+ * @brief Sends the acknowledgement of a priority command to a plugin, encoded
+ *        with the protocol used by the plugin.
+ *
+ * @param socket  Plugin that sent the command.
+ * @param id      Command id chosen by the plugin.
+ * @param bytes   Number of bytes written to the device, -1 on failure.
+ * @param latency Nanoseconds between the reception of the command & the
+ *                completion of its write.
+ */
+void Plugins::ServerWorker::sendAck(QTcpSocket *socket, const qint64 id,
+                                    const qint64 bytes, const qint64 latency)
+{
+  // Acknowledge the command with the binary protocol
+  if (m_clients.value(socket).binary)
+  {
+    QCborMap map;
+    map.insert(QLatin1StringView("type"), QLatin1StringView("ack"));
+    map.insert(QLatin1StringView("id"), id);
+    map.insert(QLatin1StringView("bytes"), bytes);
+    map.insert(QLatin1StringView("latency"), latency);
+    send(socket, binaryMessage(map.toCborValue().toCbor()), false);
+  }
+
+  // Acknowledge the command with a JSON line
+  else
+  {
+    QJsonObject ack;
+    ack.insert(QStringLiteral("id"), id);
+    ack.insert(QStringLiteral("bytes"), bytes);
+    ack.insert(QStringLiteral("latency"), latency);
+
+    QJsonObject object;
+    object.insert(QStringLiteral("ack"), ack);
+    const QJsonDocument document(object);
+    send(socket, document.toJson(QJsonDocument::Compact) + "\n", false);
+  }
+}
+
+/**
+ * @brief Selects the buffered frames that are sent to the given @a client.
+ *
+ * Every frame is selected unless the subscription of the plugin limits its
+ * frame rate, in which case frames are skipped until the subscription
+ * interval has elapsed since the last frame sent to the plugin.
+ *
+ * @return The indexes of the selected frames, in ascending order.
+ */
+QVector<qsizetype>
+Plugins::ServerWorker::selectFrames(ClientState &client) const
+{
+  QVector<qsizetype> selection;
+  selection.reserve(m_frames.count());
+
+  const auto interval = client.subscription.interval;
+  for (qsizetype i = 0; i < m_frames.count(); ++i)
+  {
+    // No rate limit
+    if (interval <= 0)
+    {
+      selection.append(i);
+      continue;
+    }
+
+    // Skip frames received before the interval elapsed
+    const auto timestamp = m_frames[i].timestamp();
+    const auto t = timestamp > 0 ? timestamp : Misc::SessionClock::now();
+    if (client.lastFrameTime == 0 || t - client.lastFrameTime >= interval)
+    {
+      selection.append(i);
+      client.lastFrameTime = t;
+    }
+  }
+
+  return selection;
+}
+
+/**
+ * @brief Updates the schema sent to binary plugins with the structure of the
+ *        given @a frame.
+ *
+ * The schema is the JSON representation of the frame without the dataset
+ * values. It is only regenerated when the structure generation of the frame
+ * changes, and a new schema id is assigned only if its contents differ from
+ * the previous schema (e.g. frames built from JSON data always have a new
+ * generation, but usually the same structure).
+ *
+ * @return @c true if the schema changed, @c false otherwise.
+ */
+bool Plugins::ServerWorker::updateSchema(const JSON::Frame &frame)
+{
+  // Same structure as the previous frame
+  if (!m_schema.isEmpty() && frame.generation() == m_schemaGeneration)
+    return false;
+
+  // Obtain the frame structure without values
+  m_schemaGeneration = frame.generation();
+  auto object = frame.serialize();
+  auto groups = object.value(QStringLiteral("groups")).toArray();
+  for (qsizetype g = 0; g < groups.count(); ++g)
+  {
+    auto group = groups[g].toObject();
+    auto datasets = group.value(QStringLiteral("datasets")).toArray();
+    for (qsizetype d = 0; d < datasets.count(); ++d)
+    {
+      auto dataset = datasets[d].toObject();
+      dataset.remove(QStringLiteral("value"));
+      datasets[d] = dataset;
+    }
+
+    group.insert(QStringLiteral("datasets"), datasets);
+    groups[g] = group;
+  }
+
+  object.insert(QStringLiteral("groups"), groups);
+
+  // Compare with the previous schema
+  const auto structure = QCborValue::fromJsonValue(object);
+  const auto schema = structure.toCbor();
+  if (schema == m_schema)
+    return false;
+
+  // Generate the schema message
+  m_schema = schema;
+  ++m_schemaId;
+  QCborMap map;
+  map.insert(QLatin1StringView("type"), QLatin1StringView("schema"));
+  map.insert(QLatin1StringView("id"), static_cast<qint64>(m_schemaId));
+  map.insert(QLatin1StringView("frame"), structure);
+  m_schemaMessage = binaryMessage(map.toCborValue().toCbor());
+  return true;
+}
+
+/**
+ * @brief Splits the buffered frames in runs of frames that share the same
+ *        schema.
+ *
+ * The schema of each run is generated with @c updateSchema(), so that the
+ * binary schema messages are only regenerated when the structure changes.
+ */
+void Plugins::ServerWorker::updateSchemaRuns()
+{
+  m_schemaRuns.clear();
+  if (m_frames.isEmpty())
+    return;
+
+  updateSchema(m_frames.first());
+  SchemaRun run{0, 0, m_schemaId, m_schemaMessage};
+  for (qsizetype i = 1; i < m_frames.count(); ++i)
+  {
+    if (updateSchema(m_frames[i]))
+    {
+      run.last = i - 1;
+      m_schemaRuns.append(run);
+      run = SchemaRun{i, i, m_schemaId, m_schemaMessage};
+    }
+  }
+
+  run.last = m_frames.count() - 1;
+  m_schemaRuns.append(run);
+}
+
+/**
+ * @brief Encodes the selected frames as a compact JSON document with a
+ *        @c "frames" array, followed by a newline.
+ *
+ * Groups & datasets that are not part of the @a subscription filters are
+ * removed from each frame, as well as groups left without datasets.
+ *
+ * @param selection    Indexes of the buffered frames to encode.
+ * @param subscription Subscription of the plugins that receive the data.
+ */
+QByteArray Plugins::ServerWorker::encodeJsonFrames(
+    const QVector<qsizetype> &selection, const Subscription &subscription) const
+{
+  // Create JSON array with frame data
+  QJsonArray array;
+  const bool filter = !subscription.groups.isEmpty()
+                      || !subscription.datasets.isEmpty();
+  for (const auto i : selection)
+  {
+    const auto &frame = m_frames[i];
+    auto data = frame.serialize();
+
+    // Remove the datasets that are not part of the subscription
+    if (filter)
+    {
+      QJsonArray filtered;
+      const auto &frameGroups = frame.groups();
+      const auto groups = data.value(QStringLiteral("groups")).toArray();
+      const auto groupCount = qMin(groups.count(), frameGroups.count());
+      for (qsizetype g = 0; g < groupCount; ++g)
+      {
+        const auto &frameDatasets = frameGroups[g].datasets();
+        const bool all = subscription.groups.contains(frameGroups[g].groupId());
+
+        QJsonArray selected;
+        auto group = groups[g].toObject();
+        const auto datasets = group.value(QStringLiteral("datasets")).toArray();
+        const auto count = qMin(datasets.count(), frameDatasets.count());
+        for (qsizetype d = 0; d < count; ++d)
+        {
+          if (all || subscription.datasets.contains(frameDatasets[d].index()))
+            selected.append(datasets[d]);
+        }
+
+        if (!selected.isEmpty())
+        {
+          group.insert(QStringLiteral("datasets"), selected);
+          filtered.append(group);
+        }
+      }
+
+      data.insert(QStringLiteral("groups"), filtered);
+    }
+
+    QJsonObject object;
+    object.insert(QStringLiteral("data"), data);
+    array.append(object);
+  }
+
+  // Create JSON document with frame arrays
+  QJsonObject object;
+  object.insert(QStringLiteral("frames"), array);
+  const QJsonDocument document(object);
+  return document.toJson(QJsonDocument::Compact) + "\n";
+}
+
+/**
+ * @brief Encodes the selected frames as binary messages.
+ *
+ * Consecutive frames that share the same schema are encoded in a single
+ * @c "frames" message. If the schema changes within the buffered frames, the
+ * new schema message is inserted before the frames that use it. The schema of
+ * the first run (see @c updateSchemaRuns()) must be sent before the returned
+ * data to plugins that did not receive it yet.
+ *
+ * @param selection    Indexes of the buffered frames to encode.
+ * @param subscription Subscription of the plugins that receive the data.
+ *
+ * @return The encoded messages.
+ */
+QByteArray Plugins::ServerWorker::encodeBinaryFrames(
+    const QVector<qsizetype> &selection, const Subscription &subscription) const
+{
+  QByteArray data;
+  qsizetype k = 0;
+  for (qsizetype r = 0; r < m_schemaRuns.count(); ++r)
+  {
+    // Find the selected frames that belong to the run
+    const auto &run = m_schemaRuns[r];
+    const auto begin = k;
+    while (k < selection.count() && selection[k] <= run.last)
+      ++k;
+
+    // Insert the schema of the run, and then its frames
+    if (r > 0)
+      data.append(run.schemaMessage);
+
+    if (k > begin)
+    {
+      const auto mask = slotMask(m_frames[run.first], subscription.groups,
+                                 subscription.datasets);
+      data.append(encodeRun(m_frames, selection.constData() + begin,
+                            k - begin, mask, run.schemaId));
+    }
+  }
+
+  return data;
+}
+
+/**
+ * This function is called whenever a socket error occurs, it disconnects the
+ * socket from the host and displays the error in a message box.
+ */
+void Plugins::ServerWorker::onErrorOccurred(
+    const QAbstractSocket::SocketError socketError)
+{
+  // Get caller socket
+  auto socket = static_cast<QTcpSocket *>(QObject::sender());
+
+  // Print error
+  if (socket)
+    qDebug() << socket->errorString();
+  else
+    qDebug() << socketError;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QSet>
+#include <QHash>
+#include <QQueue>
+#include <QJsonObject>
+#include <QObject>
+#include <QTcpSocket>
+#include <QTcpServer>
+#include <QByteArray>
+#include <QHostAddress>
+
+#include "JSON/Frame.h"
+#include "Misc/SpscQueue.h"
+#include "Plugins/SharedMemory.h"
+
+/**
+ * Default TCP port to use for incoming connections, I choose 7777 because 7 is
+ * one of my favourite numbers :)
+ */
+#define PLUGINS_TCP_PORT 7777
+
+/**
+ * First message sent by plugins to switch their connection to the binary
+ * protocol.
+ */
+#define PLUGINS_BINARY_HANDSHAKE "SSBINARY/1\n"
+
+/**
+ * Prefix of the messages sent by plugins to change their subscription, the
+ * prefix is followed by a JSON object & a newline.
+ */
+#define PLUGINS_SUBSCRIBE_COMMAND "SSSUBSCRIBE "
+
+/**
+ * Prefix of the priority commands sent by plugins to the device, the prefix is
+ * followed by the command id, the payload size in bytes, a newline & the
+ * payload.
+ */
+#define PLUGINS_DEVICE_COMMAND "SSCOMMAND "
+
+namespace Plugins
+{
+/**
+ * @brief The ServerWorker class
+ *
+ * Owns the TCP server & the plugin sockets of the @c Plugins::Server class,
+ * and runs in a dedicated network thread. Frames are read from the frame bus
+ * (see @c JSON::FrameBus) with the cursor of the worker, and raw data is
+ * handed over by the main thread through a lock-free queue
+ * (@c enqueueRawData()), so encoding & sending data never competes with the
+ * user interface, and the main thread never touches a socket.
+ *
+ * By default, frames & raw data are sent as compact JSON documents separated
+ * by newlines. A plugin can switch its connection to the binary protocol by
+ * sending the @c PLUGINS_BINARY_HANDSHAKE string as its very first message
+ * (anything after the handshake is handled as usual). The server
+ * answers with the same string, everything received before the answer is
+ * still JSON and should be discarded by the plugin. In binary mode, each
+ * message is a @c quint32 little-endian byte count followed by a CBOR map with
+ * a @c "type" key:
+ *
+ * - @c "schema": sent before the first frames & whenever the structure of the
+ *   frames changes. Contains the schema @c "id" and the @c "frame" structure
+ *   (the JSON frame without dataset values).
+ * - @c "frames": contains the @c "schema" id & a @c "frames" array. The first
+ *   frame of each message lists every value, the following frames only list
+ *   the values that changed. Each frame is a flat array of
+ *   @c [slot, value, slot, value...] pairs, where the slot is the position of
+ *   the dataset in the schema (counting the datasets of each group in order)
+ *   and the value is a number for numeric datasets or a string otherwise.
+ * - @c "raw": contains the raw @c "data" received from the device, as a CBOR
+ *   byte string.
+ * - @c "stats": contains the pipeline statistics (see
+ *   @c Misc::PipelineStats::toJson()) in the @c "stats" key, sent once per
+ *   second. JSON plugins receive them as an object with a @c "stats" key.
+ *   The @c "datasets" array of the statistics contains the live statistics
+ *   of each dataset (see @c Misc::DatasetStatistics::toJson()).
+ *
+ * Plugins receive every dataset of every frame & the raw data by default. A
+ * plugin can narrow its subscription at any time by sending a line that
+ * starts with @c PLUGINS_SUBSCRIBE_COMMAND, followed by a JSON object and a
+ * newline (the message is not written to the device):
+ *
+ * - @c "groups": ids of the groups whose datasets are sent.
+ * - @c "datasets": indexes of the datasets that are sent, in addition to the
+ *   datasets of the selected groups. If neither list is given (or both are
+ *   empty), every dataset is sent.
+ * - @c "rate": maximum number of frames per second sent to the plugin, the
+ *   other frames are skipped. Zero (the default) sends every frame.
+ * - @c "raw": set to @c false to stop receiving raw data.
+ * - @c "delta": set to @c true to receive live frames (used by
+ *   @c Plugins::Viewer). Instead of the one second batches, the newest frame
+ *   is sent as soon as it is published (limited by @c "rate"), and only lists
+ *   the values that changed since the previous frame sent to the plugin. The
+ *   next frame lists every value again after a schema change or after a
+ *   frame message was dropped from the queue of the plugin.
+ *
+ * JSON plugins receive frames that only contain the selected groups &
+ * datasets. Binary plugins still receive the complete schema, but frame
+ * messages only list the slots of the selected datasets.
+ *
+ * Any other data sent by a plugin is queued for transmission to the device.
+ * Closed-loop plugins can instead send priority commands, which start a line
+ * with @c PLUGINS_DEVICE_COMMAND (e.g. @c "SSCOMMAND 42 5\nhello"). Control
+ * messages are recognized at the start of the connection, after a newline
+ * or after another control message, even if they arrive split across reads
+ * or together with other data, and the start of a line that may still become
+ * a control message is held back until the rest arrives. Commands are
+ * handed to @c IO::Manager::writeCommand() from the server thread, skipping
+ * the transmission queue, and each command is acknowledged with an @c "ack"
+ * object (a JSON line or a binary @c "ack" message) once the driver reports
+ * that it was written. The acknowledgement contains its @c "id", the number
+ * of @c "bytes" written to the device (-1 on failure) and the @c "latency" in
+ * nanoseconds between its reception & the completion of the write. Plugins
+ * can measure the round-trip time of their control loop from the time they
+ * send a command until its acknowledgement arrives.
+ *
+ * Each message is encoded once and shared by all the plugins that use the same
+ * protocol & subscription. Messages are handed to a socket only while its
+ * output buffer is small, the rest wait in a bounded per-plugin queue. When a
+ * plugin does not read fast enough and its queue becomes full, either the
+ * oldest queued messages are dropped (schema messages are never dropped) or
+ * the plugin is disconnected, depending on the selected policy.
+ *
+ * Plugins running on the same computer can also receive the binary messages
+ * through the @c Plugins::SharedMemory transport, which is available while the
+ * plugin system is enabled.
+ */
+class ServerWorker : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ServerWorker();
+
+  /**
+   * @brief Action taken when the send queue of a plugin is full.
+   */
+  enum SlowClientPolicy
+  {
+    DropOldest = 0,
+    Disconnect = 1,
+  };
+  Q_ENUM(SlowClientPolicy)
+
+  void wakeUp();
+  void enqueueRawData(const QByteArray &data);
+  void setFrameBus(JSON::FrameBus *bus, const int consumer);
+
+public slots:
+  void stopServer();
+  void startServer();
+  void sendProcessedData();
+  void setEnabled(const bool enabled);
+  void sendStatistics(const QJsonObject &statistics);
+  void setSlowClientPolicy(const int policy);
+
+private slots:
+  void drainQueues();
+  void onBytesWritten();
+  void onDataReceived();
+  void removeConnection();
+  void acceptConnection();
+  void onCommandCompleted(const quint64 ticket, const qint64 bytes);
+  void onErrorOccurred(const QAbstractSocket::SocketError socketError);
+
+private:
+  /**
+   * @brief Data requested by a plugin.
+   *
+   * The @c key identifies the group & dataset filters, so that frames are
+   * encoded once for the plugins that share the same filters.
+   */
+  struct Subscription
+  {
+    bool raw = true;
+    bool delta = false;
+    qint64 interval = 0;
+    QSet<int> groups;
+    QSet<int> datasets;
+    QByteArray key;
+  };
+
+  /**
+   * @brief Protocol state of a plugin connection.
+   */
+  struct ClientState
+  {
+    bool handshakeDone = false;
+    bool lineStart = true;
+    bool binary = false;
+    bool disconnecting = false;
+    quint64 schemaId = 0;
+    qint64 lastFrameTime = 0;
+    quint64 deltaGeneration = 0;
+    qsizetype queuedBytes = 0;
+    Subscription subscription;
+    QByteArray pendingInput;
+    QQueue<QByteArray> queue;
+    QQueue<bool> droppable;
+  };
+
+  /**
+   * @brief Range of buffered frames that share the same binary schema.
+   */
+  struct SchemaRun
+  {
+    qsizetype first;
+    qsizetype last;
+    quint64 schemaId;
+    QByteArray schemaMessage;
+  };
+
+  void sendLiveFrames();
+  void reportMemoryUsage();
+  void flushQueue(QTcpSocket *socket);
+  void sendRawData(const QByteArray &data);
+  void send(QTcpSocket *socket, const QByteArray &message,
+            const bool droppable = true);
+
+  void subscribe(ClientState &client, const QByteArray &message);
+  void writeCommand(QTcpSocket *socket, const qint64 id,
+                    const QByteArray &payload, const qint64 receivedAt);
+  void sendAck(QTcpSocket *socket, const qint64 id, const qint64 bytes,
+               const qint64 latency);
+  [[nodiscard]] QVector<qsizetype> selectFrames(ClientState &client) const;
+
+  bool updateSchema(const JSON::Frame &frame);
+  void updateSchemaRuns();
+  [[nodiscard]] QByteArray
+  encodeJsonFrames(const QVector<qsizetype> &selection,
+                   const Subscription &subscription) const;
+  [[nodiscard]] QByteArray
+  encodeBinaryFrames(const QVector<qsizetype> &selection,
+                     const Subscription &subscription) const;
+
+private:
+  bool m_enabled;
+  int m_slowClientPolicy;
+
+  std::atomic_bool m_wakeUpPending;
+  int m_frameConsumer;
+  JSON::FrameBus *m_frameBus;
+  Misc::SpscQueue<QByteArray> m_rawDataQueue;
+
+  QTcpServer m_server;
+  SharedMemory m_sharedMemory;
+  QVector<JSON::Frame> m_frames;
+  QVector<SchemaRun> m_schemaRuns;
+  QVector<QTcpSocket *> m_sockets;
+  QHash<QTcpSocket *, ClientState> m_clients;
+
+  struct PendingAck
+  {
+    QTcpSocket *socket;
+    qint64 id;
+    qint64 receivedAt;
+  };
+
+  QHash<quint64, PendingAck> m_pendingAcks;
+
+  qint64 m_framesSince;
+
+  quint64 m_schemaId;
+  quint64 m_schemaGeneration;
+  QByteArray m_schema;
+  QByteArray m_schemaMessage;
+};
+} // namespace Plugins
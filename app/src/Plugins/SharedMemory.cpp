@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Plugins/SharedMemory.h"
+
+#include <new>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+
+#include <QDebug>
+
+/**
+ * Version of the shared memory layout
+ */
+static constexpr quint32 kFormatVersion = 1;
+
+/**
+ * Number of consumers that can be attached at the same time
+ */
+static constexpr int kSlotCount = 8;
+
+/**
+ * Capacity of the ring buffer of each consumer (in bytes)
+ */
+static constexpr quint64 kRingCapacity = 2 * 1024 * 1024;
+
+/**
+ * Size of the segment header & of each slot control block (in bytes)
+ */
+static constexpr qsizetype kHeaderSize = 64;
+static constexpr qsizetype kSlotHeaderSize = 64;
+
+/**
+ * Time after which a consumer that does not read any data is released
+ */
+static constexpr qint64 kStaleTimeout = 10000;
+
+/**
+ * @brief Control block of a consumer slot, stored in the shared segment.
+ *
+ * The fields are accessed with atomic operations by both processes, so they
+ * must be lock-free (i.e. have the same layout as the plain integers).
+ */
+struct Plugins::SharedMemory::SlotHeader
+{
+  std::atomic<quint32> state;
+  std::atomic<quint32> generation;
+  std::atomic<quint64> writeSequence;
+  std::atomic<quint64> readSequence;
+  std::atomic<quint64> dropped;
+};
+
+/**
+ * Constructor function
+ */
+Plugins::SharedMemory::SharedMemory()
+{
+  m_memory.setNativeKey(QSharedMemory::platformSafeKey(PLUGINS_SHM_KEY));
+}
+
+/**
+ * Destructor function, releases the shared segment
+ */
+Plugins::SharedMemory::~SharedMemory()
+{
+  close();
+}
+
+/**
+ * Returns @c true if the shared segment has been created
+ */
+bool Plugins::SharedMemory::isOpen() const
+{
+  return m_memory.isAttached();
+}
+
+/**
+ * Returns @c true if at least one consumer is attached to the segment
+ */
+bool Plugins::SharedMemory::hasConsumers() const
+{
+  if (!isOpen())
+    return false;
+
+  for (int i = 0; i < kSlotCount; ++i)
+  {
+    if (slot(i)->state.load(std::memory_order_acquire) == 1)
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Creates the shared segment & initializes its header.
+ *
+ * If a segment with the same key already exists (e.g. left behind by an
+ * instance that crashed), it is attached to and re-initialized.
+ *
+ * @return @c true on success, @c false otherwise.
+ */
+bool Plugins::SharedMemory::open()
+{
+  // Control blocks are shared between processes
+  static_assert(std::atomic<quint32>::is_always_lock_free);
+  static_assert(std::atomic<quint64>::is_always_lock_free);
+  static_assert(sizeof(SlotHeader) <= kSlotHeaderSize);
+
+  // Already open
+  if (isOpen())
+    return true;
+
+  // Create or attach to the segment
+  const auto size = kHeaderSize + kSlotCount * kSlotHeaderSize
+                    + kSlotCount * static_cast<qsizetype>(kRingCapacity);
+  if (!m_memory.create(size))
+  {
+    if (m_memory.error() != QSharedMemory::AlreadyExists || !m_memory.attach()
+        || m_memory.size() < size)
+    {
+      qWarning() << "Cannot create plugin shared memory:"
+                 << m_memory.errorString();
+      m_memory.detach();
+      return false;
+    }
+  }
+
+  // Write the segment header
+  auto *data = static_cast<char *>(m_memory.data());
+  std::memset(data, 0, kHeaderSize + kSlotCount * kSlotHeaderSize);
+
+  const quint32 slotCount = kSlotCount;
+  std::memcpy(data, "SSPLUGSH", 8);
+  std::memcpy(data + 8, &kFormatVersion, sizeof(quint32));
+  std::memcpy(data + 12, &slotCount, sizeof(quint32));
+  std::memcpy(data + 16, &kRingCapacity, sizeof(quint64));
+
+  // Initialize the slot control blocks
+  for (int i = 0; i < kSlotCount; ++i)
+    new (data + kHeaderSize + i * kSlotHeaderSize) SlotHeader{};
+
+  m_consumers.clear();
+  m_consumers.resize(kSlotCount);
+  return true;
+}
+
+/**
+ * Invalidates the segment header, so that consumers know that the server is
+ * gone, and releases the shared segment.
+ */
+void Plugins::SharedMemory::close()
+{
+  if (isOpen())
+  {
+    std::memset(m_memory.data(), 0, 8);
+    m_memory.detach();
+  }
+
+  m_consumers.clear();
+}
+
+/**
+ * @brief Sends a batch of binary frame messages to every attached consumer.
+ *
+ * The schema of the first frame is sent first to consumers that did not
+ * receive it yet. If the ring of a consumer is full, the messages are dropped
+ * for that consumer only.
+ *
+ * @param firstSchema   Schema message of the first frame of the batch.
+ * @param firstSchemaId Id of the schema of the first frame of the batch.
+ * @param frames        Encoded frame (and inline schema) messages.
+ * @param lastSchemaId  Id of the schema of the last frame of the batch.
+ */
+void Plugins::SharedMemory::sendFrames(const QByteArray &firstSchema,
+                                       const quint64 firstSchemaId,
+                                       const QByteArray &frames,
+                                       const quint64 lastSchemaId)
+{
+  if (!isOpen())
+    return;
+
+  for (int i = 0; i < kSlotCount; ++i)
+  {
+    if (!attached(i))
+      continue;
+
+    auto &consumer = m_consumers[i];
+    if (consumer.schemaId != firstSchemaId)
+    {
+      if (!write(i, firstSchema))
+        continue;
+
+      consumer.schemaId = firstSchemaId;
+    }
+
+    if (write(i, frames))
+      consumer.schemaId = lastSchemaId;
+  }
+}
+
+/**
+ * Sends the given binary raw data @a message to every attached consumer
+ */
+void Plugins::SharedMemory::sendRawData(const QByteArray &message)
+{
+  if (!isOpen())
+    return;
+
+  for (int i = 0; i < kSlotCount; ++i)
+  {
+    if (attached(i))
+      (void)write(i, message);
+  }
+}
+
+/**
+ * Returns the control block of the slot with the given @a index
+ */
+Plugins::SharedMemory::SlotHeader *
+Plugins::SharedMemory::slot(const int index) const
+{
+  auto *data = static_cast<char *>(const_cast<void *>(m_memory.constData()));
+  return reinterpret_cast<SlotHeader *>(data + kHeaderSize
+                                        + index * kSlotHeaderSize);
+}
+
+/**
+ * @brief Checks if a consumer is attached to the slot with the given @a index.
+ *
+ * Detects consumers that attached since the last call (so that they receive
+ * the schema again), and releases the slot if its consumer did not read any
+ * data for @c kStaleTimeout milliseconds while its ring was full.
+ */
+bool Plugins::SharedMemory::attached(const int index)
+{
+  auto *header = slot(index);
+  if (header->state.load(std::memory_order_acquire) != 1)
+    return false;
+
+  // New consumer attached
+  auto &consumer = m_consumers[index];
+  const auto generation = header->generation.load(std::memory_order_acquire);
+  if (generation != consumer.generation)
+  {
+    consumer.generation = generation;
+    consumer.schemaId = 0;
+    consumer.lastReadSequence
+        = header->readSequence.load(std::memory_order_acquire);
+    consumer.stalled.invalidate();
+  }
+
+  // Consumer stopped reading, release the slot
+  if (consumer.stalled.isValid() && consumer.stalled.elapsed() > kStaleTimeout)
+  {
+    qWarning() << "Releasing stalled shared memory plugin" << index;
+    header->state.store(0, std::memory_order_release);
+    consumer.stalled.invalidate();
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Writes the given @a message to the ring of the slot with the given
+ *        @a index.
+ *
+ * @return @c false if the ring does not have enough free space, in which case
+ *         the message is dropped & counted in the control block.
+ */
+bool Plugins::SharedMemory::write(const int index, const QByteArray &message)
+{
+  auto *header = slot(index);
+  auto &consumer = m_consumers[index];
+
+  // Obtain the free space of the ring
+  const auto writeSeq = header->writeSequence.load(std::memory_order_relaxed);
+  const auto readSeq = header->readSequence.load(std::memory_order_acquire);
+  if (readSeq != consumer.lastReadSequence)
+  {
+    consumer.lastReadSequence = readSeq;
+    consumer.stalled.invalidate();
+  }
+
+  // Ring is full, drop the message
+  const auto size = static_cast<quint64>(message.size());
+  if (size > kRingCapacity - (writeSeq - readSeq))
+  {
+    header->dropped.fetch_add(1, std::memory_order_relaxed);
+    if (!consumer.stalled.isValid())
+      consumer.stalled.start();
+
+    return false;
+  }
+
+  // Copy the message, wrapping around the end of the ring
+  auto *ring = static_cast<char *>(m_memory.data()) + kHeaderSize
+               + kSlotCount * kSlotHeaderSize
+               + index * static_cast<qsizetype>(kRingCapacity);
+  const auto offset = writeSeq % kRingCapacity;
+  const auto first = std::min(size, kRingCapacity - offset);
+  std::memcpy(ring + offset, message.constData(), first);
+  std::memcpy(ring, message.constData() + first, size - first);
+
+  // Publish the message
+  header->writeSequence.store(writeSeq + size, std::memory_order_release);
+  return true;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QByteArray>
+#include <QSharedMemory>
+#include <QElapsedTimer>
+
+/**
+ * Key of the shared memory segment used by local plugins, consumers obtain
+ * the native key with @c QSharedMemory::platformSafeKey().
+ */
+#define PLUGINS_SHM_KEY "SerialStudio.Plugins"
+
+namespace Plugins
+{
+/**
+ * @brief The SharedMemory class
+ *
+ * Shared-memory transport for plugins running on the same computer. It sends
+ * the same binary messages as the TCP binary protocol (a @c quint32 byte count
+ * followed by a CBOR map, see @c Plugins::ServerWorker), but without the
+ * overhead of the TCP loopback interface: local analytics processes can read
+ * frames at full wire rate with a single copy.
+ *
+ * The segment starts with a header (the @c "SSPLUGSH" magic, a @c quint32
+ * format version, the @c quint32 number of consumer slots and the @c quint64
+ * ring capacity of each slot), followed by one 64-byte control block per slot
+ * and by the ring buffer of each slot. All integers are stored in the native
+ * byte order of the computer. Each control block contains:
+ *
+ * - @c quint32 state: 0 if the slot is free, 1 if a consumer is attached.
+ * - @c quint32 generation: incremented by each consumer that attaches.
+ * - @c quint64 write sequence: total number of bytes written by the server.
+ * - @c quint64 read sequence: total number of bytes read by the consumer.
+ * - @c quint64 number of messages dropped because the ring was full.
+ *
+ * Each slot is a single-producer/single-consumer byte ring: the byte with
+ * sequence number @c n is stored at offset @c n modulo the ring capacity, and
+ * messages may wrap around the end of the ring. To attach, a consumer atomically
+ * changes the state of a free slot from 0 to 1, sets its read sequence to the
+ * write sequence and increments the generation. The server then sends the
+ * current schema before any frame. To detach, the consumer sets the state back
+ * to 0. Slots whose consumer does not read any data for a while (e.g. because
+ * it crashed) are released automatically.
+ */
+class SharedMemory
+{
+public:
+  SharedMemory();
+  ~SharedMemory();
+
+  [[nodiscard]] bool isOpen() const;
+  [[nodiscard]] bool hasConsumers() const;
+
+  bool open();
+  void close();
+
+  void sendFrames(const QByteArray &firstSchema, const quint64 firstSchemaId,
+                  const QByteArray &frames, const quint64 lastSchemaId);
+  void sendRawData(const QByteArray &message);
+
+private:
+  struct SlotHeader;
+
+  /**
+   * @brief Server-side state of a consumer slot.
+   */
+  struct ConsumerState
+  {
+    quint32 generation = 0;
+    quint64 schemaId = 0;
+    quint64 lastReadSequence = 0;
+    QElapsedTimer stalled;
+  };
+
+  [[nodiscard]] SlotHeader *slot(const int index) const;
+  [[nodiscard]] bool attached(const int index);
+  bool write(const int index, const QByteArray &message);
+
+private:
+  QSharedMemory m_memory;
+  QVector<ConsumerState> m_consumers;
+};
+} // namespace Plugins
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QtEndian>
+#include <QCborArray>
+#include <QCborValue>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include "IO/Manager.h"
+#include "Plugins/Viewer.h"
+#include "Plugins/ServerWorker.h"
+#include "JSON/FrameBuilder.h"
+
+#include "Misc/Utilities.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Maximum size of a binary message sent by the node, larger messages are
+ * treated as a protocol error
+ */
+static constexpr quint32 kMaxMessageSize = 64 * 1024 * 1024;
+
+/**
+ * Constructor function, restores the address of the last node
+ */
+Plugins::Viewer::Viewer()
+  : m_handshakeDone(false)
+  , m_schemaId(0)
+{
+  // Restore the address of the node
+  m_host = m_settings.value("viewer_host", "127.0.0.1").toString();
+  m_port = static_cast<quint16>(
+      m_settings.value("viewer_port", PLUGINS_TCP_PORT).toUInt());
+
+  // Configure the socket
+  m_socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+  connect(&m_socket, &QTcpSocket::connected, this,
+          &Plugins::Viewer::onConnected);
+  connect(&m_socket, &QTcpSocket::readyRead, this,
+          &Plugins::Viewer::onReadyRead);
+  connect(&m_socket, &QTcpSocket::disconnected, this,
+          &Plugins::Viewer::onDisconnected);
+  connect(&m_socket, &QTcpSocket::errorOccurred, this,
+          &Plugins::Viewer::onErrorOccurred);
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+Plugins::Viewer &Plugins::Viewer::instance()
+{
+  static Viewer singleton;
+  return singleton;
+}
+
+/**
+ * Returns the TCP port of the plugin server of the node
+ */
+quint16 Plugins::Viewer::port() const
+{
+  return m_port;
+}
+
+/**
+ * Returns the address of the node
+ */
+QString Plugins::Viewer::host() const
+{
+  return m_host;
+}
+
+/**
+ * Returns the default TCP port of the plugin server
+ */
+quint16 Plugins::Viewer::defaultPort() const
+{
+  return PLUGINS_TCP_PORT;
+}
+
+/**
+ * Returns @c true if the viewer is connected to a node
+ */
+bool Plugins::Viewer::isConnectedToHost() const
+{
+  return m_socket.state() == QAbstractSocket::ConnectedState;
+}
+
+/**
+ * Connects to the node, disconnecting the local device first so that the
+ * dashboard only shows the frames of the node.
+ */
+void Plugins::Viewer::connectToHost()
+{
+  if (m_socket.state() != QAbstractSocket::UnconnectedState)
+    return;
+
+  if (IO::Manager::instance().connected())
+    IO::Manager::instance().disconnectDevice();
+
+  m_socket.connectToHost(m_host, m_port);
+}
+
+/**
+ * Connects to the node or disconnects from it
+ */
+void Plugins::Viewer::toggleConnection()
+{
+  if (m_socket.state() == QAbstractSocket::UnconnectedState)
+    connectToHost();
+  else
+    disconnectFromHost();
+}
+
+/**
+ * Closes the connection with the node
+ */
+void Plugins::Viewer::disconnectFromHost()
+{
+  m_socket.abort();
+}
+
+/**
+ * Disconnects from the node when a local device is connected, and updates
+ * the subscription when the refresh rate of the dashboard changes.
+ */
+void Plugins::Viewer::setupExternalConnections()
+{
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this,
+          [=] {
+            if (IO::Manager::instance().connected())
+              disconnectFromHost();
+          });
+  connect(&Misc::TimerEvents::instance(),
+          &Misc::TimerEvents::effectiveUiRefreshRateChanged, this,
+          &Plugins::Viewer::sendSubscription);
+}
+
+/**
+ * Changes the TCP port of the plugin server of the node
+ */
+void Plugins::Viewer::setPort(const quint16 port)
+{
+  if (m_port == port)
+    return;
+
+  m_port = port;
+  m_settings.setValue("viewer_port", port);
+  Q_EMIT portChanged();
+}
+
+/**
+ * Changes the address of the node
+ */
+void Plugins::Viewer::setHost(const QString &host)
+{
+  if (m_host == host)
+    return;
+
+  m_host = host;
+  m_settings.setValue("viewer_host", host);
+  Q_EMIT hostChanged();
+}
+
+/**
+ * Switches the connection to the binary protocol & subscribes to the frames
+ * of the node.
+ */
+void Plugins::Viewer::onConnected()
+{
+  m_buffer.clear();
+  m_handshakeDone = false;
+  m_socket.write(PLUGINS_BINARY_HANDSHAKE);
+  sendSubscription();
+  Q_EMIT connectedChanged();
+}
+
+/**
+ * Reads the binary messages sent by the node. Every byte received before the
+ * handshake is echoed by the node belongs to the JSON protocol & is discarded.
+ */
+void Plugins::Viewer::onReadyRead()
+{
+  m_buffer.append(m_socket.readAll());
+
+  // Wait for the node to switch to the binary protocol
+  if (!m_handshakeDone)
+  {
+    static const QByteArray handshake(PLUGINS_BINARY_HANDSHAKE);
+    const auto index = m_buffer.indexOf(handshake);
+    if (index < 0)
+    {
+      if (m_buffer.size() > handshake.size())
+        m_buffer.remove(0, m_buffer.size() - handshake.size());
+
+      return;
+    }
+
+    m_handshakeDone = true;
+    m_buffer.remove(0, index + handshake.size());
+  }
+
+  // Process every complete message
+  qsizetype offset = 0;
+  constexpr auto header = static_cast<qsizetype>(sizeof(quint32));
+  while (m_buffer.size() - offset >= header)
+  {
+    const auto size = qFromLittleEndian<quint32>(m_buffer.constData() + offset);
+    if (size > kMaxMessageSize)
+    {
+      qWarning() << "Invalid message received from remote node";
+      disconnectFromHost();
+      return;
+    }
+
+    if (m_buffer.size() - offset - header < static_cast<qsizetype>(size))
+      break;
+
+    processMessage(m_buffer.mid(offset + header, size));
+    offset += header + size;
+  }
+
+  m_buffer.remove(0, offset);
+}
+
+/**
+ * Clears the frame of the node once the connection is closed
+ */
+void Plugins::Viewer::onDisconnected()
+{
+  m_schemaId = 0;
+  m_slots.clear();
+  m_frame.clear();
+  m_buffer.clear();
+  m_handshakeDone = false;
+  Q_EMIT connectedChanged();
+}
+
+/**
+ * @brief Requests the frames of the node at the refresh rate of the
+ *        dashboard.
+ *
+ * Raw data is not requested, and only the values that changed since the
+ * previous frame are sent by the node.
+ */
+void Plugins::Viewer::sendSubscription()
+{
+  if (!isConnectedToHost())
+    return;
+
+  QJsonObject object;
+  object.insert(QStringLiteral("raw"), false);
+  object.insert(QStringLiteral("delta"), true);
+  object.insert(QStringLiteral("rate"),
+                Misc::TimerEvents::instance().effectiveUiRefreshRate());
+
+  QByteArray message(PLUGINS_SUBSCRIBE_COMMAND);
+  message.append(QJsonDocument(object).toJson(QJsonDocument::Compact));
+  message.append('\n');
+  m_socket.write(message);
+}
+
+/**
+ * Closes the connection & displays the given socket error in a message box
+ */
+void Plugins::Viewer::onErrorOccurred(
+    const QAbstractSocket::SocketError socketError)
+{
+  Q_UNUSED(socketError);
+
+  const auto error = m_socket.errorString();
+  disconnectFromHost();
+  Misc::Utilities::showMessageBox(tr("Remote node connection error"), error);
+}
+
+/**
+ * Handles the given CBOR @a payload of a binary message, messages other than
+ * schemas & frames (e.g. statistics) are ignored.
+ */
+void Plugins::Viewer::processMessage(const QByteArray &payload)
+{
+  const auto message = QCborValue::fromCbor(payload).toMap();
+  const auto type = message.value(QLatin1StringView("type")).toString();
+  if (type == QLatin1StringView("schema"))
+    readSchema(message);
+  else if (type == QLatin1StringView("frames"))
+    readFrames(message);
+}
+
+/**
+ * @brief Rebuilds the local frame from the schema sent by the node.
+ *
+ * The slot table maps each dataset slot of the schema (counting the datasets
+ * of each group in order) to its group & dataset in the local frame.
+ */
+void Plugins::Viewer::readSchema(const QCborMap &message)
+{
+  m_slots.clear();
+  m_schemaId = 0;
+
+  const auto frame = message.value(QLatin1StringView("frame"));
+  if (!m_frame.read(frame.toJsonValue().toObject()))
+  {
+    qWarning() << "Invalid schema received from remote node";
+    return;
+  }
+
+  const auto &groups = m_frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    for (int d = 0; d < groups[g].datasetCount(); ++d)
+      m_slots.append(DatasetSlot{g, d});
+  }
+
+  m_schemaId = message.value(QLatin1StringView("id")).toInteger();
+}
+
+/**
+ * @brief Applies the values of each frame sent by the node to the local frame
+ *        & publishes it.
+ *
+ * Each frame is a flat array of @c [slot, value...] pairs that only lists the
+ * values that changed, frames that use an unknown schema are ignored.
+ */
+void Plugins::Viewer::readFrames(const QCborMap &message)
+{
+  // Ignore frames until the matching schema is received
+  const auto id = message.value(QLatin1StringView("schema")).toInteger();
+  if (m_schemaId == 0 || static_cast<quint64>(id) != m_schemaId)
+    return;
+
+  // Apply the changed values of each frame
+  auto &builder = JSON::FrameBuilder::instance();
+  const auto frames = message.value(QLatin1StringView("frames")).toArray();
+  for (const auto &frame : frames)
+  {
+    const auto values = frame.toArray();
+    for (qsizetype i = 0; i + 1 < values.size(); i += 2)
+    {
+      const auto slot = values.at(i).toInteger(-1);
+      if (slot < 0 || slot >= m_slots.count())
+        continue;
+
+      const auto &position = m_slots[slot];
+      auto &group = m_frame.m_groups[position.group];
+      auto &dataset = group.m_datasets[position.dataset];
+
+      bool changed;
+      const auto value = values.at(i + 1);
+      if (value.isString())
+        changed = dataset.setValue(value.toString());
+      else
+        changed = dataset.setNumericValue(value.toDouble());
+
+      if (changed)
+        group.m_valueGeneration = dataset.valueGeneration();
+    }
+
+    builder.readFrame(m_frame, Misc::SessionClock::now());
+  }
+}
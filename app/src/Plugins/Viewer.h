@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QCborMap>
+#include <QSettings>
+#include <QTcpSocket>
+#include <QByteArray>
+
+#include "JSON/Frame.h"
+
+namespace Plugins
+{
+/**
+ * @brief The Viewer class
+ *
+ * Turns Serial Studio into a thin client of another Serial Studio instance
+ * (e.g. a headless acquisition node started with @c --plugins), which runs the
+ * complete @c IO::Manager & @c JSON::FrameBuilder pipeline next to the device.
+ *
+ * The viewer connects to the plugin server of the node, switches to the
+ * binary protocol & requests a delta subscription (see
+ * @c Plugins::ServerWorker) limited to the refresh rate of the dashboard.
+ * The node then sends the frame schema once, followed by frames that only
+ * list the values that changed. The values are applied to a local copy of
+ * the frame, which is published through @c JSON::FrameBuilder::readFrame(),
+ * so the dashboard works exactly as with a local device.
+ */
+class Viewer : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(QString host
+             READ host
+             WRITE setHost
+             NOTIFY hostChanged)
+  Q_PROPERTY(quint16 port
+             READ port
+             WRITE setPort
+             NOTIFY portChanged)
+  Q_PROPERTY(bool isConnectedToHost
+             READ isConnectedToHost
+             NOTIFY connectedChanged)
+  Q_PROPERTY(quint16 defaultPort
+             READ defaultPort
+             CONSTANT)
+  // clang-format on
+
+signals:
+  void hostChanged();
+  void portChanged();
+  void connectedChanged();
+
+private:
+  explicit Viewer();
+  Viewer(Viewer &&) = delete;
+  Viewer(const Viewer &) = delete;
+  Viewer &operator=(Viewer &&) = delete;
+  Viewer &operator=(const Viewer &) = delete;
+
+public:
+  static Viewer &instance();
+
+  [[nodiscard]] quint16 port() const;
+  [[nodiscard]] QString host() const;
+  [[nodiscard]] quint16 defaultPort() const;
+  [[nodiscard]] bool isConnectedToHost() const;
+
+public slots:
+  void connectToHost();
+  void toggleConnection();
+  void disconnectFromHost();
+  void setupExternalConnections();
+  void setPort(const quint16 port);
+  void setHost(const QString &host);
+
+private slots:
+  void onConnected();
+  void onReadyRead();
+  void onDisconnected();
+  void sendSubscription();
+  void onErrorOccurred(const QAbstractSocket::SocketError socketError);
+
+private:
+  void processMessage(const QByteArray &payload);
+  void readSchema(const QCborMap &message);
+  void readFrames(const QCborMap &message);
+
+private:
+  /**
+   * @brief Position of a dataset slot of the schema in the local frame.
+   */
+  struct DatasetSlot
+  {
+    int group;
+    int dataset;
+  };
+
+  bool m_handshakeDone;
+
+  QString m_host;
+  quint16 m_port;
+  quint64 m_schemaId;
+
+  JSON::Frame m_frame;
+  QVector<DatasetSlot> m_slots;
+
+  QByteArray m_buffer;
+  QSettings m_settings;
+  QTcpSocket m_socket;
+};
+} // namespace Plugins
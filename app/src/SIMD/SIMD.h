@@ -23,10 +23,15 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <algorithm>
+#include <type_traits>
 
 #include <QVector>
 #include <QPointF>
+#include <QByteArray>
+#include <QStringView>
+#include <QByteArrayView>
 
 #ifdef _WIN32
 #  include <cmath>
@@ -36,6 +41,19 @@
 #  include <x86/sse2.h>
 #endif
 
+#if defined(CPU_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#  include <immintrin.h>
+#  define SIMD_RUNTIME_DISPATCH
+#  define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#  define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(CPU_X86_64) && defined(_MSC_VER)
+#  include <intrin.h>
+#  include <immintrin.h>
+#  define SIMD_RUNTIME_DISPATCH
+#  define SIMD_TARGET_AVX2
+#  define SIMD_TARGET_AVX512
+#endif
+
 #if defined(CPU_ARM64)
 #  include <arm/sve.h>
 #  include <arm/neon.h>
@@ -43,6 +61,679 @@
 
 namespace SIMD
 {
+//------------------------------------------------------------------------------
+// Runtime CPU dispatch
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Instruction set extensions that the x86-64 kernels can use.
+ *
+ * The application is built for the SSE2 baseline of x86-64, so that a single
+ * binary runs on every machine. Wider AVX2 & AVX-512 variants of the hot
+ * kernels are compiled next to the SSE2 code (with per-function target
+ * attributes) and are selected at runtime with @c isa().
+ */
+enum class Isa
+{
+  SSE2,
+  AVX2,
+  AVX512
+};
+
+/**
+ * @brief Detects the widest instruction set supported by the CPU & the OS.
+ *
+ * The detection runs once, the result is cached for the lifetime of the
+ * application. ARM64 builds always report @c Isa::SSE2, since NEON is part of
+ * the ARM64 baseline and its kernels are selected at compile time.
+ *
+ * @return The instruction set used by the dispatched kernels.
+ */
+inline Isa isa()
+{
+  static const Isa level = [] {
+#if defined(SIMD_RUNTIME_DISPATCH) && defined(_MSC_VER)
+    // Query the CPU features
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+      return Isa::SSE2;
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512 = (info[1] & (1 << 16)) != 0;
+    if (!osxsave)
+      return Isa::SSE2;
+
+    // Check that the OS saves the AVX & AVX-512 registers
+    const auto xcr0 = _xgetbv(0);
+    if (avx512 && (xcr0 & 0xE6) == 0xE6)
+      return Isa::AVX512;
+
+    if (avx2 && (xcr0 & 0x06) == 0x06)
+      return Isa::AVX2;
+
+#elif defined(SIMD_RUNTIME_DISPATCH)
+    // The compiler runtime checks both the CPU & the OS support
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return Isa::AVX512;
+
+    if (__builtin_cpu_supports("avx2"))
+      return Isa::AVX2;
+
+#endif
+
+    return Isa::SSE2;
+  }();
+
+  return level;
+}
+
+#if defined(SIMD_RUNTIME_DISPATCH)
+/**
+ * @brief AVX2 kernels (four double or eight float lanes per register).
+ *
+ * Each kernel processes the largest prefix of the data that fits in whole
+ * registers and returns its length, the caller handles the remaining
+ * elements with its SSE2 & scalar loops.
+ */
+namespace Avx2
+{
+SIMD_TARGET_AVX2 inline size_t fill(double *data, size_t count, double value)
+{
+  size_t i = 0;
+  const auto fillValue = _mm256_set1_pd(value);
+  for (; i + 4 <= count; i += 4)
+    _mm256_storeu_pd(data + i, fillValue);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t fill(float *data, size_t count, float value)
+{
+  size_t i = 0;
+  const auto fillValue = _mm256_set1_ps(value);
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, fillValue);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t shift(double *data, size_t count)
+{
+  size_t i = 0;
+  for (; i + 4 < count; i += 4)
+    _mm256_storeu_pd(data + i, _mm256_loadu_pd(data + i + 1));
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t shift(float *data, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 < count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_loadu_ps(data + i + 1));
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t findMin(const double *data, size_t count,
+                                       double &minVal)
+{
+  size_t i = 0;
+  auto minVec = _mm256_set1_pd(minVal);
+  for (; i + 4 <= count; i += 4)
+    minVec = _mm256_min_pd(minVec, _mm256_loadu_pd(data + i));
+
+  double buffer[4];
+  _mm256_storeu_pd(buffer, minVec);
+  for (const auto value : buffer)
+    minVal = std::min<double>(minVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t findMin(const float *data, size_t count,
+                                       float &minVal)
+{
+  size_t i = 0;
+  auto minVec = _mm256_set1_ps(minVal);
+  for (; i + 8 <= count; i += 8)
+    minVec = _mm256_min_ps(minVec, _mm256_loadu_ps(data + i));
+
+  float buffer[8];
+  _mm256_storeu_ps(buffer, minVec);
+  for (const auto value : buffer)
+    minVal = std::min<float>(minVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t findMax(const double *data, size_t count,
+                                       double &maxVal)
+{
+  size_t i = 0;
+  auto maxVec = _mm256_set1_pd(maxVal);
+  for (; i + 4 <= count; i += 4)
+    maxVec = _mm256_max_pd(maxVec, _mm256_loadu_pd(data + i));
+
+  double buffer[4];
+  _mm256_storeu_pd(buffer, maxVec);
+  for (const auto value : buffer)
+    maxVal = std::max<double>(maxVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t findMax(const float *data, size_t count,
+                                       float &maxVal)
+{
+  size_t i = 0;
+  auto maxVec = _mm256_set1_ps(maxVal);
+  for (; i + 8 <= count; i += 8)
+    maxVec = _mm256_max_ps(maxVec, _mm256_loadu_ps(data + i));
+
+  float buffer[8];
+  _mm256_storeu_ps(buffer, maxVec);
+  for (const auto value : buffer)
+    maxVal = std::max<float>(maxVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t powerSpectrum(const float *re, const float *im,
+                                             float *output, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const auto r = _mm256_loadu_ps(re + i);
+    const auto m = _mm256_loadu_ps(im + i);
+    _mm256_storeu_ps(output + i,
+                     _mm256_add_ps(_mm256_mul_ps(r, r), _mm256_mul_ps(m, m)));
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t biquad(double *x, double *z1, double *z2,
+                                      size_t count, double b0, double b1,
+                                      double b2, double a1, double a2)
+{
+  // Multiply & add separately (no FMA), so results match the SSE2 kernel
+  size_t i = 0;
+  const auto vb0 = _mm256_set1_pd(b0);
+  const auto vb1 = _mm256_set1_pd(b1);
+  const auto vb2 = _mm256_set1_pd(b2);
+  const auto va1 = _mm256_set1_pd(a1);
+  const auto va2 = _mm256_set1_pd(a2);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto vx = _mm256_loadu_pd(x + i);
+    const auto vz1 = _mm256_loadu_pd(z1 + i);
+    const auto vz2 = _mm256_loadu_pd(z2 + i);
+    const auto y = _mm256_add_pd(_mm256_mul_pd(vb0, vx), vz1);
+    const auto n1 = _mm256_add_pd(
+        _mm256_sub_pd(_mm256_mul_pd(vb1, vx), _mm256_mul_pd(va1, y)), vz2);
+    const auto n2
+        = _mm256_sub_pd(_mm256_mul_pd(vb2, vx), _mm256_mul_pd(va2, y));
+    _mm256_storeu_pd(x + i, y);
+    _mm256_storeu_pd(z1 + i, n1);
+    _mm256_storeu_pd(z2 + i, n2);
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t compareGreaterEqual(const double *a,
+                                                   const double *b,
+                                                   quint8 *output,
+                                                   size_t count)
+{
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto mask = _mm256_movemask_pd(_mm256_cmp_pd(
+        _mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_GE_OQ));
+    output[i] = mask & 1;
+    output[i + 1] = (mask >> 1) & 1;
+    output[i + 2] = (mask >> 2) & 1;
+    output[i + 3] = (mask >> 3) & 1;
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t welfordAdd(double *mean, double *m2,
+                                          const double *x, size_t count,
+                                          double n)
+{
+  size_t i = 0;
+  const auto vn = _mm256_set1_pd(n);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto vx = _mm256_loadu_pd(x + i);
+    auto vmean = _mm256_loadu_pd(mean + i);
+    const auto delta = _mm256_sub_pd(vx, vmean);
+    vmean = _mm256_add_pd(vmean, _mm256_div_pd(delta, vn));
+    const auto vm2
+        = _mm256_add_pd(_mm256_loadu_pd(m2 + i),
+                        _mm256_mul_pd(delta, _mm256_sub_pd(vx, vmean)));
+    _mm256_storeu_pd(mean + i, vmean);
+    _mm256_storeu_pd(m2 + i, vm2);
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t welfordReplace(double *mean, double *m2,
+                                              const double *x, const double *y,
+                                              size_t count, double n)
+{
+  size_t i = 0;
+  const auto vn = _mm256_set1_pd(n);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto vx = _mm256_loadu_pd(x + i);
+    const auto vy = _mm256_loadu_pd(y + i);
+    const auto previous = _mm256_loadu_pd(mean + i);
+    const auto delta = _mm256_sub_pd(vx, vy);
+    const auto vmean = _mm256_add_pd(previous, _mm256_div_pd(delta, vn));
+    const auto spread = _mm256_add_pd(_mm256_sub_pd(vx, vmean),
+                                      _mm256_sub_pd(vy, previous));
+    const auto vm2 = _mm256_add_pd(_mm256_loadu_pd(m2 + i),
+                                   _mm256_mul_pd(delta, spread));
+    _mm256_storeu_pd(mean + i, vmean);
+    _mm256_storeu_pd(m2 + i, vm2);
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t findRangeY(const QPointF *points, size_t count,
+                                          qreal &minVal, qreal &maxVal)
+{
+  // Each pair of registers holds four points, unpacking keeps the Y lanes
+  size_t i = 0;
+  auto minVec = _mm256_set1_pd(minVal);
+  auto maxVec = _mm256_set1_pd(maxVal);
+  const auto *data = reinterpret_cast<const double *>(points);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto a = _mm256_loadu_pd(data + i * 2);
+    const auto b = _mm256_loadu_pd(data + i * 2 + 4);
+    const auto y = _mm256_unpackhi_pd(a, b);
+    minVec = _mm256_min_pd(minVec, y);
+    maxVec = _mm256_max_pd(maxVec, y);
+  }
+
+  double minBuffer[4];
+  double maxBuffer[4];
+  _mm256_storeu_pd(minBuffer, minVec);
+  _mm256_storeu_pd(maxBuffer, maxVec);
+  for (size_t j = 0; j < 4; ++j)
+  {
+    minVal = std::min<double>(minVal, minBuffer[j]);
+    maxVal = std::max<double>(maxVal, maxBuffer[j]);
+  }
+
+  return i;
+}
+
+template<typename T>
+SIMD_TARGET_AVX2 inline size_t toPoints(const T *data, size_t count,
+                                        QPointF *points, qreal x0, qreal xStep,
+                                        qreal yScale, qreal yOffset)
+{
+  size_t i = 0;
+  const auto vx0 = _mm256_set1_pd(x0);
+  const auto vstep = _mm256_set1_pd(xStep);
+  const auto vscale = _mm256_set1_pd(yScale);
+  const auto voffset = _mm256_set1_pd(yOffset);
+  auto index = _mm256_set_pd(3, 2, 1, 0);
+  auto *output = reinterpret_cast<double *>(points);
+  for (; i + 4 <= count; i += 4)
+  {
+    // Load four samples as doubles
+    __m256d y;
+    if constexpr (std::is_same_v<T, float>)
+      y = _mm256_cvtps_pd(_mm_loadu_ps(data + i));
+    else
+      y = _mm256_loadu_pd(data + i);
+
+    // Transform the coordinates
+    y = _mm256_add_pd(_mm256_mul_pd(y, vscale), voffset);
+    const auto x = _mm256_add_pd(_mm256_mul_pd(index, vstep), vx0);
+    index = _mm256_add_pd(index, _mm256_set1_pd(4));
+
+    // Interleave them as (x, y) pairs
+    const auto lo = _mm256_unpacklo_pd(x, y);
+    const auto hi = _mm256_unpackhi_pd(x, y);
+    _mm256_storeu_pd(output + i * 2, _mm256_permute2f128_pd(lo, hi, 0x20));
+    _mm256_storeu_pd(output + i * 2 + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+  }
+
+  return i;
+}
+} // namespace Avx2
+
+/**
+ * @brief AVX-512 kernels (eight double or sixteen float lanes per register).
+ *
+ * Only the streaming kernels over long arrays (plot & FFT buffers) have an
+ * AVX-512 variant, the per-frame kernels work on a few lanes and use AVX2.
+ */
+namespace Avx512
+{
+SIMD_TARGET_AVX512 inline size_t fill(double *data, size_t count, double value)
+{
+  size_t i = 0;
+  const auto fillValue = _mm512_set1_pd(value);
+  for (; i + 8 <= count; i += 8)
+    _mm512_storeu_pd(data + i, fillValue);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t fill(float *data, size_t count, float value)
+{
+  size_t i = 0;
+  const auto fillValue = _mm512_set1_ps(value);
+  for (; i + 16 <= count; i += 16)
+    _mm512_storeu_ps(data + i, fillValue);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t shift(double *data, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 < count; i += 8)
+    _mm512_storeu_pd(data + i, _mm512_loadu_pd(data + i + 1));
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t shift(float *data, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 < count; i += 16)
+    _mm512_storeu_ps(data + i, _mm512_loadu_ps(data + i + 1));
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t findMin(const double *data, size_t count,
+                                         double &minVal)
+{
+  size_t i = 0;
+  auto minVec = _mm512_set1_pd(minVal);
+  for (; i + 8 <= count; i += 8)
+    minVec = _mm512_min_pd(minVec, _mm512_loadu_pd(data + i));
+
+  double buffer[8];
+  _mm512_storeu_pd(buffer, minVec);
+  for (const auto value : buffer)
+    minVal = std::min<double>(minVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t findMin(const float *data, size_t count,
+                                         float &minVal)
+{
+  size_t i = 0;
+  auto minVec = _mm512_set1_ps(minVal);
+  for (; i + 16 <= count; i += 16)
+    minVec = _mm512_min_ps(minVec, _mm512_loadu_ps(data + i));
+
+  float buffer[16];
+  _mm512_storeu_ps(buffer, minVec);
+  for (const auto value : buffer)
+    minVal = std::min<float>(minVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t findMax(const double *data, size_t count,
+                                         double &maxVal)
+{
+  size_t i = 0;
+  auto maxVec = _mm512_set1_pd(maxVal);
+  for (; i + 8 <= count; i += 8)
+    maxVec = _mm512_max_pd(maxVec, _mm512_loadu_pd(data + i));
+
+  double buffer[8];
+  _mm512_storeu_pd(buffer, maxVec);
+  for (const auto value : buffer)
+    maxVal = std::max<double>(maxVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t findMax(const float *data, size_t count,
+                                         float &maxVal)
+{
+  size_t i = 0;
+  auto maxVec = _mm512_set1_ps(maxVal);
+  for (; i + 16 <= count; i += 16)
+    maxVec = _mm512_max_ps(maxVec, _mm512_loadu_ps(data + i));
+
+  float buffer[16];
+  _mm512_storeu_ps(buffer, maxVec);
+  for (const auto value : buffer)
+    maxVal = std::max<float>(maxVal, value);
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t powerSpectrum(const float *re,
+                                               const float *im, float *output,
+                                               size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const auto r = _mm512_loadu_ps(re + i);
+    const auto m = _mm512_loadu_ps(im + i);
+    _mm512_storeu_ps(output + i,
+                     _mm512_add_ps(_mm512_mul_ps(r, r), _mm512_mul_ps(m, m)));
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t findRangeY(const QPointF *points,
+                                            size_t count, qreal &minVal,
+                                            qreal &maxVal)
+{
+  // Each pair of registers holds eight points, unpacking keeps the Y lanes
+  size_t i = 0;
+  auto minVec = _mm512_set1_pd(minVal);
+  auto maxVec = _mm512_set1_pd(maxVal);
+  const auto *data = reinterpret_cast<const double *>(points);
+  for (; i + 8 <= count; i += 8)
+  {
+    const auto a = _mm512_loadu_pd(data + i * 2);
+    const auto b = _mm512_loadu_pd(data + i * 2 + 8);
+    const auto y = _mm512_unpackhi_pd(a, b);
+    minVec = _mm512_min_pd(minVec, y);
+    maxVec = _mm512_max_pd(maxVec, y);
+  }
+
+  double minBuffer[8];
+  double maxBuffer[8];
+  _mm512_storeu_pd(minBuffer, minVec);
+  _mm512_storeu_pd(maxBuffer, maxVec);
+  for (size_t j = 0; j < 8; ++j)
+  {
+    minVal = std::min<double>(minVal, minBuffer[j]);
+    maxVal = std::max<double>(maxVal, maxBuffer[j]);
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t scatter(const double *values, size_t count,
+                                         double *data, size_t stride)
+{
+  size_t i = 0;
+  const auto s = static_cast<long long>(stride);
+  const auto offsets
+      = _mm512_set_epi64(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+  for (; i + 8 <= count; i += 8)
+  {
+    _mm512_i64scatter_pd(data, offsets, _mm512_loadu_pd(values + i), 8);
+    data += stride * 8;
+  }
+
+  return i;
+}
+
+SIMD_TARGET_AVX512 inline size_t scatter(const double *values, size_t count,
+                                         float *data, size_t stride)
+{
+  size_t i = 0;
+  const auto s = static_cast<long long>(stride);
+  const auto offsets
+      = _mm512_set_epi64(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+  for (; i + 8 <= count; i += 8)
+  {
+    const auto samples = _mm512_cvtpd_ps(_mm512_loadu_pd(values + i));
+    _mm512_i64scatter_ps(data, offsets, samples, 4);
+    data += stride * 8;
+  }
+
+  return i;
+}
+} // namespace Avx512
+#endif
+
+/**
+ * @brief Selects the widest kernel variant supported by the CPU.
+ *
+ * Every function returns the number of leading elements that were processed
+ * by the selected variant, or @c 0 when only SSE2 is available (or when the
+ * compiler does not support runtime dispatch).
+ */
+namespace Dispatch
+{
+#if defined(SIMD_RUNTIME_DISPATCH)
+#  define SIMD_DISPATCH_AVX512(call)                                           \
+    if (isa() == Isa::AVX512)                                                  \
+      return Avx512::call;
+
+#  define SIMD_DISPATCH_AVX2(call)                                             \
+    if (isa() >= Isa::AVX2)                                                    \
+      return Avx2::call;
+#else
+#  define SIMD_DISPATCH_AVX512(call)
+#  define SIMD_DISPATCH_AVX2(call)
+#endif
+
+template<typename T>
+inline size_t fill(T *data, size_t count, T value)
+{
+  SIMD_DISPATCH_AVX512(fill(data, count, value));
+  SIMD_DISPATCH_AVX2(fill(data, count, value));
+  return 0;
+}
+
+template<typename T>
+inline size_t shift(T *data, size_t count)
+{
+  SIMD_DISPATCH_AVX512(shift(data, count));
+  SIMD_DISPATCH_AVX2(shift(data, count));
+  return 0;
+}
+
+template<typename T>
+inline size_t findMin(const T *data, size_t count, T &minVal)
+{
+  SIMD_DISPATCH_AVX512(findMin(data, count, minVal));
+  SIMD_DISPATCH_AVX2(findMin(data, count, minVal));
+  return 0;
+}
+
+template<typename T>
+inline size_t findMax(const T *data, size_t count, T &maxVal)
+{
+  SIMD_DISPATCH_AVX512(findMax(data, count, maxVal));
+  SIMD_DISPATCH_AVX2(findMax(data, count, maxVal));
+  return 0;
+}
+
+inline size_t powerSpectrum(const float *re, const float *im, float *output,
+                            size_t count)
+{
+  SIMD_DISPATCH_AVX512(powerSpectrum(re, im, output, count));
+  SIMD_DISPATCH_AVX2(powerSpectrum(re, im, output, count));
+  return 0;
+}
+
+inline size_t biquad(double *x, double *z1, double *z2, size_t count,
+                     double b0, double b1, double b2, double a1, double a2)
+{
+  SIMD_DISPATCH_AVX2(biquad(x, z1, z2, count, b0, b1, b2, a1, a2));
+  return 0;
+}
+
+inline size_t compareGreaterEqual(const double *a, const double *b,
+                                  quint8 *output, size_t count)
+{
+  SIMD_DISPATCH_AVX2(compareGreaterEqual(a, b, output, count));
+  return 0;
+}
+
+inline size_t welfordAdd(double *mean, double *m2, const double *x,
+                         size_t count, double n)
+{
+  SIMD_DISPATCH_AVX2(welfordAdd(mean, m2, x, count, n));
+  return 0;
+}
+
+inline size_t welfordReplace(double *mean, double *m2, const double *x,
+                             const double *y, size_t count, double n)
+{
+  SIMD_DISPATCH_AVX2(welfordReplace(mean, m2, x, y, count, n));
+  return 0;
+}
+
+inline size_t findRangeY(const QPointF *points, size_t count, qreal &minVal,
+                         qreal &maxVal)
+{
+  SIMD_DISPATCH_AVX512(findRangeY(points, count, minVal, maxVal));
+  SIMD_DISPATCH_AVX2(findRangeY(points, count, minVal, maxVal));
+  return 0;
+}
+
+template<typename T>
+inline size_t toPoints(const T *data, size_t count, QPointF *points, qreal x0,
+                       qreal xStep, qreal yScale, qreal yOffset)
+{
+  SIMD_DISPATCH_AVX2(toPoints(data, count, points, x0, xStep, yScale, yOffset));
+  return 0;
+}
+
+template<typename T>
+inline size_t scatter(const double *values, size_t count, T *data,
+                      size_t stride)
+{
+  SIMD_DISPATCH_AVX512(scatter(values, count, data, stride));
+  return 0;
+}
+
+#undef SIMD_DISPATCH_AVX512
+#undef SIMD_DISPATCH_AVX2
+} // namespace Dispatch
+
+//------------------------------------------------------------------------------
+// Double precision (float64) kernels
+//------------------------------------------------------------------------------
+
 /**
  * @brief Initializes an array with a specific value using SIMD for bulk
  *        operations.
@@ -66,8 +757,8 @@ inline void fill(T *data, size_t count, T value)
   // Use SSE2 for supported Intel/AMD processors
   constexpr auto simdWidth = sizeof(simde__m128d) / sizeof(T);
 
-  // SIMD bulk initialization
-  size_t i = 0;
+  // SIMD bulk initialization, wider registers are used when available
+  size_t i = Dispatch::fill(data, count, value);
   auto fillValue = simde_mm_set1_pd(value);
   for (; i + simdWidth <= count; i += simdWidth)
     simde_mm_storeu_pd(reinterpret_cast<double *>(data + i), fillValue);
@@ -117,12 +808,13 @@ template<typename T>
 inline void shift(T *data, size_t count, T newValue)
 {
 #if defined(CPU_X86_64)
-  // Use AVX2 for supported Intel/AMD processors
+  // Use SSE2 for supported Intel/AMD processors
   constexpr auto simdWidth = sizeof(simde__m128d) / sizeof(T);
 
-  // Shift elements using SIMD operations
-  size_t i = 0;
-  for (; i + simdWidth <= count; i += simdWidth)
+  // Shift elements using SIMD operations, reading one element ahead of each
+  // store, wider registers are used when available
+  size_t i = Dispatch::shift(data, count);
+  for (; i + simdWidth < count; i += simdWidth)
   {
     auto next
         = simde_mm_loadu_pd(reinterpret_cast<const double *>(data + i + 1));
@@ -142,8 +834,9 @@ inline void shift(T *data, size_t count, T newValue)
   auto pg = simde_svptrue_b64();
   const auto simdWidth = simde_svcntd();
 
-  // Shift elements using SIMD operations
-  for (; i + simdWidth <= count; i += simdWidth)
+  // Shift elements using SIMD operations, reading one element ahead of each
+  // store
+  for (; i + simdWidth < count; i += simdWidth)
   {
     auto next = simde_svld1_f64(pg, data + i + 1);
     simde_svst1_f64(pg, data + i, next);
@@ -186,9 +879,10 @@ inline T findMin(const T *data, size_t count)
   // Use SSE2 for supported Intel/AMD processors
   constexpr auto simdWidth = sizeof(simde__m128d) / sizeof(T);
 
-  // SIMD comparisons
-  size_t i = 0;
-  auto minVec = simde_mm_set1_pd(data[0]);
+  // SIMD comparisons, wider registers are used when available
+  T minVal = data[0];
+  size_t i = Dispatch::findMin(data, count, minVal);
+  auto minVec = simde_mm_set1_pd(minVal);
   for (; i + simdWidth <= count; i += simdWidth)
   {
     auto values = simde_mm_loadu_pd(&data[i]);
@@ -196,7 +890,6 @@ inline T findMin(const T *data, size_t count)
   }
 
   // Reduce SIMD register to scalar
-  T minVal = data[0];
   std::vector<T> buffer(simdWidth); // Replace VLAs with std::vector
   simde_mm_storeu_pd(buffer.data(), minVec);
   for (size_t j = 0; j < simdWidth; ++j)
@@ -264,9 +957,10 @@ inline T findMax(const T *data, size_t count)
   // Use SSE2 for supported Intel/AMD processors
   constexpr auto simdWidth = sizeof(simde__m128d) / sizeof(T);
 
-  // SIMD comparisons
-  size_t i = 0;
-  auto maxVec = simde_mm_set1_pd(data[0]);
+  // SIMD comparisons, wider registers are used when available
+  T maxVal = data[0];
+  size_t i = Dispatch::findMax(data, count, maxVal);
+  auto maxVec = simde_mm_set1_pd(maxVal);
   for (; i + simdWidth <= count; i += simdWidth)
   {
     auto values = simde_mm_loadu_pd(&data[i]);
@@ -274,7 +968,6 @@ inline T findMax(const T *data, size_t count)
   }
 
   // Reduce SIMD register to scalar
-  T maxVal = data[0];
   std::vector<T> buffer(simdWidth);
   simde_mm_storeu_pd(buffer.data(), maxVec);
   for (size_t j = 0; j < simdWidth; ++j)
@@ -480,4 +1173,1372 @@ inline qreal findMax(const QVector<QPointF> &data, Extractor extractor)
 
   return maxVal;
 }
+
+//------------------------------------------------------------------------------
+// Strided & multi-array kernels
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the lowest & highest Y coordinate of a series of points.
+ *
+ * Unlike the extractor-based @c findMin() and @c findMax(), the points are
+ * loaded directly as interleaved (x, y) pairs and the Y lanes are separated
+ * with unpack (or de-interleaving load) instructions, so that both extremes
+ * are found in a single vectorized pass.
+ *
+ * @param points Pointer to the points.
+ * @param count The number of points, the outputs are set to 0 if it is 0.
+ * @param minVal Receives the lowest Y coordinate.
+ * @param maxVal Receives the highest Y coordinate.
+ */
+inline void findRangeY(const QPointF *points, size_t count, qreal &minVal,
+                       qreal &maxVal)
+{
+  minVal = 0;
+  maxVal = 0;
+  if (count == 0)
+    return;
+
+  size_t i = 0;
+  minVal = points[0].y();
+  maxVal = minVal;
+
+#if defined(CPU_X86_64)
+  // SSE2 comparisons, wider registers are used when available
+  i = Dispatch::findRangeY(points, count, minVal, maxVal);
+  auto minVec = simde_mm_set1_pd(minVal);
+  auto maxVec = simde_mm_set1_pd(maxVal);
+  const auto *data = reinterpret_cast<const double *>(points);
+  for (; i + 2 <= count; i += 2)
+  {
+    const auto y = simde_mm_unpackhi_pd(simde_mm_loadu_pd(data + i * 2),
+                                        simde_mm_loadu_pd(data + i * 2 + 2));
+    minVec = simde_mm_min_pd(minVec, y);
+    maxVec = simde_mm_max_pd(maxVec, y);
+  }
+
+  // Reduce SIMD registers to scalars
+  double minBuffer[2];
+  double maxBuffer[2];
+  simde_mm_storeu_pd(minBuffer, minVec);
+  simde_mm_storeu_pd(maxBuffer, maxVec);
+  for (size_t j = 0; j < 2; ++j)
+  {
+    minVal = std::min<qreal>(minVal, minBuffer[j]);
+    maxVal = std::max<qreal>(maxVal, maxBuffer[j]);
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON de-interleaving loads
+  auto minVec = simde_vdupq_n_f64(minVal);
+  auto maxVec = simde_vdupq_n_f64(maxVal);
+  const auto *data = reinterpret_cast<const double *>(points);
+  for (; i + 2 <= count; i += 2)
+  {
+    const auto pairs = simde_vld2q_f64(data + i * 2);
+    minVec = simde_vminq_f64(minVec, pairs.val[1]);
+    maxVec = simde_vmaxq_f64(maxVec, pairs.val[1]);
+  }
+
+  // Reduce SIMD registers to scalars
+  minVal = std::min<qreal>(minVal, simde_vminvq_f64(minVec));
+  maxVal = std::max<qreal>(maxVal, simde_vmaxvq_f64(maxVec));
+
+#endif
+
+  // Scalar fallback for remaining elements
+  for (; i < count; ++i)
+  {
+    minVal = std::min<qreal>(minVal, points[i].y());
+    maxVal = std::max<qreal>(maxVal, points[i].y());
+  }
+}
+
+/**
+ * @brief Converts an array of samples into a series of points, applying a
+ *        linear transform to both coordinates.
+ *
+ * The X coordinate of the sample at index @c i is @c x0+i*xStep, and its Y
+ * coordinate is @c sample*yScale+yOffset. The points are written directly as
+ * interleaved (x, y) pairs, which is how plot histories (usually the two
+ * spans of a ring buffer) are turned into chart series.
+ *
+ * @param data Pointer to the samples (double or float).
+ * @param count The number of samples.
+ * @param points Pointer to the array that receives the points.
+ * @param x0 X coordinate of the first sample.
+ * @param xStep Distance between the X coordinates of consecutive samples.
+ * @param yScale Factor applied to each sample.
+ * @param yOffset Offset added to each sample after scaling it.
+ */
+template<typename T>
+inline void toPoints(const T *data, size_t count, QPointF *points,
+                     qreal x0 = 0, qreal xStep = 1, qreal yScale = 1,
+                     qreal yOffset = 0)
+{
+  static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>,
+                "Samples must be double or float values");
+
+  size_t i = 0;
+  auto *output = reinterpret_cast<double *>(points);
+
+#if defined(CPU_X86_64)
+  // SSE2 transform & interleave, wider registers are used when available
+  i = Dispatch::toPoints(data, count, points, x0, xStep, yScale, yOffset);
+  const auto vx0 = simde_mm_set1_pd(x0);
+  const auto vstep = simde_mm_set1_pd(xStep);
+  const auto vscale = simde_mm_set1_pd(yScale);
+  const auto voffset = simde_mm_set1_pd(yOffset);
+  for (; i + 2 <= count; i += 2)
+  {
+    simde__m128d y;
+    if constexpr (std::is_same_v<T, float>)
+      y = simde_mm_cvtps_pd(simde_mm_castsi128_ps(simde_mm_loadl_epi64(
+          reinterpret_cast<const simde__m128i *>(data + i))));
+    else
+      y = simde_mm_loadu_pd(data + i);
+
+    y = simde_mm_add_pd(simde_mm_mul_pd(y, vscale), voffset);
+    const auto index = simde_mm_set_pd(double(i + 1), double(i));
+    const auto x = simde_mm_add_pd(simde_mm_mul_pd(index, vstep), vx0);
+    simde_mm_storeu_pd(output + i * 2, simde_mm_unpacklo_pd(x, y));
+    simde_mm_storeu_pd(output + i * 2 + 2, simde_mm_unpackhi_pd(x, y));
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON transform & interleaving stores
+  const auto vx0 = simde_vdupq_n_f64(x0);
+  const auto vstep = simde_vdupq_n_f64(xStep);
+  const auto vscale = simde_vdupq_n_f64(yScale);
+  const auto voffset = simde_vdupq_n_f64(yOffset);
+  for (; i + 2 <= count; i += 2)
+  {
+    simde_float64x2_t y;
+    if constexpr (std::is_same_v<T, float>)
+      y = simde_vcvt_f64_f32(simde_vld1_f32(data + i));
+    else
+      y = simde_vld1q_f64(data + i);
+
+    const double indexes[2] = {double(i), double(i + 1)};
+    simde_float64x2x2_t pairs;
+    pairs.val[0] = simde_vaddq_f64(
+        simde_vmulq_f64(simde_vld1q_f64(indexes), vstep), vx0);
+    pairs.val[1] = simde_vaddq_f64(simde_vmulq_f64(y, vscale), voffset);
+    simde_vst2q_f64(output + i * 2, pairs);
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+  {
+    output[i * 2] = double(i) * xStep + x0;
+    output[i * 2 + 1] = double(data[i]) * yScale + yOffset;
+  }
+}
+
+/**
+ * @brief Writes one value to each of several ring buffers that are stored
+ *        @a stride elements apart.
+ *
+ * This is how a frame appends one sample to every curve of a group whose
+ * histories share a structure-of-arrays block and a ring head (pass the
+ * address of the head sample of the first curve as @a data). The values are
+ * converted to the sample type of the rings, and written with scatter stores
+ * when AVX-512 is available.
+ *
+ * @param values Pointer to the value of each ring.
+ * @param count The number of rings.
+ * @param data Pointer to the element of the first ring that is replaced.
+ * @param stride The distance (in elements) between consecutive rings.
+ */
+template<typename T>
+inline void scatter(const double *values, size_t count, T *data,
+                    size_t stride)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // AVX-512 scatter stores, when available
+  i = Dispatch::scatter(values, count, data, stride);
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    data[i * stride] = static_cast<T>(values[i]);
+}
+
+//------------------------------------------------------------------------------
+// Single precision (float32) specializations
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes an array of 32-bit floats with a specific value, using
+ *        four float lanes per SIMD register.
+ *
+ * @param data Pointer to the array of values.
+ * @param count The total number of elements in the array.
+ * @param value The value to initialize all elements in the array.
+ */
+template<>
+inline void fill<float>(float *data, size_t count, float value)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 bulk initialization, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128) / sizeof(float);
+  i = Dispatch::fill(data, count, value);
+  auto fillValue = simde_mm_set1_ps(value);
+  for (; i + simdWidth <= count; i += simdWidth)
+    simde_mm_storeu_ps(data + i, fillValue);
+
+#elif defined(CPU_ARM64)
+  // NEON bulk initialization
+  constexpr size_t simdWidth = sizeof(simde_float32x4_t) / sizeof(float);
+  auto fillValue = simde_vdupq_n_f32(value);
+  for (; i + simdWidth <= count; i += simdWidth)
+    simde_vst1q_f32(data + i, fillValue);
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    data[i] = value;
+}
+
+/**
+ * @brief Shifts an array of 32-bit floats to the left and appends a new value,
+ *        using four float lanes per SIMD register.
+ *
+ * @param data Pointer to the array of values.
+ * @param count The total number of elements in the array.
+ * @param newValue The value to set at the last position after the shift.
+ */
+template<>
+inline void shift<float>(float *data, size_t count, float newValue)
+{
+  if (count == 0)
+    return;
+
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 shift, reads one element ahead of each store
+  constexpr size_t simdWidth = sizeof(simde__m128) / sizeof(float);
+  i = Dispatch::shift(data, count);
+  for (; i + simdWidth < count; i += simdWidth)
+    simde_mm_storeu_ps(data + i, simde_mm_loadu_ps(data + i + 1));
+
+#elif defined(CPU_ARM64)
+  // NEON shift, reads one element ahead of each store
+  constexpr size_t simdWidth = sizeof(simde_float32x4_t) / sizeof(float);
+  for (; i + simdWidth < count; i += simdWidth)
+    simde_vst1q_f32(data + i, simde_vld1q_f32(data + i + 1));
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count - 1; ++i)
+    data[i] = data[i + 1];
+
+  // Set the last value of the array
+  data[count - 1] = newValue;
+}
+
+/**
+ * @brief Finds the minimum value in an array of 32-bit floats, using four
+ *        float lanes per SIMD register.
+ *
+ * @param data Pointer to the array of values.
+ * @param count The total number of elements in the array.
+ * @return The minimum value in the array.
+ */
+template<>
+inline float findMin<float>(const float *data, size_t count)
+{
+  if (count == 0)
+    return 0;
+
+  size_t i = 0;
+  float minVal = data[0];
+
+#if defined(CPU_X86_64)
+  // SSE2 comparisons, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128) / sizeof(float);
+  i = Dispatch::findMin(data, count, minVal);
+  auto minVec = simde_mm_set1_ps(minVal);
+  for (; i + simdWidth <= count; i += simdWidth)
+    minVec = simde_mm_min_ps(minVec, simde_mm_loadu_ps(data + i));
+
+  // Reduce SIMD register to scalar
+  float buffer[simdWidth];
+  simde_mm_storeu_ps(buffer, minVec);
+  for (size_t j = 0; j < simdWidth; ++j)
+    minVal = std::min<float>(minVal, buffer[j]);
+
+#elif defined(CPU_ARM64)
+  // NEON comparisons
+  constexpr size_t simdWidth = sizeof(simde_float32x4_t) / sizeof(float);
+  auto minVec = simde_vdupq_n_f32(data[0]);
+  for (; i + simdWidth <= count; i += simdWidth)
+    minVec = simde_vminq_f32(minVec, simde_vld1q_f32(data + i));
+
+  // Reduce SIMD register to scalar
+  float buffer[simdWidth];
+  simde_vst1q_f32(buffer, minVec);
+  for (size_t j = 0; j < simdWidth; ++j)
+    minVal = std::min<float>(minVal, buffer[j]);
+
+#endif
+
+  // Scalar fallback for remaining elements
+  for (; i < count; ++i)
+    minVal = std::min<float>(minVal, data[i]);
+
+  return minVal;
+}
+
+/**
+ * @brief Finds the maximum value in an array of 32-bit floats, using four
+ *        float lanes per SIMD register.
+ *
+ * @param data Pointer to the array of values.
+ * @param count The total number of elements in the array.
+ * @return The maximum value in the array.
+ */
+template<>
+inline float findMax<float>(const float *data, size_t count)
+{
+  if (count == 0)
+    return 0;
+
+  size_t i = 0;
+  float maxVal = data[0];
+
+#if defined(CPU_X86_64)
+  // SSE2 comparisons, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128) / sizeof(float);
+  i = Dispatch::findMax(data, count, maxVal);
+  auto maxVec = simde_mm_set1_ps(maxVal);
+  for (; i + simdWidth <= count; i += simdWidth)
+    maxVec = simde_mm_max_ps(maxVec, simde_mm_loadu_ps(data + i));
+
+  // Reduce SIMD register to scalar
+  float buffer[simdWidth];
+  simde_mm_storeu_ps(buffer, maxVec);
+  for (size_t j = 0; j < simdWidth; ++j)
+    maxVal = std::max<float>(maxVal, buffer[j]);
+
+#elif defined(CPU_ARM64)
+  // NEON comparisons
+  constexpr size_t simdWidth = sizeof(simde_float32x4_t) / sizeof(float);
+  auto maxVec = simde_vdupq_n_f32(data[0]);
+  for (; i + simdWidth <= count; i += simdWidth)
+    maxVec = simde_vmaxq_f32(maxVec, simde_vld1q_f32(data + i));
+
+  // Reduce SIMD register to scalar
+  float buffer[simdWidth];
+  simde_vst1q_f32(buffer, maxVec);
+  for (size_t j = 0; j < simdWidth; ++j)
+    maxVal = std::max<float>(maxVal, buffer[j]);
+
+#endif
+
+  // Scalar fallback for remaining elements
+  for (; i < count; ++i)
+    maxVal = std::max<float>(maxVal, data[i]);
+
+  return maxVal;
+}
+
+/**
+ * @brief Calculates the power (squared magnitude) of each bin of a spectrum
+ *        stored as separate real and imaginary arrays, using four float lanes
+ *        per SIMD register.
+ *
+ * Taking the power instead of the magnitude avoids a square root for every
+ * bin, since the decibel value can be obtained directly with 10 * log10(p).
+ *
+ * @param re Pointer to the real parts of the spectrum.
+ * @param im Pointer to the imaginary parts of the spectrum.
+ * @param output Pointer to the array that receives the power of each bin.
+ * @param count The number of bins in the spectrum.
+ */
+inline void powerSpectrum(const float *re, const float *im, float *output,
+                          size_t count)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 multiply & add, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128) / sizeof(float);
+  i = Dispatch::powerSpectrum(re, im, output, count);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto r = simde_mm_loadu_ps(re + i);
+    const auto m = simde_mm_loadu_ps(im + i);
+    simde_mm_storeu_ps(output + i, simde_mm_add_ps(simde_mm_mul_ps(r, r),
+                                                   simde_mm_mul_ps(m, m)));
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON multiply & add
+  constexpr size_t simdWidth = sizeof(simde_float32x4_t) / sizeof(float);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto r = simde_vld1q_f32(re + i);
+    const auto m = simde_vld1q_f32(im + i);
+    simde_vst1q_f32(output + i, simde_vmlaq_f32(simde_vmulq_f32(r, r), m, m));
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    output[i] = re[i] * re[i] + im[i] * im[i];
+}
+
+/**
+ * @brief Runs one sample of several independent signals through the same
+ *        biquad filter section.
+ *
+ * The section is evaluated in transposed direct form II, where each signal
+ * (lane) has its own pair of state variables. The lanes are stored as
+ * structures of arrays and processed a SIMD register at a time.
+ *
+ * @param x Pointer to the sample of each lane, replaced by the filter output.
+ * @param z1 Pointer to the first state variable of each lane.
+ * @param z2 Pointer to the second state variable of each lane.
+ * @param count The number of lanes.
+ * @param b0 Feed-forward coefficient of the current sample.
+ * @param b1 Feed-forward coefficient of the previous sample.
+ * @param b2 Feed-forward coefficient of the second previous sample.
+ * @param a1 Feedback coefficient of the previous output (normalized).
+ * @param a2 Feedback coefficient of the second previous output (normalized).
+ */
+inline void biquad(double *x, double *z1, double *z2, size_t count, double b0,
+                   double b1, double b2, double a1, double a2)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 implementation, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128d) / sizeof(double);
+  i = Dispatch::biquad(x, z1, z2, count, b0, b1, b2, a1, a2);
+  const auto vb0 = simde_mm_set1_pd(b0);
+  const auto vb1 = simde_mm_set1_pd(b1);
+  const auto vb2 = simde_mm_set1_pd(b2);
+  const auto va1 = simde_mm_set1_pd(a1);
+  const auto va2 = simde_mm_set1_pd(a2);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_mm_loadu_pd(x + i);
+    const auto vz1 = simde_mm_loadu_pd(z1 + i);
+    const auto vz2 = simde_mm_loadu_pd(z2 + i);
+    const auto y = simde_mm_add_pd(simde_mm_mul_pd(vb0, vx), vz1);
+    const auto n1 = simde_mm_add_pd(
+        simde_mm_sub_pd(simde_mm_mul_pd(vb1, vx), simde_mm_mul_pd(va1, y)),
+        vz2);
+    const auto n2
+        = simde_mm_sub_pd(simde_mm_mul_pd(vb2, vx), simde_mm_mul_pd(va2, y));
+    simde_mm_storeu_pd(x + i, y);
+    simde_mm_storeu_pd(z1 + i, n1);
+    simde_mm_storeu_pd(z2 + i, n2);
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON implementation
+  constexpr size_t simdWidth = sizeof(simde_float64x2_t) / sizeof(double);
+  const auto vb0 = simde_vdupq_n_f64(b0);
+  const auto vb1 = simde_vdupq_n_f64(b1);
+  const auto vb2 = simde_vdupq_n_f64(b2);
+  const auto va1 = simde_vdupq_n_f64(a1);
+  const auto va2 = simde_vdupq_n_f64(a2);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_vld1q_f64(x + i);
+    const auto vz1 = simde_vld1q_f64(z1 + i);
+    const auto vz2 = simde_vld1q_f64(z2 + i);
+    const auto y = simde_vaddq_f64(simde_vmulq_f64(vb0, vx), vz1);
+    const auto n1 = simde_vaddq_f64(
+        simde_vsubq_f64(simde_vmulq_f64(vb1, vx), simde_vmulq_f64(va1, y)),
+        vz2);
+    const auto n2
+        = simde_vsubq_f64(simde_vmulq_f64(vb2, vx), simde_vmulq_f64(va2, y));
+    simde_vst1q_f64(x + i, y);
+    simde_vst1q_f64(z1 + i, n1);
+    simde_vst1q_f64(z2 + i, n2);
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+  {
+    const auto y = b0 * x[i] + z1[i];
+    z1[i] = b1 * x[i] - a1 * y + z2[i];
+    z2[i] = b2 * x[i] - a2 * y;
+    x[i] = y;
+  }
+}
+
+/**
+ * @brief Converts signed 16-bit PCM samples to scaled double values.
+ *
+ * Four samples are sign-extended and converted at a time, which is how audio
+ * blocks are turned into dataset values without going through text.
+ *
+ * @param input Pointer to the PCM samples.
+ * @param output Pointer to the array that receives the converted samples.
+ * @param count The number of samples.
+ * @param scale Factor applied to each sample (e.g. @c 1/32768 for [-1, 1)).
+ */
+inline void pcm16ToDouble(const qint16 *input, double *output, size_t count,
+                          double scale)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 sign extension & conversion
+  const auto vscale = simde_mm_set1_pd(scale);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto raw = simde_mm_loadl_epi64(
+        reinterpret_cast<const simde__m128i *>(input + i));
+    const auto pairs = simde_mm_unpacklo_epi16(raw, raw);
+    const auto wide = simde_mm_srai_epi32(pairs, 16);
+    const auto lo = simde_mm_cvtepi32_pd(wide);
+    const auto hi = simde_mm_cvtepi32_pd(simde_mm_srli_si128(wide, 8));
+    simde_mm_storeu_pd(output + i, simde_mm_mul_pd(lo, vscale));
+    simde_mm_storeu_pd(output + i + 2, simde_mm_mul_pd(hi, vscale));
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON sign extension & conversion
+  const auto vscale = simde_vdupq_n_f64(scale);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto wide = simde_vmovl_s16(simde_vld1_s16(input + i));
+    const auto lo = simde_vmovl_s32(simde_vget_low_s32(wide));
+    const auto hi = simde_vmovl_s32(simde_vget_high_s32(wide));
+    simde_vst1q_f64(output + i,
+                    simde_vmulq_f64(simde_vcvtq_f64_s64(lo), vscale));
+    simde_vst1q_f64(output + i + 2,
+                    simde_vmulq_f64(simde_vcvtq_f64_s64(hi), vscale));
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    output[i] = input[i] * scale;
+}
+
+/**
+ * @brief Converts 32-bit floating point PCM samples to scaled double values.
+ *
+ * @param input Pointer to the PCM samples.
+ * @param output Pointer to the array that receives the converted samples.
+ * @param count The number of samples.
+ * @param scale Factor applied to each sample.
+ */
+inline void pcmFloatToDouble(const float *input, double *output, size_t count,
+                             double scale)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 widening of four samples at a time
+  const auto vscale = simde_mm_set1_pd(scale);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto raw = simde_mm_loadu_ps(input + i);
+    const auto lo = simde_mm_cvtps_pd(raw);
+    const auto hi = simde_mm_cvtps_pd(simde_mm_movehl_ps(raw, raw));
+    simde_mm_storeu_pd(output + i, simde_mm_mul_pd(lo, vscale));
+    simde_mm_storeu_pd(output + i + 2, simde_mm_mul_pd(hi, vscale));
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON widening of four samples at a time
+  const auto vscale = simde_vdupq_n_f64(scale);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto raw = simde_vld1q_f32(input + i);
+    const auto lo = simde_vcvt_f64_f32(simde_vget_low_f32(raw));
+    const auto hi = simde_vcvt_high_f64_f32(raw);
+    simde_vst1q_f64(output + i, simde_vmulq_f64(lo, vscale));
+    simde_vst1q_f64(output + i + 2, simde_vmulq_f64(hi, vscale));
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    output[i] = input[i] * scale;
+}
+
+/**
+ * @brief Compares two arrays element by element.
+ *
+ * Stores @c 1 in @a output for each element of @a a that is greater than or
+ * equal to the element of @a b at the same position, and @c 0 otherwise (also
+ * when either of them is NaN). Two elements are compared at a time and their
+ * results are extracted from the comparison mask.
+ *
+ * @param a Pointer to the values to compare.
+ * @param b Pointer to the values to compare against.
+ * @param output Pointer to the array that receives the comparison results.
+ * @param count The number of elements in the arrays.
+ */
+inline void compareGreaterEqual(const double *a, const double *b,
+                                quint8 *output, size_t count)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 comparison & mask extraction, wider registers are used when
+  // available
+  constexpr size_t simdWidth = sizeof(simde__m128d) / sizeof(double);
+  i = Dispatch::compareGreaterEqual(a, b, output, count);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto mask = simde_mm_movemask_pd(
+        simde_mm_cmpge_pd(simde_mm_loadu_pd(a + i), simde_mm_loadu_pd(b + i)));
+    output[i] = mask & 1;
+    output[i + 1] = (mask >> 1) & 1;
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON comparison & lane extraction
+  constexpr size_t simdWidth = sizeof(simde_float64x2_t) / sizeof(double);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto mask
+        = simde_vcgeq_f64(simde_vld1q_f64(a + i), simde_vld1q_f64(b + i));
+    output[i] = simde_vgetq_lane_u64(mask, 0) & 1;
+    output[i + 1] = simde_vgetq_lane_u64(mask, 1) & 1;
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+    output[i] = a[i] >= b[i];
+}
+
+/**
+ * @brief Adds a sample to the running means & sums of squared deviations of
+ *        several independent series, using Welford's algorithm.
+ *
+ * The series are stored as structures of arrays, so that the samples of all
+ * the series are processed a SIMD register at a time.
+ *
+ * @param mean Pointer to the running mean of each series.
+ * @param m2 Pointer to the sum of squared deviations of each series.
+ * @param x Pointer to the new sample of each series.
+ * @param count The number of series.
+ * @param n The number of samples of each series, including the new one.
+ */
+inline void welfordAdd(double *mean, double *m2, const double *x,
+                       size_t count, double n)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 implementation, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128d) / sizeof(double);
+  i = Dispatch::welfordAdd(mean, m2, x, count, n);
+  const auto vn = simde_mm_set1_pd(n);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_mm_loadu_pd(x + i);
+    auto vmean = simde_mm_loadu_pd(mean + i);
+    const auto delta = simde_mm_sub_pd(vx, vmean);
+    vmean = simde_mm_add_pd(vmean, simde_mm_div_pd(delta, vn));
+    const auto vm2 = simde_mm_add_pd(
+        simde_mm_loadu_pd(m2 + i),
+        simde_mm_mul_pd(delta, simde_mm_sub_pd(vx, vmean)));
+    simde_mm_storeu_pd(mean + i, vmean);
+    simde_mm_storeu_pd(m2 + i, vm2);
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON implementation
+  constexpr size_t simdWidth = sizeof(simde_float64x2_t) / sizeof(double);
+  const auto vn = simde_vdupq_n_f64(n);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_vld1q_f64(x + i);
+    auto vmean = simde_vld1q_f64(mean + i);
+    const auto delta = simde_vsubq_f64(vx, vmean);
+    vmean = simde_vaddq_f64(vmean, simde_vdivq_f64(delta, vn));
+    const auto vm2 = simde_vaddq_f64(
+        simde_vld1q_f64(m2 + i),
+        simde_vmulq_f64(delta, simde_vsubq_f64(vx, vmean)));
+    simde_vst1q_f64(mean + i, vmean);
+    simde_vst1q_f64(m2 + i, vm2);
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+  {
+    const auto delta = x[i] - mean[i];
+    mean[i] += delta / n;
+    m2[i] += delta * (x[i] - mean[i]);
+  }
+}
+
+/**
+ * @brief Replaces the oldest sample of a sliding window in the running means
+ *        & sums of squared deviations of several independent series.
+ *
+ * Equivalent to removing the sample @a y and adding the sample @a x with
+ * Welford's algorithm, while the window keeps @a n samples.
+ *
+ * @param mean Pointer to the running mean of each series.
+ * @param m2 Pointer to the sum of squared deviations of each series.
+ * @param x Pointer to the new sample of each series.
+ * @param y Pointer to the sample of each series that leaves the window.
+ * @param count The number of series.
+ * @param n The number of samples in the window.
+ */
+inline void welfordReplace(double *mean, double *m2, const double *x,
+                           const double *y, size_t count, double n)
+{
+  size_t i = 0;
+
+#if defined(CPU_X86_64)
+  // SSE2 implementation, wider registers are used when available
+  constexpr size_t simdWidth = sizeof(simde__m128d) / sizeof(double);
+  i = Dispatch::welfordReplace(mean, m2, x, y, count, n);
+  const auto vn = simde_mm_set1_pd(n);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_mm_loadu_pd(x + i);
+    const auto vy = simde_mm_loadu_pd(y + i);
+    const auto previous = simde_mm_loadu_pd(mean + i);
+    const auto delta = simde_mm_sub_pd(vx, vy);
+    const auto vmean = simde_mm_add_pd(previous, simde_mm_div_pd(delta, vn));
+    const auto spread = simde_mm_add_pd(simde_mm_sub_pd(vx, vmean),
+                                        simde_mm_sub_pd(vy, previous));
+    const auto vm2 = simde_mm_add_pd(simde_mm_loadu_pd(m2 + i),
+                                     simde_mm_mul_pd(delta, spread));
+    simde_mm_storeu_pd(mean + i, vmean);
+    simde_mm_storeu_pd(m2 + i, vm2);
+  }
+
+#elif defined(CPU_ARM64)
+  // NEON implementation
+  constexpr size_t simdWidth = sizeof(simde_float64x2_t) / sizeof(double);
+  const auto vn = simde_vdupq_n_f64(n);
+  for (; i + simdWidth <= count; i += simdWidth)
+  {
+    const auto vx = simde_vld1q_f64(x + i);
+    const auto vy = simde_vld1q_f64(y + i);
+    const auto previous = simde_vld1q_f64(mean + i);
+    const auto delta = simde_vsubq_f64(vx, vy);
+    const auto vmean = simde_vaddq_f64(previous, simde_vdivq_f64(delta, vn));
+    const auto spread = simde_vaddq_f64(simde_vsubq_f64(vx, vmean),
+                                        simde_vsubq_f64(vy, previous));
+    const auto vm2 = simde_vaddq_f64(simde_vld1q_f64(m2 + i),
+                                     simde_vmulq_f64(delta, spread));
+    simde_vst1q_f64(mean + i, vmean);
+    simde_vst1q_f64(m2 + i, vm2);
+  }
+
+#endif
+
+  // Handle remaining elements using a scalar loop
+  for (; i < count; ++i)
+  {
+    const auto previous = mean[i];
+    const auto delta = x[i] - y[i];
+    mean[i] += delta / n;
+    m2[i] += delta * ((x[i] - mean[i]) + (y[i] - previous));
+  }
+}
+
+/**
+ * @brief Precomputed search tables for a set of byte patterns.
+ *
+ * A pattern set stores a list of delimiters (e.g. frame start/end sequences)
+ * together with the distinct first bytes of all patterns. These tables are
+ * built once when the delimiters change, so that the hot search path only
+ * has to scan the data for candidate first bytes and verify the (usually very
+ * short) remainder of each pattern.
+ *
+ * Patterns are kept in the order in which they were given; when several
+ * patterns match at the same position, the earliest one in the list wins.
+ */
+class PatternSet
+{
+public:
+  PatternSet() = default;
+  explicit PatternSet(const QList<QByteArray> &patterns) { set(patterns); }
+
+  /**
+   * @brief Replaces the patterns of the set and rebuilds the search tables.
+   * @param patterns The list of patterns; empty patterns are ignored.
+   */
+  void set(const QList<QByteArray> &patterns)
+  {
+    m_patterns.clear();
+    m_firstBytes.clear();
+    m_minLength = 0;
+    m_maxLength = 0;
+
+    for (const auto &pattern : patterns)
+    {
+      if (pattern.isEmpty())
+        continue;
+
+      m_patterns.append(pattern);
+      const auto first = static_cast<quint8>(pattern.at(0));
+      if (!m_firstBytes.contains(first))
+        m_firstBytes.append(first);
+
+      if (m_minLength == 0 || pattern.size() < m_minLength)
+        m_minLength = pattern.size();
+
+      m_maxLength = std::max(m_maxLength, pattern.size());
+    }
+  }
+
+  [[nodiscard]] bool isEmpty() const { return m_patterns.isEmpty(); }
+  [[nodiscard]] qsizetype count() const { return m_patterns.count(); }
+  [[nodiscard]] qsizetype minLength() const { return m_minLength; }
+  [[nodiscard]] qsizetype maxLength() const { return m_maxLength; }
+  [[nodiscard]] const QByteArray &at(qsizetype i) const
+  {
+    return m_patterns.at(i);
+  }
+  [[nodiscard]] const QVector<quint8> &firstBytes() const
+  {
+    return m_firstBytes;
+  }
+
+private:
+  qsizetype m_minLength = 0;
+  qsizetype m_maxLength = 0;
+  QList<QByteArray> m_patterns;
+  QVector<quint8> m_firstBytes;
+};
+
+/**
+ * @brief Finds the first byte in a buffer that may start any of the patterns
+ *        of the given set.
+ *
+ * With a single distinct first byte, the search is delegated to @c memchr(),
+ * which is vectorized by every mainstream C library. With several distinct
+ * first bytes, the buffer is scanned 16 bytes at a time, comparing each block
+ * against all candidates at once and reducing the result to a bit mask.
+ *
+ * @param data Pointer to the data to scan.
+ * @param size The number of bytes to scan.
+ * @param set The pattern set with the precomputed first bytes.
+ *
+ * @return The offset of the first candidate byte, or -1 if none was found.
+ */
+inline qsizetype findFirstOf(const char *data, qsizetype size,
+                             const PatternSet &set)
+{
+  // Nothing to search for
+  const auto &needles = set.firstBytes();
+  if (needles.isEmpty() || size <= 0)
+    return -1;
+
+  // Single candidate, let the C library do the heavy lifting
+  if (needles.count() == 1)
+  {
+    const auto *hit = std::memchr(data, needles.first(), size);
+    if (hit)
+      return static_cast<const char *>(hit) - data;
+
+    return -1;
+  }
+
+  qsizetype i = 0;
+
+#if defined(CPU_X86_64)
+  // Compare 16 bytes against every candidate using SSE2
+  constexpr qsizetype simdWidth = sizeof(simde__m128i);
+  for (; i + simdWidth <= size; i += simdWidth)
+  {
+    const auto block = simde_mm_loadu_si128(
+        reinterpret_cast<const simde__m128i *>(data + i));
+
+    auto match = simde_mm_setzero_si128();
+    for (const auto needle : needles)
+    {
+      const auto value = simde_mm_set1_epi8(static_cast<char>(needle));
+      match = simde_mm_or_si128(match, simde_mm_cmpeq_epi8(block, value));
+    }
+
+    const auto mask = simde_mm_movemask_epi8(match);
+    if (mask != 0)
+      return i + qCountTrailingZeroBits(static_cast<quint32>(mask));
+  }
+#endif
+
+  // Scalar fallback for the remaining bytes
+  for (; i < size; ++i)
+  {
+    if (needles.contains(static_cast<quint8>(data[i])))
+      return i;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Validates a buffer of UTF-8 encoded text.
+ *
+ * ASCII data is skipped 16 bytes at a time by checking the high bit of every
+ * byte in a SIMD register. Multi-byte sequences are validated with a scalar
+ * state machine that rejects overlong encodings, surrogates & code points
+ * above U+10FFFF.
+ *
+ * When the buffer ends in the middle of an otherwise valid multi-byte
+ * sequence (e.g. because a character was split between two received chunks),
+ * the data is still reported as valid & the number of bytes of the truncated
+ * sequence is written to @a incomplete, so that the caller can keep them for
+ * the next chunk.
+ *
+ * @param data Pointer to the data to validate.
+ * @param size The number of bytes to validate.
+ * @param incomplete Optional, receives the length of the truncated sequence
+ *                   at the end of the buffer (0 to 3 bytes).
+ *
+ * @return @c true if the data is valid UTF-8.
+ */
+inline bool validateUtf8(const char *data, qsizetype size,
+                         qsizetype *incomplete = nullptr)
+{
+  if (incomplete)
+    *incomplete = 0;
+
+  const auto *bytes = reinterpret_cast<const quint8 *>(data);
+  qsizetype i = 0;
+  while (i < size)
+  {
+#if defined(CPU_X86_64)
+    // Skip blocks of 16 ASCII bytes using SSE2
+    constexpr qsizetype simdWidth = sizeof(simde__m128i);
+    while (i + simdWidth <= size)
+    {
+      const auto block = simde_mm_loadu_si128(
+          reinterpret_cast<const simde__m128i *>(bytes + i));
+      if (simde_mm_movemask_epi8(block) != 0)
+        break;
+
+      i += simdWidth;
+    }
+
+#elif defined(CPU_ARM64)
+    // Skip blocks of 16 ASCII bytes using NEON
+    constexpr qsizetype simdWidth = sizeof(simde_uint8x16_t);
+    while (i + simdWidth <= size)
+    {
+      if (simde_vmaxvq_u8(simde_vld1q_u8(bytes + i)) >= 0x80)
+        break;
+
+      i += simdWidth;
+    }
+
+#endif
+
+    // Consume ASCII bytes one by one
+    while (i < size && bytes[i] < 0x80)
+      ++i;
+
+    if (i >= size)
+      break;
+
+    // Obtain the length & the valid range of the second byte of the sequence
+    const auto lead = bytes[i];
+    int length = 0;
+    quint8 low = 0x80;
+    quint8 high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF)
+      length = 2;
+    else if (lead == 0xE0)
+    {
+      length = 3;
+      low = 0xA0;
+    }
+    else if (lead == 0xED)
+    {
+      length = 3;
+      high = 0x9F;
+    }
+    else if (lead >= 0xE1 && lead <= 0xEF)
+      length = 3;
+    else if (lead == 0xF0)
+    {
+      length = 4;
+      low = 0x90;
+    }
+    else if (lead == 0xF4)
+    {
+      length = 4;
+      high = 0x8F;
+    }
+    else if (lead >= 0xF1 && lead <= 0xF3)
+      length = 4;
+    else
+      return false;
+
+    // Validate the continuation bytes that are available
+    const auto available = std::min<qsizetype>(length, size - i);
+    for (qsizetype j = 1; j < available; ++j)
+    {
+      const auto byte = bytes[i + j];
+      const auto min = j == 1 ? low : quint8(0x80);
+      const auto max = j == 1 ? high : quint8(0xBF);
+      if (byte < min || byte > max)
+        return false;
+    }
+
+    // Sequence is truncated by the end of the buffer
+    if (available < length)
+    {
+      if (incomplete)
+        *incomplete = available;
+
+      return true;
+    }
+
+    i += length;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Finds the first UTF-16 code unit that is not a printable ASCII
+ *        character (i.e. outside of the 0x20-0x7E range).
+ *
+ * Control characters (ESC, CR, LF, BS...) and non-ASCII characters are
+ * detected 8 code units at a time by offsetting each unit by 0x20 & doing an
+ * unsigned saturated comparison against the width of the printable range.
+ *
+ * @param data Pointer to the UTF-16 data to scan.
+ * @param size The number of code units to scan.
+ *
+ * @return The offset of the first matching code unit, or -1 if all the code
+ *         units are printable ASCII characters.
+ */
+inline qsizetype findFirstNonPrintable(const char16_t *data, qsizetype size)
+{
+  qsizetype i = 0;
+
+#if defined(CPU_X86_64)
+  // Flag units for which (unit - 0x20) > 0x5E using SSE2
+  constexpr qsizetype simdWidth = sizeof(simde__m128i) / sizeof(char16_t);
+  const auto offset = simde_mm_set1_epi16(0x20);
+  const auto range = simde_mm_set1_epi16(0x5E);
+  const auto zero = simde_mm_setzero_si128();
+  for (; i + simdWidth <= size; i += simdWidth)
+  {
+    const auto block = simde_mm_loadu_si128(
+        reinterpret_cast<const simde__m128i *>(data + i));
+    const auto shifted = simde_mm_sub_epi16(block, offset);
+    const auto excess = simde_mm_subs_epu16(shifted, range);
+    const auto printable = simde_mm_cmpeq_epi16(excess, zero);
+
+    const auto mask = ~simde_mm_movemask_epi8(printable) & 0xFFFF;
+    if (mask != 0)
+      return i + qCountTrailingZeroBits(static_cast<quint32>(mask)) / 2;
+  }
+
+#elif defined(CPU_ARM64)
+  // Flag units for which (unit - 0x20) > 0x5E using NEON
+  constexpr qsizetype simdWidth = sizeof(simde_uint16x8_t) / sizeof(char16_t);
+  const auto offset = simde_vdupq_n_u16(0x20);
+  const auto range = simde_vdupq_n_u16(0x5E);
+  for (; i + simdWidth <= size; i += simdWidth)
+  {
+    const auto *units = reinterpret_cast<const quint16 *>(data + i);
+    const auto block = simde_vld1q_u16(units);
+    const auto shifted = simde_vsubq_u16(block, offset);
+    if (simde_vmaxvq_u16(simde_vcgtq_u16(shifted, range)) != 0)
+      break;
+  }
+
+#endif
+
+  // Scalar fallback for the remaining code units
+  for (; i < size; ++i)
+  {
+    if (data[i] < 0x20 || data[i] > 0x7E)
+      return i;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Finds the first occurrence of a UTF-16 @a needle in @a data.
+ *
+ * Candidate positions are located 8 code units at a time by comparing the
+ * data with the first & the last code unit of the needle, and only the
+ * positions where both match are verified with @c memcmp(). This skips most
+ * of the data without looking at the inner characters of the needle.
+ *
+ * @param data   Pointer to the UTF-16 data to scan.
+ * @param size   The number of code units to scan.
+ * @param needle Pointer to the UTF-16 text to find.
+ * @param length The number of code units of the needle.
+ *
+ * @return The offset of the first occurrence, 0 if the needle is empty, or -1
+ *         if the needle is not found.
+ */
+inline qsizetype findSubstring(const char16_t *data, qsizetype size,
+                               const char16_t *needle, qsizetype length)
+{
+  if (length <= 0)
+    return 0;
+  if (length > size)
+    return -1;
+
+  qsizetype i = 0;
+  const qsizetype last = size - length;
+  const auto tail = static_cast<size_t>(length - 1) * sizeof(char16_t);
+
+#if defined(CPU_X86_64)
+  // Compare 8 candidate positions with the first & last needle units (SSE2)
+  constexpr qsizetype simdWidth = sizeof(simde__m128i) / sizeof(char16_t);
+  const auto back = static_cast<short>(needle[length - 1]);
+  const auto front = static_cast<short>(needle[0]);
+  const auto firstUnit = simde_mm_set1_epi16(front);
+  const auto lastUnit = simde_mm_set1_epi16(back);
+  for (; i + simdWidth - 1 <= last; i += simdWidth)
+  {
+    const auto head = simde_mm_loadu_si128(
+        reinterpret_cast<const simde__m128i *>(data + i));
+    const auto end = simde_mm_loadu_si128(
+        reinterpret_cast<const simde__m128i *>(data + i + length - 1));
+    const auto match = simde_mm_and_si128(simde_mm_cmpeq_epi16(head, firstUnit),
+                                          simde_mm_cmpeq_epi16(end, lastUnit));
+
+    // Verify each candidate position
+    auto mask = static_cast<quint32>(simde_mm_movemask_epi8(match));
+    while (mask != 0)
+    {
+      const auto offset = qCountTrailingZeroBits(mask) / 2;
+      if (std::memcmp(data + i + offset + 1, needle + 1, tail) == 0)
+        return i + offset;
+
+      mask &= ~(3u << (offset * 2));
+    }
+  }
+
+#elif defined(CPU_ARM64)
+  // Compare 8 candidate positions with the first & last needle units (NEON)
+  constexpr qsizetype simdWidth = sizeof(simde_uint16x8_t) / sizeof(char16_t);
+  const auto back = static_cast<quint16>(needle[length - 1]);
+  const auto front = static_cast<quint16>(needle[0]);
+  const auto firstUnit = simde_vdupq_n_u16(front);
+  const auto lastUnit = simde_vdupq_n_u16(back);
+  for (; i + simdWidth - 1 <= last; i += simdWidth)
+  {
+    const auto *head = reinterpret_cast<const quint16 *>(data + i);
+    const auto *end = reinterpret_cast<const quint16 *>(data + i + length - 1);
+    const auto match
+        = simde_vandq_u16(simde_vceqq_u16(simde_vld1q_u16(head), firstUnit),
+                          simde_vceqq_u16(simde_vld1q_u16(end), lastUnit));
+
+    // Verify each candidate position
+    if (simde_vmaxvq_u16(match) == 0)
+      continue;
+
+    for (qsizetype j = i; j < i + simdWidth; ++j)
+    {
+      if (data[j] == needle[0]
+          && std::memcmp(data + j + 1, needle + 1, tail) == 0)
+        return j;
+    }
+  }
+
+#endif
+
+  // Scalar fallback for the remaining positions
+  for (; i <= last; ++i)
+  {
+    if (data[i] != needle[0])
+      continue;
+
+    if (std::memcmp(data + i + 1, needle + 1, tail) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Text to number conversion
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Converts a number in text form to a double.
+ *
+ * Plain decimal numbers (e.g. @c -12.5 or @c 3.2e-4), which is what devices
+ * send in almost every frame, are converted with an exact fast path: the
+ * digits are accumulated in a 64-bit integer mantissa, which is scaled by an
+ * exactly representable power of ten. When the mantissa fits in 53 bits and
+ * the exponent is within [-22, 22], a single IEEE multiplication (or
+ * division) is correctly rounded, so the result is identical to a full
+ * conversion.
+ *
+ * Everything else (long mantissas, large exponents, @c inf, @c nan or invalid
+ * text) falls back to Qt's conversion, so the accepted syntax & the results
+ * are the same as @c QString::toDouble(), including leading & trailing
+ * whitespace being ignored.
+ *
+ * @param data Pointer to the characters (@c char or @c char16_t).
+ * @param size The number of characters.
+ * @param ok Optional, set to @c true if the text is a valid number.
+ * @return The number, or @c 0 if the text is not a valid number.
+ */
+template<typename Char>
+inline double parseNumber(const Char *data, qsizetype size, bool *ok = nullptr)
+{
+  static_assert(std::is_same_v<Char, char> || std::is_same_v<Char, char16_t>,
+                "Text must be given as char or char16_t characters");
+
+  // Exact powers of ten of a double
+  static constexpr double kPowers[]
+      = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  // Skip surrounding whitespace
+  qsizetype i = 0;
+  qsizetype end = qMax<qsizetype>(size, 0);
+  const auto isSpace = [](const Char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  };
+  while (i < end && isSpace(data[i]))
+    ++i;
+  while (end > i && isSpace(data[end - 1]))
+    --end;
+
+  // Read the sign
+  bool negative = false;
+  if (i < end && (data[i] == '-' || data[i] == '+'))
+    negative = data[i++] == '-';
+
+  // Read the integer & fractional digits into the mantissa
+  int digits = 0;
+  int exponent = 0;
+  quint64 mantissa = 0;
+  for (; i < end && data[i] >= '0' && data[i] <= '9'; ++i, ++digits)
+    mantissa = mantissa * 10 + static_cast<quint64>(data[i] - '0');
+
+  if (i < end && data[i] == '.')
+  {
+    for (++i; i < end && data[i] >= '0' && data[i] <= '9'; ++i, ++digits)
+    {
+      mantissa = mantissa * 10 + static_cast<quint64>(data[i] - '0');
+      --exponent;
+    }
+  }
+
+  // Read the exponent
+  bool valid = digits > 0 && digits <= 19;
+  if (valid && i < end && (data[i] == 'e' || data[i] == 'E'))
+  {
+    ++i;
+    bool negativeExponent = false;
+    if (i < end && (data[i] == '-' || data[i] == '+'))
+      negativeExponent = data[i++] == '-';
+
+    int value = 0;
+    const auto start = i;
+    for (; i < end && data[i] >= '0' && data[i] <= '9' && value < 1000; ++i)
+      value = value * 10 + (data[i] - '0');
+
+    valid = i > start;
+    exponent += negativeExponent ? -value : value;
+  }
+
+  // Exact fast path
+  constexpr quint64 kMaxMantissa = quint64(1) << 53;
+  if (valid && i == end && mantissa <= kMaxMantissa && exponent >= -22
+      && exponent <= 22)
+  {
+    auto value = static_cast<double>(mantissa);
+    if (exponent < 0)
+      value /= kPowers[-exponent];
+    else
+      value *= kPowers[exponent];
+
+    if (ok)
+      *ok = true;
+
+    return negative ? -value : value;
+  }
+
+  // Let Qt deal with the rest
+  bool converted = false;
+  double value = 0;
+  if constexpr (std::is_same_v<Char, char>)
+    value = QByteArrayView(data, qMax<qsizetype>(size, 0)).toDouble(&converted);
+  else
+    value = QStringView(data, qMax<qsizetype>(size, 0)).toDouble(&converted);
+
+  if (ok)
+    *ok = converted;
+
+  return converted ? value : 0;
+}
+
+/**
+ * @brief Converts the fields of a delimited buffer (e.g. a quick plot line or
+ *        a CSV row) to numbers in a single pass.
+ *
+ * Field boundaries are found with @c memchr(), which the C library implements
+ * with vector instructions, and each field is converted with
+ * @c parseNumber() as soon as it is found.
+ *
+ * @param data Pointer to the buffer.
+ * @param size The size of the buffer in bytes.
+ * @param delimiter The character that separates the fields.
+ * @param values Receives the value of each field, @c 0 for invalid numbers.
+ * @param valid Optional, receives whether each field is a valid number.
+ * @param ends Optional, receives the offset at which each field ends.
+ * @param capacity The size of the output arrays, extra fields are ignored.
+ * @return The number of fields that were converted.
+ */
+inline qsizetype parseNumbers(const char *data, qsizetype size, char delimiter,
+                              double *values, bool *valid, qsizetype *ends,
+                              qsizetype capacity)
+{
+  qsizetype count = 0;
+  qsizetype start = 0;
+  while (count < capacity && start <= size)
+  {
+    // Find the end of the field
+    qsizetype end = size;
+    const auto *hit = std::memchr(data + start, delimiter, size - start);
+    if (hit)
+      end = static_cast<const char *>(hit) - data;
+
+    // Convert the field
+    bool ok = false;
+    values[count] = parseNumber(data + start, end - start, &ok);
+    if (valid)
+      valid[count] = ok;
+    if (ends)
+      ends[count] = end;
+
+    ++count;
+    start = end + 1;
+  }
+
+  return count;
+}
 }; // namespace SIMD
@@ -21,10 +21,794 @@
  */
 
 #include "SerialStudio.h"
+#include "SIMD/SIMD.h"
+#include "UI/HistoryStore.h"
 #include "Misc/ThemeManager.h"
 
+#include <array>
+#include <algorithm>
 #include <QJsonArray>
 
+//------------------------------------------------------------------------------
+// Curve ring buffer
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Drops the oldest samples of a ring buffer history, given as its
+ *        oldest & newest spans, so that at most @a samples samples remain.
+ *
+ * Used by widgets that display a shorter history than the one stored for
+ * their dataset, since the history is shared with other widgets.
+ *
+ * @param first   The oldest samples of the history.
+ * @param second  The newest samples of the history.
+ * @param samples Number of samples to keep, 0 keeps every sample.
+ */
+static void keepNewest(Curve::Span &first, Curve::Span &second,
+                       const qsizetype samples)
+{
+  auto excess = first.count + second.count - samples;
+  if (samples <= 0 || excess <= 0)
+    return;
+
+  const auto skip = qMin(excess, first.count);
+  first.data += skip;
+  first.count -= skip;
+  excess -= skip;
+
+  second.data += excess;
+  second.count -= excess;
+}
+
+/**
+ * @brief Constructs an empty curve.
+ */
+Curve::Curve()
+  : m_head(0)
+  , m_sequence(0)
+{
+}
+
+/**
+ * @brief Constructs a curve with @a size samples set to 0.
+ */
+Curve::Curve(const qsizetype size)
+  : m_head(0)
+  , m_sequence(0)
+{
+  resize(size);
+}
+
+/**
+ * @brief Sets every sample of the curve to the given @a value.
+ */
+void Curve::fill(const qreal value)
+{
+  m_head = 0;
+  m_minQueue.clear();
+  m_maxQueue.clear();
+  m_sequence = static_cast<quint64>(m_data.count());
+  if (!m_data.isEmpty())
+  {
+    const auto sample = static_cast<Sample>(value);
+    SIMD::fill<Sample>(m_data.data(), m_data.count(), sample);
+    m_minQueue.emplace_back(m_sequence - 1, sample);
+    m_maxQueue.emplace_back(m_sequence - 1, sample);
+  }
+}
+
+/**
+ * @brief Changes the number of samples of the curve, and resets all samples
+ *        to 0.
+ */
+void Curve::resize(const qsizetype size)
+{
+  m_data.resize(qMax<qsizetype>(size, 0));
+  fill(0);
+}
+
+/**
+ * @brief Replaces the samples of the curve with the newest samples of the
+ *        given @a source curve, keeping the size of the curve.
+ *
+ * Used to take snapshots of a history, such as the triggered captures of the
+ * dashboard plots. If @a source is shorter than the curve, the oldest samples
+ * of the curve are set to 0.
+ */
+void Curve::copyNewest(const Curve &source)
+{
+  auto first = source.firstSpan();
+  auto second = source.secondSpan();
+  keepNewest(first, second, count());
+
+  fill(0);
+  for (qsizetype i = 0; i < first.count; ++i)
+    append(first.data[i]);
+  for (qsizetype i = 0; i < second.count; ++i)
+    append(second.data[i]);
+}
+
+/**
+ * @brief Returns the number of bytes used by the samples of the curve & the
+ *        queues that track its extremes.
+ */
+qsizetype Curve::memoryUsage() const
+{
+  const auto queued = m_minQueue.size() + m_maxQueue.size();
+  return sizeof(Curve) + m_data.capacity() * sizeof(Sample)
+         + static_cast<qsizetype>(queued * sizeof(Extremum));
+}
+
+/**
+ * @brief Converts a ring buffer history, given as its oldest & newest spans,
+ *        into a series of points, see @c Curve::toPoints().
+ *
+ * @param first   The oldest samples of the history.
+ * @param second  The newest samples of the history.
+ * @param points  The output series, reused between calls to avoid allocations.
+ * @param columns Maximum number of pixel columns, 0 disables decimation.
+ */
+static void toPoints(const Curve::Span &first, const Curve::Span &second,
+                     QVector<QPointF> &points, const qsizetype columns)
+{
+  // Logical access to the samples of the two spans
+  const auto n = first.count + second.count;
+  const auto at = [&](const qsizetype i) -> qreal {
+    return i < first.count ? first.data[i] : second.data[i - first.count];
+  };
+
+  // Copy every sample if decimation is not needed
+  if (columns <= 0 || n <= columns * 2)
+  {
+    points.resize(n);
+    SIMD::toPoints(first.data, first.count, points.data());
+    SIMD::toPoints(second.data, second.count, points.data() + first.count,
+                   first.count);
+    return;
+  }
+
+  // Keep the lowest & highest sample of each column
+  points.clear();
+  points.reserve(columns * 2);
+  for (qsizetype c = 0; c < columns; ++c)
+  {
+    const auto begin = c * n / columns;
+    const auto end = (c + 1) * n / columns;
+
+    auto minIndex = begin;
+    auto maxIndex = begin;
+    auto minValue = at(begin);
+    auto maxValue = minValue;
+    for (auto i = begin + 1; i < end; ++i)
+    {
+      const auto value = at(i);
+      if (value < minValue)
+      {
+        minValue = value;
+        minIndex = i;
+      }
+
+      else if (value > maxValue)
+      {
+        maxValue = value;
+        maxIndex = i;
+      }
+    }
+
+    const auto firstIndex = qMin(minIndex, maxIndex);
+    const auto lastIndex = qMax(minIndex, maxIndex);
+    points.append(QPointF(firstIndex, at(firstIndex)));
+    if (lastIndex != firstIndex)
+      points.append(QPointF(lastIndex, at(lastIndex)));
+  }
+}
+
+/**
+ * @brief Converts the curve into a series of points, with the sample index as
+ *        the X coordinate and the sample value as the Y coordinate.
+ *
+ * If the curve has more than two samples for each of the given @a columns
+ * (usually the width of the plot in pixels), the samples are decimated with
+ * a min/max (M4-style) filter: the lowest and highest sample of each column
+ * are kept in their original order. The rendered line is visually identical
+ * to the full resolution one, and the Y range of the series is preserved.
+ *
+ * @param points  The output series, reused between calls to avoid allocations.
+ * @param columns Maximum number of pixel columns, 0 disables decimation.
+ * @param samples Number of (newest) samples to convert, 0 converts all of them.
+ */
+void Curve::toPoints(QVector<QPointF> &points, const qsizetype columns,
+                     const qsizetype samples) const
+{
+  auto first = firstSpan();
+  auto second = secondSpan();
+  keepNewest(first, second, samples);
+  ::toPoints(first, second, points, columns);
+}
+
+/**
+ * @brief Converts a ring buffer history into a series of points, with the
+ *        acquisition time of each sample as the X coordinate, see
+ *        @c Curve::toPoints().
+ *
+ * @param first    The oldest samples of the history.
+ * @param second   The newest samples of the history.
+ * @param timeline The acquisition timestamps of the samples.
+ * @param window   Length of the plotted time window, in nanoseconds.
+ * @param points   The output series, reused between calls.
+ * @param columns  Maximum number of pixel columns, 0 disables decimation.
+ * @param offset   Time between the end of the window & the newest sample.
+ */
+static void toPoints(const Curve::Span &first, const Curve::Span &second,
+                     const Timeline &timeline, const qint64 window,
+                     QVector<QPointF> &points, const qsizetype columns,
+                     const qint64 offset)
+{
+  points.clear();
+
+  // Align the newest sample of the curve with the newest timestamp
+  const auto samples = first.count + second.count;
+  const auto n = qMin(samples, timeline.count());
+  const auto newest = timeline.newest();
+  if (n <= 0 || newest <= 0 || window <= 0)
+    return;
+
+  const auto sampleOffset = samples - n;
+  const auto timeOffset = timeline.count() - n;
+  const auto value = [&](qsizetype i) -> qreal {
+    i += sampleOffset;
+    return i < first.count ? first.data[i] : second.data[i - first.count];
+  };
+  const auto time = [&](const qsizetype i) -> qint64 {
+    return timeline.at(i + timeOffset);
+  };
+  const auto x = [&](const qsizetype i) -> qreal {
+    return static_cast<qreal>(time(i) - newest) / 1e9;
+  };
+
+  // Find the samples of the time window, timestamps never decrease
+  const auto stop = newest - qMax<qint64>(offset, 0);
+  const auto start = qMax<qint64>(stop - window, 1);
+  const auto lowerBound = [&](const qint64 timestamp, const bool inclusive) {
+    qsizetype begin = 0;
+    qsizetype end = n;
+    while (begin < end)
+    {
+      const auto middle = begin + (end - begin) / 2;
+      const auto t = time(middle);
+      if (t < timestamp || (inclusive && t == timestamp))
+        begin = middle + 1;
+      else
+        end = middle;
+    }
+
+    return begin;
+  };
+
+  // Copy every sample of the window if decimation is not needed
+  const auto begin = lowerBound(start, false);
+  const auto end = lowerBound(stop, true);
+  const auto visible = end - begin;
+  if (columns <= 0 || visible <= columns * 2)
+  {
+    points.reserve(visible);
+    for (auto i = begin; i < end; ++i)
+      points.append(QPointF(x(i), value(i)));
+
+    return;
+  }
+
+  // Keep the first, lowest, highest & last sample of each time column, so
+  // that bursts collapse into their column and gaps in the data stay visible
+  points.reserve(columns * 4);
+  std::array<qsizetype, 4> indexes = {begin, begin, begin, begin};
+  const auto flush = [&] {
+    auto sorted = indexes;
+    std::sort(sorted.begin(), sorted.end());
+    for (qsizetype k = 0; k < 4; ++k)
+    {
+      if (k == 0 || sorted[k] != sorted[k - 1])
+        points.append(QPointF(x(sorted[k]), value(sorted[k])));
+    }
+  };
+
+  qsizetype column = -1;
+  for (auto i = begin; i < end; ++i)
+  {
+    const auto c = qMin<qsizetype>((time(i) - start) * columns / window,
+                                   columns - 1);
+    if (c != column)
+    {
+      if (column >= 0)
+        flush();
+
+      column = c;
+      indexes = {i, i, i, i};
+      continue;
+    }
+
+    const auto sample = value(i);
+    if (sample < value(indexes[1]))
+      indexes[1] = i;
+    else if (sample > value(indexes[2]))
+      indexes[2] = i;
+
+    indexes[3] = i;
+  }
+
+  flush();
+}
+
+/**
+ * @brief Converts the curve into a series of points, with the acquisition time
+ *        of each sample (in seconds, relative to the newest sample) as the X
+ *        coordinate.
+ *
+ * Only the samples acquired within the @a window nanoseconds that end
+ * @a offset nanoseconds before the newest sample are kept.
+ * Since samples may arrive at irregular intervals, decimation is done over
+ * time instead of over the sample index: the window is split in @a columns
+ * equal time slices and the first, lowest, highest and last sample of each
+ * slice are kept (M4 filter). Slices without samples produce no points.
+ *
+ * @param timeline The acquisition timestamps of the samples of the curve.
+ * @param window   Length of the plotted time window, in nanoseconds.
+ * @param points   The output series, reused between calls.
+ * @param columns  Maximum number of pixel columns, 0 disables decimation.
+ * @param samples  Number of (newest) samples to consider, 0 for all of them.
+ * @param offset   Time between the end of the window & the newest sample, in
+ *                 nanoseconds, used to scroll back through the history.
+ */
+void Curve::toPoints(const Timeline &timeline, const qint64 window,
+                     QVector<QPointF> &points, const qsizetype columns,
+                     const qsizetype samples, const qint64 offset) const
+{
+  auto first = firstSpan();
+  auto second = secondSpan();
+  keepNewest(first, second, samples);
+  ::toPoints(first, second, timeline, window, points, columns, offset);
+}
+
+//------------------------------------------------------------------------------
+// Multiple curves ring buffer
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs an empty group of curves.
+ */
+MultipleCurves::MultipleCurves()
+  : m_head(0)
+  , m_size(0)
+  , m_sequence(0)
+{
+}
+
+/**
+ * @brief Constructs a group of @a curves curves with @a size samples set to 0.
+ */
+MultipleCurves::MultipleCurves(const qsizetype curves, const qsizetype size)
+  : m_head(0)
+  , m_size(0)
+  , m_sequence(0)
+{
+  resize(curves, size);
+}
+
+/**
+ * @brief Changes the number of curves & samples per curve, and resets all
+ *        samples to 0.
+ */
+void MultipleCurves::resize(const qsizetype curves, const qsizetype size)
+{
+  const auto count = qMax<qsizetype>(curves, 0);
+  m_head = 0;
+  m_size = qMax<qsizetype>(size, 0);
+  m_sequence = static_cast<quint64>(m_size);
+  m_data.resize(count * m_size);
+  SIMD::fill<Curve::Sample>(m_data.data(), m_data.count(), 0);
+
+  m_minQueues.clear();
+  m_maxQueues.clear();
+  m_minQueues.resize(count);
+  m_maxQueues.resize(count);
+  if (m_size > 0)
+  {
+    for (qsizetype c = 0; c < count; ++c)
+    {
+      m_minQueues[c].emplace_back(m_sequence - 1, 0);
+      m_maxQueues[c].emplace_back(m_sequence - 1, 0);
+    }
+  }
+}
+
+/**
+ * @brief Replaces the samples of the curves with the newest samples of the
+ *        given @a source group, keeping the size of the group.
+ *
+ * Used to resize the histories of a multiplot without losing its data. If
+ * @a source is shorter, the oldest samples are set to 0; curves that are not
+ * part of @a source repeat their newest sample.
+ */
+void MultipleCurves::copyNewest(const MultipleCurves &source)
+{
+  const auto curves = qMin(curveCount(), source.curveCount());
+  const auto samples = qMin(count(), source.count());
+  resize(curveCount(), count());
+
+  QVector<qreal> row(curves);
+  for (auto i = source.m_size - samples; i < source.m_size; ++i)
+  {
+    auto index = source.m_head + i;
+    if (index >= source.m_size)
+      index -= source.m_size;
+
+    for (qsizetype c = 0; c < curves; ++c)
+      row[c] = source.m_data[c * source.m_size + index];
+
+    append(row);
+  }
+}
+
+/**
+ * @brief Replaces the oldest sample of every curve with the given @a values,
+ *        one per curve.
+ *
+ * Curves without a value in @a values repeat their newest sample.
+ */
+void MultipleCurves::append(QSpan<const qreal> values)
+{
+  if (m_size <= 0)
+    return;
+
+  // Write the samples to the columns of the curves in a single pass
+  const auto previous = m_head > 0 ? m_head - 1 : m_size - 1;
+  const auto given = qMin<qsizetype>(values.size(), curveCount());
+  SIMD::scatter(values.data(), given, m_data.data() + m_head, m_size);
+
+  const auto sequence = m_sequence++;
+  const auto oldest = m_sequence - static_cast<quint64>(m_size);
+  for (qsizetype c = 0; c < curveCount(); ++c)
+  {
+    // Repeat the newest sample of curves without a value
+    auto *column = m_data.data() + c * m_size;
+    if (c >= given)
+      column[m_head] = column[previous];
+
+    const auto sample = column[m_head];
+
+    // Drop the extremes that are no longer part of the history
+    auto &minQueue = m_minQueues[c];
+    auto &maxQueue = m_maxQueues[c];
+    while (!minQueue.empty() && minQueue.front().first < oldest)
+      minQueue.pop_front();
+    while (!maxQueue.empty() && maxQueue.front().first < oldest)
+      maxQueue.pop_front();
+
+    // Drop the extremes that can no longer be the lowest or highest sample
+    while (!minQueue.empty() && minQueue.back().second >= sample)
+      minQueue.pop_back();
+    while (!maxQueue.empty() && maxQueue.back().second <= sample)
+      maxQueue.pop_back();
+
+    minQueue.emplace_back(sequence, sample);
+    maxQueue.emplace_back(sequence, sample);
+  }
+
+  if (++m_head == m_size)
+    m_head = 0;
+}
+
+/**
+ * @brief Converts the given @a curve into a series of points, decimated to
+ *        the given number of pixel @a columns (see @c Curve::toPoints()).
+ */
+void MultipleCurves::toPoints(const qsizetype curve, QVector<QPointF> &points,
+                              const qsizetype columns) const
+{
+  if (curve < 0 || curve >= curveCount())
+  {
+    points.clear();
+    return;
+  }
+
+  ::toPoints(firstSpan(curve), secondSpan(curve), points, columns);
+}
+
+/**
+ * @brief Returns the number of bytes used by the samples of the curves & the
+ *        queues that track their extremes.
+ */
+qsizetype MultipleCurves::memoryUsage() const
+{
+  qsizetype queued = 0;
+  for (qsizetype c = 0; c < curveCount(); ++c)
+    queued += m_minQueues[c].size() + m_maxQueues[c].size();
+
+  return sizeof(MultipleCurves) + m_data.capacity() * sizeof(Curve::Sample)
+         + queued * static_cast<qsizetype>(sizeof(Extremum));
+}
+
+//------------------------------------------------------------------------------
+// Timeline ring buffer
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructs an empty timeline.
+ */
+Timeline::Timeline()
+  : m_head(0)
+{
+}
+
+/**
+ * @brief Constructs a timeline with @a size timestamps set to 0.
+ */
+Timeline::Timeline(const qsizetype size)
+  : m_head(0)
+{
+  resize(size);
+}
+
+/**
+ * @brief Changes the number of timestamps of the timeline, and resets all
+ *        timestamps to 0.
+ */
+void Timeline::resize(const qsizetype size)
+{
+  m_head = 0;
+  m_data.fill(0, qMax<qsizetype>(size, 0));
+}
+
+/**
+ * @brief Returns the number of bytes used by the timestamps of the timeline.
+ */
+qsizetype Timeline::memoryUsage() const
+{
+  return sizeof(Timeline) + m_data.capacity() * sizeof(qint64);
+}
+
+//------------------------------------------------------------------------------
+// Multi-resolution history tiers
+//------------------------------------------------------------------------------
+
+/**
+ * Width of the buckets of each history tier, in nanoseconds.
+ */
+static constexpr std::array<qint64, 3> kTierWidths
+    = {1'000'000'000LL, 10'000'000'000LL, 60'000'000'000LL};
+
+/**
+ * Maximum number of buckets of each history tier (1 hour of 1 s buckets,
+ * 6 hours of 10 s buckets & 24 hours of 1 min buckets).
+ */
+static constexpr std::array<qsizetype, 3> kTierSizes = {3600, 2160, 1440};
+
+/**
+ * @brief Constructs an empty multi-resolution history.
+ */
+HistoryTiers::HistoryTiers()
+  : m_store(nullptr)
+{
+  clear();
+}
+
+/**
+ * @brief Removes every bucket of the history & frees its memory.
+ *
+ * The history is also detached from its store, whose streams are owned by
+ * the store itself.
+ */
+void HistoryTiers::clear()
+{
+  m_store = nullptr;
+  m_tiers.clear();
+  m_tiers.resize(tierCount());
+}
+
+/**
+ * @brief Moves the oldest buckets of full tiers to a new stream of the given
+ *        @a store from now on, instead of dropping them.
+ *
+ * The @a store must outlive the history, or the history must be cleared
+ * before the store is closed.
+ */
+void HistoryTiers::setStore(UI::HistoryStore *store)
+{
+  m_store = store;
+  for (auto &tier : m_tiers)
+    tier.stream = store ? store->addStream() : -1;
+}
+
+/**
+ * @brief Adds the sample @a value, acquired at @a timestamp (in nanoseconds),
+ *        to the bucket of each tier that contains its time.
+ *
+ * When the sample falls outside of the bucket that is being filled, that
+ * bucket is completed & stored in the tier, replacing its oldest bucket once
+ * the tier is full. The replaced bucket is moved to the store, if any.
+ */
+void HistoryTiers::append(const qint64 timestamp, const qreal value)
+{
+  if (timestamp <= 0)
+    return;
+
+  for (int t = 0; t < m_tiers.count(); ++t)
+  {
+    // Complete the current bucket if the sample belongs to a new one
+    auto &tier = m_tiers[t];
+    auto start = timestamp - timestamp % kTierWidths[t];
+    if (tier.samples > 0)
+      start = qMax(start, tier.start);
+    if (tier.samples > 0 && start != tier.start)
+    {
+      Bucket bucket;
+      bucket.time = tier.start;
+      bucket.min = static_cast<Curve::Sample>(tier.min);
+      bucket.max = static_cast<Curve::Sample>(tier.max);
+      bucket.mean = static_cast<Curve::Sample>(tier.sum / tier.samples);
+      if (tier.buckets.count() < kTierSizes[t])
+        tier.buckets.append(bucket);
+
+      else
+      {
+        auto &oldest = tier.buckets[tier.head];
+        if (tier.dropped || !m_store || !m_store->append(tier.stream, oldest))
+          tier.dropped = true;
+
+        oldest = bucket;
+        tier.head = (tier.head + 1) % tier.buckets.count();
+      }
+
+      tier.samples = 0;
+    }
+
+    // Add the sample to the current bucket
+    if (tier.samples == 0)
+    {
+      tier.start = start;
+      tier.min = value;
+      tier.max = value;
+      tier.sum = 0;
+    }
+
+    ++tier.samples;
+    tier.sum += value;
+    tier.min = qMin(tier.min, value);
+    tier.max = qMax(tier.max, value);
+  }
+}
+
+/**
+ * @brief Converts the buckets of the history into a series of points, with
+ *        the center of each bucket (in seconds, relative to @a newest) as the
+ *        X coordinate.
+ *
+ * Only the buckets that start within [@a start, @a end) are used, from the
+ * finest tier that still holds the buckets at @a start & has at most one
+ * bucket per pixel column. Each bucket produces its lowest & highest value,
+ * so that the series draws the envelope of the samples.
+ *
+ * @param newest   Time of the newest sample of the plot, in nanoseconds.
+ * @param start    Oldest time of the plotted window, in nanoseconds.
+ * @param end      Buckets that start at or after this time are left out, so
+ *                 that the raw samples of the plot can be appended to the
+ *                 series.
+ * @param points   The output series, reused between calls.
+ * @param columns  Maximum number of pixel columns, 0 disables the limit.
+ */
+void HistoryTiers::toPoints(const qint64 newest, const qint64 start,
+                            const qint64 end, QVector<QPointF> &points,
+                            const qsizetype columns) const
+{
+  points.clear();
+  const auto window = end - start;
+  if (newest <= 0 || window <= 0)
+    return;
+
+  // Select the finest tier that is suitable for the window
+  int tier = tierCount() - 1;
+  for (int t = 0; t < tierCount() - 1; ++t)
+  {
+    const auto &ring = m_tiers[t];
+    const bool complete = !ring.dropped || at(t, 0).time <= start;
+    if (complete && (columns <= 0 || window / width(t) <= columns))
+    {
+      tier = t;
+      break;
+    }
+  }
+
+  // Find the buckets of the time window, buckets are sorted by time
+  const auto lowerBound = [&](const qint64 time) {
+    qsizetype first = 0;
+    qsizetype last = count(tier);
+    while (first < last)
+    {
+      const auto middle = first + (last - first) / 2;
+      if (at(tier, middle).time < time)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+
+    return first;
+  };
+
+  // Add the lowest & highest value of each bucket
+  const auto begin = lowerBound(start);
+  const auto stop = lowerBound(end);
+  const auto offset = width(tier) / 2 - newest;
+  points.reserve((stop - begin) * 2);
+  for (auto i = begin; i < stop; ++i)
+  {
+    const auto bucket = at(tier, i);
+    const auto x = static_cast<qreal>(bucket.time + offset) / 1e9;
+    points.append(QPointF(x, bucket.min));
+    if (bucket.max != bucket.min)
+      points.append(QPointF(x, bucket.max));
+  }
+}
+
+/**
+ * @brief Returns the number of tiers of every history.
+ */
+int HistoryTiers::tierCount()
+{
+  return static_cast<int>(kTierWidths.size());
+}
+
+/**
+ * @brief Returns the width of the buckets of the given @a tier, in
+ *        nanoseconds.
+ */
+qint64 HistoryTiers::width(const int tier)
+{
+  return kTierWidths[tier];
+}
+
+/**
+ * @brief Returns the number of bytes used by the buckets of the history that
+ *        are kept in RAM.
+ */
+qsizetype HistoryTiers::memoryUsage() const
+{
+  qsizetype bytes = sizeof(HistoryTiers);
+  for (const auto &tier : m_tiers)
+    bytes += sizeof(Tier) + tier.buckets.capacity() * sizeof(Bucket);
+
+  return bytes;
+}
+
+/**
+ * @brief Returns the number of completed buckets of the given @a tier,
+ *        including the buckets that were moved to the store.
+ */
+qsizetype HistoryTiers::count(const int tier) const
+{
+  const auto &t = m_tiers[tier];
+  const auto stored = m_store ? m_store->count(t.stream) : 0;
+  return stored + t.buckets.count();
+}
+
+/**
+ * @brief Returns the bucket at the given logical @a index of the given
+ *        @a tier, where 0 is the oldest bucket of the tier.
+ *
+ * Buckets that were moved to the store are read from its mapped file.
+ */
+HistoryTiers::Bucket HistoryTiers::at(const int tier,
+                                      const qsizetype index) const
+{
+  const auto &t = m_tiers[tier];
+  const auto stored = m_store ? m_store->count(t.stream) : 0;
+  if (index < stored)
+    return m_store->at(t.stream, index);
+
+  const auto i = t.head + index - stored;
+  const auto n = t.buckets.count();
+  return t.buckets.at(i < n ? i : i - n);
+}
+
 //------------------------------------------------------------------------------
 // Dashboard widget logic
 //------------------------------------------------------------------------------
@@ -62,6 +846,7 @@ bool SerialStudio::isDatasetWidget(const DashboardWidget widget)
   switch (widget)
   {
     case DashboardFFT:
+    case DashboardWaterfall:
     case DashboardPlot:
     case DashboardBar:
     case DashboardGauge:
@@ -101,6 +886,9 @@ QString SerialStudio::dashboardWidgetIcon(const DashboardWidget w)
     case DashboardFFT:
       return "qrc:/rcc/icons/dashboard/fft.svg";
       break;
+    case DashboardWaterfall:
+      return "qrc:/rcc/icons/dashboard/waterfall.svg";
+      break;
     case DashboardLED:
       return "qrc:/rcc/icons/dashboard/led.svg";
       break;
@@ -152,6 +940,9 @@ QString SerialStudio::dashboardWidgetTitle(const DashboardWidget w)
     case DashboardFFT:
       return tr("FFT Plots");
       break;
+    case DashboardWaterfall:
+      return tr("Waterfall Plots");
+      break;
     case DashboardLED:
       return tr("LED Panels");
       break;
@@ -233,12 +1024,40 @@ SerialStudio::getDashboardWidgets(const JSON::Dataset &dataset)
   if (dataset.fft())
     list.append(DashboardFFT);
 
+  if (dataset.waterfall())
+    list.append(DashboardWaterfall);
+
   if (dataset.led())
     list.append(DashboardLED);
 
   return list;
 }
 
+/**
+ * @brief Retrieves the refresh class used by a dashboard widget type when its
+ *        group does not define one.
+ *
+ * Data grids and the LED panel are status displays, which are refreshed at a
+ * low rate. All other widgets use the normal refresh class.
+ *
+ * @param widget The `DashboardWidget` type to check.
+ * @return The default `RefreshClass` of the widget type.
+ */
+SerialStudio::RefreshClass
+SerialStudio::defaultRefreshClass(const DashboardWidget widget)
+{
+  switch (widget)
+  {
+    case DashboardDataGrid:
+    case DashboardLED:
+      return RefreshLow;
+      break;
+    default:
+      return RefreshNormal;
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Parsing & project model logic
 //------------------------------------------------------------------------------
@@ -349,6 +1168,50 @@ SerialStudio::DatasetWidget SerialStudio::datasetWidgetFromId(const QString &id)
   return NoDatasetWidget;
 }
 
+/**
+ * @brief Retrieves the ID string used to store a refresh class in a project.
+ * @param refresh The `RefreshClass` to get the ID for.
+ * @return A QString representing the refresh class ID.
+ */
+QString SerialStudio::refreshClassId(const RefreshClass refresh)
+{
+  switch (refresh)
+  {
+    case RefreshRealtime:
+      return "realtime";
+      break;
+    case RefreshNormal:
+      return "normal";
+      break;
+    case RefreshLow:
+      return "low";
+      break;
+    default:
+      return "";
+      break;
+  }
+}
+
+/**
+ * @brief Determines the refresh class from a given ID string.
+ * @param id The ID string to interpret.
+ * @return The corresponding `RefreshClass`, or @c RefreshDefault if the ID is
+ *         empty or unknown.
+ */
+SerialStudio::RefreshClass SerialStudio::refreshClassFromId(const QString &id)
+{
+  if (id == "realtime")
+    return RefreshRealtime;
+
+  else if (id == "normal")
+    return RefreshNormal;
+
+  else if (id == "low")
+    return RefreshLow;
+
+  return RefreshDefault;
+}
+
 //------------------------------------------------------------------------------
 // Utility functions
 //------------------------------------------------------------------------------
@@ -365,10 +1228,5 @@ SerialStudio::DatasetWidget SerialStudio::datasetWidgetFromId(const QString &id)
 QString SerialStudio::getDatasetColor(const int index)
 {
   static const auto *theme = &Misc::ThemeManager::instance();
-  const auto idx = index - 1;
-  const auto colors = theme->colors()["widget_colors"].toArray();
-  const auto color = colors.count() > idx
-                         ? colors.at(idx).toString()
-                         : colors.at(idx % colors.count()).toString();
-  return color;
+  return theme->datasetColorName(index);
 }
@@ -22,23 +22,472 @@
 
 #pragma once
 
+#include <deque>
+#include <utility>
+
+#include <QSpan>
 #include <QObject>
+#include <QPointF>
 #include <QVector>
 
 #include "JSON/Group.h"
 #include "JSON/Dataset.h"
 
+class Timeline;
+
+namespace UI
+{
+class HistoryStore;
+}
+
+/**
+ * @class Curve
+ * @brief Fixed-size history of real values used for plot series.
+ *
+ * The samples are stored in a ring buffer with a head index, so appending a
+ * new sample replaces the oldest one in constant time instead of shifting
+ * the whole history. Logical index 0 is always the oldest sample.
+ *
+ * Widgets that need to copy the whole history should read it as two
+ * contiguous spans with @c firstSpan() (oldest samples) and @c secondSpan()
+ * (newest samples) instead of using the subscript operator for every sample,
+ * or use @c toPoints() to obtain a series that is decimated to the width of
+ * the plot.
+ *
+ * The lowest and highest sample of the history are tracked with two monotonic
+ * queues of (sequence, value) pairs, so @c min() and @c max() are O(1) and
+ * appending a sample is amortized O(1).
+ *
+ * Samples are stored as 32-bit floats when the project is built with
+ * @c FLOAT32_PLOT_SAMPLES, which halves the memory footprint and bandwidth of
+ * high point-count dashboards. Dataset values are doubles, so this rounds
+ * each sample to 24 significant bits, which is visible on signals such as
+ * timestamps or 24-bit ADC counts. The accessors always return @c qreal
+ * values.
+ */
+class Curve
+{
+public:
+  /**
+   * @brief Storage type of the samples of the curve.
+   */
+#ifdef FLOAT32_PLOT_SAMPLES
+  typedef float Sample;
+#else
+  typedef qreal Sample;
+#endif
+
+  /**
+   * @brief Contiguous read-only range of samples in a curve.
+   */
+  struct Span
+  {
+    const Sample *data;
+    qsizetype count;
+  };
+
+  Curve();
+  explicit Curve(const qsizetype size);
+
+  void fill(const qreal value);
+  void resize(const qsizetype size);
+  void copyNewest(const Curve &source);
+  void toPoints(QVector<QPointF> &points, const qsizetype columns = 0,
+                const qsizetype samples = 0) const;
+  void toPoints(const Timeline &timeline, const qint64 window,
+                QVector<QPointF> &points, const qsizetype columns = 0,
+                const qsizetype samples = 0, const qint64 offset = 0) const;
+
+  inline void append(const qreal value);
+
+  [[nodiscard]] qsizetype memoryUsage() const;
+  [[nodiscard]] inline qsizetype count() const;
+  [[nodiscard]] inline quint64 sequence() const;
+  [[nodiscard]] inline bool isEmpty() const;
+  [[nodiscard]] inline qreal min() const;
+  [[nodiscard]] inline qreal max() const;
+  [[nodiscard]] inline qreal at(const qsizetype index) const;
+  [[nodiscard]] inline qreal operator[](const qsizetype index) const;
+
+  [[nodiscard]] inline Span firstSpan() const;
+  [[nodiscard]] inline Span secondSpan() const;
+
+private:
+  typedef std::pair<quint64, Sample> Extremum;
+
+  qsizetype m_head;
+  quint64 m_sequence;
+  QVector<Sample> m_data;
+  std::deque<Extremum> m_minQueue;
+  std::deque<Extremum> m_maxQueue;
+};
+
+/**
+ * @brief Replaces the oldest sample of the curve with the given @a value.
+ */
+inline void Curve::append(const qreal value)
+{
+  if (m_data.isEmpty())
+    return;
+
+  const auto sample = static_cast<Sample>(value);
+  m_data[m_head] = sample;
+  if (++m_head == m_data.count())
+    m_head = 0;
+
+  // Drop the extremes that are no longer part of the history
+  const auto sequence = m_sequence++;
+  const auto oldest = m_sequence - static_cast<quint64>(m_data.count());
+  while (!m_minQueue.empty() && m_minQueue.front().first < oldest)
+    m_minQueue.pop_front();
+  while (!m_maxQueue.empty() && m_maxQueue.front().first < oldest)
+    m_maxQueue.pop_front();
+
+  // Drop the extremes that can no longer be the lowest or highest sample
+  while (!m_minQueue.empty() && m_minQueue.back().second >= sample)
+    m_minQueue.pop_back();
+  while (!m_maxQueue.empty() && m_maxQueue.back().second <= sample)
+    m_maxQueue.pop_back();
+
+  m_minQueue.emplace_back(sequence, sample);
+  m_maxQueue.emplace_back(sequence, sample);
+}
+
 /**
- * @typedef Curve
- * @brief Defines a plot series or curve as a vector of real (qreal) values.
+ * @brief Returns the lowest sample of the curve, or 0 if it is empty.
  */
-typedef QVector<qreal> Curve;
+inline qreal Curve::min() const
+{
+  return m_minQueue.empty() ? 0 : m_minQueue.front().second;
+}
+
+/**
+ * @brief Returns the highest sample of the curve, or 0 if it is empty.
+ */
+inline qreal Curve::max() const
+{
+  return m_maxQueue.empty() ? 0 : m_maxQueue.front().second;
+}
+
+/**
+ * @brief Returns the number of samples stored in the curve.
+ */
+inline qsizetype Curve::count() const
+{
+  return m_data.count();
+}
 
 /**
- * @typedef MultipleCurves
- * @brief Defines a collection of curves, used for representing multiple plots.
+ * @brief Returns a counter that increases every time a sample is appended to
+ *        the curve, used by widgets to know how many new samples arrived since
+ *        they last read the curve.
+ *
+ * @note The counter is reset when the curve is filled or resized.
  */
-typedef QVector<Curve> MultipleCurves;
+inline quint64 Curve::sequence() const
+{
+  return m_sequence;
+}
+
+/**
+ * @brief Returns @c true if the curve has no samples.
+ */
+inline bool Curve::isEmpty() const
+{
+  return m_data.isEmpty();
+}
+
+/**
+ * @brief Returns the sample at the given logical @a index, where 0 is the
+ *        oldest sample of the curve.
+ */
+inline qreal Curve::at(const qsizetype index) const
+{
+  const auto i = m_head + index;
+  return m_data.at(i < m_data.count() ? i : i - m_data.count());
+}
+
+/**
+ * @brief Returns the sample at the given logical @a index.
+ */
+inline qreal Curve::operator[](const qsizetype index) const
+{
+  return at(index);
+}
+
+/**
+ * @brief Returns the oldest samples of the curve, from the head of the ring to
+ *        the end of the storage.
+ */
+inline Curve::Span Curve::firstSpan() const
+{
+  return {m_data.constData() + m_head, m_data.count() - m_head};
+}
+
+/**
+ * @brief Returns the newest samples of the curve, from the start of the
+ *        storage to the head of the ring.
+ */
+inline Curve::Span Curve::secondSpan() const
+{
+  return {m_data.constData(), m_head};
+}
+
+/**
+ * @class MultipleCurves
+ * @brief Fixed-size histories of the curves of a multiplot group.
+ *
+ * The curves share a single ring buffer head and sequence counter, since a
+ * frame always appends one sample to every curve of the group. The samples
+ * are stored as one contiguous structure-of-arrays block, with one column
+ * of @c count() samples per curve, so that the X axis (the sample index) is
+ * implicit and shared by all curves, and iterating a curve is sequential.
+ *
+ * Each curve keeps its own lowest and highest sample with monotonic queues,
+ * like @c Curve does.
+ */
+class MultipleCurves
+{
+public:
+  MultipleCurves();
+  MultipleCurves(const qsizetype curves, const qsizetype size);
+
+  void resize(const qsizetype curves, const qsizetype size);
+  void copyNewest(const MultipleCurves &source);
+  void append(QSpan<const qreal> values);
+  void toPoints(const qsizetype curve, QVector<QPointF> &points,
+                const qsizetype columns = 0) const;
+
+  [[nodiscard]] qsizetype memoryUsage() const;
+  [[nodiscard]] inline qsizetype count() const;
+  [[nodiscard]] inline qsizetype curveCount() const;
+  [[nodiscard]] inline quint64 sequence() const;
+  [[nodiscard]] inline qreal min(const qsizetype curve) const;
+  [[nodiscard]] inline qreal max(const qsizetype curve) const;
+
+  [[nodiscard]] inline Curve::Span firstSpan(const qsizetype curve) const;
+  [[nodiscard]] inline Curve::Span secondSpan(const qsizetype curve) const;
+
+private:
+  typedef std::pair<quint64, Curve::Sample> Extremum;
+
+  qsizetype m_head;
+  qsizetype m_size;
+  quint64 m_sequence;
+  QVector<Curve::Sample> m_data;
+  QVector<std::deque<Extremum>> m_minQueues;
+  QVector<std::deque<Extremum>> m_maxQueues;
+};
+
+/**
+ * @brief Returns the number of samples stored for each curve.
+ */
+inline qsizetype MultipleCurves::count() const
+{
+  return m_size;
+}
+
+/**
+ * @brief Returns the number of curves of the group.
+ */
+inline qsizetype MultipleCurves::curveCount() const
+{
+  return m_minQueues.count();
+}
+
+/**
+ * @brief Returns a counter that increases every time a row of samples is
+ *        appended to the curves.
+ */
+inline quint64 MultipleCurves::sequence() const
+{
+  return m_sequence;
+}
+
+/**
+ * @brief Returns the lowest sample of the given @a curve, or 0 if it is empty.
+ */
+inline qreal MultipleCurves::min(const qsizetype curve) const
+{
+  const auto &queue = m_minQueues[curve];
+  return queue.empty() ? 0 : queue.front().second;
+}
+
+/**
+ * @brief Returns the highest sample of the given @a curve, or 0 if it is
+ *        empty.
+ */
+inline qreal MultipleCurves::max(const qsizetype curve) const
+{
+  const auto &queue = m_maxQueues[curve];
+  return queue.empty() ? 0 : queue.front().second;
+}
+
+/**
+ * @brief Returns the oldest samples of the given @a curve, from the head of
+ *        the ring to the end of its column.
+ */
+inline Curve::Span MultipleCurves::firstSpan(const qsizetype curve) const
+{
+  return {m_data.constData() + curve * m_size + m_head, m_size - m_head};
+}
+
+/**
+ * @brief Returns the newest samples of the given @a curve, from the start of
+ *        its column to the head of the ring.
+ */
+inline Curve::Span MultipleCurves::secondSpan(const qsizetype curve) const
+{
+  return {m_data.constData() + curve * m_size, m_head};
+}
+
+/**
+ * @class Timeline
+ * @brief Fixed-size history of the acquisition timestamps of a set of curves.
+ *
+ * The timestamps (in nanoseconds, see @c Misc::PipelineStats::timestamp())
+ * are stored in a ring buffer with the same size & logical indexing as the
+ * curves they belong to, so that index @c i of the timeline is the time at
+ * which sample @c i of every curve was acquired, as long as the curves and
+ * the timeline are resized together and receive one append per frame.
+ *
+ * Timestamps never decrease, and slots that have not been written since the
+ * timeline was resized hold 0, which allows plots to locate the first sample
+ * of a time window with a binary search.
+ */
+class Timeline
+{
+public:
+  Timeline();
+  explicit Timeline(const qsizetype size);
+
+  void resize(const qsizetype size);
+
+  inline void append(const qint64 timestamp);
+
+  [[nodiscard]] qsizetype memoryUsage() const;
+  [[nodiscard]] inline qsizetype count() const;
+  [[nodiscard]] inline qint64 newest() const;
+  [[nodiscard]] inline qint64 at(const qsizetype index) const;
+
+private:
+  qsizetype m_head;
+  QVector<qint64> m_data;
+};
+
+/**
+ * @brief Replaces the oldest timestamp of the timeline with @a timestamp, or
+ *        with the newest timestamp if @a timestamp is older than it.
+ */
+inline void Timeline::append(const qint64 timestamp)
+{
+  if (m_data.isEmpty())
+    return;
+
+  m_data[m_head] = qMax(timestamp, newest());
+  if (++m_head == m_data.count())
+    m_head = 0;
+}
+
+/**
+ * @brief Returns the number of timestamps stored in the timeline.
+ */
+inline qsizetype Timeline::count() const
+{
+  return m_data.count();
+}
+
+/**
+ * @brief Returns the newest timestamp of the timeline, or 0 if it is empty.
+ */
+inline qint64 Timeline::newest() const
+{
+  if (m_data.isEmpty())
+    return 0;
+
+  return m_data.at(m_head > 0 ? m_head - 1 : m_data.count() - 1);
+}
+
+/**
+ * @brief Returns the timestamp at the given logical @a index, where 0 is the
+ *        oldest timestamp of the timeline.
+ */
+inline qint64 Timeline::at(const qsizetype index) const
+{
+  const auto i = m_head + index;
+  return m_data.at(i < m_data.count() ? i : i - m_data.count());
+}
+
+/**
+ * @class HistoryTiers
+ * @brief Multi-resolution history of a dataset, used by plots that display
+ *        time windows longer than their sample history.
+ *
+ * Samples are aggregated incrementally into buckets of 1 s, 10 s & 1 min,
+ * each bucket storing the lowest, highest & mean value of the samples that
+ * were acquired during its time slice. Each tier is a ring buffer of a fixed
+ * number of buckets (1 hour, 6 hours & 24 hours of data respectively), which
+ * grows as buckets are completed, so the memory used by a dataset is bounded
+ * no matter how long the session is.
+ *
+ * When a store is set, the oldest bucket of a full tier is moved to the
+ * store instead of being dropped. The stored buckets remain part of the tier
+ * (with the lowest logical indexes), so the tiers cover the whole session
+ * while RAM only holds their newest buckets.
+ *
+ * The bucket that is being filled is not part of the tier until the next
+ * sample falls outside of its time slice.
+ */
+class HistoryTiers
+{
+public:
+  /**
+   * @brief Aggregate of the samples acquired during a time slice.
+   */
+  struct Bucket
+  {
+    qint64 time;
+    Curve::Sample min;
+    Curve::Sample max;
+    Curve::Sample mean;
+  };
+
+  HistoryTiers();
+
+  void clear();
+  void setStore(UI::HistoryStore *store);
+  void append(const qint64 timestamp, const qreal value);
+  void toPoints(const qint64 newest, const qint64 start, const qint64 end,
+                QVector<QPointF> &points, const qsizetype columns = 0) const;
+
+  [[nodiscard]] static int tierCount();
+  [[nodiscard]] static qint64 width(const int tier);
+
+  [[nodiscard]] qsizetype memoryUsage() const;
+  [[nodiscard]] qsizetype count(const int tier) const;
+  [[nodiscard]] Bucket at(const int tier, const qsizetype index) const;
+
+private:
+  /**
+   * @brief Ring buffer of completed buckets & the bucket being filled.
+   */
+  struct Tier
+  {
+    int stream = -1;
+    bool dropped = false;
+    qsizetype head = 0;
+    QVector<Bucket> buckets;
+
+    qint64 start = 0;
+    qint64 samples = 0;
+    qreal min = 0;
+    qreal max = 0;
+    qreal sum = 0;
+  };
+
+  QVector<Tier> m_tiers;
+  UI::HistoryStore *m_store;
+};
 
 /**
  * @class SerialStudio
@@ -52,8 +501,8 @@ typedef QVector<Curve> MultipleCurves;
  * Bluetooth LE devices.
  *
  * Key Features:
- * - **Decoding Methods**: Support for PlainText, Hexadecimal, and Base64
- *   decoding.
+ * - **Decoding Methods**: Support for PlainText, Hexadecimal, Base64 and
+ *   raw binary decoding.
  * - **Frame Detection**: Configurable methods for detecting data frames in
  *   streams, including end-delimiter-only and start-and-end-delimiter
  * strategies.
@@ -98,7 +547,8 @@ public:
   {
     PlainText,   /**< Standard decoding, interprets data as plain text. */
     Hexadecimal, /**< Decodes data assuming a hexadecimal-encoded format. */
-    Base64       /**< Decodes data assuming a Base64-encoded format. */
+    Base64,      /**< Decodes data assuming a Base64-encoded format. */
+    Binary       /**< Passes the raw bytes to the frame parser. */
   };
   Q_ENUM(DecoderMethod)
 
@@ -115,8 +565,12 @@ public:
     EndDelimiterOnly,     /**< Detects frames based only on an end delimiter. */
     StartAndEndDelimiter, /**< Detects frames based on both start and end
                                delimiters. */
-    NoDelimiters          /**< Disables frame detection and processes incoming
+    NoDelimiters,         /**< Disables frame detection and processes incoming
                                data directly */
+    LengthPrefixed,       /**< Detects frames by an optional header followed
+                               by the length of the payload. */
+    CobsEncoded,          /**< Decodes zero-terminated COBS frames. */
+    SlipEncoded           /**< Decodes END-delimited SLIP frames. */
   };
   Q_ENUM(FrameDetection)
 
@@ -148,7 +602,14 @@ public:
   {
     Serial,     /**< Serial port communication. */
     Network,    /**< Network socket communication. */
-    BluetoothLE /**< Bluetooth Low Energy communication. */
+    BluetoothLE, /**< Bluetooth Low Energy communication. */
+    Replay,      /**< Replay of a raw capture file. */
+    Generator,   /**< Synthetic signal generator. */
+    CanBus,      /**< CAN bus interface. */
+    Modbus,      /**< Modbus RTU/TCP server. */
+    RawUsb,      /**< Bulk endpoints of a USB device. */
+    AudioInput,  /**< Audio capture device. */
+    Pipe         /**< Standard input, named pipe or local socket. */
   };
   Q_ENUM(BusType)
 
@@ -170,6 +631,63 @@ public:
   };
   Q_ENUM(AxisVisibility)
 
+  /**
+   * @enum TriggerEdge
+   * @brief Specifies the signal edge that starts a triggered plot capture.
+   */
+  enum TriggerEdge
+  {
+    TriggerRisingEdge,  /**< The signal crosses the level upwards. */
+    TriggerFallingEdge, /**< The signal crosses the level downwards. */
+  };
+  Q_ENUM(TriggerEdge)
+
+  /**
+   * @enum BufferOverflowPolicy
+   * @brief Specifies what the frame reader does when incoming data does not
+   *        fit in its buffer.
+   */
+  enum BufferOverflowPolicy
+  {
+    OverflowDropOldest,   /**< Overwrite the oldest unread bytes. */
+    OverflowDropNewest,   /**< Discard the incoming bytes that do not fit. */
+    OverflowBackpressure, /**< Parse pending frames before accepting data. */
+  };
+  Q_ENUM(BufferOverflowPolicy)
+
+  /**
+   * @enum ChecksumAlgorithm
+   * @brief Specifies the checksum that protects the frames of a project.
+   *
+   * With @c ChecksumAuto, the frame reader looks for in-band checksum tags
+   * (e.g. "crc16:") after the frame delimiter. Every other value declares the
+   * checksum explicitly, which is then read at a fixed offset of the frame.
+   */
+  enum ChecksumAlgorithm
+  {
+    ChecksumAuto, /**< Detect in-band checksum tags after the delimiter. */
+    NoChecksum,   /**< Frames are not protected by a checksum. */
+    Crc8,         /**< CRC-8 (polynomial 0x31, initial value 0xFF). */
+    Crc16,        /**< CRC-16/CCITT-FALSE. */
+    Crc32,        /**< Standard CRC-32. */
+    Crc16Modbus,  /**< CRC-16/MODBUS. */
+    Crc16Xmodem,  /**< CRC-16/XMODEM. */
+    Fletcher16,   /**< Fletcher-16. */
+    Fletcher32,   /**< Fletcher-32. */
+  };
+  Q_ENUM(ChecksumAlgorithm)
+
+  /**
+   * @enum ChecksumPosition
+   * @brief Specifies where a declared checksum is stored within a frame.
+   */
+  enum ChecksumPosition
+  {
+    ChecksumTrailer, /**< The checksum is stored in the last bytes. */
+    ChecksumHeader,  /**< The checksum is stored in the first bytes. */
+  };
+  Q_ENUM(ChecksumPosition)
+
   /**
    * @brief Enum representing the different widget types available for groups.
    */
@@ -208,6 +726,7 @@ public:
     DashboardGyroscope,
     DashboardGPS,
     DashboardFFT,
+    DashboardWaterfall,
     DashboardLED,
     DashboardPlot,
     DashboardBar,
@@ -217,6 +736,22 @@ public:
   };
   Q_ENUM(DashboardWidget)
 
+  /**
+   * @brief Enum representing how often a dashboard widget is refreshed.
+   *
+   * The refresh class of a widget is defined by its group in the project
+   * file. Groups that do not define it use the default class of the widget
+   * type (see @c defaultRefreshClass()).
+   */
+  enum RefreshClass
+  {
+    RefreshDefault,  /**< Use the default class of the widget type. */
+    RefreshRealtime, /**< Refreshed on every dashboard update. */
+    RefreshNormal,   /**< Refreshed at a moderate, capped, rate. */
+    RefreshLow       /**< Refreshed once or twice per second. */
+  };
+  Q_ENUM(RefreshClass)
+
   /**
    * @brief Enum representing the options available for datasets.
    *
@@ -226,13 +761,14 @@ public:
   // clang-format off
   enum DatasetOption
   {
-    DatasetGeneric = 0b00000000,
-    DatasetPlot    = 0b00000001,
-    DatasetFFT     = 0b00000010,
-    DatasetBar     = 0b00000100,
-    DatasetGauge   = 0b00001000,
-    DatasetCompass = 0b00010000,
-    DatasetLED     = 0b00100000,
+    DatasetGeneric   = 0b00000000,
+    DatasetPlot      = 0b00000001,
+    DatasetFFT       = 0b00000010,
+    DatasetBar       = 0b00000100,
+    DatasetGauge     = 0b00001000,
+    DatasetCompass   = 0b00010000,
+    DatasetLED       = 0b00100000,
+    DatasetWaterfall = 0b01000000,
   };
   Q_ENUM(DatasetOption)
   // clang-format on
@@ -247,6 +783,7 @@ public:
   [[nodiscard]] static QString dashboardWidgetTitle(const DashboardWidget w);
   [[nodiscard]] static DashboardWidget getDashboardWidget(const JSON::Group& group);
   [[nodiscard]] static QList<DashboardWidget> getDashboardWidgets(const JSON::Dataset& dataset);
+  [[nodiscard]] static RefreshClass defaultRefreshClass(const DashboardWidget widget);
   // clang-format on
 
   //
@@ -256,6 +793,8 @@ public:
   [[nodiscard]] static GroupWidget groupWidgetFromId(const QString &id);
   [[nodiscard]] static QString datasetWidgetId(const DatasetWidget widget);
   [[nodiscard]] static DatasetWidget datasetWidgetFromId(const QString &id);
+  [[nodiscard]] static QString refreshClassId(const RefreshClass refresh);
+  [[nodiscard]] static RefreshClass refreshClassFromId(const QString &id);
 
   //
   // Utility functions
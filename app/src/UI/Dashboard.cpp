@@ -20,15 +20,141 @@
  * THE SOFTWARE.
  */
 
+#include <QCoreApplication>
+
 #include "UI/Dashboard.h"
+#include "UI/HistorySnapshot.h"
 
-#include "SIMD/SIMD.h"
 #include "IO/Manager.h"
 #include "CSV/Player.h"
+#include "CSV/Reference.h"
 #include "MQTT/Client.h"
+#include "Plugins/Viewer.h"
 #include "Misc/TimerEvents.h"
 #include "Misc/ThemeManager.h"
 #include "JSON/FrameBuilder.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/OverloadController.h"
+#include "Misc/Trace.h"
+
+//------------------------------------------------------------------------------
+// Widget refresh classes
+//------------------------------------------------------------------------------
+
+/**
+ * Minimum time (in milliseconds) between two updates of a widget, slightly
+ * below the nominal 30 Hz & 2 Hz periods to absorb the jitter of the UI timer.
+ */
+static constexpr qint64 kNormalRefreshInterval = 30;
+static constexpr qint64 kLowRefreshInterval = 450;
+
+/**
+ * @brief Returns the minimum time between two updates of a widget with the
+ *        given refresh class.
+ */
+static qint64 refreshInterval(const SerialStudio::RefreshClass refresh)
+{
+  switch (refresh)
+  {
+    case SerialStudio::RefreshRealtime:
+      return 0;
+    case SerialStudio::RefreshLow:
+      return kLowRefreshInterval;
+    default:
+      return kNormalRefreshInterval;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Plot time axis
+//------------------------------------------------------------------------------
+
+/**
+ * Range (in seconds) of the time window displayed by plots with a time axis.
+ */
+static constexpr qreal kMinTimeWindow = 0.1;
+static constexpr qreal kMaxTimeWindow = 86400;
+
+/**
+ * Maximum time (in seconds) by which plots can be scrolled back.
+ */
+static constexpr qreal kMaxTimeOffset = 7 * 86400;
+
+//------------------------------------------------------------------------------
+// Widget identities
+//------------------------------------------------------------------------------
+
+/**
+ * Separator of the parts of a widget or history identity, which can't be
+ * typed in a project title.
+ */
+static const QChar kKeySeparator(0x1F);
+
+/**
+ * @brief Returns the identity of a dashboard widget, built from its type and
+ *        the titles of the group (and dataset) that it displays.
+ *
+ * Identities do not depend on the position of the group or dataset in the
+ * frame, so widgets keep them when the project is edited. Widgets with the
+ * same type & titles are told apart by the number of times that the identity
+ * was already registered in @a occurrences.
+ */
+static QString widgetKey(const SerialStudio::DashboardWidget widget,
+                         const QString &group, const QString &dataset,
+                         QHash<QString, int> &occurrences)
+{
+  const QStringList parts = {QString::number(widget), group, dataset};
+  auto key = parts.join(kKeySeparator);
+  const auto occurrence = occurrences[key]++;
+  if (occurrence > 0)
+    key += kKeySeparator + QString::number(occurrence);
+
+  return key;
+}
+
+/**
+ * @brief Returns the identity of a group widget, which also depends on the
+ *        number of datasets of the group, since group widgets build their
+ *        layout (curves, bars, LEDs...) from them.
+ */
+static QString widgetKey(const SerialStudio::DashboardWidget widget,
+                         const QString &group, const int datasets,
+                         QHash<QString, int> &occurrences)
+{
+  return widgetKey(widget, group, QString::number(datasets), occurrences);
+}
+
+/**
+ * Interval at which the plot histories are saved to the history snapshot
+ * while a device is connected, in seconds.
+ */
+static constexpr int kSnapshotInterval = 30;
+
+/**
+ * @brief Returns the identity of the project whose plot histories are saved
+ *        to the history snapshot: the path of the project file, or the
+ *        operation mode if the frames are not described by a project.
+ */
+static QString historyProject()
+{
+  const auto &builder = JSON::FrameBuilder::instance();
+  if (builder.operationMode() == SerialStudio::ProjectFile)
+    return builder.jsonMapFilepath();
+
+  return QString::number(static_cast<int>(builder.operationMode()));
+}
+
+/**
+ * @brief Returns the identity of the sample history of a dataset, built from
+ *        its frame index & the titles of the dataset and of its group.
+ */
+static QString historyKey(const JSON::Group &group,
+                          const JSON::Dataset &dataset)
+{
+  const QStringList parts
+      = {QString::number(dataset.index()), group.title(), dataset.title()};
+  return parts.join(kKeySeparator);
+}
 
 //------------------------------------------------------------------------------
 // UI::Dashboard implementation
@@ -44,16 +170,43 @@ UI::Dashboard::Dashboard()
   , m_precision(2)
   , m_widgetCount(0)
   , m_showLegends(true)
+  , m_timeAxis(false)
+  , m_timeWindow(10)
+  , m_timeOffset(0)
+  , m_triggerEnabled(false)
+  , m_triggerSource(0)
+  , m_triggerPosition(10)
+  , m_triggerLevel(0)
+  , m_captureCount(0)
+  , m_triggerEdge(SerialStudio::TriggerRisingEdge)
+  , m_valuesChanged(false)
   , m_updateRequired(false)
+  , m_deferredUpdates(false)
+  , m_frameReadPending(false)
+  , m_restoreHistory(false)
+  , m_snapshotTicks(0)
+  , m_frameConsumer(-1)
+  , m_decimationCount(0)
+  , m_updateCount(0)
+  , m_pendingArrival(0)
+  , m_pendingFrames(0)
+  , m_renderArrival(0)
+  , m_renderFrames(0)
   , m_axisVisibility(SerialStudio::AxisXY)
 {
   // clang-format off
   connect(&CSV::Player::instance(), &CSV::Player::openChanged, this, [=] { resetData(); });
-  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this, [=] { resetData(); });
-  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::jsonFileMapChanged, this, [=] { resetData(); });
-  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged, this, &UI::Dashboard::processFrame, Qt::QueuedConnection);
+  connect(&IO::Manager::instance(), &IO::Manager::connectedChanged, this, &UI::Dashboard::onConnectedChanged);
+  connect(&Plugins::Viewer::instance(), &Plugins::Viewer::connectedChanged, this, [=] { resetData(); });
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::jsonFileMapChanged, this, &UI::Dashboard::onProjectChanged);
+  connect(&JSON::FrameBuilder::instance(), &JSON::FrameBuilder::frameChanged, this, &UI::Dashboard::scheduleFrameRead);
   // clang-format on
 
+  // Read every frame from the frame bus, losing the oldest ones on stalls
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  m_frameConsumer = bus.addConsumer(JSON::FrameBus::Policy::DropOldest);
+  bus.attach(m_frameConsumer);
+
   // Reset dashboard data if MQTT client is subscribed
   connect(
       &MQTT::Client::instance(), &MQTT::Client::connectedChanged, this, [=] {
@@ -65,15 +218,31 @@ UI::Dashboard::Dashboard()
           resetData();
       });
 
-  // Update the dashboard widgets at 24 Hz
-  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout24Hz, this,
+  // Update the dashboard widgets at the UI refresh rate
+  m_refreshClock.start();
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi, this,
+          &UI::Dashboard::updateWidgets);
+
+  // Report the memory used by the plot histories once per second
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &UI::Dashboard::reportMemoryUsage);
+
+  // Save the plot histories periodically while a device is connected
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
           [=] {
-            if (m_updateRequired)
+            if (++m_snapshotTicks >= kSnapshotInterval)
             {
-              m_updateRequired = false;
-              Q_EMIT updated();
+              m_snapshotTicks = 0;
+              if (IO::Manager::instance().connected())
+                saveHistorySnapshot();
             }
           });
+
+  // Save the plot histories before the application quits
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [=] {
+    if (IO::Manager::instance().connected())
+      saveHistorySnapshot();
+  });
 }
 
 /**
@@ -170,6 +339,16 @@ bool UI::Dashboard::showLegends() const
   return m_showLegends;
 }
 
+/**
+ * @brief Indicates whether plots use the acquisition time of each sample as
+ *        their X axis, instead of the sample index.
+ * @return True if plots have a time axis.
+ */
+bool UI::Dashboard::timeAxis() const
+{
+  return m_timeAxis;
+}
+
 /**
  * @brief Determines if the point-selector widget should be visible based on the
  *        presence of relevant widget groups or datasets.
@@ -178,8 +357,8 @@ bool UI::Dashboard::showLegends() const
  */
 bool UI::Dashboard::pointsWidgetVisible() const
 {
-  return m_widgetGroups.contains(SerialStudio::DashboardMultiPlot)
-         || m_widgetDatasets.contains(SerialStudio::DashboardPlot);
+  return !m_widgetGroups[SerialStudio::DashboardMultiPlot].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardPlot].isEmpty();
 }
 
 /**
@@ -190,12 +369,12 @@ bool UI::Dashboard::pointsWidgetVisible() const
  */
 bool UI::Dashboard::precisionWidgetVisible() const
 {
-  return m_widgetGroups.contains(SerialStudio::DashboardAccelerometer)
-         || m_widgetGroups.contains(SerialStudio::DashboardGyroscope)
-         || m_widgetGroups.contains(SerialStudio::DashboardDataGrid)
-         || m_widgetDatasets.contains(SerialStudio::DashboardBar)
-         || m_widgetDatasets.contains(SerialStudio::DashboardGauge)
-         || m_widgetDatasets.contains(SerialStudio::DashboardCompass);
+  return !m_widgetGroups[SerialStudio::DashboardAccelerometer].isEmpty()
+         || !m_widgetGroups[SerialStudio::DashboardGyroscope].isEmpty()
+         || !m_widgetGroups[SerialStudio::DashboardDataGrid].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardBar].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardGauge].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardCompass].isEmpty();
 }
 
 /**
@@ -206,9 +385,10 @@ bool UI::Dashboard::precisionWidgetVisible() const
  */
 bool UI::Dashboard::axisOptionsWidgetVisible() const
 {
-  return m_widgetGroups.contains(SerialStudio::DashboardMultiPlot)
-         || m_widgetDatasets.contains(SerialStudio::DashboardPlot)
-         || m_widgetDatasets.contains(SerialStudio::DashboardFFT);
+  return !m_widgetGroups[SerialStudio::DashboardMultiPlot].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardPlot].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardFFT].isEmpty()
+         || !m_widgetDatasets[SerialStudio::DashboardWaterfall].isEmpty();
 }
 
 /**
@@ -256,6 +436,94 @@ int UI::Dashboard::totalWidgetCount() const
   return m_widgetCount;
 }
 
+/**
+ * @brief Returns the list model of the widgets displayed by the dashboard
+ *        grid, which only inserts & removes the widgets that changed when the
+ *        structure of the frames changes.
+ */
+UI::DashboardModel *UI::Dashboard::widgetModel()
+{
+  return &m_widgetModel;
+}
+
+/**
+ * @brief Gets the length of the time window displayed by plots with a time
+ *        axis.
+ * @return The time window, in seconds.
+ */
+qreal UI::Dashboard::timeWindow() const
+{
+  return m_timeWindow;
+}
+
+/**
+ * @brief Gets the time between the end of the window displayed by plots with
+ *        a time axis & the newest sample.
+ * @return The scrollback offset, in seconds (0 displays the newest data).
+ */
+qreal UI::Dashboard::timeOffset() const
+{
+  return m_timeOffset;
+}
+
+/**
+ * @brief Checks if the plots display triggered captures instead of their
+ *        scrolling history.
+ * @return True if the plot trigger is enabled.
+ */
+bool UI::Dashboard::triggerEnabled() const
+{
+  return m_triggerEnabled;
+}
+
+/**
+ * @brief Gets the index of the plot whose dataset triggers the captures.
+ * @return The index of the trigger source, relative to the linear plots.
+ */
+int UI::Dashboard::triggerSource() const
+{
+  return m_triggerSource;
+}
+
+/**
+ * @brief Gets the position of the trigger sample within the captures.
+ * @return The percentage of the capture that precedes the trigger sample.
+ */
+int UI::Dashboard::triggerPosition() const
+{
+  return m_triggerPosition;
+}
+
+/**
+ * @brief Gets the level that the trigger source must cross to start a
+ *        capture.
+ * @return The trigger level.
+ */
+qreal UI::Dashboard::triggerLevel() const
+{
+  return m_triggerLevel;
+}
+
+/**
+ * @brief Gets the number of samples of each capture before the trigger
+ *        sample, used as the origin of the X axis of triggered plots.
+ * @return The number of pre-trigger samples.
+ */
+qsizetype UI::Dashboard::pretriggerSamples() const
+{
+  return m_trigger.pretrigger();
+}
+
+/**
+ * @brief Gets the direction in which the trigger source must cross the
+ *        trigger level.
+ * @return The trigger edge.
+ */
+SerialStudio::TriggerEdge UI::Dashboard::triggerEdge() const
+{
+  return m_triggerEdge;
+}
+
 /**
  * @brief Checks if the current frame is valid for processing.
  * @return True if the current frame is valid; false otherwise.
@@ -300,18 +568,18 @@ SerialStudio::DashboardWidget UI::Dashboard::widgetType(const int widgetIndex)
  * @brief Counts the number of instances of a specified widget type within the
  *        dashboard.
  *
+ * Group widget types have no datasets in the dataset table & vice versa, so
+ * the count is obtained with two array lookups.
+ *
  * @param widget The type of widget to count.
  * @return The count of instances for the specified widget type.
  */
 int UI::Dashboard::widgetCount(const SerialStudio::DashboardWidget widget) const
 {
-  if (SerialStudio::isGroupWidget(widget))
-    return m_widgetGroups.value(widget).count();
-
-  else if (SerialStudio::isDatasetWidget(widget))
-    return m_widgetDatasets.value(widget).count();
+  if (widget < 0 || widget >= SerialStudio::DashboardNoWidget)
+    return 0;
 
-  return 0;
+  return m_widgetGroups[widget].count() + m_widgetDatasets[widget].count();
 }
 
 /**
@@ -344,19 +612,19 @@ QStringList
 UI::Dashboard::widgetColors(const SerialStudio::DashboardWidget widget)
 {
   QStringList list;
+  const auto &theme = Misc::ThemeManager::instance();
 
   if (SerialStudio::isDatasetWidget(widget)
-      && m_widgetDatasets.contains(widget))
+      && !m_widgetDatasets[widget].isEmpty())
   {
-    for (const auto &dataset : m_widgetDatasets[widget])
-      list.append(SerialStudio::getDatasetColor(dataset.index()));
+    const auto &datasets = m_widgetDatasets[widget];
+    list.reserve(datasets.count());
+    for (const auto &dataset : datasets)
+      list.append(theme.datasetColorName(dataset.index()));
   }
 
   if (list.isEmpty())
-  {
-    const auto colors = Misc::ThemeManager::instance().colors();
-    list.append(colors["switch_highlight"].toString());
-  }
+    list.append(theme.colors()["switch_highlight"].toString());
 
   return list;
 }
@@ -448,6 +716,19 @@ QStringList UI::Dashboard::actionTitles() const
   return titles;
 }
 
+/**
+ * @brief Indicates which actions are being sent periodically.
+ * @return A list with one boolean for each action available on the dashboard.
+ */
+QVariantList UI::Dashboard::activeActions() const
+{
+  QVariantList active;
+  for (int i = 0; i < m_actions.count(); ++i)
+    active.append(m_activeActions.contains(i));
+
+  return active;
+}
+
 /**
  * @brief Provides access to a specific group widget based on widget type and
  *        relative index.
@@ -461,6 +742,7 @@ const JSON::Group &
 UI::Dashboard::getGroupWidget(const SerialStudio::DashboardWidget widget,
                               const int index) const
 {
+  Q_ASSERT(widget >= 0 && widget < SerialStudio::DashboardNoWidget);
   Q_ASSERT(index >= 0 && index < m_widgetGroups[widget].count());
   return m_widgetGroups[widget].at(index);
 }
@@ -478,6 +760,7 @@ const JSON::Dataset &
 UI::Dashboard::getDatasetWidget(const SerialStudio::DashboardWidget widget,
                                 const int index) const
 {
+  Q_ASSERT(widget >= 0 && widget < SerialStudio::DashboardNoWidget);
   Q_ASSERT(index >= 0 && index < m_widgetDatasets[widget].count());
   return m_widgetDatasets[widget].at(index);
 }
@@ -492,36 +775,170 @@ const JSON::Frame &UI::Dashboard::currentFrame()
 }
 
 /**
- * @brief Provides the FFT plot values currently displayed on the dashboard.
- * @return A reference to a QVector containing the FFT Curve data.
+ * @brief Provides the acquisition timestamps of the dataset histories.
+ *
+ * Every dataset history receives one sample per frame, so the timeline is
+ * shared by all of them. It is as long as the longest history, and histories
+ * are aligned with it by their newest sample.
+ *
+ * @return The timeline of the dataset history samples.
+ */
+const Timeline &UI::Dashboard::historyTimeline() const
+{
+  return m_historyTimeline;
+}
+
+/**
+ * @brief Provides the sample history of the dataset displayed by a linear
+ *        plot, FFT plot or waterfall widget.
+ *
+ * Widgets that display the same dataset share a single history, which is as
+ * long as required by its most demanding widget, so widgets should only read
+ * the newest samples that they need from it.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The read-only history, or @c nullptr if it has not been created.
+ */
+const Curve *
+UI::Dashboard::datasetHistory(const SerialStudio::DashboardWidget widget,
+                              const int index) const
+{
+  const auto indexes = m_historyIndexes.constFind(widget);
+  if (indexes == m_historyIndexes.constEnd() || index < 0
+      || index >= indexes->count())
+    return nullptr;
+
+  return &m_datasetHistories[indexes->at(index)];
+}
+
+/**
+ * @brief Provides the multi-resolution history of the dataset displayed by a
+ *        linear plot, used to plot time windows that are longer than the
+ *        sample history of the dataset.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The read-only history, or @c nullptr if it has not been created.
+ */
+const HistoryTiers *
+UI::Dashboard::datasetTiers(const SerialStudio::DashboardWidget widget,
+                            const int index) const
+{
+  const auto indexes = m_historyIndexes.constFind(widget);
+  if (indexes == m_historyIndexes.constEnd() || index < 0
+      || index >= indexes->count())
+    return nullptr;
+
+  return &m_datasetTiers[indexes->at(index)];
+}
+
+/**
+ * @brief Provides the last triggered capture of the dataset displayed by a
+ *        linear plot.
+ *
+ * A capture holds @c points() + 1 samples, aligned so that the trigger sample
+ * is at index @c pretriggerSamples().
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The read-only capture, or @c nullptr if the trigger is disabled.
+ */
+const Curve *
+UI::Dashboard::triggerCapture(const SerialStudio::DashboardWidget widget,
+                              const int index) const
+{
+  const auto indexes = m_historyIndexes.constFind(widget);
+  if (indexes == m_historyIndexes.constEnd() || index < 0
+      || index >= indexes->count())
+    return nullptr;
+
+  const auto history = indexes->at(index);
+  if (history >= m_triggerCaptures.count())
+    return nullptr;
+
+  return &m_triggerCaptures[history];
+}
+
+/**
+ * @brief Provides the reference overlay of the dataset displayed by a linear
+ *        plot, which has the same length & timeline as its history.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The read-only overlay, or @c nullptr if no reference is open.
+ */
+const Curve *
+UI::Dashboard::referenceHistory(const SerialStudio::DashboardWidget widget,
+                                const int index) const
+{
+  const auto indexes = m_historyIndexes.constFind(widget);
+  if (indexes == m_historyIndexes.constEnd() || index < 0
+      || index >= indexes->count())
+    return nullptr;
+
+  const auto history = indexes->at(index);
+  if (history >= m_referenceHistories.count()
+      || m_referenceHistories[history].isEmpty())
+    return nullptr;
+
+  return &m_referenceHistories[history];
+}
+
+/**
+ * @brief Provides the reference overlay of the last triggered capture of the
+ *        dataset displayed by a linear plot.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The read-only overlay, or @c nullptr if there is none.
  */
-const QVector<Curve> &UI::Dashboard::fftPlotValues()
+const Curve *
+UI::Dashboard::referenceCapture(const SerialStudio::DashboardWidget widget,
+                                const int index) const
 {
-  return m_fftPlotValues;
+  const auto indexes = m_historyIndexes.constFind(widget);
+  if (indexes == m_historyIndexes.constEnd() || index < 0
+      || index >= indexes->count())
+    return nullptr;
+
+  const auto history = indexes->at(index);
+  if (history >= m_referenceCaptures.count()
+      || m_referenceCaptures[history].isEmpty())
+    return nullptr;
+
+  return &m_referenceCaptures[history];
 }
 
 /**
- * @brief Provides the linear plot values currently displayed on the dashboard.
- * @return A reference to a QVector containing the linear Curve data.
+ * @brief Provides the reference overlay of the curves of a multiplot.
+ *
+ * @param index The index of the multiplot.
+ * @return The read-only overlay, or @c nullptr if no reference is open.
  */
-const QVector<Curve> &UI::Dashboard::linearPlotValues()
+const MultipleCurves *UI::Dashboard::multiplotReference(const int index) const
 {
-  return m_linearPlotValues;
+  if (index < 0 || index >= m_multiplotReferences.count())
+    return nullptr;
+
+  return &m_multiplotReferences[index];
 }
 
 /**
  * @brief Provides the values for multiplot visuals on the dashboard.
- * @return A reference to a QVector containing MultipleCurves data.
+ * @return A read-only span over the MultipleCurves data.
  */
-const QVector<MultipleCurves> &UI::Dashboard::multiplotValues()
+QSpan<const MultipleCurves> UI::Dashboard::multiplotValues() const
 {
   return m_multiplotValues;
 }
 
 /**
  * @brief Sets the number of data points displayed in the dashboard plots.
- *        Clears existing multiplot and linear plot values and emits the
- *        @c pointsChanged signal.
+ *
+ * The dataset histories & multiplot curves are resized in place, keeping
+ * their newest samples, so that the plots do not lose the data that is
+ * being inspected. Each history is reallocated once.
  *
  * @param points The new point/sample count.
  */
@@ -530,27 +947,186 @@ void UI::Dashboard::setPoints(const int points)
   if (m_points != points)
   {
     m_points = points;
-    m_multiplotValues.clear();
-    m_linearPlotValues.clear();
-    m_multiplotValues.squeeze();
-    m_linearPlotValues.squeeze();
+    if (m_currentFrame.isValid())
+    {
+      initializeHistories(m_currentFrame);
+      initializeMultiplots();
+    }
 
     Q_EMIT pointsChanged();
   }
 }
 
+/**
+ * @brief Enables or disables the time axis of the dashboard plots.
+ *
+ * With a time axis, plots display the samples acquired within the last
+ * @c timeWindow() seconds, at their acquisition time. The number of raw
+ * samples kept in memory is still bounded by @c points(), older parts of the
+ * window are drawn from the 1 s, 10 s & 1 min aggregates of the datasets
+ * (see @c HistoryTiers).
+ *
+ * @param enabled True to use the acquisition time as the X axis.
+ */
+void UI::Dashboard::setTimeAxis(const bool enabled)
+{
+  if (m_timeAxis != enabled)
+  {
+    m_timeAxis = enabled;
+    Q_EMIT timeAxisChanged();
+  }
+}
+
+/**
+ * @brief Sets the length of the time window displayed by plots with a time
+ *        axis.
+ * @param seconds The new time window, in seconds.
+ */
+void UI::Dashboard::setTimeWindow(const qreal seconds)
+{
+  const auto window = qBound(kMinTimeWindow, seconds, kMaxTimeWindow);
+  if (!qFuzzyCompare(m_timeWindow, window))
+  {
+    m_timeWindow = window;
+    Q_EMIT timeWindowChanged();
+  }
+}
+
+/**
+ * @brief Scrolls the plots with a time axis back through the session.
+ *
+ * Older parts of the session are read from the history tiers of the plotted
+ * datasets, which are kept in the on-disk history store once they no longer
+ * fit in RAM.
+ *
+ * @param seconds Time between the end of the plotted window & the newest
+ *                sample, 0 displays the newest data.
+ */
+void UI::Dashboard::setTimeOffset(const qreal seconds)
+{
+  const auto offset = qBound<qreal>(0, seconds, kMaxTimeOffset);
+  if (!qFuzzyCompare(m_timeOffset + 1, offset + 1))
+  {
+    m_timeOffset = offset;
+    Q_EMIT timeOffsetChanged();
+  }
+}
+
+/**
+ * @brief Enables or disables the oscilloscope-style trigger of the plots.
+ *
+ * While the trigger is enabled, linear plots are only updated when a capture
+ * is complete, and display the aligned capture instead of their scrolling
+ * history, which gives a stable display of periodic signals.
+ *
+ * @param enabled True to display triggered captures.
+ */
+void UI::Dashboard::setTriggerEnabled(const bool enabled)
+{
+  if (m_triggerEnabled != enabled)
+  {
+    m_triggerEnabled = enabled;
+    configureTrigger();
+    Q_EMIT triggerChanged();
+  }
+}
+
+/**
+ * @brief Selects the plot whose dataset triggers the captures.
+ * @param index The index of the plot, relative to the linear plots.
+ */
+void UI::Dashboard::setTriggerSource(const int index)
+{
+  if (m_triggerSource != index)
+  {
+    m_triggerSource = qMax(0, index);
+    configureTrigger();
+    Q_EMIT triggerChanged();
+  }
+}
+
+/**
+ * @brief Changes the level that the trigger source must cross.
+ * @param level The new trigger level.
+ */
+void UI::Dashboard::setTriggerLevel(const qreal level)
+{
+  if (!qFuzzyCompare(m_triggerLevel + 1, level + 1))
+  {
+    m_triggerLevel = level;
+    configureTrigger();
+    Q_EMIT triggerChanged();
+  }
+}
+
+/**
+ * @brief Changes the position of the trigger sample within the captures.
+ * @param percent The percentage of the capture before the trigger sample.
+ */
+void UI::Dashboard::setTriggerPosition(const int percent)
+{
+  const auto position = qBound(0, percent, 100);
+  if (m_triggerPosition != position)
+  {
+    m_triggerPosition = position;
+    configureTrigger();
+    Q_EMIT triggerChanged();
+  }
+}
+
+/**
+ * @brief Changes the direction in which the trigger source must cross the
+ *        trigger level.
+ * @param edge The new trigger edge.
+ */
+void UI::Dashboard::setTriggerEdge(const SerialStudio::TriggerEdge edge)
+{
+  if (m_triggerEdge != edge)
+  {
+    m_triggerEdge = edge;
+    configureTrigger();
+    Q_EMIT triggerChanged();
+  }
+}
+
 /**
  * @brief Activates an action by sending its associated data via the IO Manager.
+ *
+ * Actions with a repeat interval are toggled instead: the IO Manager sends
+ * their data periodically from its action scheduler thread until the action
+ * is activated again, or until the device is disconnected.
+ *
  * @param index The index of the action to activate.
- * @throws An assertion failure if the index is out of bounds.
  */
 void UI::Dashboard::activateAction(const int index)
 {
   if (index >= 0 && index < m_actions.count())
   {
+    // Send the pre-encoded data of single-shot actions
+    auto &manager = IO::Manager::instance();
     const auto &action = m_actions[index];
-    const auto &data = action.txData() + action.eolSequence();
-    IO::Manager::instance().writeData(data.toUtf8());
+    if (action.repeatInterval() <= 0)
+    {
+      manager.writeData(action.txBytes());
+      return;
+    }
+
+    // Stop a periodic action
+    if (m_activeActions.contains(index))
+    {
+      m_activeActions.remove(index);
+      manager.stopPeriodicWrite(index);
+    }
+
+    // Start a periodic action
+    else if (manager.connected())
+    {
+      m_activeActions.insert(index);
+      manager.startPeriodicWrite(index, action.txBytes(),
+                                 action.repeatInterval());
+    }
+
+    Q_EMIT activeActionsChanged();
   }
 }
 
@@ -592,25 +1168,46 @@ void UI::Dashboard::setShowLegends(const bool enabled)
 void UI::Dashboard::resetData(const bool notify)
 {
   // Clear plotting data
-  m_fftPlotValues.clear();
+  m_restoreHistory = false;
   m_multiplotValues.clear();
-  m_linearPlotValues.clear();
-  m_fftPlotValues.squeeze();
+  m_historyIndexes.clear();
+  m_historySources.clear();
+  m_historyKeys.clear();
+  m_multiplotKeys.clear();
+  m_datasetHistories.clear();
+  m_datasetTiers.clear();
+  m_tieredHistories.clear();
+  m_historyStore.close();
+  m_triggerCaptures.clear();
+  m_referenceHistories.clear();
+  m_referenceCaptures.clear();
+  m_multiplotReferences.clear();
   m_multiplotValues.squeeze();
-  m_linearPlotValues.squeeze();
+  m_historySources.squeeze();
+  m_datasetHistories.squeeze();
+  m_datasetTiers.squeeze();
+  m_historyTimeline.resize(0);
 
   // Clear widget & action structures
   m_widgetCount = 0;
+  stopPeriodicActions();
   m_actions.clear();
   m_actions.squeeze();
   m_widgetMap.clear();
-  m_widgetGroups.clear();
-  m_widgetDatasets.clear();
+  m_widgetGroups = {};
+  m_widgetDatasets = {};
+  m_widgetKeys.clear();
+  m_groupSources.clear();
+  m_datasetSources.clear();
   m_widgetVisibility.clear();
   m_availableWidgets.clear();
+  m_widgetModel.setKeys(QStringList());
 
   // Reset frame data
   m_currentFrame = JSON::Frame();
+  m_pendingArrival = 0;
+  m_pendingFrames = 0;
+  m_valuesChanged = false;
 
   // Notify user interface
   if (notify)
@@ -662,93 +1259,571 @@ void UI::Dashboard::setWidgetVisible(const SerialStudio::DashboardWidget widget,
 }
 
 /**
- * @brief Updates plot data for linear, FFT, and multiplot widgets on the
- *        dashboard.
+ * @brief Copies the latest frame to the widget groups & datasets and notifies
+ *        the widgets, called once per UI refresh tick.
  *
- * This function checks and initializes the data structures for each plot type
- * (linear plots, FFT plots, and multiplots) if needed.
- *
- * It then appends the latest values from the data sources to these plots by
- * shifting older data back and adding new data to the end.
+ * Frames received between two ticks only append their values to the plot
+ * histories, the (relatively expensive) widget copies and signal emission
+ * are done here only for the most recent frame.
  */
-void UI::Dashboard::updatePlots()
+void UI::Dashboard::updateWidgets()
 {
-  // Check if we need to re-initialize linear plots data
-  if (m_linearPlotValues.count() != widgetCount(SerialStudio::DashboardPlot))
+  TRACE_ZONE("Dashboard::updateWidgets");
+
+  if (m_updateRequired)
   {
-    m_linearPlotValues.clear();
-    m_linearPlotValues.squeeze();
-    for (int i = 0; i < widgetCount(SerialStudio::DashboardPlot); ++i)
+    // In low-power mode, plots are only redrawn if new values were received
+    if (m_valuesChanged || !Misc::TimerEvents::instance().lowPowerMode())
+      ++m_updateCount;
+
+    m_valuesChanged = false;
+    m_updateRequired = false;
+    updateWidgetValues(m_currentFrame);
+
+    // Hand the oldest unrendered arrival time over to the render thread
+    if (m_pendingArrival > 0)
     {
-      m_linearPlotValues.append(Curve());
-      m_linearPlotValues.last().resize(points() + 1);
-      SIMD::fill<qreal>(m_linearPlotValues.last().data(), points() + 1, 0);
+      qint64 expected = 0;
+      m_renderArrival.compare_exchange_strong(expected, m_pendingArrival);
+      m_renderFrames.fetch_add(m_pendingFrames);
+      m_pendingArrival = 0;
+      m_pendingFrames = 0;
     }
+
+    notifyWidgets();
+    Q_EMIT updated();
   }
 
-  // Check if we need to re-initialize FFT plots data
-  if (m_fftPlotValues.count() != widgetCount(SerialStudio::DashboardFFT))
+  // Update the widgets whose refresh interval had not elapsed yet
+  else if (m_deferredUpdates)
+    notifyWidgets();
+}
+
+/**
+ * @brief Handles changes to the loaded project file.
+ *
+ * While a device is connected or a CSV file is being played, the dashboard is
+ * kept as-is and the next frame (built with the modified project) is diffed
+ * against it, so that only the widgets affected by the changes are created
+ * or destroyed. Otherwise, the dashboard data is reset.
+ */
+void UI::Dashboard::onProjectChanged()
+{
+  if (IO::Manager::instance().connected() || CSV::Player::instance().isOpen())
+    return;
+
+  resetData();
+}
+
+/**
+ * @brief Resets the dashboard when a device is connected or disconnected.
+ *
+ * The plot histories are saved to the history snapshot before they are
+ * cleared on disconnection, and restored from it with the first frame
+ * received after connecting, if the same project is used.
+ */
+void UI::Dashboard::onConnectedChanged()
+{
+  if (IO::Manager::instance().connected())
+  {
+    resetData();
+    m_snapshotTicks = 0;
+    m_restoreHistory = true;
+  }
+
+  else
   {
-    m_fftPlotValues.clear();
-    m_fftPlotValues.squeeze();
-    for (int i = 0; i < widgetCount(SerialStudio::DashboardFFT); ++i)
+    saveHistorySnapshot();
+    resetData();
+  }
+}
+
+/**
+ * @brief Writes the plot histories of the connected device to the history
+ *        snapshot (see @c UI::HistorySnapshot).
+ *
+ * Frames played from a CSV file are not saved, since the file can be replayed
+ * at any time.
+ */
+void UI::Dashboard::saveHistorySnapshot()
+{
+  if (m_historyKeys.isEmpty() || CSV::Player::instance().isOpen())
+    return;
+
+  (void)UI::HistorySnapshot::save(historyProject(), m_historyKeys,
+                                  m_datasetHistories, m_historyTimeline);
+}
+
+/**
+ * @brief Reports the memory used by the plot histories of the dashboard.
+ */
+void UI::Dashboard::reportMemoryUsage()
+{
+  qint64 bytes = 0;
+  bytes += m_historyTimeline.memoryUsage();
+  for (const auto &curve : std::as_const(m_datasetHistories))
+    bytes += curve.memoryUsage();
+  for (const auto &tiers : std::as_const(m_datasetTiers))
+    bytes += tiers.memoryUsage();
+  for (const auto &capture : std::as_const(m_triggerCaptures))
+    bytes += capture.memoryUsage();
+  for (const auto &curves : std::as_const(m_multiplotValues))
+    bytes += curves.memoryUsage();
+  for (const auto &curve : std::as_const(m_referenceHistories))
+    bytes += curve.memoryUsage();
+  for (const auto &capture : std::as_const(m_referenceCaptures))
+    bytes += capture.memoryUsage();
+  for (const auto &curves : std::as_const(m_multiplotReferences))
+    bytes += curves.memoryUsage();
+
+  Misc::PipelineStats::instance().setMemoryUsage(
+      Misc::PipelineStats::DashboardCurves, bytes);
+}
+
+/**
+ * @brief Records the end-to-end latency of the frames shown on screen.
+ *
+ * Connected (directly) to the @c frameSwapped() signal of the application
+ * windows, so it runs on the render thread right after a new image has been
+ * presented. The measured latency is the time between the arrival of the
+ * oldest frame that made it into this image and the buffer swap, which is the
+ * worst case delay experienced by the user.
+ */
+void UI::Dashboard::onFrameSwapped()
+{
+  const auto arrival = m_renderArrival.exchange(0);
+  if (arrival <= 0)
+    return;
+
+  const auto frames = m_renderFrames.exchange(0);
+  auto &stats = Misc::PipelineStats::instance();
+  stats.record(Misc::PipelineStats::EndToEnd, qMax<qint64>(frames, 1), 0,
+               stats.timestamp() - arrival);
+}
+
+/**
+ * @brief Creates one sample history for every dataset that is displayed by a
+ *        linear plot, FFT plot or waterfall widget.
+ *
+ * Widgets that display the same dataset (identified by its index) share the
+ * same history, which is sized for the widget that needs the most samples:
+ * @c points() + 1 samples for linear plots and the FFT window size for FFT &
+ * waterfall plots. Each widget is mapped to its history in
+ * @c m_historyIndexes.
+ *
+ * The histories of the datasets displayed by linear plots also get a
+ * multi-resolution history, which allows plots with a time axis to display
+ * windows of up to 24 hours with bounded memory. Their oldest buckets are
+ * moved to the on-disk history store, so that plots can scroll back through
+ * the whole session.
+ *
+ * The histories (and multi-resolution histories) of the datasets that were
+ * already displayed before the call are kept, identified by @c historyKey(),
+ * so editing a project does not clear the plots of the unchanged datasets.
+ * Resized histories keep their newest samples.
+ *
+ * With the first frame received after connecting a device, the histories are
+ * taken from the history snapshot saved by the previous connection to the
+ * same project, so the plots continue where they stopped.
+ *
+ * @param frame The frame whose values are about to be appended.
+ */
+void UI::Dashboard::initializeHistories(const JSON::Frame &frame)
+{
+  // Continue the histories of the previous connection to the same project
+  if (m_restoreHistory && m_historyKeys.isEmpty())
+    (void)UI::HistorySnapshot::load(historyProject(), m_historyKeys,
+                                    m_datasetHistories, m_historyTimeline);
+
+  m_restoreHistory = false;
+
+  // Take the current histories, so that they can be reused
+  QHash<QString, qsizetype> previous;
+  for (qsizetype i = 0; i < m_historyKeys.count(); ++i)
+    previous.insert(m_historyKeys[i], i);
+
+  const auto previousTimeline = m_historyTimeline;
+  const auto previousTiered = m_tieredHistories;
+  auto previousHistories = std::move(m_datasetHistories);
+  auto previousTiers = std::move(m_datasetTiers);
+
+  m_historyIndexes.clear();
+  m_historySources.clear();
+  m_historyKeys.clear();
+  m_datasetHistories.clear();
+  m_datasetTiers.clear();
+  m_tieredHistories.clear();
+
+  // Map each widget to the history of its dataset
+  QMap<int, int> histories;
+  QVector<qsizetype> sizes;
+  const auto &groups = frame.groups();
+  for (const auto &source : std::as_const(m_datasetSources))
+  {
+    qsizetype size = 0;
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    if (source.widget == SerialStudio::DashboardPlot)
+      size = points() + 1;
+    else if (source.widget == SerialStudio::DashboardFFT
+             || source.widget == SerialStudio::DashboardWaterfall)
+      size = dataset.fftSamples();
+    else
+      continue;
+
+    auto history = histories.value(dataset.index(), -1);
+    if (history < 0)
+    {
+      history = int(m_historySources.count());
+      histories.insert(dataset.index(), history);
+      m_historySources.append({source.group, source.dataset});
+      m_historyKeys.append(historyKey(groups[source.group], dataset));
+      sizes.append(0);
+    }
+
+    auto &indexes = m_historyIndexes[source.widget];
+    if (indexes.count() <= source.index)
+      indexes.resize(source.index + 1);
+
+    indexes[source.index] = history;
+    sizes[history] = qMax(sizes[history], size);
+    if (source.widget == SerialStudio::DashboardPlot
+        && !m_tieredHistories.contains(history))
+      m_tieredHistories.append(history);
+  }
+
+  // Allocate the histories, reusing the ones of unchanged datasets
+  qsizetype longest = 0;
+  m_datasetHistories.reserve(sizes.count());
+  for (qsizetype i = 0; i < sizes.count(); ++i)
+  {
+    const auto size = sizes[i];
+    const auto old = previous.value(m_historyKeys[i], -1);
+    if (old >= 0 && previousHistories[old].count() == size)
+      m_datasetHistories.append(std::move(previousHistories[old]));
+
+    else
+    {
+      Curve curve(size);
+      if (old >= 0)
+        curve.copyNewest(previousHistories[old]);
+
+      m_datasetHistories.append(std::move(curve));
+    }
+
+    longest = qMax(longest, size);
+  }
+
+  // Allocate the timeline shared by the histories, keeping its newest times
+  m_historyTimeline.resize(longest);
+  const auto count = previousTimeline.count();
+  const auto first = count - qMin(count, longest);
+  for (auto i = first; i < count; ++i)
+    m_historyTimeline.append(previousTimeline.at(i));
+
+  // Reuse the multi-resolution histories of unchanged datasets
+  bool storeInUse = false;
+  QVector<bool> reused(sizes.count(), false);
+  m_datasetTiers.resize(sizes.count());
+  for (const auto i : std::as_const(m_tieredHistories))
+  {
+    const auto old = previous.value(m_historyKeys[i], -1);
+    if (old >= 0 && previousTiered.contains(int(old)))
+    {
+      m_datasetTiers[i] = std::move(previousTiers[old]);
+      reused[i] = true;
+      storeInUse = true;
+    }
+  }
+
+  // Start a new store if no stored buckets are used anymore
+  if (!storeInUse)
+    m_historyStore.close();
+
+  for (const auto i : std::as_const(m_tieredHistories))
+  {
+    if (!reused[i])
+      m_datasetTiers[i].setStore(&m_historyStore);
+  }
+
+  // Allocate the triggered captures
+  configureTrigger();
+}
+
+/**
+ * @brief Creates the curves of every multiplot widget.
+ *
+ * The curves of the multiplots that were already displayed (identified by the
+ * widget identity) are kept if the multiplot still has the same number of
+ * curves & samples. If only the number of samples changed, the newest
+ * samples are copied to the resized curves.
+ */
+void UI::Dashboard::initializeMultiplots()
+{
+  // Take the current curves, so that they can be reused
+  QHash<QString, qsizetype> previous;
+  const auto known = qMin(m_multiplotKeys.count(), m_multiplotValues.count());
+  for (qsizetype i = 0; i < known; ++i)
+    previous.insert(m_multiplotKeys[i], i);
+
+  auto previousValues = std::move(m_multiplotValues);
+  m_multiplotValues.clear();
+  m_multiplotKeys = m_widgetKeys.value(SerialStudio::DashboardMultiPlot);
+
+  // Create the curves of each multiplot
+  const auto count = widgetCount(SerialStudio::DashboardMultiPlot);
+  m_multiplotValues.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    const auto &group = getGroupWidget(SerialStudio::DashboardMultiPlot, i);
+    const auto curves = group.datasetCount();
+    const auto old = previous.value(m_multiplotKeys.value(i), -1);
+    if (old >= 0 && previousValues[old].curveCount() == curves
+        && previousValues[old].count() == points() + 1)
+      m_multiplotValues.append(std::move(previousValues[old]));
+
+    else
     {
-      const auto &dataset = getDatasetWidget(SerialStudio::DashboardFFT, i);
-      m_fftPlotValues.append(Curve());
-      m_fftPlotValues.last().resize(dataset.fftSamples());
-      SIMD::fill<qreal>(m_fftPlotValues.last().data(), dataset.fftSamples(), 0);
+      MultipleCurves values(curves, points() + 1);
+      if (old >= 0 && previousValues[old].curveCount() == curves)
+        values.copyNewest(previousValues[old]);
+
+      m_multiplotValues.append(std::move(values));
     }
   }
+}
+
+/**
+ * @brief Updates plot data for linear, FFT, and multiplot widgets on the
+ *        dashboard.
+ *
+ * This function checks and initializes the dataset histories (shared by the
+ * linear, FFT and waterfall plots) and the multiplot data if needed.
+ *
+ * It then appends the values of the given @a frame to these histories,
+ * reading them directly from the frame through the recorded sources, so
+ * every dataset is appended once no matter how many widgets display it. Each
+ * curve is a ring buffer, so the newest value replaces the oldest one without
+ * moving the rest of the history.
+ *
+ * @param frame The new frame, with the same structure as the current frame.
+ */
+void UI::Dashboard::updatePlots(const JSON::Frame &frame)
+{
+  // Check if we need to re-initialize the dataset histories
+  const auto plots = widgetCount(SerialStudio::DashboardPlot);
+  const auto ffts = widgetCount(SerialStudio::DashboardFFT);
+  const auto waterfalls = widgetCount(SerialStudio::DashboardWaterfall);
+  if (m_historyIndexes.value(SerialStudio::DashboardPlot).count() != plots
+      || m_historyIndexes.value(SerialStudio::DashboardFFT).count() != ffts
+      || m_historyIndexes.value(SerialStudio::DashboardWaterfall).count()
+             != waterfalls)
+    initializeHistories(frame);
 
   // Check if we need to re-initialize multiplot data
   if (m_multiplotValues.count()
       != widgetCount(SerialStudio::DashboardMultiPlot))
+    initializeMultiplots();
+
+  // Record the reference values of the plotted datasets
+  updateReferences(frame);
+
+  // Append latest values & acquisition time to the dataset histories
+  const auto &groups = frame.groups();
+  if (!m_historySources.isEmpty())
   {
-    m_multiplotValues.clear();
-    m_multiplotValues.squeeze();
-    for (int i = 0; i < widgetCount(SerialStudio::DashboardMultiPlot); ++i)
+    auto timestamp = frame.timestamp();
+    if (timestamp <= 0)
+      timestamp = Misc::PipelineStats::timestamp();
+
+    for (qsizetype i = 0; i < m_historySources.count(); ++i)
     {
-      const auto &group = getGroupWidget(SerialStudio::DashboardMultiPlot, i);
-      m_multiplotValues.append(MultipleCurves());
-      m_multiplotValues.last().resize(group.datasetCount());
-      for (int j = 0; j < group.datasetCount(); ++j)
-      {
-        m_multiplotValues[i][j].resize(points() + 1);
-        SIMD::fill<qreal>(m_multiplotValues[i][j].data(), points() + 1, 0);
-      }
+      const auto &source = m_historySources[i];
+      const auto &dataset = groups[source.group].datasets()[source.dataset];
+      m_datasetHistories[i].append(dataset.numericValue());
     }
+
+    // Aggregate the values of plotted datasets into their history tiers
+    for (const auto i : std::as_const(m_tieredHistories))
+    {
+      const auto &source = m_historySources[i];
+      const auto &dataset = groups[source.group].datasets()[source.dataset];
+      m_datasetTiers[i].append(timestamp, dataset.numericValue());
+    }
+
+    m_historyTimeline.append(timestamp);
+
+    // Evaluate the plot trigger
+    if (m_triggerEnabled)
+      updateTrigger();
   }
 
-  // Append latest values to linear plots data
-  for (int i = 0; i < widgetCount(SerialStudio::DashboardPlot); ++i)
+  // Append latest values to multiplots data
+  for (const auto &source : std::as_const(m_groupSources))
   {
-    const auto &dataset = getDatasetWidget(SerialStudio::DashboardPlot, i);
-    auto *data = m_linearPlotValues[i].data();
-    auto count = m_linearPlotValues[i].count();
-    SIMD::shift<qreal>(data, count, dataset.value().toFloat());
+    if (source.widget != SerialStudio::DashboardMultiPlot)
+      continue;
+
+    auto &curves = m_multiplotValues[source.index];
+    const auto &datasets = groups[source.group].datasets();
+    const auto count = qMin(datasets.count(), curves.curveCount());
+    m_multiplotRow.resize(count);
+    for (int j = 0; j < count; ++j)
+      m_multiplotRow[j] = datasets[j].numericValue();
+
+    curves.append(m_multiplotRow);
+  }
+}
+
+/**
+ * @brief Appends the reference values of the plotted datasets at the
+ *        acquisition time of the given @a frame to the reference overlays.
+ *
+ * The overlays are allocated when a reference is open, starting as a copy of
+ * the live histories, and released when the reference is closed. Samples
+ * that the reference does not cover (before it is aligned or after it ends)
+ * take the live value, so that the overlay only departs from the live curve
+ * where the reference streams.
+ *
+ * Must be called before the values of @a frame are appended to the live
+ * histories, so that new overlays copy the same samples.
+ */
+void UI::Dashboard::updateReferences(const JSON::Frame &frame)
+{
+  // Release the overlays when the reference is closed
+  auto &reference = CSV::Reference::instance();
+  if (!reference.isOpen())
+  {
+    if (!m_referenceHistories.isEmpty() || !m_multiplotReferences.isEmpty())
+    {
+      m_referenceHistories.clear();
+      m_referenceCaptures.clear();
+      m_multiplotReferences.clear();
+    }
+
+    return;
   }
 
-  // Append latest values to FFT plots data
-  for (int i = 0; i < widgetCount(SerialStudio::DashboardFFT); ++i)
+  // Obtain the acquisition time of the frame
+  auto timestamp = frame.timestamp();
+  if (timestamp <= 0)
+    timestamp = Misc::PipelineStats::timestamp();
+
+  // Append the reference values of the linear plots
+  bool ok = false;
+  const auto &groups = frame.groups();
+  if (m_referenceHistories.count() != m_datasetHistories.count())
   {
-    const auto &dataset = getDatasetWidget(SerialStudio::DashboardFFT, i);
-    auto *data = m_fftPlotValues[i].data();
-    auto count = m_fftPlotValues[i].count();
-    SIMD::shift<qreal>(data, count, dataset.value().toFloat());
+    m_referenceHistories.clear();
+    m_referenceHistories.resize(m_datasetHistories.count());
   }
 
-  // Append latest values to multiplots data
-  for (int i = 0; i < widgetCount(SerialStudio::DashboardMultiPlot); ++i)
+  for (const auto i : std::as_const(m_tieredHistories))
   {
-    const auto &group = getGroupWidget(SerialStudio::DashboardMultiPlot, i);
-    for (int j = 0; j < group.datasetCount(); ++j)
+    auto &curve = m_referenceHistories[i];
+    if (curve.count() != m_datasetHistories[i].count())
     {
-      const auto &dataset = group.datasets()[j];
-      auto *data = m_multiplotValues[i][j].data();
-      auto count = m_multiplotValues[i][j].count();
-      SIMD::shift<qreal>(data, count, dataset.value().toFloat());
+      curve.resize(m_datasetHistories[i].count());
+      curve.copyNewest(m_datasetHistories[i]);
     }
+
+    const auto &source = m_historySources[i];
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    const auto value = reference.value(dataset.index(), timestamp, &ok);
+    curve.append(ok ? value : dataset.numericValue());
+  }
+
+  // Append the reference values of the multiplots
+  if (m_multiplotReferences.count() != m_multiplotValues.count())
+  {
+    m_multiplotReferences.clear();
+    m_multiplotReferences.resize(m_multiplotValues.count());
   }
+
+  for (const auto &source : std::as_const(m_groupSources))
+  {
+    if (source.widget != SerialStudio::DashboardMultiPlot)
+      continue;
+
+    const auto &values = m_multiplotValues[source.index];
+    auto &curves = m_multiplotReferences[source.index];
+    if (curves.curveCount() != values.curveCount()
+        || curves.count() != values.count())
+    {
+      curves.resize(values.curveCount(), values.count());
+      curves.copyNewest(values);
+    }
+
+    const auto &datasets = groups[source.group].datasets();
+    const auto count = qMin(datasets.count(), curves.curveCount());
+    m_multiplotRow.resize(count);
+    for (int j = 0; j < count; ++j)
+    {
+      const auto &dataset = datasets[j];
+      const auto value = reference.value(dataset.index(), timestamp, &ok);
+      m_multiplotRow[j] = ok ? value : dataset.numericValue();
+    }
+
+    curves.append(m_multiplotRow);
+  }
+}
+
+/**
+ * @brief Processes the frames published to the frame bus since the last
+ *        read.
+ *
+ * Frames that were lost because the bus overran the dashboard are reported
+ * to @c Misc::PipelineStats as dropped frames.
+ *
+ * While @c Misc::OverloadController reports a degraded pipeline, only one out
+ * of N frames is processed, the skipped frames are reported as dropped.
+ */
+void UI::Dashboard::readFrameBus()
+{
+  m_frameReadPending = false;
+
+  // Report the backlog of the dashboard to the overload controller
+  auto &overload = Misc::OverloadController::instance();
+  auto &bus = JSON::FrameBuilder::instance().frameBus();
+  overload.reportQueue(Misc::OverloadController::DashboardQueue,
+                       static_cast<qint64>(bus.pending(m_frameConsumer)),
+                       static_cast<qint64>(bus.capacity()));
+
+  // Process the pending frames, decimate them if the pipeline is degraded
+  quint64 skipped = 0;
+  JSON::Frame frame;
+  const auto decimation = static_cast<quint64>(overload.uiDecimation());
+  while (bus.tryRead(m_frameConsumer, frame))
+  {
+    if (decimation > 1 && m_decimationCount++ % decimation != 0)
+    {
+      ++skipped;
+      continue;
+    }
+
+    processFrame(frame);
+  }
+
+  // Report the frames dropped by the bus or skipped by the decimation
+  const auto dropped = bus.takeDropped(m_frameConsumer) + skipped;
+  if (dropped > 0)
+    Misc::PipelineStats::instance().recordDrops(
+        Misc::PipelineStats::Dashboard, dropped);
+}
+
+/**
+ * @brief Schedules a read of the frame bus after a frame has been published.
+ *
+ * Consecutive frames published before the event loop runs are coalesced into
+ * a single call to @c readFrameBus().
+ */
+void UI::Dashboard::scheduleFrameRead()
+{
+  if (m_frameReadPending)
+    return;
+
+  m_frameReadPending = true;
+  QMetaObject::invokeMethod(this, &UI::Dashboard::readFrameBus,
+                            Qt::QueuedConnection);
 }
 
 /**
@@ -757,73 +1832,141 @@ void UI::Dashboard::updatePlots()
  * This function validates and processes the given `frame`, updating the
  * dashboard’s internal data structures, widgets, and visibility settings.
  *
- * It clears and reconfigures widget groups, datasets, and actions to reflect
- * the new frame's data. The function also emits necessary signals to notify
- * changes and triggers the update of plot data.
+ * If the frame has the same structure as the previous one, its values are
+ * appended to the plot histories and the frame is kept until the next UI
+ * refresh tick, where the groups & datasets of each widget are updated in
+ * place. Frames of a loaded project share the same structure generation, so
+ * this check is done in constant time.
+ *
+ * Otherwise, it clears and reconfigures widget groups, datasets, and actions
+ * to reflect the new frame's data. The function also emits necessary signals
+ * to notify changes and triggers the update of plot data.
  *
  * The function:
  * - Validates the frame and updates widget data structures.
- * - Clears and reinitializes widget groups and datasets.
+ * - Clears and reinitializes widget groups, datasets and their identities.
  * - Updates the list of actions.
- * - Checks for differences in widget counts or titles to determine if a
- *   dashboard regeneration is required.
+ * - Diffs the widget identities against the displayed widgets, so that only
+ *   the widgets that were added or removed are created or destroyed.
  * - Configures widget visibility and mappings based on the new frame data.
  * - Emits signals to update the UI with the new widget count and visibility.
- * - Calls `updatePlots()` to ensure plotting data aligns with the new frame.
+ * - Reuses the plot data of the widgets that are still displayed and calls
+ *   `updatePlots()` to ensure plotting data aligns with the new frame.
  * - Notifies the application about the updated frame.
  *
  * @param frame The new JSON::Frame to process for the dashboard.
  */
 void UI::Dashboard::processFrame(const JSON::Frame &frame)
 {
+  TRACE_ZONE("Dashboard::processFrame");
+
   // Validate frame
+  auto &stats = Misc::PipelineStats::instance();
   if (!frame.isValid())
+  {
+    stats.recordDrops(Misc::PipelineStats::Dashboard);
     return;
+  }
+
+  // Keep track of the oldest frame that has not been rendered yet
+  if (frame.timestamp() > 0)
+  {
+    if (m_pendingArrival == 0)
+      m_pendingArrival = frame.timestamp();
+
+    ++m_pendingFrames;
+  }
 
-  // Get previous counts & title
+  // Same structure as the previous frame, only update the values
+  const auto start = stats.timestamp();
+  if (frame.generation() == m_currentFrame.generation() || sameStructure(frame))
+  {
+    if (!m_valuesChanged && valuesChanged(frame))
+    {
+      m_valuesChanged = true;
+      Misc::TimerEvents::instance().wake();
+    }
+
+    m_currentFrame = frame;
+    m_updateRequired = true;
+    updatePlots(frame);
+    stats.record(Misc::PipelineStats::Dashboard, 1, 0,
+                 stats.timestamp() - start);
+    return;
+  }
+
+  // Get previous title & action count
   const auto previousTitle = title();
   const auto previousActionCount = actionCount();
-  QMap<SerialStudio::DashboardWidget, int> previousCounts;
-  for (auto i = m_widgetGroups.begin(); i != m_widgetGroups.end(); ++i)
-    previousCounts[i.key()] = widgetCount(i.key());
-  for (auto i = m_widgetDatasets.begin(); i != m_widgetDatasets.end(); ++i)
-    previousCounts[i.key()] = widgetCount(i.key());
 
   // Copy frame data & set update required flag to true
   m_currentFrame = frame;
+  m_valuesChanged = true;
   m_updateRequired = true;
+  Misc::TimerEvents::instance().wake();
 
   // Reset widget structures
-  m_widgetGroups.clear();
-  m_widgetDatasets.clear();
+  m_widgetKeys.clear();
+  m_widgetGroups = {};
+  m_widgetDatasets = {};
+  m_groupSources.clear();
+  m_datasetSources.clear();
+  m_historyIndexes.clear();
 
   // Update actions
+  stopPeriodicActions();
   m_actions = m_currentFrame.actions();
   if (actionCount() != previousActionCount)
     Q_EMIT actionCountChanged();
 
-  // Update widget data structures
+  // Update widget data structures & widget identities
   JSON::Group ledPanel;
-  for (const auto &group : frame.groups())
+  QHash<QString, int> occurrences;
+  const auto &groups = frame.groups();
+  for (int g = 0; g < groups.count(); ++g)
   {
+    const auto &group = groups[g];
     const auto key = SerialStudio::getDashboardWidget(group);
     if (key != SerialStudio::DashboardNoWidget)
+    {
+      m_groupSources.append({key, int(m_widgetGroups[key].count()), g});
       m_widgetGroups[key].append(group);
+      m_widgetKeys[key].append(
+          widgetKey(key, group.title(), group.datasetCount(), occurrences));
+    }
 
     if (key == SerialStudio::DashboardAccelerometer
         || key == SerialStudio::DashboardGyroscope)
-      m_widgetGroups[SerialStudio::DashboardMultiPlot].append(group);
+    {
+      const auto plot = SerialStudio::DashboardMultiPlot;
+      m_groupSources.append({plot, int(m_widgetGroups[plot].count()), g});
+      m_widgetGroups[plot].append(group);
+      m_widgetKeys[plot].append(
+          widgetKey(plot, group.title(), group.datasetCount(), occurrences));
+    }
 
-    for (const auto &dataset : group.datasets())
+    const auto &datasets = group.datasets();
+    for (int d = 0; d < datasets.count(); ++d)
     {
+      const auto &dataset = datasets[d];
       auto keys = SerialStudio::getDashboardWidgets(dataset);
       for (const auto &key : keys)
       {
         if (key == SerialStudio::DashboardLED)
+        {
+          const auto index = int(ledPanel.m_datasets.count());
+          m_datasetSources.append({key, index, g, d});
           ledPanel.m_datasets.append(dataset);
+        }
 
         else if (key != SerialStudio::DashboardNoWidget)
+        {
+          const auto index = int(m_widgetDatasets[key].count());
+          m_datasetSources.append({key, index, g, d});
           m_widgetDatasets[key].append(dataset);
+          m_widgetKeys[key].append(
+              widgetKey(key, group.title(), dataset.title(), occurrences));
+        }
       }
     }
   }
@@ -831,84 +1974,484 @@ void UI::Dashboard::processFrame(const JSON::Frame &frame)
   // Add LED panel to group widgets (if required)
   if (ledPanel.datasetCount() > 0)
   {
+    const auto led = SerialStudio::DashboardLED;
     ledPanel.m_title = tr("Status Panel");
-    m_widgetGroups[SerialStudio::DashboardLED].append(ledPanel);
+    m_widgetGroups[led].append(ledPanel);
+    m_widgetKeys[led].append(
+        widgetKey(led, ledPanel.title(), ledPanel.datasetCount(), occurrences));
   }
 
-  // Get current counts & title
-  const auto currentTitle = title();
-  QMap<SerialStudio::DashboardWidget, int> currentCounts;
-  for (auto i = m_widgetGroups.begin(); i != m_widgetGroups.end(); ++i)
-    currentCounts[i.key()] = widgetCount(i.key());
-  for (auto i = m_widgetDatasets.begin(); i != m_widgetDatasets.end(); ++i)
-    currentCounts[i.key()] = widgetCount(i.key());
+  // Only create & destroy the widgets that changed
+  if (updateWidgetModel())
+  {
+    Q_EMIT widgetCountChanged();
+    Q_EMIT widgetVisibilityChanged();
+  }
+
+  else if (title() != previousTitle)
+    Q_EMIT widgetCountChanged();
 
-  // Check if we need to regenerate the dashboard
-  if (previousCounts != currentCounts || previousTitle != currentTitle)
+  // Update plot data, keeping the curves of the unchanged widgets
+  initializeMultiplots();
+  updatePlots(frame);
+  stats.record(Misc::PipelineStats::Dashboard, 1, 0, stats.timestamp() - start);
+}
+
+/**
+ * @brief Rebuilds the global widget index map from the widget structures of
+ *        the current frame and diffs it against the widget model.
+ *
+ * Widgets that keep their identity also keep their visibility flag, new
+ * widgets are visible by default. The widget model only inserts & removes the
+ * rows of the widgets that were added or removed, so that the user interface
+ * does not have to re-create the widgets that did not change.
+ *
+ * @return @c true if the widget list changed.
+ */
+bool UI::Dashboard::updateWidgetModel()
+{
+  // Build the widget identities in the order used by the dashboard grid
+  QStringList keys;
+  QList<QPair<SerialStudio::DashboardWidget, int>> widgets;
+  const auto append = [&](const SerialStudio::DashboardWidget key) {
+    const auto count = widgetCount(key);
+    const auto &ids = m_widgetKeys[key];
+    for (int j = 0; j < count; ++j)
+    {
+      keys.append(ids.value(j));
+      widgets.append(qMakePair(key, j));
+    }
+  };
+
+  for (int i = 0; i < SerialStudio::DashboardNoWidget; ++i)
   {
-    // Clear visibility flags & widget indexes
-    m_widgetMap.clear();
-    m_widgetVisibility.clear();
+    if (!m_widgetGroups[i].isEmpty())
+      append(static_cast<SerialStudio::DashboardWidget>(i));
+  }
 
-    // Initialize widget count parameter
-    m_widgetCount = 0;
-    m_availableWidgets.clear();
+  for (int i = 0; i < SerialStudio::DashboardNoWidget; ++i)
+  {
+    if (!m_widgetDatasets[i].isEmpty())
+      append(static_cast<SerialStudio::DashboardWidget>(i));
+  }
+
+  // Nothing to do if the same widgets are displayed
+  const auto &previousKeys = m_widgetModel.keys();
+  if (keys == previousKeys)
+    return false;
+
+  // Keep the visibility flags of the widgets that are still displayed
+  QHash<QString, bool> visibility;
+  for (auto i = m_widgetMap.begin(); i != m_widgetMap.end(); ++i)
+  {
+    const auto &flags = m_widgetVisibility[i.value().first];
+    if (i.key() < previousKeys.count() && i.value().second < flags.count())
+      visibility.insert(previousKeys[i.key()], flags[i.value().second]);
+  }
+
+  // Map "global" widget index to index relative to widget type/key
+  m_widgetCount = 0;
+  m_widgetMap.clear();
+  m_widgetVisibility.clear();
+  m_availableWidgets.clear();
+  for (int i = 0; i < widgets.count(); ++i)
+  {
+    // Register available widget types in the same order as the widgets
+    // that are drawn on the dashboard grid
+    const auto key = widgets[i].first;
+    if (!m_availableWidgets.contains(key))
+      m_availableWidgets.append(key);
+
+    m_widgetVisibility[key].append(visibility.value(keys[i], true));
+    m_widgetMap.insert(m_widgetCount, widgets[i]);
+    ++m_widgetCount;
+  }
+
+  // Insert & remove the rows of the widgets that changed
+  m_widgetModel.setKeys(keys);
+  return true;
+}
 
-    // Register group widgets
-    for (auto i = m_widgetGroups.begin(); i != m_widgetGroups.end(); ++i)
+/**
+ * @brief Checks if the given @a frame has the same structure as the frame
+ *        that is currently displayed.
+ *
+ * Two frames have the same structure if they have the same title, actions,
+ * groups and datasets, and if every group & dataset is displayed with the same
+ * widgets. Values are not compared.
+ *
+ * @param frame The new frame.
+ * @return @c true if the dashboard widgets can be updated in place.
+ */
+bool UI::Dashboard::sameStructure(const JSON::Frame &frame) const
+{
+  // Compare frame properties
+  if (!m_currentFrame.isValid() || frame.title() != m_currentFrame.title()
+      || frame.actions().count() != m_currentFrame.actions().count()
+      || frame.groupCount() != m_currentFrame.groupCount())
+    return false;
+
+  // Compare groups & datasets
+  const auto &groups = frame.groups();
+  const auto &previousGroups = m_currentFrame.groups();
+  for (int g = 0; g < groups.count(); ++g)
+  {
+    const auto &group = groups[g];
+    const auto &previous = previousGroups[g];
+    if (group.datasetCount() != previous.datasetCount()
+        || group.widget() != previous.widget()
+        || group.title() != previous.title())
+      return false;
+
+    const auto &datasets = group.datasets();
+    const auto &previousDatasets = previous.datasets();
+    for (int d = 0; d < datasets.count(); ++d)
     {
-      // Get number of widgets for current widget type
-      const auto key = i.key();
-      const auto count = widgetCount(key);
-
-      // Make all widgets visible
-      QVector<bool> visibilityFlags;
-      visibilityFlags.resize(count, true);
-      m_widgetVisibility[key] = visibilityFlags;
-
-      // Register available widget types in the same order as the widgets
-      // that are drawn on the dashboard grid
-      if (!m_availableWidgets.contains(key))
-        m_availableWidgets.append(key);
-
-      // Map "global" widget index to index relative to widget type/key
-      for (int j = 0; j < count; ++j)
+      const auto &dataset = datasets[d];
+      const auto &prev = previousDatasets[d];
+      if (dataset.fft() != prev.fft() || dataset.led() != prev.led()
+          || dataset.waterfall() != prev.waterfall()
+          || dataset.graph() != prev.graph() || dataset.log() != prev.log()
+          || dataset.widget() != prev.widget()
+          || dataset.title() != prev.title())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Checks if any group of the given @a frame has different values than
+ *        the frame that is currently displayed.
+ *
+ * The frames must have the same structure. Groups take the value generation
+ * of their last modified dataset, so only the groups are compared.
+ *
+ * @param frame The new frame.
+ * @return @c true if the displayed values change with the new frame.
+ */
+bool UI::Dashboard::valuesChanged(const JSON::Frame &frame) const
+{
+  const auto &groups = frame.groups();
+  const auto &previous = m_currentFrame.groups();
+  if (groups.count() != previous.count())
+    return true;
+
+  for (qsizetype g = 0; g < groups.count(); ++g)
+  {
+    if (groups[g].valueGeneration() != previous[g].valueGeneration())
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Updates the groups & datasets displayed by each widget with the
+ *        contents of the given @a frame.
+ *
+ * The frame must have the same structure as the one used to build the widget
+ * structures, the locations recorded while building them are used to copy
+ * each group & dataset directly to its place.
+ *
+ * @param frame The new frame.
+ */
+void UI::Dashboard::updateWidgetValues(const JSON::Frame &frame)
+{
+  // Update group widgets, skipping groups whose values did not change
+  const auto &groups = frame.groups();
+  for (const auto &source : std::as_const(m_groupSources))
+  {
+    const auto &group = groups[source.group];
+    auto &target = m_widgetGroups[source.widget][source.index];
+    if (target.valueGeneration() != group.valueGeneration())
+      target = group;
+  }
+
+  // Update dataset widgets & the LED panel
+  for (const auto &source : std::as_const(m_datasetSources))
+  {
+    const auto &dataset = groups[source.group].datasets()[source.dataset];
+    if (source.widget == SerialStudio::DashboardLED)
+    {
+      auto &panel = m_widgetGroups[SerialStudio::DashboardLED].last();
+      auto &target = panel.m_datasets[source.index];
+      if (target.valueGeneration() != dataset.valueGeneration())
       {
-        m_widgetMap.insert(m_widgetCount, qMakePair(key, j));
-        ++m_widgetCount;
+        target = dataset;
+        panel.m_valueGeneration = dataset.valueGeneration();
       }
     }
 
-    // Register dataset widgets
-    for (auto i = m_widgetDatasets.begin(); i != m_widgetDatasets.end(); ++i)
+    else
     {
-      // Get number of widgets for current widget type
-      const auto key = i.key();
-      const auto count = widgetCount(key);
-
-      // Make all widgets visible
-      QVector<bool> visibilityFlags;
-      visibilityFlags.resize(count, true);
-      m_widgetVisibility[key] = visibilityFlags;
-
-      // Register available widget types in the same order as the widgets
-      // that are drawn on the dashboard grid
-      if (!m_availableWidgets.contains(key))
-        m_availableWidgets.append(key);
-
-      // Map "global" widget index to index relative to widget type/key
-      for (int j = 0; j < count; ++j)
+      auto &target = m_widgetDatasets[source.widget][source.index];
+      if (target.valueGeneration() != dataset.valueGeneration())
+        target = dataset;
+    }
+  }
+}
+
+/**
+ * @brief Returns the value generation of the input of a dashboard widget.
+ *
+ * Plots, FFT plots, waterfalls & gyroscopes depend on the history of the
+ * received frames, so their generation changes on every tick in which new
+ * frames were processed. Other widgets use the value generation of the group
+ * or dataset that they display.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @return The generation, or @c 0 if the widget does not exist.
+ */
+quint64
+UI::Dashboard::widgetGeneration(const SerialStudio::DashboardWidget widget,
+                                const int index) const
+{
+  switch (widget)
+  {
+    case SerialStudio::DashboardPlot:
+      return m_triggerEnabled ? m_captureCount : m_updateCount;
+    case SerialStudio::DashboardFFT:
+    case SerialStudio::DashboardWaterfall:
+    case SerialStudio::DashboardGyroscope:
+    case SerialStudio::DashboardMultiPlot:
+      return m_updateCount;
+    default:
+      break;
+  }
+
+  if (SerialStudio::isGroupWidget(widget))
+  {
+    const auto &groups = m_widgetGroups[widget];
+    if (index >= 0 && index < groups.count())
+      return groups.at(index).valueGeneration();
+  }
+
+  else if (widget >= 0 && widget < SerialStudio::DashboardNoWidget)
+  {
+    const auto &datasets = m_widgetDatasets[widget];
+    if (index >= 0 && index < datasets.count())
+      return datasets.at(index).valueGeneration();
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Returns the refresh class of a dashboard widget.
+ *
+ * The class is defined by the group that generates the widget. The LED panel
+ * combines the datasets of several groups, so it uses the fastest class
+ * requested by any of them. Widgets whose group does not define a class use
+ * the default class of their type.
+ */
+SerialStudio::RefreshClass
+UI::Dashboard::refreshClass(const SerialStudio::DashboardWidget widget,
+                            const int index) const
+{
+  // Obtain the refresh class requested by the source group(s) of the widget
+  auto refresh = SerialStudio::RefreshDefault;
+  const auto &groups = m_currentFrame.groups();
+  const auto request = [&](const int group) {
+    if (group < 0 || group >= groups.count())
+      return;
+
+    const auto id = groups[group].refreshClass();
+    const auto value = SerialStudio::refreshClassFromId(id);
+    if (value != SerialStudio::RefreshDefault
+        && (refresh == SerialStudio::RefreshDefault || value < refresh))
+      refresh = value;
+  };
+
+  if (widget == SerialStudio::DashboardLED)
+  {
+    for (const auto &source : std::as_const(m_datasetSources))
+    {
+      if (source.widget == widget)
+        request(source.group);
+    }
+  }
+
+  else if (SerialStudio::isGroupWidget(widget))
+  {
+    for (const auto &source : std::as_const(m_groupSources))
+    {
+      if (source.widget == widget && source.index == index)
+        request(source.group);
+    }
+  }
+
+  else
+  {
+    for (const auto &source : std::as_const(m_datasetSources))
+    {
+      if (source.widget == widget && source.index == index)
+        request(source.group);
+    }
+  }
+
+  // Fall back to the default class of the widget type
+  if (refresh == SerialStudio::RefreshDefault)
+    return SerialStudio::defaultRefreshClass(widget);
+
+  return refresh;
+}
+
+/**
+ * @brief Feeds the newest sample of the trigger source to the plot trigger &
+ *        takes a snapshot of the plotted histories when a capture completes.
+ *
+ * Only the histories of linear plots are copied, and only once per capture,
+ * so the plots are redrawn at the capture rate instead of the frame rate.
+ */
+void UI::Dashboard::updateTrigger()
+{
+  // Obtain the history of the trigger source
+  const auto &indexes = m_historyIndexes[SerialStudio::DashboardPlot];
+  if (m_triggerSource >= indexes.count())
+    return;
+
+  const auto &source = m_datasetHistories[indexes[m_triggerSource]];
+  if (source.isEmpty() || !m_trigger.process(source.at(source.count() - 1)))
+    return;
+
+  // Copy the aligned capture of every plotted history
+  for (const auto i : std::as_const(m_tieredHistories))
+    m_triggerCaptures[i].copyNewest(m_datasetHistories[i]);
+
+  // Copy the reference overlays of the capture
+  if (!m_referenceHistories.isEmpty())
+  {
+    m_referenceCaptures.resize(m_datasetHistories.count());
+    for (const auto i : std::as_const(m_tieredHistories))
+    {
+      const auto length = m_triggerCaptures[i].count();
+      if (m_referenceCaptures[i].count() != length)
+        m_referenceCaptures[i].resize(length);
+
+      m_referenceCaptures[i].copyNewest(m_referenceHistories[i]);
+    }
+  }
+
+  ++m_captureCount;
+}
+
+/**
+ * @brief Stops the periodic transmission of every active action.
+ */
+void UI::Dashboard::stopPeriodicActions()
+{
+  if (!m_activeActions.isEmpty())
+  {
+    m_activeActions.clear();
+    IO::Manager::instance().stopPeriodicWrites();
+    Q_EMIT activeActionsChanged();
+  }
+}
+
+/**
+ * @brief Applies the trigger settings to the plot trigger & (re)allocates
+ *        the captures of the plotted histories, which are released when the
+ *        trigger is disabled.
+ */
+void UI::Dashboard::configureTrigger()
+{
+  m_triggerCaptures.clear();
+  m_referenceCaptures.clear();
+  const auto length = static_cast<qsizetype>(points()) + 1;
+  const auto pretrigger = length * m_triggerPosition / 100;
+  m_trigger.configure(m_triggerEdge, m_triggerLevel, pretrigger, length);
+  if (!m_triggerEnabled)
+    return;
+
+  m_triggerCaptures.resize(m_datasetHistories.count());
+  for (const auto i : std::as_const(m_tieredHistories))
+    m_triggerCaptures[i].resize(length);
+}
+
+/**
+ * @brief Calls the update function of the enabled widgets whose input changed
+ *        since they were last updated.
+ *
+ * Disabled widgets keep their last generation, so that they are updated as
+ * soon as they are enabled again (see @c resume()). Widgets whose refresh
+ * interval has not elapsed yet are postponed, they are updated on a later
+ * tick even if no new frames are received.
+ */
+void UI::Dashboard::notifyWidgets()
+{
+  TRACE_ZONE("Dashboard::notifyWidgets");
+
+  // Widgets may be created or destroyed by the update functions
+  m_deferredUpdates = false;
+  const auto now = m_refreshClock.elapsed();
+  for (qsizetype i = 0; i < m_subscribers.count(); ++i)
+  {
+    auto &subscriber = m_subscribers[i];
+    if (!subscriber.item->isEnabled())
+      continue;
+
+    const auto generation
+        = widgetGeneration(subscriber.widget, subscriber.index);
+    if (generation != 0 && generation != subscriber.generation)
+    {
+      // Postpone the update until the refresh interval of the widget elapses
+      const auto interval = refreshInterval(subscriber.refresh);
+      if (subscriber.lastUpdate >= 0 && now - subscriber.lastUpdate < interval)
       {
-        m_widgetMap.insert(m_widgetCount, qMakePair(key, j));
-        ++m_widgetCount;
+        m_deferredUpdates = true;
+        continue;
       }
+
+      subscriber.generation = generation;
+      subscriber.lastUpdate = now;
+      auto *item = subscriber.item;
+      const auto update = subscriber.update;
+      (item->*update)();
     }
+  }
+}
 
-    // Update user interface
-    Q_EMIT widgetCountChanged();
-    Q_EMIT widgetVisibilityChanged();
+/**
+ * @brief Updates a suspended widget as soon as it is enabled again.
+ *
+ * Called when the enabled state of @a item changes, so that a widget that is
+ * scrolled back into view shows the current data immediately, even if no
+ * new frames are received (e.g. when the device is paused).
+ */
+void UI::Dashboard::resume(QQuickItem *item)
+{
+  if (!item->isEnabled())
+    return;
+
+  for (qsizetype i = 0; i < m_subscribers.count(); ++i)
+  {
+    auto &subscriber = m_subscribers[i];
+    if (subscriber.item != item)
+      continue;
+
+    const auto generation
+        = widgetGeneration(subscriber.widget, subscriber.index);
+    if (generation != 0 && generation != subscriber.generation)
+    {
+      subscriber.generation = generation;
+      subscriber.lastUpdate = m_refreshClock.elapsed();
+      const auto update = subscriber.update;
+      (item->*update)();
+    }
   }
+}
 
-  // Update plot data
-  updatePlots();
+/**
+ * @brief Removes the update functions registered by the given @a item.
+ *
+ * Called when a widget is destroyed, @a item must not be dereferenced.
+ */
+void UI::Dashboard::unsubscribe(QObject *item)
+{
+  m_subscribers.removeIf([item](const Subscriber &subscriber) {
+    return static_cast<QObject *>(subscriber.item) == item;
+  });
 }
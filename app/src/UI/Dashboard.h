@@ -22,11 +22,21 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+
+#include <QSet>
 #include <QFont>
+#include <QSpan>
 #include <QObject>
+#include <QQuickItem>
+#include <QElapsedTimer>
 
 #include "JSON/Frame.h"
 #include "SerialStudio.h"
+#include "UI/PlotTrigger.h"
+#include "UI/HistoryStore.h"
+#include "UI/DashboardModel.h"
 
 // clang-format off
 #define GET_GROUP(type, index) UI::Dashboard::instance().getGroupWidget(type, index)
@@ -34,6 +44,12 @@
 #define VALIDATE_WIDGET(type, index) (index >= 0 && index < UI::Dashboard::instance().widgetCount(type))
 // clang-format on
 
+namespace Misc
+{
+class Benchmark;
+class WidgetBenchmark;
+}
+
 namespace UI
 {
 
@@ -46,9 +62,44 @@ namespace UI
  * dashboard user interface, updating various widgets such as plots, multiplots,
  * and status indicators based on JSON frame data.
  *
- * Updates occur at a maximum rate of 20 Hz for optimal performance. It manages
- * real-time data for different plot types (linear, FFT, multiplot) and supports
- * actions that can be triggered from the UI.
+ * Frames are ingested at the rate at which they are received: each frame only
+ * appends its values to the plot histories. The widget groups & datasets are
+ * updated, and the @c updated() signal is emitted, once per UI refresh tick
+ * (see @c Misc::TimerEvents::uiRefreshRate()).
+ *
+ * Widgets register their update function with @c subscribe(). On each tick,
+ * the dashboard only calls the functions of the enabled widgets whose input
+ * changed since they were last updated, according to the value generations
+ * that the frame builder assigns to each group & dataset. Plots (and the
+ * gyroscope, which integrates its readings) are updated whenever new frames
+ * were received, since their histories change even if the values don't.
+ *
+ * Each widget also has a refresh class (see @c SerialStudio::RefreshClass),
+ * defined by its group in the project file. Realtime widgets are updated on
+ * every tick, while normal and low priority widgets are updated at most at
+ * a capped rate, which keeps the frame time available for the widgets that
+ * matter when the dashboard is large.
+ *
+ * The dashboard grid disables the widgets that are scrolled out of view or
+ * hidden by the user, and widgets are disabled while their window (the main
+ * window or an external window) is minimized. They are suspended (their
+ * update functions are not called), while the plot histories keep being
+ * recorded here, so that a widget shows current data as soon as it is enabled
+ * again.
+ *
+ * Frames are read from the @c JSON::FrameBus: each published frame schedules
+ * a single read of the bus (if none is pending), which processes all the
+ * frames received since the previous read. If the user interface stalls for
+ * a whole bus, the oldest frames are dropped & reported to
+ * @c Misc::PipelineStats.
+ *
+ * While a reference session is open (see @c CSV::Reference), every linear
+ * plot & multiplot also records the reference value of its datasets at the
+ * acquisition time of each frame, which the plots draw over the live curves.
+ *
+ * It manages real-time data for
+ * different plot types (linear, FFT, multiplot) and supports actions that can
+ * be triggered from the UI.
  *
  * Properties notify changes to dynamically adjust UI elements like widget
  * visibility and count.
@@ -64,9 +115,19 @@ class Dashboard : public QObject
   Q_PROPERTY(bool available READ available NOTIFY widgetCountChanged)
   Q_PROPERTY(int actionCount READ actionCount NOTIFY actionCountChanged)
   Q_PROPERTY(int points READ points WRITE setPoints NOTIFY pointsChanged)
+  Q_PROPERTY(bool timeAxis READ timeAxis WRITE setTimeAxis NOTIFY timeAxisChanged)
+  Q_PROPERTY(qreal timeWindow READ timeWindow WRITE setTimeWindow NOTIFY timeWindowChanged)
+  Q_PROPERTY(qreal timeOffset READ timeOffset WRITE setTimeOffset NOTIFY timeOffsetChanged)
+  Q_PROPERTY(bool triggerEnabled READ triggerEnabled WRITE setTriggerEnabled NOTIFY triggerChanged)
+  Q_PROPERTY(int triggerSource READ triggerSource WRITE setTriggerSource NOTIFY triggerChanged)
+  Q_PROPERTY(qreal triggerLevel READ triggerLevel WRITE setTriggerLevel NOTIFY triggerChanged)
+  Q_PROPERTY(int triggerPosition READ triggerPosition WRITE setTriggerPosition NOTIFY triggerChanged)
+  Q_PROPERTY(SerialStudio::TriggerEdge triggerEdge READ triggerEdge WRITE setTriggerEdge NOTIFY triggerChanged)
   Q_PROPERTY(QStringList actionIcons READ actionIcons NOTIFY actionCountChanged)
   Q_PROPERTY(QStringList actionTitles READ actionTitles NOTIFY actionCountChanged)
+  Q_PROPERTY(QVariantList activeActions READ activeActions NOTIFY activeActionsChanged)
   Q_PROPERTY(int totalWidgetCount READ totalWidgetCount NOTIFY widgetCountChanged)
+  Q_PROPERTY(UI::DashboardModel* widgetModel READ widgetModel CONSTANT)
   Q_PROPERTY(int precision READ precision WRITE setPrecision NOTIFY precisionChanged)
   Q_PROPERTY(bool pointsWidgetVisible READ pointsWidgetVisible NOTIFY widgetCountChanged)
   Q_PROPERTY(bool showLegends READ showLegends WRITE setShowLegends NOTIFY showLegendsChanged)
@@ -82,10 +143,15 @@ signals:
   void updated();
   void dataReset();
   void pointsChanged();
+  void timeAxisChanged();
+  void timeWindowChanged();
+  void timeOffsetChanged();
+  void triggerChanged();
   void precisionChanged();
   void showLegendsChanged();
   void actionCountChanged();
   void widgetCountChanged();
+  void activeActionsChanged();
   void axisVisibilityChanged();
   void widgetVisibilityChanged();
 
@@ -103,6 +169,7 @@ public:
 
   [[nodiscard]] bool available() const;
   [[nodiscard]] bool showLegends() const;
+  [[nodiscard]] bool timeAxis() const;
   [[nodiscard]] bool pointsWidgetVisible() const;
   [[nodiscard]] bool precisionWidgetVisible() const;
   [[nodiscard]] bool axisOptionsWidgetVisible() const;
@@ -112,6 +179,16 @@ public:
   [[nodiscard]] int precision() const;
   [[nodiscard]] int actionCount() const;
   [[nodiscard]] int totalWidgetCount() const;
+  [[nodiscard]] UI::DashboardModel *widgetModel();
+  [[nodiscard]] qreal timeWindow() const;
+  [[nodiscard]] qreal timeOffset() const;
+
+  [[nodiscard]] bool triggerEnabled() const;
+  [[nodiscard]] int triggerSource() const;
+  [[nodiscard]] int triggerPosition() const;
+  [[nodiscard]] qreal triggerLevel() const;
+  [[nodiscard]] qsizetype pretriggerSamples() const;
+  [[nodiscard]] SerialStudio::TriggerEdge triggerEdge() const;
 
   Q_INVOKABLE bool frameValid() const;
   Q_INVOKABLE int relativeIndex(const int widgetIndex);
@@ -132,6 +209,7 @@ public:
   [[nodiscard]] const QString &title() const;
   [[nodiscard]] QStringList actionIcons() const;
   [[nodiscard]] QStringList actionTitles() const;
+  [[nodiscard]] QVariantList activeActions() const;
 
   // clang-format off
   [[nodiscard]] const JSON::Group &getGroupWidget(const SerialStudio::DashboardWidget widget, const int index) const;
@@ -139,12 +217,40 @@ public:
   // clang-format on
 
   [[nodiscard]] const JSON::Frame &currentFrame();
-  [[nodiscard]] const QVector<Curve> &fftPlotValues();
-  [[nodiscard]] const QVector<Curve> &linearPlotValues();
-  [[nodiscard]] const QVector<MultipleCurves> &multiplotValues();
+  [[nodiscard]] const Timeline &historyTimeline() const;
+  [[nodiscard]] QSpan<const MultipleCurves> multiplotValues() const;
+  [[nodiscard]] const Curve *
+  datasetHistory(const SerialStudio::DashboardWidget widget,
+                 const int index) const;
+  [[nodiscard]] const HistoryTiers *
+  datasetTiers(const SerialStudio::DashboardWidget widget,
+               const int index) const;
+  [[nodiscard]] const Curve *
+  triggerCapture(const SerialStudio::DashboardWidget widget,
+                 const int index) const;
+  [[nodiscard]] const Curve *
+  referenceHistory(const SerialStudio::DashboardWidget widget,
+                   const int index) const;
+  [[nodiscard]] const Curve *
+  referenceCapture(const SerialStudio::DashboardWidget widget,
+                   const int index) const;
+  [[nodiscard]] const MultipleCurves *
+  multiplotReference(const int index) const;
+
+  template<typename Widget>
+  void subscribe(const SerialStudio::DashboardWidget widget, const int index,
+                 Widget *item, void (Widget::*function)());
 
 public slots:
   void setPoints(const int points);
+  void setTimeAxis(const bool enabled);
+  void setTimeWindow(const qreal seconds);
+  void setTimeOffset(const qreal seconds);
+  void setTriggerEnabled(const bool enabled);
+  void setTriggerSource(const int index);
+  void setTriggerLevel(const qreal level);
+  void setTriggerPosition(const int percent);
+  void setTriggerEdge(const SerialStudio::TriggerEdge edge);
   void activateAction(const int index);
   void setPrecision(const int precision);
   void setShowLegends(const bool enabled);
@@ -152,30 +258,187 @@ public slots:
   void setAxisVisibility(const SerialStudio::AxisVisibility option);
   void setWidgetVisible(const SerialStudio::DashboardWidget widget,
                         const int index, const bool visible);
+  void onFrameSwapped();
 
 private slots:
-  void updatePlots();
+  void updateWidgets();
+  void readFrameBus();
+  void onProjectChanged();
+  void onConnectedChanged();
+  void reportMemoryUsage();
+  void saveHistorySnapshot();
+  void scheduleFrameRead();
   void processFrame(const JSON::Frame &frame);
 
+private:
+  [[nodiscard]] bool sameStructure(const JSON::Frame &frame) const;
+  [[nodiscard]] bool valuesChanged(const JSON::Frame &frame) const;
+  [[nodiscard]] quint64
+  widgetGeneration(const SerialStudio::DashboardWidget widget,
+                   const int index) const;
+
+  [[nodiscard]] SerialStudio::RefreshClass
+  refreshClass(const SerialStudio::DashboardWidget widget,
+               const int index) const;
+
+  void updateTrigger();
+  void notifyWidgets();
+  void configureTrigger();
+  void stopPeriodicActions();
+  void resume(QQuickItem *item);
+  void unsubscribe(QObject *item);
+  void initializeMultiplots();
+  void updatePlots(const JSON::Frame &frame);
+  void updateReferences(const JSON::Frame &frame);
+  bool updateWidgetModel();
+  void initializeHistories(const JSON::Frame &frame);
+  void updateWidgetValues(const JSON::Frame &frame);
+
+private:
+  /**
+   * @brief Widgets of each type, indexed directly by the widget type.
+   */
+  template<typename T>
+  using WidgetTable = std::array<QVector<T>, SerialStudio::DashboardNoWidget>;
+
+  /**
+   * @brief Location of a dashboard widget's group in the source frame.
+   */
+  struct GroupSource
+  {
+    SerialStudio::DashboardWidget widget;
+    int index;
+    int group;
+  };
+
+  /**
+   * @brief Location of a dashboard widget's dataset in the source frame.
+   */
+  struct DatasetSource
+  {
+    SerialStudio::DashboardWidget widget;
+    int index;
+    int group;
+    int dataset;
+  };
+
+  /**
+   * @brief Location of the dataset of a shared sample history in the source
+   *        frame.
+   */
+  struct HistorySource
+  {
+    int group;
+    int dataset;
+  };
+
+  /**
+   * @brief Update function of a dashboard widget, its refresh class & the
+   *        value generation of its input (and the time, in milliseconds) when
+   *        it was last called.
+   */
+  struct Subscriber
+  {
+    SerialStudio::DashboardWidget widget;
+    int index;
+    quint64 generation;
+    QQuickItem *item;
+    void (QQuickItem::*update)();
+    SerialStudio::RefreshClass refresh;
+    qint64 lastUpdate;
+  };
+
 private:
   int m_points;
   int m_precision;
   int m_widgetCount;
   bool m_showLegends;
+  bool m_timeAxis;
+  bool m_valuesChanged;
   bool m_updateRequired;
+  bool m_deferredUpdates;
+  bool m_frameReadPending;
+  bool m_restoreHistory;
+  int m_snapshotTicks;
+  int m_frameConsumer;
+  quint64 m_decimationCount;
+  qreal m_timeWindow;
+  qreal m_timeOffset;
+  bool m_triggerEnabled;
+  int m_triggerSource;
+  int m_triggerPosition;
+  qreal m_triggerLevel;
+  quint64 m_captureCount;
+  SerialStudio::TriggerEdge m_triggerEdge;
+  quint64 m_updateCount;
+  qint64 m_pendingArrival;
+  qint64 m_pendingFrames;
+  std::atomic<qint64> m_renderArrival;
+  std::atomic<qint64> m_renderFrames;
   SerialStudio::AxisVisibility m_axisVisibility;
 
-  QVector<Curve> m_fftPlotValues;
-  QVector<Curve> m_linearPlotValues;
+  Timeline m_historyTimeline;
+  QVector<Curve> m_datasetHistories;
+  QVector<HistoryTiers> m_datasetTiers;
+  QVector<int> m_tieredHistories;
+  UI::HistoryStore m_historyStore;
+  UI::PlotTrigger m_trigger;
+  QVector<Curve> m_triggerCaptures;
+  QVector<HistorySource> m_historySources;
+  QStringList m_historyKeys;
+  QStringList m_multiplotKeys;
+  QMap<SerialStudio::DashboardWidget, QVector<int>> m_historyIndexes;
   QVector<MultipleCurves> m_multiplotValues;
+  QVector<qreal> m_multiplotRow;
+  QVector<Curve> m_referenceHistories;
+  QVector<Curve> m_referenceCaptures;
+  QVector<MultipleCurves> m_multiplotReferences;
 
+  QSet<int> m_activeActions;
   QVector<JSON::Action> m_actions;
   QList<SerialStudio::DashboardWidget> m_availableWidgets;
   QMap<int, QPair<SerialStudio::DashboardWidget, int>> m_widgetMap;
   QMap<SerialStudio::DashboardWidget, QVector<bool>> m_widgetVisibility;
-  QMap<SerialStudio::DashboardWidget, QVector<JSON::Group>> m_widgetGroups;
-  QMap<SerialStudio::DashboardWidget, QVector<JSON::Dataset>> m_widgetDatasets;
+  WidgetTable<JSON::Group> m_widgetGroups;
+  WidgetTable<JSON::Dataset> m_widgetDatasets;
+  QMap<SerialStudio::DashboardWidget, QStringList> m_widgetKeys;
+  UI::DashboardModel m_widgetModel;
+
+  QVector<GroupSource> m_groupSources;
+  QVector<DatasetSource> m_datasetSources;
+  QVector<Subscriber> m_subscribers;
+  QElapsedTimer m_refreshClock;
 
   JSON::Frame m_currentFrame;
+
+  friend class Misc::Benchmark;
+  friend class Misc::WidgetBenchmark;
+  friend class DashboardRecorder;
 };
+
+/**
+ * @brief Registers the update @a function of a dashboard widget.
+ *
+ * The function is called on the UI refresh ticks in which the group or
+ * dataset displayed by the widget changed, and while the @a item is enabled.
+ * The registration is removed automatically when the @a item is destroyed.
+ *
+ * @param widget The type of the dashboard widget.
+ * @param index The index of the widget relative to its type.
+ * @param item The widget item.
+ * @param function The member function that updates the widget.
+ */
+template<typename Widget>
+void Dashboard::subscribe(const SerialStudio::DashboardWidget widget,
+                          const int index, Widget *item,
+                          void (Widget::*function)())
+{
+  const auto update = static_cast<void (QQuickItem::*)()>(function);
+  const auto refresh = refreshClass(widget, index);
+  m_subscribers.append({widget, index, 0, item, update, refresh, -1});
+
+  connect(item, &QObject::destroyed, this,
+          [=](QObject *object) { unsubscribe(object); });
+  connect(item, &QQuickItem::enabledChanged, this, [=] { resume(item); });
+}
 } // namespace UI
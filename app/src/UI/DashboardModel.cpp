@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QSet>
+
+#include "UI/DashboardModel.h"
+
+/**
+ * Constructor function
+ */
+UI::DashboardModel::DashboardModel(QObject *parent)
+  : QAbstractListModel(parent)
+{
+}
+
+/**
+ * Returns the identities of the widgets, in the order of the dashboard grid
+ */
+const QStringList &UI::DashboardModel::keys() const
+{
+  return m_keys;
+}
+
+/**
+ * Returns the role names exposed to QML
+ */
+QHash<int, QByteArray> UI::DashboardModel::roleNames() const
+{
+  return {{WidgetKeyRole, "widgetKey"}};
+}
+
+/**
+ * Returns the number of widgets displayed by the dashboard
+ */
+int UI::DashboardModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(m_keys.count());
+}
+
+/**
+ * Returns the identity of the widget at the given @a index
+ */
+QVariant UI::DashboardModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() >= m_keys.count())
+    return QVariant();
+
+  if (role == WidgetKeyRole || role == Qt::DisplayRole)
+    return m_keys.at(index.row());
+
+  return QVariant();
+}
+
+/**
+ * @brief Updates the widgets of the model with the given unique @a keys.
+ *
+ * The rows of the widgets that are no longer displayed are removed first,
+ * from the last to the first one, and the rows of the new widgets are then
+ * inserted in ascending order, so that every inserted row is created at its
+ * final position. Consecutive rows are removed & inserted together.
+ *
+ * @param keys The identities of the widgets, in the order of the dashboard
+ *             grid.
+ */
+void UI::DashboardModel::setKeys(const QStringList &keys)
+{
+  // Nothing to do
+  if (keys == m_keys)
+    return;
+
+  // The remaining widgets must keep their order, otherwise reset the model
+  const QSet<QString> current(m_keys.cbegin(), m_keys.cend());
+  const QSet<QString> updated(keys.cbegin(), keys.cend());
+  QStringList keptCurrent;
+  QStringList keptUpdated;
+  for (const auto &key : std::as_const(m_keys))
+  {
+    if (updated.contains(key))
+      keptCurrent.append(key);
+  }
+
+  for (const auto &key : keys)
+  {
+    if (current.contains(key))
+      keptUpdated.append(key);
+  }
+
+  if (keptCurrent != keptUpdated || updated.count() != keys.count())
+  {
+    reset(keys);
+    return;
+  }
+
+  // Remove the rows of the widgets that are no longer displayed
+  auto i = m_keys.count() - 1;
+  while (i >= 0)
+  {
+    if (updated.contains(m_keys.at(i)))
+    {
+      --i;
+      continue;
+    }
+
+    const auto last = i;
+    while (i >= 0 && !updated.contains(m_keys.at(i)))
+      --i;
+
+    beginRemoveRows(QModelIndex(), static_cast<int>(i + 1),
+                    static_cast<int>(last));
+    m_keys.remove(i + 1, last - i);
+    endRemoveRows();
+  }
+
+  // Insert the rows of the new widgets at their final positions
+  qsizetype j = 0;
+  while (j < keys.count())
+  {
+    if (j < m_keys.count() && m_keys.at(j) == keys.at(j))
+    {
+      ++j;
+      continue;
+    }
+
+    const auto first = j;
+    while (j < keys.count() && !current.contains(keys.at(j)))
+      ++j;
+
+    if (j == first)
+    {
+      reset(keys);
+      return;
+    }
+
+    beginInsertRows(QModelIndex(), static_cast<int>(first),
+                    static_cast<int>(j - 1));
+    for (auto k = first; k < j; ++k)
+      m_keys.insert(k, keys.at(k));
+    endInsertRows();
+  }
+}
+
+/**
+ * Replaces all the rows of the model with the given @a keys
+ */
+void UI::DashboardModel::reset(const QStringList &keys)
+{
+  beginResetModel();
+  m_keys = keys;
+  endResetModel();
+}
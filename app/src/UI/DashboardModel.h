@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QStringList>
+#include <QAbstractListModel>
+
+namespace UI
+{
+/**
+ * @brief The DashboardModel class
+ *
+ * List model of the widgets displayed by the dashboard grid, in the order of
+ * their global widget indexes. Each row holds the identity of a widget (its
+ * type & the titles of its group or dataset), which does not change when the
+ * project is edited or reloaded.
+ *
+ * When the widgets of the dashboard change, @c setKeys() compares the new
+ * identities with the current ones and only removes & inserts the rows that
+ * changed, so that the QML delegates of the remaining widgets (and the state
+ * of their items) are kept. If the remaining widgets were reordered, the
+ * model is reset instead.
+ */
+class DashboardModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  enum Roles
+  {
+    WidgetKeyRole = Qt::UserRole + 1
+  };
+
+  explicit DashboardModel(QObject *parent = nullptr);
+
+  [[nodiscard]] const QStringList &keys() const;
+  [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+  [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+  [[nodiscard]] QVariant data(const QModelIndex &index,
+                              int role = Qt::DisplayRole) const override;
+
+  void setKeys(const QStringList &keys);
+
+private:
+  void reset(const QStringList &keys);
+
+private:
+  QStringList m_keys;
+};
+} // namespace UI
@@ -0,0 +1,725 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <limits>
+
+#include <QDir>
+#include <QUrl>
+#include <QImage>
+#include <QDateTime>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QFileDialog>
+#include <QMediaFormat>
+#include <QQuickWindow>
+#include <QApplication>
+#include <QQmlComponent>
+#include <QStandardPaths>
+#include <QQuickRenderTarget>
+#include <QQuickRenderControl>
+
+#include <rhi/qrhi.h>
+
+#include "CSV/Player.h"
+#include "UI/Dashboard.h"
+#include "UI/DashboardRecorder.h"
+#include "Misc/WorkerPool.h"
+#include "Misc/Utilities.h"
+#include "Misc/ThemeManager.h"
+
+/**
+ * QML component of the dashboard that is rendered offscreen
+ */
+static constexpr auto kDashboardQml
+    = "qrc:/qml/MainWindow/Dashboard/WidgetGrid.qml";
+
+/**
+ * Lowest and highest frame rates that can be selected (in Hz)
+ */
+static constexpr int kMinFrameRate = 1;
+static constexpr int kMaxFrameRate = 120;
+
+/**
+ * Smallest and largest image sizes that can be selected (in pixels)
+ */
+static constexpr int kMinImageSize = 320;
+static constexpr int kMaxImageSize = 7680;
+
+/**
+ * Number of PNG files that can be encoded at the same time before the replay
+ * waits (or live recordings drop frames), and interval in milliseconds after
+ * which a waiting replay checks the encoders again
+ */
+static constexpr int kMaxPendingImages = 8;
+static constexpr int kRetryInterval = 5;
+
+/**
+ * Time given to the asynchronous loaders of the dashboard widgets after the
+ * offscreen dashboard is created, before the first frame is rendered (in ms)
+ */
+static constexpr int kWarmupInterval = 500;
+
+/**
+ * Constructor function, reads the recording settings
+ */
+UI::DashboardRecorder::DashboardRecorder()
+  : m_engine(nullptr)
+  , m_output(Output::Images)
+  , m_replay(false)
+  , m_lastFrame(false)
+  , m_recording(false)
+  , m_frameCount(0)
+  , m_replayStart(0)
+  , m_pendingImages(std::make_shared<std::atomic<int>>(0))
+{
+  // Read settings
+  const auto fps = m_settings.value("recorder_frame_rate", 30).toInt();
+  const auto size = m_settings.value("recorder_resolution", QSize(1920, 1080));
+  m_frameRate = qBound(kMinFrameRate, fps, kMaxFrameRate);
+  m_resolution = size.toSize();
+
+  // Capture the live dashboard at a fixed rate
+  m_timer.setTimerType(Qt::PreciseTimer);
+  connect(&m_timer, &QTimer::timeout, this,
+          &UI::DashboardRecorder::captureFrame);
+
+  // Stop recording if the video can't be encoded
+  connect(&m_mediaRecorder, &QMediaRecorder::errorOccurred, this,
+          [=](QMediaRecorder::Error error, const QString &message) {
+            Q_UNUSED(error);
+            qWarning() << "Dashboard video recording error:" << message;
+            stop();
+          });
+}
+
+/**
+ * Stops the recording & releases the offscreen renderer
+ */
+UI::DashboardRecorder::~DashboardRecorder()
+{
+  stop();
+  release();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+UI::DashboardRecorder &UI::DashboardRecorder::instance()
+{
+  static DashboardRecorder singleton;
+  return singleton;
+}
+
+/**
+ * Returns @c true while an image sequence or a video is being recorded
+ */
+bool UI::DashboardRecorder::recording() const
+{
+  return m_recording;
+}
+
+/**
+ * Returns the number of frames rendered since the recording started
+ */
+int UI::DashboardRecorder::frameCount() const
+{
+  return m_frameCount;
+}
+
+/**
+ * Returns the number of frames rendered per second of recording
+ */
+int UI::DashboardRecorder::frameRate() const
+{
+  return m_frameRate;
+}
+
+/**
+ * Returns the size (in pixels) of the rendered images
+ */
+QSize UI::DashboardRecorder::resolution() const
+{
+  return m_resolution;
+}
+
+/**
+ * Returns @c true if the given @a window is the offscreen window in which the
+ * dashboard is rendered, its widgets must stay enabled even though the window
+ * is never shown
+ */
+bool UI::DashboardRecorder::isOffscreenWindow(const QWindow *window) const
+{
+  return window && window == m_window.get();
+}
+
+/**
+ * Stops the current recording, the video file is finalized by Qt Multimedia
+ * in the background
+ */
+void UI::DashboardRecorder::stop()
+{
+  if (!m_recording)
+    return;
+
+  m_timer.stop();
+  m_recording = false;
+  m_pendingFrame = QVideoFrame();
+  if (m_output == Output::Video)
+    m_mediaRecorder.stop();
+
+  Q_EMIT recordingChanged();
+  Q_EMIT recordingFinished(m_path);
+}
+
+/**
+ * Sets the QML @a engine used to instantiate the offscreen dashboard, which
+ * must be the engine of the user interface, since the dashboard needs its
+ * context properties
+ */
+void UI::DashboardRecorder::setEngine(QQmlEngine *engine)
+{
+  m_engine = engine;
+}
+
+/**
+ * Changes the number of frames rendered per second of recording, the value
+ * is saved in the application settings. It can't be changed while recording.
+ */
+void UI::DashboardRecorder::setFrameRate(const int fps)
+{
+  const auto rate = qBound(kMinFrameRate, fps, kMaxFrameRate);
+  if (m_frameRate != rate && !m_recording)
+  {
+    m_frameRate = rate;
+    m_settings.setValue("recorder_frame_rate", rate);
+    Q_EMIT frameRateChanged();
+  }
+}
+
+/**
+ * Changes the size (in pixels) of the rendered images, the value is saved in
+ * the application settings. It can't be changed while recording.
+ *
+ * Dimensions are rounded down to even values, as required by most video
+ * codecs.
+ */
+void UI::DashboardRecorder::setResolution(const QSize &size)
+{
+  const auto w = qBound(kMinImageSize, size.width(), kMaxImageSize) & ~1;
+  const auto h = qBound(kMinImageSize, size.height(), kMaxImageSize) & ~1;
+  if (m_resolution != QSize(w, h) && !m_recording)
+  {
+    release();
+    m_resolution = QSize(w, h);
+    m_settings.setValue("recorder_resolution", m_resolution);
+    Q_EMIT resolutionChanged();
+  }
+}
+
+/**
+ * Asks the user where to save a snapshot of the dashboard & saves it
+ */
+void UI::DashboardRecorder::saveSnapshot()
+{
+  const auto now = QDateTime::currentDateTime();
+  const auto name = now.toString(QStringLiteral("yyyy-MM-dd_HH-mm-ss"));
+  const auto path = QFileDialog::getSaveFileName(
+      nullptr, tr("Save dashboard snapshot"),
+      outputPath() + name + QStringLiteral(".png"),
+      tr("Images") + QStringLiteral(" (*.png *.jpg *.bmp)"));
+
+  if (!path.isEmpty())
+    (void)saveSnapshot(path);
+}
+
+/**
+ * Asks the user where to save a video of the dashboard & starts recording
+ */
+void UI::DashboardRecorder::recordVideo()
+{
+  const auto now = QDateTime::currentDateTime();
+  const auto name = now.toString(QStringLiteral("yyyy-MM-dd_HH-mm-ss"));
+  const auto path = QFileDialog::getSaveFileName(
+      nullptr, tr("Record dashboard video"),
+      outputPath() + name + QStringLiteral(".mp4"),
+      tr("Videos") + QStringLiteral(" (*.mp4)"));
+
+  if (!path.isEmpty())
+    (void)recordVideo(path);
+}
+
+/**
+ * Asks the user for a directory & starts recording an image sequence in it
+ */
+void UI::DashboardRecorder::recordImages()
+{
+  const auto path = QFileDialog::getExistingDirectory(
+      nullptr, tr("Select a directory for the dashboard images"),
+      outputPath());
+
+  if (!path.isEmpty())
+    (void)recordImages(path);
+}
+
+/**
+ * Renders the current state of the dashboard to the image file at @a path.
+ *
+ * The image is saved once the offscreen dashboard is ready, which is
+ * reported with the @c snapshotSaved() signal.
+ *
+ * @return @c false if the offscreen renderer could not be created.
+ */
+bool UI::DashboardRecorder::saveSnapshot(const QString &path)
+{
+  if (!initialize())
+    return false;
+
+  QTimer::singleShot(warmupDelay(), this, [=] {
+    updateDashboard();
+    const auto image = renderFrame();
+    if (image.isNull() || !image.save(path))
+    {
+      Misc::Utilities::showMessageBox(
+          tr("Dashboard snapshot error"),
+          tr("Cannot save the image to \"%1\".").arg(path));
+      return;
+    }
+
+    Q_EMIT snapshotSaved(path);
+  });
+
+  return true;
+}
+
+/**
+ * Starts recording the dashboard to the MP4 video file at @a path.
+ *
+ * @return @c false if the recording could not be started.
+ */
+bool UI::DashboardRecorder::recordVideo(const QString &path)
+{
+  return start(Output::Video, path);
+}
+
+/**
+ * Starts recording the dashboard to a sequence of numbered PNG files in the
+ * given @a directory.
+ *
+ * @return @c false if the recording could not be started.
+ */
+bool UI::DashboardRecorder::recordImages(const QString &directory)
+{
+  return start(Output::Images, directory);
+}
+
+/**
+ * Sends the rows of the next frame period of the replayed CSV file, and
+ * renders the frame once they have been processed.
+ */
+void UI::DashboardRecorder::step()
+{
+  if (!m_recording)
+    return;
+
+  // Wait for the image encoders to catch up
+  const auto pending = m_pendingImages->load();
+  if (m_output == Output::Images && pending >= kMaxPendingImages)
+  {
+    QTimer::singleShot(kRetryInterval, this, &UI::DashboardRecorder::step);
+    return;
+  }
+
+  // Send the rows that are due at the time of the next frame
+  const auto time = m_replayStart + m_frameCount * 1000LL / m_frameRate;
+  m_lastFrame = !CSV::Player::instance().advanceTo(time);
+
+  // The frame builder processes the rows before this call is delivered
+  QMetaObject::invokeMethod(this, &UI::DashboardRecorder::captureFrame,
+                            Qt::QueuedConnection);
+}
+
+/**
+ * Renders & encodes one frame of the recording.
+ *
+ * Live recordings drop the frame if the encoders are busy. Replays wait for
+ * the video encoder before sending the rows of the next frame.
+ */
+void UI::DashboardRecorder::captureFrame()
+{
+  if (!m_recording)
+    return;
+
+  updateDashboard();
+  if (writeFrame(renderFrame()))
+    onFrameWritten();
+}
+
+/**
+ * Sends the video frame that was rejected by the encoder once it is ready to
+ * receive frames again, and continues the replay.
+ */
+void UI::DashboardRecorder::onVideoInputReady()
+{
+  if (!m_recording || !m_pendingFrame.isValid() || !m_videoInput)
+    return;
+
+  if (m_videoInput->sendVideoFrame(m_pendingFrame))
+  {
+    m_pendingFrame = QVideoFrame();
+    onFrameWritten();
+  }
+}
+
+/**
+ * Creates the offscreen window, the dashboard grid & the texture in which the
+ * dashboard is rendered, if they don't exist yet.
+ *
+ * @return @c false if the offscreen renderer could not be created.
+ */
+bool UI::DashboardRecorder::initialize()
+{
+  // Renderer already created
+  if (m_window)
+    return true;
+
+  // The dashboard needs the context properties of the user interface
+  if (!m_engine)
+  {
+    qWarning() << "Dashboard recorder: QML engine not available";
+    return false;
+  }
+
+  // Create the offscreen window
+  const auto &theme = Misc::ThemeManager::instance();
+  m_renderControl = std::make_unique<QQuickRenderControl>();
+  m_window = std::make_unique<QQuickWindow>(m_renderControl.get());
+  m_window->setColor(theme.getColor("dashboard_background"));
+  m_window->setGeometry(QRect(QPoint(0, 0), m_resolution));
+  m_window->contentItem()->setSize(m_resolution);
+
+  // Instantiate the dashboard grid
+  QQmlComponent component(m_engine, QUrl(QString::fromLatin1(kDashboardQml)));
+  auto *object = component.create();
+  m_rootItem.reset(qobject_cast<QQuickItem *>(object));
+  if (!m_rootItem)
+  {
+    qWarning() << "Dashboard recorder:" << component.errorString();
+    delete object;
+    release();
+    return false;
+  }
+
+  m_rootItem->setParentItem(m_window->contentItem());
+  m_rootItem->setSize(m_resolution);
+
+  // Initialize the graphics API
+  if (!m_renderControl->initialize())
+  {
+    qWarning() << "Dashboard recorder: cannot initialize the renderer";
+    release();
+    return false;
+  }
+
+  // Create the texture in which the dashboard is rendered
+  auto *rhi = m_renderControl->rhi();
+  m_texture.reset(rhi->newTexture(QRhiTexture::RGBA8, m_resolution, 1,
+                                  QRhiTexture::RenderTarget
+                                      | QRhiTexture::UsedAsTransferSource));
+  m_depthStencil.reset(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil,
+                                            m_resolution, 1));
+  if (!m_texture->create() || !m_depthStencil->create())
+  {
+    qWarning() << "Dashboard recorder: cannot create the render texture";
+    release();
+    return false;
+  }
+
+  // Create the render target
+  QRhiTextureRenderTargetDescription description(
+      (QRhiColorAttachment(m_texture.get())));
+  description.setDepthStencilBuffer(m_depthStencil.get());
+  m_renderTarget.reset(rhi->newTextureRenderTarget(description));
+  m_renderPass.reset(m_renderTarget->newCompatibleRenderPassDescriptor());
+  m_renderTarget->setRenderPassDescriptor(m_renderPass.get());
+  if (!m_renderTarget->create())
+  {
+    qWarning() << "Dashboard recorder: cannot create the render target";
+    release();
+    return false;
+  }
+
+  // Render the window into the texture
+  m_window->setRenderTarget(
+      QQuickRenderTarget::fromRhiRenderTarget(m_renderTarget.get()));
+
+  // Give the widgets some time to load
+  m_warmupClock.start();
+  return true;
+}
+
+/**
+ * Destroys the offscreen dashboard & the graphics resources used to render
+ * it, the graphics resources must be destroyed before the render control.
+ */
+void UI::DashboardRecorder::release()
+{
+  m_renderTarget.reset();
+  m_renderPass.reset();
+  m_depthStencil.reset();
+  m_texture.reset();
+  m_renderControl.reset();
+  m_rootItem.reset();
+  m_window.reset();
+}
+
+/**
+ * Counts the frame that was just encoded, and continues the replay (or stops
+ * the recording after the last frame of the replayed file).
+ */
+void UI::DashboardRecorder::onFrameWritten()
+{
+  ++m_frameCount;
+  Q_EMIT frameCountChanged();
+
+  if (m_replay)
+  {
+    if (m_lastFrame)
+      stop();
+    else
+      QMetaObject::invokeMethod(this, &UI::DashboardRecorder::step,
+                                Qt::QueuedConnection);
+  }
+}
+
+/**
+ * Processes the frames received so far & updates the dashboard widgets,
+ * without waiting for the UI refresh tick (which is not related to the frame
+ * rate of the recording, and is reduced when the windows are minimized).
+ */
+void UI::DashboardRecorder::updateDashboard()
+{
+  auto &dashboard = UI::Dashboard::instance();
+  dashboard.readFrameBus();
+  dashboard.updateWidgets();
+}
+
+/**
+ * Starts recording the dashboard to the given @a output.
+ *
+ * If a CSV file is open in the player, the file is replayed from its current
+ * position as fast as the frames can be rendered. Otherwise, the live
+ * dashboard is captured with a timer.
+ *
+ * @return @c false if the recording could not be started.
+ */
+bool UI::DashboardRecorder::start(const Output output, const QString &path)
+{
+  // Stop the current recording
+  stop();
+
+  // Replayed files need valid timestamps to be stepped
+  auto &player = CSV::Player::instance();
+  const auto replay = player.isOpen();
+  const auto replayStart = player.currentTime();
+  if (replay && replayStart == std::numeric_limits<qint64>::min())
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Dashboard recording error"),
+        tr("The date/time of the current row of the CSV file is invalid."));
+    return false;
+  }
+
+  // Create the offscreen renderer
+  if (!initialize())
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Dashboard recording error"),
+        tr("Cannot create the offscreen dashboard renderer."));
+    return false;
+  }
+
+  // Create the output directory for image sequences
+  if (output == Output::Images && !QDir().mkpath(path))
+  {
+    Misc::Utilities::showMessageBox(
+        tr("Dashboard recording error"),
+        tr("Cannot create the directory \"%1\".").arg(path));
+    return false;
+  }
+
+  // Configure the video encoder
+  if (output == Output::Video)
+  {
+    m_videoInput = std::make_unique<QVideoFrameInput>();
+    connect(m_videoInput.get(), &QVideoFrameInput::readyToSendVideoFrame, this,
+            &UI::DashboardRecorder::onVideoInputReady);
+
+    QMediaFormat format(QMediaFormat::MPEG4);
+    format.setVideoCodec(QMediaFormat::VideoCodec::H264);
+    m_session.setVideoFrameInput(m_videoInput.get());
+    m_session.setRecorder(&m_mediaRecorder);
+    m_mediaRecorder.setMediaFormat(format);
+    m_mediaRecorder.setVideoFrameRate(m_frameRate);
+    m_mediaRecorder.setVideoResolution(m_resolution);
+    m_mediaRecorder.setQuality(QMediaRecorder::HighQuality);
+    m_mediaRecorder.setOutputLocation(QUrl::fromLocalFile(path));
+    m_mediaRecorder.record();
+  }
+
+  // Start recording
+  m_path = path;
+  m_output = output;
+  m_replay = replay;
+  m_lastFrame = false;
+  m_recording = true;
+  m_frameCount = 0;
+  m_replayStart = replayStart;
+  m_clock.start();
+  Q_EMIT recordingChanged();
+  Q_EMIT frameCountChanged();
+
+  // Step through the replayed file, or capture the live dashboard
+  if (m_replay)
+  {
+    if (player.isPlaying())
+      player.pause();
+
+    QTimer::singleShot(warmupDelay(), this, &UI::DashboardRecorder::step);
+  }
+
+  else
+    QTimer::singleShot(warmupDelay(), this,
+                       [=] { m_timer.start(1000 / m_frameRate); });
+
+  return true;
+}
+
+/**
+ * Returns the time (in milliseconds) left before the offscreen dashboard can
+ * be rendered, see @c kWarmupInterval
+ */
+int UI::DashboardRecorder::warmupDelay() const
+{
+  const auto elapsed = m_warmupClock.isValid() ? m_warmupClock.elapsed() : 0;
+  return static_cast<int>(qMax<qint64>(0, kWarmupInterval - elapsed));
+}
+
+/**
+ * Returns the default directory of the snapshots & recordings
+ */
+QString UI::DashboardRecorder::outputPath() const
+{
+  const auto path = QStringLiteral("%1/%2/Recordings/")
+                        .arg(QStandardPaths::writableLocation(
+                                 QStandardPaths::DocumentsLocation),
+                             qApp->applicationDisplayName());
+
+  QDir dir(path);
+  if (!dir.exists())
+    dir.mkpath(".");
+
+  return path;
+}
+
+/**
+ * Renders the offscreen dashboard & reads the rendered image back.
+ *
+ * @return The rendered image, or a null image if the renderer does not exist.
+ */
+QImage UI::DashboardRecorder::renderFrame()
+{
+  if (!m_window || !m_renderControl)
+    return QImage();
+
+  // Render the dashboard
+  auto *rhi = m_renderControl->rhi();
+  m_renderControl->polishItems();
+  m_renderControl->beginFrame();
+  m_renderControl->sync();
+  m_renderControl->render();
+
+  // Read the texture back, the result is available once the frame ends
+  QRhiReadbackResult result;
+  auto *batch = rhi->nextResourceUpdateBatch();
+  batch->readBackTexture(m_texture.get(), &result);
+  m_renderControl->commandBuffer()->resourceUpdate(batch);
+  m_renderControl->endFrame();
+
+  // Wrap the pixels in an image
+  const QImage image(reinterpret_cast<const uchar *>(result.data.constData()),
+                     result.pixelSize.width(), result.pixelSize.height(),
+                     QImage::Format_RGBA8888_Premultiplied);
+  if (rhi->isYUpInFramebuffer())
+    return image.mirrored();
+
+  return image.copy();
+}
+
+/**
+ * Hands the given @a image to the encoder of the current recording.
+ *
+ * @return @c false if the encoder can't receive the image yet, in which case
+ *         replays keep the video frame until the encoder is ready.
+ */
+bool UI::DashboardRecorder::writeFrame(const QImage &image)
+{
+  if (image.isNull())
+    return false;
+
+  // Encode the image as a PNG file on a worker thread
+  if (m_output == Output::Images)
+  {
+    if (m_pendingImages->load() >= kMaxPendingImages)
+      return false;
+
+    const auto name = QStringLiteral("frame_%1.png")
+                          .arg(m_frameCount, 6, 10, QLatin1Char('0'));
+    const auto path = QDir(m_path).filePath(name);
+    auto pending = m_pendingImages;
+    pending->fetch_add(1);
+    Misc::WorkerPool::instance().start([image, path, pending] {
+      if (!image.save(path, "PNG"))
+        qWarning() << "Dashboard recorder: cannot save" << path;
+
+      pending->fetch_sub(1);
+    });
+
+    return true;
+  }
+
+  // Replays use the frame period as timestamp, live recordings the real time
+  qint64 start = m_frameCount * 1000000LL / m_frameRate;
+  if (!m_replay)
+    start = m_clock.nsecsElapsed() / 1000;
+
+  // Send the image to the video encoder
+  QVideoFrame frame(image);
+  frame.setStartTime(start);
+  frame.setEndTime(start + 1000000LL / m_frameRate);
+  if (m_videoInput && m_videoInput->sendVideoFrame(frame))
+    return true;
+
+  if (m_replay)
+    m_pendingFrame = frame;
+
+  return false;
+}
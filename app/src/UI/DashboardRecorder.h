@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QSize>
+#include <QTimer>
+#include <QObject>
+#include <QSettings>
+#include <QElapsedTimer>
+#include <QVideoFrame>
+#include <QMediaRecorder>
+#include <QVideoFrameInput>
+#include <QMediaCaptureSession>
+
+class QWindow;
+class QQmlEngine;
+class QQuickItem;
+class QQuickWindow;
+class QQuickRenderControl;
+
+class QRhiTexture;
+class QRhiRenderBuffer;
+class QRhiTextureRenderTarget;
+class QRhiRenderPassDescriptor;
+
+namespace UI
+{
+/**
+ * @brief The DashboardRecorder class
+ *
+ * Renders the dashboard offscreen, without a visible window & without
+ * grabbing the screen, to produce snapshots, image sequences or encoded
+ * videos (e.g. for test reports).
+ *
+ * The dashboard grid is instantiated in a @c QQuickWindow driven by a
+ * @c QQuickRenderControl, which renders into a texture of the selected
+ * resolution that is read back after each frame. Frames are rendered at a
+ * fixed rate:
+ *
+ * - With live data, a timer captures the current state of the dashboard.
+ * - When a CSV file is replayed, the player is stepped by one frame period
+ *   for each rendered frame (see @c CSV::Player::advanceTo()), so that the
+ *   session is rendered as fast as the frames can be produced, which is
+ *   usually much faster than real-time.
+ *
+ * Images are encoded as PNG files by the @c Misc::WorkerPool, and videos are
+ * encoded by Qt Multimedia through a @c QVideoFrameInput. Replays wait for
+ * the encoders when they fall behind, while live recordings drop the frames
+ * that can't be encoded in time.
+ */
+class DashboardRecorder : public QObject
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(bool recording
+             READ recording
+             NOTIFY recordingChanged)
+  Q_PROPERTY(int frameCount
+             READ frameCount
+             NOTIFY frameCountChanged)
+  Q_PROPERTY(int frameRate
+             READ frameRate
+             WRITE setFrameRate
+             NOTIFY frameRateChanged)
+  Q_PROPERTY(QSize resolution
+             READ resolution
+             WRITE setResolution
+             NOTIFY resolutionChanged)
+  // clang-format on
+
+signals:
+  void recordingChanged();
+  void frameCountChanged();
+  void frameRateChanged();
+  void resolutionChanged();
+  void snapshotSaved(const QString &path);
+  void recordingFinished(const QString &path);
+
+private:
+  explicit DashboardRecorder();
+  DashboardRecorder(DashboardRecorder &&) = delete;
+  DashboardRecorder(const DashboardRecorder &) = delete;
+  DashboardRecorder &operator=(DashboardRecorder &&) = delete;
+  DashboardRecorder &operator=(const DashboardRecorder &) = delete;
+
+  ~DashboardRecorder();
+
+public:
+  static DashboardRecorder &instance();
+
+  [[nodiscard]] bool recording() const;
+  [[nodiscard]] int frameCount() const;
+  [[nodiscard]] int frameRate() const;
+  [[nodiscard]] QSize resolution() const;
+
+  [[nodiscard]] bool isOffscreenWindow(const QWindow *window) const;
+
+public slots:
+  void stop();
+  void setEngine(QQmlEngine *engine);
+  void setFrameRate(const int fps);
+  void setResolution(const QSize &size);
+
+  void saveSnapshot();
+  void recordVideo();
+  void recordImages();
+  bool saveSnapshot(const QString &path);
+  bool recordVideo(const QString &path);
+  bool recordImages(const QString &directory);
+
+private slots:
+  void step();
+  void captureFrame();
+  void onVideoInputReady();
+
+private:
+  enum class Output
+  {
+    Images,
+    Video
+  };
+
+  bool initialize();
+  void release();
+  void onFrameWritten();
+  void updateDashboard();
+  bool start(const Output output, const QString &path);
+
+  [[nodiscard]] int warmupDelay() const;
+  [[nodiscard]] QString outputPath() const;
+
+  [[nodiscard]] QImage renderFrame();
+  [[nodiscard]] bool writeFrame(const QImage &image);
+
+private:
+  QQmlEngine *m_engine;
+  std::unique_ptr<QQuickRenderControl> m_renderControl;
+  std::unique_ptr<QQuickWindow> m_window;
+  std::unique_ptr<QQuickItem> m_rootItem;
+
+  std::unique_ptr<QRhiTexture> m_texture;
+  std::unique_ptr<QRhiRenderBuffer> m_depthStencil;
+  std::unique_ptr<QRhiTextureRenderTarget> m_renderTarget;
+  std::unique_ptr<QRhiRenderPassDescriptor> m_renderPass;
+
+  Output m_output;
+  QString m_path;
+  bool m_replay;
+  bool m_lastFrame;
+  bool m_recording;
+  int m_frameRate;
+  int m_frameCount;
+  QSize m_resolution;
+  qint64 m_replayStart;
+
+  QTimer m_timer;
+  QElapsedTimer m_clock;
+  QElapsedTimer m_warmupClock;
+  QSettings m_settings;
+  std::shared_ptr<std::atomic<int>> m_pendingImages;
+
+  QVideoFrame m_pendingFrame;
+  QMediaRecorder m_mediaRecorder;
+  QMediaCaptureSession m_session;
+  std::unique_ptr<QVideoFrameInput> m_videoInput;
+};
+} // namespace UI
@@ -20,9 +20,12 @@
  * THE SOFTWARE.
  */
 
+#include <QQuickWindow>
+
 #include "UI/DashboardWidget.h"
 
 #include "UI/Dashboard.h"
+#include "UI/DashboardRecorder.h"
 #include "UI/Widgets/Bar.h"
 #include "UI/Widgets/GPS.h"
 #include "UI/Widgets/Plot.h"
@@ -33,9 +36,12 @@
 #include "UI/Widgets/DataGrid.h"
 #include "UI/Widgets/Gyroscope.h"
 #include "UI/Widgets/MultiPlot.h"
+#include "UI/Widgets/Waterfall.h"
 #include "UI/Widgets/Accelerometer.h"
 
+#include "Misc/TimerEvents.h"
 #include "Misc/ThemeManager.h"
+#include "Misc/WidgetBenchmark.h"
 
 /**
  * Constructor function
@@ -52,6 +58,8 @@ UI::DashboardWidget::DashboardWidget(QQuickItem *parent)
           &UI::DashboardWidget::widgetColorChanged);
   connect(&Misc::ThemeManager::instance(), &Misc::ThemeManager::themeChanged,
           this, &UI::DashboardWidget::widgetColorChanged);
+  connect(&UI::Dashboard::instance(), &UI::Dashboard::widgetCountChanged, this,
+          &UI::DashboardWidget::onWidgetsChanged);
 }
 
 /**
@@ -91,7 +99,7 @@ QColor UI::DashboardWidget::widgetColor() const
     if (SerialStudio::isDatasetWidget(m_widgetType))
     {
       const auto &dataset = GET_DATASET(m_widgetType, m_relativeIndex);
-      return QColor(SerialStudio::getDatasetColor(dataset.index()));
+      return Misc::ThemeManager::instance().datasetColor(dataset.index());
     }
   }
 
@@ -154,80 +162,177 @@ QQuickItem *UI::DashboardWidget::widgetModel() const
 }
 
 /**
- * Selects & configures the appropiate widget for the given @a index
+ * Selects & configures the appropiate widget for the given @a index.
+ *
+ * Once a widget has been created, changing the index does not re-create it
+ * immediately, since the index changes while the dashboard inserts & removes
+ * the rows of other widgets. The widget is re-created (if needed) once the
+ * dashboard notifies that its widget list has been updated.
  */
 void UI::DashboardWidget::setWidgetIndex(const int index)
 {
   if (index < UI::Dashboard::instance().totalWidgetCount() && index >= 0)
   {
-    // Update widget index
     m_index = index;
-    m_widgetType = UI::Dashboard::instance().widgetType(index);
-    m_relativeIndex = UI::Dashboard::instance().relativeIndex(index);
+    if (!m_dbWidget)
+      createWidget();
+  }
+}
 
-    // Delete previous widget
-    if (m_dbWidget)
-    {
-      m_dbWidget->deleteLater();
-      m_dbWidget = nullptr;
-    }
+/**
+ * Re-creates the widget if the widget type or relative index that corresponds
+ * to the current global index changed after the dashboard updated its widget
+ * list, otherwise the existing widget (and its state) is kept.
+ */
+void UI::DashboardWidget::onWidgetsChanged()
+{
+  if (!m_dbWidget || m_index < 0)
+    return;
 
-    // Construct new widget
-    switch (widgetType())
-    {
-      case SerialStudio::DashboardDataGrid:
-        m_dbWidget = new Widgets::DataGrid(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/DataGrid.qml";
-        break;
-      case SerialStudio::DashboardMultiPlot:
-        m_dbWidget = new Widgets::MultiPlot(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/MultiPlot.qml";
-        break;
-      case SerialStudio::DashboardFFT:
-        m_dbWidget = new Widgets::FFTPlot(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/FFTPlot.qml";
-        break;
-      case SerialStudio::DashboardPlot:
-        m_dbWidget = new Widgets::Plot(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Plot.qml";
-        break;
-      case SerialStudio::DashboardBar:
-        m_dbWidget = new Widgets::Bar(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Bar.qml";
-        break;
-      case SerialStudio::DashboardGauge:
-        m_dbWidget = new Widgets::Gauge(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Gauge.qml";
-        break;
-      case SerialStudio::DashboardCompass:
-        m_dbWidget = new Widgets::Compass(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Compass.qml";
-        break;
-      case SerialStudio::DashboardGyroscope:
-        m_dbWidget = new Widgets::Gyroscope(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Gyroscope.qml";
-        break;
-      case SerialStudio::DashboardAccelerometer:
-        m_dbWidget = new Widgets::Accelerometer(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/Accelerometer.qml";
-        break;
-      case SerialStudio::DashboardGPS:
-        m_dbWidget = new Widgets::GPS(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/GPS.qml";
-        break;
-      case SerialStudio::DashboardLED:
-        m_dbWidget = new Widgets::LEDPanel(relativeIndex(), this);
-        m_qmlPath = "qrc:/qml/Widgets/Dashboard/LEDPanel.qml";
-        break;
-      default:
-        break;
-    }
+  if (m_index >= UI::Dashboard::instance().totalWidgetCount())
+    return;
+
+  const auto type = UI::Dashboard::instance().widgetType(m_index);
+  const auto relativeIndex = UI::Dashboard::instance().relativeIndex(m_index);
+  if (type != m_widgetType || relativeIndex != m_relativeIndex)
+    createWidget();
+  else
+    Q_EMIT widgetIndexChanged();
+}
+
+/**
+ * Constructs the widget that corresponds to the current global index,
+ * deleting the previous widget (if any).
+ */
+void UI::DashboardWidget::createWidget()
+{
+  // Update widget type & relative index
+  m_widgetType = UI::Dashboard::instance().widgetType(m_index);
+  m_relativeIndex = UI::Dashboard::instance().relativeIndex(m_index);
+
+  // Delete previous widget
+  if (m_dbWidget)
+  {
+    m_dbWidget->deleteLater();
+    m_dbWidget = nullptr;
+  }
 
-    // Configure widget
-    if (m_dbWidget)
+  // Construct new widget
+  switch (widgetType())
+  {
+    case SerialStudio::DashboardDataGrid:
+      m_dbWidget = new Widgets::DataGrid(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/DataGrid.qml";
+      break;
+    case SerialStudio::DashboardMultiPlot:
+      m_dbWidget = new Widgets::MultiPlot(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/MultiPlot.qml";
+      break;
+    case SerialStudio::DashboardFFT:
+      m_dbWidget = new Widgets::FFTPlot(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/FFTPlot.qml";
+      break;
+    case SerialStudio::DashboardWaterfall:
+      m_dbWidget = new Widgets::Waterfall(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Waterfall.qml";
+      break;
+    case SerialStudio::DashboardPlot:
+      m_dbWidget = new Widgets::Plot(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Plot.qml";
+      break;
+    case SerialStudio::DashboardBar:
+      m_dbWidget = new Widgets::Bar(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Bar.qml";
+      break;
+    case SerialStudio::DashboardGauge:
+      m_dbWidget = new Widgets::Gauge(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Gauge.qml";
+      break;
+    case SerialStudio::DashboardCompass:
+      m_dbWidget = new Widgets::Compass(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Compass.qml";
+      break;
+    case SerialStudio::DashboardGyroscope:
+      m_dbWidget = new Widgets::Gyroscope(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Gyroscope.qml";
+      break;
+    case SerialStudio::DashboardAccelerometer:
+      m_dbWidget = new Widgets::Accelerometer(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/Accelerometer.qml";
+      break;
+    case SerialStudio::DashboardGPS:
+      m_dbWidget = new Widgets::GPS(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/GPS.qml";
+      break;
+    case SerialStudio::DashboardLED:
+      m_dbWidget = new Widgets::LEDPanel(relativeIndex(), this);
+      m_qmlPath = "qrc:/qml/Widgets/Dashboard/LEDPanel.qml";
+      break;
+    default:
+      break;
+  }
+
+  // Configure widget
+  if (m_dbWidget)
+  {
+    m_dbWidget->setParentItem(this);
+    updateWindowState();
+    Q_EMIT widgetIndexChanged();
+  }
+}
+
+/**
+ * Suspends the widget while its window is minimized or hidden, the dashboard
+ * skips the update functions of disabled widgets & updates them as soon as
+ * they are enabled again.
+ */
+void UI::DashboardWidget::updateWindowState()
+{
+  if (!m_dbWidget)
+    return;
+
+  bool visible = false;
+  if (UI::DashboardRecorder::instance().isOffscreenWindow(m_window)
+      || Misc::WidgetBenchmark::isOffscreenWindow(m_window))
+    visible = true;
+
+  else if (m_window)
+  {
+    const auto visibility = m_window->visibility();
+    visible = visibility != QWindow::Hidden && visibility != QWindow::Minimized;
+  }
+
+  m_dbWidget->setEnabled(visible);
+}
+
+/**
+ * Registers the window that displays the widget with the UI refresh scheduler
+ * & the latency measurement of the dashboard, and follows its visibility.
+ */
+void UI::DashboardWidget::itemChange(ItemChange change,
+                                     const ItemChangeData &value)
+{
+  if (change == ItemSceneChange)
+  {
+    if (m_window)
+      disconnect(m_window, nullptr, this, nullptr);
+
+    m_window = value.window;
+    const auto &recorder = UI::DashboardRecorder::instance();
+    if (m_window && !recorder.isOffscreenWindow(m_window)
+        && !Misc::WidgetBenchmark::isOffscreenWindow(m_window))
     {
-      m_dbWidget->setParentItem(this);
-      Q_EMIT widgetIndexChanged();
+      Misc::TimerEvents::instance().trackWindow(m_window);
+      connect(m_window, &QQuickWindow::frameSwapped, &UI::Dashboard::instance(),
+              &UI::Dashboard::onFrameSwapped,
+              static_cast<Qt::ConnectionType>(Qt::DirectConnection
+                                              | Qt::UniqueConnection));
+      connect(m_window, &QWindow::visibilityChanged, this,
+              &UI::DashboardWidget::updateWindowState);
     }
+
+    updateWindowState();
   }
+
+  QQuickItem::itemChange(change, value);
 }
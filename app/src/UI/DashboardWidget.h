@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <QPointer>
 #include <QQuickItem>
 
 #include "SerialStudio.h"
@@ -43,6 +44,13 @@ namespace UI
  *
  * The class also manages special cases like GPS widgets and external windows,
  * providing properties and methods to handle these scenarios.
+ *
+ * Dashboards can span several windows (e.g. widgets popped out to other
+ * monitors). Every window that displays a widget is registered with the UI
+ * refresh scheduler (see @c Misc::TimerEvents) & the end-to-end latency
+ * measurement of @c UI::Dashboard, so that all windows are updated on the
+ * same refresh tick from the same histories. Widgets are suspended while
+ * their window is minimized or hidden, and updated as soon as it is shown.
  */
 class DashboardWidget : public QQuickItem
 {
@@ -93,6 +101,16 @@ public:
 public slots:
   void setWidgetIndex(const int index);
 
+private slots:
+  void onWidgetsChanged();
+  void updateWindowState();
+
+protected:
+  void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+  void createWidget();
+
 private:
   int m_index;
   int m_relativeIndex;
@@ -100,5 +118,6 @@ private:
 
   QString m_qmlPath;
   QQuickItem *m_dbWidget;
+  QPointer<QQuickWindow> m_window;
 };
 } // namespace UI
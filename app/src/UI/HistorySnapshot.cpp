@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "UI/HistorySnapshot.h"
+#include "Misc/SessionClock.h"
+
+/**
+ * Magic number at the start of the snapshot file ("SSHS").
+ */
+static constexpr quint32 kSnapshotMagic = 0x53485353;
+
+/**
+ * Version of the snapshot format, files of other versions are ignored.
+ */
+static constexpr quint32 kSnapshotVersion = 1;
+
+/**
+ * @brief Fixed-size header of the snapshot file.
+ */
+struct SnapshotHeader
+{
+  quint32 magic;
+  quint32 version;
+  qint64 curves;
+  qint64 timestamps;
+  qint64 projectBytes;
+};
+
+/**
+ * @brief Fixed-size header of each history in the snapshot file.
+ */
+struct CurveHeader
+{
+  qint64 keyBytes;
+  qint64 samples;
+};
+
+/**
+ * Returns @a bytes rounded up to a multiple of 8.
+ */
+static qint64 padded(const qint64 bytes)
+{
+  return (bytes + 7) & ~qint64(7);
+}
+
+/**
+ * Writes @a bytes of @a data to the @a file, followed by the padding that
+ * aligns the next block to 8 bytes.
+ */
+static void writeBlock(QSaveFile &file, const void *data, const qint64 bytes)
+{
+  static const char zeros[8] = {};
+  file.write(static_cast<const char *>(data), bytes);
+  file.write(zeros, padded(bytes) - bytes);
+}
+
+/**
+ * @brief Returns the path of the snapshot file.
+ */
+QString UI::HistorySnapshot::filePath()
+{
+  const auto dir
+      = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return QDir(dir).filePath(QStringLiteral("dashboard-history.bin"));
+}
+
+/**
+ * @brief Writes the histories of the given @a project to the snapshot file.
+ *
+ * @param project Identity of the project, compared by @c load().
+ * @param keys Dataset key of each history.
+ * @param curves Sample history of each dataset.
+ * @param timeline Acquisition time of the samples of every history.
+ *
+ * @return @c true if the snapshot was written.
+ */
+bool UI::HistorySnapshot::save(const QString &project,
+                               const QStringList &keys,
+                               const QVector<Curve> &curves,
+                               const Timeline &timeline)
+{
+  // Create the cache directory (if needed)
+  const auto path = filePath();
+  QDir().mkpath(QFileInfo(path).absolutePath());
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    qWarning() << "Cannot write the dashboard history snapshot:"
+               << file.errorString();
+    return false;
+  }
+
+  // Write the header & the project identity
+  const auto count = qMin(keys.count(), curves.count());
+  const auto projectId = project.toUtf8();
+  SnapshotHeader header;
+  header.magic = kSnapshotMagic;
+  header.version = kSnapshotVersion;
+  header.curves = count;
+  header.timestamps = timeline.count();
+  header.projectBytes = projectId.size();
+  writeBlock(file, &header, sizeof(header));
+  writeBlock(file, projectId.constData(), projectId.size());
+
+  // Write each history, oldest sample first
+  QVector<double> samples;
+  for (qsizetype i = 0; i < count; ++i)
+  {
+    const auto key = keys[i].toUtf8();
+    const auto &curve = curves[i];
+
+    CurveHeader curveHeader;
+    curveHeader.keyBytes = key.size();
+    curveHeader.samples = curve.count();
+    writeBlock(file, &curveHeader, sizeof(curveHeader));
+    writeBlock(file, key.constData(), key.size());
+
+    samples.resize(curve.count());
+    qsizetype j = 0;
+    const auto first = curve.firstSpan();
+    const auto second = curve.secondSpan();
+    for (qsizetype k = 0; k < first.count; ++k)
+      samples[j++] = first.data[k];
+    for (qsizetype k = 0; k < second.count; ++k)
+      samples[j++] = second.data[k];
+
+    writeBlock(file, samples.constData(), samples.size() * sizeof(double));
+  }
+
+  // Write the timeline as wall clock time, 0 marks unwritten slots
+  QVector<qint64> timestamps(timeline.count());
+  for (qsizetype i = 0; i < timeline.count(); ++i)
+  {
+    const auto timestamp = timeline.at(i);
+    timestamps[i] = timestamp > 0 ? Misc::SessionClock::toUnixNsecs(timestamp)
+                                  : 0;
+  }
+
+  writeBlock(file, timestamps.constData(),
+             timestamps.size() * sizeof(qint64));
+
+  return file.commit();
+}
+
+/**
+ * @brief Reads the histories of the given @a project from the snapshot file.
+ *
+ * The file is memory-mapped & the samples are appended to the restored curves
+ * straight from the mapping. The timeline is converted to the steady clock of
+ * the current session, samples taken before the session started are placed
+ * at its very beginning.
+ *
+ * @return @c false if there is no snapshot, if it is invalid or if it belongs
+ *         to another project, in which case the outputs are left unchanged.
+ */
+bool UI::HistorySnapshot::load(const QString &project, QStringList &keys,
+                               QVector<Curve> &curves, Timeline &timeline)
+{
+  QFile file(filePath());
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  const auto size = file.size();
+  if (size < static_cast<qint64>(sizeof(SnapshotHeader)))
+    return false;
+
+  const auto *data = file.map(0, size);
+  if (!data)
+    return false;
+
+  // Validate the header & the project identity
+  SnapshotHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  qint64 offset = padded(sizeof(header));
+  const auto projectId = project.toUtf8();
+  const bool valid = header.magic == kSnapshotMagic
+                     && header.version == kSnapshotVersion
+                     && header.curves >= 0 && header.timestamps >= 0
+                     && header.projectBytes == projectId.size()
+                     && offset + padded(header.projectBytes) <= size
+                     && std::memcmp(data + offset, projectId.constData(),
+                                    projectId.size())
+                            == 0;
+  if (!valid)
+    return false;
+
+  // Read the histories
+  offset += padded(header.projectBytes);
+  QStringList restoredKeys;
+  QVector<Curve> restoredCurves;
+  for (qint64 i = 0; i < header.curves; ++i)
+  {
+    CurveHeader curveHeader;
+    if (offset + static_cast<qint64>(sizeof(curveHeader)) > size)
+      return false;
+
+    std::memcpy(&curveHeader, data + offset, sizeof(curveHeader));
+    offset += padded(sizeof(curveHeader));
+
+    const auto keyBytes = curveHeader.keyBytes;
+    const auto sampleBytes = curveHeader.samples * qint64(sizeof(double));
+    if (keyBytes < 0 || curveHeader.samples < 0
+        || offset + padded(keyBytes) + sampleBytes > size)
+      return false;
+
+    restoredKeys.append(QString::fromUtf8(
+        reinterpret_cast<const char *>(data + offset), keyBytes));
+    offset += padded(keyBytes);
+
+    Curve curve(curveHeader.samples);
+    const auto *samples = reinterpret_cast<const double *>(data + offset);
+    for (qint64 j = 0; j < curveHeader.samples; ++j)
+      curve.append(samples[j]);
+
+    restoredCurves.append(std::move(curve));
+    offset += sampleBytes;
+  }
+
+  // Read the timeline & convert it to the steady clock of this session
+  const auto timestampBytes = header.timestamps * qint64(sizeof(qint64));
+  if (offset + timestampBytes > size)
+    return false;
+
+  const auto now = Misc::SessionClock::now();
+  const auto unixNow = Misc::SessionClock::toUnixNsecs(now);
+  const auto *timestamps = reinterpret_cast<const qint64 *>(data + offset);
+  Timeline restoredTimeline(header.timestamps);
+  for (qint64 i = 0; i < header.timestamps; ++i)
+  {
+    const auto timestamp = timestamps[i];
+    if (timestamp > 0)
+      restoredTimeline.append(qMax<qint64>(1, now - (unixNow - timestamp)));
+    else
+      restoredTimeline.append(0);
+  }
+
+  keys = std::move(restoredKeys);
+  curves = std::move(restoredCurves);
+  timeline = std::move(restoredTimeline);
+  return true;
+}
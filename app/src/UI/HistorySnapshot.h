@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QStringList>
+
+#include "SerialStudio.h"
+
+namespace UI
+{
+/**
+ * @class UI::HistorySnapshot
+ * @brief Compact binary snapshot of the plot histories of the dashboard.
+ *
+ * The dashboard saves the sample history of every plotted dataset, together
+ * with the timeline of the samples, when the device is disconnected, when the
+ * application quits & periodically while data is received. When the same
+ * project is connected again (in the same session or after a restart), the
+ * histories are restored from the snapshot before the first frame is
+ * plotted, so that the plots continue where they stopped instead of starting
+ * empty after a brief cable drop.
+ *
+ * The snapshot is a single file in the cache directory, written atomically &
+ * read through a memory mapping:
+ *
+ * - A header with the magic number, the format version and the number of
+ *   histories & timestamps.
+ * - The identity of the project whose histories are stored.
+ * - For each history, the dataset key used by the dashboard to match it with
+ *   a dataset and its samples (oldest first) as 64-bit floats.
+ * - The timeline, as nanoseconds since the Unix epoch, so that it can be
+ *   converted to the steady clock of another session.
+ *
+ * Every block is padded to 8 bytes, so the mapped samples can be read in
+ * place.
+ */
+class HistorySnapshot
+{
+public:
+  [[nodiscard]] static QString filePath();
+
+  [[nodiscard]] static bool save(const QString &project,
+                                 const QStringList &keys,
+                                 const QVector<Curve> &curves,
+                                 const Timeline &timeline);
+  [[nodiscard]] static bool load(const QString &project, QStringList &keys,
+                                 QVector<Curve> &curves, Timeline &timeline);
+};
+} // namespace UI
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDebug>
+
+#include "UI/HistoryStore.h"
+
+/**
+ * Size of the segments by which the store file grows, in bytes. It is a
+ * multiple of the allocation granularity of every supported operating system,
+ * which is required for the offsets of the mappings.
+ */
+static constexpr qint64 kSegmentSize = 256 * 1024;
+
+/**
+ * Number of buckets that fit in a segment.
+ */
+static constexpr qsizetype kSegmentBuckets
+    = kSegmentSize / static_cast<qint64>(sizeof(HistoryTiers::Bucket));
+
+/**
+ * @brief Constructs an empty store, the file is created when the first
+ *        bucket is appended.
+ */
+UI::HistoryStore::HistoryStore()
+  : m_failed(false)
+  , m_fileSize(0)
+{
+}
+
+/**
+ * @brief Unmaps the segments & deletes the store file.
+ */
+UI::HistoryStore::~HistoryStore()
+{
+  close();
+}
+
+/**
+ * @brief Removes every stream, unmaps the segments & deletes the store file.
+ */
+void UI::HistoryStore::close()
+{
+  if (m_file)
+  {
+    for (const auto &stream : std::as_const(m_streams))
+    {
+      for (auto *segment : stream.segments)
+        m_file->unmap(reinterpret_cast<uchar *>(segment));
+    }
+
+    m_file.reset();
+  }
+
+  m_failed = false;
+  m_fileSize = 0;
+  m_streams.clear();
+}
+
+/**
+ * @brief Registers a new, empty stream of buckets.
+ * @return The identifier of the stream.
+ */
+int UI::HistoryStore::addStream()
+{
+  m_streams.append(Stream());
+  return static_cast<int>(m_streams.count() - 1);
+}
+
+/**
+ * @brief Appends the given @a bucket at the end of the given @a stream.
+ *
+ * @return @c false if the store file could not be created, grown or mapped,
+ *         in which case the bucket is not stored.
+ */
+bool UI::HistoryStore::append(const int stream,
+                              const HistoryTiers::Bucket &bucket)
+{
+  if (stream < 0 || stream >= m_streams.count())
+    return false;
+
+  // Allocate a new segment when the last one is full
+  auto &s = m_streams[stream];
+  if (s.count == s.segments.count() * kSegmentBuckets && !allocateSegment(s))
+    return false;
+
+  // Write the bucket directly to the mapping
+  s.segments[s.count / kSegmentBuckets][s.count % kSegmentBuckets] = bucket;
+  ++s.count;
+  return true;
+}
+
+/**
+ * @brief Returns the size of the store file, in bytes.
+ */
+qint64 UI::HistoryStore::fileSize() const
+{
+  return m_fileSize;
+}
+
+/**
+ * @brief Returns the number of buckets of the given @a stream.
+ */
+qsizetype UI::HistoryStore::count(const int stream) const
+{
+  if (stream < 0 || stream >= m_streams.count())
+    return 0;
+
+  return m_streams[stream].count;
+}
+
+/**
+ * @brief Returns the bucket at the given @a index of the given @a stream,
+ *        where 0 is the oldest bucket of the stream.
+ *
+ * The reference points into the mapped file and remains valid until the store
+ * is closed.
+ */
+const HistoryTiers::Bucket &
+UI::HistoryStore::at(const int stream, const qsizetype index) const
+{
+  const auto &s = m_streams[stream];
+  return s.segments[index / kSegmentBuckets][index % kSegmentBuckets];
+}
+
+/**
+ * @brief Grows the store file by one segment & maps it for the given
+ *        @a stream, creating the file if required.
+ *
+ * Once an operation on the file fails, the store stops trying to allocate
+ * segments, and the history tiers drop their oldest buckets instead.
+ */
+bool UI::HistoryStore::allocateSegment(Stream &stream)
+{
+  if (m_failed)
+    return false;
+
+  // Create the store file
+  if (!m_file)
+  {
+    m_file = std::make_unique<QTemporaryFile>();
+    if (!m_file->open())
+    {
+      qWarning() << "Cannot create plot history store:"
+                 << m_file->errorString();
+      m_failed = true;
+      return false;
+    }
+  }
+
+  // Grow the file & map the new segment
+  uchar *segment = nullptr;
+  if (m_file->resize(m_fileSize + kSegmentSize))
+    segment = m_file->map(m_fileSize, kSegmentSize);
+
+  if (!segment)
+  {
+    qWarning() << "Cannot grow plot history store:" << m_file->errorString();
+    m_failed = true;
+    return false;
+  }
+
+  m_fileSize += kSegmentSize;
+  stream.segments.append(reinterpret_cast<HistoryTiers::Bucket *>(segment));
+  return true;
+}
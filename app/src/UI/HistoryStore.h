@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QVector>
+#include <QTemporaryFile>
+
+#include "SerialStudio.h"
+
+namespace UI
+{
+/**
+ * @class UI::HistoryStore
+ * @brief Memory-mapped, on-disk continuation of the history tiers of the
+ *        plotted datasets.
+ *
+ * When a tier of a @c HistoryTiers is full, its oldest bucket is moved to a
+ * stream of this store instead of being discarded, so that plots can scroll
+ * back through the whole session without keeping it in RAM.
+ *
+ * The store is a temporary file that grows in fixed-size segments. Each
+ * segment belongs to a single stream & is mapped into memory once it is
+ * allocated, buckets are written to & read from the mapping directly, without
+ * copies or read calls. The operating system pages the mapped segments in and
+ * out as needed. The file is deleted when the store is closed.
+ */
+class HistoryStore
+{
+public:
+  HistoryStore();
+  ~HistoryStore();
+
+  HistoryStore(HistoryStore &&) = delete;
+  HistoryStore(const HistoryStore &) = delete;
+  HistoryStore &operator=(HistoryStore &&) = delete;
+  HistoryStore &operator=(const HistoryStore &) = delete;
+
+  void close();
+
+  [[nodiscard]] int addStream();
+  [[nodiscard]] bool append(const int stream,
+                            const HistoryTiers::Bucket &bucket);
+
+  [[nodiscard]] qint64 fileSize() const;
+  [[nodiscard]] qsizetype count(const int stream) const;
+  [[nodiscard]] const HistoryTiers::Bucket &at(const int stream,
+                                               const qsizetype index) const;
+
+private:
+  /**
+   * @brief Buckets of a stream & the mapped segments that contain them.
+   */
+  struct Stream
+  {
+    qsizetype count = 0;
+    QVector<HistoryTiers::Bucket *> segments;
+  };
+
+  [[nodiscard]] bool allocateSegment(Stream &stream);
+
+private:
+  bool m_failed;
+  qint64 m_fileSize;
+  QVector<Stream> m_streams;
+  std::unique_ptr<QTemporaryFile> m_file;
+};
+} // namespace UI
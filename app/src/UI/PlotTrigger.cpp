@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "UI/PlotTrigger.h"
+
+/**
+ * @brief Constructs a rising edge trigger at level 0, without pre-trigger
+ *        samples.
+ */
+UI::PlotTrigger::PlotTrigger()
+  : m_state(State::Arming)
+  , m_edge(SerialStudio::TriggerRisingEdge)
+  , m_level(0)
+  , m_previous(0)
+  , m_count(0)
+  , m_pretrigger(0)
+  , m_posttrigger(1)
+{
+}
+
+/**
+ * @brief Discards the current capture & waits for the pre-trigger samples
+ *        before arming the trigger again.
+ */
+void UI::PlotTrigger::reset()
+{
+  m_count = 0;
+  m_previous = 0;
+  m_state = State::Arming;
+}
+
+/**
+ * @brief Changes the parameters of the trigger & resets it.
+ *
+ * @param edge       The direction in which the signal must cross the level.
+ * @param level      The trigger level.
+ * @param pretrigger Number of samples before the trigger sample.
+ * @param length     Total number of samples of a capture.
+ */
+void UI::PlotTrigger::configure(const SerialStudio::TriggerEdge edge,
+                                const qreal level, const qsizetype pretrigger,
+                                const qsizetype length)
+{
+  m_edge = edge;
+  m_level = level;
+  m_pretrigger = qBound<qsizetype>(0, pretrigger, qMax<qsizetype>(length, 1));
+  m_posttrigger = qMax<qsizetype>(length - m_pretrigger, 1);
+  reset();
+}
+
+/**
+ * @brief Feeds a new sample of the trigger source to the trigger.
+ *
+ * @return @c true if the sample completes a capture, in which case the
+ *         newest samples of the histories form an aligned capture.
+ */
+bool UI::PlotTrigger::process(const qreal value)
+{
+  const auto previous = m_previous;
+  m_previous = value;
+
+  switch (m_state)
+  {
+    // Wait until the histories contain the pre-trigger samples
+    case State::Arming:
+      if (++m_count > m_pretrigger)
+        m_state = State::Armed;
+
+      return false;
+
+    // Wait for the signal to cross the level in the selected direction
+    case State::Armed:
+    {
+      const bool crossed = m_edge == SerialStudio::TriggerRisingEdge
+                               ? previous < m_level && value >= m_level
+                               : previous > m_level && value <= m_level;
+      if (!crossed)
+        return false;
+
+      m_count = 0;
+      m_state = State::Capturing;
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  // Capture the post-trigger samples, including the trigger sample
+  if (++m_count < m_posttrigger)
+    return false;
+
+  m_state = State::Armed;
+  return true;
+}
+
+/**
+ * @brief Returns the number of samples of a capture before the trigger
+ *        sample.
+ */
+qsizetype UI::PlotTrigger::pretrigger() const
+{
+  return m_pretrigger;
+}
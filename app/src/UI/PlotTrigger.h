@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include "SerialStudio.h"
+
+namespace UI
+{
+/**
+ * @class UI::PlotTrigger
+ * @brief Oscilloscope-style trigger evaluated on the samples of a dataset.
+ *
+ * The trigger receives one sample per frame & detects when the signal
+ * crosses the trigger level in the selected direction. A capture is complete
+ * once the post-trigger samples have been received, at which point the
+ * newest @c length samples of the plot histories are aligned so that the
+ * trigger sample is at index @c pretrigger.
+ *
+ * After a reset, the trigger waits for the pre-trigger samples before it
+ * arms, so that the first capture does not contain samples from before the
+ * histories were filled. Once a capture is complete, it re-arms immediately.
+ */
+class PlotTrigger
+{
+public:
+  PlotTrigger();
+
+  void reset();
+  void configure(const SerialStudio::TriggerEdge edge, const qreal level,
+                 const qsizetype pretrigger, const qsizetype length);
+
+  [[nodiscard]] bool process(const qreal value);
+  [[nodiscard]] qsizetype pretrigger() const;
+
+private:
+  enum class State
+  {
+    Arming,
+    Armed,
+    Capturing
+  };
+
+  State m_state;
+  SerialStudio::TriggerEdge m_edge;
+
+  qreal m_level;
+  qreal m_previous;
+  qsizetype m_count;
+  qsizetype m_pretrigger;
+  qsizetype m_posttrigger;
+};
+} // namespace UI
@@ -22,6 +22,7 @@
 
 #include "UI/Dashboard.h"
 #include "UI/Widgets/Accelerometer.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs an Accelerometer widget.
@@ -31,12 +32,28 @@
 Widgets::Accelerometer::Accelerometer(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
+  , m_xSlot(-1)
+  , m_ySlot(-1)
   , m_theta(0)
   , m_magnitude(0)
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardAccelerometer, m_index))
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Accelerometer::updateData);
+  {
+    // Find the datasets that provide the X & Y accelerations
+    const auto &acc = GET_GROUP(SerialStudio::DashboardAccelerometer, m_index);
+    for (int i = 0; i < acc.datasetCount(); ++i)
+    {
+      const auto &widget = acc.getDataset(i).widget();
+      if (m_xSlot < 0 && widget == QStringLiteral("x"))
+        m_xSlot = i;
+      else if (m_ySlot < 0 && widget == QStringLiteral("y"))
+        m_ySlot = i;
+    }
+
+    UI::Dashboard::instance().subscribe(
+        SerialStudio::DashboardAccelerometer, m_index, this,
+        &Accelerometer::updateData);
+  }
 }
 
 /**
@@ -64,12 +81,14 @@ qreal Widgets::Accelerometer::theta() const
  */
 void Widgets::Accelerometer::updateData()
 {
+  TRACE_ZONE("Accelerometer::updateData");
+
   // Widget not enabled, do nothing
   if (!isEnabled())
     return;
 
   // Get the dashboard instance and check if the index is valid
-  if (VALIDATE_WIDGET(SerialStudio::DashboardAccelerometer, m_index))
+  if (!VALIDATE_WIDGET(SerialStudio::DashboardAccelerometer, m_index))
     return;
 
   // Get the accelerometer data and validate the dataset count
@@ -77,16 +96,9 @@ void Widgets::Accelerometer::updateData()
   if (acc.datasetCount() != 3)
     return;
 
-  // Obtain the X, Y, and Z acceleration values
-  qreal x = 0, y = 0;
-  for (int i = 0; i < 3; ++i)
-  {
-    auto dataset = acc.getDataset(i);
-    if (dataset.widget() == QStringLiteral("x"))
-      x = dataset.value().toDouble();
-    else if (dataset.widget() == QStringLiteral("y"))
-      y = dataset.value().toDouble();
-  }
+  // Obtain the X & Y acceleration values from the datasets found on startup
+  const qreal x = m_xSlot >= 0 ? acc.getDataset(m_xSlot).numericValue() : 0;
+  const qreal y = m_ySlot >= 0 ? acc.getDataset(m_ySlot).numericValue() : 0;
 
   // Calculate the radius (magnitude) using only X and Y
   const qreal r = qSqrt(qPow(x / 9.81, 2) + qPow(y / 9.81, 2));
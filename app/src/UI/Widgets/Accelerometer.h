@@ -49,6 +49,8 @@ private slots:
 
 private:
   int m_index;
+  int m_xSlot;
+  int m_ySlot;
   qreal m_theta;
   qreal m_magnitude;
 };
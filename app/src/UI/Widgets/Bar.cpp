@@ -21,7 +21,10 @@
  */
 
 #include "UI/Dashboard.h"
+#include "Misc/AlarmEngine.h"
 #include "UI/Widgets/Bar.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a Bar widget.
@@ -31,7 +34,7 @@
 Widgets::Bar::Bar(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
-  , m_value(0)
+  , m_alarm(false)
   , m_minValue(0)
   , m_maxValue(100)
   , m_alarmValue(0)
@@ -44,12 +47,28 @@ Widgets::Bar::Bar(const int index, QQuickItem *parent)
     m_alarmValue = dataset.alarm();
     m_minValue = qMin(dataset.min(), dataset.max());
     m_maxValue = qMax(dataset.min(), dataset.max());
+    m_filter.setRange(m_maxValue - m_minValue);
+    m_filter.reset(qBound(m_minValue, dataset.numericValue(), m_maxValue));
 
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Bar::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardBar, m_index,
+                                        this, &Bar::updateData);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
+            this, &Widgets::Bar::updateDisplay);
+
+    updateAlarm();
+    connect(&Misc::AlarmEngine::instance(), &Misc::AlarmEngine::alarmsChanged,
+            this, &Widgets::Bar::updateAlarm);
   }
 }
 
+/**
+ * @brief Returns @c true if the alarm of the dataset is active.
+ */
+bool Widgets::Bar::alarm() const
+{
+  return m_alarm;
+}
+
 /**
  * @brief Returns the measurement units of the dataset.
  */
@@ -60,11 +79,15 @@ const QString &Widgets::Bar::units() const
 
 /**
  * @brief Returns the current value of the bar.
+ *
+ * The value is smoothed by a display filter, so it moves towards the latest
+ * dataset value at the UI refresh rate.
+ *
  * @return The current value of the bar.
  */
 qreal Widgets::Bar::value() const
 {
-  return m_value;
+  return m_filter.value();
 }
 
 /**
@@ -135,21 +158,52 @@ qreal Widgets::Bar::alarmFractionalValue() const
  * @brief Updates the bar data from the Dashboard.
  *
  * This method retrieves the latest data for this bar from the Dashboard
- * and updates the bar's value and text display accordingly.
+ * and sets it as the target of the display filter, the displayed value is
+ * updated on the following render ticks.
  */
 void Widgets::Bar::updateData()
 {
+  TRACE_ZONE("Bar::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardBar, m_index))
   {
     const auto &dataset = GET_DATASET(SerialStudio::DashboardBar, m_index);
-    auto value = qMax(m_minValue, qMin(m_maxValue, dataset.value().toDouble()));
-    if (!qFuzzyCompare(value, m_value))
+    m_filter.setTarget(qBound(m_minValue, dataset.numericValue(), m_maxValue));
+  }
+}
+
+/**
+ * @brief Obtains the alarm state of the dataset from the alarm engine, which
+ *        evaluates the alarms of every received frame.
+ */
+void Widgets::Bar::updateAlarm()
+{
+  if (VALIDATE_WIDGET(SerialStudio::DashboardBar, m_index))
+  {
+    const auto &dataset = GET_DATASET(SerialStudio::DashboardBar, m_index);
+    const bool alarm = Misc::AlarmEngine::instance().active(dataset.index());
+    if (m_alarm != alarm)
     {
-      m_value = value;
+      m_alarm = alarm;
       Q_EMIT updated();
     }
   }
 }
+
+/**
+ * @brief Advances the display filter on every render tick and notifies the
+ *        user interface if the displayed value changed.
+ *
+ * Nothing is done once the displayed value has reached the dataset value.
+ */
+void Widgets::Bar::updateDisplay()
+{
+  if (!isEnabled())
+    return;
+
+  if (m_filter.step())
+    Q_EMIT updated();
+}
@@ -24,6 +24,8 @@
 
 #include <QtQuick>
 
+#include "UI/Widgets/DisplayFilter.h"
+
 namespace Widgets
 {
 /**
@@ -33,6 +35,7 @@ class Bar : public QQuickItem
 {
   Q_OBJECT
   Q_PROPERTY(QString units READ units CONSTANT)
+  Q_PROPERTY(bool alarm READ alarm NOTIFY updated)
   Q_PROPERTY(qreal value READ value NOTIFY updated)
   Q_PROPERTY(qreal minValue READ minValue CONSTANT)
   Q_PROPERTY(qreal maxValue READ maxValue CONSTANT)
@@ -46,6 +49,7 @@ signals:
 public:
   explicit Bar(const int index = -1, QQuickItem *parent = nullptr);
 
+  [[nodiscard]] bool alarm() const;
   [[nodiscard]] const QString &units() const;
 
   [[nodiscard]] qreal value() const;
@@ -57,13 +61,16 @@ public:
 
 private slots:
   void updateData();
+  void updateAlarm();
+  void updateDisplay();
 
 private:
   int m_index;
+  bool m_alarm;
   QString m_units;
-  qreal m_value;
   qreal m_minValue;
   qreal m_maxValue;
   qreal m_alarmValue;
+  DisplayFilter m_filter;
 };
 } // namespace Widgets
@@ -22,6 +22,8 @@
 
 #include "UI/Dashboard.h"
 #include "UI/Widgets/Compass.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a Compass widget.
@@ -34,21 +36,30 @@ Widgets::Compass::Compass(const int index, QQuickItem *parent)
   , m_value(0)
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardCompass, m_index))
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Compass::updateData);
+  {
+    m_filter.setWrap(360);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardCompass, m_index,
+                                        this, &Compass::updateData);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
+            this, &Widgets::Compass::updateDisplay);
+  }
 }
 
 /**
  * @brief Returns the current value of the compass.
+ *
+ * The value is smoothed by a display filter, so the needle follows the
+ * shortest path towards the latest heading at the UI refresh rate.
+ *
  * @return The current value of the compass.
  */
 qreal Widgets::Compass::value() const
 {
-  return m_value;
+  return m_filter.value();
 }
 
 /**
- * @brief Returns the text representation of the compass value.
+ * @brief Returns the text representation of the latest compass value.
  * @return The text representation of the compass value.
  */
 QString Widgets::Compass::text() const
@@ -60,21 +71,26 @@ QString Widgets::Compass::text() const
  * @brief Updates the compass data from the Dashboard.
  *
  * This method retrieves the latest data for this compass from the Dashboard
- * and updates the compass's value and text display accordingly.
+ * and updates the compass's text display accordingly. The heading is set as
+ * the target of the display filter, which moves the needle on the following
+ * render ticks.
  */
 void Widgets::Compass::updateData()
 {
+  TRACE_ZONE("Compass::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardCompass, m_index))
   {
     const auto &dataset = GET_DATASET(SerialStudio::DashboardCompass, m_index);
-    const auto value = dataset.value().toDouble();
+    const auto value = dataset.numericValue();
     if (!qFuzzyCompare(value, m_value))
     {
       // Update values
       m_value = qMin(360.0, qMax(0.0, value));
+      m_filter.setTarget(m_value);
       m_text = QString::number(m_value, 'f',
                                UI::Dashboard::instance().precision());
 
@@ -113,3 +129,16 @@ void Widgets::Compass::updateData()
     }
   }
 }
+
+/**
+ * @brief Advances the display filter on every render tick and notifies the
+ *        user interface if the needle moved.
+ */
+void Widgets::Compass::updateDisplay()
+{
+  if (!isEnabled())
+    return;
+
+  if (m_filter.step())
+    Q_EMIT updated();
+}
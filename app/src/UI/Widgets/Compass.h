@@ -24,6 +24,8 @@
 
 #include <QtQuick>
 
+#include "UI/Widgets/DisplayFilter.h"
+
 namespace Widgets
 {
 /**
@@ -46,10 +48,12 @@ public:
 
 private slots:
   void updateData();
+  void updateDisplay();
 
 private:
   int m_index;
   qreal m_value;
   QString m_text;
+  DisplayFilter m_filter;
 };
 } // namespace Widgets
\ No newline at end of file
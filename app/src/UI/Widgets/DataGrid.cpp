@@ -20,9 +20,82 @@
  * THE SOFTWARE.
  */
 
+#include <cmath>
+
 #include "UI/Dashboard.h"
+#include "Misc/AlarmEngine.h"
 #include "Misc/ThemeManager.h"
+#include "Misc/DatasetStatistics.h"
 #include "UI/Widgets/DataGrid.h"
+#include "Misc/Trace.h"
+
+//------------------------------------------------------------------------------
+// Fixed-precision number formatting
+//------------------------------------------------------------------------------
+
+/**
+ * Powers of ten used to scale values to the selected number of decimals, and
+ * largest scaled value that fits in a 64-bit integer with some margin.
+ */
+static constexpr qint64 kPowersOfTen[]
+    = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+static constexpr int kMaxFastPrecision = 8;
+static constexpr double kMaxFastScaledValue = 1e17;
+
+/**
+ * @brief Formats @a value with @a precision decimals into @a buffer.
+ *
+ * The value is scaled & rounded to an integer, which is then written digit by
+ * digit, avoiding the allocations & locale handling of @c QString::number().
+ *
+ * @return The number of characters written, or @c -1 if the value is not
+ *         finite, too large or if @a precision is not supported, in which case
+ *         @c QString::number() must be used.
+ */
+static qsizetype formatFixed(char *buffer, const double value,
+                             const int precision)
+{
+  // Validate the precision & the magnitude of the value
+  if (precision < 0 || precision > kMaxFastPrecision)
+    return -1;
+
+  const auto scale = kPowersOfTen[precision];
+  const auto magnitude = std::abs(value) * scale;
+  if (!(magnitude < kMaxFastScaledValue))
+    return -1;
+
+  // Split the scaled value into its integer & fractional digits
+  const auto scaled = std::llround(magnitude);
+  auto integer = scaled / scale;
+  auto fraction = scaled % scale;
+
+  // Write the digits in reverse order
+  char digits[32];
+  qsizetype length = 0;
+  for (int i = 0; i < precision; ++i)
+  {
+    digits[length++] = char('0' + fraction % 10);
+    fraction /= 10;
+  }
+
+  if (precision > 0)
+    digits[length++] = '.';
+
+  do
+  {
+    digits[length++] = char('0' + integer % 10);
+    integer /= 10;
+  } while (integer > 0);
+
+  if (value < 0)
+    digits[length++] = '-';
+
+  // Copy the digits to the output buffer in the correct order
+  for (qsizetype i = 0; i < length; ++i)
+    buffer[i] = digits[length - i - 1];
+
+  return length;
+}
 
 /**
  * @brief Constructs a DataGrid widget.
@@ -32,6 +105,8 @@
 Widgets::DataGrid::DataGrid(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
+  , m_precision(UI::Dashboard::instance().precision())
+  , m_changed(false)
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardDataGrid, m_index))
   {
@@ -41,6 +116,8 @@ Widgets::DataGrid::DataGrid(const int index, QQuickItem *parent)
     m_titles.resize(group.datasetCount());
     m_values.resize(group.datasetCount());
     m_alarms.resize(group.datasetCount());
+    m_statistics.resize(group.datasetCount());
+    m_generations.fill(0, group.datasetCount());
 
     for (int i = 0; i < group.datasetCount(); ++i)
     {
@@ -54,12 +131,18 @@ Widgets::DataGrid::DataGrid(const int index, QQuickItem *parent)
                        : QString("[%1]").arg(dataset.units());
     }
 
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &DataGrid::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardDataGrid,
+                                        m_index, this, &DataGrid::updateData);
 
     onThemeChanged();
     connect(&Misc::ThemeManager::instance(), &Misc::ThemeManager::themeChanged,
             this, &Widgets::DataGrid::onThemeChanged);
+
+    updateAlarms();
+    connect(&Misc::AlarmEngine::instance(), &Misc::AlarmEngine::alarmsChanged,
+            this, &Widgets::DataGrid::updateAlarms);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::precisionChanged, this,
+            &Widgets::DataGrid::onPrecisionChanged);
   }
 }
 
@@ -117,72 +200,179 @@ const QStringList &Widgets::DataGrid::values() const
   return m_values;
 }
 
+/**
+ * @brief Returns the live statistics of the datasets in the data grid.
+ * @return A vector of strings with the mean, standard deviation, RMS value,
+ *         range & update rate of each dataset.
+ */
+const QStringList &Widgets::DataGrid::statistics() const
+{
+  return m_statistics;
+}
+
 /**
  * @brief Updates the data grid data from the Dashboard.
  *
  * This method retrieves the latest data for this data grid from the Dashboard
- * and updates the displayed values accordingly.
+ * and updates the displayed values accordingly. Datasets whose value
+ * generation did not change since they were last displayed are skipped, and
+ * numeric values are formatted with the cached dashboard precision.
+ *
+ * Alarm states are obtained from @c Misc::AlarmEngine by @c updateAlarms().
  */
 void Widgets::DataGrid::updateData()
 {
+  TRACE_ZONE("DataGrid::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardDataGrid, m_index))
   {
-    // Regular expression to check if the value is a number
-    static const QRegularExpression regex("^[+-]?(\\d*\\.)?\\d+$");
-
     // Get the datagrid group and update the value readings
-    bool changed = false;
+    m_changed = false;
+    char buffer[32];
     const auto &group = GET_GROUP(SerialStudio::DashboardDataGrid, m_index);
-    for (int i = 0; i < group.datasetCount(); ++i)
+    const auto count = qMin(group.datasetCount(), int(m_generations.count()));
+    for (int i = 0; i < count; ++i)
     {
-      // Get the dataset and its values
+      // Skip datasets that did not change
       const auto &dataset = group.getDataset(i);
-      const auto alarmValue = dataset.alarm();
-      auto value = dataset.value();
+      if (m_generations[i] == dataset.valueGeneration())
+        continue;
+
+      m_generations[i] = dataset.valueGeneration();
 
-      // Process dataset numerical value
-      bool alarm = false;
-      if (regex.match(value).hasMatch())
+      // Text values are displayed as-is
+      if (!dataset.isNumeric())
       {
-        const double v = value.toDouble();
-        value = QString::number(v, 'f', UI::Dashboard::instance().precision());
-        alarm = (alarmValue != 0 && v >= alarmValue);
+        setValue(i, dataset.value());
+        continue;
       }
 
-      // Update the alarm state
+      // Format numeric values
+      const double value = dataset.numericValue();
+      const auto length = formatFixed(buffer, value, m_precision);
+      if (length >= 0)
+        setValue(i, QLatin1StringView(buffer, length));
+      else
+        setValue(i, QString::number(value, 'f', m_precision));
+    }
+
+    // Update the statistics of the datasets
+    updateStatistics();
+
+    // Redraw the widget
+    if (m_changed)
+      Q_EMIT updated();
+  }
+}
+
+/**
+ * @brief Obtains the alarm state of each dataset from the alarm engine, which
+ *        evaluates the alarms of every received frame.
+ */
+void Widgets::DataGrid::updateAlarms()
+{
+  if (VALIDATE_WIDGET(SerialStudio::DashboardDataGrid, m_index))
+  {
+    bool changed = false;
+    const auto &alarms = Misc::AlarmEngine::instance();
+    const auto &group = GET_GROUP(SerialStudio::DashboardDataGrid, m_index);
+    const auto count = qMin(group.datasetCount(), int(m_alarms.count()));
+    for (int i = 0; i < count; ++i)
+    {
+      const bool alarm = alarms.active(group.getDataset(i).index());
       if (m_alarms[i] != alarm)
       {
         changed = true;
         m_alarms[i] = alarm;
       }
-
-      // Update value text
-      if (m_values[i] != value)
-      {
-        changed = true;
-        m_values[i] = value;
-      }
     }
 
-    // Redraw the widget
     if (changed)
       Q_EMIT updated();
   }
 }
 
+/**
+ * @brief Reformats every value with the new precision of the dashboard.
+ */
+void Widgets::DataGrid::onPrecisionChanged()
+{
+  m_precision = UI::Dashboard::instance().precision();
+  m_generations.fill(0);
+  updateData();
+}
+
+/**
+ * @brief Formats the statistics of each dataset over the window kept by
+ *        @c Misc::DatasetStatistics with the dashboard precision.
+ */
+void Widgets::DataGrid::updateStatistics()
+{
+  const auto &statistics = Misc::DatasetStatistics::instance();
+  const auto &group = GET_GROUP(SerialStudio::DashboardDataGrid, m_index);
+  const auto count = qMin(group.datasetCount(), int(m_statistics.count()));
+  for (int i = 0; i < count; ++i)
+  {
+    // Obtain the statistics of the dataset
+    QString text;
+    const auto &dataset = group.getDataset(i);
+    const auto s = statistics.summary(dataset.index());
+    if (s.count > 0 && dataset.isNumeric())
+    {
+      text = QStringLiteral("μ %1  σ %2  RMS %3  [%4, %5]  %6 Hz")
+                 .arg(QString::number(s.mean, 'f', m_precision),
+                      QString::number(s.stddev, 'f', m_precision),
+                      QString::number(s.rms, 'f', m_precision),
+                      QString::number(s.min, 'f', m_precision),
+                      QString::number(s.max, 'f', m_precision),
+                      QString::number(s.rate, 'f', 1));
+    }
+
+    // Update the displayed text
+    if (m_statistics[i] != text)
+    {
+      m_changed = true;
+      m_statistics[i] = text;
+    }
+  }
+}
+
+/**
+ * @brief Changes the text displayed for the dataset at @a index.
+ */
+void Widgets::DataGrid::setValue(const int index, const QString &value)
+{
+  if (m_values[index] != value)
+  {
+    m_changed = true;
+    m_values[index] = value;
+  }
+}
+
+/**
+ * @brief Changes the text displayed for the dataset at @a index, only
+ *        allocating a new string if the text changed.
+ */
+void Widgets::DataGrid::setValue(const int index,
+                                 const QLatin1StringView &value)
+{
+  if (m_values[index] != value)
+  {
+    m_changed = true;
+    m_values[index] = value;
+  }
+}
+
 /**
  * @brief Updates the colors for each dataset in the widget based on the
  *        colorscheme defined by the application's currently loaded theme.
  */
 void Widgets::DataGrid::onThemeChanged()
 {
-  // clang-format off
-  const auto colors = Misc::ThemeManager::instance().colors()["widget_colors"].toArray();
-  // clang-format on
-
+  const auto &theme = Misc::ThemeManager::instance();
   if (VALIDATE_WIDGET(SerialStudio::DashboardDataGrid, m_index))
   {
     const auto &group = GET_GROUP(SerialStudio::DashboardDataGrid, m_index);
@@ -192,11 +382,7 @@ void Widgets::DataGrid::onThemeChanged()
     for (int i = 0; i < group.datasetCount(); ++i)
     {
       const auto &dataset = group.getDataset(i);
-      const auto index = dataset.index() - 1;
-      const auto color = colors.count() > index
-                             ? colors.at(index).toString()
-                             : colors.at(index % colors.count()).toString();
-      m_colors[i] = color;
+      m_colors[i] = theme.datasetColorName(dataset.index());
     }
 
     Q_EMIT themeChanged();
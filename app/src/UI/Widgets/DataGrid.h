@@ -34,6 +34,7 @@ class DataGrid : public QQuickItem
   Q_PROPERTY(QStringList titles READ titles CONSTANT)
   Q_PROPERTY(QStringList values READ values NOTIFY updated)
   Q_PROPERTY(QList<bool> alarms READ alarms NOTIFY updated)
+  Q_PROPERTY(QStringList statistics READ statistics NOTIFY updated)
   Q_PROPERTY(QStringList colors READ colors NOTIFY themeChanged)
 
 signals:
@@ -50,18 +51,30 @@ public:
   [[nodiscard]] const QStringList &colors() const;
   [[nodiscard]] const QStringList &titles() const;
   [[nodiscard]] const QStringList &values() const;
+  [[nodiscard]] const QStringList &statistics() const;
 
 private slots:
   void updateData();
+  void updateAlarms();
   void onThemeChanged();
+  void onPrecisionChanged();
+
+private:
+  void updateStatistics();
+  void setValue(const int index, const QString &value);
+  void setValue(const int index, const QLatin1StringView &value);
 
 private:
   int m_index;
+  int m_precision;
+  bool m_changed;
   QList<bool> m_alarms;
+  QVector<quint64> m_generations;
 
   QStringList m_units;
   QStringList m_titles;
   QStringList m_values;
   QStringList m_colors;
+  QStringList m_statistics;
 };
 } // namespace Widgets
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "UI/Widgets/DisplayFilter.h"
+
+/**
+ * @brief Constructs a display filter that is settled at zero.
+ */
+Widgets::DisplayFilter::DisplayFilter()
+  : m_wrap(0)
+  , m_value(0)
+  , m_target(0)
+  , m_velocity(0)
+  , m_resolution(kResolution)
+  , m_settled(true)
+{
+}
+
+/**
+ * @brief Returns the filtered value that should be displayed.
+ */
+qreal Widgets::DisplayFilter::value() const
+{
+  return wrapped(m_value);
+}
+
+/**
+ * @brief Returns the value that the filter is moving towards.
+ */
+qreal Widgets::DisplayFilter::target() const
+{
+  return wrapped(m_target);
+}
+
+/**
+ * @brief Returns @c true if the output has reached the target, in which case
+ *        calling @c step() does nothing.
+ */
+bool Widgets::DisplayFilter::settled() const
+{
+  return m_settled;
+}
+
+/**
+ * @brief Treats the values as angles that wrap around at @a wrap (e.g. 360
+ *        degrees), use zero to filter linear values.
+ */
+void Widgets::DisplayFilter::setWrap(const qreal wrap)
+{
+  m_wrap = qMax<qreal>(0, wrap);
+  if (m_wrap > 0)
+    setRange(m_wrap);
+}
+
+/**
+ * @brief Sets the range of the values displayed by the widget, which is used
+ *        to decide when the output is close enough to the target to stop.
+ */
+void Widgets::DisplayFilter::setRange(const qreal range)
+{
+  m_resolution = qMax(qAbs(range) * kResolution,
+                      std::numeric_limits<qreal>::epsilon());
+}
+
+/**
+ * @brief Moves the output to the given @a value immediately, without
+ *        interpolation.
+ */
+void Widgets::DisplayFilter::reset(const qreal value)
+{
+  m_value = wrapped(value);
+  m_target = m_value;
+  m_velocity = 0;
+  m_settled = true;
+}
+
+/**
+ * @brief Sets the value that the output should move towards.
+ *
+ * The velocity of the output is kept, so a new target only bends the current
+ * motion instead of restarting it.
+ */
+void Widgets::DisplayFilter::setTarget(const qreal value)
+{
+  // Follow the shortest path towards the target angle
+  auto target = value;
+  if (m_wrap > 0)
+  {
+    auto delta = std::fmod(value - m_value, m_wrap);
+    if (delta > m_wrap / 2)
+      delta -= m_wrap;
+    else if (delta < -m_wrap / 2)
+      delta += m_wrap;
+
+    target = m_value + delta;
+  }
+
+  // Update the target & start measuring the elapsed time if needed
+  if (target == m_target)
+    return;
+
+  m_target = target;
+  if (m_settled)
+  {
+    m_settled = false;
+    m_clock.start();
+  }
+}
+
+/**
+ * @brief Advances the output by the time elapsed since the previous call,
+ *        should be called once per render tick.
+ *
+ * The critically damped spring is solved exactly for the elapsed time, so
+ * the output follows the same curve with any refresh rate (and after long
+ * pauses, e.g. while the widget is hidden).
+ *
+ * @return @c true if the displayed value changed.
+ */
+bool Widgets::DisplayFilter::step()
+{
+  // Nothing to do
+  if (m_settled)
+    return false;
+
+  // Obtain the elapsed time in seconds
+  const qreal dt = m_clock.nsecsElapsed() / 1e9;
+  m_clock.restart();
+
+  // Solve the critically damped spring over the elapsed time
+  const qreal omega = 4 / kSmoothingTime;
+  const auto change = m_value - m_target;
+  const auto temp = (m_velocity + omega * change) * dt;
+  const auto decay = std::exp(-omega * dt);
+  const auto previous = value();
+  m_velocity = (m_velocity - omega * temp) * decay;
+  m_value = m_target + (change + temp) * decay;
+
+  // Stop once the output reached the target
+  if (qAbs(m_value - m_target) <= m_resolution
+      && qAbs(m_velocity) * kSmoothingTime <= m_resolution)
+    reset(m_target);
+
+  return value() != previous;
+}
+
+/**
+ * @brief Maps the given @a value to the [0, wrap) range if the filter
+ *        handles angles.
+ */
+qreal Widgets::DisplayFilter::wrapped(const qreal value) const
+{
+  if (m_wrap <= 0)
+    return value;
+
+  auto result = std::fmod(value, m_wrap);
+  if (result < 0)
+    result += m_wrap;
+
+  return result;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+
+namespace Widgets
+{
+/**
+ * @brief Critically damped display filter for the values of the dashboard
+ *        widgets.
+ *
+ * The filter moves its output towards the latest received value like a
+ * critically damped spring, which reaches the target as fast as possible
+ * without overshooting. New targets keep the current velocity of the output,
+ * so noisy data does not restart the motion from rest and needles do not
+ * jitter.
+ *
+ * The spring is integrated in closed form with the time elapsed since the
+ * previous render tick, so the motion does not depend on the UI refresh rate.
+ *
+ * Angles are supported by setting a wrap value (e.g. 360 degrees), in that
+ * case the output follows the shortest path towards the target & is reported
+ * in the [0, wrap) range.
+ */
+class DisplayFilter
+{
+public:
+  DisplayFilter();
+
+  [[nodiscard]] qreal value() const;
+  [[nodiscard]] qreal target() const;
+  [[nodiscard]] bool settled() const;
+
+  void setWrap(const qreal wrap);
+  void setRange(const qreal range);
+  void reset(const qreal value);
+  void setTarget(const qreal value);
+
+  bool step();
+
+private:
+  [[nodiscard]] qreal wrapped(const qreal value) const;
+
+private:
+  /**
+   * Time (in seconds) that the output needs to get close to a new target.
+   */
+  static constexpr qreal kSmoothingTime = 0.1;
+
+  /**
+   * Fraction of the widget range below which the output is considered to
+   * have reached the target.
+   */
+  static constexpr qreal kResolution = 1e-4;
+
+private:
+  qreal m_wrap;
+  qreal m_value;
+  qreal m_target;
+  qreal m_velocity;
+  qreal m_resolution;
+
+  bool m_settled;
+  QElapsedTimer m_clock;
+};
+} // namespace Widgets
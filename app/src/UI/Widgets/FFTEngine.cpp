@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <qfouriertransformer.h>
+
+#include "SIMD/SIMD.h"
+#include "Misc/WorkerPool.h"
+#include "UI/Widgets/FFTEngine.h"
+
+/**
+ * @brief Transformer & buffers shared between an FFT engine and the worker
+ *        pool job that calculates its spectrum.
+ *
+ * The @c busy flag is set while a job is queued or running, and @c ready is
+ * set once the job has written a new spectrum that the engine has not picked
+ * up yet.
+ */
+struct Widgets::FFTEngine::Job
+{
+  Job()
+    : transformer(0, QStringLiteral("Hann"))
+    , busy(false)
+    , ready(false)
+  {
+  }
+
+  void run();
+
+  QFourierTransformer transformer;
+
+  QVector<float> fft;
+  QVector<float> power;
+  QVector<float> samples;
+  QVector<float> spectrum;
+
+  std::atomic_bool busy;
+  std::atomic_bool ready;
+};
+
+/**
+ * @brief Calculates the spectrum (in dB relative to the strongest bin) of the
+ *        samples, runs in one of the threads of the worker pool.
+ */
+void Widgets::FFTEngine::Job::run()
+{
+  // Obtain FFT transformation
+  transformer.forwardTransform(samples.data(), fft.data());
+  transformer.rescale(fft.data());
+
+  // Obtain the power of each bin & the strongest bin
+  const auto bins = power.count();
+  SIMD::powerSpectrum(fft.constData(), fft.constData() + bins, power.data(),
+                      bins);
+  const auto maxPower = SIMD::findMax<float>(power.constData(), bins);
+
+  // Convert to decibels relative to the strongest bin
+  spectrum.resize(bins);
+  const auto scale = maxPower > 0 ? 1.0f / maxPower : 0.0f;
+  for (qsizetype i = 0; i < bins; ++i)
+  {
+    const auto p = power[i] * scale;
+    spectrum[i] = p > 0 ? 10 * std::log10(p) : -100;
+  }
+
+  // Let the engine pick up the spectrum
+  ready = true;
+  busy = false;
+}
+
+/**
+ * @brief Constructs an FFT engine that is not configured yet.
+ */
+Widgets::FFTEngine::FFTEngine()
+  : m_size(0)
+  , m_hopSize(1)
+  , m_samplingRate(0)
+  , m_sequence(0)
+  , m_job(std::make_shared<Job>())
+{
+}
+
+/**
+ * @brief Configures the window size, window function, hop size & sampling
+ *        rate of the engine from the FFT settings of the given @a dataset.
+ */
+void Widgets::FFTEngine::configure(const JSON::Dataset &dataset)
+{
+  // Use a new job, a queued job may still use the previous buffers
+  m_sequence = 0;
+  m_job = std::make_shared<Job>();
+
+  // Initialize FFT size
+  auto &transformer = m_job->transformer;
+  int size = qMax(8, dataset.fftSamples());
+  while (transformer.setSize(size) != QFourierTransformer::FixedSize)
+    --size;
+
+  // Set the size
+  m_size = size;
+
+  // Obtain sampling rate, hop size & window function from dataset
+  m_hopSize = dataset.fftHopSize();
+  m_samplingRate = dataset.fftSamplingRate();
+  if (!transformer.setWindowFunction(dataset.fftWindow()))
+    transformer.setWindowFunction(QStringLiteral("Hann"));
+
+  // Allocate FFT, power and sample arrays
+  m_job->fft.resize(m_size);
+  m_job->power.resize(bins());
+  m_job->samples.resize(m_size);
+}
+
+/**
+ * @brief Returns the number of samples used for each transform.
+ */
+int Widgets::FFTEngine::size() const
+{
+  return m_size;
+}
+
+/**
+ * @brief Returns the number of frequency bins of the spectrum.
+ */
+int Widgets::FFTEngine::bins() const
+{
+  return m_size / 2;
+}
+
+/**
+ * @brief Returns the sampling rate (in Hz) of the transformed samples.
+ */
+int Widgets::FFTEngine::samplingRate() const
+{
+  return m_samplingRate;
+}
+
+/**
+ * @brief Returns the frequency (in Hz) of the given spectrum @a bin.
+ */
+qreal Widgets::FFTEngine::frequency(const int bin) const
+{
+  if (m_size <= 0)
+    return 0;
+
+  return static_cast<qreal>(bin) * m_samplingRate / static_cast<qreal>(m_size);
+}
+
+/**
+ * @brief Swaps the spectrum calculated by the worker pool since the last call
+ *        (if any) into @a spectrum.
+ *
+ * @return @c true if @a spectrum was updated, @c false if no new spectrum is
+ *         available and @a spectrum was left untouched.
+ */
+bool Widgets::FFTEngine::takeSpectrum(QVector<float> &spectrum)
+{
+  if (!m_job->ready.exchange(false))
+    return false;
+
+  spectrum.swap(m_job->spectrum);
+  return true;
+}
+
+/**
+ * @brief Queues a new transform of the newest samples of the given @a curve,
+ *        if at least @c hopSize samples were appended since the last transform
+ *        and no other transform is running.
+ */
+void Widgets::FFTEngine::process(const Curve &curve)
+{
+  // Wait for the queued transform to finish
+  if (m_size <= 0 || m_job->busy)
+    return;
+
+  // Skip the transform until enough new samples have arrived
+  const auto sequence = curve.sequence();
+  const auto hopSize = static_cast<quint64>(m_hopSize);
+  if (sequence >= m_sequence && sequence - m_sequence < hopSize)
+    return;
+
+  // Copy the newest samples from data
+  m_sequence = sequence;
+  qsizetype offset = 0;
+  auto *samples = m_job->samples.data();
+  auto skip = curve.count() - qMin<qsizetype>(m_size, curve.count());
+  for (const auto &span : {curve.firstSpan(), curve.secondSpan()})
+  {
+    const auto begin = qMin(skip, span.count);
+    std::copy_n(span.data + begin, span.count - begin, samples + offset);
+    offset += span.count - begin;
+    skip -= begin;
+  }
+
+  // Calculate the transform in the worker pool
+  m_job->busy = true;
+  Misc::WorkerPool::instance().start([job = m_job] { job->run(); });
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <QVector>
+
+#include "SerialStudio.h"
+
+namespace Widgets
+{
+/**
+ * @class Widgets::FFTEngine
+ * @brief Incremental FFT pipeline shared by the spectrum widgets.
+ *
+ * The engine is configured from the FFT settings of a dataset (window size,
+ * window function, hop size & sampling rate). Every time @c process() is
+ * called, it checks if at least @c hopSize new samples were appended to the
+ * curve since the last transform, and if so, it copies the newest samples
+ * into a job that is calculated by the shared @c Misc::WorkerPool.
+ *
+ * The spectrum of a finished job (in dB relative to the strongest bin) is
+ * picked up by the widget with @c takeSpectrum(), so that the GUI thread
+ * never calculates a transform. Only one job is queued at a time, and the
+ * job buffers are shared with the worker, so destroying the engine while a
+ * transform is running is safe.
+ */
+class FFTEngine
+{
+public:
+  FFTEngine();
+
+  void configure(const JSON::Dataset &dataset);
+
+  [[nodiscard]] int size() const;
+  [[nodiscard]] int bins() const;
+  [[nodiscard]] int samplingRate() const;
+  [[nodiscard]] qreal frequency(const int bin) const;
+
+  bool takeSpectrum(QVector<float> &spectrum);
+  void process(const Curve &curve);
+
+private:
+  struct Job;
+
+  int m_size;
+  int m_hopSize;
+  int m_samplingRate;
+  quint64 m_sequence;
+
+  std::shared_ptr<Job> m_job;
+};
+} // namespace Widgets
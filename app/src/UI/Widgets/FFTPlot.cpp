@@ -22,6 +22,7 @@
 
 #include "UI/Dashboard.h"
 #include "UI/Widgets/FFTPlot.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a new FFTPlot widget.
@@ -30,44 +31,32 @@
  */
 Widgets::FFTPlot::FFTPlot(const int index, QQuickItem *parent)
   : QQuickItem(parent)
-  , m_size(0)
   , m_index(index)
-  , m_samplingRate(0)
   , m_minX(0)
   , m_maxX(0)
   , m_minY(0)
   , m_maxY(0)
-  , m_transformer(0, QStringLiteral("Hann"))
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardFFT, m_index))
   {
-    // Get FFT dataset
+    // Configure the FFT engine from the dataset
     const auto &dataset = GET_DATASET(SerialStudio::DashboardFFT, m_index);
-
-    // Initialize FFT size
-    int size = qMax(8, dataset.fftSamples());
-    while (m_transformer.setSize(size) != QFourierTransformer::FixedSize)
-      --size;
-
-    // Set the size
-    m_size = size;
-
-    // Obtain sampling rate from dataset
-    m_samplingRate = dataset.fftSamplingRate();
-
-    // Allocate FFT and sample arrays
-    m_fft.reset(new float[m_size]);
-    m_samples.reset(new float[m_size]);
+    m_engine.configure(dataset);
 
     // Set axis ranges
     m_minX = 0;
     m_maxY = 0;
     m_minY = -100;
-    m_maxX = m_samplingRate / 2;
+    m_maxX = m_engine.samplingRate() / 2;
+
+    // Calculate the frequency of each bin once
+    m_data.resize(m_engine.bins());
+    for (int i = 0; i < m_engine.bins(); ++i)
+      m_data[i] = QPointF(m_engine.frequency(i), m_minY);
 
     // Update widget
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &FFTPlot::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardFFT, m_index,
+                                        this, &FFTPlot::updateData);
   }
 }
 
@@ -126,63 +115,42 @@ qreal Widgets::FFTPlot::yTickInterval() const
 }
 
 /**
- * @brief Draws the FFT data on the given QLineSeries.
- * @param series The QLineSeries to draw the data on.
+ * @brief Draws the FFT data on the given line renderer.
+ * @param renderer The scene graph curve to draw the data on.
  */
-void Widgets::FFTPlot::draw(QLineSeries *series)
+void Widgets::FFTPlot::draw(Widgets::LineRenderer *renderer)
 {
-  if (series)
-  {
-    series->replace(m_data);
-    Q_EMIT series->update();
-  }
+  if (renderer)
+    renderer->setPoints(m_data);
 }
 
 /**
  * @brief Updates the FFT data.
+ *
+ * The spectrum calculated by the FFT engine since the last UI refresh (if
+ * any) is swapped in, and a new transform is queued once the dataset has
+ * received at least @c fftHopSize new samples since the last transform.
+ * Otherwise, the cached spectrum is kept as-is.
  */
 void Widgets::FFTPlot::updateData()
 {
+  TRACE_ZONE("FFTPlot::updateData");
+
   if (!isEnabled())
     return;
 
-  // Get the plot data
-  auto dash = &UI::Dashboard::instance();
-  auto plotData = dash->fftPlotValues();
-
-  // If the plot data is valid, update the data
-  if (plotData.count() > m_index)
+  // Swap in the spectrum calculated by the worker pool
+  if (m_engine.takeSpectrum(m_spectrum))
   {
-    // Obtain samples from data
-    const auto &data = plotData.at(m_index);
-    for (int i = 0; i < m_size; ++i)
-      m_samples[i] = static_cast<float>(data[i]);
-
-    // Obtain FFT transformation
-    m_transformer.forwardTransform(m_samples.data(), m_fft.data());
-    m_transformer.rescale(m_fft.data());
-
-    // Create a final array with the magnitudes for each point
-    qreal maxMagnitude = 0;
-    m_data.resize(m_size / 2);
-    for (int i = 0; i < m_size / 2; ++i)
-    {
-      const qreal re = m_fft[i];
-      const qreal im = m_fft[m_size / 2 + i];
-      const qreal m = sqrt(re * re + im * im);
-      const qreal f
-          = static_cast<qreal>(i) * m_samplingRate / static_cast<qreal>(m_size);
-      m_data[i] = QPointF(f, m);
-      if (m > maxMagnitude)
-        maxMagnitude = m;
-    }
-
-    // Convert to decibels
-    for (int i = 0; i < m_size / 2; ++i)
-    {
-      const qreal m = m_data[i].y() / maxMagnitude;
-      const qreal dB = (m > 0) ? 20 * log10(m) : -100;
-      m_data[i].setY(dB);
-    }
+    const auto count = qMin(m_data.count(), m_spectrum.count());
+    for (qsizetype i = 0; i < count; ++i)
+      m_data[i].setY(m_spectrum[i]);
   }
+
+  // Queue a new transform if the plot data is valid
+  const auto &dashboard = UI::Dashboard::instance();
+  const auto *history = dashboard.datasetHistory(SerialStudio::DashboardFFT,
+                                                 m_index);
+  if (history)
+    m_engine.process(*history);
 }
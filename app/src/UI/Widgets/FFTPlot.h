@@ -24,13 +24,18 @@
 
 #include <QtQuick>
 #include <QVector>
-#include <QLineSeries>
-#include <qfouriertransformer.h>
+
+#include "UI/Widgets/FFTEngine.h"
+#include "UI/Widgets/LineRenderer.h"
 
 namespace Widgets
 {
 /**
  * @brief A widget that plots the FFT of a dataset.
+ *
+ * The transform is calculated by a @c Widgets::FFTEngine in the shared
+ * worker pool, the widget only swaps in the finished spectrum during the next
+ * UI refresh.
  */
 class FFTPlot : public QQuickItem
 {
@@ -58,25 +63,21 @@ public:
   [[nodiscard]] qreal yTickInterval() const;
 
 public slots:
-  void draw(QLineSeries *series);
+  void draw(Widgets::LineRenderer *renderer);
 
 private slots:
   void updateData();
 
 private:
-  int m_size;
   int m_index;
-  int m_samplingRate;
 
   qreal m_minX;
   qreal m_maxX;
   qreal m_minY;
   qreal m_maxY;
 
-  QFourierTransformer m_transformer;
-
+  FFTEngine m_engine;
   QList<QPointF> m_data;
-  QScopedArrayPointer<float> m_fft;
-  QScopedArrayPointer<float> m_samples;
+  QVector<float> m_spectrum;
 };
 } // namespace Widgets
@@ -20,8 +20,30 @@
  * THE SOFTWARE.
  */
 
+#include <QtMath>
+
 #include "UI/Dashboard.h"
 #include "UI/Widgets/GPS.h"
+#include "Misc/Trace.h"
+
+//------------------------------------------------------------------------------
+// Track history constants
+//------------------------------------------------------------------------------
+
+/** Maximum number of points kept in the decimated trajectory */
+static constexpr qsizetype kMaxTrackPoints = 2000;
+
+/** Number of raw positions collected before they are decimated */
+static constexpr qsizetype kTrackBatchSize = 64;
+
+/** Positions closer than this (in meters) to the previous one are ignored */
+static constexpr qreal kMinTrackDistance = 0.5;
+
+/** Initial Douglas-Peucker tolerance, in meters */
+static constexpr qreal kInitialTrackTolerance = 1.0;
+
+/** Mean earth radius used to project coordinates to meters */
+static constexpr qreal kEarthRadius = 6371000.0;
 
 /**
  * @brief Constructs a GPS widget.
@@ -31,13 +53,32 @@
 Widgets::GPS::GPS(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
+  , m_altitudeSlot(-1)
+  , m_latitudeSlot(-1)
+  , m_longitudeSlot(-1)
   , m_altitude(0)
   , m_latitude(0)
   , m_longitude(0)
+  , m_trackTolerance(kInitialTrackTolerance)
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardGPS, m_index))
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Widgets::GPS::updateData);
+  {
+    // Find the dataset that provides each coordinate
+    const auto &group = GET_GROUP(SerialStudio::DashboardGPS, m_index);
+    for (int i = 0; i < group.datasetCount(); ++i)
+    {
+      const auto &widget = group.getDataset(i).widget();
+      if (m_latitudeSlot < 0 && widget == QStringLiteral("lat"))
+        m_latitudeSlot = i;
+      else if (m_longitudeSlot < 0 && widget == QStringLiteral("lon"))
+        m_longitudeSlot = i;
+      else if (m_altitudeSlot < 0 && widget == QStringLiteral("alt"))
+        m_altitudeSlot = i;
+    }
+
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardGPS, m_index,
+                                        this, &Widgets::GPS::updateData);
+  }
 }
 
 /**
@@ -64,6 +105,38 @@ qreal Widgets::GPS::longitude() const
   return m_longitude;
 }
 
+/**
+ * @brief Returns the trajectory followed by the GPS so far.
+ *
+ * The list contains the decimated history followed by the positions that
+ * have not been decimated yet, so that the last point is always the latest
+ * position received by the widget.
+ *
+ * @return A list of @c QGeoCoordinate values, suitable for a @c MapPolyline.
+ */
+QVariantList Widgets::GPS::track() const
+{
+  QVariantList path;
+  path.reserve(m_track.size() + m_pendingTrack.size());
+  for (const auto &coordinate : m_track)
+    path.append(QVariant::fromValue(coordinate));
+  for (const auto &coordinate : m_pendingTrack)
+    path.append(QVariant::fromValue(coordinate));
+
+  return path;
+}
+
+/**
+ * @brief Discards the trajectory history of the widget.
+ */
+void Widgets::GPS::clearTrack()
+{
+  m_track.clear();
+  m_pendingTrack.clear();
+  m_trackTolerance = kInitialTrackTolerance;
+  Q_EMIT trackChanged();
+}
+
 /**
  * Checks if the widget is enabled, if so, the widget shall be updated
  * to process the latest data frame.
@@ -73,24 +146,25 @@ qreal Widgets::GPS::longitude() const
  */
 void Widgets::GPS::updateData()
 {
+  TRACE_ZONE("GPS::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardGPS, m_index))
   {
+    // Read the coordinates from the datasets found by the constructor
     const auto &group = GET_GROUP(SerialStudio::DashboardGPS, m_index);
+    const auto value = [&group](const int slot) {
+      if (slot < 0 || slot >= group.datasetCount())
+        return 0.0;
 
-    qreal lat = 0, lon = 0, alt = 0;
-    for (int i = 0; i < group.datasetCount(); ++i)
-    {
-      const auto &dataset = group.getDataset(i);
-      if (dataset.widget() == QStringLiteral("lat"))
-        lat = dataset.value().toDouble();
-      else if (dataset.widget() == QStringLiteral("lon"))
-        lon = dataset.value().toDouble();
-      else if (dataset.widget() == QStringLiteral("alt"))
-        alt = dataset.value().toDouble();
-    }
+      return group.getDataset(slot).numericValue();
+    };
+
+    const qreal lat = value(m_latitudeSlot);
+    const qreal lon = value(m_longitudeSlot);
+    const qreal alt = value(m_altitudeSlot);
 
     if (!qFuzzyCompare(lat, m_latitude) || !qFuzzyCompare(lon, m_longitude)
         || !qFuzzyCompare(alt, m_altitude))
@@ -98,7 +172,156 @@ void Widgets::GPS::updateData()
       m_latitude = lat;
       m_altitude = alt;
       m_longitude = lon;
+      appendToTrack(lat, lon);
       Q_EMIT updated();
     }
   }
 }
+
+/**
+ * @brief Adds a position to the trajectory history.
+ *
+ * Positions are collected in a small pending batch. Once the batch is full,
+ * it is decimated and appended to the trajectory. If the trajectory exceeds
+ * its point budget, the whole history is decimated again with a coarser
+ * tolerance, so that memory usage and rendering time stay bounded.
+ *
+ * @param latitude  The latitude of the new position, in degrees.
+ * @param longitude The longitude of the new position, in degrees.
+ */
+void Widgets::GPS::appendToTrack(const qreal latitude, const qreal longitude)
+{
+  // Ignore invalid positions & positions reported without a fix
+  const QGeoCoordinate coordinate(latitude, longitude);
+  const bool noFix = qFuzzyIsNull(latitude) && qFuzzyIsNull(longitude);
+  if (!coordinate.isValid() || noFix)
+    return;
+
+  // Ignore positions that barely moved from the previous one
+  QGeoCoordinate previous;
+  if (!m_pendingTrack.isEmpty())
+    previous = m_pendingTrack.last();
+  else if (!m_track.isEmpty())
+    previous = m_track.last();
+
+  if (previous.isValid() && previous.distanceTo(coordinate) < kMinTrackDistance)
+    return;
+
+  // Register the position
+  m_pendingTrack.append(coordinate);
+
+  // Decimate the pending batch, starting from the last committed point
+  if (m_pendingTrack.size() >= kTrackBatchSize)
+  {
+    QList<QGeoCoordinate> segment;
+    segment.reserve(m_pendingTrack.size() + 1);
+    if (!m_track.isEmpty())
+      segment.append(m_track.last());
+
+    segment.append(m_pendingTrack);
+    auto simplified = simplify(segment, m_trackTolerance);
+    if (!m_track.isEmpty())
+      simplified.removeFirst();
+
+    m_track.append(simplified);
+    m_pendingTrack.clear();
+
+    // Coarsen the whole trajectory until it fits in the point budget
+    while (m_track.size() > kMaxTrackPoints)
+    {
+      m_trackTolerance *= 2;
+      m_track = simplify(m_track, m_trackTolerance);
+    }
+  }
+
+  // Update the user interface
+  Q_EMIT trackChanged();
+}
+
+/**
+ * @brief Decimates a polyline with the Douglas-Peucker algorithm.
+ *
+ * Coordinates are projected to a local equirectangular plane centered on the
+ * first point, which is accurate enough for the distances involved in a
+ * trajectory segment. The first and last points are always preserved.
+ *
+ * @param points    The polyline to decimate.
+ * @param tolerance The maximum allowed deviation, in meters.
+ *
+ * @return The decimated polyline.
+ */
+QList<QGeoCoordinate>
+Widgets::GPS::simplify(const QList<QGeoCoordinate> &points,
+                       const qreal tolerance)
+{
+  // Nothing to decimate
+  const auto count = points.size();
+  if (count < 3)
+    return points;
+
+  // Project the coordinates to meters
+  const qreal scale = qDegreesToRadians(kEarthRadius);
+  const qreal cosLatitude = qCos(qDegreesToRadians(points.first().latitude()));
+  QList<QPointF> plane;
+  plane.reserve(count);
+  for (const auto &point : points)
+    plane.append(QPointF(point.longitude() * cosLatitude * scale,
+                         point.latitude() * scale));
+
+  // Find the points to keep, without recursion
+  QList<bool> keep(count, false);
+  keep[0] = true;
+  keep[count - 1] = true;
+
+  QList<QPair<qsizetype, qsizetype>> stack;
+  stack.append(qMakePair(qsizetype(0), count - 1));
+  while (!stack.isEmpty())
+  {
+    const auto range = stack.takeLast();
+    const auto &a = plane[range.first];
+    const auto &b = plane[range.second];
+    const qreal dx = b.x() - a.x();
+    const qreal dy = b.y() - a.y();
+    const qreal lengthSquared = dx * dx + dy * dy;
+
+    // Find the point farthest away from the segment
+    qreal maxDistance = 0;
+    qsizetype farthest = -1;
+    for (auto i = range.first + 1; i < range.second; ++i)
+    {
+      const auto &p = plane[i];
+      qreal t = 0;
+      if (lengthSquared > 0)
+      {
+        t = ((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / lengthSquared;
+        t = qBound(0.0, t, 1.0);
+      }
+
+      const qreal distance
+          = qHypot(p.x() - (a.x() + t * dx), p.y() - (a.y() + t * dy));
+      if (distance > maxDistance)
+      {
+        maxDistance = distance;
+        farthest = i;
+      }
+    }
+
+    // Keep the point & subdivide the range if it deviates too much
+    if (farthest > 0 && maxDistance > tolerance)
+    {
+      keep[farthest] = true;
+      stack.append(qMakePair(range.first, farthest));
+      stack.append(qMakePair(farthest, range.second));
+    }
+  }
+
+  // Build the decimated polyline
+  QList<QGeoCoordinate> result;
+  for (qsizetype i = 0; i < count; ++i)
+  {
+    if (keep[i])
+      result.append(points[i]);
+  }
+
+  return result;
+}
@@ -23,11 +23,18 @@
 #pragma once
 
 #include <QQuickItem>
+#include <QVariantList>
+#include <QGeoCoordinate>
 
 namespace Widgets
 {
 /**
  * @brief A widget that displays the GPS data on a map.
+ *
+ * Besides the latest position, the widget keeps a bounded history of the
+ * positions received so far, which the map renders as a single polyline.
+ * The history is decimated with the Douglas-Peucker algorithm, so that long
+ * sessions keep the shape of the trajectory with a limited number of points.
  */
 class GPS : public QQuickItem
 {
@@ -35,9 +42,11 @@ class GPS : public QQuickItem
   Q_PROPERTY(qreal altitude READ altitude NOTIFY updated)
   Q_PROPERTY(qreal latitude READ latitude NOTIFY updated)
   Q_PROPERTY(qreal longitude READ longitude NOTIFY updated)
+  Q_PROPERTY(QVariantList track READ track NOTIFY trackChanged)
 
 signals:
   void updated();
+  void trackChanged();
 
 public:
   GPS(const int index = -1, QQuickItem *parent = nullptr);
@@ -45,14 +54,30 @@ public:
   [[nodiscard]] qreal altitude() const;
   [[nodiscard]] qreal latitude() const;
   [[nodiscard]] qreal longitude() const;
+  [[nodiscard]] QVariantList track() const;
+
+public slots:
+  void clearTrack();
 
 private slots:
   void updateData();
 
+private:
+  void appendToTrack(const qreal latitude, const qreal longitude);
+  static QList<QGeoCoordinate> simplify(const QList<QGeoCoordinate> &points,
+                                        const qreal tolerance);
+
 private:
   int m_index;
+  int m_altitudeSlot;
+  int m_latitudeSlot;
+  int m_longitudeSlot;
   qreal m_altitude;
   qreal m_latitude;
   qreal m_longitude;
+
+  qreal m_trackTolerance;
+  QList<QGeoCoordinate> m_track;
+  QList<QGeoCoordinate> m_pendingTrack;
 };
 } // namespace Widgets
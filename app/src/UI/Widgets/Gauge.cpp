@@ -21,7 +21,10 @@
  */
 
 #include "UI/Dashboard.h"
+#include "Misc/AlarmEngine.h"
 #include "UI/Widgets/Gauge.h"
+#include "Misc/TimerEvents.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a Gauge widget.
@@ -31,7 +34,7 @@
 Widgets::Gauge::Gauge(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
-  , m_value(0)
+  , m_alarm(false)
   , m_minValue(0)
   , m_maxValue(100)
   , m_alarmValue(0)
@@ -44,12 +47,28 @@ Widgets::Gauge::Gauge(const int index, QQuickItem *parent)
     m_alarmValue = dataset.alarm();
     m_minValue = qMin(dataset.min(), dataset.max());
     m_maxValue = qMax(dataset.min(), dataset.max());
+    m_filter.setRange(m_maxValue - m_minValue);
+    m_filter.reset(qBound(m_minValue, dataset.numericValue(), m_maxValue));
 
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Gauge::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardGauge, m_index,
+                                        this, &Gauge::updateData);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
+            this, &Widgets::Gauge::updateDisplay);
+
+    updateAlarm();
+    connect(&Misc::AlarmEngine::instance(), &Misc::AlarmEngine::alarmsChanged,
+            this, &Widgets::Gauge::updateAlarm);
   }
 }
 
+/**
+ * @brief Returns @c true if the alarm of the dataset is active.
+ */
+bool Widgets::Gauge::alarm() const
+{
+  return m_alarm;
+}
+
 /**
  * @brief Returns the measurement units of the dataset.
  */
@@ -60,11 +79,15 @@ const QString &Widgets::Gauge::units() const
 
 /**
  * @brief Returns the current value of the gauge.
+ *
+ * The value is smoothed by a display filter, so it moves towards the latest
+ * dataset value at the UI refresh rate.
+ *
  * @return The current value of the gauge.
  */
 qreal Widgets::Gauge::value() const
 {
-  return m_value;
+  return m_filter.value();
 }
 
 /**
@@ -98,21 +121,52 @@ qreal Widgets::Gauge::alarmValue() const
  * @brief Updates the gauge data from the Dashboard.
  *
  * This method retrieves the latest data for this gauge from the Dashboard
- * and updates the gauge's value and text display accordingly.
+ * and sets it as the target of the display filter, the displayed value is
+ * updated on the following render ticks.
  */
 void Widgets::Gauge::updateData()
 {
+  TRACE_ZONE("Gauge::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardGauge, m_index))
   {
     const auto &dataset = GET_DATASET(SerialStudio::DashboardGauge, m_index);
-    auto value = qMax(m_minValue, qMin(m_maxValue, dataset.value().toDouble()));
-    if (!qFuzzyCompare(value, m_value))
+    m_filter.setTarget(qBound(m_minValue, dataset.numericValue(), m_maxValue));
+  }
+}
+
+/**
+ * @brief Obtains the alarm state of the dataset from the alarm engine, which
+ *        evaluates the alarms of every received frame.
+ */
+void Widgets::Gauge::updateAlarm()
+{
+  if (VALIDATE_WIDGET(SerialStudio::DashboardGauge, m_index))
+  {
+    const auto &dataset = GET_DATASET(SerialStudio::DashboardGauge, m_index);
+    const bool alarm = Misc::AlarmEngine::instance().active(dataset.index());
+    if (m_alarm != alarm)
     {
-      m_value = value;
+      m_alarm = alarm;
       Q_EMIT updated();
     }
   }
 }
+
+/**
+ * @brief Advances the display filter on every render tick and notifies the
+ *        user interface if the displayed value changed.
+ *
+ * Nothing is done once the displayed value has reached the dataset value.
+ */
+void Widgets::Gauge::updateDisplay()
+{
+  if (!isEnabled())
+    return;
+
+  if (m_filter.step())
+    Q_EMIT updated();
+}
@@ -22,6 +22,7 @@
 
 #include "UI/Dashboard.h"
 #include "UI/Widgets/Gyroscope.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a Gyroscope widget.
@@ -36,11 +37,8 @@ Widgets::Gyroscope::Gyroscope(const int index, QQuickItem *parent)
   , m_pitch(0)
 {
   if (VALIDATE_WIDGET(SerialStudio::DashboardGyroscope, m_index))
-  {
-    m_timer.start();
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Gyroscope::updateData);
-  }
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardGyroscope,
+                                        m_index, this, &Gyroscope::updateData);
 }
 
 /**
@@ -73,78 +71,33 @@ qreal Widgets::Gyroscope::pitch() const
 /**
  * @brief Updates the gyroscope data from the Dashboard.
  *
- * This method retrieves the latest data for this gyroscope from the
- * Dashboard and updates the pitch, roll, and yaw values accordingly
- * by integrating the data over time.
+ * This method retrieves the latest orientation of this gyroscope from the
+ * Dashboard, which is integrated (and fused with the accelerometer, if any)
+ * for every received frame by @c JSON::ImuFusion.
  */
 void Widgets::Gyroscope::updateData()
 {
+  TRACE_ZONE("Gyroscope::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardGyroscope, m_index))
   {
-    // Get the gyroscope data and validate the dataset count
+    // Get the fused orientation of the gyroscope
     const auto &gyro = GET_GROUP(SerialStudio::DashboardGyroscope, m_index);
-    if (gyro.datasetCount() != 3)
-      return;
-
-    // Backup previous readings
-    const qreal previousYaw = m_yaw;
-    const qreal previousRoll = m_roll;
-    const qreal previousPitch = m_pitch;
-
-    // Obtain delta-T for integration
-    const qreal deltaT = qMax(1, m_timer.elapsed()) / 1000.0;
-    m_timer.restart();
-
-    // Update the pitch, roll, and yaw values by integration
-    for (int i = 0; i < 3; ++i)
-    {
-      // Obtain dataset
-      const auto &dataset = gyro.getDataset(i);
-
-      // clang-format off
-      const qreal angle = dataset.value().toDouble();
-      const bool isYaw = (dataset.widget() == QStringLiteral("z")) ||
-                         (dataset.widget() == QStringLiteral("yaw"));
-      const bool isRoll = (dataset.widget() == QStringLiteral("y")) ||
-                          (dataset.widget() == QStringLiteral("roll"));
-      const bool isPitch = (dataset.widget() == QStringLiteral("x")) ||
-                           (dataset.widget() == QStringLiteral("pitch"));
-      // clang-format on
-
-      // Update orientation angles
-      if (isYaw)
-        m_yaw += angle * deltaT;
-      else if (isRoll)
-        m_roll += angle * deltaT;
-      else if (isPitch)
-        m_pitch += angle * deltaT;
-    }
-
-    // Normalize yaw angle from -180 to 180
-    m_yaw = std::fmod(m_yaw + 180.0, 360.0);
-    if (m_yaw < 0)
-      m_yaw += 360.0;
-    m_yaw -= 180.0;
-
-    // Normalize roll angle from -180 to 180
-    m_roll = std::fmod(m_roll + 180.0, 360.0);
-    if (m_roll < 0)
-      m_roll += 360.0;
-    m_roll -= 180.0;
-
-    // Normalize pitch angle from -180 to 180
-    m_pitch = std::fmod(m_pitch + 180.0, 360.0);
-    if (m_pitch < 0)
-      m_pitch += 360.0;
-    m_pitch -= 180.0;
+    const qreal yaw = gyro.yaw();
+    const qreal roll = gyro.roll();
+    const qreal pitch = gyro.pitch();
 
     // Request a repaint of the widget
-    if (!qFuzzyCompare(m_yaw, previousYaw)
-        || !qFuzzyCompare(m_roll, previousRoll)
-        || !qFuzzyCompare(m_pitch, previousPitch))
+    if (!qFuzzyCompare(yaw, m_yaw) || !qFuzzyCompare(roll, m_roll)
+        || !qFuzzyCompare(pitch, m_pitch))
+    {
+      m_yaw = yaw;
+      m_roll = roll;
+      m_pitch = pitch;
       Q_EMIT updated();
+    }
   }
 }
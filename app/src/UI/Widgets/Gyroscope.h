@@ -28,6 +28,9 @@ namespace Widgets
 {
 /**
  * @brief A widget that displays the gyroscope data on an attitude indicator.
+ *
+ * The orientation is estimated by @c JSON::ImuFusion on every frame, the
+ * widget only reads the latest fused angles of its group.
  */
 class Gyroscope : public QQuickItem
 {
@@ -54,7 +57,6 @@ private:
   qreal m_yaw;
   qreal m_roll;
   qreal m_pitch;
-  QElapsedTimer m_timer;
 };
 
 } // namespace Widgets
@@ -21,8 +21,11 @@
  */
 
 #include "UI/Dashboard.h"
+#include "Misc/AlarmEngine.h"
+#include "Misc/TimerEvents.h"
 #include "Misc/ThemeManager.h"
 #include "UI/Widgets/LEDPanel.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs an LEDPanel widget.
@@ -48,14 +51,22 @@ Widgets::LEDPanel::LEDPanel(const int index, QQuickItem *parent)
       m_titles[i] = group.getDataset(i).title();
     }
 
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &LEDPanel::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardLED, m_index,
+                                        this, &LEDPanel::updateData);
 
     m_alarmTimer.setInterval(250);
     m_alarmTimer.setTimerType(Qt::PreciseTimer);
     connect(&m_alarmTimer, &QTimer::timeout, this,
             &Widgets::LEDPanel::onAlarmTimeout);
-    m_alarmTimer.start();
+    connect(this, &Widgets::LEDPanel::enabledChanged, this,
+            &Widgets::LEDPanel::updateBlinker);
+    connect(&Misc::TimerEvents::instance(),
+            &Misc::TimerEvents::lowPowerModeChanged, this,
+            &Widgets::LEDPanel::updateBlinker);
+
+    updateAlarms();
+    connect(&Misc::AlarmEngine::instance(), &Misc::AlarmEngine::alarmsChanged,
+            this, &Widgets::LEDPanel::updateAlarms);
 
     onThemeChanged();
     connect(&Misc::ThemeManager::instance(), &Misc::ThemeManager::themeChanged,
@@ -112,10 +123,13 @@ const QStringList &Widgets::LEDPanel::titles() const
  * @brief Updates the LED panel data from the Dashboard.
  *
  * This method retrieves the latest data for this LED panel from the Dashboard
- * and updates the LEDs' states and titles accordingly.
+ * and updates the LEDs' states and titles accordingly. LEDs with an active
+ * alarm keep blinking until the alarm is cleared.
  */
 void Widgets::LEDPanel::updateData()
 {
+  TRACE_ZONE("LEDPanel::updateData");
+
   if (!isEnabled())
     return;
 
@@ -126,31 +140,87 @@ void Widgets::LEDPanel::updateData()
     const auto &group = GET_GROUP(SerialStudio::DashboardLED, m_index);
     for (int i = 0; i < group.datasetCount(); ++i)
     {
-      // Get the dataset and its values
+      // Obtain the LED state
       const auto &dataset = group.getDataset(i);
-      const auto value = dataset.value().toDouble();
-      const auto alarmValue = dataset.alarm();
+      const bool enabled = (dataset.numericValue() >= dataset.ledHigh());
 
-      // Obtain the LED state
-      const bool enabled = (value >= dataset.ledHigh());
-      const bool alarm = (alarmValue != 0 && value >= alarmValue);
+      // Update the LED state
+      if (!m_alarms[i] && m_states[i] != enabled)
+      {
+        changed = true;
+        m_states[i] = enabled;
+      }
+    }
+
+    // Redraw the widget
+    if (changed)
+      Q_EMIT updated();
+  }
+}
 
-      // Update the alarm state
+/**
+ * @brief Obtains the alarm state of each LED from the alarm engine.
+ *
+ * The alarm blinker timer only runs while at least one LED has an active
+ * alarm, LEDs whose alarm is cleared go back to their regular state.
+ */
+void Widgets::LEDPanel::updateAlarms()
+{
+  if (VALIDATE_WIDGET(SerialStudio::DashboardLED, m_index))
+  {
+    // Update the alarm state of each LED
+    bool changed = false;
+    const auto &alarms = Misc::AlarmEngine::instance();
+    const auto &group = GET_GROUP(SerialStudio::DashboardLED, m_index);
+    const auto count = qMin(group.datasetCount(), int(m_alarms.count()));
+    for (int i = 0; i < count; ++i)
+    {
+      const auto &dataset = group.getDataset(i);
+      const bool alarm = alarms.active(dataset.index());
       if (m_alarms[i] != alarm)
       {
         changed = true;
         m_alarms[i] = alarm;
+        m_states[i] = alarm || dataset.numericValue() >= dataset.ledHigh();
       }
+    }
 
-      // Update the LED state
-      if (!alarm && m_states[i] != enabled)
+    // Start or stop the blinker
+    updateBlinker();
+    if (changed)
+      Q_EMIT updated();
+  }
+}
+
+/**
+ * @brief Starts or stops the alarm blinker timer.
+ *
+ * The timer runs while at least one LED has an active alarm and the widget
+ * is shown. In low-power mode, LEDs with an active alarm are lit without
+ * blinking instead.
+ */
+void Widgets::LEDPanel::updateBlinker()
+{
+  const bool blinking = m_alarms.contains(true) && isEnabled()
+                        && !Misc::TimerEvents::instance().lowPowerMode();
+  if (blinking && !m_alarmTimer.isActive())
+    m_alarmTimer.start();
+
+  else if (!blinking && m_alarmTimer.isActive())
+  {
+    m_alarmTimer.stop();
+
+    // Light the LEDs that were turned off by the blinker
+    bool changed = false;
+    for (int i = 0; i < m_alarms.count(); ++i)
+    {
+      if (m_alarms[i] && !m_states[i])
       {
         changed = true;
-        m_states[i] = enabled;
+        m_states[i] = true;
       }
     }
 
-    // Redraw the widget
     if (changed)
       Q_EMIT updated();
   }
@@ -181,10 +251,7 @@ void Widgets::LEDPanel::onAlarmTimeout()
  */
 void Widgets::LEDPanel::onThemeChanged()
 {
-  // clang-format off
-  const auto colors = Misc::ThemeManager::instance().colors()["widget_colors"].toArray();
-  // clang-format on
-
+  const auto &theme = Misc::ThemeManager::instance();
   if (VALIDATE_WIDGET(SerialStudio::DashboardLED, m_index))
   {
     const auto &group = GET_GROUP(SerialStudio::DashboardLED, m_index);
@@ -194,11 +261,7 @@ void Widgets::LEDPanel::onThemeChanged()
     for (int i = 0; i < group.datasetCount(); ++i)
     {
       const auto &dataset = group.getDataset(i);
-      const auto index = dataset.index() - 1;
-      const auto color = colors.count() > index
-                             ? colors.at(index).toString()
-                             : colors.at(index % colors.count()).toString();
-      m_colors[i] = color;
+      m_colors[i] = theme.datasetColorName(dataset.index());
     }
 
     Q_EMIT themeChanged();
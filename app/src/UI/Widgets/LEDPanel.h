@@ -55,6 +55,8 @@ public:
 
 private slots:
   void updateData();
+  void updateAlarms();
+  void updateBlinker();
   void onAlarmTimeout();
   void onThemeChanged();
 
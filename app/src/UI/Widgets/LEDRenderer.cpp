@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <array>
+
+#include <QtMath>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+
+#include "Misc/ThemeManager.h"
+#include "UI/Widgets/LEDRenderer.h"
+
+/** Number of segments used to approximate the circles of an LED */
+static constexpr int kLedSegments = 16;
+
+/** Vertices of an LED: glow ring, border ring (6 each) and disc (3) */
+static constexpr int kVerticesPerLed = kLedSegments * 15;
+
+/** Radius of the LED disc */
+static constexpr qreal kLedRadius = 9;
+
+/** Outer radius of the glow drawn around a lit LED */
+static constexpr qreal kGlowRadius = 20;
+
+/** Distance between the left edge of a cell and the LED disc */
+static constexpr qreal kLedMargin = 8;
+
+/** Opacity of the glow at the edge of a lit LED */
+static constexpr int kGlowAlpha = 140;
+
+/**
+ * @brief Returns the points of a unit circle, the last point repeats the
+ *        first one so that segments can be iterated without wrapping.
+ */
+static const std::array<QPointF, kLedSegments + 1> &unitCircle()
+{
+  static const auto circle = [] {
+    std::array<QPointF, kLedSegments + 1> points;
+    for (int i = 0; i <= kLedSegments; ++i)
+    {
+      const qreal angle = 2 * M_PI * i / kLedSegments;
+      points[i] = QPointF(qCos(angle), qSin(angle));
+    }
+
+    return points;
+  }();
+
+  return circle;
+}
+
+/**
+ * @brief Writes a vertex with a premultiplied color and advances the pointer.
+ */
+static void setVertex(QSGGeometry::ColoredPoint2D *&vertex,
+                      const QPointF &point, const QColor &color)
+{
+  const int a = color.alpha();
+  vertex->set(static_cast<float>(point.x()), static_cast<float>(point.y()),
+              static_cast<uchar>(color.red() * a / 255),
+              static_cast<uchar>(color.green() * a / 255),
+              static_cast<uchar>(color.blue() * a / 255),
+              static_cast<uchar>(a));
+  ++vertex;
+}
+
+/**
+ * @brief Writes the triangles of a ring, blending from @a inner at radius
+ *        @a r0 to @a outer at radius @a r1.
+ */
+static void writeRing(QSGGeometry::ColoredPoint2D *&vertex,
+                      const QPointF &center, const qreal r0, const qreal r1,
+                      const QColor &inner, const QColor &outer)
+{
+  const auto &circle = unitCircle();
+  for (int i = 0; i < kLedSegments; ++i)
+  {
+    const auto in0 = center + circle[i] * r0;
+    const auto in1 = center + circle[i + 1] * r0;
+    const auto out0 = center + circle[i] * r1;
+    const auto out1 = center + circle[i + 1] * r1;
+
+    setVertex(vertex, in0, inner);
+    setVertex(vertex, out0, outer);
+    setVertex(vertex, out1, outer);
+
+    setVertex(vertex, in0, inner);
+    setVertex(vertex, out1, outer);
+    setVertex(vertex, in1, inner);
+  }
+}
+
+/**
+ * @brief Writes the triangles of a filled circle.
+ */
+static void writeDisc(QSGGeometry::ColoredPoint2D *&vertex,
+                      const QPointF &center, const qreal radius,
+                      const QColor &color)
+{
+  const auto &circle = unitCircle();
+  for (int i = 0; i < kLedSegments; ++i)
+  {
+    setVertex(vertex, center, color);
+    setVertex(vertex, center + circle[i] * radius, color);
+    setVertex(vertex, center + circle[i + 1] * radius, color);
+  }
+}
+
+/**
+ * @brief Constructs a LEDRenderer item.
+ * @param parent The parent QQuickItem (optional).
+ */
+Widgets::LEDRenderer::LEDRenderer(QQuickItem *parent)
+  : QQuickItem(parent)
+  , m_columns(2)
+  , m_spacing(4)
+  , m_cellHeight(32)
+  , m_layoutChanged(true)
+  , m_statesChanged(false)
+{
+  setFlag(ItemHasContents, true);
+
+  // Move the LEDs when the item is resized
+  connect(this, &QQuickItem::widthChanged, this,
+          &Widgets::LEDRenderer::onLayoutChanged);
+}
+
+/**
+ * @brief Returns the number of LED columns.
+ */
+int Widgets::LEDRenderer::columns() const
+{
+  return m_columns;
+}
+
+/**
+ * @brief Returns the space between two cells, in pixels.
+ */
+qreal Widgets::LEDRenderer::spacing() const
+{
+  return m_spacing;
+}
+
+/**
+ * @brief Returns the height of a cell, in pixels.
+ */
+qreal Widgets::LEDRenderer::cellHeight() const
+{
+  return m_cellHeight;
+}
+
+/**
+ * @brief Returns the LED panel model drawn by the item.
+ */
+Widgets::LEDPanel *Widgets::LEDRenderer::model() const
+{
+  return m_model;
+}
+
+/**
+ * @brief Changes the number of LED columns.
+ */
+void Widgets::LEDRenderer::setColumns(const int columns)
+{
+  if (m_columns != columns && columns > 0)
+  {
+    m_columns = columns;
+    onLayoutChanged();
+    Q_EMIT layoutChanged();
+  }
+}
+
+/**
+ * @brief Changes the space between two cells, in pixels.
+ */
+void Widgets::LEDRenderer::setSpacing(const qreal spacing)
+{
+  if (!qFuzzyCompare(m_spacing, spacing))
+  {
+    m_spacing = spacing;
+    onLayoutChanged();
+    Q_EMIT layoutChanged();
+  }
+}
+
+/**
+ * @brief Changes the height of a cell, in pixels.
+ */
+void Widgets::LEDRenderer::setCellHeight(const qreal height)
+{
+  if (!qFuzzyCompare(m_cellHeight, height))
+  {
+    m_cellHeight = height;
+    onLayoutChanged();
+    Q_EMIT layoutChanged();
+  }
+}
+
+/**
+ * @brief Changes the LED panel model drawn by the item.
+ */
+void Widgets::LEDRenderer::setModel(Widgets::LEDPanel *model)
+{
+  if (m_model == model)
+    return;
+
+  if (m_model)
+    disconnect(m_model, nullptr, this, nullptr);
+
+  m_model = model;
+  if (m_model)
+  {
+    connect(m_model, &Widgets::LEDPanel::updated, this,
+            &Widgets::LEDRenderer::onStatesChanged);
+    connect(m_model, &Widgets::LEDPanel::themeChanged, this,
+            &Widgets::LEDRenderer::onThemeChanged);
+  }
+
+  onThemeChanged();
+  Q_EMIT modelChanged();
+}
+
+/**
+ * @brief Builds or updates the geometry node that draws the LEDs.
+ *
+ * The vertex buffer is re-allocated and fully rewritten when the number of
+ * LEDs, the layout or the theme changes. Otherwise, only the vertex blocks of
+ * the LEDs whose color changed since the last update are rewritten.
+ */
+QSGNode *Widgets::LEDRenderer::updatePaintNode(QSGNode *oldNode,
+                                               UpdatePaintNodeData *)
+{
+  // Create the node on the first update
+  auto *node = static_cast<QSGGeometryNode *>(oldNode);
+  if (!node)
+  {
+    auto *geometry
+        = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+
+    node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+  }
+
+  // Nothing to do
+  if (!m_layoutChanged && !m_statesChanged)
+    return node;
+
+  // Re-allocate the vertex buffer if the number of LEDs changed
+  const int count = m_model ? qMin(m_model->count(), m_colors.count()) : 0;
+  auto *geometry = node->geometry();
+  bool rewrite = m_layoutChanged;
+  if (geometry->vertexCount() != count * kVerticesPerLed)
+  {
+    rewrite = true;
+    geometry->allocate(count * kVerticesPerLed);
+  }
+
+  if (rewrite)
+  {
+    m_drawnColors.clear();
+    m_drawnColors.resize(count);
+  }
+
+  m_layoutChanged = false;
+  m_statesChanged = false;
+
+  // Rewrite the LEDs that changed
+  bool dirty = rewrite;
+  QList<bool> states;
+  if (m_model)
+    states = m_model->states();
+
+  auto *vertices = geometry->vertexDataAsColoredPoint2D();
+  for (int i = 0; i < count; ++i)
+  {
+    const auto color = ledColor(i);
+    if (!rewrite && m_drawnColors[i] == color)
+      continue;
+
+    const bool lit = i < states.count() && states[i];
+    const auto center = ledCenter(i);
+    auto glow = color;
+    glow.setAlpha(lit ? kGlowAlpha : 0);
+    auto fade = glow;
+    fade.setAlpha(0);
+
+    auto *vertex = vertices + i * kVerticesPerLed;
+    writeRing(vertex, center, kLedRadius, kGlowRadius, glow, fade);
+    writeRing(vertex, center, kLedRadius - 1, kLedRadius, m_borderColor,
+              m_borderColor);
+    writeDisc(vertex, center, kLedRadius - 1, color);
+
+    m_drawnColors[i] = color;
+    dirty = true;
+  }
+
+  if (dirty)
+    node->markDirty(QSGNode::DirtyGeometry);
+
+  return node;
+}
+
+/**
+ * @brief Schedules an update of the LEDs whose state changed.
+ */
+void Widgets::LEDRenderer::onStatesChanged()
+{
+  m_statesChanged = true;
+  update();
+}
+
+/**
+ * @brief Reloads the LED, alarm and border colors and redraws all the LEDs.
+ */
+void Widgets::LEDRenderer::onThemeChanged()
+{
+  const auto &theme = Misc::ThemeManager::instance().colors();
+  m_alarmColor = QColor(theme.value("alarm").toString());
+  m_borderColor = QColor(theme.value("widget_border").toString());
+
+  m_colors.clear();
+  if (m_model)
+  {
+    for (const auto &color : m_model->colors())
+      m_colors.append(QColor(color));
+  }
+
+  onLayoutChanged();
+}
+
+/**
+ * @brief Schedules a full rewrite of the vertex buffer.
+ */
+void Widgets::LEDRenderer::onLayoutChanged()
+{
+  m_layoutChanged = true;
+  update();
+}
+
+/**
+ * @brief Returns the center of the LED with the given @a index, in item
+ *        coordinates.
+ */
+QPointF Widgets::LEDRenderer::ledCenter(const int index) const
+{
+  const int row = index / m_columns;
+  const int column = index % m_columns;
+  const qreal cellWidth = (width() - (m_columns - 1) * m_spacing) / m_columns;
+
+  return QPointF(column * (cellWidth + m_spacing) + kLedMargin + kLedRadius,
+                 row * (m_cellHeight + m_spacing) + m_cellHeight / 2);
+}
+
+/**
+ * @brief Returns the color of the LED with the given @a index, considering
+ *        its on/off and alarm states.
+ */
+QColor Widgets::LEDRenderer::ledColor(const int index) const
+{
+  const auto &states = m_model->states();
+  const auto &alarms = m_model->alarms();
+
+  auto color = m_colors[index];
+  if (index < alarms.count() && alarms[index])
+    color = m_alarmColor;
+
+  if (index >= states.count() || !states[index])
+    color = color.darker();
+
+  return color;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+
+#include "UI/Widgets/LEDPanel.h"
+
+namespace Widgets
+{
+/**
+ * @class Widgets::LEDRenderer
+ * @brief Scene graph item that draws all the LEDs of an LED panel.
+ *
+ * Instead of instantiating a QML item (and its glow effects) for every LED,
+ * the renderer draws the complete panel with a single @c QSGGeometryNode.
+ * Every LED owns a fixed block of colored vertices (glow, border and disc),
+ * so that the whole panel is submitted to the GPU in one draw call.
+ *
+ * LEDs are laid out in a grid of @c columns columns, using the same cell
+ * geometry as the panel labels. When the panel state changes, only the
+ * vertex blocks of the LEDs whose color changed are rewritten.
+ */
+class LEDRenderer : public QQuickItem
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(Widgets::LEDPanel *model
+             READ model
+             WRITE setModel
+             NOTIFY modelChanged)
+  Q_PROPERTY(int columns
+             READ columns
+             WRITE setColumns
+             NOTIFY layoutChanged)
+  Q_PROPERTY(qreal spacing
+             READ spacing
+             WRITE setSpacing
+             NOTIFY layoutChanged)
+  Q_PROPERTY(qreal cellHeight
+             READ cellHeight
+             WRITE setCellHeight
+             NOTIFY layoutChanged)
+  // clang-format on
+
+signals:
+  void modelChanged();
+  void layoutChanged();
+
+public:
+  explicit LEDRenderer(QQuickItem *parent = nullptr);
+
+  [[nodiscard]] int columns() const;
+  [[nodiscard]] qreal spacing() const;
+  [[nodiscard]] qreal cellHeight() const;
+  [[nodiscard]] Widgets::LEDPanel *model() const;
+
+public slots:
+  void setColumns(const int columns);
+  void setSpacing(const qreal spacing);
+  void setCellHeight(const qreal height);
+  void setModel(Widgets::LEDPanel *model);
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private slots:
+  void onStatesChanged();
+  void onThemeChanged();
+  void onLayoutChanged();
+
+private:
+  [[nodiscard]] QPointF ledCenter(const int index) const;
+  [[nodiscard]] QColor ledColor(const int index) const;
+
+private:
+  int m_columns;
+  qreal m_spacing;
+  qreal m_cellHeight;
+
+  bool m_layoutChanged;
+  bool m_statesChanged;
+
+  QColor m_alarmColor;
+  QColor m_borderColor;
+  QList<QColor> m_colors;
+  QList<QColor> m_drawnColors;
+  QPointer<Widgets::LEDPanel> m_model;
+};
+} // namespace Widgets
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QSGGeometry>
+#include <QSGTransformNode>
+#include <QSGGeometryNode>
+#include <QSGFlatColorMaterial>
+
+#include "UI/Widgets/LineRenderer.h"
+
+/**
+ * @brief Constructs a LineRenderer item.
+ * @param parent The parent QQuickItem (optional).
+ */
+Widgets::LineRenderer::LineRenderer(QQuickItem *parent)
+  : QQuickItem(parent)
+  , m_xMin(0)
+  , m_xMax(1)
+  , m_yMin(0)
+  , m_yMax(1)
+  , m_color(Qt::white)
+  , m_colorChanged(true)
+  , m_pointsChanged(false)
+{
+  setClip(true);
+  setFlag(ItemHasContents, true);
+
+  // Update the transformation matrix when the item is resized
+  connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+  connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+}
+
+/**
+ * @brief Returns the X value drawn at the left edge of the item.
+ */
+qreal Widgets::LineRenderer::xMin() const
+{
+  return m_xMin;
+}
+
+/**
+ * @brief Returns the X value drawn at the right edge of the item.
+ */
+qreal Widgets::LineRenderer::xMax() const
+{
+  return m_xMax;
+}
+
+/**
+ * @brief Returns the Y value drawn at the bottom edge of the item.
+ */
+qreal Widgets::LineRenderer::yMin() const
+{
+  return m_yMin;
+}
+
+/**
+ * @brief Returns the Y value drawn at the top edge of the item.
+ */
+qreal Widgets::LineRenderer::yMax() const
+{
+  return m_yMax;
+}
+
+/**
+ * @brief Returns the color of the curve.
+ */
+const QColor &Widgets::LineRenderer::color() const
+{
+  return m_color;
+}
+
+/**
+ * @brief Changes the X value drawn at the left edge of the item.
+ */
+void Widgets::LineRenderer::setXMin(const qreal value)
+{
+  setRangeValue(m_xMin, value);
+}
+
+/**
+ * @brief Changes the X value drawn at the right edge of the item.
+ */
+void Widgets::LineRenderer::setXMax(const qreal value)
+{
+  setRangeValue(m_xMax, value);
+}
+
+/**
+ * @brief Changes the Y value drawn at the bottom edge of the item.
+ */
+void Widgets::LineRenderer::setYMin(const qreal value)
+{
+  setRangeValue(m_yMin, value);
+}
+
+/**
+ * @brief Changes the Y value drawn at the top edge of the item.
+ */
+void Widgets::LineRenderer::setYMax(const qreal value)
+{
+  setRangeValue(m_yMax, value);
+}
+
+/**
+ * @brief Changes the color of the curve.
+ */
+void Widgets::LineRenderer::setColor(const QColor &color)
+{
+  if (m_color != color)
+  {
+    m_color = color;
+    m_colorChanged = true;
+    update();
+
+    Q_EMIT colorChanged();
+  }
+}
+
+/**
+ * @brief Replaces the points of the curve, the vertex data is updated during
+ *        the next scene graph synchronization.
+ *
+ * @param points The points of the curve in data coordinates.
+ */
+void Widgets::LineRenderer::setPoints(const QVector<QPointF> &points)
+{
+  m_points = points;
+  m_pointsChanged = true;
+  update();
+}
+
+/**
+ * @brief Returns the points of the curve so that the caller can replace them
+ *        in place, without an intermediate copy. The vertex data is updated
+ *        during the next scene graph synchronization.
+ */
+QVector<QPointF> &Widgets::LineRenderer::editPoints()
+{
+  m_pointsChanged = true;
+  update();
+  return m_points;
+}
+
+/**
+ * @brief Builds or updates the scene graph nodes of the curve.
+ *
+ * The node tree is a @c QSGTransformNode that maps data coordinates to item
+ * coordinates, with a single line strip @c QSGGeometryNode as its child.
+ */
+QSGNode *Widgets::LineRenderer::updatePaintNode(QSGNode *oldNode,
+                                                UpdatePaintNodeData *)
+{
+  // Create the node tree on the first update
+  QSGGeometryNode *line = nullptr;
+  auto *transform = static_cast<QSGTransformNode *>(oldNode);
+  if (!transform)
+  {
+    auto *geometry
+        = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setVertexDataPattern(QSGGeometry::StreamPattern);
+
+    line = new QSGGeometryNode;
+    line->setGeometry(geometry);
+    line->setMaterial(new QSGFlatColorMaterial);
+    line->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+
+    transform = new QSGTransformNode;
+    transform->appendChildNode(line);
+  }
+
+  else
+    line = static_cast<QSGGeometryNode *>(transform->firstChild());
+
+  // Map the plot range to the item rectangle
+  QMatrix4x4 matrix;
+  const auto dx = m_xMax - m_xMin;
+  const auto dy = m_yMax - m_yMin;
+  if (!qFuzzyIsNull(dx) && !qFuzzyIsNull(dy))
+  {
+    matrix.translate(0, height());
+    matrix.scale(width() / dx, -height() / dy);
+    matrix.translate(-m_xMin, -m_yMin);
+  }
+
+  if (transform->matrix() != matrix)
+    transform->setMatrix(matrix);
+
+  // Update the curve color
+  if (m_colorChanged)
+  {
+    m_colorChanged = false;
+    static_cast<QSGFlatColorMaterial *>(line->material())->setColor(m_color);
+    line->markDirty(QSGNode::DirtyMaterial);
+  }
+
+  // Update the vertices that changed since the last update
+  if (m_pointsChanged)
+  {
+    m_pointsChanged = false;
+
+    auto *geometry = line->geometry();
+    const auto count = static_cast<int>(m_points.count());
+    const bool reallocate = geometry->vertexCount() != count;
+    if (reallocate)
+      geometry->allocate(count);
+
+    bool dirty = reallocate;
+    auto *vertices = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i < count; ++i)
+    {
+      const auto x = static_cast<float>(m_points[i].x());
+      const auto y = static_cast<float>(m_points[i].y());
+      if (reallocate || vertices[i].x != x || vertices[i].y != y)
+      {
+        vertices[i].set(x, y);
+        dirty = true;
+      }
+    }
+
+    if (dirty)
+      line->markDirty(QSGNode::DirtyGeometry);
+  }
+
+  return transform;
+}
+
+/**
+ * @brief Updates one of the plot range values and schedules a repaint, only
+ *        the transformation matrix is changed.
+ */
+void Widgets::LineRenderer::setRangeValue(qreal &member, const qreal value)
+{
+  if (!qFuzzyCompare(member, value))
+  {
+    member = value;
+    update();
+
+    Q_EMIT rangeChanged();
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QPointF>
+#include <QVector>
+#include <QQuickItem>
+
+namespace Widgets
+{
+/**
+ * @class Widgets::LineRenderer
+ * @brief Scene graph item that draws a single plot curve.
+ *
+ * The curve is drawn with a @c QSGGeometryNode that is updated directly from
+ * the points of a plot widget model, without going through a chart series.
+ * Vertices are stored in data coordinates, and a @c QSGTransformNode maps the
+ * @c xMin / @c xMax and @c yMin / @c yMax range to the item rectangle, so the
+ * axis transformation is done on the GPU and changing the plot range does not
+ * touch the vertex data.
+ *
+ * The geometry is allocated once and only re-allocated when the number of
+ * points changes, and only the vertices that changed since the last update
+ * are rewritten.
+ */
+class LineRenderer : public QQuickItem
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(qreal xMin
+             READ xMin
+             WRITE setXMin
+             NOTIFY rangeChanged)
+  Q_PROPERTY(qreal xMax
+             READ xMax
+             WRITE setXMax
+             NOTIFY rangeChanged)
+  Q_PROPERTY(qreal yMin
+             READ yMin
+             WRITE setYMin
+             NOTIFY rangeChanged)
+  Q_PROPERTY(qreal yMax
+             READ yMax
+             WRITE setYMax
+             NOTIFY rangeChanged)
+  Q_PROPERTY(QColor color
+             READ color
+             WRITE setColor
+             NOTIFY colorChanged)
+  // clang-format on
+
+signals:
+  void colorChanged();
+  void rangeChanged();
+
+public:
+  explicit LineRenderer(QQuickItem *parent = nullptr);
+
+  [[nodiscard]] qreal xMin() const;
+  [[nodiscard]] qreal xMax() const;
+  [[nodiscard]] qreal yMin() const;
+  [[nodiscard]] qreal yMax() const;
+  [[nodiscard]] const QColor &color() const;
+  [[nodiscard]] QVector<QPointF> &editPoints();
+
+public slots:
+  void setXMin(const qreal value);
+  void setXMax(const qreal value);
+  void setYMin(const qreal value);
+  void setYMax(const qreal value);
+  void setColor(const QColor &color);
+  void setPoints(const QVector<QPointF> &points);
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+  void setRangeValue(qreal &member, const qreal value);
+
+private:
+  qreal m_xMin;
+  qreal m_xMax;
+  qreal m_yMin;
+  qreal m_yMax;
+  QColor m_color;
+
+  bool m_colorChanged;
+  bool m_pointsChanged;
+  QVector<QPointF> m_points;
+};
+} // namespace Widgets
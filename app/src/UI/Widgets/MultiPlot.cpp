@@ -20,10 +20,11 @@
  * THE SOFTWARE.
  */
 
-#include "SIMD/SIMD.h"
 #include "UI/Dashboard.h"
+#include "CSV/Reference.h"
 #include "Misc/ThemeManager.h"
 #include "UI/Widgets/MultiPlot.h"
+#include "Misc/Trace.h"
 
 /**
  * @brief Constructs a MultiPlot widget.
@@ -33,6 +34,7 @@
 Widgets::MultiPlot::MultiPlot(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
+  , m_pixelWidth(0)
   , m_minX(0)
   , m_maxX(0)
   , m_minY(0)
@@ -55,16 +57,17 @@ Widgets::MultiPlot::MultiPlot(const int index, QQuickItem *parent)
     // Obtain group title
     m_yLabel = group.title();
 
-    // Resize data container to fit curves
-    m_data.resize(group.datasetCount());
-    for (auto i = 0; i < group.datasetCount(); ++i)
-      m_data[i].resize(UI::Dashboard::instance().points());
+    // Draw every curve on the first update
+    m_pending.fill(true, group.datasetCount());
+    m_referencePending.fill(true, group.datasetCount());
 
     // Connect to the dashboard signals to update the plot data and range
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &MultiPlot::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardMultiPlot,
+                                        m_index, this, &MultiPlot::updateData);
     connect(&UI::Dashboard::instance(), &UI::Dashboard::pointsChanged, this,
             &MultiPlot::updateRange);
+    connect(&CSV::Reference::instance(), &CSV::Reference::openChanged, this,
+            &MultiPlot::referenceChanged);
 
     // Connect to the theme manager to update the curve colors
     onThemeChanged();
@@ -83,7 +86,17 @@ Widgets::MultiPlot::MultiPlot(const int index, QQuickItem *parent)
  */
 int Widgets::MultiPlot::count() const
 {
-  return m_data.count();
+  return m_labels.count();
+}
+
+/**
+ * @brief Returns the width of the plot area in pixels, used to decimate the
+ *        plotted curves.
+ * @return The plot width in pixels, or 0 if decimation is disabled.
+ */
+int Widgets::MultiPlot::pixelWidth() const
+{
+  return m_pixelWidth;
 }
 
 /**
@@ -168,46 +181,94 @@ const QStringList &Widgets::MultiPlot::labels() const
 }
 
 /**
- * @brief Draws the data on the given QLineSeries.
- * @param series The QLineSeries to draw the data on.
+ * @brief Returns @c true if a reference session is overlaid on the curves.
+ */
+bool Widgets::MultiPlot::hasReference() const
+{
+  return CSV::Reference::instance().isOpen();
+}
+
+/**
+ * @brief Changes the width of the plot area in pixels, the plotted curves are
+ *        decimated to two points per pixel column.
+ * @param width The plot width in pixels, 0 disables decimation.
+ */
+void Widgets::MultiPlot::setPixelWidth(const int width)
+{
+  if (m_pixelWidth != width)
+  {
+    m_pixelWidth = qMax(0, width);
+    m_pending.fill(true);
+    Q_EMIT pixelWidthChanged();
+  }
+}
+
+/**
+ * @brief Draws the data on the given line renderer.
+ *
+ * The curve is decimated directly into the point buffer of the renderer, at
+ * most two points per pixel column, and only if it changed since it was last
+ * drawn.
+ *
+ * @param renderer The scene graph curve to draw the data on.
  * @param index The index of the dataset to draw.
  */
-void Widgets::MultiPlot::draw(QLineSeries *series, const int index)
+void Widgets::MultiPlot::draw(Widgets::LineRenderer *renderer, const int index)
 {
-  if (series && index >= 0 && index < count())
+  if (renderer && index >= 0 && index < count())
   {
     if (index == 0)
       calculateAutoScaleRange();
 
-    series->replace(m_data[index]);
-    Q_EMIT series->update();
+    if (!m_pending[index])
+      return;
+
+    const auto plotData = UI::Dashboard::instance().multiplotValues();
+    if (m_index >= 0 && plotData.size() > m_index)
+    {
+      m_pending[index] = false;
+      const auto &curves = plotData[m_index];
+      curves.toPoints(index, renderer->editPoints(), m_pixelWidth);
+    }
+  }
+}
+
+/**
+ * @brief Draws the reference overlay of a dataset on the given line renderer.
+ *
+ * @param renderer The scene graph curve to draw the reference on.
+ * @param index The index of the dataset to draw.
+ */
+void Widgets::MultiPlot::drawReference(Widgets::LineRenderer *renderer,
+                                       const int index)
+{
+  if (renderer && index >= 0 && index < count() && m_referencePending[index])
+  {
+    const auto *curves
+        = UI::Dashboard::instance().multiplotReference(m_index);
+    if (curves && index < curves->curveCount())
+    {
+      m_referencePending[index] = false;
+      curves->toPoints(index, renderer->editPoints(), m_pixelWidth);
+    }
   }
 }
 
 /**
- * @brief Updates the data of the multiplot.
+ * @brief Marks the curves of the multiplot to be redrawn, since new samples
+ *        were appended to the dashboard histories.
  */
 void Widgets::MultiPlot::updateData()
 {
+  TRACE_ZONE("MultiPlot::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardMultiPlot, m_index))
   {
-    const auto &plotData = UI::Dashboard::instance().multiplotValues();
-    if (m_index >= 0 && plotData.count() > m_index)
-    {
-      const auto &curves = plotData[m_index];
-      for (int i = 0; i < curves.count(); ++i)
-      {
-        const auto &values = curves[i];
-        if (m_data[i].count() != values.count())
-          m_data[i].resize(values.count());
-
-        for (int j = 0; j < values.count(); ++j)
-          m_data[i][j] = QPointF(j, values[j]);
-      }
-    }
+    m_pending.fill(true);
+    m_referencePending.fill(true);
   }
 }
 
@@ -220,24 +281,10 @@ void Widgets::MultiPlot::updateRange()
   if (!VALIDATE_WIDGET(SerialStudio::DashboardMultiPlot, m_index))
     return;
 
-  // Clear dataset curves
-  for (auto &dataset : m_data)
-  {
-    dataset.clear();
-    dataset.squeeze();
-  }
-
-  // Clear the data
-  m_data.clear();
-  m_data.squeeze();
-
-  // Get the multiplot group and loop through each dataset
+  // Redraw every curve, the dashboard histories were re-allocated
   const auto &group = GET_GROUP(SerialStudio::DashboardMultiPlot, m_index);
-  for (int i = 0; i < group.datasetCount(); ++i)
-  {
-    m_data.append(QVector<QPointF>());
-    m_data.last().resize(UI::Dashboard::instance().points() + 1);
-  }
+  m_pending.fill(true, group.datasetCount());
+  m_referencePending.fill(true, group.datasetCount());
 
   // Update X-axis range
   m_minX = 0;
@@ -252,10 +299,7 @@ void Widgets::MultiPlot::updateRange()
  */
 void Widgets::MultiPlot::onThemeChanged()
 {
-  // clang-format off
-  const auto colors = Misc::ThemeManager::instance().colors()["widget_colors"].toArray();
-  // clang-format on
-
+  const auto &theme = Misc::ThemeManager::instance();
   if (VALIDATE_WIDGET(SerialStudio::DashboardMultiPlot, m_index))
   {
     const auto &group = GET_GROUP(SerialStudio::DashboardMultiPlot, m_index);
@@ -265,12 +309,7 @@ void Widgets::MultiPlot::onThemeChanged()
     for (int i = 0; i < group.datasetCount(); ++i)
     {
       const auto &dataset = group.getDataset(i);
-      const auto index = dataset.index() - 1;
-      const auto color = colors.count() > index
-                             ? colors.at(index).toString()
-                             : colors.at(index % colors.count()).toString();
-
-      m_colors[i] = color;
+      m_colors[i] = theme.datasetColorName(dataset.index());
     }
 
     Q_EMIT themeChanged();
@@ -288,7 +327,7 @@ void Widgets::MultiPlot::calculateAutoScaleRange()
   const auto prevMaxY = m_maxY;
 
   // If the data is empty, set the range to 0-1
-  if (m_data.isEmpty())
+  if (m_labels.isEmpty())
   {
     m_minY = 0;
     m_maxY = 1;
@@ -323,16 +362,23 @@ void Widgets::MultiPlot::calculateAutoScaleRange()
     m_minY = std::numeric_limits<qreal>::max();
     m_maxY = std::numeric_limits<qreal>::lowest();
 
-    // Loop through each dataset and find the min and max values
-    for (const auto &dataset : m_data)
+    // Combine the running min and max of each curve history
+    const auto plotData = UI::Dashboard::instance().multiplotValues();
+    if (m_index >= 0 && plotData.size() > m_index)
     {
-      m_minY = qMin(m_minY, SIMD::findMin(dataset, [](const QPointF &p) {
-                      return p.y();
-                    }));
+      const auto &curves = plotData[m_index];
+      for (qsizetype i = 0; i < curves.curveCount(); ++i)
+      {
+        m_minY = qMin(m_minY, curves.min(i));
+        m_maxY = qMax(m_maxY, curves.max(i));
+      }
+    }
 
-      m_maxY = qMax(m_maxY, SIMD::findMax(dataset, [](const QPointF &p) {
-                      return p.y();
-                    }));
+    // No curve history available
+    if (m_minY > m_maxY)
+    {
+      m_minY = 0;
+      m_maxY = 0;
     }
 
     // If the min and max are the same, set the range to 0-1
@@ -371,6 +417,6 @@ void Widgets::MultiPlot::calculateAutoScaleRange()
   }
 
   // Update user interface if required
-  if (qFuzzyCompare(prevMinY, m_minY) || qFuzzyCompare(prevMaxY, m_maxY))
+  if (!qFuzzyCompare(prevMinY, m_minY) || !qFuzzyCompare(prevMaxY, m_maxY))
     Q_EMIT rangeChanged();
 }
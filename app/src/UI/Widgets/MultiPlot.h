@@ -24,12 +24,21 @@
 
 #include <QtQuick>
 #include <QVector>
-#include <QLineSeries>
+
+#include "UI/Widgets/LineRenderer.h"
 
 namespace Widgets
 {
 /**
  * @brief A widget that displays multiple plots on a single chart.
+ *
+ * The widget does not keep a copy of the curves: when a curve is drawn, its
+ * history is decimated straight from the dashboard's multiplot block into
+ * the point buffer of its @c LineRenderer, and only if new samples arrived
+ * since it was last drawn.
+ *
+ * While a reference session is open, the reference values of each dataset
+ * are drawn the same way with @c drawReference().
  */
 class MultiPlot : public QQuickItem
 {
@@ -44,26 +53,21 @@ class MultiPlot : public QQuickItem
   Q_PROPERTY(QStringList colors READ colors NOTIFY themeChanged)
   Q_PROPERTY(qreal xTickInterval READ xTickInterval NOTIFY rangeChanged)
   Q_PROPERTY(qreal yTickInterval READ yTickInterval NOTIFY rangeChanged)
+  Q_PROPERTY(int pixelWidth READ pixelWidth WRITE setPixelWidth
+                 NOTIFY pixelWidthChanged)
+  Q_PROPERTY(bool hasReference READ hasReference NOTIFY referenceChanged)
 
 signals:
   void rangeChanged();
+  void pixelWidthChanged();
+  void referenceChanged();
   void themeChanged();
 
 public:
   explicit MultiPlot(const int index = -1, QQuickItem *parent = nullptr);
-  ~MultiPlot()
-  {
-    for (auto &curve : m_data)
-    {
-      curve.clear();
-      curve.squeeze();
-    }
-
-    m_data.clear();
-    m_data.squeeze();
-  }
 
   [[nodiscard]] int count() const;
+  [[nodiscard]] int pixelWidth() const;
   [[nodiscard]] qreal minX() const;
   [[nodiscard]] qreal maxX() const;
   [[nodiscard]] qreal minY() const;
@@ -73,9 +77,12 @@ public:
   [[nodiscard]] const QString &yLabel() const;
   [[nodiscard]] const QStringList &colors() const;
   [[nodiscard]] const QStringList &labels() const;
+  [[nodiscard]] bool hasReference() const;
 
 public slots:
-  void draw(QLineSeries *series, const int index);
+  void setPixelWidth(const int width);
+  void draw(Widgets::LineRenderer *renderer, const int index);
+  void drawReference(Widgets::LineRenderer *renderer, const int index);
 
 private slots:
   void updateData();
@@ -85,6 +92,7 @@ private slots:
 
 private:
   int m_index;
+  int m_pixelWidth;
   qreal m_minX;
   qreal m_maxX;
   qreal m_minY;
@@ -92,6 +100,7 @@ private:
   QString m_yLabel;
   QStringList m_colors;
   QStringList m_labels;
-  QVector<QVector<QPointF>> m_data;
+  QVector<bool> m_pending;
+  QVector<bool> m_referencePending;
 };
 } // namespace Widgets
@@ -20,9 +20,11 @@
  * THE SOFTWARE.
  */
 
-#include "SIMD/SIMD.h"
 #include "UI/Dashboard.h"
 #include "UI/Widgets/Plot.h"
+#include "CSV/Reference.h"
+#include "Misc/Trace.h"
+#include "SIMD/SIMD.h"
 
 /**
  * @brief Constructs a Plot widget.
@@ -32,6 +34,7 @@
 Widgets::Plot::Plot(const int index, QQuickItem *parent)
   : QQuickItem(parent)
   , m_index(index)
+  , m_pixelWidth(0)
   , m_minX(0)
   , m_maxX(0)
   , m_minY(0)
@@ -48,16 +51,38 @@ Widgets::Plot::Plot(const int index, QQuickItem *parent)
     if (!dataset.units().isEmpty())
       m_yLabel += " (" + dataset.units() + ")";
 
-    connect(&UI::Dashboard::instance(), &UI::Dashboard::updated, this,
-            &Plot::updateData);
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardPlot, m_index,
+                                        this, &Plot::updateData);
     connect(&UI::Dashboard::instance(), &UI::Dashboard::pointsChanged, this,
             &Plot::updateRange);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::timeAxisChanged, this,
+            &Plot::updateRange);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::timeWindowChanged,
+            this, &Plot::updateRange);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::timeOffsetChanged,
+            this, &Plot::updateRange);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::timeOffsetChanged,
+            this, &Plot::updateData);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::triggerChanged, this,
+            &Plot::updateRange);
+    connect(&CSV::Reference::instance(), &CSV::Reference::openChanged, this,
+            &Plot::referenceChanged);
 
     calculateAutoScaleRange();
     updateRange();
   }
 }
 
+/**
+ * @brief Returns the width of the plot area in pixels, used to decimate the
+ *        plotted curves.
+ * @return The plot width in pixels, or 0 if decimation is disabled.
+ */
+int Widgets::Plot::pixelWidth() const
+{
+  return m_pixelWidth;
+}
+
 /**
  * @brief Returns the minimum X-axis value.
  * @return The minimum X-axis value.
@@ -122,41 +147,192 @@ const QString &Widgets::Plot::yLabel() const
 }
 
 /**
- * @brief Draws the data on the given QLineSeries.
- * @param series The QLineSeries to draw the data on.
+ * @brief Returns the X-axis label, which depends on whether the dashboard
+ *        plots samples over their index or over their acquisition time.
+ * @return The X-axis label.
  */
-void Widgets::Plot::draw(QLineSeries *series)
+QString Widgets::Plot::xLabel() const
 {
-  if (series)
+  const auto &dashboard = UI::Dashboard::instance();
+  if (dashboard.timeAxis() && !dashboard.triggerEnabled())
+    return tr("Time (s)");
+
+  return tr("Samples");
+}
+
+/**
+ * @brief Returns @c true if a reference session is overlaid on the plot.
+ */
+bool Widgets::Plot::hasReference() const
+{
+  return CSV::Reference::instance().isOpen();
+}
+
+/**
+ * @brief Changes the width of the plot area in pixels, the plotted curve is
+ *        decimated to two points per pixel column.
+ * @param width The plot width in pixels, 0 disables decimation.
+ */
+void Widgets::Plot::setPixelWidth(const int width)
+{
+  if (m_pixelWidth != width)
   {
-    series->replace(m_data);
+    m_pixelWidth = qMax(0, width);
+    Q_EMIT pixelWidthChanged();
+  }
+}
+
+/**
+ * @brief Draws the data on the given line renderer.
+ * @param renderer The scene graph curve to draw the data on.
+ */
+void Widgets::Plot::draw(Widgets::LineRenderer *renderer)
+{
+  if (renderer)
+  {
+    renderer->setPoints(m_data);
     calculateAutoScaleRange();
-    Q_EMIT series->update();
   }
 }
 
+/**
+ * @brief Draws the reference overlay on the given line renderer.
+ * @param renderer The scene graph curve to draw the reference on.
+ */
+void Widgets::Plot::drawReference(Widgets::LineRenderer *renderer)
+{
+  if (renderer)
+    renderer->setPoints(m_referenceData);
+}
+
 /**
  * @brief Updates the plot data from the Dashboard.
  */
 void Widgets::Plot::updateData()
 {
+  TRACE_ZONE("Plot::updateData");
+
   if (!isEnabled())
     return;
 
   if (VALIDATE_WIDGET(SerialStudio::DashboardPlot, m_index))
   {
-    const auto &plotData = UI::Dashboard::instance().linearPlotValues();
+    const auto &dashboard = UI::Dashboard::instance();
+    const auto *history
+        = dashboard.datasetHistory(SerialStudio::DashboardPlot, m_index);
 
-    if (m_index >= 0 && plotData.count() > m_index)
+    if (history)
     {
-      const auto &values = plotData[m_index];
-      if (m_data.count() != values.count())
-        m_data.resize(UI::Dashboard::instance().points());
+      // The history may be shared with (longer) FFT plots of the dataset
+      const auto samples = dashboard.points() + 1;
 
-      for (int i = 0; i < values.count(); ++i)
-        m_data[i] = QPointF(i, values[i]);
+      // Display the last triggered capture, centered on the trigger sample
+      if (dashboard.triggerEnabled())
+      {
+        const auto *capture
+            = dashboard.triggerCapture(SerialStudio::DashboardPlot, m_index);
+        if (capture)
+        {
+          capture->toPoints(m_data, m_pixelWidth);
+          const auto origin = static_cast<qreal>(dashboard.pretriggerSamples());
+          for (auto &point : m_data)
+            point.rx() -= origin;
+        }
+      }
+
+      // Place the samples of the time window at their acquisition time
+      else if (dashboard.timeAxis())
+      {
+        // Obtain the time of the oldest raw sample of the plot
+        const auto &timeline = dashboard.historyTimeline();
+        const auto window = qRound64(dashboard.timeWindow() * 1e9);
+        const auto offset = qRound64(dashboard.timeOffset() * 1e9);
+        const auto n = qMin<qsizetype>(samples, timeline.count());
+        const auto oldest = n > 0 ? timeline.at(timeline.count() - n) : 0;
+        const auto newest = timeline.newest();
+
+        // Obtain the time range of the window
+        const auto stop = newest - offset;
+        const auto start = stop - window;
+
+        // Draw the older part of the window from the history tiers
+        const auto *tiers
+            = dashboard.datasetTiers(SerialStudio::DashboardPlot, m_index);
+        if (tiers && oldest > 0 && start < oldest)
+        {
+          tiers->toPoints(newest, start, qMin(stop, oldest), m_data,
+                          m_pixelWidth);
+          if (stop > oldest)
+          {
+            history->toPoints(timeline, window, m_rawData, m_pixelWidth,
+                              samples, offset);
+            m_data.append(m_rawData);
+          }
+        }
+
+        // The raw samples cover the whole window
+        else
+          history->toPoints(timeline, window, m_data, m_pixelWidth, samples,
+                            offset);
+      }
+
+      // Send at most two points per pixel column to the chart
+      else
+        history->toPoints(m_data, m_pixelWidth, samples);
+    }
+  }
+
+  updateReference();
+}
+
+/**
+ * @brief Updates the reference overlay from the Dashboard.
+ *
+ * The overlay shares the timeline of the plot history, in time axis mode only
+ * the window covered by the raw samples is drawn.
+ */
+void Widgets::Plot::updateReference()
+{
+  // Obtain the reference overlay of the dataset
+  const auto &dashboard = UI::Dashboard::instance();
+  const auto *reference
+      = dashboard.referenceHistory(SerialStudio::DashboardPlot, m_index);
+  if (!reference)
+  {
+    m_referenceData.clear();
+    return;
+  }
+
+  // Display the reference of the last triggered capture
+  const auto samples = dashboard.points() + 1;
+  if (dashboard.triggerEnabled())
+  {
+    const auto *capture
+        = dashboard.referenceCapture(SerialStudio::DashboardPlot, m_index);
+    if (!capture)
+    {
+      m_referenceData.clear();
+      return;
     }
+
+    capture->toPoints(m_referenceData, m_pixelWidth);
+    const auto origin = static_cast<qreal>(dashboard.pretriggerSamples());
+    for (auto &point : m_referenceData)
+      point.rx() -= origin;
   }
+
+  // Place the reference samples at their acquisition time
+  else if (dashboard.timeAxis())
+  {
+    const auto window = qRound64(dashboard.timeWindow() * 1e9);
+    const auto offset = qRound64(dashboard.timeOffset() * 1e9);
+    reference->toPoints(dashboard.historyTimeline(), window, m_referenceData,
+                        m_pixelWidth, samples, offset);
+  }
+
+  // Send at most two points per pixel column to the chart
+  else
+    reference->toPoints(m_referenceData, m_pixelWidth, samples);
 }
 
 /**
@@ -164,16 +340,28 @@ void Widgets::Plot::updateData()
  */
 void Widgets::Plot::updateRange()
 {
-  // Reserve the number of points in the dashboard
-  m_data.clear();
-  m_data.squeeze();
-  m_data.resize(UI::Dashboard::instance().points() + 1);
+  // Update x-axis, time is given in seconds relative to the newest sample
+  const auto &dashboard = UI::Dashboard::instance();
+  if (dashboard.triggerEnabled())
+  {
+    m_minX = -static_cast<qreal>(dashboard.pretriggerSamples());
+    m_maxX = m_minX + dashboard.points();
+  }
 
-  // Update x-axis
-  m_minX = 0;
-  m_maxX = UI::Dashboard::instance().points();
+  else if (dashboard.timeAxis())
+  {
+    m_maxX = -dashboard.timeOffset();
+    m_minX = m_maxX - dashboard.timeWindow();
+  }
 
-  // Update the plot
+  else
+  {
+    m_minX = 0;
+    m_maxX = dashboard.points();
+  }
+
+  // Redraw the retained history with the new range
+  updateData();
   Q_EMIT rangeChanged();
 }
 
@@ -209,13 +397,23 @@ void Widgets::Plot::calculateAutoScaleRange()
   // Set the min and max to the lowest and highest values
   if (!ok)
   {
-    // Initialize values to ensure that min/max are set
-    m_minY = std::numeric_limits<qreal>::max();
-    m_maxY = std::numeric_limits<qreal>::lowest();
+    // Obtain the running min and max of the plot history
+    m_minY = 0;
+    m_maxY = 0;
+    const auto &dashboard = UI::Dashboard::instance();
+    const auto *history
+        = dashboard.datasetHistory(SerialStudio::DashboardPlot, m_index);
+    if (history && !dashboard.timeAxis() && !dashboard.triggerEnabled()
+        && history->count() <= dashboard.points() + 1)
+    {
+      m_minY = history->min();
+      m_maxY = history->max();
+    }
 
-    // Loop through the plot data and update the min and max
-    m_minY = SIMD::findMin(m_data, [](const QPointF &p) { return p.y(); });
-    m_maxY = SIMD::findMax(m_data, [](const QPointF &p) { return p.y(); });
+    // The history is longer than the plot, use the (decimated) plot data,
+    // which preserves the extremes of the displayed samples
+    else if (!m_data.isEmpty())
+      SIMD::findRangeY(m_data.constData(), m_data.count(), m_minY, m_maxY);
 
     // If min and max are the same, adjust the range
     if (qFuzzyCompare(m_minY, m_maxY))
@@ -253,6 +451,6 @@ void Widgets::Plot::calculateAutoScaleRange()
   }
 
   // Update user interface if required
-  if (qFuzzyCompare(prevMinY, m_minY) || qFuzzyCompare(prevMaxY, m_maxY))
+  if (!qFuzzyCompare(prevMinY, m_minY) || !qFuzzyCompare(prevMaxY, m_maxY))
     Q_EMIT rangeChanged();
 }
@@ -24,26 +24,36 @@
 
 #include <QtQuick>
 #include <QVector>
-#include <QLineSeries>
+
+#include "UI/Widgets/LineRenderer.h"
 
 namespace Widgets
 {
 /**
  * @brief A widget that displays a real-time plot of data points.
+ *
+ * While a reference session is open, the reference values of the dataset are
+ * drawn as a second curve with @c drawReference().
  */
 class Plot : public QQuickItem
 {
   Q_OBJECT
   Q_PROPERTY(QString yLabel READ yLabel CONSTANT)
+  Q_PROPERTY(QString xLabel READ xLabel NOTIFY rangeChanged)
   Q_PROPERTY(qreal minX READ minX NOTIFY rangeChanged)
   Q_PROPERTY(qreal maxX READ maxX NOTIFY rangeChanged)
   Q_PROPERTY(qreal minY READ minY NOTIFY rangeChanged)
   Q_PROPERTY(qreal maxY READ maxY NOTIFY rangeChanged)
   Q_PROPERTY(qreal xTickInterval READ xTickInterval NOTIFY rangeChanged)
   Q_PROPERTY(qreal yTickInterval READ yTickInterval NOTIFY rangeChanged)
+  Q_PROPERTY(int pixelWidth READ pixelWidth WRITE setPixelWidth
+                 NOTIFY pixelWidthChanged)
+  Q_PROPERTY(bool hasReference READ hasReference NOTIFY referenceChanged)
 
 signals:
   void rangeChanged();
+  void referenceChanged();
+  void pixelWidthChanged();
 
 public:
   explicit Plot(const int index = -1, QQuickItem *parent = nullptr);
@@ -51,8 +61,11 @@ public:
   {
     m_data.clear();
     m_data.squeeze();
+    m_referenceData.clear();
+    m_referenceData.squeeze();
   }
 
+  [[nodiscard]] int pixelWidth() const;
   [[nodiscard]] qreal minX() const;
   [[nodiscard]] qreal maxX() const;
   [[nodiscard]] qreal minY() const;
@@ -60,22 +73,30 @@ public:
   [[nodiscard]] qreal xTickInterval() const;
   [[nodiscard]] qreal yTickInterval() const;
   [[nodiscard]] const QString &yLabel() const;
+  [[nodiscard]] QString xLabel() const;
+  [[nodiscard]] bool hasReference() const;
 
 public slots:
-  void draw(QLineSeries *series);
+  void setPixelWidth(const int width);
+  void draw(Widgets::LineRenderer *renderer);
+  void drawReference(Widgets::LineRenderer *renderer);
 
 private slots:
   void updateData();
   void updateRange();
+  void updateReference();
   void calculateAutoScaleRange();
 
 private:
   int m_index;
+  int m_pixelWidth;
   qreal m_minX;
   qreal m_maxX;
   qreal m_minY;
   qreal m_maxY;
   QString m_yLabel;
   QVector<QPointF> m_data;
+  QVector<QPointF> m_rawData;
+  QVector<QPointF> m_referenceData;
 };
 } // namespace Widgets
@@ -20,19 +20,36 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+
+#include <QtMath>
 #include <QPainter>
+#include <QStaticText>
 #include <QClipboard>
 #include <QFontMetrics>
 #include <QApplication>
 
 #include "IO/Console.h"
 #include "IO/Manager.h"
+#include "SIMD/SIMD.h"
 #include "Misc/Translator.h"
 #include "Misc/TimerEvents.h"
 #include "Misc/CommonFonts.h"
 #include "Misc/ThemeManager.h"
+#include "Misc/PipelineStats.h"
+#include "Misc/ThreadScheduler.h"
 #include "UI/Widgets/Terminal.h"
 
+/**
+ * @brief Compares the line of a search match with the given @a line, used to
+ *        binary search the sorted list of matches.
+ */
+static bool matchPrecedesLine(const Widgets::TerminalSearch::Match &match,
+                              const qint64 line)
+{
+  return match.line < line;
+}
+
 /**
  * @brief Constructs a Terminal object with the given parent item.
  *
@@ -59,6 +76,7 @@
  *   visibility.
  * - Establishes a connection to redraw the terminal at a rate of 24 Hz for
  *   smooth updates.
+ * - Starts the worker thread that searches the scrollback.
  *
  * @note The cursor flash time is retrieved from
  * `QGuiApplication::styleHints()`, and the blink interval is adjusted
@@ -75,6 +93,17 @@ Widgets::Terminal::Terminal(QQuickItem *parent)
   , m_formatValue(0)
   , m_formatValueY(0)
   , m_useFormatValueY(false)
+  , m_damageFirst(-1)
+  , m_damageLast(-1)
+  , m_textCache(4096)
+  , m_memoryUsage(0)
+  , m_searchRegex(false)
+  , m_filterEnabled(false)
+  , m_searchCaseSensitive(false)
+  , m_lineOrigin(0)
+  , m_searchScanned(0)
+  , m_searchGeneration(0)
+  , m_currentMatch(-1)
 {
   // Initialize data buffer
   initBuffer();
@@ -118,22 +147,76 @@ Widgets::Terminal::Terminal(QQuickItem *parent)
   connect(&Misc::Translator::instance(), &Misc::Translator::languageChanged,
           this, [=] { setFont(Misc::CommonFonts::instance().monoFont()); });
 
-  // Blink the cursor
-  m_cursorTimer.start(200);
+  // Blink the cursor while the terminal is visible (except in low-power mode)
+  m_cursorTimer.setInterval(200);
   m_cursorTimer.setTimerType(Qt::PreciseTimer);
   connect(&m_cursorTimer, &QTimer::timeout, this,
           &Widgets::Terminal::toggleCursor);
-
-  // Redraw the widget only when necessary
+  connect(this, &Widgets::Terminal::visibleChanged, this,
+          &Widgets::Terminal::updateCursorTimer);
+  connect(&Misc::TimerEvents::instance(),
+          &Misc::TimerEvents::lowPowerModeChanged, this,
+          &Widgets::Terminal::updateCursorTimer);
+  updateCursorTimer();
+
+  // Repaint everything when the widget is resized
+  connect(this, &Widgets::Terminal::widthChanged, this,
+          [=] { m_stateChanged = true; });
+  connect(this, &Widgets::Terminal::heightChanged, this,
+          [=] { m_stateChanged = true; });
+
+  // Redraw the widget only when necessary, and only the damaged lines if the
+  // view itself did not change (e.g. new text on the last line)
   m_stateChanged = true;
   connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout24Hz, this,
           [=] {
-            if (isVisible() && m_stateChanged)
-            {
-              m_stateChanged = false;
+            if (!isVisible())
+              return;
+
+            if (m_stateChanged)
               update();
+
+            else if (m_damageFirst >= 0 || !m_cursorDamage.isNull())
+            {
+              const auto rect = damagedRect();
+              if (!rect.isEmpty())
+                update(rect);
             }
+
+            m_damageFirst = -1;
+            m_damageLast = -1;
+            m_cursorDamage = QRect();
+            m_stateChanged = false;
           });
+
+  // Report the memory used by the scrollback once per second
+  connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+          &Widgets::Terminal::reportMemoryUsage);
+
+  // Search the scrollback from its own thread
+  m_search.moveToThread(&m_searchThread);
+  connect(&m_search, &Widgets::TerminalSearch::matchesFound, this,
+          &Widgets::Terminal::onMatchesFound, Qt::QueuedConnection);
+
+  // Start the search thread
+  m_searchThread.setObjectName(QStringLiteral("Terminal Search"));
+  Misc::ThreadScheduler::instance().registerThread(
+      &m_searchThread, Misc::ThreadScheduler::Role::Exporter);
+  m_searchThread.start(QThread::LowPriority);
+}
+
+/**
+ * @brief Stops the search thread & removes the scrollback of the terminal from
+ *        the memory report.
+ */
+Widgets::Terminal::~Terminal()
+{
+  m_search.cancel(++m_searchGeneration);
+  m_searchThread.quit();
+  m_searchThread.wait();
+
+  Misc::PipelineStats::instance().addMemoryUsage(
+      Misc::PipelineStats::TerminalScrollback, -m_memoryUsage);
 }
 
 /**
@@ -148,9 +231,12 @@ Widgets::Terminal::Terminal(QQuickItem *parent)
  * - Skips rendering if the terminal is not visible.
  * - Prepares the painter by setting the current font and fills the terminal
  *   background.
- * - Draws each visible line of terminal data, using the current palette.
+ * - Highlights the search matches of the visible lines.
+ * - Draws each visible line of terminal data, using the current palette. Each
+ *   line segment is drawn from a cached @c QStaticText, and lines outside of
+ *   the region that needs to be repainted are skipped.
  * - Draws the cursor if it is currently visible and within the visible range of
- *   lines.
+ *   lines (the cursor is hidden while the search filter is active).
  * - Draws a vertical scrollbar if autoscroll is disabled and not all lines are
  *   visible.
  *
@@ -167,16 +253,23 @@ void Widgets::Terminal::paint(QPainter *painter)
   painter->setFont(m_font);
   int lineHeight = m_cHeight;
 
+  // Obtain the region that needs to be repainted
+  const bool clipped = painter->hasClipping();
+  const QRectF clipRect = clipped ? painter->clipBoundingRect() : QRectF();
+
   // Calculate the range of lines to be painted
   const int firstLine = m_scrollOffsetY;
   const int lastVLine = qMin(firstLine + linesPerPage(), lineCount() - 1);
 
+  // Highlight the search matches
+  drawMatches(painter, firstLine, lastVLine);
+
   // Draw selection rectangles
   int y = m_borderY;
   for (int i = firstLine; i <= lastVLine && y < height() - m_borderY; ++i)
   {
     // Obtain the line data
-    const QString &line = m_data[i];
+    const QString &line = viewLine(i);
 
     // Check if this line is within the selection range
     bool lineFullySelected = !m_selectionEnd.isNull()
@@ -275,12 +368,13 @@ void Widgets::Terminal::paint(QPainter *painter)
     }
   }
 
-  // Draw characters one by one with variable width handling
+  // Draw the text of each line segment
   y = m_borderY;
+  painter->setPen(m_palette.color(QPalette::Text));
   for (int i = firstLine; i <= lastVLine && y < height() - m_borderY; ++i)
   {
     // Obtain line data
-    const QString &line = m_data[i];
+    const QString &line = viewLine(i);
 
     // Skip empty lines, but draw line break
     if (line.isEmpty())
@@ -294,24 +388,14 @@ void Widgets::Terminal::paint(QPainter *painter)
     while (start < line.length())
     {
       const int end = qMin<int>(start + maxCharsPerLine(), line.length());
-      const QString segment = line.mid(start, end - start);
-      int x = m_borderX;
 
-      for (int j = 0; j < segment.length(); ++j)
+      // Only draw segments that intersect with the damaged region
+      const QRectF segmentRect(0, y, width(), lineHeight);
+      if (!clipped || clipRect.intersects(segmentRect))
       {
-        // Get character to render
-        const QString character = segment.mid(j, 1);
-
-        // Measure the character width dynamically
-        int charWidth = painter->fontMetrics().horizontalAdvance(character);
-
-        // Draw the character at the centered position within its cell
-        painter->setPen(m_palette.color(QPalette::Text));
-        painter->drawText(x, y, charWidth, m_cHeight, Qt::AlignCenter,
-                          character);
-
-        // Move to the next character position
-        x += charWidth;
+        const auto *text = cachedText(line.mid(start, end - start));
+        if (text)
+          painter->drawStaticText(m_borderX, y, *text);
       }
 
       y += lineHeight;
@@ -320,7 +404,7 @@ void Widgets::Terminal::paint(QPainter *painter)
   }
 
   // Draw cursor if visible
-  if (m_cursorVisible && m_cursorPosition.y() >= firstLine
+  if (m_cursorVisible && !filterActive() && m_cursorPosition.y() >= firstLine
       && m_cursorPosition.y() <= lastVLine)
   {
     // clang-format off
@@ -428,7 +512,7 @@ bool Widgets::Terminal::autoscroll() const
 bool Widgets::Terminal::copyAvailable() const
 {
   return (!m_selectionEnd.isNull() || !m_selectionStart.isNull())
-         && !m_data.isEmpty();
+         && lineCount() > 0;
 }
 
 /**
@@ -442,12 +526,99 @@ bool Widgets::Terminal::vt100emulation() const
 }
 
 /**
- * @brief Gets the total number of lines in the terminal's data buffer.
+ * @brief Checks if old scrollback lines are compressed in memory.
+ *
+ * @return True if scrollback compression is enabled, false otherwise.
+ */
+bool Widgets::Terminal::compressScrollback() const
+{
+  return m_data.compressionEnabled();
+}
+
+/**
+ * @brief Gets the text or regular expression searched in the scrollback.
+ *
+ * @return The search query, an empty string disables the search.
+ */
+QString Widgets::Terminal::searchText() const
+{
+  return m_searchText;
+}
+
+/**
+ * @brief Checks if the search query is a regular expression.
+ *
+ * @return True if the query is a regular expression, false if it is literal
+ *         text.
+ */
+bool Widgets::Terminal::searchRegex() const
+{
+  return m_searchRegex;
+}
+
+/**
+ * @brief Checks if only the lines that match the search query are displayed.
  *
- * @return The number of lines currently stored in the terminal's data buffer.
+ * @return True if the search filter is enabled, false otherwise.
+ */
+bool Widgets::Terminal::filterEnabled() const
+{
+  return m_filterEnabled;
+}
+
+/**
+ * @brief Checks if the search is case-sensitive.
+ *
+ * @return True if the search is case-sensitive, false otherwise.
+ */
+bool Widgets::Terminal::searchCaseSensitive() const
+{
+  return m_searchCaseSensitive;
+}
+
+/**
+ * @brief Gets the number of matches of the search query in the scrollback.
+ *
+ * @return The number of matches found so far.
+ */
+int Widgets::Terminal::matchCount() const
+{
+  return static_cast<int>(m_matches.size());
+}
+
+/**
+ * @brief Gets the match selected with @c findNext() or @c findPrevious().
+ *
+ * @return The one-based index of the selected match, or 0 if no match is
+ *         selected.
+ */
+int Widgets::Terminal::currentMatch() const
+{
+  return m_currentMatch + 1;
+}
+
+/**
+ * @brief Gets the maximum number of lines kept in the scrollback.
+ *
+ * @return The scrollback line cap, older lines are discarded.
+ */
+int Widgets::Terminal::maxLines() const
+{
+  return static_cast<int>(m_data.maxLines());
+}
+
+/**
+ * @brief Gets the number of lines displayed by the terminal.
+ *
+ * @return The number of lines currently stored in the terminal's data buffer,
+ *         or the number of lines that match the search query if the filter is
+ *         active.
  */
 int Widgets::Terminal::lineCount() const
 {
+  if (filterActive())
+    return static_cast<int>(m_filteredLines.size());
+
   return m_data.size();
 }
 
@@ -522,9 +693,9 @@ QPoint Widgets::Terminal::positionToCursor(const QPoint &pos) const
   int actualX = 0;
   int remainingY = y;
 
-  for (int i = 0; i < m_data.size() && i <= y; ++i)
+  for (int i = 0; i < lineCount() && i <= y; ++i)
   {
-    const QString &line = m_data[i];
+    const QString &line = viewLine(i);
 
     if (line.isEmpty())
     {
@@ -561,10 +732,10 @@ QPoint Widgets::Terminal::positionToCursor(const QPoint &pos) const
     }
   }
 
-  if (!m_data.isEmpty())
+  if (lineCount() > 0)
   {
-    actualY = m_data.size() - 1;
-    actualX = m_data.last().length();
+    actualY = lineCount() - 1;
+    actualX = viewLine(actualY).length();
   }
 
   return QPoint(qMax(0, actualX), qMax(0, actualY));
@@ -606,7 +777,7 @@ void Widgets::Terminal::copy()
   // Iterate over the lines within the selection range
   for (int lineIndex = start.y(); lineIndex <= end.y(); ++lineIndex)
   {
-    const QString &line = m_data[lineIndex];
+    const QString &line = viewLine(lineIndex);
 
     int startX = (lineIndex == start.y()) ? start.x() : 0;
     int endX = (lineIndex == end.y()) ? end.x() : line.size();
@@ -647,9 +818,23 @@ void Widgets::Terminal::clear()
   initBuffer();
   setCursorPosition(0, 0);
   setAutoscroll(true);
+  restartSearch();
   m_stateChanged = true;
 }
 
+/**
+ * @brief Selects the next search match & scrolls the view to it, wrapping
+ *        around to the first match after the last one.
+ */
+void Widgets::Terminal::findNext()
+{
+  if (m_matches.isEmpty())
+    return;
+
+  m_currentMatch = (m_currentMatch + 1) % m_matches.size();
+  scrollToMatch();
+}
+
 /**
  * @brief Selects all the text currently present in the terminal.
  *
@@ -660,15 +845,15 @@ void Widgets::Terminal::clear()
 void Widgets::Terminal::selectAll()
 {
   // Skip if there is no data to select
-  if (m_data.isEmpty())
+  if (lineCount() <= 0)
     return;
 
   // Set selection start at the beginning (top-left corner)
   m_selectionStart = QPoint(0, 0);
 
   // Set selection end at the last character of the last line
-  int lastLineIndex = m_data.size() - 1;
-  int lastCharIndex = m_data[lastLineIndex].size();
+  int lastLineIndex = lineCount() - 1;
+  int lastCharIndex = viewLine(lastLineIndex).size();
   m_selectionEnd = QPoint(lastCharIndex, lastLineIndex);
 
   // Since we're selecting everything, we do not need a "start cursor"
@@ -679,6 +864,23 @@ void Widgets::Terminal::selectAll()
   Q_EMIT selectionChanged();
 }
 
+/**
+ * @brief Selects the previous search match & scrolls the view to it, wrapping
+ *        around to the last match before the first one.
+ */
+void Widgets::Terminal::findPrevious()
+{
+  if (m_matches.isEmpty())
+    return;
+
+  if (m_currentMatch <= 0)
+    m_currentMatch = static_cast<int>(m_matches.size()) - 1;
+  else
+    --m_currentMatch;
+
+  scrollToMatch();
+}
+
 /**
  * @brief Sets the font used for rendering the terminal text.
  *
@@ -707,10 +909,30 @@ void Widgets::Terminal::setFont(const QFont &font)
   m_borderX = qMax(m_cWidth, m_cHeight) / 2;
   m_borderY = qMax(m_cWidth, m_cHeight) / 2;
 
+  // Discard text layouts made with the previous font
+  m_textCache.clear();
+  m_stateChanged = true;
+
   // Notify QML
   Q_EMIT fontChanged();
 }
 
+/**
+ * @brief Sets the maximum number of lines kept in the scrollback.
+ *
+ * @param lines The new line cap, lines are discarded in blocks once the
+ *              buffer grows past it.
+ */
+void Widgets::Terminal::setMaxLines(const int lines)
+{
+  if (maxLines() != lines)
+  {
+    m_data.setMaxLines(lines);
+    trimBuffer();
+    Q_EMIT maxLinesChanged();
+  }
+}
+
 /**
  * @brief Enables or disables autoscroll.
  *
@@ -774,6 +996,97 @@ void Widgets::Terminal::setVt100Emulation(const bool enabled)
   Q_EMIT vt100EmulationChanged();
 }
 
+/**
+ * @brief Enables or disables the compression of old scrollback lines.
+ *
+ * @param enabled If true, blocks of lines far from the end of the buffer are
+ *                kept compressed in memory & decompressed when displayed.
+ */
+void Widgets::Terminal::setCompressScrollback(const bool enabled)
+{
+  if (compressScrollback() != enabled)
+  {
+    m_data.setCompressionEnabled(enabled);
+    Q_EMIT compressScrollbackChanged();
+  }
+}
+
+/**
+ * @brief Changes the text or regular expression searched in the scrollback &
+ *        searches the whole scrollback again.
+ *
+ * @param text The new search query, an empty string disables the search.
+ */
+void Widgets::Terminal::setSearchText(const QString &text)
+{
+  if (m_searchText != text)
+  {
+    m_searchText = text;
+    restartSearch();
+    Q_EMIT searchChanged();
+  }
+}
+
+/**
+ * @brief Selects whether the search query is a regular expression or literal
+ *        text, and searches the whole scrollback again.
+ *
+ * @param enabled If true, the query is interpreted as a regular expression.
+ */
+void Widgets::Terminal::setSearchRegex(const bool enabled)
+{
+  if (m_searchRegex != enabled)
+  {
+    m_searchRegex = enabled;
+    restartSearch();
+    Q_EMIT searchChanged();
+  }
+}
+
+/**
+ * @brief Enables or disables the search filter.
+ *
+ * @param enabled If true, only the lines that match the search query are
+ *                displayed.
+ */
+void Widgets::Terminal::setFilterEnabled(const bool enabled)
+{
+  if (m_filterEnabled != enabled)
+  {
+    m_filterEnabled = enabled;
+    resetView();
+    Q_EMIT searchChanged();
+  }
+}
+
+/**
+ * @brief Selects whether the search is case-sensitive, and searches the whole
+ *        scrollback again.
+ *
+ * @param enabled If true, the search is case-sensitive.
+ */
+void Widgets::Terminal::setSearchCaseSensitive(const bool enabled)
+{
+  if (m_searchCaseSensitive != enabled)
+  {
+    m_searchCaseSensitive = enabled;
+    restartSearch();
+    Q_EMIT searchChanged();
+  }
+}
+
+/**
+ * @brief Updates the memory used by the scrollback of this terminal in the
+ *        memory report of the application.
+ */
+void Widgets::Terminal::reportMemoryUsage()
+{
+  const auto bytes = static_cast<qint64>(m_data.memoryUsage());
+  Misc::PipelineStats::instance().addMemoryUsage(
+      Misc::PipelineStats::TerminalScrollback, bytes - m_memoryUsage);
+  m_memoryUsage = bytes;
+}
+
 /**
  * @brief Toggles the visibility of the cursor.
  *
@@ -782,10 +1095,32 @@ void Widgets::Terminal::setVt100Emulation(const bool enabled)
  */
 void Widgets::Terminal::toggleCursor()
 {
-  m_stateChanged = true;
+  m_cursorDamage |= cursorRect(m_cursorPosition);
   m_cursorVisible = !m_cursorVisible;
 }
 
+/**
+ * @brief Starts or stops the cursor blinker.
+ *
+ * The cursor only blinks while the terminal is visible and the low-power mode
+ * is disabled, otherwise the timer is stopped & the cursor is shown without
+ * blinking, so that an idle terminal does not need to be repainted.
+ */
+void Widgets::Terminal::updateCursorTimer()
+{
+  const bool blink
+      = isVisible() && !Misc::TimerEvents::instance().lowPowerMode();
+  if (blink && !m_cursorTimer.isActive())
+    m_cursorTimer.start();
+
+  else if (!blink && m_cursorTimer.isActive())
+  {
+    m_cursorTimer.stop();
+    if (!m_cursorVisible)
+      toggleCursor();
+  }
+}
+
 /**
  * @brief Updates the terminal's color palette when the theme changes.
  *
@@ -806,6 +1141,7 @@ void Widgets::Terminal::onThemeChanged()
   m_palette.setColor(QPalette::Window, theme->getColor("console_border"));
   m_palette.setColor(QPalette::Highlight, theme->getColor("console_highlight"));
   setFillColor(m_palette.color(QPalette::Base));
+  m_textCache.clear();
   update();
   // clang-format on
 }
@@ -816,9 +1152,12 @@ void Widgets::Terminal::onThemeChanged()
  *
  * @param data The string of data to be appended to the terminal.
  *
- * This method processes each character in the provided data string,
- * interpreting escape sequences, formatting commands, and resetting font styles
- * based on the terminal's current state (Text, Escape, Format, ResetFont).
+ * While the terminal is in the `Text` state, runs of printable ASCII characters
+ * are located with a SIMD scan & copied to the accumulated text in bulk. Only
+ * the characters that end a run (control characters such as ESC, CR, LF or BS,
+ * and non-ASCII characters) and the characters of escape sequences are
+ * dispatched, one by one, to the handler of the current state through a
+ * lookup table (Text, Escape, Format, ResetFont).
  *
  * The processed text is accumulated and then appended to the terminal's buffer.
  *
@@ -827,33 +1166,55 @@ void Widgets::Terminal::onThemeChanged()
  */
 void Widgets::Terminal::append(const QString &data)
 {
+  // Keep the full UI refresh rate while new text is displayed
+  if (isVisible())
+    Misc::TimerEvents::instance().wake();
+
+  // State handlers, indexed by the State enum
+  using Handler = void (Terminal::*)(const QChar &, QString &);
+  static constexpr Handler kHandlers[] = {
+      &Terminal::processText,
+      &Terminal::processEscape,
+      &Terminal::processFormat,
+      &Terminal::processResetFont,
+  };
+
   QString text;
-  auto it = data.constBegin();
+  text.reserve(data.size());
+  const int scrollOffset = m_scrollOffsetY;
 
-  while (it != data.constEnd())
+  qsizetype i = 0;
+  const auto size = data.size();
+  const auto *chars = data.utf16();
+  while (i < size)
   {
-    auto byte = *it;
-    switch (m_state)
+    // Copy runs of printable characters in bulk
+    if (m_state == Text)
     {
-      case Text:
-        processText(byte, text);
-        break;
-      case Escape:
-        processEscape(byte, text);
-        break;
-      case Format:
-        processFormat(byte, text);
-        break;
-      case ResetFont:
-        processResetFont(byte, text);
-        break;
+      const auto *run = reinterpret_cast<const char16_t *>(chars + i);
+      const auto offset = SIMD::findFirstNonPrintable(run, size - i);
+      const auto length = offset < 0 ? size - i : offset;
+      if (length > 0)
+      {
+        text.append(QStringView(run, length));
+        i += length;
+        continue;
+      }
     }
 
-    ++it;
+    // Process control & escape sequence characters individually
+    (this->*kHandlers[m_state])(QChar(chars[i]), text);
+    ++i;
   }
 
   appendString(text);
-  m_stateChanged = true;
+  trimBuffer();
+  scanNewLines();
+
+  // Repaint everything if the view scrolled, otherwise only the lines that
+  // were modified are repainted
+  if (m_scrollOffsetY != scrollOffset)
+    m_stateChanged = true;
 }
 
 /**
@@ -862,10 +1223,17 @@ void Widgets::Terminal::append(const QString &data)
  *
  * @param string The QString to be appended to the terminal.
  *
- * This method processes each character in the given string by:
- * - Registering it in the terminal's internal buffer at the current cursor
- *   position.
- * - Moving the cursor to the right after each character is placed.
+ * This method writes the given string at the current cursor position in runs
+ * that fit in the remaining space of the current line:
+ * - When the cursor is at the end of the line (the common case when no VT-100
+ *   cursor movement is involved), each run is appended to the line in bulk.
+ * - Otherwise, the run overwrites the existing characters of the line, padding
+ *   the line with spaces if the cursor is beyond its end.
+ * - When a run reaches the end of a wrapped line, the cursor moves to the
+ *   beginning of the next line.
+ *
+ * The string is expected to contain only printable characters, which is
+ * guaranteed by `processText()`.
  *
  * If autoscroll is enabled, the vertical scroll offset (`scrollOffsetY`) is
  * adjusted to ensure that the cursor remains visible, and
@@ -875,26 +1243,55 @@ void Widgets::Terminal::append(const QString &data)
  */
 void Widgets::Terminal::appendString(const QString &string)
 {
-  // Register each character in the provided string
-  foreach (QChar character, string)
+  // Register the provided string, one line-sized run at a time
+  qsizetype pos = 0;
+  const int maxChars = maxCharsPerLine();
+  while (pos < string.size())
   {
     // Obtain the current (x, y) cursor position
     int cursorX = m_cursorPosition.x();
-    int cursorY = m_cursorPosition.y();
+    const int cursorY = m_cursorPosition.y();
+
+    // Cursor is past the end of a wrapped line, move to the next line
+    const qsizetype count = qMin<qsizetype>(string.size() - pos,
+                                            maxChars - cursorX);
+    if (count <= 0)
+    {
+      setCursorPosition(0, cursorY + 1);
+      continue;
+    }
 
-    // Replace data in the console buffer at the current cursor position
-    replaceData(cursorX, cursorY, character);
+    // Make sure the line at the cursor exists in the buffer
+    if (cursorY >= m_data.size())
+      m_data.resize(cursorY + 1);
 
-    // Increment the cursor position to the right after placing the character
-    setCursorPosition(cursorX + 1, cursorY);
+    // Append the run to the line, or overwrite the existing characters
+    markLinesDamaged(cursorY, cursorY);
+    QString &line = m_data.line(cursorY);
+    const auto run = QStringView(string).mid(pos, count);
+    if (cursorX == line.size())
+      line.append(run);
+    else
+    {
+      if (cursorX > line.size())
+        line = line.leftJustified(cursorX, ' ');
 
-    // If we've reached the end of a wrapped line, move to the next line
-    if (m_cursorPosition.x() >= maxCharsPerLine())
-      setCursorPosition(0, m_cursorPosition.y() + 1);
+      line.replace(cursorX, qMin(count, line.size() - cursorX),
+                   run.data(), run.size());
+    }
+
+    // Move the cursor to the right after placing the run
+    pos += count;
+    cursorX += static_cast<int>(count);
+    if (cursorX >= maxChars)
+      setCursorPosition(0, cursorY + 1);
+    else
+      setCursorPosition(cursorX, cursorY);
   }
 
-  // Adjust the scroll offset if autoscroll is enabled
-  if (autoscroll())
+  // Adjust the scroll offset if autoscroll is enabled, the filtered view is
+  // scrolled when new matching lines are found instead
+  if (autoscroll() && !filterActive())
   {
     // Calculate the total number of wrapped lines for the current line
     int cursorLine = m_cursorPosition.y();
@@ -978,11 +1375,70 @@ void Widgets::Terminal::removeStringFromCursor(const Direction direction,
   }
 }
 
+/**
+ * @brief Registers a batch of search results reported by the search thread.
+ *
+ * The results replace the matches previously found in the lines
+ * [@a first, @a first + @a count), which happens when the last line of the
+ * buffer is searched again once it is complete. Results of older queries are
+ * ignored.
+ *
+ * @param generation Generation of the search that produced the results.
+ * @param first      Absolute number of the first searched line.
+ * @param count      Number of searched lines.
+ * @param matches    Matches found in the searched lines, sorted by line.
+ */
+void Widgets::Terminal::onMatchesFound(
+    const quint64 generation, const qint64 first, const qint64 count,
+    const QVector<Widgets::TerminalSearch::Match> &matches)
+{
+  Q_UNUSED(count);
+
+  // Ignore results of older queries
+  if (generation != m_searchGeneration)
+    return;
+
+  // Nothing changed, avoid repainting the view
+  const auto match = std::lower_bound(m_matches.begin(), m_matches.end(),
+                                      first, matchPrecedesLine);
+  if (matches.isEmpty() && match == m_matches.end())
+    return;
+
+  // Remove the previous results of the searched lines
+  m_matches.erase(match, m_matches.end());
+  const auto line = std::lower_bound(m_filteredLines.begin(),
+                                     m_filteredLines.end(), first);
+  m_filteredLines.erase(line, m_filteredLines.end());
+  if (m_currentMatch >= m_matches.size())
+    m_currentMatch = -1;
+
+  // Register the matches of the lines that are still in the scrollback
+  for (const auto &m : matches)
+  {
+    if (m.line < m_lineOrigin)
+      continue;
+
+    m_matches.append(m);
+    if (m_filteredLines.isEmpty() || m_filteredLines.last() != m.line)
+      m_filteredLines.append(m.line);
+  }
+
+  // Scroll to the last matching line
+  if (filterActive() && autoscroll())
+  {
+    m_scrollOffsetY = qMax(0, lineCount() - linesPerPage());
+    Q_EMIT scrollOffsetYChanged();
+  }
+
+  // Update the user interface
+  m_stateChanged = true;
+  Q_EMIT searchResultsChanged();
+}
+
 /**
  * @brief Initializes the terminal's data buffer.
  *
- * Clears the existing data buffer and reserves memory for 1024 * 100 lines of
- * terminal content.
+ * Clears the existing data buffer and releases the memory used by its blocks.
  *
  * This function is typically used to reset the terminal state, ensuring
  * efficient memory management for upcoming operations.
@@ -990,8 +1446,365 @@ void Widgets::Terminal::removeStringFromCursor(const Direction direction,
 void Widgets::Terminal::initBuffer()
 {
   m_data.clear();
-  m_data.squeeze();
-  m_data.reserve(1024 * 100);
+  m_lineOrigin = 0;
+}
+
+/**
+ * @brief Discards the oldest lines of the scrollback that exceed the line
+ *        cap, and shifts the cursor, selection & scroll offset accordingly.
+ *
+ * The search results of the discarded lines are dropped as well.
+ */
+void Widgets::Terminal::trimBuffer()
+{
+  // Drop old blocks of lines
+  const int removed = static_cast<int>(m_data.trim());
+  if (removed <= 0)
+    return;
+
+  // Drop the search matches of the discarded lines
+  m_lineOrigin += removed;
+  const auto match = std::lower_bound(m_matches.begin(), m_matches.end(),
+                                      m_lineOrigin, matchPrecedesLine);
+  const auto droppedMatches = static_cast<int>(match - m_matches.begin());
+  if (droppedMatches > 0)
+  {
+    m_matches.erase(m_matches.begin(), match);
+    if (m_currentMatch < droppedMatches)
+      m_currentMatch = -1;
+    else
+      m_currentMatch -= droppedMatches;
+
+    Q_EMIT searchResultsChanged();
+  }
+
+  // Drop the filtered lines that were discarded
+  const auto line = std::lower_bound(m_filteredLines.begin(),
+                                     m_filteredLines.end(), m_lineOrigin);
+  const auto droppedLines = static_cast<int>(line - m_filteredLines.begin());
+  m_filteredLines.erase(m_filteredLines.begin(), line);
+
+  // Shift the cursor position
+  const auto y = qMax(0, m_cursorPosition.y() - removed);
+  setCursorPosition(m_cursorPosition.x(), y);
+
+  // Number of displayed lines that were discarded
+  const int shift = filterActive() ? droppedLines : removed;
+
+  // Shift the selection, or clear it if it was discarded
+  if (!m_selectionEnd.isNull() || !m_selectionStart.isNull())
+  {
+    if (m_selectionStart.y() < shift)
+    {
+      m_selectionEnd = QPoint();
+      m_selectionStart = QPoint();
+      m_selectionStartCursor = QPoint();
+    }
+
+    else
+    {
+      m_selectionEnd.ry() -= shift;
+      m_selectionStart.ry() -= shift;
+      m_selectionStartCursor.ry() -= shift;
+    }
+
+    Q_EMIT selectionChanged();
+  }
+
+  // Shift the scroll offset
+  m_scrollOffsetY = qMax(0, m_scrollOffsetY - shift);
+  Q_EMIT scrollOffsetYChanged();
+
+  // Every visible line moved
+  m_stateChanged = true;
+}
+
+/**
+ * @brief Clears the selection & scrolls to the end of the displayed lines,
+ *        used when the filter changes the lines that are displayed.
+ */
+void Widgets::Terminal::resetView()
+{
+  m_selectionEnd = QPoint();
+  m_selectionStart = QPoint();
+  m_selectionStartCursor = QPoint();
+  Q_EMIT selectionChanged();
+
+  setAutoscroll(true);
+  m_scrollOffsetY = qMax(0, lineCount() - linesPerPage());
+  Q_EMIT scrollOffsetYChanged();
+
+  m_stateChanged = true;
+}
+
+/**
+ * @brief Searches the lines that were completed since the previous scan.
+ *
+ * The last line of the buffer is still being received, so it is only searched
+ * once it is complete. Lines that were already searched are not searched
+ * again, even if they are modified by VT-100 escape sequences.
+ */
+void Widgets::Terminal::scanNewLines()
+{
+  if (m_searchText.isEmpty())
+    return;
+
+  const auto first = qMax<qint64>(0, m_searchScanned - m_lineOrigin);
+  const auto last = m_data.size() - 1;
+  if (last > first)
+  {
+    scan(first, last);
+    m_searchScanned = m_lineOrigin + last;
+  }
+}
+
+/**
+ * @brief Discards the current search results & searches the whole scrollback
+ *        with the current query.
+ *
+ * Scans of the previous query that are still running are aborted, and their
+ * results are ignored.
+ */
+void Widgets::Terminal::restartSearch()
+{
+  // Discard the results of the previous query
+  m_search.cancel(++m_searchGeneration);
+  m_matches.clear();
+  m_filteredLines.clear();
+  m_currentMatch = -1;
+  m_searchScanned = m_lineOrigin;
+  m_stateChanged = true;
+  Q_EMIT searchResultsChanged();
+
+  // The displayed lines changed
+  if (m_filterEnabled)
+    resetView();
+
+  // Search the whole scrollback, the last line is searched again once it is
+  // complete
+  if (!m_searchText.isEmpty() && !m_data.isEmpty())
+  {
+    scan(0, m_data.size());
+    m_searchScanned = m_lineOrigin + m_data.size() - 1;
+  }
+}
+
+/**
+ * @brief Scrolls the view so that the selected search match is displayed.
+ */
+void Widgets::Terminal::scrollToMatch()
+{
+  // Obtain the displayed line of the match
+  const auto &match = m_matches[m_currentMatch];
+  auto line = match.line - m_lineOrigin;
+  if (filterActive())
+  {
+    const auto it = std::lower_bound(m_filteredLines.cbegin(),
+                                     m_filteredLines.cend(), match.line);
+    line = it - m_filteredLines.cbegin();
+  }
+
+  // Place the line in the middle of the view
+  setAutoscroll(false);
+  const auto offset = qMax<qint64>(0, line - linesPerPage() / 2);
+  setScrollOffsetY(static_cast<int>(offset));
+
+  m_stateChanged = true;
+  Q_EMIT searchResultsChanged();
+}
+
+/**
+ * @brief Hands the buffer lines [@a first, @a last) to the search thread.
+ */
+void Widgets::Terminal::scan(const qsizetype first, const qsizetype last)
+{
+  TerminalSearch::Query query;
+  query.pattern = m_searchText;
+  query.regex = m_searchRegex;
+  query.caseSensitive = m_searchCaseSensitive;
+
+  const auto origin = m_lineOrigin;
+  const auto generation = m_searchGeneration;
+  const auto chunks = m_data.snapshot(first, last);
+  QMetaObject::invokeMethod(
+      &m_search,
+      [=] { m_search.scan(generation, query, origin, chunks); },
+      Qt::QueuedConnection);
+}
+
+/**
+ * @brief Highlights the search matches of the displayed lines
+ *        [@a firstLine, @a lastLine], the selected match is drawn with the
+ *        highlight color & the other matches with a translucent version of it.
+ */
+void Widgets::Terminal::drawMatches(QPainter *painter, const int firstLine,
+                                    const int lastLine)
+{
+  // Skip if there is nothing to highlight
+  if (m_matches.isEmpty() || firstLine > lastLine)
+    return;
+
+  // Obtain the highlight colors
+  const auto current = m_palette.color(QPalette::Highlight);
+  auto other = current;
+  other.setAlphaF(0.4);
+
+  // Find the first match of the displayed lines
+  const int maxChars = maxCharsPerLine();
+  auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(),
+                             absoluteLine(firstLine), matchPrecedesLine);
+
+  // Draw the matches of each line, splitting them across wrapped rows
+  int y = m_borderY;
+  for (int i = firstLine; i <= lastLine && y < height() - m_borderY; ++i)
+  {
+    const auto number = absoluteLine(i);
+    const int length = viewLine(i).length();
+    for (; it != m_matches.cend() && it->line == number; ++it)
+    {
+      const bool selected = (it - m_matches.cbegin()) == m_currentMatch;
+      const auto &color = selected ? current : other;
+
+      int column = it->column;
+      const int end = qMin(it->column + it->length, length);
+      while (column < end)
+      {
+        const int row = column / maxChars;
+        const int rowEnd = qMin(end, (row + 1) * maxChars);
+        const QRect rect(m_borderX + (column - row * maxChars) * m_cWidth,
+                         y + row * m_cHeight, (rowEnd - column) * m_cWidth,
+                         m_cHeight);
+        painter->fillRect(rect, color);
+        column = rowEnd;
+      }
+    }
+
+    y += qMax(1, (length + maxChars - 1) / maxChars) * m_cHeight;
+  }
+}
+
+/**
+ * @brief Checks if only the lines that match the search query are displayed.
+ */
+bool Widgets::Terminal::filterActive() const
+{
+  return m_filterEnabled && !m_searchText.isEmpty();
+}
+
+/**
+ * @brief Returns the absolute number of the displayed line at @a index,
+ *        lines discarded from the scrollback are still counted.
+ */
+qint64 Widgets::Terminal::absoluteLine(const int index) const
+{
+  if (filterActive())
+    return m_filteredLines[index];
+
+  return m_lineOrigin + index;
+}
+
+/**
+ * @brief Returns the text of the displayed line at @a index.
+ */
+const QString &Widgets::Terminal::viewLine(const int index) const
+{
+  return m_data[absoluteLine(index) - m_lineOrigin];
+}
+
+/**
+ * @brief Registers the range of buffer lines [@a first, @a last] that must be
+ *        repainted during the next refresh.
+ */
+void Widgets::Terminal::markLinesDamaged(const int first, const int last)
+{
+  // Buffer lines do not match the displayed lines while filtering, the view
+  // is repainted when new matching lines are found instead
+  if (filterActive())
+    return;
+
+  if (m_damageFirst < 0)
+  {
+    m_damageFirst = first;
+    m_damageLast = last;
+  }
+
+  else
+  {
+    m_damageFirst = qMin(m_damageFirst, first);
+    m_damageLast = qMax(m_damageLast, last);
+  }
+}
+
+/**
+ * @brief Returns the area covered by the cursor when placed at the given
+ *        @a position, including the descent of the block glyph.
+ */
+QRect Widgets::Terminal::cursorRect(const QPoint &position) const
+{
+  const int x = position.x() * m_cWidth + m_borderX;
+  const int y = (position.y() - m_scrollOffsetY) * m_cHeight + m_borderY;
+  return QRect(x, y, m_cWidth * 2, m_cHeight * 2);
+}
+
+/**
+ * @brief Calculates the area of the widget that contains the damaged lines &
+ *        cursor positions registered since the last refresh.
+ *
+ * Wrapped lines are taken into account by walking the visible lines in the
+ * same way as @c paint(), which only requires integer arithmetic.
+ */
+QRect Widgets::Terminal::damagedRect() const
+{
+  QRect rect = m_cursorDamage;
+  if (m_damageFirst < 0)
+    return rect;
+
+  // Find the vertical span of the damaged lines
+  int y = m_borderY;
+  int top = -1;
+  int bottom = -1;
+  const int maxChars = maxCharsPerLine();
+  const int lastLine = qMin(m_damageLast, lineCount() - 1);
+  for (int i = m_scrollOffsetY; i <= lastLine && y < height(); ++i)
+  {
+    const int length = viewLine(i).length();
+    const int rows = qMax(1, (length + maxChars - 1) / maxChars);
+    if (i >= m_damageFirst && top < 0)
+      top = y;
+
+    y += rows * m_cHeight;
+    if (i >= m_damageFirst)
+      bottom = y;
+  }
+
+  // Add the damaged lines to the cursor area
+  if (top >= 0)
+    rect |= QRect(0, top, qCeil(width()), bottom - top);
+
+  return rect;
+}
+
+/**
+ * @brief Returns a prepared @c QStaticText for the given @a text.
+ *
+ * Layouts are cached by their content, so that repainting lines that did not
+ * change does not require shaping their text again. The cache is invalidated
+ * when the font or the theme changes.
+ */
+const QStaticText *Widgets::Terminal::cachedText(const QString &text)
+{
+  auto *staticText = m_textCache.object(text);
+  if (!staticText)
+  {
+    staticText = new QStaticText(text);
+    staticText->setTextFormat(Qt::PlainText);
+    staticText->setPerformanceHint(QStaticText::AggressiveCaching);
+    staticText->prepare(QTransform(), m_font);
+    if (!m_textCache.insert(text, staticText))
+      return nullptr;
+  }
+
+  return staticText;
 }
 
 /**
@@ -1029,7 +1842,7 @@ void Widgets::Terminal::processText(const QChar &byte, QString &text)
   {
     appendString(text);
     text.clear();
-    m_data.append("");
+    m_data.append(QString());
     setCursorPosition(0, m_cursorPosition.y() + 1);
   }
 
@@ -1260,6 +2073,8 @@ void Widgets::Terminal::setCursorPosition(const QPoint position)
 {
   if (m_cursorPosition != position)
   {
+    m_cursorDamage |= cursorRect(m_cursorPosition);
+    m_cursorDamage |= cursorRect(position);
     m_cursorPosition = position;
     Q_EMIT cursorMoved();
   }
@@ -1304,16 +2119,17 @@ void Widgets::Terminal::setCursorPosition(const int x, const int y)
  *
  * @note Non-printable characters are replaced with a dot (`'.'`).
  *
- * @see lineCount(), m_data
+ * @see m_data
  */
 void Widgets::Terminal::replaceData(qsizetype x, qsizetype y, QChar byte)
 {
   // Make sure the line at y exists in the buffer
-  if (y >= lineCount())
+  if (y >= m_data.size())
     m_data.resize(y + 1);
 
   // Get reference to current line
-  QString &currentLine = m_data[y];
+  markLinesDamaged(static_cast<int>(y), static_cast<int>(y));
+  QString &currentLine = m_data.line(y);
 
   // Ensure the current line is long enough to hold the character at x
   if (x > currentLine.size())
@@ -1548,9 +2364,9 @@ void Widgets::Terminal::mouseReleaseEvent(QMouseEvent *event)
 void Widgets::Terminal::mouseDoubleClickEvent(QMouseEvent *event)
 {
   auto cursorPos = positionToCursor(event->pos());
-  if (cursorPos.y() >= 0 && cursorPos.y() < m_data.size())
+  if (cursorPos.y() >= 0 && cursorPos.y() < lineCount())
   {
-    const QString &line = m_data[cursorPos.y()];
+    const QString &line = viewLine(cursorPos.y());
 
     // Find word boundaries by expanding to the left and right
     int wordStartX = cursorPos.x();
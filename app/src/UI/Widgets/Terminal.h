@@ -22,10 +22,16 @@
 
 #pragma once
 
+#include <QCache>
 #include <QTimer>
+#include <QThread>
 #include <QPalette>
+#include <QStaticText>
 #include <QQuickPaintedItem>
 
+#include "UI/Widgets/TerminalBuffer.h"
+#include "UI/Widgets/TerminalSearch.h"
+
 namespace Widgets
 {
 /**
@@ -40,6 +46,12 @@ namespace Widgets
  *
  * This class is suitable for embedding a terminal interface in QML-based GUI
  * applications, with multiple customizable features exposed as properties.
+ *
+ * The scrollback can be searched with a literal or regular expression query.
+ * Searches run in a @c Widgets::TerminalSearch worker thread, matches are
+ * highlighted and, when the filter is enabled, only the lines that match the
+ * query are displayed. New lines are searched as they are completed, so the
+ * filter stays live without rescanning the whole scrollback.
  */
 class Terminal : public QQuickPaintedItem
 {
@@ -74,20 +86,55 @@ class Terminal : public QQuickPaintedItem
              READ scrollOffsetY
              WRITE setScrollOffsetY
              NOTIFY scrollOffsetYChanged)
+  Q_PROPERTY(int maxLines
+             READ maxLines
+             WRITE setMaxLines
+             NOTIFY maxLinesChanged)
+  Q_PROPERTY(bool compressScrollback
+             READ compressScrollback
+             WRITE setCompressScrollback
+             NOTIFY compressScrollbackChanged)
+  Q_PROPERTY(QString searchText
+             READ searchText
+             WRITE setSearchText
+             NOTIFY searchChanged)
+  Q_PROPERTY(bool searchRegex
+             READ searchRegex
+             WRITE setSearchRegex
+             NOTIFY searchChanged)
+  Q_PROPERTY(bool searchCaseSensitive
+             READ searchCaseSensitive
+             WRITE setSearchCaseSensitive
+             NOTIFY searchChanged)
+  Q_PROPERTY(bool filterEnabled
+             READ filterEnabled
+             WRITE setFilterEnabled
+             NOTIFY searchChanged)
+  Q_PROPERTY(int matchCount
+             READ matchCount
+             NOTIFY searchResultsChanged)
+  Q_PROPERTY(int currentMatch
+             READ currentMatch
+             NOTIFY searchResultsChanged)
   // clang-format on
 
 signals:
   void fontChanged();
   void cursorMoved();
+  void searchChanged();
+  void maxLinesChanged();
   void selectionChanged();
   void autoscrollChanged();
   void colorPaletteChanged();
   void copyAvailableChanged();
   void scrollOffsetYChanged();
   void vt100EmulationChanged();
+  void compressScrollbackChanged();
+  void searchResultsChanged();
 
 public:
   Terminal(QQuickItem *parent = 0);
+  ~Terminal();
   void paint(QPainter *painter) override;
 
   enum Direction
@@ -115,7 +162,16 @@ public:
   [[nodiscard]] bool autoscroll() const;
   [[nodiscard]] bool copyAvailable() const;
   [[nodiscard]] bool vt100emulation() const;
+  [[nodiscard]] bool compressScrollback() const;
+
+  [[nodiscard]] QString searchText() const;
+  [[nodiscard]] bool searchRegex() const;
+  [[nodiscard]] bool filterEnabled() const;
+  [[nodiscard]] bool searchCaseSensitive() const;
+  [[nodiscard]] int matchCount() const;
+  [[nodiscard]] int currentMatch() const;
 
+  [[nodiscard]] int maxLines() const;
   [[nodiscard]] int lineCount() const;
   [[nodiscard]] int linesPerPage() const;
   [[nodiscard]] int scrollOffsetY() const;
@@ -127,28 +183,58 @@ public:
 public slots:
   void copy();
   void clear();
+  void findNext();
   void selectAll();
+  void findPrevious();
   void setFont(const QFont &font);
+  void setMaxLines(const int lines);
   void setAutoscroll(const bool enabled);
   void setScrollOffsetY(const int offset);
   void setPalette(const QPalette &palette);
   void setVt100Emulation(const bool enabled);
+  void setCompressScrollback(const bool enabled);
+  void setSearchText(const QString &text);
+  void setSearchRegex(const bool enabled);
+  void setFilterEnabled(const bool enabled);
+  void setSearchCaseSensitive(const bool enabled);
 
 private slots:
   void toggleCursor();
   void onThemeChanged();
+  void updateCursorTimer();
+  void reportMemoryUsage();
   void append(const QString &data);
   void appendString(const QString &string);
+  void onMatchesFound(const quint64 generation, const qint64 first,
+                      const qint64 count,
+                      const QVector<Widgets::TerminalSearch::Match> &matches);
   void removeStringFromCursor(const Direction direction = RightDirection,
                               int len = INT_MAX);
 
 private:
   void initBuffer();
+  void trimBuffer();
   void processText(const QChar &byte, QString &text);
   void processEscape(const QChar &byte, QString &text);
   void processFormat(const QChar &byte, QString &text);
   void processResetFont(const QChar &byte, QString &text);
 
+  void resetView();
+  void scanNewLines();
+  void restartSearch();
+  void scrollToMatch();
+  void scan(const qsizetype first, const qsizetype last);
+  void drawMatches(QPainter *painter, const int firstLine, const int lastLine);
+
+  [[nodiscard]] bool filterActive() const;
+  [[nodiscard]] qint64 absoluteLine(const int index) const;
+  [[nodiscard]] const QString &viewLine(const int index) const;
+
+  void markLinesDamaged(const int first, const int last);
+  [[nodiscard]] QRect cursorRect(const QPoint &position) const;
+  [[nodiscard]] QRect damagedRect() const;
+  [[nodiscard]] const QStaticText *cachedText(const QString &text);
+
   void setCursorPosition(const QPoint position);
   void setCursorPosition(const int x, const int y);
   void replaceData(qsizetype x, qsizetype y, QChar byte);
@@ -163,7 +249,7 @@ protected:
 
 private:
   QPalette m_palette;
-  QStringList m_data;
+  TerminalBuffer m_data;
 
   QFont m_font;
   int m_cWidth;
@@ -191,5 +277,27 @@ private:
   bool m_useFormatValueY;
 
   bool m_stateChanged;
+  int m_damageFirst;
+  int m_damageLast;
+  QRect m_cursorDamage;
+  QCache<QString, QStaticText> m_textCache;
+
+  qint64 m_memoryUsage;
+
+  QString m_searchText;
+  bool m_searchRegex;
+  bool m_filterEnabled;
+  bool m_searchCaseSensitive;
+
+  qint64 m_lineOrigin;
+  qint64 m_searchScanned;
+  quint64 m_searchGeneration;
+
+  int m_currentMatch;
+  QVector<qint64> m_filteredLines;
+  QVector<TerminalSearch::Match> m_matches;
+
+  TerminalSearch m_search;
+  QThread m_searchThread;
 };
 } // namespace Widgets
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "UI/Widgets/TerminalBuffer.h"
+
+// Number of lines stored in each block of the scrollback buffer
+static constexpr qsizetype kLinesPerBlock = 1024;
+
+// Number of blocks at the end of the buffer that are never compressed
+static constexpr size_t kUncompressedBlocks = 4;
+
+/**
+ * @brief Constructs an empty buffer with a cap of 100 000 lines.
+ */
+Widgets::TerminalBuffer::TerminalBuffer()
+  : m_size(0)
+  , m_maxLines(100000)
+  , m_compressionEnabled(false)
+{
+}
+
+/**
+ * @brief Returns @c true if the buffer contains no lines.
+ */
+bool Widgets::TerminalBuffer::isEmpty() const
+{
+  return m_size == 0;
+}
+
+/**
+ * @brief Returns the number of lines stored in the buffer.
+ */
+qsizetype Widgets::TerminalBuffer::size() const
+{
+  return m_size;
+}
+
+/**
+ * @brief Returns the maximum number of lines kept in the scrollback.
+ */
+qsizetype Widgets::TerminalBuffer::maxLines() const
+{
+  return m_maxLines;
+}
+
+/**
+ * @brief Returns the number of bytes used by the lines of the buffer, taking
+ *        the size of compressed blocks into account.
+ */
+qsizetype Widgets::TerminalBuffer::memoryUsage() const
+{
+  qsizetype bytes = 0;
+  for (const auto &block : m_blocks)
+  {
+    bytes += sizeof(Block) + block.compressed.capacity();
+    for (const auto &line : block.lines)
+      bytes += sizeof(QString) + line.capacity() * sizeof(QChar);
+  }
+
+  return bytes;
+}
+
+/**
+ * @brief Returns @c true if old blocks of lines are compressed in memory.
+ */
+bool Widgets::TerminalBuffer::compressionEnabled() const
+{
+  return m_compressionEnabled;
+}
+
+/**
+ * @brief Returns the last line of the buffer, the buffer must not be empty.
+ */
+const QString &Widgets::TerminalBuffer::last() const
+{
+  return at(m_size - 1);
+}
+
+/**
+ * @brief Returns the line at the given @a index.
+ *
+ * If the line is stored in a compressed block, the block is decompressed
+ * before returning the line.
+ */
+const QString &Widgets::TerminalBuffer::at(const qsizetype index) const
+{
+  Q_ASSERT(index >= 0 && index < m_size);
+  return blockAt(index).lines.at(index % kLinesPerBlock);
+}
+
+/**
+ * @brief Returns the line at the given @a index.
+ */
+const QString &Widgets::TerminalBuffer::operator[](const qsizetype index) const
+{
+  return at(index);
+}
+
+/**
+ * @brief Returns a modifiable reference to the line at the given @a index.
+ *
+ * The reference remains valid until a line is appended or the buffer is
+ * trimmed, since both operations may compress or drop blocks.
+ */
+QString &Widgets::TerminalBuffer::line(const qsizetype index)
+{
+  Q_ASSERT(index >= 0 && index < m_size);
+  return blockAt(index).lines[index % kLinesPerBlock];
+}
+
+/**
+ * @brief Returns the lines of the given @a chunk, decompressing them if
+ *        required.
+ */
+QStringList Widgets::TerminalBuffer::lines(const Chunk &chunk)
+{
+  if (chunk.compressed.isEmpty())
+    return chunk.lines;
+
+  const auto text = QString::fromUtf8(qUncompress(chunk.compressed));
+  return text.split('\n').mid(chunk.offset, chunk.count);
+}
+
+/**
+ * @brief Copies the lines in the range [@a first, @a last), one chunk per
+ *        block.
+ *
+ * Lines of uncompressed blocks are implicitly shared with the buffer, and
+ * compressed blocks are copied without decompressing them, so that taking a
+ * snapshot of a large scrollback is cheap.
+ */
+QVector<Widgets::TerminalBuffer::Chunk>
+Widgets::TerminalBuffer::snapshot(const qsizetype first,
+                                  const qsizetype last) const
+{
+  QVector<Chunk> chunks;
+  const auto end = qMin(last, m_size);
+  for (auto i = qMax<qsizetype>(0, first); i < end;)
+  {
+    // Obtain the range of lines of the block
+    const auto offset = i % kLinesPerBlock;
+    const auto &block = m_blocks[static_cast<size_t>(i / kLinesPerBlock)];
+    const auto count = qMin(block.count - offset, end - i);
+
+    // Copy the lines of the block
+    Chunk chunk;
+    chunk.first = i;
+    chunk.count = count;
+    chunk.offset = offset;
+    if (block.isCompressed)
+      chunk.compressed = block.compressed;
+    else if (offset == 0 && count == block.count)
+      chunk.lines = block.lines;
+    else
+      chunk.lines = block.lines.mid(offset, count);
+
+    chunks.append(chunk);
+    i += count;
+  }
+
+  return chunks;
+}
+
+/**
+ * @brief Removes all lines from the buffer & releases its memory.
+ */
+void Widgets::TerminalBuffer::clear()
+{
+  m_size = 0;
+  m_blocks.clear();
+}
+
+/**
+ * @brief Drops the oldest blocks of lines that exceed the line cap.
+ *
+ * Lines are removed a whole block at a time, so the buffer may hold up to
+ * one block of lines more than the configured cap.
+ *
+ * @return The number of lines removed from the beginning of the buffer.
+ */
+qsizetype Widgets::TerminalBuffer::trim()
+{
+  qsizetype removed = 0;
+  while (m_blocks.size() > 1 && m_size - kLinesPerBlock >= m_maxLines)
+  {
+    m_blocks.pop_front();
+    m_size -= kLinesPerBlock;
+    removed += kLinesPerBlock;
+  }
+
+  return removed;
+}
+
+/**
+ * @brief Appends empty lines until the buffer contains @a size lines.
+ *
+ * The buffer never shrinks, use @c clear() or @c trim() to remove lines.
+ */
+void Widgets::TerminalBuffer::resize(const qsizetype size)
+{
+  while (m_size < size)
+    append(QString());
+}
+
+/**
+ * @brief Appends the given @a line to the end of the buffer.
+ */
+void Widgets::TerminalBuffer::append(const QString &line)
+{
+  // Start a new block if the last one is full
+  if (m_blocks.empty() || m_blocks.back().count >= kLinesPerBlock)
+  {
+    m_blocks.emplace_back();
+    m_blocks.back().lines.reserve(kLinesPerBlock);
+    compressOldBlocks();
+  }
+
+  // Register the line
+  auto &block = m_blocks.back();
+  block.lines.append(line);
+  block.count++;
+  m_size++;
+}
+
+/**
+ * @brief Sets the maximum number of @a lines kept in the scrollback.
+ */
+void Widgets::TerminalBuffer::setMaxLines(const qsizetype lines)
+{
+  m_maxLines = qMax<qsizetype>(kLinesPerBlock, lines);
+}
+
+/**
+ * @brief Enables or disables the compression of old blocks of lines.
+ */
+void Widgets::TerminalBuffer::setCompressionEnabled(const bool enabled)
+{
+  m_compressionEnabled = enabled;
+  if (enabled)
+    compressOldBlocks();
+
+  else
+  {
+    for (auto &block : m_blocks)
+      decompress(block);
+  }
+}
+
+/**
+ * @brief Compresses every full block that is not close to the end of the
+ *        buffer, including blocks that were decompressed to be displayed.
+ */
+void Widgets::TerminalBuffer::compressOldBlocks()
+{
+  if (!m_compressionEnabled || m_blocks.size() <= kUncompressedBlocks)
+    return;
+
+  const auto end = m_blocks.size() - kUncompressedBlocks;
+  for (size_t i = 0; i < end; ++i)
+    compress(m_blocks[i]);
+}
+
+/**
+ * @brief Replaces the lines of the given @a block with a compressed copy.
+ */
+void Widgets::TerminalBuffer::compress(Block &block)
+{
+  if (block.isCompressed)
+    return;
+
+  block.compressed = qCompress(block.lines.join('\n').toUtf8());
+  block.lines = QStringList();
+  block.isCompressed = true;
+}
+
+/**
+ * @brief Restores the lines of the given compressed @a block.
+ */
+void Widgets::TerminalBuffer::decompress(Block &block)
+{
+  if (!block.isCompressed)
+    return;
+
+  block.lines = QString::fromUtf8(qUncompress(block.compressed)).split('\n');
+  block.compressed.clear();
+  block.isCompressed = false;
+  Q_ASSERT(block.lines.size() == block.count);
+}
+
+/**
+ * @brief Returns the (decompressed) block that contains the line at the
+ *        given @a index.
+ */
+Widgets::TerminalBuffer::Block &
+Widgets::TerminalBuffer::blockAt(const qsizetype index) const
+{
+  auto &block = m_blocks[static_cast<size_t>(index / kLinesPerBlock)];
+  decompress(block);
+  return block;
+}
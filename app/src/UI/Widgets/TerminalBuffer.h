@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+namespace Widgets
+{
+/**
+ * @class Widgets::TerminalBuffer
+ * @brief Chunked scrollback storage for the terminal widget.
+ *
+ * Lines are stored in fixed-size blocks, so that appending lines never moves
+ * the existing scrollback in memory & old lines can be dropped a whole block
+ * at a time once the configured line cap is exceeded.
+ *
+ * Blocks that are far away from the end of the buffer can optionally be
+ * compressed. A compressed block is transparently decompressed when one of its
+ * lines is accessed (e.g. when the user scrolls back), and compressed again
+ * once new blocks are added to the buffer.
+ *
+ * A range of lines can be copied with @c snapshot() & handed to a worker
+ * thread (e.g. to search the scrollback). The copy shares the memory of the
+ * blocks, and compressed blocks are only decompressed by the thread that reads
+ * the snapshot.
+ */
+class TerminalBuffer
+{
+public:
+  TerminalBuffer();
+
+  /**
+   * @brief Lines of one block of the buffer, shared with other threads.
+   *
+   * The lines are either stored in @c lines, or in the @c compressed data of
+   * the whole block, in which case the first @c offset lines of the block are
+   * not part of the chunk.
+   */
+  struct Chunk
+  {
+    qsizetype first = 0;
+    qsizetype count = 0;
+    qsizetype offset = 0;
+    QStringList lines;
+    QByteArray compressed;
+  };
+
+  [[nodiscard]] static QStringList lines(const Chunk &chunk);
+  [[nodiscard]] QVector<Chunk> snapshot(const qsizetype first,
+                                        const qsizetype last) const;
+
+  [[nodiscard]] bool isEmpty() const;
+  [[nodiscard]] qsizetype size() const;
+  [[nodiscard]] qsizetype maxLines() const;
+  [[nodiscard]] qsizetype memoryUsage() const;
+  [[nodiscard]] bool compressionEnabled() const;
+
+  [[nodiscard]] const QString &last() const;
+  [[nodiscard]] const QString &at(const qsizetype index) const;
+  [[nodiscard]] const QString &operator[](const qsizetype index) const;
+
+  [[nodiscard]] QString &line(const qsizetype index);
+
+  void clear();
+  qsizetype trim();
+  void resize(const qsizetype size);
+  void append(const QString &line);
+  void setMaxLines(const qsizetype lines);
+  void setCompressionEnabled(const bool enabled);
+
+private:
+  struct Block
+  {
+    QStringList lines;
+    QByteArray compressed;
+    qsizetype count = 0;
+    bool isCompressed = false;
+  };
+
+  void compressOldBlocks();
+  static void compress(Block &block);
+  static void decompress(Block &block);
+  Block &blockAt(const qsizetype index) const;
+
+private:
+  qsizetype m_size;
+  qsizetype m_maxLines;
+  bool m_compressionEnabled;
+  mutable std::deque<Block> m_blocks;
+};
+} // namespace Widgets
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SIMD/SIMD.h"
+#include "UI/Widgets/TerminalSearch.h"
+
+/**
+ * Constructor function
+ */
+Widgets::TerminalSearch::TerminalSearch(QObject *parent)
+  : QObject(parent)
+  , m_generation(0)
+{
+}
+
+/**
+ * @brief Aborts the scans that belong to generations older than the given
+ *        @a generation, may be called from any thread.
+ */
+void Widgets::TerminalSearch::cancel(const quint64 generation)
+{
+  m_generation.store(generation, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Finds the matches of the given @a query in a scrollback snapshot.
+ *
+ * One batch of results is reported for each chunk of the snapshot, the scan
+ * stops between two chunks if a newer generation was requested.
+ *
+ * @param generation Generation of the search, reported with each batch.
+ * @param query      Search parameters.
+ * @param origin     Absolute line number of the first line of the buffer.
+ * @param chunks     Lines to scan, obtained with @c TerminalBuffer::snapshot().
+ */
+void Widgets::TerminalSearch::scan(
+    const quint64 generation, const Query &query, const qint64 origin,
+    const QVector<Widgets::TerminalBuffer::Chunk> &chunks)
+{
+  setQuery(query);
+  for (const auto &chunk : chunks)
+  {
+    // Stop if the scan was superseded
+    if (generation != m_generation.load(std::memory_order_relaxed))
+      return;
+
+    // Find the matches of each line of the chunk
+    QVector<Match> matches;
+    const auto first = origin + chunk.first;
+    const auto lines = TerminalBuffer::lines(chunk);
+    for (qsizetype i = 0; i < lines.count(); ++i)
+      findMatches(lines[i], first + i, matches);
+
+    Q_EMIT matchesFound(generation, first, lines.count(), matches);
+  }
+}
+
+/**
+ * @brief Updates the search parameters, compiling the regular expression only
+ *        when the query changes.
+ */
+void Widgets::TerminalSearch::setQuery(const Query &query)
+{
+  if (query.pattern == m_query.pattern && query.regex == m_query.regex
+      && query.caseSensitive == m_query.caseSensitive)
+    return;
+
+  m_query = query;
+  if (m_query.regex)
+  {
+    auto options = QRegularExpression::NoPatternOption;
+    if (!m_query.caseSensitive)
+      options |= QRegularExpression::CaseInsensitiveOption;
+
+    m_regex.setPattern(m_query.pattern);
+    m_regex.setPatternOptions(options);
+    m_regex.optimize();
+  }
+}
+
+/**
+ * @brief Appends the matches of the current query in the given @a line to
+ *        the @a matches list.
+ *
+ * @param line    Text of the line.
+ * @param number  Absolute line number of the line.
+ * @param matches List in which the matches are registered.
+ */
+void Widgets::TerminalSearch::findMatches(const QString &line,
+                                          const qint64 number,
+                                          QVector<Match> &matches) const
+{
+  // Nothing to search
+  if (m_query.pattern.isEmpty() || line.isEmpty())
+    return;
+
+  // Regular expression, empty matches are not reported
+  if (m_query.regex)
+  {
+    if (!m_regex.isValid())
+      return;
+
+    auto it = m_regex.globalMatch(line);
+    while (it.hasNext())
+    {
+      const auto match = it.next();
+      if (match.capturedLength() > 0)
+      {
+        matches.append({number, static_cast<int>(match.capturedStart()),
+                        static_cast<int>(match.capturedLength())});
+      }
+    }
+
+    return;
+  }
+
+  // Literal text, case-sensitive queries use the SIMD substring search
+  qsizetype from = 0;
+  const auto length = m_query.pattern.size();
+  const auto &pattern = m_query.pattern;
+  const auto *data = reinterpret_cast<const char16_t *>(line.utf16());
+  const auto *needle = reinterpret_cast<const char16_t *>(pattern.utf16());
+  while (from + length <= line.size())
+  {
+    qsizetype index = -1;
+    if (m_query.caseSensitive)
+    {
+      const auto offset = SIMD::findSubstring(data + from, line.size() - from,
+                                              needle, length);
+      if (offset >= 0)
+        index = from + offset;
+    }
+
+    else
+      index = line.indexOf(m_query.pattern, from, Qt::CaseInsensitive);
+
+    if (index < 0)
+      break;
+
+    matches.append({number, static_cast<int>(index), static_cast<int>(length)});
+    from = index + length;
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QObject>
+#include <QVector>
+#include <QString>
+#include <QRegularExpression>
+
+#include "UI/Widgets/TerminalBuffer.h"
+
+namespace Widgets
+{
+/**
+ * @class Widgets::TerminalSearch
+ * @brief Finds the lines of the terminal scrollback that match a query.
+ *
+ * The search engine is meant to live in a worker thread. The terminal hands
+ * it snapshots of its scrollback (see @c TerminalBuffer::snapshot()) with
+ * @c scan(): the whole scrollback when the query changes, and then only the
+ * lines completed since the previous scan, so that the live filter does not
+ * rescan the history every time that a new line arrives.
+ *
+ * Queries are either regular expressions or literal text. Case-sensitive
+ * literal queries use the SIMD substring search (see
+ * @c SIMD::findSubstring()), which is the fast path for typical searches.
+ *
+ * Results are reported in batches with @c matchesFound(), each batch covers a
+ * range of lines so that the terminal can replace the results of lines that
+ * were scanned again. Every scan is tagged with a generation number, and scans
+ * of older generations are aborted as soon as a newer one is requested with
+ * @c cancel().
+ */
+class TerminalSearch : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Search parameters.
+   */
+  struct Query
+  {
+    QString pattern;
+    bool regex = false;
+    bool caseSensitive = false;
+  };
+
+  /**
+   * @brief Position of a match, @c line is the absolute line number (lines
+   *        dropped from the scrollback are still counted).
+   */
+  struct Match
+  {
+    qint64 line;
+    int column;
+    int length;
+  };
+
+signals:
+  void matchesFound(const quint64 generation, const qint64 first,
+                    const qint64 count,
+                    const QVector<Widgets::TerminalSearch::Match> &matches);
+
+public:
+  explicit TerminalSearch(QObject *parent = nullptr);
+
+  void cancel(const quint64 generation);
+
+public slots:
+  void scan(const quint64 generation, const Query &query, const qint64 origin,
+            const QVector<Widgets::TerminalBuffer::Chunk> &chunks);
+
+private:
+  void setQuery(const Query &query);
+  void findMatches(const QString &line, const qint64 number,
+                   QVector<Match> &matches) const;
+
+private:
+  Query m_query;
+  QRegularExpression m_regex;
+  std::atomic<quint64> m_generation;
+};
+} // namespace Widgets
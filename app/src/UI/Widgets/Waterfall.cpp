@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "UI/Dashboard.h"
+#include "UI/Widgets/Waterfall.h"
+#include "Misc/Trace.h"
+
+/**
+ * Number of spectrums kept in the history of a waterfall plot
+ */
+static constexpr int kWaterfallRows = 256;
+
+/**
+ * Range of values (in dB relative to the strongest bin) that is color-mapped
+ */
+static constexpr qreal kMinDecibels = -100;
+static constexpr qreal kMaxDecibels = 0;
+
+/**
+ * @brief Constructs a new Waterfall widget.
+ * @param index The index of the waterfall plot in the Dashboard.
+ * @param parent The parent QQuickItem.
+ */
+Widgets::Waterfall::Waterfall(const int index, QQuickItem *parent)
+  : QQuickItem(parent)
+  , m_index(index)
+  , m_maxX(0)
+{
+  if (VALIDATE_WIDGET(SerialStudio::DashboardWaterfall, m_index))
+  {
+    // Configure the FFT engine from the dataset
+    const auto &dataset
+        = GET_DATASET(SerialStudio::DashboardWaterfall, m_index);
+    m_engine.configure(dataset);
+    m_maxX = m_engine.samplingRate() / 2;
+
+    // Update widget
+    UI::Dashboard::instance().subscribe(SerialStudio::DashboardWaterfall,
+                                        m_index, this, &Waterfall::updateData);
+  }
+}
+
+/**
+ * @brief Returns the number of spectrums kept in the history.
+ */
+int Widgets::Waterfall::rows() const
+{
+  return kWaterfallRows;
+}
+
+/**
+ * @brief Returns the minimum X-axis (frequency) value.
+ */
+qreal Widgets::Waterfall::minX() const
+{
+  return 0;
+}
+
+/**
+ * @brief Returns the maximum X-axis (frequency) value.
+ */
+qreal Widgets::Waterfall::maxX() const
+{
+  return m_maxX;
+}
+
+/**
+ * @brief Returns the minimum Y-axis value, which is the age (in spectrums) of
+ *        the oldest row of the history.
+ */
+qreal Widgets::Waterfall::minY() const
+{
+  return -kWaterfallRows;
+}
+
+/**
+ * @brief Returns the maximum Y-axis value, which is the age of the newest row
+ *        of the history.
+ */
+qreal Widgets::Waterfall::maxY() const
+{
+  return 0;
+}
+
+/**
+ * @brief Returns the magnitude (in dB) drawn with the first palette color.
+ */
+qreal Widgets::Waterfall::minValue() const
+{
+  return kMinDecibels;
+}
+
+/**
+ * @brief Returns the magnitude (in dB) drawn with the last palette color.
+ */
+qreal Widgets::Waterfall::maxValue() const
+{
+  return kMaxDecibels;
+}
+
+/**
+ * @brief Returns the X-axis tick interval.
+ */
+qreal Widgets::Waterfall::xTickInterval() const
+{
+  return UI::Dashboard::smartInterval(minX(), maxX());
+}
+
+/**
+ * @brief Returns the Y-axis tick interval.
+ */
+qreal Widgets::Waterfall::yTickInterval() const
+{
+  return UI::Dashboard::smartInterval(minY(), maxY());
+}
+
+/**
+ * @brief Hands the spectrums calculated since the last call to the given
+ *        renderer, which adds them to the history as new rows.
+ *
+ * @param renderer The scene graph item that draws the waterfall.
+ */
+void Widgets::Waterfall::draw(Widgets::WaterfallRenderer *renderer)
+{
+  if (renderer)
+  {
+    for (const auto &row : std::as_const(m_pendingRows))
+      renderer->addRow(row);
+  }
+
+  m_pendingRows.clear();
+}
+
+/**
+ * @brief Queues the spectrum calculated by the FFT engine since the last UI
+ *        refresh (if any), and queues a new transform once the dataset has
+ *        received at least @c fftHopSize new samples.
+ */
+void Widgets::Waterfall::updateData()
+{
+  TRACE_ZONE("Waterfall::updateData");
+
+  if (!isEnabled())
+    return;
+
+  // Queue the spectrum calculated by the worker pool
+  if (m_engine.takeSpectrum(m_spectrum))
+  {
+    m_pendingRows.append(m_spectrum);
+    while (m_pendingRows.count() > kWaterfallRows)
+      m_pendingRows.removeFirst();
+  }
+
+  // Queue a new transform if the plot data is valid
+  const auto &dashboard = UI::Dashboard::instance();
+  const auto *history
+      = dashboard.datasetHistory(SerialStudio::DashboardWaterfall, m_index);
+  if (history)
+    m_engine.process(*history);
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+
+#include "UI/Widgets/WaterfallRenderer.h"
+
+/**
+ * @brief Root node of a waterfall plot, owns the texture that is shared by the
+ *        two texture nodes that draw the halves of the ring buffer.
+ */
+class WaterfallNode : public QSGNode
+{
+public:
+  WaterfallNode()
+    : older(new QSGSimpleTextureNode)
+    , newer(new QSGSimpleTextureNode)
+  {
+    appendChildNode(newer);
+    appendChildNode(older);
+  }
+
+  QSGSimpleTextureNode *older;
+  QSGSimpleTextureNode *newer;
+  QScopedPointer<QSGTexture> texture;
+};
+
+/**
+ * @brief Constructs a WaterfallRenderer item.
+ * @param parent The parent QQuickItem (optional).
+ */
+Widgets::WaterfallRenderer::WaterfallRenderer(QQuickItem *parent)
+  : QQuickItem(parent)
+  , m_head(0)
+  , m_rows(256)
+  , m_minValue(-100)
+  , m_maxValue(0)
+  , m_imageChanged(false)
+{
+  setClip(true);
+  setFlag(ItemHasContents, true);
+
+  // Build the palette by interpolating a perceptual (dark to bright) scale
+  static const QColor stops[] = {QColor(0x00, 0x00, 0x04),
+                                 QColor(0x42, 0x0a, 0x68),
+                                 QColor(0x93, 0x26, 0x67),
+                                 QColor(0xdd, 0x51, 0x3a),
+                                 QColor(0xfc, 0xa5, 0x0a),
+                                 QColor(0xfc, 0xff, 0xa4)};
+  constexpr int segments = sizeof(stops) / sizeof(stops[0]) - 1;
+  const int last = static_cast<int>(m_palette.size()) - 1;
+  for (int i = 0; i <= last; ++i)
+  {
+    const qreal t = static_cast<qreal>(i) * segments / last;
+    const int s = qMin(static_cast<int>(t), segments - 1);
+    const qreal f = t - s;
+    const auto &a = stops[s];
+    const auto &b = stops[s + 1];
+    m_palette[i] = qRgb(qRound(a.red() + (b.red() - a.red()) * f),
+                        qRound(a.green() + (b.green() - a.green()) * f),
+                        qRound(a.blue() + (b.blue() - a.blue()) * f));
+  }
+
+  // Update the node geometry when the item is resized
+  connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+  connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+}
+
+/**
+ * @brief Returns the number of spectrums kept in the history.
+ */
+int Widgets::WaterfallRenderer::rows() const
+{
+  return m_rows;
+}
+
+/**
+ * @brief Returns the value drawn with the first color of the palette.
+ */
+qreal Widgets::WaterfallRenderer::minValue() const
+{
+  return m_minValue;
+}
+
+/**
+ * @brief Returns the value drawn with the last color of the palette.
+ */
+qreal Widgets::WaterfallRenderer::maxValue() const
+{
+  return m_maxValue;
+}
+
+/**
+ * @brief Removes all the spectrums from the history.
+ */
+void Widgets::WaterfallRenderer::clear()
+{
+  m_head = 0;
+  m_image = QImage();
+  m_imageChanged = true;
+  update();
+}
+
+/**
+ * @brief Changes the number of spectrums kept in the history, and clears the
+ *        current history.
+ */
+void Widgets::WaterfallRenderer::setRows(const int rows)
+{
+  const auto value = qMax(1, rows);
+  if (m_rows != value)
+  {
+    m_rows = value;
+    clear();
+
+    Q_EMIT rowsChanged();
+  }
+}
+
+/**
+ * @brief Changes the value drawn with the first color of the palette.
+ *
+ * @note Only the spectrums added after the change use the new range.
+ */
+void Widgets::WaterfallRenderer::setMinValue(const qreal value)
+{
+  if (!qFuzzyCompare(m_minValue, value))
+  {
+    m_minValue = value;
+    Q_EMIT rangeChanged();
+  }
+}
+
+/**
+ * @brief Changes the value drawn with the last color of the palette.
+ *
+ * @note Only the spectrums added after the change use the new range.
+ */
+void Widgets::WaterfallRenderer::setMaxValue(const qreal value)
+{
+  if (!qFuzzyCompare(m_maxValue, value))
+  {
+    m_maxValue = value;
+    Q_EMIT rangeChanged();
+  }
+}
+
+/**
+ * @brief Color-maps the given spectrum @a values into the newest row of the
+ *        history, replacing the oldest row.
+ *
+ * The history is cleared if the number of values differs from the width of
+ * the previous spectrums.
+ */
+void Widgets::WaterfallRenderer::addRow(const QVector<float> &values)
+{
+  if (values.isEmpty())
+    return;
+
+  // (Re)allocate the history image
+  const auto width = static_cast<int>(values.count());
+  if (m_image.width() != width || m_image.height() != m_rows)
+  {
+    m_head = 0;
+    m_image = QImage(width, m_rows, QImage::Format_RGB32);
+    m_image.fill(m_palette.front());
+  }
+
+  // The newest row is written just before the previous one in the ring
+  m_head = (m_head + m_rows - 1) % m_rows;
+
+  // Color-map the spectrum into the row
+  const auto range = m_maxValue - m_minValue;
+  const auto scale = range > 0 ? (m_palette.size() - 1) / range : 0;
+  auto *row = reinterpret_cast<QRgb *>(m_image.scanLine(m_head));
+  for (int i = 0; i < width; ++i)
+  {
+    const auto index = qBound<qreal>(0, (values[i] - m_minValue) * scale,
+                                     m_palette.size() - 1);
+    row[i] = m_palette[static_cast<size_t>(index)];
+  }
+
+  m_imageChanged = true;
+  update();
+}
+
+/**
+ * @brief Builds or updates the scene graph nodes of the waterfall.
+ *
+ * The history image is uploaded as a texture when new rows were added, and
+ * the two halves of the ring buffer are drawn with two texture nodes: the
+ * newest rows (from the head of the ring to the bottom of the image) at the
+ * top of the item, followed by the oldest rows.
+ */
+QSGNode *Widgets::WaterfallRenderer::updatePaintNode(QSGNode *oldNode,
+                                                     UpdatePaintNodeData *)
+{
+  // Nothing to draw
+  if (m_image.isNull() || width() <= 0 || height() <= 0)
+  {
+    delete oldNode;
+    return nullptr;
+  }
+
+  // Create the node tree on the first update
+  auto *node = static_cast<WaterfallNode *>(oldNode);
+  if (!node)
+  {
+    node = new WaterfallNode;
+    m_imageChanged = true;
+  }
+
+  // Upload the history image
+  if (m_imageChanged)
+  {
+    m_imageChanged = false;
+    node->texture.reset(window()->createTextureFromImage(m_image));
+    node->newer->setTexture(node->texture.data());
+    node->older->setTexture(node->texture.data());
+  }
+
+  // Split the item rectangle between the two halves of the ring
+  const qreal w = m_image.width();
+  const qreal newerRows = m_rows - m_head;
+  const qreal split = height() * newerRows / m_rows;
+  node->newer->setSourceRect(QRectF(0, m_head, w, newerRows));
+  node->newer->setRect(QRectF(0, 0, width(), split));
+  node->older->setSourceRect(QRectF(0, 0, w, m_head));
+  node->older->setRect(QRectF(0, split, width(), height() - split));
+
+  return node;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <QImage>
+#include <QVector>
+#include <QQuickItem>
+
+namespace Widgets
+{
+/**
+ * @class Widgets::WaterfallRenderer
+ * @brief Scene graph item that draws the spectrum history of a waterfall plot.
+ *
+ * Every spectrum is color-mapped into one row of an image that is used as a
+ * ring buffer: a new row replaces the oldest one, and the rest of the history
+ * is never shifted nor re-colored. The image is drawn with two texture nodes
+ * that show the two halves of the ring, so that the newest row is always at
+ * the top of the item.
+ *
+ * The @c minValue and @c maxValue properties define the range of values
+ * (usually in dB) that is mapped to the first and last color of the palette.
+ */
+class WaterfallRenderer : public QQuickItem
+{
+  // clang-format off
+  Q_OBJECT
+  Q_PROPERTY(int rows
+             READ rows
+             WRITE setRows
+             NOTIFY rowsChanged)
+  Q_PROPERTY(qreal minValue
+             READ minValue
+             WRITE setMinValue
+             NOTIFY rangeChanged)
+  Q_PROPERTY(qreal maxValue
+             READ maxValue
+             WRITE setMaxValue
+             NOTIFY rangeChanged)
+  // clang-format on
+
+signals:
+  void rowsChanged();
+  void rangeChanged();
+
+public:
+  explicit WaterfallRenderer(QQuickItem *parent = nullptr);
+
+  [[nodiscard]] int rows() const;
+  [[nodiscard]] qreal minValue() const;
+  [[nodiscard]] qreal maxValue() const;
+
+public slots:
+  void clear();
+  void setRows(const int rows);
+  void setMinValue(const qreal value);
+  void setMaxValue(const qreal value);
+  void addRow(const QVector<float> &values);
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+  int m_head;
+  int m_rows;
+  qreal m_minValue;
+  qreal m_maxValue;
+
+  QImage m_image;
+  bool m_imageChanged;
+  std::array<QRgb, 256> m_palette;
+};
+} // namespace Widgets
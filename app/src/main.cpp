@@ -28,7 +28,12 @@
 #include <QStyleFactory>
 
 #include "AppInfo.h"
+#include "Misc/Benchmark.h"
+#include "Misc/Corpus.h"
+#include "Misc/Headless.h"
+#include "Misc/GraphicsBackend.h"
 #include "Misc/ModuleManager.h"
+#include "Misc/WidgetBenchmark.h"
 
 #ifdef Q_OS_WIN
 #  include <windows.h>
@@ -48,6 +53,7 @@
 
 static void cliShowVersion();
 static void cliResetSettings();
+static bool cliHeadlessMode(int argc, char **argv);
 
 #ifdef Q_OS_LINUX
 static void setupAppImageIcon(const QString &appExecutableName,
@@ -95,6 +101,16 @@ int main(int argc, char **argv)
   auto policy = Qt::HighDpiScaleFactorRoundingPolicy::PassThrough;
   QApplication::setHighDpiScaleFactorRoundingPolicy(policy);
 
+  // Headless mode does not need a display server
+  const auto platform = "QT_QPA_PLATFORM";
+  const auto headless = cliHeadlessMode(argc, argv);
+  if (headless && qEnvironmentVariableIsEmpty(platform))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  // Select the graphics API & render loop of Qt Quick
+  if (!headless)
+    Misc::GraphicsBackend::configure(argc, argv);
+
   // Initialize application
   QApplication app(argc, argv);
 
@@ -124,6 +140,36 @@ int main(int argc, char **argv)
       cliResetSettings();
       return EXIT_SUCCESS;
     }
+
+    else if (arguments == "--benchmark")
+    {
+      Misc::Benchmark benchmark;
+      return benchmark.run(app.arguments().value(2));
+    }
+
+    else if (arguments == "--widget-benchmark")
+    {
+      Misc::ModuleManager moduleManager;
+      moduleManager.registerQmlTypes();
+      moduleManager.initializeQmlInterface(false);
+
+      Misc::WidgetBenchmark benchmark(&moduleManager.engine());
+      const auto copies = app.arguments().value(2).toInt();
+      return benchmark.run(copies, app.arguments().value(3));
+    }
+
+    else if (arguments == "--corpus" || arguments == "--corpus-update")
+    {
+      Misc::Corpus corpus;
+      const bool update = arguments == "--corpus-update";
+      return corpus.run(app.arguments().value(2), update);
+    }
+
+    else if (arguments == "--headless")
+    {
+      Misc::Headless headless;
+      return headless.run(app.arguments());
+    }
   }
 
   // Create module manager
@@ -176,6 +222,15 @@ static void cliResetSettings()
   qDebug() << APP_NAME << "settings cleared!";
 }
 
+/**
+ * Returns @c true if the application was started with the @c --headless
+ * option, before the application object is created
+ */
+static bool cliHeadlessMode(int argc, char **argv)
+{
+  return argc >= 2 && qstrcmp(argv[1], "--headless") == 0;
+}
+
 //------------------------------------------------------------------------------
 // Linux-specific initialization code
 //------------------------------------------------------------------------------